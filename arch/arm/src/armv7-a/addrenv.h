@@ -48,6 +48,14 @@
 
 #define ENTRIES_PER_L2TABLE 256
 
+/* A shared memory section mapping is recorded in the group's shm[] list as
+ * the section base address tagged with the section descriptor type.  L2
+ * page table addresses are page aligned, so the two cannot be confused.
+ */
+
+#define ARM_SHM_ISSECTION(e) \
+  (((uintptr_t)(e) & PMD_TYPE_MASK) == PMD_TYPE_SECT)
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
@@ -374,7 +374,7 @@ int up_addrenv_destroy(group_addrenv_t *addrenv)
    * data).
    */
 
-  arm_addrenv_destroy_region(addrenv->heap, ARCH_SHM_NSECTS,
+  arm_addrenv_destroy_region(addrenv->shm, ARCH_SHM_NSECTS,
                              CONFIG_ARCH_SHM_VBASE, true);
 #endif
 #endif
@@ -630,7 +630,12 @@ int up_addrenv_select(const group_addrenv_t *addrenv,
       /* Set (or clear) the new page table entry */
 
       paddr = (uintptr_t)addrenv->shm[i];
-      if (paddr)
+      if (ARM_SHM_ISSECTION(paddr))
+        {
+          mmu_l1_setentry(paddr & PMD_SECT_PADDR_MASK, vaddr,
+                          MMU_L1_SHMFLAGS);
+        }
+      else if (paddr)
         {
           mmu_l1_setentry(paddr, vaddr, MMU_L1_PGTABFLAGS);
         }
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
@@ -40,6 +41,52 @@
 
 #if defined(CONFIG_BUILD_KERNEL) && defined(CONFIG_MM_SHM)
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: arm_shm_issection
+ *
+ * Description:
+ *   Check if the next section worth of pages is one physically contiguous,
+ *   section aligned run that can be mapped with a single section
+ *   descriptor.
+ *
+ * Input Parameters:
+ *   pages - The physical pages remaining to be mapped.
+ *   npages - The number of pages remaining to be mapped.
+ *   vaddr - The virtual address of the first page.
+ *
+ * Returned Value:
+ *   True if the pages can be mapped as one section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_SHM_CONTIGUOUS
+static bool arm_shm_issection(FAR uintptr_t *pages, unsigned int npages,
+                              uintptr_t vaddr)
+{
+  unsigned int i;
+
+  if ((vaddr & SECTION_MASK) != 0 || (pages[0] & SECTION_MASK) != 0 ||
+      npages < ENTRIES_PER_L2TABLE)
+    {
+      return false;
+    }
+
+  for (i = 1; i < ENTRIES_PER_L2TABLE; i++)
+    {
+      if (pages[i] != pages[0] + (i << MM_PGSHIFT))
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -101,6 +148,30 @@ int up_shmat(uintptr_t *pages, unsigned int npages, uintptr_t vaddr)
        */
 
       l1entry = group->tg_addrenv.shm[shmndx];
+
+#ifdef CONFIG_MM_SHM_CONTIGUOUS
+      /* Map a contiguous, aligned section of pages with a single section
+       * descriptor.  This uses no L2 page table and only one TLB entry.
+       */
+
+      if (l1entry == NULL &&
+          arm_shm_issection(pages, npages - nmapped, vaddr))
+        {
+          paddr = *pages;
+
+          flags = enter_critical_section();
+          group->tg_addrenv.shm[shmndx] =
+            (uintptr_t *)(paddr | PMD_TYPE_SECT);
+          mmu_l1_setentry(paddr, vaddr, MMU_L1_SHMFLAGS);
+          leave_critical_section(flags);
+
+          pages   += ENTRIES_PER_L2TABLE;
+          nmapped += ENTRIES_PER_L2TABLE;
+          vaddr   += SECTION_SIZE;
+          continue;
+        }
+#endif
+
       if (l1entry == NULL)
         {
           /* No.. Allocate one physical page for the L2 page table */
@@ -253,6 +324,23 @@ int up_shmdt(uintptr_t vaddr, unsigned int npages)
       l1entry = group->tg_addrenv.shm[shmndx];
       DEBUGASSERT(l1entry != NULL);
 
+      /* A section mapping is removed as a whole */
+
+      if (ARM_SHM_ISSECTION(l1entry))
+        {
+          DEBUGASSERT((vaddr & SECTION_MASK) == 0 &&
+                      npages - nunmapped >= ENTRIES_PER_L2TABLE);
+
+          flags = enter_critical_section();
+          group->tg_addrenv.shm[shmndx] = NULL;
+          mmu_l1_clrentry(vaddr);
+          leave_critical_section(flags);
+
+          nunmapped += ENTRIES_PER_L2TABLE;
+          vaddr     += SECTION_SIZE;
+          continue;
+        }
+
       /* Get the physical address of the L2 page table from the L1 page
        * table entry.
        */
@@ -202,6 +202,18 @@ void arm_addrenv_destroy_region(uintptr_t **list, unsigned int listlen,
       /* Has this page table been allocated? */
 
       paddr = (uintptr_t)list[i];
+
+#ifdef CONFIG_MM_SHM
+      /* A shared memory section mapping has no L2 page table and its pages
+       * belong to the shared memory region.
+       */
+
+      if (ARM_SHM_ISSECTION(paddr))
+        {
+          continue;
+        }
+#endif
+
       if (paddr != 0)
         {
           flags = enter_critical_section();
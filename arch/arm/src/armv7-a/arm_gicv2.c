@@ -504,6 +504,39 @@ int up_prioritize_irq(int irq, int priority)
   return -EINVAL;
 }
 
+/****************************************************************************
+ * Name: up_affinity_irq
+ *
+ * Description:
+ *   Set the set of CPUs that may service a shared peripheral interrupt.
+ *
+ *   Since this API is not supported on all architectures, it should be
+ *   avoided in common implementations where possible.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+int up_affinity_irq(int irq, cpu_set_t cpuset)
+{
+  /* Only SPIs can be routed, SGIs and PPIs are private to each CPU */
+
+  if (irq >= GIC_IRQ_SPI && irq < NR_IRQS && (cpuset & 0xff) != 0)
+    {
+      /* The distributor Interrupt Processor Targets Registers
+       * (GIC_ICDIPTR) are byte accessible, so there is no need to lock
+       * against another CPU modifying the neighbouring fields.
+       */
+
+      putreg8(cpuset & 0xff, GIC_ICDIPTR(irq) + (irq & 3));
+
+      arm_gic_dump("Exit up_affinity_irq", false, irq);
+      return OK;
+    }
+
+  return -EINVAL;
+}
+#endif
+
 /****************************************************************************
  * Name: arm_gic_irq_trigger
  *
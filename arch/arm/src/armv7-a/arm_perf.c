@@ -22,10 +22,14 @@
  * Included Files
  ****************************************************************************/
 
+#include <errno.h>
+
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/pmu.h>
 
 #include "arm_internal.h"
+#include "barriers.h"
 #include "sctlr.h"
 
 /****************************************************************************
@@ -34,6 +38,19 @@
 
 static uint32_t g_cpu_freq;
 
+/* The architected events that implement the generic events */
+
+static const uint8_t g_pmu_events[] =
+{
+  0,                             /* PMU_EVENT_NONE */
+  PMETSR_CYCLES,                 /* PMU_EVENT_CYCLES */
+  PMETSR_INSTARCHEXEC,           /* PMU_EVENT_INSTRUCTIONS */
+  PMETSR_L1_DC_ACC,              /* PMU_EVENT_CACHE_REFS */
+  PMETSR_L1_DC_FILL,             /* PMU_EVENT_CACHE_MISSES */
+  PMETSR_PREDICTEDBRANCHEXEC,    /* PMU_EVENT_BRANCHES */
+  PMETSR_MISPREDICTEDBRANCHEXEC, /* PMU_EVENT_BRANCH_MISSES */
+};
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -85,3 +102,55 @@ void up_perf_convert(uint32_t elapsed, struct timespec *ts)
   left        = elapsed - ts->tv_sec * g_cpu_freq;
   ts->tv_nsec = NSEC_PER_SEC * (uint64_t)left / g_cpu_freq;
 }
+
+/****************************************************************************
+ * Name: up_pmu_*
+ *
+ * Description:
+ *   The event counters of the PMU.  Stalls have no architected event; they
+ *   may be counted with the raw event number of the implementation.
+ *
+ ****************************************************************************/
+
+int up_pmu_ncounters(void)
+{
+  return (cp15_pmu_rdpmcr() & PMCR_N_MASK) >> PMCR_N_SHIFT;
+}
+
+int up_pmu_config(int counter, uint32_t event)
+{
+  uint32_t type;
+
+  if (event == PMU_EVENT_NONE)
+    {
+      cp15_pmu_wrcecr(1 << counter);
+      return 32;
+    }
+
+  if (PMU_EVENT_ISRAW(event))
+    {
+      type = PMU_EVENT_RAWNUM(event) & PMETSR_EVENT_MASK;
+    }
+  else if (event < sizeof(g_pmu_events))
+    {
+      type = g_pmu_events[event];
+    }
+  else
+    {
+      return -ENOTSUP;
+    }
+
+  cp15_pmu_wrecsr(counter & PMECSR_CS_MASK);
+  ARM_ISB();
+  cp15_pmu_wretsr(type);
+  cp15_pmu_pmcr(PMCR_E);
+  cp15_pmu_wrcesr(1 << counter);
+  return 32;
+}
+
+uint32_t up_pmu_read(int counter)
+{
+  cp15_pmu_wrecsr(counter & PMECSR_CS_MASK);
+  ARM_ISB();
+  return cp15_pmu_rdecr();
+}
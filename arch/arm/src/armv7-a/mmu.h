@@ -615,6 +615,18 @@
                                PMD_PTE_DOM(0))
 #define MMU_L2_PGTABFLAGS     (PTE_TYPE_SMALL | PTE_WRITE_THROUGH | PTE_AP_RW1)
 
+/* Section mapping of a physically contiguous shared memory region */
+
+#ifdef CONFIG_SMP
+#  define MMU_L1_SHMFLAGS     (PMD_TYPE_SECT | PMD_SECT_AP_RW01 | \
+                               PMD_CACHEABLE | PMD_SECT_S | \
+                               PMD_SECT_DOM(0) | PMD_SECT_XN)
+#else
+#  define MMU_L1_SHMFLAGS     (PMD_TYPE_SECT | PMD_SECT_AP_RW01 | \
+                               PMD_CACHEABLE | PMD_SECT_DOM(0) | \
+                               PMD_SECT_XN)
+#endif
+
 #define MMU_L1_VECTORFLAGS    (PMD_TYPE_PTE | PMD_PTE_PXN | PMD_PTE_DOM(0))
 #define MMU_L2_VECTRWFLAGS    (PTE_TYPE_SMALL | PTE_WRITE_THROUGH | PTE_AP_RW1)
 #define MMU_L2_VECTROFLAGS    (PTE_TYPE_SMALL | PTE_WRITE_THROUGH | PTE_AP_R1)
@@ -32,6 +32,7 @@
 #include <nuttx/board.h>
 #include <arch/board/board.h>
 
+#include "sched/sched.h"
 #include "arm_internal.h"
 
 /****************************************************************************
@@ -40,6 +41,10 @@
 
 uint32_t *arm_doirq(int irq, uint32_t *regs)
 {
+#ifdef CONFIG_ARMV7M_STACKGUARD
+  uint32_t *entry = regs;
+#endif
+
   board_autoled_on(LED_INIRQ);
 #ifdef CONFIG_SUPPRESS_INTERRUPTS
   PANIC();
@@ -82,6 +87,17 @@ uint32_t *arm_doirq(int irq, uint32_t *regs)
       regs         = (uint32_t *)CURRENT_REGS;
       CURRENT_REGS = NULL;
     }
+
+#ifdef CONFIG_ARMV7M_STACKGUARD
+  /* If a context switch occurred, move the stack guard to the stack of
+   * the thread that will run on return from the exception.
+   */
+
+  if (regs != entry)
+    {
+      arm_stackguard_switch(this_task());
+    }
+#endif
 #endif
 
   board_autoled_off(LED_INIRQ);
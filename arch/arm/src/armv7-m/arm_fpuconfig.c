@@ -58,6 +58,18 @@ void arm_fpuconfig(void)
 {
   uint32_t regval;
 
+#ifdef CONFIG_ARMV7M_LAZYFPU
+  /* Leave CONTROL.FPCA clear.  FPCCR.ASPEN sets it on the first FP
+   * instruction of a context, so only tasks that use the FPU get the
+   * extended exception frame.  FPCCR.LSPEN then defers stacking of the
+   * volatile FP registers until the exception handler itself executes an
+   * FP instruction.
+   */
+
+  regval = getreg32(NVIC_FPCCR);
+  regval |= NVIC_FPCCR_ASPEN | NVIC_FPCCR_LSPEN;
+  putreg32(regval, NVIC_FPCCR);
+#else
   /* Set CONTROL.FPCA so that we always get the extended context frame
    * with the volatile FP registers stacked above the basic context.
    */
@@ -74,6 +86,7 @@ void arm_fpuconfig(void)
   regval = getreg32(NVIC_FPCCR);
   regval &= ~(NVIC_FPCCR_ASPEN | NVIC_FPCCR_LSPEN);
   putreg32(regval, NVIC_FPCCR);
+#endif
 
   /* Enable full access to CP10 and CP11 */
 
@@ -126,6 +126,17 @@ int arm_hardfault(int irq, void *context, void *arg)
     {
       hfalert("Hard Fault escalation:\n");
 
+#ifdef CONFIG_ARMV7M_STACKGUARD
+      /* A stack overflow into the guard escalates to a hard fault when
+       * the MemManage exception itself cannot be stacked.
+       */
+
+      if (cfsr & NVIC_CFAULTS_MEMFAULTSR_MASK)
+        {
+          arm_stackguard_report(cfsr);
+        }
+#endif
+
 #ifdef CONFIG_DEBUG_MEMFAULT
       if (cfsr & NVIC_CFAULTS_MEMFAULTSR_MASK)
         {
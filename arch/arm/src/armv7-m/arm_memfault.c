@@ -62,6 +62,12 @@ int arm_memfault(int irq, void *context, void *arg)
 {
   uint32_t cfsr = getreg32(NVIC_CFAULTS);
 
+#ifdef CONFIG_ARMV7M_STACKGUARD
+  /* Report a stack overflow caught by the MPU stack guard */
+
+  arm_stackguard_report(cfsr);
+#endif
+
   /* Dump some memory management fault info */
 
   mfalert("PANIC!!! Memory Management Fault:\n");
@@ -22,8 +22,11 @@
  * Included Files
  ****************************************************************************/
 
+#include <errno.h>
+
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/pmu.h>
 
 #include "arm_internal.h"
 #include "dwt.h"
@@ -36,6 +39,27 @@
 
 static uint32_t g_cpu_freq;
 
+/* The DWT has one fixed counter per event.  The raw event numbers select
+ * them in the order of the registers: 0 CYCCNT, 1 CPICNT, 2 EXCCNT,
+ * 3 SLEEPCNT, 4 LSUCNT and 5 FOLDCNT.  All but CYCCNT are 8 bits wide.
+ */
+
+#define DWT_NCOUNTERS 6
+
+static const uint32_t g_dwt_enable[DWT_NCOUNTERS] =
+{
+  DWT_CTRL_CYCCNTENA_MASK,
+  DWT_CTRL_CPIEVTENA_MASK,
+  DWT_CTRL_EXCEVTENA_MASK,
+  DWT_CTRL_SLEEPEVTENA_MASK,
+  DWT_CTRL_LSUEVTENA_MASK,
+  DWT_CTRL_FOLDEVTENA_MASK
+};
+
+/* The DWT register read by each counter, 0 if the counter is stopped */
+
+static uintptr_t g_dwt_counter[DWT_NCOUNTERS];
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -74,3 +98,61 @@ void up_perf_convert(uint32_t elapsed, struct timespec *ts)
   left        = elapsed - ts->tv_sec * g_cpu_freq;
   ts->tv_nsec = NSEC_PER_SEC * (uint64_t)left / g_cpu_freq;
 }
+
+/****************************************************************************
+ * Name: up_pmu_*
+ *
+ * Description:
+ *   The DWT profiling counters.  Only cycles and stalls (CPICNT, the extra
+ *   cycles of multi-cycle instructions and fetch stalls) have a generic
+ *   event; the other counters are selected with raw events.  The 8-bit
+ *   counters wrap after 256 events, so they are only meaningful if the
+ *   threads are switched more often than that.
+ *
+ ****************************************************************************/
+
+int up_pmu_ncounters(void)
+{
+  return DWT_NCOUNTERS;
+}
+
+int up_pmu_config(int counter, uint32_t event)
+{
+  uint32_t index;
+
+  if (event == PMU_EVENT_NONE)
+    {
+      g_dwt_counter[counter] = 0;
+      return 32;
+    }
+  else if (event == PMU_EVENT_CYCLES)
+    {
+      index = 0;
+    }
+  else if (event == PMU_EVENT_STALLS)
+    {
+      index = 1;
+    }
+  else if (PMU_EVENT_ISRAW(event) &&
+           PMU_EVENT_RAWNUM(event) < DWT_NCOUNTERS)
+    {
+      index = PMU_EVENT_RAWNUM(event);
+    }
+  else
+    {
+      return -ENOTSUP;
+    }
+
+  modifyreg32(NVIC_DEMCR, 0, NVIC_DEMCR_TRCENA);
+  modifyreg32(DWT_CTRL, 0, g_dwt_enable[index]);
+
+  g_dwt_counter[counter] = DWT_CYCCNT + 4 * index;
+  return index == 0 ? 32 : 8;
+}
+
+uint32_t up_pmu_read(int counter)
+{
+  uintptr_t regaddr = g_dwt_counter[counter];
+
+  return regaddr != 0 ? getreg32(regaddr) : 0;
+}
@@ -0,0 +1,210 @@
+/****************************************************************************
+ * arch/arm/src/armv7-m/arm_stackguard.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+#include "barriers.h"
+#include "mpu.h"
+#include "nvic.h"
+#include "arm_internal.h"
+
+#ifdef CONFIG_ARMV7M_STACKGUARD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define GUARD_SIZE  CONFIG_ARMV7M_STACKGUARD_SIZE
+
+#if (GUARD_SIZE & (GUARD_SIZE - 1)) != 0 || GUARD_SIZE < 32
+#  error CONFIG_ARMV7M_STACKGUARD_SIZE must be a power of two, 32 or more
+#endif
+
+/* No access from any mode, no execution */
+
+#define GUARD_FLAGS (MPU_RASR_AP_NONO | MPU_RASR_XN)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static unsigned int g_guard_region;   /* MPU region of the guard */
+static uintptr_t    g_guard_base;     /* Guarded address, 0 if none */
+static FAR struct tcb_s *g_guard_tcb; /* Owner of the guarded stack */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: arm_stackguard_initialize
+ *
+ * Description:
+ *   Reserve an MPU region for the stack guard and enable the MPU if the
+ *   chip logic did not.  The region is allocated after those of the chip
+ *   so that it takes priority over any region covering the stacks.
+ *
+ ****************************************************************************/
+
+void arm_stackguard_initialize(void)
+{
+  g_guard_region = mpu_allocregion();
+  DEBUGASSERT(g_guard_region < CONFIG_ARM_MPU_NREGIONS);
+
+  if ((getreg32(MPU_CTRL) & MPU_CTRL_ENABLE) == 0)
+    {
+      /* Only the guard is mapped: keep the default memory map for the
+       * privileged code, which is all of the code in the FLAT build.
+       */
+
+      mpu_control(true, false, true);
+    }
+
+  arm_stackguard_switch(this_task());
+}
+
+/****************************************************************************
+ * Name: arm_stackguard_switch
+ *
+ * Description:
+ *   Move the guard to the bottom of the stack of the thread that is about
+ *   to run.  Any access to the lowest CONFIG_ARMV7M_STACKGUARD_SIZE bytes
+ *   of its stack then raises a MemManage fault, as soon as the stack
+ *   overflows and at no cost to the running code.
+ *
+ *   The guard starts at the first aligned address above stack_base_ptr,
+ *   so the TLS data and the task arguments below it stay accessible.
+ *   Stacks too small to give up the guard are not protected.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that will run next
+ *
+ ****************************************************************************/
+
+void arm_stackguard_switch(FAR struct tcb_s *tcb)
+{
+  uintptr_t base = (uintptr_t)tcb->stack_base_ptr;
+  uintptr_t top  = base + tcb->adj_stack_size;
+
+  base = (base + GUARD_SIZE - 1) & ~(GUARD_SIZE - 1);
+
+  putreg32(g_guard_region, MPU_RNR);
+
+  if (tcb->stack_base_ptr == NULL || base + 2 * GUARD_SIZE > top)
+    {
+      putreg32(0, MPU_RASR);
+      g_guard_base = 0;
+    }
+  else
+    {
+      putreg32(base | g_guard_region | MPU_RBAR_VALID, MPU_RBAR);
+      putreg32(MPU_RASR_ENABLE | GUARD_FLAGS |
+               MPU_RASR_SIZE_LOG2((uint32_t)mpu_log2regionceil(GUARD_SIZE)),
+               MPU_RASR);
+      g_guard_base = base;
+    }
+
+  g_guard_tcb = tcb;
+
+  /* The new region must be in effect before the next stack access */
+
+  ARM_DSB();
+  ARM_ISB();
+}
+
+/****************************************************************************
+ * Name: arm_stackguard_report
+ *
+ * Description:
+ *   Called from the fault handlers to tell whether the fault was caused by
+ *   a stack overflow into the guard and, if so, to report which thread
+ *   overflowed.
+ *
+ *   A fault on exception entry (MSTKERR) has no valid fault address but,
+ *   with the guard in place, means that the stack of the running thread
+ *   could not hold the exception frame.
+ *
+ * Input Parameters:
+ *   cfsr - The value of the Configurable Fault Status Register
+ *
+ * Returned Value:
+ *   true if the fault hit the stack guard.
+ *
+ ****************************************************************************/
+
+bool arm_stackguard_report(uint32_t cfsr)
+{
+  FAR struct tcb_s *tcb = g_guard_tcb;
+  uintptr_t addr = getreg32(NVIC_MEMMANAGE_ADDR);
+  bool hit = false;
+
+  if (g_guard_base == 0 || tcb == NULL)
+    {
+      return false;
+    }
+
+  if ((cfsr & NVIC_CFAULTS_MSTKERR) != 0)
+    {
+      hit = true;
+    }
+  else if ((cfsr & (NVIC_CFAULTS_MMARVALID | NVIC_CFAULTS_DACCVIOL)) ==
+           (NVIC_CFAULTS_MMARVALID | NVIC_CFAULTS_DACCVIOL))
+    {
+      hit = addr >= g_guard_base && addr < g_guard_base + GUARD_SIZE;
+    }
+
+  if (hit)
+    {
+#if CONFIG_TASK_NAME_SIZE > 0
+      _alert("Stack overflow: PID %d (%s) stack %p size %zu addr %08x\n",
+             tcb->pid, tcb->name, tcb->stack_base_ptr,
+             tcb->adj_stack_size, (unsigned int)addr);
+#else
+      _alert("Stack overflow: PID %d stack %p size %zu addr %08x\n",
+             tcb->pid, tcb->stack_base_ptr, tcb->adj_stack_size,
+             (unsigned int)addr);
+#endif
+
+      /* Drop the guard: the fault handling that follows must be able to
+       * use what remains of the stack.
+       */
+
+      putreg32(g_guard_region, MPU_RNR);
+      putreg32(0, MPU_RASR);
+      g_guard_base = 0;
+    }
+
+  return hit;
+}
+
+#endif /* CONFIG_ARMV7M_STACKGUARD */
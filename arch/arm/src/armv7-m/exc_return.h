@@ -79,9 +79,12 @@
 
 /* EXC_RETURN_PRIVTHR: Return to privileged thread mode. Exception return
  * gets state from the main stack. Execution uses MSP after return.
+ *
+ * With the lazy FPU context switch, new contexts start with the basic
+ * frame:  The FP context is created by the first FP instruction.
  */
 
-#ifdef CONFIG_ARCH_FPU
+#if defined(CONFIG_ARCH_FPU) && !defined(CONFIG_ARMV7M_LAZYFPU)
 #  define EXC_RETURN_PRIVTHR     (EXC_RETURN_BASE | EXC_RETURN_THREAD_MODE)
 #else
 #  define EXC_RETURN_PRIVTHR     (EXC_RETURN_BASE | EXC_RETURN_STD_CONTEXT | \
@@ -92,7 +95,7 @@
  * gets state from the process stack. Execution uses PSP after return.
  */
 
-#ifdef CONFIG_ARCH_FPU
+#if defined(CONFIG_ARCH_FPU) && !defined(CONFIG_ARMV7M_LAZYFPU)
 #  define EXC_RETURN_UNPRIVTHR   (EXC_RETURN_BASE | EXC_RETURN_THREAD_MODE | \
                                   EXC_RETURN_PROCESS_STACK)
 #else
@@ -100,6 +103,21 @@
                                   EXC_RETURN_THREAD_MODE | EXC_RETURN_PROCESS_STACK)
 #endif
 
+/* EXC_RETURN_FRAME: Change the EXC_RETURN value of an existing context
+ * while keeping its frame type.  With the lazy FPU context switch, a
+ * context may have either the basic or the extended frame.  The frame type
+ * tells the hardware how much to unstack, so it must stay as it was
+ * stacked.
+ */
+
+#ifdef CONFIG_ARMV7M_LAZYFPU
+#  define EXC_RETURN_FRAME(regs, excret) \
+     (((excret) & ~EXC_RETURN_STD_CONTEXT) | \
+      ((regs)[REG_EXC_RETURN] & EXC_RETURN_STD_CONTEXT))
+#else
+#  define EXC_RETURN_FRAME(regs, excret) (excret)
+#endif
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
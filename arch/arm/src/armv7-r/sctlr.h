@@ -333,6 +333,7 @@
 #define PMETSR_PROCRET                (0xe)  /* Procedure return */
 #define PMETSR_UNALINGEDLDSTR         (0xf)  /* Unaligned load or store */
 #define PMETSR_MISPREDICTEDBRANCHEXEC (0x10) /* Mispredicted or not predicted branch speculatively executed */
+#define PMETSR_CYCLES                 (0x11) /* Cycle */
 #define PMETSR_PREDICTEDBRANCHEXEC    (0x12) /* Predictable branch speculatively executed */
 #define PMETSR_DATAMEMACC             (0x13) /* Data memory access. */
 #define PMETSR_ICACC                  (0x14) /* Instruction Cache access. */
@@ -135,5 +135,11 @@ void up_initialize(void)
   /* Initialize the L2 cache if present and selected */
 
   arm_l2ccinitialize();
+
+#ifdef CONFIG_ARMV7M_STACKGUARD
+  /* Protect the bottom of the stacks with an MPU region from now on */
+
+  arm_stackguard_initialize();
+#endif
   board_autoled_on(LED_IRQSENABLED);
 }
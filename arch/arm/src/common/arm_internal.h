@@ -304,6 +304,15 @@ int  arm_securefault(int irq, void *context, void *arg);
 
 #  endif /* CONFIG_ARCH_CORTEXM3,4,7 */
 
+/* MPU stack guard */
+
+#  ifdef CONFIG_ARMV7M_STACKGUARD
+struct tcb_s;
+void arm_stackguard_initialize(void);
+void arm_stackguard_switch(struct tcb_s *tcb);
+bool arm_stackguard_report(uint32_t cfsr);
+#  endif
+
 /* Exception handling logic unique to the Cortex-A and Cortex-R families
 * (but should be back-ported to the ARM7 and ARM9 families).
  */
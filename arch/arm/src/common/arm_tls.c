@@ -28,6 +28,36 @@
 
 #include "arm_internal.h"
 
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+void *__aeabi_read_tp(void) naked_function;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: arm_tls_pointer
+ *
+ * Description:
+ *   Return the thread pointer: the TLS data follows the TLS information
+ *   at the bottom of the stack.  In the FLAT build with CONFIG_TLS_ALIGNED
+ *   the threads always run on the stack that holds their TLS, so it is
+ *   found by masking the stack pointer and no OS interface is called.
+ *
+ ****************************************************************************/
+
+static used_code void *arm_tls_pointer(void)
+{
+#if defined(CONFIG_TLS_ALIGNED) && defined(CONFIG_BUILD_FLAT)
+  return (void *)(TLS_INFO((uintptr_t)up_getsp()) + 1);
+#else
+  return (void *)(tls_get_info() + 1);
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -82,9 +112,18 @@ void up_tls_initialize(struct tls_info_s *info)
  * Description:
  *   Read thread local storage region pointer.
  *
+ *   The run-time ABI lets callers of __aeabi_read_tp() assume that only
+ *   R0, IP, LR and the flags are changed, so the C helper must be called
+ *   with R1-R3 preserved.
+ *
  ****************************************************************************/
 
 void *__aeabi_read_tp(void)
 {
-  return (void *)(tls_get_info() + 1);
+  __asm__ __volatile__
+    (
+      " push {r1-r3, lr}\n"
+      " bl   arm_tls_pointer\n"
+      " pop  {r1-r3, pc}\n"
+    );
 }
@@ -449,7 +449,7 @@ static void cxd56_geofence_sighandler(uint32_t data, void *userdata)
         {
           fds->revents |= POLLIN;
           gnssinfo("Report events: %08" PRIx32 "\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 
@@ -2392,7 +2392,7 @@ static void cxd56_gnss_default_sighandler(uint32_t data, void *userdata)
         {
           fds->revents |= POLLIN;
           gnssinfo("Report events: %08" PRIx32 "\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 
@@ -548,7 +548,7 @@ static int stm32_bbsram_poll(struct file *filep, struct pollfd *fds,
       fds->revents |= (fds->events & (POLLIN | POLLOUT));
       if (fds->revents != 0)
         {
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 
@@ -472,6 +472,10 @@ void weak_function arm_dma_initialize(void)
 
       up_enable_irq(dmast->irq);
     }
+
+#ifdef CONFIG_STM32F7_DMAENGINE
+  stm32_dmaengine_initialize();
+#endif
 }
 
 /****************************************************************************
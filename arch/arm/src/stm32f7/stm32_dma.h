@@ -281,6 +281,19 @@ void stm32_dmadump(DMA_HANDLE handle, const struct stm32_dmaregs_s *regs,
 #  define stm32_dmadump(handle,regs,msg)
 #endif
 
+/****************************************************************************
+ * Name: stm32_dmaengine_initialize
+ *
+ * Description:
+ *   Register the DMA streams with the DMA engine framework.  The channel
+ *   ident passed to dmaengine_request() is a DMAMAP_* value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_STM32F7_DMAENGINE
+void stm32_dmaengine_initialize(void);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
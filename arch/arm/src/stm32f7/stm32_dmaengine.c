@@ -0,0 +1,400 @@
+/****************************************************************************
+ * arch/arm/src/stm32f7/stm32_dmaengine.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/dmaengine.h>
+
+#include "stm32_dma.h"
+
+#ifdef CONFIG_STM32F7_DMAENGINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The stream counts at most 65535 data items */
+
+#define DMAENGINE_MAXTRANSFERS 65535
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct stm32_dmaengine_chan_s
+{
+  struct dmaengine_chan_s chan;  /* Must be first */
+  DMA_HANDLE handle;             /* The stream from stm32_dmachannel() */
+  uint32_t scr;                  /* SCR value for the configuration */
+  uint32_t width;                /* Data item width in bytes */
+  bool cyclic;                   /* A cyclic transfer is prepared */
+  bool half;                     /* Interrupt at the half way point too */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static FAR struct dmaengine_chan_s *
+stm32_dmaengine_request(FAR struct dmaengine_dev_s *dev,
+                        unsigned int ident);
+static void stm32_dmaengine_release(FAR struct dmaengine_dev_s *dev,
+                                    FAR struct dmaengine_chan_s *chan);
+
+static int stm32_dmaengine_config(FAR struct dmaengine_chan_s *chan,
+                                  FAR const struct dmaengine_config_s *cfg);
+static int stm32_dmaengine_prep(FAR struct dmaengine_chan_s *chan,
+                                FAR const struct dmaengine_desc_s *desc);
+static int stm32_dmaengine_start(FAR struct dmaengine_chan_s *chan);
+static int stm32_dmaengine_stop(FAR struct dmaengine_chan_s *chan);
+static size_t stm32_dmaengine_residue(FAR struct dmaengine_chan_s *chan);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct dmaengine_ops_s g_stm32_dmaengine_ops =
+{
+  .config  = stm32_dmaengine_config,
+  .prep    = stm32_dmaengine_prep,
+  .start   = stm32_dmaengine_start,
+  .stop    = stm32_dmaengine_stop,
+  .residue = stm32_dmaengine_residue,
+};
+
+static const struct dmaengine_devops_s g_stm32_dmaengine_devops =
+{
+  .request = stm32_dmaengine_request,
+  .release = stm32_dmaengine_release,
+};
+
+/* The streams chain no descriptors and cannot be suspended:  The framework
+ * issues scatter-gather lists one segment at a time.
+ */
+
+static struct dmaengine_dev_s g_stm32_dmaengine =
+{
+  .ops  = &g_stm32_dmaengine_devops,
+  .caps = DMAENGINE_CAP_CYCLIC | DMAENGINE_CAP_MEMCPY,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: stm32_dmaengine_callback
+ *
+ * Description:
+ *   The stream interrupt callback.
+ *
+ ****************************************************************************/
+
+static void stm32_dmaengine_callback(DMA_HANDLE handle, uint8_t status,
+                                     FAR void *arg)
+{
+  FAR struct stm32_dmaengine_chan_s *priv = arg;
+  int result = OK;
+
+  if ((status & DMA_STATUS_ERROR) != 0)
+    {
+      result = -EIO;
+    }
+  else if (priv->cyclic)
+    {
+      result = DMAENGINE_PERIOD;
+    }
+
+  dmaengine_complete(&priv->chan, result);
+}
+
+/****************************************************************************
+ * Name: stm32_dmaengine_request
+ *
+ * Description:
+ *   Allocate the stream/channel given by a DMAMAP_* value.  Waits if the
+ *   stream is in use.
+ *
+ ****************************************************************************/
+
+static FAR struct dmaengine_chan_s *
+stm32_dmaengine_request(FAR struct dmaengine_dev_s *dev,
+                        unsigned int ident)
+{
+  FAR struct stm32_dmaengine_chan_s *priv;
+
+  priv = kmm_zalloc(sizeof(struct stm32_dmaengine_chan_s));
+  if (priv == NULL)
+    {
+      return NULL;
+    }
+
+  priv->handle   = stm32_dmachannel(ident);
+  priv->chan.ops = &g_stm32_dmaengine_ops;
+  return &priv->chan;
+}
+
+/****************************************************************************
+ * Name: stm32_dmaengine_release
+ ****************************************************************************/
+
+static void stm32_dmaengine_release(FAR struct dmaengine_dev_s *dev,
+                                    FAR struct dmaengine_chan_s *chan)
+{
+  FAR struct stm32_dmaengine_chan_s *priv =
+    (FAR struct stm32_dmaengine_chan_s *)chan;
+
+  stm32_dmafree(priv->handle);
+  kmm_free(priv);
+}
+
+/****************************************************************************
+ * Name: stm32_dmaengine_config
+ *
+ * Description:
+ *   Translate the channel configuration into an SCR value.
+ *
+ ****************************************************************************/
+
+static int stm32_dmaengine_config(FAR struct dmaengine_chan_s *chan,
+                                  FAR const struct dmaengine_config_s *cfg)
+{
+  FAR struct stm32_dmaengine_chan_s *priv =
+    (FAR struct stm32_dmaengine_chan_s *)chan;
+  uint32_t scr;
+
+  switch (cfg->dir)
+    {
+      case DMAENGINE_MEM_TO_DEV:
+        scr = DMA_SCR_DIR_M2P | DMA_SCR_MINC;
+        break;
+
+      case DMAENGINE_DEV_TO_MEM:
+        scr = DMA_SCR_DIR_P2M | DMA_SCR_MINC;
+        break;
+
+      case DMAENGINE_MEM_TO_MEM:
+        scr = DMA_SCR_DIR_M2M | DMA_SCR_MINC | DMA_SCR_PINC;
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  switch (cfg->width)
+    {
+      case 1:
+        scr |= DMA_SCR_PSIZE_8BITS | DMA_SCR_MSIZE_8BITS;
+        break;
+
+      case 2:
+        scr |= DMA_SCR_PSIZE_16BITS | DMA_SCR_MSIZE_16BITS;
+        break;
+
+      case 4:
+        scr |= DMA_SCR_PSIZE_32BITS | DMA_SCR_MSIZE_32BITS;
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  switch (cfg->priority)
+    {
+      case 0:
+        scr |= DMA_SCR_PRILO;
+        break;
+
+      case 1:
+        scr |= DMA_SCR_PRIMED;
+        break;
+
+      case 2:
+        scr |= DMA_SCR_PRIHI;
+        break;
+
+      default:
+        scr |= DMA_SCR_PRIVERYHI;
+        break;
+    }
+
+  /* Bursts are not used:  stm32_dmasetup() selects the FIFO threshold and
+   * that would have to agree with the memory burst size.
+   */
+
+  priv->scr   = scr;
+  priv->width = cfg->width;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: stm32_dmaengine_prep
+ *
+ * Description:
+ *   Program the stream for one contiguous transfer.
+ *
+ ****************************************************************************/
+
+static int stm32_dmaengine_prep(FAR struct dmaengine_chan_s *chan,
+                                FAR const struct dmaengine_desc_s *desc)
+{
+  FAR struct stm32_dmaengine_chan_s *priv =
+    (FAR struct stm32_dmaengine_chan_s *)chan;
+  uint32_t scr = priv->scr;
+  uint32_t paddr;
+  uint32_t maddr;
+  size_t ntransfers;
+
+  if (desc->len % priv->width != 0)
+    {
+      return -EINVAL;
+    }
+
+  ntransfers = desc->len / priv->width;
+  if (ntransfers > DMAENGINE_MAXTRANSFERS)
+    {
+      return -E2BIG;
+    }
+
+  priv->cyclic = false;
+  priv->half   = false;
+
+  switch (desc->type)
+    {
+      case DMAENGINE_CYCLIC:
+
+        /* The stream interrupts at the end of the buffer and, optionally,
+         * half way through it.  Those are the only periods possible.
+         */
+
+        if (desc->period != desc->len && desc->period * 2 != desc->len)
+          {
+            return -EINVAL;
+          }
+
+        scr         |= DMA_SCR_CIRC;
+        priv->cyclic = true;
+        priv->half   = desc->period != desc->len;
+
+        /* Fall through */
+
+      case DMAENGINE_SINGLE:
+        if (chan->config.dir == DMAENGINE_DEV_TO_MEM)
+          {
+            paddr = desc->src;
+            maddr = desc->dst;
+          }
+        else
+          {
+            paddr = desc->dst;
+            maddr = desc->src;
+          }
+        break;
+
+      case DMAENGINE_MEMCPY:
+
+        /* In memory-to-memory mode the peripheral port is the source */
+
+        paddr = desc->src;
+        maddr = desc->dst;
+        break;
+
+      default:
+        return -ENOSYS;
+    }
+
+  stm32_dmasetup(priv->handle, paddr, maddr, ntransfers, scr);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: stm32_dmaengine_start
+ ****************************************************************************/
+
+static int stm32_dmaengine_start(FAR struct dmaengine_chan_s *chan)
+{
+  FAR struct stm32_dmaengine_chan_s *priv =
+    (FAR struct stm32_dmaengine_chan_s *)chan;
+
+  stm32_dmastart(priv->handle, stm32_dmaengine_callback, priv, priv->half);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: stm32_dmaengine_stop
+ ****************************************************************************/
+
+static int stm32_dmaengine_stop(FAR struct dmaengine_chan_s *chan)
+{
+  FAR struct stm32_dmaengine_chan_s *priv =
+    (FAR struct stm32_dmaengine_chan_s *)chan;
+
+  stm32_dmastop(priv->handle);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: stm32_dmaengine_residue
+ ****************************************************************************/
+
+static size_t stm32_dmaengine_residue(FAR struct dmaengine_chan_s *chan)
+{
+  FAR struct stm32_dmaengine_chan_s *priv =
+    (FAR struct stm32_dmaengine_chan_s *)chan;
+
+  return stm32_dmaresidual(priv->handle) * priv->width;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: stm32_dmaengine_initialize
+ *
+ * Description:
+ *   Register the DMA streams with the DMA engine framework.  Called from
+ *   arm_dma_initialize().
+ *
+ ****************************************************************************/
+
+void stm32_dmaengine_initialize(void)
+{
+  int devno;
+
+  devno = dmaengine_register(&g_stm32_dmaengine);
+  if (devno < 0)
+    {
+      dmaerr("ERROR: dmaengine_register failed: %d\n", devno);
+    }
+}
+
+#endif /* CONFIG_STM32F7_DMAENGINE */
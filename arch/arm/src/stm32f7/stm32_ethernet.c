@@ -37,6 +37,7 @@
 #include <arpa/inet.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/dma.h>
 #include <nuttx/irq.h>
 #include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
@@ -1086,8 +1087,7 @@ static int stm32_transmit(struct stm32_ethmac_s *priv)
 
   /* Flush the contents of the TX buffer into physical memory */
 
-  up_clean_dcache((uintptr_t)priv->dev.d_buf,
-                  (uintptr_t)priv->dev.d_buf + priv->dev.d_len);
+  dma_sync_for_device(priv->dev.d_buf, priv->dev.d_len, DMA_TO_DEVICE);
 
   /* Is the size to be sent greater than the size of the Ethernet buffer? */
 
@@ -1741,8 +1741,9 @@ static int stm32_recvframe(struct stm32_ethmac_s *priv)
                    * physical memory.
                    */
 
-                  up_invalidate_dcache((uintptr_t)dev->d_buf,
-                                       min(dev->d_len, ALIGNED_BUFSIZE));
+                  dma_sync_for_cpu(dev->d_buf,
+                                   min(dev->d_len, ALIGNED_BUFSIZE),
+                                   DMA_FROM_DEVICE);
 
                   ninfo("rxhead: %p d_buf: %p d_len: %d\n",
                         priv->rxhead, dev->d_buf, dev->d_len);
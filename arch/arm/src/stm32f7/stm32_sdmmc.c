@@ -33,6 +33,7 @@
 #include <errno.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/dma.h>
 #include <nuttx/wdog.h>
 #include <nuttx/clock.h>
 #include <nuttx/sdio.h>
@@ -1571,8 +1572,8 @@ static void stm32_endtransfer(struct stm32_dev_s *priv,
 
       if (priv->rxbuffer)
         {
-          up_invalidate_dcache((uintptr_t)priv->rxbuffer,
-                               (uintptr_t)priv->rxend);
+          dma_sync_for_cpu(priv->rxbuffer, priv->rxend - priv->rxbuffer,
+                           DMA_FROM_DEVICE);
           priv->rxbuffer = 0;
         }
     }
@@ -3063,8 +3064,7 @@ static int stm32_dmarecvsetup(struct sdio_dev_s *dev,
    * ARMV7M_DCACHE_LINESIZE boundaries.
    */
 
-  if (((uintptr_t)buffer & (ARMV7M_DCACHE_LINESIZE - 1)) != 0 ||
-      (buflen & (ARMV7M_DCACHE_LINESIZE - 1)) != 0)
+  if (!dma_aligned(buffer, buflen))
     {
       return -EFAULT;
     }
@@ -3114,8 +3114,7 @@ static int stm32_dmarecvsetup(struct sdio_dev_s *dev,
     {
       priv->rxbuffer = buffer;
       priv->rxend    = buffer + buflen;
-      up_invalidate_dcache((uintptr_t)priv->rxbuffer,
-                           (uintptr_t)priv->rxend);
+      dma_sync_for_device(buffer, buflen, DMA_FROM_DEVICE);
     }
 
   /* Start the DMA */
@@ -3166,8 +3165,7 @@ static int stm32_dmasendsetup(struct sdio_dev_s *dev,
    * ARMV7M_DCACHE_LINESIZE boundaries.
    */
 
-  if (((uintptr_t)buffer & (ARMV7M_DCACHE_LINESIZE - 1)) != 0 ||
-      (buflen & (ARMV7M_DCACHE_LINESIZE - 1)) != 0)
+  if (!dma_aligned(buffer, buflen))
     {
       return -EFAULT;
     }
@@ -3188,7 +3186,7 @@ static int stm32_dmasendsetup(struct sdio_dev_s *dev,
   if ((uintptr_t)buffer < DTCM_START ||
       (uintptr_t)buffer + buflen > DTCM_END)
     {
-      up_clean_dcache((uintptr_t)buffer, (uintptr_t)buffer + buflen);
+      dma_sync_for_device(buffer, buflen, DMA_TO_DEVICE);
     }
 
   /* Save the source buffer information for use by the interrupt handler */
@@ -35,6 +35,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/dma.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/serial/serial.h>
 #include <nuttx/power/pm.h>
@@ -2966,7 +2967,6 @@ static int up_dma_receive(struct uart_dev_s *dev, unsigned int *status)
       if (priv->rxdmaavail == 0)
         {
           uint32_t rxdmaavail;
-          uintptr_t addr;
 
           /* No.. then we will have to invalidate additional space in the Rx
            * DMA buffer.
@@ -2987,8 +2987,8 @@ static int up_dma_receive(struct uart_dev_s *dev, unsigned int *status)
 
           /* Invalidate the DMA buffer range */
 
-          addr = (uintptr_t)&priv->rxfifo[priv->rxdmanext];
-          up_invalidate_dcache(addr, addr + rxdmaavail);
+          dma_sync_for_cpu(&priv->rxfifo[priv->rxdmanext], rxdmaavail,
+                           DMA_FROM_DEVICE);
 
           /* We don't need to invalidate the data cache for the next
            * rxdmaavail number of next bytes.
@@ -3209,8 +3209,8 @@ static void up_dma_send(struct uart_dev_s *dev)
 
   /* Flush the contents of the TX buffer into physical memory */
 
-  up_clean_dcache((uintptr_t)dev->dmatx.buffer,
-                  (uintptr_t)dev->dmatx.buffer + dev->dmatx.length);
+  dma_sync_for_device(dev->dmatx.buffer, dev->dmatx.length,
+                      DMA_TO_DEVICE);
 
   /* Is this a split transfer */
 
@@ -3218,8 +3218,8 @@ static void up_dma_send(struct uart_dev_s *dev)
     {
       /* Flush the contents of the next TX buffer into physical memory */
 
-      up_clean_dcache((uintptr_t)dev->dmatx.nbuffer,
-                      (uintptr_t)dev->dmatx.nbuffer + dev->dmatx.nlength);
+      dma_sync_for_device(dev->dmatx.nbuffer, dev->dmatx.nlength,
+                          DMA_TO_DEVICE);
     }
 
   /* Make use of setup function to update buffer and its length for next
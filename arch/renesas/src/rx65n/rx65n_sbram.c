@@ -492,7 +492,7 @@ static int rx65n_sbram_poll(FAR struct file *filep, FAR struct pollfd *fds,
       fds->revents |= (fds->events & (POLLIN | POLLOUT));
       if (fds->revents != 0)
         {
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 
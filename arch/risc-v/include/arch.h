@@ -99,6 +99,32 @@ static inline uintptr_t up_getsp(void)
   return sp;
 }
 
+/****************************************************************************
+ * Name: up_gettp
+ ****************************************************************************/
+
+static inline uintptr_t up_gettp(void)
+{
+  register uintptr_t tp;
+  __asm__
+  (
+    "\tadd  %0, x0, x4\n"
+    : "=r"(tp)
+  );
+  return tp;
+}
+
+/* With CONFIG_SCHED_THREAD_LOCAL, the thread pointer of every thread
+ * points just after its TLS information, see up_initial_state(), so that
+ * it is found with a register read.  The idle threads of the other CPUs
+ * start before their thread pointer could be set, hence the restriction
+ * to a single CPU.
+ */
+
+#if defined(CONFIG_SCHED_THREAD_LOCAL) && !defined(CONFIG_SMP)
+#  define up_tls_info() ((FAR struct tls_info_s *)up_gettp() - 1)
+#endif
+
 #endif
 
 /****************************************************************************
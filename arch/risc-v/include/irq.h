@@ -594,6 +594,14 @@ extern "C"
 EXTERN volatile uintptr_t *g_current_regs[CONFIG_SMP_NCPUS];
 #define CURRENT_REGS (g_current_regs[up_cpu_index()])
 
+/* Return the PC saved in 'regs' or, if NULL, the PC interrupted by the
+ * interrupt currently being processed.
+ */
+
+#define up_getusrpc(regs) \
+  ((uintptr_t)((regs) != NULL ? (FAR volatile uintptr_t *)(regs) : \
+               CURRENT_REGS)[REG_EPC])
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
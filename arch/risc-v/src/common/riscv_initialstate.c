@@ -77,6 +77,19 @@ void up_initial_state(struct tcb_s *tcb)
 
       riscv_stack_color(tcb->stack_alloc_ptr, 0);
 #endif /* CONFIG_STACK_COLORATION */
+
+#if defined(CONFIG_SCHED_THREAD_LOCAL) && !defined(CONFIG_SMP)
+      /* The idle thread is the one running now: load its thread pointer
+       * directly, it will be saved with the rest of its context.
+       */
+
+      __asm__ __volatile__
+      (
+        "\tadd  x4, x0, %0\n"
+        :
+        : "r"((uintptr_t)tcb->stack_alloc_ptr + sizeof(struct tls_info_s))
+      );
+#endif
       return;
     }
 
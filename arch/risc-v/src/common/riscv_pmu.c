@@ -0,0 +1,181 @@
+/****************************************************************************
+ * arch/risc-v/src/common/riscv_pmu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/pmu.h>
+
+#include "riscv_internal.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The counters 0-3 are mapped on mhpmcounter3-6.  The events of these
+ * counters are implementation-defined, so they can only be selected with
+ * raw events (the value written to mhpmevent).  Cycles and instructions
+ * are read from mcycle and minstret instead.
+ */
+
+#define RISCV_PMU_NCOUNTERS  4
+
+#define RISCV_PMU_STOPPED    0
+#define RISCV_PMU_HPM        1
+#define RISCV_PMU_CYCLE      2
+#define RISCV_PMU_INSTRET    3
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint8_t g_pmu_source[RISCV_PMU_NCOUNTERS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: riscv_pmu_setevent
+ ****************************************************************************/
+
+static void riscv_pmu_setevent(int counter, uintptr_t event)
+{
+  switch (counter)
+    {
+      case 0:
+        WRITE_CSR(CSR_MPHEVENT3, event);
+        break;
+
+      case 1:
+        WRITE_CSR(CSR_MPHEVENT4, event);
+        break;
+
+      case 2:
+        WRITE_CSR(CSR_MPHEVENT5, event);
+        break;
+
+      case 3:
+        WRITE_CSR(CSR_MPHEVENT6, event);
+        break;
+    }
+}
+
+/****************************************************************************
+ * Name: riscv_pmu_gethpm
+ ****************************************************************************/
+
+static uintptr_t riscv_pmu_gethpm(int counter)
+{
+  switch (counter)
+    {
+      case 0:
+        return READ_CSR(CSR_MHPMCOUNTER3);
+
+      case 1:
+        return READ_CSR(CSR_MHPMCOUNTER4);
+
+      case 2:
+        return READ_CSR(CSR_MHPMCOUNTER5);
+
+      case 3:
+        return READ_CSR(CSR_MHPMCOUNTER6);
+
+      default:
+        return 0;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_pmu_*
+ *
+ * Description:
+ *   The hardware performance monitor counters.  These are machine mode
+ *   registers, so this is only available without CONFIG_ARCH_USE_S_MODE.
+ *
+ ****************************************************************************/
+
+int up_pmu_ncounters(void)
+{
+  return RISCV_PMU_NCOUNTERS;
+}
+
+int up_pmu_config(int counter, uint32_t event)
+{
+  uint8_t source;
+
+  if (event == PMU_EVENT_NONE)
+    {
+      source = RISCV_PMU_STOPPED;
+    }
+  else if (event == PMU_EVENT_CYCLES)
+    {
+      source = RISCV_PMU_CYCLE;
+    }
+  else if (event == PMU_EVENT_INSTRUCTIONS)
+    {
+      source = RISCV_PMU_INSTRET;
+    }
+  else if (PMU_EVENT_ISRAW(event))
+    {
+      source = RISCV_PMU_HPM;
+    }
+  else
+    {
+      return -ENOTSUP;
+    }
+
+  /* Stop the hardware counter if it is not used */
+
+  riscv_pmu_setevent(counter, source == RISCV_PMU_HPM ?
+                              PMU_EVENT_RAWNUM(event) : 0);
+
+  g_pmu_source[counter] = source;
+  return 32;
+}
+
+uint32_t up_pmu_read(int counter)
+{
+  switch (g_pmu_source[counter])
+    {
+      case RISCV_PMU_HPM:
+        return riscv_pmu_gethpm(counter);
+
+      case RISCV_PMU_CYCLE:
+        return READ_CSR(CSR_MCYCLE);
+
+      case RISCV_PMU_INSTRET:
+        return READ_CSR(CSR_MINSTRET);
+
+      default:
+        return 0;
+    }
+}
@@ -24,6 +24,7 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <sys/statvfs.h>
 #include <sys/ioctl.h>
 
@@ -660,3 +661,34 @@ int host_chstat(const char *path, const struct nuttx_stat_s *buf, int flags)
 
   return 0;
 }
+
+/****************************************************************************
+ * Name: host_mmap
+ ****************************************************************************/
+
+void *host_mmap(int fd, nuttx_size_t length)
+{
+  void *addr;
+
+  /* Map the file privately and read-only from its beginning */
+
+  addr = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  return addr == MAP_FAILED ? NULL : addr;
+}
+
+/****************************************************************************
+ * Name: host_munmap
+ ****************************************************************************/
+
+int host_munmap(void *addr, nuttx_size_t length)
+{
+  int ret;
+
+  ret = munmap(addr, length);
+  if (ret < 0)
+    {
+      return -errno;
+    }
+
+  return 0;
+}
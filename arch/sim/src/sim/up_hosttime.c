@@ -32,6 +32,42 @@
 
 #include "up_internal.h"
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Host CLOCK_MONOTONIC time of the simulation time zero */
+
+static uint64_t g_start;
+
+#ifndef __APPLE__
+/* The host one-shot timer used by host_setalarm() */
+
+static timer_t g_alarm_timer;
+static bool g_alarm_created;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: host_abstime
+ *
+ * Description:
+ *   Convert a simulation time to an absolute host CLOCK_MONOTONIC time.
+ *
+ ****************************************************************************/
+
+#ifndef __APPLE__
+static void host_abstime(uint64_t nsec, struct timespec *ts)
+{
+  nsec += g_start;
+  ts->tv_sec  = nsec / 1000000000ull;
+  ts->tv_nsec = nsec % 1000000000ull;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -42,7 +78,6 @@
 
 uint64_t host_gettime(bool rtc)
 {
-  static uint64_t start;
   struct timespec tp;
   uint64_t current;
 
@@ -54,12 +89,12 @@ uint64_t host_gettime(bool rtc)
       return current;
     }
 
-  if (start == 0)
+  if (g_start == 0)
     {
-      start = current;
+      g_start = current;
     }
 
-  return current - start;
+  return current - g_start;
 }
 
 /****************************************************************************
@@ -77,6 +112,7 @@ void host_sleep(uint64_t nsec)
 
 void host_sleepuntil(uint64_t nsec)
 {
+#ifdef __APPLE__
   uint64_t now;
 
   now = host_gettime(false);
@@ -84,6 +120,18 @@ void host_sleepuntil(uint64_t nsec)
     {
       usleep((nsec - now) / 1000);
     }
+#else
+  struct timespec ts;
+
+  /* Sleep on the absolute host time so that the wake-up time does not
+   * drift by the time spent getting here.  A signal (an interrupt or an
+   * IPI) ends the sleep early.
+   */
+
+  host_gettime(false);
+  host_abstime(nsec, &ts);
+  clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+#endif
 }
 
 /****************************************************************************
@@ -119,3 +167,56 @@ int host_settimer(int *irq)
 
   return setitimer(ITIMER_REAL, &it, NULL);
 }
+
+/****************************************************************************
+ * Name: host_setalarm
+ *
+ * Description:
+ *   Arm a host one-shot timer that sends SIGALRM at the given simulation
+ *   time.  An alarm that is already armed is replaced.
+ *
+ * Input Parameters:
+ *   nsec - The simulation time of the alarm in nanoseconds
+ *
+ * Returned Value:
+ *   On success, (0) zero value is returned, otherwise a negative value.
+ *
+ ****************************************************************************/
+
+int host_setalarm(uint64_t nsec)
+{
+#ifdef __APPLE__
+  return -ENOSYS;
+#else
+  struct itimerspec its;
+  struct sigevent sev;
+
+  if (!g_alarm_created)
+    {
+      sev.sigev_notify = SIGEV_SIGNAL;
+      sev.sigev_signo  = SIGALRM;
+      sev.sigev_value.sival_ptr = NULL;
+
+      if (timer_create(CLOCK_MONOTONIC, &sev, &g_alarm_timer) < 0)
+        {
+          return -errno;
+        }
+
+      g_alarm_created = true;
+    }
+
+  /* A zero it_value would disarm the timer, so never ask for time zero */
+
+  host_gettime(false);
+  host_abstime(nsec > 0 ? nsec : 1, &its.it_value);
+  its.it_interval.tv_sec  = 0;
+  its.it_interval.tv_nsec = 0;
+
+  if (timer_settime(g_alarm_timer, TIMER_ABSTIME, &its, NULL) < 0)
+    {
+      return -errno;
+    }
+
+  return 0;
+#endif
+}
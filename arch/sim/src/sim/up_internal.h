@@ -163,6 +163,7 @@ uint64_t host_gettime(bool rtc);
 void host_sleep(uint64_t nsec);
 void host_sleepuntil(uint64_t nsec);
 int host_settimer(int *irq);
+int host_setalarm(uint64_t nsec);
 
 /* up_sigdeliver.c **********************************************************/
 
@@ -122,6 +122,39 @@ static inline void sim_timer_current(struct timespec *ts)
   ts->tv_nsec = nsec;
 }
 
+/****************************************************************************
+ * Name: sim_timer_next
+ *
+ * Description:
+ *   Return the host time in nanoseconds of the earliest armed alarm, or
+ *   UINT64_MAX if no alarm is armed.
+ *
+ ****************************************************************************/
+
+static uint64_t sim_timer_next(void)
+{
+  struct sim_oneshot_lowerhalf_s *priv;
+  sq_entry_t *entry;
+  uint64_t next = UINT64_MAX;
+  uint64_t alarm;
+
+  for (entry = sq_peek(&g_oneshot_list); entry; entry = sq_next(entry))
+    {
+      priv = container_of(entry, struct sim_oneshot_lowerhalf_s, link);
+      if (priv->callback != NULL)
+        {
+          alarm = (uint64_t)priv->alarm.tv_sec * NSEC_PER_SEC +
+                  priv->alarm.tv_nsec;
+          if (alarm < next)
+            {
+              next = alarm;
+            }
+        }
+    }
+
+  return next;
+}
+
 /****************************************************************************
  * Name: sim_timer_update
  *
@@ -253,6 +286,14 @@ static int sim_start(struct oneshot_lowerhalf_s *lower,
   priv->callback = callback;
   priv->arg      = arg;
 
+#ifdef CONFIG_SIM_WALLTIME_SIGNAL
+  /* Have the host deliver the alarm when it is due instead of on the
+   * next periodic tick.
+   */
+
+  host_setalarm(sim_timer_next());
+#endif
+
   return OK;
 }
 
@@ -438,13 +479,27 @@ void up_timer_initialize(void)
 void up_timer_update(void)
 {
   static uint64_t until;
+#ifdef CONFIG_SIM_WALLTIME_SLEEP
+  uint64_t next;
+#endif
 
-  /* Wait a bit so that the timing is close to the correct rate. */
+  /* Wait a bit so that the timing is close to the correct rate.   Only
+   * advance the cadence once it has been reached:  A sleep that was cut
+   * short by an interrupt must not push the next tick out.
+   */
 
-  until += NSEC_PER_TICK;
-  host_sleepuntil(until);
+  if (until <= host_gettime(false))
+    {
+      until += NSEC_PER_TICK;
+    }
 
 #ifdef CONFIG_SIM_WALLTIME_SLEEP
+  /* But wake up on time for an alarm that is due before the next tick */
+
+  next = sim_timer_next();
+  host_sleepuntil(next < until ? next : until);
   sim_timer_update();
+#else
+  host_sleepuntil(until);
 #endif
 }
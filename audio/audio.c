@@ -36,6 +36,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mqueue.h>
 #include <nuttx/arch.h>
@@ -76,6 +77,7 @@ struct audio_upperhalf_s
   sem_t             exclsem;          /* Supports mutual exclusion */
   FAR struct audio_lowerhalf_s *dev;  /* lower-half state */
   struct file      *usermq;           /* User mode app's message queue */
+  struct audio_stats_s stats;         /* Buffer statistics of the stream */
 };
 
 /****************************************************************************
@@ -335,9 +337,16 @@ static int audio_start(FAR struct audio_upperhalf_s *upper)
 
       if (ret == OK)
         {
+          irqstate_t flags;
+
           /* Indicate that the audio stream has started */
 
+          flags = enter_critical_section();
+          upper->stats.nperiods  = 0;
+          upper->stats.nxruns    = 0;
+          upper->stats.minqueued = upper->stats.nqueued;
           upper->started = true;
+          leave_critical_section(flags);
         }
     }
 
@@ -361,6 +370,7 @@ static int audio_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 #ifdef CONFIG_AUDIO_MULTI_SESSION
   FAR void *session;
 #endif
+  irqstate_t flags;
   int ret;
 
   audinfo("cmd: %d arg: %ld\n", cmd, arg);
@@ -462,13 +472,17 @@ static int audio_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
           if (upper->started)
             {
+              /* Clear started first so that the buffers returned by the
+               * stop are not counted as xruns.
+               */
+
+              upper->started = false;
 #ifdef CONFIG_AUDIO_MULTI_SESSION
               session = (FAR void *) arg;
               ret = lower->ops->stop(lower, session);
 #else
               ret = lower->ops->stop(lower);
 #endif
-              upper->started = false;
             }
         }
         break;
@@ -582,7 +596,47 @@ static int audio_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
           DEBUGASSERT(lower->ops->enqueuebuffer != NULL);
 
           bufdesc = (FAR struct audio_buf_desc_s *) arg;
+
+          /* Count the buffer first, the lower half may return it before
+           * enqueuebuffer() does.
+           */
+
+          flags = enter_critical_section();
+          upper->stats.nqueued++;
+          leave_critical_section(flags);
+
           ret = lower->ops->enqueuebuffer(lower, bufdesc->u.buffer);
+          if (ret < 0)
+            {
+              flags = enter_critical_section();
+              upper->stats.nqueued--;
+              leave_critical_section(flags);
+            }
+        }
+        break;
+
+      /* AUDIOIOC_GETSTATS - Get the buffer statistics of the stream
+       *
+       *   ioctl argument:  pointer to an audio_stats_s structure
+       */
+
+      case AUDIOIOC_GETSTATS:
+        {
+          FAR struct audio_stats_s *stats =
+                     (FAR struct audio_stats_s *)((uintptr_t)arg);
+
+          audinfo("AUDIOIOC_GETSTATS\n");
+
+          if (stats == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          flags = enter_critical_section();
+          memcpy(stats, &upper->stats, sizeof(struct audio_stats_s));
+          leave_critical_section(flags);
+          ret = OK;
         }
         break;
 
@@ -712,9 +766,36 @@ static inline void audio_dequeuebuffer(FAR struct audio_upperhalf_s *upper,
 #endif
 {
   struct audio_msg_s    msg;
+  irqstate_t            flags;
 
   audinfo("Entry\n");
 
+  /* Update the statistics.  If the lower half has nothing left to process
+   * while the stream is running, the stream stalls: that is an xrun.
+   */
+
+  flags = enter_critical_section();
+  if (upper->stats.nqueued > 0)
+    {
+      upper->stats.nqueued--;
+    }
+
+  if (upper->started)
+    {
+      upper->stats.nperiods++;
+      if (upper->stats.nqueued < upper->stats.minqueued)
+        {
+          upper->stats.minqueued = upper->stats.nqueued;
+        }
+
+      if (upper->stats.nqueued == 0 && (apb->flags & AUDIO_APB_FINAL) == 0)
+        {
+          upper->stats.nxruns++;
+        }
+    }
+
+  leave_critical_section(flags);
+
   /* Send a dequeue message to the user if a message queue is registered */
 
   if (upper->usermq != NULL)
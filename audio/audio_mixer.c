@@ -0,0 +1,1205 @@
+/****************************************************************************
+ * audio/audio_mixer.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <queue.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/audio/audio.h>
+#include <nuttx/audio/audio_mixer.h>
+
+#ifdef CONFIG_AUDIO_MIXER
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) (((a) < (b)) ? (a) : (b))
+#endif
+
+/* Output stream format: signed, native endian 16-bit PCM */
+
+#define MIXER_NCHANNELS    CONFIG_AUDIO_MIXER_NCHANNELS
+#define MIXER_FRAMESIZE    (MIXER_NCHANNELS * sizeof(int16_t))
+#define MIXER_NFRAMES      (CONFIG_AUDIO_BUFFER_NUMBYTES / MIXER_FRAMESIZE)
+
+/* The resampler position and step are Q16 fixed point numbers of input
+ * frames.  The input gain is Q10 so that a volume of 1000 is unity.
+ */
+
+#define MIXER_ONE          (1 << 16)
+#define MIXER_GAIN_UNITY   (1 << 10)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct audio_mixer_s;
+
+/* This structure describes one input of the mixer.  Each input is an audio
+ * lower half of its own that a client (or a decoder such as the PCM
+ * decoder) feeds with buffers.
+ */
+
+struct audio_mixer_input_s
+{
+  /* This is is our appearance to the outside world.  This *MUST* be the
+   * first element of the structure so that we can freely cast between types
+   * struct audio_lowerhalf and struct audio_mixer_input_s.
+   */
+
+  struct audio_lowerhalf_s export;
+
+  FAR struct audio_mixer_s *mixer; /* The mixer that contains the input */
+  struct dq_queue_s queue;         /* Buffers enqueued by the client */
+  uint32_t step;                   /* Input frames per output frame, Q16 */
+  uint32_t phase;                  /* Position between prev and cur, Q16 */
+  int16_t  prev[MIXER_NCHANNELS];  /* The previous input frame */
+  int16_t  cur[MIXER_NCHANNELS];   /* The current input frame */
+  uint16_t gain;                   /* Volume of the input, Q10 */
+  uint8_t  nchannels;              /* Mono=1, Stereo=2 */
+  uint8_t  bpsamp;                 /* Bits per sample: 8 or 16 */
+  bool     reserved;               /* A client reserved the input */
+  bool     running;                /* The input is started */
+  bool     paused;                 /* The input is paused */
+  bool     final;                  /* The final buffer has been consumed */
+};
+
+/* This structure describes the state of the mixer */
+
+struct audio_mixer_s
+{
+  FAR struct audio_lowerhalf_s *lower;    /* The real output device */
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  FAR void *session;                      /* Session of the output device */
+#endif
+  FAR struct audio_mixer_input_s *inputs; /* Array of inputs */
+  FAR int32_t *accum;                     /* Mix accumulator, one period */
+  struct dq_queue_s freeq;                /* Output buffers not enqueued */
+  struct work_s work;                     /* Mixing work */
+  sem_t exclsem;                          /* Protects the mixer state */
+  uint8_t ninputs;                        /* Number of inputs */
+  uint8_t nreserved;                      /* Number of reserved inputs */
+  uint8_t nrunning;                       /* Number of started inputs */
+  volatile uint8_t noutstanding;          /* Buffers enqueued to lower */
+  bool started;                           /* The output device is started */
+
+  /* Output buffers */
+
+  FAR struct ap_buffer_s *apb[CONFIG_AUDIO_NUM_BUFFERS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Helper functions *********************************************************/
+
+static void audio_mixer_notify(FAR struct audio_mixer_input_s *in,
+                               uint16_t reason, FAR struct ap_buffer_s *apb,
+                               uint16_t status);
+static void audio_mixer_flush(FAR struct audio_mixer_input_s *in);
+static bool audio_mixer_nextframe(FAR struct audio_mixer_input_s *in);
+static void audio_mixer_resample(FAR struct audio_mixer_input_s *in,
+                                 FAR int32_t *accum, size_t nframes);
+static void audio_mixer_mix(FAR struct audio_mixer_s *mixer,
+                            FAR struct ap_buffer_s *apb);
+static bool audio_mixer_ready(FAR struct audio_mixer_s *mixer);
+static int  audio_mixer_startlower(FAR struct audio_mixer_s *mixer);
+static void audio_mixer_stoplower(FAR struct audio_mixer_s *mixer);
+static void audio_mixer_worker(FAR void *arg);
+
+/* struct audio_lowerhalf_s methods *****************************************/
+
+static int  audio_mixer_getcaps(FAR struct audio_lowerhalf_s *dev, int type,
+                                FAR struct audio_caps_s *caps);
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int  audio_mixer_configure(FAR struct audio_lowerhalf_s *dev,
+                                  FAR void *session,
+                                  FAR const struct audio_caps_s *caps);
+#else
+static int  audio_mixer_configure(FAR struct audio_lowerhalf_s *dev,
+                                  FAR const struct audio_caps_s *caps);
+#endif
+static int  audio_mixer_shutdown(FAR struct audio_lowerhalf_s *dev);
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int  audio_mixer_start(FAR struct audio_lowerhalf_s *dev,
+                              FAR void *session);
+#else
+static int  audio_mixer_start(FAR struct audio_lowerhalf_s *dev);
+#endif
+#ifndef CONFIG_AUDIO_EXCLUDE_STOP
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int  audio_mixer_stop(FAR struct audio_lowerhalf_s *dev,
+                             FAR void *session);
+#else
+static int  audio_mixer_stop(FAR struct audio_lowerhalf_s *dev);
+#endif
+#endif
+#ifndef CONFIG_AUDIO_EXCLUDE_PAUSE_RESUME
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int  audio_mixer_pause(FAR struct audio_lowerhalf_s *dev,
+                              FAR void *session);
+static int  audio_mixer_resume(FAR struct audio_lowerhalf_s *dev,
+                               FAR void *session);
+#else
+static int  audio_mixer_pause(FAR struct audio_lowerhalf_s *dev);
+static int  audio_mixer_resume(FAR struct audio_lowerhalf_s *dev);
+#endif
+#endif
+static int  audio_mixer_enqueuebuffer(FAR struct audio_lowerhalf_s *dev,
+                                      FAR struct ap_buffer_s *apb);
+static int  audio_mixer_cancelbuffer(FAR struct audio_lowerhalf_s *dev,
+                                     FAR struct ap_buffer_s *apb);
+static int  audio_mixer_ioctl(FAR struct audio_lowerhalf_s *dev, int cmd,
+                              unsigned long arg);
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int  audio_mixer_reserve(FAR struct audio_lowerhalf_s *dev,
+                                FAR void **session);
+static int  audio_mixer_release(FAR struct audio_lowerhalf_s *dev,
+                                FAR void *session);
+#else
+static int  audio_mixer_reserve(FAR struct audio_lowerhalf_s *dev);
+static int  audio_mixer_release(FAR struct audio_lowerhalf_s *dev);
+#endif
+
+/* Output device callback ***************************************************/
+
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static void audio_mixer_callback(FAR void *arg, uint16_t reason,
+                                 FAR struct ap_buffer_s *apb,
+                                 uint16_t status, FAR void *session);
+#else
+static void audio_mixer_callback(FAR void *arg, uint16_t reason,
+                                 FAR struct ap_buffer_s *apb,
+                                 uint16_t status);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct audio_ops_s g_audio_mixer_ops =
+{
+  audio_mixer_getcaps,       /* getcaps        */
+  audio_mixer_configure,     /* configure      */
+  audio_mixer_shutdown,      /* shutdown       */
+  audio_mixer_start,         /* start          */
+#ifndef CONFIG_AUDIO_EXCLUDE_STOP
+  audio_mixer_stop,          /* stop           */
+#endif
+#ifndef CONFIG_AUDIO_EXCLUDE_PAUSE_RESUME
+  audio_mixer_pause,         /* pause          */
+  audio_mixer_resume,        /* resume         */
+#endif
+  NULL,                      /* allocbuffer    */
+  NULL,                      /* freebuffer     */
+  audio_mixer_enqueuebuffer, /* enqueue_buffer */
+  audio_mixer_cancelbuffer,  /* cancel_buffer  */
+  audio_mixer_ioctl,         /* ioctl          */
+  NULL,                      /* read           */
+  NULL,                      /* write          */
+  audio_mixer_reserve,       /* reserve        */
+  audio_mixer_release        /* release        */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: audio_mixer_notify
+ *
+ * Description:
+ *   Send an event to the client of an input.
+ *
+ ****************************************************************************/
+
+static void audio_mixer_notify(FAR struct audio_mixer_input_s *in,
+                               uint16_t reason, FAR struct ap_buffer_s *apb,
+                               uint16_t status)
+{
+  if (in->export.upper != NULL)
+    {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+      in->export.upper(in->export.priv, reason, apb, status, in);
+#else
+      in->export.upper(in->export.priv, reason, apb, status);
+#endif
+    }
+}
+
+/****************************************************************************
+ * Name: audio_mixer_flush
+ *
+ * Description:
+ *   Return all of the buffers still enqueued on an input to its client.
+ *
+ ****************************************************************************/
+
+static void audio_mixer_flush(FAR struct audio_mixer_input_s *in)
+{
+  FAR struct ap_buffer_s *apb;
+
+  while ((apb = (FAR struct ap_buffer_s *)dq_remfirst(&in->queue)) != NULL)
+    {
+      audio_mixer_notify(in, AUDIO_CALLBACK_DEQUEUE, apb, OK);
+    }
+}
+
+/****************************************************************************
+ * Name: audio_mixer_nextframe
+ *
+ * Description:
+ *   Advance the resampler of an input by one input frame.  Client buffers
+ *   are consumed in place and returned as soon as they are used up.
+ *
+ * Returned Value:
+ *   true if a new frame is available; false if the input ran dry.
+ *
+ ****************************************************************************/
+
+static bool audio_mixer_nextframe(FAR struct audio_mixer_input_s *in)
+{
+  FAR struct ap_buffer_s *apb;
+  FAR const uint8_t *src;
+  int16_t samp[2];
+  unsigned int framesize;
+  unsigned int ch;
+
+  framesize = in->nchannels * (in->bpsamp >> 3);
+
+  for (; ; )
+    {
+      apb = (FAR struct ap_buffer_s *)dq_peek(&in->queue);
+      if (apb == NULL || in->final)
+        {
+          return false;
+        }
+
+      if (apb->curbyte + framesize <= apb->nbytes)
+        {
+          break;
+        }
+
+      /* This buffer is used up, give it back to the client */
+
+      dq_remfirst(&in->queue);
+      if ((apb->flags & AUDIO_APB_FINAL) != 0)
+        {
+          in->final = true;
+        }
+
+      audio_mixer_notify(in, AUDIO_CALLBACK_DEQUEUE, apb, OK);
+    }
+
+  src = &apb->samp[apb->curbyte];
+  apb->curbyte += framesize;
+
+  for (ch = 0; ch < in->nchannels; ch++)
+    {
+      if (in->bpsamp == 8)
+        {
+          samp[ch] = (int16_t)(((int)src[ch] - 128) << 8);
+        }
+      else
+        {
+          samp[ch] = (int16_t)(src[2 * ch] | (src[2 * ch + 1] << 8));
+        }
+    }
+
+  memcpy(in->prev, in->cur, sizeof(in->cur));
+
+#if MIXER_NCHANNELS == 1
+  in->cur[0] = in->nchannels == 1 ? samp[0] :
+               (int16_t)(((int32_t)samp[0] + samp[1]) >> 1);
+#else
+  in->cur[0] = samp[0];
+  in->cur[1] = in->nchannels == 1 ? samp[0] : samp[1];
+#endif
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_resample
+ *
+ * Description:
+ *   Convert one period of an input to the output rate with linear
+ *   interpolation and add it to the accumulator.
+ *
+ ****************************************************************************/
+
+static void audio_mixer_resample(FAR struct audio_mixer_input_s *in,
+                                 FAR int32_t *accum, size_t nframes)
+{
+  int32_t frac;
+  int32_t samp;
+  size_t i;
+  int ch;
+
+  for (i = 0; i < nframes; i++)
+    {
+      while (in->phase >= MIXER_ONE)
+        {
+          if (!audio_mixer_nextframe(in))
+            {
+              /* The client did not keep up, the rest is silence */
+
+              return;
+            }
+
+          in->phase -= MIXER_ONE;
+        }
+
+      /* Use a Q15 fraction so that the product cannot overflow */
+
+      frac = (int32_t)(in->phase >> 1);
+
+      for (ch = 0; ch < MIXER_NCHANNELS; ch++)
+        {
+          samp   = in->prev[ch] +
+                   (((in->cur[ch] - in->prev[ch]) * frac) >> 15);
+          *accum++ += (samp * in->gain) >> 10;
+        }
+
+      in->phase += in->step;
+    }
+}
+
+/****************************************************************************
+ * Name: audio_mixer_mix
+ *
+ * Description:
+ *   Fill one output buffer with the sum of all of the active inputs.
+ *
+ ****************************************************************************/
+
+static void audio_mixer_mix(FAR struct audio_mixer_s *mixer,
+                            FAR struct ap_buffer_s *apb)
+{
+  FAR struct audio_mixer_input_s *in;
+  FAR int16_t *dest;
+  size_t nframes;
+  size_t nsamples;
+  size_t i;
+  int32_t samp;
+
+  nframes  = MIN(apb->nmaxbytes / MIXER_FRAMESIZE, MIXER_NFRAMES);
+  nsamples = nframes * MIXER_NCHANNELS;
+
+  memset(mixer->accum, 0, nsamples * sizeof(int32_t));
+
+  for (i = 0; i < mixer->ninputs; i++)
+    {
+      in = &mixer->inputs[i];
+      if (in->running && !in->paused)
+        {
+          audio_mixer_resample(in, mixer->accum, nframes);
+        }
+    }
+
+  /* Saturate the sum into the output buffer */
+
+  dest = (FAR int16_t *)apb->samp;
+  for (i = 0; i < nsamples; i++)
+    {
+      samp    = mixer->accum[i];
+      dest[i] = samp > INT16_MAX ? INT16_MAX :
+                samp < INT16_MIN ? INT16_MIN : (int16_t)samp;
+    }
+
+  apb->i.channels = MIXER_NCHANNELS;
+  apb->nbytes     = nsamples * sizeof(int16_t);
+  apb->curbyte    = 0;
+  apb->flags      = 0;
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  apb->session    = mixer->session;
+#endif
+
+  /* Complete the inputs whose final buffer has been consumed */
+
+  for (i = 0; i < mixer->ninputs; i++)
+    {
+      in = &mixer->inputs[i];
+      if (in->running && in->final)
+        {
+          audio_mixer_flush(in);
+          in->running = false;
+          mixer->nrunning--;
+          audio_mixer_notify(in, AUDIO_CALLBACK_COMPLETE, NULL, OK);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: audio_mixer_ready
+ *
+ * Description:
+ *   Decide if the next output buffer should be mixed now.  That is the case
+ *   when every active input has data queued, or when the output device is
+ *   about to run dry and cannot wait for the late inputs.
+ *
+ ****************************************************************************/
+
+static bool audio_mixer_ready(FAR struct audio_mixer_s *mixer)
+{
+  FAR struct audio_mixer_input_s *in;
+  int i;
+
+  if (mixer->noutstanding <= 1)
+    {
+      return true;
+    }
+
+  for (i = 0; i < mixer->ninputs; i++)
+    {
+      in = &mixer->inputs[i];
+      if (in->running && !in->paused && dq_peek(&in->queue) == NULL)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_startlower
+ *
+ * Description:
+ *   Configure the output device for the mixer format and start it.
+ *
+ ****************************************************************************/
+
+static int audio_mixer_startlower(FAR struct audio_mixer_s *mixer)
+{
+  FAR struct audio_lowerhalf_s *lower = mixer->lower;
+  struct audio_caps_s caps;
+  int ret;
+
+  memset(&caps, 0, sizeof(caps));
+  caps.ac_len            = sizeof(struct audio_caps_s);
+  caps.ac_type           = AUDIO_TYPE_OUTPUT;
+  caps.ac_channels       = MIXER_NCHANNELS;
+  caps.ac_controls.hw[0] = CONFIG_AUDIO_MIXER_SAMPRATE;
+  caps.ac_controls.b[2]  = 16;
+
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  ret = lower->ops->configure(lower, mixer->session, &caps);
+#else
+  ret = lower->ops->configure(lower, &caps);
+#endif
+  if (ret < 0)
+    {
+      auderr("ERROR: Failed to configure the output: %d\n", ret);
+      return ret;
+    }
+
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  ret = lower->ops->start(lower, mixer->session);
+#else
+  ret = lower->ops->start(lower);
+#endif
+  if (ret < 0)
+    {
+      auderr("ERROR: Failed to start the output: %d\n", ret);
+      return ret;
+    }
+
+  mixer->started = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_stoplower
+ *
+ * Description:
+ *   Stop the output device once no input is running.
+ *
+ ****************************************************************************/
+
+static void audio_mixer_stoplower(FAR struct audio_mixer_s *mixer)
+{
+  mixer->started = false;
+
+#ifndef CONFIG_AUDIO_EXCLUDE_STOP
+  if (mixer->lower->ops->stop != NULL)
+    {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+      mixer->lower->ops->stop(mixer->lower, mixer->session);
+#else
+      mixer->lower->ops->stop(mixer->lower);
+#endif
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: audio_mixer_worker
+ *
+ * Description:
+ *   Mix into every free output buffer and hand it to the output device.
+ *   Runs on the work queue whenever an input gets data or the output
+ *   device returns a buffer.
+ *
+ ****************************************************************************/
+
+static void audio_mixer_worker(FAR void *arg)
+{
+  FAR struct audio_mixer_s *mixer = (FAR struct audio_mixer_s *)arg;
+  FAR struct ap_buffer_s *apb;
+  irqstate_t flags;
+  int ret;
+
+  nxsem_wait_uninterruptible(&mixer->exclsem);
+
+  while (mixer->nrunning > 0 && audio_mixer_ready(mixer))
+    {
+      flags = enter_critical_section();
+      apb = (FAR struct ap_buffer_s *)dq_remfirst(&mixer->freeq);
+      leave_critical_section(flags);
+
+      if (apb == NULL)
+        {
+          break;
+        }
+
+      audio_mixer_mix(mixer, apb);
+
+      flags = enter_critical_section();
+      mixer->noutstanding++;
+      leave_critical_section(flags);
+
+      ret = mixer->lower->ops->enqueuebuffer(mixer->lower, apb);
+      if (ret < 0)
+        {
+          auderr("ERROR: Failed to enqueue the output: %d\n", ret);
+
+          flags = enter_critical_section();
+          mixer->noutstanding--;
+          dq_addlast(&apb->dq_entry, &mixer->freeq);
+          leave_critical_section(flags);
+          break;
+        }
+
+      if (!mixer->started)
+        {
+          audio_mixer_startlower(mixer);
+        }
+    }
+
+  /* Stop the output once everything mixed has been played */
+
+  if (mixer->started && mixer->nrunning == 0 && mixer->noutstanding == 0)
+    {
+      audio_mixer_stoplower(mixer);
+    }
+
+  nxsem_post(&mixer->exclsem);
+}
+
+/****************************************************************************
+ * Name: audio_mixer_getcaps
+ *
+ * Description:
+ *   Get the capabilities of a mixer input.  Any PCM rate is accepted
+ *   because the input is resampled to the output rate.
+ *
+ ****************************************************************************/
+
+static int audio_mixer_getcaps(FAR struct audio_lowerhalf_s *dev, int type,
+                               FAR struct audio_caps_s *caps)
+{
+  DEBUGASSERT(caps && caps->ac_len >= sizeof(struct audio_caps_s));
+
+  caps->ac_format.hw  = 0;
+  caps->ac_controls.w = 0;
+
+  switch (caps->ac_type)
+    {
+      case AUDIO_TYPE_QUERY:
+        caps->ac_channels = 2;
+        if (caps->ac_subtype == AUDIO_TYPE_QUERY)
+          {
+            caps->ac_format.hw     = 1 << (AUDIO_FMT_PCM - 1);
+            caps->ac_controls.b[0] = AUDIO_TYPE_OUTPUT |
+                                     AUDIO_TYPE_FEATURE;
+          }
+        else
+          {
+            caps->ac_controls.b[0] = AUDIO_SUBFMT_END;
+          }
+        break;
+
+      case AUDIO_TYPE_OUTPUT:
+        caps->ac_channels = 2;
+        if (caps->ac_subtype == AUDIO_TYPE_QUERY)
+          {
+            caps->ac_controls.b[0] = AUDIO_SAMP_RATE_8K |
+                                     AUDIO_SAMP_RATE_11K |
+                                     AUDIO_SAMP_RATE_16K |
+                                     AUDIO_SAMP_RATE_22K |
+                                     AUDIO_SAMP_RATE_32K |
+                                     AUDIO_SAMP_RATE_44K |
+                                     AUDIO_SAMP_RATE_48K;
+          }
+        break;
+
+      case AUDIO_TYPE_FEATURE:
+#ifndef CONFIG_AUDIO_EXCLUDE_VOLUME
+        if (caps->ac_subtype == AUDIO_FU_UNDEF)
+          {
+            caps->ac_controls.b[0] = AUDIO_FU_VOLUME;
+          }
+#endif
+        break;
+
+      default:
+        break;
+    }
+
+  return caps->ac_len;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_configure
+ *
+ * Description:
+ *   Configure the format and the volume of a mixer input.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int audio_mixer_configure(FAR struct audio_lowerhalf_s *dev,
+                                 FAR void *session,
+                                 FAR const struct audio_caps_s *caps)
+#else
+static int audio_mixer_configure(FAR struct audio_lowerhalf_s *dev,
+                                 FAR const struct audio_caps_s *caps)
+#endif
+{
+  FAR struct audio_mixer_input_s *in = (FAR struct audio_mixer_input_s *)dev;
+  FAR struct audio_mixer_s *mixer = in->mixer;
+  uint32_t samprate;
+  int ret = OK;
+
+  nxsem_wait_uninterruptible(&mixer->exclsem);
+
+  switch (caps->ac_type)
+    {
+      case AUDIO_TYPE_FEATURE:
+#ifndef CONFIG_AUDIO_EXCLUDE_VOLUME
+        if (caps->ac_format.hw == AUDIO_FU_VOLUME)
+          {
+            uint16_t volume = caps->ac_controls.hw[0];
+
+            if (volume > 1000)
+              {
+                ret = -EDOM;
+                break;
+              }
+
+            in->gain = (uint16_t)(((uint32_t)volume * MIXER_GAIN_UNITY +
+                                   500) / 1000);
+          }
+#endif
+        break;
+
+      case AUDIO_TYPE_OUTPUT:
+        samprate = caps->ac_controls.hw[0];
+        if (caps->ac_channels < 1 || caps->ac_channels > 2 ||
+            (caps->ac_controls.b[2] != 8 && caps->ac_controls.b[2] != 16) ||
+            samprate == 0)
+          {
+            ret = -EINVAL;
+            break;
+          }
+
+        if (in->running)
+          {
+            ret = -EBUSY;
+            break;
+          }
+
+        in->nchannels = caps->ac_channels;
+        in->bpsamp    = caps->ac_controls.b[2];
+        in->step      = (uint32_t)(((uint64_t)samprate << 16) /
+                                   CONFIG_AUDIO_MIXER_SAMPRATE);
+
+        audinfo("Input %p: %u channels, %u bits, %" PRIu32 " Hz\n",
+                in, in->nchannels, in->bpsamp, samprate);
+        break;
+
+      default:
+        break;
+    }
+
+  nxsem_post(&mixer->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_shutdown
+ *
+ * Description:
+ *   Shutdown a mixer input.  The output device is shared and stays up.
+ *
+ ****************************************************************************/
+
+static int audio_mixer_shutdown(FAR struct audio_lowerhalf_s *dev)
+{
+  return OK;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_start
+ *
+ * Description:
+ *   Start mixing an input.  The output device is started with the first
+ *   input.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int audio_mixer_start(FAR struct audio_lowerhalf_s *dev,
+                             FAR void *session)
+#else
+static int audio_mixer_start(FAR struct audio_lowerhalf_s *dev)
+#endif
+{
+  FAR struct audio_mixer_input_s *in = (FAR struct audio_mixer_input_s *)dev;
+  FAR struct audio_mixer_s *mixer = in->mixer;
+
+  nxsem_wait_uninterruptible(&mixer->exclsem);
+
+  if (!in->running)
+    {
+      /* Start from silence so that the first output frame is not a click */
+
+      memset(in->prev, 0, sizeof(in->prev));
+      memset(in->cur, 0, sizeof(in->cur));
+      in->phase   = MIXER_ONE;
+      in->final   = false;
+      in->paused  = false;
+      in->running = true;
+      mixer->nrunning++;
+    }
+
+  nxsem_post(&mixer->exclsem);
+
+  work_queue(LPWORK, &mixer->work, audio_mixer_worker, mixer, 0);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_stop
+ *
+ * Description:
+ *   Stop mixing an input and return its buffers.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_AUDIO_EXCLUDE_STOP
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int audio_mixer_stop(FAR struct audio_lowerhalf_s *dev,
+                            FAR void *session)
+#else
+static int audio_mixer_stop(FAR struct audio_lowerhalf_s *dev)
+#endif
+{
+  FAR struct audio_mixer_input_s *in = (FAR struct audio_mixer_input_s *)dev;
+  FAR struct audio_mixer_s *mixer = in->mixer;
+
+  nxsem_wait_uninterruptible(&mixer->exclsem);
+
+  if (in->running)
+    {
+      in->running = false;
+      mixer->nrunning--;
+      audio_mixer_flush(in);
+      audio_mixer_notify(in, AUDIO_CALLBACK_COMPLETE, NULL, OK);
+    }
+
+  nxsem_post(&mixer->exclsem);
+
+  /* Let the worker stop the output device when it has drained */
+
+  work_queue(LPWORK, &mixer->work, audio_mixer_worker, mixer, 0);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: audio_mixer_pause
+ *
+ * Description:
+ *   Pause an input.  The other inputs keep playing.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_AUDIO_EXCLUDE_PAUSE_RESUME
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int audio_mixer_pause(FAR struct audio_lowerhalf_s *dev,
+                             FAR void *session)
+#else
+static int audio_mixer_pause(FAR struct audio_lowerhalf_s *dev)
+#endif
+{
+  FAR struct audio_mixer_input_s *in = (FAR struct audio_mixer_input_s *)dev;
+
+  in->paused = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_resume
+ *
+ * Description:
+ *   Resume a paused input.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int audio_mixer_resume(FAR struct audio_lowerhalf_s *dev,
+                              FAR void *session)
+#else
+static int audio_mixer_resume(FAR struct audio_lowerhalf_s *dev)
+#endif
+{
+  FAR struct audio_mixer_input_s *in = (FAR struct audio_mixer_input_s *)dev;
+  FAR struct audio_mixer_s *mixer = in->mixer;
+
+  in->paused = false;
+  work_queue(LPWORK, &mixer->work, audio_mixer_worker, mixer, 0);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: audio_mixer_enqueuebuffer
+ *
+ * Description:
+ *   Queue a client buffer on an input.  The samples are read in place by
+ *   the mixer; the buffer is returned once it has been consumed.
+ *
+ ****************************************************************************/
+
+static int audio_mixer_enqueuebuffer(FAR struct audio_lowerhalf_s *dev,
+                                     FAR struct ap_buffer_s *apb)
+{
+  FAR struct audio_mixer_input_s *in = (FAR struct audio_mixer_input_s *)dev;
+  FAR struct audio_mixer_s *mixer = in->mixer;
+
+  if (in->bpsamp == 0)
+    {
+      return -EINVAL;
+    }
+
+  nxsem_wait_uninterruptible(&mixer->exclsem);
+  dq_addlast(&apb->dq_entry, &in->queue);
+  nxsem_post(&mixer->exclsem);
+
+  if (in->running)
+    {
+      work_queue(LPWORK, &mixer->work, audio_mixer_worker, mixer, 0);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_cancelbuffer
+ *
+ * Description:
+ *   Cancel a previously enqueued buffer.
+ *
+ ****************************************************************************/
+
+static int audio_mixer_cancelbuffer(FAR struct audio_lowerhalf_s *dev,
+                                    FAR struct ap_buffer_s *apb)
+{
+  return OK;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_ioctl
+ *
+ * Description:
+ *   Mixer inputs support no ioctl commands of their own.
+ *
+ ****************************************************************************/
+
+static int audio_mixer_ioctl(FAR struct audio_lowerhalf_s *dev, int cmd,
+                             unsigned long arg)
+{
+  return -ENOTTY;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_reserve
+ *
+ * Description:
+ *   Reserve a mixer input for a client.  The output device is reserved
+ *   along with the first input.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int audio_mixer_reserve(FAR struct audio_lowerhalf_s *dev,
+                               FAR void **session)
+#else
+static int audio_mixer_reserve(FAR struct audio_lowerhalf_s *dev)
+#endif
+{
+  FAR struct audio_mixer_input_s *in = (FAR struct audio_mixer_input_s *)dev;
+  FAR struct audio_mixer_s *mixer = in->mixer;
+  FAR struct audio_lowerhalf_s *lower = mixer->lower;
+  int ret = OK;
+
+  nxsem_wait_uninterruptible(&mixer->exclsem);
+
+  if (in->reserved)
+    {
+      ret = -EBUSY;
+    }
+  else
+    {
+      if (mixer->nreserved == 0 && lower->ops->reserve != NULL)
+        {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+          ret = lower->ops->reserve(lower, &mixer->session);
+#else
+          ret = lower->ops->reserve(lower);
+#endif
+        }
+
+      if (ret >= 0)
+        {
+          in->reserved = true;
+          mixer->nreserved++;
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+          *session = in;
+#endif
+        }
+    }
+
+  nxsem_post(&mixer->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_release
+ *
+ * Description:
+ *   Release a mixer input.  The output device is released with the last
+ *   input.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static int audio_mixer_release(FAR struct audio_lowerhalf_s *dev,
+                               FAR void *session)
+#else
+static int audio_mixer_release(FAR struct audio_lowerhalf_s *dev)
+#endif
+{
+  FAR struct audio_mixer_input_s *in = (FAR struct audio_mixer_input_s *)dev;
+  FAR struct audio_mixer_s *mixer = in->mixer;
+  FAR struct audio_lowerhalf_s *lower = mixer->lower;
+  int ret = OK;
+
+  nxsem_wait_uninterruptible(&mixer->exclsem);
+
+  if (in->reserved)
+    {
+      in->reserved = false;
+      if (--mixer->nreserved == 0 && lower->ops->release != NULL)
+        {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+          ret = lower->ops->release(lower, mixer->session);
+#else
+          ret = lower->ops->release(lower);
+#endif
+        }
+    }
+
+  nxsem_post(&mixer->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: audio_mixer_callback
+ *
+ * Description:
+ *   Callback from the output device.  This may run in interrupt context so
+ *   the returned buffer is just put back on the free list and the mixing
+ *   is deferred to the work queue.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+static void audio_mixer_callback(FAR void *arg, uint16_t reason,
+                                 FAR struct ap_buffer_s *apb,
+                                 uint16_t status, FAR void *session)
+#else
+static void audio_mixer_callback(FAR void *arg, uint16_t reason,
+                                 FAR struct ap_buffer_s *apb,
+                                 uint16_t status)
+#endif
+{
+  FAR struct audio_mixer_s *mixer = (FAR struct audio_mixer_s *)arg;
+  irqstate_t flags;
+
+  switch (reason)
+    {
+      case AUDIO_CALLBACK_DEQUEUE:
+        flags = enter_critical_section();
+        dq_addlast(&apb->dq_entry, &mixer->freeq);
+        mixer->noutstanding--;
+        leave_critical_section(flags);
+
+        work_queue(LPWORK, &mixer->work, audio_mixer_worker, mixer, 0);
+        break;
+
+      case AUDIO_CALLBACK_IOERR:
+        auderr("ERROR: Output I/O error: %d\n", status);
+        break;
+
+      default:
+        break;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: audio_mixer_initialize
+ *
+ * Description:
+ *   Create a software mixer in front of an audio output device.  See
+ *   include/nuttx/audio/audio_mixer.h.
+ *
+ ****************************************************************************/
+
+int audio_mixer_initialize(FAR struct audio_lowerhalf_s *lower,
+                           FAR struct audio_lowerhalf_s **inputs,
+                           int ninputs)
+{
+  FAR struct audio_mixer_s *mixer;
+  struct audio_buf_desc_s bufdesc;
+  int ret;
+  int i;
+
+  DEBUGASSERT(lower && inputs && ninputs > 0 && ninputs <= UINT8_MAX);
+  DEBUGASSERT(lower->ops->configure && lower->ops->start &&
+              lower->ops->enqueuebuffer);
+
+  mixer = (FAR struct audio_mixer_s *)
+    kmm_zalloc(sizeof(struct audio_mixer_s));
+  if (mixer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  mixer->inputs = (FAR struct audio_mixer_input_s *)
+    kmm_zalloc(ninputs * sizeof(struct audio_mixer_input_s));
+  mixer->accum  = (FAR int32_t *)
+    kmm_malloc(MIXER_NFRAMES * MIXER_NCHANNELS * sizeof(int32_t));
+  if (mixer->inputs == NULL || mixer->accum == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  /* Allocate the output buffers.  These are the only buffers the mixer
+   * writes to; client buffers are consumed in place.
+   */
+
+  for (i = 0; i < CONFIG_AUDIO_NUM_BUFFERS; i++)
+    {
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+      bufdesc.session   = NULL;
+#endif
+      bufdesc.numbytes  = CONFIG_AUDIO_BUFFER_NUMBYTES;
+      bufdesc.u.pbuffer = &mixer->apb[i];
+
+      ret = apb_alloc(&bufdesc);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+      dq_addlast(&mixer->apb[i]->dq_entry, &mixer->freeq);
+    }
+
+  nxsem_init(&mixer->exclsem, 0, 1);
+  mixer->lower   = lower;
+  mixer->ninputs = ninputs;
+  lower->upper   = audio_mixer_callback;
+  lower->priv    = mixer;
+
+  for (i = 0; i < ninputs; i++)
+    {
+      FAR struct audio_mixer_input_s *in = &mixer->inputs[i];
+
+      in->export.ops = &g_audio_mixer_ops;
+      in->mixer      = mixer;
+      in->gain       = MIXER_GAIN_UNITY;
+      inputs[i]      = &in->export;
+    }
+
+  return OK;
+
+errout:
+  for (i = 0; i < CONFIG_AUDIO_NUM_BUFFERS; i++)
+    {
+      if (mixer->apb[i] != NULL)
+        {
+          apb_free(mixer->apb[i]);
+        }
+    }
+
+  kmm_free(mixer->accum);
+  kmm_free(mixer->inputs);
+  kmm_free(mixer);
+  return ret;
+}
+
+#endif /* CONFIG_AUDIO_MIXER */
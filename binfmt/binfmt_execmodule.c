@@ -35,6 +35,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/sched.h>
 #include <nuttx/mm/shm.h>
+#include <nuttx/spawn.h>
 #include <nuttx/binfmt/binfmt.h>
 
 #include "binfmt.h"
@@ -103,6 +104,8 @@ static void exec_ctors(FAR void *arg)
  *
  * Description:
  *   Execute a module that has been loaded into memory by load_module().
+ *   If 'actions' is not NULL, the spawn file actions are performed on the
+ *   file list of the new task before it is activated.
  *
  * Returned Value:
  *   This is a NuttX internal function so it follows the convention that
@@ -113,7 +116,8 @@ static void exec_ctors(FAR void *arg)
 
 int exec_module(FAR const struct binary_s *binp,
                 FAR const char *filename, FAR char * const *argv,
-                FAR char * const *envp)
+                FAR char * const *envp,
+                FAR const posix_spawn_file_actions_t *actions)
 {
   FAR struct task_tcb_s *tcb;
 #if defined(CONFIG_ARCH_ADDRENV) && defined(CONFIG_BUILD_KERNEL)
@@ -142,6 +146,13 @@ int exec_module(FAR const struct binary_s *binp,
       return -ENOMEM;
     }
 
+#ifdef CONFIG_ARCH_ADDRENV
+  /* The caller's argv and envp will not be accessible once the address
+   * environment of the new task is selected, so make a copy of them first.
+   * Otherwise nxtask_init() copies them directly onto the new task's stack
+   * and into its group and no intermediate copy is needed.
+   */
+
   if (argv)
     {
       argv = binfmt_copyargv(argv);
@@ -163,6 +174,7 @@ int exec_module(FAR const struct binary_s *binp,
           goto errout_with_args;
         }
     }
+#endif
 
 #if defined(CONFIG_ARCH_ADDRENV) && defined(CONFIG_BUILD_KERNEL)
   /* Instantiate the address environment containing the user heap */
@@ -209,10 +221,12 @@ int exec_module(FAR const struct binary_s *binp,
       goto errout_with_addrenv;
     }
 
+#ifdef CONFIG_ARCH_ADDRENV
   /* The copied argv and envp can now be released */
 
   binfmt_freeargv(argv);
   binfmt_freeenv(envp);
+#endif
 
 #if defined(CONFIG_ARCH_ADDRENV) && defined(CONFIG_ARCH_KERNEL_STACK)
   /* Allocate the kernel stack */
@@ -279,10 +293,6 @@ int exec_module(FAR const struct binary_s *binp,
 
   pid = tcb->cmn.pid;
 
-  /* Then activate the task at the provided priority */
-
-  nxtask_activate((FAR struct tcb_s *)tcb);
-
 #if defined(CONFIG_ARCH_ADDRENV) && defined(CONFIG_BUILD_KERNEL)
   /* Restore the address environment of the caller */
 
@@ -294,24 +304,41 @@ int exec_module(FAR const struct binary_s *binp,
     }
 #endif
 
+  /* Perform the file actions directly on the file list of the new task.
+   * The actions live in the caller's memory so this must be done with the
+   * caller's address environment in place.
+   */
+
+  ret = spawn_file_actions(&tcb->cmn, actions);
+  if (ret < 0)
+    {
+      berr("ERROR: spawn_file_actions() failed: %d\n", ret);
+      goto errout_with_tcbinit;
+    }
+
+  /* Then activate the task at the provided priority */
+
+  nxtask_activate((FAR struct tcb_s *)tcb);
   return (int)pid;
 
-#if defined(CONFIG_ARCH_ADDRENV) || defined(CONFIG_MM_SHM)
 errout_with_tcbinit:
+#ifdef CONFIG_BUILD_KERNEL
   tcb->cmn.stack_alloc_ptr = NULL;
+#endif
   nxsched_release_tcb(&tcb->cmn, TCB_FLAG_TTYPE_TASK);
   return ret;
-#endif
 
 errout_with_addrenv:
 #if defined(CONFIG_ARCH_ADDRENV) && defined(CONFIG_BUILD_KERNEL)
   up_addrenv_restore(&oldenv);
 errout_with_envp:
 #endif
+#ifdef CONFIG_ARCH_ADDRENV
   binfmt_freeenv(envp);
 errout_with_args:
   binfmt_freeargv(argv);
 errout_with_tcb:
+#endif
   kmm_free(tcb);
   return ret;
 }
@@ -25,12 +25,17 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <debug.h>
 #include <errno.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/binfmt/binfmt.h>
 #include <nuttx/binfmt/elf.h>
 
@@ -64,6 +69,44 @@
 #  define MIN(a,b) (a < b ? a : b)
 #endif
 
+/* Cache of relocated images.  Not possible with address environments:
+ * each process then gets its own copy of the image.
+ */
+
+#ifndef CONFIG_ELF_CACHE_NENTRIES
+#  define CONFIG_ELF_CACHE_NENTRIES 0
+#endif
+
+#if CONFIG_ELF_CACHE_NENTRIES > 0 && !defined(CONFIG_ARCH_ADDRENV)
+#  define ELF_HAVE_CACHE 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef ELF_HAVE_CACHE
+/* One relocated module kept in memory after its last instance exited.
+ * The text refers to the data at its load address, so the data cannot be
+ * shared: only one instance at a time runs from the cached image, and the
+ * data is restored from a pristine copy taken right after relocation.
+ */
+
+struct elf_cache_s
+{
+  FAR char *filename;          /* Path of the module, NULL if slot unused */
+  off_t filelen;               /* File size when the module was loaded */
+  time_t mtime;                /* File modification time at load */
+  uintptr_t textalloc;         /* Relocated .text */
+  uintptr_t dataalloc;         /* .data/.bss at its load address */
+  size_t datasize;             /* Size of .data/.bss */
+  FAR void *datainit;          /* Copy of .data/.bss after relocation */
+  main_t entrypt;              /* Entry point of the module */
+  uint32_t lastuse;            /* Used to select the entry to replace */
+  bool inuse;                  /* An instance is running from the image */
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -72,6 +115,9 @@ static int elf_loadbinary(FAR struct binary_s *binp,
                           FAR const char *filename,
                           FAR const struct symtab_s *exports,
                           int nexports);
+#ifdef ELF_HAVE_CACHE
+static int elf_unloadbinary(FAR struct binary_s *binp);
+#endif
 #ifdef CONFIG_ELF_COREDUMP
 static int elf_dumpbinary(FAR struct memory_region_s *regions,
                           FAR struct lib_outstream_s *stream);
@@ -88,16 +134,283 @@ static struct binfmt_s g_elfbinfmt =
 {
   NULL,             /* next */
   elf_loadbinary,   /* load */
+#ifdef ELF_HAVE_CACHE
+  elf_unloadbinary, /* unload */
+#else
   NULL,             /* unload */
+#endif
 #ifdef CONFIG_ELF_COREDUMP
   elf_dumpbinary,   /* coredump */
 #endif
 };
 
+#ifdef ELF_HAVE_CACHE
+static struct elf_cache_s g_elfcache[CONFIG_ELF_CACHE_NENTRIES];
+static uint32_t g_elfcacheuse;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef ELF_HAVE_CACHE
+/****************************************************************************
+ * Name: elf_cache_free
+ *
+ * Description:
+ *   Release the memory of a cache entry that was removed from the cache.
+ *
+ ****************************************************************************/
+
+static void elf_cache_free(FAR struct elf_cache_s *entry)
+{
+#if defined(CONFIG_ARCH_USE_TEXT_HEAP)
+  up_textheap_free((FAR void *)entry->textalloc);
+#else
+  kumm_free((FAR void *)entry->textalloc);
+#endif
+
+  if (entry->dataalloc != 0)
+    {
+      kumm_free((FAR void *)entry->dataalloc);
+    }
+
+  kmm_free(entry->datainit);
+  kmm_free(entry->filename);
+}
+
+/****************************************************************************
+ * Name: elf_cache_lookup
+ *
+ * Description:
+ *   Start the module from a cached image if there is an unused one that is
+ *   still up to date with the file.  Only the data has to be restored.
+ *
+ * Returned Value:
+ *   0 (OK) if the module was started from the cache; a negated errno value
+ *   if it has to be loaded from the file.
+ *
+ ****************************************************************************/
+
+static int elf_cache_lookup(FAR struct binary_s *binp,
+                            FAR const char *filename)
+{
+  FAR struct elf_cache_s *entry = NULL;
+  struct elf_cache_s stale;
+  struct stat buf;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  ret = nx_stat(filename, &buf, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  stale.filename = NULL;
+
+  flags = enter_critical_section();
+  for (i = 0; i < CONFIG_ELF_CACHE_NENTRIES; i++)
+    {
+      if (g_elfcache[i].filename == NULL || g_elfcache[i].inuse ||
+          strcmp(g_elfcache[i].filename, filename) != 0)
+        {
+          continue;
+        }
+
+      if (g_elfcache[i].filelen == buf.st_size &&
+          g_elfcache[i].mtime == buf.st_mtime)
+        {
+          entry          = &g_elfcache[i];
+          entry->inuse   = true;
+          entry->lastuse = ++g_elfcacheuse;
+        }
+      else
+        {
+          /* The file was replaced, forget the old image */
+
+          stale = g_elfcache[i];
+          g_elfcache[i].filename = NULL;
+        }
+
+      break;
+    }
+
+  leave_critical_section(flags);
+
+  if (stale.filename != NULL)
+    {
+      elf_cache_free(&stale);
+    }
+
+  if (entry == NULL)
+    {
+      return -ENOENT;
+    }
+
+  /* Restore the data as it was right after relocation */
+
+  if (entry->datasize > 0)
+    {
+      memcpy((FAR void *)entry->dataalloc, entry->datainit,
+             entry->datasize);
+      up_coherent_dcache(entry->dataalloc, entry->datasize);
+    }
+
+  binp->entrypt   = entry->entrypt;
+  binp->stacksize = CONFIG_ELF_STACKSIZE;
+
+  binfo("Started %s from the image cache\n", filename);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: elf_cache_add
+ *
+ * Description:
+ *   Keep a freshly relocated module in the cache.  On success, the cache
+ *   owns the module memory and the new instance runs from the cached
+ *   image.
+ *
+ * Returned Value:
+ *   0 (OK) if the module was added; a negated errno value otherwise, the
+ *   caller then keeps ownership of the module memory.
+ *
+ ****************************************************************************/
+
+static int elf_cache_add(FAR const char *filename,
+                         FAR struct elf_loadinfo_s *loadinfo,
+                         main_t entrypt)
+{
+  FAR struct elf_cache_s *entry = NULL;
+  struct elf_cache_s victim;
+  FAR void *datainit = NULL;
+  FAR char *name;
+  struct stat buf;
+  irqstate_t flags;
+  size_t len;
+  int ret;
+  int i;
+
+#ifdef CONFIG_BINFMT_CONSTRUCTORS
+  /* Constructors would have to be kept as well, don't bother */
+
+  if (loadinfo->nctors > 0 || loadinfo->ndtors > 0)
+    {
+      return -ENOSYS;
+    }
+#endif
+
+  ret = nx_stat(filename, &buf, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  len  = strlen(filename) + 1;
+  name = kmm_malloc(len);
+  if (name == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memcpy(name, filename, len);
+
+  if (loadinfo->datasize > 0)
+    {
+      datainit = kmm_malloc(loadinfo->datasize);
+      if (datainit == NULL)
+        {
+          kmm_free(name);
+          return -ENOMEM;
+        }
+
+      memcpy(datainit, (FAR void *)loadinfo->dataalloc, loadinfo->datasize);
+    }
+
+  /* Take a free entry, or else the least recently used idle one */
+
+  victim.filename = NULL;
+
+  flags = enter_critical_section();
+  for (i = 0; i < CONFIG_ELF_CACHE_NENTRIES; i++)
+    {
+      if (g_elfcache[i].filename == NULL)
+        {
+          entry = &g_elfcache[i];
+          break;
+        }
+
+      if (!g_elfcache[i].inuse &&
+          (entry == NULL || g_elfcache[i].lastuse < entry->lastuse))
+        {
+          entry = &g_elfcache[i];
+        }
+    }
+
+  if (entry != NULL)
+    {
+      victim           = *entry;
+      entry->filename  = name;
+      entry->filelen   = buf.st_size;
+      entry->mtime     = buf.st_mtime;
+      entry->textalloc = loadinfo->textalloc;
+      entry->dataalloc = loadinfo->dataalloc;
+      entry->datasize  = loadinfo->datasize;
+      entry->datainit  = datainit;
+      entry->entrypt   = entrypt;
+      entry->lastuse   = ++g_elfcacheuse;
+      entry->inuse     = true;
+    }
+
+  leave_critical_section(flags);
+
+  if (entry == NULL)
+    {
+      kmm_free(datainit);
+      kmm_free(name);
+      return -EBUSY;
+    }
+
+  if (victim.filename != NULL)
+    {
+      elf_cache_free(&victim);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: elf_unloadbinary
+ *
+ * Description:
+ *   The instance running from a cached image exited, the image may be
+ *   used again.
+ *
+ ****************************************************************************/
+
+static int elf_unloadbinary(FAR struct binary_s *binp)
+{
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+  for (i = 0; i < CONFIG_ELF_CACHE_NENTRIES; i++)
+    {
+      if (g_elfcache[i].filename != NULL && g_elfcache[i].inuse &&
+          g_elfcache[i].entrypt == binp->entrypt)
+        {
+          g_elfcache[i].inuse = false;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+#endif /* ELF_HAVE_CACHE */
+
 /****************************************************************************
  * Name: elf_dumploadinfo
  ****************************************************************************/
@@ -227,6 +540,15 @@ static int elf_loadbinary(FAR struct binary_s *binp,
 
   binfo("Loading file: %s\n", filename);
 
+#ifdef ELF_HAVE_CACHE
+  /* Start from a cached image if possible */
+
+  if (elf_cache_lookup(binp, filename) >= 0)
+    {
+      return OK;
+    }
+#endif
+
   /* Initialize the ELF library to load the program binary. */
 
   ret = elf_init(filename, &loadinfo);
@@ -276,11 +598,20 @@ static int elf_loadbinary(FAR struct binary_s *binp,
 
   up_addrenv_clone(&loadinfo.addrenv, &binp->addrenv);
 #else
-  binp->alloc[0]  = (FAR void *)loadinfo.textalloc;
+#ifdef ELF_HAVE_CACHE
+  /* Keep the relocated image for the next launches.  If it is cached, the
+   * cache owns the memory.
+   */
+
+  if (elf_cache_add(filename, &loadinfo, binp->entrypt) < 0)
+#endif
+    {
+      binp->alloc[0]  = (FAR void *)loadinfo.textalloc;
 #ifdef CONFIG_BINFMT_CONSTRUCTORS
-  binp->alloc[1]  = loadinfo.ctoralloc;
-  binp->alloc[2]  = loadinfo.dtoralloc;
+      binp->alloc[1]  = loadinfo.ctoralloc;
+      binp->alloc[2]  = loadinfo.dtoralloc;
 #endif
+    }
 #endif
 
 #ifdef CONFIG_BINFMT_CONSTRUCTORS
@@ -170,7 +170,8 @@ static inline int elf_readrelas(FAR struct elf_loadinfo_s *loadinfo,
  ****************************************************************************/
 
 static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
-                        FAR const struct symtab_s *exports, int nexports)
+                        FAR const struct symtab_s *exports, int nexports,
+                        FAR dq_queue_t *q, FAR int *ncache)
 {
   FAR Elf_Shdr         *relsec = &loadinfo->shdr[relidx];
   FAR Elf_Shdr         *dstsec = &loadinfo->shdr[relsec->sh_info];
@@ -179,12 +180,10 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
   FAR elf_symcache_t   *cache;
   FAR Elf_Sym          *sym;
   FAR dq_entry_t       *e;
-  dq_queue_t            q;
   uintptr_t             addr;
   int                   symidx;
   int                   ret;
   int                   i;
-  int                   j;
 
   rels = kmm_malloc(CONFIG_ELF_RELOCATION_BUFFERCOUNT * sizeof(Elf_Rel));
   if (rels == NULL)
@@ -193,8 +192,6 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
       return -ENOMEM;
     }
 
-  dq_init(&q);
-
   /* Examine each relocation in the section.  'relsec' is the section
    * containing the relations.  'dstsec' is the section containing the data
    * to be relocated.
@@ -202,7 +199,7 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 
   ret = OK;
 
-  for (i = j = 0; i < relsec->sh_size / sizeof(Elf_Rel); i++)
+  for (i = 0; i < relsec->sh_size / sizeof(Elf_Rel); i++)
     {
       /* Read the relocation entry into memory */
 
@@ -230,13 +227,13 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
       /* First try the cache */
 
       sym = NULL;
-      for (e = dq_peek(&q); e; e = dq_next(e))
+      for (e = dq_peek(q); e; e = dq_next(e))
         {
           cache = (FAR elf_symcache_t *)e;
           if (cache->idx == symidx)
             {
-              dq_rem(&cache->entry, &q);
-              dq_addfirst(&cache->entry, &q);
+              dq_rem(&cache->entry, q);
+              dq_addfirst(&cache->entry, q);
               sym = &cache->sym;
               break;
             }
@@ -248,7 +245,7 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 
       if (sym == NULL)
         {
-          if (j < CONFIG_ELF_SYMBOL_CACHECOUNT)
+          if (*ncache < CONFIG_ELF_SYMBOL_CACHECOUNT)
             {
               cache = kmm_malloc(sizeof(elf_symcache_t));
               if (!cache)
@@ -258,11 +255,11 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
                   break;
                 }
 
-              j++;
+              (*ncache)++;
             }
           else
             {
-              cache = (FAR elf_symcache_t *)dq_remlast(&q);
+              cache = (FAR elf_symcache_t *)dq_remlast(q);
             }
 
           sym = &cache->sym;
@@ -310,7 +307,7 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
             }
 
           cache->idx = symidx;
-          dq_addfirst(&cache->entry, &q);
+          dq_addfirst(&cache->entry, q);
         }
 
       if (sym->st_shndx == SHN_UNDEF && sym->st_name == 0)
@@ -345,17 +342,12 @@ static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx,
     }
 
   kmm_free(rels);
-  while ((e = dq_peek(&q)))
-    {
-      dq_rem(e, &q);
-      kmm_free(e);
-    }
-
   return ret;
 }
 
 static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
-                           FAR const struct symtab_s *exports, int nexports)
+                           FAR const struct symtab_s *exports, int nexports,
+                           FAR dq_queue_t *q, FAR int *ncache)
 {
   FAR Elf_Shdr         *relsec = &loadinfo->shdr[relidx];
   FAR Elf_Shdr         *dstsec = &loadinfo->shdr[relsec->sh_info];
@@ -364,12 +356,10 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
   FAR elf_symcache_t   *cache;
   FAR Elf_Sym          *sym;
   FAR dq_entry_t       *e;
-  dq_queue_t            q;
   uintptr_t             addr;
   int                   symidx;
   int                   ret;
   int                   i;
-  int                   j;
 
   relas = kmm_malloc(CONFIG_ELF_RELOCATION_BUFFERCOUNT * sizeof(Elf_Rela));
   if (relas == NULL)
@@ -378,8 +368,6 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
       return -ENOMEM;
     }
 
-  dq_init(&q);
-
   /* Examine each relocation in the section.  'relsec' is the section
    * containing the relations.  'dstsec' is the section containing the data
    * to be relocated.
@@ -387,7 +375,7 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 
   ret = OK;
 
-  for (i = j = 0; i < relsec->sh_size / sizeof(Elf_Rela); i++)
+  for (i = 0; i < relsec->sh_size / sizeof(Elf_Rela); i++)
     {
       /* Read the relocation entry into memory */
 
@@ -415,13 +403,13 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
       /* First try the cache */
 
       sym = NULL;
-      for (e = dq_peek(&q); e; e = dq_next(e))
+      for (e = dq_peek(q); e; e = dq_next(e))
         {
           cache = (FAR elf_symcache_t *)e;
           if (cache->idx == symidx)
             {
-              dq_rem(&cache->entry, &q);
-              dq_addfirst(&cache->entry, &q);
+              dq_rem(&cache->entry, q);
+              dq_addfirst(&cache->entry, q);
               sym = &cache->sym;
               break;
             }
@@ -433,7 +421,7 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 
       if (sym == NULL)
         {
-          if (j < CONFIG_ELF_SYMBOL_CACHECOUNT)
+          if (*ncache < CONFIG_ELF_SYMBOL_CACHECOUNT)
             {
               cache = kmm_malloc(sizeof(elf_symcache_t));
               if (!cache)
@@ -443,11 +431,11 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
                   break;
                 }
 
-              j++;
+              (*ncache)++;
             }
           else
             {
-              cache = (FAR elf_symcache_t *)dq_remlast(&q);
+              cache = (FAR elf_symcache_t *)dq_remlast(q);
             }
 
           sym = &cache->sym;
@@ -495,7 +483,7 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
             }
 
           cache->idx = symidx;
-          dq_addfirst(&cache->entry, &q);
+          dq_addfirst(&cache->entry, q);
         }
 
       if (sym->st_shndx == SHN_UNDEF && sym->st_name == 0)
@@ -530,12 +518,6 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
     }
 
   kmm_free(relas);
-  while ((e = dq_peek(&q)))
-    {
-      dq_rem(e, &q);
-      kmm_free(e);
-    }
-
   return ret;
 }
 
@@ -559,9 +541,12 @@ static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx,
 int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
              FAR const struct symtab_s *exports, int nexports)
 {
+  FAR dq_entry_t *e;
+  dq_queue_t q;
 #ifdef CONFIG_ARCH_ADDRENV
   int status;
 #endif
+  int ncache;
   int ret;
   int i;
 
@@ -598,7 +583,13 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
     }
 #endif
 
-  /* Process relocations in every allocated section */
+  /* Process relocations in every allocated section.  The cache of resolved
+   * symbols is shared by all sections: most imported symbols are referenced
+   * from several of them.
+   */
+
+  dq_init(&q);
+  ncache = 0;
 
   for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
     {
@@ -623,11 +614,12 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
 
       if (loadinfo->shdr[i].sh_type == SHT_REL)
         {
-          ret = elf_relocate(loadinfo, i, exports, nexports);
+          ret = elf_relocate(loadinfo, i, exports, nexports, &q, &ncache);
         }
       else if (loadinfo->shdr[i].sh_type == SHT_RELA)
         {
-          ret = elf_relocateadd(loadinfo, i, exports, nexports);
+          ret = elf_relocateadd(loadinfo, i, exports, nexports,
+                                &q, &ncache);
         }
 
       if (ret < 0)
@@ -636,6 +628,12 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
         }
     }
 
+  while ((e = dq_peek(&q)))
+    {
+      dq_rem(e, &q);
+      kmm_free(e);
+    }
+
 #if defined(CONFIG_ARCH_ADDRENV)
   /* Ensure that the I and D caches are coherent before starting the newly
    * loaded module by cleaning the D cache (i.e., flushing the D cache
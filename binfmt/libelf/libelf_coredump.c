@@ -254,6 +254,59 @@ static void elf_emit_note_info(FAR struct elf_dumpinfo_s *cinfo)
     }
 }
 
+/****************************************************************************
+ * Name: elf_get_stack_segs
+ *
+ * Description:
+ *   Count the task stacks that are dumped when no memory region is given
+ *
+ ****************************************************************************/
+
+static int elf_get_stack_segs(void)
+{
+  int count = 0;
+  int i;
+
+  for (i = 0; i < g_npidhash; i++)
+    {
+      if (g_pidhash[i] && g_pidhash[i]->stack_base_ptr)
+        {
+          count++;
+        }
+    }
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: elf_emit_segment_header
+ *
+ * Description:
+ *   Fill the PT_LOAD program header of one segment
+ *
+ ****************************************************************************/
+
+static void elf_emit_segment_header(FAR struct elf_dumpinfo_s *cinfo,
+                                    FAR off_t *offset, uintptr_t start,
+                                    size_t size, uint32_t flags)
+{
+  Elf_Phdr phdr;
+
+  memset(&phdr, 0, sizeof(Elf_Phdr));
+
+  phdr.p_type   = PT_LOAD;
+  phdr.p_offset = ROUNDUP(*offset, ELF_PAGESIZE);
+  phdr.p_vaddr  = start;
+  phdr.p_paddr  = start;
+  phdr.p_filesz = size;
+  phdr.p_memsz  = size;
+  phdr.p_flags  = flags;
+  phdr.p_align  = ELF_PAGESIZE;
+  *offset       = phdr.p_offset + phdr.p_memsz;
+
+  elf_emit(cinfo, &phdr, sizeof(phdr));
+}
+
 /****************************************************************************
  * Name: elf_emit_program_header
  *
@@ -266,6 +319,7 @@ static void elf_emit_program_header(FAR struct elf_dumpinfo_s *cinfo,
                                     int segs)
 {
   off_t offset = cinfo->stream->nput + (segs + 1) * sizeof(Elf_Phdr);
+  FAR struct tcb_s *tcb;
   Elf_Phdr phdr;
   int i;
 
@@ -280,18 +334,68 @@ static void elf_emit_program_header(FAR struct elf_dumpinfo_s *cinfo,
 
   /* Write program headers for segments dump */
 
-  for (i = 0; i < segs; i++)
+  if (cinfo->regions)
     {
-      phdr.p_type   = PT_LOAD;
-      phdr.p_offset = ROUNDUP(offset, ELF_PAGESIZE);
-      phdr.p_vaddr  = cinfo->regions[i].start;
-      phdr.p_paddr  = cinfo->regions[i].start;
-      phdr.p_filesz = cinfo->regions[i].end - cinfo->regions[i].start;
-      phdr.p_memsz  = phdr.p_filesz;
-      phdr.p_flags  = cinfo->regions[i].flags;
-      phdr.p_align  = ELF_PAGESIZE;
-      offset       += ROUNDUP(phdr.p_memsz, ELF_PAGESIZE);
-      elf_emit(cinfo, &phdr, sizeof(phdr));
+      for (i = 0; i < segs; i++)
+        {
+          elf_emit_segment_header(cinfo, &offset, cinfo->regions[i].start,
+                                  cinfo->regions[i].end -
+                                  cinfo->regions[i].start,
+                                  cinfo->regions[i].flags);
+        }
+
+      return;
+    }
+
+  for (i = 0; i < g_npidhash; i++)
+    {
+      tcb = g_pidhash[i];
+      if (tcb && tcb->stack_base_ptr)
+        {
+          elf_emit_segment_header(cinfo, &offset,
+                                  (uintptr_t)tcb->stack_base_ptr,
+                                  tcb->adj_stack_size, PF_R | PF_W);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: elf_emit_memory
+ *
+ * Description:
+ *   Dump the content of the segments, each one aligned to a page
+ *
+ ****************************************************************************/
+
+static void elf_emit_memory(FAR struct elf_dumpinfo_s *cinfo, int segs)
+{
+  FAR struct tcb_s *tcb;
+  int i;
+
+  if (cinfo->regions)
+    {
+      for (i = 0; i < segs; i++)
+        {
+          elf_emit(cinfo, (FAR void *)cinfo->regions[i].start,
+                   cinfo->regions[i].end -
+                   cinfo->regions[i].start);
+
+          /* Align to page */
+
+          elf_emit_align(cinfo);
+        }
+
+      return;
+    }
+
+  for (i = 0; i < g_npidhash; i++)
+    {
+      tcb = g_pidhash[i];
+      if (tcb && tcb->stack_base_ptr)
+        {
+          elf_emit(cinfo, tcb->stack_base_ptr, tcb->adj_stack_size);
+          elf_emit_align(cinfo);
+        }
     }
 }
 
@@ -305,6 +409,10 @@ static void elf_emit_program_header(FAR struct elf_dumpinfo_s *cinfo,
  * Description:
  *   Generat the core dump stream as ELF structure.
  *
+ *   If no memory region is given, only the stack of each task is dumped
+ *   together with its registers.  That is enough for a backtrace of every
+ *   task and takes a small fraction of the time needed to dump all of RAM.
+ *
  * Input Parameters:
  *   dumpinfo - elf coredump informations
  *
@@ -316,7 +424,6 @@ static void elf_emit_program_header(FAR struct elf_dumpinfo_s *cinfo,
 int elf_coredump(FAR struct elf_dumpinfo_s *cinfo)
 {
   int segs = 0;
-  int i;
 
   /* Check the memory region */
 
@@ -325,6 +432,10 @@ int elf_coredump(FAR struct elf_dumpinfo_s *cinfo)
       for (; cinfo->regions[segs].start <
              cinfo->regions[segs].end; segs++);
     }
+  else
+    {
+      segs = elf_get_stack_segs();
+    }
 
   if (segs == 0)
     {
@@ -351,16 +462,7 @@ int elf_coredump(FAR struct elf_dumpinfo_s *cinfo)
 
   /* Start dump the memory */
 
-  for (i = 0; i < segs; i++)
-    {
-      elf_emit(cinfo, (FAR void *)cinfo->regions[i].start,
-               cinfo->regions[i].end -
-               cinfo->regions[i].start);
-
-      /* Align to page */
-
-      elf_emit_align(cinfo);
-    }
+  elf_emit_memory(cinfo, segs);
 
   /* Flush the dump */
 
@@ -81,7 +81,7 @@
  *
  ****************************************************************************/
 
-static void elf_elfsize(struct elf_loadinfo_s *loadinfo)
+static int elf_elfsize(struct elf_loadinfo_s *loadinfo)
 {
   size_t textsize;
   size_t datasize;
@@ -96,6 +96,18 @@ static void elf_elfsize(struct elf_loadinfo_s *loadinfo)
     {
       FAR Elf_Shdr *shdr = &loadinfo->shdr[i];
 
+      /* SHF_TLS indicates that each thread needs its own copy of the
+       * section.  The TLS area of a thread is sized for the thread
+       * variables of the base code only and modules have no way to
+       * reserve their own, so they must not use __thread variables.
+       */
+
+      if ((shdr->sh_flags & SHF_TLS) != 0)
+        {
+          berr("ERROR: Thread local section %d not supported\n", i);
+          return -ENOTSUP;
+        }
+
       /* SHF_ALLOC indicates that the section requires memory during
        * execution.
        */
@@ -131,6 +143,7 @@ static void elf_elfsize(struct elf_loadinfo_s *loadinfo)
 
   loadinfo->textsize = textsize;
   loadinfo->datasize = datasize;
+  return OK;
 }
 
 /****************************************************************************
@@ -267,7 +280,12 @@ int elf_load(FAR struct elf_loadinfo_s *loadinfo)
 
   /* Determine total size to allocate */
 
-  elf_elfsize(loadinfo);
+  ret = elf_elfsize(loadinfo);
+  if (ret < 0)
+    {
+      berr("ERROR: elf_elfsize failed: %d\n", ret);
+      goto errout_with_buffers;
+    }
 
   /* Determine the heapsize to allocate.  heapsize is ignored if there is
    * no address environment because the heap is a shared resource in that
@@ -32,6 +32,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/binfmt/elf.h>
 
 /****************************************************************************
@@ -40,6 +41,10 @@
 
 #undef ELF_DUMP_READDATA       /* Define to dump all file data read */
 
+#ifndef CONFIG_ELF_READAHEAD_SIZE
+#  define CONFIG_ELF_READAHEAD_SIZE 0
+#endif
+
 /****************************************************************************
  * Private Constant Data
  ****************************************************************************/
@@ -75,27 +80,16 @@ static inline void elf_dumpreaddata(FAR char *buffer, int buflen)
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: elf_read
+ * Name: elf_readfile
  *
  * Description:
- *   Read 'readsize' bytes from the object file at 'offset'.  The data is
- *   read into 'buffer.' If 'buffer' is part of the ELF address environment,
- *   then the caller is responsible for assuring that that address
- *   environment is in place before calling this function (i.e., that
- *   elf_addrenv_select() has been called if CONFIG_ARCH_ADDRENV=y).
- *
- * Returned Value:
- *   0 (OK) is returned on success and a negated errno is returned on
- *   failure.
+ *   Read 'readsize' bytes from the object file at 'offset' directly into
+ *   'buffer'.
  *
  ****************************************************************************/
 
-int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
-             size_t readsize, off_t offset)
+static int elf_readfile(FAR struct elf_loadinfo_s *loadinfo,
+                        FAR uint8_t *buffer, size_t readsize, off_t offset)
 {
   ssize_t nbytes;      /* Number of bytes read */
   off_t   rpos;        /* Position returned by lseek */
@@ -146,3 +140,119 @@ int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
   elf_dumpreaddata(buffer, readsize);
   return OK;
 }
+
+/****************************************************************************
+ * Name: elf_readahead
+ *
+ * Description:
+ *   Read 'readsize' bytes from the object file at 'offset' through the
+ *   read-ahead buffer.  Symbols, symbol names and relocations are read a
+ *   few bytes at a time, mostly from neighbouring offsets; reading them as
+ *   aligned CONFIG_ELF_READAHEAD_SIZE blocks replaces most of those small
+ *   seeks and reads with a copy from memory.
+ *
+ ****************************************************************************/
+
+#if CONFIG_ELF_READAHEAD_SIZE > 0
+static int elf_readahead(FAR struct elf_loadinfo_s *loadinfo,
+                         FAR uint8_t *buffer, size_t readsize, off_t offset)
+{
+  size_t ncopy;
+  int ret;
+
+  if (loadinfo->rabuffer == NULL)
+    {
+      loadinfo->rabuffer = kmm_malloc(CONFIG_ELF_READAHEAD_SIZE);
+      if (loadinfo->rabuffer == NULL)
+        {
+          return elf_readfile(loadinfo, buffer, readsize, offset);
+        }
+
+      loadinfo->ralen = 0;
+    }
+
+  while (readsize > 0)
+    {
+      /* Refill the buffer with the block containing 'offset' */
+
+      if (offset < loadinfo->raoffset ||
+          offset >= loadinfo->raoffset + loadinfo->ralen)
+        {
+          loadinfo->raoffset = offset - offset % CONFIG_ELF_READAHEAD_SIZE;
+          loadinfo->ralen    = CONFIG_ELF_READAHEAD_SIZE;
+
+          if (loadinfo->raoffset + loadinfo->ralen > loadinfo->filelen)
+            {
+              if (offset >= loadinfo->filelen)
+                {
+                  loadinfo->ralen = 0;
+                  berr("Unexpected end of file\n");
+                  return -ENODATA;
+                }
+
+              loadinfo->ralen = loadinfo->filelen - loadinfo->raoffset;
+            }
+
+          ret = elf_readfile(loadinfo, loadinfo->rabuffer, loadinfo->ralen,
+                             loadinfo->raoffset);
+          if (ret < 0)
+            {
+              loadinfo->ralen = 0;
+              return ret;
+            }
+        }
+
+      ncopy = loadinfo->raoffset + loadinfo->ralen - offset;
+      if (ncopy > readsize)
+        {
+          ncopy = readsize;
+        }
+
+      memcpy(buffer, &loadinfo->rabuffer[offset - loadinfo->raoffset],
+             ncopy);
+
+      readsize -= ncopy;
+      buffer   += ncopy;
+      offset   += ncopy;
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_read
+ *
+ * Description:
+ *   Read 'readsize' bytes from the object file at 'offset'.  The data is
+ *   read into 'buffer.' If 'buffer' is part of the ELF address environment,
+ *   then the caller is responsible for assuring that that address
+ *   environment is in place before calling this function (i.e., that
+ *   elf_addrenv_select() has been called if CONFIG_ARCH_ADDRENV=y).
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
+             size_t readsize, off_t offset)
+{
+#if CONFIG_ELF_READAHEAD_SIZE > 0
+  /* Small reads go through the read-ahead buffer, section contents and
+   * other large reads go directly to the caller's buffer.
+   */
+
+  if (readsize < CONFIG_ELF_READAHEAD_SIZE)
+    {
+      return elf_readahead(loadinfo, buffer, readsize, offset);
+    }
+#endif
+
+  return elf_readfile(loadinfo, buffer, readsize, offset);
+}
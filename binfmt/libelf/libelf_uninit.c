@@ -107,5 +107,14 @@ int elf_freebuffers(struct elf_loadinfo_s *loadinfo)
       loadinfo->buflen    = 0;
     }
 
+#if defined(CONFIG_ELF_READAHEAD_SIZE) && CONFIG_ELF_READAHEAD_SIZE > 0
+  if (loadinfo->rabuffer)
+    {
+      kmm_free((FAR void *)loadinfo->rabuffer);
+      loadinfo->rabuffer  = NULL;
+      loadinfo->ralen     = 0;
+    }
+#endif
+
   return OK;
 }
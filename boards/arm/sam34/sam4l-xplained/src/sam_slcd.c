@@ -1171,7 +1171,7 @@ static int slcd_poll(struct file *filep, struct pollfd *fds,
       fds->revents |= (fds->events & (POLLIN | POLLOUT));
       if (fds->revents != 0)
         {
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 
@@ -28,6 +28,7 @@
 
 #include <nuttx/userspace.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/clock.h>
 #include <nuttx/mm/mm.h>
 
 #if defined(CONFIG_BUILD_PROTECTED) && !defined(__KERNEL__)
@@ -104,6 +105,12 @@ const struct userspace_s userspace locate_data(".userspace") =
 #ifdef CONFIG_LIBC_USRWORK
   .work_usrstart    = work_usrstart,
 #endif
+
+  /* Kernel time published to user space (see include/nuttx/clock.h) */
+
+#ifdef CONFIG_CLOCK_VDSO
+  .us_clockvdso     = &g_clock_vdso,
+#endif
 };
 
 /****************************************************************************
@@ -602,7 +602,7 @@ static void tc_notify(struct tc_dev_s *priv)
         {
           fds->revents |= POLLIN;
           iinfo("Report events: %08" PRIx32 "\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 
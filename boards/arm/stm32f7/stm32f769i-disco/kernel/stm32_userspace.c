@@ -27,6 +27,7 @@
 #include <stdlib.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/mm/mm.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/userspace.h>
@@ -105,6 +106,12 @@ const struct userspace_s userspace locate_data(".userspace") =
 #ifdef CONFIG_LIBC_USRWORK
   .work_usrstart    = work_usrstart,
 #endif
+
+  /* Kernel time published to user space (see include/nuttx/clock.h) */
+
+#ifdef CONFIG_CLOCK_VDSO
+  .us_clockvdso     = &g_clock_vdso,
+#endif
 };
 
 /****************************************************************************
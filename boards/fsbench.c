@@ -0,0 +1,730 @@
+/****************************************************************************
+ * boards/fsbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/board.h>
+#include <nuttx/clock.h>
+#include <nuttx/fs/iostat.h>
+
+#ifdef CONFIG_BOARD_FSBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Default parameters */
+
+#define FSB_DIRECTORY      "/mnt"
+#define FSB_FILESIZE       256     /* KiB */
+#define FSB_BLOCKSIZE      1024
+#define FSB_NFILES         32
+#define FSB_NRANDOM        256
+#define FSB_NSYNCS         32
+
+#define FSB_PATHLEN        64
+#define FSB_SMALLSIZE      32      /* Size of the small files */
+
+/* The tests, selected with -t */
+
+#define FSB_TEST_SEQWRITE  (1 << 0)  /* 'w' */
+#define FSB_TEST_SEQREAD   (1 << 1)  /* 'r' */
+#define FSB_TEST_RNDREAD   (1 << 2)  /* 'R' */
+#define FSB_TEST_RNDWRITE  (1 << 3)  /* 'W' */
+#define FSB_TEST_META      (1 << 4)  /* 'm' */
+#define FSB_TEST_FSYNC     (1 << 5)  /* 's' */
+#define FSB_TEST_ALL       0x3f
+#define FSB_TESTS          "wrRWms"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The parameters of the run */
+
+struct fsb_options_s
+{
+  FAR const char *directory;         /* Where the files are created */
+  size_t filesize;                   /* Bytes */
+  size_t blocksize;                  /* Size of one read or write */
+  int nfiles;                        /* Number of small files */
+  int nrandom;                       /* Number of random accesses */
+  int nsyncs;                        /* Number of fsync() */
+  int tests;
+  FAR uint8_t *buffer;               /* One block */
+};
+
+/* The measures of one kind of operation */
+
+struct fsb_result_s
+{
+  FAR const char *name;
+  uint64_t start;                    /* Nanoseconds */
+  uint64_t elapsed;
+  uint64_t bytes;
+  uint64_t min;                      /* Latency of one operation */
+  uint64_t max;
+  uint32_t count;
+#ifdef CONFIG_FS_IOSTAT
+  struct fs_iostat_s iostat[FS_IOSTAT_NOPS];
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct fsb_options_s g_fsb;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fsb_now
+ ****************************************************************************/
+
+static uint64_t fsb_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/****************************************************************************
+ * Name: fsb_start
+ ****************************************************************************/
+
+static void fsb_start(FAR struct fsb_result_s *result, FAR const char *name)
+{
+  memset(result, 0, sizeof(*result));
+  result->name = name;
+  result->min  = UINT64_MAX;
+
+#ifdef CONFIG_FS_IOSTAT
+  fs_iostat_get(result->iostat);
+#endif
+
+  result->start = fsb_now();
+}
+
+/****************************************************************************
+ * Name: fsb_record
+ *
+ * Description:
+ *   Account one operation that started at the time 'begin'.
+ *
+ ****************************************************************************/
+
+static void fsb_record(FAR struct fsb_result_s *result, uint64_t begin,
+                       size_t bytes)
+{
+  uint64_t latency = fsb_now() - begin;
+
+  result->min    = latency < result->min ? latency : result->min;
+  result->max    = latency > result->max ? latency : result->max;
+  result->bytes += bytes;
+  result->count++;
+}
+
+/****************************************************************************
+ * Name: fsb_report
+ *
+ * Description:
+ *   Print the results of one test as key=value pairs: the throughput in
+ *   KiB/s, the rate of the operations and their latency; then, with
+ *   CONFIG_FS_IOSTAT, the operations of each layer of the I/O stack that
+ *   the test caused.  The time of a layer includes the time of the
+ *   layers below it.
+ *
+ ****************************************************************************/
+
+static void fsb_report(FAR struct fsb_result_s *result)
+{
+  uint64_t elapsed;
+#ifdef CONFIG_FS_IOSTAT
+  struct fs_iostat_s iostat[FS_IOSTAT_NOPS];
+  uint32_t freq = up_perf_getfreq();
+  uint64_t time;
+  int op;
+#endif
+
+  result->elapsed = fsb_now() - result->start;
+  elapsed = result->elapsed > 0 ? result->elapsed : 1;
+
+  if (result->count == 0)
+    {
+      result->min = 0;
+    }
+
+  printf("fsbench: test=%s count=%" PRIu32 " bytes=%" PRIu64
+         " seconds=%" PRIu32 ".%03" PRIu32 " kibps=%" PRIu64
+         " rate=%" PRIu64 " min=%" PRIu64 " avg=%" PRIu64
+         " max=%" PRIu64 " unit=us\n",
+         result->name, result->count, result->bytes,
+         (uint32_t)(elapsed / NSEC_PER_SEC),
+         (uint32_t)((elapsed % NSEC_PER_SEC) / NSEC_PER_MSEC),
+         (result->bytes * NSEC_PER_SEC / 1024) / elapsed,
+         ((uint64_t)result->count * NSEC_PER_SEC) / elapsed,
+         result->min / NSEC_PER_USEC,
+         result->count > 0 ?
+           elapsed / result->count / NSEC_PER_USEC : 0,
+         result->max / NSEC_PER_USEC);
+
+#ifdef CONFIG_FS_IOSTAT
+  fs_iostat_get(iostat);
+
+  for (op = 0; op < FS_IOSTAT_NOPS; op++)
+    {
+      if (iostat[op].count == result->iostat[op].count)
+        {
+          continue;
+        }
+
+      /* Convert the counts of the performance counter to microseconds */
+
+      time = iostat[op].time - result->iostat[op].time;
+      time = freq > 0 ? (time / freq) * USEC_PER_SEC +
+                        ((time % freq) * USEC_PER_SEC) / freq : 0;
+      printf("fsbench: test=%s layer=%s count=%" PRIu32
+             " errors=%" PRIu32 " size=%" PRIu64 " time=%" PRIu64
+             " unit=us\n", result->name, fs_iostat_name(op),
+             iostat[op].count - result->iostat[op].count,
+             iostat[op].errors - result->iostat[op].errors,
+             iostat[op].size - result->iostat[op].size, time);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: fsb_path
+ ****************************************************************************/
+
+static void fsb_path(FAR char *path, FAR const char *name, int index)
+{
+  snprintf(path, FSB_PATHLEN, "%s/fsb%s%d", g_fsb.directory, name, index);
+}
+
+/****************************************************************************
+ * Name: fsb_random
+ *
+ * Description:
+ *   A small generator so that every run makes the same accesses.
+ *
+ ****************************************************************************/
+
+static uint32_t fsb_random(FAR uint32_t *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return *seed >> 8;
+}
+
+/****************************************************************************
+ * Name: fsb_sequential
+ *
+ * Description:
+ *   Write the test file from the start to the end, then close it, or read
+ *   it back.  The write includes the final fsync(), so that the data is on
+ *   the media when it is timed.
+ *
+ ****************************************************************************/
+
+static int fsb_sequential(bool writing)
+{
+  struct fsb_result_s result;
+  char path[FSB_PATHLEN];
+  uint64_t begin;
+  size_t offset;
+  ssize_t ret;
+  int fd;
+
+  fsb_path(path, "seq", 0);
+  fd = open(path, writing ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY, 0666);
+  if (fd < 0)
+    {
+      printf("fsbench: ERROR: open %s failed: %d\n", path, errno);
+      return -1;
+    }
+
+  memset(g_fsb.buffer, 0x5a, g_fsb.blocksize);
+  fsb_start(&result, writing ? "seq-write" : "seq-read");
+
+  for (offset = 0; offset < g_fsb.filesize; offset += g_fsb.blocksize)
+    {
+      begin = fsb_now();
+      ret = writing ? write(fd, g_fsb.buffer, g_fsb.blocksize) :
+                      read(fd, g_fsb.buffer, g_fsb.blocksize);
+      if (ret != g_fsb.blocksize)
+        {
+          printf("fsbench: ERROR: %s failed: %d\n", result.name, errno);
+          close(fd);
+          return -1;
+        }
+
+      fsb_record(&result, begin, ret);
+    }
+
+  if (writing && fsync(fd) < 0)
+    {
+      printf("fsbench: ERROR: fsync failed: %d\n", errno);
+      close(fd);
+      return -1;
+    }
+
+  close(fd);
+  fsb_report(&result);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: fsb_randomio
+ *
+ * Description:
+ *   Read or overwrite blocks of the test file at random block aligned
+ *   offsets.
+ *
+ ****************************************************************************/
+
+static int fsb_randomio(bool writing)
+{
+  struct fsb_result_s result;
+  char path[FSB_PATHLEN];
+  uint32_t seed = 1;
+  size_t nblocks;
+  uint64_t begin;
+  off_t offset;
+  ssize_t ret;
+  int fd;
+  int i;
+
+  nblocks = g_fsb.filesize / g_fsb.blocksize;
+
+  fsb_path(path, "seq", 0);
+  fd = open(path, writing ? O_WRONLY : O_RDONLY);
+  if (fd < 0)
+    {
+      printf("fsbench: ERROR: open %s failed: %d, "
+             "the sequential write test creates it\n", path, errno);
+      return -1;
+    }
+
+  fsb_start(&result, writing ? "rnd-write" : "rnd-read");
+
+  for (i = 0; i < g_fsb.nrandom; i++)
+    {
+      offset = (off_t)(fsb_random(&seed) % nblocks) * g_fsb.blocksize;
+
+      begin = fsb_now();
+      if (lseek(fd, offset, SEEK_SET) != offset)
+        {
+          ret = -1;
+        }
+      else
+        {
+          ret = writing ? write(fd, g_fsb.buffer, g_fsb.blocksize) :
+                          read(fd, g_fsb.buffer, g_fsb.blocksize);
+        }
+
+      if (ret != g_fsb.blocksize)
+        {
+          printf("fsbench: ERROR: %s failed: %d\n", result.name, errno);
+          close(fd);
+          return -1;
+        }
+
+      fsb_record(&result, begin, ret);
+    }
+
+  if (writing && fsync(fd) < 0)
+    {
+      printf("fsbench: ERROR: fsync failed: %d\n", errno);
+      close(fd);
+      return -1;
+    }
+
+  close(fd);
+  fsb_report(&result);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: fsb_metadata
+ *
+ * Description:
+ *   Create small files, then stat(), rename(), list and delete them.  Each
+ *   kind of operation is reported as a test of its own.
+ *
+ ****************************************************************************/
+
+static int fsb_metadata(void)
+{
+  struct fsb_result_s result;
+  char path[FSB_PATHLEN];
+  char newpath[FSB_PATHLEN];
+  FAR struct dirent *entry;
+  FAR DIR *dir;
+  struct stat buf;
+  uint64_t begin;
+  int fd;
+  int i;
+
+  memset(g_fsb.buffer, 0xa5, FSB_SMALLSIZE);
+  fsb_start(&result, "create");
+
+  for (i = 0; i < g_fsb.nfiles; i++)
+    {
+      fsb_path(path, "small", i);
+
+      begin = fsb_now();
+      fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+      if (fd < 0 || write(fd, g_fsb.buffer, FSB_SMALLSIZE) != FSB_SMALLSIZE)
+        {
+          printf("fsbench: ERROR: create %s failed: %d\n", path, errno);
+          if (fd >= 0)
+            {
+              close(fd);
+            }
+
+          return -1;
+        }
+
+      close(fd);
+      fsb_record(&result, begin, FSB_SMALLSIZE);
+    }
+
+  fsb_report(&result);
+
+  fsb_start(&result, "stat");
+
+  for (i = 0; i < g_fsb.nfiles; i++)
+    {
+      fsb_path(path, "small", i);
+
+      begin = fsb_now();
+      if (stat(path, &buf) < 0)
+        {
+          printf("fsbench: ERROR: stat %s failed: %d\n", path, errno);
+          return -1;
+        }
+
+      fsb_record(&result, begin, 0);
+    }
+
+  fsb_report(&result);
+
+  fsb_start(&result, "rename");
+
+  for (i = 0; i < g_fsb.nfiles; i++)
+    {
+      fsb_path(path, "small", i);
+      fsb_path(newpath, "moved", i);
+
+      begin = fsb_now();
+      if (rename(path, newpath) < 0)
+        {
+          printf("fsbench: ERROR: rename %s failed: %d\n", path, errno);
+          return -1;
+        }
+
+      fsb_record(&result, begin, 0);
+    }
+
+  fsb_report(&result);
+
+  fsb_start(&result, "readdir");
+
+  dir = opendir(g_fsb.directory);
+  if (dir == NULL)
+    {
+      printf("fsbench: ERROR: opendir %s failed: %d\n", g_fsb.directory,
+             errno);
+      return -1;
+    }
+
+  for (; ; )
+    {
+      begin = fsb_now();
+      entry = readdir(dir);
+      if (entry == NULL)
+        {
+          break;
+        }
+
+      fsb_record(&result, begin, 0);
+    }
+
+  closedir(dir);
+  fsb_report(&result);
+
+  fsb_start(&result, "unlink");
+
+  for (i = 0; i < g_fsb.nfiles; i++)
+    {
+      fsb_path(path, "moved", i);
+
+      begin = fsb_now();
+      if (unlink(path) < 0)
+        {
+          printf("fsbench: ERROR: unlink %s failed: %d\n", path, errno);
+          return -1;
+        }
+
+      fsb_record(&result, begin, 0);
+    }
+
+  fsb_report(&result);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: fsb_fsync
+ *
+ * Description:
+ *   Append one block and synchronize the file, like a logger that must
+ *   not lose its records.  The latency is the one of fsync() alone.
+ *
+ ****************************************************************************/
+
+static int fsb_fsync(void)
+{
+  struct fsb_result_s result;
+  char path[FSB_PATHLEN];
+  uint64_t begin;
+  int fd;
+  int i;
+
+  fsb_path(path, "sync", 0);
+  fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd < 0)
+    {
+      printf("fsbench: ERROR: open %s failed: %d\n", path, errno);
+      return -1;
+    }
+
+  fsb_start(&result, "fsync");
+
+  for (i = 0; i < g_fsb.nsyncs; i++)
+    {
+      if (write(fd, g_fsb.buffer, g_fsb.blocksize) != g_fsb.blocksize)
+        {
+          printf("fsbench: ERROR: write failed: %d\n", errno);
+          break;
+        }
+
+      begin = fsb_now();
+      if (fsync(fd) < 0)
+        {
+          printf("fsbench: ERROR: fsync failed: %d\n", errno);
+          break;
+        }
+
+      fsb_record(&result, begin, g_fsb.blocksize);
+    }
+
+  close(fd);
+  unlink(path);
+
+  if (i < g_fsb.nsyncs)
+    {
+      return -1;
+    }
+
+  fsb_report(&result);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: fsb_usage
+ ****************************************************************************/
+
+static void fsb_usage(FAR const char *progname)
+{
+  printf("Usage: %s [-d directory] [-s KiB] [-b blocksize] [-n files] "
+         "[-r accesses] [-f fsyncs] [-t tests]\n", progname);
+  printf("  -d directory  Where the files are created (%s)\n",
+         FSB_DIRECTORY);
+  printf("  -s KiB        Size of the sequential file (%d)\n",
+         FSB_FILESIZE);
+  printf("  -b blocksize  Size of each read and write (%d)\n",
+         FSB_BLOCKSIZE);
+  printf("  -n files      Number of small files (%d)\n", FSB_NFILES);
+  printf("  -r accesses   Number of random reads and writes (%d)\n",
+         FSB_NRANDOM);
+  printf("  -f fsyncs     Number of fsync() (%d)\n", FSB_NSYNCS);
+  printf("  -t tests      Tests to run among w (sequential write), "
+         "r (sequential read), R (random read), W (random write), "
+         "m (metadata) and s (fsync)\n");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fsbench_main
+ *
+ * Description:
+ *   Measure the throughput and the latency of a file system and print the
+ *   results.
+ *
+ ****************************************************************************/
+
+int fsbench_main(int argc, FAR char *argv[])
+{
+  FAR const char *tests;
+  FAR const char *p;
+  char path[FSB_PATHLEN];
+  int ret = 0;
+  int ch;
+
+  memset(&g_fsb, 0, sizeof(g_fsb));
+  g_fsb.directory = FSB_DIRECTORY;
+  g_fsb.filesize  = FSB_FILESIZE * 1024;
+  g_fsb.blocksize = FSB_BLOCKSIZE;
+  g_fsb.nfiles    = FSB_NFILES;
+  g_fsb.nrandom   = FSB_NRANDOM;
+  g_fsb.nsyncs    = FSB_NSYNCS;
+  g_fsb.tests     = FSB_TEST_ALL;
+
+  optind = 1;
+  while ((ch = getopt(argc, argv, "d:s:b:n:r:f:t:h")) != ERROR)
+    {
+      switch (ch)
+        {
+          case 'd':
+            g_fsb.directory = optarg;
+            break;
+
+          case 's':
+            g_fsb.filesize = (size_t)atoi(optarg) * 1024;
+            break;
+
+          case 'b':
+            g_fsb.blocksize = atoi(optarg);
+            break;
+
+          case 'n':
+            g_fsb.nfiles = atoi(optarg);
+            break;
+
+          case 'r':
+            g_fsb.nrandom = atoi(optarg);
+            break;
+
+          case 'f':
+            g_fsb.nsyncs = atoi(optarg);
+            break;
+
+          case 't':
+            g_fsb.tests = 0;
+            for (tests = optarg; *tests != '\0'; tests++)
+              {
+                p = strchr(FSB_TESTS, *tests);
+                if (p != NULL)
+                  {
+                    g_fsb.tests |= 1 << (p - FSB_TESTS);
+                  }
+              }
+            break;
+
+          default:
+            fsb_usage(argv[0]);
+            return ch == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+  if (g_fsb.blocksize < FSB_SMALLSIZE ||
+      g_fsb.filesize < g_fsb.blocksize ||
+      g_fsb.nfiles < 0 || g_fsb.nrandom < 0 || g_fsb.nsyncs < 0)
+    {
+      fsb_usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+  g_fsb.buffer = malloc(g_fsb.blocksize);
+  if (g_fsb.buffer == NULL)
+    {
+      printf("fsbench: ERROR: no memory for %zu bytes\n", g_fsb.blocksize);
+      return EXIT_FAILURE;
+    }
+
+  printf("fsbench: directory=%s filesize=%zu blocksize=%zu nfiles=%d "
+         "nrandom=%d nsyncs=%d\n", g_fsb.directory, g_fsb.filesize,
+         g_fsb.blocksize, g_fsb.nfiles, g_fsb.nrandom, g_fsb.nsyncs);
+
+  if ((g_fsb.tests & FSB_TEST_SEQWRITE) != 0)
+    {
+      ret |= fsb_sequential(true);
+    }
+
+  if ((g_fsb.tests & FSB_TEST_SEQREAD) != 0)
+    {
+      ret |= fsb_sequential(false);
+    }
+
+  if ((g_fsb.tests & FSB_TEST_RNDREAD) != 0)
+    {
+      ret |= fsb_randomio(false);
+    }
+
+  if ((g_fsb.tests & FSB_TEST_RNDWRITE) != 0)
+    {
+      ret |= fsb_randomio(true);
+    }
+
+  if ((g_fsb.tests & FSB_TEST_META) != 0)
+    {
+      ret |= fsb_metadata();
+    }
+
+  if ((g_fsb.tests & FSB_TEST_FSYNC) != 0)
+    {
+      ret |= fsb_fsync();
+    }
+
+  /* Leave the volume as it was found */
+
+  fsb_path(path, "seq", 0);
+  unlink(path);
+
+  free(g_fsb.buffer);
+  return ret == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif /* CONFIG_BOARD_FSBENCH */
@@ -0,0 +1,851 @@
+/****************************************************************************
+ * boards/latencytest.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <sched.h>
+#include <mqueue.h>
+#include <fcntl.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/board.h>
+#include <nuttx/clock.h>
+
+#ifdef CONFIG_BOARD_LATENCYTEST
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LAT_NBUCKETS       CONFIG_BOARD_LATENCYTEST_NBUCKETS
+#define LAT_STACKSIZE      CONFIG_BOARD_LATENCYTEST_STACKSIZE
+
+/* Default parameters.  The periodic wakeups cannot come more often than
+ * once per system tick (or per timer resolution with
+ * CONFIG_SCHED_TICKLESS), so the interval is never shorter than that.
+ */
+
+#define LAT_LOOPS          1000
+#if USEC_PER_TICK > 1000
+#  define LAT_INTERVAL     USEC_PER_TICK    /* Microseconds */
+#else
+#  define LAT_INTERVAL     1000             /* Microseconds */
+#endif
+#define LAT_PRIORITY       200
+
+/* Number of sched_yield() per context switch sample */
+
+#define LAT_YIELDS         100
+
+#define LAT_SIGNO          SIGUSR1
+#define LAT_MQREQ          "/latreq"
+#define LAT_MQRSP          "/latrsp"
+
+/* The tests, selected with -t */
+
+#define LAT_TEST_NANOSLEEP (1 << 0)  /* 'n' */
+#define LAT_TEST_TIMER     (1 << 1)  /* 't' */
+#define LAT_TEST_SEM       (1 << 2)  /* 's' */
+#define LAT_TEST_MQ        (1 << 3)  /* 'm' */
+#define LAT_TEST_SWITCH    (1 << 4)  /* 'c' */
+#define LAT_TEST_ALL       0x1f
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The results of one test, in nanoseconds */
+
+struct lat_stats_s
+{
+  FAR const char *name;              /* Name of the test */
+  int cpu;                           /* CPU of the measuring thread */
+  uint32_t count;                    /* Number of samples */
+  uint32_t overflow;                 /* Samples beyond the histogram */
+  uint64_t min;
+  uint64_t max;
+  uint64_t sum;
+  uint32_t hist[LAT_NBUCKETS];       /* One bucket per microsecond */
+};
+
+/* The state shared by the two threads of a wakeup or round trip test */
+
+struct lat_pair_s
+{
+  FAR struct lat_stats_s *stats;
+  sem_t request;
+  sem_t response;
+  mqd_t mqreq;
+  mqd_t mqrsp;
+  volatile uint64_t start;
+  volatile bool done;
+};
+
+/* The parameters of the run */
+
+struct lat_options_s
+{
+  int loops;
+  uint32_t interval;                 /* Nanoseconds */
+  int priority;
+  int tests;
+  bool histogram;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct lat_options_s g_lat;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lat_now
+ ****************************************************************************/
+
+static uint64_t lat_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/****************************************************************************
+ * Name: lat_totimespec
+ ****************************************************************************/
+
+static void lat_totimespec(uint64_t ns, FAR struct timespec *ts)
+{
+  ts->tv_sec  = ns / NSEC_PER_SEC;
+  ts->tv_nsec = ns % NSEC_PER_SEC;
+}
+
+/****************************************************************************
+ * Name: lat_init
+ ****************************************************************************/
+
+static void lat_init(FAR struct lat_stats_s *stats, FAR const char *name,
+                     int cpu)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->name = name;
+  stats->cpu  = cpu;
+  stats->min  = UINT64_MAX;
+}
+
+/****************************************************************************
+ * Name: lat_record
+ ****************************************************************************/
+
+static void lat_record(FAR struct lat_stats_s *stats, uint64_t ns)
+{
+  uint64_t us = ns / NSEC_PER_USEC;
+
+  if (ns < stats->min)
+    {
+      stats->min = ns;
+    }
+
+  if (ns > stats->max)
+    {
+      stats->max = ns;
+    }
+
+  if (us < LAT_NBUCKETS)
+    {
+      stats->hist[us]++;
+    }
+  else
+    {
+      stats->overflow++;
+    }
+
+  stats->sum += ns;
+  stats->count++;
+}
+
+/****************************************************************************
+ * Name: lat_report
+ *
+ * Description:
+ *   Print the results of one test.  Each line is a list of key=value pairs
+ *   so that it can be parsed by regression tracking scripts.
+ *
+ ****************************************************************************/
+
+static void lat_report(FAR struct lat_stats_s *stats)
+{
+  int i;
+
+  if (stats->count == 0)
+    {
+      printf("latency: test=%s cpu=%d samples=0\n", stats->name,
+             stats->cpu);
+      return;
+    }
+
+  printf("latency: test=%s cpu=%d samples=%" PRIu32 " min=%" PRIu64
+         " avg=%" PRIu64 " max=%" PRIu64 " overflow=%" PRIu32 " unit=ns\n",
+         stats->name, stats->cpu, stats->count, stats->min,
+         stats->sum / stats->count, stats->max, stats->overflow);
+
+  if (g_lat.histogram)
+    {
+      for (i = 0; i < LAT_NBUCKETS; i++)
+        {
+          if (stats->hist[i] != 0)
+            {
+              printf("hist: test=%s cpu=%d us=%d count=%" PRIu32 "\n",
+                     stats->name, stats->cpu, i, stats->hist[i]);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: lat_create
+ *
+ * Description:
+ *   Start a SCHED_FIFO thread with the given priority, on the given CPU if
+ *   cpu is not negative.
+ *
+ ****************************************************************************/
+
+static int lat_create(FAR pthread_t *thread, int priority, int cpu,
+                      pthread_startroutine_t entry, FAR void *arg)
+{
+  struct sched_param param;
+  pthread_attr_t attr;
+  int ret;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, LAT_STACKSIZE);
+  pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+  pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+
+  param.sched_priority = priority;
+  pthread_attr_setschedparam(&attr, &param);
+
+#ifdef CONFIG_SMP
+  if (cpu >= 0)
+    {
+      cpu_set_t cpuset;
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu, &cpuset);
+      pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+    }
+#endif
+
+  ret = pthread_create(thread, &attr, entry, arg);
+  pthread_attr_destroy(&attr);
+
+  if (ret != 0)
+    {
+      printf("latency: ERROR: pthread_create failed: %d\n", ret);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: lat_nanosleep_thread
+ *
+ * Description:
+ *   Periodic thread: the latency is the difference between the programmed
+ *   absolute wakeup time and the time when the thread runs.
+ *
+ ****************************************************************************/
+
+static FAR void *lat_nanosleep_thread(FAR void *arg)
+{
+  FAR struct lat_stats_s *stats = arg;
+  struct timespec ts;
+  uint64_t expected;
+  uint64_t now;
+  int i;
+
+  expected = lat_now();
+
+  for (i = 0; i < g_lat.loops; i++)
+    {
+      expected += g_lat.interval;
+      lat_totimespec(expected, &ts);
+
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+
+      now = lat_now();
+      lat_record(stats, now > expected ? now - expected : 0);
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: lat_timer_thread
+ *
+ * Description:
+ *   Same measurement with a periodic POSIX timer whose signal is accepted
+ *   with sigwaitinfo(): this is the wakeup of a task from the timer
+ *   interrupt through the signal logic.
+ *
+ ****************************************************************************/
+
+static FAR void *lat_timer_thread(FAR void *arg)
+{
+  FAR struct lat_stats_s *stats = arg;
+  struct itimerspec its;
+  struct sigevent sev;
+  siginfo_t info;
+  sigset_t set;
+  timer_t timer;
+  uint64_t expected;
+  uint64_t now;
+  int overrun;
+  int i;
+
+  sigemptyset(&set);
+  sigaddset(&set, LAT_SIGNO);
+  pthread_sigmask(SIG_BLOCK, &set, NULL);
+
+  memset(&sev, 0, sizeof(sev));
+  sev.sigev_notify = SIGEV_SIGNAL;
+  sev.sigev_signo  = LAT_SIGNO;
+
+  if (timer_create(CLOCK_MONOTONIC, &sev, &timer) < 0)
+    {
+      printf("latency: ERROR: timer_create failed: %d\n", errno);
+      return NULL;
+    }
+
+  expected = lat_now() + g_lat.interval;
+  lat_totimespec(expected, &its.it_value);
+  lat_totimespec(g_lat.interval, &its.it_interval);
+  timer_settime(timer, TIMER_ABSTIME, &its, NULL);
+
+  for (i = 0; i < g_lat.loops; i++)
+    {
+      if (sigwaitinfo(&set, &info) < 0)
+        {
+          continue;
+        }
+
+      now = lat_now();
+      lat_record(stats, now > expected ? now - expected : 0);
+
+      /* Skip the expirations that were lost while we were late */
+
+      overrun = timer_getoverrun(timer);
+      if (overrun < 0)
+        {
+          overrun = 0;
+        }
+
+      expected += (uint64_t)g_lat.interval * (1 + overrun);
+    }
+
+  timer_delete(timer);
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: lat_periodic
+ *
+ * Description:
+ *   Run a periodic test, concurrently on every CPU.
+ *
+ ****************************************************************************/
+
+static void lat_periodic(FAR const char *name, pthread_startroutine_t entry)
+{
+  FAR struct lat_stats_s *stats;
+  pthread_t thread[CONFIG_SMP_NCPUS];
+  bool started[CONFIG_SMP_NCPUS];
+  int cpu;
+
+  stats = malloc(CONFIG_SMP_NCPUS * sizeof(struct lat_stats_s));
+  if (stats == NULL)
+    {
+      printf("latency: ERROR: no memory for %s\n", name);
+      return;
+    }
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      lat_init(&stats[cpu], name, cpu);
+      started[cpu] = lat_create(&thread[cpu], g_lat.priority, cpu, entry,
+                                &stats[cpu]) == 0;
+    }
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (started[cpu])
+        {
+          pthread_join(thread[cpu], NULL);
+          lat_report(&stats[cpu]);
+        }
+    }
+
+  free(stats);
+}
+
+/****************************************************************************
+ * Name: lat_sem_waiter/lat_sem_poster
+ *
+ * Description:
+ *   The poster takes a timestamp right before sem_post(), the waiter right
+ *   after it returns from sem_wait().  The poster then waits for the
+ *   waiter so that every sample starts from the same state.
+ *
+ ****************************************************************************/
+
+static FAR void *lat_sem_waiter(FAR void *arg)
+{
+  FAR struct lat_pair_s *pair = arg;
+  uint64_t now;
+
+  for (; ; )
+    {
+      sem_wait(&pair->request);
+      now = lat_now();
+
+      if (pair->done)
+        {
+          break;
+        }
+
+      lat_record(pair->stats, now - pair->start);
+      sem_post(&pair->response);
+    }
+
+  return NULL;
+}
+
+static FAR void *lat_sem_poster(FAR void *arg)
+{
+  FAR struct lat_pair_s *pair = arg;
+  int i;
+
+  for (i = 0; i < g_lat.loops; i++)
+    {
+      usleep(g_lat.interval / NSEC_PER_USEC);
+
+      pair->start = lat_now();
+      sem_post(&pair->request);
+      sem_wait(&pair->response);
+    }
+
+  pair->done = true;
+  sem_post(&pair->request);
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: lat_mq_server/lat_mq_client
+ *
+ * Description:
+ *   The client measures the time for a message to reach the server and
+ *   for its reply to come back.
+ *
+ ****************************************************************************/
+
+static FAR void *lat_mq_server(FAR void *arg)
+{
+  FAR struct lat_pair_s *pair = arg;
+  char msg;
+
+  for (; ; )
+    {
+      if (mq_receive(pair->mqreq, &msg, 1, NULL) < 0 || msg == 0)
+        {
+          break;
+        }
+
+      mq_send(pair->mqrsp, &msg, 1, 0);
+    }
+
+  return NULL;
+}
+
+static FAR void *lat_mq_client(FAR void *arg)
+{
+  FAR struct lat_pair_s *pair = arg;
+  uint64_t start;
+  char msg = 1;
+  int i;
+
+  for (i = 0; i < g_lat.loops; i++)
+    {
+      usleep(g_lat.interval / NSEC_PER_USEC);
+
+      start = lat_now();
+      mq_send(pair->mqreq, &msg, 1, 0);
+      if (mq_receive(pair->mqrsp, &msg, 1, NULL) < 0)
+        {
+          break;
+        }
+
+      lat_record(pair->stats, lat_now() - start);
+    }
+
+  msg = 0;
+  mq_send(pair->mqreq, &msg, 1, 0);
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: lat_switch_partner/lat_switch_thread
+ *
+ * Description:
+ *   Two threads of the same priority on the same CPU that yield to each
+ *   other: each sched_yield() of the measuring thread is two context
+ *   switches.
+ *
+ ****************************************************************************/
+
+static FAR void *lat_switch_partner(FAR void *arg)
+{
+  FAR struct lat_pair_s *pair = arg;
+
+  while (!pair->done)
+    {
+      sched_yield();
+    }
+
+  return NULL;
+}
+
+static FAR void *lat_switch_thread(FAR void *arg)
+{
+  FAR struct lat_pair_s *pair = arg;
+  uint64_t start;
+  int i;
+  int j;
+
+  for (i = 0; i < g_lat.loops; i++)
+    {
+      start = lat_now();
+
+      for (j = 0; j < LAT_YIELDS; j++)
+        {
+          sched_yield();
+        }
+
+      lat_record(pair->stats, (lat_now() - start) / (2 * LAT_YIELDS));
+    }
+
+  pair->done = true;
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: lat_pair
+ *
+ * Description:
+ *   Run a test made of a passive thread (started first, on cpu1 with
+ *   priority prio1) and of the measuring thread (on cpu0 with prio0).
+ *
+ ****************************************************************************/
+
+static void lat_pair(FAR const char *name, pthread_startroutine_t passive,
+                     int prio1, int cpu1, pthread_startroutine_t active,
+                     int prio0, int cpu0)
+{
+  FAR struct lat_stats_s *stats;
+  struct lat_pair_s pair;
+  struct mq_attr attr;
+  pthread_t thread0;
+  pthread_t thread1;
+
+  stats = malloc(sizeof(struct lat_stats_s));
+  if (stats == NULL)
+    {
+      printf("latency: ERROR: no memory for %s\n", name);
+      return;
+    }
+
+  memset(&pair, 0, sizeof(pair));
+  lat_init(stats, name, cpu0 < 0 ? 0 : cpu0);
+  pair.stats = stats;
+
+  sem_init(&pair.request, 0, 0);
+  sem_init(&pair.response, 0, 0);
+  sem_setprotocol(&pair.request, SEM_PRIO_NONE);
+  sem_setprotocol(&pair.response, SEM_PRIO_NONE);
+
+  attr.mq_maxmsg  = 1;
+  attr.mq_msgsize = 1;
+  attr.mq_flags   = 0;
+
+  pair.mqreq = mq_open(LAT_MQREQ, O_RDWR | O_CREAT, 0666, &attr);
+  pair.mqrsp = mq_open(LAT_MQRSP, O_RDWR | O_CREAT, 0666, &attr);
+
+  if (pair.mqreq == (mqd_t)-1 || pair.mqrsp == (mqd_t)-1)
+    {
+      printf("latency: ERROR: mq_open failed: %d\n", errno);
+    }
+  else if (lat_create(&thread1, prio1, cpu1, passive, &pair) == 0)
+    {
+      if (lat_create(&thread0, prio0, cpu0, active, &pair) == 0)
+        {
+          pthread_join(thread0, NULL);
+        }
+      else
+        {
+          /* Release the passive thread */
+
+          pair.done = true;
+          sem_post(&pair.request);
+          mq_send(pair.mqreq, "", 1, 0);
+        }
+
+      pthread_join(thread1, NULL);
+      lat_report(stats);
+    }
+
+  if (pair.mqreq != (mqd_t)-1)
+    {
+      mq_close(pair.mqreq);
+    }
+
+  if (pair.mqrsp != (mqd_t)-1)
+    {
+      mq_close(pair.mqrsp);
+    }
+
+  mq_unlink(LAT_MQREQ);
+  mq_unlink(LAT_MQRSP);
+  sem_destroy(&pair.request);
+  sem_destroy(&pair.response);
+  free(stats);
+}
+
+/****************************************************************************
+ * Name: lat_usage
+ ****************************************************************************/
+
+static void lat_usage(FAR const char *progname)
+{
+  printf("Usage: %s [-l loops] [-i interval] [-p priority] [-t tests] "
+         "[-H]\n", progname);
+  printf("  -l loops     Number of samples of each test (%d)\n",
+         LAT_LOOPS);
+  printf("  -i interval  Period of the tests in microseconds, at least "
+         "one tick (%d)\n", LAT_INTERVAL);
+  printf("  -p priority  Priority of the measuring threads (%d)\n",
+         LAT_PRIORITY);
+  printf("  -t tests     Tests to run among n (nanosleep), t (timer), "
+         "s (sem), m (mqueue) and c (context switch)\n");
+  printf("  -H           Print the histograms\n");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latencytest_main
+ *
+ * Description:
+ *   Measure the wakeup latencies and the context switch cost of the
+ *   scheduler and print the results.
+ *
+ ****************************************************************************/
+
+int latencytest_main(int argc, FAR char *argv[])
+{
+  struct sched_param param;
+  struct sched_param saved;
+  FAR const char *tests;
+  sigset_t set;
+  int prio;
+  int ch;
+  int cpu;
+
+  g_lat.loops     = LAT_LOOPS;
+  g_lat.interval  = LAT_INTERVAL * NSEC_PER_USEC;
+  g_lat.priority  = LAT_PRIORITY;
+  g_lat.tests     = LAT_TEST_ALL;
+  g_lat.histogram = false;
+
+  optind = 1;
+  while ((ch = getopt(argc, argv, "l:i:p:t:Hh")) != ERROR)
+    {
+      switch (ch)
+        {
+          case 'l':
+            g_lat.loops = atoi(optarg);
+            break;
+
+          case 'i':
+            g_lat.interval = atoi(optarg) * NSEC_PER_USEC;
+            break;
+
+          case 'p':
+            g_lat.priority = atoi(optarg);
+            break;
+
+          case 't':
+            g_lat.tests = 0;
+            for (tests = optarg; *tests != '\0'; tests++)
+              {
+                FAR const char *p = strchr("ntsmc", *tests);
+
+                if (p != NULL)
+                  {
+                    g_lat.tests |= 1 << (p - "ntsmc");
+                  }
+              }
+            break;
+
+          case 'H':
+            g_lat.histogram = true;
+            break;
+
+          default:
+            lat_usage(argv[0]);
+            return ch == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+  if (g_lat.loops <= 0 || g_lat.interval == 0 ||
+      g_lat.priority <= SCHED_PRIORITY_MIN ||
+      g_lat.priority >= SCHED_PRIORITY_MAX)
+    {
+      lat_usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+  /* A shorter period would only measure the rounding to the next tick */
+
+  if (g_lat.interval < NSEC_PER_TICK)
+    {
+      g_lat.interval = NSEC_PER_TICK;
+    }
+
+  prio = g_lat.priority;
+
+  /* Run above the test threads so that they are all started before the
+   * measurements begin, and keep the timer signal for lat_timer_thread().
+   */
+
+  sched_getparam(0, &saved);
+  param.sched_priority = prio + 1;
+  sched_setparam(0, &param);
+
+  sigemptyset(&set);
+  sigaddset(&set, LAT_SIGNO);
+  pthread_sigmask(SIG_BLOCK, &set, NULL);
+
+  printf("latency: loops=%d interval=%" PRIu32 " priority=%d ncpus=%d\n",
+         g_lat.loops, g_lat.interval / NSEC_PER_USEC, prio,
+         CONFIG_SMP_NCPUS);
+
+  if ((g_lat.tests & LAT_TEST_NANOSLEEP) != 0)
+    {
+      lat_periodic("nanosleep", lat_nanosleep_thread);
+    }
+
+  if ((g_lat.tests & LAT_TEST_TIMER) != 0)
+    {
+      /* The signal goes to the whole task group, so one CPU at a time */
+
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          FAR struct lat_stats_s *stats;
+          pthread_t thread;
+
+          stats = malloc(sizeof(struct lat_stats_s));
+          if (stats == NULL)
+            {
+              break;
+            }
+
+          lat_init(stats, "timer", cpu);
+          if (lat_create(&thread, prio, cpu, lat_timer_thread, stats) == 0)
+            {
+              pthread_join(thread, NULL);
+              lat_report(stats);
+            }
+
+          free(stats);
+        }
+    }
+
+  if ((g_lat.tests & LAT_TEST_SEM) != 0)
+    {
+      /* Wakeup of a higher priority thread is a preemption in sem_post(),
+       * a lower priority one only runs when the poster blocks.
+       */
+
+      lat_pair("sem-preempt", lat_sem_waiter, prio, 0,
+               lat_sem_poster, prio - 1, 0);
+      lat_pair("sem-lowprio", lat_sem_waiter, prio - 1, 0,
+               lat_sem_poster, prio, 0);
+#ifdef CONFIG_SMP
+      lat_pair("sem-xcpu", lat_sem_waiter, prio, 1,
+               lat_sem_poster, prio, 0);
+#endif
+    }
+
+  if ((g_lat.tests & LAT_TEST_MQ) != 0)
+    {
+      lat_pair("mq-rtt", lat_mq_server, prio, 0,
+               lat_mq_client, prio, 0);
+#ifdef CONFIG_SMP
+      lat_pair("mq-rtt-xcpu", lat_mq_server, prio, 1,
+               lat_mq_client, prio, 0);
+#endif
+    }
+
+  if ((g_lat.tests & LAT_TEST_SWITCH) != 0)
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          lat_pair("switch", lat_switch_partner, prio, cpu,
+                   lat_switch_thread, prio, cpu);
+        }
+    }
+
+  sched_setparam(0, &saved);
+  return EXIT_SUCCESS;
+}
+
+#endif /* CONFIG_BOARD_LATENCYTEST */
@@ -0,0 +1,676 @@
+/****************************************************************************
+ * boards/mmbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/board.h>
+#include <nuttx/clock.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_BOARD_MMBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Default parameters */
+
+#define MMB_ITERATIONS     20000
+#define MMB_NSLOTS         256
+#define MMB_MAXSIZE        1024
+#define MMB_INTERVAL       2000    /* Iterations between two samples */
+#define MMB_NTHREADS       4
+
+#define MMB_HEAPSIZE       CONFIG_BOARD_MMBENCH_HEAPSIZE
+#define MMB_STACKSIZE      CONFIG_BOARD_MMBENCH_STACKSIZE
+#define MMB_MAXTHREADS     16
+
+/* The tests, selected with -t */
+
+#define MMB_TEST_MIX       (1 << 0)  /* 'm' */
+#define MMB_TEST_REALLOC   (1 << 1)  /* 'r' */
+#define MMB_TEST_THREADS   (1 << 2)  /* 't' */
+#define MMB_TEST_ALL       0x07
+#define MMB_TESTS          "mrt"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The parameters of the run */
+
+struct mmb_options_s
+{
+  FAR struct mm_heap_s *heap;        /* The heap under test */
+  int iterations;
+  int nslots;                        /* Live allocations at most */
+  size_t maxsize;                    /* Largest allocation */
+  int interval;                      /* Iterations between two samples */
+  int nthreads;
+  int tests;
+};
+
+/* The latency of one kind of call */
+
+struct mmb_stats_s
+{
+  uint64_t sum;                      /* Nanoseconds */
+  uint64_t min;
+  uint64_t max;
+  uint32_t count;
+  uint32_t fails;                    /* Calls that returned NULL */
+};
+
+/* The state of one thread of the churn test */
+
+struct mmb_thread_s
+{
+  FAR void **slots;
+  int nslots;
+  int iterations;
+  uint32_t seed;
+  struct mmb_stats_s mallocs;
+  struct mmb_stats_s frees;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct mmb_options_s g_mmb;
+
+/* The private heap, that is created at the first run and kept so that the
+ * results do not depend on the other users of the system heap.
+ */
+
+static FAR struct mm_heap_s *g_mmb_heap;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mmb_now
+ ****************************************************************************/
+
+static uint64_t mmb_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/****************************************************************************
+ * Name: mmb_random
+ ****************************************************************************/
+
+static uint32_t mmb_random(FAR uint32_t *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return *seed >> 8;
+}
+
+/****************************************************************************
+ * Name: mmb_size
+ *
+ * Description:
+ *   Return the size of the next allocation: mostly small objects, some
+ *   medium buffers and a few large ones, which is what fragments a heap.
+ *
+ ****************************************************************************/
+
+static size_t mmb_size(FAR uint32_t *seed)
+{
+  uint32_t r = mmb_random(seed);
+  uint32_t percent = r % 100;
+
+  r /= 100;
+  if (percent < 75)
+    {
+      return 8 + r % 120;
+    }
+  else if (percent < 95)
+    {
+      return 128 + r % (g_mmb.maxsize / 4 + 1);
+    }
+  else
+    {
+      return 1 + r % g_mmb.maxsize;
+    }
+}
+
+/****************************************************************************
+ * Name: mmb_init
+ ****************************************************************************/
+
+static void mmb_init(FAR struct mmb_stats_s *stats)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->min = UINT64_MAX;
+}
+
+/****************************************************************************
+ * Name: mmb_record
+ ****************************************************************************/
+
+static void mmb_record(FAR struct mmb_stats_s *stats, uint64_t begin,
+                       bool success)
+{
+  uint64_t ns = mmb_now() - begin;
+
+  stats->min  = ns < stats->min ? ns : stats->min;
+  stats->max  = ns > stats->max ? ns : stats->max;
+  stats->sum += ns;
+  stats->count++;
+
+  if (!success)
+    {
+      stats->fails++;
+    }
+}
+
+/****************************************************************************
+ * Name: mmb_merge
+ ****************************************************************************/
+
+static void mmb_merge(FAR struct mmb_stats_s *to,
+                      FAR const struct mmb_stats_s *from)
+{
+  to->min    = from->min < to->min ? from->min : to->min;
+  to->max    = from->max > to->max ? from->max : to->max;
+  to->sum   += from->sum;
+  to->count += from->count;
+  to->fails += from->fails;
+}
+
+/****************************************************************************
+ * Name: mmb_report
+ *
+ * Description:
+ *   Print the latency of one kind of call as key=value pairs.
+ *
+ ****************************************************************************/
+
+static void mmb_report(FAR const char *test, FAR const char *call,
+                       FAR const struct mmb_stats_s *stats)
+{
+  if (stats->count == 0)
+    {
+      return;
+    }
+
+  printf("mmbench: test=%s call=%s count=%" PRIu32 " fails=%" PRIu32
+         " min=%" PRIu64 " avg=%" PRIu64 " max=%" PRIu64 " unit=ns\n",
+         test, call, stats->count, stats->fails, stats->min,
+         stats->sum / stats->count, stats->max);
+}
+
+/****************************************************************************
+ * Name: mmb_sample
+ *
+ * Description:
+ *   Print the state of the free space of the heap; with 'histogram', also
+ *   the number and size of the free chunks of each size bucket.  The
+ *   fragmentation is the part of the free space, in permille, that is not
+ *   in the largest free chunk.
+ *
+ ****************************************************************************/
+
+static void mmb_sample(FAR const char *test, int iteration, bool histogram)
+{
+  struct mm_fraginfo_s info;
+  unsigned int frag = 0;
+  int ndx;
+
+  mm_fraginfo(g_mmb.heap, &info);
+  if (info.freesize > 0)
+    {
+      frag = 1000 - ((uint64_t)info.largest * 1000) / info.freesize;
+    }
+
+  printf("mmbench: test=%s iteration=%d used=%zu free=%zu nfree=%zu "
+         "largest=%zu frag=%u\n", test, iteration, info.nused,
+         info.freesize, info.nfree, info.largest, frag);
+
+  if (histogram)
+    {
+      for (ndx = 0; ndx < MM_FRAG_NBUCKETS; ndx++)
+        {
+          if (info.count[ndx] > 0)
+            {
+              printf("mmbench: test=%s bucket=%zu count=%zu size=%zu\n",
+                     test, (size_t)1 << ndx, info.count[ndx],
+                     info.size[ndx]);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mmb_churn
+ *
+ * Description:
+ *   Allocate into empty slots and free full slots, picked at random, so
+ *   that the number of live allocations stays around half of the slots.
+ *   With 'name', sample the heap every g_mmb.interval iterations.
+ *
+ ****************************************************************************/
+
+static void mmb_churn(FAR struct mmb_thread_s *thread, FAR const char *name)
+{
+  uint64_t begin;
+  int slot;
+  int i;
+
+  for (i = 0; i < thread->iterations; i++)
+    {
+      slot = mmb_random(&thread->seed) % thread->nslots;
+
+      begin = mmb_now();
+      if (thread->slots[slot] != NULL)
+        {
+          mm_free(g_mmb.heap, thread->slots[slot]);
+          mmb_record(&thread->frees, begin, true);
+          thread->slots[slot] = NULL;
+        }
+      else
+        {
+          thread->slots[slot] = mm_malloc(g_mmb.heap,
+                                          mmb_size(&thread->seed));
+          mmb_record(&thread->mallocs, begin, thread->slots[slot] != NULL);
+        }
+
+      if (name != NULL && (i + 1) % g_mmb.interval == 0)
+        {
+          mmb_sample(name, i + 1, false);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mmb_release
+ ****************************************************************************/
+
+static void mmb_release(FAR void **slots, int nslots)
+{
+  int i;
+
+  for (i = 0; i < nslots; i++)
+    {
+      if (slots[i] != NULL)
+        {
+          mm_free(g_mmb.heap, slots[i]);
+          slots[i] = NULL;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mmb_mix
+ *
+ * Description:
+ *   The single thread malloc()/free() mix, with the trend of the
+ *   fragmentation over the run.
+ *
+ ****************************************************************************/
+
+static int mmb_mix(FAR void **slots)
+{
+  struct mmb_thread_s thread;
+
+  memset(&thread, 0, sizeof(thread));
+  thread.slots      = slots;
+  thread.nslots     = g_mmb.nslots;
+  thread.iterations = g_mmb.iterations;
+  thread.seed       = 1;
+  mmb_init(&thread.mallocs);
+  mmb_init(&thread.frees);
+
+  mmb_sample("mix", 0, false);
+  mmb_churn(&thread, "mix");
+  mmb_report("mix", "malloc", &thread.mallocs);
+  mmb_report("mix", "free", &thread.frees);
+  mmb_sample("mix", g_mmb.iterations, true);
+
+  mmb_release(slots, g_mmb.nslots);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: mmb_realloc
+ *
+ * Description:
+ *   Grow buffers with realloc() in small steps, like a string builder,
+ *   while small allocations are made between them so that they can not
+ *   always grow in place.  The moves are the reallocations that returned
+ *   a new address.
+ *
+ ****************************************************************************/
+
+static int mmb_realloc(FAR void **slots)
+{
+  struct mmb_stats_s stats;
+  FAR void *buffers[4];
+  FAR void *mem;
+  uint32_t moves = 0;
+  uint32_t seed = 1;
+  uint64_t begin;
+  size_t size;
+  int pins = 0;
+  int i;
+
+  memset(buffers, 0, sizeof(buffers));
+  mmb_init(&stats);
+
+  for (size = 16; size <= g_mmb.maxsize * 4; size += 16)
+    {
+      for (i = 0; i < 4; i++)
+        {
+          begin = mmb_now();
+          mem   = mm_realloc(g_mmb.heap, buffers[i], size);
+          mmb_record(&stats, begin, mem != NULL);
+
+          if (mem == NULL)
+            {
+              continue;
+            }
+
+          if (buffers[i] != NULL && mem != buffers[i])
+            {
+              moves++;
+            }
+
+          buffers[i] = mem;
+
+          if (pins < g_mmb.nslots && (mmb_random(&seed) % 4) == 0)
+            {
+              slots[pins++] = mm_malloc(g_mmb.heap, 8 + seed % 56);
+            }
+        }
+    }
+
+  mmb_report("realloc", "realloc", &stats);
+  printf("mmbench: test=realloc moves=%" PRIu32 "\n", moves);
+  mmb_sample("realloc", stats.count, true);
+
+  for (i = 0; i < 4; i++)
+    {
+      mm_free(g_mmb.heap, buffers[i]);
+    }
+
+  mmb_release(slots, pins);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: mmb_thread
+ ****************************************************************************/
+
+static FAR void *mmb_thread(FAR void *arg)
+{
+  mmb_churn(arg, NULL);
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: mmb_threads
+ *
+ * Description:
+ *   The same mix in several threads at once, each with its own slots.
+ *   This measures the contention on the heap lock.
+ *
+ ****************************************************************************/
+
+static int mmb_threads(FAR void **slots)
+{
+  struct mmb_thread_s threads[MMB_MAXTHREADS];
+  pthread_t ids[MMB_MAXTHREADS];
+  struct mmb_stats_s mallocs;
+  struct mmb_stats_s frees;
+  pthread_attr_t attr;
+  uint64_t elapsed;
+  uint64_t start;
+  int started;
+  int i;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, MMB_STACKSIZE);
+
+  start = mmb_now();
+  for (started = 0; started < g_mmb.nthreads; started++)
+    {
+      FAR struct mmb_thread_s *thread = &threads[started];
+
+      memset(thread, 0, sizeof(*thread));
+      thread->nslots     = g_mmb.nslots / g_mmb.nthreads;
+      thread->slots      = &slots[started * thread->nslots];
+      thread->iterations = g_mmb.iterations / g_mmb.nthreads;
+      thread->seed       = started + 1;
+      mmb_init(&thread->mallocs);
+      mmb_init(&thread->frees);
+
+      if (pthread_create(&ids[started], &attr, mmb_thread, thread) != 0)
+        {
+          printf("mmbench: ERROR: pthread_create failed\n");
+          break;
+        }
+    }
+
+  mmb_init(&mallocs);
+  mmb_init(&frees);
+
+  for (i = 0; i < started; i++)
+    {
+      pthread_join(ids[i], NULL);
+      mmb_merge(&mallocs, &threads[i].mallocs);
+      mmb_merge(&frees, &threads[i].frees);
+    }
+
+  elapsed = mmb_now() - start;
+  pthread_attr_destroy(&attr);
+
+  printf("mmbench: test=threads threads=%d ops=%" PRIu32
+         " rate=%" PRIu64 "\n", started, mallocs.count + frees.count,
+         elapsed > 0 ? (uint64_t)(mallocs.count + frees.count) *
+                       NSEC_PER_SEC / elapsed : 0);
+  mmb_report("threads", "malloc", &mallocs);
+  mmb_report("threads", "free", &frees);
+  mmb_sample("threads", g_mmb.iterations, true);
+
+  mmb_release(slots, g_mmb.nslots);
+  return started == g_mmb.nthreads ? 0 : -1;
+}
+
+/****************************************************************************
+ * Name: mmb_usage
+ ****************************************************************************/
+
+static void mmb_usage(FAR const char *progname)
+{
+  printf("Usage: %s [-S] [-n iterations] [-s slots] [-m maxsize] "
+         "[-i interval] [-T threads] [-t tests]\n", progname);
+  printf("  -S             Use the system heap instead of a private heap "
+         "of %d bytes\n", MMB_HEAPSIZE);
+  printf("  -n iterations  Number of malloc() and free() (%d)\n",
+         MMB_ITERATIONS);
+  printf("  -s slots       Number of live allocations at most (%d)\n",
+         MMB_NSLOTS);
+  printf("  -m maxsize     Largest allocation (%d)\n", MMB_MAXSIZE);
+  printf("  -i interval    Iterations between two heap samples (%d)\n",
+         MMB_INTERVAL);
+  printf("  -T threads     Number of threads of the threads test (%d)\n",
+         MMB_NTHREADS);
+  printf("  -t tests       Tests to run among m (malloc/free mix), "
+         "r (realloc growth) and t (threads)\n");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mmbench_main
+ *
+ * Description:
+ *   Measure the latency of the heap allocator and the fragmentation of the
+ *   heap under typical allocation patterns and print the results.
+ *
+ ****************************************************************************/
+
+int mmbench_main(int argc, FAR char *argv[])
+{
+  FAR const char *tests;
+  FAR const char *p;
+  FAR void **slots;
+  FAR void *arena;
+  bool sysheap = false;
+  int ret = 0;
+  int ch;
+
+  memset(&g_mmb, 0, sizeof(g_mmb));
+  g_mmb.iterations = MMB_ITERATIONS;
+  g_mmb.nslots     = MMB_NSLOTS;
+  g_mmb.maxsize    = MMB_MAXSIZE;
+  g_mmb.interval   = MMB_INTERVAL;
+  g_mmb.nthreads   = MMB_NTHREADS;
+  g_mmb.tests      = MMB_TEST_ALL;
+
+  optind = 1;
+  while ((ch = getopt(argc, argv, "Sn:s:m:i:T:t:h")) != ERROR)
+    {
+      switch (ch)
+        {
+          case 'S':
+            sysheap = true;
+            break;
+
+          case 'n':
+            g_mmb.iterations = atoi(optarg);
+            break;
+
+          case 's':
+            g_mmb.nslots = atoi(optarg);
+            break;
+
+          case 'm':
+            g_mmb.maxsize = atoi(optarg);
+            break;
+
+          case 'i':
+            g_mmb.interval = atoi(optarg);
+            break;
+
+          case 'T':
+            g_mmb.nthreads = atoi(optarg);
+            break;
+
+          case 't':
+            g_mmb.tests = 0;
+            for (tests = optarg; *tests != '\0'; tests++)
+              {
+                p = strchr(MMB_TESTS, *tests);
+                if (p != NULL)
+                  {
+                    g_mmb.tests |= 1 << (p - MMB_TESTS);
+                  }
+              }
+            break;
+
+          default:
+            mmb_usage(argv[0]);
+            return ch == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+  if (g_mmb.iterations <= 0 || g_mmb.nslots <= 0 || g_mmb.maxsize < 16 ||
+      g_mmb.interval <= 0 || g_mmb.nthreads <= 0 ||
+      g_mmb.nthreads > MMB_MAXTHREADS || g_mmb.nthreads > g_mmb.nslots)
+    {
+      mmb_usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+  if (sysheap)
+    {
+      g_mmb.heap = g_mmheap;
+    }
+  else
+    {
+      if (g_mmb_heap == NULL)
+        {
+          arena = malloc(MMB_HEAPSIZE);
+          if (arena != NULL)
+            {
+              g_mmb_heap = mm_initialize("mmbench", arena, MMB_HEAPSIZE);
+            }
+        }
+
+      g_mmb.heap = g_mmb_heap;
+    }
+
+  slots = calloc(g_mmb.nslots, sizeof(FAR void *));
+  if (g_mmb.heap == NULL || slots == NULL)
+    {
+      printf("mmbench: ERROR: no memory for the heap\n");
+      free(slots);
+      return EXIT_FAILURE;
+    }
+
+  printf("mmbench: heap=%s iterations=%d slots=%d maxsize=%zu\n",
+         sysheap ? "system" : "private", g_mmb.iterations, g_mmb.nslots,
+         g_mmb.maxsize);
+
+  if ((g_mmb.tests & MMB_TEST_MIX) != 0)
+    {
+      ret |= mmb_mix(slots);
+    }
+
+  if ((g_mmb.tests & MMB_TEST_REALLOC) != 0)
+    {
+      ret |= mmb_realloc(slots);
+    }
+
+  if ((g_mmb.tests & MMB_TEST_THREADS) != 0)
+    {
+      ret |= mmb_threads(slots);
+    }
+
+  free(slots);
+  return ret == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif /* CONFIG_BOARD_MMBENCH */
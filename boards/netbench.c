@@ -0,0 +1,984 @@
+/****************************************************************************
+ * boards/netbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include <nuttx/board.h>
+#include <nuttx/clock.h>
+#include <nuttx/mm/iob.h>
+
+#ifdef CONFIG_BOARD_NETBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Default parameters */
+
+#define NB_ADDRESS         "127.0.0.1"
+#define NB_PORT            5471
+#define NB_DURATION        5       /* Seconds */
+#define NB_TCPLEN          1024
+#define NB_UDPLEN          64
+
+#define NB_MAXLEN          1472    /* Largest IPv4 datagram over Ethernet */
+#define NB_STACKSIZE       CONFIG_BOARD_NETBENCH_STACKSIZE
+
+/* First byte of each TCP connection or UDP datagram */
+
+#define NB_CMD_STREAM      's'     /* Sink data, then return the count */
+#define NB_CMD_RR          'r'     /* Echo each byte */
+#define NB_CMD_CONNECT     'c'     /* Close immediately */
+#define NB_CMD_DATA        'd'     /* UDP datagram to count */
+#define NB_CMD_END         'e'     /* UDP end of a test, return count */
+#define NB_CMD_QUIT        'q'     /* Stop the server */
+
+/* The tests, selected with -t */
+
+#define NB_TEST_TCP        (1 << 0)  /* 't' */
+#define NB_TEST_UDP        (1 << 1)  /* 'u' */
+#define NB_TEST_RR         (1 << 2)  /* 'r' */
+#define NB_TEST_CONNECT    (1 << 3)  /* 'c' */
+#define NB_TEST_ALL        0x0f
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The reply of the UDP server at the end of a test */
+
+begin_packed_struct struct nb_udpcount_s
+{
+  uint32_t packets;
+  uint32_t bytes;
+} end_packed_struct;
+
+/* The parameters of the run */
+
+struct nb_options_s
+{
+  struct sockaddr_in addr;           /* Server address */
+  int duration;                      /* Seconds */
+  int tcplen;                        /* Size of the TCP writes */
+  int udplen;                        /* Size of the UDP datagrams */
+  int tests;
+  bool server;                       /* Run the servers only */
+  bool client;                       /* Run the client only */
+};
+
+/* The measures common to all tests */
+
+struct nb_result_s
+{
+  FAR const char *name;
+  uint64_t start;                    /* Nanoseconds */
+  uint64_t elapsed;
+  uint64_t bytes;
+  uint32_t count;                    /* Packets, transactions, ... */
+  int iobmin;                        /* Lowest number of free IOBs */
+#if defined(CONFIG_MM_IOB) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  unsigned long iobstart;            /* IOB allocations at start */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct nb_options_s g_nb;
+static uint8_t g_nb_buffer[NB_MAXLEN];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nb_now
+ ****************************************************************************/
+
+static uint64_t nb_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/****************************************************************************
+ * Name: nb_iobsample
+ *
+ * Description:
+ *   Keep the lowest number of free IOBs seen during the test.
+ *
+ ****************************************************************************/
+
+static void nb_iobsample(FAR struct nb_result_s *result)
+{
+#ifdef CONFIG_MM_IOB
+  int navail = iob_navail(false);
+
+  if (result->iobmin < 0 || navail < result->iobmin)
+    {
+      result->iobmin = navail;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: nb_start
+ ****************************************************************************/
+
+static void nb_start(FAR struct nb_result_s *result, FAR const char *name)
+{
+  memset(result, 0, sizeof(*result));
+  result->name   = name;
+  result->iobmin = -1;
+
+#if defined(CONFIG_MM_IOB) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  result->iobstart = iob_getuserstats(IOBUSER_GLOBAL)->totalconsumed;
+#endif
+
+  nb_iobsample(result);
+  result->start = nb_now();
+}
+
+/****************************************************************************
+ * Name: nb_cpuload
+ *
+ * Description:
+ *   Return the recent load of the CPUs in permille.  This is the decaying
+ *   average of the CPU load monitor, so it reflects the test if the test
+ *   is longer than CONFIG_SCHED_CPULOAD_TIMECONSTANT.
+ *
+ ****************************************************************************/
+
+static int nb_cpuload(void)
+{
+#ifdef CONFIG_SCHED_CPULOAD
+  struct cpuload_s cpuload;
+  uint32_t busy = 0;
+  int cpu;
+
+  /* The IDLE threads are the PIDs 0 to CONFIG_SMP_NCPUS - 1 */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (clock_cpuload(cpu, &cpuload) < 0 || cpuload.total == 0)
+        {
+          return -1;
+        }
+
+      busy += 1000 - (uint32_t)((1000ull * cpuload.active) /
+                                cpuload.total);
+    }
+
+  return busy / CONFIG_SMP_NCPUS;
+#else
+  return -1;
+#endif
+}
+
+/****************************************************************************
+ * Name: nb_report
+ *
+ * Description:
+ *   Print the results of one test as key=value pairs: the throughput in
+ *   kbit/s, the rate of packets or transactions per second, the CPU load
+ *   in permille and its cost in permille per Mbit/s, and the IOB usage.
+ *
+ ****************************************************************************/
+
+static void nb_report(FAR struct nb_result_s *result)
+{
+  uint64_t elapsed = result->elapsed > 0 ? result->elapsed : 1;
+  uint32_t kbps = (result->bytes * 8 * 1000000) / elapsed;
+  uint32_t rate = ((uint64_t)result->count * NSEC_PER_SEC) / elapsed;
+  int load = nb_cpuload();
+
+  printf("netbench: test=%s seconds=%" PRIu32 ".%03" PRIu32
+         " bytes=%" PRIu64 " kbps=%" PRIu32 " count=%" PRIu32
+         " rate=%" PRIu32,
+         result->name, (uint32_t)(elapsed / NSEC_PER_SEC),
+         (uint32_t)((elapsed % NSEC_PER_SEC) / NSEC_PER_MSEC),
+         result->bytes, kbps, result->count, rate);
+
+  if (load >= 0)
+    {
+      printf(" cpu=%d", load);
+      if (kbps >= 1000)
+        {
+          printf(" cpu_per_mbit=%" PRIu32, (uint32_t)load * 1000 / kbps);
+        }
+    }
+
+#ifdef CONFIG_MM_IOB
+  printf(" iob_free=%d iob_minfree=%d", iob_navail(false), result->iobmin);
+#endif
+
+#if defined(CONFIG_MM_IOB) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  printf(" iob_allocs=%lu",
+         (unsigned long)iob_getuserstats(IOBUSER_GLOBAL)->totalconsumed -
+         result->iobstart);
+#endif
+
+  printf("\n");
+}
+
+/****************************************************************************
+ * Name: nb_socket
+ *
+ * Description:
+ *   Create a socket; for TCP connect it to the server and send the command
+ *   that selects the test.
+ *
+ ****************************************************************************/
+
+static int nb_socket(int type, char cmd)
+{
+  int sd;
+
+  sd = socket(AF_INET, type, 0);
+  if (sd < 0)
+    {
+      printf("netbench: ERROR: socket failed: %d\n", errno);
+      return -1;
+    }
+
+  if (type == SOCK_STREAM)
+    {
+      if (connect(sd, (FAR struct sockaddr *)&g_nb.addr,
+                  sizeof(g_nb.addr)) < 0 ||
+          send(sd, &cmd, 1, 0) != 1)
+        {
+          printf("netbench: ERROR: connect failed: %d\n", errno);
+          close(sd);
+          return -1;
+        }
+    }
+
+  return sd;
+}
+
+/****************************************************************************
+ * Name: nb_recvall
+ ****************************************************************************/
+
+static int nb_recvall(int sd, FAR void *buffer, size_t len)
+{
+  FAR uint8_t *ptr = buffer;
+  ssize_t nrecvd;
+
+  while (len > 0)
+    {
+      nrecvd = recv(sd, ptr, len, 0);
+      if (nrecvd <= 0)
+        {
+          return -1;
+        }
+
+      ptr += nrecvd;
+      len -= nrecvd;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: nb_tcpserver
+ *
+ * Description:
+ *   Accept the connections of the client and serve the command that each
+ *   one starts with, until NB_CMD_QUIT.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP
+static FAR void *nb_tcpserver(FAR void *arg)
+{
+  FAR int *listensd = arg;
+  uint64_t total;
+  ssize_t nrecvd;
+  char cmd;
+  int sd;
+
+  for (; ; )
+    {
+      sd = accept(*listensd, NULL, NULL);
+      if (sd < 0)
+        {
+          printf("netbench: ERROR: accept failed: %d\n", errno);
+          break;
+        }
+
+      if (recv(sd, &cmd, 1, 0) != 1)
+        {
+          close(sd);
+          continue;
+        }
+
+      if (cmd == NB_CMD_QUIT)
+        {
+          close(sd);
+          break;
+        }
+      else if (cmd == NB_CMD_STREAM)
+        {
+          /* Sink everything, then return the byte count */
+
+          total = 0;
+          while ((nrecvd = recv(sd, g_nb_buffer, NB_MAXLEN, 0)) > 0)
+            {
+              total += nrecvd;
+            }
+
+          send(sd, &total, sizeof(total), 0);
+        }
+      else if (cmd == NB_CMD_RR)
+        {
+          while (recv(sd, &cmd, 1, 0) == 1 && send(sd, &cmd, 1, 0) == 1);
+        }
+
+      close(sd);
+    }
+
+  close(*listensd);
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: nb_udpserver
+ *
+ * Description:
+ *   Count the datagrams of the client and return the counts when the
+ *   client ends the test, until NB_CMD_QUIT.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP
+static FAR void *nb_udpserver(FAR void *arg)
+{
+  FAR int *sd = arg;
+  struct nb_udpcount_s count;
+  struct sockaddr_in from;
+  socklen_t fromlen;
+  ssize_t nrecvd;
+
+  memset(&count, 0, sizeof(count));
+
+  for (; ; )
+    {
+      fromlen = sizeof(from);
+      nrecvd  = recvfrom(*sd, g_nb_buffer, NB_MAXLEN, 0,
+                         (FAR struct sockaddr *)&from, &fromlen);
+      if (nrecvd <= 0)
+        {
+          continue;
+        }
+
+      if (g_nb_buffer[0] == NB_CMD_DATA)
+        {
+          count.packets++;
+          count.bytes += nrecvd;
+        }
+      else if (g_nb_buffer[0] == NB_CMD_END)
+        {
+          sendto(*sd, &count, sizeof(count), 0,
+                 (FAR struct sockaddr *)&from, fromlen);
+          memset(&count, 0, sizeof(count));
+        }
+      else if (g_nb_buffer[0] == NB_CMD_QUIT)
+        {
+          break;
+        }
+    }
+
+  close(*sd);
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: nb_tcpstream
+ *
+ * Description:
+ *   Send as much as possible for the duration of the test; the throughput
+ *   is the number of bytes received by the server.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP
+static int nb_tcpstream(void)
+{
+  struct nb_result_s result;
+  uint64_t deadline;
+  uint64_t total;
+  ssize_t nsent;
+  int sd;
+
+  sd = nb_socket(SOCK_STREAM, NB_CMD_STREAM);
+  if (sd < 0)
+    {
+      return -1;
+    }
+
+  memset(g_nb_buffer, NB_CMD_DATA, NB_MAXLEN);
+  nb_start(&result, "tcp-stream");
+  deadline = result.start + (uint64_t)g_nb.duration * NSEC_PER_SEC;
+
+  while (nb_now() < deadline)
+    {
+      nsent = send(sd, g_nb_buffer, g_nb.tcplen, 0);
+      if (nsent < 0)
+        {
+          printf("netbench: ERROR: send failed: %d\n", errno);
+          close(sd);
+          return -1;
+        }
+
+      result.count++;
+      nb_iobsample(&result);
+    }
+
+  /* The server returns its count when it sees the end of the stream */
+
+  shutdown(sd, SHUT_WR);
+  if (nb_recvall(sd, &total, sizeof(total)) < 0)
+    {
+      printf("netbench: ERROR: no count from the server\n");
+      close(sd);
+      return -1;
+    }
+
+  result.elapsed = nb_now() - result.start;
+  result.bytes   = total;
+  close(sd);
+
+  nb_report(&result);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: nb_tcprr
+ *
+ * Description:
+ *   One byte request/response transactions; the latency of a transaction
+ *   is the round trip through both stacks.
+ *
+ ****************************************************************************/
+
+static int nb_tcprr(void)
+{
+  struct nb_result_s result;
+  uint64_t deadline;
+  uint64_t begin;
+  uint64_t rtt;
+  uint64_t min = UINT64_MAX;
+  uint64_t max = 0;
+  char cmd = NB_CMD_DATA;
+#ifdef CONFIG_NET_TCPPROTO_OPTIONS
+  int nodelay = 1;
+#endif
+  int sd;
+
+  sd = nb_socket(SOCK_STREAM, NB_CMD_RR);
+  if (sd < 0)
+    {
+      return -1;
+    }
+
+#ifdef CONFIG_NET_TCPPROTO_OPTIONS
+  setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+#endif
+
+  nb_start(&result, "tcp-rr");
+  deadline = result.start + (uint64_t)g_nb.duration * NSEC_PER_SEC;
+
+  while ((begin = nb_now()) < deadline)
+    {
+      if (send(sd, &cmd, 1, 0) != 1 || recv(sd, &cmd, 1, 0) != 1)
+        {
+          printf("netbench: ERROR: transaction failed: %d\n", errno);
+          close(sd);
+          return -1;
+        }
+
+      rtt = nb_now() - begin;
+      min = rtt < min ? rtt : min;
+      max = rtt > max ? rtt : max;
+
+      result.count++;
+      result.bytes += 2;
+      nb_iobsample(&result);
+    }
+
+  result.elapsed = nb_now() - result.start;
+  close(sd);
+
+  nb_report(&result);
+  if (result.count > 0)
+    {
+      printf("netbench: test=tcp-rr-latency min=%" PRIu64 " avg=%" PRIu64
+             " max=%" PRIu64 " unit=ns\n", min,
+             result.elapsed / result.count, max);
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: nb_tcpconnect
+ *
+ * Description:
+ *   Open and close connections for the duration of the test.
+ *
+ ****************************************************************************/
+
+static int nb_tcpconnect(void)
+{
+  struct nb_result_s result;
+  uint64_t deadline;
+  char cmd;
+  int sd;
+
+  nb_start(&result, "tcp-connect");
+  deadline = result.start + (uint64_t)g_nb.duration * NSEC_PER_SEC;
+
+  while (nb_now() < deadline)
+    {
+      sd = nb_socket(SOCK_STREAM, NB_CMD_CONNECT);
+      if (sd < 0)
+        {
+          return -1;
+        }
+
+      /* Wait for the close of the server so that the connections do not
+       * accumulate.
+       */
+
+      recv(sd, &cmd, 1, 0);
+      close(sd);
+
+      result.count++;
+      nb_iobsample(&result);
+    }
+
+  result.elapsed = nb_now() - result.start;
+  nb_report(&result);
+  return 0;
+}
+#endif /* CONFIG_NET_TCP */
+
+/****************************************************************************
+ * Name: nb_udpstream
+ *
+ * Description:
+ *   Send datagrams for the duration of the test; the server returns the
+ *   number that it received, the difference is the loss.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP
+static int nb_udpstream(void)
+{
+  struct nb_udpcount_s count;
+  struct nb_result_s result;
+  uint64_t deadline;
+  uint32_t sent = 0;
+#ifdef CONFIG_NET_SOCKOPTS
+  struct timeval tv;
+#endif
+  int retry;
+  int sd;
+
+  sd = nb_socket(SOCK_DGRAM, 0);
+  if (sd < 0)
+    {
+      return -1;
+    }
+
+#ifdef CONFIG_NET_SOCKOPTS
+  tv.tv_sec  = 1;
+  tv.tv_usec = 0;
+  setsockopt(sd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+#endif
+
+  memset(g_nb_buffer, NB_CMD_DATA, NB_MAXLEN);
+  nb_start(&result, "udp-stream");
+  deadline = result.start + (uint64_t)g_nb.duration * NSEC_PER_SEC;
+
+  while (nb_now() < deadline)
+    {
+      if (sendto(sd, g_nb_buffer, g_nb.udplen, 0,
+                 (FAR struct sockaddr *)&g_nb.addr,
+                 sizeof(g_nb.addr)) == g_nb.udplen)
+        {
+          sent++;
+        }
+
+      nb_iobsample(&result);
+    }
+
+  result.elapsed = nb_now() - result.start;
+
+  /* Ask for the counts, the end command may be lost too */
+
+  for (retry = 0; retry < 3; retry++)
+    {
+      char cmd = NB_CMD_END;
+
+      sendto(sd, &cmd, 1, 0, (FAR struct sockaddr *)&g_nb.addr,
+             sizeof(g_nb.addr));
+      if (recv(sd, &count, sizeof(count), 0) == sizeof(count))
+        {
+          break;
+        }
+    }
+
+  close(sd);
+
+  if (retry >= 3)
+    {
+      printf("netbench: ERROR: no count from the server\n");
+      return -1;
+    }
+
+  result.count = count.packets;
+  result.bytes = count.bytes;
+  nb_report(&result);
+
+  printf("netbench: test=udp-loss sent=%" PRIu32 " received=%" PRIu32
+         "\n", sent, count.packets);
+  return 0;
+}
+#endif /* CONFIG_NET_UDP */
+
+/****************************************************************************
+ * Name: nb_servers
+ *
+ * Description:
+ *   Start the TCP and UDP servers.
+ *
+ ****************************************************************************/
+
+static int nb_servers(FAR pthread_t *tcpthread, FAR int *tcpsd,
+                      FAR pthread_t *udpthread, FAR int *udpsd)
+{
+  pthread_attr_t attr;
+  struct sockaddr_in addr;
+  int reuse = 1;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, NB_STACKSIZE);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = g_nb.addr.sin_port;
+  addr.sin_addr.s_addr = INADDR_ANY;
+
+  *tcpsd = -1;
+  *udpsd = -1;
+
+#ifdef CONFIG_NET_TCP
+  *tcpsd = socket(AF_INET, SOCK_STREAM, 0);
+  if (*tcpsd < 0)
+    {
+      goto errout;
+    }
+
+#ifdef CONFIG_NET_SOCKOPTS
+  setsockopt(*tcpsd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
+
+  if (bind(*tcpsd, (FAR struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(*tcpsd, 4) < 0 ||
+      pthread_create(tcpthread, &attr, nb_tcpserver, tcpsd) != 0)
+    {
+      close(*tcpsd);
+      *tcpsd = -1;
+      goto errout;
+    }
+#endif
+
+#ifdef CONFIG_NET_UDP
+  *udpsd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (*udpsd < 0)
+    {
+      goto errout;
+    }
+
+  if (bind(*udpsd, (FAR struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      pthread_create(udpthread, &attr, nb_udpserver, udpsd) != 0)
+    {
+      close(*udpsd);
+      *udpsd = -1;
+      goto errout;
+    }
+#endif
+
+  UNUSED(reuse);
+  pthread_attr_destroy(&attr);
+  return 0;
+
+errout:
+  printf("netbench: ERROR: failed to start the servers: %d\n", errno);
+  pthread_attr_destroy(&attr);
+  return -1;
+}
+
+/****************************************************************************
+ * Name: nb_quit
+ *
+ * Description:
+ *   Stop the servers started by nb_servers() and wait for them.
+ *
+ ****************************************************************************/
+
+static void nb_quit(pthread_t tcpthread, int tcpsd,
+                    pthread_t udpthread, int udpsd)
+{
+  char cmd = NB_CMD_QUIT;
+  int sd;
+
+#ifdef CONFIG_NET_TCP
+  if (tcpsd >= 0)
+    {
+      sd = nb_socket(SOCK_STREAM, NB_CMD_QUIT);
+      if (sd >= 0)
+        {
+          close(sd);
+          pthread_join(tcpthread, NULL);
+        }
+    }
+#endif
+
+#ifdef CONFIG_NET_UDP
+  if (udpsd >= 0)
+    {
+      sd = nb_socket(SOCK_DGRAM, 0);
+      if (sd >= 0)
+        {
+          sendto(sd, &cmd, 1, 0, (FAR struct sockaddr *)&g_nb.addr,
+                 sizeof(g_nb.addr));
+          close(sd);
+          pthread_join(udpthread, NULL);
+        }
+    }
+#endif
+
+  UNUSED(cmd);
+  UNUSED(sd);
+}
+
+/****************************************************************************
+ * Name: nb_usage
+ ****************************************************************************/
+
+static void nb_usage(FAR const char *progname)
+{
+  printf("Usage: %s [-s | -c address] [-p port] [-d seconds] "
+         "[-l tcplen] [-u udplen] [-t tests]\n", progname);
+  printf("  -s          Run the servers only\n");
+  printf("  -c address  Run the client only, against this server\n");
+  printf("  -p port     TCP and UDP port (%d)\n", NB_PORT);
+  printf("  -d seconds  Duration of each test (%d)\n", NB_DURATION);
+  printf("  -l tcplen   Size of the TCP writes (%d)\n", NB_TCPLEN);
+  printf("  -u udplen   Size of the UDP datagrams (%d)\n", NB_UDPLEN);
+  printf("  -t tests    Tests to run among t (TCP stream), u (UDP stream), "
+         "r (TCP request/response) and c (TCP connections)\n");
+  printf("Without -s or -c, both run locally over %s (loopback).\n",
+         NB_ADDRESS);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netbench_main
+ *
+ * Description:
+ *   Measure the throughput, the packet rate, the latency and the
+ *   connection rate of the network stack and print the results.
+ *
+ ****************************************************************************/
+
+int netbench_main(int argc, FAR char *argv[])
+{
+  FAR const char *address = NB_ADDRESS;
+  FAR const char *tests;
+  pthread_t tcpthread = 0;
+  pthread_t udpthread = 0;
+  int tcpsd = -1;
+  int udpsd = -1;
+  int port = NB_PORT;
+  int ret = 0;
+  int ch;
+
+  memset(&g_nb, 0, sizeof(g_nb));
+  g_nb.duration = NB_DURATION;
+  g_nb.tcplen   = NB_TCPLEN;
+  g_nb.udplen   = NB_UDPLEN;
+  g_nb.tests    = NB_TEST_ALL;
+
+  optind = 1;
+  while ((ch = getopt(argc, argv, "sc:p:d:l:u:t:h")) != ERROR)
+    {
+      switch (ch)
+        {
+          case 's':
+            g_nb.server = true;
+            break;
+
+          case 'c':
+            g_nb.client = true;
+            address = optarg;
+            break;
+
+          case 'p':
+            port = atoi(optarg);
+            break;
+
+          case 'd':
+            g_nb.duration = atoi(optarg);
+            break;
+
+          case 'l':
+            g_nb.tcplen = atoi(optarg);
+            break;
+
+          case 'u':
+            g_nb.udplen = atoi(optarg);
+            break;
+
+          case 't':
+            g_nb.tests = 0;
+            for (tests = optarg; *tests != '\0'; tests++)
+              {
+                FAR const char *p = strchr("turc", *tests);
+
+                if (p != NULL)
+                  {
+                    g_nb.tests |= 1 << (p - "turc");
+                  }
+              }
+            break;
+
+          default:
+            nb_usage(argv[0]);
+            return ch == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+  g_nb.addr.sin_family = AF_INET;
+  g_nb.addr.sin_port   = htons(port);
+
+  if ((g_nb.server && g_nb.client) || g_nb.duration <= 0 ||
+      g_nb.tcplen <= 0 || g_nb.tcplen > NB_MAXLEN ||
+      g_nb.udplen <= 0 || g_nb.udplen > NB_MAXLEN ||
+      inet_pton(AF_INET, address, &g_nb.addr.sin_addr) != 1)
+    {
+      nb_usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+  if (!g_nb.client)
+    {
+      if (nb_servers(&tcpthread, &tcpsd, &udpthread, &udpsd) < 0)
+        {
+          return EXIT_FAILURE;
+        }
+
+      if (g_nb.server)
+        {
+          /* Serve remote clients until one of them sends NB_CMD_QUIT */
+
+          printf("netbench: serving on port %d\n", port);
+#ifdef CONFIG_NET_TCP
+          pthread_join(tcpthread, NULL);
+#endif
+#ifdef CONFIG_NET_UDP
+          pthread_join(udpthread, NULL);
+#endif
+          return EXIT_SUCCESS;
+        }
+    }
+
+  printf("netbench: address=%s port=%d duration=%d tcplen=%d udplen=%d\n",
+         address, port, g_nb.duration, g_nb.tcplen, g_nb.udplen);
+
+#ifdef CONFIG_NET_TCP
+  if ((g_nb.tests & NB_TEST_TCP) != 0)
+    {
+      ret |= nb_tcpstream();
+    }
+
+  if ((g_nb.tests & NB_TEST_RR) != 0)
+    {
+      ret |= nb_tcprr();
+    }
+
+  if ((g_nb.tests & NB_TEST_CONNECT) != 0)
+    {
+      ret |= nb_tcpconnect();
+    }
+#endif
+
+#ifdef CONFIG_NET_UDP
+  if ((g_nb.tests & NB_TEST_UDP) != 0)
+    {
+      ret |= nb_udpstream();
+    }
+#endif
+
+  if (!g_nb.client)
+    {
+      nb_quit(tcpthread, tcpsd, udpthread, udpsd);
+    }
+
+  return ret == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif /* CONFIG_BOARD_NETBENCH */
@@ -31,6 +31,8 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/drivers/drivers.h>
 
 #include <nuttx/crypto/crypto.h>
@@ -40,18 +42,50 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifndef CONFIG_CRYPTO_CRYPTODEV_NSESSIONS
+#  define CONFIG_CRYPTO_CRYPTODEV_NSESSIONS 4
+#endif
+
+#define CRYPTODEV_MAXKEYLEN 32
+
 #ifdef CONFIG_CRYPTO_AES
 #  define AES_CYPHER(mode) \
   aes_cypher(op->dst, op->src, op->len, op->iv, ses->key, ses->keylen, \
              mode, encrypt)
 #endif
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one session.  The key is copied to the kernel
+ * once, when the session is created, and reused by every operation that
+ * refers to the session.
+ */
+
+struct cryptodev_session_s
+{
+  uint32_t cipher;                     /* Cipher, 0 if the slot is free */
+  uint32_t keylen;                     /* Length of the key in bytes */
+  uint8_t  key[CRYPTODEV_MAXKEYLEN];   /* Copy of the cipher key */
+};
+
+/* This structure describes the state of one open file */
+
+struct cryptodev_file_s
+{
+  sem_t exclsem;                       /* Protects the session table */
+  struct cryptodev_session_s sessions[CONFIG_CRYPTO_CRYPTODEV_NSESSIONS];
+};
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
 /* Character driver methods */
 
+static int     cryptodev_open(FAR struct file *filep);
+static int     cryptodev_close(FAR struct file *filep);
 static ssize_t cryptodev_read(FAR struct file *filep,
                               FAR char *buffer,
                               size_t len);
@@ -68,8 +102,8 @@ static int cryptodev_ioctl(FAR struct file *filep,
 
 static const struct file_operations g_cryptodevops =
 {
-  NULL,               /* open   */
-  NULL,               /* close  */
+  cryptodev_open,     /* open   */
+  cryptodev_close,    /* close  */
   cryptodev_read,     /* read   */
   cryptodev_write,    /* write  */
   NULL,               /* seek   */
@@ -84,6 +118,42 @@ static const struct file_operations g_cryptodevops =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: cryptodev_open
+ ****************************************************************************/
+
+static int cryptodev_open(FAR struct file *filep)
+{
+  FAR struct cryptodev_file_s *priv;
+
+  priv = kmm_zalloc(sizeof(struct cryptodev_file_s));
+  if (priv == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxsem_init(&priv->exclsem, 0, 1);
+  filep->f_priv = priv;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cryptodev_close
+ ****************************************************************************/
+
+static int cryptodev_close(FAR struct file *filep)
+{
+  FAR struct cryptodev_file_s *priv = filep->f_priv;
+
+  /* Do not leave any key material behind in the heap */
+
+  nxsem_destroy(&priv->exclsem);
+  explicit_bzero(priv, sizeof(struct cryptodev_file_s));
+  kmm_free(priv);
+  filep->f_priv = NULL;
+  return OK;
+}
+
 static ssize_t cryptodev_read(FAR struct file *filep,
                               FAR char *buffer,
                               size_t len)
@@ -98,65 +168,183 @@ static ssize_t cryptodev_write(FAR struct file *filep,
   return -EACCES;
 }
 
+/****************************************************************************
+ * Name: cryptodev_newsession
+ *
+ * Description:
+ *   Validate the session parameters, copy the key into a free session slot
+ *   and return the session number (slot index + 1) to the caller.
+ *
+ ****************************************************************************/
+
+static int cryptodev_newsession(FAR struct cryptodev_file_s *priv,
+                                FAR struct session_op *sop)
+{
+  FAR struct cryptodev_session_s *ses;
+  int i;
+
+  switch (sop->cipher)
+    {
+#ifdef CONFIG_CRYPTO_AES
+      case CRYPTO_AES_ECB:
+      case CRYPTO_AES_CBC:
+      case CRYPTO_AES_CTR:
+        if (sop->keylen != 16 && sop->keylen != 24 && sop->keylen != 32)
+          {
+            return -EINVAL;
+          }
+        break;
+#endif
+
+      default:
+        return -EINVAL;
+    }
+
+  if (sop->key == NULL)
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < CONFIG_CRYPTO_CRYPTODEV_NSESSIONS; i++)
+    {
+      ses = &priv->sessions[i];
+      if (ses->cipher == 0)
+        {
+          ses->cipher = sop->cipher;
+          ses->keylen = sop->keylen;
+          memcpy(ses->key, sop->key, sop->keylen);
+
+          sop->ses = i + 1;
+          return OK;
+        }
+    }
+
+  return -ENOSPC;
+}
+
+/****************************************************************************
+ * Name: cryptodev_session
+ *
+ * Description:
+ *   Look up an active session by its session number.
+ *
+ ****************************************************************************/
+
+static FAR struct cryptodev_session_s *
+cryptodev_session(FAR struct cryptodev_file_s *priv, uint32_t sesid)
+{
+  FAR struct cryptodev_session_s *ses;
+
+  if (sesid == 0 || sesid > CONFIG_CRYPTO_CRYPTODEV_NSESSIONS)
+    {
+      return NULL;
+    }
+
+  ses = &priv->sessions[sesid - 1];
+  return ses->cipher != 0 ? ses : NULL;
+}
+
+#ifdef CONFIG_CRYPTO_AES
+/****************************************************************************
+ * Name: cryptodev_crypt
+ ****************************************************************************/
+
+static int cryptodev_crypt(FAR struct cryptodev_session_s *ses,
+                           FAR struct crypt_op *op)
+{
+  int encrypt;
+
+  switch (op->op)
+    {
+    case COP_ENCRYPT:
+      encrypt = 1;
+      break;
+
+    case COP_DECRYPT:
+      encrypt = 0;
+      break;
+
+    default:
+      return -EINVAL;
+    }
+
+  switch (ses->cipher)
+    {
+    case CRYPTO_AES_ECB:
+      return AES_CYPHER(AES_MODE_ECB);
+
+    case CRYPTO_AES_CBC:
+      return AES_CYPHER(AES_MODE_CBC);
+
+    case CRYPTO_AES_CTR:
+      return AES_CYPHER(AES_MODE_CTR);
+
+    default:
+       return -EINVAL;
+    }
+}
+#endif
+
 static int cryptodev_ioctl(FAR struct file *filep,
                            int cmd,
                            unsigned long arg)
 {
+  FAR struct cryptodev_file_s *priv = filep->f_priv;
+  FAR struct cryptodev_session_s *ses;
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&priv->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
   switch (cmd)
   {
   case CIOCGSESSION:
     {
-      FAR struct session_op *ses = (FAR struct session_op *)arg;
-      ses->ses = (uint32_t)ses;
-      return OK;
+      ret = cryptodev_newsession(priv, (FAR struct session_op *)arg);
+      break;
     }
 
   case CIOCFSESSION:
     {
-      return OK;
+      ses = cryptodev_session(priv, *(FAR uint32_t *)arg);
+      if (ses == NULL)
+        {
+          ret = -EINVAL;
+          break;
+        }
+
+      explicit_bzero(ses, sizeof(struct cryptodev_session_s));
+      ret = OK;
+      break;
     }
 
 #ifdef CONFIG_CRYPTO_AES
   case CIOCCRYPT:
     {
-      FAR struct crypt_op *op    = (FAR struct crypt_op *)arg;
-      FAR struct session_op *ses = (FAR struct session_op *)op->ses;
-      int encrypt;
+      FAR struct crypt_op *op = (FAR struct crypt_op *)arg;
 
-      switch (op->op)
+      ses = cryptodev_session(priv, op->ses);
+      if (ses == NULL)
         {
-        case COP_ENCRYPT:
-          encrypt = 1;
+          ret = -EINVAL;
           break;
-
-        case COP_DECRYPT:
-          encrypt = 0;
-          break;
-
-        default:
-          return -EINVAL;
         }
 
-      switch (ses->cipher)
-        {
-        case CRYPTO_AES_ECB:
-          return AES_CYPHER(AES_MODE_ECB);
-
-        case CRYPTO_AES_CBC:
-          return AES_CYPHER(AES_MODE_CBC);
-
-        case CRYPTO_AES_CTR:
-          return AES_CYPHER(AES_MODE_CTR);
-
-        default:
-           return -EINVAL;
-        }
+      ret = cryptodev_crypt(ses, op);
+      break;
     }
 #endif
 
   default:
-    return -ENOTTY;
+    ret = -ENOTTY;
+    break;
   }
+
+  nxsem_post(&priv->exclsem);
+  return ret;
 }
 
 /****************************************************************************
@@ -34,6 +34,7 @@
 #include <nuttx/random.h>
 #include <nuttx/board.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/crypto/blake2s.h>
 
@@ -48,6 +49,31 @@
 #define ROTL_32(x,n) ( ((x) << (n)) | ((x) >> (32-(n))) )
 #define ROTR_32(x,n) ( ((x) >> (n)) | ((x) << (32-(n))) )
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CRNG
+#  ifdef CONFIG_SMP
+#    define CRNG_NCPUS      CONFIG_SMP_NCPUS
+#  else
+#    define CRNG_NCPUS      1
+#  endif
+
+#  define CRNG_KEY_WORDS    8
+#  define CRNG_KEY_BYTES    (CRNG_KEY_WORDS * 4)
+#  define CRNG_BLOCK_WORDS  16
+#  define CRNG_BLOCK_BYTES  (CRNG_BLOCK_WORDS * 4)
+#  define CRNG_RESEED_TICKS \
+     SEC2TICK(CONFIG_CRYPTO_RANDOM_POOL_CRNG_RESEED_INTERVAL)
+
+#  define CHACHA_QR(a,b,c,d) \
+  do \
+    { \
+      a += b; d ^= a; d = ROTL_32(d, 16); \
+      c += d; b ^= c; b = ROTL_32(b, 12); \
+      a += b; d ^= a; d = ROTL_32(d, 8); \
+      c += d; b ^= c; b = ROTL_32(b, 7); \
+    } \
+  while (0)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -73,9 +99,25 @@ struct rng_s
   volatile uint8_t rd_prev_time;
   volatile uint16_t rd_prev_irq;
   bool output_initialized;
+  uint32_t generation; /* Incremented on every reseed of the root */
   struct blake2xs_rng_s blake2xs;
 };
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CRNG
+/* Per-CPU ChaCha20 output generator.  It is keyed from the BLAKE2Xs
+ * generator above and rekeys itself after every request (fast key
+ * erasure), so that concurrent callers never contend for rd_sem unless
+ * a reseed is due.
+ */
+
+struct crng_s
+{
+  uint32_t key[CRNG_KEY_WORDS];
+  uint32_t generation; /* Root generation the key was derived from */
+  clock_t birth;       /* Time of the last reseed */
+};
+#endif
+
 enum
 {
   POOL_SIZE = ENTROPY_POOL_SIZE,
@@ -91,6 +133,10 @@ enum
 
 static struct rng_s g_rng;
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CRNG
+static struct crng_s g_crng[CRNG_NCPUS];
+#endif
+
 #ifdef CONFIG_BOARD_ENTROPY_POOL
 /* Entropy pool structure can be provided by board source. Use for this is,
  * for example, allocate entropy pool from special area of RAM which content
@@ -304,6 +350,15 @@ static void rng_reseed(void)
   g_rng.blake2xs.param.node_depth = 0;
 
   g_rng.output_initialized = true;
+
+  /* Let the per-CPU generators know that they must rekey.  Zero is used
+   * for 'never seeded'.
+   */
+
+  if (++g_rng.generation == 0)
+    {
+      g_rng.generation = 1;
+    }
 }
 
 static void rng_buf_internal(FAR uint8_t *bytes, size_t nbytes)
@@ -357,6 +412,156 @@ static void rng_buf_internal(FAR uint8_t *bytes, size_t nbytes)
     }
 }
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CRNG
+/****************************************************************************
+ * Name: chacha20_block
+ *
+ * Description:
+ *   Compute one 64-byte ChaCha20 keystream block (RFC 8439) for the given
+ *   key and block counter, with an all-zero nonce.
+ *
+ ****************************************************************************/
+
+static void chacha20_block(FAR const uint32_t *key, uint32_t counter,
+                           FAR uint32_t *out)
+{
+  uint32_t x[CRNG_BLOCK_WORDS];
+  int i;
+
+  out[0]  = 0x61707865;
+  out[1]  = 0x3320646e;
+  out[2]  = 0x79622d32;
+  out[3]  = 0x6b206574;
+  memcpy(&out[4], key, CRNG_KEY_BYTES);
+  out[12] = counter;
+  out[13] = 0;
+  out[14] = 0;
+  out[15] = 0;
+
+  memcpy(x, out, sizeof(x));
+
+  for (i = 0; i < 10; i++)
+    {
+      CHACHA_QR(x[0], x[4], x[8],  x[12]);
+      CHACHA_QR(x[1], x[5], x[9],  x[13]);
+      CHACHA_QR(x[2], x[6], x[10], x[14]);
+      CHACHA_QR(x[3], x[7], x[11], x[15]);
+      CHACHA_QR(x[0], x[5], x[10], x[15]);
+      CHACHA_QR(x[1], x[6], x[11], x[12]);
+      CHACHA_QR(x[2], x[7], x[8],  x[13]);
+      CHACHA_QR(x[3], x[4], x[9],  x[14]);
+    }
+
+  for (i = 0; i < CRNG_BLOCK_WORDS; i++)
+    {
+      out[i] += x[i];
+    }
+
+  explicit_bzero(x, sizeof(x));
+}
+
+/****************************************************************************
+ * Name: crng_needs_reseed
+ *
+ * Description:
+ *   Check if the generator of the current CPU has to take a new key from
+ *   the central pool.  This is only a hint: the caller may migrate to
+ *   another CPU right after the check, which is harmless.
+ *
+ ****************************************************************************/
+
+static bool crng_needs_reseed(void)
+{
+  FAR struct crng_s *crng = &g_crng[up_cpu_index()];
+
+  return crng->generation == 0 ||
+         crng->generation != g_rng.generation ||
+         g_rng.rd_newentr >= MAX_SEED_NEW_ENTROPY_WORDS ||
+         clock_systime_ticks() - crng->birth >= CRNG_RESEED_TICKS;
+}
+
+/****************************************************************************
+ * Name: crng_reseed
+ *
+ * Description:
+ *   Take a fresh key for the generator of the current CPU from the central
+ *   BLAKE2Xs generator.  Must be called with rd_sem held.
+ *
+ ****************************************************************************/
+
+static void crng_reseed(void)
+{
+  FAR struct crng_s *crng;
+  uint32_t key[CRNG_KEY_WORDS];
+  irqstate_t flags;
+
+  rng_buf_internal((FAR uint8_t *)key, sizeof(key));
+
+  flags = up_irq_save();
+  crng = &g_crng[up_cpu_index()];
+  memcpy(crng->key, key, sizeof(key));
+  crng->generation = g_rng.generation;
+  crng->birth = clock_systime_ticks();
+  up_irq_restore(flags);
+
+  explicit_bzero(key, sizeof(key));
+}
+
+/****************************************************************************
+ * Name: crng_generate
+ *
+ * Description:
+ *   Produce random bytes from the generator of the current CPU.  Only the
+ *   rekeying of the per-CPU state is done with local interrupts disabled;
+ *   the bulk of the output is generated with a private per-call key.
+ *
+ ****************************************************************************/
+
+static void crng_generate(FAR uint8_t *bytes, size_t nbytes)
+{
+  uint32_t block[CRNG_BLOCK_WORDS];
+  uint32_t key[CRNG_KEY_WORDS];
+  FAR struct crng_s *crng;
+  irqstate_t flags;
+  uint32_t counter;
+  size_t n;
+
+  /* The first half of the block replaces the per-CPU key, the second half
+   * is either returned directly or used as the key for this request.
+   */
+
+  flags = up_irq_save();
+  crng = &g_crng[up_cpu_index()];
+  chacha20_block(crng->key, 0, block);
+  memcpy(crng->key, block, CRNG_KEY_BYTES);
+  up_irq_restore(flags);
+
+  if (nbytes <= CRNG_BLOCK_BYTES - CRNG_KEY_BYTES)
+    {
+      memcpy(bytes, &block[CRNG_KEY_WORDS], nbytes);
+    }
+  else
+    {
+      memcpy(key, &block[CRNG_KEY_WORDS], CRNG_KEY_BYTES);
+
+      for (counter = 0; nbytes > 0; counter++)
+        {
+          chacha20_block(key, counter, block);
+
+          n = MIN(nbytes, CRNG_BLOCK_BYTES);
+          memcpy(bytes, block, n);
+
+          bytes  += n;
+          nbytes -= n;
+        }
+
+      explicit_bzero(key, sizeof(key));
+    }
+
+  explicit_bzero(block, sizeof(block));
+}
+#endif /* CONFIG_CRYPTO_RANDOM_POOL_CRNG */
+
 static void rng_init(void)
 {
   cryptinfo("Initializing RNG\n");
@@ -548,6 +753,14 @@ void arc4random_buf(FAR void *bytes, size_t nbytes)
 {
   int ret;
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CRNG
+  if (!crng_needs_reseed())
+    {
+      crng_generate(bytes, nbytes);
+      return;
+    }
+#endif
+
   do
     {
       ret = nxsem_wait_uninterruptible(&g_rng.rd_sem);
@@ -561,6 +774,13 @@ void arc4random_buf(FAR void *bytes, size_t nbytes)
     }
   while (ret < 0);
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_CRNG
+  crng_reseed();
+  nxsem_post(&g_rng.rd_sem);
+
+  crng_generate(bytes, nbytes);
+#else
   rng_buf_internal(bytes, nbytes);
   nxsem_post(&g_rng.rd_sem);
+#endif
 }
@@ -36,6 +36,7 @@
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/analog/adc.h>
 #include <nuttx/analog/ioctl.h>
 #include <nuttx/random.h>
@@ -59,6 +60,14 @@ static int     adc_poll(FAR struct file *filep, struct pollfd *fds,
                         bool setup);
 static int     adc_reset_fifo(FAR struct adc_dev_s *dev);
 static int     adc_samples_on_read(FAR struct adc_dev_s *dev);
+#ifdef CONFIG_ADC_STREAM
+static int     adc_receive_block(FAR struct adc_dev_s *dev,
+                                 FAR const void *data, size_t nbytes);
+static ssize_t adc_read_stream(FAR struct file *filep,
+                               FAR struct adc_dev_s *dev,
+                               FAR char *buffer, size_t buflen);
+static int     adc_stream(FAR struct adc_dev_s *dev, bool enable);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -82,6 +91,9 @@ static const struct adc_callback_s g_adc_callback =
 {
   adc_receive,    /* au_receive */
   adc_reset       /* au_reset */
+#ifdef CONFIG_ADC_STREAM
+  , adc_receive_block /* au_receive_block */
+#endif
 };
 
 /****************************************************************************
@@ -202,8 +214,15 @@ static int adc_close(FAR struct file *filep)
 
           flags = enter_critical_section();    /* Disable interrupts */
           dev->ad_ops->ao_shutdown(dev);       /* Disable the ADC */
+#ifdef CONFIG_ADC_STREAM
+          dev->ad_streaming = false;
+#endif
           leave_critical_section(flags);
 
+#ifdef CONFIG_ADC_STREAM
+          circbuf_uninit(&dev->ad_stream);
+#endif
+
           nxsem_post(&dev->ad_closesem);
         }
     }
@@ -227,6 +246,13 @@ static ssize_t adc_read(FAR struct file *filep, FAR char *buffer,
 
   ainfo("buflen: %d\n", (int)buflen);
 
+#ifdef CONFIG_ADC_STREAM
+  if (dev->ad_streaming)
+    {
+      return adc_read_stream(filep, dev, buffer, buflen);
+    }
+#endif
+
   /* Determine the size of the messages to return.
    *
    * REVISIT:  What if buflen is 8 does that mean 4 messages of size 2?  Or
@@ -426,6 +452,14 @@ static int adc_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+#ifdef CONFIG_ADC_STREAM
+      case ANIOC_STREAM:
+        {
+          ret = adc_stream(dev, arg != 0);
+        }
+        break;
+#endif
+
       default:
         {
           /* Those IOCTLs might be used in arch specific section */
@@ -510,7 +544,7 @@ static void adc_pollnotify(FAR struct adc_dev_s *dev, uint32_t type)
       if (fds)
         {
           fds->revents |= type;
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 }
@@ -594,7 +628,11 @@ static int adc_poll(FAR struct file *filep, struct pollfd *fds, bool setup)
 
       /* Should we immediately notify on any of the requested events? */
 
-      if (dev->ad_recv.af_head != dev->ad_recv.af_tail)
+      if (dev->ad_recv.af_head != dev->ad_recv.af_tail
+#ifdef CONFIG_ADC_STREAM
+          || (dev->ad_streaming && !circbuf_is_empty(&dev->ad_stream))
+#endif
+         )
         {
           adc_pollnotify(dev, POLLIN);
         }
@@ -664,6 +702,169 @@ static int adc_samples_on_read(FAR struct adc_dev_s *dev)
   return ret;
 }
 
+#ifdef CONFIG_ADC_STREAM
+/****************************************************************************
+ * Name: adc_receive_block
+ *
+ * Description:
+ *   Queue one block of samples from the lower half, together with its
+ *   header.  A block that does not fit is dropped as a whole, the reader
+ *   sees the gap in the sequence numbers.
+ *
+ ****************************************************************************/
+
+static int adc_receive_block(FAR struct adc_dev_s *dev,
+                             FAR const void *data, size_t nbytes)
+{
+  struct adc_block_s block;
+
+  if (!dev->ad_streaming)
+    {
+      return -EPERM;
+    }
+
+  block.ab_seqno  = dev->ad_seqno++;
+  block.ab_nbytes = nbytes;
+
+  if (circbuf_space(&dev->ad_stream) < sizeof(block) + nbytes)
+    {
+      return -ENOMEM;
+    }
+
+  clock_systime_timespec(&block.ab_time);
+
+  circbuf_write(&dev->ad_stream, &block, sizeof(block));
+  circbuf_write(&dev->ad_stream, data, nbytes);
+
+  adc_notify(dev);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: adc_read_stream
+ *
+ * Description:
+ *   read() in streaming mode: return as many whole blocks as fit in the
+ *   user buffer.
+ *
+ ****************************************************************************/
+
+static ssize_t adc_read_stream(FAR struct file *filep,
+                               FAR struct adc_dev_s *dev,
+                               FAR char *buffer, size_t buflen)
+{
+  struct adc_block_s block;
+  irqstate_t flags;
+  size_t nread = 0;
+  ssize_t ret = 0;
+
+  /* Interrupts must be disabled while accessing the ad_stream buffer */
+
+  flags = enter_critical_section();
+  while (circbuf_is_empty(&dev->ad_stream))
+    {
+      if (filep->f_oflags & O_NONBLOCK)
+        {
+          ret = -EAGAIN;
+          goto return_with_irqdisabled;
+        }
+
+      dev->ad_nrxwaiters++;
+      ret = nxsem_wait(&dev->ad_recv.af_sem);
+      dev->ad_nrxwaiters--;
+      if (ret < 0)
+        {
+          goto return_with_irqdisabled;
+        }
+
+      /* Streaming may have been disabled while waiting */
+
+      if (!dev->ad_streaming)
+        {
+          ret = -EIO;
+          goto return_with_irqdisabled;
+        }
+    }
+
+  while (circbuf_peek(&dev->ad_stream, &block, sizeof(block)) ==
+         sizeof(block))
+    {
+      if (nread + sizeof(block) + block.ab_nbytes > buflen)
+        {
+          break;
+        }
+
+      circbuf_read(&dev->ad_stream, buffer + nread,
+                   sizeof(block) + block.ab_nbytes);
+      nread += sizeof(block) + block.ab_nbytes;
+    }
+
+  /* The user buffer must hold at least one block */
+
+  ret = nread > 0 ? (ssize_t)nread : -EMSGSIZE;
+
+return_with_irqdisabled:
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: adc_stream
+ *
+ * Description:
+ *   Enable or disable streaming mode.  The lower half is asked to switch
+ *   its way of delivering samples first.
+ *
+ ****************************************************************************/
+
+static int adc_stream(FAR struct adc_dev_s *dev, bool enable)
+{
+  irqstate_t flags;
+  int ret;
+
+  if (enable == dev->ad_streaming)
+    {
+      return OK;
+    }
+
+  if (enable)
+    {
+      ret = circbuf_init(&dev->ad_stream, NULL, CONFIG_ADC_STREAM_BUFSIZE);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  ret = dev->ad_ops->ao_ioctl(dev, ANIOC_STREAM, enable);
+  if (ret < 0)
+    {
+      aerr("ERROR: Lower half cannot stream: %d\n", ret);
+      if (enable)
+        {
+          circbuf_uninit(&dev->ad_stream);
+        }
+
+      return ret;
+    }
+
+  flags = enter_critical_section();
+  dev->ad_streaming = enable;
+  dev->ad_seqno     = 0;
+  leave_critical_section(flags);
+
+  if (!enable)
+    {
+      /* Wake up the readers so that they see the mode change */
+
+      adc_notify(dev);
+      circbuf_uninit(&dev->ad_stream);
+    }
+
+  return OK;
+}
+#endif /* CONFIG_ADC_STREAM */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
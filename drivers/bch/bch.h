@@ -33,6 +33,7 @@
 
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/blkcache.h>
 
 /****************************************************************************
  * Pre-processor Definitions
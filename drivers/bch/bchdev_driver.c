@@ -39,6 +39,7 @@
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/fs/iostat.h>
 #include <nuttx/drivers/drivers.h>
 
 #include "bch.h"
@@ -100,7 +101,7 @@ static int bch_poll(FAR struct file *filep, FAR struct pollfd *fds,
       fds->revents |= (fds->events & (POLLIN | POLLOUT));
       if (fds->revents != 0)
         {
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 
@@ -171,6 +172,7 @@ static int bch_close(FAR struct file *filep)
   /* Flush any dirty pages remaining in the cache */
 
   bchlib_flushsector(bch);
+  blkcache_flush(bch->inode);
 
   /* Decrement the reference count (I don't use bchlib_decref() because I
    * want the entire close operation to be atomic wrt other driver
@@ -294,6 +296,7 @@ static ssize_t bch_read(FAR struct file *filep, FAR char *buffer, size_t len)
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct bchlib_s *bch;
+  uint32_t start;
   int ret;
 
   DEBUGASSERT(inode && inode->i_private);
@@ -305,7 +308,9 @@ static ssize_t bch_read(FAR struct file *filep, FAR char *buffer, size_t len)
       return (ssize_t)ret;
     }
 
+  start = fs_iostat_begin();
   ret = bchlib_read(bch, buffer, filep->f_pos, len);
+  fs_iostat_end(FS_IOSTAT_BCH_READ, start, ret);
   if (ret > 0)
     {
       filep->f_pos += len;
@@ -324,6 +329,7 @@ static ssize_t bch_write(FAR struct file *filep, FAR const char *buffer,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct bchlib_s *bch;
+  uint32_t start;
   int ret = -EACCES;
 
   DEBUGASSERT(inode && inode->i_private);
@@ -337,7 +343,9 @@ static ssize_t bch_write(FAR struct file *filep, FAR const char *buffer,
           return (ssize_t)ret;
         }
 
+      start = fs_iostat_begin();
       ret = bchlib_write(bch, buffer, filep->f_pos, len);
+      fs_iostat_end(FS_IOSTAT_BCH_WRITE, start, ret);
       if (ret > 0)
         {
           filep->f_pos += len;
@@ -427,6 +435,95 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
           /* Flush any dirty pages remaining in the cache */
 
           ret = bchlib_flushsector(bch);
+          if (ret >= 0)
+            {
+              ret = blkcache_flush(bch->inode);
+            }
+        }
+        break;
+
+#ifndef CONFIG_BCH_ENCRYPTION
+      /* mmap() of a block driver whose memory is directly accessible, such
+       * as a RAM disk.  The cached sectors are written back and dropped
+       * first since the mapping bypasses the caches.
+       */
+
+      case FIOC_MMAP:
+        {
+          FAR struct inode *bchinode = bch->inode;
+          FAR void **ppv = (FAR void **)((uintptr_t)arg);
+
+          if (ppv == NULL || bchinode->u.i_bops->ioctl == NULL)
+            {
+              ret = -ENOTTY;
+              break;
+            }
+
+          ret = bchlib_semtake(bch);
+          if (ret < 0)
+            {
+              break;
+            }
+
+          ret = bchlib_flushsector(bch);
+          if (ret >= 0)
+            {
+              bch->sector = (size_t)-1;
+              ret = blkcache_invalidate(bchinode);
+            }
+
+          bchlib_semgive(bch);
+
+          if (ret >= 0)
+            {
+              ret = bchinode->u.i_bops->ioctl(bchinode, BIOC_XIPBASE,
+                                              (unsigned long)
+                                              ((uintptr_t)ppv));
+            }
+        }
+        break;
+#endif
+
+      /* The discarded sectors must not be written back later from the
+       * caches.
+       */
+
+      case BIOC_DISCARD:
+        {
+          FAR struct inode *bchinode = bch->inode;
+          FAR const struct blk_discard_s *discard =
+            (FAR const struct blk_discard_s *)((uintptr_t)arg);
+
+          if (discard == NULL || bchinode->u.i_bops->ioctl == NULL)
+            {
+              ret = discard == NULL ? -EINVAL : -ENOTTY;
+              break;
+            }
+
+          ret = bchlib_semtake(bch);
+          if (ret < 0)
+            {
+              break;
+            }
+
+          ret = bchlib_flushsector(bch);
+          if (ret >= 0)
+            {
+              if (bch->sector >= discard->startsector &&
+                  bch->sector - discard->startsector < discard->nsectors)
+                {
+                  bch->sector = (size_t)-1;
+                }
+
+              ret = blkcache_invalidate(bchinode);
+            }
+
+          bchlib_semgive(bch);
+
+          if (ret >= 0)
+            {
+              ret = bchinode->u.i_bops->ioctl(bchinode, cmd, arg);
+            }
         }
         break;
 
@@ -124,7 +124,8 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 
       /* Write the sector to the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
+      ret = blkcache_write(inode, bch->buffer, bch->sector, 1,
+                           bch->sectsize);
       if (ret < 0)
         {
           ferr("Write failed: %zd\n", ret);
@@ -176,7 +177,7 @@ int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 
       bch->sector = (size_t)-1;
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+      ret = blkcache_read(inode, bch->buffer, sector, 1, bch->sectsize);
       if (ret < 0)
         {
           ferr("Read failed: %zd\n", ret);
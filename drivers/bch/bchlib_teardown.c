@@ -63,6 +63,7 @@ int bchlib_teardown(FAR void *handle)
   /* Flush any pending data to the block driver */
 
   bchlib_flushsector(bch);
+  blkcache_invalidate(bch->inode);
 
   /* Close the block driver */
 
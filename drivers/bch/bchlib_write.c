@@ -141,8 +141,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
 
       /* Write the contiguous sectors */
 
-      ret = bch->inode->u.i_bops->write(bch->inode, (FAR uint8_t *)buffer,
-                                        sector, nsectors);
+      ret = blkcache_write(bch->inode, (FAR uint8_t *)buffer, sector,
+                           nsectors, bch->sectsize);
       if (ret < 0)
         {
           ferr("ERROR: Write failed: %d\n", ret);
@@ -187,7 +187,7 @@ static void can_pollnotify(FAR struct can_dev_s *dev, pollevent_t eventset)
           if (fds->revents != 0)
             {
               caninfo("Report events: %08" PRIx32 "\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -379,6 +379,55 @@ static FAR struct can_reader_s *init_can_reader(FAR struct file *filep)
   return reader;
 }
 
+#ifdef CONFIG_CAN_READER_FILTERS
+/****************************************************************************
+ * Name: can_reader_accept
+ *
+ * Description:
+ *   Return true if the message passes the filters of the reader.
+ *
+ ****************************************************************************/
+
+static bool can_reader_accept(FAR struct can_reader_s *reader,
+                              FAR struct can_hdr_s *hdr)
+{
+  FAR struct canioc_rdfilter_s *filter;
+  int i;
+
+#ifdef CONFIG_CAN_ERRORS
+  if (hdr->ch_error)
+    {
+      return true;
+    }
+#endif
+
+  if (reader->nfilters == 0)
+    {
+      return true;
+    }
+
+  for (i = 0; i < reader->nfilters; i++)
+    {
+      filter = &reader->filters[i];
+
+#ifdef CONFIG_CAN_EXTID
+      if (filter->rf_extid != hdr->ch_extid)
+        {
+          continue;
+        }
+#endif
+
+      if ((hdr->ch_id & filter->rf_mask) ==
+          (filter->rf_id & filter->rf_mask))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Name: can_open
  *
@@ -608,6 +657,10 @@ static ssize_t can_read(FAR struct file *filep, FAR char *buffer,
           msg->cm_hdr.ch_extid  = 0;
 #endif
           msg->cm_hdr.ch_unused = 0;
+#ifdef CONFIG_CAN_TIMESTAMP
+          msg->cm_hdr.ch_ts.tv_sec  = 0;
+          msg->cm_hdr.ch_ts.tv_usec = 0;
+#endif
           memset(&(msg->cm_data), 0, CAN_ERROR_DLC);
           msg->cm_data[5]       = dev->cd_error;
 
@@ -1039,6 +1092,48 @@ static int can_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
                           (FAR struct canioc_rtr_s *)((uintptr_t)arg));
         break;
 
+#ifdef CONFIG_CAN_READER_FILTERS
+      /* CANIOC_ADD_RDFILTER: Add a software filter to this open file.
+       * Argument is a reference to struct canioc_rdfilter_s.
+       */
+
+      case CANIOC_ADD_RDFILTER:
+        {
+          FAR struct can_reader_s *reader = filep->f_priv;
+          FAR struct canioc_rdfilter_s *filter =
+            (FAR struct canioc_rdfilter_s *)((uintptr_t)arg);
+          irqstate_t flags;
+
+          DEBUGASSERT(reader != NULL && filter != NULL);
+
+          /* can_receive() walks the filters from the interrupt handler */
+
+          flags = enter_critical_section();
+          if (reader->nfilters >= CONFIG_CAN_NREADER_FILTERS)
+            {
+              ret = -ENOSPC;
+            }
+          else
+            {
+              reader->filters[reader->nfilters++] = *filter;
+            }
+
+          leave_critical_section(flags);
+        }
+        break;
+
+      /* CANIOC_CLR_RDFILTERS: Remove all software filters of this file */
+
+      case CANIOC_CLR_RDFILTERS:
+        {
+          FAR struct can_reader_s *reader = filep->f_priv;
+
+          DEBUGASSERT(reader != NULL);
+          reader->nfilters = 0;
+        }
+        break;
+#endif
+
       /* Not a "built-in" ioctl command.. perhaps it is unique to this
        * lower-half, device driver.
        */
@@ -1302,6 +1397,19 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
 
   caninfo("ID: %" PRId32 " DLC: %d\n", (uint32_t)hdr->ch_id, hdr->ch_dlc);
 
+#ifdef CONFIG_CAN_TIMESTAMP
+  /* Stamp the message now if the lower half has no hardware timestamp */
+
+  if (hdr->ch_ts.tv_sec == 0 && hdr->ch_ts.tv_usec == 0)
+    {
+      struct timespec ts;
+
+      clock_systime_timespec(&ts);
+      hdr->ch_ts.tv_sec  = ts.tv_sec;
+      hdr->ch_ts.tv_usec = ts.tv_nsec / 1000;
+    }
+#endif
+
   /* Check if adding this new message would over-run the drivers ability to
    * enqueue read data.
    */
@@ -1365,6 +1473,13 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
       FAR struct can_reader_s *reader = (FAR struct can_reader_s *)node;
       fifo = &reader->fifo;
 
+#ifdef CONFIG_CAN_READER_FILTERS
+      if (!can_reader_accept(reader, hdr))
+        {
+          continue;
+        }
+#endif
+
       nexttail = fifo->rx_tail + 1;
       if (nexttail >= CONFIG_CAN_FIFOSIZE)
         {
@@ -0,0 +1,108 @@
+/****************************************************************************
+ * drivers/dma/dma_coherent.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/dma.h>
+#include <nuttx/mm/gran.h>
+
+#ifdef CONFIG_DMA_COHERENT_POOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* By default a granule is one cache line, so that coherent buffers can
+ * also be handed to code that expects DMA_ALIGN alignment.
+ */
+
+#define DMA_COHERENT_LOG2GRAN  CONFIG_DMA_COHERENT_LOG2GRAN
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static GRAN_HANDLE g_dma_coherent;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: dma_coherent_initialize
+ *
+ * Description:
+ *   Provide the memory of the coherent DMA pool.
+ *
+ ****************************************************************************/
+
+int dma_coherent_initialize(FAR void *start, size_t size)
+{
+  DEBUGASSERT(g_dma_coherent == NULL);
+
+  g_dma_coherent = gran_initialize(start, size, DMA_COHERENT_LOG2GRAN,
+                                   DMA_COHERENT_LOG2GRAN);
+  return g_dma_coherent != NULL ? OK : -ENOMEM;
+}
+
+/****************************************************************************
+ * Name: dma_alloc_coherent
+ *
+ * Description:
+ *   Allocate memory from the coherent DMA pool.
+ *
+ ****************************************************************************/
+
+FAR void *dma_alloc_coherent(size_t size)
+{
+  if (g_dma_coherent == NULL)
+    {
+      return NULL;
+    }
+
+  return gran_alloc(g_dma_coherent, size);
+}
+
+/****************************************************************************
+ * Name: dma_free_coherent
+ *
+ * Description:
+ *   Return memory to the coherent DMA pool.
+ *
+ ****************************************************************************/
+
+void dma_free_coherent(FAR void *mem, size_t size)
+{
+  DEBUGASSERT(g_dma_coherent != NULL);
+
+  if (mem != NULL)
+    {
+      gran_free(g_dma_coherent, mem, size);
+    }
+}
+
+#endif /* CONFIG_DMA_COHERENT_POOL */
@@ -0,0 +1,529 @@
+/****************************************************************************
+ * drivers/dma/dma_engine.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/dmaengine.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The registered controllers */
+
+static FAR struct dmaengine_dev_s *g_dmaengine_devs[CONFIG_DMA_ENGINE_NDEVS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: dmaengine_prep
+ *
+ * Description:
+ *   Record the callback and pass a prepared descriptor to the lower half.
+ *
+ ****************************************************************************/
+
+static int dmaengine_prep(FAR struct dmaengine_chan_s *chan,
+                          FAR const struct dmaengine_desc_s *desc,
+                          dmaengine_callback_t callback, FAR void *arg)
+{
+  DEBUGASSERT(chan != NULL && chan->ops->prep != NULL);
+
+  chan->callback = callback;
+  chan->arg      = arg;
+  chan->sg       = NULL;
+  chan->nents    = 0;
+  chan->sgindex  = 0;
+
+  return chan->ops->prep(chan, desc);
+}
+
+/****************************************************************************
+ * Name: dmaengine_prep_buffer
+ *
+ * Description:
+ *   Fill a descriptor for a transfer between the device and one buffer.
+ *
+ ****************************************************************************/
+
+static void dmaengine_prep_buffer(FAR struct dmaengine_chan_s *chan,
+                                  FAR struct dmaengine_desc_s *desc,
+                                  uint8_t type, uintptr_t buf, size_t len)
+{
+  desc->type   = type;
+  desc->len    = len;
+  desc->period = 0;
+  desc->sg     = NULL;
+  desc->nents  = 0;
+
+  if (chan->config.dir == DMAENGINE_DEV_TO_MEM)
+    {
+      desc->src = chan->config.devaddr;
+      desc->dst = buf;
+    }
+  else
+    {
+      desc->src = buf;
+      desc->dst = chan->config.devaddr;
+    }
+}
+
+/****************************************************************************
+ * Name: dmaengine_prep_segment
+ *
+ * Description:
+ *   Prepare one segment of a scatter-gather list that the framework chains
+ *   in software.
+ *
+ ****************************************************************************/
+
+static int dmaengine_prep_segment(FAR struct dmaengine_chan_s *chan)
+{
+  FAR const struct dma_sg_s *sg = &chan->sg[chan->sgindex];
+  struct dmaengine_desc_s desc;
+
+  dmaengine_prep_buffer(chan, &desc, DMAENGINE_SINGLE, sg->dmaaddr,
+                        sg->len);
+  return chan->ops->prep(chan, &desc);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: dmaengine_register
+ *
+ * Description:
+ *   Register a DMA controller.
+ *
+ ****************************************************************************/
+
+int dmaengine_register(FAR struct dmaengine_dev_s *dev)
+{
+  irqstate_t flags;
+  int devno;
+
+  DEBUGASSERT(dev != NULL && dev->ops != NULL);
+
+  /* Controllers register during the early architecture initialization,
+   * before it is possible to wait on a mutex.
+   */
+
+  flags = enter_critical_section();
+  for (devno = 0; devno < CONFIG_DMA_ENGINE_NDEVS; devno++)
+    {
+      if (g_dmaengine_devs[devno] == NULL)
+        {
+          g_dmaengine_devs[devno] = dev;
+          leave_critical_section(flags);
+          return devno;
+        }
+    }
+
+  leave_critical_section(flags);
+  dmaerr("ERROR: No room for another DMA controller\n");
+  return -ENOSPC;
+}
+
+/****************************************************************************
+ * Name: dmaengine_request
+ *
+ * Description:
+ *   Allocate a channel of a registered controller.
+ *
+ ****************************************************************************/
+
+FAR struct dmaengine_chan_s *dmaengine_request(int devno,
+                                               unsigned int ident)
+{
+  FAR struct dmaengine_dev_s *dev;
+  FAR struct dmaengine_chan_s *chan;
+
+  if (devno < 0 || devno >= CONFIG_DMA_ENGINE_NDEVS ||
+      (dev = g_dmaengine_devs[devno]) == NULL)
+    {
+      return NULL;
+    }
+
+  chan = dev->ops->request(dev, ident);
+  if (chan != NULL)
+    {
+      DEBUGASSERT(chan->ops != NULL);
+
+      chan->dev      = dev;
+      chan->callback = NULL;
+      chan->sg       = NULL;
+      chan->nents    = 0;
+      chan->sgindex  = 0;
+    }
+
+  return chan;
+}
+
+/****************************************************************************
+ * Name: dmaengine_release
+ *
+ * Description:
+ *   Stop any transfer and free the channel.
+ *
+ ****************************************************************************/
+
+void dmaengine_release(FAR struct dmaengine_chan_s *chan)
+{
+  DEBUGASSERT(chan != NULL && chan->dev != NULL);
+
+  dmaengine_terminate(chan);
+  chan->dev->ops->release(chan->dev, chan);
+}
+
+/****************************************************************************
+ * Name: dmaengine_config
+ *
+ * Description:
+ *   Set the static configuration of the channel.
+ *
+ ****************************************************************************/
+
+int dmaengine_config(FAR struct dmaengine_chan_s *chan,
+                     FAR const struct dmaengine_config_s *config)
+{
+  int ret = OK;
+
+  DEBUGASSERT(chan != NULL && config != NULL);
+
+  if (config->width != 1 && config->width != 2 && config->width != 4)
+    {
+      return -EINVAL;
+    }
+
+  if (chan->ops->config != NULL)
+    {
+      ret = chan->ops->config(chan, config);
+    }
+
+  if (ret >= 0)
+    {
+      chan->config = *config;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: dmaengine_prep_single
+ *
+ * Description:
+ *   Prepare a transfer between the device and one buffer.
+ *
+ ****************************************************************************/
+
+int dmaengine_prep_single(FAR struct dmaengine_chan_s *chan, uintptr_t buf,
+                          size_t len, dmaengine_callback_t callback,
+                          FAR void *arg)
+{
+  struct dmaengine_desc_s desc;
+
+  DEBUGASSERT(chan != NULL);
+
+  if (chan->config.dir == DMAENGINE_MEM_TO_MEM || len == 0)
+    {
+      return -EINVAL;
+    }
+
+  dmaengine_prep_buffer(chan, &desc, DMAENGINE_SINGLE, buf, len);
+  return dmaengine_prep(chan, &desc, callback, arg);
+}
+
+/****************************************************************************
+ * Name: dmaengine_prep_sg
+ *
+ * Description:
+ *   Prepare a transfer between the device and a scatter-gather list.  If
+ *   the controller cannot chain the segments itself, they are issued one
+ *   at a time from dmaengine_complete() and the callback is made once,
+ *   after the last segment.
+ *
+ ****************************************************************************/
+
+int dmaengine_prep_sg(FAR struct dmaengine_chan_s *chan,
+                      FAR const struct dma_sg_s *sg, int nents,
+                      dmaengine_callback_t callback, FAR void *arg)
+{
+  struct dmaengine_desc_s desc;
+  int ret;
+
+  DEBUGASSERT(chan != NULL && sg != NULL);
+
+  if (chan->config.dir == DMAENGINE_MEM_TO_MEM || nents <= 0)
+    {
+      return -EINVAL;
+    }
+
+  if ((chan->dev->caps & DMAENGINE_CAP_SG) != 0)
+    {
+      desc.type   = DMAENGINE_SG;
+      desc.src    = 0;
+      desc.dst    = 0;
+      desc.len    = 0;
+      desc.period = 0;
+      desc.sg     = sg;
+      desc.nents  = nents;
+
+      return dmaengine_prep(chan, &desc, callback, arg);
+    }
+
+  chan->callback = callback;
+  chan->arg      = arg;
+  chan->sg       = sg;
+  chan->nents    = nents;
+  chan->sgindex  = 0;
+
+  ret = dmaengine_prep_segment(chan);
+  if (ret < 0)
+    {
+      chan->sg    = NULL;
+      chan->nents = 0;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: dmaengine_prep_cyclic
+ *
+ * Description:
+ *   Prepare a cyclic transfer between the device and a ring buffer of
+ *   len / period periods.
+ *
+ ****************************************************************************/
+
+int dmaengine_prep_cyclic(FAR struct dmaengine_chan_s *chan, uintptr_t buf,
+                          size_t len, size_t period,
+                          dmaengine_callback_t callback, FAR void *arg)
+{
+  struct dmaengine_desc_s desc;
+
+  DEBUGASSERT(chan != NULL);
+
+  if ((chan->dev->caps & DMAENGINE_CAP_CYCLIC) == 0)
+    {
+      return -ENOSYS;
+    }
+
+  if (chan->config.dir == DMAENGINE_MEM_TO_MEM || period == 0 ||
+      len == 0 || len % period != 0)
+    {
+      return -EINVAL;
+    }
+
+  dmaengine_prep_buffer(chan, &desc, DMAENGINE_CYCLIC, buf, len);
+  desc.period = period;
+
+  return dmaengine_prep(chan, &desc, callback, arg);
+}
+
+/****************************************************************************
+ * Name: dmaengine_prep_memcpy
+ *
+ * Description:
+ *   Prepare a memory-to-memory copy.
+ *
+ ****************************************************************************/
+
+int dmaengine_prep_memcpy(FAR struct dmaengine_chan_s *chan, uintptr_t dst,
+                          uintptr_t src, size_t len,
+                          dmaengine_callback_t callback, FAR void *arg)
+{
+  struct dmaengine_desc_s desc;
+
+  DEBUGASSERT(chan != NULL);
+
+  if ((chan->dev->caps & DMAENGINE_CAP_MEMCPY) == 0)
+    {
+      return -ENOSYS;
+    }
+
+  if (chan->config.dir != DMAENGINE_MEM_TO_MEM || len == 0)
+    {
+      return -EINVAL;
+    }
+
+  desc.type   = DMAENGINE_MEMCPY;
+  desc.src    = src;
+  desc.dst    = dst;
+  desc.len    = len;
+  desc.period = 0;
+  desc.sg     = NULL;
+  desc.nents  = 0;
+
+  return dmaengine_prep(chan, &desc, callback, arg);
+}
+
+/****************************************************************************
+ * Name: dmaengine_submit
+ *
+ * Description:
+ *   Start the prepared transfer.
+ *
+ ****************************************************************************/
+
+int dmaengine_submit(FAR struct dmaengine_chan_s *chan)
+{
+  DEBUGASSERT(chan != NULL && chan->ops->start != NULL);
+  return chan->ops->start(chan);
+}
+
+/****************************************************************************
+ * Name: dmaengine_terminate
+ *
+ * Description:
+ *   Stop the transfer in progress and forget the rest of a software
+ *   chained scatter-gather list.
+ *
+ ****************************************************************************/
+
+int dmaengine_terminate(FAR struct dmaengine_chan_s *chan)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  DEBUGASSERT(chan != NULL);
+
+  flags = enter_critical_section();
+  chan->sg       = NULL;
+  chan->nents    = 0;
+  chan->callback = NULL;
+
+  if (chan->ops->stop != NULL)
+    {
+      ret = chan->ops->stop(chan);
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: dmaengine_pause
+ ****************************************************************************/
+
+int dmaengine_pause(FAR struct dmaengine_chan_s *chan)
+{
+  DEBUGASSERT(chan != NULL);
+
+  if ((chan->dev->caps & DMAENGINE_CAP_PAUSE) == 0 ||
+      chan->ops->pause == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  return chan->ops->pause(chan);
+}
+
+/****************************************************************************
+ * Name: dmaengine_resume
+ ****************************************************************************/
+
+int dmaengine_resume(FAR struct dmaengine_chan_s *chan)
+{
+  DEBUGASSERT(chan != NULL);
+
+  if ((chan->dev->caps & DMAENGINE_CAP_PAUSE) == 0 ||
+      chan->ops->resume == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  return chan->ops->resume(chan);
+}
+
+/****************************************************************************
+ * Name: dmaengine_residue
+ ****************************************************************************/
+
+size_t dmaengine_residue(FAR struct dmaengine_chan_s *chan)
+{
+  DEBUGASSERT(chan != NULL);
+
+  if (chan->ops->residue == NULL)
+    {
+      return 0;
+    }
+
+  return chan->ops->residue(chan);
+}
+
+/****************************************************************************
+ * Name: dmaengine_complete
+ *
+ * Description:
+ *   Called by the lower half from its interrupt handler.  Issues the next
+ *   segment of a software chained scatter-gather list or reports the
+ *   result to the client.
+ *
+ ****************************************************************************/
+
+void dmaengine_complete(FAR struct dmaengine_chan_s *chan, int result)
+{
+  dmaengine_callback_t callback;
+  int ret;
+
+  DEBUGASSERT(chan != NULL);
+
+  if (result == OK && chan->sg != NULL && ++chan->sgindex < chan->nents)
+    {
+      ret = dmaengine_prep_segment(chan);
+      if (ret >= 0)
+        {
+          ret = chan->ops->start(chan);
+        }
+
+      if (ret >= 0)
+        {
+          return;
+        }
+
+      result = ret;
+    }
+
+  callback = chan->callback;
+  if (result != DMAENGINE_PERIOD)
+    {
+      chan->sg    = NULL;
+      chan->nents = 0;
+    }
+
+  if (callback != NULL)
+    {
+      callback(chan, chan->arg, result);
+    }
+}
@@ -0,0 +1,170 @@
+/****************************************************************************
+ * drivers/dma/dma_map.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/cache.h>
+#include <nuttx/dma.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: dma_aligned
+ *
+ * Description:
+ *   Return true if the buffer starts and ends on cache line boundaries.
+ *
+ ****************************************************************************/
+
+bool dma_aligned(FAR const void *addr, size_t len)
+{
+#ifdef CONFIG_ARCH_DCACHE
+  return (((uintptr_t)addr | len) & DMA_ALIGN_MASK) == 0;
+#else
+  return true;
+#endif
+}
+
+/****************************************************************************
+ * Name: dma_sync_for_device
+ *
+ * Description:
+ *   Give the buffer to the device.
+ *
+ ****************************************************************************/
+
+void dma_sync_for_device(FAR const void *addr, size_t len,
+                         enum dma_direction_e dir)
+{
+  if (dir == DMA_TO_DEVICE)
+    {
+      up_clean_dcache((uintptr_t)addr, (uintptr_t)addr + len);
+    }
+  else
+    {
+      /* Also write back the partial lines at either end:  Discarding them
+       * here would lose the CPU's writes to the data next to the buffer.
+       */
+
+      up_flush_dcache((uintptr_t)addr, (uintptr_t)addr + len);
+    }
+}
+
+/****************************************************************************
+ * Name: dma_sync_for_cpu
+ *
+ * Description:
+ *   Give the buffer back to the CPU.
+ *
+ ****************************************************************************/
+
+void dma_sync_for_cpu(FAR const void *addr, size_t len,
+                      enum dma_direction_e dir)
+{
+  if (dir != DMA_TO_DEVICE)
+    {
+      /* The lines may have been fetched again by speculative reads while
+       * the transfer was in progress.
+       */
+
+      up_invalidate_dcache((uintptr_t)addr, (uintptr_t)addr + len);
+    }
+}
+
+/****************************************************************************
+ * Name: dma_map_single
+ *
+ * Description:
+ *   Map a buffer for one DMA transfer.
+ *
+ ****************************************************************************/
+
+uintptr_t dma_map_single(FAR void *addr, size_t len,
+                         enum dma_direction_e dir)
+{
+  DEBUGASSERT(addr != NULL && len > 0);
+
+  dma_sync_for_device(addr, len, dir);
+  return (uintptr_t)addr;
+}
+
+/****************************************************************************
+ * Name: dma_unmap_single
+ *
+ * Description:
+ *   Unmap a buffer when its transfer is complete.
+ *
+ ****************************************************************************/
+
+void dma_unmap_single(FAR void *addr, size_t len,
+                      enum dma_direction_e dir)
+{
+  dma_sync_for_cpu(addr, len, dir);
+}
+
+/****************************************************************************
+ * Name: dma_map_sg
+ *
+ * Description:
+ *   Map each segment of a scatter-gather list.
+ *
+ ****************************************************************************/
+
+int dma_map_sg(FAR struct dma_sg_s *sg, int nents,
+               enum dma_direction_e dir)
+{
+  int i;
+
+  DEBUGASSERT(sg != NULL && nents > 0);
+
+  for (i = 0; i < nents; i++)
+    {
+      sg[i].dmaaddr = dma_map_single(sg[i].addr, sg[i].len, dir);
+    }
+
+  return nents;
+}
+
+/****************************************************************************
+ * Name: dma_unmap_sg
+ *
+ * Description:
+ *   Unmap each segment of a scatter-gather list.
+ *
+ ****************************************************************************/
+
+void dma_unmap_sg(FAR struct dma_sg_s *sg, int nents,
+                  enum dma_direction_e dir)
+{
+  int i;
+
+  for (i = 0; i < nents; i++)
+    {
+      dma_unmap_single(sg[i].addr, sg[i].len, dir);
+    }
+}
@@ -78,6 +78,10 @@ void drivers_initialize(void)
   loop_register();      /* Standard /dev/loop */
 #endif
 
+#if defined(CONFIG_DEV_PMU)
+  devpmu_register();    /* Non-standard /dev/pmu */
+#endif
+
 #if defined(CONFIG_DRIVER_NOTE)
   note_register();      /* Non-standard /dev/note */
 #endif
@@ -0,0 +1,525 @@
+/****************************************************************************
+ * drivers/i2c/i2c_regmap.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/i2c/i2c_master.h>
+#include <nuttx/i2c/i2c_regmap.h>
+
+#ifdef CONFIG_I2C_REGMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define REGMAP_NREGS      256
+#define REGMAP_NWORDS     (REGMAP_NREGS / 32)
+
+#define REGMAP_TEST(b,r)  (((b)[(r) >> 5] & (UINT32_C(1) << ((r) & 31))) != 0)
+#define REGMAP_SET(b,r)   ((b)[(r) >> 5] |= (UINT32_C(1) << ((r) & 31)))
+#define REGMAP_CLR(b,r)   ((b)[(r) >> 5] &= ~(UINT32_C(1) << ((r) & 31)))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct i2c_regmap_s
+{
+  FAR struct i2c_master_s *i2c;    /* The bus the device is on */
+  struct i2c_config_s config;      /* The address of the device */
+  sem_t exclsem;                   /* Mutual exclusion */
+  uint8_t autoinc;                 /* Address bits of burst accesses */
+  bool cacheonly;                  /* Defer writes to i2c_regmap_sync() */
+  uint32_t valid[REGMAP_NWORDS];   /* The register is in cache[] */
+  uint32_t dirty[REGMAP_NWORDS];   /* The register awaits sync */
+  uint32_t volat[REGMAP_NWORDS];   /* The register is never cached */
+  uint8_t cache[REGMAP_NREGS];     /* The cached register values */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: regmap_busread
+ *
+ * Description:
+ *   Read len registers from the device in one transfer.
+ *
+ ****************************************************************************/
+
+static int regmap_busread(FAR struct i2c_regmap_s *map, unsigned int reg,
+                          FAR uint8_t *buf, unsigned int len)
+{
+  uint8_t regaddr = reg;
+
+  if (len > 1)
+    {
+      regaddr |= map->autoinc;
+    }
+
+  return i2c_writeread(map->i2c, &map->config, &regaddr, 1, buf, len);
+}
+
+/****************************************************************************
+ * Name: regmap_buswrite
+ *
+ * Description:
+ *   Write len registers to the device in one transfer.  The data follows
+ *   the register address without a restart, so no copy is needed.
+ *
+ ****************************************************************************/
+
+static int regmap_buswrite(FAR struct i2c_regmap_s *map, unsigned int reg,
+                           FAR const uint8_t *buf, unsigned int len)
+{
+  uint8_t regaddr = reg;
+
+  if (len > 1)
+    {
+      regaddr |= map->autoinc;
+    }
+
+  return i2c_writeread(map->i2c, &map->config, &regaddr, 1,
+                       (FAR uint8_t *)buf, -(int)len);
+}
+
+/****************************************************************************
+ * Name: regmap_iscached
+ *
+ * Description:
+ *   Return true if all registers of the range can be served from cache.
+ *
+ ****************************************************************************/
+
+static bool regmap_iscached(FAR struct i2c_regmap_s *map, unsigned int reg,
+                            unsigned int len)
+{
+  unsigned int i;
+
+  for (i = reg; i < reg + len; i++)
+    {
+      if (REGMAP_TEST(map->volat, i) || !REGMAP_TEST(map->valid, i))
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: regmap_read
+ *
+ * Description:
+ *   i2c_regmap_bulk_read() with the register map locked.
+ *
+ ****************************************************************************/
+
+static int regmap_read(FAR struct i2c_regmap_s *map, unsigned int reg,
+                       FAR uint8_t *buf, unsigned int len)
+{
+  unsigned int i;
+  int ret;
+
+  if (regmap_iscached(map, reg, len))
+    {
+      memcpy(buf, &map->cache[reg], len);
+      return OK;
+    }
+
+  ret = regmap_busread(map, reg, buf, len);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = reg; i < reg + len; i++)
+    {
+      if (REGMAP_TEST(map->volat, i))
+        {
+          continue;
+        }
+
+      /* A register awaiting sync reads back the value to be written */
+
+      if (REGMAP_TEST(map->dirty, i))
+        {
+          buf[i - reg] = map->cache[i];
+        }
+      else
+        {
+          map->cache[i] = buf[i - reg];
+          REGMAP_SET(map->valid, i);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: regmap_write
+ *
+ * Description:
+ *   i2c_regmap_bulk_write() with the register map locked.
+ *
+ ****************************************************************************/
+
+static int regmap_write(FAR struct i2c_regmap_s *map, unsigned int reg,
+                        FAR const uint8_t *buf, unsigned int len)
+{
+  unsigned int i;
+  bool isvolatile = false;
+  int ret;
+
+  for (i = reg; i < reg + len; i++)
+    {
+      if (REGMAP_TEST(map->volat, i))
+        {
+          isvolatile = true;
+          break;
+        }
+    }
+
+  if (!isvolatile)
+    {
+      /* Skip the bus if nothing changes */
+
+      if (regmap_iscached(map, reg, len) &&
+          memcmp(&map->cache[reg], buf, len) == 0)
+        {
+          return OK;
+        }
+
+      if (map->cacheonly)
+        {
+          memcpy(&map->cache[reg], buf, len);
+          for (i = reg; i < reg + len; i++)
+            {
+              REGMAP_SET(map->valid, i);
+              REGMAP_SET(map->dirty, i);
+            }
+
+          return OK;
+        }
+    }
+
+  ret = regmap_buswrite(map, reg, buf, len);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = reg; i < reg + len; i++)
+    {
+      if (!REGMAP_TEST(map->volat, i))
+        {
+          map->cache[i] = buf[i - reg];
+          REGMAP_SET(map->valid, i);
+        }
+
+      REGMAP_CLR(map->dirty, i);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: regmap_sync
+ *
+ * Description:
+ *   i2c_regmap_sync() with the register map locked.
+ *
+ ****************************************************************************/
+
+static int regmap_sync(FAR struct i2c_regmap_s *map)
+{
+  unsigned int start;
+  unsigned int end;
+  unsigned int i;
+  int ret;
+
+  for (start = 0; start < REGMAP_NREGS; start = end)
+    {
+      if (!REGMAP_TEST(map->dirty, start))
+        {
+          end = start + 1;
+          continue;
+        }
+
+      /* Write the whole run of consecutive dirty registers at once */
+
+      for (end = start + 1;
+           end < REGMAP_NREGS && REGMAP_TEST(map->dirty, end);
+           end++);
+
+      ret = regmap_buswrite(map, start, &map->cache[start], end - start);
+      if (ret < 0)
+        {
+          i2cerr("ERROR: Failed to sync 0x%02x-0x%02x: %d\n",
+                 start, end - 1, ret);
+          return ret;
+        }
+
+      for (i = start; i < end; i++)
+        {
+          REGMAP_CLR(map->dirty, i);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_regmap_create
+ *
+ * Description:
+ *   Create a register map for one device.  All registers are cacheable and
+ *   not yet cached.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_regmap_s *
+i2c_regmap_create(FAR struct i2c_master_s *i2c,
+                  FAR const struct i2c_config_s *config, uint8_t autoinc)
+{
+  FAR struct i2c_regmap_s *map;
+
+  DEBUGASSERT(i2c != NULL && config != NULL);
+
+  map = (FAR struct i2c_regmap_s *)kmm_zalloc(sizeof(struct i2c_regmap_s));
+  if (map == NULL)
+    {
+      i2cerr("ERROR: Failed to allocate the register map\n");
+      return NULL;
+    }
+
+  map->i2c     = i2c;
+  map->config  = *config;
+  map->autoinc = autoinc;
+  nxsem_init(&map->exclsem, 0, 1);
+
+  return map;
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_destroy
+ ****************************************************************************/
+
+void i2c_regmap_destroy(FAR struct i2c_regmap_s *map)
+{
+  DEBUGASSERT(map != NULL);
+
+  nxsem_destroy(&map->exclsem);
+  kmm_free(map);
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_set_volatile
+ ****************************************************************************/
+
+void i2c_regmap_set_volatile(FAR struct i2c_regmap_s *map, uint8_t reg,
+                             unsigned int count)
+{
+  unsigned int i;
+
+  DEBUGASSERT(map != NULL && reg + count <= REGMAP_NREGS);
+
+  nxsem_wait_uninterruptible(&map->exclsem);
+  for (i = reg; i < reg + count; i++)
+    {
+      REGMAP_SET(map->volat, i);
+      REGMAP_CLR(map->valid, i);
+      REGMAP_CLR(map->dirty, i);
+    }
+
+  nxsem_post(&map->exclsem);
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_read
+ ****************************************************************************/
+
+int i2c_regmap_read(FAR struct i2c_regmap_s *map, uint8_t reg,
+                    FAR uint8_t *val)
+{
+  return i2c_regmap_bulk_read(map, reg, val, 1);
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_bulk_read
+ *
+ * Description:
+ *   Read len consecutive registers, from the cache if all of them are
+ *   cached, otherwise in one burst.
+ *
+ ****************************************************************************/
+
+int i2c_regmap_bulk_read(FAR struct i2c_regmap_s *map, uint8_t reg,
+                         FAR uint8_t *buf, unsigned int len)
+{
+  int ret;
+
+  DEBUGASSERT(map != NULL && buf != NULL);
+
+  if (len == 0 || reg + len > REGMAP_NREGS)
+    {
+      return -EINVAL;
+    }
+
+  nxsem_wait_uninterruptible(&map->exclsem);
+  ret = regmap_read(map, reg, buf, len);
+  nxsem_post(&map->exclsem);
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_write
+ ****************************************************************************/
+
+int i2c_regmap_write(FAR struct i2c_regmap_s *map, uint8_t reg,
+                     uint8_t val)
+{
+  return i2c_regmap_bulk_write(map, reg, &val, 1);
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_bulk_write
+ *
+ * Description:
+ *   Write len consecutive registers in one burst, or only to the cache in
+ *   cache-only mode.
+ *
+ ****************************************************************************/
+
+int i2c_regmap_bulk_write(FAR struct i2c_regmap_s *map, uint8_t reg,
+                          FAR const uint8_t *buf, unsigned int len)
+{
+  int ret;
+
+  DEBUGASSERT(map != NULL && buf != NULL);
+
+  if (len == 0 || reg + len > REGMAP_NREGS)
+    {
+      return -EINVAL;
+    }
+
+  nxsem_wait_uninterruptible(&map->exclsem);
+  ret = regmap_write(map, reg, buf, len);
+  nxsem_post(&map->exclsem);
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_update_bits
+ ****************************************************************************/
+
+int i2c_regmap_update_bits(FAR struct i2c_regmap_s *map, uint8_t reg,
+                           uint8_t mask, uint8_t val)
+{
+  uint8_t regval;
+  int ret;
+
+  DEBUGASSERT(map != NULL);
+
+  nxsem_wait_uninterruptible(&map->exclsem);
+  ret = regmap_read(map, reg, &regval, 1);
+  if (ret >= 0)
+    {
+      regval = (regval & ~mask) | (val & mask);
+      ret = regmap_write(map, reg, &regval, 1);
+    }
+
+  nxsem_post(&map->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_cache_only
+ ****************************************************************************/
+
+int i2c_regmap_cache_only(FAR struct i2c_regmap_s *map, bool enable)
+{
+  int ret = OK;
+
+  DEBUGASSERT(map != NULL);
+
+  nxsem_wait_uninterruptible(&map->exclsem);
+  map->cacheonly = enable;
+  if (!enable)
+    {
+      ret = regmap_sync(map);
+    }
+
+  nxsem_post(&map->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_sync
+ ****************************************************************************/
+
+int i2c_regmap_sync(FAR struct i2c_regmap_s *map)
+{
+  int ret;
+
+  DEBUGASSERT(map != NULL);
+
+  nxsem_wait_uninterruptible(&map->exclsem);
+  ret = regmap_sync(map);
+  nxsem_post(&map->exclsem);
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: i2c_regmap_invalidate
+ ****************************************************************************/
+
+void i2c_regmap_invalidate(FAR struct i2c_regmap_s *map)
+{
+  DEBUGASSERT(map != NULL);
+
+  nxsem_wait_uninterruptible(&map->exclsem);
+  memset(map->valid, 0, sizeof(map->valid));
+  memset(map->dirty, 0, sizeof(map->dirty));
+  nxsem_post(&map->exclsem);
+}
+
+#endif /* CONFIG_I2C_REGMAP */
@@ -274,7 +274,7 @@ static void ajoy_sample(FAR struct ajoy_upperhalf_s *priv)
                   if (fds->revents != 0)
                     {
                       iinfo("Report events: %08" PRIx32 "\n", fds->revents);
-                      nxsem_post(fds->sem);
+                      poll_notify(&fds, 1, 0);
                     }
                 }
             }
@@ -639,7 +639,7 @@ static int ajoy_poll(FAR struct file *filep, FAR struct pollfd *fds,
                   if (fds->revents != 0)
                     {
                       iinfo("Report events: %08" PRIx32 "\n", fds->revents);
-                      nxsem_post(fds->sem);
+                      poll_notify(&fds, 1, 0);
                     }
                 }
 
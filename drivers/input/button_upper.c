@@ -276,7 +276,7 @@ static void btn_sample(FAR struct btn_upperhalf_s *priv)
                   if (fds->revents != 0)
                     {
                       iinfo("Report events: %08" PRIx32 "\n", fds->revents);
-                      nxsem_post(fds->sem);
+                      poll_notify(&fds, 1, 0);
                     }
                 }
             }
@@ -691,7 +691,7 @@ static int btn_poll(FAR struct file *filep, FAR struct pollfd *fds,
                   if (fds->revents != 0)
                     {
                       iinfo("Report events: %08" PRIx32 "\n", fds->revents);
-                      nxsem_post(fds->sem);
+                      poll_notify(&fds, 1, 0);
                     }
                 }
 
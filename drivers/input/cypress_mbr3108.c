@@ -995,7 +995,7 @@ static void mbr3108_poll_notify(FAR struct mbr3108_dev_s *priv)
           mbr3108_dbg("Report events: %08" PRIx32 "\n", fds->revents);
 
           fds->revents |= POLLIN;
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 }
@@ -274,7 +274,7 @@ static void djoy_sample(FAR struct djoy_upperhalf_s *priv)
                   if (fds->revents != 0)
                     {
                       iinfo("Report events: %08" PRIx32 "\n", fds->revents);
-                      nxsem_post(fds->sem);
+                      poll_notify(&fds, 1, 0);
                     }
                 }
             }
@@ -633,7 +633,7 @@ static int djoy_poll(FAR struct file *filep, FAR struct pollfd *fds,
                   if (fds->revents != 0)
                     {
                       iinfo("Report events: %08" PRIx32 "\n", fds->revents);
-                      nxsem_post(fds->sem);
+                      poll_notify(&fds, 1, 0);
                     }
                 }
 
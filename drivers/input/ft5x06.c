@@ -216,7 +216,7 @@ static void ft5x06_notify(FAR struct ft5x06_dev_s *priv)
         {
           fds->revents |= POLLIN;
           iinfo("Report events: %08" PRIx32 "\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 
@@ -105,22 +105,7 @@ static const struct file_operations g_keyboard_fops =
 
 static void keyboard_notify(FAR struct keyboard_opriv_s *opriv)
 {
-  FAR struct pollfd *fds = opriv->fds;
-  if (fds != NULL)
-    {
-      fds->revents |= (fds->events & POLLIN);
-      if (fds->revents != 0)
-        {
-          /* report event log */
-
-          int semcount;
-          nxsem_get_value(fds->sem, &semcount);
-          if (semcount < 1)
-            {
-              nxsem_post(fds->sem);
-            }
-        }
-    }
+  poll_notify(&opriv->fds, 1, POLLIN);
 }
 
 /****************************************************************************
@@ -149,7 +134,8 @@ static int keyboard_open(FAR struct file *filep)
 
   /* Initializes the buffer for each open file */
 
-  ret = circbuf_init(&opriv->circ, NULL, upper->nums);
+  ret = circbuf_init(&opriv->circ, NULL,
+                     upper->nums * sizeof(struct keyboard_event_s));
   if (ret < 0)
     {
       kmm_free(opriv);
@@ -229,6 +215,14 @@ static ssize_t keyboard_read(FAR struct file *filep,
   FAR struct keyboard_opriv_s *opriv = filep->f_priv;
   int ret;
 
+  /* Only whole events are returned, as many as fit in the buffer */
+
+  len -= len % sizeof(struct keyboard_event_s);
+  if (len == 0)
+    {
+      return -EINVAL;
+    }
+
   /* Make sure that we have exclusive access to the private data structure */
 
   ret = nxsem_wait(&opriv->locksem);
@@ -50,6 +50,10 @@ struct touch_openpriv_s
   FAR struct pollfd *fds;     /* Polling structure of waiting thread */
   sem_t              waitsem; /* Used to wait for the availability of data */
   sem_t              locksem; /* Manages exclusive access to this structure */
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+  size_t             lasthead; /* Buffer head after the last sample queued */
+  bool               lastmove; /* The last sample queued was motion only */
+#endif
 };
 
 /* This structure is for touchscreen upper half driver */
@@ -60,6 +64,9 @@ struct touch_upperhalf_s
   sem_t            exclsem;            /* Manages exclusive access to this structure */
   struct list_node head;               /* Opened file buffer chain header node */
   FAR struct touch_lowerhalf_s *lower; /* A pointer of lower half instance */
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+  FAR struct touch_sample_s    *last;  /* Copy of the last sample reported */
+#endif
 };
 
 /****************************************************************************
@@ -68,6 +75,13 @@ struct touch_upperhalf_s
 
 static void    touch_notify(FAR struct touch_openpriv_s *openpriv,
                             pollevent_t eventset);
+static void    touch_drop(FAR struct circbuf_s *circ, size_t size);
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+static bool    touch_is_motion(FAR const struct touch_sample_s *last,
+                               FAR const struct touch_sample_s *sample);
+static void    touch_rewrite(FAR struct circbuf_s *circ, size_t pos,
+                             FAR const void *src, size_t bytes);
+#endif
 static int     touch_open(FAR struct file *filep);
 static int     touch_close(FAR struct file *filep);
 static ssize_t touch_read(FAR struct file *filep, FAR char *buffer,
@@ -104,26 +118,87 @@ static const struct file_operations g_touch_fops =
 static void touch_notify(FAR struct touch_openpriv_s *openpriv,
                          pollevent_t eventset)
 {
-  FAR struct pollfd *fd = openpriv->fds;
+  poll_notify(&openpriv->fds, 1, eventset);
+}
+
+/****************************************************************************
+ * Name: touch_drop
+ *
+ * Description:
+ *   Discard the oldest samples until there is room for size bytes.  Whole
+ *   samples are dropped so that the reader stays on sample boundaries.
+ *
+ ****************************************************************************/
+
+static void touch_drop(FAR struct circbuf_s *circ, size_t size)
+{
+  int npoints;
 
-  fd = openpriv->fds;
-  if (fd)
+  while (circbuf_space(circ) < size &&
+         circbuf_peek(circ, &npoints, sizeof(npoints)) > 0)
     {
-      fd->revents |= (fd->events & eventset);
-      if (fd->revents != 0)
-        {
-          /* report event log */
+      circbuf_skip(circ, SIZEOF_TOUCH_SAMPLE_S(npoints));
+    }
+}
 
-          int semcount;
-          nxsem_get_value(fd->sem, &semcount);
-          if (semcount < 1)
-            {
-              nxsem_post(fd->sem);
-            }
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+/****************************************************************************
+ * Name: touch_is_motion
+ *
+ * Description:
+ *   Return true if sample only reports motion of its contacts.  If last is
+ *   not NULL, these must also be the contacts of last, in the same order.
+ *
+ ****************************************************************************/
+
+static bool touch_is_motion(FAR const struct touch_sample_s *last,
+                            FAR const struct touch_sample_s *sample)
+{
+  int i;
+
+  if (last != NULL && sample->npoints != last->npoints)
+    {
+      return false;
+    }
+
+  for (i = 0; i < sample->npoints; i++)
+    {
+      if ((sample->point[i].flags & (TOUCH_DOWN | TOUCH_UP)) != 0 ||
+          (sample->point[i].flags & TOUCH_MOVE) == 0 ||
+          (last != NULL && sample->point[i].id != last->point[i].id))
+        {
+          return false;
         }
     }
+
+  return true;
 }
 
+/****************************************************************************
+ * Name: touch_rewrite
+ *
+ * Description:
+ *   Replace the bytes at the absolute position pos of the circular buffer,
+ *   which must still hold data not yet read.
+ *
+ ****************************************************************************/
+
+static void touch_rewrite(FAR struct circbuf_s *circ, size_t pos,
+                          FAR const void *src, size_t bytes)
+{
+  size_t off = pos % circ->size;
+  size_t len = circ->size - off;
+
+  if (len > bytes)
+    {
+      len = bytes;
+    }
+
+  memcpy((FAR char *)circ->base + off, src, len);
+  memcpy(circ->base, (FAR const char *)src + len, bytes - len);
+}
+#endif
+
 /****************************************************************************
  * Name: touch_open
  ****************************************************************************/
@@ -226,6 +301,9 @@ static ssize_t touch_read(FAR struct file *filep, FAR char *buffer,
                           size_t len)
 {
   FAR struct touch_openpriv_s *openpriv = filep->f_priv;
+  size_t nread = 0;
+  size_t size;
+  int npoints;
   int ret;
 
   if (!buffer || !len)
@@ -263,7 +341,31 @@ static ssize_t touch_read(FAR struct file *filep, FAR char *buffer,
         }
     }
 
-  ret = circbuf_read(&openpriv->circbuf, buffer, len);
+  /* Return as many whole samples as the buffer can hold */
+
+  while (circbuf_peek(&openpriv->circbuf, &npoints, sizeof(npoints)) > 0)
+    {
+      size = SIZEOF_TOUCH_SAMPLE_S(npoints);
+      if (nread + size > len)
+        {
+          /* If not even one sample fits, return its beginning and drop
+           * the remainder so that the next read starts on a sample.
+           */
+
+          if (nread == 0)
+            {
+              nread = circbuf_read(&openpriv->circbuf, buffer, len);
+              circbuf_skip(&openpriv->circbuf, size - nread);
+            }
+
+          break;
+        }
+
+      circbuf_read(&openpriv->circbuf, buffer + nread, size);
+      nread += size;
+    }
+
+  ret = nread;
 
 out:
   nxsem_post(&openpriv->locksem);
@@ -350,27 +452,74 @@ void touch_event(FAR void *priv, FAR const struct touch_sample_s *sample)
 {
   FAR struct touch_upperhalf_s *upper = priv;
   FAR struct touch_openpriv_s  *openpriv;
+  size_t size;
   int semcount;
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+  bool motion;
+#endif
+
+  if (sample->npoints < 1 || sample->npoints > upper->lower->maxpoint)
+    {
+      ierr("ERROR: invalid number of points: %d\n", sample->npoints);
+      return;
+    }
 
   if (nxsem_wait(&upper->exclsem) < 0)
     {
       return;
     }
 
+  size = SIZEOF_TOUCH_SAMPLE_S(sample->npoints);
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+  motion = touch_is_motion(upper->last, sample);
+#endif
+
   list_for_every_entry(&upper->head, openpriv, struct touch_openpriv_s, node)
     {
-      circbuf_overwrite(&openpriv->circbuf, sample,
-                        SIZEOF_TOUCH_SAMPLE_S(sample->npoints));
+      if (nxsem_wait(&openpriv->locksem) < 0)
+        {
+          continue;
+        }
 
-      nxsem_get_value(&openpriv->waitsem, &semcount);
-      if (semcount < 1)
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+      /* If the previous sample of this reader only reported motion of the
+       * same contacts, nothing was queued after it and it has not been
+       * read yet, just replace it with the new positions.
+       */
+
+      if (motion && openpriv->lastmove &&
+          openpriv->circbuf.head == openpriv->lasthead &&
+          circbuf_used(&openpriv->circbuf) >= size)
         {
-          nxsem_post(&openpriv->waitsem);
+          touch_rewrite(&openpriv->circbuf, openpriv->lasthead - size,
+                        sample, size);
         }
+      else
+#endif
+        {
+          touch_drop(&openpriv->circbuf, size);
+          circbuf_write(&openpriv->circbuf, sample, size);
+
+          nxsem_get_value(&openpriv->waitsem, &semcount);
+          if (semcount < 1)
+            {
+              nxsem_post(&openpriv->waitsem);
+            }
 
-      touch_notify(openpriv, POLLIN);
+          touch_notify(openpriv, POLLIN);
+        }
+
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+      openpriv->lasthead = openpriv->circbuf.head;
+      openpriv->lastmove = touch_is_motion(NULL, sample);
+#endif
+      nxsem_post(&openpriv->locksem);
     }
 
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+  memcpy(upper->last, sample, size);
+#endif
+
   nxsem_post(&upper->exclsem);
 }
 
@@ -395,6 +544,16 @@ int touch_register(FAR struct touch_lowerhalf_s *lower,
       return -ENOMEM;
     }
 
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+  upper->last = kmm_zalloc(SIZEOF_TOUCH_SAMPLE_S(lower->maxpoint));
+  if (!upper->last)
+    {
+      ierr("ERROR: Failed to mem alloc!\n");
+      kmm_free(upper);
+      return -ENOMEM;
+    }
+#endif
+
   lower->priv  = upper;
   upper->lower = lower;
   upper->nums  = nums;
@@ -405,6 +564,9 @@ int touch_register(FAR struct touch_lowerhalf_s *lower,
   if (ret < 0)
     {
       nxsem_destroy(&upper->exclsem);
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+      kmm_free(upper->last);
+#endif
       kmm_free(upper);
       return ret;
     }
@@ -425,5 +587,8 @@ void touch_unregister(FAR struct touch_lowerhalf_s *lower,
   unregister_driver(path);
 
   nxsem_destroy(&upper->exclsem);
+#ifdef CONFIG_INPUT_TOUCHSCREEN_COALESCE
+  kmm_free(upper->last);
+#endif
   kmm_free(upper);
 }
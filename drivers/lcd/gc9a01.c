@@ -152,6 +152,8 @@ struct gc9a01_dev_s
   FAR struct spi_dev_s *spi;  /* SPI device */
   uint8_t bpp;                /* Selected color depth */
   uint8_t power;              /* Current power setting */
+  uint16_t col0;              /* First column of the current window */
+  uint16_t col1;              /* Last column of the current window */
 
   /* This is working memory allocated by the LCD driver for each LCD device
    * and for each color plane. This memory will hold one raster line of data.
@@ -479,25 +481,31 @@ static void gc9a01_setarea(FAR struct gc9a01_dev_s *dev,
                            uint16_t x0, uint16_t y0,
                            uint16_t x1, uint16_t y1)
 {
+  uint8_t param[4];
+
   /* Set row address */
 
-  gc9a01_sendcmd(dev, GC9A01_RASET);
-  gc9a01_select(dev->spi, 8);
-  SPI_SEND(dev->spi, (y0 + GC9A01_YOFFSET) >> 8);
-  SPI_SEND(dev->spi, (y0 + GC9A01_YOFFSET) & 0xff);
-  SPI_SEND(dev->spi, (y1 + GC9A01_YOFFSET) >> 8);
-  SPI_SEND(dev->spi, (y1 + GC9A01_YOFFSET) & 0xff);
-  gc9a01_deselect(dev->spi);
+  param[0] = (y0 + GC9A01_YOFFSET) >> 8;
+  param[1] = (y0 + GC9A01_YOFFSET) & 0xff;
+  param[2] = (y1 + GC9A01_YOFFSET) >> 8;
+  param[3] = (y1 + GC9A01_YOFFSET) & 0xff;
+  gc9a01_cmddata(dev, GC9A01_RASET, param, 4);
 
-  /* Set column address */
+  /* Set column address.  Consecutive runs usually cover the same columns
+   * of successive rows, so skip the command if the columns are unchanged.
+   */
 
-  gc9a01_sendcmd(dev, GC9A01_CASET);
-  gc9a01_select(dev->spi, 8);
-  SPI_SEND(dev->spi, (x0 + GC9A01_XOFFSET) >> 8);
-  SPI_SEND(dev->spi, (x0 + GC9A01_XOFFSET) & 0xff);
-  SPI_SEND(dev->spi, (x1 + GC9A01_XOFFSET) >> 8);
-  SPI_SEND(dev->spi, (x1 + GC9A01_XOFFSET) & 0xff);
-  gc9a01_deselect(dev->spi);
+  if (x0 != dev->col0 || x1 != dev->col1)
+    {
+      param[0] = (x0 + GC9A01_XOFFSET) >> 8;
+      param[1] = (x0 + GC9A01_XOFFSET) & 0xff;
+      param[2] = (x1 + GC9A01_XOFFSET) >> 8;
+      param[3] = (x1 + GC9A01_XOFFSET) & 0xff;
+      gc9a01_cmddata(dev, GC9A01_CASET, param, 4);
+
+      dev->col0 = x0;
+      dev->col1 = x1;
+    }
 }
 
 /****************************************************************************
@@ -539,9 +547,16 @@ static void gc9a01_bpp(FAR struct gc9a01_dev_s *dev, int bpp)
 static void gc9a01_wrram(FAR struct gc9a01_dev_s *dev,
                          FAR const uint16_t *buff, size_t size)
 {
-  gc9a01_sendcmd(dev, GC9A01_RAMWR);
+  /* Send the command and the pixels without releasing the bus in between,
+   * the whole block goes out in one (possibly DMA) transfer.
+   */
 
-  gc9a01_select(dev->spi, GC9A01_BYTESPP * 8);
+  gc9a01_select(dev->spi, 8);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), true);
+  SPI_SEND(dev->spi, GC9A01_RAMWR);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), false);
+
+  SPI_SETBITS(dev->spi, GC9A01_BYTESPP * 8);
   SPI_SNDBLOCK(dev->spi, buff, size);
   gc9a01_deselect(dev->spi);
 }
@@ -576,16 +591,30 @@ static void gc9a01_rdram(FAR struct gc9a01_dev_s *dev,
 
 static void gc9a01_fill(FAR struct gc9a01_dev_s *dev, uint16_t color)
 {
+  size_t npixels = GC9A01_XRES * GC9A01_YRES;
+  size_t nsend;
   int i;
 
+  /* Replicate the color in the run buffer and send it block by block */
+
+  for (i = 0; i < GC9A01_LUT_SIZE; i++)
+    {
+      dev->runbuffer[i] = color;
+    }
+
   gc9a01_setarea(dev, 0, 0, GC9A01_XRES - 1, GC9A01_YRES - 1);
 
-  gc9a01_sendcmd(dev, GC9A01_RAMWR);
-  gc9a01_select(dev->spi, GC9A01_BYTESPP *8);
+  gc9a01_select(dev->spi, 8);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), true);
+  SPI_SEND(dev->spi, GC9A01_RAMWR);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), false);
 
-  for (i = 0; i < GC9A01_XRES * GC9A01_YRES; i++)
+  SPI_SETBITS(dev->spi, GC9A01_BYTESPP * 8);
+  while (npixels > 0)
     {
-      SPI_SEND(dev->spi, color);
+      nsend = npixels < GC9A01_LUT_SIZE ? npixels : GC9A01_LUT_SIZE;
+      SPI_SNDBLOCK(dev->spi, dev->runbuffer, nsend);
+      npixels -= nsend;
     }
 
   gc9a01_deselect(dev->spi);
@@ -844,6 +873,8 @@ FAR struct lcd_dev_s *gc9a01_lcdinitialize(FAR struct spi_dev_s *spi)
   priv->dev.getcontrast  = gc9a01_getcontrast;
   priv->dev.setcontrast  = gc9a01_setcontrast;
   priv->spi              = spi;
+  priv->col0             = UINT16_MAX;
+  priv->col1             = UINT16_MAX;
 
   /* Init the hardware and clear the display */
 
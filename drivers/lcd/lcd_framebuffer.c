@@ -31,7 +31,9 @@
 #include <debug.h>
 
 #include <nuttx/board.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/lcd/lcd.h>
 #include <nuttx/video/fb.h>
 
@@ -45,6 +47,19 @@
 
 #define VIDEO_PLANE 0
 
+/* Deferred updates: damaged areas are accumulated and transferred to the
+ * LCD together, from the low priority work queue.
+ */
+
+#ifndef CONFIG_LCD_FRAMEBUFFER_UPDATE_DELAY
+#  define CONFIG_LCD_FRAMEBUFFER_UPDATE_DELAY 0
+#endif
+
+#if CONFIG_LCD_FRAMEBUFFER_UPDATE_DELAY > 0
+#  define LCDFB_DEFERRED_UPDATE 1
+#  define LCDFB_NDAMAGE         4 /* Maximum number of pending areas */
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -63,6 +78,15 @@ struct lcdfb_dev_s
   fb_coord_t yres;                  /* Vertical resolution in pixel rows */
   fb_coord_t stride;                /* Width of a row in bytes */
   uint8_t display;                  /* Display number */
+
+#ifdef LCDFB_DEFERRED_UPDATE
+  struct work_s work;               /* Deferred update work */
+  uint8_t ndamage;                  /* Number of damaged areas */
+
+  /* Areas changed since the last transfer to the LCD */
+
+  struct fb_area_s damage[LCDFB_NDAMAGE];
+#endif
 };
 
 /****************************************************************************
@@ -73,6 +97,10 @@ struct lcdfb_dev_s
 
 static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
              FAR const struct fb_area_s *area);
+#ifdef LCDFB_DEFERRED_UPDATE
+static int lcdfb_deferupdate(FAR struct fb_vtable_s *vtable,
+             FAR const struct fb_area_s *area);
+#endif
 
 /* Get information about the video controller configuration and the
  * configuration of each color plane.
@@ -238,6 +266,162 @@ static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
   return OK;
 }
 
+#ifdef LCDFB_DEFERRED_UPDATE
+/****************************************************************************
+ * Name: lcdfb_areasize and lcdfb_areaunion
+ *
+ * Description:
+ *   Return the size of an area in pixels and the bounding box of two
+ *   areas.
+ *
+ ****************************************************************************/
+
+static inline int32_t lcdfb_areasize(FAR const struct fb_area_s *area)
+{
+  return (int32_t)area->w * area->h;
+}
+
+static void lcdfb_areaunion(FAR const struct fb_area_s *a,
+                            FAR const struct fb_area_s *b,
+                            FAR struct fb_area_s *result)
+{
+  fb_coord_t x1 = a->x < b->x ? a->x : b->x;
+  fb_coord_t y1 = a->y < b->y ? a->y : b->y;
+  fb_coord_t x2 = a->x + a->w > b->x + b->w ? a->x + a->w : b->x + b->w;
+  fb_coord_t y2 = a->y + a->h > b->y + b->h ? a->y + a->h : b->y + b->h;
+
+  result->x = x1;
+  result->y = y1;
+  result->w = x2 - x1;
+  result->h = y2 - y1;
+}
+
+/****************************************************************************
+ * Name: lcdfb_adddamage
+ *
+ * Description:
+ *   Add an area to the list of damaged areas.  An area is merged with the
+ *   pending area whose bounding box grows the least; that is always done
+ *   if the merge costs no extra pixels (overlapping or adjacent areas) or
+ *   if the list is full.  Must be called in a critical section.
+ *
+ ****************************************************************************/
+
+static void lcdfb_adddamage(FAR struct lcdfb_dev_s *priv,
+                            FAR const struct fb_area_s *area)
+{
+  struct fb_area_s merged;
+  struct fb_area_s bestarea;
+  int32_t bestcost;
+  int32_t cost;
+  int best;
+  int i;
+
+  bestarea = *area;
+
+  do
+    {
+      best     = -1;
+      bestcost = INT32_MAX;
+
+      for (i = 0; i < priv->ndamage; i++)
+        {
+          lcdfb_areaunion(&priv->damage[i], &bestarea, &merged);
+          cost = lcdfb_areasize(&merged) -
+                 lcdfb_areasize(&priv->damage[i]) -
+                 lcdfb_areasize(&bestarea);
+          if (cost < bestcost)
+            {
+              best     = i;
+              bestcost = cost;
+            }
+        }
+
+      if (best < 0 || (bestcost > 0 && priv->ndamage < LCDFB_NDAMAGE))
+        {
+          /* Nothing worth merging with, keep it as a separate area */
+
+          priv->damage[priv->ndamage++] = bestarea;
+          return;
+        }
+
+      /* Take the area out of the list, merge it and retry: the bigger area
+       * may now overlap yet another one.
+       */
+
+      lcdfb_areaunion(&priv->damage[best], &bestarea, &bestarea);
+      priv->damage[best] = priv->damage[--priv->ndamage];
+    }
+  while (priv->ndamage > 0);
+
+  priv->damage[priv->ndamage++] = bestarea;
+}
+
+/****************************************************************************
+ * Name: lcdfb_updateworker
+ *
+ * Description:
+ *   Transfer all the damaged areas accumulated so far to the LCD.
+ *
+ ****************************************************************************/
+
+static void lcdfb_updateworker(FAR void *arg)
+{
+  FAR struct lcdfb_dev_s *priv = (FAR struct lcdfb_dev_s *)arg;
+  struct fb_area_s damage[LCDFB_NDAMAGE];
+  irqstate_t flags;
+  int ndamage;
+  int i;
+
+  flags = enter_critical_section();
+  ndamage = priv->ndamage;
+  memcpy(damage, priv->damage, ndamage * sizeof(struct fb_area_s));
+  priv->ndamage = 0;
+  leave_critical_section(flags);
+
+  for (i = 0; i < ndamage; i++)
+    {
+      lcdfb_updateearea(&priv->vtable, &damage[i]);
+    }
+}
+
+/****************************************************************************
+ * Name: lcdfb_deferupdate
+ *
+ * Description:
+ *   Record the change to the framebuffer; the LCD is updated after
+ *   CONFIG_LCD_FRAMEBUFFER_UPDATE_DELAY milliseconds, together with all
+ *   the other changes done in the meantime.
+ *
+ ****************************************************************************/
+
+static int lcdfb_deferupdate(FAR struct fb_vtable_s *vtable,
+                             FAR const struct fb_area_s *area)
+{
+  FAR struct lcdfb_dev_s *priv = (FAR struct lcdfb_dev_s *)vtable;
+  irqstate_t flags;
+
+  DEBUGASSERT(area != NULL);
+
+  if (area->w < 1 || area->h < 1)
+    {
+      return OK;
+    }
+
+  flags = enter_critical_section();
+  lcdfb_adddamage(priv, area);
+  leave_critical_section(flags);
+
+  if (work_available(&priv->work))
+    {
+      work_queue(LPWORK, &priv->work, lcdfb_updateworker, priv,
+                 MSEC2TICK(CONFIG_LCD_FRAMEBUFFER_UPDATE_DELAY));
+    }
+
+  return OK;
+}
+#endif /* LCDFB_DEFERRED_UPDATE */
+
 /****************************************************************************
  * Name: lcdfb_getvideoinfo
  ****************************************************************************/
@@ -521,7 +705,11 @@ int up_fbinitialize(int display)
   priv->vtable.getcursor    = lcdfb_getcursor,
   priv->vtable.setcursor    = lcdfb_setcursor,
 #endif
+#ifdef LCDFB_DEFERRED_UPDATE
+  priv->vtable.updatearea   = lcdfb_deferupdate,
+#else
   priv->vtable.updatearea   = lcdfb_updateearea,
+#endif
   priv->vtable.setpower     = lcdfb_setpower,
 
 #ifdef CONFIG_LCD_EXTERNINIT
@@ -703,6 +891,12 @@ void up_fbuninitialize(int display)
               g_lcdfb = priv->flink;
             }
 
+#ifdef LCDFB_DEFERRED_UPDATE
+          /* Drop any pending deferred update */
+
+          work_cancel(LPWORK, &priv->work);
+#endif
+
 #ifndef CONFIG_LCD_EXTERNINIT
           /* Uninitialize the LCD */
 
@@ -152,6 +152,8 @@ struct st7789_dev_s
   FAR struct spi_dev_s *spi;  /* SPI device */
   uint8_t bpp;                /* Selected color depth */
   uint8_t power;              /* Current power setting */
+  uint16_t col0;              /* First column of the current window */
+  uint16_t col1;              /* Last column of the current window */
 
   /* This is working memory allocated by the LCD driver for each LCD device
    * and for each color plane. This memory will hold one raster line of data.
@@ -178,6 +180,8 @@ static void st7789_select(FAR struct spi_dev_s *spi, int bits);
 static void st7789_deselect(FAR struct spi_dev_s *spi);
 
 static inline void st7789_sendcmd(FAR struct st7789_dev_s *dev, uint8_t cmd);
+static void st7789_cmddata(FAR struct st7789_dev_s *dev, uint8_t cmd,
+                           FAR const uint8_t *data, int len);
 static void st7789_sleep(FAR struct st7789_dev_s *dev, bool sleep);
 static void st7789_setorientation(FAR struct st7789_dev_s *dev);
 static void st7789_display(FAR struct st7789_dev_s *dev, bool on);
@@ -307,6 +311,25 @@ static inline void st7789_sendcmd(FAR struct st7789_dev_s *dev, uint8_t cmd)
   st7789_deselect(dev->spi);
 }
 
+/****************************************************************************
+ * Name: st7789_cmddata
+ *
+ * Description:
+ *   Send a command and its parameters in a single bus transaction.
+ *
+ ****************************************************************************/
+
+static void st7789_cmddata(FAR struct st7789_dev_s *dev, uint8_t cmd,
+                           FAR const uint8_t *data, int len)
+{
+  st7789_select(dev->spi, 8);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), true);
+  SPI_SEND(dev->spi, cmd);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), false);
+  SPI_SNDBLOCK(dev->spi, data, len);
+  st7789_deselect(dev->spi);
+}
+
 /****************************************************************************
  * Name: st7789_sleep
  *
@@ -383,25 +406,31 @@ static void st7789_setarea(FAR struct st7789_dev_s *dev,
                            uint16_t x0, uint16_t y0,
                            uint16_t x1, uint16_t y1)
 {
+  uint8_t param[4];
+
   /* Set row address */
 
-  st7789_sendcmd(dev, ST7789_RASET);
-  st7789_select(dev->spi, 8);
-  SPI_SEND(dev->spi, (y0 + ST7789_YOFFSET) >> 8);
-  SPI_SEND(dev->spi, (y0 + ST7789_YOFFSET) & 0xff);
-  SPI_SEND(dev->spi, (y1 + ST7789_YOFFSET) >> 8);
-  SPI_SEND(dev->spi, (y1 + ST7789_YOFFSET) & 0xff);
-  st7789_deselect(dev->spi);
+  param[0] = (y0 + ST7789_YOFFSET) >> 8;
+  param[1] = (y0 + ST7789_YOFFSET) & 0xff;
+  param[2] = (y1 + ST7789_YOFFSET) >> 8;
+  param[3] = (y1 + ST7789_YOFFSET) & 0xff;
+  st7789_cmddata(dev, ST7789_RASET, param, 4);
 
-  /* Set column address */
+  /* Set column address.  Consecutive runs usually cover the same columns
+   * of successive rows, so skip the command if the columns are unchanged.
+   */
 
-  st7789_sendcmd(dev, ST7789_CASET);
-  st7789_select(dev->spi, 8);
-  SPI_SEND(dev->spi, (x0 + ST7789_XOFFSET) >> 8);
-  SPI_SEND(dev->spi, (x0 + ST7789_XOFFSET) & 0xff);
-  SPI_SEND(dev->spi, (x1 + ST7789_XOFFSET) >> 8);
-  SPI_SEND(dev->spi, (x1 + ST7789_XOFFSET) & 0xff);
-  st7789_deselect(dev->spi);
+  if (x0 != dev->col0 || x1 != dev->col1)
+    {
+      param[0] = (x0 + ST7789_XOFFSET) >> 8;
+      param[1] = (x0 + ST7789_XOFFSET) & 0xff;
+      param[2] = (x1 + ST7789_XOFFSET) >> 8;
+      param[3] = (x1 + ST7789_XOFFSET) & 0xff;
+      st7789_cmddata(dev, ST7789_CASET, param, 4);
+
+      dev->col0 = x0;
+      dev->col1 = x1;
+    }
 }
 
 /****************************************************************************
@@ -445,9 +474,16 @@ static void st7789_bpp(FAR struct st7789_dev_s *dev, int bpp)
 static void st7789_wrram(FAR struct st7789_dev_s *dev,
                          FAR const uint16_t *buff, size_t size)
 {
-  st7789_sendcmd(dev, ST7789_RAMWR);
+  /* Send the command and the pixels without releasing the bus in between,
+   * the whole block goes out in one (possibly DMA) transfer.
+   */
 
-  st7789_select(dev->spi, ST7789_BYTESPP * 8);
+  st7789_select(dev->spi, 8);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), true);
+  SPI_SEND(dev->spi, ST7789_RAMWR);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), false);
+
+  SPI_SETBITS(dev->spi, ST7789_BYTESPP * 8);
   SPI_SNDBLOCK(dev->spi, buff, size);
   st7789_deselect(dev->spi);
 }
@@ -482,16 +518,30 @@ static void st7789_rdram(FAR struct st7789_dev_s *dev,
 
 static void st7789_fill(FAR struct st7789_dev_s *dev, uint16_t color)
 {
+  size_t npixels = ST7789_XRES * ST7789_YRES;
+  size_t nsend;
   int i;
 
+  /* Replicate the color in the run buffer and send it block by block */
+
+  for (i = 0; i < ST7789_LUT_SIZE; i++)
+    {
+      dev->runbuffer[i] = color;
+    }
+
   st7789_setarea(dev, 0, 0, ST7789_XRES - 1, ST7789_YRES - 1);
 
-  st7789_sendcmd(dev, ST7789_RAMWR);
-  st7789_select(dev->spi, ST7789_BYTESPP *8);
+  st7789_select(dev->spi, 8);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), true);
+  SPI_SEND(dev->spi, ST7789_RAMWR);
+  SPI_CMDDATA(dev->spi, SPIDEV_DISPLAY(0), false);
 
-  for (i = 0; i < ST7789_XRES * ST7789_YRES; i++)
+  SPI_SETBITS(dev->spi, ST7789_BYTESPP * 8);
+  while (npixels > 0)
     {
-      SPI_SEND(dev->spi, color);
+      nsend = npixels < ST7789_LUT_SIZE ? npixels : ST7789_LUT_SIZE;
+      SPI_SNDBLOCK(dev->spi, dev->runbuffer, nsend);
+      npixels -= nsend;
     }
 
   st7789_deselect(dev->spi);
@@ -750,6 +800,8 @@ FAR struct lcd_dev_s *st7789_lcdinitialize(FAR struct spi_dev_s *spi)
   priv->dev.getcontrast  = st7789_getcontrast;
   priv->dev.setcontrast  = st7789_setcontrast;
   priv->spi              = spi;
+  priv->col0             = UINT16_MAX;
+  priv->col1             = UINT16_MAX;
 
   /* Init the hardware and clear the display */
 
@@ -73,6 +73,10 @@ struct loop_struct_s
  ****************************************************************************/
 
 static int     loop_semtake(FAR struct loop_struct_s *dev);
+static ssize_t loop_transfer(FAR struct loop_struct_s *dev,
+                             FAR unsigned char *buffer,
+                             blkcnt_t start_sector, unsigned int nsectors,
+                             bool write);
 static int     loop_open(FAR struct inode *inode);
 static int     loop_close(FAR struct inode *inode);
 static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
@@ -82,6 +86,8 @@ static ssize_t loop_write(FAR struct inode *inode,
                           blkcnt_t start_sector, unsigned int nsectors);
 static int     loop_geometry(FAR struct inode *inode,
                              FAR struct geometry *geometry);
+static int     loop_ioctl(FAR struct inode *inode, int cmd,
+                          unsigned long arg);
 
 /****************************************************************************
  * Private Data
@@ -94,7 +100,7 @@ static const struct block_operations g_bops =
   loop_read,     /* read */
   loop_write,    /* write */
   loop_geometry, /* geometry */
-  NULL           /* ioctl */
+  loop_ioctl     /* ioctl */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL         /* unlink */
 #endif
@@ -188,56 +194,111 @@ static int loop_close(FAR struct inode *inode)
 }
 
 /****************************************************************************
- * Name: loop_read
+ * Name: loop_transfer
  *
- * Description:  Read the specified number of sectors
+ * Description:
+ *   Read or write nsectors starting at start_sector with as few file
+ *   operations as possible: one seek and, unless the file system returns
+ *   less, one transfer for all of the sectors.  The device is locked so
+ *   that concurrent transfers cannot move the file position underneath.
  *
  ****************************************************************************/
 
-static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
-                         blkcnt_t start_sector, unsigned int nsectors)
+static ssize_t loop_transfer(FAR struct loop_struct_s *dev,
+                             FAR unsigned char *buffer,
+                             blkcnt_t start_sector, unsigned int nsectors,
+                             bool write)
 {
-  FAR struct loop_struct_s *dev;
-  ssize_t nbytesread;
+  size_t nbytes = (size_t)nsectors * dev->sectsize;
+  size_t ntotal = 0;
+  ssize_t nxfrd;
   off_t offset;
   off_t ret;
 
-  DEBUGASSERT(inode && inode->i_private);
-  dev = (FAR struct loop_struct_s *)inode->i_private;
-
   if (start_sector + nsectors > dev->nsectors)
     {
-      ferr("ERROR: Read past end of file\n");
+      ferr("ERROR: Transfer past end of file\n");
       return -EIO;
     }
 
-  /* Calculate the offset to read the sectors and seek to the position */
+  ret = loop_semtake(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Calculate the offset of the sectors and seek to the position */
 
   offset = start_sector * dev->sectsize + dev->offset;
   ret = file_seek(&dev->devfile, offset, SEEK_SET);
   if (ret < 0)
     {
       ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
+      loop_semgive(dev);
       return -EIO;
     }
 
-  /* Then read the requested number of sectors from that position */
+  /* Then transfer the requested number of sectors from that position */
 
-  do
+  while (ntotal < nbytes)
     {
-      nbytesread = file_read(&dev->devfile, buffer,
-                             nsectors * dev->sectsize);
-      if (nbytesread < 0 && nbytesread != -EINTR)
+      if (write)
+        {
+          nxfrd = file_write(&dev->devfile, buffer + ntotal,
+                             nbytes - ntotal);
+        }
+      else
+        {
+          nxfrd = file_read(&dev->devfile, buffer + ntotal,
+                            nbytes - ntotal);
+        }
+
+      if (nxfrd == -EINTR)
         {
-          ferr("ERROR: Read failed: %zd\n", nbytesread);
-          return (int)nbytesread;
+          continue;
         }
+      else if (nxfrd < 0)
+        {
+          ferr("ERROR: Transfer failed: %zd\n", nxfrd);
+          if (ntotal == 0)
+            {
+              loop_semgive(dev);
+              return nxfrd;
+            }
+
+          break;
+        }
+      else if (nxfrd == 0)
+        {
+          break;
+        }
+
+      ntotal += nxfrd;
     }
-  while (nbytesread < 0);
 
-  /* Return the number of sectors read */
+  loop_semgive(dev);
+
+  /* Return the number of sectors transferred */
+
+  return ntotal / dev->sectsize;
+}
+
+/****************************************************************************
+ * Name: loop_read
+ *
+ * Description:  Read the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                         blkcnt_t start_sector, unsigned int nsectors)
+{
+  FAR struct loop_struct_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct loop_struct_s *)inode->i_private;
 
-  return nbytesread / dev->sectsize;
+  return loop_transfer(dev, buffer, start_sector, nsectors, false);
 }
 
 /****************************************************************************
@@ -252,39 +313,17 @@ static ssize_t loop_write(FAR struct inode *inode,
                           blkcnt_t start_sector, unsigned int nsectors)
 {
   FAR struct loop_struct_s *dev;
-  ssize_t nbyteswritten;
-  off_t offset;
-  off_t ret;
 
   DEBUGASSERT(inode && inode->i_private);
   dev = (FAR struct loop_struct_s *)inode->i_private;
 
-  /* Calculate the offset to write the sectors and seek to the position */
-
-  offset = start_sector * dev->sectsize + dev->offset;
-  ret = file_seek(&dev->devfile, offset, SEEK_SET);
-  if (ret < 0)
-    {
-      ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
-    }
-
-  /* Then write the requested number of sectors to that position */
-
-  do
+  if (!dev->writeenabled)
     {
-      nbyteswritten = file_write(&dev->devfile, buffer,
-                                 nsectors * dev->sectsize);
-      if (nbyteswritten < 0 && nbyteswritten != -EINTR)
-        {
-          ferr("ERROR: file_write failed: %zd\n", nbyteswritten);
-          return nbyteswritten;
-        }
+      return -EACCES;
     }
-  while (nbyteswritten < 0);
-
-  /* Return the number of sectors written */
 
-  return nbyteswritten / dev->sectsize;
+  return loop_transfer(dev, (FAR unsigned char *)buffer, start_sector,
+                       nsectors, true);
 }
 
 /****************************************************************************
@@ -314,6 +353,104 @@ static int loop_geometry(FAR struct inode *inode,
   return -EINVAL;
 }
 
+/****************************************************************************
+ * Name: loop_ioctl
+ *
+ * Description:
+ *   Pass direct mapping and discard requests on to the underlying file
+ *
+ ****************************************************************************/
+
+static int loop_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
+{
+  FAR struct loop_struct_s *dev;
+  int ret;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct loop_struct_s *)inode->i_private;
+
+  switch (cmd)
+    {
+      /* The loop device is directly accessible if the file is, e.g. if it
+       * is a RAM disk or a file on XIP media.
+       */
+
+      case BIOC_XIPBASE:
+        {
+          FAR void **ppv = (FAR void **)((uintptr_t)arg);
+          FAR void *base;
+
+          if (ppv == NULL)
+            {
+              return -EINVAL;
+            }
+
+          ret = file_ioctl(&dev->devfile, FIOC_MMAP,
+                           (unsigned long)((uintptr_t)&base));
+          if (ret >= 0)
+            {
+              *ppv = (FAR uint8_t *)base + dev->offset;
+            }
+        }
+        break;
+
+      /* Discard the sectors of the underlying block device that are fully
+       * covered by the range, if the file is a block device.
+       */
+
+      case BIOC_DISCARD:
+        {
+          FAR const struct blk_discard_s *discard =
+            (FAR const struct blk_discard_s *)((uintptr_t)arg);
+          struct blk_discard_s lower;
+          struct geometry geo;
+          off_t start;
+          off_t end;
+
+          if (discard == NULL ||
+              discard->startsector >= dev->nsectors ||
+              discard->nsectors > dev->nsectors - discard->startsector)
+            {
+              return -EINVAL;
+            }
+
+          if (!dev->writeenabled)
+            {
+              return -EACCES;
+            }
+
+          ret = file_ioctl(&dev->devfile, BIOC_GEOMETRY,
+                           (unsigned long)((uintptr_t)&geo));
+          if (ret < 0)
+            {
+              return -ENOTTY;
+            }
+
+          start = dev->offset + discard->startsector * dev->sectsize;
+          end   = start + discard->nsectors * dev->sectsize;
+
+          lower.startsector = (start + geo.geo_sectorsize - 1) /
+                              geo.geo_sectorsize;
+          lower.nsectors    = end / geo.geo_sectorsize;
+          if (lower.nsectors <= lower.startsector)
+            {
+              return OK;
+            }
+
+          lower.nsectors -= lower.startsector;
+          ret = file_ioctl(&dev->devfile, BIOC_DISCARD,
+                           (unsigned long)((uintptr_t)&lower));
+        }
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -0,0 +1,166 @@
+/****************************************************************************
+ * drivers/misc/dev_pmu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/pmu.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/drivers/drivers.h>
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int devpmu_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations devpmu_fops =
+{
+  NULL,          /* open */
+  NULL,          /* close */
+  NULL,          /* read */
+  NULL,          /* write */
+  NULL,          /* seek */
+  devpmu_ioctl,  /* ioctl */
+  NULL           /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL         /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devpmu_ioctl
+ ****************************************************************************/
+
+static int devpmu_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  int ret;
+
+  switch (cmd)
+    {
+      case PMUIOC_NCOUNTERS:
+        {
+          FAR int *ncounters = (FAR int *)((uintptr_t)arg);
+
+          if (ncounters == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          ret = up_pmu_ncounters();
+          *ncounters = ret < PMU_NCOUNTERS ? ret : PMU_NCOUNTERS;
+          ret = OK;
+        }
+        break;
+
+      case PMUIOC_CONFIG:
+        {
+          FAR const struct pmu_config_s *config =
+            (FAR const struct pmu_config_s *)((uintptr_t)arg);
+
+          if (config == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          ret = nxsched_pmu_config(config->counter, config->event);
+        }
+        break;
+
+      case PMUIOC_READ:
+        {
+          FAR struct pmu_count_s *count =
+            (FAR struct pmu_count_s *)((uintptr_t)arg);
+          FAR struct tcb_s *tcb;
+          irqstate_t flags;
+
+          if (count == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          /* Keep the thread from exiting while it is read */
+
+          flags = enter_critical_section();
+          tcb = count->pid == 0 ? nxsched_self() :
+                                  nxsched_get_tcb(count->pid);
+          if (tcb != NULL)
+            {
+              nxsched_pmu_read(tcb, count);
+              ret = OK;
+            }
+          else
+            {
+              ret = -ESRCH;
+            }
+
+          leave_critical_section(flags);
+        }
+        break;
+
+      case PMUIOC_RESET:
+        nxsched_pmu_reset();
+        ret = OK;
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devpmu_register
+ *
+ * Description:
+ *   Register /dev/pmu
+ *
+ ****************************************************************************/
+
+void devpmu_register(void)
+{
+  register_driver("/dev/pmu", &devpmu_fops, 0666, NULL);
+}
@@ -328,30 +328,70 @@ static int rd_geometry(FAR struct inode *inode, struct geometry *geometry)
  * Name: rd_ioctl
  *
  * Description:
- *   Return device geometry
+ *   Return the base address of the RAM disk memory or discard sectors
  *
  ****************************************************************************/
 
 static int rd_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 {
   FAR struct rd_struct_s *dev;
-  FAR void **ppv = (void**)((uintptr_t)arg);
 
   finfo("Entry\n");
 
-  /* Only one ioctl command is supported */
-
   DEBUGASSERT(inode && inode->i_private);
-  if (cmd == BIOC_XIPBASE && ppv)
+  dev = (FAR struct rd_struct_s *)inode->i_private;
+
+  switch (cmd)
     {
-      dev  = (FAR struct rd_struct_s *)inode->i_private;
-      *ppv = (FAR void *)dev->rd_buffer;
+      /* The RAM disk memory is directly accessible, so the file systems
+       * and mmap() may use it in place.
+       */
 
-      finfo("ppv: %p\n", *ppv);
-      return OK;
+      case BIOC_XIPBASE:
+        {
+          FAR void **ppv = (FAR void **)((uintptr_t)arg);
+
+          if (ppv == NULL)
+            {
+              return -EINVAL;
+            }
+
+          *ppv = (FAR void *)dev->rd_buffer;
+          finfo("ppv: %p\n", *ppv);
+        }
+        break;
+
+      /* The discarded sectors are cleared so that no stale data can be read
+       * back from them.
+       */
+
+      case BIOC_DISCARD:
+        {
+          FAR const struct blk_discard_s *discard =
+            (FAR const struct blk_discard_s *)((uintptr_t)arg);
+
+          if (discard == NULL ||
+              discard->startsector >= dev->rd_nsectors ||
+              discard->nsectors > dev->rd_nsectors - discard->startsector)
+            {
+              return -EINVAL;
+            }
+
+          if (!RDFLAG_IS_WRENABLED(dev->rd_flags))
+            {
+              return -EACCES;
+            }
+
+          memset(&dev->rd_buffer[discard->startsector * dev->rd_sectsize],
+                 0, discard->nsectors * dev->rd_sectsize);
+        }
+        break;
+
+      default:
+        return -ENOTTY;
     }
 
-  return -ENOTTY;
+  return OK;
 }
 
 /****************************************************************************
@@ -958,6 +958,28 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
                 }
             }
 
+          /* A request of at least a whole read-ahead buffer is read
+           * directly into the user buffer in one transfer.  Staging it
+           * through the read-ahead buffer would only add a copy.
+           */
+
+          if (remaining >= rwb->rhmaxblocks &&
+              startblock + remaining <= rwb->nblocks)
+            {
+              ret = rwb->rhreload(rwb->dev, rdbuffer, startblock,
+                                  remaining);
+              if (ret != remaining)
+                {
+                  ferr("ERROR: Failed to read %zu blocks: %d\n",
+                       remaining, ret);
+
+                  rwb_semgive(&rwb->rhsem);
+                  return ret < 0 ? ret : -EIO;
+                }
+
+              remaining = 0;
+            }
+
           /* If we did not get all of the data from the buffer, then we have
            * to refill the buffer and try again.
            */
@@ -1166,20 +1188,79 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
 ssize_t rwb_readbytes(FAR struct rwbuffer_s *dev, off_t offset,
                       size_t nbytes, FAR uint8_t *buffer)
 {
+  FAR uint8_t *blkbuffer = NULL;
+  size_t nread = 0;
+  ssize_t ret = OK;
+
   /* Loop while there are bytes still be be read */
 
-  /* Make sure that the sector containing the next bytes to transfer is in
-   * memory.
-   */
+  while (nread < nbytes)
+    {
+      off_t  block  = offset / dev->blocksize;
+      size_t blkoff = offset % dev->blocksize;
+      size_t ncopy;
+
+      if (blkoff == 0 && nbytes - nread >= dev->blocksize)
+        {
+          /* Whole blocks go straight to the user buffer, through the write
+           * buffer and the read-ahead logic of rwb_read().
+           */
+
+          ret = rwb_read(dev, block, (nbytes - nread) / dev->blocksize,
+                         &buffer[nread]);
+          if (ret <= 0)
+            {
+              break;
+            }
+
+          ncopy = ret * dev->blocksize;
+        }
+      else
+        {
+          /* Make sure that the block containing the next bytes to transfer
+           * is in memory.  Consecutive small reads are served from the
+           * read-ahead buffer.
+           */
+
+          if (blkbuffer == NULL)
+            {
+              blkbuffer = kmm_malloc(dev->blocksize);
+              if (blkbuffer == NULL)
+                {
+                  ret = -ENOMEM;
+                  break;
+                }
+            }
+
+          ret = rwb_read(dev, block, 1, blkbuffer);
+          if (ret <= 0)
+            {
+              break;
+            }
+
+          /* How many bytes can be transfer from the in-memory data? */
+
+          ncopy = dev->blocksize - blkoff;
+          if (ncopy > nbytes - nread)
+            {
+              ncopy = nbytes - nread;
+            }
 
-  /* How many bytes can be transfer from the in-memory data? */
+          memcpy(&buffer[nread], &blkbuffer[blkoff], ncopy);
+        }
+
+      /* Adjust counts and offsets for the next time through the loop */
 
-  /* Transfer the bytes */
+      nread  += ncopy;
+      offset += ncopy;
+    }
 
-  /* Adjust counts and offsets for the next time through the loop */
+  if (blkbuffer != NULL)
+    {
+      kmm_free(blkbuffer);
+    }
 
-#warning Not Implemented
-  return -ENOSYS;
+  return nread > 0 ? (ssize_t)nread : ret;
 }
 #endif
 
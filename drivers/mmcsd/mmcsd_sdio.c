@@ -117,6 +117,12 @@ struct mmcsd_state_s
 #ifdef CONFIG_SDIO_DMA
   uint8_t dma:1;                   /* true: hardware supports DMA */
 #endif
+#ifdef CONFIG_MMCSD_SETBLOCKCOUNT
+  uint8_t cmd23:1;                 /* true: card supports SET_BLOCK_COUNT */
+#endif
+#ifdef CONFIG_MMCSD_MMCCACHE
+  uint8_t cache:1;                 /* true: eMMC write cache is enabled */
+#endif
 
   uint8_t mode:2;                  /* (See MMCSDMODE_* definitions) */
   uint8_t type:4;                  /* Card type (See MMCSD_CARDTYPE_* definitions) */
@@ -181,6 +187,14 @@ static int     mmcsd_transferready(FAR struct mmcsd_state_s *priv);
 #if MMCSD_MULTIBLOCK_LIMIT != 1
 static int     mmcsd_stoptransmission(FAR struct mmcsd_state_s *priv);
 #endif
+#ifdef CONFIG_MMCSD_SETBLOCKCOUNT
+static int     mmcsd_setblockcount(FAR struct mmcsd_state_s *priv,
+                 uint32_t nblocks);
+#endif
+#ifdef CONFIG_MMCSD_MMCCACHE
+static int     mmcsd_switch(FAR struct mmcsd_state_s *priv, uint8_t index,
+                 uint8_t value);
+#endif
 static int     mmcsd_setblocklen(FAR struct mmcsd_state_s *priv,
                  uint32_t blocklen);
 static ssize_t mmcsd_readsingle(FAR struct mmcsd_state_s *priv,
@@ -992,6 +1006,16 @@ static void mmcsd_decode_scr(FAR struct mmcsd_state_s *priv, uint32_t scr[2])
   priv->buswidth     = (scr[0] >> 8) & 15;
 #endif
 
+  /* CMD_SUPPORT 33:32, bit 33 indicates CMD23 (SET_BLOCK_COUNT) support */
+
+#ifdef CONFIG_MMCSD_SETBLOCKCOUNT
+#ifdef CONFIG_ENDIAN_BIG
+  priv->cmd23        = (scr[0] >> 1) & 1;
+#else
+  priv->cmd23        = (scr[0] >> 25) & 1;
+#endif
+#endif
+
 #ifdef CONFIG_DEBUG_FS_INFO
 #ifdef CONFIG_ENDIAN_BIG
   /* Card SCR is big-endian order / CPU also big-endian
@@ -1318,6 +1342,83 @@ static int mmcsd_stoptransmission(FAR struct mmcsd_state_s *priv)
 }
 #endif
 
+/****************************************************************************
+ * Name: mmcsd_setblockcount
+ *
+ * Description:
+ *   Send SET_BLOCK_COUNT to announce the number of blocks of the following
+ *   multiple block transfer.  The card then ends the transfer by itself and
+ *   no STOP_TRANSMISSION has to be sent.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MMCSD_SETBLOCKCOUNT
+static int mmcsd_setblockcount(FAR struct mmcsd_state_s *priv,
+                               uint32_t nblocks)
+{
+  int ret;
+
+  /* Send CMD23, SET_BLOCK_COUNT, and verify good R1 return status  */
+
+  mmcsd_sendcmdpoll(priv, MMCSD_CMD23, nblocks);
+  ret = mmcsd_recv_r1(priv, MMCSD_CMD23);
+  if (ret != OK)
+    {
+      ferr("ERROR: mmcsd_recv_r1 for CMD23 failed: %d\n", ret);
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: mmcsd_switch
+ *
+ * Description:
+ *   Write one byte of the EXT_CSD register of an MMC card with CMD6
+ *   (SWITCH) and wait until the card has completed the operation.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MMCSD_MMCCACHE
+static int mmcsd_switch(FAR struct mmcsd_state_s *priv, uint8_t index,
+                        uint8_t value)
+{
+  int ret;
+
+  ret = mmcsd_transferready(priv);
+  if (ret != OK)
+    {
+      ferr("ERROR: Card not ready: %d\n", ret);
+      return ret;
+    }
+
+  /* Send CMD6, SWITCH, and verify good R1 return status  */
+
+  mmcsd_sendcmdpoll(priv, MMCSD_CMD6, MMC_CMD6_WRITEBYTE |
+                    MMC_CMD6_INDEX(index) | MMC_CMD6_VALUE(value));
+  ret = mmcsd_recv_r1(priv, MMCSD_CMD6);
+  if (ret != OK)
+    {
+      ferr("ERROR: mmcsd_recv_r1 for CMD6 failed: %d\n", ret);
+      return ret;
+    }
+
+  /* The card signals busy until the switch is done, just like after a
+   * write.  Wait for it to return to the transfer state.
+   */
+
+  priv->wrbusy = true;
+
+#if defined(CONFIG_MMCSD_SDIOWAIT_WRCOMPLETE)
+  SDIO_WAITENABLE(priv->dev, SDIOWAIT_WRCOMPLETE | SDIOWAIT_TIMEOUT,
+                  MMCSD_BLOCK_WDATADELAY);
+#endif
+
+  return mmcsd_transferready(priv);
+}
+#endif
+
 /****************************************************************************
  * Name: mmcsd_setblocklen
  *
@@ -1502,6 +1603,7 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
 {
   size_t nbytes = nblocks << priv->blockshift;
   off_t  offset;
+  bool   sbc = false;
   int ret;
 
   finfo("startblock=%jd nblocks=%zu\n", (intmax_t)startblock, nblocks);
@@ -1570,6 +1672,21 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
       return ret;
     }
 
+#ifdef CONFIG_MMCSD_SETBLOCKCOUNT
+  /* Announce the length of the transfer if the card supports it */
+
+  if (priv->cmd23 && nblocks <= MMCSD_CMD23_MAXBLOCKS)
+    {
+      ret = mmcsd_setblockcount(priv, nblocks);
+      if (ret != OK)
+        {
+          return ret;
+        }
+
+      sbc = true;
+    }
+#endif
+
   /* Configure SDIO controller hardware for the read transfer */
 
   SDIO_BLOCKSETUP(priv->dev, priv->blocksize, nblocks);
@@ -1616,13 +1733,15 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
       return ret;
     }
 
-  /* Send STOP_TRANSMISSION */
+  /* Send STOP_TRANSMISSION, unless the card stopped by itself */
 
-  ret = mmcsd_stoptransmission(priv);
-
-  if (ret != OK)
+  if (!sbc)
     {
-      ferr("ERROR: mmcsd_stoptransmission failed: %d\n", ret);
+      ret = mmcsd_stoptransmission(priv);
+      if (ret != OK)
+        {
+          ferr("ERROR: mmcsd_stoptransmission failed: %d\n", ret);
+        }
     }
 
   /* On success, return the number of blocks read */
@@ -1813,6 +1932,7 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
 {
   size_t nbytes = nblocks << priv->blockshift;
   off_t  offset;
+  bool   sbc = false;
   int ret;
   int evret = OK;
 
@@ -1915,6 +2035,23 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
         }
     }
 
+#ifdef CONFIG_MMCSD_SETBLOCKCOUNT
+  /* Announce the length of the transfer if the card supports it.  This
+   * must be the last command before CMD25.
+   */
+
+  if (priv->cmd23 && nblocks <= MMCSD_CMD23_MAXBLOCKS)
+    {
+      ret = mmcsd_setblockcount(priv, nblocks);
+      if (ret != OK)
+        {
+          return ret;
+        }
+
+      sbc = true;
+    }
+#endif
+
   /* If Controller does not need DMA setup before the write then send CMD25
    * now.
    */
@@ -1990,18 +2127,23 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
        */
     }
 
-  /* Send STOP_TRANSMISSION */
+  /* Send STOP_TRANSMISSION, unless the card stopped by itself.  It is
+   * still needed to abort a failed transfer.
+   */
 
-  ret = mmcsd_stoptransmission(priv);
-  if (evret != OK)
+  if (!sbc || evret != OK)
     {
-      return evret;
-    }
+      ret = mmcsd_stoptransmission(priv);
+      if (evret != OK)
+        {
+          return evret;
+        }
 
-  if (ret != OK)
-    {
-      ferr("ERROR: mmcsd_stoptransmission failed: %d\n", ret);
-      return ret;
+      if (ret != OK)
+        {
+          ferr("ERROR: mmcsd_stoptransmission failed: %d\n", ret);
+          return ret;
+        }
     }
 
   /* Flag that a write transfer is pending that we will have to check for
@@ -2357,6 +2499,24 @@ static int mmcsd_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       }
       break;
 
+    case BIOC_FLUSH: /* Write back the eMMC cache */
+      {
+        finfo("BIOC_FLUSH\n");
+
+        ret = OK;
+#ifdef CONFIG_MMCSD_MMCCACHE
+        if (priv->cache)
+          {
+            ret = mmcsd_switch(priv, MMC_EXTCSD_FLUSH_CACHE, 1);
+            if (ret != OK)
+              {
+                ferr("ERROR: Cache flush failed: %d\n", ret);
+              }
+          }
+#endif
+      }
+      break;
+
     default:
       ret = -ENOTTY;
       break;
@@ -2636,6 +2796,20 @@ static int mmcsd_mmcinitialize(FAR struct mmcsd_state_s *priv)
           ferr("ERROR: Failed to determinate number of blocks: %d\n", ret);
           return ret;
         }
+
+#ifdef CONFIG_MMCSD_MMCCACHE
+      /* Enable the write cache if the device has one */
+
+      if (priv->cache)
+        {
+          ret = mmcsd_switch(priv, MMC_EXTCSD_CACHE_CTRL, 1);
+          if (ret != OK)
+            {
+              fwarn("WARNING: Failed to enable the cache: %d\n", ret);
+              priv->cache = false;
+            }
+        }
+#endif
     }
 
   mmcsd_decode_csd(priv, csd);
@@ -2765,6 +2939,21 @@ static int mmcsd_read_csd(FAR struct mmcsd_state_s *priv)
   finfo("MMC ext CSD read succsesfully, number of block %" PRId32 "\n",
         priv->nblocks);
 
+  /* Block addressed devices follow MMC 4.2 or later and so support
+   * SET_BLOCK_COUNT.
+   */
+
+#ifdef CONFIG_MMCSD_SETBLOCKCOUNT
+  priv->cmd23 = true;
+#endif
+
+#ifdef CONFIG_MMCSD_MMCCACHE
+  priv->cache = (buffer[MMC_EXTCSD_CACHE_SIZE] |
+                 buffer[MMC_EXTCSD_CACHE_SIZE + 1] |
+                 buffer[MMC_EXTCSD_CACHE_SIZE + 2] |
+                 buffer[MMC_EXTCSD_CACHE_SIZE + 3]) != 0;
+#endif
+
   SDIO_GOTEXTCSD(priv->dev, buffer);
 
   /* Return value:  One sector read */
@@ -3440,6 +3629,12 @@ static int mmcsd_removed(FAR struct mmcsd_state_s *priv)
   priv->type         = MMCSD_CARDTYPE_UNKNOWN;
   priv->rca          = 0;
   priv->selblocklen  = 0;
+#ifdef CONFIG_MMCSD_SETBLOCKCOUNT
+  priv->cmd23        = false;
+#endif
+#ifdef CONFIG_MMCSD_MMCCACHE
+  priv->cache        = false;
+#endif
 
   /* Go back to the default 1-bit data bus. */
 
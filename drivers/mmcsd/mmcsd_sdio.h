@@ -52,6 +52,22 @@
 #define MMCSD_ACMD6_BUSWIDTH_1      ((uint32_t)0)          /* Bus width = 1-bit */
 #define MMCSD_ACMD6_BUSWIDTH_4      ((uint32_t)2)          /* Bus width = 4-bit */
 
+/* CMD6 (MMC SWITCH) argument */
+
+#define MMC_CMD6_WRITEBYTE          ((uint32_t)3 << 24)    /* Access: Write byte */
+#define MMC_CMD6_INDEX(n)           ((uint32_t)(n) << 16)  /* EXT_CSD byte index */
+#define MMC_CMD6_VALUE(n)           ((uint32_t)(n) << 8)   /* Value to write */
+
+/* MMC EXT_CSD register bytes */
+
+#define MMC_EXTCSD_FLUSH_CACHE      32                     /* Flush the cache */
+#define MMC_EXTCSD_CACHE_CTRL       33                     /* Enable the cache */
+#define MMC_EXTCSD_CACHE_SIZE       249                    /* 4 bytes, in KiB */
+
+/* CMD23 (SET_BLOCK_COUNT) argument */
+
+#define MMCSD_CMD23_MAXBLOCKS       0xffff                 /* Bits 0-15: Count */
+
 /* ACMD41 argument */
 
 #define MMCSD_ACMD41_VOLTAGEWINDOW_34_33 ((uint32_t)1 << 21)
@@ -37,7 +37,10 @@
 #include <debug.h>
 #include <errno.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mtd/mtd.h>
@@ -59,10 +62,47 @@
 
 #define DEV_NAME_MAX    (NAME_MAX + 5)
 
+/* The erase block cache is written back from the low priority work queue
+ * after a delay.  The work runs concurrently with the block driver
+ * interfaces, which must then hold the device semaphore.
+ */
+
+#ifdef CONFIG_FTL_EBCACHE
+#  if defined(CONFIG_FTL_EBCACHE_FLUSHDELAY) && \
+      CONFIG_FTL_EBCACHE_FLUSHDELAY > 0
+#    define FTL_EBCACHE_TIMEOUT 1
+#  endif
+#  define ftl_lock(dev)   nxsem_wait_uninterruptible(&(dev)->exclsem)
+#  define ftl_unlock(dev) nxsem_post(&(dev)->exclsem)
+#  define ftl_cache_written(e, n) (((e)->written[(n) >> 3] & \
+                                    (1 << ((n) & 7))) != 0)
+#else
+#  define ftl_lock(dev)
+#  define ftl_unlock(dev)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_FTL_EBCACHE
+/* One cached erase block.  Until the entry is loaded, only the R/W blocks
+ * marked in the written bitmap are valid in the buffer and the others must
+ * be read from FLASH before the erase block is written back.
+ */
+
+struct ftl_ebcache_s
+{
+  FAR uint8_t *buffer;            /* Contents of the erase block */
+  FAR uint8_t *written;           /* Bitmap of the R/W blocks written */
+  off_t        eblock;            /* Cached erase block, -1 if unused */
+  uint32_t     lastuse;           /* Time stamp for the LRU eviction */
+  uint16_t     nwritten;          /* Number of bits set in written */
+  bool         loaded;            /* The whole buffer is valid */
+  bool         dirty;             /* Must be written back to FLASH */
+};
+#endif
+
 struct ftl_struct_s
 {
   FAR struct mtd_dev_s *mtd;      /* Contained MTD interface */
@@ -73,7 +113,16 @@ struct ftl_struct_s
   uint16_t              blkper;   /* R/W blocks per erase block */
   uint16_t              refs;     /* Number of references */
   bool                  unlinked; /* The driver has been unlinked */
+#ifdef CONFIG_FTL_EBCACHE
+  sem_t                 exclsem;  /* Protects the erase block cache */
+  uint32_t              ebclock;  /* Source of the LRU time stamps */
+#ifdef FTL_EBCACHE_TIMEOUT
+  struct work_s         work;     /* Delayed write-back of the cache */
+#endif
+  struct ftl_ebcache_s  ebcache[CONFIG_FTL_EBCACHE_NBLOCKS];
+#else
   FAR uint8_t          *eblock;   /* One, in-memory erase block */
+#endif
 };
 
 /****************************************************************************
@@ -120,6 +169,352 @@ static const struct block_operations g_bops =
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_FTL_EBCACHE
+
+/****************************************************************************
+ * Name: ftl_cache_find
+ *
+ * Description: Return the cache entry holding an erase block, if any
+ *
+ ****************************************************************************/
+
+static FAR struct ftl_ebcache_s *
+ftl_cache_find(FAR struct ftl_struct_s *dev, off_t eraseblock)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FTL_EBCACHE_NBLOCKS; i++)
+    {
+      if (dev->ebcache[i].eblock == eraseblock)
+        {
+          return &dev->ebcache[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: ftl_cache_fill
+ *
+ * Description:
+ *   Read from FLASH the R/W blocks of a cached erase block that have not
+ *   been written.  Nothing is read when the erase block was completely
+ *   overwritten.
+ *
+ ****************************************************************************/
+
+static int ftl_cache_fill(FAR struct ftl_struct_s *dev,
+                          FAR struct ftl_ebcache_s *entry)
+{
+  off_t  rwblock;
+  size_t nxfrd;
+  int    first;
+  int    i;
+
+  if (entry->loaded)
+    {
+      return OK;
+    }
+
+  rwblock = entry->eblock * dev->blkper;
+  for (first = 0; first < dev->blkper; first = i)
+    {
+      /* Skip over the R/W blocks already written */
+
+      if (ftl_cache_written(entry, first))
+        {
+          i = first + 1;
+          continue;
+        }
+
+      /* Then read the following run of unwritten R/W blocks */
+
+      i = first + 1;
+      while (i < dev->blkper && !ftl_cache_written(entry, i))
+        {
+          i++;
+        }
+
+      nxfrd = MTD_BREAD(dev->mtd, rwblock + first, i - first,
+                        entry->buffer + first * dev->geo.blocksize);
+      if (nxfrd != i - first)
+        {
+          ferr("ERROR: Read block %" PRIdOFF " failed: %zd\n",
+               rwblock + first, nxfrd);
+          return -EIO;
+        }
+    }
+
+  entry->loaded = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_cache_writeback
+ *
+ * Description: Write a dirty cached erase block back to FLASH
+ *
+ ****************************************************************************/
+
+static int ftl_cache_writeback(FAR struct ftl_struct_s *dev,
+                               FAR struct ftl_ebcache_s *entry)
+{
+  off_t  rwblock;
+  size_t nxfrd;
+  int    ret;
+
+  if (!entry->dirty)
+    {
+      return OK;
+    }
+
+  ret = ftl_cache_fill(dev, entry);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = MTD_ERASE(dev->mtd, entry->eblock, 1);
+  if (ret < 0)
+    {
+      ferr("ERROR: Erase block=%" PRIdOFF " failed: %d\n",
+           entry->eblock, ret);
+      return ret;
+    }
+
+  finfo("Write back erase block=%" PRIdOFF "\n", entry->eblock);
+
+  rwblock = entry->eblock * dev->blkper;
+  nxfrd   = MTD_BWRITE(dev->mtd, rwblock, dev->blkper, entry->buffer);
+  if (nxfrd != dev->blkper)
+    {
+      ferr("ERROR: Write erase block %" PRIdOFF " failed: %zu\n",
+           rwblock, nxfrd);
+      return -EIO;
+    }
+
+  entry->dirty = false;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_cache_flush
+ *
+ * Description: Write all dirty cached erase blocks back to FLASH
+ *
+ ****************************************************************************/
+
+static int ftl_cache_flush(FAR struct ftl_struct_s *dev)
+{
+  int ret = OK;
+  int err;
+  int i;
+
+  for (i = 0; i < CONFIG_FTL_EBCACHE_NBLOCKS; i++)
+    {
+      err = ftl_cache_writeback(dev, &dev->ebcache[i]);
+      if (err < 0 && ret == OK)
+        {
+          ret = err;
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_cache_timeout
+ *
+ * Description: Delayed write-back of the cache, on the LP work queue
+ *
+ ****************************************************************************/
+
+#ifdef FTL_EBCACHE_TIMEOUT
+static void ftl_cache_timeout(FAR void *arg)
+{
+  FAR struct ftl_struct_s *dev = (FAR struct ftl_struct_s *)arg;
+
+  ftl_lock(dev);
+  ftl_cache_flush(dev);
+  ftl_unlock(dev);
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_cache_get
+ *
+ * Description:
+ *   Return the cache entry of an erase block, evicting the least recently
+ *   used entry if the erase block is not cached.
+ *
+ ****************************************************************************/
+
+static int ftl_cache_get(FAR struct ftl_struct_s *dev, off_t eraseblock,
+                         FAR struct ftl_ebcache_s **entryp)
+{
+  FAR struct ftl_ebcache_s *entry;
+  int ret;
+  int i;
+
+  entry = ftl_cache_find(dev, eraseblock);
+  if (entry == NULL)
+    {
+      /* Prefer an unused entry, else take the least recently used one */
+
+      entry = &dev->ebcache[0];
+      for (i = 1; i < CONFIG_FTL_EBCACHE_NBLOCKS && entry->eblock >= 0; i++)
+        {
+          if (dev->ebcache[i].eblock < 0 ||
+              (int32_t)(dev->ebcache[i].lastuse - entry->lastuse) < 0)
+            {
+              entry = &dev->ebcache[i];
+            }
+        }
+
+      ret = ftl_cache_writeback(dev, entry);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (entry->buffer == NULL)
+        {
+          entry->buffer  = kmm_malloc(dev->geo.erasesize);
+          entry->written = kmm_malloc((dev->blkper + 7) / 8);
+          if (entry->buffer == NULL || entry->written == NULL)
+            {
+              ferr("ERROR: Failed to allocate an erase block buffer\n");
+              kmm_free(entry->buffer);
+              kmm_free(entry->written);
+              entry->buffer  = NULL;
+              entry->written = NULL;
+              entry->eblock  = -1;
+              return -ENOMEM;
+            }
+        }
+
+      memset(entry->written, 0, (dev->blkper + 7) / 8);
+      entry->eblock   = eraseblock;
+      entry->nwritten = 0;
+      entry->loaded   = false;
+    }
+
+  entry->lastuse = ++dev->ebclock;
+  *entryp        = entry;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_cache_write
+ *
+ * Description: Copy R/W blocks into a cached erase block
+ *
+ ****************************************************************************/
+
+static int ftl_cache_write(FAR struct ftl_struct_s *dev, off_t eraseblock,
+                           int offset, int nblocks,
+                           FAR const uint8_t *buffer)
+{
+  FAR struct ftl_ebcache_s *entry;
+  int ret;
+  int i;
+
+  ret = ftl_cache_get(dev, eraseblock, &entry);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  finfo("Cache %d blocks of erase block=%" PRIdOFF " at block=%d\n",
+        nblocks, eraseblock, offset);
+
+  memcpy(entry->buffer + offset * dev->geo.blocksize, buffer,
+         nblocks * dev->geo.blocksize);
+
+  /* Once each R/W block has been written, the erase block no longer needs
+   * to be read from FLASH.
+   */
+
+  if (!entry->loaded)
+    {
+      for (i = offset; i < offset + nblocks; i++)
+        {
+          if (!ftl_cache_written(entry, i))
+            {
+              entry->written[i >> 3] |= 1 << (i & 7);
+              entry->nwritten++;
+            }
+        }
+
+      entry->loaded = entry->nwritten >= dev->blkper;
+    }
+
+  entry->dirty = true;
+
+#ifdef FTL_EBCACHE_TIMEOUT
+  if (work_available(&dev->work))
+    {
+      work_queue(LPWORK, &dev->work, ftl_cache_timeout, dev,
+                 MSEC2TICK(CONFIG_FTL_EBCACHE_FLUSHDELAY));
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_cache_read
+ *
+ * Description: Read R/W blocks of an erase block through the cache
+ *
+ ****************************************************************************/
+
+static int ftl_cache_read(FAR struct ftl_struct_s *dev,
+                          FAR struct ftl_ebcache_s *entry, int offset,
+                          int nblocks, FAR uint8_t *buffer)
+{
+  int ret;
+
+  ret = ftl_cache_fill(dev, entry);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  memcpy(buffer, entry->buffer + offset * dev->geo.blocksize,
+         nblocks * dev->geo.blocksize);
+  entry->lastuse = ++dev->ebclock;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_cache_uninitialize
+ *
+ * Description: Write back and release the erase block cache
+ *
+ ****************************************************************************/
+
+static void ftl_cache_uninitialize(FAR struct ftl_struct_s *dev)
+{
+  int i;
+
+#ifdef FTL_EBCACHE_TIMEOUT
+  work_cancel(LPWORK, &dev->work);
+#endif
+
+  ftl_cache_flush(dev);
+  for (i = 0; i < CONFIG_FTL_EBCACHE_NBLOCKS; i++)
+    {
+      kmm_free(dev->ebcache[i].buffer);
+      kmm_free(dev->ebcache[i].written);
+    }
+
+  nxsem_destroy(&dev->exclsem);
+}
+
+#endif /* CONFIG_FTL_EBCACHE */
+
 /****************************************************************************
  * Name: ftl_open
  *
@@ -156,15 +551,28 @@ static int ftl_close(FAR struct inode *inode)
   rwb_flush(&dev->rwb);
 #endif
 
+#ifdef CONFIG_FTL_EBCACHE
+  if (dev->refs == 1)
+    {
+      ftl_lock(dev);
+      ftl_cache_flush(dev);
+      ftl_unlock(dev);
+    }
+#endif
+
   if (--dev->refs == 0 && dev->unlinked)
     {
 #ifdef FTL_HAVE_RWBUFFER
       rwb_uninitialize(&dev->rwb);
 #endif
+#ifdef CONFIG_FTL_EBCACHE
+      ftl_cache_uninitialize(dev);
+#else
       if (dev->eblock)
         {
           kmm_free(dev->eblock);
         }
+#endif
 
       kmm_free(dev);
     }
@@ -183,6 +591,52 @@ static ssize_t ftl_reload(FAR void *priv, FAR uint8_t *buffer,
                           off_t startblock, size_t nblocks)
 {
   struct ftl_struct_s *dev = (struct ftl_struct_s *)priv;
+#ifdef CONFIG_FTL_EBCACHE
+  FAR struct ftl_ebcache_s *entry;
+  off_t  mask = dev->blkper - 1;
+  size_t remaining;
+  size_t nread;
+  int    ret;
+
+  /* Cached erase blocks must be read from the cache, the others directly
+   * from FLASH.
+   */
+
+  ftl_lock(dev);
+  for (remaining = nblocks; remaining > 0; remaining -= nread)
+    {
+      nread = dev->blkper - (startblock & mask);
+      if (nread > remaining)
+        {
+          nread = remaining;
+        }
+
+      entry = ftl_cache_find(dev, startblock / dev->blkper);
+      if (entry != NULL)
+        {
+          ret = ftl_cache_read(dev, entry, startblock & mask, nread,
+                               buffer);
+          if (ret < 0)
+            {
+              ftl_unlock(dev);
+              return ret;
+            }
+        }
+      else if (MTD_BREAD(dev->mtd, startblock, nread, buffer) != nread)
+        {
+          ferr("ERROR: Read %zu blocks starting at block %" PRIdOFF
+               " failed\n", nread, startblock);
+          ftl_unlock(dev);
+          return -EIO;
+        }
+
+      startblock += nread;
+      buffer     += nread * dev->geo.blocksize;
+    }
+
+  ftl_unlock(dev);
+  return nblocks;
+#else
   ssize_t nread;
 
   /* Read the full erase block into the buffer */
@@ -195,6 +649,7 @@ static ssize_t ftl_reload(FAR void *priv, FAR uint8_t *buffer,
     }
 
   return nread;
+#endif
 }
 
 /****************************************************************************
@@ -222,12 +677,16 @@ static ssize_t ftl_read(FAR struct inode *inode, unsigned char *buffer,
 }
 
 /****************************************************************************
- * Name: ftl_flush
+ * Name: ftl_write_partial
  *
- * Description: Write the specified number of sectors
+ * Description:
+ *   Write R/W blocks that cover only part of an erase block.  Without the
+ *   erase block cache, the whole erase block is read, erased, modified and
+ *   written back.
  *
  ****************************************************************************/
 
+#ifndef CONFIG_FTL_EBCACHE
 static int ftl_alloc_eblock(FAR struct ftl_struct_s *dev)
 {
   if (dev->eblock == NULL)
@@ -239,6 +698,128 @@ static int ftl_alloc_eblock(FAR struct ftl_struct_s *dev)
 
   return dev->eblock != NULL ? OK : -ENOMEM;
 }
+#endif
+
+static int ftl_write_partial(FAR struct ftl_struct_s *dev, off_t rwblock,
+                             int offset, int nblocks,
+                             FAR const uint8_t *buffer)
+{
+  off_t  eraseblock = rwblock / dev->blkper;
+#ifdef CONFIG_FTL_EBCACHE
+  return ftl_cache_write(dev, eraseblock, offset, nblocks, buffer);
+#else
+  size_t nxfrd;
+  int    nbytes;
+  int    ret;
+
+  ret = ftl_alloc_eblock(dev);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to allocate an erase block buffer\n");
+      return ret;
+    }
+
+  /* Read the full erase block into the buffer */
+
+  nxfrd = MTD_BREAD(dev->mtd, rwblock, dev->blkper, dev->eblock);
+  if (nxfrd != dev->blkper)
+    {
+      ferr("ERROR: Read erase block %" PRIdOFF " failed: %zd\n",
+           rwblock, nxfrd);
+      return -EIO;
+    }
+
+  /* Then erase the erase block */
+
+  ret = MTD_ERASE(dev->mtd, eraseblock, 1);
+  if (ret < 0)
+    {
+      ferr("ERROR: Erase block=%" PRIdOFF "failed: %d\n",
+           eraseblock, ret);
+      return ret;
+    }
+
+  /* Copy the user data into the buffered erase block */
+
+  nbytes = nblocks * dev->geo.blocksize;
+  finfo("Copy %d bytes into erase block=%" PRIdOFF " at offset=%d\n",
+        nbytes, eraseblock, offset * dev->geo.blocksize);
+
+  memcpy(dev->eblock + offset * dev->geo.blocksize, buffer, nbytes);
+
+  /* And write the erase block back to flash */
+
+  nxfrd = MTD_BWRITE(dev->mtd, rwblock, dev->blkper, dev->eblock);
+  if (nxfrd != dev->blkper)
+    {
+      ferr("ERROR: Write erase block %" PRIdOFF " failed: %zu\n",
+           rwblock, nxfrd);
+      return -EIO;
+    }
+
+  return OK;
+#endif
+}
+
+/****************************************************************************
+ * Name: ftl_write_eblock
+ *
+ * Description: Erase an erase block and overwrite it completely
+ *
+ ****************************************************************************/
+
+static int ftl_write_eblock(FAR struct ftl_struct_s *dev, off_t rwblock,
+                            FAR const uint8_t *buffer)
+{
+  off_t  eraseblock = rwblock / dev->blkper;
+  size_t nxfrd;
+  int    ret;
+
+#ifdef CONFIG_FTL_EBCACHE
+  FAR struct ftl_ebcache_s *entry;
+
+  /* Any cached copy is superseded and must not be written back */
+
+  entry = ftl_cache_find(dev, eraseblock);
+  if (entry != NULL)
+    {
+      entry->eblock = -1;
+      entry->dirty  = false;
+    }
+#endif
+
+  /* Erase the erase block */
+
+  ret = MTD_ERASE(dev->mtd, eraseblock, 1);
+  if (ret < 0)
+    {
+      ferr("ERROR: Erase block=%" PRIdOFF " failed: %d\n",
+           eraseblock, ret);
+      return ret;
+    }
+
+  /* Write a full erase back to flash */
+
+  finfo("Write %" PRId32 " bytes into erase block=%" PRIdOFF
+        " at offset=0\n", dev->geo.erasesize, rwblock);
+
+  nxfrd = MTD_BWRITE(dev->mtd, rwblock, dev->blkper, buffer);
+  if (nxfrd != dev->blkper)
+    {
+      ferr("ERROR: Write erase block %" PRIdOFF " failed: %zu\n",
+           rwblock, nxfrd);
+      return -EIO;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_flush
+ *
+ * Description: Write the specified number of sectors
+ *
+ ****************************************************************************/
 
 static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
                          off_t startblock, size_t nblocks)
@@ -246,13 +827,9 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
   struct ftl_struct_s *dev = (struct ftl_struct_s *)priv;
   off_t  alignedblock;
   off_t  mask;
-  off_t  rwblock;
-  off_t  eraseblock;
-  off_t  offset;
   size_t remaining;
   size_t nxfrd;
-  int    nbytes;
-  int    ret;
+  int    ret = OK;
 
   /* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
    * per erase block is a power of 2, and (2) the erase begins with that same
@@ -262,6 +839,8 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
   mask         = dev->blkper - 1;
   alignedblock = (startblock + mask) & ~mask;
 
+  ftl_lock(dev);
+
   /* Handle partial erase blocks before the first unaligned block */
 
   remaining = nblocks;
@@ -269,105 +848,33 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
     {
       /* Check if the write is shorter than to the end of the erase block */
 
-      bool short_write = (remaining < (alignedblock - startblock));
-
-      ret = ftl_alloc_eblock(dev);
-      if (ret < 0)
-        {
-          ferr("ERROR: Failed to allocate an erase block buffer\n");
-          return ret;
-        }
-
-      /* Read the full erase block into the buffer */
-
-      rwblock = startblock & ~mask;
-      nxfrd   = MTD_BREAD(dev->mtd, rwblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
+      nxfrd = alignedblock - startblock;
+      if (nxfrd > remaining)
         {
-          ferr("ERROR: Read erase block %" PRIdOFF " failed: %zd\n",
-               rwblock, nxfrd);
-          return -EIO;
+          nxfrd = remaining;
         }
 
-      /* Then erase the erase block */
-
-      eraseblock = rwblock / dev->blkper;
-      ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
+      ret = ftl_write_partial(dev, startblock & ~mask, startblock & mask,
+                              nxfrd, buffer);
       if (ret < 0)
         {
-          ferr("ERROR: Erase block=%" PRIdOFF "failed: %d\n",
-               eraseblock, ret);
-          return ret;
-        }
-
-      /* Copy the user data at the end of the buffered erase block */
-
-      offset = (startblock & mask) * dev->geo.blocksize;
-
-      if (short_write)
-        {
-          nbytes = remaining * dev->geo.blocksize;
-        }
-      else
-        {
-          nbytes = dev->geo.erasesize - offset;
-        }
-
-      finfo("Copy %d bytes into erase block=%" PRIdOFF
-            " at offset=%" PRIdOFF "\n", nbytes, eraseblock, offset);
-
-      memcpy(dev->eblock + offset, buffer, nbytes);
-
-      /* And write the erase block back to flash */
-
-      nxfrd = MTD_BWRITE(dev->mtd, rwblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
-        {
-          ferr("ERROR: Write erase block %" PRIdOFF " failed: %zu\n",
-               rwblock, nxfrd);
-          return -EIO;
+          goto errout_with_lock;
         }
 
       /* Then update for amount written */
 
-      if (short_write)
-        {
-          remaining = 0;
-        }
-      else
-        {
-          remaining -= dev->blkper - (startblock & mask);
-        }
-
-      buffer += nbytes;
+      remaining -= nxfrd;
+      buffer    += nxfrd * dev->geo.blocksize;
     }
 
   /* How handle full erase pages in the middle */
 
   while (remaining >= dev->blkper)
     {
-      /* Erase the erase block */
-
-      eraseblock = alignedblock / dev->blkper;
-      ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
+      ret = ftl_write_eblock(dev, alignedblock, buffer);
       if (ret < 0)
         {
-          ferr("ERROR: Erase block=%" PRIdOFF " failed: %d\n",
-               eraseblock, ret);
-          return ret;
-        }
-
-      /* Write a full erase back to flash */
-
-      finfo("Write %" PRId32 " bytes into erase block=%" PRIdOFF
-            " at offset=0\n", dev->geo.erasesize, alignedblock);
-
-      nxfrd = MTD_BWRITE(dev->mtd, alignedblock, dev->blkper, buffer);
-      if (nxfrd != dev->blkper)
-        {
-          ferr("ERROR: Write erase block %" PRIdOFF " failed: %zu\n",
-               alignedblock, nxfrd);
-          return -EIO;
+          goto errout_with_lock;
         }
 
       /* Then update for amount written */
@@ -381,53 +888,12 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
 
   if (remaining > 0)
     {
-      ret = ftl_alloc_eblock(dev);
-      if (ret < 0)
-        {
-          ferr("ERROR: Failed to allocate an erase block buffer\n");
-          return ret;
-        }
-
-      /* Read the full erase block into the buffer */
-
-      nxfrd = MTD_BREAD(dev->mtd, alignedblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
-        {
-          ferr("ERROR: Read erase block %" PRIdOFF " failed: %zu\n",
-               alignedblock, nxfrd);
-          return -EIO;
-        }
-
-      /* Then erase the erase block */
-
-      eraseblock = alignedblock / dev->blkper;
-      ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
-      if (ret < 0)
-        {
-          ferr("ERROR: Erase block=%" PRIdOFF "failed: %d\n",
-               eraseblock, ret);
-          return ret;
-        }
-
-      /* Copy the user data at the beginning the buffered erase block */
-
-      nbytes = remaining * dev->geo.blocksize;
-      finfo("Copy %d bytes into erase block=%" PRIdOFF " at offset=0\n",
-             nbytes, alignedblock);
-      memcpy(dev->eblock, buffer, nbytes);
-
-      /* And write the erase back to flash */
-
-      nxfrd = MTD_BWRITE(dev->mtd, alignedblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
-        {
-          ferr("ERROR: Write erase block %" PRIdOFF " failed: %zu\n",
-               alignedblock, nxfrd);
-          return -EIO;
-        }
+      ret = ftl_write_partial(dev, alignedblock, 0, remaining, buffer);
     }
 
-  return nblocks;
+errout_with_lock:
+  ftl_unlock(dev);
+  return ret < 0 ? ret : nblocks;
 }
 
 /****************************************************************************
@@ -510,6 +976,15 @@ static int ftl_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
     {
 #ifdef CONFIG_FTL_WRITEBUFFER
       rwb_flush(&dev->rwb);
+#endif
+#ifdef CONFIG_FTL_EBCACHE
+      ftl_lock(dev);
+      ret = ftl_cache_flush(dev);
+      ftl_unlock(dev);
+      if (ret < 0)
+        {
+          return ret;
+        }
 #endif
     }
 
@@ -548,10 +1023,14 @@ static int ftl_unlink(FAR struct inode *inode)
 #ifdef FTL_HAVE_RWBUFFER
       rwb_uninitialize(&dev->rwb);
 #endif
+#ifdef CONFIG_FTL_EBCACHE
+      ftl_cache_uninitialize(dev);
+#else
       if (dev->eblock)
         {
           kmm_free(dev->eblock);
         }
+#endif
 
       kmm_free(dev);
     }
@@ -579,6 +1058,9 @@ static int ftl_unlink(FAR struct inode *inode)
 int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
 {
   struct ftl_struct_s *dev;
+#ifdef CONFIG_FTL_EBCACHE
+  int i;
+#endif
   int ret = -ENOMEM;
 
   /* Sanity check */
@@ -599,6 +1081,14 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
 
       dev->mtd = mtd;
 
+#ifdef CONFIG_FTL_EBCACHE
+      nxsem_init(&dev->exclsem, 0, 1);
+      for (i = 0; i < CONFIG_FTL_EBCACHE_NBLOCKS; i++)
+        {
+          dev->ebcache[i].eblock = -1;
+        }
+#endif
+
       /* Get the device geometry. (casting to uintptr_t first eliminates
        * complaints on some architectures where the sizeof long is different
        * from the size of a pointer).
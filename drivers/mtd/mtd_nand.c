@@ -55,6 +55,7 @@
 #include <nuttx/mtd/nand_scheme.h>
 #include <nuttx/mtd/nand_model.h>
 #include <nuttx/mtd/nand_ecc.h>
+#include <nuttx/mtd/nand_bch.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -100,6 +101,12 @@ static int      nand_readpage(FAR struct nand_dev_s *nand, off_t block,
                   unsigned int page, FAR uint8_t *data);
 static int      nand_writepage(FAR struct nand_dev_s *nand, off_t block,
                   unsigned int page, FAR const void *data);
+static int      nand_readpages(FAR struct nand_dev_s *nand, off_t block,
+                  unsigned int page, unsigned int npages,
+                  FAR uint8_t *data);
+static int      nand_writepages(FAR struct nand_dev_s *nand, off_t block,
+                  unsigned int page, unsigned int npages,
+                  FAR const uint8_t *data);
 
 /* MTD driver methods */
 
@@ -529,6 +536,127 @@ static int nand_writepage(FAR struct nand_dev_s *nand, off_t block,
     }
 }
 
+/****************************************************************************
+ * Name: nand_readpages
+ *
+ * Description:
+ *   Reads the data area of several consecutive pages of one block.  The
+ *   multi-page method of the lower half is used if there is one and the
+ *   ECC is not computed in software, since software ECC needs the spare
+ *   area of each page.
+ *
+ * Input Parameters:
+ *   nand   - Upper-half, NAND FLASH interface
+ *   block  - Number of the block where the pages to read reside.
+ *   page   - Number of the first page to read inside the given block.
+ *   npages - Number of pages to read, all inside the given block.
+ *   data   - Buffer where the data areas will be stored.
+ *
+ * Returned Value:
+ *   OK is returned in success; a negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+static int nand_readpages(FAR struct nand_dev_s *nand, off_t block,
+                          unsigned int page, unsigned int npages,
+                          FAR uint8_t *data)
+{
+  FAR struct nand_raw_s *raw = nand->raw;
+  uint16_t pagesize = nandmodel_getpagesize(&raw->model);
+  int ret;
+
+#ifdef CONFIG_MTD_NAND_MULTIPAGE
+  if (npages > 1 && raw->readpages != NULL &&
+      raw->ecctype != NANDECC_SWECC)
+    {
+#ifdef CONFIG_MTD_NAND_BLOCKCHECK
+      /* Check that the block is not BAD, once for all pages */
+
+      if (nand_checkblock(nand, block) != GOODBLOCK)
+        {
+          ferr("ERROR: Block is BAD\n");
+          return -EAGAIN;
+        }
+#endif
+
+      return NAND_READPAGES(raw, block, page, npages, data);
+    }
+#endif
+
+  for (; npages > 0; npages--)
+    {
+      ret = nand_readpage(nand, block, page++, data);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      data += pagesize;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nand_writepages
+ *
+ * Description:
+ *   Writes the data area of several consecutive pages of one block, using
+ *   the multi-page method of the lower half under the same conditions as
+ *   nand_readpages().
+ *
+ * Input Parameters:
+ *   nand   - Upper-half, NAND FLASH interface
+ *   block  - Number of the block where the pages to write reside.
+ *   page   - Number of the first page to write inside the given block.
+ *   npages - Number of pages to write, all inside the given block.
+ *   data   - Buffer containing the data to be written.
+ *
+ * Returned Value:
+ *   OK is returned in success; a negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+static int nand_writepages(FAR struct nand_dev_s *nand, off_t block,
+                           unsigned int page, unsigned int npages,
+                           FAR const uint8_t *data)
+{
+  FAR struct nand_raw_s *raw = nand->raw;
+  uint16_t pagesize = nandmodel_getpagesize(&raw->model);
+  int ret;
+
+#ifdef CONFIG_MTD_NAND_MULTIPAGE
+  if (npages > 1 && raw->writepages != NULL &&
+      raw->ecctype != NANDECC_SWECC)
+    {
+#ifdef CONFIG_MTD_NAND_BLOCKCHECK
+      /* Check that the block is good, once for all pages */
+
+      if (nand_checkblock(nand, block) != GOODBLOCK)
+        {
+          ferr("ERROR: Block is BAD\n");
+          return -EAGAIN;
+        }
+#endif
+
+      return NAND_WRITEPAGES(raw, block, page, npages, data);
+    }
+#endif
+
+  for (; npages > 0; npages--)
+    {
+      ret = nand_writepage(nand, block, page++, data);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      data += pagesize;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: nand_erase
  *
@@ -585,6 +713,7 @@ static ssize_t nand_bread(struct mtd_dev_s *dev, off_t startpage,
   FAR struct nand_model_s *model;
   unsigned int pagesperblock;
   unsigned int page;
+  unsigned int count;
   uint16_t pagesize;
   size_t remaining;
   off_t maxblock;
@@ -616,9 +745,9 @@ static ssize_t nand_bread(struct mtd_dev_s *dev, off_t startpage,
 
   nand_lock(nand);
 
-  /* Then read every page from NAND */
+  /* Then read every page from NAND, one block at a time */
 
-  for (remaining = npages; remaining > 0; remaining--)
+  for (remaining = npages; remaining > 0; remaining -= count)
     {
       /* Check for attempt to read beyond the end of NAND */
 
@@ -631,30 +760,27 @@ static ssize_t nand_bread(struct mtd_dev_s *dev, off_t startpage,
           goto errout_with_lock;
         }
 
-      /* Read the next page from NAND */
+      /* Read the next pages of this block from NAND */
 
-      ret = nand_readpage(nand, block, page, buffer);
-      if (ret < 0)
+      count = pagesperblock - page;
+      if (count > remaining)
         {
-          ferr("ERROR: nand_readpage failed block=%ld page=%d: %d\n",
-               (long)block, page, ret);
-          goto errout_with_lock;
+          count = remaining;
         }
 
-      /* Increment the page number.  If we exceed the number of
-       * pages per block, then reset the page number and bump up
-       * the block number.
-       */
-
-      if (++page >= pagesperblock)
+      ret = nand_readpages(nand, block, page, count, buffer);
+      if (ret < 0)
         {
-          page = 0;
-          block++;
+          ferr("ERROR: nand_readpages failed block=%ld page=%d: %d\n",
+               (long)block, page, ret);
+          goto errout_with_lock;
         }
 
-      /* Increment the buffer point by the size of one page */
+      /* Continue with the first page of the next block */
 
-      buffer += pagesize;
+      page    = 0;
+      block++;
+      buffer += count * pagesize;
     }
 
   nand_unlock(nand);
@@ -681,6 +807,7 @@ static ssize_t nand_bwrite(struct mtd_dev_s *dev, off_t startpage,
   FAR struct nand_model_s *model;
   unsigned int pagesperblock;
   unsigned int page;
+  unsigned int count;
   uint16_t pagesize;
   size_t remaining;
   off_t maxblock;
@@ -712,9 +839,9 @@ static ssize_t nand_bwrite(struct mtd_dev_s *dev, off_t startpage,
 
   nand_lock(nand);
 
-  /* Then write every page into NAND */
+  /* Then write every page into NAND, one block at a time */
 
-  for (remaining = npages; remaining > 0; remaining--)
+  for (remaining = npages; remaining > 0; remaining -= count)
     {
       /* Check for attempt to write beyond the end of NAND */
 
@@ -727,30 +854,27 @@ static ssize_t nand_bwrite(struct mtd_dev_s *dev, off_t startpage,
           goto errout_with_lock;
         }
 
-      /* Write the next page into NAND */
+      /* Write the next pages of this block into NAND */
 
-      ret = nand_writepage(nand, block, page, buffer);
-      if (ret < 0)
+      count = pagesperblock - page;
+      if (count > remaining)
         {
-          ferr("ERROR: nand_writepage failed block=%ld page=%d: %d\n",
-               (long)block, page, ret);
-          goto errout_with_lock;
+          count = remaining;
         }
 
-      /* Increment the page number.  If we exceed the number of
-       * pages per block, then reset the page number and bump up
-       * the block number.
-       */
-
-      if (++page >= pagesperblock)
+      ret = nand_writepages(nand, block, page, count, buffer);
+      if (ret < 0)
         {
-          page = 0;
-          block++;
+          ferr("ERROR: nand_writepages failed block=%ld page=%d: %d\n",
+               (long)block, page, ret);
+          goto errout_with_lock;
         }
 
-      /* Increment the buffer point by the size of one page */
+      /* Continue with the first page of the next block */
 
-      buffer += pagesize;
+      page    = 0;
+      block++;
+      buffer += count * pagesize;
     }
 
   nand_unlock(nand);
@@ -969,6 +1093,12 @@ FAR struct mtd_dev_s *nand_initialize(FAR struct nand_raw_s *raw)
 
   nxsem_init(&nand->exclsem, 0, 1);
 
+#ifdef CONFIG_MTD_NAND_SWECC_BCH
+  /* Build the BCH tables used by software ECC */
+
+  nandbch_initialize();
+#endif
+
 #if defined(CONFIG_MTD_NAND_BLOCKCHECK) && defined(CONFIG_DEBUG_INFO) && \
     defined(CONFIG_DEBUG_FS)
 
@@ -0,0 +1,591 @@
+/****************************************************************************
+ * drivers/mtd/mtd_nandbch.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mtd/nand_bch.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* GF(2^13) generated by x^13 + x^4 + x^3 + x + 1 */
+
+#define GF_M              13
+#define GF_N              ((1 << GF_M) - 1)
+#define GF_POLY           0x201b
+
+/* Code parameters.  The remainder register holds NANDBCH_ECCBITS bits left
+ * aligned in BCH_NWORDS 32-bit words.
+ */
+
+#define BCH_T             CONFIG_MTD_NAND_BCH_STRENGTH
+#define BCH_R             NANDBCH_ECCBITS
+#define BCH_K             (8 * NANDBCH_STEPSIZE)
+#define BCH_NWORDS        ((BCH_R + 31) / 32)
+
+#if BCH_T < 1 || BCH_R + BCH_K > GF_N
+#  error Unsupported CONFIG_MTD_NAND_BCH_STRENGTH
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The generator polynomial without its x^R term, left aligned */
+
+static uint32_t g_bch_genpoly[BCH_NWORDS];
+
+/* Remainder of each possible leading byte, used by the byte-wise encoder */
+
+static uint32_t g_bch_table[256][BCH_NWORDS];
+
+/* Inverted code of an erased step.  Folding this into every code makes
+ * erased pages verify without errors.
+ */
+
+static uint32_t g_bch_erased[BCH_NWORDS];
+
+static bool g_bch_initialized;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gf_mul
+ *
+ * Description:
+ *   Multiply two elements of GF(2^13).
+ *
+ ****************************************************************************/
+
+static uint16_t gf_mul(uint16_t a, uint16_t b)
+{
+  uint16_t result = 0;
+
+  while (b != 0)
+    {
+      if ((b & 1) != 0)
+        {
+          result ^= a;
+        }
+
+      b >>= 1;
+      a <<= 1;
+      if ((a & (1 << GF_M)) != 0)
+        {
+          a ^= GF_POLY;
+        }
+    }
+
+  return result;
+}
+
+/****************************************************************************
+ * Name: gf_pow
+ *
+ * Description:
+ *   Raise an element of GF(2^13) to a non-negative power.
+ *
+ ****************************************************************************/
+
+static uint16_t gf_pow(uint16_t a, unsigned int e)
+{
+  uint16_t result = 1;
+
+  e %= GF_N;
+  while (e != 0)
+    {
+      if ((e & 1) != 0)
+        {
+          result = gf_mul(result, a);
+        }
+
+      a = gf_mul(a, a);
+      e >>= 1;
+    }
+
+  return result;
+}
+
+/****************************************************************************
+ * Name: bch_shift1 and bch_shift8
+ *
+ * Description:
+ *   Shift a remainder register left by one or eight bits.
+ *
+ ****************************************************************************/
+
+static void bch_shift1(FAR uint32_t *reg)
+{
+  int i;
+
+  for (i = 0; i < BCH_NWORDS - 1; i++)
+    {
+      reg[i] = (reg[i] << 1) | (reg[i + 1] >> 31);
+    }
+
+  reg[i] <<= 1;
+}
+
+static void bch_shift8(FAR uint32_t *reg)
+{
+  int i;
+
+  for (i = 0; i < BCH_NWORDS - 1; i++)
+    {
+      reg[i] = (reg[i] << 8) | (reg[i + 1] >> 24);
+    }
+
+  reg[i] <<= 8;
+}
+
+/****************************************************************************
+ * Name: bch_encode
+ *
+ * Description:
+ *   Compute the remainder of one 512 byte step times x^R divided by the
+ *   generator polynomial.
+ *
+ ****************************************************************************/
+
+static void bch_encode(FAR const uint8_t *data, FAR uint32_t *reg)
+{
+  FAR const uint32_t *entry;
+  int i;
+  int j;
+
+  memset(reg, 0, BCH_NWORDS * sizeof(uint32_t));
+  for (i = 0; i < NANDBCH_STEPSIZE; i++)
+    {
+      entry = g_bch_table[(reg[0] >> 24) ^ data[i]];
+      bch_shift8(reg);
+
+      for (j = 0; j < BCH_NWORDS; j++)
+        {
+          reg[j] ^= entry[j];
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: bch_correct
+ *
+ * Description:
+ *   Locate and flip the erroneous data bits of one step given the remainder
+ *   of the received code word.
+ *
+ * Returned Value:
+ *   The number of corrected bits, or -EBADMSG if not correctable.
+ *
+ ****************************************************************************/
+
+static int bch_correct(FAR uint8_t *data, FAR const uint32_t *rem)
+{
+  uint16_t syn[2 * BCH_T + 1];
+  uint16_t lambda[2 * BCH_T + 1];
+  uint16_t prev[2 * BCH_T + 1];
+  uint16_t tmp[2 * BCH_T + 1];
+  uint16_t alpha[BCH_T + 1];
+  uint16_t aj;
+  uint16_t prevd = 1;
+  unsigned int shift = 1;
+  int nfound = 0;
+  int nerr = 0;
+  int i;
+  int j;
+  int n;
+
+  /* Syndromes S(j) = rem(alpha^j), j = 1 .. 2T.  The remainder is
+   * evaluated from its highest degree term downwards.
+   */
+
+  for (j = 1; j <= 2 * BCH_T; j++)
+    {
+      if ((j & 1) == 0)
+        {
+          syn[j] = gf_mul(syn[j / 2], syn[j / 2]);
+          continue;
+        }
+
+      aj     = gf_pow(2, j);
+      syn[j] = 0;
+      for (i = 0; i < BCH_R; i++)
+        {
+          syn[j] = gf_mul(syn[j], aj) ^
+                   ((rem[i / 32] >> (31 - i % 32)) & 1);
+        }
+    }
+
+  /* Berlekamp-Massey: find the error locator polynomial lambda(x) */
+
+  memset(lambda, 0, sizeof(lambda));
+  memset(prev, 0, sizeof(prev));
+  lambda[0] = 1;
+  prev[0]   = 1;
+
+  for (n = 0; n < 2 * BCH_T; n++)
+    {
+      uint16_t d = syn[n + 1];
+      uint16_t coef;
+
+      for (i = 1; i <= nerr; i++)
+        {
+          d ^= gf_mul(lambda[i], syn[n + 1 - i]);
+        }
+
+      if (d == 0)
+        {
+          shift++;
+          continue;
+        }
+
+      memcpy(tmp, lambda, sizeof(lambda));
+      coef = gf_mul(d, gf_pow(prevd, GF_N - 1));
+      for (i = 0; i + shift <= 2 * BCH_T; i++)
+        {
+          lambda[i + shift] ^= gf_mul(coef, prev[i]);
+        }
+
+      if (2 * nerr <= n)
+        {
+          nerr  = n + 1 - nerr;
+          prevd = d;
+          shift = 1;
+          memcpy(prev, tmp, sizeof(prev));
+        }
+      else
+        {
+          shift++;
+        }
+    }
+
+  if (nerr > BCH_T)
+    {
+      return -EBADMSG;
+    }
+
+  /* Chien search: position p is in error if lambda(alpha^-p) == 0.  The
+   * terms lambda(i) * alpha^(-p * i) are updated incrementally.
+   */
+
+  for (i = 1; i <= nerr; i++)
+    {
+      alpha[i] = gf_pow(2, GF_N - i);
+    }
+
+  for (n = 0; n < BCH_R + BCH_K && nfound < nerr; n++)
+    {
+      uint16_t sum = lambda[0];
+
+      for (i = 1; i <= nerr; i++)
+        {
+          sum ^= lambda[i];
+          lambda[i] = gf_mul(lambda[i], alpha[i]);
+        }
+
+      if (sum != 0)
+        {
+          continue;
+        }
+
+      nfound++;
+
+      /* Errors in the code itself need no correction.  Data bit 7 of the
+       * first byte holds the highest degree of the code word.
+       */
+
+      if (n >= BCH_R)
+        {
+          unsigned int bit = BCH_R + BCH_K - 1 - n;
+
+          data[bit / 8] ^= 0x80 >> (bit % 8);
+        }
+    }
+
+  return nfound == nerr ? nerr : -EBADMSG;
+}
+
+/****************************************************************************
+ * Name: bch_store and bch_load
+ *
+ * Description:
+ *   Convert between a remainder register and its NANDBCH_ECCBYTES wide,
+ *   most significant byte first representation.
+ *
+ ****************************************************************************/
+
+static void bch_store(FAR const uint32_t *reg, FAR uint8_t *code)
+{
+  int i;
+
+  for (i = 0; i < NANDBCH_ECCBYTES; i++)
+    {
+      code[i] = (reg[i / 4] ^ g_bch_erased[i / 4]) >> (24 - 8 * (i % 4));
+    }
+}
+
+static void bch_load(FAR const uint8_t *code, FAR uint32_t *reg)
+{
+  int i;
+
+  memset(reg, 0, BCH_NWORDS * sizeof(uint32_t));
+  for (i = 0; i < NANDBCH_ECCBYTES; i++)
+    {
+      reg[i / 4] |= (uint32_t)code[i] << (24 - 8 * (i % 4));
+    }
+
+  for (i = 0; i < BCH_NWORDS; i++)
+    {
+      reg[i] ^= g_bch_erased[i];
+    }
+
+  /* Drop the padding bits after the last code bit */
+
+  if ((BCH_R % 32) != 0)
+    {
+      reg[BCH_NWORDS - 1] &= ~(UINT32_MAX >> (BCH_R % 32));
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nandbch_initialize
+ *
+ * Description:
+ *   Build the generator polynomial and the encoder lookup table.  This must
+ *   be called once before any other BCH function; later calls do nothing.
+ *
+ ****************************************************************************/
+
+void nandbch_initialize(void)
+{
+  uint16_t genpoly[BCH_R + 1];
+  uint8_t erased[NANDBCH_STEPSIZE];
+  uint32_t reg[BCH_NWORDS];
+  int degree = 0;
+  int i;
+  int j;
+  int k;
+
+  if (g_bch_initialized)
+    {
+      return;
+    }
+
+  /* The generator polynomial is the product of the minimal polynomials of
+   * alpha^1, alpha^3, ... alpha^(2T - 1), that is of (x + alpha^e) for all
+   * e in the cyclotomic cosets of these exponents.
+   */
+
+  memset(genpoly, 0, sizeof(genpoly));
+  genpoly[0] = 1;
+
+  for (i = 1; i < 2 * BCH_T; i += 2)
+    {
+      int e = i;
+
+      /* Skip exponents already part of a previous coset */
+
+      do
+        {
+          e = (2 * e) % GF_N;
+        }
+      while (e != i && e > i);
+
+      if (e != i)
+        {
+          continue;
+        }
+
+      do
+        {
+          uint16_t root = gf_pow(2, e);
+
+          DEBUGASSERT(degree < BCH_R);
+          degree++;
+          for (k = degree; k > 0; k--)
+            {
+              genpoly[k] = genpoly[k - 1] ^ gf_mul(root, genpoly[k]);
+            }
+
+          genpoly[0] = gf_mul(root, genpoly[0]);
+          e = (2 * e) % GF_N;
+        }
+      while (e != i);
+    }
+
+  DEBUGASSERT(degree == BCH_R);
+
+  /* Keep the binary coefficients below x^R, left aligned */
+
+  memset(g_bch_genpoly, 0, sizeof(g_bch_genpoly));
+  for (k = 0; k < BCH_R; k++)
+    {
+      DEBUGASSERT(genpoly[k] <= 1);
+      if (genpoly[k] != 0)
+        {
+          j = BCH_R - 1 - k;
+          g_bch_genpoly[j / 32] |= (uint32_t)1 << (31 - j % 32);
+        }
+    }
+
+  /* Remainder of every leading byte shifted through the register */
+
+  for (i = 0; i < 256; i++)
+    {
+      memset(reg, 0, sizeof(reg));
+      reg[0] = (uint32_t)i << 24;
+
+      for (k = 0; k < 8; k++)
+        {
+          bool msb = (reg[0] & 0x80000000) != 0;
+
+          bch_shift1(reg);
+          if (msb)
+            {
+              for (j = 0; j < BCH_NWORDS; j++)
+                {
+                  reg[j] ^= g_bch_genpoly[j];
+                }
+            }
+        }
+
+      memcpy(g_bch_table[i], reg, sizeof(reg));
+    }
+
+  /* Code of an erased step, inverted */
+
+  memset(erased, 0xff, sizeof(erased));
+  bch_encode(erased, reg);
+
+  for (j = 0; j < BCH_NWORDS; j++)
+    {
+      g_bch_erased[j] = ~reg[j];
+    }
+
+  if ((BCH_R % 32) != 0)
+    {
+      g_bch_erased[BCH_NWORDS - 1] &= ~(UINT32_MAX >> (BCH_R % 32));
+    }
+
+  g_bch_initialized = true;
+}
+
+/****************************************************************************
+ * Name: nandbch_compute512x
+ *
+ * Description:
+ *   Computes NANDBCH_ECCBYTES of BCH code for each 512 byte step of a data
+ *   block whose size is a multiple of 512 bytes.
+ *
+ ****************************************************************************/
+
+void nandbch_compute512x(FAR const uint8_t *data, size_t size,
+                         FAR uint8_t *code)
+{
+  uint32_t reg[BCH_NWORDS];
+
+  DEBUGASSERT(g_bch_initialized && (size % NANDBCH_STEPSIZE) == 0);
+
+  while (size > 0)
+    {
+      bch_encode(data, reg);
+      bch_store(reg, code);
+
+      data += NANDBCH_STEPSIZE;
+      code += NANDBCH_ECCBYTES;
+      size -= NANDBCH_STEPSIZE;
+    }
+}
+
+/****************************************************************************
+ * Name: nandbch_verify512x
+ *
+ * Description:
+ *   Verifies and, where possible, corrects in place a data block whose size
+ *   is a multiple of 512 bytes.
+ *
+ ****************************************************************************/
+
+int nandbch_verify512x(FAR uint8_t *data, size_t size,
+                       FAR const uint8_t *code)
+{
+  uint32_t computed[BCH_NWORDS];
+  uint32_t stored[BCH_NWORDS];
+  bool error;
+  int ncorrected = 0;
+  int ret;
+  int i;
+
+  DEBUGASSERT(g_bch_initialized && (size % NANDBCH_STEPSIZE) == 0);
+
+  while (size > 0)
+    {
+      bch_encode(data, computed);
+      bch_load(code, stored);
+
+      /* The remainder of the received code word is the difference of
+       * both codes.  Zero means that no error was detected.
+       */
+
+      error = false;
+      for (i = 0; i < BCH_NWORDS; i++)
+        {
+          computed[i] ^= stored[i];
+          error |= computed[i] != 0;
+        }
+
+      if (error)
+        {
+          ret = bch_correct(data, computed);
+          if (ret < 0)
+            {
+              ferr("ERROR: Uncorrectable BCH error\n");
+              return ret;
+            }
+
+          finfo("Corrected %d bits\n", ret);
+          ncorrected += ret;
+        }
+
+      data += NANDBCH_STEPSIZE;
+      code += NANDBCH_ECCBYTES;
+      size -= NANDBCH_STEPSIZE;
+    }
+
+  return ncorrected;
+}
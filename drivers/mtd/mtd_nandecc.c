@@ -48,6 +48,7 @@
 
 #include <nuttx/mtd/nand.h>
 #include <nuttx/mtd/hamming.h>
+#include <nuttx/mtd/nand_bch.h>
 #include <nuttx/mtd/nand_scheme.h>
 #include <nuttx/mtd/nand_ecc.h>
 
@@ -55,6 +56,16 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* With BCH, the codes of all 512 byte steps of a page are stored together
+ * at the end of the spare area.  The first two spare bytes hold the bad
+ * block marker and are never used.
+ */
+
+#ifdef CONFIG_MTD_NAND_SWECC_BCH
+#  define NANDBCH_ECCLEN(p)   (((p) / NANDBCH_STEPSIZE) * NANDBCH_ECCBYTES)
+#  define NANDBCH_FITS(p,s)   (NANDBCH_ECCLEN(p) + 2 <= (s))
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -85,7 +96,9 @@ int nandecc_readpage(FAR struct nand_dev_s *nand, off_t block,
 {
   FAR struct nand_raw_s *raw;
   FAR struct nand_model_s *model;
+#ifndef CONFIG_MTD_NAND_SWECC_BCH
   FAR const struct nand_scheme_s *scheme;
+#endif
   unsigned int pagesize;
   unsigned int sparesize;
   int ret;
@@ -107,6 +120,14 @@ int nandecc_readpage(FAR struct nand_dev_s *nand, off_t block,
   pagesize  = nandmodel_getpagesize(model);
   sparesize = nandmodel_getsparesize(model);
 
+#ifdef CONFIG_MTD_NAND_SWECC_BCH
+  if (!NANDBCH_FITS(pagesize, sparesize))
+    {
+      ferr("ERROR: BCH code does not fit in spare area\n");
+      return -ENOSPC;
+    }
+#endif
+
   /* Store code in spare buffer, either the buffer provided by the caller or
    * the scratch buffer in the raw NAND structure.
    */
@@ -135,6 +156,18 @@ int nandecc_readpage(FAR struct nand_dev_s *nand, off_t block,
       return ret;
     }
 
+#ifdef CONFIG_MTD_NAND_SWECC_BCH
+  /* Verify and correct the data against the codes at the end of spare */
+
+  ret = nandbch_verify512x(data, pagesize, (FAR uint8_t *)spare +
+                           sparesize - NANDBCH_ECCLEN(pagesize));
+  if (ret < 0)
+    {
+      ferr("ERROR: Block=%d page=%d Unrecoverable error: %d\n",
+           block, page, ret);
+      return -EIO;
+    }
+#else
   /* Retrieve ECC information from page */
 
   scheme = nandmodel_getscheme(model);
@@ -149,6 +182,7 @@ int nandecc_readpage(FAR struct nand_dev_s *nand, off_t block,
            block, page, ret);
       return -EIO;
     }
+#endif
 
   return OK;
 }
@@ -181,7 +215,9 @@ int nandecc_writepage(FAR struct nand_dev_s *nand, off_t block,
 {
   FAR struct nand_raw_s *raw;
   FAR struct nand_model_s *model;
+#ifndef CONFIG_MTD_NAND_SWECC_BCH
   FAR const struct nand_scheme_s *scheme;
+#endif
   unsigned int pagesize;
   unsigned int sparesize;
   int ret;
@@ -203,6 +239,33 @@ int nandecc_writepage(FAR struct nand_dev_s *nand, off_t block,
   pagesize  = nandmodel_getpagesize(model);
   sparesize = nandmodel_getsparesize(model);
 
+#ifdef CONFIG_MTD_NAND_SWECC_BCH
+  if (!NANDBCH_FITS(pagesize, sparesize))
+    {
+      ferr("ERROR: BCH code does not fit in spare area\n");
+      return -ENOSPC;
+    }
+
+  /* Store code in spare buffer, either the buffer provided by the caller or
+   * the scratch buffer in the raw NAND structure.
+   */
+
+  if (!spare)
+    {
+      spare = raw->spare;
+      memset(spare, 0xff, sparesize);
+    }
+
+  /* Compute the BCH codes on the new data, if provided.  Otherwise the
+   * code bytes of the spare are written unchanged.
+   */
+
+  if (data)
+    {
+      nandbch_compute512x(data, pagesize, (FAR uint8_t *)spare +
+                          sparesize - NANDBCH_ECCLEN(pagesize));
+    }
+#else
   /* Set hamming code set to 0xffff.. to keep existing bytes */
 
   memset(raw->ecc, 0xff, CONFIG_MTD_NAND_MAXSPAREECCBYTES);
@@ -230,6 +293,7 @@ int nandecc_writepage(FAR struct nand_dev_s *nand, off_t block,
 
   scheme = nandmodel_getscheme(model);
   nandscheme_writeecc(scheme, spare, raw->ecc);
+#endif
 
   /* Perform page write operation */
 
@@ -316,7 +316,7 @@ static int mtd_ioctl(FAR struct mtd_dev_s *dev, int cmd, unsigned long arg)
           /* Erase the entire device */
 
           ret = priv->dev->ioctl(priv->dev, MTDIOC_BULKERASE, 0);
-          if (ret >= 0)
+          if (ret < 0)
             {
               ferr("ERROR: Device ioctl failed: %d\n", ret);
               break;
@@ -332,6 +332,31 @@ static int mtd_ioctl(FAR struct mtd_dev_s *dev, int cmd, unsigned long arg)
         }
         break;
 
+      case BIOC_XIPBASE:
+      case BIOC_FLUSH:
+        {
+          /* Memory-mapped reads bypass this layer, so any buffered write
+           * data must reach the media before the lower half is asked for
+           * its base address.
+           */
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+          ret = rwb_flush(&priv->rwb);
+          if (ret < 0)
+            {
+              ferr("ERROR: rwb_flush failed: %d\n", ret);
+              break;
+            }
+#endif
+
+          ret = priv->dev->ioctl(priv->dev, cmd, arg);
+          if (ret == -ENOTTY && cmd == BIOC_FLUSH)
+            {
+              ret = OK;
+            }
+        }
+        break;
+
       default:
         ret = -ENOTTY; /* Bad command */
         break;
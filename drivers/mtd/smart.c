@@ -43,7 +43,10 @@
 #include <crc32.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mtd/mtd.h>
@@ -143,6 +146,20 @@
 #define SMART_WEARFLAGS_FORCE_REORG         0x01
 #define SMART_WEARFLAGS_WRITE_NEEDED        0x02
 
+/* With background garbage collection, the work queue and the block driver
+ * interfaces access the device concurrently and must hold the device
+ * semaphore.  Otherwise the upper file system serializes all accesses.
+ */
+
+#ifdef CONFIG_MTD_SMART_BGCOLLECT
+#  define smart_lock(dev)   nxsem_wait_uninterruptible(&(dev)->exclsem)
+#  define smart_unlock(dev) nxsem_post(&(dev)->exclsem)
+#else
+#  define smart_lock(dev)
+#  define smart_unlock(dev)
+#  define smart_bgcollect_schedule(dev)
+#endif
+
 #define SET_BITMAP(m, n) do { (m)[(n) / 8] |= 1 << ((n) % 8); } while (0)
 #define CLR_BITMAP(m, n) do { (m)[(n) / 8] &= ~(1 << ((n) % 8)); } while (0)
 #define ISSET_BITMAP(m, n) ((m)[(n) / 8] & (1 << ((n) % 8)))
@@ -226,6 +243,12 @@ struct smart_struct_s
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
   uint32_t              unusedsectors;    /* Count of unused sectors (i.e. free when erased) */
   uint32_t              blockerases;      /* Count of unused sectors (i.e. free when erased) */
+  uint32_t              fgcollects;       /* Blocks collected by writers */
+  uint32_t              bgcollects;       /* Blocks collected when idle */
+#endif
+#ifdef CONFIG_MTD_SMART_BGCOLLECT
+  sem_t                 exclsem;          /* Serializes device accesses */
+  struct work_s         bgwork;           /* Background garbage collection */
 #endif
   uint16_t              neraseblocks;     /* Number of erase blocks or sub-sectors */
   uint16_t              lastallocblock;   /* Last  block we allocated a sector from */
@@ -418,6 +441,7 @@ static int     smart_validate_crc(FAR struct smart_struct_s *dev);
 #endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 static int     smart_read_wearstatus(FAR struct smart_struct_s *dev);
+static int     smart_write_wearstatus(FAR struct smart_struct_s *dev);
 static int     smart_relocate_static_data(FAR struct smart_struct_s *dev,
                  uint16_t block);
 #endif
@@ -882,6 +906,7 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer,
                           blkcnt_t start_sector, unsigned int nsectors)
 {
   FAR struct smart_struct_s *dev;
+  ssize_t ret;
 
   finfo("SMART: sector: %" PRIuOFF " nsectors: %u\n",
         start_sector, nsectors);
@@ -892,7 +917,11 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer,
 #else
   dev = (struct smart_struct_s *)inode->i_private;
 #endif
-  return smart_reload(dev, buffer, start_sector, nsectors);
+
+  smart_lock(dev);
+  ret = smart_reload(dev, buffer, start_sector, nsectors);
+  smart_unlock(dev);
+  return ret;
 }
 
 /****************************************************************************
@@ -929,7 +958,7 @@ static ssize_t smart_write(FAR struct inode *inode,
   dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
-  /* I think maybe we need to lock on a mutex here */
+  smart_lock(dev);
 
   /* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
    * per erase block is a power of 2, and (2) the erase begins with that same
@@ -971,8 +1000,7 @@ static ssize_t smart_write(FAR struct inode *inode,
               ferr("ERROR: Erase block=%" PRIdOFF " failed: %d\n",
                    eraseblock, ret);
 
-              /* Unlock the mutex if we add one */
-
+              smart_unlock(dev);
               return ret;
             }
         }
@@ -1002,8 +1030,7 @@ static ssize_t smart_write(FAR struct inode *inode,
           ferr("ERROR: Write block %" PRIdOFF " failed: %zd.\n",
                nextblock, nxfrd);
 
-          /* Unlock the mutex if we add one */
-
+          smart_unlock(dev);
           return -EIO;
         }
 
@@ -1015,6 +1042,7 @@ static ssize_t smart_write(FAR struct inode *inode,
       alignedblock += mtdblkspererase;
     }
 
+  smart_unlock(dev);
   return nsectors;
 }
 
@@ -3987,6 +4015,56 @@ retry:
   return physicalsector;
 }
 
+/****************************************************************************
+ * Name: smart_findcollectblock
+ *
+ * Description:  Find the erase block with the most released sectors that
+ *               is not worn out.  Returns 0xffff if there is none and the
+ *               count of released sectors of the block in releasemax.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_findcollectblock(FAR struct smart_struct_s *dev,
+                                       FAR uint16_t *releasemax)
+{
+  uint16_t collectblock;
+  int x;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+  uint8_t count;
+#endif
+
+  collectblock = 0xffff;
+  *releasemax = 0;
+  for (x = 0; x < dev->neraseblocks; x++)
+    {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+      /* Don't collect blocks that have been worn completely */
+
+      if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
+        {
+          continue;
+        }
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      count = smart_get_count(dev, dev->releasecount, x);
+      if (count > *releasemax)
+        {
+          *releasemax = count;
+          collectblock = x;
+        }
+#else
+      if (dev->releasecount[x] > *releasemax)
+        {
+          *releasemax = dev->releasecount[x];
+          collectblock = x;
+        }
+#endif
+    }
+
+  return collectblock;
+}
+
 /****************************************************************************
  * Name: smart_garbagecollect
  *
@@ -4001,11 +4079,7 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
   uint16_t collectblock;
   uint16_t releasemax;
   bool collect = TRUE;
-  int x;
   int ret;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-  uint8_t count;
-#endif
 
   while (collect)
     {
@@ -4034,39 +4108,7 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
         {
           /* Find the block with the most released sectors */
 
-          collectblock = 0xffff;
-          releasemax = 0;
-          for (x = 0; x < dev->neraseblocks; x++)
-            {
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-              /* Don't collect blocks that have been worn completely */
-
-              if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
-                {
-                  continue;
-                }
-#endif
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-              count = smart_get_count(dev, dev->releasecount, x);
-              if (count > releasemax)
-                {
-                  releasemax = count;
-                  collectblock = x;
-                }
-#else
-              if (dev->releasecount[x] > releasemax)
-                {
-                  releasemax = dev->releasecount[x];
-                  collectblock = x;
-                }
-#endif
-            }
-
-#if 0
-          releasemax = smart_get_count(dev, dev->releasecount, collectblock);
-#endif
-
+          collectblock = smart_findcollectblock(dev, &releasemax);
           if (collectblock == 0xffff)
             {
               /* Need to collect, but no sectors with released blocks! */
@@ -4110,6 +4152,10 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
             {
               goto errout;
             }
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+          dev->fgcollects++;
+#endif
         }
     }
 
@@ -4119,6 +4165,90 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: smart_bgcollect_worker
+ *
+ * Description:  Collect one erase block in the background, so that writers
+ *               find erased sectors instead of collecting blocks themselves.
+ *               Blocks are collected until the watermark of free sectors is
+ *               reached, but only those that hold at least half of released
+ *               sectors.  Collecting mostly live blocks at idle time would
+ *               only add wear.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BGCOLLECT
+static void smart_bgcollect_worker(FAR void *arg)
+{
+  FAR struct smart_struct_s *dev = arg;
+  uint16_t collectblock;
+  uint16_t releasemax;
+  uint32_t watermark;
+  int ret;
+
+  smart_lock(dev);
+
+  watermark = (uint32_t)CONFIG_MTD_SMART_BGCOLLECT_WATERMARK *
+              dev->availsectperblk;
+  if (dev->formatstatus != SMART_FMT_STAT_FORMATTED ||
+      dev->freesectors >= watermark)
+    {
+      goto out;
+    }
+
+  collectblock = smart_findcollectblock(dev, &releasemax);
+  if (collectblock == 0xffff || 2 * releasemax < dev->availsectperblk)
+    {
+      goto out;
+    }
+
+  finfo("Background collecting block %d, released=%d\n",
+        collectblock, releasemax);
+
+  ret = smart_relocate_block(dev, collectblock);
+  if (ret < 0)
+    {
+      ferr("ERROR: Background collection failed: %d\n", ret);
+      goto out;
+    }
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+  dev->bgcollects++;
+#endif
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+  if (dev->wearflags & SMART_WEARFLAGS_WRITE_NEEDED)
+    {
+      smart_write_wearstatus(dev);
+    }
+#endif
+
+  /* Requeue for the next block, giving the writers the chance to get the
+   * device in between.
+   */
+
+  work_queue(LPWORK, &dev->bgwork, smart_bgcollect_worker, dev, 0);
+
+out:
+  smart_unlock(dev);
+}
+
+/****************************************************************************
+ * Name: smart_bgcollect_schedule
+ *
+ * Description:  (Re)start the idle timer of the background garbage
+ *               collection after the device was accessed.  Must be called
+ *               with the device locked.
+ *
+ ****************************************************************************/
+
+static void smart_bgcollect_schedule(FAR struct smart_struct_s *dev)
+{
+  work_queue(LPWORK, &dev->bgwork, smart_bgcollect_worker, dev,
+             MSEC2TICK(CONFIG_MTD_SMART_BGCOLLECT_IDLE));
+}
+#endif
+
 /****************************************************************************
  * Name: smart_write_wearstatus
  *
@@ -4129,7 +4259,7 @@ errout:
  ****************************************************************************/
 
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-static int smart_write_wearstatus(struct smart_struct_s *dev)
+static int smart_write_wearstatus(FAR struct smart_struct_s *dev)
 {
   uint16_t sector;
   uint16_t remaining;
@@ -5483,6 +5613,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
   dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
+  smart_lock(dev);
+
   /* Process the ioctl's we care about first, pass any we don't respond
    * to directly to the underlying MTD device.
    */
@@ -5535,6 +5667,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       /* Free the specified logical sector */
 
       ret = smart_freesector(dev, arg);
+      smart_bgcollect_schedule(dev);
       goto ok_out;
 
     case BIOC_WRITESECT:
@@ -5552,6 +5685,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
         }
 #endif
 
+      smart_bgcollect_schedule(dev);
       goto ok_out;
 
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
@@ -5589,6 +5723,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
       procfs_data->uneven_wearcount = dev->uneven_wearcount;
 #endif
+      procfs_data->fgcollects     = dev->fgcollects;
+      procfs_data->bgcollects     = dev->bgcollects;
       ret = OK;
       goto ok_out;
 #endif
@@ -5622,6 +5758,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
     }
 
 ok_out:
+  smart_unlock(dev);
   return ret;
 }
 
@@ -6163,6 +6300,9 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd,
       /* Initialize the SMART device structure */
 
       dev->mtd = mtd;
+#ifdef CONFIG_MTD_SMART_BGCOLLECT
+      nxsem_init(&dev->exclsem, 0, 1);
+#endif
 
       /* Get the device geometry. (casting to uintptr_t first eliminates
        * complaints on some architectures where the sizeof long is different
@@ -6314,6 +6454,9 @@ errout:
     }
 #endif
 
+#ifdef CONFIG_MTD_SMART_BGCOLLECT
+  nxsem_destroy(&dev->exclsem);
+#endif
   kmm_free(dev);
   return ret;
 }
@@ -6434,6 +6577,13 @@ static int smart_loteardown(FAR const char *devname)
   filemtd_teardown(dev->mtd);
   unregister_blockdriver(devname);
 
+#ifdef CONFIG_MTD_SMART_BGCOLLECT
+  smart_lock(dev);
+  work_cancel(LPWORK, &dev->bgwork);
+  smart_unlock(dev);
+  nxsem_destroy(&dev->exclsem);
+#endif
+
   kmm_free(dev);
 
   return OK;
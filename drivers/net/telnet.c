@@ -26,6 +26,7 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 #include <fcntl.h>
 #include <poll.h>
 #include <errno.h>
@@ -79,6 +80,7 @@
 
 /* Telnet commands */
 
+#define TELNET_BINARY         0     /* Transmit binary */
 #define TELNET_ECHO           1
 #define TELNET_SGA            3     /* Suppress Go Ahead */
 #define TELNET_NAWS           31    /* Negotiate about window size */
@@ -134,6 +136,10 @@ struct telnet_dev_s
 #endif
 #ifdef HAVE_SIGNALS
   pid_t             td_pid;
+#endif
+#ifdef CONFIG_TELNET_SUPPORT_BINARY
+  bool              td_rxbinary;  /* The client sends binary data */
+  bool              td_txbinary;  /* We send binary data */
 #endif
   struct pollfd     td_fds;
   FAR struct socket td_psock;     /* A clone of the internal socket structure */
@@ -153,13 +159,17 @@ static inline void telnet_dumpbuffer(FAR const char *msg,
 #else
 # define telnet_dumpbuffer(msg,buffer,nbytes)
 #endif
+static size_t  telnet_span(FAR const char *buffer, size_t len, bool cr,
+                 bool nl);
 static void    telnet_getchar(FAR struct telnet_dev_s *priv, uint8_t ch,
                  FAR char *dest, int *nread);
 static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
                  FAR const char *src, size_t srclen, FAR char *dest,
                  size_t destlen);
-static bool    telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
+static void    telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
                  int *nwritten);
+static ssize_t telnet_send(FAR struct telnet_dev_s *priv,
+                 FAR const char *buffer, size_t len);
 static void    telnet_sendopt(FAR struct telnet_dev_s *priv, uint8_t option,
                  uint8_t value);
 static int     telnet_io_main(int argc, FAR char** argv);
@@ -271,42 +281,32 @@ static void telnet_check_ctrlchar(FAR struct telnet_dev_s *priv,
 {
   int signo = 0;
 
-  for (; priv->td_pid >= 0 && len > 0; buffer++, len--)
+  if (priv->td_pid < 0)
     {
-#ifdef CONFIG_TTY_SIGINT
-      /* Is this the special character that will generate the SIGINT
-       * signal?
-       */
+      return;
+    }
 
-      if (*buffer == CONFIG_TTY_SIGINT_CHAR)
-        {
-          /* Yes.. note that the kill is needed and do not put the character
-           * into the Rx buffer.  It should not be read as normal data.
-           */
+#ifdef CONFIG_TTY_SIGINT
+  /* Is there the special character that will generate the SIGINT signal?
+   * SIGINT takes precedence over SIGTSTP.
+   */
 
-          signo = SIGINT;
-          break;
-        }
+  if (memchr(buffer, CONFIG_TTY_SIGINT_CHAR, len) != NULL)
+    {
+      signo = SIGINT;
+    }
 #endif
 
 #ifdef CONFIG_TTY_SIGTSTP
-      /* Is this the special character that will generate the SIGTSTP
-       * signal?
-       */
-
-      if (*buffer == CONFIG_TTY_SIGTSTP_CHAR)
-        {
-          /* Note that the kill is needed and do not put the character
-           * into the Rx buffer.  It should not be read as normal data.
-           */
+  /* Is there the special character that will generate the SIGTSTP
+   * signal?
+   */
 
-          signo = SIGTSTP;
-#ifndef CONFIG_TTY_SIGINT
-          break;
-#endif
-        }
-#endif
+  if (signo == 0 && memchr(buffer, CONFIG_TTY_SIGTSTP_CHAR, len) != NULL)
+    {
+      signo = SIGTSTP;
     }
+#endif
 
   /* Send the signal if necessary */
 
@@ -317,6 +317,48 @@ static void telnet_check_ctrlchar(FAR struct telnet_dev_s *priv,
 }
 #endif
 
+/****************************************************************************
+ * Name: telnet_span
+ *
+ * Description:
+ *   Return the length of the initial run of the buffer that contains no
+ *   TELNET_IAC, no carriage return (if cr is true) and no newline (if nl is
+ *   true).  These bytes need no processing and are copied as a block.
+ *
+ ****************************************************************************/
+
+static size_t telnet_span(FAR const char *buffer, size_t len, bool cr,
+                          bool nl)
+{
+  FAR const char *ptr;
+
+  ptr = memchr(buffer, TELNET_IAC, len);
+  if (ptr != NULL)
+    {
+      len = ptr - buffer;
+    }
+
+  if (cr)
+    {
+      ptr = memchr(buffer, TELNET_CR, len);
+      if (ptr != NULL)
+        {
+          len = ptr - buffer;
+        }
+    }
+
+  if (nl)
+    {
+      ptr = memchr(buffer, TELNET_NL, len);
+      if (ptr != NULL)
+        {
+          len = ptr - buffer;
+        }
+    }
+
+  return len;
+}
+
 /****************************************************************************
  * Name: telnet_getchar
  *
@@ -331,9 +373,13 @@ static void telnet_getchar(FAR struct telnet_dev_s *priv, uint8_t ch,
   register int index;
 
 #ifndef CONFIG_TELNET_CHARACTER_MODE
-  /* Ignore carriage returns */
+  /* Ignore carriage returns, unless receiving binary data */
 
-  if (ch != TELNET_CR)
+  if (ch != TELNET_CR
+#ifdef CONFIG_TELNET_SUPPORT_BINARY
+      || priv->td_rxbinary
+#endif
+     )
 #endif
     {
       /* Add all other characters to the destination buffer */
@@ -356,14 +402,48 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
                               FAR const char *src, size_t srclen,
                               FAR char *dest, size_t destlen)
 {
+  bool cr = false;
+  size_t n;
   int nread;
   uint8_t ch;
 
   ninfo("srclen: %zd destlen: %zd\n", srclen, destlen);
 
-  for (nread = 0; srclen > 0 && nread < destlen; srclen--)
+#ifndef CONFIG_TELNET_CHARACTER_MODE
+  /* Carriage returns are dropped in line mode */
+
+  cr = true;
+#ifdef CONFIG_TELNET_SUPPORT_BINARY
+  cr = !priv->td_rxbinary;
+#endif
+#endif
+
+  for (nread = 0; srclen > 0 && nread < destlen; )
     {
+      /* Outside of a command, copy the bytes that need no processing as a
+       * block.
+       */
+
+      if (priv->td_state == STATE_NORMAL)
+        {
+          n = telnet_span(src, srclen, cr, false);
+          if (n > destlen - nread)
+            {
+              n = destlen - nread;
+            }
+
+          if (n > 0)
+            {
+              memcpy(&dest[nread], src, n);
+              nread  += n;
+              src    += n;
+              srclen -= n;
+              continue;
+            }
+        }
+
       ch = *src++;
+      srclen--;
       ninfo("ch=%02x state=%d\n", ch, priv->td_state);
 
       switch (priv->td_state)
@@ -413,6 +493,19 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
             break;
 
           case STATE_WILL:
+#ifdef CONFIG_TELNET_SUPPORT_BINARY
+            /* Accept binary data from the client */
+
+            if (ch == TELNET_BINARY)
+              {
+                if (!priv->td_rxbinary)
+                  {
+                    priv->td_rxbinary = true;
+                    telnet_sendopt(priv, TELNET_DO, ch);
+                  }
+              }
+            else
+#endif
 #ifdef CONFIG_TELNET_SUPPORT_NAWS
             /* For NAWS, Reply with a DO */
 
@@ -434,11 +527,34 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
             break;
 
           case STATE_WONT:
+#ifdef CONFIG_TELNET_SUPPORT_BINARY
+            if (ch == TELNET_BINARY)
+              {
+                priv->td_rxbinary = false;
+              }
+#endif
+
             telnet_sendopt(priv, TELNET_DONT, ch);
             priv->td_state = STATE_NORMAL;
             break;
 
           case STATE_DO:
+#ifdef CONFIG_TELNET_SUPPORT_BINARY
+            /* Send binary data to the client */
+
+            if (ch == TELNET_BINARY)
+              {
+                if (!priv->td_txbinary)
+                  {
+                    priv->td_txbinary = true;
+                    telnet_sendopt(priv, TELNET_WILL, ch);
+                  }
+
+                priv->td_state = STATE_NORMAL;
+                break;
+              }
+#endif
+
 #ifdef CONFIG_TELNET_CHARACTER_MODE
             if (ch == TELNET_SGA || ch == TELNET_ECHO)
               {
@@ -462,6 +578,12 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
             break;
 
           case STATE_DONT:
+#ifdef CONFIG_TELNET_SUPPORT_BINARY
+            if (ch == TELNET_BINARY)
+              {
+                priv->td_txbinary = false;
+              }
+#endif
 
             /* Reply with a WONT */
 
@@ -562,41 +684,55 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
  * Name: telnet_putchar
  *
  * Description:
- *   Put another character from the user buffer to the TX buffer.
+ *   Put a special character from the user buffer to the TX buffer.  All
+ *   other characters are copied as a block by telnet_write().
  *
  ****************************************************************************/
 
-static bool telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
+static void telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
                            int *nread)
 {
-  register int index;
-  bool ret = false;
+  register int index = *nread;
 
-  /* Ignore carriage returns (we will put these in automatically as
-   * necessary).
-   */
-
-  if (ch != TELNET_CR)
+  if (ch == TELNET_IAC)
     {
-      /* Add all other characters to the destination buffer */
+      /* Escape the data byte that would be taken for a command */
 
-      index = *nread;
-      priv->td_txbuffer[index++] = ch;
+      priv->td_txbuffer[index++] = TELNET_IAC;
+      priv->td_txbuffer[index++] = TELNET_IAC;
+    }
+  else if (ch == TELNET_NL)
+    {
+      /* Add the line feed followed by the carriage return */
 
-      /* Check for line feeds */
+      priv->td_txbuffer[index++] = TELNET_NL;
+      priv->td_txbuffer[index++] = TELNET_CR;
+    }
 
-      if (ch == TELNET_NL)
-        {
-          /* Now add the carriage return */
+  /* Ignore carriage returns (we will put these in automatically as
+   * necessary).
+   */
 
-          priv->td_txbuffer[index++] = TELNET_CR;
+  *nread = index;
+}
 
-          /* End of line */
+/****************************************************************************
+ * Name: telnet_send
+ *
+ * Description:
+ *   Send data to the client.
+ *
+ ****************************************************************************/
 
-          ret = true;
-        }
+static ssize_t telnet_send(FAR struct telnet_dev_s *priv,
+                           FAR const char *buffer, size_t len)
+{
+  ssize_t ret;
 
-      *nread = index;
+  ret = psock_send(&priv->td_psock, buffer, len, 0);
+  if (ret < 0)
+    {
+      nerr("ERROR: psock_send failed: %zd\n", ret);
     }
 
   return ret;
@@ -893,57 +1029,85 @@ static ssize_t telnet_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct inode *inode = filep->f_inode;
   FAR struct telnet_dev_s *priv = inode->i_private;
   FAR const char *src = buffer;
-  ssize_t nsent;
+  bool crlf = true;
+  size_t nsent;
+  size_t n;
   ssize_t ret;
   int ncopied;
-  char ch;
-  bool eol;
 
   ninfo("len: %zd\n", len);
 
-  /* Process each character from the user buffer */
+#ifdef CONFIG_TELNET_SUPPORT_BINARY
+  /* In binary mode, only TELNET_IAC needs to be processed */
+
+  crlf = !priv->td_txbinary;
+#endif
 
-  for (nsent = 0, ncopied = 0; nsent < len; nsent++)
+  for (nsent = 0, ncopied = 0; nsent < len; )
     {
-      /* Get the next character from the user buffer */
+      n = telnet_span(src, len - nsent, crlf, crlf);
+      if (n == 0)
+        {
+          /* Is the buffer too full to hold the next largest character
+           * sequence ("\n\r" or two TELNET_IAC)?  Then send the data now.
+           */
 
-      ch = *src++;
+          if (ncopied > CONFIG_TELNET_TXBUFFER_SIZE - 2)
+            {
+              ret = telnet_send(priv, priv->td_txbuffer, ncopied);
+              if (ret < 0)
+                {
+                  return ret;
+                }
 
-      /* Add the character to the TX buffer */
+              ncopied = 0;
+            }
 
-      eol = telnet_putchar(priv, ch, &ncopied);
+          telnet_putchar(priv, *src++, &ncopied);
+          nsent++;
+          continue;
+        }
 
-      /* Was that the end of a line? Or is the buffer too full to hold the
-       * next largest character sequence ("\r\n")?
+      /* Copy the bytes that need no processing to the TX buffer.  If they
+       * do not fit, send them directly from the user buffer.
        */
 
-      if (eol || ncopied > CONFIG_TELNET_TXBUFFER_SIZE - 2)
+      if (n <= CONFIG_TELNET_TXBUFFER_SIZE - ncopied)
+        {
+          memcpy(&priv->td_txbuffer[ncopied], src, n);
+          ncopied += n;
+        }
+      else
         {
-          /* Yes... send the data now */
+          if (ncopied > 0)
+            {
+              ret = telnet_send(priv, priv->td_txbuffer, ncopied);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              ncopied = 0;
+            }
 
-          ret = psock_send(&priv->td_psock, priv->td_txbuffer, ncopied, 0);
+          ret = telnet_send(priv, src, n);
           if (ret < 0)
             {
-              nerr("ERROR: psock_send failed '%s': %zd\n",
-                   priv->td_txbuffer, ret);
               return ret;
             }
-
-          /* Reset the index to the beginning of the TX buffer. */
-
-          ncopied = 0;
         }
+
+      src   += n;
+      nsent += n;
     }
 
   /* Send anything remaining in the TX buffer */
 
   if (ncopied > 0)
     {
-      ret = psock_send(&priv->td_psock, priv->td_txbuffer, ncopied, 0);
+      ret = telnet_send(priv, priv->td_txbuffer, ncopied);
       if (ret < 0)
         {
-          nerr("ERROR: psock_send failed '%s': %zd\n",
-               priv->td_txbuffer, ret);
           return ret;
         }
     }
@@ -1250,7 +1414,7 @@ static int telnet_poll(FAR struct file *filep, FAR struct pollfd *fds,
       fds->revents |= (POLLRDNORM & fds->events);
       if (fds->revents)
         {
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 
@@ -313,7 +313,7 @@ static void tun_pollnotify(FAR struct tun_device_s *priv,
   if (eventset != 0)
     {
       fds->revents |= eventset;
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, 0);
     }
 }
 
@@ -25,28 +25,53 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <sched.h>
 #include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
 #include <string.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched.h>
 #include <nuttx/sched_note.h>
 #include <nuttx/note/noteram_driver.h>
 #include <nuttx/fs/fs.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* In SMP configurations every CPU adds its notes to a buffer of its own so
+ * that the CPUs do not contend for a lock when they add notes.  The reader
+ * merges the buffers in the order of the timestamps of the notes.
+ */
+
+#ifdef CONFIG_SMP
+#  define NOTERAM_NCPUS         CONFIG_SMP_NCPUS
+#  define noteram_cpu()         up_cpu_index()
+#  define noteram_tasklock()    spin_lock_wo_note(&g_noteram_tasklock)
+#  define noteram_taskunlock()  spin_unlock_wo_note(&g_noteram_tasklock)
+#else
+#  define NOTERAM_NCPUS         1
+#  define noteram_cpu()         0
+#  define noteram_tasklock()
+#  define noteram_taskunlock()
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
 struct noteram_info_s
 {
-  unsigned int ni_overwrite;
   volatile unsigned int ni_head;
   volatile unsigned int ni_tail;
   volatile unsigned int ni_read;
+#ifdef CONFIG_SMP
+  volatile spinlock_t ni_lock;
+#endif
   uint8_t ni_buffer[CONFIG_DRIVER_NOTERAM_BUFSIZE];
 };
 
@@ -92,21 +117,23 @@ static const struct file_operations g_noteram_fops =
 #endif
 };
 
-static struct noteram_info_s g_noteram_info =
-{
+static struct noteram_info_s g_noteram_info[NOTERAM_NCPUS];
+
+static volatile unsigned int g_noteram_overwrite =
 #ifdef CONFIG_DRIVER_NOTERAM_DEFAULT_NOOVERWRITE
-  NOTERAM_MODE_OVERWRITE_DISABLE
+  NOTERAM_MODE_OVERWRITE_DISABLE;
 #else
-  NOTERAM_MODE_OVERWRITE_ENABLE
+  NOTERAM_MODE_OVERWRITE_ENABLE;
 #endif
-};
 
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
 static struct noteram_taskname_s g_noteram_taskname;
 #endif
 
 #ifdef CONFIG_SMP
-static volatile spinlock_t g_noteram_lock;
+/* Protects the task name buffer that is shared by all CPUs */
+
+static volatile spinlock_t g_noteram_tasklock;
 #endif
 
 /****************************************************************************
@@ -255,7 +282,8 @@ static const char *noteram_get_taskname(pid_t pid)
   FAR struct noteram_taskname_info_s *ti;
   FAR struct tcb_s *tcb;
 
-  irq_mask = enter_critical_section();
+  irq_mask = up_irq_save();
+  noteram_tasklock();
 
   ti = noteram_find_taskname(pid);
   if (ti != NULL)
@@ -272,11 +300,59 @@ static const char *noteram_get_taskname(pid_t pid)
         }
     }
 
-  leave_critical_section(irq_mask);
+  noteram_taskunlock();
+  up_irq_restore(irq_mask);
   return ret;
 }
 #endif
 
+/****************************************************************************
+ * Name: noteram_lock
+ *
+ * Description:
+ *   Disable local interrupts and lock the buffers of all CPUs so that the
+ *   reader sees a consistent state.  Writers only ever take the lock of
+ *   the buffer of their own CPU.
+ *
+ ****************************************************************************/
+
+static irqstate_t noteram_lock(void)
+{
+  irqstate_t flags = up_irq_save();
+#ifdef CONFIG_SMP
+  int cpu;
+
+  for (cpu = 0; cpu < NOTERAM_NCPUS; cpu++)
+    {
+      spin_lock_wo_note(&g_noteram_info[cpu].ni_lock);
+    }
+#endif
+
+  return flags;
+}
+
+/****************************************************************************
+ * Name: noteram_unlock
+ *
+ * Description:
+ *   Release the locks taken by noteram_lock().
+ *
+ ****************************************************************************/
+
+static void noteram_unlock(irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  int cpu;
+
+  for (cpu = NOTERAM_NCPUS - 1; cpu >= 0; cpu--)
+    {
+      spin_unlock_wo_note(&g_noteram_info[cpu].ni_lock);
+    }
+#endif
+
+  up_irq_restore(flags);
+}
+
 /****************************************************************************
  * Name: noteram_buffer_clear
  *
@@ -293,23 +369,31 @@ static const char *noteram_get_taskname(pid_t pid)
 
 static void noteram_buffer_clear(void)
 {
+  FAR struct noteram_info_s *info;
   irqstate_t flags;
+  int cpu;
 
-  flags = enter_critical_section();
+  flags = noteram_lock();
 
-  g_noteram_info.ni_tail = g_noteram_info.ni_head;
-  g_noteram_info.ni_read = g_noteram_info.ni_head;
+  for (cpu = 0; cpu < NOTERAM_NCPUS; cpu++)
+    {
+      info = &g_noteram_info[cpu];
+      info->ni_tail = info->ni_head;
+      info->ni_read = info->ni_head;
+    }
 
-  if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+  if (g_noteram_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
     {
-      g_noteram_info.ni_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
+      g_noteram_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
     }
 
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
+  noteram_tasklock();
   g_noteram_taskname.buffer_used = 0;
+  noteram_taskunlock();
 #endif
 
-  leave_critical_section(flags);
+  noteram_unlock(flags);
 }
 
 /****************************************************************************
@@ -346,17 +430,17 @@ static inline unsigned int noteram_next(unsigned int ndx,
  *   Length of data currently in circular buffer.
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   Length of data currently in circular buffer.
  *
  ****************************************************************************/
 
-static unsigned int noteram_length(void)
+static unsigned int noteram_length(FAR struct noteram_info_s *info)
 {
-  unsigned int head = g_noteram_info.ni_head;
-  unsigned int tail = g_noteram_info.ni_tail;
+  unsigned int head = info->ni_head;
+  unsigned int tail = info->ni_tail;
 
   if (tail > head)
     {
@@ -373,17 +457,17 @@ static unsigned int noteram_length(void)
  *   Length of unread data currently in circular buffer.
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   Length of unread data currently in circular buffer.
  *
  ****************************************************************************/
 
-static unsigned int noteram_unread_length(void)
+static unsigned int noteram_unread_length(FAR struct noteram_info_s *info)
 {
-  unsigned int head = g_noteram_info.ni_head;
-  unsigned int read = g_noteram_info.ni_read;
+  unsigned int head = info->ni_head;
+  unsigned int read = info->ni_read;
 
   if (read > head)
     {
@@ -393,6 +477,155 @@ static unsigned int noteram_unread_length(void)
   return head - read;
 }
 
+/****************************************************************************
+ * Name: noteram_copy
+ *
+ * Description:
+ *   Copy data out of the circular buffer, handling wraparound.
+ *
+ * Input Parameters:
+ *   info   - The circular buffer
+ *   ndx    - The index of the first byte to copy
+ *   buffer - The location to copy the data to
+ *   len    - The number of bytes to copy
+ *
+ * Returned Value:
+ *   The circular buffer index after the copied data.
+ *
+ ****************************************************************************/
+
+static unsigned int noteram_copy(FAR struct noteram_info_s *info,
+                                 unsigned int ndx, FAR uint8_t *buffer,
+                                 size_t len)
+{
+  size_t span = CONFIG_DRIVER_NOTERAM_BUFSIZE - ndx;
+
+  if (span > len)
+    {
+      span = len;
+    }
+
+  memcpy(buffer, &info->ni_buffer[ndx], span);
+  memcpy(buffer + span, info->ni_buffer, len - span);
+  return noteram_next(ndx, len);
+}
+
+/****************************************************************************
+ * Name: noteram_timestamp
+ *
+ * Description:
+ *   Return the timestamp of the note at the specified index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+static uint64_t noteram_timestamp(FAR struct noteram_info_s *info,
+                                  unsigned int ndx)
+{
+  struct note_common_s note;
+  uint64_t timestamp = 0;
+#ifdef CONFIG_SCHED_INSTRUMENTATION_HIRES
+  uint64_t nsec = 0;
+#endif
+  int i;
+
+  noteram_copy(info, ndx, (FAR uint8_t *)&note, sizeof(note));
+
+  /* The fields are stored in little endian order */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_HIRES
+  for (i = sizeof(note.nc_systime_sec) - 1; i >= 0; i--)
+    {
+      timestamp = (timestamp << 8) | note.nc_systime_sec[i];
+    }
+
+  for (i = sizeof(note.nc_systime_nsec) - 1; i >= 0; i--)
+    {
+      nsec = (nsec << 8) | note.nc_systime_nsec[i];
+    }
+
+  timestamp = timestamp * NSEC_PER_SEC + nsec;
+#else
+  for (i = sizeof(note.nc_systime) - 1; i >= 0; i--)
+    {
+      timestamp = (timestamp << 8) | note.nc_systime[i];
+    }
+#endif
+
+  return timestamp;
+}
+#endif
+
+/****************************************************************************
+ * Name: noteram_before
+ *
+ * Description:
+ *   Return true if the timestamp t1 is earlier than the timestamp t2,
+ *   allowing for the wraparound of 32-bit counters.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+static inline bool noteram_before(uint64_t t1, uint64_t t2)
+{
+#if defined(CONFIG_SCHED_INSTRUMENTATION_HIRES)
+  return t1 < t2;
+#elif defined(CONFIG_SCHED_INSTRUMENTATION_PERFCOUNT) || \
+      !defined(CONFIG_SYSTEM_TIME64)
+  return (int32_t)(uint32_t)(t1 - t2) < 0;
+#else
+  return (int64_t)(t1 - t2) < 0;
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: noteram_oldest
+ *
+ * Description:
+ *   Return the buffer that holds the oldest unread note.
+ *
+ * Returned Value:
+ *   The buffer to read the next note from, or NULL if all buffers are
+ *   empty.
+ *
+ * Assumptions:
+ *   The buffers are locked with noteram_lock().
+ *
+ ****************************************************************************/
+
+static FAR struct noteram_info_s *noteram_oldest(void)
+{
+  FAR struct noteram_info_s *oldest = NULL;
+#ifdef CONFIG_SMP
+  FAR struct noteram_info_s *info;
+  uint64_t timestamp = 0;
+  uint64_t t;
+  int cpu;
+
+  for (cpu = 0; cpu < NOTERAM_NCPUS; cpu++)
+    {
+      info = &g_noteram_info[cpu];
+      if (noteram_unread_length(info) > 0)
+        {
+          t = noteram_timestamp(info, info->ni_read);
+          if (oldest == NULL || noteram_before(t, timestamp))
+            {
+              oldest    = info;
+              timestamp = t;
+            }
+        }
+    }
+#else
+  if (noteram_unread_length(&g_noteram_info[0]) > 0)
+    {
+      oldest = &g_noteram_info[0];
+    }
+#endif
+
+  return oldest;
+}
+
 /****************************************************************************
  * Name: noteram_remove
  *
@@ -400,33 +633,33 @@ static unsigned int noteram_unread_length(void)
  *   Remove the variable length note from the tail of the circular buffer
  *
  * Input Parameters:
- *   None
+ *   info - The circular buffer
  *
  * Returned Value:
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   The buffer is locked.
  *
  ****************************************************************************/
 
-static void noteram_remove(void)
+static void noteram_remove(FAR struct noteram_info_s *info)
 {
   unsigned int tail;
   unsigned int length;
 
   /* Get the tail index of the circular buffer */
 
-  tail = g_noteram_info.ni_tail;
+  tail = info->ni_tail;
   DEBUGASSERT(tail < CONFIG_DRIVER_NOTERAM_BUFSIZE);
 
   /* Get the length of the note at the tail index */
 
-  length = g_noteram_info.ni_buffer[tail];
-  DEBUGASSERT(length <= noteram_length());
+  length = info->ni_buffer[tail];
+  DEBUGASSERT(length <= noteram_length(info));
 
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
-  if (g_noteram_info.ni_buffer[noteram_next(tail, 1)] == NOTE_STOP)
+  if (info->ni_buffer[noteram_next(tail, 1)] == NOTE_STOP)
     {
       uint8_t nc_pid[2];
 
@@ -435,14 +668,16 @@ static void noteram_remove(void)
        */
 
 #ifdef CONFIG_SMP
-      nc_pid[0] = g_noteram_info.ni_buffer[noteram_next(tail, 4)];
-      nc_pid[1] = g_noteram_info.ni_buffer[noteram_next(tail, 5)];
+      nc_pid[0] = info->ni_buffer[noteram_next(tail, 4)];
+      nc_pid[1] = info->ni_buffer[noteram_next(tail, 5)];
 #else
-      nc_pid[0] = g_noteram_info.ni_buffer[noteram_next(tail, 3)];
-      nc_pid[1] = g_noteram_info.ni_buffer[noteram_next(tail, 4)];
+      nc_pid[0] = info->ni_buffer[noteram_next(tail, 3)];
+      nc_pid[1] = info->ni_buffer[noteram_next(tail, 4)];
 #endif
 
+      noteram_tasklock();
       noteram_remove_taskname(nc_pid[0] + (nc_pid[1] << 8));
+      noteram_taskunlock();
     }
 #endif
 
@@ -450,14 +685,14 @@ static void noteram_remove(void)
    * buffer.
    */
 
-  if (g_noteram_info.ni_read == g_noteram_info.ni_tail)
+  if (info->ni_read == info->ni_tail)
     {
       /* The read index also needs increment. */
 
-      g_noteram_info.ni_read = noteram_next(tail, length);
+      info->ni_read = noteram_next(tail, length);
     }
 
-  g_noteram_info.ni_tail = noteram_next(tail, length);
+  info->ni_tail = noteram_next(tail, length);
 }
 
 /****************************************************************************
@@ -479,35 +714,32 @@ static void noteram_remove(void)
 
 static ssize_t noteram_get(FAR uint8_t *buffer, size_t buflen)
 {
-  FAR struct note_common_s *note;
+  FAR struct noteram_info_s *info;
   irqstate_t flags;
-  unsigned int remaining;
   unsigned int read;
   ssize_t notelen;
-  size_t circlen;
 
   DEBUGASSERT(buffer != NULL);
-  flags = enter_critical_section();
+  flags = noteram_lock();
 
-  /* Verify that the circular buffer is not empty */
+  /* Find the buffer with the oldest unread note */
 
-  circlen = noteram_unread_length();
-  if (circlen <= 0)
+  info = noteram_oldest();
+  if (info == NULL)
     {
       notelen = 0;
-      goto errout_with_csection;
+      goto errout_with_lock;
     }
 
   /* Get the read index of the circular buffer */
 
-  read    = g_noteram_info.ni_read;
+  read    = info->ni_read;
   DEBUGASSERT(read < CONFIG_DRIVER_NOTERAM_BUFSIZE);
 
   /* Get the length of the note at the read index */
 
-  note    = (FAR struct note_common_s *)&g_noteram_info.ni_buffer[read];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  notelen = info->ni_buffer[read];
+  DEBUGASSERT(notelen <= noteram_unread_length(info));
 
   /* Is the user buffer large enough to hold the note? */
 
@@ -515,33 +747,20 @@ static ssize_t noteram_get(FAR uint8_t *buffer, size_t buflen)
     {
       /* Skip the large note so that we do not get constipated. */
 
-      g_noteram_info.ni_read = noteram_next(read, notelen);
+      info->ni_read = noteram_next(read, notelen);
 
       /* and return an error */
 
       notelen = -EFBIG;
-      goto errout_with_csection;
+      goto errout_with_lock;
     }
 
-  /* Loop until the note has been transferred to the user buffer */
-
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
-    {
-      /* Copy the next byte at the read index */
-
-      *buffer++ = g_noteram_info.ni_buffer[read];
-
-      /* Adjust indices and counts */
-
-      read = noteram_next(read, 1);
-      remaining--;
-    }
+  /* Copy the note to the user buffer */
 
-  g_noteram_info.ni_read = read;
+  info->ni_read = noteram_copy(info, read, buffer, notelen);
 
-errout_with_csection:
-  leave_critical_section(flags);
+errout_with_lock:
+  noteram_unlock(flags);
   return notelen;
 }
 
@@ -563,36 +782,22 @@ errout_with_csection:
 
 static ssize_t noteram_size(void)
 {
-  FAR struct note_common_s *note;
+  FAR struct noteram_info_s *info;
   irqstate_t flags;
-  unsigned int read;
-  ssize_t notelen;
-  size_t circlen;
+  ssize_t notelen = 0;
 
-  flags = enter_critical_section();
+  flags = noteram_lock();
 
-  /* Verify that the circular buffer is not empty */
+  /* Get the length of the oldest unread note */
 
-  circlen = noteram_unread_length();
-  if (circlen <= 0)
+  info = noteram_oldest();
+  if (info != NULL)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      DEBUGASSERT(info->ni_read < CONFIG_DRIVER_NOTERAM_BUFSIZE);
+      notelen = info->ni_buffer[info->ni_read];
     }
 
-  /* Get the read index of the circular buffer */
-
-  read = g_noteram_info.ni_read;
-  DEBUGASSERT(read < CONFIG_DRIVER_NOTERAM_BUFSIZE);
-
-  /* Get the length of the note at the read index */
-
-  note    = (FAR struct note_common_s *)&g_noteram_info.ni_buffer[read];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
-
-errout_with_csection:
-  leave_critical_section(flags);
+  noteram_unlock(flags);
   return notelen;
 }
 
@@ -602,10 +807,19 @@ errout_with_csection:
 
 static int noteram_open(FAR struct file *filep)
 {
-  /* Reset the read index of the circular buffer */
+  irqstate_t flags;
+  int cpu;
 
-  g_noteram_info.ni_read = g_noteram_info.ni_tail;
+  /* Reset the read index of the circular buffers */
 
+  flags = noteram_lock();
+
+  for (cpu = 0; cpu < NOTERAM_NCPUS; cpu++)
+    {
+      g_noteram_info[cpu].ni_read = g_noteram_info[cpu].ni_tail;
+    }
+
+  noteram_unlock(flags);
   return OK;
 }
 
@@ -703,7 +917,7 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
           }
         else
           {
-            *(unsigned int *)arg = g_noteram_info.ni_overwrite;
+            *(unsigned int *)arg = g_noteram_overwrite;
             ret = OK;
           }
         break;
@@ -720,7 +934,7 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
           }
         else
           {
-            g_noteram_info.ni_overwrite = *(unsigned int *)arg;
+            g_noteram_overwrite = *(unsigned int *)arg;
             ret = OK;
           }
         break;
@@ -786,29 +1000,52 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   May be called from any context, including interrupt handlers.
  *
  ****************************************************************************/
 
 void sched_note_add(FAR const void *note, size_t notelen)
 {
-  FAR const char *buf = note;
+  FAR struct noteram_info_s *info;
+  FAR const uint8_t *buf = note;
   unsigned int head;
-  unsigned int next;
+  size_t span;
   irqstate_t flags;
 
+  /* Only the buffer of this CPU is locked, so the CPUs do not contend with
+   * each other, only with the reader.
+   */
+
   flags = up_irq_save();
+  info  = &g_noteram_info[noteram_cpu()];
 #ifdef CONFIG_SMP
-  spin_lock_wo_note(&g_noteram_lock);
+  spin_lock_wo_note(&info->ni_lock);
 #endif
 
-  if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+  if (g_noteram_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
     {
-#ifdef CONFIG_SMP
-      spin_unlock_wo_note(&g_noteram_lock);
-#endif
-      up_irq_restore(flags);
-      return;
+      goto out_with_lock;
+    }
+
+  DEBUGASSERT(note != NULL && notelen < CONFIG_DRIVER_NOTERAM_BUFSIZE);
+
+  /* Make room for the note.  One byte is always left free so that a full
+   * buffer can be told from an empty one.
+   */
+
+  while (noteram_length(info) + notelen >= CONFIG_DRIVER_NOTERAM_BUFSIZE)
+    {
+      if (g_noteram_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
+        {
+          /* Stop recording if not in overwrite mode */
+
+          g_noteram_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
+          goto out_with_lock;
+        }
+
+      /* Remove the note at the tail index */
+
+      noteram_remove(info);
     }
 
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
@@ -820,59 +1057,34 @@ void sched_note_add(FAR const void *note, size_t notelen)
       note_st = (FAR struct note_start_s *)note;
       if (note_st->nst_cmn.nc_type == NOTE_START)
         {
+          noteram_tasklock();
           noteram_record_taskname(note_st->nst_cmn.nc_pid[0] +
                                   (note_st->nst_cmn.nc_pid[1] << 8),
                                   note_st->nst_name);
+          noteram_taskunlock();
         }
     }
 #endif
 
-  /* Get the index to the head of the circular buffer */
-
-  DEBUGASSERT(note != NULL && notelen < CONFIG_DRIVER_NOTERAM_BUFSIZE);
-  head = g_noteram_info.ni_head;
-
-  /* Loop until all bytes have been transferred to the circular buffer */
+  /* Copy the note to the head of the circular buffer in at most two
+   * contiguous spans.
+   */
 
-  while (notelen > 0)
+  head = info->ni_head;
+  span = CONFIG_DRIVER_NOTERAM_BUFSIZE - head;
+  if (span > notelen)
     {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
-       */
-
-      next = noteram_next(head, 1);
-      if (next == g_noteram_info.ni_tail)
-        {
-          if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
-            {
-              /* Stop recording if not in overwrite mode */
-
-              g_noteram_info.ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
-
-#ifdef CONFIG_SMP
-              spin_unlock_wo_note(&g_noteram_lock);
-#endif
-              up_irq_restore(flags);
-              return;
-            }
-
-          /* Yes, then remove the note at the tail index */
-
-          noteram_remove();
-        }
-
-      /* Save the next byte at the head index */
-
-      g_noteram_info.ni_buffer[head] = *buf++;
-
-      head = next;
-      notelen--;
+      span = notelen;
     }
 
-  g_noteram_info.ni_head = head;
+  memcpy(&info->ni_buffer[head], buf, span);
+  memcpy(info->ni_buffer, buf + span, notelen - span);
+
+  info->ni_head = noteram_next(head, notelen);
 
+out_with_lock:
 #ifdef CONFIG_SMP
-  spin_unlock_wo_note(&g_noteram_lock);
+  spin_unlock_wo_note(&info->ni_lock);
 #endif
   up_irq_restore(flags);
 }
@@ -105,7 +105,7 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
           if (fds->revents != 0)
             {
               finfo("Report events: %08" PRIx32 "\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -402,6 +402,9 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
   FAR uint8_t           *start = (FAR uint8_t *)buffer;
 #endif
   ssize_t                nread = 0;
+#ifdef CONFIG_DEV_PIPE_DIRECT
+  struct pipe_reader_s   reader;
+#endif
   int                    sval;
   int                    ret;
 
@@ -444,6 +447,45 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
           return -EAGAIN;
         }
 
+#ifdef CONFIG_DEV_PIPE_DIRECT
+      /* Offer the buffer to the next writer unless another reader already
+       * does.  The buffer must be withdrawn again before returning, even
+       * if waiting fails, and the writer may have filled it by then.
+       */
+
+      if (dev->d_reader == NULL)
+        {
+          reader.r_buffer = buffer;
+          reader.r_len    = len;
+          reader.r_copied = 0;
+          dev->d_reader   = &reader;
+
+          nxsem_post(&dev->d_bfsem);
+          ret = nxsem_wait(&dev->d_rdsem);
+          nxsem_wait_uninterruptible(&dev->d_bfsem);
+
+          if (dev->d_reader == &reader)
+            {
+              dev->d_reader = NULL;
+            }
+
+          if (reader.r_copied > 0)
+            {
+              nxsem_post(&dev->d_bfsem);
+              pipe_dumpbuffer("From PIPE:", start, reader.r_copied);
+              return reader.r_copied;
+            }
+
+          if (ret < 0)
+            {
+              nxsem_post(&dev->d_bfsem);
+              return ret;
+            }
+
+          continue;
+        }
+#endif
+
       /* Otherwise, wait for something to be written to the pipe */
 
       nxsem_post(&dev->d_bfsem);
@@ -460,19 +502,38 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
     }
 
   /* Then return whatever is available in the pipe (which is at least one
-   * byte).
+   * byte).  The data is copied in at most two contiguous spans, the second
+   * one if the data wraps around the end of the buffer.
    */
 
   nread = 0;
   while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx)
     {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= dev->d_bufsize)
+      size_t ncopy;
+
+      if (dev->d_wrndx > dev->d_rdndx)
         {
-          dev->d_rdndx = 0;
+          ncopy = dev->d_wrndx - dev->d_rdndx;
+        }
+      else
+        {
+          ncopy = dev->d_bufsize - dev->d_rdndx;
         }
 
-      nread++;
+      if (ncopy > len - nread)
+        {
+          ncopy = len - nread;
+        }
+
+      memcpy(buffer, &dev->d_buffer[dev->d_rdndx], ncopy);
+      buffer += ncopy;
+      nread  += ncopy;
+
+      dev->d_rdndx += ncopy;
+      if (dev->d_rdndx >= dev->d_bufsize)
+        {
+          dev->d_rdndx = 0;
+        }
     }
 
   /* Notify all poll/select waiters that they can write to the FIFO */
@@ -504,7 +565,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct pipe_dev_s *dev      = inode->i_private;
   ssize_t                nwritten = 0;
   ssize_t                last;
-  int                    nxtwrndx;
+  size_t                 nfree;
   int                    sval;
   int                    ret;
 
@@ -562,26 +623,85 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
           return nwritten == 0 ? -EPIPE : nwritten;
         }
 
-      /* Calculate the write index AFTER the next byte is written */
+#ifdef CONFIG_DEV_PIPE_DIRECT
+      /* If a reader waits on the empty pipe, give the data to it
+       * directly.
+       */
 
-      nxtwrndx = dev->d_wrndx + 1;
-      if (nxtwrndx >= dev->d_bufsize)
+      if (dev->d_reader != NULL && dev->d_wrndx == dev->d_rdndx)
         {
-          nxtwrndx = 0;
+          FAR struct pipe_reader_s *reader = dev->d_reader;
+          size_t ncopy = len - nwritten;
+
+          if (ncopy > reader->r_len)
+            {
+              ncopy = reader->r_len;
+            }
+
+          memcpy(reader->r_buffer, buffer, ncopy);
+          reader->r_copied = ncopy;
+          dev->d_reader    = NULL;
+
+          buffer   += ncopy;
+          nwritten += ncopy;
+          last      = nwritten;
+
+          while (nxsem_get_value(&dev->d_rdsem, &sval) == 0 && sval <= 0)
+            {
+              nxsem_post(&dev->d_rdsem);
+            }
+
+          if ((size_t)nwritten >= len)
+            {
+              nxsem_post(&dev->d_bfsem);
+              return len;
+            }
+
+          continue;
+        }
+#endif
+
+      /* Get the size of the free space that follows the write index
+       * without wrapping around.  One byte always stays free so that a full
+       * buffer can be told from an empty one.
+       */
+
+      if (dev->d_wrndx >= dev->d_rdndx)
+        {
+          nfree = dev->d_bufsize - dev->d_wrndx;
+          if (dev->d_rdndx == 0)
+            {
+              nfree--;
+            }
+        }
+      else
+        {
+          nfree = dev->d_rdndx - dev->d_wrndx - 1;
         }
 
       /* Would the next write overflow the circular buffer? */
 
-      if (nxtwrndx != dev->d_rdndx)
+      if (nfree > 0)
         {
-          /* No... copy the byte */
+          /* No... copy as much as fits into that space */
+
+          if (nfree > len - nwritten)
+            {
+              nfree = len - nwritten;
+            }
+
+          memcpy(&dev->d_buffer[dev->d_wrndx], buffer, nfree);
+          buffer   += nfree;
+          nwritten += nfree;
 
-          dev->d_buffer[dev->d_wrndx] = *buffer++;
-          dev->d_wrndx = nxtwrndx;
+          dev->d_wrndx += nfree;
+          if (dev->d_wrndx >= dev->d_bufsize)
+            {
+              dev->d_wrndx = 0;
+            }
 
           /* Is the write complete? */
 
-          nwritten++;
           if ((size_t)nwritten >= len)
             {
               /* Notify all poll/select waiters that they can read from the
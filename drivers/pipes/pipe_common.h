@@ -106,6 +106,17 @@ typedef uint16_t pipe_ndx_t;  /* 16-bit index */
 typedef uint8_t pipe_ndx_t;   /*  8-bit index */
 #endif
 
+#ifdef CONFIG_DEV_PIPE_DIRECT
+/* A reader waiting on an empty pipe offers its buffer to the writers */
+
+struct pipe_reader_s
+{
+  FAR char  *r_buffer;      /* The buffer of the waiting reader */
+  size_t     r_len;         /* The size of r_buffer */
+  size_t     r_copied;      /* Bytes that a writer has copied to r_buffer */
+};
+#endif
+
 /* This structure represents the state of one pipe.  A reference to this
  * structure is retained in the i_private field of the inode whenthe
  * pipe/fifo device is registered.
@@ -123,6 +134,9 @@ struct pipe_dev_s
   uint8_t    d_nreaders;    /* Number of reference counts for read access */
   uint8_t    d_flags;       /* See PIPE_FLAG_* definitions */
   uint8_t   *d_buffer;      /* Buffer allocated when device opened */
+#ifdef CONFIG_DEV_PIPE_DIRECT
+  FAR struct pipe_reader_s *d_reader; /* Reader waiting for direct data */
+#endif
 
   /* The following is a list if poll structures of threads waiting for
    * driver events. The 'struct pollfd' reference for each open is also
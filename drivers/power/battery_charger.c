@@ -122,12 +122,7 @@ static int battery_charger_notify(FAR struct battery_charger_priv_s *priv,
   priv->mask |= mask;
   if (priv->mask)
     {
-      fd->revents |= POLLIN;
-      nxsem_get_value(fd->sem, &semcnt);
-      if (semcnt < 1)
-        {
-          nxsem_post(fd->sem);
-        }
+      poll_notify(&fd, 1, POLLIN);
 
       nxsem_get_value(&priv->wait, &semcnt);
       if (semcnt < 1)
@@ -0,0 +1,528 @@
+/****************************************************************************
+ * drivers/power/cpufreq.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/power/cpufreq.h>
+#include <nuttx/power/pm.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_CPUFREQ_DEFAULT_GOVERNOR_ONDEMAND)
+#  define CPUFREQ_DEFAULT_GOVERNOR CPUFREQ_GOVERNOR_ONDEMAND
+#elif defined(CONFIG_CPUFREQ_DEFAULT_GOVERNOR_USERSPACE)
+#  define CPUFREQ_DEFAULT_GOVERNOR CPUFREQ_GOVERNOR_USERSPACE
+#elif defined(CONFIG_CPUFREQ_DEFAULT_GOVERNOR_POWERSAVE)
+#  define CPUFREQ_DEFAULT_GOVERNOR CPUFREQ_GOVERNOR_POWERSAVE
+#else
+#  define CPUFREQ_DEFAULT_GOVERNOR CPUFREQ_GOVERNOR_PERFORMANCE
+#endif
+
+#define CPUFREQ_MIN(cf) ((cf)->lower->table[0])
+#define CPUFREQ_MAX(cf) ((cf)->lower->table[(cf)->lower->ntable - 1])
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct cpufreq_s
+{
+  FAR struct cpufreq_lowerhalf_s *lower; /* The core clock driver */
+  uint32_t                freq;          /* The current frequency, in Hz */
+  enum cpufreq_governor_e governor;      /* The active governor */
+  dq_queue_t              notifiers;     /* The registered notifiers */
+#ifdef CONFIG_CPUFREQ_GOVERNOR_ONDEMAND
+  struct work_s           work;          /* Samples the CPU load */
+  bool                    suspended;     /* Sampling stopped in low power */
+#endif
+#if defined(CONFIG_PM) && defined(CONFIG_CPUFREQ_GOVERNOR_ONDEMAND)
+  struct pm_callback_s    pmcb;          /* Follows the PM state changes */
+#endif
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static uint32_t cpufreq_resolve(FAR struct cpufreq_s *cf, uint32_t freq);
+static int      cpufreq_target(FAR struct cpufreq_s *cf, uint32_t freq);
+static void     cpufreq_apply(FAR struct cpufreq_s *cf);
+#ifdef CONFIG_CPUFREQ_GOVERNOR_ONDEMAND
+static uint32_t cpufreq_load(void);
+static void     cpufreq_ondemand_worker(FAR void *arg);
+#endif
+#if defined(CONFIG_PM) && defined(CONFIG_CPUFREQ_GOVERNOR_ONDEMAND)
+static void     cpufreq_pm_notify(FAR struct pm_callback_s *cb, int domain,
+                                  enum pm_state_e pmstate);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct cpufreq_s g_cpufreq;
+static sem_t g_cpufreq_sem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cpufreq_resolve
+ *
+ * Description:
+ *   Return the lowest supported frequency that is not below freq, or the
+ *   highest one.
+ *
+ ****************************************************************************/
+
+static uint32_t cpufreq_resolve(FAR struct cpufreq_s *cf, uint32_t freq)
+{
+  int i;
+
+  for (i = 0; i < cf->lower->ntable - 1; i++)
+    {
+      if (cf->lower->table[i] >= freq)
+        {
+          break;
+        }
+    }
+
+  return cf->lower->table[i];
+}
+
+/****************************************************************************
+ * Name: cpufreq_target
+ *
+ * Description:
+ *   Switch to the supported frequency closest above freq and tell the
+ *   notifiers.  Called with g_cpufreq_sem held.
+ *
+ ****************************************************************************/
+
+static int cpufreq_target(FAR struct cpufreq_s *cf, uint32_t freq)
+{
+  FAR struct cpufreq_lowerhalf_s *lower = cf->lower;
+  FAR struct cpufreq_notifier_s *nb;
+  FAR dq_entry_t *entry;
+  struct cpufreq_freqs_s freqs;
+  int ret;
+
+  freqs.oldfreq = cf->freq;
+  freqs.newfreq = cpufreq_resolve(cf, freq);
+  if (freqs.newfreq == freqs.oldfreq)
+    {
+      return OK;
+    }
+
+  for (entry = dq_peek(&cf->notifiers); entry; entry = dq_next(entry))
+    {
+      nb = (FAR struct cpufreq_notifier_s *)entry;
+      nb->notify(nb, CPUFREQ_PRECHANGE, &freqs);
+    }
+
+  ret = lower->ops->set_freq(lower, freqs.newfreq);
+  if (ret < 0)
+    {
+      pwrwarn("WARNING: Failed to set %" PRIu32 " Hz: %d\n",
+              freqs.newfreq, ret);
+      freqs.newfreq = freqs.oldfreq;
+    }
+
+  cf->freq = freqs.newfreq;
+
+  for (entry = dq_peek(&cf->notifiers); entry; entry = dq_next(entry))
+    {
+      nb = (FAR struct cpufreq_notifier_s *)entry;
+      nb->notify(nb, CPUFREQ_POSTCHANGE, &freqs);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: cpufreq_apply
+ *
+ * Description:
+ *   Put the frequency in line with the current governor.  Called with
+ *   g_cpufreq_sem held.
+ *
+ ****************************************************************************/
+
+static void cpufreq_apply(FAR struct cpufreq_s *cf)
+{
+#ifdef CONFIG_CPUFREQ_GOVERNOR_ONDEMAND
+  work_cancel(LPWORK, &cf->work);
+#endif
+
+  switch (cf->governor)
+    {
+      case CPUFREQ_GOVERNOR_PERFORMANCE:
+        cpufreq_target(cf, CPUFREQ_MAX(cf));
+        break;
+
+      case CPUFREQ_GOVERNOR_POWERSAVE:
+        cpufreq_target(cf, CPUFREQ_MIN(cf));
+        break;
+
+#ifdef CONFIG_CPUFREQ_GOVERNOR_ONDEMAND
+      case CPUFREQ_GOVERNOR_ONDEMAND:
+        work_queue(LPWORK, &cf->work, cpufreq_ondemand_worker, cf, 0);
+        break;
+#endif
+
+      default:
+        break;
+    }
+}
+
+#ifdef CONFIG_CPUFREQ_GOVERNOR_ONDEMAND
+/****************************************************************************
+ * Name: cpufreq_load
+ *
+ * Description:
+ *   Return the load of the busiest CPU, in percent.  The load of a CPU is
+ *   the share of the time its IDLE thread did not run, as measured by
+ *   the CPU load monitor.
+ *
+ ****************************************************************************/
+
+static uint32_t cpufreq_load(void)
+{
+  struct cpuload_s cpuload;
+  uint32_t maxload = 0;
+  uint32_t load;
+  int cpu;
+
+  /* The IDLE thread of each CPU has the PID of the CPU */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (clock_cpuload(cpu, &cpuload) < 0 || cpuload.total == 0)
+        {
+          continue;
+        }
+
+      load = 100 - (uint32_t)((uint64_t)cpuload.active * 100 /
+                              cpuload.total);
+      if (load > maxload)
+        {
+          maxload = load;
+        }
+    }
+
+  return maxload;
+}
+
+/****************************************************************************
+ * Name: cpufreq_ondemand_worker
+ *
+ * Description:
+ *   Go straight to the highest frequency when the load reaches the up
+ *   threshold.  Below it, pick the lowest frequency that would keep the
+ *   same work at the threshold.
+ *
+ ****************************************************************************/
+
+static void cpufreq_ondemand_worker(FAR void *arg)
+{
+  FAR struct cpufreq_s *cf = arg;
+  uint32_t load;
+  uint32_t freq;
+
+  nxsem_wait_uninterruptible(&g_cpufreq_sem);
+
+  if (cf->lower == NULL || cf->governor != CPUFREQ_GOVERNOR_ONDEMAND ||
+      cf->suspended)
+    {
+      goto out;
+    }
+
+  load = cpufreq_load();
+  if (load >= CONFIG_CPUFREQ_ONDEMAND_UP_THRESHOLD)
+    {
+      freq = CPUFREQ_MAX(cf);
+    }
+  else
+    {
+      freq = (uint64_t)cf->freq * load /
+             CONFIG_CPUFREQ_ONDEMAND_UP_THRESHOLD;
+    }
+
+  cpufreq_target(cf, freq);
+
+  work_queue(LPWORK, &cf->work, cpufreq_ondemand_worker, cf,
+             MSEC2TICK(CONFIG_CPUFREQ_ONDEMAND_SAMPLING_MS));
+
+out:
+  nxsem_post(&g_cpufreq_sem);
+}
+#endif
+
+#if defined(CONFIG_PM) && defined(CONFIG_CPUFREQ_GOVERNOR_ONDEMAND)
+/****************************************************************************
+ * Name: cpufreq_pm_notify
+ *
+ * Description:
+ *   Stop sampling the load in the STANDBY and SLEEP states, so that the
+ *   governor does not keep waking the system up, and start again when it
+ *   returns to NORMAL.  This runs in the context of the PM governor, so it
+ *   must not block.
+ *
+ ****************************************************************************/
+
+static void cpufreq_pm_notify(FAR struct pm_callback_s *cb, int domain,
+                              enum pm_state_e pmstate)
+{
+  FAR struct cpufreq_s *cf = &g_cpufreq;
+
+  /* Only the IDLE domain (zero) says whether the CPU is in use */
+
+  if (domain != 0 || cf->governor != CPUFREQ_GOVERNOR_ONDEMAND)
+    {
+      return;
+    }
+
+  switch (pmstate)
+    {
+      case PM_STANDBY:
+      case PM_SLEEP:
+        if (!cf->suspended)
+          {
+            cf->suspended = true;
+            work_cancel(LPWORK, &cf->work);
+          }
+        break;
+
+      case PM_NORMAL:
+        if (cf->suspended)
+          {
+            cf->suspended = false;
+            work_queue(LPWORK, &cf->work, cpufreq_ondemand_worker, cf, 0);
+          }
+        break;
+
+      default:
+        break;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cpufreq_register
+ ****************************************************************************/
+
+int cpufreq_register(FAR struct cpufreq_lowerhalf_s *lower)
+{
+  FAR struct cpufreq_s *cf = &g_cpufreq;
+  int ret = OK;
+
+  if (lower == NULL || lower->ops == NULL ||
+      lower->ops->set_freq == NULL || lower->ops->get_freq == NULL ||
+      lower->table == NULL || lower->ntable == 0)
+    {
+      return -EINVAL;
+    }
+
+  nxsem_wait_uninterruptible(&g_cpufreq_sem);
+
+  if (cf->lower != NULL)
+    {
+      ret = -EBUSY;
+      goto out;
+    }
+
+  cf->lower    = lower;
+  cf->freq     = lower->ops->get_freq(lower);
+  cf->governor = CPUFREQ_DEFAULT_GOVERNOR;
+
+#ifdef CONFIG_CPUFREQ_GOVERNOR_ONDEMAND
+  cf->suspended = false;
+#endif
+#if defined(CONFIG_PM) && defined(CONFIG_CPUFREQ_GOVERNOR_ONDEMAND)
+  cf->pmcb.notify = cpufreq_pm_notify;
+  pm_register(&cf->pmcb);
+#endif
+
+  pwrinfo("Core clock at %" PRIu32 " Hz\n", cf->freq);
+  cpufreq_apply(cf);
+
+out:
+  nxsem_post(&g_cpufreq_sem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: cpufreq_unregister
+ ****************************************************************************/
+
+int cpufreq_unregister(FAR struct cpufreq_lowerhalf_s *lower)
+{
+  FAR struct cpufreq_s *cf = &g_cpufreq;
+  int ret = OK;
+
+  nxsem_wait_uninterruptible(&g_cpufreq_sem);
+
+  if (cf->lower != lower)
+    {
+      ret = -ENODEV;
+      goto out;
+    }
+
+#ifdef CONFIG_CPUFREQ_GOVERNOR_ONDEMAND
+  work_cancel(LPWORK, &cf->work);
+#endif
+#if defined(CONFIG_PM) && defined(CONFIG_CPUFREQ_GOVERNOR_ONDEMAND)
+  pm_unregister(&cf->pmcb);
+#endif
+
+  cf->lower = NULL;
+
+out:
+  nxsem_post(&g_cpufreq_sem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: cpufreq_get
+ ****************************************************************************/
+
+uint32_t cpufreq_get(void)
+{
+  FAR struct cpufreq_s *cf = &g_cpufreq;
+
+  return cf->lower != NULL ? cf->freq : 0;
+}
+
+/****************************************************************************
+ * Name: cpufreq_set
+ ****************************************************************************/
+
+int cpufreq_set(uint32_t freq)
+{
+  FAR struct cpufreq_s *cf = &g_cpufreq;
+  int ret;
+
+  nxsem_wait_uninterruptible(&g_cpufreq_sem);
+
+  if (cf->lower == NULL)
+    {
+      ret = -ENODEV;
+    }
+  else if (cf->governor != CPUFREQ_GOVERNOR_USERSPACE)
+    {
+      ret = -EPERM;
+    }
+  else
+    {
+      ret = cpufreq_target(cf, freq);
+    }
+
+  nxsem_post(&g_cpufreq_sem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: cpufreq_set_governor
+ ****************************************************************************/
+
+int cpufreq_set_governor(enum cpufreq_governor_e governor)
+{
+  FAR struct cpufreq_s *cf = &g_cpufreq;
+  int ret = OK;
+
+  switch (governor)
+    {
+      case CPUFREQ_GOVERNOR_PERFORMANCE:
+      case CPUFREQ_GOVERNOR_POWERSAVE:
+      case CPUFREQ_GOVERNOR_USERSPACE:
+#ifdef CONFIG_CPUFREQ_GOVERNOR_ONDEMAND
+      case CPUFREQ_GOVERNOR_ONDEMAND:
+#endif
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  nxsem_wait_uninterruptible(&g_cpufreq_sem);
+
+  if (cf->lower == NULL)
+    {
+      ret = -ENODEV;
+    }
+  else if (cf->governor != governor)
+    {
+      cf->governor = governor;
+      cpufreq_apply(cf);
+    }
+
+  nxsem_post(&g_cpufreq_sem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: cpufreq_register_notifier
+ ****************************************************************************/
+
+int cpufreq_register_notifier(FAR struct cpufreq_notifier_s *nb)
+{
+  DEBUGASSERT(nb != NULL && nb->notify != NULL);
+
+  nxsem_wait_uninterruptible(&g_cpufreq_sem);
+  dq_addlast(&nb->entry, &g_cpufreq.notifiers);
+  nxsem_post(&g_cpufreq_sem);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cpufreq_unregister_notifier
+ ****************************************************************************/
+
+int cpufreq_unregister_notifier(FAR struct cpufreq_notifier_s *nb)
+{
+  DEBUGASSERT(nb != NULL);
+
+  nxsem_wait_uninterruptible(&g_cpufreq_sem);
+  dq_rem(&nb->entry, &g_cpufreq.notifiers);
+  nxsem_post(&g_cpufreq_sem);
+
+  return OK;
+}
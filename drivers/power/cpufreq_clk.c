@@ -0,0 +1,122 @@
+/****************************************************************************
+ * drivers/power/cpufreq_clk.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/clk/clk.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/power/cpufreq.h>
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A core clock scaled through the clock framework */
+
+struct cpufreq_clk_s
+{
+  struct cpufreq_lowerhalf_s lower; /* Must be first */
+  FAR struct clk_s *clk;            /* The core clock */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int      cpufreq_clk_set_freq(FAR struct cpufreq_lowerhalf_s *lower,
+                                     uint32_t freq);
+static uint32_t cpufreq_clk_get_freq(FAR struct cpufreq_lowerhalf_s *lower);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct cpufreq_ops_s g_cpufreq_clk_ops =
+{
+  cpufreq_clk_set_freq,  /* set_freq */
+  cpufreq_clk_get_freq   /* get_freq */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int cpufreq_clk_set_freq(FAR struct cpufreq_lowerhalf_s *lower,
+                                uint32_t freq)
+{
+  FAR struct cpufreq_clk_s *priv = (FAR struct cpufreq_clk_s *)lower;
+
+  return clk_set_rate(priv->clk, freq);
+}
+
+static uint32_t cpufreq_clk_get_freq(FAR struct cpufreq_lowerhalf_s *lower)
+{
+  FAR struct cpufreq_clk_s *priv = (FAR struct cpufreq_clk_s *)lower;
+
+  return clk_get_rate(priv->clk);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cpufreq_clk_initialize
+ ****************************************************************************/
+
+FAR struct cpufreq_lowerhalf_s *
+cpufreq_clk_initialize(FAR const char *name, FAR const uint32_t *table,
+                       uint8_t ntable)
+{
+  FAR struct cpufreq_clk_s *priv;
+  FAR struct clk_s *clk;
+
+  if (name == NULL || table == NULL || ntable == 0)
+    {
+      return NULL;
+    }
+
+  clk = clk_get(name);
+  if (clk == NULL)
+    {
+      pwrerr("ERROR: No clock %s\n", name);
+      return NULL;
+    }
+
+  priv = kmm_zalloc(sizeof(struct cpufreq_clk_s));
+  if (priv == NULL)
+    {
+      return NULL;
+    }
+
+  priv->lower.ops    = &g_cpufreq_clk_ops;
+  priv->lower.table  = table;
+  priv->lower.ntable = ntable;
+  priv->clk          = clk;
+
+  return &priv->lower;
+}
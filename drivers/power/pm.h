@@ -72,6 +72,17 @@ struct pm_domain_s
   /* A pointer to the PM governor instance */
 
   FAR const struct pm_governor_s *governor;
+
+#ifdef CONFIG_PM_QOS
+  /* The list of active latency constraints, the tightest of them (in
+   * microseconds), and the latency table of the states provided by the
+   * board.
+   */
+
+  dq_queue_t qos;
+  uint32_t qoslatency;
+  FAR const struct pm_latency_s *latency;
+#endif
 };
 
 /* This structure encapsulates all of the global data used by the PM system */
@@ -137,6 +148,20 @@ irqstate_t pm_lock(void);
 
 void pm_unlock(irqstate_t flags);
 
+/****************************************************************************
+ * Name: pm_qos_constrain
+ *
+ * Description:
+ *   Return the deepest state not deeper than 'state' whose entry and exit
+ *   latency is compatible with the active latency constraints of the
+ *   domain.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PM_QOS
+enum pm_state_e pm_qos_constrain(int domain, enum pm_state_e state);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
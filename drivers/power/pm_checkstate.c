@@ -71,14 +71,22 @@
 
 enum pm_state_e pm_checkstate(int domain)
 {
+  enum pm_state_e state = PM_NORMAL;
+
   DEBUGASSERT(domain >= 0 && domain < CONFIG_PM_NDOMAINS);
 
   if (g_pmglobals.domain[domain].governor->checkstate)
     {
-      return g_pmglobals.domain[domain].governor->checkstate(domain);
+      state = g_pmglobals.domain[domain].governor->checkstate(domain);
     }
 
-  return PM_NORMAL;
+#ifdef CONFIG_PM_QOS
+  /* Don't go deeper than the latency constraints allow */
+
+  state = pm_qos_constrain(domain, state);
+#endif
+
+  return state;
 }
 
 #endif /* CONFIG_PM */
@@ -24,6 +24,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 #include <nuttx/power/pm.h>
 
 #include "pm.h"
@@ -87,6 +89,12 @@ void pm_initialize(void)
       gov = &null;
 #endif
       pm_set_governor(i, gov);
+
+#ifdef CONFIG_PM_QOS
+      /* No latency constraint yet */
+
+      g_pmglobals.domain[i].qoslatency = UINT32_MAX;
+#endif
     }
 }
 
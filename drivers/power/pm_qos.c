@@ -0,0 +1,211 @@
+/****************************************************************************
+ * drivers/power/pm_qos.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/power/pm.h>
+#include <nuttx/irq.h>
+
+#include "pm.h"
+
+#ifdef CONFIG_PM_QOS
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pm_qos_recalc
+ *
+ * Description:
+ *   Recompute the tightest latency constraint of the domain.  Called with
+ *   the PM lock held.
+ *
+ ****************************************************************************/
+
+static void pm_qos_recalc(FAR struct pm_domain_s *pdom)
+{
+  FAR struct pm_qos_s *qos;
+  uint32_t latency = UINT32_MAX;
+
+  for (qos = (FAR struct pm_qos_s *)dq_peek(&pdom->qos);
+       qos != NULL;
+       qos = (FAR struct pm_qos_s *)dq_next(&qos->entry))
+    {
+      if (qos->latency < latency)
+        {
+          latency = qos->latency;
+        }
+    }
+
+  pdom->qoslatency = latency;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pm_set_latency
+ *
+ * Description:
+ *   This function is called by board-specific logic to describe the entry
+ *   and exit latency of the power management states of a domain.
+ *
+ ****************************************************************************/
+
+void pm_set_latency(int domain, FAR const struct pm_latency_s *latency)
+{
+  DEBUGASSERT(domain >= 0 && domain < CONFIG_PM_NDOMAINS);
+
+  g_pmglobals.domain[domain].latency = latency;
+  pm_auto_updatestate(domain);
+}
+
+/****************************************************************************
+ * Name: pm_qos_add
+ *
+ * Description:
+ *   Add a constraint on the wakeup latency of the domain.
+ *
+ ****************************************************************************/
+
+void pm_qos_add(int domain, FAR struct pm_qos_s *qos, uint32_t latency)
+{
+  FAR struct pm_domain_s *pdom;
+  irqstate_t flags;
+
+  DEBUGASSERT(domain >= 0 && domain < CONFIG_PM_NDOMAINS && qos != NULL);
+  pdom = &g_pmglobals.domain[domain];
+
+  flags = pm_lock();
+  qos->latency = latency;
+  dq_addlast(&qos->entry, &pdom->qos);
+  if (latency < pdom->qoslatency)
+    {
+      pdom->qoslatency = latency;
+    }
+
+  pm_unlock(flags);
+
+  pm_auto_updatestate(domain);
+}
+
+/****************************************************************************
+ * Name: pm_qos_update
+ *
+ * Description:
+ *   Change the latency of a constraint of the domain.
+ *
+ ****************************************************************************/
+
+void pm_qos_update(int domain, FAR struct pm_qos_s *qos, uint32_t latency)
+{
+  FAR struct pm_domain_s *pdom;
+  irqstate_t flags;
+
+  DEBUGASSERT(domain >= 0 && domain < CONFIG_PM_NDOMAINS && qos != NULL);
+  pdom = &g_pmglobals.domain[domain];
+
+  flags = pm_lock();
+  qos->latency = latency;
+  pm_qos_recalc(pdom);
+  pm_unlock(flags);
+
+  pm_auto_updatestate(domain);
+}
+
+/****************************************************************************
+ * Name: pm_qos_remove
+ *
+ * Description:
+ *   Remove a constraint from the domain.
+ *
+ ****************************************************************************/
+
+void pm_qos_remove(int domain, FAR struct pm_qos_s *qos)
+{
+  FAR struct pm_domain_s *pdom;
+  irqstate_t flags;
+
+  DEBUGASSERT(domain >= 0 && domain < CONFIG_PM_NDOMAINS && qos != NULL);
+  pdom = &g_pmglobals.domain[domain];
+
+  flags = pm_lock();
+  dq_rem(&qos->entry, &pdom->qos);
+  pm_qos_recalc(pdom);
+  pm_unlock(flags);
+
+  pm_auto_updatestate(domain);
+}
+
+/****************************************************************************
+ * Name: pm_qos_latency
+ *
+ * Description:
+ *   Return the tightest active latency constraint of the domain.
+ *
+ ****************************************************************************/
+
+uint32_t pm_qos_latency(int domain)
+{
+  DEBUGASSERT(domain >= 0 && domain < CONFIG_PM_NDOMAINS);
+
+  return g_pmglobals.domain[domain].qoslatency;
+}
+
+/****************************************************************************
+ * Name: pm_qos_constrain
+ *
+ * Description:
+ *   Return the deepest state not deeper than 'state' whose entry and exit
+ *   latency is compatible with the active latency constraints of the
+ *   domain.  Called from pm_checkstate().
+ *
+ ****************************************************************************/
+
+enum pm_state_e pm_qos_constrain(int domain, enum pm_state_e state)
+{
+  FAR struct pm_domain_s *pdom = &g_pmglobals.domain[domain];
+  FAR const struct pm_latency_s *latency = pdom->latency;
+  uint32_t limit = pdom->qoslatency;
+
+  if (latency != NULL && limit != UINT32_MAX)
+    {
+      /* The sum is done in 64 bit so that large table values can't wrap */
+
+      while (state > PM_NORMAL &&
+             (uint64_t)latency[state].entry + latency[state].exit > limit)
+        {
+          state--;
+        }
+    }
+
+  return state;
+}
+
+#endif /* CONFIG_PM_QOS */
@@ -116,23 +116,7 @@ static const struct file_operations g_lirc_fops =
 static void lirc_pollnotify(FAR struct lirc_fh_s *fh,
                             pollevent_t eventset)
 {
-  int semcount;
-
-  if (fh->fd)
-    {
-      fh->fd->revents |= (fh->fd->events & eventset);
-
-      if (fh->fd->revents != 0)
-        {
-          rcinfo("Report events: %08" PRIx32 "\n", fh->fd->revents);
-
-          nxsem_get_value(fh->fd->sem, &semcount);
-          if (semcount < 1)
-            {
-              nxsem_post(fh->fd->sem);
-            }
-        }
-    }
+  poll_notify(&fh->fd, 1, eventset);
 }
 
 static int lirc_open(FAR struct file *filep)
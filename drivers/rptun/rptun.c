@@ -84,6 +84,10 @@ struct rptun_priv_s
 #ifdef CONFIG_RPTUN_PM
   bool                         stay;
 #endif
+#ifdef CONFIG_RPTUN_NOTIFY_BATCH
+  unsigned int                 hold;     /* Notifications are deferred */
+  bool                         pending;  /* A notification was deferred */
+#endif
 #ifdef CONFIG_RPTUN_PING
   struct rpmsg_endpoint        ping;
 #endif
@@ -287,6 +291,87 @@ static inline void rptun_pm_action(FAR struct rptun_priv_s *priv,
 #  define rptun_pm_action(priv, stay)
 #endif
 
+/* With CONFIG_RPTUN_NOTIFY_BATCH, the notifications of the remote are
+ * deferred while the received messages are dispatched and between
+ * rpmsg_batch_begin() and rpmsg_batch_end(), so that the replies and the
+ * returned buffers of a whole batch cost a single interrupt of the remote.
+ * The deferred notification is sent before waiting for the remote.
+ */
+
+#ifdef CONFIG_RPTUN_NOTIFY_BATCH
+static void rptun_notify_hold(FAR struct rptun_priv_s *priv)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  priv->hold++;
+  leave_critical_section(flags);
+}
+
+static void rptun_notify_flush(FAR struct rptun_priv_s *priv)
+{
+  irqstate_t flags;
+  bool pending;
+
+  flags = enter_critical_section();
+  pending = priv->pending;
+  priv->pending = false;
+  leave_critical_section(flags);
+
+  if (pending)
+    {
+      RPTUN_NOTIFY(priv->dev, RPTUN_NOTIFY_ALL);
+    }
+}
+
+static void rptun_notify_release(FAR struct rptun_priv_s *priv)
+{
+  irqstate_t flags;
+  bool pending;
+
+  flags = enter_critical_section();
+  if (priv->hold > 0)
+    {
+      priv->hold--;
+    }
+
+  pending = priv->hold == 0 && priv->pending;
+  if (pending)
+    {
+      priv->pending = false;
+    }
+
+  leave_critical_section(flags);
+
+  if (pending)
+    {
+      RPTUN_NOTIFY(priv->dev, RPTUN_NOTIFY_ALL);
+    }
+}
+
+static bool rptun_notify_defer(FAR struct rptun_priv_s *priv)
+{
+  irqstate_t flags;
+  bool defer;
+
+  flags = enter_critical_section();
+  defer = priv->hold > 0;
+  if (defer)
+    {
+      priv->pending = true;
+    }
+
+  leave_critical_section(flags);
+  return defer;
+}
+
+#else
+#  define rptun_notify_hold(priv)
+#  define rptun_notify_flush(priv)
+#  define rptun_notify_release(priv)
+#  define rptun_notify_defer(priv) false
+#endif
+
 static void rptun_worker(FAR void *arg)
 {
   FAR struct rptun_priv_s *priv = arg;
@@ -309,7 +394,10 @@ static void rptun_worker(FAR void *arg)
     }
 
   priv->cmd = RPTUNIOC_NONE;
+
+  rptun_notify_hold(priv);
   remoteproc_get_notification(&priv->rproc, RPTUN_NOTIFY_ALL);
+  rptun_notify_release(priv);
 
   rptun_pm_action(priv, false);
 }
@@ -441,7 +529,11 @@ static int rptun_notify(FAR struct remoteproc *rproc, uint32_t id)
       rptun_pm_action(priv, true);
     }
 
-  RPTUN_NOTIFY(priv->dev, RPTUN_NOTIFY_ALL);
+  if (!rptun_notify_defer(priv))
+    {
+      RPTUN_NOTIFY(priv->dev, RPTUN_NOTIFY_ALL);
+    }
+
   return 0;
 }
 
@@ -488,6 +580,10 @@ static int rptun_wait_tx_buffer(FAR struct remoteproc *rproc)
 {
   FAR struct rptun_priv_s *priv = rproc->priv;
 
+  /* The remote frees TX buffers only after it has seen what was sent */
+
+  rptun_notify_flush(priv);
+
   if (!rptun_is_recursive(priv))
     {
       return -EAGAIN;
@@ -1033,6 +1129,7 @@ int rpmsg_wait(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem)
           break;
         }
 
+      rptun_notify_flush(priv);
       nxsem_wait(&priv->sem);
       rptun_worker(priv);
     }
@@ -1063,6 +1160,28 @@ int rpmsg_post(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem)
   return ret;
 }
 
+#ifdef CONFIG_RPTUN_NOTIFY_BATCH
+void rpmsg_batch_begin(FAR struct rpmsg_endpoint *ept)
+{
+  FAR struct rptun_priv_s *priv = rptun_get_priv_by_rdev(ept->rdev);
+
+  if (priv)
+    {
+      rptun_notify_hold(priv);
+    }
+}
+
+void rpmsg_batch_end(FAR struct rpmsg_endpoint *ept)
+{
+  FAR struct rptun_priv_s *priv = rptun_get_priv_by_rdev(ept->rdev);
+
+  if (priv)
+    {
+      rptun_notify_release(priv);
+    }
+}
+#endif
+
 FAR const char *rpmsg_get_cpuname(FAR struct rpmsg_device *rdev)
 {
   FAR struct rptun_priv_s *priv = rptun_get_priv_by_rdev(rdev);
@@ -290,7 +290,7 @@ static void hcsr04_notify(FAR struct hcsr04_dev_s *priv)
         {
           fds->revents |= POLLIN;
           hcsr04_dbg("Report events: %08" PRIx32 "\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 }
@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
@@ -35,6 +36,7 @@
 #include <poll.h>
 #include <fcntl.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/list.h>
 #include <nuttx/mm/circbuf.h>
 #include <nuttx/sensors/sensor.h>
 
@@ -61,20 +63,37 @@ struct sensor_info
   FAR char *name;
 };
 
+/* This structure describes one subscriber, that is one open file of the
+ * sensor device.  The events are stored once in the circular buffer of
+ * the upper half and each subscriber reads them through its own cursor.
+ */
+
+struct sensor_user_s
+{
+  struct list_node   node;               /* Node in the list of subscribers */
+  FAR struct pollfd *fds;                /* The poll structure of user */
+  sem_t              buffersem;          /* Wakeup subscriber waiting data */
+  size_t             bufferpos;          /* The position of next event */
+  unsigned long      skip;               /* Events to skip before next one */
+  unsigned int       interval;           /* The interval requested, in us */
+  unsigned int       latency;            /* The latency requested, in us */
+  uint32_t           overrun;            /* Events overwritten before read */
+  bool               enabled;            /* The subscriber activated sensor */
+};
+
 /* This structure describes the state of the upper half driver */
 
 struct sensor_upperhalf_s
 {
-  /* poll structures of threads waiting for driver events. */
-
-  FAR struct pollfd             *fds[CONFIG_SENSORS_NPOLLWAITERS];
   FAR struct sensor_lowerhalf_s *lower;  /* the handle of lower half driver */
+  struct list_node   userlist;           /* The list of subscribers */
   struct circbuf_s   buffer;             /* The circular buffer of sensor device */
   uint8_t            esize;              /* The element size of circular buffer */
   uint8_t            crefs;              /* Number of times the device has been opened */
+  uint8_t            nactive;            /* Number of active subscribers */
   sem_t              exclsem;            /* Manages exclusive access to file operations */
-  sem_t              buffersem;          /* Wakeup user waiting for data in circular buffer */
   bool               enabled;            /* The status of sensor enable or disable */
+  bool               mapped;             /* The buffer is mapped by mmap() */
   unsigned int       interval;           /* The sample interval for sensor, in us */
   unsigned int       latency;            /* The batch latency for sensor, in us */
 };
@@ -83,8 +102,24 @@ struct sensor_upperhalf_s
  * Private Function Prototypes
  ****************************************************************************/
 
-static void    sensor_pollnotify(FAR struct sensor_upperhalf_s *upper,
+static void    sensor_pollnotify(FAR struct sensor_user_s *user,
                                  pollevent_t eventset);
+static unsigned long sensor_step(FAR struct sensor_upperhalf_s *upper,
+                                 FAR struct sensor_user_s *user);
+static void    sensor_catchup(FAR struct sensor_upperhalf_s *upper,
+                              FAR struct sensor_user_s *user);
+static size_t  sensor_nevents(FAR struct sensor_upperhalf_s *upper,
+                              FAR struct sensor_user_s *user);
+static bool    sensor_is_ready(FAR struct sensor_upperhalf_s *upper,
+                               FAR struct sensor_user_s *user);
+static void    sensor_wakeup(FAR struct sensor_user_s *user);
+static int     sensor_resize(FAR struct sensor_upperhalf_s *upper,
+                             size_t bytes);
+static size_t  sensor_bufsize(FAR struct sensor_upperhalf_s *upper);
+static int     sensor_update_interval(FAR struct sensor_upperhalf_s *upper);
+static int     sensor_update_latency(FAR struct sensor_upperhalf_s *upper);
+static int     sensor_activate(FAR struct sensor_upperhalf_s *upper,
+                               FAR struct sensor_user_s *user, bool enable);
 static int     sensor_open(FAR struct file *filep);
 static int     sensor_close(FAR struct file *filep);
 static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
@@ -151,32 +186,309 @@ static const struct file_operations g_sensor_fops =
  * Private Functions
  ****************************************************************************/
 
-static void sensor_pollnotify(FAR struct sensor_upperhalf_s *upper,
+static void sensor_pollnotify(FAR struct sensor_user_s *user,
                               pollevent_t eventset)
 {
-  FAR struct pollfd *fd;
+  poll_notify(&user->fds, 1, eventset);
+}
+
+/* A subscriber that asked for a longer interval than the sensor runs at
+ * only gets every step'th event.
+ */
+
+static unsigned long sensor_step(FAR struct sensor_upperhalf_s *upper,
+                                 FAR struct sensor_user_s *user)
+{
+  if (upper->interval > 0 && user->interval > upper->interval)
+    {
+      return user->interval / upper->interval;
+    }
+
+  return 1;
+}
+
+/* Move the cursor of a subscriber past the events that were overwritten
+ * before it read them.
+ */
+
+static void sensor_catchup(FAR struct sensor_upperhalf_s *upper,
+                           FAR struct sensor_user_s *user)
+{
+  if (user->bufferpos < upper->buffer.tail)
+    {
+      user->overrun  += (upper->buffer.tail - user->bufferpos) /
+                        upper->esize;
+      user->bufferpos = upper->buffer.tail;
+    }
+}
+
+/* Return the number of events the subscriber can read now */
+
+static size_t sensor_nevents(FAR struct sensor_upperhalf_s *upper,
+                             FAR struct sensor_user_s *user)
+{
+  size_t avail = (upper->buffer.head - user->bufferpos) / upper->esize;
+
+  if (avail <= user->skip)
+    {
+      return 0;
+    }
+
+  return (avail - user->skip - 1) / sensor_step(upper, user) + 1;
+}
+
+/* In batch mode a subscriber is only notified once the events of its
+ * whole batch latency are buffered, or before its oldest unread events
+ * would be overwritten.
+ */
+
+static bool sensor_is_ready(FAR struct sensor_upperhalf_s *upper,
+                            FAR struct sensor_user_s *user)
+{
+  unsigned long interval;
+  size_t watermark = 1;
+  size_t nevents;
+
+  sensor_catchup(upper, user);
+  nevents = sensor_nevents(upper, user);
+  if (nevents == 0)
+    {
+      return false;
+    }
+
+  interval = sensor_step(upper, user) * upper->interval;
+  if (user->latency > 0 && interval > 0)
+    {
+      watermark = ROUNDUP(user->latency, interval) / interval;
+    }
+
+  return nevents >= watermark ||
+         upper->buffer.head - user->bufferpos >=
+         circbuf_size(&upper->buffer);
+}
+
+static void sensor_wakeup(FAR struct sensor_user_s *user)
+{
   int semcount;
-  int i;
 
-  for (i = 0; i < CONFIG_SENSORS_NPOLLWAITERS; i++)
+  sensor_pollnotify(user, POLLIN);
+  nxsem_get_value(&user->buffersem, &semcount);
+  if (semcount < 1)
+    {
+      nxsem_post(&user->buffersem);
+    }
+}
+
+/* Resize the circular buffer and keep the cursors of the subscribers on
+ * the same events.  The buffer can't move once it is mapped by an
+ * application, so it is only allowed to keep its size or to stay bigger
+ * than needed until the last close.
+ */
+
+static int sensor_resize(FAR struct sensor_upperhalf_s *upper, size_t bytes)
+{
+  FAR struct sensor_user_s *user;
+  size_t oldhead = upper->buffer.head;
+  size_t delta;
+  int ret;
+
+  if (upper->mapped)
+    {
+      return bytes > circbuf_size(&upper->buffer) ? -EBUSY : OK;
+    }
+
+  list_for_every_entry(&upper->userlist, user, struct sensor_user_s, node)
+    {
+      sensor_catchup(upper, user);
+    }
+
+  ret = circbuf_resize(&upper->buffer, bytes);
+  if (ret < 0)
     {
-      fd = upper->fds[i];
-      if (fd)
+      return ret;
+    }
+
+  /* circbuf_resize() keeps the newest events and restarts the counters */
+
+  delta = oldhead - upper->buffer.head;
+  list_for_every_entry(&upper->userlist, user, struct sensor_user_s, node)
+    {
+      if (user->bufferpos < delta)
+        {
+          user->overrun  += (delta - user->bufferpos) / upper->esize;
+          user->bufferpos = 0;
+        }
+      else
         {
-          fd->revents |= (fd->events & eventset);
+          user->bufferpos -= delta;
+        }
+    }
 
-          if (fd->revents != 0)
-            {
-              sninfo("Report events: %08" PRIx32 "\n", fd->revents);
+  return ret;
+}
 
-              nxsem_get_value(fd->sem, &semcount);
-              if (semcount < 1)
-                {
-                  nxsem_post(fd->sem);
-                }
+/* Return the buffer size needed by the longest latency of the
+ * subscribers.
+ */
+
+static size_t sensor_bufsize(FAR struct sensor_upperhalf_s *upper)
+{
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR struct sensor_user_s *user;
+  unsigned int latency = 0;
+  size_t nevents = 0;
+
+  list_for_every_entry(&upper->userlist, user, struct sensor_user_s, node)
+    {
+      if (user->interval != 0 && user->latency > latency)
+        {
+          latency = user->latency;
+        }
+    }
+
+  if (upper->interval != 0)
+    {
+      nevents = ROUNDUP(latency, upper->interval) / upper->interval;
+    }
+
+  return (nevents + lower->buffer_number) * upper->esize;
+}
+
+/* Run the sensor at the shortest interval of the subscribers */
+
+static int sensor_update_interval(FAR struct sensor_upperhalf_s *upper)
+{
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR struct sensor_user_s *user;
+  unsigned int interval = 0;
+  int ret;
+
+  list_for_every_entry(&upper->userlist, user, struct sensor_user_s, node)
+    {
+      if (user->interval != 0 &&
+          (interval == 0 || user->interval < interval))
+        {
+          interval = user->interval;
+        }
+    }
+
+  if (interval == 0 || interval == upper->interval)
+    {
+      return OK;
+    }
+
+  ret = lower->ops->set_interval(lower, &interval);
+  if (ret >= 0)
+    {
+      upper->interval = interval;
+    }
+
+  return ret;
+}
+
+/* Run the sensor at the shortest batch latency of the subscribers and
+ * grow the buffer for the longest one.
+ */
+
+static int sensor_update_latency(FAR struct sensor_upperhalf_s *upper)
+{
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR struct sensor_user_s *user;
+  unsigned int latency = UINT_MAX;
+  size_t bufsize;
+  int ret;
+
+  list_for_every_entry(&upper->userlist, user, struct sensor_user_s, node)
+    {
+      if (user->interval != 0 && user->latency < latency)
+        {
+          latency = user->latency;
+        }
+    }
+
+  if (latency == UINT_MAX)
+    {
+      latency = 0;
+    }
+
+  /* Without hardware batching the upper half still coalesces the
+   * notifications of each subscriber.
+   */
+
+  if (latency != upper->latency)
+    {
+      if (lower->ops->batch != NULL)
+        {
+          ret = lower->ops->batch(lower, &latency);
+          if (ret < 0)
+            {
+              return ret;
             }
         }
+
+      upper->latency = latency;
+    }
+
+  if (lower->ops->fetch)
+    {
+      return OK;
     }
+
+  bufsize = sensor_bufsize(upper);
+  if (bufsize > circbuf_size(&upper->buffer))
+    {
+      return sensor_resize(upper, bufsize);
+    }
+
+  return OK;
+}
+
+static int sensor_activate(FAR struct sensor_upperhalf_s *upper,
+                           FAR struct sensor_user_s *user, bool enable)
+{
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  int ret;
+
+  if (user->enabled == enable)
+    {
+      return OK;
+    }
+
+  /* The first subscriber starts the sensor and the last one stops it */
+
+  if (upper->nactive == (enable ? 0 : 1))
+    {
+      ret = lower->ops->activate ?
+            lower->ops->activate(lower, enable) : -ENOTSUP;
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      upper->enabled = enable;
+    }
+
+  user->enabled = enable;
+  if (enable)
+    {
+      upper->nactive++;
+      return OK;
+    }
+
+  upper->nactive--;
+  user->interval = 0;
+  user->latency  = 0;
+
+  if (upper->nactive > 0)
+    {
+      sensor_update_interval(upper);
+      return sensor_update_latency(upper);
+    }
+
+  upper->interval = 0;
+  upper->latency  = 0;
+  return lower->ops->fetch ? OK :
+         sensor_resize(upper, lower->buffer_number * upper->esize);
 }
 
 static int sensor_open(FAR struct file *filep)
@@ -184,13 +496,20 @@ static int sensor_open(FAR struct file *filep)
   FAR struct inode *inode = filep->f_inode;
   FAR struct sensor_upperhalf_s *upper = inode->i_private;
   FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR struct sensor_user_s *user;
   uint8_t tmp;
   int ret;
 
+  user = kmm_zalloc(sizeof(struct sensor_user_s));
+  if (user == NULL)
+    {
+      return -ENOMEM;
+    }
+
   ret = nxsem_wait(&upper->exclsem);
   if (ret < 0)
     {
-      return ret;
+      goto errout_with_user;
     }
 
   tmp = upper->crefs + 1;
@@ -199,7 +518,7 @@ static int sensor_open(FAR struct file *filep)
       /* More than 255 opens; uint8_t overflows to zero */
 
       ret = -EMFILE;
-      goto err;
+      goto errout_with_sem;
     }
   else if (tmp == 1)
     {
@@ -209,13 +528,28 @@ static int sensor_open(FAR struct file *filep)
                          upper->esize);
       if (ret < 0)
         {
-          goto err;
+          goto errout_with_sem;
         }
+
+      upper->mapped = false;
     }
 
-  upper->crefs = tmp;
-err:
+  /* A new subscriber only sees the events published after it opened */
+
+  nxsem_init(&user->buffersem, 0, 0);
+  nxsem_set_protocol(&user->buffersem, SEM_PRIO_NONE);
+  user->bufferpos = upper->buffer.head;
+  list_add_tail(&upper->userlist, &user->node);
+
+  upper->crefs  = tmp;
+  filep->f_priv = user;
+  nxsem_post(&upper->exclsem);
+  return OK;
+
+errout_with_sem:
   nxsem_post(&upper->exclsem);
+errout_with_user:
+  kmm_free(user);
   return ret;
 }
 
@@ -223,7 +557,7 @@ static int sensor_close(FAR struct file *filep)
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct sensor_upperhalf_s *upper = inode->i_private;
-  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR struct sensor_user_s *user = filep->f_priv;
   int ret;
 
   ret = nxsem_wait(&upper->exclsem);
@@ -232,18 +566,17 @@ static int sensor_close(FAR struct file *filep)
       return ret;
     }
 
-  if (--upper->crefs <= 0 && upper->enabled)
+  ret = sensor_activate(upper, user, false);
+
+  list_delete(&user->node);
+  if (--upper->crefs <= 0)
     {
-      ret = lower->ops->activate ?
-            lower->ops->activate(lower, false) : -ENOTSUP;
-      if (ret >= 0)
-        {
-          upper->enabled = false;
-          circbuf_uninit(&upper->buffer);
-        }
+      circbuf_uninit(&upper->buffer);
     }
 
   nxsem_post(&upper->exclsem);
+  nxsem_destroy(&user->buffersem);
+  kmm_free(user);
   return ret;
 }
 
@@ -253,6 +586,13 @@ static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
   FAR struct inode *inode = filep->f_inode;
   FAR struct sensor_upperhalf_s *upper = inode->i_private;
   FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR struct sensor_user_s *user = filep->f_priv;
+  FAR struct sensor_user_s *tmp;
+  unsigned long step;
+  size_t oldest;
+  size_t nbytes;
+  size_t off;
+  size_t n;
   ssize_t ret;
 
   if (!buffer || !len)
@@ -271,7 +611,7 @@ static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
       if (!(filep->f_oflags & O_NONBLOCK))
         {
           nxsem_post(&upper->exclsem);
-          ret = nxsem_wait_uninterruptible(&upper->buffersem);
+          ret = nxsem_wait_uninterruptible(&user->buffersem);
           if (ret < 0)
             {
               return ret;
@@ -293,14 +633,28 @@ static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
     }
   else
     {
+      /* Only whole events are returned */
+
+      if (len < upper->esize)
+        {
+          ret = -EINVAL;
+          goto out;
+        }
+
       /* We must make sure that when the semaphore is equal to 1, there must
-       * be events available in the buffer, so we use a while statement to
-       * synchronize this case that other read operations consume events
-       * that have just entered the buffer.
+       * be events available for this subscriber, so we use a while
+       * statement to synchronize this case that the semaphore was posted
+       * for events that were overwritten since.
        */
 
-      while (circbuf_is_empty(&upper->buffer))
+      for (; ; )
         {
+          sensor_catchup(upper, user);
+          if (sensor_nevents(upper, user) > 0)
+            {
+              break;
+            }
+
           if (filep->f_oflags & O_NONBLOCK)
             {
               ret = -EAGAIN;
@@ -309,7 +663,7 @@ static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
           else
             {
               nxsem_post(&upper->exclsem);
-              ret = nxsem_wait_uninterruptible(&upper->buffersem);
+              ret = nxsem_wait_uninterruptible(&user->buffersem);
               if (ret < 0)
                 {
                   return ret;
@@ -323,19 +677,61 @@ static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
             }
         }
 
-      ret = circbuf_read(&upper->buffer, buffer, len);
+      /* Copy the events from the cursor of this subscriber, skipping the
+       * ones beyond its rate.
+       */
 
-      /* Release some buffer space when current mode isn't batch mode
-       * and last mode is batch mode, and the number of bytes available
-       * in buffer is less than the number of bytes origin.
+      step   = sensor_step(upper, user);
+      nbytes = 0;
+      while (nbytes + upper->esize <= len &&
+             user->bufferpos < upper->buffer.head)
+        {
+          if (user->skip > 0)
+            {
+              user->skip--;
+            }
+          else
+            {
+              off = user->bufferpos % upper->buffer.size;
+              n   = upper->buffer.size - off;
+              if (n > upper->esize)
+                {
+                  n = upper->esize;
+                }
+
+              memcpy(buffer + nbytes, (FAR char *)upper->buffer.base + off,
+                     n);
+              memcpy(buffer + nbytes + n, upper->buffer.base,
+                     upper->esize - n);
+
+              nbytes    += upper->esize;
+              user->skip = step - 1;
+            }
+
+          user->bufferpos += upper->esize;
+        }
+
+      ret = nbytes;
+
+      /* Release some buffer space when the batch latency of subscribers
+       * became shorter and all of them read enough events.
        */
 
-      uint32_t buffer_size = lower->buffer_number * upper->esize;
-      if (upper->latency == 0 &&
-          circbuf_size(&upper->buffer) > buffer_size &&
-          circbuf_used(&upper->buffer) <= buffer_size)
+      oldest = upper->buffer.head;
+      list_for_every_entry(&upper->userlist, tmp, struct sensor_user_s,
+                           node)
+        {
+          if (tmp->bufferpos < oldest)
+            {
+              oldest = tmp->bufferpos;
+            }
+        }
+
+      n = sensor_bufsize(upper);
+      if (circbuf_size(&upper->buffer) > n &&
+          upper->buffer.head - oldest <= n)
         {
-          ret = circbuf_resize(&upper->buffer, buffer_size);
+          sensor_resize(upper, n);
         }
     }
 
@@ -349,7 +745,10 @@ static int sensor_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   FAR struct inode *inode = filep->f_inode;
   FAR struct sensor_upperhalf_s *upper = inode->i_private;
   FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR struct sensor_user_s *user = filep->f_priv;
   FAR unsigned int *val = (unsigned int *)(uintptr_t)arg;
+  FAR struct sensor_state_s *state;
+  size_t avail;
   int ret;
 
   sninfo("cmd=%x arg=%08lx\n", cmd, arg);
@@ -364,24 +763,7 @@ static int sensor_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
     {
       case SNIOC_ACTIVATE:
         {
-          if (upper->enabled == !!arg)
-            {
-              break;
-            }
-
-          ret = lower->ops->activate ?
-                lower->ops->activate(lower, !!arg) : -ENOTSUP;
-          if (ret >= 0)
-            {
-              upper->enabled = !!arg;
-              if (!upper->enabled)
-                {
-                  upper->interval = 0;
-                  upper->latency = 0;
-                  ret = circbuf_resize(&upper->buffer, lower->buffer_number *
-                                                       upper->esize);
-                }
-            }
+          ret = sensor_activate(upper, user, !!arg);
         }
         break;
 
@@ -393,54 +775,39 @@ static int sensor_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
               break;
             }
 
-          if (upper->interval == *val)
+          if (user->interval == *val)
             {
               break;
             }
 
-          ret = lower->ops->set_interval(lower, val);
+          /* The sensor runs at the shortest interval of all subscribers,
+           * the others get a subset of the events.
+           */
+
+          user->interval = *val;
+          ret = sensor_update_interval(upper);
           if (ret >= 0)
             {
-              upper->interval = *val;
+              ret = sensor_update_latency(upper);
             }
         }
         break;
 
       case SNIOC_BATCH:
         {
-          if (lower->ops->batch == NULL)
-            {
-              ret = -ENOTSUP;
-              break;
-            }
-
-          if (upper->interval == 0)
+          if (user->interval == 0)
             {
               ret = -EINVAL;
               break;
             }
 
-          if (upper->latency == *val)
+          if (user->latency == *val)
             {
               break;
             }
 
-          ret = lower->ops->batch(lower, val);
-          if (ret >= 0)
-            {
-              upper->latency = *val;
-              if (*val != 0)
-                {
-                  /* Adjust length of buffer in batch mode */
-
-                  uint32_t buffer_size = (ROUNDUP(*val, upper->interval) /
-                                         upper->interval +
-                                         lower->buffer_number) *
-                                         upper->esize;
-
-                  ret = circbuf_resize(&upper->buffer, buffer_size);
-                }
-            }
+          user->latency = *val;
+          ret = sensor_update_latency(upper);
         }
         break;
 
@@ -478,12 +845,60 @@ static int sensor_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         {
           if (arg != 0)
             {
-              lower->buffer_number = arg;
-              ret = circbuf_resize(&upper->buffer, arg * upper->esize);
+              ret = sensor_resize(upper, arg * upper->esize);
+              if (ret >= 0)
+                {
+                  lower->buffer_number = arg;
+                }
             }
         }
         break;
 
+      case FIOC_MMAP:
+        {
+          /* Only events pushed by the lower half are buffered */
+
+          if (lower->ops->fetch)
+            {
+              ret = -ENOTSUP;
+              break;
+            }
+
+          *(FAR void **)((uintptr_t)arg) = upper->buffer.base;
+          upper->mapped = true;
+        }
+        break;
+
+      case SNIOC_GET_STATE:
+        {
+          sensor_catchup(upper, user);
+
+          state = (FAR struct sensor_state_s *)((uintptr_t)arg);
+          state->size    = circbuf_size(&upper->buffer);
+          state->head    = upper->buffer.head;
+          state->tail    = upper->buffer.tail;
+          state->cursor  = user->bufferpos;
+          state->overrun = user->overrun;
+          state->esize   = upper->esize;
+        }
+        break;
+
+      case SNIOC_RELEASE:
+        {
+          if (arg % upper->esize != 0)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          /* Advance the cursor of this subscriber only */
+
+          sensor_catchup(upper, user);
+          avail = upper->buffer.head - user->bufferpos;
+          user->bufferpos += arg < avail ? arg : avail;
+        }
+        break;
+
       default:
 
         /* Lowerhalf driver process other cmd. */
@@ -510,10 +925,10 @@ static int sensor_poll(FAR struct file *filep,
   FAR struct inode *inode = filep->f_inode;
   FAR struct sensor_upperhalf_s *upper = inode->i_private;
   FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR struct sensor_user_s *user = filep->f_priv;
   pollevent_t eventset = 0;
   int semcount;
   int ret;
-  int i;
 
   ret = nxsem_wait(&upper->exclsem);
   if (ret < 0)
@@ -523,24 +938,17 @@ static int sensor_poll(FAR struct file *filep,
 
   if (setup)
     {
-      for (i = 0; i < CONFIG_SENSORS_NPOLLWAITERS; i++)
-        {
-          if (NULL == upper->fds[i])
-            {
-              upper->fds[i] = fds;
-              fds->priv = &upper->fds[i];
-              break;
-            }
-        }
+      /* Each subscriber is polled by one thread */
 
-      /* Don't have enough space to store fds */
-
-      if (i == CONFIG_SENSORS_NPOLLWAITERS)
+      if (user->fds != NULL)
         {
-          ret = -ENOSPC;
+          ret = -EBUSY;
           goto errout;
         }
 
+      user->fds = fds;
+      fds->priv = &user->fds;
+
       if (lower->ops->fetch)
         {
           /* Always return POLLIN for fetch data directly(non-block) */
@@ -551,34 +959,27 @@ static int sensor_poll(FAR struct file *filep,
             }
           else
             {
-              nxsem_get_value(&upper->buffersem, &semcount);
+              nxsem_get_value(&user->buffersem, &semcount);
               if (semcount > 0)
                 {
                   eventset |= (fds->events & POLLIN);
                 }
             }
         }
-      else if (!circbuf_is_empty(&upper->buffer))
+      else if (sensor_is_ready(upper, user))
         {
           eventset |= (fds->events & POLLIN);
         }
 
       if (eventset)
         {
-          sensor_pollnotify(upper, eventset);
+          sensor_pollnotify(user, eventset);
         }
     }
   else if (fds->priv != NULL)
     {
-      for (i = 0; i < CONFIG_SENSORS_NPOLLWAITERS; i++)
-        {
-          if (fds == upper->fds[i])
-            {
-              upper->fds[i] = NULL;
-              fds->priv = NULL;
-              break;
-            }
-        }
+      user->fds = NULL;
+      fds->priv = NULL;
     }
 
 errout:
@@ -590,19 +991,26 @@ static void sensor_push_event(FAR void *priv, FAR const void *data,
                               size_t bytes)
 {
   FAR struct sensor_upperhalf_s *upper = priv;
-  int semcount;
+  FAR struct sensor_user_s *user;
+
+  DEBUGASSERT(bytes % upper->esize == 0);
 
   if (!bytes || nxsem_wait(&upper->exclsem) < 0)
     {
       return;
     }
 
+  /* The events are stored once for all subscribers.  A whole hardware fifo
+   * is copied at once, older events are overwritten if the buffer is full.
+   */
+
   circbuf_overwrite(&upper->buffer, data, bytes);
-  sensor_pollnotify(upper, POLLIN);
-  nxsem_get_value(&upper->buffersem, &semcount);
-  if (semcount < 1)
+  list_for_every_entry(&upper->userlist, user, struct sensor_user_s, node)
     {
-      nxsem_post(&upper->buffersem);
+      if (sensor_is_ready(upper, user))
+        {
+          sensor_wakeup(user);
+        }
     }
 
   nxsem_post(&upper->exclsem);
@@ -611,18 +1019,16 @@ static void sensor_push_event(FAR void *priv, FAR const void *data,
 static void sensor_notify_event(FAR void *priv)
 {
   FAR struct sensor_upperhalf_s *upper = priv;
-  int semcount;
+  FAR struct sensor_user_s *user;
 
   if (nxsem_wait(&upper->exclsem) < 0)
     {
       return;
     }
 
-  sensor_pollnotify(upper, POLLIN);
-  nxsem_get_value(&upper->buffersem, &semcount);
-  if (semcount < 1)
+  list_for_every_entry(&upper->userlist, user, struct sensor_user_s, node)
     {
-      nxsem_post(&upper->buffersem);
+      sensor_wakeup(user);
     }
 
   nxsem_post(&upper->exclsem);
@@ -723,10 +1129,8 @@ int sensor_custom_register(FAR struct sensor_lowerhalf_s *lower,
   upper->lower = lower;
   upper->esize = esize;
 
+  list_initialize(&upper->userlist);
   nxsem_init(&upper->exclsem, 0, 1);
-  nxsem_init(&upper->buffersem, 0, 0);
-
-  nxsem_set_protocol(&upper->buffersem, SEM_PRIO_NONE);
 
   /* Bind the lower half data structure member */
 
@@ -758,7 +1162,6 @@ int sensor_custom_register(FAR struct sensor_lowerhalf_s *lower,
 
 drv_err:
   nxsem_destroy(&upper->exclsem);
-  nxsem_destroy(&upper->buffersem);
 
   kmm_free(upper);
 
@@ -818,7 +1221,6 @@ void sensor_custom_unregister(FAR struct sensor_lowerhalf_s *lower,
   unregister_driver(path);
 
   nxsem_destroy(&upper->exclsem);
-  nxsem_destroy(&upper->buffersem);
 
   kmm_free(upper);
 }
@@ -100,6 +100,8 @@ struct pty_devpair_s
  ****************************************************************************/
 
 static int     pty_semtake(FAR struct pty_devpair_s *devpair);
+static size_t  pty_span(FAR const char *buffer, size_t len, bool cr,
+                        bool nl);
 static void    pty_destroy(FAR struct pty_devpair_s *devpair);
 static int     pty_pipe(FAR struct pty_devpair_s *devpair);
 static int     pty_open(FAR struct file *filep);
@@ -152,6 +154,41 @@ static int pty_semtake(FAR struct pty_devpair_s *devpair)
 
 #define pty_semgive(c) nxsem_post(&(c)->pp_exclsem)
 
+/****************************************************************************
+ * Name: pty_span
+ *
+ * Description:
+ *   Return the length of the initial run of the buffer that contains no
+ *   carriage return (if cr is true) and no newline (if nl is true).  These
+ *   bytes need no translation and can be transferred as a block.
+ *
+ ****************************************************************************/
+
+static size_t pty_span(FAR const char *buffer, size_t len, bool cr, bool nl)
+{
+  FAR const char *ptr;
+
+  if (nl)
+    {
+      ptr = memchr(buffer, '\n', len);
+      if (ptr != NULL)
+        {
+          len = ptr - buffer;
+        }
+    }
+
+  if (cr)
+    {
+      ptr = memchr(buffer, '\r', len);
+      if (ptr != NULL)
+        {
+          len = ptr - buffer;
+        }
+    }
+
+  return len;
+}
+
 /****************************************************************************
  * Name: pty_destroy
  ****************************************************************************/
@@ -410,6 +447,9 @@ static ssize_t pty_read(FAR struct file *filep, FAR char *buffer, size_t len)
 #ifdef CONFIG_SERIAL_TERMIOS
   ssize_t i;
   ssize_t j;
+  size_t n;
+  bool cr;
+  bool nl;
   char ch;
 #endif
 
@@ -432,13 +472,33 @@ static ssize_t pty_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   if (dev->pd_iflag & (INLCR | IGNCR | ICRNL))
     {
+      cr = (dev->pd_iflag & (IGNCR | ICRNL)) != 0;
+      nl = (dev->pd_iflag & INLCR) != 0;
+
       while ((ntotal = file_read(&dev->pd_src, buffer, len)) > 0)
         {
-          for (i = j = 0; i < ntotal; i++)
+          for (i = j = 0; i < ntotal; )
             {
+              /* Keep the run of bytes that need no translation as a
+               * block.
+               */
+
+              n = pty_span(&buffer[i], ntotal - i, cr, nl);
+              if (n > 0)
+                {
+                  if (j != i)
+                    {
+                      memmove(&buffer[j], &buffer[i], n);
+                    }
+
+                  i += n;
+                  j += n;
+                  continue;
+                }
+
               /* Perform input processing */
 
-              ch = buffer[i];
+              ch = buffer[i++];
 
               /* \n -> \r or \r -> \n translation? */
 
@@ -503,86 +563,102 @@ static ssize_t pty_write(FAR struct file *filep,
   FAR struct pty_dev_s *dev;
   ssize_t ntotal;
   ssize_t nwritten;
-  size_t i;
-  char ch;
+  size_t n;
+  bool cr;
+  bool nl;
+  char ch[2];
 
   DEBUGASSERT(filep != NULL && filep->f_inode != NULL);
   inode = filep->f_inode;
   dev   = inode->i_private;
   DEBUGASSERT(dev != NULL);
 
-  /* Do output post-processing */
+  /* Do output post-processing.  OPOST alone does not change anything. */
 
-  if ((dev->pd_oflag & OPOST) != 0)
+  if ((dev->pd_oflag & OPOST) != 0 &&
+      (dev->pd_oflag & (OCRNL | ONLCR | ONLRET)) != 0)
     {
-      /* We will transfer one byte at a time, making the appropriae
-       * translations.  Specifically not handled:
+      /* The runs of bytes that need no translation are transferred as a
+       * block and the special characters one at a time.  Specifically not
+       * handled:
        *
        *   OXTABS - primarily a full-screen terminal optimisation
        *   ONOEOT - Unix interoperability hack
        *   OLCUC  - Not specified by POSIX
        *   ONOCR  - low-speed interactive optimisation
+       *
+       * Everything written blocks if the sink pipe is full.
+       *
+       * REVISIT: Should not block if the oflags include O_NONBLOCK.
+       * How would we ripple the O_NONBLOCK characteristic to the
+       * contained sink pipe?  file_fcntl()?  Or FIONSPACE?  See the
+       * TODO comment at the top of this file.
        */
 
-      ntotal = 0;
-      for (i = 0; i < len; i++)
-        {
-          ch = *buffer++;
+      cr = (dev->pd_oflag & OCRNL) != 0;
+      nl = (dev->pd_oflag & (ONLCR | ONLRET)) != 0;
 
-          /* Mapping CR to NL? */
-
-          if (ch == '\r' && (dev->pd_oflag & OCRNL) != 0)
-            {
-              ch = '\n';
-            }
+      ntotal   = 0;
+      nwritten = 0;
 
-          /* Are we interested in newline processing? */
-
-          if ((ch == '\n') && (dev->pd_oflag & (ONLCR | ONLRET)) != 0)
+      while ((size_t)ntotal < len)
+        {
+          n = pty_span(buffer, len - ntotal, cr, nl);
+          if (n > 0)
             {
-              char cr = '\r';
-
-              /* Transfer the carriage return.  This will block if the
-               * sink pipe is full.
-               *
-               * REVISIT: Should not block if the oflags include O_NONBLOCK.
-               * How would we ripple the O_NONBLOCK characteristic to the
-               * contained sink pipe?  file_fcntl()?  Or FIONSPACE?  See the
-               * TODO comment at the top of this file.
-               *
-               * NOTE: The newline is not included in total number of bytes
-               * written.  Otherwise, we would return more than the
-               * requested number of bytes.
-               */
-
-              nwritten = file_write(&dev->pd_sink, &cr, 1);
+              nwritten = file_write(&dev->pd_sink, buffer, n);
               if (nwritten < 0)
                 {
-                  ntotal = nwritten;
                   break;
                 }
+
+              buffer += nwritten;
+              ntotal += nwritten;
+              continue;
+            }
+
+          /* Mapping CR to NL? */
+
+          ch[0] = *buffer;
+          if (ch[0] == '\r' && cr)
+            {
+              ch[0] = '\n';
             }
 
-          /* Transfer the (possibly translated) character..  This will block
-           * if the sink pipe is full
+          /* Are we interested in newline processing?  Then precede the
+           * newline with a carriage return.
            *
-           * REVISIT: Should not block if the oflags include O_NONBLOCK.
-           * How would we ripple the O_NONBLOCK characteristic to the
-           * contained sink pipe?  file_fcntl()?  Or FIONSPACe?  See the
-           * TODO comment at the top of this file.
+           * NOTE: The carriage return is not included in total number of
+           * bytes written.  Otherwise, we would return more than the
+           * requested number of bytes.
            */
 
-          nwritten = file_write(&dev->pd_sink, &ch, 1);
+          n = 1;
+          if (ch[0] == '\n' && nl)
+            {
+              ch[0] = '\r';
+              ch[1] = '\n';
+              n     = 2;
+            }
+
+          nwritten = file_write(&dev->pd_sink, ch, n);
           if (nwritten < 0)
             {
-              ntotal = nwritten;
               break;
             }
 
           /* Update the count of bytes transferred */
 
+          buffer++;
           ntotal++;
         }
+
+      /* Report an error only if nothing could be transferred */
+
+      if (nwritten < 0 && ntotal == 0)
+        {
+          ntotal = nwritten;
+        }
     }
   else
     {
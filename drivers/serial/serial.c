@@ -82,6 +82,12 @@
 
 static int     uart_takesem(FAR sem_t *sem, bool errout);
 static void    uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset);
+static int     uart_rxbuffered(FAR struct uart_buffer_s *rxbuf);
+
+/* Read support */
+
+static size_t  uart_readspan(FAR uart_dev_t *dev, FAR char *buffer,
+                             size_t buflen);
 
 /* Write support */
 
@@ -185,15 +191,8 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
 #endif
           if (fds->revents != 0)
             {
-              int semcount;
-
               finfo("Report events: %08" PRIx32 "\n", fds->revents);
-
-              nxsem_get_value(fds->sem, &semcount);
-              if (semcount < 1)
-                {
-                  nxsem_post(fds->sem);
-                }
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -715,6 +714,7 @@ static int uart_close(FAR struct file *filep)
 
   /* Wake up read and poll functions */
 
+  dev->recvmin = 0;
   uart_datareceived(dev);
 
   /* We need to re-initialize the semaphores if this is the last close
@@ -727,6 +727,130 @@ static int uart_close(FAR struct file *filep)
   return OK;
 }
 
+/****************************************************************************
+ * Name: uart_rxbuffered
+ *
+ * Description:
+ *   Return the number of bytes waiting in the RX circular buffer.
+ *
+ ****************************************************************************/
+
+static int uart_rxbuffered(FAR struct uart_buffer_s *rxbuf)
+{
+  int16_t head = rxbuf->head;
+  int16_t tail = rxbuf->tail;
+
+  if (tail <= head)
+    {
+      return head - tail;
+    }
+  else
+    {
+      return rxbuf->size - (tail - head);
+    }
+}
+
+/****************************************************************************
+ * Name: uart_readspan
+ *
+ * Description:
+ *   Copy the contiguous span of data that starts at the tail of the RX
+ *   circular buffer to the user buffer and apply the input processing of
+ *   the termios settings to the copy.
+ *
+ *   NOTE: Rx interrupt handling logic may asynchronously increment the
+ *   head index but must not modify the tail index.  The tail index is only
+ *   modified by the reader which holds recv.sem.  Therefore, no special
+ *   handshaking is required here.
+ *
+ * Returned Value:
+ *   The number of bytes stored in the user buffer.  This may be less than
+ *   the number of bytes removed from the RX buffer if characters were
+ *   discarded by the input processing.
+ *
+ ****************************************************************************/
+
+static size_t uart_readspan(FAR uart_dev_t *dev, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct uart_buffer_s *rxbuf = &dev->recv;
+  int16_t head = rxbuf->head;
+  int16_t tail = rxbuf->tail;
+  size_t nread;
+#ifdef CONFIG_SERIAL_TERMIOS
+  size_t nstored;
+  size_t i;
+  char ch;
+#endif
+
+  /* The data up to the head or to the end of the buffer is contiguous */
+
+  nread = (head >= tail ? head : rxbuf->size) - tail;
+  if (nread > buflen)
+    {
+      nread = buflen;
+    }
+
+  memcpy(buffer, &rxbuf->buffer[tail], nread);
+
+  /* Update the tail index.  The local variable 'tail' is used so that the
+   * final rxbuf->tail update is atomic.
+   */
+
+  tail += nread;
+  if (tail >= rxbuf->size)
+    {
+      tail = 0;
+    }
+
+  rxbuf->tail = tail;
+
+#ifdef CONFIG_SERIAL_TERMIOS
+  /* Do input processing if any is enabled */
+
+  if ((dev->tc_iflag & (INLCR | IGNCR | ICRNL)) != 0)
+    {
+      for (i = 0, nstored = 0; i < nread; i++)
+        {
+          ch = buffer[i];
+
+          /* \n -> \r or \r -> \n translation? */
+
+          if ((ch == '\n') && (dev->tc_iflag & INLCR))
+            {
+              ch = '\r';
+            }
+          else if ((ch == '\r') && (dev->tc_iflag & ICRNL))
+            {
+              ch = '\n';
+            }
+
+          /* Discarding \r ? */
+
+          if ((ch == '\r') && (dev->tc_iflag & IGNCR))
+            {
+              continue;
+            }
+
+          buffer[nstored++] = ch;
+        }
+
+      nread = nstored;
+    }
+
+  /* Specifically not handled:
+   *
+   * All of the local modes; echo, line editing, etc.
+   * Anything to do with break or parity errors.
+   * ISTRIP - we should be 8-bit clean.
+   * IUCLC - Not Posix
+   * IXON/OXOFF - no xon/xoff flow control.
+   */
+#endif
+
+  return nread;
+}
+
 /****************************************************************************
  * Name: uart_read
  ****************************************************************************/
@@ -743,8 +867,10 @@ static ssize_t uart_read(FAR struct file *filep,
 #endif
   irqstate_t flags;
   ssize_t recvd = 0;
-  int16_t tail;
-  char ch;
+  size_t minread;
+#ifdef CONFIG_SERIAL_TERMIOS
+  clock_t timeout;
+#endif
   int ret;
 
   /* Only one user can access rxbuf->tail at a time */
@@ -760,6 +886,33 @@ static ssize_t uart_read(FAR struct file *filep,
       return ret;
     }
 
+  /* Determine how much data must be received before returning.  Without
+   * CONFIG_DEV_SERIAL_FULLBLOCKS, read() returns as soon as some data is
+   * available, or after VMIN bytes and the VTIME inter-byte timeout if
+   * termios is supported.
+   */
+
+#if defined(CONFIG_DEV_SERIAL_FULLBLOCKS)
+  minread = buflen;
+#elif defined(CONFIG_SERIAL_TERMIOS)
+  minread = dev->tc_vmin;
+#else
+  minread = 1;
+#endif
+
+  if (minread > buflen)
+    {
+      minread = buflen;
+    }
+
+#ifdef CONFIG_SERIAL_TERMIOS
+  timeout = DSEC2TICK(dev->tc_vtime);
+  if (dev->tc_vtime > 0 && timeout == 0)
+    {
+      timeout = 1;
+    }
+#endif
+
   /* Loop while we still have data to copy to the receive buffer.
    * we add data to the head of the buffer; uart_xmitchars takes the
    * data from the end of the buffer.
@@ -784,76 +937,42 @@ static ssize_t uart_read(FAR struct file *filep,
 #endif
 
       /* Check if there is more data to return in the circular buffer.
-       * NOTE: Rx interrupt handling logic may asynchronously increment
-       * the head index but must not modify the tail index.  The tail
-       * index is only modified in this function.  Therefore, no
-       * special handshaking is required here.
        *
        * The head and tail pointers are 16-bit values.  The only time that
        * the following could be unsafe is if the CPU made two non-atomic
        * 8-bit accesses to obtain the 16-bit head index.
        */
 
-      tail = rxbuf->tail;
-      if (rxbuf->head != tail)
+      if (rxbuf->head != rxbuf->tail)
         {
-          /* Take the next character from the tail of the buffer */
-
-          ch = rxbuf->buffer[tail];
-
-          /* Increment the tail index.  Most operations are done using the
-           * local variable 'tail' so that the final rxbuf->tail update
-           * is atomic.
-           */
-
-          if (++tail >= rxbuf->size)
-            {
-              tail = 0;
-            }
-
-          rxbuf->tail = tail;
-
-#ifdef CONFIG_SERIAL_TERMIOS
-          /* Do input processing if any is enabled */
+          /* Copy the next contiguous span from the tail of the buffer */
 
-          if (dev->tc_iflag & (INLCR | IGNCR | ICRNL))
-            {
-              /* \n -> \r or \r -> \n translation? */
+          recvd += uart_readspan(dev, buffer + recvd, buflen - recvd);
+        }
 
-              if ((ch == '\n') && (dev->tc_iflag & INLCR))
-                {
-                  ch = '\r';
-                }
-              else if ((ch == '\r') && (dev->tc_iflag & ICRNL))
-                {
-                  ch = '\n';
-                }
+      /* No... the circular buffer is empty.  Have we returned enough
+       * to the caller?
+       */
 
-              /* Discarding \r ? */
+      else if (recvd > 0 && (size_t)recvd >= minread)
+        {
+          /* Yes.. break out of the loop and return the number of bytes
+           * received up to the wait condition.
+           */
 
-              if ((ch == '\r') & (dev->tc_iflag & IGNCR))
-                {
-                  continue;
-                }
-            }
+          break;
+        }
 
-          /* Specifically not handled:
-           *
-           * All of the local modes; echo, line editing, etc.
-           * Anything to do with break or parity errors.
-           * ISTRIP - we should be 8-bit clean.
-           * IUCLC - Not Posix
-           * IXON/OXOFF - no xon/xoff flow control.
+      else if (filep->f_inode == 0)
+        {
+          /* File has been closed.
+           * Descriptor is not valid.
            */
-#endif
 
-          /* Store the received character */
-
-          *buffer++ = ch;
-          recvd++;
+          recvd = -EBADFD;
+          break;
         }
 
-#ifdef CONFIG_DEV_SERIAL_FULLBLOCKS
       /* No... then we would have to wait to get receive more data.
        * If the user has specified the O_NONBLOCK option, then just
        * return what we have.
@@ -872,40 +991,12 @@ static ssize_t uart_read(FAR struct file *filep,
 
           break;
         }
-#else
-      /* No... the circular buffer is empty.  Have we returned anything
-       * to the caller?
-       */
-
-      else if (recvd > 0)
-        {
-          /* Yes.. break out of the loop and return the number of bytes
-           * received up to the wait condition.
-           */
-
-          break;
-        }
-
-      else if (filep->f_inode == 0)
-        {
-          /* File has been closed.
-           * Descriptor is not valid.
-           */
-
-          recvd = -EBADFD;
-          break;
-        }
 
-      /* No... then we would have to wait to get receive some data.
-       * If the user has specified the O_NONBLOCK option, then do not
-       * wait.
-       */
+#ifdef CONFIG_SERIAL_TERMIOS
+      /* VMIN = 0 and VTIME = 0 is a polling read that never waits */
 
-      else if ((filep->f_oflags & O_NONBLOCK) != 0)
+      else if (minread == 0 && timeout == 0)
         {
-          /* Break out of the loop returning -EAGAIN */
-
-          recvd = -EAGAIN;
           break;
         }
 #endif
@@ -974,17 +1065,85 @@ static ssize_t uart_read(FAR struct file *filep,
               else
 #endif
                 {
+                  /* Ask to be woken up only when the rest of the data that
+                   * we need has arrived, but never later than when half of
+                   * the RX buffer has filled, so that the receiver does not
+                   * overrun before we get to run.
+                   */
+
+                  dev->recvmin = minread > (size_t)recvd ?
+                                 minread - recvd : 1;
+#ifdef CONFIG_SERIAL_TERMIOS
+                  if (timeout > 0 && recvd == 0)
+                    {
+                      /* The VTIME timer starts with the first byte */
+
+                      dev->recvmin = 1;
+                    }
+#endif
+
+                  if (dev->recvmin > rxbuf->size / 2)
+                    {
+                      dev->recvmin = rxbuf->size / 2;
+                    }
+
+#ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
+                  /* Nor later than RX flow control would stop the sender */
+
+                  watermark = (CONFIG_SERIAL_IFLOWCONTROL_UPPER_WATERMARK *
+                               rxbuf->size) / 100;
+                  if (dev->recvmin > watermark)
+                    {
+                      dev->recvmin = watermark > 0 ? watermark : 1;
+                    }
+#endif
+
                   /* Now wait with the Rx interrupt enabled.  NuttX will
                    * automatically re-enable global interrupts when this
                    * thread goes to sleep.
                    */
 
                   dev->recvwaiting = true;
-                  ret = uart_takesem(&dev->recvsem, true);
+
+#ifdef CONFIG_SERIAL_TERMIOS
+                  /* VTIME is an inter-byte timeout once some data has
+                   * been received, or the timeout of the whole read if
+                   * VMIN is zero.
+                   */
+
+                  if (timeout > 0 && (minread == 0 || recvd > 0))
+                    {
+                      ret = nxsem_tickwait(&dev->recvsem, timeout);
+                      if (ret == -ETIMEDOUT)
+                        {
+                          dev->recvwaiting = false;
+                        }
+                    }
+                  else
+#endif
+                    {
+                      ret = uart_takesem(&dev->recvsem, true);
+                    }
                 }
 
               leave_critical_section(flags);
 
+#ifdef CONFIG_SERIAL_TERMIOS
+              /* Did the VTIME timer expire?  Return what we have unless
+               * some data arrived that did not reach the wake-up level.
+               */
+
+              if (ret == -ETIMEDOUT)
+                {
+                  if (rxbuf->head != rxbuf->tail)
+                    {
+                      continue;
+                    }
+
+                  break;
+                }
+#endif
+
               /* Was a signal received while waiting for data to be
                * received?  Was a removable device disconnected while
                * we were waiting?
@@ -1301,14 +1460,7 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
               /* Determine the number of bytes available in the RX buffer */
 
-              if (dev->recv.tail <= dev->recv.head)
-                {
-                  count = dev->recv.head - dev->recv.tail;
-                }
-              else
-                {
-                  count = dev->recv.size - (dev->recv.tail - dev->recv.head);
-                }
+              count = uart_rxbuffered(&dev->recv);
 
               leave_critical_section(flags);
 
@@ -1458,6 +1610,8 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
               termiosp->c_iflag = dev->tc_iflag;
               termiosp->c_oflag = dev->tc_oflag;
               termiosp->c_lflag = dev->tc_lflag;
+              termiosp->c_cc[VMIN]  = dev->tc_vmin;
+              termiosp->c_cc[VTIME] = dev->tc_vtime;
 
               ret = 0;
             }
@@ -1478,6 +1632,8 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
               dev->tc_iflag = termiosp->c_iflag;
               dev->tc_oflag = termiosp->c_oflag;
               dev->tc_lflag = termiosp->c_lflag;
+              dev->tc_vmin  = termiosp->c_cc[VMIN];
+              dev->tc_vtime = termiosp->c_cc[VTIME];
 
               ret = 0;
             }
@@ -1675,7 +1831,8 @@ static void uart_launch_worker(void *arg)
 
       attr.priority  = CONFIG_TTY_LAUNCH_PRIORITY;
       attr.stacksize = CONFIG_TTY_LAUNCH_STACKSIZE;
-      exec_spawn(CONFIG_TTY_LAUNCH_FILEPATH, argv, NULL, 0, &attr);
+      exec_spawn(CONFIG_TTY_LAUNCH_FILEPATH, argv, NULL, NULL, 0, NULL,
+                 &attr);
 #endif
     }
 }
@@ -1719,6 +1876,11 @@ int uart_register(FAR const char *path, FAR uart_dev_t *dev)
 
       dev->tc_oflag = OPOST | ONLCR;
     }
+
+  /* read() waits for at least one byte without timeout by default */
+
+  dev->tc_vmin  = 1;
+  dev->tc_vtime = 0;
 #endif
 
   /* Initialize semaphores */
@@ -1759,9 +1921,11 @@ void uart_datareceived(FAR uart_dev_t *dev)
 
   uart_pollnotify(dev, POLLIN);
 
-  /* Is there a thread waiting for read data?  */
+  /* Is there a thread waiting for read data?  It is only woken up when
+   * as much data as it has asked for is available.
+   */
 
-  if (dev->recvwaiting)
+  if (dev->recvwaiting && uart_rxbuffered(&dev->recv) >= dev->recvmin)
     {
       /* Yes... wake it up */
 
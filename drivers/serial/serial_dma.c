@@ -42,8 +42,8 @@
  * Name: uart_recvchars_check_special
  *
  * Description:
- *   Check if the SIGINT character is anywhere in the newly received DMA
- *   buffer.
+ *   Check if the SIGINT character is anywhere in the part of the DMA buffer
+ *   that was received since the last commit.
  *
  *   REVISIT:  We must also remove the SIGINT/SIGTSTP character from the Rx
  *   buffer.  It should not be read as normal data by the caller.
@@ -56,27 +56,107 @@
 static int uart_recvchars_check_special(FAR uart_dev_t *dev)
 {
   FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+  size_t start = xfer->ncommit;
+  size_t end = xfer->nbytes;
   int signo;
 
-  /* Check if the valid DMAed data is in one or two contiguous regions */
+  /* Check if the new DMAed data is in one or two contiguous regions */
 
-  if (xfer->nbytes <= xfer->length)
-    {
-      return uart_check_special(dev, xfer->buffer, xfer->nbytes);
-    }
-  else
+  if (start < xfer->length)
     {
       /* REVISIT:  Additional signals could be in the second region. */
 
-      signo = uart_check_special(dev, xfer->buffer, xfer->length);
+      signo = uart_check_special(dev, xfer->buffer + start,
+                                 (end < xfer->length ? end : xfer->length) -
+                                 start);
       if (signo != 0)
         {
           return signo;
         }
 
-      return uart_check_special(dev, xfer->nbuffer,
-                                xfer->nbytes - xfer->length);
+      start = xfer->length;
+    }
+
+  if (end > start)
+    {
+      return uart_check_special(dev, xfer->nbuffer + start - xfer->length,
+                                end - start);
     }
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: uart_recvchars_commit
+ *
+ * Description:
+ *   Move the head of the RX circular buffer past the bytes that the RX DMA
+ *   transfer received since the last commit and wake up the waiters.  The
+ *   DMA transfer itself is reset only if it has completed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+static void uart_recvchars_commit(FAR uart_dev_t *dev, bool done)
+{
+  FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+  FAR struct uart_buffer_s *rxbuf = &dev->recv;
+  size_t nbytes;
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGTSTP) || \
+    defined(CONFIG_TTY_FORCE_PANIC) || defined(CONFIG_TTY_LAUNCH)
+  int signo = 0;
+#endif
+
+  DEBUGASSERT(xfer->nbytes >= xfer->ncommit);
+  nbytes = xfer->nbytes - xfer->ncommit;
+
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGTSTP) || \
+    defined(CONFIG_TTY_FORCE_PANIC) || defined(CONFIG_TTY_LAUNCH)
+  /* Check if the SIGINT character is anywhere in the newly received DMA
+   * buffer.
+   */
+
+  if (nbytes > 0)
+    {
+      signo = uart_recvchars_check_special(dev);
+    }
+#endif
+
+  /* Move head for the new bytes. */
+
+  rxbuf->head = (rxbuf->head + nbytes) % rxbuf->size;
+
+  if (done)
+    {
+      xfer->nbytes  = 0;
+      xfer->ncommit = 0;
+      xfer->length  = xfer->nlength = 0;
+    }
+  else
+    {
+      xfer->ncommit = xfer->nbytes;
+    }
+
+  /* If any bytes were added to the buffer, inform any waiters there is new
+   * incoming data available.
+   */
+
+  if (nbytes)
+    {
+      uart_datareceived(dev);
+    }
+
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGTSTP) || \
+    defined(CONFIG_TTY_FORCE_PANIC) || defined(CONFIG_TTY_LAUNCH)
+  /* Send the signal if necessary */
+
+  if (signo != 0)
+    {
+      nxsig_kill(dev->pid, signo);
+      uart_reset_sem(dev);
+    }
+#endif
 }
 #endif
 
@@ -294,6 +374,7 @@ void uart_recvchars_dma(FAR uart_dev_t *dev)
       xfer->nlength = 0;
     }
 
+  xfer->ncommit = 0;
   uart_dmareceive(dev);
 }
 #endif
@@ -312,45 +393,27 @@ void uart_recvchars_dma(FAR uart_dev_t *dev)
 #ifdef CONFIG_SERIAL_RXDMA
 void uart_recvchars_done(FAR uart_dev_t *dev)
 {
-  FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
-  FAR struct uart_buffer_s *rxbuf = &dev->recv;
-  size_t nbytes = xfer->nbytes;
-#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGTSTP) || \
-    defined(CONFIG_TTY_FORCE_PANIC) || defined(CONFIG_TTY_LAUNCH)
-  int signo = 0;
-
-  /* Check if the SIGINT character is anywhere in the newly received DMA
-   * buffer.
-   */
-
-  signo = uart_recvchars_check_special(dev);
+  uart_recvchars_commit(dev, true);
+}
 #endif
 
-  /* Move head for nbytes. */
-
-  rxbuf->head  = (rxbuf->head + nbytes) % rxbuf->size;
-  xfer->nbytes = 0;
-  xfer->length = xfer->nlength = 0;
-
-  /* If any bytes were added to the buffer, inform any waiters there is new
-   * incoming data available.
-   */
-
-  if (nbytes)
-    {
-      uart_datareceived(dev);
-    }
-
-#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGTSTP) || \
-    defined(CONFIG_TTY_FORCE_PANIC) || defined(CONFIG_TTY_LAUNCH)
-  /* Send the signal if necessary */
+/****************************************************************************
+ * Name: uart_recvchars_idle
+ *
+ * Description:
+ *   Add the bytes that the running RX DMA transfer has received so far to
+ *   the RX circular buffer.  This is called by the lower half on an
+ *   idle-line or receive timeout event, so that a reader sees a short
+ *   burst without waiting for the transfer to fill its whole region.  The
+ *   transfer keeps running; uart_recvchars_done() must still be called when
+ *   it completes.
+ *
+ ****************************************************************************/
 
-  if (signo != 0)
-    {
-      nxsig_kill(dev->pid, signo);
-      uart_reset_sem(dev);
-    }
-#endif
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_idle(FAR uart_dev_t *dev)
+{
+  uart_recvchars_commit(dev, false);
 }
 #endif
 
@@ -113,22 +113,7 @@ static inline void uart_bth4_post(FAR sem_t *sem)
 static void uart_bth4_pollnotify(FAR struct uart_bth4_s *dev,
                                  pollevent_t eventset)
 {
-  int i;
-
-  for (i = 0; i < CONFIG_UART_BTH4_NPOLLWAITERS; i++)
-    {
-      FAR struct pollfd *fds = dev->fds[i];
-
-      if (fds)
-        {
-          fds->revents |= (fds->events & eventset);
-
-          if (fds->revents != 0)
-            {
-              uart_bth4_post(fds->sem);
-            }
-        }
-    }
+  poll_notify(dev->fds, CONFIG_UART_BTH4_NPOLLWAITERS, eventset);
 
   if ((eventset & POLLIN) != 0)
     {
@@ -246,6 +231,7 @@ static ssize_t uart_bth4_write(FAR struct file *filep,
   enum bt_buf_type_e type;
   size_t reserved;
   uint8_t *data;
+  size_t offset = 0;
   size_t pktlen;
   size_t hdrlen;
   int ret;
@@ -277,11 +263,18 @@ static ssize_t uart_bth4_write(FAR struct file *filep,
          buffer, buflen);
   dev->sendlen += buflen;
 
-  hdr = (FAR union bt_hdr_u *)data;
+  /* Send out all complete packets in the buffer.  Each packet is sent in
+   * place, the buffer is only compacted once at the end, so a write with
+   * several packets costs a single memmove() of the incomplete tail.
+   * The driver may use head_reserve bytes in front of the packet, those
+   * belong to the packets already sent.
+   */
 
-  for (; ; )
+  while (offset < dev->sendlen)
     {
-      switch (*(data - H4_HEADER_SIZE))
+      hdr = (FAR union bt_hdr_u *)(data + offset);
+
+      switch (*(data + offset - H4_HEADER_SIZE))
         {
           case H4_CMD:
             hdrlen = sizeof(struct bt_hci_cmd_hdr_s);
@@ -307,36 +300,40 @@ static ssize_t uart_bth4_write(FAR struct file *filep,
 
       hdrlen += H4_HEADER_SIZE;
 
-      if (dev->sendlen < hdrlen)
+      if (dev->sendlen - offset < hdrlen)
         {
-          goto out;
+          break;
         }
 
       pktlen += hdrlen;
-      if (dev->sendlen < pktlen)
+      if (dev->sendlen - offset < pktlen)
         {
-          goto out;
+          break;
         }
 
       /* Got the full packet, send out */
 
       ret = dev->drv->send(dev->drv, type,
-                           data, pktlen - H4_HEADER_SIZE);
+                           data + offset, pktlen - H4_HEADER_SIZE);
       if (ret < 0)
         {
           goto err;
         }
 
-      dev->sendlen -= pktlen;
-      if (dev->sendlen == 0)
-        {
-          goto out;
-        }
+      offset += pktlen;
+    }
+
+  /* Keep the incomplete packet, if any, for the next write */
 
+  dev->sendlen -= offset;
+  if (dev->sendlen > 0 && offset > 0)
+    {
       memmove(data - H4_HEADER_SIZE,
-              dev->sendbuf + pktlen, dev->sendlen);
+              data - H4_HEADER_SIZE + offset, dev->sendlen);
     }
 
+  goto out;
+
 err:
   dev->sendlen = 0;
 out:
@@ -437,9 +434,10 @@ int uart_bth4_register(FAR const char *path, FAR struct bt_driver_s *drv)
       return -ENOMEM;
     }
 
-  dev->drv     = drv;
-  drv->receive = uart_bth4_receive;
-  drv->priv    = dev;
+  dev->drv         = drv;
+  drv->receive     = uart_bth4_receive;
+  drv->receive_iob = NULL;
+  drv->priv        = dev;
 
   nxsem_init(&dev->sendlock, 0, 1);
   nxsem_init(&dev->recvsem,  0, 0);
@@ -0,0 +1,353 @@
+/****************************************************************************
+ * drivers/spi/spi_queue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spi/spi.h>
+#include <nuttx/spi/spi_transfer.h>
+
+#ifdef CONFIG_SPI_QUEUE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The transaction queue of one SPI bus */
+
+struct spi_queue_s
+{
+  FAR struct spi_dev_s *spi;   /* The bus the queue executes on */
+  sq_queue_t pending;          /* Messages ordered by priority */
+  sem_t waitsem;               /* Counts the pending messages */
+  pid_t pid;                   /* The bus thread */
+};
+
+/* Used by spi_queue_transfer() to wait for its own message */
+
+struct spi_waiter_s
+{
+  struct spi_message_s msg;
+  sem_t donesem;
+  int result;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_queue_thread
+ *
+ * Description:
+ *   The bus thread.  Take the highest priority message, execute it and
+ *   report the result through the message callback.
+ *
+ ****************************************************************************/
+
+static int spi_queue_thread(int argc, FAR char **argv)
+{
+  FAR struct spi_queue_s *queue;
+  FAR struct spi_message_s *msg;
+  irqstate_t flags;
+  int ret;
+
+  queue = (FAR struct spi_queue_s *)((uintptr_t)strtoul(argv[1], NULL, 0));
+  DEBUGASSERT(queue != NULL);
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&queue->waitsem);
+
+      flags = enter_critical_section();
+      msg = (FAR struct spi_message_s *)sq_remfirst(&queue->pending);
+      leave_critical_section(flags);
+
+      /* The message may have been cancelled after it was counted */
+
+      if (msg == NULL)
+        {
+          continue;
+        }
+
+      ret = spi_transfer(queue->spi, msg->seq);
+      if (ret < 0)
+        {
+          spierr("ERROR: spi_transfer failed: %d\n", ret);
+        }
+
+      if (msg->callback != NULL)
+        {
+          msg->callback(msg, ret);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spi_queue_wakeup
+ *
+ * Description:
+ *   The completion callback of spi_queue_transfer().
+ *
+ ****************************************************************************/
+
+static void spi_queue_wakeup(FAR struct spi_message_s *msg, int result)
+{
+  FAR struct spi_waiter_s *waiter = (FAR struct spi_waiter_s *)msg;
+
+  waiter->result = result;
+  nxsem_post(&waiter->donesem);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_queue_initialize
+ *
+ * Description:
+ *   Create the transaction queue of one SPI bus and start the kernel
+ *   thread that executes the queued sequences back-to-back.  All devices
+ *   on the bus that want asynchronous transfers share the same queue.
+ *
+ * Input Parameters:
+ *   spi - An instance of the lower half SPI driver
+ *
+ * Returned Value:
+ *   The queue handle on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct spi_queue_s *spi_queue_initialize(FAR struct spi_dev_s *spi)
+{
+  FAR struct spi_queue_s *queue;
+  FAR char *argv[2];
+  char arg1[16];
+  int ret;
+
+  DEBUGASSERT(spi != NULL);
+
+  queue = (FAR struct spi_queue_s *)kmm_zalloc(sizeof(struct spi_queue_s));
+  if (queue == NULL)
+    {
+      spierr("ERROR: Failed to allocate the queue\n");
+      return NULL;
+    }
+
+  queue->spi = spi;
+  sq_init(&queue->pending);
+
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&queue->waitsem, 0, 0);
+  nxsem_set_protocol(&queue->waitsem, SEM_PRIO_NONE);
+
+  /* The inputs to a task started by kthread_create() are very awkward for
+   * this purpose.  They are really designed for command line tasks
+   * (argc/argv).  So the queue address is passed as a string.
+   */
+
+  snprintf(arg1, 16, "%p", queue);
+  argv[0] = arg1;
+  argv[1] = NULL;
+
+  ret = kthread_create("spiqueue", CONFIG_SPI_QUEUE_PRIORITY,
+                       CONFIG_SPI_QUEUE_STACKSIZE, spi_queue_thread, argv);
+  if (ret < 0)
+    {
+      spierr("ERROR: Failed to start the bus thread: %d\n", ret);
+      nxsem_destroy(&queue->waitsem);
+      kmm_free(queue);
+      return NULL;
+    }
+
+  queue->pid = (pid_t)ret;
+  return queue;
+}
+
+/****************************************************************************
+ * Name: spi_queue_submit
+ *
+ * Description:
+ *   Queue a sequence of transfers for execution by the bus thread and
+ *   return immediately.  Messages are executed in priority order, and in
+ *   submission order for equal priorities.  msg->callback is called on
+ *   the bus thread with the result of spi_transfer() once the sequence has
+ *   completed.  This function may be called from the callback.
+ *
+ * Input Parameters:
+ *   queue - The queue returned by spi_queue_initialize()
+ *   msg   - The message to queue.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_submit(FAR struct spi_queue_s *queue,
+                     FAR struct spi_message_s *msg)
+{
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *curr;
+  irqstate_t flags;
+
+  if (queue == NULL || msg == NULL || msg->seq == NULL ||
+      msg->seq->trans == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* Insert behind all messages of the same or a higher priority */
+
+  flags = enter_critical_section();
+  for (curr = sq_peek(&queue->pending); curr != NULL; curr = sq_next(curr))
+    {
+      if (((FAR struct spi_message_s *)curr)->priority < msg->priority)
+        {
+          break;
+        }
+
+      prev = curr;
+    }
+
+  if (prev == NULL)
+    {
+      sq_addfirst(&msg->flink, &queue->pending);
+    }
+  else
+    {
+      sq_addafter(prev, &msg->flink, &queue->pending);
+    }
+
+  leave_critical_section(flags);
+
+  return nxsem_post(&queue->waitsem);
+}
+
+/****************************************************************************
+ * Name: spi_queue_cancel
+ *
+ * Description:
+ *   Remove a message that has not been started yet from the queue.  The
+ *   callback of a cancelled message is not called.
+ *
+ * Input Parameters:
+ *   queue - The queue returned by spi_queue_initialize()
+ *   msg   - The message to remove.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if the message is not queued, i.e. it
+ *   is already running or completed.
+ *
+ ****************************************************************************/
+
+int spi_queue_cancel(FAR struct spi_queue_s *queue,
+                     FAR struct spi_message_s *msg)
+{
+  FAR sq_entry_t *curr;
+  irqstate_t flags;
+  int ret = -ENOENT;
+
+  DEBUGASSERT(queue != NULL && msg != NULL);
+
+  flags = enter_critical_section();
+  for (curr = sq_peek(&queue->pending); curr != NULL; curr = sq_next(curr))
+    {
+      if (curr == &msg->flink)
+        {
+          sq_rem(curr, &queue->pending);
+          ret = OK;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  /* The count of waitsem is left as is, the bus thread skips the empty
+   * wakeup.
+   */
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spi_queue_transfer
+ *
+ * Description:
+ *   Execute a sequence through the bus queue and wait for its completion.
+ *   This lets synchronous users take part in the priority ordering of the
+ *   bus.
+ *
+ * Input Parameters:
+ *   queue    - The queue returned by spi_queue_initialize()
+ *   seq      - Describes the sequence of transfers.
+ *   priority - The priority of the sequence.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_transfer(FAR struct spi_queue_s *queue,
+                       FAR struct spi_sequence_s *seq, uint8_t priority)
+{
+  struct spi_waiter_s waiter;
+  int ret;
+
+  waiter.msg.seq      = seq;
+  waiter.msg.priority = priority;
+  waiter.msg.callback = spi_queue_wakeup;
+  waiter.msg.arg      = NULL;
+  waiter.result       = OK;
+
+  nxsem_init(&waiter.donesem, 0, 0);
+  nxsem_set_protocol(&waiter.donesem, SEM_PRIO_NONE);
+
+  ret = spi_queue_submit(queue, &waiter.msg);
+  if (ret >= 0)
+    {
+      nxsem_wait_uninterruptible(&waiter.donesem);
+      ret = waiter.result;
+    }
+
+  nxsem_destroy(&waiter.donesem);
+  return ret;
+}
+
+#endif /* CONFIG_SPI_QUEUE */
@@ -68,6 +68,7 @@ struct ramlog_dev_s
 #endif
   size_t            rl_bufsize;  /* Size of the RAM buffer */
   FAR char         *rl_buffer;   /* Circular RAM buffer */
+  volatile uint32_t rl_seq;      /* Number of bytes added, wrapping */
 
   /* The following is a list if poll structures of threads waiting for
    * driver events. The 'struct pollfd' reference for each open is also
@@ -88,7 +89,11 @@ static int     ramlog_readnotify(FAR struct ramlog_dev_s *priv);
 #endif
 static void    ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
                                  pollevent_t eventset);
-static int     ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch);
+static void    ramlog_notify(FAR struct ramlog_dev_s *priv);
+static size_t  ramlog_addspan(FAR struct ramlog_dev_s *priv,
+                              FAR const char *buffer, size_t len);
+static size_t  ramlog_addbuf(FAR struct ramlog_dev_s *priv,
+                             FAR const char *buffer, size_t len);
 
 /* Character driver methods */
 
@@ -213,7 +218,7 @@ static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
           fds->revents |= (fds->events & eventset);
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
 
@@ -276,166 +281,207 @@ static void ramlog_initbuf(void)
 #endif
 
 /****************************************************************************
- * Name: ramlog_addchar
+ * Name: ramlog_notify
+ *
+ * Description:
+ *   Wake up the readers after data was added to the buffer.
+ *
  ****************************************************************************/
 
-static int ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch)
+static void ramlog_notify(FAR struct ramlog_dev_s *priv)
 {
-  irqstate_t flags;
-  size_t nexthead;
-
-#ifdef CONFIG_RAMLOG_SYSLOG
-  if (priv == &g_sysdev)
-    {
-      ramlog_initbuf();
-    }
-#endif
+  int readers_waken = 0;
 
-  /* Disable interrupts (in case we are NOT called from interrupt handler) */
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  /* Are there threads waiting for read data? */
 
-  flags = enter_critical_section();
+  readers_waken = ramlog_readnotify(priv);
+#endif
 
-#ifdef CONFIG_RAMLOG_CRLF
-  /* Ignore carriage returns */
+  /* If there are multiple readers, some of them might block despite
+   * POLLIN because first reader might read all data. Favor readers
+   * and notify poll waiters only if no reader was awakened, even if
+   * the latter may starve.
+   *
+   * This also implies we do not have to make these two notify
+   * operations a critical section.
+   */
 
-  if (ch == '\r')
+  if (readers_waken == 0 &&
+      ramlog_bufferused(priv) >= CONFIG_RAMLOG_POLLTHRESHOLD)
     {
-      leave_critical_section(flags);
-      return OK;
-    }
-
-  /* Pre-pend a carriage before a linefeed */
+      /* Notify all poll/select waiters that they can read from the FIFO */
 
-  if (ch == '\n')
-    {
-      ch = '\r';
+      ramlog_pollnotify(priv, POLLIN);
     }
+}
 
-again:
-#endif
-
-  /* Calculate the write index AFTER the next byte is written */
-
-  nexthead = priv->rl_head + 1;
-  if (nexthead >= priv->rl_bufsize)
-    {
-      nexthead = 0;
-    }
+/****************************************************************************
+ * Name: ramlog_addspan
+ *
+ * Description:
+ *   Copy data into the circular buffer.  Without CONFIG_RAMLOG_OVERWRITE,
+ *   the data that does not fit is dropped.  With it, the oldest data is
+ *   dropped to make room.
+ *
+ * Returned Value:
+ *   The number of bytes consumed from 'buffer'.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
 
-  /* Would the next write overflow the circular buffer? */
+static size_t ramlog_addspan(FAR struct ramlog_dev_s *priv,
+                             FAR const char *buffer, size_t len)
+{
+  size_t nfree = priv->rl_bufsize - 1 - ramlog_bufferused(priv);
+  size_t nwritten = len;
+  size_t span;
 
-  if (nexthead == priv->rl_tail)
+  if (len > nfree)
     {
 #ifdef CONFIG_RAMLOG_OVERWRITE
-      /* Yes... Overwrite with the latest log in the circular buffer */
+      /* Only the end of a write longer than the buffer can be kept */
 
-      priv->rl_buffer[priv->rl_tail] = '\0';
-      priv->rl_tail += 1;
-      if (priv->rl_tail >= priv->rl_bufsize)
+      if (len > priv->rl_bufsize - 1)
         {
-          priv->rl_tail = 0;
+          priv->rl_seq += len - (priv->rl_bufsize - 1);
+          buffer       += len - (priv->rl_bufsize - 1);
+          len           = priv->rl_bufsize - 1;
         }
+
+      /* Drop the oldest data to make room for the latest log */
+
+      priv->rl_tail = (priv->rl_tail + len - nfree) % priv->rl_bufsize;
 #else
-      /* Yes... Return an indication that nothing was saved in the buffer. */
+      /* Keep what fits, the rest is dropped on the floor */
 
-      leave_critical_section(flags);
-      return -EBUSY;
+      len = nwritten = nfree;
 #endif
     }
 
-  /* No... copy the byte and re-enable interrupts */
+  /* Copy the data in at most two contiguous spans */
 
-  priv->rl_buffer[priv->rl_head] = ch;
-  priv->rl_head = nexthead;
-
-#ifdef CONFIG_RAMLOG_CRLF
-  if (ch == '\r')
+  while (len > 0)
     {
-      ch = '\n';
-      goto again;
+      span = priv->rl_bufsize - priv->rl_head;
+      if (span > len)
+        {
+          span = len;
+        }
+
+      memcpy(&priv->rl_buffer[priv->rl_head], buffer, span);
+
+      priv->rl_head += span;
+      if (priv->rl_head >= priv->rl_bufsize)
+        {
+          priv->rl_head = 0;
+        }
+
+      priv->rl_seq += span;
+      buffer       += span;
+      len          -= span;
     }
+
+#ifdef CONFIG_RAMLOG_OVERWRITE
+  /* The unused byte in front of the tail must stay zero so that
+   * ramlog_initbuf() can find the end of the log after a reset.
+   */
+
+  priv->rl_buffer[priv->rl_head] = '\0';
 #endif
 
-  leave_critical_section(flags);
-  return OK;
+  return nwritten;
 }
 
 /****************************************************************************
  * Name: ramlog_addbuf
+ *
+ * Description:
+ *   Add data to the circular buffer.  This may be called from interrupt
+ *   handlers and by concurrent writers:  Each call adds its data as one
+ *   piece within a single critical section.  The readers are not
+ *   notified.
+ *
+ * Returned Value:
+ *   The number of bytes consumed from 'buffer'.
+ *
  ****************************************************************************/
 
-static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
-                             FAR const char *buffer, size_t len)
+static size_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
+                            FAR const char *buffer, size_t len)
 {
-  int readers_waken;
-  ssize_t nwritten;
-  char ch;
-  int ret;
+  irqstate_t flags;
+  size_t nwritten = 0;
+  size_t span;
+  size_t ret;
 
-  ret = nxsem_wait(&priv->rl_exclsem);
-  if (ret < 0)
+#ifdef CONFIG_RAMLOG_SYSLOG
+  if (priv == &g_sysdev)
     {
-      return ret;
+      ramlog_initbuf();
     }
+#endif
+
+  /* Disable interrupts (in case we are NOT called from interrupt handler) */
+
+  flags = enter_critical_section();
 
-  for (nwritten = 0; (size_t)nwritten < len; nwritten++)
+  while (nwritten < len)
     {
-      /* Get the next character to output */
+#ifdef CONFIG_RAMLOG_CRLF
+      /* Ignore carriage returns */
 
-      ch = buffer[nwritten];
+      if (buffer[nwritten] == '\r')
+        {
+          nwritten++;
+          continue;
+        }
 
-      /* Then output the character */
+      /* Pre-pend a carriage before a linefeed */
 
-      ret = ramlog_addchar(priv, ch);
-      if (ret < 0)
+      if (buffer[nwritten] == '\n')
         {
-          /* The buffer is full and nothing was saved.  The remaining
-           * data to be written is dropped on the floor.
-           */
+          if (ramlog_addspan(priv, "\r\n", 2) < 2)
+            {
+              break;
+            }
 
-          break;
+          nwritten++;
+          continue;
         }
-    }
-
-  /* Was anything written? */
 
-  if (nwritten > 0)
-    {
-      readers_waken = 0;
+      /* Then copy everything up to the next line ending at once */
 
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-      /* Are there threads waiting for read data? */
+      for (span = nwritten; span < len; span++)
+        {
+          if (buffer[span] == '\r' || buffer[span] == '\n')
+            {
+              break;
+            }
+        }
 
-      readers_waken = ramlog_readnotify(priv);
+      span -= nwritten;
+#else
+      span = len - nwritten;
 #endif
 
-      /* If there are multiple readers, some of them might block despite
-       * POLLIN because first reader might read all data. Favor readers
-       * and notify poll waiters only if no reader was awakened, even if
-       * the latter may starve.
-       *
-       * This also implies we do not have to make these two notify
-       * operations a critical section.
-       */
+      ret = ramlog_addspan(priv, &buffer[nwritten], span);
+      nwritten += ret;
 
-      if (readers_waken == 0 &&
-          ramlog_bufferused(priv) >= CONFIG_RAMLOG_POLLTHRESHOLD)
+      if (ret < span)
         {
-          /* Notify all poll/select waiters that they can read from the
-           * FIFO.
+          /* The buffer is full.  The remaining data to be written is
+           * dropped on the floor.
            */
 
-          ramlog_pollnotify(priv, POLLIN);
+          break;
         }
     }
 
-  /* We always have to return the number of bytes requested and NOT the
-   * number of bytes that were actually written.  Otherwise, callers
-   * probably retry, causing same error condition again.
-   */
-
-  nxsem_post(&priv->rl_exclsem);
-  return len;
+  leave_critical_section(flags);
+  return nwritten;
 }
 
 /****************************************************************************
@@ -447,8 +493,9 @@ static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
+  irqstate_t flags;
   ssize_t nread;
-  char ch;
+  size_t span;
   int ret;
 
   /* Some sanity checking */
@@ -562,24 +609,40 @@ static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
         }
       else
         {
-          /* The circular buffer is not empty, get the next byte from the
-           * tail index.
+          /* The circular buffer is not empty, copy the contiguous data
+           * at the tail index.  The writers may move the tail in the
+           * overwrite mode, so this is done in a critical section.
            */
 
-          ch = priv->rl_buffer[priv->rl_tail];
-          priv->rl_buffer[priv->rl_tail] = '\0';
+          flags = enter_critical_section();
+
+          if (priv->rl_head >= priv->rl_tail)
+            {
+              span = priv->rl_head - priv->rl_tail;
+            }
+          else
+            {
+              span = priv->rl_bufsize - priv->rl_tail;
+            }
+
+          if (span > len - nread)
+            {
+              span = len - nread;
+            }
 
-          /* Increment the tail index. */
+          memcpy(&buffer[nread], &priv->rl_buffer[priv->rl_tail], span);
+          memset(&priv->rl_buffer[priv->rl_tail], 0, span);
 
-          if (++priv->rl_tail >= priv->rl_bufsize)
+          /* Advance the tail index */
+
+          priv->rl_tail += span;
+          if (priv->rl_tail >= priv->rl_bufsize)
             {
               priv->rl_tail = 0;
             }
 
-          /* Add the character to the user buffer. */
-
-          buffer[nread] = ch;
-          nread++;
+          leave_critical_section(flags);
+          nread += span;
         }
     }
 
@@ -618,7 +681,19 @@ static ssize_t ramlog_file_write(FAR struct file *filep,
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct ramlog_dev_s *)inode->i_private;
 
-  return ramlog_addbuf(priv, buffer, len);
+  /* Was anything written? */
+
+  if (ramlog_addbuf(priv, buffer, len) > 0)
+    {
+      ramlog_notify(priv);
+    }
+
+  /* We always have to return the number of bytes requested and NOT the
+   * number of bytes that were actually written.  Otherwise, callers
+   * probably retry, causing same error condition again.
+   */
+
+  return len;
 }
 
 /****************************************************************************
@@ -630,6 +705,8 @@ static int ramlog_file_ioctl(FAR struct file *filep, int cmd,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
+  FAR struct ramlog_state_s *state;
+  irqstate_t flags;
   int ret;
 
   DEBUGASSERT(inode && inode->i_private);
@@ -646,6 +723,24 @@ static int ramlog_file_ioctl(FAR struct file *filep, int cmd,
       case FIONREAD:
         *(FAR int *)((uintptr_t)arg) = ramlog_bufferused(priv);
         break;
+
+      case FIOC_MMAP:
+        *(FAR void **)((uintptr_t)arg) = priv->rl_buffer;
+        break;
+
+      case RAMLOGIOC_GETSTATE:
+        state = (FAR struct ramlog_state_s *)((uintptr_t)arg);
+
+        /* Sample the indices and the sequence number together */
+
+        flags = enter_critical_section();
+        state->rs_size = priv->rl_bufsize;
+        state->rs_head = priv->rl_head;
+        state->rs_tail = priv->rl_tail;
+        state->rs_seq  = priv->rl_seq;
+        leave_critical_section(flags);
+        break;
+
       default:
         ret = -ENOTTY;
         break;
@@ -854,42 +949,26 @@ void ramlog_syslog_register(void)
 int ramlog_putc(FAR struct syslog_channel_s *channel, int ch)
 {
   FAR struct ramlog_dev_s *priv = &g_sysdev;
-  int readers_waken = 0;
-  int ret;
+  char c = ch;
 
   UNUSED(channel);
 
   /* Add the character to the RAMLOG */
 
-  ret = ramlog_addchar(priv, ch);
-  if (ret < 0)
+  if (ramlog_addbuf(priv, &c, 1) == 0)
     {
       /* The buffer is full and 'ch' was not saved. */
 
-      return ret;
+      return -EBUSY;
     }
 
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-  /* Are there threads waiting for read data? */
-
-  readers_waken = ramlog_readnotify(priv);
-#endif
-
-  /* If there are multiple readers, some of them might block despite
-   * POLLIN because first reader might read all data. Favor readers
-   * and notify poll waiters only if no reader was awakened, even if
-   * the latter may starve.
-   *
-   * This also implies we do not have to make these two notify
-   * operations a critical section.
+  /* The SYSLOG output arrives one character at a time.  Wake up the
+   * readers only when a line is complete.
    */
 
-  if (readers_waken == 0 &&
-      ramlog_bufferused(priv) >= CONFIG_RAMLOG_POLLTHRESHOLD)
+  if (ch == '\n')
     {
-      /* Notify all poll/select waiters that they can read from the FIFO */
-
-      ramlog_pollnotify(priv, POLLIN);
+      ramlog_notify(priv);
     }
 
   /* Return the character added on success */
@@ -902,7 +981,12 @@ ssize_t ramlog_write(FAR struct syslog_channel_s *channel,
 {
   FAR struct ramlog_dev_s *priv = &g_sysdev;
 
-  return ramlog_addbuf(priv, buffer, buflen);
+  if (ramlog_addbuf(priv, buffer, buflen) > 0)
+    {
+      ramlog_notify(priv);
+    }
+
+  return buflen;
 }
 #endif
 
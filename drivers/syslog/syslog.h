@@ -28,7 +28,10 @@
 #include <nuttx/config.h>
 #include <nuttx/streams.h>
 
+#include <sys/types.h>
+#include <stdarg.h>
 #include <stdbool.h>
+#include <time.h>
 
 /****************************************************************************
  * Public Types
@@ -337,6 +340,107 @@ void syslogstream_destroy(FAR struct lib_syslogstream_s *stream);
 #  define syslogstream_destroy(s)
 #endif
 
+/****************************************************************************
+ * Name: syslog_gettime
+ *
+ * Description:
+ *   Sample the time that is used to timestamp a SYSLOG message.
+ *
+ * Input Parameters:
+ *   ts - The location to return the time
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+void syslog_gettime(FAR struct timespec *ts);
+#endif
+
+/****************************************************************************
+ * Name: syslog_header
+ *
+ * Description:
+ *   Generate the configured prefix (timestamp, CPU, process ID, color,
+ *   priority, prefix string and process name) of a SYSLOG message.
+ *
+ * Input Parameters:
+ *   stream   - The stream that receives the message
+ *   priority - The priority of the message
+ *   ts       - The time of the message (CONFIG_SYSLOG_TIMESTAMP only)
+ *   cpu      - The CPU that generated the message
+ *   pid      - The task that generated the message
+ *
+ * Returned Value:
+ *   The number of characters generated.
+ *
+ ****************************************************************************/
+
+int syslog_header(FAR struct lib_outstream_s *stream, int priority,
+                  FAR const struct timespec *ts, int cpu, pid_t pid);
+
+/****************************************************************************
+ * Name: syslog_trailer
+ *
+ * Description:
+ *   Generate the configured suffix of a SYSLOG message.
+ *
+ * Input Parameters:
+ *   stream - The stream that receives the message
+ *
+ * Returned Value:
+ *   The number of characters generated.
+ *
+ ****************************************************************************/
+
+int syslog_trailer(FAR struct lib_outstream_s *stream);
+
+/****************************************************************************
+ * Name: syslog_deferred
+ *
+ * Description:
+ *   Record the format string and the raw arguments of a SYSLOG message in
+ *   the per-CPU buffer of the deferred SYSLOG.  The message is formatted
+ *   later on the low priority work queue or by syslog_flush().
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   fmt      - The format string, which must stay valid until it is
+ *              formatted
+ *   ap       - The arguments of the format string
+ *
+ * Returned Value:
+ *   Zero (OK) if the message was recorded or was dropped because the
+ *   buffer is full.  A negated errno value if the message must be
+ *   formatted immediately.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+int syslog_deferred(int priority, FAR const IPTR char *fmt,
+                    FAR va_list *ap);
+#endif
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Format all messages recorded by syslog_deferred() and send them to the
+ *   SYSLOG channels.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+void syslog_flush_deferred(void);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,885 @@
+/****************************************************************************
+ * drivers/syslog/syslog_deferred.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <syslog.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/init.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define SYSLOG_NCPUS          CONFIG_SMP_NCPUS
+#  define syslog_cpu()          up_cpu_index()
+#  define syslog_lock(d)        spin_lock_wo_note(&(d)->sd_lock)
+#  define syslog_unlock(d)      spin_unlock_wo_note(&(d)->sd_lock)
+#else
+#  define SYSLOG_NCPUS          1
+#  define syslog_cpu()          0
+#  define syslog_lock(d)
+#  define syslog_unlock(d)
+#endif
+
+/* The largest record, header included.  The arguments that do not fit are
+ * dropped and the message is truncated at the first of them.
+ */
+
+#define SYSLOG_RECORD_SIZE      256
+
+/* The longest conversion specification that is passed to lib_sprintf() */
+
+#define SYSLOG_SPEC_SIZE        32
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The types of the arguments as they are recorded */
+
+enum syslog_arg_e
+{
+  SYSLOG_ARG_NONE = 0,  /* "%%" or an unknown conversion, no argument */
+  SYSLOG_ARG_SKIP,      /* "%n", the pointer argument is not recorded */
+  SYSLOG_ARG_INT,
+  SYSLOG_ARG_LONG,
+#ifdef CONFIG_HAVE_LONG_LONG
+  SYSLOG_ARG_LLONG,
+#endif
+  SYSLOG_ARG_INTMAX,
+  SYSLOG_ARG_SIZE,
+  SYSLOG_ARG_PTRDIFF,
+  SYSLOG_ARG_PTR,
+#ifdef CONFIG_HAVE_DOUBLE
+  SYSLOG_ARG_DOUBLE,
+#endif
+#ifdef CONFIG_HAVE_LONG_DOUBLE
+  SYSLOG_ARG_LDOUBLE,
+#endif
+  SYSLOG_ARG_STRING     /* "%s", the string is copied into the record */
+};
+
+/* One conversion specification of the format string */
+
+struct syslog_conv_s
+{
+  FAR const char *sc_end;  /* Just past the conversion character */
+  uint8_t sc_nstar;        /* Number of '*' width and precision arguments */
+  uint8_t sc_type;         /* Type of the argument, see enum syslog_arg_e */
+};
+
+/* The header of one record.  The raw arguments follow it in the order of
+ * the conversion specifications.
+ */
+
+struct syslog_record_s
+{
+  uint16_t sr_length;               /* Length of the record with header */
+  uint8_t sr_priority;              /* Priority of the message */
+  uint8_t sr_cpu;                   /* CPU that generated the message */
+  pid_t sr_pid;                     /* Task that generated the message */
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  struct timespec sr_time;          /* Time of the message */
+#endif
+  FAR const IPTR char *sr_fmt;      /* The format string */
+};
+
+/* The records of one CPU */
+
+struct syslog_deferred_s
+{
+#ifdef CONFIG_SMP
+  volatile spinlock_t sd_lock;      /* Serializes the writer and readers */
+#endif
+  volatile size_t sd_head;          /* Free running write index */
+  volatile size_t sd_tail;          /* Free running read index */
+  uint32_t sd_dropped;              /* Messages lost because of no room */
+  uint8_t sd_buffer[CONFIG_SYSLOG_DEFERRED_BUFSIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_deferred_s g_syslog_deferred[SYSLOG_NCPUS];
+static struct work_s g_syslog_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_parse
+ *
+ * Description:
+ *   Parse one conversion specification of a format string.
+ *
+ * Input Parameters:
+ *   fmt  - The format string just after the '%'
+ *   conv - The location to return the description of the conversion
+ *
+ * Returned Value:
+ *   The format string just after the conversion specification.
+ *
+ ****************************************************************************/
+
+static FAR const char *syslog_parse(FAR const char *fmt,
+                                    FAR struct syslog_conv_s *conv)
+{
+  int length = 0;
+
+  conv->sc_nstar = 0;
+  conv->sc_type  = SYSLOG_ARG_NONE;
+
+  /* Skip the flags, the field width and the precision */
+
+  while (*fmt != '\0' && strchr("-+ #0'.123456789*", *fmt) != NULL)
+    {
+      if (*fmt++ == '*')
+        {
+          conv->sc_nstar++;
+        }
+    }
+
+  /* Then the length modifiers.  'l' counts once per character, the other
+   * modifiers are remembered by their character.
+   */
+
+  while (*fmt != '\0' && strchr("hljztLq", *fmt) != NULL)
+    {
+      if (*fmt == 'l' || *fmt == 'q')
+        {
+          length = (length == 'l' || *fmt == 'q') ? 'q' : 'l';
+        }
+      else if (*fmt != 'h')
+        {
+          length = *fmt;
+        }
+
+      fmt++;
+    }
+
+  switch (*fmt)
+    {
+      case 'd':
+      case 'i':
+      case 'o':
+      case 'u':
+      case 'x':
+      case 'X':
+        switch (length)
+          {
+            case 'l':
+              conv->sc_type = SYSLOG_ARG_LONG;
+              break;
+
+#ifdef CONFIG_HAVE_LONG_LONG
+            case 'q':
+              conv->sc_type = SYSLOG_ARG_LLONG;
+              break;
+#endif
+
+            case 'j':
+              conv->sc_type = SYSLOG_ARG_INTMAX;
+              break;
+
+            case 'z':
+              conv->sc_type = SYSLOG_ARG_SIZE;
+              break;
+
+            case 't':
+              conv->sc_type = SYSLOG_ARG_PTRDIFF;
+              break;
+
+            default:
+              conv->sc_type = SYSLOG_ARG_INT;
+              break;
+          }
+        break;
+
+      case 'c':
+        conv->sc_type = SYSLOG_ARG_INT;
+        break;
+
+      case 'p':
+        conv->sc_type = SYSLOG_ARG_PTR;
+        break;
+
+      case 's':
+        conv->sc_type = SYSLOG_ARG_STRING;
+        break;
+
+      case 'n':
+        conv->sc_type = SYSLOG_ARG_SKIP;
+        break;
+
+#ifdef CONFIG_HAVE_DOUBLE
+      case 'a':
+      case 'A':
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+#ifdef CONFIG_HAVE_LONG_DOUBLE
+        if (length == 'L')
+          {
+            conv->sc_type = SYSLOG_ARG_LDOUBLE;
+            break;
+          }
+#endif
+
+        conv->sc_type = SYSLOG_ARG_DOUBLE;
+        break;
+#endif
+
+      default:
+        break;
+    }
+
+  /* Never step over the terminating NUL */
+
+  if (*fmt != '\0')
+    {
+      fmt++;
+    }
+
+  conv->sc_end = fmt;
+  return fmt;
+}
+
+/****************************************************************************
+ * Name: syslog_store
+ *
+ * Description:
+ *   Append one raw argument to a record.
+ *
+ ****************************************************************************/
+
+static bool syslog_store(FAR uint8_t *record, FAR size_t *length,
+                         FAR const void *value, size_t size)
+{
+  if (*length + size > SYSLOG_RECORD_SIZE)
+    {
+      return false;
+    }
+
+  memcpy(&record[*length], value, size);
+  *length += size;
+  return true;
+}
+
+/****************************************************************************
+ * Name: syslog_load
+ *
+ * Description:
+ *   Fetch the next raw argument from a record.
+ *
+ ****************************************************************************/
+
+static bool syslog_load(FAR const uint8_t *record, size_t length,
+                        FAR size_t *offset, FAR void *value, size_t size)
+{
+  if (*offset + size > length)
+    {
+      return false;
+    }
+
+  memcpy(value, &record[*offset], size);
+  *offset += size;
+  return true;
+}
+
+/****************************************************************************
+ * Name: syslog_copyin/syslog_copyout
+ *
+ * Description:
+ *   Copy data into or out of the circular buffer of one CPU.
+ *
+ ****************************************************************************/
+
+static void syslog_copyin(FAR struct syslog_deferred_s *deferred,
+                          size_t index, FAR const uint8_t *src,
+                          size_t len)
+{
+  size_t offset = index % CONFIG_SYSLOG_DEFERRED_BUFSIZE;
+  size_t span   = CONFIG_SYSLOG_DEFERRED_BUFSIZE - offset;
+
+  if (span > len)
+    {
+      span = len;
+    }
+
+  memcpy(&deferred->sd_buffer[offset], src, span);
+  memcpy(deferred->sd_buffer, src + span, len - span);
+}
+
+static void syslog_copyout(FAR struct syslog_deferred_s *deferred,
+                           size_t index, FAR uint8_t *dest, size_t len)
+{
+  size_t offset = index % CONFIG_SYSLOG_DEFERRED_BUFSIZE;
+  size_t span   = CONFIG_SYSLOG_DEFERRED_BUFSIZE - offset;
+
+  if (span > len)
+    {
+      span = len;
+    }
+
+  memcpy(dest, &deferred->sd_buffer[offset], span);
+  memcpy(dest + span, deferred->sd_buffer, len - span);
+}
+
+/****************************************************************************
+ * Name: syslog_remove
+ *
+ * Description:
+ *   Remove the oldest record of one CPU.
+ *
+ * Input Parameters:
+ *   deferred - The records of the CPU
+ *   record   - The location to return the record, SYSLOG_RECORD_SIZE bytes
+ *   dropped  - The location to return the number of lost messages
+ *
+ * Returned Value:
+ *   true if a record was removed, false if there are no records.
+ *
+ ****************************************************************************/
+
+static bool syslog_remove(FAR struct syslog_deferred_s *deferred,
+                          FAR uint8_t *record, FAR uint32_t *dropped)
+{
+  struct syslog_record_s header;
+  irqstate_t flags;
+  bool ret = false;
+
+  flags = up_irq_save();
+  syslog_lock(deferred);
+
+  *dropped = deferred->sd_dropped;
+  deferred->sd_dropped = 0;
+
+  if (deferred->sd_tail != deferred->sd_head)
+    {
+      syslog_copyout(deferred, deferred->sd_tail, (FAR uint8_t *)&header,
+                     sizeof(header));
+      syslog_copyout(deferred, deferred->sd_tail, record,
+                     header.sr_length);
+      deferred->sd_tail += header.sr_length;
+      ret = true;
+    }
+
+  syslog_unlock(deferred);
+  up_irq_restore(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: syslog_oldest
+ *
+ * Description:
+ *   Return the CPU that holds the oldest record.  Only the readers remove
+ *   records, so the record at the tail can be inspected without the lock.
+ *
+ * Returned Value:
+ *   The CPU index, or -1 if no CPU holds a record.
+ *
+ ****************************************************************************/
+
+static int syslog_oldest(void)
+{
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  struct syslog_record_s oldest;
+  struct syslog_record_s header;
+#endif
+  FAR struct syslog_deferred_s *deferred;
+  int ret = -1;
+  int cpu;
+
+  for (cpu = 0; cpu < SYSLOG_NCPUS; cpu++)
+    {
+      deferred = &g_syslog_deferred[cpu];
+      if (deferred->sd_tail == deferred->sd_head)
+        {
+          continue;
+        }
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+      syslog_copyout(deferred, deferred->sd_tail, (FAR uint8_t *)&header,
+                     sizeof(header));
+
+      if (ret < 0 || header.sr_time.tv_sec < oldest.sr_time.tv_sec ||
+          (header.sr_time.tv_sec == oldest.sr_time.tv_sec &&
+           header.sr_time.tv_nsec < oldest.sr_time.tv_nsec))
+        {
+          oldest = header;
+          ret    = cpu;
+        }
+#else
+      ret = cpu;
+      break;
+#endif
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: syslog_format
+ *
+ * Description:
+ *   Format one record and send it to the SYSLOG channels.
+ *
+ ****************************************************************************/
+
+static void syslog_format(FAR const uint8_t *record)
+{
+  struct lib_syslogstream_s stream;
+  struct syslog_record_s header;
+  struct syslog_conv_s conv;
+  FAR const char *fmt;
+  FAR const char *ptr;
+  char spec[SYSLOG_SPEC_SIZE];
+  size_t offset;
+  size_t nspec;
+  int star;
+  char ch;
+
+  memcpy(&header, record, sizeof(header));
+  offset = sizeof(header);
+
+  syslogstream_create(&stream);
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  syslog_header(&stream.public, header.sr_priority, &header.sr_time,
+                header.sr_cpu, header.sr_pid);
+#else
+  syslog_header(&stream.public, header.sr_priority, NULL,
+                header.sr_cpu, header.sr_pid);
+#endif
+
+  fmt = header.sr_fmt;
+  while ((ch = *fmt++) != '\0')
+    {
+      if (ch != '%')
+        {
+          stream.public.put(&stream.public, ch);
+          continue;
+        }
+
+      /* Rebuild the conversion specification with the recorded width and
+       * precision in place of the '*'.
+       */
+
+      ptr = fmt - 1;
+      syslog_parse(fmt, &conv);
+
+      for (nspec = 0; ptr < conv.sc_end; ptr++)
+        {
+          if (*ptr != '*')
+            {
+              if (nspec < SYSLOG_SPEC_SIZE - 1)
+                {
+                  spec[nspec++] = *ptr;
+                }
+
+              continue;
+            }
+
+          if (!syslog_load(record, header.sr_length, &offset, &star,
+                           sizeof(star)))
+            {
+              goto truncated;
+            }
+
+          if (star < 0 && nspec > 0 && spec[nspec - 1] == '.')
+            {
+              /* A negative precision is taken as if it were omitted */
+
+              nspec--;
+            }
+          else
+            {
+              nspec += snprintf(&spec[nspec], SYSLOG_SPEC_SIZE - nspec,
+                                "%d", star);
+              if (nspec > SYSLOG_SPEC_SIZE - 1)
+                {
+                  nspec = SYSLOG_SPEC_SIZE - 1;
+                }
+            }
+        }
+
+      spec[nspec] = '\0';
+      fmt = conv.sc_end;
+
+      switch (conv.sc_type)
+        {
+          case SYSLOG_ARG_NONE:
+            lib_sprintf(&stream.public, "%s",
+                        strcmp(spec, "%%") == 0 ? "%" : spec);
+            break;
+
+          case SYSLOG_ARG_SKIP:
+            break;
+
+#define SYSLOG_FORMAT(type) \
+            { \
+              type value; \
+              if (!syslog_load(record, header.sr_length, &offset, \
+                               &value, sizeof(value))) \
+                { \
+                  goto truncated; \
+                } \
+              lib_sprintf(&stream.public, spec, value); \
+            } \
+            break
+
+          case SYSLOG_ARG_INT:
+            SYSLOG_FORMAT(int);
+
+          case SYSLOG_ARG_LONG:
+            SYSLOG_FORMAT(long);
+
+#ifdef CONFIG_HAVE_LONG_LONG
+          case SYSLOG_ARG_LLONG:
+            SYSLOG_FORMAT(long long);
+#endif
+
+          case SYSLOG_ARG_INTMAX:
+            SYSLOG_FORMAT(intmax_t);
+
+          case SYSLOG_ARG_SIZE:
+            SYSLOG_FORMAT(size_t);
+
+          case SYSLOG_ARG_PTRDIFF:
+            SYSLOG_FORMAT(ptrdiff_t);
+
+          case SYSLOG_ARG_PTR:
+            SYSLOG_FORMAT(FAR void *);
+
+#ifdef CONFIG_HAVE_DOUBLE
+          case SYSLOG_ARG_DOUBLE:
+            SYSLOG_FORMAT(double);
+#endif
+
+#ifdef CONFIG_HAVE_LONG_DOUBLE
+          case SYSLOG_ARG_LDOUBLE:
+            SYSLOG_FORMAT(long double);
+#endif
+
+#undef SYSLOG_FORMAT
+
+          case SYSLOG_ARG_STRING:
+            if (offset >= header.sr_length)
+              {
+                goto truncated;
+              }
+
+            lib_sprintf(&stream.public, spec, (FAR const char *)
+                        &record[offset]);
+            offset += strlen((FAR const char *)&record[offset]) + 1;
+            break;
+        }
+    }
+
+  goto out;
+
+truncated:
+
+  /* The record could not hold all arguments */
+
+  lib_sprintf(&stream.public, "...\n");
+
+out:
+  syslog_trailer(&stream.public);
+  syslogstream_destroy(&stream);
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_worker
+ *
+ * Description:
+ *   Format the recorded messages on the low priority work queue.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_worker(FAR void *arg)
+{
+  syslog_flush_deferred();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_deferred
+ *
+ * Description:
+ *   Record the format string and the raw arguments of a SYSLOG message in
+ *   the per-CPU buffer of the deferred SYSLOG.
+ *
+ ****************************************************************************/
+
+int syslog_deferred(int priority, FAR const IPTR char *fmt,
+                    FAR va_list *ap)
+{
+  FAR struct syslog_deferred_s *deferred;
+  struct syslog_record_s header;
+  struct syslog_conv_s conv;
+  uint8_t record[SYSLOG_RECORD_SIZE];
+  FAR const char *ptr;
+  FAR const char *str;
+  irqstate_t flags;
+  size_t length;
+  size_t len;
+  bool full;
+  int i;
+
+  /* The work queue is not running before the OS is ready and the most
+   * severe messages must not wait for it.
+   */
+
+  if (!OSINIT_OS_READY() || priority <= LOG_ALERT)
+    {
+      return -EAGAIN;
+    }
+
+  /* Record the raw arguments after the header */
+
+  length = sizeof(header);
+  ptr    = fmt;
+
+  while (*ptr != '\0')
+    {
+      if (*ptr++ != '%')
+        {
+          continue;
+        }
+
+      ptr  = syslog_parse(ptr, &conv);
+      full = false;
+
+      for (i = 0; i < conv.sc_nstar && !full; i++)
+        {
+          int star = va_arg(*ap, int);
+          full = !syslog_store(record, &length, &star, sizeof(star));
+        }
+
+      switch (conv.sc_type)
+        {
+          case SYSLOG_ARG_NONE:
+            break;
+
+          case SYSLOG_ARG_SKIP:
+            va_arg(*ap, FAR void *);
+            break;
+
+#define SYSLOG_RECORD(type) \
+            { \
+              type value = va_arg(*ap, type); \
+              full = full || !syslog_store(record, &length, &value, \
+                                           sizeof(value)); \
+            } \
+            break
+
+          case SYSLOG_ARG_INT:
+            SYSLOG_RECORD(int);
+
+          case SYSLOG_ARG_LONG:
+            SYSLOG_RECORD(long);
+
+#ifdef CONFIG_HAVE_LONG_LONG
+          case SYSLOG_ARG_LLONG:
+            SYSLOG_RECORD(long long);
+#endif
+
+          case SYSLOG_ARG_INTMAX:
+            SYSLOG_RECORD(intmax_t);
+
+          case SYSLOG_ARG_SIZE:
+            SYSLOG_RECORD(size_t);
+
+          case SYSLOG_ARG_PTRDIFF:
+            SYSLOG_RECORD(ptrdiff_t);
+
+          case SYSLOG_ARG_PTR:
+            SYSLOG_RECORD(FAR void *);
+
+#ifdef CONFIG_HAVE_DOUBLE
+          case SYSLOG_ARG_DOUBLE:
+            SYSLOG_RECORD(double);
+#endif
+
+#ifdef CONFIG_HAVE_LONG_DOUBLE
+          case SYSLOG_ARG_LDOUBLE:
+            SYSLOG_RECORD(long double);
+#endif
+
+#undef SYSLOG_RECORD
+
+          case SYSLOG_ARG_STRING:
+
+            /* The string may not outlive the call, so copy it.  A string
+             * that does not fit completely is cut.
+             */
+
+            str = va_arg(*ap, FAR const char *);
+            if (str == NULL)
+              {
+                str = "(null)";
+              }
+
+            if (full || length >= SYSLOG_RECORD_SIZE)
+              {
+                full = true;
+                break;
+              }
+
+            len = strnlen(str, SYSLOG_RECORD_SIZE - length - 1);
+            memcpy(&record[length], str, len);
+            record[length + len] = '\0';
+            length += len + 1;
+            break;
+        }
+
+      if (full)
+        {
+          break;
+        }
+    }
+
+  header.sr_length   = length;
+  header.sr_priority = priority;
+  header.sr_pid      = getpid();
+  header.sr_fmt      = fmt;
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  syslog_gettime(&header.sr_time);
+#endif
+
+  /* Add the record to the buffer of this CPU.  Only the readers on other
+   * CPUs can contend for the lock.
+   */
+
+  flags    = up_irq_save();
+  deferred = &g_syslog_deferred[syslog_cpu()];
+
+  syslog_lock(deferred);
+
+  header.sr_cpu = syslog_cpu();
+  memcpy(record, &header, sizeof(header));
+
+  if (CONFIG_SYSLOG_DEFERRED_BUFSIZE -
+      (deferred->sd_head - deferred->sd_tail) < length)
+    {
+      deferred->sd_dropped++;
+    }
+  else
+    {
+      syslog_copyin(deferred, deferred->sd_head, record, length);
+      deferred->sd_head += length;
+    }
+
+  syslog_unlock(deferred);
+  up_irq_restore(flags);
+
+  /* Queue the formatting unless it is already pending.  Queuing it again
+   * would postpone the delayed work.
+   */
+
+  if (work_available(&g_syslog_work))
+    {
+      work_queue(LPWORK, &g_syslog_work, syslog_deferred_worker, NULL,
+                 MSEC2TICK(CONFIG_SYSLOG_DEFERRED_DELAY));
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Format all recorded messages, oldest first, and send them to the
+ *   SYSLOG channels.
+ *
+ ****************************************************************************/
+
+void syslog_flush_deferred(void)
+{
+  struct lib_syslogstream_s stream;
+  uint8_t record[SYSLOG_RECORD_SIZE];
+  uint32_t dropped[SYSLOG_NCPUS];
+  uint32_t count;
+  int cpu;
+
+  memset(dropped, 0, sizeof(dropped));
+
+  while ((cpu = syslog_oldest()) >= 0)
+    {
+      if (syslog_remove(&g_syslog_deferred[cpu], record, &count))
+        {
+          syslog_format(record);
+        }
+
+      dropped[cpu] += count;
+    }
+
+  /* The lost messages came after the records that were in the buffer */
+
+  for (cpu = 0; cpu < SYSLOG_NCPUS; cpu++)
+    {
+      if (dropped[cpu] > 0)
+        {
+          syslogstream_create(&stream);
+          lib_sprintf(&stream.public, "[CPU%d] %lu messages lost\n", cpu,
+                      (unsigned long)dropped[cpu]);
+          syslogstream_destroy(&stream);
+        }
+    }
+}
+
+#endif /* CONFIG_SYSLOG_DEFERRED */
@@ -202,6 +202,7 @@ void syslogstream_create(FAR struct lib_syslogstream_s *stream)
   /* Initialize the common fields */
 
   stream->public.put   = syslogstream_putc;
+  stream->public.puts  = NULL;
   stream->public.flush = lib_noflush;
   stream->public.nput  = 0;
 
@@ -30,7 +30,6 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/init.h>
-#include <nuttx/arch.h>
 #include <nuttx/clock.h>
 
 #include "syslog.h"
@@ -52,46 +51,18 @@ static FAR const char * g_priority_str[] =
  ****************************************************************************/
 
 /****************************************************************************
- * Name: nx_vsyslog
+ * Name: syslog_gettime
  *
  * Description:
- *   nx_vsyslog() handles the system logging system calls. It is functionally
- *   equivalent to vsyslog() except that (1) the per-process priority
- *   filtering has already been performed and the va_list parameter is
- *   passed by reference.  That is because the va_list is a structure in
- *   some compilers and passing of structures in the NuttX sycalls does
- *   not work.
+ *   Sample the time that is used to timestamp a SYSLOG message.
  *
  ****************************************************************************/
 
-int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
-{
-  struct lib_syslogstream_s stream;
-  int ret = 0;
-#if CONFIG_TASK_NAME_SIZE > 0 && defined(CONFIG_SYSLOG_PROCESS_NAME)
-  struct tcb_s *tcb;
-#endif
-#ifdef CONFIG_SYSLOG_TIMESTAMP
-  struct timespec ts;
-#if defined(CONFIG_SYSLOG_TIMESTAMP_FORMATTED)
-  struct tm tm;
-  char date_buf[CONFIG_SYSLOG_TIMESTAMP_BUFFER];
-#endif
-#endif
-
-  /* Wrap the low-level output in a stream object and let lib_vsprintf
-   * do the work.
-   */
-
-  syslogstream_create(&stream);
-
 #ifdef CONFIG_SYSLOG_TIMESTAMP
-  ts.tv_sec = 0;
-  ts.tv_nsec = 0;
-
-#if defined(CONFIG_SYSLOG_TIMESTAMP_FORMATTED)
-  memset(&tm, 0, sizeof(tm));
-#endif
+void syslog_gettime(FAR struct timespec *ts)
+{
+  ts->tv_sec = 0;
+  ts->tv_nsec = 0;
 
   /* Get the current time.  Since debug output may be generated very early
    * in the start-up sequence, hardware timer support may not yet be
@@ -103,54 +74,79 @@ int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
 #if defined(CONFIG_SYSLOG_TIMESTAMP_REALTIME)
       /* Use CLOCK_REALTIME if so configured */
 
-      clock_gettime(CLOCK_REALTIME, &ts);
+      clock_gettime(CLOCK_REALTIME, ts);
 
 #else
       /* Prefer monotonic when enabled, as it can be synchronized to
        * RTC with clock_resynchronize.
        */
 
-      clock_gettime(CLOCK_MONOTONIC, &ts);
+      clock_gettime(CLOCK_MONOTONIC, ts);
+#endif
+    }
+}
 #endif
 
-      /* Prepend the message with the current time, if available */
+/****************************************************************************
+ * Name: syslog_header
+ *
+ * Description:
+ *   Generate the configured prefix of a SYSLOG message.
+ *
+ ****************************************************************************/
+
+int syslog_header(FAR struct lib_outstream_s *stream, int priority,
+                  FAR const struct timespec *ts, int cpu, pid_t pid)
+{
+  int ret = 0;
+#if CONFIG_TASK_NAME_SIZE > 0 && defined(CONFIG_SYSLOG_PROCESS_NAME)
+  struct tcb_s *tcb;
+#endif
+#if defined(CONFIG_SYSLOG_TIMESTAMP_FORMATTED)
+  struct tm tm;
+  char date_buf[CONFIG_SYSLOG_TIMESTAMP_BUFFER];
+#endif
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  /* Prepend the message with the time, if available */
 
 #if defined(CONFIG_SYSLOG_TIMESTAMP_FORMATTED)
+  memset(&tm, 0, sizeof(tm));
+  if (ts->tv_sec != 0 || ts->tv_nsec != 0)
+    {
 #if defined(CONFIG_SYSLOG_TIMESTAMP_LOCALTIME)
-      localtime_r(&ts.tv_sec, &tm);
+      localtime_r(&ts->tv_sec, &tm);
 #else
-      gmtime_r(&ts.tv_sec, &tm);
-#endif
+      gmtime_r(&ts->tv_sec, &tm);
 #endif
     }
 
-#if defined(CONFIG_SYSLOG_TIMESTAMP_FORMATTED)
   ret = strftime(date_buf, CONFIG_SYSLOG_TIMESTAMP_BUFFER,
                  CONFIG_SYSLOG_TIMESTAMP_FORMAT, &tm);
 
   if (ret > 0)
     {
 #if defined(CONFIG_SYSLOG_TIMESTAMP_FORMAT_MICROSECOND)
-      ret = lib_sprintf(&stream.public, "[%s.%06ld] ",
-                        date_buf, ts.tv_nsec / NSEC_PER_USEC);
+      ret = lib_sprintf(stream, "[%s.%06ld] ",
+                        date_buf, ts->tv_nsec / NSEC_PER_USEC);
 #else
-      ret = lib_sprintf(&stream.public, "[%s] ", date_buf);
+      ret = lib_sprintf(stream, "[%s] ", date_buf);
 #endif
     }
 #else
-  ret = lib_sprintf(&stream.public, "[%5jd.%06ld] ",
-                    (uintmax_t)ts.tv_sec, ts.tv_nsec / NSEC_PER_USEC);
+  ret = lib_sprintf(stream, "[%5jd.%06ld] ",
+                    (uintmax_t)ts->tv_sec, ts->tv_nsec / NSEC_PER_USEC);
 #endif
 #endif
 
 #if defined(CONFIG_SMP)
-  ret += lib_sprintf(&stream.public, "[CPU%d] ", up_cpu_index());
+  ret += lib_sprintf(stream, "[CPU%d] ", cpu);
 #endif
 
 #if defined(CONFIG_SYSLOG_PROCESSID)
   /* Prepend the Process ID */
 
-  ret += lib_sprintf(&stream.public, "[%2d] ", (int)getpid());
+  ret += lib_sprintf(stream, "[%2d] ", (int)pid);
 #endif
 
 #if defined(CONFIG_SYSLOG_COLOR_OUTPUT)
@@ -159,34 +155,34 @@ int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
   switch (priority)
     {
       case LOG_EMERG:   /* Red, Bold, Blinking */
-        ret += lib_sprintf(&stream.public, "\e[31;1;5m");
+        ret += lib_sprintf(stream, "\e[31;1;5m");
         break;
 
       case LOG_ALERT:   /* Red, Bold */
-        ret += lib_sprintf(&stream.public, "\e[31;1m");
+        ret += lib_sprintf(stream, "\e[31;1m");
         break;
 
       case LOG_CRIT:    /* Red, Bold */
-        ret += lib_sprintf(&stream.public, "\e[31;1m");
+        ret += lib_sprintf(stream, "\e[31;1m");
         break;
 
       case LOG_ERR:     /* Red */
-        ret += lib_sprintf(&stream.public, "\e[31m");
+        ret += lib_sprintf(stream, "\e[31m");
         break;
 
       case LOG_WARNING: /* Yellow */
-        ret += lib_sprintf(&stream.public, "\e[33m");
+        ret += lib_sprintf(stream, "\e[33m");
         break;
 
       case LOG_NOTICE:  /* Bold */
-        ret += lib_sprintf(&stream.public, "\e[1m");
+        ret += lib_sprintf(stream, "\e[1m");
         break;
 
       case LOG_INFO:    /* Normal */
         break;
 
       case LOG_DEBUG:   /* Dim */
-        ret += lib_sprintf(&stream.public, "\e[2m");
+        ret += lib_sprintf(stream, "\e[2m");
         break;
     }
 #endif
@@ -194,33 +190,94 @@ int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
 #if defined(CONFIG_SYSLOG_PRIORITY)
   /* Prepend the message priority. */
 
-  ret += lib_sprintf(&stream.public, "[%6s] ", g_priority_str[priority]);
+  ret += lib_sprintf(stream, "[%6s] ", g_priority_str[priority]);
 #endif
 
 #if defined(CONFIG_SYSLOG_PREFIX)
   /* Prepend the prefix, if available */
 
-  ret += lib_sprintf(&stream.public, "[%s] ", CONFIG_SYSLOG_PREFIX_STRING);
+  ret += lib_sprintf(stream, "[%s] ", CONFIG_SYSLOG_PREFIX_STRING);
 #endif
 
 #if CONFIG_TASK_NAME_SIZE > 0 && defined(CONFIG_SYSLOG_PROCESS_NAME)
   /* Prepend the process name */
 
-  tcb = nxsched_get_tcb(getpid());
-  ret += lib_sprintf(&stream.public, "%s: ",
-                     (tcb != NULL) ? tcb->name : "(null)");
+  tcb = nxsched_get_tcb(pid);
+  ret += lib_sprintf(stream, "%s: ", (tcb != NULL) ? tcb->name : "(null)");
 #endif
 
-  /* Generate the output */
+  return ret;
+}
 
-  ret += lib_vsprintf(&stream.public, fmt, *ap);
+/****************************************************************************
+ * Name: syslog_trailer
+ *
+ * Description:
+ *   Generate the configured suffix of a SYSLOG message.
+ *
+ * Returned Value:
+ *   The number of characters generated.
+ *
+ ****************************************************************************/
 
+int syslog_trailer(FAR struct lib_outstream_s *stream)
+{
 #if defined(CONFIG_SYSLOG_COLOR_OUTPUT)
   /* Reset the terminal style back to normal. */
 
-  ret += lib_sprintf(&stream.public, "\e[0m");
+  return lib_sprintf(stream, "\e[0m");
+#else
+  return 0;
+#endif
+}
+
+/****************************************************************************
+ * Name: nx_vsyslog
+ *
+ * Description:
+ *   nx_vsyslog() handles the system logging system calls. It is functionally
+ *   equivalent to vsyslog() except that (1) the per-process priority
+ *   filtering has already been performed and the va_list parameter is
+ *   passed by reference.  That is because the va_list is a structure in
+ *   some compilers and passing of structures in the NuttX sycalls does
+ *   not work.
+ *
+ ****************************************************************************/
+
+int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
+{
+  struct lib_syslogstream_s stream;
+  struct timespec ts;
+  int ret;
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+  /* Record the message to be formatted later, if possible */
+
+  ret = syslog_deferred(priority, fmt, ap);
+  if (ret >= 0)
+    {
+      return ret;
+    }
 #endif
 
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  syslog_gettime(&ts);
+#endif
+
+  /* Wrap the low-level output in a stream object and let lib_vsprintf
+   * do the work.
+   */
+
+  syslogstream_create(&stream);
+
+  ret  = syslog_header(&stream.public, priority, &ts, up_cpu_index(),
+                       getpid());
+
+  /* Generate the output */
+
+  ret += lib_vsprintf(&stream.public, fmt, *ap);
+  ret += syslog_trailer(&stream.public);
+
 #ifdef CONFIG_SYSLOG_BUFFER
   /* Flush and destroy the syslog stream buffer */
 
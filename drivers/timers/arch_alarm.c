@@ -24,6 +24,8 @@
 
 #include <nuttx/config.h>
 
+#include <assert.h>
+
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
 #include <nuttx/timers/arch_alarm.h>
@@ -45,6 +47,12 @@
 
 static FAR struct oneshot_lowerhalf_s *g_oneshot_lower;
 
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+/* The local oneshot timers of each CPU used to time the time slices */
+
+static FAR struct oneshot_lowerhalf_s *g_cpu_oneshot_lower[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -147,6 +155,19 @@ static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
 #endif
 }
 
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+static void cpu_oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
+                                 FAR void *arg)
+{
+  struct timespec now;
+
+  /* Report the time in the time base of the global oneshot timer */
+
+  ONESHOT_CURRENT(g_oneshot_lower, &now);
+  nxsched_cpu_alarm_expiration(&now);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -170,6 +191,25 @@ void up_alarm_set_lowerhalf(FAR struct oneshot_lowerhalf_s *lower)
 #endif
 }
 
+/****************************************************************************
+ * Name: up_cpu_alarm_set_lowerhalf
+ *
+ * Description:
+ *   Register the local oneshot timer of a CPU.  Its callback must run on
+ *   that CPU.  The global oneshot timer registered with
+ *   up_alarm_set_lowerhalf() remains the time base.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+void up_cpu_alarm_set_lowerhalf(int cpu,
+                                FAR struct oneshot_lowerhalf_s *lower)
+{
+  DEBUGASSERT(cpu >= 0 && cpu < CONFIG_SMP_NCPUS);
+  g_cpu_oneshot_lower[cpu] = lower;
+}
+#endif
+
 /****************************************************************************
  * Name: up_timer_gettime
  *
@@ -354,6 +394,51 @@ int weak_function up_alarm_start(FAR const struct timespec *ts)
 }
 #endif
 
+/****************************************************************************
+ * Name: up_cpu_alarm_start and up_cpu_alarm_cancel
+ *
+ * Description:
+ *   Start or cancel the local alarm of the calling CPU using the oneshot
+ *   timer registered with up_cpu_alarm_set_lowerhalf().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+int weak_function up_cpu_alarm_start(FAR const struct timespec *ts)
+{
+  FAR struct oneshot_lowerhalf_s *lower;
+  int ret = -EAGAIN;
+
+  lower = g_cpu_oneshot_lower[up_cpu_index()];
+  if (lower != NULL && g_oneshot_lower != NULL)
+    {
+      struct timespec now;
+      struct timespec delta;
+
+      ONESHOT_CURRENT(g_oneshot_lower, &now);
+      clock_timespec_subtract(ts, &now, &delta);
+      ret = ONESHOT_START(lower, cpu_oneshot_callback, NULL, &delta);
+    }
+
+  return ret;
+}
+
+int weak_function up_cpu_alarm_cancel(void)
+{
+  FAR struct oneshot_lowerhalf_s *lower;
+  struct timespec ts;
+  int ret = -EAGAIN;
+
+  lower = g_cpu_oneshot_lower[up_cpu_index()];
+  if (lower != NULL)
+    {
+      ret = ONESHOT_CANCEL(lower, &ts);
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: up_perf_*
  *
@@ -0,0 +1,475 @@
+/****************************************************************************
+ * drivers/timers/hrtimer.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/timers/hrtimer.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define timespec_to_nsec(ts) \
+    ((uint64_t)(ts)->tv_sec * NSEC_PER_SEC + (ts)->tv_nsec)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void hrtimer_callback(FAR struct oneshot_lowerhalf_s *lower,
+                             FAR void *arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct oneshot_lowerhalf_s *g_hrtimer_lower;
+static uint64_t g_hrtimer_maxdelay;
+
+/* g_hrtimer_root is the root of a pairing heap of the active timers,
+ * ordered by expiration time.  The root is the timer that expires next.
+ */
+
+static FAR struct hrtimer_s *g_hrtimer_root;
+
+/* True while the expiration loop runs.  The loop reprograms the oneshot
+ * timer once at the end, so timers started from callbacks need not.
+ */
+
+static bool g_hrtimer_expiring;
+static spinlock_t g_hrtimer_lock;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline void timespec_from_nsec(FAR struct timespec *ts,
+                                      uint64_t nanoseconds)
+{
+  ts->tv_sec  = nanoseconds / NSEC_PER_SEC;
+  ts->tv_nsec = nanoseconds - (uint64_t)ts->tv_sec * NSEC_PER_SEC;
+}
+
+static uint64_t hrtimer_now(void)
+{
+  struct timespec ts;
+
+  if (ONESHOT_CURRENT(g_hrtimer_lower, &ts) < 0)
+    {
+      return 0;
+    }
+
+  return timespec_to_nsec(&ts);
+}
+
+/****************************************************************************
+ * Name: hrtimer_meld
+ *
+ * Description:
+ *   Combine two pairing heaps, making the root that expires later the first
+ *   child of the other.  Both roots must be detached (no siblings).
+ *
+ ****************************************************************************/
+
+static FAR struct hrtimer_s *hrtimer_meld(FAR struct hrtimer_s *a,
+                                          FAR struct hrtimer_s *b)
+{
+  FAR struct hrtimer_s *tmp;
+
+  if (a == NULL)
+    {
+      return b;
+    }
+
+  if (b == NULL)
+    {
+      return a;
+    }
+
+  if (b->expired < a->expired)
+    {
+      tmp = a;
+      a   = b;
+      b   = tmp;
+    }
+
+  b->prev = a;
+  b->next = a->child;
+  if (a->child != NULL)
+    {
+      a->child->prev = b;
+    }
+
+  a->child = b;
+  return a;
+}
+
+/****************************************************************************
+ * Name: hrtimer_mergepairs
+ *
+ * Description:
+ *   Combine a list of sibling heaps into one with the usual two-pass
+ *   pairing.
+ *
+ ****************************************************************************/
+
+static FAR struct hrtimer_s *hrtimer_mergepairs(FAR struct hrtimer_s *first)
+{
+  FAR struct hrtimer_s *pairs = NULL;
+  FAR struct hrtimer_s *root = NULL;
+  FAR struct hrtimer_s *a;
+  FAR struct hrtimer_s *b;
+
+  while (first != NULL)
+    {
+      a     = first;
+      b     = a->next;
+      first = b != NULL ? b->next : NULL;
+
+      a->next = a->prev = NULL;
+      if (b != NULL)
+        {
+          b->next = b->prev = NULL;
+        }
+
+      a       = hrtimer_meld(a, b);
+      a->next = pairs;
+      pairs   = a;
+    }
+
+  while (pairs != NULL)
+    {
+      a       = pairs;
+      pairs   = a->next;
+      a->next = NULL;
+      root    = hrtimer_meld(root, a);
+    }
+
+  return root;
+}
+
+/****************************************************************************
+ * Name: hrtimer_remove
+ *
+ * Description:
+ *   Remove an active timer from the heap.  The caller holds the lock.
+ *
+ ****************************************************************************/
+
+static void hrtimer_remove(FAR struct hrtimer_s *timer)
+{
+  if (timer == g_hrtimer_root)
+    {
+      g_hrtimer_root = hrtimer_mergepairs(timer->child);
+    }
+  else
+    {
+      if (timer->prev->child == timer)
+        {
+          timer->prev->child = timer->next;
+        }
+      else
+        {
+          timer->prev->next = timer->next;
+        }
+
+      if (timer->next != NULL)
+        {
+          timer->next->prev = timer->prev;
+        }
+
+      g_hrtimer_root = hrtimer_meld(g_hrtimer_root,
+                                    hrtimer_mergepairs(timer->child));
+    }
+
+  timer->child = NULL;
+  timer->next  = NULL;
+  timer->prev  = NULL;
+}
+
+/****************************************************************************
+ * Name: hrtimer_reprogram
+ *
+ * Description:
+ *   Program the oneshot timer for the timer at the root of the heap.  The
+ *   caller holds the lock.
+ *
+ ****************************************************************************/
+
+static void hrtimer_reprogram(void)
+{
+  struct timespec ts;
+  uint64_t delay;
+  uint64_t now;
+
+  if (g_hrtimer_expiring)
+    {
+      return;
+    }
+
+  ONESHOT_CANCEL(g_hrtimer_lower, &ts);
+
+  if (g_hrtimer_root != NULL)
+    {
+      /* A timer that is already due still needs an interrupt so that its
+       * callback runs in the usual context.
+       */
+
+      now   = hrtimer_now();
+      delay = g_hrtimer_root->expired > now ?
+              g_hrtimer_root->expired - now : 1;
+
+      if (delay > g_hrtimer_maxdelay)
+        {
+          delay = g_hrtimer_maxdelay;
+        }
+
+      timespec_from_nsec(&ts, delay);
+      ONESHOT_START(g_hrtimer_lower, hrtimer_callback, NULL, &ts);
+    }
+}
+
+/****************************************************************************
+ * Name: hrtimer_callback
+ *
+ * Description:
+ *   Called from the oneshot interrupt.  Run the callbacks of all expired
+ *   timers, then program the oneshot timer for the next one.  The timer
+ *   may also fire early because of the maximum delay of the lower half;
+ *   then nothing expires and the oneshot timer is simply reprogrammed.
+ *
+ ****************************************************************************/
+
+static void hrtimer_callback(FAR struct oneshot_lowerhalf_s *lower,
+                             FAR void *arg)
+{
+  FAR struct hrtimer_s *timer;
+  hrtimer_entry_t func;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+  g_hrtimer_expiring = true;
+
+  while (g_hrtimer_root != NULL &&
+         g_hrtimer_root->expired <= hrtimer_now())
+    {
+      timer = g_hrtimer_root;
+      hrtimer_remove(timer);
+
+      /* Mark the timer inactive before calling the function which may
+       * restart it.
+       */
+
+      func        = timer->func;
+      arg         = timer->arg;
+      timer->func = NULL;
+
+      spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+      func(timer, arg);
+      flags = spin_lock_irqsave(&g_hrtimer_lock);
+    }
+
+  g_hrtimer_expiring = false;
+  hrtimer_reprogram();
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_initialize
+ *
+ * Description:
+ *   Bind the high resolution timers to a oneshot timer lower half.
+ *
+ ****************************************************************************/
+
+int hrtimer_initialize(FAR struct oneshot_lowerhalf_s *lower)
+{
+  struct timespec ts;
+  irqstate_t flags;
+  int ret;
+
+  if (lower == NULL || lower->ops->current == NULL)
+    {
+      return -EINVAL;
+    }
+
+  ret = ONESHOT_MAX_DELAY(lower, &ts);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+  g_hrtimer_lower    = lower;
+  g_hrtimer_maxdelay = timespec_to_nsec(&ts);
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: hrtimer_current
+ *
+ * Description:
+ *   Return the current time of the high resolution timer clock.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_current(void)
+{
+  return g_hrtimer_lower != NULL ? hrtimer_now() : 0;
+}
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start (or restart) a high resolution timer.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *timer, uint64_t ns,
+                  enum hrtimer_mode_e mode, hrtimer_entry_t func,
+                  FAR void *arg)
+{
+  irqstate_t flags;
+
+  if (timer == NULL || func == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (g_hrtimer_lower == NULL)
+    {
+      return -ENODEV;
+    }
+
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+  if (HRTIMER_ISACTIVE(timer))
+    {
+      hrtimer_remove(timer);
+    }
+
+  if (mode == HRTIMER_MODE_REL)
+    {
+      ns += hrtimer_now();
+    }
+
+  timer->func    = func;
+  timer->arg     = arg;
+  timer->expired = ns;
+  timer->child   = NULL;
+  timer->next    = NULL;
+  timer->prev    = NULL;
+
+  g_hrtimer_root = hrtimer_meld(g_hrtimer_root, timer);
+
+  /* Reprogram the oneshot timer if this is now the first timer to expire */
+
+  if (g_hrtimer_root == timer)
+    {
+      hrtimer_reprogram();
+    }
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Cancel a high resolution timer.
+ *
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *timer)
+{
+  irqstate_t flags;
+  bool head;
+  int ret = -EINVAL;
+
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+  if (timer != NULL && HRTIMER_ISACTIVE(timer))
+    {
+      head = (timer == g_hrtimer_root);
+
+      hrtimer_remove(timer);
+      timer->func = NULL;
+
+      if (head)
+        {
+          hrtimer_reprogram();
+        }
+
+      ret = OK;
+    }
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the time remaining before a high resolution timer expires.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(FAR struct hrtimer_s *timer)
+{
+  irqstate_t flags;
+  uint64_t remaining = 0;
+  uint64_t now;
+
+  flags = spin_lock_irqsave(&g_hrtimer_lock);
+
+  if (timer != NULL && HRTIMER_ISACTIVE(timer))
+    {
+      now = hrtimer_now();
+      if (timer->expired > now)
+        {
+          remaining = timer->expired - now;
+        }
+    }
+
+  spin_unlock_irqrestore(&g_hrtimer_lock, flags);
+  return remaining;
+}
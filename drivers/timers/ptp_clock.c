@@ -0,0 +1,313 @@
+/****************************************************************************
+ * drivers/timers/ptp_clock.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/timers/ptp_clock.h>
+
+#ifdef CONFIG_PTP_CLOCK
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PTP_DEVNAME_FMT  "/dev/ptp%d"
+#define PTP_DEVNAME_MAX  16
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes the state of the upper half driver */
+
+struct ptp_upperhalf_s
+{
+  mutex_t lock;                        /* Serializes the lower half calls */
+  int devno;                           /* The N of /dev/ptpN */
+  FAR struct ptp_lowerhalf_s *lower;   /* The lower half driver */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int ptp_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_ptp_fops =
+{
+  NULL,        /* open */
+  NULL,        /* close */
+  NULL,        /* read */
+  NULL,        /* write */
+  NULL,        /* seek */
+  ptp_ioctl,   /* ioctl */
+  NULL         /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL       /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ptp_adjtime
+ *
+ * Description:
+ *   Step the clock by 'delta' nanoseconds, with the method of the lower
+ *   half if it has one.
+ *
+ ****************************************************************************/
+
+static int ptp_adjtime(FAR struct ptp_lowerhalf_s *lower, int64_t delta)
+{
+  struct timespec ts;
+  int64_t nsec;
+  int ret;
+
+  if (lower->ops->adjtime != NULL)
+    {
+      return lower->ops->adjtime(lower, delta);
+    }
+
+  ret = lower->ops->gettime(lower, &ts);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  nsec = (int64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec + delta;
+  if (nsec < 0)
+    {
+      return -EINVAL;
+    }
+
+  ts.tv_sec  = nsec / NSEC_PER_SEC;
+  ts.tv_nsec = nsec % NSEC_PER_SEC;
+  return lower->ops->settime(lower, &ts);
+}
+
+/****************************************************************************
+ * Name: ptp_ioctl
+ ****************************************************************************/
+
+static int ptp_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct ptp_upperhalf_s *upper = inode->i_private;
+  FAR struct ptp_lowerhalf_s *lower = upper->lower;
+  int ret;
+
+  /* Commands that change the clock need write access */
+
+  if ((cmd == PTPIOC_SETTIME || cmd == PTPIOC_ADJTIME ||
+       cmd == PTPIOC_ADJFREQ) && (filep->f_oflags & O_WROK) == 0)
+    {
+      return -EPERM;
+    }
+
+  ret = nxmutex_lock(&upper->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (cmd)
+    {
+      case PTPIOC_GETCAPS:
+        {
+          FAR struct ptp_clock_caps_s *caps =
+            (FAR struct ptp_clock_caps_s *)((uintptr_t)arg);
+
+          if (caps == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          caps->max_adj = lower->max_adj;
+          ret = OK;
+        }
+        break;
+
+      case PTPIOC_GETTIME:
+        {
+          FAR struct timespec *ts = (FAR struct timespec *)((uintptr_t)arg);
+
+          ret = ts != NULL ? lower->ops->gettime(lower, ts) : -EINVAL;
+        }
+        break;
+
+      case PTPIOC_SETTIME:
+        {
+          FAR const struct timespec *ts =
+            (FAR const struct timespec *)((uintptr_t)arg);
+
+          if (ts == NULL || ts->tv_nsec < 0 || ts->tv_nsec >= NSEC_PER_SEC)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          ret = lower->ops->settime(lower, ts);
+        }
+        break;
+
+      case PTPIOC_ADJTIME:
+        {
+          FAR const int64_t *delta = (FAR const int64_t *)((uintptr_t)arg);
+
+          ret = delta != NULL ? ptp_adjtime(lower, *delta) : -EINVAL;
+        }
+        break;
+
+      case PTPIOC_ADJFREQ:
+        {
+          long ppb = (long)arg;
+
+          if (ppb > lower->max_adj || ppb < -lower->max_adj)
+            {
+              ret = -ERANGE;
+              break;
+            }
+
+          ret = lower->ops->adjfreq(lower, ppb);
+        }
+        break;
+
+      case PTPIOC_SYSOFFSET:
+        {
+          FAR struct ptp_sys_offset_s *off =
+            (FAR struct ptp_sys_offset_s *)((uintptr_t)arg);
+
+          if (off == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          clock_gettime(CLOCK_REALTIME, &off->ts[0]);
+          ret = lower->ops->gettime(lower, &off->ts[1]);
+          clock_gettime(CLOCK_REALTIME, &off->ts[2]);
+        }
+        break;
+
+      default:
+        ret = -ENOTTY;
+        if (lower->ops->ioctl != NULL)
+          {
+            ret = lower->ops->ioctl(lower, cmd, arg);
+          }
+        break;
+    }
+
+  nxmutex_unlock(&upper->lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ptp_clock_register
+ *
+ * Description:
+ *   Register a PTP hardware clock as /dev/ptpN.
+ *
+ ****************************************************************************/
+
+FAR void *ptp_clock_register(FAR struct ptp_lowerhalf_s *lower, int devno)
+{
+  FAR struct ptp_upperhalf_s *upper;
+  char path[PTP_DEVNAME_MAX];
+  int ret;
+
+  DEBUGASSERT(lower != NULL && lower->ops != NULL &&
+              lower->ops->gettime != NULL && lower->ops->settime != NULL &&
+              lower->ops->adjfreq != NULL);
+
+  upper = kmm_zalloc(sizeof(struct ptp_upperhalf_s));
+  if (upper == NULL)
+    {
+      return NULL;
+    }
+
+  upper->lower = lower;
+  upper->devno = devno;
+  nxmutex_init(&upper->lock);
+
+  snprintf(path, sizeof(path), PTP_DEVNAME_FMT, devno);
+  ret = register_driver(path, &g_ptp_fops, 0666, upper);
+  if (ret < 0)
+    {
+      tmrerr("ERROR: register_driver %s failed: %d\n", path, ret);
+      nxmutex_destroy(&upper->lock);
+      kmm_free(upper);
+      return NULL;
+    }
+
+  return upper;
+}
+
+/****************************************************************************
+ * Name: ptp_clock_unregister
+ *
+ * Description:
+ *   Remove a PTP hardware clock registered by ptp_clock_register().
+ *
+ ****************************************************************************/
+
+void ptp_clock_unregister(FAR void *handle)
+{
+  FAR struct ptp_upperhalf_s *upper = handle;
+  char path[PTP_DEVNAME_MAX];
+
+  DEBUGASSERT(upper != NULL);
+
+  snprintf(path, sizeof(path), PTP_DEVNAME_FMT, upper->devno);
+  unregister_driver(path);
+
+  nxmutex_destroy(&upper->lock);
+  kmm_free(upper);
+}
+
+#endif /* CONFIG_PTP_CLOCK */
@@ -1565,7 +1565,7 @@ static void adb_char_pollnotify(FAR struct usbdev_adb_s *dev,
 
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -90,6 +90,14 @@
 #  define CONFIG_CDCECM_NINTERFACES 1
 #endif
 
+#ifndef CONFIG_CDCECM_NRDREQS
+#  define CONFIG_CDCECM_NRDREQS 2
+#endif
+
+#ifndef CONFIG_CDCECM_NWRREQS
+#  define CONFIG_CDCECM_NWRREQS 2
+#endif
+
 /* TX poll delay = 1 seconds.
  * CLK_TCK is the number of clock ticks per second
  */
@@ -108,6 +116,14 @@
  * Private Types
  ****************************************************************************/
 
+/* Container to support a list of requests */
+
+struct cdcecm_req_s
+{
+  FAR struct cdcecm_req_s *flink;  /* Implements a singly linked list */
+  FAR struct usbdev_req_s *req;    /* The contained request */
+};
+
 /* The cdcecm_driver_s encapsulates all state information for a single
  * hardware interface
  */
@@ -127,11 +143,12 @@ struct cdcecm_driver_s
   uint16_t                     pktbuf[(CONFIG_NET_ETH_PKTSIZE +
                                        CONFIG_NET_GUARDSIZE + 1) / 2];
 
-  struct usbdev_req_s         *rdreq;       /* Single read request */
-  bool                         rxpending;   /* Packet available in rdreq */
+  struct cdcecm_req_s          rdreqs[CONFIG_CDCECM_NRDREQS];
+  sq_queue_t                   rxqueue;     /* Completed read requests */
 
-  struct usbdev_req_s         *wrreq;       /* Single write request */
-  sem_t                        wrreq_idle;  /* Is the wrreq available? */
+  struct cdcecm_req_s          wrreqs[CONFIG_CDCECM_NWRREQS];
+  sq_queue_t                   wrfree;      /* Available write requests */
+  sem_t                        wrreq_idle;  /* Counts the wrfree entries */
   bool                         txdone;      /* Did a write request complete? */
 
   /* Network device */
@@ -164,7 +181,8 @@ static int  cdcecm_txpoll(FAR struct net_driver_s *dev);
 /* Interrupt handling */
 
 static void cdcecm_reply(struct cdcecm_driver_s *priv);
-static void cdcecm_receive(FAR struct cdcecm_driver_s *priv);
+static void cdcecm_receive(FAR struct cdcecm_driver_s *priv,
+                           FAR struct usbdev_req_s *req);
 static void cdcecm_txdone(FAR struct cdcecm_driver_s *priv);
 
 static void cdcecm_interrupt_work(FAR void *arg);
@@ -305,24 +323,45 @@ static const struct usb_devdesc_s g_devdesc =
 
 static int cdcecm_transmit(FAR struct cdcecm_driver_s *self)
 {
-  /* Wait until the USB device request for Ethernet frame transmissions
-   * becomes available.
+  FAR struct cdcecm_req_s *wrcontainer;
+  FAR struct usbdev_req_s *req;
+  irqstate_t flags;
+  int ret;
+
+  /* Wait until one of the USB device requests for Ethernet frame
+   * transmissions becomes available.
    */
 
   while (nxsem_wait(&self->wrreq_idle) != OK)
     {
     }
 
+  flags = enter_critical_section();
+  wrcontainer = (FAR struct cdcecm_req_s *)sq_remfirst(&self->wrfree);
+  leave_critical_section(flags);
+
+  DEBUGASSERT(wrcontainer != NULL);
+  req = wrcontainer->req;
+
   /* Increment statistics */
 
   NETDEV_TXPACKETS(self->dev);
 
   /* Send the packet: address=priv->dev.d_buf, length=priv->dev.d_len */
 
-  memcpy(self->wrreq->buf, self->dev.d_buf, self->dev.d_len);
-  self->wrreq->len = self->dev.d_len;
+  memcpy(req->buf, self->dev.d_buf, self->dev.d_len);
+  req->len = self->dev.d_len;
 
-  return EP_SUBMIT(self->epbulkin, self->wrreq);
+  ret = EP_SUBMIT(self->epbulkin, req);
+  if (ret < 0)
+    {
+      flags = enter_critical_section();
+      sq_addlast((FAR sq_entry_t *)wrcontainer, &self->wrfree);
+      leave_critical_section(flags);
+      nxsem_post(&self->wrreq_idle);
+    }
+
+  return ret;
 }
 
 /****************************************************************************
@@ -477,7 +516,8 @@ static void cdcecm_reply(struct cdcecm_driver_s *priv)
  *
  ****************************************************************************/
 
-static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
+static void cdcecm_receive(FAR struct cdcecm_driver_s *self,
+                           FAR struct usbdev_req_s *req)
 {
   /* Check for errors and update statistics */
 
@@ -485,12 +525,14 @@ static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
    * configuration.
    */
 
-  /* Copy the data data from the hardware to self->dev.d_buf.  Set
-   * amount of data in self->dev.d_len
+  /* The frame is processed in place in the request buffer, which is as
+   * large as the packet buffer.  A reply is copied into a write request
+   * by cdcecm_transmit(), so the read request can be queued again as
+   * soon as the frame is processed.
    */
 
-  memcpy(self->dev.d_buf, self->rdreq->buf, self->rdreq->xfrd);
-  self->dev.d_len = self->rdreq->xfrd;
+  self->dev.d_buf = req->buf;
+  self->dev.d_len = req->xfrd;
 
 #ifdef CONFIG_NET_PKT
   /* When packet sockets are enabled, feed the frame into the tap */
@@ -557,6 +599,8 @@ static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
     {
       NETDEV_RXDROPPED(&self->dev);
     }
+
+  self->dev.d_buf = (FAR uint8_t *)self->pktbuf;
 }
 
 /****************************************************************************
@@ -607,6 +651,7 @@ static void cdcecm_txdone(FAR struct cdcecm_driver_s *priv)
 static void cdcecm_interrupt_work(FAR void *arg)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)arg;
+  FAR struct cdcecm_req_s *rdcontainer;
   irqstate_t flags;
 
   /* Lock the network and serialize driver operations if necessary.
@@ -617,15 +662,27 @@ static void cdcecm_interrupt_work(FAR void *arg)
 
   net_lock();
 
-  /* Check if we received an incoming packet, if so, call cdcecm_receive() */
+  /* Process all the received packets and queue their requests again */
 
-  if (self->rxpending)
+  for (; ; )
     {
-      cdcecm_receive(self);
+      flags = enter_critical_section();
+      rdcontainer = (FAR struct cdcecm_req_s *)sq_remfirst(&self->rxqueue);
+      leave_critical_section(flags);
+
+      if (rdcontainer == NULL)
+        {
+          break;
+        }
+
+      cdcecm_receive(self, rdcontainer->req);
 
       flags = enter_critical_section();
-      self->rxpending = false;
-      EP_SUBMIT(self->epbulkout, self->rdreq);
+      if (self->config != CDCECM_CONFIGID_NONE)
+        {
+          EP_SUBMIT(self->epbulkout, rdcontainer->req);
+        }
+
       leave_critical_section(flags);
     }
 
@@ -667,7 +724,8 @@ static void cdcecm_poll_work(FAR void *arg)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)arg;
 
-  ninfo("rxpending: %d, txdone: %d\n", self->rxpending, self->txdone);
+  ninfo("rxpending: %d, txdone: %d\n",
+        !sq_empty(&self->rxqueue), self->txdone);
 
   /* Lock the network and serialize driver operations if necessary.
    * NOTE: Serialization is only required in the case where the driver work
@@ -1106,8 +1164,7 @@ static void cdcecm_rdcomplete(FAR struct usbdev_ep_s *ep,
     {
       case 0:  /* Normal completion */
         {
-          DEBUGASSERT(!self->rxpending);
-          self->rxpending = true;
+          sq_addlast((FAR sq_entry_t *)req->priv, &self->rxqueue);
           work_queue(ETHWORK, &self->irqwork,
                      cdcecm_interrupt_work, self, 0);
         }
@@ -1119,7 +1176,7 @@ static void cdcecm_rdcomplete(FAR struct usbdev_ep_s *ep,
       default: /* Some other error occurred */
         {
           uerr("req->result: %hd\n", req->result);
-          EP_SUBMIT(self->epbulkout, self->rdreq);
+          EP_SUBMIT(self->epbulkout, req);
         }
         break;
     }
@@ -1143,10 +1200,11 @@ static void cdcecm_wrcomplete(FAR struct usbdev_ep_s *ep,
   uinfo("buf: %p, flags 0x%hhx, len %hu, xfrd %hu, result %hd\n",
         req->buf, req->flags, req->len, req->xfrd, req->result);
 
-  /* The single USB device write request is available for upcoming
-   * transmissions again.
+  /* The USB device write request is available for upcoming transmissions
+   * again.
    */
 
+  sq_addlast((FAR sq_entry_t *)req->priv, &self->wrfree);
   rc = nxsem_post(&self->wrreq_idle);
 
   if (rc != OK)
@@ -1242,6 +1300,12 @@ static void cdcecm_resetconfig(FAR struct cdcecm_driver_s *self)
       EP_DISABLE(self->epint);
       EP_DISABLE(self->epbulkin);
       EP_DISABLE(self->epbulkout);
+
+      /* Drop the received frames not processed yet, their requests are
+       * queued again by cdcecm_setconfig().
+       */
+
+      sq_init(&self->rxqueue);
     }
 }
 
@@ -1257,6 +1321,7 @@ static int cdcecm_setconfig(FAR struct cdcecm_driver_s *self, uint8_t config)
 {
   struct usb_epdesc_s epdesc;
   int ret = OK;
+  int i;
 
   if (config == self->config)
     {
@@ -1310,14 +1375,16 @@ static int cdcecm_setconfig(FAR struct cdcecm_driver_s *self, uint8_t config)
 
   /* Queue read requests in the bulk OUT endpoint */
 
-  DEBUGASSERT(!self->rxpending);
+  DEBUGASSERT(sq_empty(&self->rxqueue));
 
-  self->rdreq->callback = cdcecm_rdcomplete,
-  ret = EP_SUBMIT(self->epbulkout, self->rdreq);
-  if (ret != OK)
+  for (i = 0; i < CONFIG_CDCECM_NRDREQS; i++)
     {
-      uerr("EP_SUBMIT failed. ret %d\n", ret);
-      goto error;
+      ret = EP_SUBMIT(self->epbulkout, self->rdreqs[i].req);
+      if (ret != OK)
+        {
+          uerr("EP_SUBMIT failed. ret %d\n", ret);
+          goto error;
+        }
     }
 
   /* We are successfully configured */
@@ -1799,7 +1866,9 @@ static int cdcecm_bind(FAR struct usbdevclass_driver_s *driver,
                        FAR struct usbdev_s *dev)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)driver;
+  FAR struct usbdev_req_s *req;
   int ret = OK;
+  int i;
 
   uinfo("\n");
 
@@ -1843,33 +1912,46 @@ static int cdcecm_bind(FAR struct usbdevclass_driver_s *driver,
 
   /* Pre-allocate read requests.  The buffer size is one full packet. */
 
-  self->rdreq = cdcecm_allocreq(self->epbulkout,
-                  CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE);
-  if (self->rdreq == NULL)
+  sq_init(&self->rxqueue);
+  for (i = 0; i < CONFIG_CDCECM_NRDREQS; i++)
     {
-      uerr("Out of memory\n");
-      ret = -ENOMEM;
-      goto error;
-    }
+      req = cdcecm_allocreq(self->epbulkout,
+                            CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE);
+      if (req == NULL)
+        {
+          uerr("Out of memory\n");
+          ret = -ENOMEM;
+          goto error;
+        }
 
-  self->rdreq->callback = cdcecm_rdcomplete;
+      req->priv     = &self->rdreqs[i];
+      req->callback = cdcecm_rdcomplete;
+      self->rdreqs[i].req = req;
+    }
 
-  /* Pre-allocate a single write request.  Buffer size is one full packet. */
+  /* Pre-allocate write requests.  Buffer size is one full packet. */
 
-  self->wrreq = cdcecm_allocreq(self->epbulkin,
-                  CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE);
-  if (self->wrreq == NULL)
+  sq_init(&self->wrfree);
+  for (i = 0; i < CONFIG_CDCECM_NWRREQS; i++)
     {
-      uerr("Out of memory\n");
-      ret = -ENOMEM;
-      goto error;
-    }
+      req = cdcecm_allocreq(self->epbulkin,
+                            CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE);
+      if (req == NULL)
+        {
+          uerr("Out of memory\n");
+          ret = -ENOMEM;
+          goto error;
+        }
 
-  self->wrreq->callback = cdcecm_wrcomplete;
+      req->priv     = &self->wrreqs[i];
+      req->callback = cdcecm_wrcomplete;
+      self->wrreqs[i].req = req;
+      sq_addlast((FAR sq_entry_t *)&self->wrreqs[i], &self->wrfree);
+    }
 
-  /* The single write request just allocated is available now. */
+  /* The write requests just allocated are available now. */
 
-  ret = nxsem_init(&self->wrreq_idle, 0, 1);
+  ret = nxsem_init(&self->wrreq_idle, 0, CONFIG_CDCECM_NWRREQS);
 
   if (ret != OK)
     {
@@ -1903,6 +1985,7 @@ static void cdcecm_unbind(FAR struct usbdevclass_driver_s *driver,
                           FAR struct usbdev_s *dev)
 {
   FAR struct cdcecm_driver_s *self = (FAR struct cdcecm_driver_s *)driver;
+  int i;
 
 #ifdef CONFIG_DEBUG_FEATURES
   if (!driver || !dev)
@@ -1942,12 +2025,17 @@ static void cdcecm_unbind(FAR struct usbdevclass_driver_s *driver,
    * been returned to the free list at this time -- we don't check)
    */
 
-  if (self->rdreq != NULL)
+  for (i = 0; i < CONFIG_CDCECM_NRDREQS; i++)
     {
-      cdcecm_freereq(self->epbulkout, self->rdreq);
-      self->rdreq = NULL;
+      if (self->rdreqs[i].req != NULL)
+        {
+          cdcecm_freereq(self->epbulkout, self->rdreqs[i].req);
+          self->rdreqs[i].req = NULL;
+        }
     }
 
+  sq_init(&self->rxqueue);
+
   /* Free the bulk OUT endpoint */
 
   if (self->epbulkout)
@@ -1960,12 +2048,17 @@ static void cdcecm_unbind(FAR struct usbdevclass_driver_s *driver,
    * of them)
    */
 
-  if (self->wrreq != NULL)
+  for (i = 0; i < CONFIG_CDCECM_NWRREQS; i++)
     {
-      cdcecm_freereq(self->epbulkin, self->wrreq);
-      self->wrreq = NULL;
+      if (self->wrreqs[i].req != NULL)
+        {
+          cdcecm_freereq(self->epbulkin, self->wrreqs[i].req);
+          self->wrreqs[i].req = NULL;
+        }
     }
 
+  sq_init(&self->wrfree);
+
   /* Free the bulk IN endpoint */
 
   if (self->epbulkin)
@@ -505,7 +505,15 @@ static int rndis_submit_rdreq(FAR struct rndis_dev_s *priv)
 
   if (!priv->rdreq_submitted && !priv->rx_blocked)
     {
-      priv->rdreq->len = priv->epbulkout->maxpacket;
+      /* Receive as many packets as fit in the request buffer, so that a
+       * whole RNDIS message usually completes in a single request.  The
+       * length must be a multiple of the max packet size, the transfer of
+       * a message ends with a short packet.
+       */
+
+      priv->rdreq->len = CONFIG_RNDIS_BULKOUT_REQLEN -
+                         CONFIG_RNDIS_BULKOUT_REQLEN %
+                         priv->epbulkout->maxpacket;
       ret = EP_SUBMIT(priv->epbulkout, priv->rdreq);
       if (ret != OK)
         {
@@ -1263,9 +1271,13 @@ static inline int rndis_recvpacket(FAR struct rndis_dev_s *priv,
               priv->current_rx_datagram_offset = msg->dataoffset + 8;
               if (priv->current_rx_datagram_offset < reqlen)
                 {
+                  size_t copysize = min(reqlen -
+                                        priv->current_rx_datagram_offset,
+                                        CONFIG_NET_ETH_PKTSIZE);
+
                   memcpy(&priv->rx_req->req->buf[RNDIS_PACKET_HDR_SIZE],
                          &reqbuf[priv->current_rx_datagram_offset],
-                         reqlen - priv->current_rx_datagram_offset);
+                         copysize);
                 }
             }
           else
@@ -1212,6 +1212,7 @@ static inline int usbmsc_cmdverify10(FAR struct usbmsc_dev_s *priv)
   uint16_t  blocks;
   size_t  sector;
   ssize_t nread;
+  int     nsectors;
   int     ret;
   int     i;
 
@@ -1258,13 +1259,17 @@ static inline int usbmsc_cmdverify10(FAR struct usbmsc_dev_s *priv)
         }
       else
         {
-          /* Try to read the requested blocks */
+          /* Try to read the requested blocks, as many as will fit into
+           * the I/O buffer at a time.
+           */
 
           for (i = 0, sector = lba + lun->startsector;
                i < blocks;
-               i++, sector++)
+               i += nsectors, sector += nsectors)
             {
-              nread = USBMSC_DRVR_READ(lun, priv->iobuffer, sector, 1);
+              nsectors = MIN(blocks - i, priv->iosize / lun->sectorsize);
+              nread    = USBMSC_DRVR_READ(lun, priv->iobuffer, sector,
+                                          nsectors);
               if (nread < 0)
                 {
                   usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_VERIFY10READFAIL),
@@ -1921,6 +1926,7 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
   /* No data is buffered */
 
   priv->nsectbytes   = 0;
+  priv->niobytes     = 0;
   priv->nreqbytes    = 0;
 
   /* Get exclusive access to the block driver */
@@ -2222,7 +2228,9 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
  * State variables:
  *   xfrlen     - holds the number of sectors read to be read.
  *   sector     - holds the sector number of the next sector to be read
- *   nsectbytes - holds the number of bytes buffered for the current sector
+ *   niobytes   - holds the number of bytes read into the I/O buffer
+ *   nsectbytes - holds the number of bytes of the I/O buffer not yet copied
+ *                into a request
  *   nreqbytes  - holds the number of bytes currently buffered in the request
  *                at the head of the wrreqlist.
  *
@@ -2235,11 +2243,20 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
   FAR struct usbdev_req_s *req;
   irqstate_t flags;
   ssize_t nread;
+  uint32_t nsectors;
   uint8_t *src;
   uint8_t *dest;
+  int reqlen;
   int nbytes;
   int ret;
 
+  /* Pack the data into the whole request buffer.  Only the final request
+   * of the transfer may be shorter than a multiple of maxpacket.
+   */
+
+  reqlen = CONFIG_USBMSC_BULKINREQLEN -
+           CONFIG_USBMSC_BULKINREQLEN % priv->epbulkin->maxpacket;
+
   /* Loop transferring data until either (1) all of the data has been
    * transferred, or (2) we have used up all of the write requests that we
    * have available.
@@ -2253,9 +2270,11 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
 
       if (priv->nsectbytes <= 0)
         {
-          /* Yes.. read the next sector */
+          /* Yes.. read as many of the next sectors as will fit */
 
-          nread = USBMSC_DRVR_READ(lun, priv->iobuffer, priv->sector, 1);
+          nsectors = MIN(priv->u.xfrlen, priv->iosize / lun->sectorsize);
+          nread    = USBMSC_DRVR_READ(lun, priv->iobuffer, priv->sector,
+                                      nsectors);
           if (nread < 0)
             {
               usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADREADFAIL),
@@ -2265,9 +2284,10 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
               break;
             }
 
-          priv->nsectbytes = lun->sectorsize;
-          priv->u.xfrlen--;
-          priv->sector++;
+          priv->niobytes   = nsectors * lun->sectorsize;
+          priv->nsectbytes = priv->niobytes;
+          priv->u.xfrlen  -= nsectors;
+          priv->sector    += nsectors;
         }
 
       /* Check if there is a request in the wrreqlist that we will be able to
@@ -2295,11 +2315,10 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
        * OR (2) all of the data available in the sector buffer.
        */
 
-      src    = &priv->iobuffer[lun->sectorsize - priv->nsectbytes];
+      src    = &priv->iobuffer[priv->niobytes - priv->nsectbytes];
       dest   = &req->buf[priv->nreqbytes];
 
-      nbytes = MIN(priv->epbulkin->maxpacket - priv->nreqbytes,
-                   priv->nsectbytes);
+      nbytes = MIN(reqlen - priv->nreqbytes, priv->nsectbytes);
 
       /* Copy the data from the sector buffer to the USB request and update
        * counts
@@ -2314,7 +2333,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
        * then submit the request
        */
 
-      if (priv->nreqbytes >= priv->epbulkin->maxpacket ||
+      if (priv->nreqbytes >= reqlen ||
           (priv->u.xfrlen <= 0 && priv->nsectbytes <= 0))
         {
           /* Remove the request that we just filled from wrreqlist (we've
@@ -2378,7 +2397,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
  * State variables:
  *   xfrlen     - holds the number of sectors read to be written.
  *   sector     - holds the sector number of the next sector to write
- *   nsectbytes - holds the number of bytes buffered for the current sector
+ *   nsectbytes - holds the number of bytes buffered in the I/O buffer
  *   nreqbytes  - holds the number of untransferred bytes currently in the
  *                request at the head of the rdreqlist.
  *
@@ -2390,6 +2409,8 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
   FAR struct usbmsc_req_s *privreq;
   FAR struct usbdev_req_s *req;
   ssize_t nwritten;
+  uint32_t nsectors;
+  uint32_t iobytes;
   uint16_t xfrd;
   uint8_t *src;
   uint8_t *dest;
@@ -2438,13 +2459,17 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
       while (priv->nreqbytes > 0 && priv->u.xfrlen > 0)
         {
           /* Copy the data received in the read request into the sector I/O
-           * buffer
+           * buffer.  Buffer as many of the remaining sectors as will fit
+           * before writing them to the block driver.
            */
 
+          nsectors = MIN(priv->u.xfrlen, priv->iosize / lun->sectorsize);
+          iobytes  = nsectors * lun->sectorsize;
+
           src  = &req->buf[xfrd - priv->nreqbytes];
           dest = &priv->iobuffer[priv->nsectbytes];
 
-          nbytes = MIN(lun->sectorsize - priv->nsectbytes, priv->nreqbytes);
+          nbytes = MIN(iobytes - priv->nsectbytes, priv->nreqbytes);
 
           /* Copy the data from the sector buffer to the USB request and
            * update counts
@@ -2456,12 +2481,12 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
 
           /* Is the I/O buffer full? */
 
-          if (priv->nsectbytes >= lun->sectorsize)
+          if (priv->nsectbytes >= iobytes)
             {
-              /* Yes.. Write the next sector */
+              /* Yes.. Write the buffered sectors */
 
               nwritten = USBMSC_DRVR_WRITE(lun, priv->iobuffer,
-                                           priv->sector, 1);
+                                           priv->sector, nsectors);
               if (nwritten < 0)
                 {
                   usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDWRITEWRITEFAIL),
@@ -2472,9 +2497,9 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
                 }
 
               priv->nsectbytes = 0;
-              priv->residue   -= lun->sectorsize;
-              priv->u.xfrlen--;
-              priv->sector++;
+              priv->residue   -= iobytes;
+              priv->u.xfrlen  -= nsectors;
+              priv->sector    += nsectors;
             }
         }
 
@@ -2498,6 +2523,27 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
 
       if (xfrd != priv->epbulkout->maxpacket)
         {
+          /* Don't lose the complete sectors that are still buffered */
+
+          nsectors = priv->nsectbytes / lun->sectorsize;
+          if (nsectors > 0)
+            {
+              nwritten = USBMSC_DRVR_WRITE(lun, priv->iobuffer,
+                                           priv->sector, nsectors);
+              if (nwritten < 0)
+                {
+                  usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDWRITEWRITEFAIL),
+                           -nwritten);
+                  lun->sd     = SCSI_KCQME_WRITEFAULTAUTOREALLOCFAILED;
+                  lun->sdinfo = priv->sector;
+                  goto errout;
+                }
+
+              priv->residue  -= nsectors * lun->sectorsize;
+              priv->u.xfrlen -= nsectors;
+              priv->sector   += nsectors;
+            }
+
           priv->shortpacket = 1;
           goto errout;
         }
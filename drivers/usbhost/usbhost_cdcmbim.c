@@ -419,7 +419,7 @@ static void usbhost_pollnotify(FAR struct usbhost_cdcmbim_s *priv)
           if (fds->revents != 0)
             {
               uinfo("Report events: %08" PRIx32 "\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -40,7 +40,9 @@
 #include <nuttx/wqueue.h>
 #include <nuttx/scsi.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/drivers/rwbuffer.h>
 
 #include <nuttx/usb/usb.h>
 #include <nuttx/usb/usbhost.h>
@@ -96,6 +98,23 @@
 #define USBHOST_MAX_RETRIES 100        /* Give up after 5 seconds */
 #define USBHOST_MAX_CREFS   INT16_MAX  /* Max cref count before signed overflow */
 
+/* Sector transfers *********************************************************/
+
+/* READ(10) and WRITE(10) carry a 16-bit transfer length */
+
+#ifndef CONFIG_USBHOST_MSC_MAXSECTORS
+#  define CONFIG_USBHOST_MSC_MAXSECTORS 256
+#endif
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+#if defined(CONFIG_USBHOST_MSC_READAHEAD) || \
+    defined(CONFIG_USBHOST_MSC_WRITEBUFFER)
+#  define USBHOST_MSC_RWBUFFER 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -124,6 +143,9 @@ struct usbhost_state_s
   size_t                  tbuflen;      /* Size of the allocated transfer buffer */
   usbhost_ep_t            bulkin;       /* Bulk IN endpoint */
   usbhost_ep_t            bulkout;      /* Bulk OUT endpoint */
+#ifdef USBHOST_MSC_RWBUFFER
+  struct rwbuffer_s       rwb;          /* Read-ahead/write buffer support */
+#endif
 };
 
 /* This is how struct usbhost_state_s looks to the free list logic */
@@ -215,6 +237,13 @@ static inline int usbhost_tfree(FAR struct usbhost_state_s *priv);
 static FAR struct usbmsc_cbw_s *
        usbhost_cbwalloc(FAR struct usbhost_state_s *priv);
 
+/* Sector transfers */
+
+static ssize_t usbhost_rdsectors(FAR void *dev, FAR uint8_t *buffer,
+                                 off_t startsector, size_t nsectors);
+static ssize_t usbhost_wrsectors(FAR void *dev, FAR const uint8_t *buffer,
+                                 off_t startsector, size_t nsectors);
+
 /* struct usbhost_registry_s methods */
 
 static struct usbhost_class_s *
@@ -946,6 +975,17 @@ static void usbhost_destroy(FAR void *arg)
 
   usbhost_freedevno(priv);
 
+#ifdef USBHOST_MSC_RWBUFFER
+  /* Release the read-ahead/write buffers.  The device is already gone so
+   * nothing that is still buffered can be written.
+   */
+
+  if (priv->rwb.dev != NULL)
+    {
+      rwb_uninitialize(&priv->rwb);
+    }
+#endif
+
   /* Free the bulk endpoints */
 
   if (priv->bulkout)
@@ -1362,6 +1402,36 @@ static inline int usbhost_initvolume(FAR struct usbhost_state_s *priv)
         }
     }
 
+#ifdef USBHOST_MSC_RWBUFFER
+  /* Set up the read-ahead/write buffers now that the geometry is known */
+
+  if (ret >= 0)
+    {
+      priv->rwb.blocksize   = priv->blocksize;
+      priv->rwb.nblocks     = priv->nblocks;
+      priv->rwb.dev         = (FAR void *)priv;
+      priv->rwb.wrflush     = usbhost_wrsectors;
+      priv->rwb.rhreload    = usbhost_rdsectors;
+#ifdef CONFIG_USBHOST_MSC_WRITEBUFFER
+      priv->rwb.wrmaxblocks = CONFIG_USBHOST_MSC_NWRBLOCKS;
+#elif defined(CONFIG_DRVR_WRITEBUFFER)
+      priv->rwb.wrmaxblocks = 0;
+#endif
+#ifdef CONFIG_USBHOST_MSC_READAHEAD
+      priv->rwb.rhmaxblocks = CONFIG_USBHOST_MSC_NRHBLOCKS;
+#elif defined(CONFIG_DRVR_READAHEAD)
+      priv->rwb.rhmaxblocks = 0;
+#endif
+
+      ret = rwb_initialize(&priv->rwb);
+      if (ret < 0)
+        {
+          uerr("ERROR: rwb_initialize failed: %d\n", ret);
+          priv->rwb.dev = NULL;
+        }
+    }
+#endif
+
   /* Register the block driver */
 
   if (ret >= 0)
@@ -1684,6 +1754,241 @@ static FAR struct usbmsc_cbw_s *
   return cbw;
 }
 
+/****************************************************************************
+ * Name: usbhost_rdsectors
+ *
+ * Description:
+ *   Read sectors from the physical device.  The transfer is broken up into
+ *   SCSI READ(10) commands of at most CONFIG_USBHOST_MSC_MAXSECTORS sectors
+ *   each.  This is also the reload callout of the read-ahead buffer.
+ *
+ * Input Parameters:
+ *   dev - A reference to the class instance.
+ *   buffer - The buffer that receives the data.
+ *   startsector - The first sector to read.
+ *   nsectors - The number of sectors to read.
+ *
+ * Returned Value:
+ *   The number of sectors read on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+static ssize_t usbhost_rdsectors(FAR void *dev, FAR uint8_t *buffer,
+                                 off_t startsector, size_t nsectors)
+{
+  FAR struct usbhost_state_s *priv = (FAR struct usbhost_state_s *)dev;
+  FAR struct usbhost_hubport_s *hport;
+  FAR struct usbmsc_cbw_s *cbw;
+  FAR struct usbmsc_csw_s *csw;
+  size_t remaining;
+  size_t nxfrs;
+  ssize_t nbytes;
+  int ret;
+
+  DEBUGASSERT(priv->usbclass.hport);
+  hport = priv->usbclass.hport;
+
+  if (priv->disconnected)
+    {
+      return -ENODEV;
+    }
+
+  ret = usbhost_takesem(&priv->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  nbytes = 0;
+  for (remaining = nsectors; remaining > 0; remaining -= nxfrs)
+    {
+      nxfrs = MIN(remaining, CONFIG_USBHOST_MSC_MAXSECTORS);
+
+      /* Initialize a CBW (re-using the allocated transfer buffer) */
+
+      cbw = usbhost_cbwalloc(priv);
+      if (!cbw)
+        {
+          nbytes = -ENOMEM;
+          break;
+        }
+
+      /* Loop in the event that EAGAIN is returned (mean that the
+       * transaction was NAKed and we should try again.
+       */
+
+      do
+        {
+          /* Construct and send the CBW */
+
+          usbhost_readcbw(startsector, priv->blocksize, nxfrs, cbw);
+          nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
+                                 (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
+          if (nbytes >= 0)
+            {
+              /* Receive the user data */
+
+              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
+                                     buffer, priv->blocksize * nxfrs);
+              if (nbytes >= 0)
+                {
+                  /* Receive the CSW */
+
+                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
+                                         priv->tbuffer, USBMSC_CSW_SIZEOF);
+                  if (nbytes >= 0)
+                    {
+                      /* Check the CSW status */
+
+                      csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
+                      if (csw->status != 0)
+                        {
+                          uerr("ERROR: CSW status error: %d\n",
+                               csw->status);
+                          nbytes = -ENODEV;
+                        }
+                    }
+                }
+            }
+        }
+      while (nbytes == -EAGAIN);
+
+      if (nbytes < 0)
+        {
+          break;
+        }
+
+      startsector += nxfrs;
+      buffer      += priv->blocksize * nxfrs;
+    }
+
+  usbhost_givesem(&priv->exclsem);
+
+  /* On success, return the number of blocks read */
+
+  return nbytes < 0 ? nbytes : (ssize_t)nsectors;
+}
+
+/****************************************************************************
+ * Name: usbhost_wrsectors
+ *
+ * Description:
+ *   Write sectors to the physical device.  The transfer is broken up into
+ *   SCSI WRITE(10) commands of at most CONFIG_USBHOST_MSC_MAXSECTORS
+ *   sectors each.  This is also the flush callout of the write buffer.
+ *
+ * Input Parameters:
+ *   dev - A reference to the class instance.
+ *   buffer - The data to be written.
+ *   startsector - The first sector to write.
+ *   nsectors - The number of sectors to write.
+ *
+ * Returned Value:
+ *   The number of sectors written on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+static ssize_t usbhost_wrsectors(FAR void *dev, FAR const uint8_t *buffer,
+                                 off_t startsector, size_t nsectors)
+{
+  FAR struct usbhost_state_s *priv = (FAR struct usbhost_state_s *)dev;
+  FAR struct usbhost_hubport_s *hport;
+  FAR struct usbmsc_cbw_s *cbw;
+  FAR struct usbmsc_csw_s *csw;
+  size_t remaining;
+  size_t nxfrs;
+  ssize_t nbytes;
+  int ret;
+
+  DEBUGASSERT(priv->usbclass.hport);
+  hport = priv->usbclass.hport;
+
+  /* The write buffer may still be flushed after the device is gone */
+
+  if (priv->disconnected)
+    {
+      return -ENODEV;
+    }
+
+  ret = usbhost_takesem(&priv->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  nbytes = 0;
+  for (remaining = nsectors; remaining > 0; remaining -= nxfrs)
+    {
+      nxfrs = MIN(remaining, CONFIG_USBHOST_MSC_MAXSECTORS);
+
+      /* Initialize a CBW (re-using the allocated transfer buffer) */
+
+      cbw = usbhost_cbwalloc(priv);
+      if (!cbw)
+        {
+          nbytes = -ENOMEM;
+          break;
+        }
+
+      /* Loop in the event that EAGAIN is returned (mean that the
+       * transaction was NAKed and we should try again.
+       */
+
+      do
+        {
+          /* Construct and send the CBW */
+
+          usbhost_writecbw(startsector, priv->blocksize, nxfrs, cbw);
+          nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
+                                 (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
+          if (nbytes >= 0)
+            {
+              /* Send the user data */
+
+              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
+                                     (FAR uint8_t *)buffer,
+                                     priv->blocksize * nxfrs);
+              if (nbytes >= 0)
+                {
+                  /* Receive the CSW */
+
+                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
+                                         priv->tbuffer, USBMSC_CSW_SIZEOF);
+                  if (nbytes >= 0)
+                    {
+                      /* Check the CSW status */
+
+                      csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
+                      if (csw->status != 0)
+                        {
+                          uerr("ERROR: CSW status error: %d\n",
+                               csw->status);
+                          nbytes = -ENODEV;
+                        }
+                    }
+                }
+            }
+        }
+      while (nbytes == -EAGAIN);
+
+      if (nbytes < 0)
+        {
+          break;
+        }
+
+      startsector += nxfrs;
+      buffer      += priv->blocksize * nxfrs;
+    }
+
+  usbhost_givesem(&priv->exclsem);
+
+  /* On success, return the number of blocks written */
+
+  return nbytes < 0 ? nbytes : (ssize_t)nsectors;
+}
+
 /****************************************************************************
  * Name: usbhost_create
  *
@@ -1981,6 +2286,15 @@ static int usbhost_close(FAR struct inode *inode)
 
   DEBUGASSERT(priv->crefs > 1);
 
+#ifdef CONFIG_USBHOST_MSC_WRITEBUFFER
+  /* Write back anything left in the write buffer */
+
+  if (!priv->disconnected)
+    {
+      rwb_flush(&priv->rwb);
+    }
+#endif
+
   usbhost_forcetake(&priv->exclsem);
   priv->crefs--;
 
@@ -2028,16 +2342,10 @@ static ssize_t usbhost_read(FAR struct inode *inode, unsigned char *buffer,
                             blkcnt_t startsector, unsigned int nsectors)
 {
   FAR struct usbhost_state_s *priv;
-  FAR struct usbhost_hubport_s *hport;
-  ssize_t nbytes = 0;
-  int ret;
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct usbhost_state_s *)inode->i_private;
 
-  DEBUGASSERT(priv->usbclass.hport);
-  hport = priv->usbclass.hport;
-
   uinfo("startsector: %" PRIuOFF " nsectors: %u "
         "sectorsize: %" PRIu16 "\n", startsector, nsectors, priv->blocksize);
 
@@ -2050,81 +2358,18 @@ static ssize_t usbhost_read(FAR struct inode *inode, unsigned char *buffer,
        * attempt to read from the device.
        */
 
-      nbytes = -ENODEV;
+      return -ENODEV;
     }
-  else if (nsectors > 0)
+  else if (nsectors == 0)
     {
-      FAR struct usbmsc_cbw_s *cbw;
-
-      ret = usbhost_takesem(&priv->exclsem);
-      if (ret < 0)
-        {
-          return ret;
-        }
-
-      /* Assume allocation failure */
-
-      nbytes = -ENOMEM;
-
-      /* Initialize a CBW (re-using the allocated transfer buffer) */
-
-      cbw = usbhost_cbwalloc(priv);
-      if (cbw)
-        {
-          /* Loop in the event that EAGAIN is returned (mean that the
-           * transaction was NAKed and we should try again.
-           */
-
-          do
-            {
-              /* Assume some device failure */
-
-              nbytes = -ENODEV;
-
-              /* Construct and send the CBW */
-
-              usbhost_readcbw(startsector, priv->blocksize, nsectors, cbw);
-              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                     (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
-              if (nbytes >= 0)
-                {
-                  /* Receive the user data */
-
-                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                         buffer, priv->blocksize * nsectors);
-                  if (nbytes >= 0)
-                    {
-                      /* Receive the CSW */
-
-                      nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                             priv->tbuffer,
-                                             USBMSC_CSW_SIZEOF);
-                      if (nbytes >= 0)
-                        {
-                          FAR struct usbmsc_csw_s *csw;
-
-                          /* Check the CSW status */
-
-                          csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
-                          if (csw->status != 0)
-                            {
-                              uerr("ERROR: CSW status error: %d\n",
-                                   csw->status);
-                              nbytes = -ENODEV;
-                            }
-                        }
-                    }
-                }
-            }
-          while (nbytes == -EAGAIN);
-        }
-
-      usbhost_givesem(&priv->exclsem);
+      return 0;
     }
 
-  /* On success, return the number of blocks read */
-
-  return nbytes < 0 ? (int)nbytes : nsectors;
+#ifdef USBHOST_MSC_RWBUFFER
+  return rwb_read(&priv->rwb, startsector, nsectors, buffer);
+#else
+  return usbhost_rdsectors(priv, buffer, startsector, nsectors);
+#endif
 }
 
 /****************************************************************************
@@ -2141,18 +2386,12 @@ static ssize_t usbhost_write(FAR struct inode *inode,
                              blkcnt_t startsector, unsigned int nsectors)
 {
   FAR struct usbhost_state_s *priv;
-  FAR struct usbhost_hubport_s *hport;
-  ssize_t nbytes;
-  int ret;
 
   uinfo("sector: %" PRIuOFF " nsectors: %u\n", startsector, nsectors);
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct usbhost_state_s *)inode->i_private;
 
-  DEBUGASSERT(priv->usbclass.hport);
-  hport = priv->usbclass.hport;
-
   /* Check if the mass storage device is still connected */
 
   if (priv->disconnected)
@@ -2162,72 +2401,18 @@ static ssize_t usbhost_write(FAR struct inode *inode,
        * attempt to write to the device.
        */
 
-      nbytes = -ENODEV;
+      return -ENODEV;
     }
-  else
+  else if (nsectors == 0)
     {
-      FAR struct usbmsc_cbw_s *cbw;
-
-      ret = usbhost_takesem(&priv->exclsem);
-      if (ret < 0)
-        {
-          return ret;
-        }
-
-      /* Assume allocation failure */
-
-      nbytes = -ENOMEM;
-
-      /* Initialize a CBW (re-using the allocated transfer buffer) */
-
-      cbw = usbhost_cbwalloc(priv);
-      if (cbw)
-        {
-          /* Assume some device failure */
-
-          nbytes = -ENODEV;
-
-          /* Construct and send the CBW */
-
-          usbhost_writecbw(startsector, priv->blocksize, nsectors, cbw);
-          nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                 (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
-          if (nbytes >= 0)
-            {
-              /* Send the user data */
-
-              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                     (FAR uint8_t *)buffer,
-                                     priv->blocksize * nsectors);
-              if (nbytes >= 0)
-                {
-                  /* Receive the CSW */
-
-                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                         priv->tbuffer, USBMSC_CSW_SIZEOF);
-                  if (nbytes >= 0)
-                    {
-                      FAR struct usbmsc_csw_s *csw;
-
-                      /* Check the CSW status */
-
-                      csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
-                      if (csw->status != 0)
-                        {
-                          uerr("ERROR: CSW status error: %d\n", csw->status);
-                          nbytes = -ENODEV;
-                        }
-                    }
-                }
-            }
-        }
-
-      usbhost_givesem(&priv->exclsem);
+      return 0;
     }
 
-  /* On success, return the number of blocks written */
-
-  return nbytes < 0 ? (int)nbytes : nsectors;
+#ifdef USBHOST_MSC_RWBUFFER
+  return rwb_write(&priv->rwb, startsector, nsectors, buffer);
+#else
+  return usbhost_wrsectors(priv, buffer, startsector, nsectors);
+#endif
 }
 
 /****************************************************************************
@@ -2307,6 +2492,14 @@ static int usbhost_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 
       ret = -ENODEV;
     }
+#ifdef CONFIG_USBHOST_MSC_WRITEBUFFER
+  else if (cmd == BIOC_FLUSH)
+    {
+      /* The write buffer takes exclsem itself when it is flushed */
+
+      ret = rwb_flush(&priv->rwb);
+    }
+#endif
   else
     {
       /* Process the IOCTL by command */
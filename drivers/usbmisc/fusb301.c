@@ -756,7 +756,7 @@ static void fusb301_notify(FAR struct fusb301_dev_s *priv)
         {
           fds->revents |= POLLIN;
           fusb301_info("Report events: %08" PRIx32 "\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
     }
 }
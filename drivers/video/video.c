@@ -36,6 +36,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/board.h>
+#include <nuttx/cache.h>
 #include <nuttx/kmalloc.h>
 
 #include <arch/board/board.h>
@@ -224,6 +225,8 @@ static int video_qbuf(FAR struct video_mng_s *vmng,
                       FAR struct v4l2_buffer *buf);
 static int video_dqbuf(FAR struct video_mng_s *vmng,
                        FAR struct v4l2_buffer *buf);
+static int video_querybuf(FAR struct video_mng_s *vmng,
+                          FAR struct v4l2_buffer *buf);
 static int video_cancel_dqbuf(FAR struct video_mng_s *vmng,
                               enum v4l2_buf_type type);
 static int video_s_fmt(FAR struct video_mng_s *priv,
@@ -668,6 +671,24 @@ static bool is_bufsize_sufficient(FAR video_mng_t *vmng, uint32_t bufsize)
   return true;
 }
 
+static uint32_t get_mmap_frmsize(FAR video_type_inf_t *type_inf)
+{
+  uint32_t frmsize = 0;
+  int i;
+
+  /* Two bytes per pixel covers YUV4:2:2 and RGB565, and is an upper bound
+   * of the JPEG output, for the main image and the sub image if any.
+   */
+
+  for (i = 0; i < type_inf->nr_fmt; i++)
+    {
+      frmsize += (uint32_t)type_inf->fmt[i].width *
+                 type_inf->fmt[i].height * 2;
+    }
+
+  return frmsize;
+}
+
 static void initialize_frame_setting(FAR uint8_t *nr_fmt,
                                      FAR video_format_t *fmt,
                                      FAR struct v4l2_fract *interval)
@@ -1019,8 +1040,38 @@ static int video_reqbufs(FAR struct video_mng_s         *vmng,
     {
       video_framebuff_change_mode(&type_inf->bufinf, reqbufs->mode);
 
-      ret = video_framebuff_realloc_container(&type_inf->bufinf,
-                                              reqbufs->count);
+      if (reqbufs->memory == V4L2_MEMORY_MMAP &&
+          reqbufs->type != V4L2_BUF_TYPE_VIDEO_CAPTURE)
+        {
+          /* Only the video stream can be mapped by FIOC_MMAP */
+
+          ret = -EINVAL;
+        }
+      else
+        {
+          ret = video_framebuff_realloc_container(&type_inf->bufinf,
+                                                  reqbufs->count);
+        }
+
+      if (ret == OK)
+        {
+          /* For MMAP, the driver owns the frames.  Otherwise release the
+           * frames of a previous MMAP request.
+           */
+
+          if (reqbufs->memory == V4L2_MEMORY_MMAP)
+            {
+              type_inf->bufinf.memory = V4L2_MEMORY_MMAP;
+              ret = video_framebuff_realloc_pool(&type_inf->bufinf,
+                                                 reqbufs->count,
+                                                 get_mmap_frmsize(type_inf));
+            }
+          else
+            {
+              type_inf->bufinf.memory = V4L2_MEMORY_USERPTR;
+              ret = video_framebuff_realloc_pool(&type_inf->bufinf, 0, 0);
+            }
+        }
     }
 
   leave_critical_section(flags);
@@ -1047,7 +1098,15 @@ static int video_qbuf(FAR struct video_mng_s *vmng,
       return -EINVAL;
     }
 
-  if (!is_bufsize_sufficient(vmng, buf->length))
+  if (type_inf->bufinf.memory == V4L2_MEMORY_MMAP)
+    {
+      if (buf->memory != V4L2_MEMORY_MMAP ||
+          buf->index >= type_inf->bufinf.container_size)
+        {
+          return -EINVAL;
+        }
+    }
+  else if (!is_bufsize_sufficient(vmng, buf->length))
     {
       return -EINVAL;
     }
@@ -1059,6 +1118,17 @@ static int video_qbuf(FAR struct video_mng_s *vmng,
     }
 
   memcpy(&container->buf, buf, sizeof(struct v4l2_buffer));
+
+  if (type_inf->bufinf.memory == V4L2_MEMORY_MMAP)
+    {
+      /* Capture directly into the driver owned frame of this index */
+
+      container->buf.m.userptr = (unsigned long)
+        (type_inf->bufinf.mmap_pool +
+         buf->index * type_inf->bufinf.mmap_frmsize);
+      container->buf.length = type_inf->bufinf.mmap_frmsize;
+    }
+
   video_framebuff_queue_container(&type_inf->bufinf, container);
 
   video_lock(&type_inf->lock_state);
@@ -1168,11 +1238,49 @@ static int video_dqbuf(FAR struct video_mng_s *vmng,
 
   memcpy(buf, &container->buf, sizeof(struct v4l2_buffer));
 
+  if (type_inf->bufinf.memory == V4L2_MEMORY_MMAP)
+    {
+      /* Return the mmap() offset of the frame, not the kernel address */
+
+      buf->m.offset = buf->index * type_inf->bufinf.mmap_frmsize;
+    }
+
   video_framebuff_free_container(&type_inf->bufinf, container);
 
   return OK;
 }
 
+static int video_querybuf(FAR struct video_mng_s *vmng,
+                          FAR struct v4l2_buffer *buf)
+{
+  FAR video_type_inf_t *type_inf;
+
+  if ((vmng == NULL) || (buf == NULL))
+    {
+      return -EINVAL;
+    }
+
+  type_inf = get_video_type_inf(vmng, buf->type);
+  if (type_inf == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (type_inf->bufinf.memory != V4L2_MEMORY_MMAP ||
+      buf->index >= type_inf->bufinf.container_size)
+    {
+      return -EINVAL;
+    }
+
+  buf->memory    = V4L2_MEMORY_MMAP;
+  buf->bytesused = 0;
+  buf->flags     = 0;
+  buf->m.offset  = buf->index * type_inf->bufinf.mmap_frmsize;
+  buf->length    = type_inf->bufinf.mmap_frmsize;
+
+  return OK;
+}
+
 static int video_cancel_dqbuf(FAR struct video_mng_s *vmng,
                               enum v4l2_buf_type type)
 {
@@ -2677,6 +2785,33 @@ static int video_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
         break;
 
+      case VIDIOC_QUERYBUF:
+        ret = video_querybuf(priv, (FAR struct v4l2_buffer *)arg);
+
+        break;
+
+      case FIOC_MMAP:
+        {
+          FAR void **ppv = (FAR void **)((uintptr_t)arg);
+
+          /* Return the address of the frames of the video stream, the
+           * offsets reported by VIDIOC_QUERYBUF and VIDIOC_DQBUF are
+           * relative to it.
+           */
+
+          DEBUGASSERT(ppv != NULL);
+          if (priv->video_inf.bufinf.mmap_pool == NULL)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              *ppv = priv->video_inf.bufinf.mmap_pool;
+            }
+        }
+
+        break;
+
       case VIDIOC_STREAMON:
         ret = video_streamon(priv, (FAR enum v4l2_buf_type *)arg);
 
@@ -2904,6 +3039,14 @@ static int video_complete_capture(uint8_t  err_code, uint32_t datasize)
     }
 
   type_inf->bufinf.vbuf_curr->buf.bytesused = datasize;
+
+  /* The frame was written by DMA, drop any stale cache lines before the
+   * user reads it in place.
+   */
+
+  up_invalidate_dcache(type_inf->bufinf.vbuf_curr->buf.m.userptr,
+                       type_inf->bufinf.vbuf_curr->buf.m.userptr +
+                       datasize);
   video_framebuff_capture_done(&type_inf->bufinf);
 
   if (is_sem_waited(&type_inf->wait_capture.dqbuf_wait_flg))
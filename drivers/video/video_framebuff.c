@@ -30,6 +30,18 @@
 #include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The frames of the mmap pool are aligned so that the data cache can be
+ * invalidated per frame without touching its neighbours.
+ */
+
+#define VBUF_FRAME_ALIGN  (32)
+#define VBUF_ALIGN_UP(x)  (((x) + VBUF_FRAME_ALIGN - 1) & \
+                           ~(VBUF_FRAME_ALIGN - 1))
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -102,12 +114,16 @@ void video_framebuff_init(video_framebuff_t *fbuf)
   fbuf->vbuf_top   = NULL;
   fbuf->vbuf_tail  = NULL;
   fbuf->vbuf_next  = NULL;
+  fbuf->memory     = V4L2_MEMORY_USERPTR;
+  fbuf->mmap_pool  = NULL;
+  fbuf->mmap_frmsize = 0;
 
   nxsem_init(&fbuf->lock_empty, 0, 1);
 }
 
 void video_framebuff_uninit(video_framebuff_t *fbuf)
 {
+  video_framebuff_realloc_pool(fbuf, 0, 0);
   video_framebuff_realloc_container(fbuf, 0);
   nxsem_destroy(&fbuf->lock_empty);
 }
@@ -295,3 +311,34 @@ vbuf_container_t *video_framebuff_pop_curr_container(video_framebuff_t *fbuf)
 
   return ret;
 }
+
+int video_framebuff_realloc_pool(video_framebuff_t *fbuf, int count,
+                                 uint32_t frmsize)
+{
+  frmsize = VBUF_ALIGN_UP(frmsize);
+
+  if (fbuf->mmap_pool != NULL)
+    {
+      kumm_free(fbuf->mmap_pool);
+      fbuf->mmap_pool    = NULL;
+      fbuf->mmap_frmsize = 0;
+    }
+
+  if (count > 0 && frmsize > 0)
+    {
+      /* The frames are filled by the capture DMA and read by the user in
+       * place, so they live in the user accessible heap.
+       */
+
+      fbuf->mmap_pool = (FAR uint8_t *)kumm_memalign(VBUF_FRAME_ALIGN,
+                                                      frmsize * count);
+      if (fbuf->mmap_pool == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      fbuf->mmap_frmsize = frmsize;
+    }
+
+  return OK;
+}
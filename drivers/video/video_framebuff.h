@@ -51,6 +51,9 @@ struct video_framebuff_s
   vbuf_container_t *vbuf_tail;
   vbuf_container_t *vbuf_curr;
   vbuf_container_t *vbuf_next;
+  enum v4l2_memory  memory;           /* V4L2_MEMORY_USERPTR or MMAP */
+  FAR uint8_t      *mmap_pool;        /* Driver owned frames for MMAP */
+  uint32_t          mmap_frmsize;     /* The size of one frame in pool */
 };
 
 typedef struct video_framebuff_s video_framebuff_t;
@@ -83,5 +86,8 @@ void              video_framebuff_capture_done
                        (video_framebuff_t *fbuf);
 void              video_framebuff_change_mode
                        (video_framebuff_t *fbuf, enum v4l2_buf_mode mode);
+int               video_framebuff_realloc_pool
+                       (video_framebuff_t *fbuf, int count,
+                        uint32_t frmsize);
 
 #endif  /* __DRIVERS_VIDEO_VIDEO_FRAMEBUFF_H */
@@ -44,6 +44,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/bluetooth.h>
 
 #include <nuttx/wireless/bluetooth/bt_core.h>
@@ -104,7 +105,8 @@ static ssize_t btuart_read(FAR struct btuart_upperhalf_s *upper,
 static void btuart_rxwork(FAR void *arg)
 {
   FAR struct btuart_upperhalf_s *upper;
-  uint8_t data[BLUETOOTH_MAX_FRAMELEN];
+  FAR struct iob_s *iob;
+  FAR uint8_t *data;
   enum bt_buf_type_e type;
   unsigned int hdrlen;
   unsigned int pktlen;
@@ -119,6 +121,19 @@ static void btuart_rxwork(FAR void *arg)
 
   upper = (FAR struct btuart_upperhalf_s *)arg;
 
+  /* The packet is read directly into an IOB so that it can be handed to
+   * the stack without copying it.
+   */
+
+  iob = iob_tryalloc(false, IOBUSER_WIRELESS_BLUETOOTH);
+  if (iob == NULL)
+    {
+      wlwarn("WARNING: No IOB available\n");
+      goto errout_with_busy;
+    }
+
+  data = iob->io_data;
+
   /* Beginning of a new packet.
    * Read the first byte to get the packet type.
    */
@@ -128,7 +143,7 @@ static void btuart_rxwork(FAR void *arg)
     {
       wlwarn("WARNING: Unable to read H4 packet type: %ld\n",
              (long)nread);
-      goto errout_with_busy;
+      goto errout_with_iob;
     }
 
   if (data[0] == H4_EVT)
@@ -142,7 +157,7 @@ static void btuart_rxwork(FAR void *arg)
   else
     {
       wlerr("ERROR: Unknown H4 type %u\n", data[0]);
-      goto errout_with_busy;
+      goto errout_with_iob;
     }
 
   nread = btuart_read(upper, data + H4_HEADER_SIZE,
@@ -151,7 +166,7 @@ static void btuart_rxwork(FAR void *arg)
     {
       wlwarn("WARNING: Unable to read H4 packet header: %ld\n",
           (long)nread);
-      goto errout_with_busy;
+      goto errout_with_iob;
     }
 
   hdr = (void *)(data + H4_HEADER_SIZE);
@@ -163,13 +178,19 @@ static void btuart_rxwork(FAR void *arg)
     }
   else if (data[0] == H4_ACL)
     {
-      pktlen = hdr->acl.len;
+      pktlen = BT_LE162HOST(hdr->acl.len);
       type = BT_ACL_IN;
     }
   else
     {
       wlerr("ERROR: Unknown H4 type %u\n", data[0]);
-      goto errout_with_busy;
+      goto errout_with_iob;
+    }
+
+  if (H4_HEADER_SIZE + hdrlen + pktlen > BLUETOOTH_MAX_FRAMELEN)
+    {
+      wlerr("ERROR: H4 packet too big: %u\n", pktlen);
+      goto errout_with_iob;
     }
 
   nread = btuart_read(upper, data + H4_HEADER_SIZE + hdrlen,
@@ -178,17 +199,38 @@ static void btuart_rxwork(FAR void *arg)
     {
       wlwarn("WARNING: Unable to read H4 packet: %ld\n",
           (long)nread);
-      goto errout_with_busy;
+      goto errout_with_iob;
     }
 
   /* Pass buffer to the stack */
 
   BT_DUMP("Received", data, H4_HEADER_SIZE + hdrlen + pktlen);
   upper->busy = false;
-  bt_netdev_receive(&upper->dev, type, data + H4_HEADER_SIZE,
-                    hdrlen + pktlen);
+
+  if (upper->dev.receive_iob != NULL)
+    {
+      /* The IOB holds the frame after the H4 header.  The stack takes over
+       * the IOB, also in the case of a failure.
+       */
+
+      iob->io_offset = H4_HEADER_SIZE;
+      iob->io_len    = H4_HEADER_SIZE + hdrlen + pktlen;
+      iob->io_pktlen = hdrlen + pktlen;
+
+      bt_netdev_receive_iob(&upper->dev, type, iob);
+    }
+  else
+    {
+      bt_netdev_receive(&upper->dev, type, data + H4_HEADER_SIZE,
+                        hdrlen + pktlen);
+      iob_free(iob, IOBUSER_WIRELESS_BLUETOOTH);
+    }
+
   return;
 
+errout_with_iob:
+  iob_free(iob, IOBUSER_WIRELESS_BLUETOOTH);
+
 errout_with_busy:
   upper->busy = false;
 }
@@ -717,7 +717,7 @@ static void nrf24l01_worker(FAR void *arg)
           dev->pfd->revents |= POLLIN;  /* Data available for input */
 
           wlinfo("Wake up polled fd\n");
-          nxsem_post(dev->pfd->sem);
+          poll_notify(&dev->pfd, 1, 0);
         }
 
       /* Clear interrupt sources */
@@ -1411,7 +1411,7 @@ static int nrf24l01_poll(FAR struct file *filep, FAR struct pollfd *fds,
       if (dev->fifo_len > 0)
         {
           dev->pfd->revents |= POLLIN;  /* Data available for input */
-          nxsem_post(dev->pfd->sem);
+          poll_notify(&dev->pfd, 1, 0);
         }
 
       nxsem_post(&dev->sem_fifo);
@@ -28,6 +28,8 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <aio.h>
 #include <queue.h>
@@ -48,6 +50,29 @@
 #  define CONFIG_FS_NAIOC 8
 #endif
 
+/* Number of threads of the AIO engine.  Without any, the I/O is performed
+ * on the low priority work queue.
+ */
+
+#ifndef CONFIG_FS_AIO_NTHREADS
+#  define CONFIG_FS_AIO_NTHREADS 0
+#endif
+
+#if CONFIG_FS_AIO_NTHREADS > 0
+#  define AIO_HAVE_ENGINE 1
+#  ifndef CONFIG_FS_AIO_MERGE_BUFSIZE
+#    define CONFIG_FS_AIO_MERGE_BUFSIZE 0
+#  endif
+#endif
+
+/* The low priority work queue is boosted to the priority of the waiting
+ * task.  The threads of the AIO engine run at a fixed priority.
+ */
+
+#if defined(CONFIG_PRIORITY_INHERITANCE) && !defined(AIO_HAVE_ENGINE)
+#  define AIO_HAVE_LPBOOST 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -64,6 +89,10 @@ struct aio_container_s
   FAR struct aiocb *aioc_aiocbp;   /* The contained AIO control block */
   FAR struct file *aioc_filep;     /* File structure to use with the I/O */
   struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+#ifdef AIO_HAVE_ENGINE
+  worker_t aioc_worker;            /* Performs the I/O; NULL if not queued */
+  bool aioc_started;               /* A thread of the engine took the I/O */
+#endif
   pid_t aioc_pid;                  /* ID of the waiting task */
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t aioc_prio;               /* Priority of the waiting task */
@@ -220,6 +249,47 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove a queued asynchronous I/O before it is started.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container of the I/O
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was removed; a negated errno value if it could
+ *   not be removed because it is already running.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc);
+
+/****************************************************************************
+ * Name: aio_engine_queue, aio_engine_dequeue, aio_engine_merge, and
+ *       aio_engine_buffer
+ *
+ * Description:
+ *   The pool of threads that performs the asynchronous I/O instead of the
+ *   low priority work queue if CONFIG_FS_AIO_NTHREADS is non-zero.  The
+ *   I/O on one file is performed by one thread at a time and in order, so
+ *   that a thread may merge the next queued I/O on its file with the one
+ *   it is performing by aio_engine_merge().  See aio_engine.c.
+ *
+ ****************************************************************************/
+
+#ifdef AIO_HAVE_ENGINE
+int aio_engine_queue(FAR struct aio_container_s *aioc, worker_t worker);
+int aio_engine_dequeue(FAR struct aio_container_s *aioc);
+FAR struct aio_container_s *
+aio_engine_merge(FAR struct aio_container_s *aioc, off_t offset,
+                 size_t maxbytes);
+#if CONFIG_FS_AIO_MERGE_BUFSIZE > 0
+FAR uint8_t *aio_engine_buffer(FAR struct aio_container_s *aioc);
+#endif
+#endif
+
 /****************************************************************************
  * Name: aio_signal
  *
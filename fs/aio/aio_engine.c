@@ -0,0 +1,395 @@
+/****************************************************************************
+ * fs/aio/aio_engine.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sched.h>
+#include <aio.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+
+#include "aio/aio.h"
+
+#ifdef AIO_HAVE_ENGINE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of one thread of the AIO engine */
+
+struct aio_thread_s
+{
+  FAR struct file *filep;          /* File of the I/O in progress or NULL */
+#if CONFIG_FS_AIO_MERGE_BUFSIZE > 0
+  FAR uint8_t *buffer;             /* Bounce buffer for merged writes */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct aio_thread_s g_aio_threads[CONFIG_FS_AIO_NTHREADS];
+
+/* Posted once for each queued I/O.  A thread that wakes up and finds only
+ * I/O for files that other threads are busy with goes back to sleep;  the
+ * busy threads pick that I/O up when they are done.
+ */
+
+static sem_t g_aio_worksem = NXSEM_INITIALIZER(0, PRIOINHERIT_FLAGS_DISABLE);
+
+/* The threads are started with the first I/O, after the OS is up */
+
+static bool g_aio_started;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_engine_busy
+ *
+ * Description:
+ *   Check if another thread of the engine is doing I/O on a file.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock
+ *
+ ****************************************************************************/
+
+static bool aio_engine_busy(FAR struct file *filep)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_AIO_NTHREADS; i++)
+    {
+      if (g_aio_threads[i].filep == filep)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: aio_engine_next
+ *
+ * Description:
+ *   Take the oldest queued I/O for a file that no thread of the engine is
+ *   busy with.  Keeping each file on one thread at a time preserves the
+ *   order of the I/O on that file, as required for O_APPEND.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock
+ *
+ ****************************************************************************/
+
+static FAR struct aio_container_s *aio_engine_next(void)
+{
+  FAR struct aio_container_s *aioc;
+
+  for (aioc = (FAR struct aio_container_s *)g_aio_pending.head;
+       aioc != NULL;
+       aioc = (FAR struct aio_container_s *)aioc->aioc_link.flink)
+    {
+      if (aioc->aioc_worker != NULL && !aioc->aioc_started &&
+          !aio_engine_busy(aioc->aioc_filep))
+        {
+          aioc->aioc_started = true;
+          return aioc;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: aio_engine_thread
+ *
+ * Description:
+ *   The body of each thread of the AIO engine.
+ *
+ ****************************************************************************/
+
+static int aio_engine_thread(int argc, FAR char *argv[])
+{
+  FAR struct aio_thread_s *thread;
+  FAR struct aio_container_s *aioc;
+  worker_t worker;
+
+  thread = &g_aio_threads[atoi(argv[1])];
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&g_aio_worksem);
+
+      /* Keep going as long as there is I/O that this thread may do */
+
+      for (; ; )
+        {
+          aio_lock();
+          thread->filep = NULL;
+          aioc = aio_engine_next();
+          if (aioc == NULL)
+            {
+              aio_unlock();
+              break;
+            }
+
+          thread->filep = aioc->aioc_filep;
+          worker = aioc->aioc_worker;
+          aio_unlock();
+
+          worker(aioc);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_engine_start
+ *
+ * Description:
+ *   Start the threads of the AIO engine.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock
+ *
+ ****************************************************************************/
+
+static int aio_engine_start(void)
+{
+  FAR char *argv[2];
+  char arg[8];
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FS_AIO_NTHREADS; i++)
+    {
+#if CONFIG_FS_AIO_MERGE_BUFSIZE > 0
+      /* Without a bounce buffer, the thread just does not merge writes */
+
+      g_aio_threads[i].buffer = kmm_malloc(CONFIG_FS_AIO_MERGE_BUFSIZE);
+#endif
+
+      snprintf(arg, sizeof(arg), "%d", i);
+      argv[0] = arg;
+      argv[1] = NULL;
+
+      ret = kthread_create("aio", CONFIG_FS_AIO_PRIORITY,
+                           CONFIG_FS_AIO_STACKSIZE,
+                           (main_t)aio_engine_thread, argv);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to start AIO thread %d: %d\n", i, ret);
+
+          /* The threads that did start can do all of the I/O */
+
+          if (i > 0)
+            {
+              break;
+            }
+
+          return ret;
+        }
+    }
+
+  g_aio_started = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_engine_queue
+ *
+ * Description:
+ *   Queue an asynchronous I/O for the threads of the AIO engine.
+ *
+ * Input Parameters:
+ *   aioc   - The AIO container of the I/O
+ *   worker - The function that performs the I/O
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int aio_engine_queue(FAR struct aio_container_s *aioc, worker_t worker)
+{
+  int ret;
+
+  ret = aio_lock();
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (!g_aio_started)
+    {
+      ret = aio_engine_start();
+      if (ret < 0)
+        {
+          aio_unlock();
+          return ret;
+        }
+    }
+
+  aioc->aioc_worker  = worker;
+  aioc->aioc_started = false;
+  aio_unlock();
+
+  nxsem_post(&g_aio_worksem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_engine_dequeue
+ *
+ * Description:
+ *   Remove an I/O from the queue of the AIO engine, if no thread has taken
+ *   it yet.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container of the I/O
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was removed; -ENOENT if it is already running.
+ *
+ ****************************************************************************/
+
+int aio_engine_dequeue(FAR struct aio_container_s *aioc)
+{
+  int ret = -ENOENT;
+
+  aio_lock();
+  if (aioc->aioc_worker != NULL && !aioc->aioc_started)
+    {
+      aioc->aioc_worker = NULL;
+      ret = OK;
+    }
+
+  aio_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: aio_engine_merge
+ *
+ * Description:
+ *   Take the next queued I/O on the same file, if it is of the same kind as
+ *   an I/O that the calling thread is performing, starts at 'offset' and
+ *   transfers no more than 'maxbytes'.  Later I/O on the file is never
+ *   taken before earlier I/O.
+ *
+ * Input Parameters:
+ *   aioc     - The AIO container of I/O being performed
+ *   offset   - The file offset where the next I/O has to start
+ *   maxbytes - The maximum size of the next I/O
+ *
+ * Returned Value:
+ *   The AIO container of the next I/O, or NULL if there is none.  The
+ *   caller has to perform the I/O and decant the container.
+ *
+ ****************************************************************************/
+
+FAR struct aio_container_s *
+aio_engine_merge(FAR struct aio_container_s *aioc, off_t offset,
+                 size_t maxbytes)
+{
+  FAR struct aio_container_s *next;
+
+  aio_lock();
+  for (next = (FAR struct aio_container_s *)aioc->aioc_link.flink;
+       next != NULL;
+       next = (FAR struct aio_container_s *)next->aioc_link.flink)
+    {
+      if (next->aioc_filep != aioc->aioc_filep ||
+          next->aioc_worker == NULL || next->aioc_started)
+        {
+          continue;
+        }
+
+      /* This is the next I/O on the file */
+
+      if (next->aioc_worker == aioc->aioc_worker &&
+          next->aioc_aiocbp->aio_offset == offset &&
+          next->aioc_aiocbp->aio_nbytes <= maxbytes)
+        {
+          next->aioc_started = true;
+          aio_unlock();
+          return next;
+        }
+
+      break;
+    }
+
+  aio_unlock();
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: aio_engine_buffer
+ *
+ * Description:
+ *   Return the bounce buffer of the calling thread of the AIO engine, with
+ *   room for CONFIG_FS_AIO_MERGE_BUFSIZE bytes, or NULL.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_AIO_MERGE_BUFSIZE > 0
+FAR uint8_t *aio_engine_buffer(FAR struct aio_container_s *aioc)
+{
+  int i;
+
+  /* The calling thread is the one that is busy with the file */
+
+  for (i = 0; i < CONFIG_FS_AIO_NTHREADS; i++)
+    {
+      if (g_aio_threads[i].filep == aioc->aioc_filep)
+        {
+          return g_aio_threads[i].buffer;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+#endif /* AIO_HAVE_ENGINE */
@@ -61,8 +61,9 @@ static void aio_fsync_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
+  FAR struct file *filep;
   pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPBOOST
   uint8_t prio;
 #endif
   int ret;
@@ -73,15 +74,16 @@ static void aio_fsync_worker(FAR void *arg)
    */
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
+  filep  = aioc->aioc_filep;
   pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPBOOST
   prio   = aioc->aioc_prio;
 #endif
   aiocbp = aioc_decant(aioc);
 
   /* Perform the fsync using aioc_filep */
 
-  ret = file_fsync(aioc->aioc_filep);
+  ret = file_fsync(filep);
   if (ret < 0)
     {
       ferr("ERROR: file_fsync failed: %d\n", ret);
@@ -96,7 +98,7 @@ static void aio_fsync_worker(FAR void *arg)
 
   aio_signal(pid, aiocbp);
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPBOOST
   /* Restore the low priority worker thread default priority */
 
   lpwork_restorepriority(prio);
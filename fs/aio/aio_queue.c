@@ -44,7 +44,8 @@
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the low priority work queue, or on
+ *   the threads of the AIO engine
  *
  * Input Parameters:
  *   arg - Worker argument.  In this case, a pointer to an instance of
@@ -60,6 +61,17 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
 {
   int ret;
 
+#ifdef AIO_HAVE_ENGINE
+  ret = aio_engine_queue(aioc, worker);
+  if (ret < 0)
+    {
+      aioc->aioc_aiocbp->aio_result = ret;
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  return ret;
+#else
 #ifdef CONFIG_PRIORITY_INHERITANCE
   /* Prohibit context switches until we complete the queuing */
 
@@ -94,6 +106,41 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
   sched_unlock();
 #endif
   return ret;
+#endif /* AIO_HAVE_ENGINE */
+}
+
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove a queued asynchronous I/O before it is started.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container of the I/O
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was removed; a negated errno value if it could
+ *   not be removed because it is already running.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc)
+{
+#ifdef AIO_HAVE_ENGINE
+  return aio_engine_dequeue(aioc);
+#else
+  int ret;
+
+  ret = work_cancel(LPWORK, &aioc->aioc_work);
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if (ret >= 0)
+    {
+      lpwork_restorepriority(aioc->aioc_prio);
+    }
+#endif
+
+  return ret;
+#endif
 }
 
 #endif /* CONFIG_FS_AIO */
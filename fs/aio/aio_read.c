@@ -61,8 +61,9 @@ static void aio_read_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
+  FAR struct file *filep;
   pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPBOOST
   uint8_t prio;
 #endif
   ssize_t nread = 0;
@@ -73,8 +74,9 @@ static void aio_read_worker(FAR void *arg)
    */
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
+  filep  = aioc->aioc_filep;
   pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPBOOST
   prio   = aioc->aioc_prio;
 #endif
   aiocbp = aioc_decant(aioc);
@@ -87,7 +89,7 @@ static void aio_read_worker(FAR void *arg)
    *   aio_offset   - File offset
    */
 
-  nread = file_pread(aioc->aioc_filep, (FAR void *)aiocbp->aio_buf,
+  nread = file_pread(filep, (FAR void *)aiocbp->aio_buf,
                      aiocbp->aio_nbytes, aiocbp->aio_offset);
 
   /* Set the result of the read operation. */
@@ -105,7 +107,7 @@ static void aio_read_worker(FAR void *arg)
 
   aio_signal(pid, aiocbp);
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPBOOST
   /* Restore the low priority worker thread default priority */
 
   lpwork_restorepriority(prio);
@@ -39,10 +39,137 @@
 
 #ifdef CONFIG_FS_AIO
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Writes are merged if the threads of the AIO engine have bounce buffers */
+
+#if defined(AIO_HAVE_ENGINE) && CONFIG_FS_AIO_MERGE_BUFSIZE > 0
+#  define AIO_HAVE_MERGE 1
+
+/* The maximum number of writes merged into one transfer */
+
+#  define AIO_MERGE_MAX  8
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_write_merge
+ *
+ * Description:
+ *   Gather the queued writes that continue the write of 'aioc' on the same
+ *   file into the bounce buffer of the calling thread, and write them all
+ *   with one transfer.  A data logger with many small writes in flight
+ *   then pays for one driver or file system call instead of one each.
+ *
+ * Input Parameters:
+ *   aioc  - The AIO container of the first write
+ *   filep - The file of the write
+ *
+ * Returned Value:
+ *   true if the writes were merged and have completed; false if there was
+ *   nothing to merge and 'aioc' has to be written on its own.
+ *
+ ****************************************************************************/
+
+#ifdef AIO_HAVE_MERGE
+static bool aio_write_merge(FAR struct aio_container_s *aioc,
+                            FAR struct file *filep)
+{
+  FAR struct aio_container_s *merged[AIO_MERGE_MAX];
+  FAR struct aiocb *aiocbp[AIO_MERGE_MAX];
+  pid_t pid[AIO_MERGE_MAX];
+  FAR uint8_t *buffer;
+  ssize_t nwritten;
+  size_t nbytes;
+  off_t offset;
+  int oflags;
+  int nmerged;
+  int i;
+
+  /* Appended writes do not have offsets to check for continuity */
+
+  oflags = file_fcntl(filep, F_GETFL);
+  buffer = aio_engine_buffer(aioc);
+  if (oflags < 0 || (oflags & O_APPEND) != 0 || buffer == NULL ||
+      aioc->aioc_aiocbp->aio_nbytes >= CONFIG_FS_AIO_MERGE_BUFSIZE)
+    {
+      return false;
+    }
+
+  merged[0] = aioc;
+  nbytes    = aioc->aioc_aiocbp->aio_nbytes;
+  offset    = aioc->aioc_aiocbp->aio_offset;
+  nmerged   = 1;
+
+  while (nmerged < AIO_MERGE_MAX)
+    {
+      aioc = aio_engine_merge(merged[nmerged - 1], offset + nbytes,
+                              CONFIG_FS_AIO_MERGE_BUFSIZE - nbytes);
+      if (aioc == NULL)
+        {
+          break;
+        }
+
+      merged[nmerged++] = aioc;
+      nbytes += aioc->aioc_aiocbp->aio_nbytes;
+    }
+
+  if (nmerged < 2)
+    {
+      return false;
+    }
+
+  /* Copy the data and release the containers before starting the I/O */
+
+  nbytes = 0;
+  for (i = 0; i < nmerged; i++)
+    {
+      pid[i]    = merged[i]->aioc_pid;
+      aiocbp[i] = aioc_decant(merged[i]);
+      memcpy(buffer + nbytes, (FAR const void *)aiocbp[i]->aio_buf,
+             aiocbp[i]->aio_nbytes);
+      nbytes   += aiocbp[i]->aio_nbytes;
+    }
+
+  nwritten = file_pwrite(filep, buffer, nbytes, offset);
+  if (nwritten < 0)
+    {
+      ferr("ERROR: pwrite failed: %zd\n", nwritten);
+    }
+
+  /* A short write completes the first writes and leaves the rest short or
+   * empty.
+   */
+
+  for (i = 0; i < nmerged; i++)
+    {
+      if (nwritten < 0)
+        {
+          aiocbp[i]->aio_result = nwritten;
+        }
+      else if ((size_t)nwritten >= aiocbp[i]->aio_nbytes)
+        {
+          aiocbp[i]->aio_result = aiocbp[i]->aio_nbytes;
+          nwritten -= aiocbp[i]->aio_nbytes;
+        }
+      else
+        {
+          aiocbp[i]->aio_result = nwritten;
+          nwritten = 0;
+        }
+
+      aio_signal(pid[i], aiocbp[i]);
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: aio_write_worker
  *
@@ -63,8 +190,9 @@ static void aio_write_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
+  FAR struct file *filep;
   pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPBOOST
   uint8_t prio;
 #endif
   ssize_t nwritten = 0;
@@ -76,15 +204,24 @@ static void aio_write_worker(FAR void *arg)
    */
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
+  filep  = aioc->aioc_filep;
+
+#ifdef AIO_HAVE_MERGE
+  if (aio_write_merge(aioc, filep))
+    {
+      return;
+    }
+#endif
+
   pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPBOOST
   prio   = aioc->aioc_prio;
 #endif
   aiocbp = aioc_decant(aioc);
 
   /* Call fcntl(F_GETFL) to get the file open mode. */
 
-  oflags = file_fcntl(aioc->aioc_filep, F_GETFL);
+  oflags = file_fcntl(filep, F_GETFL);
   if (oflags < 0)
     {
       ferr("ERROR: file_fcntl failed: %d\n", oflags);
@@ -106,13 +243,13 @@ static void aio_write_worker(FAR void *arg)
     {
       /* Append to the current file position */
 
-      nwritten = file_write(aioc->aioc_filep,
+      nwritten = file_write(filep,
                             (FAR const void *)aiocbp->aio_buf,
                             aiocbp->aio_nbytes);
     }
   else
     {
-      nwritten = file_pwrite(aioc->aioc_filep,
+      nwritten = file_pwrite(filep,
                              (FAR const void *)aiocbp->aio_buf,
                              aiocbp->aio_nbytes,
                              aiocbp->aio_offset);
@@ -133,7 +270,7 @@ errout:
 
   aio_signal(pid, aiocbp);
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#ifdef AIO_HAVE_LPBOOST
   /* Restore the low priority worker thread default priority */
 
   lpwork_restorepriority(prio);
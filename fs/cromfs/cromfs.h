@@ -79,11 +79,24 @@ struct cromfs_volume_s
   uint32_t cv_bsize;     /* Optimal block size for transfers */
 };
 
+/* Values of the cn_flags field of a node */
+
+#define CROMFS_NODE_INDEXED (1 << 0) /* cn_blocks refers to a block index */
+
 /* This describes one node in the CROMFS file system. It holds node meta data
  * that provides the information that will be return by stat() or fstat()
  * and also provides the information needed by the CROMFS file system to
  * access the node data.
  *
+ * The data of a regular file is held in LZF blocks, each of which
+ * decompresses to cv_bsize bytes except for the last one.  Normally,
+ * cn_blocks refers to the first block and the following blocks are found
+ * by walking the block headers.  If CROMFS_NODE_INDEXED is set in cn_flags,
+ * cn_blocks instead refers to an array of (cn_size + cv_bsize - 1) /
+ * cv_bsize 32-bit image offsets, one per block, so that the block holding
+ * any file offset can be located directly.  That array need not be
+ * aligned.
+ *
  * Relationship to struct stat:
  *
  *   st_mode    - File type, attributes, and access mode bits
@@ -105,7 +118,7 @@ struct cromfs_volume_s
 struct cromfs_node_s
 {
   uint16_t cn_mode;      /* File type, attributes, and access mode bits */
-  uint16_t cn_pad;       /* Not used */
+  uint16_t cn_flags;     /* See CROMFS_NODE_* definitions */
   uint32_t cn_name;      /* Offset from the beginning of the volume header to the
                           * node name string.  NUL-terminated. */
   uint32_t cn_size;      /* Size of the uncompressed data (in bytes) */
@@ -53,18 +53,37 @@
 
 #define CROMFS_MAX_LINKS 64
 
+#ifdef CONFIG_FS_CROMFS_CACHE_BLOCKS
+#  define CROMFS_NCACHE CONFIG_FS_CROMFS_CACHE_BLOCKS
+#else
+#  define CROMFS_NCACHE 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* This structure describes one decompressed block held by an open file */
+
+struct cromfs_cache_s
+{
+  uint32_t cc_offset;                       /* Block offset (0 if none) */
+  uint16_t cc_ulen;                         /* Length of decompressed data */
+  FAR uint8_t *cc_buffer;                   /* Decompressed data */
+};
+
 /* This structure represents an open, regular file */
 
 struct cromfs_file_s
 {
   FAR const struct cromfs_node_s *ff_node;  /* The open file node */
-  uint32_t ff_offset;                       /* Cached block offset (zero means none) */
-  uint16_t ff_ulen;                         /* Length of decompressed data in cache */
-  FAR uint8_t *ff_buffer;                   /* Cached, decompressed data */
+  FAR const struct lzf_header_s *ff_blkhdr; /* Last block visited */
+  uint32_t ff_blkoffs;                      /* File offset of that block */
+  FAR uint8_t *ff_buffer;                   /* Memory of all cache buffers */
+
+  /* Cached, decompressed blocks, the most recently used one first */
+
+  struct cromfs_cache_s ff_cache[CROMFS_NCACHE];
 };
 
 /* This is the form of the callback from cromfs_foreach_node(): */
@@ -125,6 +144,17 @@ static int      cromfs_find_node(FAR const struct cromfs_volume_s *fs,
                   FAR const char *relpath,
                   FAR struct cromfs_nodeinfo_s *info,
                   FAR uint32_t *offset);
+static uint32_t cromfs_block_info(FAR const struct lzf_header_s *hdr,
+                  FAR uint16_t *ulen, FAR uint16_t *clen);
+static FAR const struct lzf_header_s *
+                cromfs_find_block(FAR const struct cromfs_volume_s *fs,
+                  FAR struct cromfs_file_s *ff, uint32_t fpos,
+                  FAR uint32_t *blkoffs);
+static int      cromfs_alloc_cache(FAR const struct cromfs_volume_s *fs,
+                  FAR struct cromfs_file_s *ff);
+static FAR struct cromfs_cache_s *
+                cromfs_lookup_cache(FAR struct cromfs_file_s *ff,
+                  uint32_t voloffs, bool reuse);
 
 /* Common file system methods */
 
@@ -333,7 +363,7 @@ static int cromfs_follow_link(FAR const struct cromfs_volume_s *fs,
            */
 
           newnode->cn_mode    = S_IFDIR | (node->cn_mode & ~S_IFMT);
-          newnode->cn_pad     = 0;
+          newnode->cn_flags   = 0;
           newnode->cn_name    = node->cn_name;
           newnode->cn_size    = 0;
           newnode->cn_peer    = node->cn_peer;
@@ -350,13 +380,13 @@ static int cromfs_follow_link(FAR const struct cromfs_volume_s *fs,
       /* Copy the origin node file name into the writable node copy */
 
       newnode->cn_name   = node->cn_name;
-      newnode->cn_pad    = 0;
 
       /* Copy all attributes of the target node, but retain the hard link
        * file name and, possibly, the peer node reference.
        */
 
       newnode->cn_mode   = linknode->cn_mode;
+      newnode->cn_flags  = linknode->cn_flags;
       newnode->cn_size   = linknode->cn_size;
       newnode->u.cn_link = linknode->u.cn_link;
 
@@ -708,6 +738,206 @@ static int cromfs_find_node(FAR const struct cromfs_volume_s *fs,
     }
 }
 
+/****************************************************************************
+ * Name: cromfs_block_info
+ *
+ * Description:
+ *   Decode the header of a data block.  The decompressed and the stored
+ *   length of the block data are returned in ulen and clen (these are the
+ *   same for an uncompressed block) and the size of the whole block,
+ *   including its header, is returned by the function.
+ *
+ ****************************************************************************/
+
+static uint32_t cromfs_block_info(FAR const struct lzf_header_s *hdr,
+                                  FAR uint16_t *ulen, FAR uint16_t *clen)
+{
+  if (hdr->lzf_type == LZF_TYPE0_HDR)
+    {
+      FAR const struct lzf_type0_header_s *hdr0 =
+        (FAR const struct lzf_type0_header_s *)hdr;
+
+      *ulen = (uint16_t)hdr0->lzf_len[0] << 8 |
+              (uint16_t)hdr0->lzf_len[1];
+      *clen = *ulen;
+      return (uint32_t)*ulen + LZF_TYPE0_HDR_SIZE;
+    }
+  else
+    {
+      FAR const struct lzf_type1_header_s *hdr1 =
+        (FAR const struct lzf_type1_header_s *)hdr;
+
+      *ulen = (uint16_t)hdr1->lzf_ulen[0] << 8 |
+              (uint16_t)hdr1->lzf_ulen[1];
+      *clen = (uint16_t)hdr1->lzf_clen[0] << 8 |
+              (uint16_t)hdr1->lzf_clen[1];
+      return (uint32_t)*clen + LZF_TYPE1_HDR_SIZE;
+    }
+}
+
+/****************************************************************************
+ * Name: cromfs_find_block
+ *
+ * Description:
+ *   Find the data block of an open file that holds the file offset fpos.
+ *   The file offset of the first byte of that block is returned in blkoffs.
+ *
+ *   The block is taken from the block index of the file if the image has
+ *   one.  Otherwise the block headers are walked, starting at the block
+ *   visited last if that precedes fpos so that sequential reads do not
+ *   walk the same blocks again.
+ *
+ ****************************************************************************/
+
+static FAR const struct lzf_header_s *
+cromfs_find_block(FAR const struct cromfs_volume_s *fs,
+                  FAR struct cromfs_file_s *ff, uint32_t fpos,
+                  FAR uint32_t *blkoffs)
+{
+  FAR const struct cromfs_node_s *node = ff->ff_node;
+  FAR const struct lzf_header_s *hdr;
+  uint32_t offset;
+  uint16_t ulen;
+  uint16_t clen;
+
+  DEBUGASSERT(fpos < node->cn_size);
+
+  if ((node->cn_flags & CROMFS_NODE_INDEXED) != 0)
+    {
+      FAR const uint8_t *index;
+      uint32_t blkno;
+
+      /* The index holds the image offset of each block.  It need not be
+       * aligned, so copy the entry out.
+       */
+
+      index    = (FAR const uint8_t *)
+                 cromfs_offset2addr(fs, node->u.cn_blocks);
+      blkno    = fpos / fs->cv_bsize;
+      memcpy(&offset, &index[blkno * sizeof(uint32_t)], sizeof(uint32_t));
+
+      *blkoffs = blkno * fs->cv_bsize;
+      return (FAR const struct lzf_header_s *)
+             cromfs_offset2addr(fs, offset);
+    }
+
+  /* Walk the block headers, restarting from the first block if fpos lies
+   * before the block that was visited last.
+   */
+
+  if (ff->ff_blkhdr != NULL && ff->ff_blkoffs <= fpos)
+    {
+      hdr    = ff->ff_blkhdr;
+      offset = ff->ff_blkoffs;
+    }
+  else
+    {
+      hdr    = (FAR const struct lzf_header_s *)
+               cromfs_offset2addr(fs, node->u.cn_blocks);
+      offset = 0;
+    }
+
+  for (; ; )
+    {
+      uint32_t blksize = cromfs_block_info(hdr, &ulen, &clen);
+
+      if (fpos < offset + ulen)
+        {
+          break;
+        }
+
+      offset += ulen;
+      hdr     = (FAR const struct lzf_header_s *)
+                ((FAR const uint8_t *)hdr + blksize);
+    }
+
+  ff->ff_blkhdr  = hdr;
+  ff->ff_blkoffs = offset;
+
+  *blkoffs       = offset;
+  return hdr;
+}
+
+/****************************************************************************
+ * Name: cromfs_alloc_cache
+ *
+ * Description:
+ *   Allocate the decompressed block cache of an open file.
+ *
+ ****************************************************************************/
+
+static int cromfs_alloc_cache(FAR const struct cromfs_volume_s *fs,
+                              FAR struct cromfs_file_s *ff)
+{
+  int i;
+
+  ff->ff_buffer = (FAR uint8_t *)kmm_malloc(CROMFS_NCACHE * fs->cv_bsize);
+  if (ff->ff_buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < CROMFS_NCACHE; i++)
+    {
+      ff->ff_cache[i].cc_offset = 0;
+      ff->ff_cache[i].cc_ulen   = 0;
+      ff->ff_cache[i].cc_buffer = &ff->ff_buffer[i * fs->cv_bsize];
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cromfs_lookup_cache
+ *
+ * Description:
+ *   Find the cache entry holding the decompressed data of the block at the
+ *   image offset voloffs and make it the most recently used one.  If the
+ *   block is not cached and reuse is true, the least recently used entry
+ *   is emptied and returned instead so that the block can be decompressed
+ *   into it.  Otherwise NULL is returned.
+ *
+ ****************************************************************************/
+
+static FAR struct cromfs_cache_s *
+cromfs_lookup_cache(FAR struct cromfs_file_s *ff, uint32_t voloffs,
+                    bool reuse)
+{
+  struct cromfs_cache_s entry;
+  int i;
+
+  for (i = 0; i < CROMFS_NCACHE - 1; i++)
+    {
+      if (ff->ff_cache[i].cc_offset == voloffs)
+        {
+          break;
+        }
+    }
+
+  if (ff->ff_cache[i].cc_offset != voloffs)
+    {
+      if (!reuse)
+        {
+          return NULL;
+        }
+
+      /* i refers to the least recently used entry now */
+
+      ff->ff_cache[i].cc_offset = 0;
+      ff->ff_cache[i].cc_ulen   = 0;
+    }
+
+  if (i > 0)
+    {
+      entry = ff->ff_cache[i];
+      memmove(&ff->ff_cache[1], &ff->ff_cache[0],
+              i * sizeof(struct cromfs_cache_s));
+      ff->ff_cache[0] = entry;
+    }
+
+  return &ff->ff_cache[0];
+}
+
 /****************************************************************************
  * Name: cromfs_open
  ****************************************************************************/
@@ -776,13 +1006,13 @@ static int cromfs_open(FAR struct file *filep, FAR const char *relpath,
       return -ENOMEM;
     }
 
-  /* Create a file buffer to support partial sector accesses */
+  /* Create the block cache to support partial block accesses */
 
-  ff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
-  if (!ff->ff_buffer)
+  ret = cromfs_alloc_cache(fs, ff);
+  if (ret < 0)
     {
       kmm_free(ff);
-      return -ENOMEM;
+      return ret;
     }
 
   /* Save the node in the open file instance */
@@ -830,15 +1060,17 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   FAR struct inode *inode;
   FAR const struct cromfs_volume_s *fs;
   FAR struct cromfs_file_s *ff;
-  FAR struct lzf_header_s *currhdr;
-  FAR struct lzf_header_s *nexthdr;
+  FAR const struct lzf_header_s *currhdr;
+  FAR struct cromfs_cache_s *cache;
   FAR uint8_t *dest;
   FAR const uint8_t *src;
   off_t fpos;
   size_t remaining;
   uint32_t blkoffs;
+  uint32_t voloffs;
   uint16_t ulen;
   uint16_t clen;
+  unsigned int decomplen;
   unsigned int copysize;
   unsigned int copyoffs;
 
@@ -877,66 +1109,25 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
       buflen = ff->ff_node->cn_size - filep->f_pos;
     }
 
-  /* Find the compressed block containing the current offset, f_pos */
-
   dest      = (FAR uint8_t *)buffer;
   remaining = buflen;
   fpos      = filep->f_pos;
-  blkoffs   = 0;
-  ulen      = 0;
-  nexthdr   = (FAR struct lzf_header_s *)
-               cromfs_offset2addr(fs, ff->ff_node->u.cn_blocks);
-
-  /* Look until we find the compressed block containing the start of the
-   * requested data.
-   */
 
   while (remaining > 0)
     {
-      /* Search for the next block containing the fpos file offset.  This is
-       * real search on the first time through but the remaining blocks
-       * should be contiguous so that the logic should not loop.
-       *
-       */
+      /* Find the block containing the fpos file offset */
 
-      do
-        {
-          uint32_t blksize;
-
-          /* Go to the next block */
-
-          currhdr  = nexthdr;
-          blkoffs += ulen;
-
-          if (currhdr->lzf_type == LZF_TYPE0_HDR)
-            {
-              FAR struct lzf_type0_header_s *hdr0 =
-                (FAR struct lzf_type0_header_s *)currhdr;
+      currhdr  = cromfs_find_block(fs, ff, fpos, &blkoffs);
+      cromfs_block_info(currhdr, &ulen, &clen);
 
-              ulen    = (uint16_t)hdr0->lzf_len[0] << 8 |
-                        (uint16_t)hdr0->lzf_len[1];
-              blksize = (uint32_t)ulen + LZF_TYPE0_HDR_SIZE;
-            }
-          else
-            {
-              FAR struct lzf_type1_header_s * hdr1 =
-                (FAR struct lzf_type1_header_s *)currhdr;
-
-              ulen    = (uint16_t)hdr1->lzf_ulen[0] << 8 |
-                        (uint16_t)hdr1->lzf_ulen[1];
-              clen    = (uint16_t)hdr1->lzf_clen[0] << 8 |
-                        (uint16_t)hdr1->lzf_clen[1];
-              blksize = (uint32_t)clen + LZF_TYPE1_HDR_SIZE;
-            }
+      copyoffs = fpos - blkoffs;
+      DEBUGASSERT(ulen > copyoffs);
+      copysize = ulen - copyoffs;
 
-          nexthdr  = (FAR struct lzf_header_s *)
-                     ((FAR uint8_t *)currhdr + blksize);
+      if (copysize > remaining)  /* Clip to the size really needed */
+        {
+          copysize = remaining;
         }
-      while (fpos >= (blkoffs + ulen));
-
-      /* Check if we need to decompress the next block into the user
-       * buffer.
-       */
 
       if (currhdr->lzf_type == LZF_TYPE0_HDR)
         {
@@ -944,15 +1135,6 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
            * user buffer.
            */
 
-          copyoffs = (blkoffs >= filep->f_pos) ? 0 : filep->f_pos - blkoffs;
-          DEBUGASSERT(ulen > copyoffs);
-          copysize = ulen - copyoffs;
-
-          if (copysize > remaining)  /* Clip to the size really needed */
-            {
-              copysize = remaining;
-            }
-
           src = (FAR const uint8_t *)currhdr + LZF_TYPE0_HDR_SIZE;
           memcpy(dest, &src[copyoffs], copysize);
 
@@ -961,83 +1143,54 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
         }
       else
         {
-          /* If the source of the data is at the beginning of the compressed
-           * data buffer and if the uncompressed data would not overrun the
-           * buffer, then we can decompress directly into the user buffer.
+          /* Get the address and offset in the CROMFS image to obtain the
+           * data.  Check if we already have this block in the cache.
            */
 
-          if (filep->f_pos <= blkoffs && ulen <= remaining)
-            {
-              uint32_t voloffs;
-
-              copyoffs = 0;
-              copysize = ulen;
+          src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
+          voloffs = cromfs_addr2offset(fs, src);
 
-              /* Get the address and offset in the CROMFS image to obtain
-               * the data.  Check if we already have this offset in the
-               * cache.
-               */
+          /* If the whole block is needed and it is not cached, then we can
+           * decompress directly into the user buffer.  Otherwise, we will
+           * need to decompress into one of the cache buffers.
+           */
 
-              src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
+          cache   = cromfs_lookup_cache(ff, voloffs,
+                                        copyoffs > 0 || copysize < ulen);
+          if (cache == NULL)
+            {
+              decomplen = lzf_decompress(src, clen, dest, ulen);
+            }
+          else if (cache->cc_offset != voloffs)
+            {
+              decomplen = lzf_decompress(src, clen, cache->cc_buffer,
+                                         fs->cv_bsize);
+              if (decomplen == ulen)
                 {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, dest, fs->cv_bsize);
-
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
+                  cache->cc_offset = voloffs;
+                  cache->cc_ulen   = decomplen;
                 }
-
-              finfo("voloffs=%" PRIu32 " blkoffs=%" PRIu32
-                    " ulen=%" PRIu16 " ff_offset=%" PRIu32 " copysize=%u\n",
-                    voloffs, blkoffs, ulen, ff->ff_offset, copysize);
-              DEBUGASSERT(ff->ff_ulen >= copysize);
             }
           else
             {
-              uint32_t voloffs;
-
-              /* No, we will need to decompress into the our intermediate
-               * decompression buffer.
-               */
-
-              copyoffs = (blkoffs >= filep->f_pos) ?
-                            0 : filep->f_pos - blkoffs;
-              DEBUGASSERT(ulen > copyoffs);
-              copysize = ulen - copyoffs;
-
-              if (copysize > remaining)  /* Clip to the size really needed */
-                {
-                  copysize = remaining;
-                }
-
-              DEBUGASSERT((copyoffs + copysize) <=  fs->cv_bsize);
-
-              src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
-                {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, ff->ff_buffer,
-                                             fs->cv_bsize);
+              decomplen = cache->cc_ulen;
+            }
 
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
-                }
+          finfo("voloffs=%" PRIu32 " blkoffs=%" PRIu32 " ulen=%" PRIu16
+                " clen=%" PRIu16 " copyoffs=%u copysize=%u\n",
+                voloffs, blkoffs, ulen, clen, copyoffs, copysize);
 
-              finfo("voloffs=%" PRIu32 " blkoffs=%" PRIu32 " ulen=%" PRIu16
-                    " clen=%" PRIu16 " ff_offset=%" PRIu32
-                    "  copyoffs=%u copysize=%u\n",
-                    voloffs, blkoffs, ulen, clen, ff->ff_offset,
-                    copyoffs, copysize);
-              DEBUGASSERT(ff->ff_ulen >= (copyoffs + copysize));
+          if (decomplen != ulen)
+            {
+              ferr("ERROR: Bad block at offset %" PRIu32 "\n", voloffs);
+              return -EIO;
+            }
 
-              /* Then copy to user buffer */
+          /* Then copy from the cache to user buffer */
 
-              memcpy(dest, &ff->ff_buffer[copyoffs], copysize);
+          if (cache != NULL)
+            {
+              memcpy(dest, &cache->cc_buffer[copyoffs], copysize);
             }
         }
 
@@ -1080,6 +1233,7 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
   FAR struct cromfs_volume_s *fs;
   FAR struct cromfs_file_s *oldff;
   FAR struct cromfs_file_s *newff;
+  int ret;
 
   finfo("Dup %p->%p\n", oldp, newp);
   DEBUGASSERT(oldp->f_priv != NULL && oldp->f_inode != NULL &&
@@ -1105,13 +1259,13 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
       return -ENOMEM;
     }
 
-  /* Create a file buffer to support partial sector accesses */
+  /* Create the block cache to support partial block accesses */
 
-  newff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
-  if (newff->ff_buffer == NULL)
+  ret = cromfs_alloc_cache(fs, newff);
+  if (ret < 0)
     {
       kmm_free(newff);
-      return -ENOMEM;
+      return ret;
     }
 
   /* Save the node in the open file instance */
@@ -124,28 +124,6 @@ int mtd_proxy(FAR const char *mtddev, int mountflags,
               FAR struct inode **ppinode);
 #endif
 
-/****************************************************************************
- * Name: find_mtddriver
- *
- * Description:
- *   Return the inode of the named MTD driver specified by 'pathname'
- *
- * Input Parameters:
- *   pathname   - the full path to the named MTD driver to be located
- *   ppinode    - address of the location to return the inode reference
- *
- * Returned Value:
- *   Returns zero on success or a negated errno on failure:
- *
- *   ENOENT  - No MTD driver of this name is registered
- *   ENOTBLK - The inode associated with the pathname is not an MTD driver
- *
- ****************************************************************************/
-
-#ifndef CONFIG_DISABLE_MOUNTPOINT
-int find_mtddriver(FAR const char *pathname, FAR struct inode **ppinode);
-#endif
-
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -0,0 +1,802 @@
+/****************************************************************************
+ * fs/driver/fs_blkcache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/blkcache.h>
+
+#ifdef CONFIG_FS_BLKCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of sequential streams that are tracked at the same time, e.g.
+ * the data of a file and the FAT of its volume.
+ */
+
+#define BLKCACHE_NSTREAMS 4
+
+/* Read ahead on the low priority work queue if there is one, otherwise
+ * only when a sequential read misses the cache.
+ */
+
+#if defined(CONFIG_FS_BLKCACHE_READAHEAD) && defined(CONFIG_SCHED_LPWORK)
+#  define BLKCACHE_ASYNC 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One page of the cache holds one sector of one block driver */
+
+struct blkcache_page_s
+{
+  FAR struct inode *inode;    /* The block driver, NULL if the page is free */
+  blkcnt_t sector;            /* The sector held by the page */
+  uint32_t stamp;             /* Time of the last access, for the LRU */
+  uint16_t sectsize;          /* The sector size of the block driver */
+  bool dirty;                 /* The sector was not yet written back */
+  bool busy;                  /* The driver is accessing the page */
+  uint8_t data[CONFIG_FS_BLKCACHE_SECTSIZE];
+};
+
+#ifdef CONFIG_FS_BLKCACHE_READAHEAD
+/* A stream of single sector reads at consecutive sectors */
+
+struct blkcache_stream_s
+{
+  FAR struct inode *inode;    /* The block driver, NULL if not in use */
+  blkcnt_t next;              /* The sector that continues the stream */
+  uint32_t stamp;             /* Time of the last read of the stream */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The cache is shared by all block drivers.  The mutex is recursive
+ * because the methods of a block driver, e.g. the loop device, may access
+ * the cache again on behalf of another block driver.
+ */
+
+static struct blkcache_page_s g_blkcache[CONFIG_FS_BLKCACHE_NPAGES];
+static rmutex_t g_blkcache_lock = RMUTEX_INITIALIZER;
+static uint32_t g_blkcache_stamp;
+
+/* Runs of sectors are transferred through this buffer */
+
+static uint8_t g_blkcache_runbuf[CONFIG_FS_BLKCACHE_MAXRUN *
+                                 CONFIG_FS_BLKCACHE_SECTSIZE];
+
+#ifdef CONFIG_FS_BLKCACHE_READAHEAD
+static struct blkcache_stream_s g_blkcache_streams[BLKCACHE_NSTREAMS];
+#endif
+
+#ifdef BLKCACHE_ASYNC
+/* The pending asynchronous read ahead */
+
+static struct work_s g_blkcache_work;
+static FAR struct inode *g_blkcache_rainode;
+static blkcnt_t g_blkcache_rastart;
+static size_t g_blkcache_rasize;
+#endif
+
+static uint32_t g_blkcache_hits;
+static uint32_t g_blkcache_misses;
+static uint32_t g_blkcache_writebacks;
+static uint32_t g_blkcache_bypasses;
+static uint32_t g_blkcache_readaheads;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blkcache_touch
+ *
+ * Description:
+ *   Mark a page as the most recently used one.
+ *
+ ****************************************************************************/
+
+static void blkcache_touch(FAR struct blkcache_page_s *page)
+{
+  page->stamp = ++g_blkcache_stamp;
+}
+
+/****************************************************************************
+ * Name: blkcache_find
+ *
+ * Description:
+ *   Find the page holding a sector of a block driver.
+ *
+ ****************************************************************************/
+
+static FAR struct blkcache_page_s *blkcache_find(FAR struct inode *inode,
+                                                 blkcnt_t sector)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_BLKCACHE_NPAGES; i++)
+    {
+      if (g_blkcache[i].inode == inode && g_blkcache[i].sector == sector)
+        {
+          return &g_blkcache[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: blkcache_writeback
+ *
+ * Description:
+ *   Write a dirty page back to its block driver.  The dirty pages holding
+ *   the neighbouring sectors are written back together with it in one
+ *   transfer of up to CONFIG_FS_BLKCACHE_MAXRUN sectors.
+ *
+ ****************************************************************************/
+
+static int blkcache_writeback(FAR struct blkcache_page_s *page)
+{
+  FAR struct blkcache_page_s *run[CONFIG_FS_BLKCACHE_MAXRUN];
+  FAR struct blkcache_page_s *next;
+  FAR struct inode *inode = page->inode;
+  size_t sectsize = page->sectsize;
+  blkcnt_t first = page->sector;
+  ssize_t ret;
+  int n;
+  int i;
+
+  /* Find the first sector of the run of dirty sectors */
+
+  for (n = 1; n < CONFIG_FS_BLKCACHE_MAXRUN && first > 0; n++)
+    {
+      next = blkcache_find(inode, first - 1);
+      if (next == NULL || !next->dirty || next->busy)
+        {
+          break;
+        }
+
+      first--;
+    }
+
+  /* And collect the run, which contains the page */
+
+  for (n = 0; n < CONFIG_FS_BLKCACHE_MAXRUN; n++)
+    {
+      next = blkcache_find(inode, first + n);
+      if (next == NULL || !next->dirty || next->busy)
+        {
+          break;
+        }
+
+      next->busy = true;
+      run[n]     = next;
+    }
+
+  if (n == 1)
+    {
+      ret = inode->u.i_bops->write(inode, page->data, first, 1);
+    }
+  else
+    {
+      for (i = 0; i < n; i++)
+        {
+          memcpy(g_blkcache_runbuf + i * sectsize, run[i]->data, sectsize);
+        }
+
+      ret = inode->u.i_bops->write(inode, g_blkcache_runbuf, first, n);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      run[i]->busy = false;
+      if (i < ret)
+        {
+          run[i]->dirty = false;
+          g_blkcache_writebacks++;
+        }
+    }
+
+  if (ret < 0)
+    {
+      ferr("ERROR: Write back of sector %" PRIdOFF " failed: %zd\n",
+           (off_t)first, ret);
+      return (int)ret;
+    }
+
+  return page->dirty ? -EIO : OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_alloc
+ *
+ * Description:
+ *   Get a free page, reclaiming the least recently used one if there is no
+ *   free page left.
+ *
+ * Returned Value:
+ *   The free page on success; NULL if all pages are in use by the block
+ *   drivers or if the reclaimed page could not be written back.
+ *
+ ****************************************************************************/
+
+static FAR struct blkcache_page_s *blkcache_alloc(void)
+{
+  FAR struct blkcache_page_s *victim = NULL;
+  FAR struct blkcache_page_s *page;
+  int i;
+
+  for (i = 0; i < CONFIG_FS_BLKCACHE_NPAGES; i++)
+    {
+      page = &g_blkcache[i];
+      if (page->busy)
+        {
+          continue;
+        }
+
+      if (page->inode == NULL)
+        {
+          return page;
+        }
+
+      /* The distance from the current time works across the wrap around
+       * of the time stamps.
+       */
+
+      if (victim == NULL ||
+          g_blkcache_stamp - page->stamp > g_blkcache_stamp - victim->stamp)
+        {
+          victim = page;
+        }
+    }
+
+  if (victim != NULL)
+    {
+      if (victim->dirty && blkcache_writeback(victim) < 0)
+        {
+          return NULL;
+        }
+
+      victim->inode = NULL;
+    }
+
+  return victim;
+}
+
+/****************************************************************************
+ * Name: blkcache_readrun
+ *
+ * Description:
+ *   Read a run of up to maxrun sectors that are not in the cache yet into
+ *   the cache in one transfer.  The run ends before the first sector that
+ *   is already cached.
+ *
+ * Returned Value:
+ *   The number of sectors read, zero if there is no page available or the
+ *   first sector is already cached, or a negated errno value.
+ *
+ ****************************************************************************/
+
+static ssize_t blkcache_readrun(FAR struct inode *inode, blkcnt_t start,
+                                size_t sectsize, int maxrun)
+{
+  FAR struct blkcache_page_s *run[CONFIG_FS_BLKCACHE_MAXRUN];
+  FAR struct blkcache_page_s *page;
+  ssize_t ret;
+  int n;
+  int i;
+
+  for (n = 0; n < maxrun; n++)
+    {
+      if (blkcache_find(inode, start + n) != NULL)
+        {
+          break;
+        }
+
+      page = blkcache_alloc();
+      if (page == NULL)
+        {
+          break;
+        }
+
+      page->busy = true;
+      run[n]     = page;
+    }
+
+  if (n == 0)
+    {
+      return 0;
+    }
+
+  ret = inode->u.i_bops->read(inode, n == 1 ? run[0]->data :
+                              g_blkcache_runbuf, start, n);
+
+  for (i = 0; i < n; i++)
+    {
+      page       = run[i];
+      page->busy = false;
+
+      if (i < ret)
+        {
+          if (n > 1)
+            {
+              memcpy(page->data, g_blkcache_runbuf + i * sectsize,
+                     sectsize);
+            }
+
+          page->inode    = inode;
+          page->sector   = start + i;
+          page->sectsize = sectsize;
+          page->dirty    = false;
+          blkcache_touch(page);
+        }
+    }
+
+  return ret;
+}
+
+#ifdef CONFIG_FS_BLKCACHE_READAHEAD
+
+/****************************************************************************
+ * Name: blkcache_sequential
+ *
+ * Description:
+ *   Account a single sector read and check if it continues a sequential
+ *   stream of reads.
+ *
+ ****************************************************************************/
+
+static bool blkcache_sequential(FAR struct inode *inode, blkcnt_t sector)
+{
+  FAR struct blkcache_stream_s *stream = &g_blkcache_streams[0];
+  bool sequential = false;
+  int i;
+
+  for (i = 0; i < BLKCACHE_NSTREAMS; i++)
+    {
+      if (g_blkcache_streams[i].inode == inode &&
+          g_blkcache_streams[i].next == sector)
+        {
+          stream     = &g_blkcache_streams[i];
+          sequential = true;
+          break;
+        }
+
+      /* Otherwise start a new stream in place of the oldest one */
+
+      if (g_blkcache_stamp - g_blkcache_streams[i].stamp >
+          g_blkcache_stamp - stream->stamp)
+        {
+          stream = &g_blkcache_streams[i];
+        }
+    }
+
+  stream->inode = inode;
+  stream->next  = sector + 1;
+  stream->stamp = g_blkcache_stamp;
+  return sequential;
+}
+
+#endif /* CONFIG_FS_BLKCACHE_READAHEAD */
+
+#ifdef BLKCACHE_ASYNC
+
+/****************************************************************************
+ * Name: blkcache_worker
+ *
+ * Description:
+ *   Perform the pending read ahead on the low priority work queue.
+ *
+ ****************************************************************************/
+
+static void blkcache_worker(FAR void *arg)
+{
+  ssize_t ret;
+
+  nxrmutex_lock(&g_blkcache_lock);
+
+  if (g_blkcache_rainode != NULL)
+    {
+      ret = blkcache_readrun(g_blkcache_rainode, g_blkcache_rastart,
+                             g_blkcache_rasize, CONFIG_FS_BLKCACHE_MAXRUN);
+      if (ret > 0)
+        {
+          g_blkcache_readaheads += ret;
+        }
+
+      g_blkcache_rainode = NULL;
+    }
+
+  nxrmutex_unlock(&g_blkcache_lock);
+}
+
+/****************************************************************************
+ * Name: blkcache_readahead
+ *
+ * Description:
+ *   Start reading the sectors that follow a sequential read in the
+ *   background once the reader has consumed half of the sectors that
+ *   have been read ahead.
+ *
+ ****************************************************************************/
+
+static void blkcache_readahead(FAR struct inode *inode, blkcnt_t sector,
+                               size_t sectsize)
+{
+  int i;
+
+  if (!work_available(&g_blkcache_work))
+    {
+      return;
+    }
+
+  for (i = 1; i <= (CONFIG_FS_BLKCACHE_MAXRUN + 1) / 2; i++)
+    {
+      if (blkcache_find(inode, sector + i) == NULL)
+        {
+          g_blkcache_rainode = inode;
+          g_blkcache_rastart = sector + i;
+          g_blkcache_rasize  = sectsize;
+          work_queue(LPWORK, &g_blkcache_work, blkcache_worker, NULL, 0);
+          break;
+        }
+    }
+}
+
+#endif /* BLKCACHE_ASYNC */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blkcache_read
+ *
+ * Description:
+ *   Read sectors from a block driver through the shared block cache.
+ *
+ ****************************************************************************/
+
+ssize_t blkcache_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                      blkcnt_t start, unsigned int nsectors,
+                      size_t sectsize)
+{
+  FAR struct blkcache_page_s *page;
+  bool sequential = false;
+  ssize_t ret;
+  int i;
+
+  DEBUGASSERT(inode != NULL && inode->u.i_bops->read != NULL);
+
+  if (sectsize == 0 || sectsize > CONFIG_FS_BLKCACHE_SECTSIZE)
+    {
+      g_blkcache_bypasses++;
+      return inode->u.i_bops->read(inode, buffer, start, nsectors);
+    }
+
+  nxrmutex_lock(&g_blkcache_lock);
+
+  if (nsectors == 1)
+    {
+#ifdef CONFIG_FS_BLKCACHE_READAHEAD
+      sequential = blkcache_sequential(inode, start);
+#endif
+
+      page = blkcache_find(inode, start);
+      if (page != NULL)
+        {
+          g_blkcache_hits++;
+          memcpy(buffer, page->data, sectsize);
+          blkcache_touch(page);
+
+#ifdef BLKCACHE_ASYNC
+          if (sequential)
+            {
+              blkcache_readahead(inode, start, sectsize);
+            }
+#endif
+
+          ret = 1;
+          goto out;
+        }
+
+      g_blkcache_misses++;
+
+      /* A sequential reader will ask for the following sectors next, so
+       * read them together with this one.  That may fail near the end of
+       * the media, then read just the one sector.
+       */
+
+      if (sequential)
+        {
+          ret = blkcache_readrun(inode, start, sectsize,
+                                 CONFIG_FS_BLKCACHE_MAXRUN);
+          if (ret > 1)
+            {
+              g_blkcache_readaheads += ret - 1;
+            }
+        }
+
+      page = blkcache_find(inode, start);
+      if (page == NULL)
+        {
+          ret = blkcache_readrun(inode, start, sectsize, 1);
+          page = blkcache_find(inode, start);
+        }
+
+      if (page != NULL)
+        {
+          memcpy(buffer, page->data, sectsize);
+          ret = 1;
+          goto out;
+        }
+      else if (ret < 0)
+        {
+          goto out;
+        }
+    }
+
+  /* Read longer runs of sectors directly into the caller's buffer, then
+   * replace the sectors that were not yet written back.
+   */
+
+  g_blkcache_bypasses++;
+
+  ret = inode->u.i_bops->read(inode, buffer, start, nsectors);
+  for (i = 0; ret > 0 && i < CONFIG_FS_BLKCACHE_NPAGES; i++)
+    {
+      page = &g_blkcache[i];
+      if (page->inode == inode && page->dirty &&
+          page->sector >= start && page->sector < start + ret)
+        {
+          memcpy(buffer + (page->sector - start) * sectsize, page->data,
+                 sectsize);
+        }
+    }
+
+out:
+  nxrmutex_unlock(&g_blkcache_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_write
+ *
+ * Description:
+ *   Write sectors to a block driver through the shared block cache.
+ *
+ ****************************************************************************/
+
+ssize_t blkcache_write(FAR struct inode *inode,
+                       FAR const unsigned char *buffer, blkcnt_t start,
+                       unsigned int nsectors, size_t sectsize)
+{
+  FAR struct blkcache_page_s *page;
+  ssize_t ret;
+  int i;
+
+  DEBUGASSERT(inode != NULL && inode->u.i_bops->write != NULL);
+
+  if (sectsize == 0 || sectsize > CONFIG_FS_BLKCACHE_SECTSIZE)
+    {
+      g_blkcache_bypasses++;
+      return inode->u.i_bops->write(inode, buffer, start, nsectors);
+    }
+
+  nxrmutex_lock(&g_blkcache_lock);
+
+  if (nsectors == 1)
+    {
+      page = blkcache_find(inode, start);
+      if (page != NULL)
+        {
+          g_blkcache_hits++;
+        }
+      else
+        {
+          g_blkcache_misses++;
+          page = blkcache_alloc();
+        }
+
+      if (page != NULL)
+        {
+          memcpy(page->data, buffer, sectsize);
+          page->inode    = inode;
+          page->sector   = start;
+          page->sectsize = sectsize;
+          page->dirty    = true;
+          blkcache_touch(page);
+          ret = 1;
+          goto out;
+        }
+    }
+
+  /* Write longer runs of sectors directly, then bring the cached copies up
+   * to date.  They are now in sync with the media.
+   */
+
+  g_blkcache_bypasses++;
+
+  ret = inode->u.i_bops->write(inode, buffer, start, nsectors);
+  for (i = 0; ret > 0 && i < CONFIG_FS_BLKCACHE_NPAGES; i++)
+    {
+      page = &g_blkcache[i];
+      if (page->inode == inode &&
+          page->sector >= start && page->sector < start + ret)
+        {
+          memcpy(page->data, buffer + (page->sector - start) * sectsize,
+                 sectsize);
+          page->dirty = false;
+        }
+    }
+
+out:
+  nxrmutex_unlock(&g_blkcache_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_flush
+ *
+ * Description:
+ *   Write back the dirty pages of a block driver, or of all block drivers
+ *   if inode is NULL.
+ *
+ ****************************************************************************/
+
+int blkcache_flush(FAR struct inode *inode)
+{
+  FAR struct blkcache_page_s *page;
+  int result = OK;
+  int ret;
+  int i;
+
+  nxrmutex_lock(&g_blkcache_lock);
+
+  for (i = 0; i < CONFIG_FS_BLKCACHE_NPAGES; i++)
+    {
+      page = &g_blkcache[i];
+      if (page->inode != NULL && page->dirty && !page->busy &&
+          (inode == NULL || page->inode == inode))
+        {
+          ret = blkcache_writeback(page);
+          if (ret < 0 && result == OK)
+            {
+              result = ret;
+            }
+        }
+    }
+
+  nxrmutex_unlock(&g_blkcache_lock);
+  return result;
+}
+
+/****************************************************************************
+ * Name: blkcache_invalidate
+ *
+ * Description:
+ *   Write back and then drop all pages of a block driver.
+ *
+ ****************************************************************************/
+
+int blkcache_invalidate(FAR struct inode *inode)
+{
+  int ret;
+  int i;
+
+  DEBUGASSERT(inode != NULL);
+
+  nxrmutex_lock(&g_blkcache_lock);
+
+  ret = blkcache_flush(inode);
+  for (i = 0; i < CONFIG_FS_BLKCACHE_NPAGES; i++)
+    {
+      if (g_blkcache[i].inode == inode)
+        {
+          g_blkcache[i].inode = NULL;
+          g_blkcache[i].dirty = false;
+        }
+    }
+
+#ifdef CONFIG_FS_BLKCACHE_READAHEAD
+  for (i = 0; i < BLKCACHE_NSTREAMS; i++)
+    {
+      if (g_blkcache_streams[i].inode == inode)
+        {
+          g_blkcache_streams[i].inode = NULL;
+        }
+    }
+#endif
+
+#ifdef BLKCACHE_ASYNC
+  /* Drop a pending read ahead, the worker ignores it then */
+
+  if (g_blkcache_rainode == inode)
+    {
+      g_blkcache_rainode = NULL;
+    }
+#endif
+
+  nxrmutex_unlock(&g_blkcache_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_stats
+ *
+ * Description:
+ *   Return a snapshot of the counters of the block cache.
+ *
+ ****************************************************************************/
+
+void blkcache_stats(FAR struct blkcache_stats_s *stats)
+{
+  int i;
+
+  memset(stats, 0, sizeof(struct blkcache_stats_s));
+
+  nxrmutex_lock(&g_blkcache_lock);
+
+  stats->hits       = g_blkcache_hits;
+  stats->misses     = g_blkcache_misses;
+  stats->writebacks = g_blkcache_writebacks;
+  stats->bypasses   = g_blkcache_bypasses;
+  stats->readaheads = g_blkcache_readaheads;
+  stats->npages     = CONFIG_FS_BLKCACHE_NPAGES;
+  stats->pagesize   = CONFIG_FS_BLKCACHE_SECTSIZE;
+
+  for (i = 0; i < CONFIG_FS_BLKCACHE_NPAGES; i++)
+    {
+      if (g_blkcache[i].inode != NULL)
+        {
+          stats->nused++;
+          if (g_blkcache[i].dirty)
+            {
+              stats->ndirty++;
+            }
+        }
+    }
+
+  nxrmutex_unlock(&g_blkcache_lock);
+}
+
+#endif /* CONFIG_FS_BLKCACHE */
@@ -109,6 +109,34 @@ errout_with_search:
   return ret;
 }
 
+/****************************************************************************
+ * Name: close_mtddriver
+ *
+ * Description:
+ *   Release the inode reference returned by find_mtddriver
+ *
+ * Input Parameters:
+ *   inode - reference to the inode of an MTD driver found by
+ *           find_mtddriver
+ *
+ * Returned Value:
+ *   Returns zero on success or a negated errno on failure:
+ *
+ *   EINVAL  - inode is NULL
+ *
+ ****************************************************************************/
+
+int close_mtddriver(FAR struct inode *inode)
+{
+  if (inode == NULL)
+    {
+      return -EINVAL;
+    }
+
+  inode_release(inode);
+  return OK;
+}
+
 #else
 
 int find_mtddriver(FAR const char *pathname, FAR struct inode **ppinode)
@@ -116,4 +144,9 @@ int find_mtddriver(FAR const char *pathname, FAR struct inode **ppinode)
   return -ENODEV;
 }
 
+int close_mtddriver(FAR struct inode *inode)
+{
+  return -ENODEV;
+}
+
 #endif /* CONFIG_MTD */
@@ -41,6 +41,7 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
 #include <nuttx/fs/dirent.h>
+#include <nuttx/fs/blkcache.h>
 
 #include "inode/inode.h"
 #include "fs_fat32.h"
@@ -602,12 +603,19 @@ fat_read_restart:
            *
            * Limit the number of sectors that we read on this time
            * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * in this cluster and in the clusters following it on the
+           * media.
            */
 
           if (nsectors > ff->ff_sectorsincluster)
             {
-              nsectors = ff->ff_sectorsincluster;
+              ret = fat_clusterrun(fs, ff, nsectors, false);
+              if (ret < 0)
+                {
+                  goto errout_with_semaphore;
+                }
+
+              nsectors = ret;
             }
 
           /* We are not sure of the state of the file buffer so
@@ -867,12 +875,19 @@ fat_write_restart:
            *
            * Limit the number of sectors that we write on this time
            * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * in this cluster and in the clusters following it on the
+           * media, allocating them as necessary.
            */
 
           if (nsectors > ff->ff_sectorsincluster)
             {
-              nsectors = ff->ff_sectorsincluster;
+              ret = fat_clusterrun(fs, ff, nsectors, true);
+              if (ret < 0)
+                {
+                  goto errout_with_semaphore;
+                }
+
+              nsectors = ret;
             }
 
           /* We are not sure of the state of the sector cache so the
@@ -1438,6 +1453,15 @@ static int fat_sync(FAR struct file *filep)
       ret          = fat_updatefsinfo(fs);
     }
 
+  /* Write back the sectors of the volume that are held in the block
+   * cache.
+   */
+
+  if (ret >= 0)
+    {
+      ret = blkcache_flush(fs->fs_blkdriver);
+    }
+
 errout_with_semaphore:
   fat_semgive(fs);
   return ret;
@@ -2248,6 +2272,8 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       FAR struct inode *inode = fs->fs_blkdriver;
       if (inode)
         {
+          blkcache_invalidate(inode);
+
           if (inode->u.i_bops && inode->u.i_bops->close)
             {
               inode->u.i_bops->close(inode);
@@ -2273,6 +2299,21 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
     }
 
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  if (fs->fs_fatbuffer)
+    {
+      fat_io_free(fs->fs_fatbuffer,
+                  CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+    }
+#endif
+
+#ifdef CONFIG_FAT_FREEMAP
+  if (fs->fs_freemap)
+    {
+      kmm_free(fs->fs_freemap);
+    }
+#endif
+
   nxsem_destroy(&fs->fs_sem);
   kmm_free(fs);
   return OK;
@@ -840,6 +840,32 @@
  *
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: fat_fatcachedirty
+ *
+ * Description:
+ *   Mark a FAT sector returned by fat_fatcacheread() as modified.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+#  define fat_fatcachedirty(fs,s) \
+     ((fs)->fs_fatcachedirty |= (uint32_t)1 << ((s) - (fs)->fs_fatcachebase))
+#else
+#  define fat_fatcachedirty(fs,s) ((fs)->fs_dirty = true)
+#endif
+
+/* Access to the free cluster bitmap */
+
+#ifdef CONFIG_FAT_FREEMAP
+#  define FAT_FREEMAP_ISSET(fs,c) \
+     (((fs)->fs_freemap[(c) >> 3] & (1 << ((c) & 7))) != 0)
+#  define FAT_FREEMAP_SET(fs,c) \
+     ((fs)->fs_freemap[(c) >> 3] |= (1 << ((c) & 7)))
+#  define FAT_FREEMAP_CLR(fs,c) \
+     ((fs)->fs_freemap[(c) >> 3] &= ~(1 << ((c) & 7)))
+#endif
+
 #ifdef CONFIG_FAT_DMAMEMORY
 #  define fat_io_alloc(s)  fat_dma_alloc(s)
 #  define fat_io_free(m,s) fat_dma_free(m,s)
@@ -886,6 +912,17 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  off_t    fs_fatcachebase;        /* First FAT sector held in fs_fatbuffer */
+  uint32_t fs_fatcachedirty;       /* Bit n set: Sector fs_fatcachebase + n is
+                                    * dirty */
+  uint8_t  fs_fatcachesects;       /* Number of sectors held in fs_fatbuffer */
+  uint8_t *fs_fatbuffer;           /* Allocated buffer holding a window of
+                                    * consecutive FAT sectors */
+#endif
+#ifdef CONFIG_FAT_FREEMAP
+  uint8_t *fs_freemap;             /* Bit n set: Cluster n is in use */
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -898,7 +935,7 @@ struct fat_file_s
   struct fat_file_s *ff_next;      /* Retained in a singly linked list */
   uint8_t  ff_bflags;              /* The file buffer/mount flags */
   uint8_t  ff_oflags;              /* Flags provided when file was opened */
-  uint8_t  ff_sectorsincluster;    /* Sectors remaining in cluster */
+  uint16_t ff_sectorsincluster;    /* Sectors remaining in cluster */
   uint16_t ff_dirindex;            /* Index into ff_dirsector to directory entry */
   uint32_t ff_currentcluster;      /* Current cluster being accessed */
   off_t    ff_dirsector;           /* Sector containing the directory entry */
@@ -1033,6 +1070,9 @@ EXTERN int    fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                              off_t startsector);
 EXTERN int    fat_removechain(struct fat_mountpt_s *fs, uint32_t cluster);
 EXTERN int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster);
+EXTERN int    fat_clusterrun(struct fat_mountpt_s *fs,
+                             struct fat_file_s *ff, unsigned int nsectors,
+                             bool extend);
 
 #define fat_createchain(fs) fat_extendchain(fs, 0)
 
@@ -1079,6 +1119,12 @@ EXTERN int    fat_ffcacheread(struct fat_mountpt_s *fs,
 EXTERN int    fat_ffcacheinvalidate(struct fat_mountpt_s *fs,
                                     struct fat_file_s *ff);
 
+/* FAT sector cache */
+
+EXTERN int    fat_fatcacheflush(struct fat_mountpt_s *fs);
+EXTERN int    fat_fatcacheread(struct fat_mountpt_s *fs, off_t sector,
+                               FAR uint8_t **buffer);
+
 /* FSINFO sector support */
 
 EXTERN int    fat_updatefsinfo(struct fat_mountpt_s *fs);
@@ -38,6 +38,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
+#include <nuttx/fs/blkcache.h>
 
 #include "inode/inode.h"
 #include "fs_fat32.h"
@@ -263,6 +264,113 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+#ifdef CONFIG_FAT_FREEMAP
+
+/****************************************************************************
+ * Name: fat_buildfreemap
+ *
+ * Description:
+ *   Allocate the free cluster bitmap of a volume, fill it from the FAT and
+ *   update the count of free clusters.  The volume is used without the
+ *   bitmap if it cannot be built.
+ *
+ ****************************************************************************/
+
+static void fat_buildfreemap(struct fat_mountpt_s *fs)
+{
+  uint32_t nfreeclusters = 0;
+  uint32_t cluster;
+  off_t    next;
+
+  fs->fs_freemap = kmm_zalloc((fs->fs_nclusters + 7) / 8);
+  if (fs->fs_freemap == NULL)
+    {
+      fwarn("WARNING: No memory for the free cluster bitmap\n");
+      return;
+    }
+
+  /* Clusters 0 and 1 do not exist */
+
+  FAT_FREEMAP_SET(fs, 0);
+  FAT_FREEMAP_SET(fs, 1);
+
+  for (cluster = 2; cluster < fs->fs_nclusters; cluster++)
+    {
+      next = fat_getcluster(fs, cluster);
+      if (next < 0)
+        {
+          ferr("ERROR: Failed to read the FAT: %d\n", (int)next);
+          kmm_free(fs->fs_freemap);
+          fs->fs_freemap = NULL;
+          return;
+        }
+      else if (next != 0)
+        {
+          FAT_FREEMAP_SET(fs, cluster);
+        }
+      else
+        {
+          nfreeclusters++;
+        }
+    }
+
+  /* The count is exact now, correct the FSINFO hint if necessary */
+
+  if (fs->fs_fsifreecount != nfreeclusters)
+    {
+      fs->fs_fsifreecount = nfreeclusters;
+      if (fs->fs_type == FSTYPE_FAT32)
+        {
+          fs->fs_fsidirty = true;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fat_freemapsearch
+ *
+ * Description:
+ *   Find the first cluster after 'cluster' that the free cluster bitmap
+ *   shows as free, wrapping around at the end of the volume.
+ *
+ * Returned Value:
+ *   The free cluster number, or 0 if there is no free cluster.
+ *
+ ****************************************************************************/
+
+static uint32_t fat_freemapsearch(struct fat_mountpt_s *fs,
+                                  uint32_t cluster)
+{
+  uint32_t n;
+
+  for (n = 2; n < fs->fs_nclusters; n++)
+    {
+      if (++cluster >= fs->fs_nclusters)
+        {
+          cluster = 2;
+        }
+
+      /* Skip eight clusters at a time while they are all in use */
+
+      if ((cluster & 7) == 0 && cluster + 8 <= fs->fs_nclusters &&
+          fs->fs_freemap[cluster >> 3] == 0xff)
+        {
+          cluster += 7;
+          n       += 7;
+          continue;
+        }
+
+      if (!FAT_FREEMAP_ISSET(fs, cluster))
+        {
+          return cluster;
+        }
+    }
+
+  return 0;
+}
+
+#endif /* CONFIG_FAT_FREEMAP */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -531,6 +639,20 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
       goto errout;
     }
 
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  /* And a buffer to hold a window of FAT sectors */
+
+  fs->fs_fatcachesects = 0;
+  fs->fs_fatcachedirty = 0;
+  fs->fs_fatbuffer     = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+  if (!fs->fs_fatbuffer)
+    {
+      ret = -ENOMEM;
+      goto errout_with_buffer;
+    }
+#endif
+
   /* Search FAT boot record on the drive.  First check the MBR at sector
    * zero.  This could be either the boot record or a partition that refers
    * to the boot record.
@@ -647,6 +769,12 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
     }
 #endif
 
+#ifdef CONFIG_FAT_FREEMAP
+  /* Record which clusters are free */
+
+  fat_buildfreemap(fs);
+#endif
+
   /* We did it! */
 
   finfo("FAT%d:\n", fs->fs_type == 0 ? 12 : fs->fs_type == 1  ? 16 : 32);
@@ -669,6 +797,15 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  if (fs->fs_fatbuffer)
+    {
+      fat_io_free(fs->fs_fatbuffer,
+                  CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+      fs->fs_fatbuffer = NULL;
+    }
+
+#endif
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = 0;
 
@@ -739,8 +876,9 @@ int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
       struct inode *inode = fs->fs_blkdriver;
       if (inode && inode->u.i_bops && inode->u.i_bops->read)
         {
-          ssize_t nsectorsread = inode->u.i_bops->read(inode, buffer,
-                                                       sector, nsectors);
+          ssize_t nsectorsread = blkcache_read(inode, buffer, sector,
+                                               nsectors,
+                                               fs->fs_hwsectorsize);
           if (nsectorsread == nsectors)
             {
               ret = OK;
@@ -773,7 +911,8 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
       if (inode && inode->u.i_bops && inode->u.i_bops->write)
         {
           ssize_t nsectorswritten =
-              inode->u.i_bops->write(inode, buffer, sector, nsectors);
+              blkcache_write(inode, buffer, sector, nsectors,
+                             fs->fs_hwsectorsize);
 
           if (nsectorswritten == nsectors)
             {
@@ -833,6 +972,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
         {
           case FSTYPE_FAT12 :
             {
+              FAR uint8_t  *buffer;
               off_t        fatsector;
               unsigned int fatoffset;
               unsigned int cluster;
@@ -847,7 +987,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
 
               /* Read the sector at this offset */
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, &buffer) < 0)
                 {
                   /* Read error */
 
@@ -857,7 +997,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               /* Get the first, LS byte of the cluster from the FAT */
 
               fatindex = fatoffset & SEC_NDXMASK(fs);
-              cluster  = fs->fs_buffer[fatindex];
+              cluster  = buffer[fatindex];
 
               /* With FAT12, the second byte of the cluster number may lie in
                * a different sector than the first byte.
@@ -869,7 +1009,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                   fatsector++;
                   fatindex = 0;
 
-                  if (fat_fscacheread(fs, fatsector) < 0)
+                  if (fat_fatcacheread(fs, fatsector, &buffer) < 0)
                     {
                       /* Read error */
 
@@ -882,7 +1022,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                * on the fact that the byte stream is little-endian.
                */
 
-              cluster |= (unsigned int)fs->fs_buffer[fatindex] << 8;
+              cluster |= (unsigned int)buffer[fatindex] << 8;
 
               /* Now, pick out the correct 12 bit cluster start sector
                * value.
@@ -910,15 +1050,16 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t  *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, &buffer) < 0)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              return FAT_GETFAT16(fs->fs_buffer, fatindex);
+              return FAT_GETFAT16(buffer, fatindex);
             }
 
           case FSTYPE_FAT32 :
@@ -927,15 +1068,16 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t  *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, &buffer) < 0)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              return FAT_GETFAT32(fs->fs_buffer, fatindex) & 0x0fffffff;
+              return FAT_GETFAT32(buffer, fatindex) & 0x0fffffff;
             }
 
           default:
@@ -973,6 +1115,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
         {
           case FSTYPE_FAT12 :
             {
+              FAR uint8_t  *buffer;
               off_t        fatsector;
               unsigned int fatoffset;
               unsigned int fatindex;
@@ -987,11 +1130,11 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
 
               /* Make sure that the sector at this offset is in the cache */
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, &buffer) < 0)
                 {
                   /* Read error */
 
-                  break;
+                  return -EIO;
                 }
 
               /* Get the LS byte first handling the 12-bit alignment within
@@ -1003,7 +1146,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                 {
                   /* Save the LS four bits of the next cluster */
 
-                  value = (fs->fs_buffer[fatindex] & 0x0f) |
+                  value = (buffer[fatindex] & 0x0f) |
                            nextcluster << 4;
                 }
               else
@@ -1013,7 +1156,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                   value = (uint8_t)nextcluster;
                 }
 
-              fs->fs_buffer[fatindex] = value;
+              buffer[fatindex] = value;
 
               /* With FAT12, the second byte of the cluster number may lie in
                * a different sector than the first byte.
@@ -1031,12 +1174,12 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                    * just modified is written out.
                    */
 
-                  fs->fs_dirty = true;
-                  if (fat_fscacheread(fs, fatsector) < 0)
+                  fat_fatcachedirty(fs, fatsector);
+                  if (fat_fatcacheread(fs, fatsector, &buffer) < 0)
                     {
                       /* Read error */
 
-                      break;
+                      return -EIO;
                     }
                 }
 
@@ -1054,11 +1197,12 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                 {
                   /* Save the MS four bits of the next cluster */
 
-                  value = (fs->fs_buffer[fatindex] & 0xf0) |
+                  value = (buffer[fatindex] & 0xf0) |
                           ((nextcluster >> 8) & 0x0f);
                 }
 
-              fs->fs_buffer[fatindex] = value;
+              buffer[fatindex] = value;
+              fat_fatcachedirty(fs, fatsector);
             }
           break;
 
@@ -1068,15 +1212,17 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t  *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, &buffer) < 0)
                 {
                   /* Read error */
 
-                  break;
+                  return -EIO;
                 }
 
-              FAT_PUTFAT16(fs->fs_buffer, fatindex, nextcluster & 0xffff);
+              FAT_PUTFAT16(buffer, fatindex, nextcluster & 0xffff);
+              fat_fatcachedirty(fs, fatsector);
             }
           break;
 
@@ -1086,20 +1232,22 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t  *buffer;
               uint32_t     val;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, &buffer) < 0)
                 {
                   /* Read error */
 
-                  break;
+                  return -EIO;
                 }
 
               /* Keep the top 4 bits */
 
-              val = FAT_GETFAT32(fs->fs_buffer, fatindex) & 0xf0000000;
-              FAT_PUTFAT32(fs->fs_buffer, fatindex,
+              val = FAT_GETFAT32(buffer, fatindex) & 0xf0000000;
+              FAT_PUTFAT32(buffer, fatindex,
                            val | (nextcluster & 0x0fffffff));
+              fat_fatcachedirty(fs, fatsector);
             }
           break;
 
@@ -1107,9 +1255,22 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
             return -EINVAL;
         }
 
-      /* Mark the modified sector as "dirty" and return success */
+#ifdef CONFIG_FAT_FREEMAP
+      /* Keep the free cluster bitmap in sync with the FAT */
+
+      if (fs->fs_freemap != NULL && clusterno >= 2)
+        {
+          if (nextcluster != 0)
+            {
+              FAT_FREEMAP_SET(fs, clusterno);
+            }
+          else
+            {
+              FAT_FREEMAP_CLR(fs, clusterno);
+            }
+        }
+#endif
 
-      fs->fs_dirty = true;
       return OK;
     }
 
@@ -1233,6 +1394,38 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
       startcluster = cluster;
     }
 
+#ifdef CONFIG_FAT_FREEMAP
+  /* Look the free cluster up in the bitmap if there is one.  The FAT is
+   * checked anyway, a cluster that is found not to be free is marked in
+   * the bitmap and the search goes on.
+   */
+
+  if (fs->fs_freemap != NULL)
+    {
+      newcluster = startcluster;
+      for (; ; )
+        {
+          newcluster = fat_freemapsearch(fs, newcluster);
+          if (newcluster == 0)
+            {
+              return 0;
+            }
+
+          startsector = fat_getcluster(fs, newcluster);
+          if (startsector == 0)
+            {
+              goto found;
+            }
+          else if (startsector < 0)
+            {
+              return startsector;
+            }
+
+          FAT_FREEMAP_SET(fs, newcluster);
+        }
+    }
+#endif
+
   /* Loop until (1) we discover that there are not free clusters
    * (return 0), an errors occurs (return -errno), or (3) we find
    * the next cluster (return the new cluster number).
@@ -1295,6 +1488,9 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
    * number in 'newcluster'  Now mark that cluster as in-use.
    */
 
+#ifdef CONFIG_FAT_FREEMAP
+found:
+#endif
   ret = fat_putcluster(fs, newcluster, 0x0fffffff);
   if (ret < 0)
     {
@@ -1330,6 +1526,72 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
   return newcluster;
 }
 
+/****************************************************************************
+ * Name: fat_clusterrun
+ *
+ * Description:
+ *   Extend the run of sectors that starts at the current sector of a file
+ *   over the following clusters of its chain as long as they are
+ *   contiguous on the media, so that the run can be transferred at once.
+ *   On return, ff_currentcluster is the last cluster of the run and
+ *   ff_sectorsincluster counts the sectors from ff_currentsector to the
+ *   end of that cluster.
+ *
+ * Input Parameters:
+ *   fs       - The mountpoint
+ *   ff       - The open file
+ *   nsectors - The number of sectors that the caller wants to transfer
+ *   extend   - True: Allocate clusters at the end of the chain (write)
+ *
+ * Returned Value:
+ *   The number of sectors in the run, at most nsectors, or a negated
+ *   errno value.
+ *
+ ****************************************************************************/
+
+int fat_clusterrun(struct fat_mountpt_s *fs, struct fat_file_s *ff,
+                   unsigned int nsectors, bool extend)
+{
+  off_t next;
+
+  while (ff->ff_sectorsincluster < nsectors &&
+         ff->ff_sectorsincluster + fs->fs_fatsecperclus <= UINT16_MAX)
+    {
+      if (extend)
+        {
+          next = fat_extendchain(fs, ff->ff_currentcluster);
+        }
+      else
+        {
+          next = fat_getcluster(fs, ff->ff_currentcluster);
+        }
+
+      if (next < 0)
+        {
+          return next;
+        }
+
+      /* A new cluster that is not adjacent remains linked to the chain
+       * and is used by the next transfer.
+       */
+
+      if (next != ff->ff_currentcluster + 1)
+        {
+          break;
+        }
+
+      ff->ff_currentcluster    = next;
+      ff->ff_sectorsincluster += fs->fs_fatsecperclus;
+    }
+
+  if (nsectors > ff->ff_sectorsincluster)
+    {
+      nsectors = ff->ff_sectorsincluster;
+    }
+
+  return nsectors;
+}
+
 /****************************************************************************
  * Name: fat_nextdirentry
  *
@@ -1865,6 +2127,134 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_fatcacheflush
+ *
+ * Description:
+ *   Write back the modified sectors of the FAT sector cache to all copies
+ *   of the FAT.
+ *
+ ****************************************************************************/
+
+int fat_fatcacheflush(struct fat_mountpt_s *fs)
+{
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  unsigned int first;
+  unsigned int last;
+  off_t sector;
+  int ret;
+  int i;
+
+  if (fs->fs_fatcachedirty == 0)
+    {
+      return OK;
+    }
+
+  /* Write the span of modified sectors in one transfer per FAT copy */
+
+  first = 0;
+  while ((fs->fs_fatcachedirty & ((uint32_t)1 << first)) == 0)
+    {
+      first++;
+    }
+
+  last = fs->fs_fatcachesects - 1;
+  while ((fs->fs_fatcachedirty & ((uint32_t)1 << last)) == 0)
+    {
+      last--;
+    }
+
+  sector = fs->fs_fatcachebase + first;
+  for (i = 0; i < fs->fs_fatnumfats; i++)
+    {
+      ret = fat_hwwrite(fs, fs->fs_fatbuffer + first * fs->fs_hwsectorsize,
+                        sector, last - first + 1);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      sector += fs->fs_nfatsects;
+    }
+
+  fs->fs_fatcachedirty = 0;
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fatcacheread
+ *
+ * Description:
+ *   Make sure that a FAT sector is cached and return a pointer to it.  The
+ *   FAT sector cache holds a window of consecutive FAT sectors that is read
+ *   in one transfer.  Changes must be marked with fat_fatcachedirty() and
+ *   are written back when the window moves or by fat_fatcacheflush().
+ *
+ ****************************************************************************/
+
+int fat_fatcacheread(struct fat_mountpt_s *fs, off_t sector,
+                     FAR uint8_t **buffer)
+{
+  int ret;
+
+#if CONFIG_FAT_FATCACHE_NSECTORS > 0
+  off_t fatend = fs->fs_fatbase + fs->fs_nfatsects;
+  off_t base   = fs->fs_fatcachebase;
+  unsigned int nsectors;
+
+  if (sector < fs->fs_fatbase || sector >= fatend)
+    {
+      return -EINVAL;
+    }
+
+  if (fs->fs_fatcachesects == 0 || sector < base ||
+      sector >= base + fs->fs_fatcachesects)
+    {
+      ret = fat_fatcacheflush(fs);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Read the aligned window that holds the sector, which ends with the
+       * last sector of the first FAT.
+       */
+
+      base = fs->fs_fatbase + (sector - fs->fs_fatbase) /
+             CONFIG_FAT_FATCACHE_NSECTORS * CONFIG_FAT_FATCACHE_NSECTORS;
+      nsectors = CONFIG_FAT_FATCACHE_NSECTORS;
+      if (base + nsectors > fatend)
+        {
+          nsectors = fatend - base;
+        }
+
+      fs->fs_fatcachesects = 0;
+      ret = fat_hwread(fs, fs->fs_fatbuffer, base, nsectors);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      fs->fs_fatcachebase  = base;
+      fs->fs_fatcachesects = nsectors;
+    }
+
+  *buffer = fs->fs_fatbuffer + (sector - base) * fs->fs_hwsectorsize;
+#else
+  ret = fat_fscacheread(fs, sector);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  *buffer = fs->fs_buffer;
+#endif
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: fat_ffcacheflush
  *
@@ -1995,9 +2385,14 @@ int fat_updatefsinfo(struct fat_mountpt_s *fs)
 {
   int ret;
 
-  /* Flush the fs_buffer if it is dirty */
+  /* Flush the FAT sector cache and the fs_buffer if they are dirty */
+
+  ret = fat_fatcacheflush(fs);
+  if (ret == OK)
+    {
+      ret = fat_fscacheflush(fs);
+    }
 
-  ret = fat_fscacheflush(fs);
   if (ret == OK)
     {
       /* The FSINFO sector only has to be update for the case of a FAT32 file
@@ -2065,6 +2460,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
     }
   else
     {
+      FAR uint8_t  *buffer = NULL;
       unsigned int cluster;
       off_t        fatsector;
       unsigned int offset;
@@ -2077,13 +2473,13 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
 
       for (cluster = fs->fs_nclusters; cluster > 0; cluster--)
         {
-          /* If we are starting a new sector, then read the new sector in
-           * fs_buffer
+          /* If we are starting a new sector, then read the new sector
+           * into the FAT sector cache
            */
 
           if (offset >= fs->fs_hwsectorsize)
             {
-              ret = fat_fscacheread(fs, fatsector);
+              ret = fat_fatcacheread(fs, fatsector, &buffer);
               if (ret < 0)
                 {
                   return ret;
@@ -2103,7 +2499,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
 
           if (fs->fs_type == FSTYPE_FAT16)
             {
-              if (FAT_GETFAT16(fs->fs_buffer, offset) == 0)
+              if (FAT_GETFAT16(buffer, offset) == 0)
                 {
                   nfreeclusters++;
                 }
@@ -2112,7 +2508,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
             }
           else
             {
-              if (FAT_GETFAT32(fs->fs_buffer, offset) == 0)
+              if (FAT_GETFAT32(buffer, offset) == 0)
                 {
                   nfreeclusters++;
                 }
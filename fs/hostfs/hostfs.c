@@ -51,6 +51,10 @@
 
 #define HOSTFS_RETRY_DELAY_MS       10
 
+#ifdef CONFIG_FS_HOSTFS_RWBUFFER
+#  define HOSTFS_BUFSIZE            CONFIG_FS_HOSTFS_RWBUFFER_SIZE
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -239,6 +243,385 @@ static void hostfs_mkpath(FAR struct hostfs_mountpt_s  *fs,
     }
 }
 
+/****************************************************************************
+ * Name: hostfs_bufflush
+ *
+ * Description:
+ *   Write any buffered data to the host, or, if the buffer only holds read
+ *   ahead data, move the host file position back to the file position.
+ *   The buffer is empty on return.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_HOSTFS_RWBUFFER
+static int hostfs_bufflush(FAR const struct file *filep,
+                           FAR struct hostfs_ofile_s *hf)
+{
+  size_t nwritten;
+  ssize_t nbytes;
+  off_t pos;
+
+  if (hf->buflen == 0)
+    {
+      return OK;
+    }
+
+  if (hf->bufdirty)
+    {
+      for (nwritten = 0; nwritten < hf->buflen; nwritten += nbytes)
+        {
+          nbytes = host_write(hf->fd, &hf->buf[nwritten],
+                              hf->buflen - nwritten);
+          if (nbytes <= 0)
+            {
+              return nbytes < 0 ? nbytes : -EIO;
+            }
+        }
+
+      hf->bufdirty = false;
+    }
+  else
+    {
+      pos = host_lseek(hf->fd, filep->f_pos, SEEK_SET);
+      if (pos < 0)
+        {
+          return pos;
+        }
+    }
+
+  hf->buflen = 0;
+  return OK;
+}
+#else
+#  define hostfs_bufflush(filep, hf) (OK)
+#endif
+
+/****************************************************************************
+ * Name: hostfs_bufusable
+ *
+ * Description:
+ *   Return true if transfers of the open file may go through the transfer
+ *   buffer, allocating the buffer on first use.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_HOSTFS_RWBUFFER
+static bool hostfs_bufusable(FAR struct hostfs_ofile_s *hf)
+{
+  if ((hf->oflags & (O_SYNC | O_DIRECT)) != 0)
+    {
+      return false;
+    }
+
+  if (hf->buf == NULL)
+    {
+      hf->buf = (FAR char *)kmm_malloc(HOSTFS_BUFSIZE);
+    }
+
+  return hf->buf != NULL;
+}
+
+/****************************************************************************
+ * Name: hostfs_bufread
+ *
+ * Description:
+ *   Satisfy a read from the transfer buffer, refilling it with one large
+ *   host read when it runs dry.  Reads of at least a buffer size go
+ *   directly to the caller's buffer.
+ *
+ ****************************************************************************/
+
+static ssize_t hostfs_bufread(FAR struct file *filep,
+                              FAR struct hostfs_ofile_s *hf,
+                              FAR char *buffer, size_t buflen)
+{
+  ssize_t nread = 0;
+  ssize_t ret;
+  size_t skip;
+  size_t n;
+
+  /* Dirty data or read ahead data that does not contain the file position
+   * must go first.
+   */
+
+  if (hf->bufdirty || filep->f_pos < hf->bufpos ||
+      filep->f_pos > hf->bufpos + (off_t)hf->buflen)
+    {
+      ret = hostfs_bufflush(filep, hf);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  while (buflen > 0)
+    {
+      skip = filep->f_pos - hf->bufpos;
+      if (hf->buflen > 0 && skip < hf->buflen)
+        {
+          n = hf->buflen - skip;
+          if (n > buflen)
+            {
+              n = buflen;
+            }
+
+          memcpy(buffer, &hf->buf[skip], n);
+          filep->f_pos += n;
+          buffer       += n;
+          buflen       -= n;
+          nread        += n;
+          continue;
+        }
+
+      /* The buffer is exhausted and the host file position equals the
+       * file position.
+       */
+
+      hf->buflen = 0;
+      if (buflen >= HOSTFS_BUFSIZE)
+        {
+          ret = host_read(hf->fd, buffer, buflen);
+          if (ret > 0)
+            {
+              filep->f_pos += ret;
+              nread        += ret;
+            }
+          else if (ret < 0 && nread == 0)
+            {
+              return ret;
+            }
+
+          break;
+        }
+
+      ret = host_read(hf->fd, hf->buf, HOSTFS_BUFSIZE);
+      if (ret <= 0)
+        {
+          if (ret < 0 && nread == 0)
+            {
+              return ret;
+            }
+
+          break;
+        }
+
+      hf->bufpos = filep->f_pos;
+      hf->buflen = ret;
+    }
+
+  return nread;
+}
+
+/****************************************************************************
+ * Name: hostfs_bufwrite
+ *
+ * Description:
+ *   Gather a small write in the transfer buffer.  The buffer is written to
+ *   the host when it fills, when the file position moves elsewhere, or
+ *   when the file is synchronized or closed.
+ *
+ ****************************************************************************/
+
+static ssize_t hostfs_bufwrite(FAR struct file *filep,
+                               FAR struct hostfs_ofile_s *hf,
+                               FAR const char *buffer, size_t buflen)
+{
+  ssize_t ret;
+
+  if (hf->buflen > 0 &&
+      (!hf->bufdirty || filep->f_pos != hf->bufpos + (off_t)hf->buflen ||
+       hf->buflen + buflen > HOSTFS_BUFSIZE))
+    {
+      ret = hostfs_bufflush(filep, hf);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (buflen >= HOSTFS_BUFSIZE)
+    {
+      ret = host_write(hf->fd, buffer, buflen);
+      if (ret > 0)
+        {
+          filep->f_pos += ret;
+        }
+
+      return ret;
+    }
+
+  if (hf->buflen == 0)
+    {
+      hf->bufpos   = filep->f_pos;
+      hf->bufdirty = true;
+    }
+
+  memcpy(&hf->buf[hf->buflen], buffer, buflen);
+  hf->buflen   += buflen;
+  filep->f_pos += buflen;
+  return buflen;
+}
+#endif /* CONFIG_FS_HOSTFS_RWBUFFER */
+
+/****************************************************************************
+ * Name: hostfs_statcache_find
+ *
+ * Description:
+ *   Look up the attributes of a host path in the attribute cache.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_HOSTFS_STATCACHE
+static bool hostfs_statcache_find(FAR struct hostfs_mountpt_s *fs,
+                                  FAR const char *path,
+                                  FAR struct stat *buf, FAR int *ret)
+{
+  FAR struct hostfs_statcache_s *entry;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0; i < CONFIG_FS_HOSTFS_STATCACHE_NENTRIES; i++)
+    {
+      entry = &fs->fs_stats[i];
+      if (entry->path[0] != '\0' && strcmp(entry->path, path) == 0)
+        {
+          if ((sclock_t)(entry->expires - now) <= 0)
+            {
+              entry->path[0] = '\0';
+              return false;
+            }
+
+          memcpy(buf, &entry->buf, sizeof(struct stat));
+          *ret = entry->ret;
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: hostfs_statcache_add
+ *
+ * Description:
+ *   Remember the result of host_stat() for a host path.
+ *
+ ****************************************************************************/
+
+static void hostfs_statcache_add(FAR struct hostfs_mountpt_s *fs,
+                                 FAR const char *path,
+                                 FAR const struct stat *buf, int ret)
+{
+  FAR struct hostfs_statcache_s *entry;
+
+  /* Only cache the answers that are a property of the path */
+
+  if (ret < 0 && ret != -ENOENT)
+    {
+      return;
+    }
+
+  entry = &fs->fs_stats[fs->fs_statnext];
+  if (++fs->fs_statnext >= CONFIG_FS_HOSTFS_STATCACHE_NENTRIES)
+    {
+      fs->fs_statnext = 0;
+    }
+
+  strlcpy(entry->path, path, sizeof(entry->path));
+  memcpy(&entry->buf, buf, sizeof(struct stat));
+  entry->ret     = ret;
+  entry->expires = clock_systime_ticks() +
+                   MSEC2TICK(CONFIG_FS_HOSTFS_STATCACHE_TIMEOUT);
+}
+
+/****************************************************************************
+ * Name: hostfs_statcache_flush
+ *
+ * Description:
+ *   Forget all cached attributes.  Called whenever this mount changes the
+ *   host file system.
+ *
+ ****************************************************************************/
+
+static void hostfs_statcache_flush(FAR struct hostfs_mountpt_s *fs)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_HOSTFS_STATCACHE_NENTRIES; i++)
+    {
+      fs->fs_stats[i].path[0] = '\0';
+    }
+}
+#else
+#  define hostfs_statcache_flush(fs)
+#endif
+
+/****************************************************************************
+ * Name: hostfs_mmap
+ *
+ * Description:
+ *   Map a file that was opened read-only into memory on the host and
+ *   return the address of the mapping.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_HOSTFS_MMAP
+static int hostfs_mmap(FAR struct hostfs_mountpt_s *fs,
+                       FAR struct hostfs_ofile_s *hf, FAR void **ppv)
+{
+  FAR struct hostfs_mmap_s *map;
+  struct stat buf;
+  int ret;
+
+  if (ppv == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* A private read-only host mapping cannot reflect writes */
+
+  if ((hf->oflags & O_WROK) != 0)
+    {
+      return -EACCES;
+    }
+
+  if (hf->mapaddr == NULL)
+    {
+      ret = host_fstat(hf->fd, &buf);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (!S_ISREG(buf.st_mode) || buf.st_size <= 0)
+        {
+          return -EINVAL;
+        }
+
+      map = (FAR struct hostfs_mmap_s *)kmm_malloc(sizeof(*map));
+      if (map == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      map->addr = host_mmap(hf->fd, buf.st_size);
+      if (map->addr == NULL)
+        {
+          kmm_free(map);
+          return -ENOMEM;
+        }
+
+      map->length  = buf.st_size;
+      map->next    = fs->fs_mmaps;
+      fs->fs_mmaps = map;
+      hf->mapaddr  = map->addr;
+    }
+
+  *ppv = hf->mapaddr;
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: hostfs_open
  ****************************************************************************/
@@ -275,7 +658,7 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
 
   /* Allocate memory for the open file */
 
-  hf = (struct hostfs_ofile_s *) kmm_malloc(sizeof *hf);
+  hf = (struct hostfs_ofile_s *) kmm_zalloc(sizeof *hf);
   if (hf == NULL)
     {
       ret = -ENOMEM;
@@ -297,6 +680,13 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
       goto errout_with_buffer;
     }
 
+  /* Opening for write may create or truncate the file */
+
+  if ((oflags & O_WROK) != 0)
+    {
+      hostfs_statcache_flush(fs);
+    }
+
   /* In write/append mode, we need to set the file pointer to the end of the
    * file.
    */
@@ -420,14 +810,29 @@ static int hostfs_close(FAR struct file *filep)
         }
     }
 
-  /* Close the host file */
+  /* Write out any buffered data and close the host file */
 
+  ret = hostfs_bufflush(filep, hf);
   host_close(hf->fd);
 
+  if ((hf->oflags & O_WROK) != 0)
+    {
+      hostfs_statcache_flush(fs);
+    }
+
   /* Now free the pointer */
 
   filep->f_priv = NULL;
+#ifdef CONFIG_FS_HOSTFS_RWBUFFER
+  if (hf->buf != NULL)
+    {
+      kmm_free(hf->buf);
+    }
+#endif
+
   kmm_free(hf);
+  hostfs_semgive(fs);
+  return ret;
 
 okout:
   hostfs_semgive(fs);
@@ -468,6 +873,15 @@ static ssize_t hostfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Call the host to perform the read */
 
+#ifdef CONFIG_FS_HOSTFS_RWBUFFER
+  if (hostfs_bufusable(hf))
+    {
+      ret = hostfs_bufread(filep, hf, buffer, buflen);
+      hostfs_semgive(fs);
+      return ret;
+    }
+#endif
+
   ret = host_read(hf->fd, buffer, buflen);
   if (ret > 0)
     {
@@ -534,6 +948,16 @@ static ssize_t hostfs_write(FAR struct file *filep, const char *buffer,
 
   /* Call the host to perform the write */
 
+  hostfs_statcache_flush(fs);
+
+#ifdef CONFIG_FS_HOSTFS_RWBUFFER
+  if (hostfs_bufusable(hf))
+    {
+      ret = hostfs_bufwrite(filep, hf, buffer, buflen);
+      goto errout_with_semaphore;
+    }
+#endif
+
   ret = host_write(hf->fd, buffer, buflen);
   if (ret > 0)
     {
@@ -576,9 +1000,16 @@ static off_t hostfs_seek(FAR struct file *filep, off_t offset, int whence)
       return ret;
     }
 
-  /* Call our internal routine to perform the seek */
+  /* Call our internal routine to perform the seek.  Buffered data must
+   * reach the host first so that SEEK_CUR and SEEK_END see it.
+   */
+
+  ret = hostfs_bufflush(filep, hf);
+  if (ret >= 0)
+    {
+      ret = host_lseek(hf->fd, offset, whence);
+    }
 
-  ret = host_lseek(hf->fd, offset, whence);
   if (ret >= 0)
     {
       filep->f_pos = ret;
@@ -619,9 +1050,24 @@ static int hostfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
       return ret;
     }
 
+#ifdef CONFIG_FS_HOSTFS_MMAP
+  /* Map read-only files directly from the host */
+
+  if (cmd == FIOC_MMAP)
+    {
+      ret = hostfs_mmap(fs, hf, (FAR void **)((uintptr_t)arg));
+      hostfs_semgive(fs);
+      return ret;
+    }
+#endif
+
   /* Call our internal routine to perform the ioctl */
 
-  ret = host_ioctl(hf->fd, cmd, arg);
+  ret = hostfs_bufflush(filep, hf);
+  if (ret >= 0)
+    {
+      ret = host_ioctl(hf->fd, cmd, arg);
+    }
 
   hostfs_semgive(fs);
   return ret;
@@ -662,10 +1108,11 @@ static int hostfs_sync(FAR struct file *filep)
       return ret;
     }
 
+  ret = hostfs_bufflush(filep, hf);
   host_sync(hf->fd);
 
   hostfs_semgive(fs);
-  return OK;
+  return ret;
 }
 
 /****************************************************************************
@@ -736,9 +1183,15 @@ static int hostfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
       return ret;
     }
 
-  /* Call the host to perform the read */
+  /* Call the host to perform the read.  Buffered data must be written
+   * first so that the size is right.
+   */
 
-  ret = host_fstat(hf->fd, buf);
+  ret = hostfs_bufflush(filep, hf);
+  if (ret >= 0)
+    {
+      ret = host_fstat(hf->fd, buf);
+    }
 
   hostfs_semgive(fs);
   return ret;
@@ -784,6 +1237,7 @@ static int hostfs_fchstat(FAR const struct file *filep,
 
   /* Call the host to perform the change */
 
+  hostfs_statcache_flush(fs);
   ret = host_fchstat(hf->fd, buf, flags);
 
   hostfs_semgive(fs);
@@ -829,7 +1283,12 @@ static int hostfs_ftruncate(FAR struct file *filep, off_t length)
 
   /* Call the host to perform the truncate */
 
-  ret = host_ftruncate(hf->fd, length);
+  hostfs_statcache_flush(fs);
+  ret = hostfs_bufflush(filep, hf);
+  if (ret >= 0)
+    {
+      ret = host_ftruncate(hf->fd, length);
+    }
 
   hostfs_semgive(fs);
   return ret;
@@ -1152,6 +1611,19 @@ static int hostfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
       return (flags != 0) ? -ENOSYS : -EBUSY;
     }
 
+#ifdef CONFIG_FS_HOSTFS_MMAP
+  /* Release the host mappings of the files */
+
+  while (fs->fs_mmaps != NULL)
+    {
+      FAR struct hostfs_mmap_s *map = fs->fs_mmaps;
+
+      fs->fs_mmaps = map->next;
+      host_munmap(map->addr, map->length);
+      kmm_free(map);
+    }
+#endif
+
   hostfs_semgive(fs);
   kmm_free(fs);
   return ret;
@@ -1226,6 +1698,7 @@ static int hostfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
 
   /* Call the host fs to perform the unlink */
 
+  hostfs_statcache_flush(fs);
   ret = host_unlink(path);
 
   hostfs_semgive(fs);
@@ -1266,6 +1739,7 @@ static int hostfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the mkdir */
 
+  hostfs_statcache_flush(fs);
   ret = host_mkdir(path, mode);
 
   hostfs_semgive(fs);
@@ -1307,6 +1781,7 @@ int hostfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
 
   /* Call the host FS to do the mkdir */
 
+  hostfs_statcache_flush(fs);
   ret = host_rmdir(path);
 
   hostfs_semgive(fs);
@@ -1351,6 +1826,7 @@ int hostfs_rename(FAR struct inode *mountpt, FAR const char *oldrelpath,
 
   /* Call the host FS to do the mkdir */
 
+  hostfs_statcache_flush(fs);
   ret = host_rename(oldpath, newpath);
 
   hostfs_semgive(fs);
@@ -1391,7 +1867,18 @@ static int hostfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the stat operation */
 
+#ifdef CONFIG_FS_HOSTFS_STATCACHE
+  if (hostfs_statcache_find(fs, path, buf, &ret))
+    {
+      hostfs_semgive(fs);
+      return ret;
+    }
+
   ret = host_stat(path, buf);
+  hostfs_statcache_add(fs, path, buf, ret);
+#else
+  ret = host_stat(path, buf);
+#endif
 
   hostfs_semgive(fs);
   return ret;
@@ -1431,6 +1918,7 @@ static int hostfs_chstat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the chstat operation */
 
+  hostfs_statcache_flush(fs);
   ret = host_chstat(path, buf, flags);
 
   hostfs_semgive(fs);
@@ -28,9 +28,11 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 
 /****************************************************************************
@@ -53,8 +55,50 @@ struct hostfs_ofile_s
   int16_t                   crefs;      /* Reference count */
   mode_t                    oflags;     /* Open mode */
   int                       fd;
+#ifdef CONFIG_FS_HOSTFS_RWBUFFER
+  /* Small reads and writes are gathered here so that they reach the host
+   * as one large transfer.  If the buffer is not dirty, the host file
+   * position is at bufpos + buflen; otherwise it is still at bufpos.
+   */
+
+  FAR char                 *buf;        /* Transfer buffer or NULL */
+  off_t                     bufpos;     /* File position of buf[0] */
+  size_t                    buflen;     /* Number of valid bytes in buf */
+  bool                      bufdirty;   /* buf holds unwritten data */
+#endif
+#ifdef CONFIG_FS_HOSTFS_MMAP
+  FAR void                 *mapaddr;    /* Host mapping of the file or NULL */
+#endif
 };
 
+#ifdef CONFIG_FS_HOSTFS_MMAP
+/* This structure describes one host mapping created by FIOC_MMAP.  The
+ * mapping must outlive the file that created it, so it is only released
+ * when the file system is unmounted.
+ */
+
+struct hostfs_mmap_s
+{
+  FAR struct hostfs_mmap_s *next;       /* Supports a singly linked list */
+  FAR void                 *addr;       /* Host address of the mapping */
+  size_t                    length;     /* Length of the mapping */
+};
+#endif
+
+#ifdef CONFIG_FS_HOSTFS_STATCACHE
+/* This structure caches the result of one host_stat() call.  The entry is
+ * unused if path[] is empty.
+ */
+
+struct hostfs_statcache_s
+{
+  clock_t                   expires;    /* Time when the entry goes stale */
+  int                       ret;        /* Result of host_stat() */
+  struct stat               buf;        /* Attributes from host_stat() */
+  char                      path[HOSTFS_MAX_PATH];
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a hostfs filesystem.
@@ -64,6 +108,13 @@ struct hostfs_mountpt_s
 {
   sem_t                      *fs_sem;       /* Used to assure thread-safe access */
   FAR struct hostfs_ofile_s  *fs_head;      /* A singly-linked list of open files */
+#ifdef CONFIG_FS_HOSTFS_MMAP
+  FAR struct hostfs_mmap_s   *fs_mmaps;     /* Host mappings to release on unmount */
+#endif
+#ifdef CONFIG_FS_HOSTFS_STATCACHE
+  struct hostfs_statcache_s   fs_stats[CONFIG_FS_HOSTFS_STATCACHE_NENTRIES];
+  uint8_t                     fs_statnext;  /* Next entry to replace */
+#endif
   char                        fs_root[HOSTFS_MAX_PATH];
 };
 
@@ -35,9 +35,18 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of rows that files_extend() will allow */
+
+#define FILES_MAXROWS (OPEN_MAX / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -59,6 +68,17 @@ static int _files_semtake(FAR struct filelist *list)
 
 /****************************************************************************
  * Name: files_extend
+ *
+ * Description:
+ *   Add rows to the file list.  fs_getfilep() indexes the list without
+ *   taking the list semaphore, so the row array is allocated once with
+ *   room for the maximum number of rows and is never moved, each new row
+ *   is in place before fl_rows covers it, and rows are only freed when
+ *   the file list is released.
+ *
+ * Assumptions:
+ *   The caller holds the list semaphore
+ *
  ****************************************************************************/
 
 static int files_extend(FAR struct filelist *list, size_t row)
@@ -76,11 +96,17 @@ static int files_extend(FAR struct filelist *list, size_t row)
       return -EMFILE;
     }
 
-  tmp = kmm_realloc(list->fl_files, sizeof(FAR struct file *) * row);
-  DEBUGASSERT(tmp);
+  tmp = list->fl_files;
   if (tmp == NULL)
     {
-      return -ENFILE;
+      tmp = kmm_zalloc(sizeof(FAR struct file *) * FILES_MAXROWS);
+      DEBUGASSERT(tmp);
+      if (tmp == NULL)
+        {
+          return -ENFILE;
+        }
+
+      list->fl_files = tmp;
     }
 
   i = list->fl_rows;
@@ -93,15 +119,17 @@ static int files_extend(FAR struct filelist *list, size_t row)
           while (--i >= list->fl_rows)
             {
               kmm_free(tmp[i]);
+              tmp[i] = NULL;
             }
 
-          kmm_free(tmp);
           return -ENFILE;
         }
     }
   while (++i < row);
 
-  list->fl_files = tmp;
+  /* Make the new rows visible before the descriptors that index them */
+
+  SP_DMB();
   list->fl_rows = row;
 
   /* Note: If assertion occurs, the fl_rows has a overflow.
@@ -170,16 +198,18 @@ void files_releaselist(FAR struct filelist *list)
 }
 
 /****************************************************************************
- * Name: files_allocate
+ * Name: files_allocate_from_tcb
  *
  * Description:
- *   Allocate a struct files instance and associate it with an inode
- *   instance.  Returns the file descriptor == index into the files array.
+ *   Allocate a struct files instance in the file list of the task 'tcb'
+ *   and associate it with an inode instance.  Returns the file descriptor
+ *   == index into the files array.
  *
  ****************************************************************************/
 
-int files_allocate(FAR struct inode *inode, int oflags, off_t pos,
-                   FAR void *priv, int minfd)
+int files_allocate_from_tcb(FAR struct tcb_s *tcb, FAR struct inode *inode,
+                            int oflags, off_t pos, FAR void *priv,
+                            int minfd)
 {
   FAR struct filelist *list;
   int ret;
@@ -188,8 +218,8 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos,
 
   /* Get the file descriptor list.  It should not be NULL in this context. */
 
-  list = nxsched_get_files();
-  DEBUGASSERT(list != NULL);
+  DEBUGASSERT(tcb != NULL && tcb->group != NULL);
+  list = &tcb->group->tg_filelist;
 
   ret = _files_semtake(list);
   if (ret < 0)
@@ -253,6 +283,22 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos,
   return ret;
 }
 
+/****************************************************************************
+ * Name: files_allocate
+ *
+ * Description:
+ *   Allocate a struct files instance and associate it with an inode
+ *   instance.  Returns the file descriptor == index into the files array.
+ *
+ ****************************************************************************/
+
+int files_allocate(FAR struct inode *inode, int oflags, off_t pos,
+                   FAR void *priv, int minfd)
+{
+  return files_allocate_from_tcb(nxsched_self(), inode, oflags, pos,
+                                 priv, minfd);
+}
+
 /****************************************************************************
  * Name: files_duplist
  *
@@ -342,7 +388,7 @@ out:
 int fs_getfilep(int fd, FAR struct file **filep)
 {
   FAR struct filelist *list;
-  int ret;
+  int rows;
 
   DEBUGASSERT(filep != NULL);
   *filep = (FAR struct file *)NULL;
@@ -361,50 +407,40 @@ int fs_getfilep(int fd, FAR struct file **filep)
       return -EAGAIN;
     }
 
-  if (fd < 0 || fd >= list->fl_rows * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
+  rows = list->fl_rows;
+  if (fd < 0 || fd >= rows * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
     {
       return -EBADF;
     }
 
-  /* The descriptor is in a valid range to file descriptor... Get the
-   * thread-specific file list.
+  /* The descriptor is in a valid range to file descriptor.  The list
+   * semaphore is not needed to return the file pointer from the list:
+   * files_extend() never moves the rows and fills a row in before fl_rows
+   * covers it.  Pairs with the barrier in files_extend().
    */
 
-  /* And return the file pointer from the list */
-
-  ret = _files_semtake(list);
-  if (ret < 0)
-    {
-      return ret;
-    }
-
+  SP_DMB();
   *filep = &list->fl_files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
                           [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
 
   /* if f_inode is NULL, fd was closed */
 
-  if (!(*filep)->f_inode)
+  if ((*filep)->f_inode == NULL)
     {
       *filep = (FAR struct file *)NULL;
-      ret = -EBADF;
+      return -EBADF;
     }
 
-  _files_semgive(list);
-
-  return ret;
+  return OK;
 }
 
 /****************************************************************************
- * Name: nx_dup2
+ * Name: nx_dup2_from_tcb
  *
  * Description:
- *   nx_dup2() is similar to the standard 'dup2' interface except that is
- *   not a cancellation point and it does not modify the errno variable.
- *
- *   nx_dup2() is an internal NuttX interface and should not be called from
- *   applications.
- *
- *   Clone a file descriptor to a specific descriptor number.
+ *   nx_dup2_from_tcb() is similar to nx_dup2() except that it operates on
+ *   the file list of the task 'tcb'.  This is used to set up the file
+ *   descriptors of a new task before it is activated.
  *
  * Returned Value:
  *   fd2 is returned on success; a negated errno value is return on
@@ -412,15 +448,15 @@ int fs_getfilep(int fd, FAR struct file **filep)
  *
  ****************************************************************************/
 
-int nx_dup2(int fd1, int fd2)
+int nx_dup2_from_tcb(FAR struct tcb_s *tcb, int fd1, int fd2)
 {
   FAR struct filelist *list;
   int ret;
 
   /* Get the file descriptor list.  It should not be NULL in this context. */
 
-  list = nxsched_get_files();
-  DEBUGASSERT(list != NULL);
+  DEBUGASSERT(tcb != NULL && tcb->group != NULL);
+  list = &tcb->group->tg_filelist;
 
   if (fd1 < 0 || fd1 >= CONFIG_NFILE_DESCRIPTORS_PER_BLOCK * list->fl_rows ||
       fd2 < 0)
@@ -457,6 +493,29 @@ int nx_dup2(int fd1, int fd2)
   return ret < 0 ? ret : fd2;
 }
 
+/****************************************************************************
+ * Name: nx_dup2
+ *
+ * Description:
+ *   nx_dup2() is similar to the standard 'dup2' interface except that is
+ *   not a cancellation point and it does not modify the errno variable.
+ *
+ *   nx_dup2() is an internal NuttX interface and should not be called from
+ *   applications.
+ *
+ *   Clone a file descriptor to a specific descriptor number.
+ *
+ * Returned Value:
+ *   fd2 is returned on success; a negated errno value is return on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int nx_dup2(int fd1, int fd2)
+{
+  return nx_dup2_from_tcb(nxsched_self(), fd1, fd2);
+}
+
 /****************************************************************************
  * Name: dup2
  *
@@ -481,40 +540,31 @@ int dup2(int fd1, int fd2)
 }
 
 /****************************************************************************
- * Name: nx_close
+ * Name: nx_close_from_tcb
  *
  * Description:
- *   nx_close() is similar to the standard 'close' interface except that is
- *   not a cancellation point and it does not modify the errno variable.
- *
- *   nx_close() is an internal NuttX interface and should not be called from
- *   applications.
- *
- *   Close an inode (if open)
+ *   nx_close_from_tcb() is similar to nx_close() except that it closes a
+ *   file descriptor in the file list of the task 'tcb'.
  *
  * Returned Value:
  *   Zero (OK) is returned on success; A negated errno value is returned on
  *   on any failure.
  *
- * Assumptions:
- *   Caller holds the list semaphore because the file descriptor will be
- *   freed.
- *
  ****************************************************************************/
 
-int nx_close(int fd)
+int nx_close_from_tcb(FAR struct tcb_s *tcb, int fd)
 {
   FAR struct filelist *list;
   FAR struct file     *filep;
   FAR struct file      file;
   int                  ret;
 
-  /* Get the thread-specific file list.  It should never be NULL in this
+  /* Get the task-specific file list.  It should never be NULL in this
    * context.
    */
 
-  list = nxsched_get_files();
-  DEBUGASSERT(list != NULL);
+  DEBUGASSERT(tcb != NULL && tcb->group != NULL);
+  list = &tcb->group->tg_filelist;
 
   /* Perform the protected close operation */
 
@@ -544,6 +594,29 @@ int nx_close(int fd)
   return file_close(&file);
 }
 
+/****************************************************************************
+ * Name: nx_close
+ *
+ * Description:
+ *   nx_close() is similar to the standard 'close' interface except that is
+ *   not a cancellation point and it does not modify the errno variable.
+ *
+ *   nx_close() is an internal NuttX interface and should not be called from
+ *   applications.
+ *
+ *   Close an inode (if open)
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; A negated errno value is returned on
+ *   on any failure.
+ *
+ ****************************************************************************/
+
+int nx_close(int fd)
+{
+  return nx_close_from_tcb(nxsched_self(), fd);
+}
+
 /****************************************************************************
  * Name: close
  *
@@ -0,0 +1,228 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODE_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INODE_CACHE_NENTRIES  CONFIG_FS_INODE_CACHE_NENTRIES
+#define INODE_CACHE_PATHLEN   CONFIG_FS_INODE_CACHE_PATHLEN
+
+/* Value of reloff if the search returned no relative path */
+
+#define INODE_CACHE_NORELPATH UINT8_MAX
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One remembered result of _inode_search().  The residual path and the
+ * relative path are kept as offsets into the path, so that they can be
+ * applied to any copy of the same path string.
+ */
+
+struct inode_cache_s
+{
+  uint32_t generation;             /* Tree generation of the entry */
+  uint32_t hash;                   /* Hash of the path */
+  FAR struct inode *node;          /* The inode found (may be NULL) */
+  FAR struct inode *peer;          /* Node to the "left" of the inode */
+  FAR struct inode *parent;        /* Node "above" the inode */
+  int16_t result;                  /* OK or -ENOENT */
+  uint8_t pathoff;                 /* Offset of the residual path */
+  uint8_t reloff;                  /* Offset of the relative path */
+  char path[INODE_CACHE_PATHLEN];  /* The absolute path searched */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct inode_cache_s g_inode_cache[INODE_CACHE_NENTRIES];
+
+/* Incremented each time the shape of the inode tree changes.  Entries of
+ * older generations are stale.  Zero is never used, so that the cleared
+ * entries are never valid.
+ */
+
+static uint32_t g_inode_generation = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_hash
+ *
+ * Description:
+ *   Return the FNV-1a hash and the length of a path.
+ *
+ ****************************************************************************/
+
+static uint32_t inode_cache_hash(FAR const char *path, FAR size_t *len)
+{
+  FAR const char *ptr = path;
+  uint32_t hash = 2166136261u;
+
+  while (*ptr != '\0')
+    {
+      hash ^= (uint8_t)*ptr++;
+      hash *= 16777619u;
+    }
+
+  *len = ptr - path;
+  return hash;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Look up the result of an earlier search for the same absolute path.
+ *   On a hit, the output fields of 'desc' are set up as _inode_search()
+ *   would have set them.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+bool inode_cache_lookup(FAR struct inode_search_s *desc, FAR int *result)
+{
+  FAR struct inode_cache_s *entry;
+  FAR const char *path = desc->path;
+  uint32_t hash;
+  size_t len;
+
+  hash = inode_cache_hash(path, &len);
+  if (len >= INODE_CACHE_PATHLEN)
+    {
+      return false;
+    }
+
+  entry = &g_inode_cache[hash % INODE_CACHE_NENTRIES];
+  if (entry->generation != g_inode_generation || entry->hash != hash ||
+      strcmp(entry->path, path) != 0)
+    {
+      return false;
+    }
+
+  desc->path    = path + entry->pathoff;
+  desc->node    = entry->node;
+  desc->peer    = entry->peer;
+  desc->parent  = entry->parent;
+  desc->relpath = entry->reloff == INODE_CACHE_NORELPATH ?
+                  NULL : path + entry->reloff;
+  *result       = entry->result;
+  return true;
+}
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Remember the result of _inode_search() for 'path'.  Only results that
+ *   refer to the path itself are kept, i.e. a relative path that had to
+ *   be built after passing through a soft link is not.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR const char *path,
+                     FAR const struct inode_search_s *desc, int result)
+{
+  FAR struct inode_cache_s *entry;
+  uint32_t hash;
+  size_t len;
+
+  if (result != OK && result != -ENOENT)
+    {
+      return;
+    }
+
+  hash = inode_cache_hash(path, &len);
+  if (len >= INODE_CACHE_PATHLEN ||
+      desc->path < path || desc->path > path + len ||
+      (desc->relpath != NULL &&
+       (desc->relpath < path || desc->relpath > path + len)))
+    {
+      return;
+    }
+
+  entry             = &g_inode_cache[hash % INODE_CACHE_NENTRIES];
+  entry->generation = g_inode_generation;
+  entry->hash       = hash;
+  entry->node       = desc->node;
+  entry->peer       = desc->peer;
+  entry->parent     = desc->parent;
+  entry->result     = result;
+  entry->pathoff    = desc->path - path;
+  entry->reloff     = desc->relpath == NULL ?
+                      INODE_CACHE_NORELPATH : desc->relpath - path;
+  memcpy(entry->path, path, len + 1);
+}
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Forget all remembered search results.  This must be called whenever
+ *   an inode is linked into or unlinked from the tree, and whenever an
+ *   inode becomes or stops being a mountpoint or a soft link.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void)
+{
+  if (++g_inode_generation == 0)
+    {
+      memset(g_inode_cache, 0, sizeof(g_inode_cache));
+      g_inode_generation = 1;
+    }
+}
+
+#endif /* CONFIG_FS_INODE_CACHE */
@@ -118,6 +118,8 @@ static void inode_insert(FAR struct inode *node,
       node->i_parent  = parent;
       parent->i_child = node;
     }
+
+  inode_cache_invalidate();
 }
 
 /****************************************************************************
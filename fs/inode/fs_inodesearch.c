@@ -468,6 +468,9 @@ static FAR const char *_inode_getcwd(void)
 
 int inode_search(FAR struct inode_search_s *desc)
 {
+#ifdef CONFIG_FS_INODE_CACHE
+  FAR const char *path;
+#endif
   int ret;
 
   /* Perform the common _inode_search() logic.  This does everything except
@@ -490,7 +493,35 @@ int inode_search(FAR struct inode_search_s *desc)
       desc->path = desc->buffer;
     }
 
+#ifdef CONFIG_FS_INODE_CACHE
+  /* Opening many files below the same directories repeats the same walks
+   * through the tree.  Use the remembered result of an earlier walk for
+   * the same absolute path, if there is one.
+   */
+
+  path = desc->path;
+  if (!inode_cache_lookup(desc, &ret))
+    {
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+      bool owned = (path == desc->buffer);
+#endif
+
+      ret = _inode_search(desc);
+
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+      /* Passing through a soft link releases the buffer holding a path
+       * that was made absolute above.
+       */
+
+      if (!owned)
+#endif
+        {
+          inode_cache_add(path, desc, ret);
+        }
+    }
+#else
   ret = _inode_search(desc);
+#endif
 
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
   if (ret >= 0)
@@ -202,6 +202,31 @@ int inode_checkflags(FAR struct inode *inode, int oflags);
 
 int inode_search(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_cache_lookup, inode_cache_add, and inode_cache_invalidate
+ *
+ * Description:
+ *   Hashed cache of the results of inode_search() for absolute paths.
+ *   inode_cache_lookup() returns true and sets up 'desc' and 'result' if
+ *   an earlier search for the path is remembered, inode_cache_add()
+ *   remembers the result of a search, and inode_cache_invalidate() must
+ *   be called whenever the tree, or the mountpoint or soft link type of
+ *   an inode in it, is changed.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+bool inode_cache_lookup(FAR struct inode_search_s *desc, FAR int *result);
+void inode_cache_add(FAR const char *path,
+                     FAR const struct inode_search_s *desc, int result);
+void inode_cache_invalidate(void);
+#else
+#  define inode_cache_invalidate()
+#endif
+
 /****************************************************************************
  * Name: inode_find
  *
@@ -419,6 +444,32 @@ int foreach_inode(foreach_inode_t handler, FAR void *arg);
 int files_allocate(FAR struct inode *inode, int oflags, off_t pos,
                    FAR void *priv, int minfd);
 
+/****************************************************************************
+ * Name: files_allocate_from_tcb
+ *
+ * Description:
+ *   Allocate a struct files instance in the file list of the task 'tcb'
+ *   and associate it with an inode instance.  Returns the file descriptor
+ *   == index into the files array.
+ *
+ ****************************************************************************/
+
+int files_allocate_from_tcb(FAR struct tcb_s *tcb, FAR struct inode *inode,
+                            int oflags, off_t pos, FAR void *priv,
+                            int minfd);
+
+/****************************************************************************
+ * Name: epoll_file_close
+ *
+ * Description:
+ *   Remove the file from the interest list of every epoll instance.  This
+ *   is called by file_close() before the file is closed, so that no driver
+ *   is left with a pointer to the poll structure of a registration.
+ *
+ ****************************************************************************/
+
+void epoll_file_close(FAR struct file *filep);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -24,9 +24,13 @@
 
 #include <nuttx/config.h>
 
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdlib.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <string.h>
+#include <debug.h>
 
 #include <nuttx/fs/dirent.h>
 #include <nuttx/fs/fs.h>
@@ -62,6 +66,43 @@ struct littlefs_mountpt_s
   struct mtd_geometry_s geo;
   struct lfs_config     cfg;
   struct lfs            lfs;
+
+  /* Read prefetching.  Small reads from the media are extended to
+   * prefetch_size bytes within the same littlefs block, so that the
+   * reads that follow are served from this buffer.
+   */
+
+  lfs_size_t            prefetch_size; /* Size of the prefetch buffer */
+  FAR uint8_t          *prefetch;      /* Prefetched data or NULL */
+  lfs_block_t           pblock;        /* littlefs block of the data */
+  lfs_off_t             poff;          /* Offset of the data in the block */
+  lfs_size_t            plen;          /* Length of the data, 0 if none */
+};
+
+/* The littlefs mount options.  The mount data is a comma separated list
+ * of:
+ *
+ *   forceformat            - Format the device before mounting it
+ *   autoformat             - Format the device if it cannot be mounted
+ *   read_size=<bytes>      - Minimum size of a read from the device
+ *   prog_size=<bytes>      - Minimum size of a write to the device
+ *   cache_size=<bytes>     - Size of the read, write and file caches
+ *   lookahead_size=<bytes> - Size of the free block bitmap, which covers
+ *                            8 blocks per byte of the device
+ *   prefetch_size=<bytes>  - Size of the read prefetching, 0 to disable
+ *
+ * A size of zero selects the default.
+ */
+
+struct littlefs_options_s
+{
+  bool                  forceformat;
+  bool                  autoformat;
+  lfs_size_t            read_size;
+  lfs_size_t            prog_size;
+  lfs_size_t            cache_size;
+  lfs_size_t            lookahead_size;
+  lfs_size_t            prefetch_size;
 };
 
 /****************************************************************************
@@ -904,17 +945,13 @@ static int littlefs_rewinddir(FAR struct inode *mountpt,
 }
 
 /****************************************************************************
- * Name: littlefs_bind
+ * Name: littlefs_read_media
  *
- * Description: This implements a portion of the mount operation. This
- *  function allocates and initializes the mountpoint private data and
- *  binds the driver inode to the filesystem private data. The final
- *  binding of the private data (containing the driver) to the
- *  mountpoint is performed by mount().
+ * Description: Read from the MTD or block driver.
  *
  ****************************************************************************/
 
-static int littlefs_read_block(FAR const struct lfs_config *c,
+static int littlefs_read_media(FAR const struct lfs_config *c,
                                lfs_block_t block, lfs_off_t off,
                                FAR void *buffer, lfs_size_t size)
 {
@@ -938,6 +975,48 @@ static int littlefs_read_block(FAR const struct lfs_config *c,
   return ret >= 0 ? OK : ret;
 }
 
+/****************************************************************************
+ * Name: littlefs_read_block
+ *
+ * Description: The read method of littlefs.  Reads smaller than the
+ *  prefetch buffer are served from it, refilling it with the data starting
+ *  at the requested offset if necessary.
+ *
+ ****************************************************************************/
+
+static int littlefs_read_block(FAR const struct lfs_config *c,
+                               lfs_block_t block, lfs_off_t off,
+                               FAR void *buffer, lfs_size_t size)
+{
+  FAR struct littlefs_mountpt_s *fs = c->context;
+  lfs_size_t len;
+  int ret;
+
+  if (fs->prefetch == NULL || size >= fs->prefetch_size)
+    {
+      return littlefs_read_media(c, block, off, buffer, size);
+    }
+
+  if (fs->plen == 0 || block != fs->pblock || off < fs->poff ||
+      off + size > fs->poff + fs->plen)
+    {
+      len = lfs_min(fs->prefetch_size, c->block_size - off);
+      ret = littlefs_read_media(c, block, off, fs->prefetch, len);
+      if (ret < 0)
+        {
+          fs->plen = 0;
+          return ret;
+        }
+
+      fs->pblock = block;
+      fs->poff   = off;
+      fs->plen   = len;
+    }
+
+  memcpy(buffer, fs->prefetch + off - fs->poff, size);
+  return OK;
+}
+
 /****************************************************************************
  * Name: littlefs_write_block
  ****************************************************************************/
@@ -951,6 +1030,14 @@ static int littlefs_write_block(FAR const struct lfs_config *c,
   FAR struct inode *drv = fs->drv;
   int ret;
 
+  /* Drop prefetched data that this write changes */
+
+  if (fs->plen > 0 && fs->pblock == block && off < fs->poff + fs->plen &&
+      off + size > fs->poff)
+    {
+      fs->plen = 0;
+    }
+
   block = (block * c->block_size + off) / geo->blocksize;
   size  = size / geo->blocksize;
 
@@ -977,6 +1064,11 @@ static int littlefs_erase_block(FAR const struct lfs_config *c,
   FAR struct inode *drv = fs->drv;
   int ret = OK;
 
+  if (fs->pblock == block)
+    {
+      fs->plen = 0;
+    }
+
   if (INODE_IS_MTD(drv))
     {
       FAR struct mtd_geometry_s *geo = &fs->geo;
@@ -1018,6 +1110,75 @@ static int littlefs_sync_block(FAR const struct lfs_config *c)
   return ret == -ENOTTY ? OK : ret;
 }
 
+/****************************************************************************
+ * Name: littlefs_parse_options
+ *
+ * Description: Parse the mount data into 'opts', see struct
+ *  littlefs_options_s.  Unknown options are ignored.
+ *
+ ****************************************************************************/
+
+static void littlefs_parse_options(FAR const char *data,
+                                   FAR struct littlefs_options_s *opts)
+{
+  FAR const char *end;
+  FAR lfs_size_t *size;
+  size_t len;
+
+  memset(opts, 0, sizeof(*opts));
+  opts->prefetch_size = CONFIG_FS_LITTLEFS_PREFETCH_SIZE;
+
+  while (data != NULL && *data != '\0')
+    {
+      end = strchr(data, ',');
+      len = end != NULL ? end - data : strlen(data);
+
+      if (len == 11 && strncmp(data, "forceformat", 11) == 0)
+        {
+          opts->forceformat = true;
+        }
+      else if (len == 10 && strncmp(data, "autoformat", 10) == 0)
+        {
+          opts->autoformat = true;
+        }
+      else
+        {
+          if (strncmp(data, "read_size=", 10) == 0)
+            {
+              size = &opts->read_size;
+            }
+          else if (strncmp(data, "prog_size=", 10) == 0)
+            {
+              size = &opts->prog_size;
+            }
+          else if (strncmp(data, "cache_size=", 11) == 0)
+            {
+              size = &opts->cache_size;
+            }
+          else if (strncmp(data, "lookahead_size=", 15) == 0)
+            {
+              size = &opts->lookahead_size;
+            }
+          else if (strncmp(data, "prefetch_size=", 14) == 0)
+            {
+              size = &opts->prefetch_size;
+            }
+          else
+            {
+              size = NULL;
+              fwarn("WARNING: Unknown option %.*s\n", (int)len, data);
+            }
+
+          if (size != NULL)
+            {
+              *size = strtoul(strchr(data, '=') + 1, NULL, 0);
+            }
+        }
+
+      data = end != NULL ? end + 1 : NULL;
+    }
+}
+
 /****************************************************************************
  * Name: littlefs_bind
  ****************************************************************************/
@@ -1026,8 +1187,11 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
                          FAR void **handle)
 {
   FAR struct littlefs_mountpt_s *fs;
+  struct littlefs_options_s opts;
   int ret;
 
+  littlefs_parse_options(data, &opts);
+
   /* Open the block driver */
 
   if (INODE_IS_BLOCK(driver) && driver->u.i_bops->open)
@@ -1118,13 +1282,57 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
   fs->cfg.lookahead_size = lfs_min(lfs_alignup(fs->cfg.block_count, 64) / 8,
                                    fs->cfg.read_size);
 
+  /* Apply the sizes of the mount options.  The device transfers whole
+   * device blocks, and littlefs needs caches that are a multiple of the
+   * read and write sizes and divide its blocks, and a lookahead bitmap of
+   * whole 64-bit words.
+   */
+
+  if (opts.read_size != 0)
+    {
+      fs->cfg.read_size = lfs_alignup(opts.read_size, fs->geo.blocksize);
+    }
+
+  if (opts.prog_size != 0)
+    {
+      fs->cfg.prog_size = lfs_alignup(opts.prog_size, fs->geo.blocksize);
+    }
+
+  if (opts.cache_size != 0)
+    {
+      fs->cfg.cache_size = opts.cache_size;
+    }
+
+  if (opts.lookahead_size != 0)
+    {
+      fs->cfg.lookahead_size = lfs_alignup(opts.lookahead_size, 8);
+    }
+
+  if (fs->cfg.cache_size % fs->cfg.read_size != 0 ||
+      fs->cfg.cache_size % fs->cfg.prog_size != 0 ||
+      fs->cfg.block_size % fs->cfg.cache_size != 0)
+    {
+      ferr("ERROR: Invalid cache size %" PRIu32 "\n", fs->cfg.cache_size);
+      ret = -EINVAL;
+      goto errout_with_fs;
+    }
+
+  /* Prefetching only helps if it reads more than littlefs asks for */
+
+  fs->prefetch_size = lfs_min(opts.prefetch_size, fs->cfg.block_size);
+  fs->prefetch_size -= fs->prefetch_size % fs->cfg.read_size;
+  if (fs->prefetch_size > fs->cfg.read_size)
+    {
+      fs->prefetch = kmm_malloc(fs->prefetch_size);
+    }
+
   /* Then get information about the littlefs filesystem on the devices
    * managed by this driver.
    */
 
   /* Force format the device if -o forceformat */
 
-  if (data && strcmp(data, "forceformat") == 0)
+  if (opts.forceformat)
     {
       ret = littlefs_convert_result(lfs_format(&fs->lfs, &fs->cfg));
       if (ret < 0)
@@ -1138,7 +1346,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
     {
       /* Auto format the device if -o autoformat */
 
-      if (ret != -EFAULT || !data || strcmp(data, "autoformat"))
+      if (ret != -EFAULT || !opts.autoformat)
         {
           goto errout_with_fs;
         }
@@ -1164,6 +1372,11 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
 
 errout_with_fs:
   nxsem_destroy(&fs->sem);
+  if (fs->prefetch != NULL)
+    {
+      kmm_free(fs->prefetch);
+    }
+
   kmm_free(fs);
 errout_with_block:
   if (INODE_IS_BLOCK(driver) && driver->u.i_bops->close)
@@ -1223,6 +1436,11 @@ static int littlefs_unbind(FAR void *handle, FAR struct inode **driver,
       /* Release the mountpoint private data */
 
       nxsem_destroy(&fs->sem);
+      if (fs->prefetch != NULL)
+        {
+          kmm_free(fs->prefetch);
+        }
+
       kmm_free(fs);
     }
 
@@ -41,6 +41,24 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: file_mmap_readonly
+ *
+ * Description:
+ *   Check if the data of a file can never change, i.e. if the file lies on
+ *   a file system without a write method such as ROMFS.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_RAMMAP
+static bool file_mmap_readonly(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+
+  return INODE_IS_MOUNTPT(inode) && inode->u.i_mops->write == NULL;
+}
+#endif
+
 /****************************************************************************
  * Name: file_mmap_
  ****************************************************************************/
@@ -69,10 +87,10 @@ static int file_mmap_(FAR struct file *filep, FAR void *start,
     }
 
 #ifndef CONFIG_FS_RAMMAP
-  if ((flags & MAP_PRIVATE) != 0)
+  if ((flags & MAP_PRIVATE) != 0 && (prot & PROT_WRITE) != 0)
     {
-      ferr("ERROR: MAP_PRIVATE is not supported without file mapping"
-           "emulation\n");
+      ferr("ERROR: Writable MAP_PRIVATE is not supported without file "
+           "mapping emulation\n");
       return -ENOSYS;
     }
 #endif /* CONFIG_FS_RAMMAP */
@@ -86,7 +104,7 @@ static int file_mmap_(FAR struct file *filep, FAR void *start,
     }
 #endif /* CONFIG_DEBUG_FEATURES */
 
-  if ((filep->f_oflags & O_WROK) == 0 && prot == PROT_WRITE &&
+  if ((filep->f_oflags & O_WROK) == 0 && (prot & PROT_WRITE) != 0 &&
       (flags & MAP_SHARED) != 0)
     {
       ferr("ERROR: Unsupported options for read-only file descriptor,"
@@ -127,11 +145,22 @@ static int file_mmap_(FAR struct file *filep, FAR void *start,
   if ((flags & MAP_PRIVATE) != 0)
     {
 #ifdef CONFIG_FS_RAMMAP
-      /* Allocate memory and copy the file into memory.  We would, of course,
-       * do much better in the KERNEL build using the MMU.
+      /* A private mapping that cannot be written and a file whose data
+       * never changes can share the file data if the file system allows
+       * that, e.g. ROMFS on XIP media.  Otherwise, allocate memory and copy
+       * the file into memory.  We would, of course, do much better in the
+       * KERNEL build using the MMU.
        */
 
-      return rammap(filep, length, offset, kernel, mapped);
+      if ((prot & PROT_WRITE) != 0 || !file_mmap_readonly(filep) ||
+          file_ioctl(filep, FIOC_MMAP,
+                     (unsigned long)((uintptr_t)&addr)) < 0)
+        {
+          return rammap(filep, length, offset, false, kernel, mapped);
+        }
+
+      *mapped = (FAR void *)(((FAR uint8_t *)addr) + offset);
+      return OK;
 #endif
     }
 
@@ -150,10 +179,12 @@ static int file_mmap_(FAR struct file *filep, FAR void *start,
 
 #ifdef CONFIG_FS_RAMMAP
       /* Allocate memory and copy the file into memory.  We would, of course,
-       * do much better in the KERNEL build using the MMU.
+       * do much better in the KERNEL build using the MMU.  The changes to a
+       * writable shared mapping are written back by msync() and munmap().
        */
 
-      return rammap(filep, length, offset, kernel, mapped);
+      return rammap(filep, length, offset, (prot & PROT_WRITE) != 0,
+                    kernel, mapped);
 #else
       ferr("ERROR: file_ioctl(FIOC_MMAP) failed: %d\n", ret);
       return ret;
@@ -208,7 +239,8 @@ int file_mmap(FAR struct file *filep, FAR void *start, size_t length,
  *
  *   2. If CONFIG_FS_RAMMAP is defined in the configuration, then mmap() will
  *      support simulation of memory mapped files by copying files whole
- *      into RAM.
+ *      into RAM.  The changes to a writable MAP_SHARED mapping are written
+ *      back to the file by msync() and munmap().
  *
  * Input Parameters:
  *   start   A hint at where to map the memory -- ignored.  The address
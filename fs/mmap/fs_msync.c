@@ -0,0 +1,173 @@
+/****************************************************************************
+ * fs/mmap/fs_msync.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+
+#include "inode/inode.h"
+#include "fs_rammap.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_msync_
+ ****************************************************************************/
+
+static int file_msync_(FAR void *start, size_t length, int flags)
+{
+#ifdef CONFIG_FS_RAMMAP
+  FAR struct fs_rammap_s *curr;
+  uintptr_t first;
+  uintptr_t last;
+  uintptr_t end;
+  int ret;
+#endif
+
+  if ((flags & ~(MS_ASYNC | MS_SYNC | MS_INVALIDATE)) != 0 ||
+      (flags & (MS_ASYNC | MS_SYNC)) == (MS_ASYNC | MS_SYNC))
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_FS_RAMMAP
+  /* Write back the overlapping part of every shared region in the range.
+   * MS_ASYNC is performed synchronously, and MS_INVALIDATE has nothing to
+   * do because there are no other cached copies of the file contents to
+   * invalidate.
+   */
+
+  ret = nxsem_wait(&g_rammaps.exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  end = (uintptr_t)start + length;
+  for (curr = g_rammaps.head; curr != NULL; curr = curr->flink)
+    {
+      first = (uintptr_t)curr->addr;
+      last  = first + curr->length;
+      if (first >= end || last <= (uintptr_t)start)
+        {
+          continue;
+        }
+
+      if (first < (uintptr_t)start)
+        {
+          first = (uintptr_t)start;
+        }
+
+      if (last > end)
+        {
+          last = end;
+        }
+
+      ret = rammap_sync(curr, first - (uintptr_t)curr->addr, last - first);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  nxsem_post(&g_rammaps.exclsem);
+  return ret;
+#else
+  /* Mappings of media that supports XIP are the file contents themselves */
+
+  return OK;
+#endif /* CONFIG_FS_RAMMAP */
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_msync
+ *
+ * Description:
+ *   Equivalent to the standard msync() function except it does not set
+ *   the errno variable and it is not a cancellation point.
+ *
+ ****************************************************************************/
+
+int file_msync(FAR void *start, size_t length, int flags)
+{
+  return file_msync_(start, length, flags);
+}
+
+/****************************************************************************
+ * Name: msync
+ *
+ * Description:
+ *   msync() writes the changes made to the in-memory image of a shared file
+ *   mapping in the range of 'length' bytes starting with 'start' back to
+ *   the file.  With CONFIG_FS_RAMMAP, these are the changes to the RAM
+ *   copy of a writable MAP_SHARED mapping.  Mappings of media that
+ *   supports XIP and MAP_PRIVATE mappings have nothing to write back.
+ *
+ * Input Parameters:
+ *   start   The start address of the range
+ *   length  The length of the range
+ *   flags   MS_ASYNC or MS_SYNC, optionally with MS_INVALIDATE.  The write
+ *           back is always synchronous.
+ *
+ * Returned Value:
+ *   On success, msync() returns 0, on failure -1, and errno is set:
+ *
+ *     EINVAL
+ *       'flags' is invalid
+ *     EIO
+ *       The write back to the file failed
+ *
+ ****************************************************************************/
+
+int msync(FAR void *start, size_t length, int flags)
+{
+  int ret;
+
+  /* msync() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = file_msync_(start, length, flags);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 #include <sys/mman.h>
+#include <sys/shm.h>
 
 #include <stdint.h>
 #include <errno.h>
@@ -33,6 +34,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/addrenv.h>
 
 #include "inode/inode.h"
 #include "fs_rammap.h"
@@ -72,12 +74,15 @@ static int file_munmap_(FAR void *start, size_t length, bool kernel)
         }
     }
 
-  /* Did we find the region */
+  /* Did we find the region?  If not, this should be a direct mapping of
+   * file data on random access media, e.g. XIP ROMFS.  There is nothing to
+   * release for those.
+   */
 
   if (!curr)
     {
-      ferr("ERROR: Region not found\n");
-      ret = -EINVAL;
+      finfo("No RAM mapping at %p\n", start);
+      ret = OK;
       goto errout_with_semaphore;
     }
 
@@ -102,6 +107,17 @@ static int file_munmap_(FAR void *start, size_t length, bool kernel)
 
   length = curr->length - offset;
 
+  /* Write the changes to the unmapped part of a shared mapping back to the
+   * file.  The mapping stays in place if that fails, so that the changes
+   * are not lost.
+   */
+
+  ret = rammap_sync(curr, offset, length);
+  if (ret < 0)
+    {
+      goto errout_with_semaphore;
+    }
+
   /* Are we unmapping the entire region (offset == 0)? */
 
   if (length >= curr->length)
@@ -117,6 +133,13 @@ static int file_munmap_(FAR void *start, size_t length, bool kernel)
           g_rammaps.head = curr->flink;
         }
 
+      /* Release the reference to the file of a shared mapping */
+
+      if (curr->file.f_inode != NULL)
+        {
+          file_close(&curr->file);
+        }
+
       /* Then free the region */
 
       if (kernel)
@@ -234,6 +257,18 @@ int munmap(FAR void *start, size_t length)
 {
   int ret;
 
+#ifdef CONFIG_FS_SHM
+  /* Mappings of POSIX shared memory objects are attachments of shared
+   * memory regions in the shared memory virtual address window.
+   */
+
+  if ((uintptr_t)start >= CONFIG_ARCH_SHM_VBASE &&
+      (uintptr_t)start < ARCH_SHM_VEND)
+    {
+      return shmdt(start);
+    }
+#endif
+
   ret = file_munmap_(start, length, false);
   if (ret < 0)
     {
@@ -66,6 +66,7 @@ struct fs_allmaps_s g_rammaps =
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   shared  Changes are to be written back to the file
  *   kernel  kmm_zalloc or kumm_zalloc
  *   mapped  The pointer to the mapped area
  *
@@ -81,8 +82,8 @@ struct fs_allmaps_s g_rammaps =
  *
  ****************************************************************************/
 
-int rammap(FAR struct file *filep, size_t length,
-           off_t offset, bool kernel, FAR void **mapped)
+int rammap(FAR struct file *filep, size_t length, off_t offset,
+           bool shared, bool kernel, FAR void **mapped)
 {
   FAR struct fs_rammap_s *map;
   FAR uint8_t *alloc;
@@ -177,13 +178,27 @@ int rammap(FAR struct file *filep, size_t length,
   /* Zero any memory beyond the amount read from the file */
 
   memset(rdbuffer, 0, length);
+  map->filelen = rdbuffer - (FAR uint8_t *)map->addr;
+
+  /* A shared mapping keeps its own reference to the file, so that the
+   * changes can still be written back after the file is closed.
+   */
+
+  if (shared)
+    {
+      ret = file_dup2(filep, &map->file);
+      if (ret < 0)
+        {
+          goto errout_with_region;
+        }
+    }
 
   /* Add the buffer to the list of regions */
 
   ret = nxsem_wait(&g_rammaps.exclsem);
   if (ret < 0)
     {
-      goto errout_with_region;
+      goto errout_with_file;
     }
 
   map->flink = g_rammaps.head;
@@ -193,6 +208,12 @@ int rammap(FAR struct file *filep, size_t length,
   *mapped = map->addr;
   return OK;
 
+errout_with_file:
+  if (map->file.f_inode != NULL)
+    {
+      file_close(&map->file);
+    }
+
 errout_with_region:
   if (kernel)
     {
@@ -206,4 +227,74 @@ errout_with_region:
   return ret;
 }
 
+/****************************************************************************
+ * Name: rammap_sync
+ *
+ * Description:
+ *   Write a part of the in-memory image of a shared mapping back to the
+ *   file.  Nothing is written for other mappings, or beyond the part of
+ *   the region that was read from the file.
+ *
+ * Input Parameters:
+ *   map     The mapped region
+ *   offset  The offset of the part into the region
+ *   length  The length of the part
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The caller holds g_rammaps.exclsem
+ *
+ ****************************************************************************/
+
+int rammap_sync(FAR struct fs_rammap_s *map, size_t offset, size_t length)
+{
+  FAR const uint8_t *wrbuffer;
+  ssize_t nwritten;
+
+  /* A write back must not extend the file, just like a store into a real
+   * mapping beyond the end of the file does not.
+   */
+
+  if (map->file.f_inode == NULL || offset >= map->filelen)
+    {
+      return OK;
+    }
+
+  if (length > map->filelen - offset)
+    {
+      length = map->filelen - offset;
+    }
+
+  wrbuffer = (FAR const uint8_t *)map->addr + offset;
+  while (length > 0)
+    {
+      nwritten = file_pwrite(&map->file, wrbuffer, length,
+                             map->offset + offset);
+      if (nwritten < 0)
+        {
+          if (nwritten == -EINTR)
+            {
+              continue;
+            }
+
+          ferr("ERROR: Write back failed: offset=%d ret=%d\n",
+               (int)(map->offset + offset), (int)nwritten);
+          return nwritten;
+        }
+
+      if (nwritten == 0)
+        {
+          return -EIO;
+        }
+
+      wrbuffer += nwritten;
+      offset   += nwritten;
+      length   -= nwritten;
+    }
+
+  return OK;
+}
+
 #endif /* CONFIG_FS_RAMMAP */
@@ -28,6 +28,9 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
+
+#include <nuttx/fs/fs.h>
 #include <nuttx/semaphore.h>
 
 #ifdef CONFIG_FS_RAMMAP
@@ -48,8 +51,10 @@
  * - All of the file must be present in memory.  This limits the size of
  *   files that may be memory mapped (especially on MCUs with no significant
  *   RAM resources).
- * - All mapped files are read-only.  You can write to the in-memory image,
- *   but the file contents will not change.
+ * - Changes to the in-memory image of a writable MAP_SHARED mapping only
+ *   reach the file when msync() or munmap() writes them back.  All other
+ *   mappings are read-only:  You can write to the in-memory image, but the
+ *   file contents will not change.
  * - There are not access privileges.
  */
 
@@ -59,6 +64,8 @@ struct fs_rammap_s
   FAR void           *addr;        /* Start of allocated memory */
   size_t              length;      /* Length of region */
   off_t               offset;      /* File offset */
+  size_t              filelen;     /* Length of region read from the file */
+  struct file         file;        /* Backing file of a shared mapping */
 };
 
 /* This structure defines all "mapped" files */
@@ -92,6 +99,7 @@ extern struct fs_allmaps_s g_rammaps;
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   shared  Changes are to be written back to the file
  *   kernel  kmm_zalloc or kumm_zalloc
  *   mapped  The pointer to the mapped area
  *
@@ -107,8 +115,31 @@ extern struct fs_allmaps_s g_rammaps;
  *
  ****************************************************************************/
 
-int rammap(FAR struct file *filep, size_t length,
-           off_t offset, bool kernel, FAR void **mapped);
+int rammap(FAR struct file *filep, size_t length, off_t offset,
+           bool shared, bool kernel, FAR void **mapped);
+
+/****************************************************************************
+ * Name: rammap_sync
+ *
+ * Description:
+ *   Write a part of the in-memory image of a shared mapping back to the
+ *   file.  Nothing is written for other mappings, or beyond the part of
+ *   the region that was read from the file.
+ *
+ * Input Parameters:
+ *   map     The mapped region
+ *   offset  The offset of the part into the region
+ *   length  The length of the part
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The caller holds g_rammaps.exclsem
+ *
+ ****************************************************************************/
+
+int rammap_sync(FAR struct fs_rammap_s *map, size_t offset, size_t length);
 
 #endif /* CONFIG_FS_RAMMAP */
 #endif /* __FS_MMAP_FS_RAMMAP_H */
@@ -455,6 +455,7 @@ int nx_mount(FAR const char *source, FAR const char *target,
 
   mountpt_inode->u.i_mops  = mops;
   mountpt_inode->i_private = fshandle;
+  inode_cache_invalidate();
   inode_semgive();
 
   /* We can release our reference to the blkdrver_inode, if the filesystem
@@ -372,28 +372,7 @@ static mqd_t nxmq_vopen(FAR const char *mq_name, int oflags, va_list ap)
 
 void nxmq_pollnotify(FAR struct mqueue_inode_s *msgq, pollevent_t eventset)
 {
-  int i;
-
-  for (i = 0; i < CONFIG_FS_MQUEUE_NPOLLWAITERS; i++)
-    {
-      FAR struct pollfd *fds = msgq->fds[i];
-
-      if (fds)
-        {
-          fds->revents |= (fds->events & eventset);
-
-          if (fds->revents != 0)
-            {
-              int semcount;
-
-              nxsem_get_value(fds->sem, &semcount);
-              if (semcount < 1)
-                {
-                  nxsem_post(fds->sem);
-                }
-            }
-        }
-    }
+  poll_notify(msgq->fds, CONFIG_FS_MQUEUE_NPOLLWAITERS, eventset);
 }
 
 /****************************************************************************
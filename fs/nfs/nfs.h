@@ -59,8 +59,16 @@
 #define NFS_MAXTIMEO       255            /* Max timeout to backoff to */
 #define NFS_MAXREXMIT      100            /* Stop counting after this many */
 #define NFS_RETRANS        10             /* Num of retrans for soft mounts */
-#define NFS_WSIZE          8192           /* Def. write data size <= 8192 */
-#define NFS_RSIZE          8192           /* Def. read data size <= 8192 */
+#ifdef CONFIG_NFS_WSIZE
+#  define NFS_WSIZE        CONFIG_NFS_WSIZE /* Def. write data size */
+#else
+#  define NFS_WSIZE        8192           /* Def. write data size <= 8192 */
+#endif
+#ifdef CONFIG_NFS_RSIZE
+#  define NFS_RSIZE        CONFIG_NFS_RSIZE /* Def. read data size */
+#else
+#  define NFS_RSIZE        8192           /* Def. read data size <= 8192 */
+#endif
 #define NFS_READDIRSIZE    1024           /* Def. readdir size */
 
 /* Ideally, NFS_DIRBLKSIZ should be bigger, but I've seen servers with
@@ -77,6 +85,10 @@
 #  define nfs_statistics(n)
 #endif
 
+#ifndef CONFIG_NFS_ATTRCACHE
+#  define nfs_namecache_invalidate(nmp)
+#endif
+
 /****************************************************************************
  *  Public Data
  ****************************************************************************/
@@ -125,6 +137,9 @@ EXTERN int nfs_finddir(FAR struct nfsmount *nmp, FAR const char *relpath,
               FAR struct nfs_fattr *attributes, FAR char *filename);
 EXTERN void nfs_attrupdate(FAR struct nfsnode *np,
               FAR struct nfs_fattr *attributes);
+#ifdef CONFIG_NFS_ATTRCACHE
+EXTERN void nfs_namecache_invalidate(FAR struct nfsmount *nmp);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
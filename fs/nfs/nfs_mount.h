@@ -61,6 +61,19 @@
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_NFS_ATTRCACHE
+/* One entry of the lookup and attribute cache of a mount */
+
+struct nfs_namecache_s
+{
+  FAR char                 *nc_path;          /* Path relative to the mountpoint, NULL if unused */
+  struct file_handle        nc_fhandle;       /* File handle of the path */
+  struct nfs_fattr          nc_fattr;         /* Attributes of the path */
+  clock_t                   nc_expire;        /* The entry is stale from then on */
+  clock_t                   nc_timeout;       /* Attribute timeout of the entry, in ticks */
+};
+#endif
+
 /* Mount structure. One mount structure is allocated for each NFS mount. This
  * structure holds NFS specific information for mount.
  */
@@ -79,6 +92,13 @@ struct nfsmount
   uint16_t                  nm_wsize;         /* Max size of write RPC */
   uint16_t                  nm_readdirsize;   /* Size of a readdir RPC */
   uint16_t                  nm_buflen;        /* Size of I/O buffer */
+#ifdef CONFIG_NFS_READDIRPLUS
+  bool                      nm_readdirplus;   /* The server supports READDIRPLUS */
+#endif
+#ifdef CONFIG_NFS_ATTRCACHE
+  uint8_t                   nm_ncnext;        /* Next name cache entry to replace */
+  struct nfs_namecache_s    nm_namecache[CONFIG_NFS_ATTRCACHE_NENTRIES];
+#endif
 
   /* Set aside memory on the stack to hold the largest call message.
    * NOTE that for the case of the write call message, it is the reply
@@ -95,6 +115,7 @@ struct nfsmount
     struct rpc_call_mkdir   mkdir;
     struct rpc_call_rmdir   rmdir;
     struct rpc_call_readdir readdir;
+    struct rpc_call_readdirplus readdirplus;
     struct rpc_call_fs      fsstat;
     struct rpc_call_setattr setattr;
     struct rpc_call_fs      fsinfo;
@@ -525,6 +525,15 @@ struct READDIR3args
   uint32_t           count;
 };
 
+struct READDIRPLUS3args
+{
+  struct file_handle dir;                           /* Variable length */
+  nfsuint64          cookie;
+  uint8_t            cookieverf[NFSX_V3COOKIEVERF];
+  uint32_t           dircount;
+  uint32_t           maxcount;
+};
+
 /* The READDIR reply is variable length and consists of multiple entries,
  *  each of form:
  *
@@ -535,6 +544,14 @@ struct READDIR3args
  *  Name string (variable size but in multiples of 4 bytes)
  *  Cookie (8 bytes)
  *  next entry (4 bytes)
+ *
+ * The READDIRPLUS reply has the same layout, except that the cookie of
+ * each entry is followed by:
+ *
+ *  Attributes follow indication (4 bytes)
+ *  Attributes (sizeof(struct nfs_fattr), if any)
+ *  Handle follows indication (4 bytes)
+ *  Handle length and handle (variable size, if any)
  */
 
 struct READDIR3resok
@@ -36,6 +36,9 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+
 #include "rpc.h"
 #include "nfs.h"
 #include "nfs_proto.h"
@@ -99,6 +102,140 @@ static inline int nfs_pathsegment(FAR const char **path, FAR char *buffer,
     }
 }
 
+/****************************************************************************
+ * Name: nfs_namecache_lookup
+ *
+ * Description:
+ *   Return the cached file handle and attributes of a path relative to the
+ *   mountpoint, if they are still fresh.
+ *
+ * Returned Value:
+ *   Zero on a hit; -ENOENT on a miss.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NFS_ATTRCACHE
+static int nfs_namecache_lookup(FAR struct nfsmount *nmp,
+                                FAR const char *relpath,
+                                FAR struct file_handle *fhandle,
+                                FAR struct nfs_fattr *attributes)
+{
+  FAR struct nfs_namecache_s *nc;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_NENTRIES; i++)
+    {
+      nc = &nmp->nm_namecache[i];
+      if (nc->nc_path != NULL && strcmp(nc->nc_path, relpath) == 0)
+        {
+          /* A stale entry is kept to adapt its timeout on the refresh */
+
+          if ((sclock_t)(now - nc->nc_expire) >= 0)
+            {
+              break;
+            }
+
+          memcpy(fhandle, &nc->nc_fhandle, sizeof(struct file_handle));
+          if (attributes)
+            {
+              memcpy(attributes, &nc->nc_fattr, sizeof(struct nfs_fattr));
+            }
+
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: nfs_namecache_insert
+ *
+ * Description:
+ *   Cache the file handle and attributes of a path.  When the attributes
+ *   of a refreshed entry are unchanged, its timeout is doubled up to the
+ *   maximum; otherwise it restarts from the minimum.
+ *
+ ****************************************************************************/
+
+static void nfs_namecache_insert(FAR struct nfsmount *nmp,
+                                 FAR const char *relpath,
+                                 FAR const struct file_handle *fhandle,
+                                 FAR const struct nfs_fattr *attributes)
+{
+  FAR struct nfs_namecache_s *nc = NULL;
+  clock_t mintimeout;
+  clock_t maxtimeout;
+  int i;
+
+  if (fxdr_unsigned(uint32_t, attributes->fa_type) == NFDIR)
+    {
+      mintimeout = SEC2TICK(CONFIG_NFS_ACDIRMIN);
+      maxtimeout = SEC2TICK(CONFIG_NFS_ACDIRMAX);
+    }
+  else
+    {
+      mintimeout = SEC2TICK(CONFIG_NFS_ACREGMIN);
+      maxtimeout = SEC2TICK(CONFIG_NFS_ACREGMAX);
+    }
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_NENTRIES; i++)
+    {
+      if (nmp->nm_namecache[i].nc_path != NULL &&
+          strcmp(nmp->nm_namecache[i].nc_path, relpath) == 0)
+        {
+          nc = &nmp->nm_namecache[i];
+          break;
+        }
+    }
+
+  if (nc != NULL &&
+      memcmp(&nc->nc_fattr.fa_mtime, &attributes->fa_mtime,
+             sizeof(nfstime3)) == 0 &&
+      memcmp(&nc->nc_fattr.fa_size, &attributes->fa_size,
+             sizeof(nfsuint64)) == 0)
+    {
+      nc->nc_timeout *= 2;
+      if (nc->nc_timeout > maxtimeout)
+        {
+          nc->nc_timeout = maxtimeout;
+        }
+    }
+  else
+    {
+      if (nc == NULL)
+        {
+          FAR char *path = strdup(relpath);
+
+          if (path == NULL)
+            {
+              return;
+            }
+
+          nc = &nmp->nm_namecache[nmp->nm_ncnext];
+          if (++nmp->nm_ncnext >= CONFIG_NFS_ATTRCACHE_NENTRIES)
+            {
+              nmp->nm_ncnext = 0;
+            }
+
+          if (nc->nc_path != NULL)
+            {
+              kmm_free(nc->nc_path);
+            }
+
+          nc->nc_path = path;
+        }
+
+      nc->nc_timeout = mintimeout;
+    }
+
+  memcpy(&nc->nc_fhandle, fhandle, sizeof(struct file_handle));
+  memcpy(&nc->nc_fattr, attributes, sizeof(struct nfs_fattr));
+  nc->nc_expire = clock_systime_ticks() + nc->nc_timeout;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -123,6 +260,28 @@ int nfs_request(FAR struct nfsmount *nmp, int procnum,
   struct nfs_reply_header replyh;
   int error;
 
+  /* Any request that may modify the server drops the cached attributes */
+
+  switch (procnum)
+    {
+      case NFSPROC_SETATTR:
+      case NFSPROC_WRITE:
+      case NFSPROC_CREATE:
+      case NFSPROC_MKDIR:
+      case NFSPROC_SYMLINK:
+      case NFSPROC_MKNOD:
+      case NFSPROC_REMOVE:
+      case NFSPROC_RMDIR:
+      case NFSPROC_RENAME:
+      case NFSPROC_LINK:
+      case NFSPROC_COMMIT:
+        nfs_namecache_invalidate(nmp);
+        break;
+
+      default:
+        break;
+    }
+
   error = rpcclnt_request(clnt, procnum, NFS_PROG, NFS_VER3,
                           request, reqlen, response, resplen);
   if (error != 0)
@@ -318,6 +477,7 @@ int nfs_findnode(FAR struct nfsmount *nmp, FAR const char *relpath,
                  FAR struct nfs_fattr *dir_attributes)
 {
   FAR const char *path = relpath;
+  struct nfs_fattr fattr;
   char            buffer[NAME_MAX + 1];
   char            terminator;
   uint32_t         tmp;
@@ -349,6 +509,23 @@ int nfs_findnode(FAR struct nfsmount *nmp, FAR const char *relpath,
       return OK;
     }
 
+  /* The attributes are needed to check the intermediate directories and
+   * to cache the result.
+   */
+
+  if (obj_attributes == NULL)
+    {
+      obj_attributes = &fattr;
+    }
+
+#ifdef CONFIG_NFS_ATTRCACHE
+  if (dir_attributes == NULL &&
+      nfs_namecache_lookup(nmp, relpath, fhandle, obj_attributes) == OK)
+    {
+      return OK;
+    }
+#endif
+
   /* This is not the root directory. Loop until the directory entry
    * corresponding to the path is found.
    */
@@ -390,6 +567,9 @@ int nfs_findnode(FAR struct nfsmount *nmp, FAR const char *relpath,
            * dir_attributes.
            */
 
+#ifdef CONFIG_NFS_ATTRCACHE
+          nfs_namecache_insert(nmp, relpath, fhandle, obj_attributes);
+#endif
           return OK;
         }
 
@@ -526,3 +706,30 @@ void nfs_attrupdate(FAR struct nfsnode *np, FAR struct nfs_fattr *attributes)
   fxdr_nfsv3time(&attributes->fa_mtime, &np->n_mtime);
   fxdr_nfsv3time(&attributes->fa_ctime, &np->n_ctime);
 }
+
+/****************************************************************************
+ * Name: nfs_namecache_invalidate
+ *
+ * Description:
+ *   Drop all the cached file handles and attributes of a mount.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NFS_ATTRCACHE
+void nfs_namecache_invalidate(FAR struct nfsmount *nmp)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_NENTRIES; i++)
+    {
+      if (nmp->nm_namecache[i].nc_path != NULL)
+        {
+          kmm_free(nmp->nm_namecache[i].nc_path);
+          nmp->nm_namecache[i].nc_path = NULL;
+        }
+    }
+}
+#endif
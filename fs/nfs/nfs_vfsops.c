@@ -1488,6 +1488,8 @@ static int nfs_readdir(FAR struct inode *mountpt,
   FAR uint32_t *ptr;
   FAR uint8_t *name;
   unsigned int length;
+  bool attrfollows;
+  int procnum;
   int reqlen;
   int ret;
 
@@ -1548,13 +1550,36 @@ read_dir:
 
   *ptr     = txdr_unsigned(readsize);
   reqlen  += sizeof(uint32_t);
+  procnum  = NFSPROC_READDIR;
+
+#ifdef CONFIG_NFS_READDIRPLUS
+  /* READDIRPLUS takes the size of the whole reply after the size of the
+   * directory information.
+   */
+
+  if (nmp->nm_readdirplus)
+    {
+      *++ptr   = txdr_unsigned(readsize);
+      reqlen  += sizeof(uint32_t);
+      procnum  = NFSPROC_READDIRPLUS;
+    }
+#endif
 
   /* And read the directory */
 
-  nfs_statistics(NFSPROC_READDIR);
-  ret = nfs_request(nmp, NFSPROC_READDIR,
+  nfs_statistics(procnum);
+  ret = nfs_request(nmp, procnum,
                     (FAR void *)&nmp->nm_msgbuffer.readdir, reqlen,
                     (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
+#ifdef CONFIG_NFS_READDIRPLUS
+  if (ret == -NFSERR_NOTSUPP && procnum == NFSPROC_READDIRPLUS)
+    {
+      finfo("READDIRPLUS not supported, falling back to READDIR\n");
+      nmp->nm_readdirplus = false;
+      goto read_dir;
+    }
+#endif
+
   if (ret != OK)
     {
       ferr("ERROR: nfs_request failed: %d\n", ret);
@@ -1651,6 +1676,27 @@ next_entry:
   dir->u.nfs.nfs_cookie[0] = *ptr++;
   dir->u.nfs.nfs_cookie[1] = *ptr++;
 
+  /* READDIRPLUS follows with the attributes and the handle of the entry */
+
+  attrfollows = false;
+  if (procnum == NFSPROC_READDIRPLUS)
+    {
+      tmp = *ptr++;
+      if (tmp != 0)
+        {
+          memcpy(&obj_attributes, ptr, sizeof(struct nfs_fattr));
+          ptr += uint32_increment(sizeof(struct nfs_fattr));
+          attrfollows = true;
+        }
+
+      tmp = *ptr++;
+      if (tmp != 0)
+        {
+          tmp  = fxdr_unsigned(uint32_t, *ptr++);
+          ptr += uint32_increment(tmp);
+        }
+    }
+
   /* Return the name of the node to the caller */
 
   if (length > NAME_MAX)
@@ -1672,14 +1718,18 @@ next_entry:
    * the file type.
    */
 
-  fhandle.length = (uint32_t)dir->u.nfs.nfs_fhsize;
-  memcpy(&fhandle.handle, dir->u.nfs.nfs_fhandle, fhandle.length);
-
-  ret = nfs_lookup(nmp, dir->fd_dir.d_name, &fhandle, &obj_attributes, NULL);
-  if (ret != OK)
+  if (!attrfollows)
     {
-      ferr("ERROR: nfs_lookup failed: %d\n", ret);
-      goto errout_with_semaphore;
+      fhandle.length = (uint32_t)dir->u.nfs.nfs_fhsize;
+      memcpy(&fhandle.handle, dir->u.nfs.nfs_fhandle, fhandle.length);
+
+      ret = nfs_lookup(nmp, dir->fd_dir.d_name, &fhandle,
+                       &obj_attributes, NULL);
+      if (ret != OK)
+        {
+          ferr("ERROR: nfs_lookup failed: %d\n", ret);
+          goto errout_with_semaphore;
+        }
     }
 
   /* Set the dirent file type */
@@ -2005,6 +2055,9 @@ static int nfs_bind(FAR struct inode *blkdriver, FAR const void *data,
   nmp->nm_wsize       = nprmt.wsize;
   nmp->nm_rsize       = nprmt.rsize;
   nmp->nm_readdirsize = nprmt.readdirsize;
+#ifdef CONFIG_NFS_READDIRPLUS
+  nmp->nm_readdirplus = true;
+#endif
 
   strlcpy(nmp->nm_path, argp->path, sizeof(nmp->nm_path));
   memcpy(&nmp->nm_nam, &argp->addr, argp->addrlen);
@@ -2127,6 +2180,7 @@ static int nfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   /* And free any allocated resources */
 
+  nfs_namecache_invalidate(nmp);
   nxsem_destroy(&nmp->nm_sem);
   kmm_free(nmp->nm_rpcclnt);
   kmm_free(nmp);
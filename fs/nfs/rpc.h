@@ -316,6 +316,12 @@ struct rpc_call_readdir
   struct READDIR3args readdir;
 };
 
+struct rpc_call_readdirplus
+{
+  struct rpc_call_header ch;
+  struct READDIRPLUS3args readdirplus;
+};
+
 struct rpc_call_setattr
 {
   struct rpc_call_header ch;
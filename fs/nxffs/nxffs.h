@@ -269,6 +269,19 @@ struct nxffs_wrfile_s
   uint32_t                  crc;        /* Accumulated data block CRC */
 };
 
+/* This structure describes one entry of the in-memory inode index.  It
+ * maps the name of a valid inode to the FLASH offset of its header.
+ */
+
+#ifdef CONFIG_NXFFS_INDEX
+struct nxffs_index_s
+{
+  FAR char                 *name;      /* Inode name, NULL if unused */
+  uint32_t                  hash;      /* CRC32 of the name */
+  off_t                     hoffset;   /* FLASH offset to the inode header */
+};
+#endif
+
 /* This structure represents the overall state of on NXFFS instance. */
 
 struct nxffs_volume_s
@@ -287,6 +300,20 @@ struct nxffs_volume_s
   FAR struct nxffs_ofile_s *ofiles;    /* A singly-linked list of open files */
   FAR uint8_t              *cache;     /* On cached erase block for general I/O */
   FAR uint8_t              *pack;      /* A full erase block to support packing */
+#ifdef CONFIG_NXFFS_RDCACHE
+
+  /* Read cache: copies of recently read blocks, the block number of each
+   * copy (-1 if unused) and the next copy to be replaced.
+   */
+
+  FAR uint8_t              *rdcache;
+  off_t                     rdblock[CONFIG_NXFFS_RDCACHE_NBLOCKS];
+  uint8_t                   rdnext;
+#endif
+#ifdef CONFIG_NXFFS_INDEX
+  FAR struct nxffs_index_s *index;     /* In-memory inode index */
+  bool                      indexed;   /* All valid inodes are in the index */
+#endif
 };
 
 /* This structure describes the state of the blocks on the NXFFS volume */
@@ -493,6 +520,29 @@ int nxffs_rdcache(FAR struct nxffs_volume_s *volume, off_t block);
 
 int nxffs_wrcache(FAR struct nxffs_volume_s *volume);
 
+/****************************************************************************
+ * Name: nxffs_invcache
+ *
+ * Description:
+ *   Discard the copies of FLASH blocks held in the read cache.  This must
+ *   be called whenever FLASH is modified other than via nxffs_wrcache().
+ *
+ * Input Parameters:
+ *   volume - Describes the current volume
+ *
+ * Returned Value:
+ *   None
+ *
+ * Defined in nxffs_cache.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_RDCACHE
+void nxffs_invcache(FAR struct nxffs_volume_s *volume);
+#else
+#  define nxffs_invcache(v)
+#endif
+
 /****************************************************************************
  * Name: nxffs_ioseek
  *
@@ -625,6 +675,106 @@ int nxffs_nextentry(FAR struct nxffs_volume_s *volume, off_t offset,
 int nxffs_findinode(FAR struct nxffs_volume_s *volume, FAR const char *name,
                     FAR struct nxffs_entry_s *entry);
 
+/****************************************************************************
+ * Name: nxffs_indexbuild
+ *
+ * Description:
+ *   (Re-)build the in-memory inode index by scanning all valid inodes on
+ *   the volume.  If there are more inodes than index entries, the index
+ *   only holds the first ones and lookups of other names fall back to
+ *   scanning FLASH.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *
+ * Returned Value:
+ *   None
+ *
+ * Defined in nxffs_index.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_INDEX
+void nxffs_indexbuild(FAR struct nxffs_volume_s *volume);
+#else
+#  define nxffs_indexbuild(v)
+#endif
+
+/****************************************************************************
+ * Name: nxffs_indexadd
+ *
+ * Description:
+ *   Record the FLASH offset of the inode header with the provided name,
+ *   replacing any previous offset recorded for that name.
+ *
+ * Input Parameters:
+ *   volume  - Describes the NXFFS volume
+ *   name    - The name of the inode
+ *   hoffset - FLASH offset to the inode header
+ *
+ * Returned Value:
+ *   None
+ *
+ * Defined in nxffs_index.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_INDEX
+void nxffs_indexadd(FAR struct nxffs_volume_s *volume,
+                    FAR const char *name, off_t hoffset);
+#else
+#  define nxffs_indexadd(v,n,h)
+#endif
+
+/****************************************************************************
+ * Name: nxffs_indexremove
+ *
+ * Description:
+ *   Remove the inode with the provided name from the index.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *   name   - The name of the inode
+ *
+ * Returned Value:
+ *   None
+ *
+ * Defined in nxffs_index.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_INDEX
+void nxffs_indexremove(FAR struct nxffs_volume_s *volume,
+                       FAR const char *name);
+#else
+#  define nxffs_indexremove(v,n)
+#endif
+
+/****************************************************************************
+ * Name: nxffs_indexfind
+ *
+ * Description:
+ *   Look up an inode in the index and read its header from FLASH.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *   name   - The name of the inode to find
+ *   entry  - The location to return information about the inode.
+ *
+ * Returned Value:
+ *   Zero is returned if the inode was found.  -ENOENT is returned if the
+ *   index is known to hold all inodes and the name is not among them.
+ *   -EAGAIN is returned if FLASH must be scanned to find the inode.
+ *
+ * Defined in nxffs_index.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_INDEX
+int nxffs_indexfind(FAR struct nxffs_volume_s *volume, FAR const char *name,
+                    FAR struct nxffs_entry_s *entry);
+#endif
+
 /****************************************************************************
  * Name: nxffs_inodeend
  *
@@ -29,11 +29,50 @@
 #include <debug.h>
 #include <inttypes.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <nuttx/mtd/mtd.h>
 
 #include "nxffs.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_RDCACHE
+#  define NXFFS_RDCOPY(v,i) (&(v)->rdcache[(size_t)(i) * (v)->geo.blocksize])
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_rdfind
+ *
+ * Description:
+ *   Return the index of the read cache copy of a block, or -1 if the block
+ *   is not cached.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_RDCACHE
+static int nxffs_rdfind(FAR struct nxffs_volume_s *volume, off_t block)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NXFFS_RDCACHE_NBLOCKS; i++)
+    {
+      if (volume->rdblock[i] == block)
+        {
+          return i;
+        }
+    }
+
+  return -1;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -62,6 +101,21 @@ int nxffs_rdcache(FAR struct nxffs_volume_s *volume, off_t block)
 
   if (block != volume->cblock)
     {
+#ifdef CONFIG_NXFFS_RDCACHE
+      int i;
+
+      /* A copy in the read cache saves reading FLASH again */
+
+      i = nxffs_rdfind(volume, block);
+      if (i >= 0)
+        {
+          memcpy(volume->cache, NXFFS_RDCOPY(volume, i),
+                 volume->geo.blocksize);
+          volume->cblock = block;
+          return OK;
+        }
+#endif
+
       /* Read the specified blocks into cache */
 
       nxfrd = MTD_BREAD(volume->mtd, block, 1, volume->cache);
@@ -72,6 +126,15 @@ int nxffs_rdcache(FAR struct nxffs_volume_s *volume, off_t block)
           return -EIO;
         }
 
+#ifdef CONFIG_NXFFS_RDCACHE
+      /* Keep a copy, replacing the copies in round-robin order */
+
+      i = volume->rdnext;
+      memcpy(NXFFS_RDCOPY(volume, i), volume->cache, volume->geo.blocksize);
+      volume->rdblock[i] = block;
+      volume->rdnext     = (i + 1) % CONFIG_NXFFS_RDCACHE_NBLOCKS;
+#endif
+
       /* Remember what is in the cache */
 
       volume->cblock  = block;
@@ -97,10 +160,32 @@ int nxffs_rdcache(FAR struct nxffs_volume_s *volume, off_t block)
 int nxffs_wrcache(FAR struct nxffs_volume_s *volume)
 {
   size_t nxfrd;
+#ifdef CONFIG_NXFFS_RDCACHE
+  int i;
+#endif
 
   /* Write the current block from the cache */
 
   nxfrd = MTD_BWRITE(volume->mtd, volume->cblock, 1, volume->cache);
+
+#ifdef CONFIG_NXFFS_RDCACHE
+  /* Keep any read cache copy of the block in sync with FLASH */
+
+  i = nxffs_rdfind(volume, volume->cblock);
+  if (i >= 0)
+    {
+      if (nxfrd == 1)
+        {
+          memcpy(NXFFS_RDCOPY(volume, i), volume->cache,
+                 volume->geo.blocksize);
+        }
+      else
+        {
+          volume->rdblock[i] = (off_t)-1;
+        }
+    }
+#endif
+
   if (nxfrd != 1)
     {
       ferr("ERROR: Write block %jd failed: %zu\n",
@@ -113,6 +198,30 @@ int nxffs_wrcache(FAR struct nxffs_volume_s *volume)
   return OK;
 }
 
+/****************************************************************************
+ * Name: nxffs_invcache
+ *
+ * Description:
+ *   Discard the copies of FLASH blocks held in the read cache.  This must
+ *   be called whenever FLASH is modified other than via nxffs_wrcache().
+ *
+ * Input Parameters:
+ *   volume - Describes the current volume
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_RDCACHE
+void nxffs_invcache(FAR struct nxffs_volume_s *volume)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NXFFS_RDCACHE_NBLOCKS; i++)
+    {
+      volume->rdblock[i] = (off_t)-1;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: nxffs_ioseek
  *
@@ -0,0 +1,302 @@
+/****************************************************************************
+ * fs/nxffs/nxffs_index.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <crc32.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+
+#include "nxffs.h"
+
+#ifdef CONFIG_NXFFS_INDEX
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_indexhash
+ *
+ * Description:
+ *   Return the hash of an inode name.
+ *
+ ****************************************************************************/
+
+static uint32_t nxffs_indexhash(FAR const char *name)
+{
+  return crc32((FAR const uint8_t *)name, strlen(name));
+}
+
+/****************************************************************************
+ * Name: nxffs_indexslot
+ *
+ * Description:
+ *   Return the index entry holding the provided name, or NULL if there is
+ *   no such entry.
+ *
+ ****************************************************************************/
+
+static FAR struct nxffs_index_s *
+nxffs_indexslot(FAR struct nxffs_volume_s *volume, FAR const char *name,
+                uint32_t hash)
+{
+  FAR struct nxffs_index_s *slot;
+  int i;
+
+  for (i = 0; i < CONFIG_NXFFS_INDEX_NENTRIES; i++)
+    {
+      slot = &volume->index[i];
+      if (slot->name != NULL && slot->hash == hash &&
+          strcmp(slot->name, name) == 0)
+        {
+          return slot;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: nxffs_indexfree
+ *
+ * Description:
+ *   Release an index entry.
+ *
+ ****************************************************************************/
+
+static void nxffs_indexfree(FAR struct nxffs_index_s *slot)
+{
+  kmm_free(slot->name);
+  slot->name = NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_indexbuild
+ *
+ * Description:
+ *   (Re-)build the in-memory inode index by scanning all valid inodes on
+ *   the volume.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *
+ ****************************************************************************/
+
+void nxffs_indexbuild(FAR struct nxffs_volume_s *volume)
+{
+  struct nxffs_entry_s entry;
+  off_t offset;
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_NXFFS_INDEX_NENTRIES; i++)
+    {
+      if (volume->index[i].name != NULL)
+        {
+          nxffs_indexfree(&volume->index[i]);
+        }
+    }
+
+  /* The index is complete unless nxffs_indexadd() runs out of entries or
+   * the scan fails.
+   */
+
+  volume->indexed = true;
+
+  for (offset = volume->inoffset; ; )
+    {
+      ret = nxffs_nextentry(volume, offset, &entry);
+      if (ret < 0)
+        {
+          if (ret != -ENOENT)
+            {
+              ferr("ERROR: nxffs_nextentry failed: %d\n", -ret);
+              volume->indexed = false;
+            }
+
+          break;
+        }
+
+      /* Like nxffs_findinode(), keep the first inode found with a name */
+
+      if (nxffs_indexslot(volume, entry.name,
+                          nxffs_indexhash(entry.name)) == NULL)
+        {
+          nxffs_indexadd(volume, entry.name, entry.hoffset);
+        }
+
+      offset = nxffs_inodeend(volume, &entry);
+      nxffs_freeentry(&entry);
+    }
+
+  finfo("Index %s\n", volume->indexed ? "complete" : "partial");
+}
+
+/****************************************************************************
+ * Name: nxffs_indexadd
+ *
+ * Description:
+ *   Record the FLASH offset of the inode header with the provided name,
+ *   replacing any previous offset recorded for that name.
+ *
+ * Input Parameters:
+ *   volume  - Describes the NXFFS volume
+ *   name    - The name of the inode
+ *   hoffset - FLASH offset to the inode header
+ *
+ ****************************************************************************/
+
+void nxffs_indexadd(FAR struct nxffs_volume_s *volume,
+                    FAR const char *name, off_t hoffset)
+{
+  FAR struct nxffs_index_s *slot;
+  uint32_t hash = nxffs_indexhash(name);
+  size_t namlen;
+  int i;
+
+  slot = nxffs_indexslot(volume, name, hash);
+  if (slot == NULL)
+    {
+      /* Find an unused entry */
+
+      for (i = 0; i < CONFIG_NXFFS_INDEX_NENTRIES; i++)
+        {
+          if (volume->index[i].name == NULL)
+            {
+              slot = &volume->index[i];
+              break;
+            }
+        }
+
+      namlen = strlen(name);
+      if (slot != NULL)
+        {
+          slot->name = kmm_malloc(namlen + 1);
+        }
+
+      if (slot == NULL || slot->name == NULL)
+        {
+          /* The name cannot be indexed, so lookups of names that are not
+           * in the index must scan FLASH from now on.
+           */
+
+          finfo("Index full, '%s' not indexed\n", name);
+          volume->indexed = false;
+          return;
+        }
+
+      memcpy(slot->name, name, namlen + 1);
+      slot->hash = hash;
+    }
+
+  slot->hoffset = hoffset;
+}
+
+/****************************************************************************
+ * Name: nxffs_indexremove
+ *
+ * Description:
+ *   Remove the inode with the provided name from the index.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *   name   - The name of the inode
+ *
+ ****************************************************************************/
+
+void nxffs_indexremove(FAR struct nxffs_volume_s *volume,
+                       FAR const char *name)
+{
+  FAR struct nxffs_index_s *slot;
+
+  slot = nxffs_indexslot(volume, name, nxffs_indexhash(name));
+  if (slot != NULL)
+    {
+      nxffs_indexfree(slot);
+    }
+}
+
+/****************************************************************************
+ * Name: nxffs_indexfind
+ *
+ * Description:
+ *   Look up an inode in the index and read its header from FLASH.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *   name   - The name of the inode to find
+ *   entry  - The location to return information about the inode.
+ *
+ * Returned Value:
+ *   Zero is returned if the inode was found.  -ENOENT is returned if the
+ *   index is known to hold all inodes and the name is not among them.
+ *   -EAGAIN is returned if FLASH must be scanned to find the inode.
+ *
+ ****************************************************************************/
+
+int nxffs_indexfind(FAR struct nxffs_volume_s *volume, FAR const char *name,
+                    FAR struct nxffs_entry_s *entry)
+{
+  FAR struct nxffs_index_s *slot;
+  int ret;
+
+  slot = nxffs_indexslot(volume, name, nxffs_indexhash(name));
+  if (slot == NULL)
+    {
+      return volume->indexed ? -ENOENT : -EAGAIN;
+    }
+
+  /* Read the inode header at the recorded offset, verifying its CRC */
+
+  ret = nxffs_nextentry(volume, slot->hoffset, entry);
+  if (ret == OK)
+    {
+      if (entry->hoffset == slot->hoffset &&
+          strcmp(entry->name, name) == 0)
+        {
+          return OK;
+        }
+
+      nxffs_freeentry(entry);
+    }
+
+  /* The entry is stale.  Drop it and let the caller scan FLASH */
+
+  fwarn("WARNING: Stale index entry for '%s'\n", name);
+  nxffs_indexfree(slot);
+  return -EAGAIN;
+}
+
+#endif /* CONFIG_NXFFS_INDEX */
@@ -210,6 +210,36 @@ int nxffs_initialize(FAR struct mtd_dev_s *mtd)
       goto errout_with_cache;
     }
 
+#ifdef CONFIG_NXFFS_RDCACHE
+  /* Allocate the copies of recently read blocks */
+
+  volume->rdcache = (FAR uint8_t *)
+    kmm_malloc(CONFIG_NXFFS_RDCACHE_NBLOCKS * volume->geo.blocksize);
+  if (!volume->rdcache)
+    {
+      ferr("ERROR: Failed to allocate the read cache\n");
+      ret = -ENOMEM;
+      goto errout_with_buffer;
+    }
+
+  nxffs_invcache(volume);
+#endif
+
+#ifdef CONFIG_NXFFS_INDEX
+  /* Allocate the in-memory inode index.  It is filled in once the file
+   * system limits are known.
+   */
+
+  volume->index = (FAR struct nxffs_index_s *)
+    kmm_zalloc(CONFIG_NXFFS_INDEX_NENTRIES * sizeof(struct nxffs_index_s));
+  if (!volume->index)
+    {
+      ferr("ERROR: Failed to allocate the inode index\n");
+      ret = -ENOMEM;
+      goto errout_with_buffer;
+    }
+#endif
+
   /* Get the number of R/W blocks per erase block and the total number o
    * R/W blocks
    */
@@ -263,6 +293,7 @@ int nxffs_initialize(FAR struct mtd_dev_s *mtd)
   ret = nxffs_limits(volume);
   if (ret == OK)
     {
+      nxffs_indexbuild(volume);
       return OK;
     }
 
@@ -292,6 +323,7 @@ int nxffs_initialize(FAR struct mtd_dev_s *mtd)
   ret = nxffs_limits(volume);
   if (ret == OK)
     {
+      nxffs_indexbuild(volume);
       return OK;
     }
 
@@ -300,6 +332,20 @@ int nxffs_initialize(FAR struct mtd_dev_s *mtd)
   ferr("ERROR: Failed to calculate file system limits: %d\n", -ret);
 
 errout_with_buffer:
+#ifdef CONFIG_NXFFS_INDEX
+  if (volume->index)
+    {
+      kmm_free(volume->index);
+    }
+#endif
+
+#ifdef CONFIG_NXFFS_RDCACHE
+  if (volume->rdcache)
+    {
+      kmm_free(volume->rdcache);
+    }
+#endif
+
   kmm_free(volume->pack);
 errout_with_cache:
   kmm_free(volume->cache);
@@ -369,6 +369,18 @@ int nxffs_findinode(FAR struct nxffs_volume_s *volume, FAR const char *name,
   off_t offset;
   int ret;
 
+#ifdef CONFIG_NXFFS_INDEX
+  /* Try the in-memory index first.  It goes to the inode header directly
+   * and knows when a name does not exist at all.
+   */
+
+  ret = nxffs_indexfind(volume, name, entry);
+  if (ret != -EAGAIN)
+    {
+      return ret;
+    }
+#endif
+
   /* Start with the first valid inode that was discovered when the volume
    * was created (or modified after the last file system re-packing).
    */
@@ -397,6 +409,7 @@ int nxffs_findinode(FAR struct nxffs_volume_s *volume, FAR const char *name,
         {
           /* Yes, return success with the entry data in 'entry' */
 
+          nxffs_indexadd(volume, name, entry->hoffset);
           return OK;
         }
 
@@ -107,6 +107,7 @@ int nxffs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
       /* Command not recognized, forward to the MTD driver */
 
       ret = MTD_IOCTL(volume->mtd, cmd, arg);
+      nxffs_invcache(volume);
     }
 
 errout_with_semaphore:
@@ -1596,6 +1596,7 @@ start_pack:
 
       ret = MTD_BWRITE(volume->mtd, pack.block0, volume->blkper,
                        volume->pack);
+      nxffs_invcache(volume);
       if (ret < 0)
         {
           ferr("ERROR: Failed to write erase block %jd [%jd]: %d\n",
@@ -1607,5 +1608,10 @@ start_pack:
 errout_with_pack:
   nxffs_freeentry(&pack.src.entry);
   nxffs_freeentry(&pack.dest.entry);
+
+  /* Packing moved inode headers, some without nxffs_wrinode() */
+
+  nxffs_invcache(volume);
+  nxffs_indexbuild(volume);
   return ret;
 }
@@ -273,6 +273,8 @@ int nxffs_reformat(FAR struct nxffs_volume_s *volume)
   /* Erase and reformat the entire volume */
 
   ret = nxffs_format(volume);
+  nxffs_invcache(volume);
+  nxffs_indexbuild(volume);
   if (ret < 0)
     {
       ferr("ERROR: Failed to reformat the volume: %d\n", -ret);
@@ -65,10 +65,16 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations irq_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
+extern const struct procfs_operations crithist_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations memdump_operations;
+extern const struct procfs_operations memtrace_operations;
 extern const struct procfs_operations iobinfo_operations;
+extern const struct procfs_operations slabinfo_operations;
+extern const struct procfs_operations lockstat_operations;
 extern const struct procfs_operations module_operations;
+extern const struct procfs_operations profile_operations;
+extern const struct procfs_operations snapshot_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
 extern const struct procfs_operations tcbinfo_operations;
@@ -83,7 +89,10 @@ extern const struct procfs_operations net_procfsoperations;
 extern const struct procfs_operations net_procfs_routeoperations;
 extern const struct procfs_operations part_procfsoperations;
 extern const struct procfs_operations mount_procfsoperations;
+extern const struct procfs_operations blkcache_operations;
+extern const struct procfs_operations iostat_operations;
 extern const struct procfs_operations smartfs_procfsoperations;
+extern const struct procfs_operations spiffs_procfsoperations;
 
 /****************************************************************************
  * Private Types
@@ -110,21 +119,38 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "critmon",       &critmon_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SCHED_CRITMONITOR_HISTOGRAM)
+  { "crithist",      &crithist_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #ifdef CONFIG_SCHED_IRQMONITOR
   { "irqs",          &irq_operations,             PROCFS_FILE_TYPE   },
 #endif
 
+#if (defined(CONFIG_SMP_CSECTION_STATS) || \
+     defined(CONFIG_SEM_HOLDER_STATS)) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_LOCKSTAT)
+  { "lockstat",      &lockstat_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
   { "meminfo",       &meminfo_operations,         PROCFS_FILE_TYPE   },
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMDUMP
   { "memdump",       &memdump_operations,         PROCFS_FILE_TYPE   },
 #endif
+#ifdef CONFIG_MM_TRACE
+  { "memtrace",      &memtrace_operations,        PROCFS_FILE_TYPE   },
+#endif
 #endif
 
 #if defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
   { "iobinfo",       &iobinfo_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_MM_SLAB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SLABINFO)
+  { "slabinfo",      &slabinfo_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MODULE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MODULE)
   { "modules",       &module_operations,          PROCFS_FILE_TYPE   },
 #endif
@@ -133,6 +159,14 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "fs/blocks",     &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_FS_BLKCACHE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_BLKCACHE)
+  { "fs/blkcache",   &blkcache_operations,        PROCFS_FILE_TYPE   },
+#endif
+
+#if defined(CONFIG_FS_IOSTAT) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOSTAT)
+  { "fs/iostat",     &iostat_operations,          PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MOUNT
   { "fs/mount",      &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
@@ -145,6 +179,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "fs/smartfs**",  &smartfs_procfsoperations,   PROCFS_UNKOWN_TYPE },
 #endif
 
+#if defined(CONFIG_FS_SPIFFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SPIFFS)
+  { "fs/spiffs",     &spiffs_procfsoperations,    PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_NET) && !defined(CONFIG_FS_PROCFS_EXCLUDE_NET)
   { "net",           &net_procfsoperations,       PROCFS_DIR_TYPE    },
 #if defined(CONFIG_NET_ROUTE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_ROUTE)
@@ -158,11 +196,19 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "partitions",    &part_procfsoperations,      PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SCHED_PROFILE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_PROFILE)
+  { "profile",       &profile_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_PROCESS
   { "self",          &proc_operations,            PROCFS_DIR_TYPE    },
   { "self/**",       &proc_operations,            PROCFS_UNKOWN_TYPE },
 #endif
 
+#if !defined(CONFIG_FS_PROCFS_EXCLUDE_SNAPSHOT)
+  { "snapshot",      &snapshot_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_UPTIME)
   { "uptime",        &uptime_operations,          PROCFS_FILE_TYPE   },
 #endif
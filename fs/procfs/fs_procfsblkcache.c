@@ -0,0 +1,293 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsblkcache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/fs/blkcache.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_FS_BLKCACHE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_BLKCACHE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the whole output generated by this logic.
+ */
+
+#define BLKCACHE_LINELEN 192
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct blkcache_file_s
+{
+  struct procfs_file_s base;     /* Base open file structure */
+  unsigned int linesize;         /* Number of valid characters in line[] */
+  char line[BLKCACHE_LINELEN];   /* Pre-allocated buffer for the output */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     blkcache_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     blkcache_close(FAR struct file *filep);
+static ssize_t blkcache_procread(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+static int     blkcache_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+
+static int     blkcache_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations blkcache_operations =
+{
+  blkcache_open,       /* open */
+  blkcache_close,      /* close */
+  blkcache_procread,   /* read */
+  NULL,                /* write */
+
+  blkcache_dup,        /* dup */
+
+  NULL,                /* opendir */
+  NULL,                /* closedir */
+  NULL,                /* readdir */
+  NULL,                /* rewinddir */
+
+  blkcache_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blkcache_open
+ ****************************************************************************/
+
+static int blkcache_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct blkcache_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct blkcache_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_close
+ ****************************************************************************/
+
+static int blkcache_close(FAR struct file *filep)
+{
+  FAR struct blkcache_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct blkcache_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_procread
+ ****************************************************************************/
+
+static ssize_t blkcache_procread(FAR struct file *filep, FAR char *buffer,
+                                 size_t buflen)
+{
+  FAR struct blkcache_file_s *attr;
+  struct blkcache_stats_s stats;
+  off_t offset;
+  ssize_t ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct blkcache_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Sample the counters only once so that they stay consistent if the
+   * user reads the file in small pieces.
+   */
+
+  if (filep->f_pos == 0)
+    {
+      blkcache_stats(&stats);
+
+      attr->linesize =
+        procfs_snprintf(attr->line, BLKCACHE_LINELEN,
+                        "Pages:      %u x %u bytes\n"
+                        "Used:       %u\n"
+                        "Dirty:      %u\n"
+                        "Hits:       %lu\n"
+                        "Misses:     %lu\n"
+                        "Writebacks: %lu\n"
+                        "Bypasses:   %lu\n"
+                        "Readahead:  %lu\n",
+                        stats.npages, stats.pagesize, stats.nused,
+                        stats.ndirty, (unsigned long)stats.hits,
+                        (unsigned long)stats.misses,
+                        (unsigned long)stats.writebacks,
+                        (unsigned long)stats.bypasses,
+                        (unsigned long)stats.readaheads);
+    }
+
+  /* Transfer the statistics to user receive buffer */
+
+  offset = filep->f_pos;
+  ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+  /* Update the file offset */
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int blkcache_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct blkcache_file_s *oldattr;
+  FAR struct blkcache_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct blkcache_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct blkcache_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct blkcache_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int blkcache_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "fs/blkcache" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_FS_BLKCACHE && !CONFIG_FS_PROCFS_EXCLUDE_BLKCACHE */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -39,6 +39,7 @@
 #include <debug.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
@@ -56,6 +57,14 @@
 
 #define CRITMON_LINELEN 64
 
+/* The kinds of histograms reported in /proc/crithist */
+
+#define CRITHIST_PREEMPTION 0
+#define CRITHIST_CSECTION   1
+#define CRITHIST_IRQ        2
+#define CRITHIST_WAKEUP     3
+#define CRITHIST_NKINDS     4
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -69,6 +78,19 @@ struct critmon_file_s
   char line[CRITMON_LINELEN];   /* Pre-allocated buffer for formatted lines */
 };
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/* This structure describes one open "crithist" file.  The histograms are
+ * sampled and reset when the file is read from its beginning so that
+ * the output stays consistent if it is read in small pieces.
+ */
+
+struct crithist_file_s
+{
+  struct procfs_file_s  base;   /* Base open file structure */
+  struct critmon_hist_s hist[CONFIG_SMP_NCPUS][CRITHIST_NKINDS];
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -84,6 +106,30 @@ static int     critmon_dup(FAR const struct file *oldp,
                  FAR struct file *newp);
 static int     critmon_stat(FAR const char *relpath, FAR struct stat *buf);
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static int     crithist_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     crithist_close(FAR struct file *filep);
+static ssize_t crithist_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     crithist_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static FAR const char * const g_crithist_kinds[CRITHIST_NKINDS] =
+{
+  "preemption",
+  "csection",
+  "irq",
+  "wakeup"
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -110,6 +156,25 @@ const struct procfs_operations critmon_operations =
   critmon_stat        /* stat */
 };
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+const struct procfs_operations crithist_operations =
+{
+  crithist_open,      /* open */
+  crithist_close,     /* close */
+  crithist_read,      /* read */
+  NULL,               /* write */
+
+  crithist_dup,       /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  critmon_stat        /* stat */
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -349,8 +414,301 @@ static int critmon_stat(const char *relpath, struct stat *buf)
   return OK;
 }
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+
+/****************************************************************************
+ * Name: crithist_open
+ ****************************************************************************/
+
+static int crithist_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct crithist_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct crithist_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: crithist_close
+ ****************************************************************************/
+
+static int crithist_close(FAR struct file *filep)
+{
+  FAR struct crithist_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct crithist_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: crithist_bounds
+ *
+ * Description:
+ *   Generate the first line of /proc/crithist:  the upper bound of each
+ *   histogram bucket.
+ *
+ ****************************************************************************/
+
+static size_t crithist_bounds(FAR char *buffer, size_t buflen,
+                              FAR off_t *offset)
+{
+  struct timespec bound;
+  char line[CRITMON_LINELEN];
+  size_t linesize;
+  size_t totalsize;
+  int shift;
+  int i;
+
+  totalsize = procfs_memcpy("bounds", 6, buffer, buflen, offset);
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_HISTOGRAM_NBUCKETS; i++)
+    {
+      if (totalsize >= buflen)
+        {
+          return totalsize;
+        }
+
+      /* Bucket i holds the durations below 2^(SHIFT + i), the last bucket
+       * and the buckets beyond the range of the timer are unbounded.
+       */
+
+      shift = CONFIG_SCHED_CRITMONITOR_HISTOGRAM_SHIFT + i;
+      if (i < CONFIG_SCHED_CRITMONITOR_HISTOGRAM_NBUCKETS - 1 && shift < 32)
+        {
+          up_perf_convert((uint32_t)1 << shift, &bound);
+          linesize = procfs_snprintf(line, CRITMON_LINELEN, ",%lu.%09lu",
+                                     (unsigned long)bound.tv_sec,
+                                     (unsigned long)bound.tv_nsec);
+        }
+      else
+        {
+          linesize = procfs_snprintf(line, CRITMON_LINELEN, ",inf");
+        }
+
+      totalsize += procfs_memcpy(line, linesize, buffer + totalsize,
+                                 buflen - totalsize, offset);
+    }
+
+  if (totalsize < buflen)
+    {
+      totalsize += procfs_memcpy("\n", 1, buffer + totalsize,
+                                 buflen - totalsize, offset);
+    }
+
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: crithist_read
+ ****************************************************************************/
+
+static ssize_t crithist_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct crithist_file_s *attr;
+  char prefix[CRITMON_LINELEN];
+  irqstate_t flags;
+  off_t offset;
+  size_t ret;
+  int kind;
+  int cpu;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct crithist_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Sample and reset the histograms when reading from the beginning */
+
+  if (filep->f_pos == 0)
+    {
+      flags = enter_critical_section();
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          attr->hist[cpu][CRITHIST_PREEMPTION] = g_premp_hist[cpu];
+          attr->hist[cpu][CRITHIST_CSECTION]   = g_crit_hist[cpu];
+          attr->hist[cpu][CRITHIST_IRQ]        = g_irq_hist[cpu];
+          attr->hist[cpu][CRITHIST_WAKEUP]     = g_wakeup_hist[cpu];
+        }
+
+      memset(g_premp_hist, 0, sizeof(g_premp_hist));
+      memset(g_crit_hist, 0, sizeof(g_crit_hist));
+      memset(g_irq_hist, 0, sizeof(g_irq_hist));
+      memset(g_wakeup_hist, 0, sizeof(g_wakeup_hist));
+      leave_critical_section(flags);
+    }
+
+  offset = filep->f_pos;
+  ret    = crithist_bounds(buffer, buflen, &offset);
+
+  /* Then one line for each kind of histogram of each CPU */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS && ret < buflen; cpu++)
+    {
+      for (kind = 0; kind < CRITHIST_NKINDS && ret < buflen; kind++)
+        {
+          procfs_snprintf(prefix, CRITMON_LINELEN, "%d,%s",
+                          cpu, g_crithist_kinds[kind]);
+          ret += procfs_crithist(prefix, &attr->hist[cpu][kind],
+                                 buffer + ret, buflen - ret, &offset);
+        }
+    }
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: crithist_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int crithist_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct crithist_file_s *oldattr;
+  FAR struct crithist_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct crithist_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct crithist_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct crithist_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+#endif /* CONFIG_SCHED_CRITMONITOR_HISTOGRAM */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: procfs_crithist
+ *
+ * Description:
+ *   Generate one line describing a latency histogram of the critical
+ *   section monitor.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+size_t procfs_crithist(FAR const char *prefix,
+                       FAR const struct critmon_hist_s *hist,
+                       FAR char *buffer, size_t buflen, FAR off_t *offset)
+{
+  struct timespec maxtime;
+  char line[CRITMON_LINELEN];
+  size_t linesize;
+  size_t totalsize;
+  int i;
+
+  /* The prefix, the longest duration and its code location */
+
+  if (hist->max > 0)
+    {
+      up_perf_convert(hist->max, &maxtime);
+    }
+  else
+    {
+      maxtime.tv_sec = 0;
+      maxtime.tv_nsec = 0;
+    }
+
+  totalsize = procfs_memcpy(prefix, strlen(prefix), buffer, buflen,
+                            offset);
+  if (totalsize >= buflen)
+    {
+      return totalsize;
+    }
+
+  linesize   = procfs_snprintf(line, CRITMON_LINELEN, ",%lu.%09lu,%p",
+                               (unsigned long)maxtime.tv_sec,
+                               (unsigned long)maxtime.tv_nsec,
+                               hist->maxip);
+  totalsize += procfs_memcpy(line, linesize, buffer + totalsize,
+                             buflen - totalsize, offset);
+
+  /* Then the count of each bucket */
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_HISTOGRAM_NBUCKETS; i++)
+    {
+      if (totalsize >= buflen)
+        {
+          return totalsize;
+        }
+
+      linesize   = procfs_snprintf(line, CRITMON_LINELEN, ",%lu",
+                                   (unsigned long)hist->count[i]);
+      totalsize += procfs_memcpy(line, linesize, buffer + totalsize,
+                                 buflen - totalsize, offset);
+    }
+
+  if (totalsize < buflen)
+    {
+      totalsize += procfs_memcpy("\n", 1, buffer + totalsize,
+                                 buflen - totalsize, offset);
+    }
+
+  return totalsize;
+}
+#endif
+
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_SCHED_CRITMONITOR */
@@ -91,6 +91,15 @@ static int     iobinfo_stat(FAR const char *relpath, FAR struct stat *buf);
  * logic found in the enum iob_user_e declaration found in iob.h
  */
 
+#ifdef IOB_HAVE_CLASSES
+static FAR const char *g_iob_class_names[IOB_NCLASSES] =
+{
+  "small",
+  "default",
+  "large"
+};
+#endif
+
 static FAR const char *g_iob_user_names[] =
 {
 #ifdef CONFIG_SYSLOG_BUFFER
@@ -155,6 +164,12 @@ static FAR const char *g_iob_user_names[] =
 #endif
 #ifdef CONFIG_NET_CAN
   "can",
+#endif
+#ifdef CONFIG_NETDEV_IOB
+  "netdev",
+#endif
+#if defined(CONFIG_NET_ARP) && CONFIG_NET_ARP_NHOLD > 0
+  "arp_hold",
 #endif
   "global",
 };
@@ -254,6 +269,9 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct iobinfo_file_s *iobfile;
   FAR struct iob_userstats_s *userstats;
+#ifdef IOB_HAVE_CLASSES
+  struct iob_classstats_s classstats;
+#endif
   size_t linesize;
   size_t copysize;
   size_t totalsize;
@@ -332,6 +350,47 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
       totalsize += copysize;
     }
 
+#ifdef IOB_HAVE_CLASSES
+  /* Then the usage of each buffer class */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(iobfile->line, IOBINFO_LINELEN,
+                                   "\n%-10s%8s%10s%10s%12s%12s\n",
+                                   "CLASS", "BUFSIZE", "NBUFFERS",
+                                   "NAVAIL", "NALLOC", "NSPILL");
+
+      copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (i = 0; i < IOB_NCLASSES; i++)
+    {
+      if (totalsize < buflen && iob_getclassstats(i, &classstats) >= 0)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = procfs_snprintf(iobfile->line, IOBINFO_LINELEN,
+                                       "%-10s%8u%10d%10d%12u%12u\n",
+                                       g_iob_class_names[i],
+                                       classstats.bufsize,
+                                       classstats.nbuffers,
+                                       classstats.navail,
+                                       classstats.nalloc,
+                                       classstats.nspill);
+
+          copysize   = procfs_memcpy(iobfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
@@ -0,0 +1,320 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsiostat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/fs/iostat.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_FS_IOSTAT) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOSTAT)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the whole output generated by this logic.
+ */
+
+#define IOSTAT_LINELEN 1024
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct iostat_file_s
+{
+  struct procfs_file_s base;     /* Base open file structure */
+  unsigned int linesize;         /* Number of valid characters in line[] */
+  char line[IOSTAT_LINELEN];     /* Pre-allocated buffer for the output */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     iostat_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     iostat_close(FAR struct file *filep);
+static ssize_t iostat_procread(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+static int     iostat_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+
+static int     iostat_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations iostat_operations =
+{
+  iostat_open,         /* open */
+  iostat_close,        /* close */
+  iostat_procread,     /* read */
+  NULL,                /* write */
+
+  iostat_dup,          /* dup */
+
+  NULL,                /* opendir */
+  NULL,                /* closedir */
+  NULL,                /* readdir */
+  NULL,                /* rewinddir */
+
+  iostat_stat          /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iostat_usec
+ *
+ * Description:
+ *   Convert counts of the performance counter to microseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t iostat_usec(uint64_t time, uint32_t freq)
+{
+  if (freq == 0)
+    {
+      return 0;
+    }
+
+  return (time / freq) * USEC_PER_SEC +
+         ((time % freq) * USEC_PER_SEC) / freq;
+}
+
+/****************************************************************************
+ * Name: iostat_open
+ ****************************************************************************/
+
+static int iostat_open(FAR struct file *filep, FAR const char *relpath,
+                       int oflags, mode_t mode)
+{
+  FAR struct iostat_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct iostat_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: iostat_close
+ ****************************************************************************/
+
+static int iostat_close(FAR struct file *filep)
+{
+  FAR struct iostat_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct iostat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: iostat_procread
+ ****************************************************************************/
+
+static ssize_t iostat_procread(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  FAR struct iostat_file_s *attr;
+  struct fs_iostat_s stats[FS_IOSTAT_NOPS];
+  uint32_t freq;
+  off_t offset;
+  ssize_t ret;
+  int op;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct iostat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Sample the counters only once so that they stay consistent if the
+   * user reads the file in small pieces.
+   */
+
+  if (filep->f_pos == 0)
+    {
+      fs_iostat_get(stats);
+      freq = up_perf_getfreq();
+
+      attr->linesize =
+        procfs_snprintf(attr->line, IOSTAT_LINELEN,
+                        "%-10s %10s %6s %12s %12s %10s\n",
+                        "OP", "COUNT", "ERRORS", "SIZE", "TIME(us)",
+                        "MAX(us)");
+
+      for (op = 0; op < FS_IOSTAT_NOPS; op++)
+        {
+          attr->linesize +=
+            procfs_snprintf(attr->line + attr->linesize,
+                            IOSTAT_LINELEN - attr->linesize,
+                            "%-10s %10" PRIu32 " %6" PRIu32 " %12" PRIu64
+                            " %12" PRIu64 " %10" PRIu64 "\n",
+                            fs_iostat_name(op), stats[op].count,
+                            stats[op].errors, stats[op].size,
+                            iostat_usec(stats[op].time, freq),
+                            iostat_usec(stats[op].maxtime, freq));
+        }
+    }
+
+  /* Transfer the statistics to user receive buffer */
+
+  offset = filep->f_pos;
+  ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+  /* Update the file offset */
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: iostat_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int iostat_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct iostat_file_s *oldattr;
+  FAR struct iostat_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct iostat_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct iostat_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct iostat_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: iostat_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int iostat_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "fs/iostat" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_FS_IOSTAT && !CONFIG_FS_PROCFS_EXCLUDE_IOSTAT */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
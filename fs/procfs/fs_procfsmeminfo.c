@@ -35,6 +35,7 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
+#include <syslog.h>
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
@@ -100,6 +101,12 @@ static ssize_t memdump_read(FAR struct file *filep, FAR char *buffer,
 static ssize_t memdump_write(FAR struct file *filep, FAR const char *buffer,
                              size_t buflen);
 #endif
+#ifdef CONFIG_MM_TRACE
+static ssize_t memtrace_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen);
+static ssize_t memtrace_write(FAR struct file *filep,
+                              FAR const char *buffer, size_t buflen);
+#endif
 static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
 static int     meminfo_dup(FAR const struct file *oldp,
@@ -145,6 +152,22 @@ const struct procfs_operations memdump_operations =
 };
 #endif
 
+#ifdef CONFIG_MM_TRACE
+const struct procfs_operations memtrace_operations =
+{
+  meminfo_open,   /* open */
+  meminfo_close,  /* close */
+  memtrace_read,  /* read */
+  memtrace_write, /* write */
+  meminfo_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  meminfo_stat    /* stat */
+};
+#endif
+
 FAR struct procfs_meminfo_entry_s *g_procfs_meminfo = NULL;
 
 /****************************************************************************
@@ -434,6 +457,14 @@ static ssize_t memdump_read(FAR struct file *filep, FAR char *buffer,
                               "used: dump all allocated node\n"
                               "free: dump all free node\n");
 
+  copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                             &offset);
+  totalsize += copysize;
+  buffer    += copysize;
+  buflen    -= copysize;
+  linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                               "frag: dump free chunk size histogram\n");
+
   totalsize += procfs_memcpy(procfile->line, linesize, buffer, buflen,
                              &offset);
   filep->f_pos += totalsize;
@@ -441,6 +472,43 @@ static ssize_t memdump_read(FAR struct file *filep, FAR char *buffer,
 }
 #endif
 
+/****************************************************************************
+ * Name: memdump_frag
+ *
+ * Description:
+ *   Dump the histogram of the free chunk sizes of one heap to the syslog.
+ *   The fragmentation is the part of the free space, in permille, that is
+ *   not in the largest free chunk.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMDUMP
+static void memdump_frag(FAR struct procfs_meminfo_entry_s *entry)
+{
+  struct mm_fraginfo_s info;
+  unsigned int frag = 0;
+  int ndx;
+
+  mm_fraginfo(entry->heap, &info);
+  if (info.freesize > 0)
+    {
+      frag = 1000 - ((uint64_t)info.largest * 1000) / info.freesize;
+    }
+
+  syslog(LOG_INFO, "%s: free=%zu nfree=%zu largest=%zu frag=%u\n",
+         entry->name, info.freesize, info.nfree, info.largest, frag);
+
+  for (ndx = 0; ndx < MM_FRAG_NBUCKETS; ndx++)
+    {
+      if (info.count[ndx] > 0)
+        {
+          syslog(LOG_INFO, "%12zu%12zu%12zu\n", (size_t)1 << ndx,
+                 info.count[ndx], info.size[ndx]);
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: memdump_write
  ****************************************************************************/
@@ -460,6 +528,16 @@ static ssize_t memdump_write(FAR struct file *filep, FAR const char *buffer,
   procfile = filep->f_priv;
   DEBUGASSERT(procfile);
 
+  if (strncmp(buffer, "frag", 4) == 0)
+    {
+      for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+        {
+          memdump_frag(entry);
+        }
+
+      return buflen;
+    }
+
 #ifdef CONFIG_MM_BACKTRACE
   if (strcmp(buffer, "on") == 0)
     {
@@ -505,6 +583,120 @@ static ssize_t memdump_write(FAR struct file *filep, FAR const char *buffer,
 }
 #endif
 
+/****************************************************************************
+ * Name: memtrace_read
+ *
+ * Description:
+ *   Show the call sites of the allocation tracer, one line with the
+ *   estimated live bytes, the live and total samples and the change since
+ *   the last snapshot, followed by a line with the backtrace.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_TRACE
+static ssize_t memtrace_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct meminfo_file_s *procfile;
+  struct mm_tracesite_s site;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int index;
+  int i;
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct meminfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  linesize  = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                              "%11s%8s%8s%12s\n",
+                              "live", "nlive", "nalloc", "delta");
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  for (index = 0; totalsize < buflen; index++)
+    {
+      int ret = mm_trace_getsite(index, &site);
+
+      if (ret == -EINVAL)
+        {
+          break;
+        }
+      else if (ret < 0)
+        {
+          continue;
+        }
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%11zu%8zu%8zu%12ld\n", site.live,
+                                   site.nlive, site.nalloc,
+                                   (long)(site.live - site.snapshot));
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                 buflen, &offset);
+      totalsize += copysize;
+
+      for (i = 0; i < CONFIG_MM_TRACE_DEPTH && totalsize < buflen; i++)
+        {
+          bool last = i + 1 == CONFIG_MM_TRACE_DEPTH ||
+                      site.backtrace[i + 1] == NULL;
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       " %p%s", site.backtrace[i],
+                                       last ? "\n" : "");
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+
+          if (last)
+            {
+              break;
+            }
+        }
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: memtrace_write
+ *
+ * Description:
+ *   "snapshot" remembers the live bytes of every call site, the delta
+ *   shown by memtrace_read is relative to them.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_TRACE
+static ssize_t memtrace_write(FAR struct file *filep,
+                              FAR const char *buffer, size_t buflen)
+{
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  if (buflen >= 8 && strncmp(buffer, "snapshot", 8) == 0)
+    {
+      mm_trace_snapshot();
+      return buflen;
+    }
+
+  return -EINVAL;
+}
+#endif
+
 /****************************************************************************
  * Name: meminfo_dup
  *
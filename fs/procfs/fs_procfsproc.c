@@ -53,6 +53,7 @@
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/fs/dirent.h>
 #include <nuttx/mm/mm.h>
+#include <nuttx/pmu.h>
 
 #if defined(CONFIG_SCHED_CPULOAD) || defined(CONFIG_SCHED_CRITMONITOR)
 #  include <nuttx/clock.h>
@@ -90,6 +91,12 @@ enum proc_node_e
 #ifdef CONFIG_SCHED_CRITMONITOR
   PROC_CRITMON,                       /* Critical section monitor */
 #endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  PROC_CRITHIST,                      /* Critical section histograms */
+#endif
+#ifdef CONFIG_SCHED_PMU
+  PROC_PMU,                           /* Hardware performance counters */
+#endif
 #ifdef CONFIG_DEBUG_MM
   PROC_HEAP,                          /* Task heap info */
 #endif
@@ -122,6 +129,9 @@ struct proc_file_s
   FAR const struct proc_node_s *node; /* Describes the file node */
   pid_t pid;                          /* Task/thread ID */
   char line[STATUS_LINELEN];          /* Pre-allocated buffer for formatted lines */
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  struct critmon_hist_s hist[3];      /* Histograms sampled by crithist */
+#endif
 };
 
 /* This structure describes one open "directory" */
@@ -149,9 +159,10 @@ struct proc_envinfo_s
  * Private Data
  ****************************************************************************/
 
-static FAR const char *g_policy[4] =
+static FAR const char *g_policy[5] =
 {
-  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC", "SCHED_OTHER"
+  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC", "SCHED_OTHER",
+  "SCHED_DEADLINE"
 };
 
 /****************************************************************************
@@ -178,6 +189,16 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
 #endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static ssize_t proc_crithist(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
+#ifdef CONFIG_SCHED_PMU
+static ssize_t proc_pmu(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 #ifdef CONFIG_MM_BACKTRACE
 static ssize_t proc_heap(FAR struct proc_file_s *procfile,
                          FAR struct tcb_s *tcb, FAR char *buffer,
@@ -279,6 +300,20 @@ static const struct proc_node_s g_critmon =
 };
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static const struct proc_node_s g_crithist =
+{
+  "crithist",      "crithist", (uint8_t)PROC_CRITHIST,   DTYPE_FILE        /* Critical Section Histograms */
+};
+#endif
+
+#ifdef CONFIG_SCHED_PMU
+static const struct proc_node_s g_pmu =
+{
+  "pmu",          "pmu",     (uint8_t)PROC_PMU,          DTYPE_FILE        /* Hardware performance counters */
+};
+#endif
+
 #ifdef CONFIG_DEBUG_MM
 static const struct proc_node_s g_heap =
 {
@@ -326,6 +361,12 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section Monitor */
 #endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  &g_crithist,     /* Critical section histograms */
+#endif
+#ifdef CONFIG_SCHED_PMU
+  &g_pmu,          /* Hardware performance counters */
+#endif
 #ifdef CONFIG_DEBUG_MM
   &g_heap,         /* Task heap info */
 #endif
@@ -352,6 +393,12 @@ static const struct proc_node_s * const g_level0info[] =
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section monitor */
 #endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  &g_crithist,     /* Critical section histograms */
+#endif
+#ifdef CONFIG_SCHED_PMU
+  &g_pmu,          /* Hardware performance counters */
+#endif
 #ifdef CONFIG_DEBUG_MM
   &g_heap,         /* Task heap info */
 #endif
@@ -900,6 +947,124 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_crithist
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+static ssize_t proc_crithist(FAR struct proc_file_s *procfile,
+                             FAR struct tcb_s *tcb, FAR char *buffer,
+                             size_t buflen, off_t offset)
+{
+  irqstate_t flags;
+  size_t totalsize;
+
+  /* Sample and reset the histograms when reading from the beginning so
+   * that the output stays consistent if it is read in small pieces.
+   */
+
+  if (offset == 0)
+    {
+      flags = enter_critical_section();
+      procfile->hist[0] = tcb->premp_hist;
+      procfile->hist[1] = tcb->crit_hist;
+      procfile->hist[2] = tcb->wakeup_hist;
+
+      memset(&tcb->premp_hist, 0, sizeof(tcb->premp_hist));
+      memset(&tcb->crit_hist, 0, sizeof(tcb->crit_hist));
+      memset(&tcb->wakeup_hist, 0, sizeof(tcb->wakeup_hist));
+      leave_critical_section(flags);
+    }
+
+  totalsize = procfs_crithist("preemption", &procfile->hist[0],
+                              buffer, buflen, &offset);
+  if (totalsize < buflen)
+    {
+      totalsize += procfs_crithist("csection", &procfile->hist[1],
+                                   buffer + totalsize, buflen - totalsize,
+                                   &offset);
+    }
+
+  if (totalsize < buflen)
+    {
+      totalsize += procfs_crithist("wakeup", &procfile->hist[2],
+                                   buffer + totalsize, buflen - totalsize,
+                                   &offset);
+    }
+
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: proc_pmu
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PMU
+static ssize_t proc_pmu(FAR struct proc_file_s *procfile,
+                        FAR struct tcb_s *tcb, FAR char *buffer,
+                        size_t buflen, off_t offset)
+{
+  static FAR const char * const names[] =
+  {
+    "none", "cycles", "instructions", "cache-refs", "cache-misses",
+    "branches", "branch-misses", "stalls"
+  };
+
+  struct pmu_count_s count;
+  size_t remaining;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int i;
+
+  remaining = buflen;
+  totalsize = 0;
+
+  nxsched_pmu_read(tcb, &count);
+
+  /* Generate one line per counter in use: the event and its count */
+
+  for (i = 0; i < PMU_NCOUNTERS; i++)
+    {
+      if (count.event[i] == PMU_EVENT_NONE)
+        {
+          continue;
+        }
+
+      if (PMU_EVENT_ISRAW(count.event[i]))
+        {
+          linesize = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                     "raw:0x%-10" PRIx32 " %" PRIu64 "\n",
+                                     PMU_EVENT_RAWNUM(count.event[i]),
+                                     count.count[i]);
+        }
+      else
+        {
+          linesize = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                     "%-14s %" PRIu64 "\n",
+                                     count.event[i] <= PMU_EVENT_STALLS ?
+                                     names[count.event[i]] : "unknown",
+                                     count.count[i]);
+        }
+
+      copysize = procfs_memcpy(procfile->line, linesize, buffer,
+                               remaining, &offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      remaining -= copysize;
+
+      if (totalsize >= buflen)
+        {
+          break;
+        }
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_heap
  ****************************************************************************/
@@ -1575,6 +1740,16 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
       ret = proc_critmon(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
 #endif
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+    case PROC_CRITHIST: /* Critical section histograms */
+      ret = proc_crithist(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
+#ifdef CONFIG_SCHED_PMU
+    case PROC_PMU: /* Hardware performance counters */
+      ret = proc_pmu(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
 #ifdef CONFIG_MM_BACKTRACE
     case PROC_HEAP: /* Task heap info */
       ret = proc_heap(procfile, tcb, buffer, buflen, filep->f_pos);
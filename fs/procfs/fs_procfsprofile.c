@@ -0,0 +1,355 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsprofile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SCHED_PROFILE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_PROFILE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define PROFILE_LINELEN    (32 + CONFIG_SCHED_PROFILE_DEPTH * 64)
+
+/* Total number of samples that may be drained at open time */
+
+#define PROFILE_NSAMPLES   (CONFIG_SMP_NCPUS * CONFIG_SCHED_PROFILE_NSAMPLES)
+
+/* The addresses are shown as symbol names when the symbol table is
+ * available, otherwise the host must resolve them from the ELF file.
+ */
+
+#ifdef CONFIG_ALLSYMS
+#  define PROFILE_PCFMT    ";%ps"
+#else
+#  define PROFILE_PCFMT    ";%p"
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file".  The samples are drained from
+ * the per-CPU buffers when the file is opened so that the output remains
+ * consistent if the user reads the file in small pieces.
+ */
+
+struct profile_file_s
+{
+  struct procfs_file_s base;     /* Base open file structure */
+  int nsamples;                  /* Number of valid entries in sample[] */
+  char line[PROFILE_LINELEN];    /* Pre-allocated buffer for one line */
+  struct profile_sample_s sample[PROFILE_NSAMPLES];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     profile_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     profile_close(FAR struct file *filep);
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+static int     profile_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+
+static int     profile_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations profile_operations =
+{
+  profile_open,        /* open */
+  profile_close,       /* close */
+  profile_read,        /* read */
+  NULL,                /* write */
+
+  profile_dup,         /* dup */
+
+  NULL,                /* opendir */
+  NULL,                /* closedir */
+  NULL,                /* readdir */
+  NULL,                /* rewinddir */
+
+  profile_stat         /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_format
+ *
+ * Description:
+ *   Format one sample as a folded stack: the name of the thread, then the
+ *   callers from the outermost one and the sampled function last, followed
+ *   by the sample count.
+ *
+ ****************************************************************************/
+
+static size_t profile_format(FAR char *line,
+                             FAR const struct profile_sample_s *sample)
+{
+#if CONFIG_TASK_NAME_SIZE > 0
+  FAR struct tcb_s *tcb;
+#endif
+  size_t linesize;
+  int i;
+
+#if CONFIG_TASK_NAME_SIZE > 0
+  tcb = nxsched_get_tcb(sample->pid);
+  if (tcb != NULL)
+    {
+      linesize = snprintf(line, PROFILE_LINELEN, "%s", tcb->name);
+    }
+  else
+#endif
+    {
+      linesize = snprintf(line, PROFILE_LINELEN, "%d",
+                          (int)sample->pid);
+    }
+
+  for (i = sample->depth - 1; i >= 0 && linesize < PROFILE_LINELEN; i--)
+    {
+      linesize += snprintf(line + linesize, PROFILE_LINELEN - linesize,
+                           PROFILE_PCFMT, sample->pc[i]);
+    }
+
+  if (linesize < PROFILE_LINELEN)
+    {
+      linesize += snprintf(line + linesize, PROFILE_LINELEN - linesize,
+                           " 1\n");
+    }
+
+  return linesize < PROFILE_LINELEN ? linesize : PROFILE_LINELEN - 1;
+}
+
+/****************************************************************************
+ * Name: profile_open
+ ****************************************************************************/
+
+static int profile_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct profile_file_s *attr;
+  int cpu;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_malloc(sizeof(struct profile_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Drain the samples of all CPUs.  They are consumed: a second open only
+   * returns the samples taken since this one.
+   */
+
+  memset(&attr->base, 0, sizeof(struct procfs_file_s));
+  attr->nsamples = 0;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      attr->nsamples +=
+        nxsched_profile_drain(cpu, &attr->sample[attr->nsamples],
+                              PROFILE_NSAMPLES - attr->nsamples);
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_close
+ ****************************************************************************/
+
+static int profile_close(FAR struct file *filep)
+{
+  FAR struct profile_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct profile_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_read
+ ****************************************************************************/
+
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct profile_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t ncopied;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct profile_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Regenerate the output from the beginning, skipping the part that was
+   * already read, until the user buffer is full.
+   */
+
+  offset  = filep->f_pos;
+  ncopied = 0;
+
+  for (i = 0; i < attr->nsamples && ncopied < buflen; i++)
+    {
+      linesize = profile_format(attr->line, &attr->sample[i]);
+      copysize = procfs_memcpy(attr->line, linesize, buffer + ncopied,
+                               buflen - ncopied, &offset);
+      ncopied += copysize;
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += ncopied;
+  return ncopied;
+}
+
+/****************************************************************************
+ * Name: profile_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int profile_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct profile_file_s *oldattr;
+  FAR struct profile_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct profile_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct profile_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct profile_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int profile_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "profile" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_SCHED_PROFILE && !CONFIG_FS_PROCFS_EXCLUDE_PROFILE */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -0,0 +1,467 @@
+/****************************************************************************
+ * fs/procfs/fs_procfssnapshot.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_SNAPSHOT)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Extra task records allocated beyond the count seen when sizing the
+ * buffer, so that a few threads created in between do not get lost.
+ */
+
+#define SNAPSHOT_SLACK 4
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct snapshot_file_s
+{
+  struct procfs_file_s base;             /* Base open file structure */
+  FAR struct procfs_snapshot_s *buffer;  /* Header followed by tasks */
+  size_t size;                           /* Valid bytes in buffer */
+  size_t ntasks;                         /* Task records allocated */
+};
+
+/* State passed to snapshot_task() while walking the task list */
+
+struct snapshot_walk_s
+{
+  FAR struct procfs_snapshot_task_s *task; /* Next record, NULL if counting */
+  size_t ntasks;                           /* Records used (or counted) */
+  size_t maxtasks;                         /* Records available */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     snapshot_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     snapshot_close(FAR struct file *filep);
+static ssize_t snapshot_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     snapshot_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     snapshot_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations snapshot_operations =
+{
+  snapshot_open,   /* open */
+  snapshot_close,  /* close */
+  snapshot_read,   /* read */
+  NULL,            /* write */
+  snapshot_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  snapshot_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: snapshot_task
+ *
+ * Description:
+ *   nxsched_foreach() callback.  Count the task or, if there is room left,
+ *   fill in the next task record.  Runs inside a critical section.
+ *
+ ****************************************************************************/
+
+static void snapshot_task(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  FAR struct snapshot_walk_s *walk = (FAR struct snapshot_walk_s *)arg;
+  FAR struct procfs_snapshot_task_s *task;
+#ifdef CONFIG_SCHED_CPULOAD
+  struct cpuload_s cpuload;
+#endif
+
+  if (walk->task == NULL)
+    {
+      walk->ntasks++;
+      return;
+    }
+
+  if (walk->ntasks >= walk->maxtasks)
+    {
+      return;
+    }
+
+  task               = walk->task++;
+  walk->ntasks++;
+
+  memset(task, 0, sizeof(*task));
+  task->pid          = tcb->pid;
+  task->flags        = tcb->flags;
+  task->priority     = tcb->sched_priority;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  task->basepriority = tcb->base_priority;
+#else
+  task->basepriority = tcb->sched_priority;
+#endif
+  task->state        = tcb->task_state;
+  task->stacksize    = tcb->adj_stack_size;
+#ifdef CONFIG_STACK_COLORATION
+  task->stackused    = up_check_tcbstack(tcb);
+#endif
+#ifdef CONFIG_SCHED_CPULOAD
+  if (clock_cpuload(tcb->pid, &cpuload) >= 0)
+    {
+      task->cpuload  = cpuload.active;
+    }
+#endif
+
+#if CONFIG_TASK_NAME_SIZE > 0
+  strlcpy(task->name, tcb->name, sizeof(task->name));
+#endif
+}
+
+/****************************************************************************
+ * Name: snapshot_sample
+ *
+ * Description:
+ *   Take a fresh snapshot into the file's buffer, growing it if the number
+ *   of tasks has increased since the last sample.
+ *
+ ****************************************************************************/
+
+static int snapshot_sample(FAR struct snapshot_file_s *snapfile)
+{
+  FAR struct procfs_snapshot_s *hdr;
+  struct snapshot_walk_s walk;
+#ifdef CONFIG_SCHED_CPULOAD
+  struct cpuload_s cpuload;
+#endif
+  struct mallinfo minfo;
+  irqstate_t flags;
+
+  /* Size the buffer.  This is only a hint: tasks may come and go before
+   * the records are collected, the walk below simply stops when full.
+   */
+
+  memset(&walk, 0, sizeof(walk));
+  nxsched_foreach(snapshot_task, &walk);
+
+  if (snapfile->buffer == NULL || walk.ntasks > snapfile->ntasks)
+    {
+      FAR void *newbuf;
+      size_t ntasks = walk.ntasks + SNAPSHOT_SLACK;
+
+      newbuf = kmm_realloc(snapfile->buffer,
+                           sizeof(struct procfs_snapshot_s) +
+                           ntasks * sizeof(struct procfs_snapshot_task_s));
+      if (newbuf == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      snapfile->buffer = newbuf;
+      snapfile->ntasks = ntasks;
+    }
+
+  hdr = snapfile->buffer;
+  memset(hdr, 0, sizeof(*hdr));
+  hdr->magic    = PROCFS_SNAPSHOT_MAGIC;
+  hdr->version  = PROCFS_SNAPSHOT_VERSION;
+  hdr->hdrsize  = sizeof(struct procfs_snapshot_s);
+  hdr->tasksize = sizeof(struct procfs_snapshot_task_s);
+
+  /* The heap statistics take the heap lock, so they cannot be sampled
+   * inside the critical section with the task records.
+   */
+
+  minfo             = kmm_mallinfo();
+  hdr->heap_arena   = minfo.arena;
+  hdr->heap_used    = minfo.uordblks;
+  hdr->heap_free    = minfo.fordblks;
+  hdr->heap_largest = minfo.mxordblk;
+  hdr->heap_nused   = minfo.aordblks;
+  hdr->heap_nfree   = minfo.ordblks;
+  hdr->valid       |= PROCFS_SNAPSHOT_HEAP;
+
+#ifdef CONFIG_MM_IOB
+  hdr->iob_nfree     = iob_navail(false);
+  hdr->iob_nthrottle = iob_navail(true);
+  hdr->iob_nqentry   = iob_qentry_navail();
+  hdr->valid        |= PROCFS_SNAPSHOT_IOB;
+#endif
+
+#ifdef CONFIG_STACK_COLORATION
+  hdr->valid       |= PROCFS_SNAPSHOT_STACKUSED;
+#endif
+
+  /* Collect the tick counters and all task records in one critical section
+   * so that the CPU load figures add up and no task is seen twice.
+   */
+
+  walk.task     = (FAR struct procfs_snapshot_task_s *)(hdr + 1);
+  walk.ntasks   = 0;
+  walk.maxtasks = snapfile->ntasks;
+
+  flags = enter_critical_section();
+
+  hdr->ticks = clock_systime_ticks();
+#ifdef CONFIG_SCHED_CPULOAD
+  if (clock_cpuload(0, &cpuload) >= 0)
+    {
+      hdr->cpuload_total = cpuload.total;
+      hdr->valid        |= PROCFS_SNAPSHOT_CPULOAD;
+    }
+#endif
+
+  nxsched_foreach(snapshot_task, &walk);
+  leave_critical_section(flags);
+
+  hdr->ntasks    = walk.ntasks < walk.maxtasks ? walk.ntasks : walk.maxtasks;
+  snapfile->size = sizeof(struct procfs_snapshot_s) +
+                   hdr->ntasks * sizeof(struct procfs_snapshot_task_s);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_open
+ ****************************************************************************/
+
+static int snapshot_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct snapshot_file_s *snapfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  snapfile = (FAR struct snapshot_file_s *)
+    kmm_zalloc(sizeof(struct snapshot_file_s));
+  if (!snapfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)snapfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_close
+ ****************************************************************************/
+
+static int snapshot_close(FAR struct file *filep)
+{
+  FAR struct snapshot_file_s *snapfile;
+
+  /* Recover our private data from the struct file instance */
+
+  snapfile = (FAR struct snapshot_file_s *)filep->f_priv;
+  DEBUGASSERT(snapfile);
+
+  /* Release the snapshot buffer and the file attributes structure */
+
+  kmm_free(snapfile->buffer);
+  kmm_free(snapfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_read
+ *
+ * Description:
+ *   A read at offset zero takes a new snapshot; reads at other offsets
+ *   return the remainder of the last one.  A monitoring agent keeps the
+ *   file open and does lseek(fd, 0, SEEK_SET) + read() once per period,
+ *   so the buffer is only reallocated when the number of tasks grows.
+ *
+ ****************************************************************************/
+
+static ssize_t snapshot_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct snapshot_file_s *snapfile;
+  size_t copysize;
+  off_t offset;
+  int ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  snapfile = (FAR struct snapshot_file_s *)filep->f_priv;
+  DEBUGASSERT(snapfile);
+
+  if (offset == 0)
+    {
+      ret = snapshot_sample(snapfile);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (snapfile->buffer == NULL)
+    {
+      return 0;
+    }
+
+  copysize = procfs_memcpy((FAR const char *)snapfile->buffer,
+                           snapfile->size, buffer, buflen, &offset);
+
+  /* Update the file offset */
+
+  filep->f_pos += copysize;
+  return copysize;
+}
+
+/****************************************************************************
+ * Name: snapshot_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int snapshot_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct snapshot_file_s *oldattr;
+  FAR struct snapshot_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct snapshot_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct snapshot_file_s *)
+    kmm_zalloc(sizeof(struct snapshot_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The new file gets a private copy of the last snapshot so that reads
+   * continuing at the current offset see the same data.
+   */
+
+  if (oldattr->buffer != NULL)
+    {
+      newattr->buffer = kmm_malloc(sizeof(struct procfs_snapshot_s) +
+                                   oldattr->ntasks *
+                                   sizeof(struct procfs_snapshot_task_s));
+      if (newattr->buffer == NULL)
+        {
+          kmm_free(newattr);
+          return -ENOMEM;
+        }
+
+      memcpy(newattr->buffer, oldattr->buffer, oldattr->size);
+      newattr->size   = oldattr->size;
+      newattr->ntasks = oldattr->ntasks;
+    }
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int snapshot_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "snapshot" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_SNAPSHOT */
@@ -41,6 +41,7 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/fs/dirent.h>
+#include <nuttx/fs/blkcache.h>
 
 #include "fs_romfs.h"
 
@@ -1110,9 +1111,14 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
           FAR struct inode *inode = rm->rm_blkdriver;
           if (inode)
             {
-              if (INODE_IS_BLOCK(inode) && inode->u.i_bops->close != NULL)
+              if (INODE_IS_BLOCK(inode))
                 {
-                  inode->u.i_bops->close(inode);
+                  blkcache_invalidate(inode);
+
+                  if (inode->u.i_bops->close != NULL)
+                    {
+                      inode->u.i_bops->close(inode);
+                    }
                 }
 
               /* We hold a reference to the block driver but should
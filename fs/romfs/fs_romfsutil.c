@@ -38,6 +38,8 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/fs/dirent.h>
+#include <nuttx/fs/blkcache.h>
+#include <nuttx/lib/sort.h>
 #include <nuttx/mtd/mtd.h>
 
 #include "fs_romfs.h"
@@ -266,6 +268,55 @@ static int romfs_followhardlinks(FAR struct romfs_mountpt_s *rm,
   return -ELOOP;
 }
 
+/****************************************************************************
+ * Name: romfs_headerend
+ *
+ * Description:
+ *   Given the offset to a file header, return the offset to the first
+ *   16-byte chunk after the file name, i.e. the start of the file data.
+ *
+ ****************************************************************************/
+
+static int romfs_headerend(FAR struct romfs_mountpt_s *rm, uint32_t offset,
+                           FAR uint32_t *start)
+{
+  int16_t ndx;
+
+  /* Loop until the header size is obtained. */
+
+  offset += ROMFS_FHDR_NAME;
+  for (; ; )
+    {
+      /* Read the sector into memory */
+
+      ndx = romfs_devcacheread(rm, offset);
+      if (ndx < 0)
+        {
+          return ndx;
+        }
+
+      /* Get the offset to the next chunk */
+
+      offset += 16;
+      if (offset > rm->rm_volsize)
+        {
+          return -EIO;
+        }
+
+      /* Is the name terminated in this 16-byte block */
+
+      if (rm->rm_buffer[ndx + 15] == '\0')
+        {
+          /* Yes.. then the data starts at the next chunk */
+
+          *start = offset;
+          return OK;
+        }
+    }
+
+  return -EINVAL; /* Won't get here */
+}
+
 /****************************************************************************
  * Name: romfs_nodeinfo_search/romfs_nodeinfo_compare
  *
@@ -313,6 +364,21 @@ static int romfs_nodeinfo_compare(FAR const void *a, FAR const void *b)
   entry.re_len = nodeinfo->rn_namesize;
   return romfs_nodeinfo_search(&entry, b);
 }
+
+/****************************************************************************
+ * Name: romfs_sortchild
+ *
+ * Description:
+ *   Sort an array of child nodes by name.  Every directory is sorted when
+ *   it is cached, so the comparison is inlined rather than called through
+ *   qsort().
+ *
+ ****************************************************************************/
+
+#define ROMFS_NODEINFO_LESS(a, b) (romfs_nodeinfo_compare(&(a), &(b)) < 0)
+
+SORT_DEFINE(romfs_sortchild, FAR struct romfs_nodeinfo_s *,
+            ROMFS_NODEINFO_LESS)
 #endif
 
 /****************************************************************************
@@ -415,7 +481,7 @@ static int romfs_cachenode(FAR struct romfs_mountpt_s *rm,
   char childname[NAME_MAX + 1];
   uint32_t linkoffset;
   uint32_t info;
-  uint8_t num = 0;
+  uint16_t num = 0;
   int ret;
 
   nodeinfo = kmm_zalloc(sizeof(struct romfs_nodeinfo_s) + strlen(name));
@@ -431,8 +497,13 @@ static int romfs_cachenode(FAR struct romfs_mountpt_s *rm,
   strcpy(nodeinfo->rn_name, name);
   if (!IS_DIRECTORY(next))
     {
+      /* Save the start of the file data rather than the file header.
+       * The header may be the target of a hard link with a name of a
+       * different length than this one.
+       */
+
       nodeinfo->rn_size = size;
-      return 0;
+      return romfs_headerend(rm, offset, &nodeinfo->rn_offset);
     }
 
   child = nodeinfo->rn_child;
@@ -457,11 +528,23 @@ static int romfs_cachenode(FAR struct romfs_mountpt_s *rm,
 
       if (strcmp(childname, ".") != 0 && strcmp(childname, "..") != 0)
         {
+          /* Keep at least one NULL entry at the end of the array, that
+           * is where readdir() stops.  Double the array each time so that
+           * large directories are not copied over and over.
+           */
+
           if (child == NULL || nodeinfo->rn_count == num - 1)
             {
               FAR void *tmp;
+              uint16_t incr;
+
+              incr = num < NODEINFO_NINCR ? NODEINFO_NINCR : num;
+              if (num + incr > UINT16_MAX)
+                {
+                  return -EFBIG;
+                }
 
-              tmp = kmm_realloc(nodeinfo->rn_child, (num + NODEINFO_NINCR) *
+              tmp = kmm_realloc(nodeinfo->rn_child, (num + incr) *
                                 sizeof(*nodeinfo->rn_child));
               if (tmp == NULL)
                 {
@@ -469,9 +552,9 @@ static int romfs_cachenode(FAR struct romfs_mountpt_s *rm,
                 }
 
               nodeinfo->rn_child = tmp;
-              memset(nodeinfo->rn_child + num, 0, NODEINFO_NINCR *
+              memset(nodeinfo->rn_child + num, 0, incr *
                      sizeof(*nodeinfo->rn_child));
-              num += NODEINFO_NINCR;
+              num += incr;
             }
 
           child = &nodeinfo->rn_child[nodeinfo->rn_count++];
@@ -496,8 +579,23 @@ static int romfs_cachenode(FAR struct romfs_mountpt_s *rm,
 
   if (nodeinfo->rn_count > 1)
     {
-      qsort(nodeinfo->rn_child, nodeinfo->rn_count,
-            sizeof(*nodeinfo->rn_child), romfs_nodeinfo_compare);
+      romfs_sortchild(nodeinfo->rn_child, nodeinfo->rn_count);
+    }
+
+  /* Return the unused part of the array, except for the terminating NULL
+   * entry.  The array remains valid if that fails.
+   */
+
+  if (nodeinfo->rn_count + 1 < num)
+    {
+      FAR void *tmp;
+
+      tmp = kmm_realloc(nodeinfo->rn_child, (nodeinfo->rn_count + 1) *
+                        sizeof(*nodeinfo->rn_child));
+      if (tmp != NULL)
+        {
+          nodeinfo->rn_child = tmp;
+        }
     }
 
   return 0;
@@ -563,8 +661,8 @@ int romfs_hwread(FAR struct romfs_mountpt_s *rm, FAR uint8_t *buffer,
         }
       else if (inode->u.i_bops->read)
         {
-          nsectorsread =
-            inode->u.i_bops->read(inode, buffer, sector, nsectors);
+          nsectorsread = blkcache_read(inode, buffer, sector, nsectors,
+                                       rm->rm_hwsectorsize);
         }
 
       if (nsectorsread == (ssize_t)nsectors)
@@ -1176,45 +1274,11 @@ int romfs_datastart(FAR struct romfs_mountpt_s *rm,
                     FAR uint32_t *start)
 {
 #ifdef CONFIG_FS_ROMFS_CACHE_NODE
-  *start = ROMFS_ALIGNUP(nodeinfo->rn_offset +
-                         ROMFS_FHDR_NAME + nodeinfo->rn_namesize + 1);
+  /* The start of the file data was found when the node was cached */
+
+  *start = nodeinfo->rn_offset;
   return OK;
 #else
-  uint32_t offset = nodeinfo->rn_offset;
-  int16_t ndx;
-
-  /* Loop until the header size is obtained. */
-
-  offset += ROMFS_FHDR_NAME;
-  for (; ; )
-    {
-      /* Read the sector into memory */
-
-      ndx = romfs_devcacheread(rm, offset);
-      if (ndx < 0)
-        {
-          return ndx;
-        }
-
-      /* Get the offset to the next chunk */
-
-      offset += 16;
-      if (offset > rm->rm_volsize)
-        {
-          return -EIO;
-        }
-
-      /* Is the name terminated in this 16-byte block */
-
-      if (rm->rm_buffer[ndx + 15] == '\0')
-        {
-          /* Yes.. then the data starts at the next chunk */
-
-          *start = offset;
-          return OK;
-        }
-    }
-
-  return -EINVAL; /* Won't get here */
+  return romfs_headerend(rm, nodeinfo->rn_offset, start);
 #endif
 }
@@ -50,6 +50,15 @@
 
 #define RPMSGFS_RETRY_DELAY_MS       10
 
+#ifndef CONFIG_FS_RPMSGFS_CACHE
+#  define rpmsgfs_attr_invalidate(fs)
+#  define rpmsgfs_attr_lookup(fs, path, buf) (-ENOENT)
+#  define rpmsgfs_attr_insert(fs, path, buf)
+#  define rpmsgfs_cache_flush(fs, hf)        OK
+#  define rpmsgfs_cache_flushall(fs)
+#  define rpmsgfs_cache_sync(fs, hf, pos)    OK
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -64,7 +73,25 @@ struct rpmsgfs_ofile_s
   int16_t                    crefs;    /* Reference count */
   mode_t                     oflags;   /* Open mode */
   int                        fd;
+#ifdef CONFIG_FS_RPMSGFS_CACHE
+  FAR char                   *cbuf;    /* Data cache, NULL if not cached */
+  off_t                      cpos;     /* File offset of cbuf[0] */
+  off_t                      rpos;     /* File offset after the last read */
+  size_t                     clen;     /* Number of valid bytes in cbuf */
+  bool                       dirty;    /* cbuf holds data to write back */
+#endif
+};
+
+#ifdef CONFIG_FS_RPMSGFS_CACHE
+/* This structure describes the cached attributes of one remote path */
+
+struct rpmsgfs_attr_s
+{
+  FAR char                   *path;    /* Remote path, NULL if unused */
+  clock_t                    expire;   /* The entry is stale from then on */
+  struct stat                buf;      /* The attributes of the path */
 };
+#endif
 
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
@@ -78,6 +105,10 @@ struct rpmsgfs_mountpt_s
   char                       fs_root[PATH_MAX];
   void                       *handle;
   int                        timeout;  /* Connect timeout */
+#ifdef CONFIG_FS_RPMSGFS_CACHE
+  struct rpmsgfs_attr_s      fs_attr[CONFIG_FS_RPMSGFS_ATTR_NCACHE];
+  unsigned int               fs_attrnext; /* Next entry to replace */
+#endif
 };
 
 /****************************************************************************
@@ -276,6 +307,304 @@ static void rpmsgfs_mkpath(FAR struct rpmsgfs_mountpt_s *fs,
     }
 }
 
+#ifdef CONFIG_FS_RPMSGFS_CACHE
+/****************************************************************************
+ * Name: rpmsgfs_attr_invalidate
+ *
+ * Description: Drop all the cached attributes of the mount point.
+ *
+ ****************************************************************************/
+
+static void rpmsgfs_attr_invalidate(FAR struct rpmsgfs_mountpt_s *fs)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_RPMSGFS_ATTR_NCACHE; i++)
+    {
+      if (fs->fs_attr[i].path != NULL)
+        {
+          kmm_free(fs->fs_attr[i].path);
+          fs->fs_attr[i].path = NULL;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: rpmsgfs_attr_lookup
+ *
+ * Description: Return the cached attributes of a remote path, or -ENOENT
+ *   if they are not cached or stale.
+ *
+ ****************************************************************************/
+
+static int rpmsgfs_attr_lookup(FAR struct rpmsgfs_mountpt_s *fs,
+                               FAR const char *path, FAR struct stat *buf)
+{
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0; i < CONFIG_FS_RPMSGFS_ATTR_NCACHE; i++)
+    {
+      FAR struct rpmsgfs_attr_s *attr = &fs->fs_attr[i];
+
+      if (attr->path == NULL || strcmp(attr->path, path) != 0)
+        {
+          continue;
+        }
+
+      if ((sclock_t)(now - attr->expire) >= 0)
+        {
+          kmm_free(attr->path);
+          attr->path = NULL;
+          break;
+        }
+
+      memcpy(buf, &attr->buf, sizeof(struct stat));
+      return OK;
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: rpmsgfs_attr_insert
+ *
+ * Description: Cache the attributes of a remote path, replacing the
+ *   entries in a round robin fashion.
+ *
+ ****************************************************************************/
+
+static void rpmsgfs_attr_insert(FAR struct rpmsgfs_mountpt_s *fs,
+                                FAR const char *path,
+                                FAR const struct stat *buf)
+{
+  FAR struct rpmsgfs_attr_s *attr;
+  FAR char *copy;
+
+  copy = strdup(path);
+  if (copy == NULL)
+    {
+      return;
+    }
+
+  attr = &fs->fs_attr[fs->fs_attrnext];
+  if (++fs->fs_attrnext >= CONFIG_FS_RPMSGFS_ATTR_NCACHE)
+    {
+      fs->fs_attrnext = 0;
+    }
+
+  if (attr->path != NULL)
+    {
+      kmm_free(attr->path);
+    }
+
+  attr->path   = copy;
+  attr->expire = clock_systime_ticks() +
+                 MSEC2TICK(CONFIG_FS_RPMSGFS_ATTR_TIMEOUT);
+  memcpy(&attr->buf, buf, sizeof(struct stat));
+}
+
+/****************************************************************************
+ * Name: rpmsgfs_cache_flush
+ *
+ * Description: Write back the data coalesced in the cache of an open file.
+ *
+ *   While the cache is dirty, the remote file position is cpos and it
+ *   moves to cpos + clen once the data is written back.  A clean cache
+ *   holds the data read ahead, so the remote position is cpos + clen and
+ *   may be ahead of the position of the file.
+ *
+ ****************************************************************************/
+
+static int rpmsgfs_cache_flush(FAR struct rpmsgfs_mountpt_s *fs,
+                               FAR struct rpmsgfs_ofile_s *hf)
+{
+  ssize_t ret;
+
+  if (!hf->dirty)
+    {
+      return OK;
+    }
+
+  hf->dirty = false;
+  rpmsgfs_attr_invalidate(fs);
+
+  ret = rpmsgfs_client_write(fs->handle, hf->fd, hf->cbuf, hf->clen);
+  if (ret >= 0 && ret < (ssize_t)hf->clen)
+    {
+      ret = -ENOSPC;
+    }
+
+  if (ret < 0)
+    {
+      /* The data is lost, don't keep it as valid read data */
+
+      hf->clen = 0;
+      return ret;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: rpmsgfs_cache_flushall
+ *
+ * Description: Write back the dirty cache of all the open files, so that
+ *   the remote attributes reflect the writes done so far.
+ *
+ ****************************************************************************/
+
+static void rpmsgfs_cache_flushall(FAR struct rpmsgfs_mountpt_s *fs)
+{
+  FAR struct rpmsgfs_ofile_s *hf;
+
+  for (hf = fs->fs_head; hf != NULL; hf = hf->fnext)
+    {
+      rpmsgfs_cache_flush(fs, hf);
+    }
+}
+
+/****************************************************************************
+ * Name: rpmsgfs_cache_sync
+ *
+ * Description: Write back and drop the cache of an open file and move the
+ *   remote file position to pos, the position of the file.
+ *
+ ****************************************************************************/
+
+static int rpmsgfs_cache_sync(FAR struct rpmsgfs_mountpt_s *fs,
+                              FAR struct rpmsgfs_ofile_s *hf, off_t pos)
+{
+  off_t ret;
+
+  ret = rpmsgfs_cache_flush(fs, hf);
+  if (ret >= 0 && hf->clen > 0 && hf->cpos + hf->clen != pos)
+    {
+      ret = rpmsgfs_client_lseek(fs->handle, hf->fd, pos, SEEK_SET);
+    }
+
+  hf->clen = 0;
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Name: rpmsgfs_cache_read
+ *
+ * Description: Read from an open file through its cache.  A miss of a
+ *   small read continuing the previous one refills the whole cache with
+ *   one large remote read; other misses go directly to the remote core.
+ *
+ ****************************************************************************/
+
+static ssize_t rpmsgfs_cache_read(FAR struct rpmsgfs_mountpt_s *fs,
+                                  FAR struct rpmsgfs_ofile_s *hf,
+                                  off_t pos, FAR char *buffer,
+                                  size_t buflen)
+{
+  size_t nread = 0;
+  ssize_t ret;
+
+  ret = rpmsgfs_cache_flush(fs, hf);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  while (nread < buflen)
+    {
+      size_t n;
+
+      if (hf->clen > 0 && pos >= hf->cpos && pos < hf->cpos + hf->clen)
+        {
+          n = hf->cpos + hf->clen - pos;
+          if (n > buflen - nread)
+            {
+              n = buflen - nread;
+            }
+
+          memcpy(buffer + nread, hf->cbuf + (pos - hf->cpos), n);
+          nread += n;
+          pos   += n;
+          continue;
+        }
+
+      /* The cache is empty or is consumed, the remote position is pos */
+
+      hf->clen = 0;
+      n = buflen - nread;
+      if (n >= CONFIG_FS_RPMSGFS_CACHE_SIZE || pos != hf->rpos)
+        {
+          ret = rpmsgfs_client_read(fs->handle, hf->fd,
+                                    buffer + nread, n);
+          if (ret > 0)
+            {
+              nread += ret;
+              pos   += ret;
+            }
+
+          break;
+        }
+
+      ret = rpmsgfs_client_read(fs->handle, hf->fd, hf->cbuf,
+                                CONFIG_FS_RPMSGFS_CACHE_SIZE);
+      if (ret <= 0)
+        {
+          break;
+        }
+
+      hf->cpos = pos;
+      hf->clen = ret;
+    }
+
+  hf->rpos = pos;
+  return nread > 0 ? nread : ret;
+}
+
+/****************************************************************************
+ * Name: rpmsgfs_cache_write
+ *
+ * Description: Write to an open file through its cache.  Small writes
+ *   continuing each other are coalesced until the cache is full; large
+ *   writes go directly to the remote core.
+ *
+ ****************************************************************************/
+
+static ssize_t rpmsgfs_cache_write(FAR struct rpmsgfs_mountpt_s *fs,
+                                   FAR struct rpmsgfs_ofile_s *hf,
+                                   off_t pos, FAR const char *buffer,
+                                   size_t buflen)
+{
+  ssize_t ret;
+
+  rpmsgfs_attr_invalidate(fs);
+
+  if (hf->dirty && pos == hf->cpos + hf->clen &&
+      hf->clen + buflen <= CONFIG_FS_RPMSGFS_CACHE_SIZE)
+    {
+      memcpy(hf->cbuf + hf->clen, buffer, buflen);
+      hf->clen += buflen;
+      return buflen;
+    }
+
+  ret = rpmsgfs_cache_sync(fs, hf, pos);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (buflen >= CONFIG_FS_RPMSGFS_CACHE_SIZE)
+    {
+      return rpmsgfs_client_write(fs->handle, hf->fd, buffer, buflen);
+    }
+
+  memcpy(hf->cbuf, buffer, buflen);
+  hf->cpos  = pos;
+  hf->clen  = buflen;
+  hf->dirty = true;
+  return buflen;
+}
+#endif
+
 /****************************************************************************
  * Name: rpmsgfs_open
  ****************************************************************************/
@@ -286,6 +615,9 @@ static int rpmsgfs_open(FAR struct file *filep, FAR const char *relpath,
   FAR struct inode *inode;
   FAR struct rpmsgfs_mountpt_s *fs;
   FAR struct rpmsgfs_ofile_s  *hf;
+#ifdef CONFIG_FS_RPMSGFS_CACHE
+  struct stat buf;
+#endif
   char path[PATH_MAX];
   int ret;
 
@@ -312,7 +644,7 @@ static int rpmsgfs_open(FAR struct file *filep, FAR const char *relpath,
 
   /* Allocate memory for the open file */
 
-  hf = (struct rpmsgfs_ofile_s *) kmm_malloc(sizeof *hf);
+  hf = (struct rpmsgfs_ofile_s *) kmm_zalloc(sizeof *hf);
   if (hf == NULL)
     {
       ret = -ENOMEM;
@@ -323,6 +655,11 @@ static int rpmsgfs_open(FAR struct file *filep, FAR const char *relpath,
 
   rpmsgfs_mkpath(fs, relpath, path, sizeof(path));
 
+  if ((oflags & (O_CREAT | O_TRUNC)) != 0)
+    {
+      rpmsgfs_attr_invalidate(fs);
+    }
+
   /* Try to open the file in the host file system */
 
   hf->fd = rpmsgfs_client_open(fs->handle, path, oflags, mode);
@@ -351,6 +688,23 @@ static int rpmsgfs_open(FAR struct file *filep, FAR const char *relpath,
         }
     }
 
+#ifdef CONFIG_FS_RPMSGFS_CACHE
+  /* Only the regular files are cached, the others may not keep their data
+   * or may change under the feet of the client.
+   */
+
+  if ((oflags & O_DIRECT) == 0 &&
+      rpmsgfs_client_fstat(fs->handle, hf->fd, &buf) >= 0)
+    {
+      rpmsgfs_attr_insert(fs, path, &buf);
+      if (S_ISREG(buf.st_mode))
+        {
+          hf->cbuf = kmm_malloc(CONFIG_FS_RPMSGFS_CACHE_SIZE);
+          hf->rpos = filep->f_pos;
+        }
+    }
+#endif
+
   /* Attach the private date to the struct file instance */
 
   filep->f_priv = hf;
@@ -457,14 +811,24 @@ static int rpmsgfs_close(FAR struct file *filep)
         }
     }
 
-  /* Close the host file */
+  /* Write back the cached data and close the host file */
 
+  ret = rpmsgfs_cache_flush(fs, hf);
   rpmsgfs_client_close(fs->handle, hf->fd);
 
   /* Now free the pointer */
 
   filep->f_priv = NULL;
+#ifdef CONFIG_FS_RPMSGFS_CACHE
+  if (hf->cbuf != NULL)
+    {
+      kmm_free(hf->cbuf);
+    }
+#endif
+
   kmm_free(hf);
+  rpmsgfs_semgive(fs);
+  return ret;
 
 okout:
   rpmsgfs_semgive(fs);
@@ -505,7 +869,17 @@ static ssize_t rpmsgfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Call the host to perform the read */
 
-  ret = rpmsgfs_client_read(fs->handle, hf->fd, buffer, buflen);
+#ifdef CONFIG_FS_RPMSGFS_CACHE
+  if (hf->cbuf != NULL)
+    {
+      ret = rpmsgfs_cache_read(fs, hf, filep->f_pos, buffer, buflen);
+    }
+  else
+#endif
+    {
+      ret = rpmsgfs_client_read(fs->handle, hf->fd, buffer, buflen);
+    }
+
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -571,7 +945,18 @@ static ssize_t rpmsgfs_write(FAR struct file *filep, const char *buffer,
 
   /* Call the host to perform the write */
 
-  ret = rpmsgfs_client_write(fs->handle, hf->fd, buffer, buflen);
+#ifdef CONFIG_FS_RPMSGFS_CACHE
+  if (hf->cbuf != NULL)
+    {
+      ret = rpmsgfs_cache_write(fs, hf, filep->f_pos, buffer, buflen);
+    }
+  else
+#endif
+    {
+      rpmsgfs_attr_invalidate(fs);
+      ret = rpmsgfs_client_write(fs->handle, hf->fd, buffer, buflen);
+    }
+
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -615,7 +1000,12 @@ static off_t rpmsgfs_seek(FAR struct file *filep, off_t offset, int whence)
 
   /* Call our internal routine to perform the seek */
 
-  ret = rpmsgfs_client_lseek(fs->handle, hf->fd, offset, whence);
+  ret = rpmsgfs_cache_sync(fs, hf, filep->f_pos);
+  if (ret >= 0)
+    {
+      ret = rpmsgfs_client_lseek(fs->handle, hf->fd, offset, whence);
+    }
+
   if (ret >= 0)
     {
       filep->f_pos = ret;
@@ -658,7 +1048,11 @@ static int rpmsgfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   /* Call our internal routine to perform the ioctl */
 
-  ret = rpmsgfs_client_ioctl(fs->handle, hf->fd, cmd, arg);
+  ret = rpmsgfs_cache_sync(fs, hf, filep->f_pos);
+  if (ret >= 0)
+    {
+      ret = rpmsgfs_client_ioctl(fs->handle, hf->fd, cmd, arg);
+    }
 
   rpmsgfs_semgive(fs);
   return ret;
@@ -699,10 +1093,11 @@ static int rpmsgfs_sync(FAR struct file *filep)
       return ret;
     }
 
+  ret = rpmsgfs_cache_flush(fs, hf);
   rpmsgfs_client_sync(fs->handle, hf->fd);
 
   rpmsgfs_semgive(fs);
-  return OK;
+  return ret;
 }
 
 /****************************************************************************
@@ -775,7 +1170,11 @@ static int rpmsgfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
 
   /* Call the host to perform the read */
 
-  ret = rpmsgfs_client_fstat(fs->handle, hf->fd, buf);
+  ret = rpmsgfs_cache_flush(fs, hf);
+  if (ret >= 0)
+    {
+      ret = rpmsgfs_client_fstat(fs->handle, hf->fd, buf);
+    }
 
   rpmsgfs_semgive(fs);
   return ret;
@@ -821,6 +1220,7 @@ static int rpmsgfs_fchstat(FAR const struct file *filep,
 
   /* Call the host to perform the change */
 
+  rpmsgfs_attr_invalidate(fs);
   ret = rpmsgfs_client_fchstat(fs->handle, hf->fd, buf, flags);
 
   rpmsgfs_semgive(fs);
@@ -866,7 +1266,12 @@ static int rpmsgfs_ftruncate(FAR struct file *filep, off_t length)
 
   /* Call the host to perform the truncate */
 
-  ret = rpmsgfs_client_ftruncate(fs->handle, hf->fd, length);
+  ret = rpmsgfs_cache_sync(fs, hf, filep->f_pos);
+  if (ret >= 0)
+    {
+      rpmsgfs_attr_invalidate(fs);
+      ret = rpmsgfs_client_ftruncate(fs->handle, hf->fd, length);
+    }
 
   rpmsgfs_semgive(fs);
   return ret;
@@ -1201,6 +1606,7 @@ static int rpmsgfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
       return ret;
     }
 
+  rpmsgfs_attr_invalidate(fs);
   nxsem_destroy(&fs->fs_sem);
   kmm_free(fs);
   return 0;
@@ -1275,6 +1681,7 @@ static int rpmsgfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
 
   /* Call the host fs to perform the unlink */
 
+  rpmsgfs_attr_invalidate(fs);
   ret = rpmsgfs_client_unlink(fs->handle, path);
 
   rpmsgfs_semgive(fs);
@@ -1315,6 +1722,7 @@ static int rpmsgfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the mkdir */
 
+  rpmsgfs_attr_invalidate(fs);
   ret = rpmsgfs_client_mkdir(fs->handle, path, mode);
 
   rpmsgfs_semgive(fs);
@@ -1356,6 +1764,7 @@ int rpmsgfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
 
   /* Call the host FS to do the mkdir */
 
+  rpmsgfs_attr_invalidate(fs);
   ret = rpmsgfs_client_rmdir(fs->handle, path);
 
   rpmsgfs_semgive(fs);
@@ -1400,6 +1809,7 @@ int rpmsgfs_rename(FAR struct inode *mountpt, FAR const char *oldrelpath,
 
   /* Call the host FS to do the mkdir */
 
+  rpmsgfs_attr_invalidate(fs);
   ret = rpmsgfs_client_rename(fs->handle, oldpath, newpath);
 
   rpmsgfs_semgive(fs);
@@ -1438,9 +1848,21 @@ static int rpmsgfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
 
   rpmsgfs_mkpath(fs, relpath, path, sizeof(path));
 
+  /* The attributes must reflect the data written back so far */
+
+  rpmsgfs_cache_flushall(fs);
+
   /* Call the host FS to do the stat operation */
 
-  ret = rpmsgfs_client_stat(fs->handle, path, buf);
+  ret = rpmsgfs_attr_lookup(fs, path, buf);
+  if (ret < 0)
+    {
+      ret = rpmsgfs_client_stat(fs->handle, path, buf);
+      if (ret >= 0)
+        {
+          rpmsgfs_attr_insert(fs, path, buf);
+        }
+    }
 
   rpmsgfs_semgive(fs);
   return ret;
@@ -1480,6 +1902,7 @@ static int rpmsgfs_chstat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the chstat operation */
 
+  rpmsgfs_attr_invalidate(fs);
   ret = rpmsgfs_client_chstat(fs->handle, path, buf, flags);
 
   rpmsgfs_semgive(fs);
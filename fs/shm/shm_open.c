@@ -0,0 +1,167 @@
+/****************************************************************************
+ * fs/shm/shm_open.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "shm/shmfs.h"
+
+#ifdef CONFIG_FS_SHM
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shm_open
+ *
+ * Description:
+ *   Establish a connection between a POSIX shared memory object and a file
+ *   descriptor.  The object is created with a size of zero and is sized
+ *   with ftruncate().  Its memory is then shared among processes with
+ *   mmap(..., MAP_SHARED, fd, 0) and released with munmap().
+ *
+ *   Shared memory objects exist in the VFS under CONFIG_FS_SHM_VFS_PATH
+ *   until they are removed with shm_unlink().
+ *
+ * Input Parameters:
+ *   name  - The name of the object.  A leading '/' is ignored; no other
+ *           '/' may appear in the name.
+ *   oflag - O_RDONLY or O_RDWR, optionally with O_CREAT, O_EXCL and
+ *           O_TRUNC.
+ *   mode  - Permissions of an object that is created.
+ *
+ * Returned Value:
+ *   A non-negative file descriptor on success; -1 (ERROR) on failure with
+ *   the errno value set appropriately.
+ *
+ ****************************************************************************/
+
+int shm_open(FAR const char *name, int oflag, mode_t mode)
+{
+  FAR struct shmfs_object_s *object = NULL;
+  FAR struct file *filep;
+  char fullpath[MAX_SHMPATH];
+  int ret;
+  int fd;
+
+  /* Get the full path to the shared memory object */
+
+  while (*name == '/')
+    {
+      name++;
+    }
+
+  if (*name == '\0' || strchr(name, '/') != NULL)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  snprintf(fullpath, MAX_SHMPATH, CONFIG_FS_SHM_VFS_PATH "/%s", name);
+
+  /* The check for the existence of the object and its creation must be
+   * atomic with respect to other callers of shm_open().
+   */
+
+  sched_lock();
+
+  if ((oflag & O_CREAT) != 0)
+    {
+      object = shmfs_alloc();
+      if (object == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout_with_lock;
+        }
+
+      ret = register_driver(fullpath, &g_shmfs_operations,
+                            mode & ~getumask(), object);
+      if (ret < 0)
+        {
+          shmfs_free(object);
+          object = NULL;
+
+          if (ret != -EEXIST || (oflag & O_EXCL) != 0)
+            {
+              goto errout_with_lock;
+            }
+        }
+    }
+
+  fd = nx_open(fullpath, oflag & ~(O_CREAT | O_EXCL | O_TRUNC));
+  if (fd < 0)
+    {
+      ret = fd;
+      goto errout_with_object;
+    }
+
+  /* Make sure that this really is a shared memory object */
+
+  ret = fs_getfilep(fd, &filep);
+  if (ret >= 0 && filep->f_inode->u.i_ops != &g_shmfs_operations)
+    {
+      ret = -EINVAL;
+    }
+
+  if (ret >= 0 && (oflag & O_TRUNC) != 0)
+    {
+      ret = file_truncate(filep, 0);
+    }
+
+  if (ret < 0)
+    {
+      nx_close(fd);
+      goto errout_with_object;
+    }
+
+  sched_unlock();
+  return fd;
+
+errout_with_object:
+  if (object != NULL)
+    {
+      unregister_driver(fullpath);
+      shmfs_free(object);
+    }
+
+errout_with_lock:
+  sched_unlock();
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+#endif /* CONFIG_FS_SHM */
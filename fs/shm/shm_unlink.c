@@ -0,0 +1,90 @@
+/****************************************************************************
+ * fs/shm/shm_unlink.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/mman.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "shm/shmfs.h"
+
+#ifdef CONFIG_FS_SHM
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shm_unlink
+ *
+ * Description:
+ *   Remove the name of a shared memory object.  Descriptors that are open
+ *   and mappings that exist remain usable; the memory is released when the
+ *   last of them is gone.
+ *
+ * Input Parameters:
+ *   name - The name of the object, as passed to shm_open().
+ *
+ * Returned Value:
+ *   0 (OK) on success; -1 (ERROR) on failure with the errno value set
+ *   appropriately.
+ *
+ ****************************************************************************/
+
+int shm_unlink(FAR const char *name)
+{
+  char fullpath[MAX_SHMPATH];
+  int ret;
+
+  while (*name == '/')
+    {
+      name++;
+    }
+
+  if (*name == '\0' || strchr(name, '/') != NULL)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  snprintf(fullpath, MAX_SHMPATH, CONFIG_FS_SHM_VFS_PATH "/%s", name);
+
+  ret = nx_unlink(fullpath);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+#endif /* CONFIG_FS_SHM */
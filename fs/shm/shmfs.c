@@ -0,0 +1,326 @@
+/****************************************************************************
+ * fs/shm/shmfs.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+
+#include "shm/shmfs.h"
+
+#ifdef CONFIG_FS_SHM
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int shmfs_open(FAR struct file *filep);
+static int shmfs_close(FAR struct file *filep);
+static int shmfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int shmfs_unlink(FAR struct inode *inode);
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct file_operations g_shmfs_operations =
+{
+  shmfs_open,   /* open */
+  shmfs_close,  /* close */
+  NULL,         /* read */
+  NULL,         /* write */
+  NULL,         /* seek */
+  shmfs_ioctl,  /* ioctl */
+  NULL          /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , shmfs_unlink /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmfs_truncate
+ *
+ * Description:
+ *   Set the size of a shared memory object.  The backing region is created
+ *   by the first call; after that the object may shrink but it cannot grow
+ *   beyond the size of its region.
+ *
+ ****************************************************************************/
+
+static int shmfs_truncate(FAR struct shmfs_object_s *object, off_t length)
+{
+  struct shmid_ds ds;
+  int shmid;
+
+  if (length < 0)
+    {
+      return -EINVAL;
+    }
+
+  if (object->so_shmid < 0)
+    {
+      if (length > 0)
+        {
+          shmid = shmget(IPC_PRIVATE, length, IPC_CREAT | 0666);
+          if (shmid < 0)
+            {
+              return -get_errno();
+            }
+
+          object->so_shmid = shmid;
+        }
+    }
+  else
+    {
+      if (shmctl(object->so_shmid, IPC_STAT, &ds) < 0)
+        {
+          return -get_errno();
+        }
+
+      if (length > ds.shm_segsz)
+        {
+          ferr("ERROR: Cannot grow shared memory object to %lu bytes\n",
+               (unsigned long)length);
+          return -EFBIG;
+        }
+    }
+
+  object->so_length = length;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: shmfs_mmap
+ *
+ * Description:
+ *   Attach the backing region of a shared memory object to the address
+ *   environment of the calling process.  A process that maps the same
+ *   object more than once shares a single attachment.
+ *
+ ****************************************************************************/
+
+static int shmfs_mmap(FAR struct shmfs_object_s *object,
+                      FAR void **mapped)
+{
+  FAR struct tcb_s *tcb = nxsched_self();
+  FAR void *vaddr;
+
+  if (object->so_shmid < 0)
+    {
+      return -ENXIO;
+    }
+
+  DEBUGASSERT(tcb != NULL && tcb->group != NULL);
+  vaddr = (FAR void *)tcb->group->tg_shm.gs_vaddr[object->so_shmid];
+  if (vaddr == NULL)
+    {
+      vaddr = shmat(object->so_shmid, NULL, 0);
+      if (vaddr == (FAR void *)ERROR)
+        {
+          return -get_errno();
+        }
+    }
+
+  *mapped = vaddr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: shmfs_open
+ ****************************************************************************/
+
+static int shmfs_open(FAR struct file *filep)
+{
+  FAR struct shmfs_object_s *object = filep->f_inode->i_private;
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&object->so_sem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  object->so_crefs++;
+  nxsem_post(&object->so_sem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: shmfs_close
+ ****************************************************************************/
+
+static int shmfs_close(FAR struct file *filep)
+{
+  FAR struct shmfs_object_s *object = filep->f_inode->i_private;
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&object->so_sem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  DEBUGASSERT(object->so_crefs > 0);
+  if (--object->so_crefs == 0 && object->so_unlinked)
+    {
+      /* The name is gone and this was the last descriptor */
+
+      shmfs_free(object);
+      return OK;
+    }
+
+  nxsem_post(&object->so_sem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: shmfs_ioctl
+ ****************************************************************************/
+
+static int shmfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct shmfs_object_s *object = filep->f_inode->i_private;
+  int ret;
+
+  ret = nxsem_wait(&object->so_sem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (cmd)
+    {
+      case FIOC_TRUNCATE:
+        ret = shmfs_truncate(object, (off_t)arg);
+        break;
+
+      case FIOC_MMAP:
+        ret = shmfs_mmap(object, (FAR void **)((uintptr_t)arg));
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  nxsem_post(&object->so_sem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: shmfs_unlink
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int shmfs_unlink(FAR struct inode *inode)
+{
+  FAR struct shmfs_object_s *object = inode->i_private;
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&object->so_sem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Release the object now if nobody has it open.  Otherwise the last
+   * close will do that.
+   */
+
+  if (object->so_crefs == 0)
+    {
+      shmfs_free(object);
+      return OK;
+    }
+
+  object->so_unlinked = true;
+  nxsem_post(&object->so_sem);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmfs_alloc
+ *
+ * Description:
+ *   Allocate and initialize a new, empty shared memory object.
+ *
+ ****************************************************************************/
+
+FAR struct shmfs_object_s *shmfs_alloc(void)
+{
+  FAR struct shmfs_object_s *object;
+
+  object = kmm_zalloc(sizeof(struct shmfs_object_s));
+  if (object != NULL)
+    {
+      nxsem_init(&object->so_sem, 0, 1);
+      object->so_shmid = -1;
+    }
+
+  return object;
+}
+
+/****************************************************************************
+ * Name: shmfs_free
+ *
+ * Description:
+ *   Release a shared memory object and its backing region.
+ *
+ ****************************************************************************/
+
+void shmfs_free(FAR struct shmfs_object_s *object)
+{
+  /* The region itself persists until the last process detaches from it */
+
+  if (object->so_shmid >= 0)
+    {
+      shmctl(object->so_shmid, IPC_RMID, NULL);
+    }
+
+  nxsem_destroy(&object->so_sem);
+  kmm_free(object);
+}
+
+#endif /* CONFIG_FS_SHM */
@@ -0,0 +1,117 @@
+/****************************************************************************
+ * fs/shm/shmfs.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __FS_SHM_SHMFS_H
+#define __FS_SHM_SHMFS_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/semaphore.h>
+
+#ifdef CONFIG_FS_SHM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MAX_SHMPATH 64
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure describes one POSIX shared memory object.  The object
+ * memory is a System V shared memory region that is created the first time
+ * the object is sized with ftruncate() and that is attached to the address
+ * environment of each process that maps the object.
+ */
+
+struct shmfs_object_s
+{
+  sem_t    so_sem;      /* Manages exclusive access to the object */
+  size_t   so_length;   /* Size of the object, in bytes */
+  int      so_shmid;    /* Backing shared memory region, -1 if none */
+  int16_t  so_crefs;    /* Number of open file descriptors */
+  bool     so_unlinked; /* The object name has been removed */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* Character driver operations of a shared memory object inode */
+
+EXTERN const struct file_operations g_shmfs_operations;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shmfs_alloc
+ *
+ * Description:
+ *   Allocate and initialize a new, empty shared memory object.
+ *
+ * Returned Value:
+ *   The new object on success; NULL if it could not be allocated.
+ *
+ ****************************************************************************/
+
+FAR struct shmfs_object_s *shmfs_alloc(void);
+
+/****************************************************************************
+ * Name: shmfs_free
+ *
+ * Description:
+ *   Release a shared memory object that is no longer referenced, together
+ *   with its backing region.  Processes that still have the region mapped
+ *   retain their mappings until they unmap it.
+ *
+ * Input Parameters:
+ *   object - The object to be released.
+ *
+ ****************************************************************************/
+
+void shmfs_free(FAR struct shmfs_object_s *object);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_FS_SHM */
+#endif /* __FS_SHM_SHMFS_H */
@@ -72,6 +72,12 @@ extern "C"
 
 #define SPIFFS_NO_HOLDER                (INVALID_PROCESS_ID)
 
+/* The procfs statistics need a list of all mounted volumes */
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SPIFFS)
+#  define HAVE_SPIFFS_PROCFS 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -121,6 +127,20 @@ struct spiffs_sem_s
 
 /* spiffs SPI configuration struct */
 
+#ifdef CONFIG_SPIFFS_LUCACHE
+/* One entry of the object lookup cache.  It remembers the page index that
+ * holds a given span of a given object.  Unused entries have the objid
+ * SPIFFS_OBJID_FREE.
+ */
+
+struct spiffs_lucache_s
+{
+  int16_t objid;                    /* Object ID, including SPIFFS_OBJID_NDXFLAG */
+  int16_t spndx;                    /* Span index within the object */
+  int16_t pgndx;                    /* Page index last seen holding the span */
+};
+#endif
+
 /* This structure represents the current state of an SPIFFS volume */
 
 struct spiffs_file_s;               /* Forward reference */
@@ -135,6 +155,13 @@ struct spiffs_s
   FAR uint8_t *work;                /* Secondary work buffer, size of a logical page */
   FAR uint8_t *mtd_work;            /* MTD I/O buffer for read-modify-write */
   FAR void *cache;                  /* Cache memory */
+#ifdef CONFIG_SPIFFS_LUCACHE
+  FAR struct spiffs_lucache_s *lucache; /* Object lookup cache */
+#endif
+#ifdef HAVE_SPIFFS_PROCFS
+  FAR struct spiffs_s *flink;       /* Supports a singly linked list of volumes */
+  FAR const char *devname;          /* Name of the MTD driver inode */
+#endif
 #ifdef CONFIG_HAVE_LONG_LONG
   off64_t media_size;               /* Physical size of the SPI flash */
 #else
@@ -150,9 +177,12 @@ struct spiffs_s
   uint32_t stats_gc_runs;
 #endif
   uint32_t cache_size;              /* Cache size */
-#ifdef CONFIG_SPIFFS_CACHEDBG
   uint32_t cache_hits;              /* Number of cache hits */
   uint32_t cache_misses;            /* Number of cache misses */
+#ifdef CONFIG_SPIFFS_LUCACHE
+  uint32_t lu_hits;                 /* Number of object lookup cache hits */
+  uint32_t lu_misses;               /* Number of object lookup cache misses */
+  uint16_t lu_nentries;             /* Number of object lookup cache entries */
 #endif
   int16_t free_blkndx;              /* Cursor for free blocks, block index */
   int16_t lu_blkndx;                /* Cursor when searching, block index */
@@ -333,6 +363,29 @@ ssize_t spiffs_fobj_read(FAR struct spiffs_s *fs,
 void spiffs_fobj_free(FAR struct spiffs_s *fs,
                       FAR struct spiffs_file_s *fobj, bool unlink);
 
+/****************************************************************************
+ * Name: spiffs_procfs_register and spiffs_procfs_unregister
+ *
+ * Description:
+ *   Add a mounted volume to, or remove it from, the list of volumes that
+ *   are reported by the procfs "fs/spiffs" statistics file.
+ *
+ * Input Parameters:
+ *   fs     - A reference to the volume structure
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_SPIFFS_PROCFS
+void spiffs_procfs_register(FAR struct spiffs_s *fs);
+void spiffs_procfs_unregister(FAR struct spiffs_s *fs);
+#else
+#  define spiffs_procfs_register(fs)
+#  define spiffs_procfs_unregister(fs)
+#endif
+
 #if defined(__cplusplus)
 }
 #endif
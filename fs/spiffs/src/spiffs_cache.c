@@ -46,6 +46,7 @@
 #include <nuttx/config.h>
 
 #include <string.h>
+#include <errno.h>
 #include <debug.h>
 
 #include <nuttx/mtd/mtd.h>
@@ -59,6 +60,28 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: spiffs_lucache_entry
+ *
+ * Description:
+ *   Return the object lookup cache entry that (objid, spndx) hashes to.
+ *   The cache is direct mapped:  A new span simply replaces whatever was
+ *   cached in its slot.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPIFFS_LUCACHE
+static FAR struct spiffs_lucache_s *
+  spiffs_lucache_entry(FAR struct spiffs_s *fs, int16_t objid,
+                       int16_t spndx)
+{
+  uint32_t hash;
+
+  hash = (uint32_t)(uint16_t)objid * 40503u + (uint16_t)spndx;
+  return &fs->lucache[(hash ^ (hash >> 16)) % fs->lu_nentries];
+}
+#endif
+
 /****************************************************************************
  * Name: spiffs_cache_page_get
  *
@@ -415,9 +438,7 @@ ssize_t spiffs_cache_read(FAR struct spiffs_s *fs, uint8_t op, int16_t objid,
 
       /* We've already got a cache page */
 
-#ifdef CONFIG_SPIFFS_CACHEDBG
       fs->cache_hits++;
-#endif
 
       cp->last_access = cache->last_access;
       mem             = spiffs_get_cache_page(fs, cache, cp->cpndx);
@@ -437,9 +458,7 @@ ssize_t spiffs_cache_read(FAR struct spiffs_s *fs, uint8_t op, int16_t objid,
         }
       else
         {
-#ifdef CONFIG_SPIFFS_CACHEDBG
           fs->cache_misses++;
-#endif
 
           /* This operation will always free one cache page (unless all
            * already free), the result code stems from the write operation
@@ -723,3 +742,158 @@ void spiffs_cache_page_release(FAR struct spiffs_s *fs,
       cp->objid = 0;
     }
 }
+
+#ifdef CONFIG_SPIFFS_LUCACHE
+/****************************************************************************
+ * Name: spiffs_lucache_find
+ *
+ * Description:
+ *   Look up the page index holding the given span of the given object in
+ *   the object lookup cache.  A cached page index is only returned after
+ *   the object lookup entry and the page header on FLASH have been checked
+ *   to still describe a valid page of that span; stale entries are dropped.
+ *
+ * Input Parameters:
+ *   fs              - A reference to the SPIFFS volume object instance
+ *   objid           - The object ID (including SPIFFS_OBJID_NDXFLAG)
+ *   spndx           - The span index
+ *   exclusion_pgndx - A page index that must not be returned (or 0)
+ *   pgndx           - The location in which to return the page index
+ *
+ * Returned Value:
+ *   OK is returned on a cache hit; -ENOENT is returned on a miss.
+ *
+ ****************************************************************************/
+
+int spiffs_lucache_find(FAR struct spiffs_s *fs, int16_t objid,
+                        int16_t spndx, int16_t exclusion_pgndx,
+                        FAR int16_t *pgndx)
+{
+  FAR struct spiffs_lucache_s *lu;
+  struct spiffs_page_header_s ph;
+  int16_t luobjid;
+  int16_t blkndx;
+  int ret;
+
+  if (fs->lucache == NULL)
+    {
+      return -ENOENT;
+    }
+
+  lu = spiffs_lucache_entry(fs, objid, spndx);
+  if (lu->objid != objid || lu->spndx != spndx ||
+      (exclusion_pgndx != 0 && lu->pgndx == exclusion_pgndx))
+    {
+      fs->lu_misses++;
+      return -ENOENT;
+    }
+
+  /* The page may have been deleted, moved by the garbage collector or
+   * its block erased since it was cached.  Check that the object lookup
+   * entry still claims the page for this object ...
+   */
+
+  blkndx = SPIFFS_BLOCK_FOR_PAGE(fs, lu->pgndx);
+  ret    = spiffs_cache_read(fs, SPIFFS_OP_T_OBJ_LU | SPIFFS_OP_C_READ, 0,
+                             SPIFFS_BLOCK_TO_PADDR(fs, blkndx) +
+                             SPIFFS_OBJ_LOOKUP_ENTRY_FOR_PAGE(fs,
+                                                              lu->pgndx) *
+                             sizeof(int16_t),
+                             sizeof(int16_t), (FAR uint8_t *)&luobjid);
+  if (ret < 0 || luobjid != objid)
+    {
+      goto errout_with_stale;
+    }
+
+  /* ... and that the page header is the one that the lookup scan would
+   * have accepted.
+   */
+
+  ret = spiffs_cache_read(fs, SPIFFS_OP_T_OBJ_LU2 | SPIFFS_OP_C_READ, 0,
+                          SPIFFS_PAGE_TO_PADDR(fs, lu->pgndx),
+                          sizeof(struct spiffs_page_header_s),
+                          (FAR uint8_t *)&ph);
+  if (ret < 0 || ph.objid != objid || ph.spndx != spndx ||
+      (ph.flags & (SPIFFS_PH_FLAG_FINAL | SPIFFS_PH_FLAG_DELET |
+                   SPIFFS_PH_FLAG_USED)) != SPIFFS_PH_FLAG_DELET ||
+      ((objid & SPIFFS_OBJID_NDXFLAG) != 0 &&
+       (ph.flags & SPIFFS_PH_FLAG_NDXDELE) == 0 && spndx == 0))
+    {
+      goto errout_with_stale;
+    }
+
+  fs->lu_hits++;
+  *pgndx = lu->pgndx;
+  return OK;
+
+errout_with_stale:
+  spiffs_cacheinfo("Stale entry objid=%04x spndx=%04x pgndx=%04x\n",
+                   objid, spndx, lu->pgndx);
+
+  lu->objid = SPIFFS_OBJID_FREE;
+  fs->lu_misses++;
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: spiffs_lucache_update
+ *
+ * Description:
+ *   Remember that the given span of the given object lives at pgndx.
+ *
+ * Input Parameters:
+ *   fs    - A reference to the SPIFFS volume object instance
+ *   objid - The object ID (including SPIFFS_OBJID_NDXFLAG)
+ *   spndx - The span index
+ *   pgndx - The page index that now holds the span
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spiffs_lucache_update(FAR struct spiffs_s *fs, int16_t objid,
+                           int16_t spndx, int16_t pgndx)
+{
+  FAR struct spiffs_lucache_s *lu;
+
+  if (fs->lucache != NULL)
+    {
+      lu        = spiffs_lucache_entry(fs, objid, spndx);
+      lu->objid = objid;
+      lu->spndx = spndx;
+      lu->pgndx = pgndx;
+    }
+}
+
+/****************************************************************************
+ * Name: spiffs_lucache_drop
+ *
+ * Description:
+ *   Forget the cached location of the given span of the given object.
+ *
+ * Input Parameters:
+ *   fs    - A reference to the SPIFFS volume object instance
+ *   objid - The object ID (including SPIFFS_OBJID_NDXFLAG)
+ *   spndx - The span index
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spiffs_lucache_drop(FAR struct spiffs_s *fs, int16_t objid,
+                         int16_t spndx)
+{
+  FAR struct spiffs_lucache_s *lu;
+
+  if (fs->lucache != NULL)
+    {
+      lu = spiffs_lucache_entry(fs, objid, spndx);
+      if (lu->objid == objid && lu->spndx == spndx)
+        {
+          lu->objid = SPIFFS_OBJID_FREE;
+        }
+    }
+}
+#endif /* CONFIG_SPIFFS_LUCACHE */
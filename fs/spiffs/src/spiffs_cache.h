@@ -253,6 +253,76 @@ FAR struct spiffs_cache_page_s *
 void spiffs_cache_page_release(FAR struct spiffs_s *fs,
                                FAR struct spiffs_cache_page_s *cp);
 
+#ifdef CONFIG_SPIFFS_LUCACHE
+/****************************************************************************
+ * Name: spiffs_lucache_find
+ *
+ * Description:
+ *   Look up the page index holding the given span of the given object in
+ *   the object lookup cache.  A cached page index is only returned after
+ *   the object lookup entry and the page header on FLASH have been checked
+ *   to still describe a valid page of that span; stale entries are dropped.
+ *
+ * Input Parameters:
+ *   fs              - A reference to the SPIFFS volume object instance
+ *   objid           - The object ID (including SPIFFS_OBJID_NDXFLAG)
+ *   spndx           - The span index
+ *   exclusion_pgndx - A page index that must not be returned (or 0)
+ *   pgndx           - The location in which to return the page index
+ *
+ * Returned Value:
+ *   OK is returned on a cache hit; -ENOENT is returned on a miss.
+ *
+ ****************************************************************************/
+
+int spiffs_lucache_find(FAR struct spiffs_s *fs, int16_t objid,
+                        int16_t spndx, int16_t exclusion_pgndx,
+                        FAR int16_t *pgndx);
+
+/****************************************************************************
+ * Name: spiffs_lucache_update
+ *
+ * Description:
+ *   Remember that the given span of the given object lives at pgndx.
+ *
+ * Input Parameters:
+ *   fs    - A reference to the SPIFFS volume object instance
+ *   objid - The object ID (including SPIFFS_OBJID_NDXFLAG)
+ *   spndx - The span index
+ *   pgndx - The page index that now holds the span
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spiffs_lucache_update(FAR struct spiffs_s *fs, int16_t objid,
+                           int16_t spndx, int16_t pgndx);
+
+/****************************************************************************
+ * Name: spiffs_lucache_drop
+ *
+ * Description:
+ *   Forget the cached location of the given span of the given object.
+ *
+ * Input Parameters:
+ *   fs    - A reference to the SPIFFS volume object instance
+ *   objid - The object ID (including SPIFFS_OBJID_NDXFLAG)
+ *   spndx - The span index
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spiffs_lucache_drop(FAR struct spiffs_s *fs, int16_t objid,
+                         int16_t spndx);
+#else
+#  define spiffs_lucache_find(fs,o,s,x,p) (-ENOENT)
+#  define spiffs_lucache_update(fs,o,s,p)
+#  define spiffs_lucache_drop(fs,o,s)
+#endif
+
 #if defined(__cplusplus)
 }
 #endif
@@ -978,9 +978,23 @@ int spiffs_objlu_find_id_and_span(FAR struct spiffs_s *fs, int16_t objid,
                                   FAR int16_t *pgndx)
 {
   int16_t blkndx;
+  int16_t found;
   int entry;
   int ret;
 
+  /* Try the object lookup cache before scanning the lookup pages */
+
+  ret = spiffs_lucache_find(fs, objid, spndx, exclusion_pgndx, &found);
+  if (ret >= 0)
+    {
+      if (pgndx != NULL)
+        {
+          *pgndx = found;
+        }
+
+      return OK;
+    }
+
   ret = spiffs_foreach_objlu(fs, fs->lu_blkndx, fs->lu_entry,
                              SPIFFS_VIS_CHECK_ID, objid,
                              spiffs_objlu_find_id_and_span_callback,
@@ -997,9 +1011,15 @@ int spiffs_objlu_find_id_and_span(FAR struct spiffs_s *fs, int16_t objid,
       return ret;
     }
 
+  found = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
+  if (ret >= 0)
+    {
+      spiffs_lucache_update(fs, objid, spndx, found);
+    }
+
   if (pgndx != NULL)
     {
-      *pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
+      *pgndx = found;
     }
 
   fs->lu_blkndx = blkndx;
@@ -1148,6 +1168,8 @@ int spiffs_page_allocate_data(FAR struct spiffs_s *fs, int16_t objid,
       *pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
     }
 
+  spiffs_lucache_update(fs, objid, ph->spndx,
+                        SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry));
   return ret;
 }
 
@@ -1260,6 +1282,11 @@ int spiffs_page_move(FAR struct spiffs_s *fs,
   /* Mark source deleted */
 
   ret = spiffs_page_delete(fs, src_pgndx);
+  if (ret >= 0 && phdr != NULL)
+    {
+      spiffs_lucache_update(fs, phdr->objid, phdr->spndx, free_pgndx);
+    }
+
   return ret;
 }
 
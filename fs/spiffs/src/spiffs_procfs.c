@@ -0,0 +1,378 @@
+/****************************************************************************
+ * fs/spiffs/src/spiffs_procfs.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "spiffs.h"
+#include "spiffs_core.h"
+#include "spiffs_cache.h"
+
+#ifdef HAVE_SPIFFS_PROCFS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the whole output generated by this logic.  Volumes that do not
+ * fit are not reported.
+ */
+
+#define SPIFFS_LINELEN 512
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct spiffs_procfile_s
+{
+  struct procfs_file_s base;     /* Base open file structure */
+  unsigned int linesize;         /* Number of valid characters in line[] */
+  char line[SPIFFS_LINELEN];     /* Pre-allocated buffer for the output */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     spiffs_procopen(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     spiffs_procclose(FAR struct file *filep);
+static ssize_t spiffs_procread(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+static int     spiffs_procdup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+
+static int     spiffs_procstat(FAR const char *relpath,
+                 FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The list of mounted SPIFFS volumes and the lock that protects it */
+
+static FAR struct spiffs_s *g_spiffs_volumes;
+static sem_t g_spiffs_volsem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_procfs.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations spiffs_procfsoperations =
+{
+  spiffs_procopen,     /* open */
+  spiffs_procclose,    /* close */
+  spiffs_procread,     /* read */
+  NULL,                /* write */
+
+  spiffs_procdup,      /* dup */
+
+  NULL,                /* opendir */
+  NULL,                /* closedir */
+  NULL,                /* readdir */
+  NULL,                /* rewinddir */
+
+  spiffs_procstat      /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spiffs_procopen
+ ****************************************************************************/
+
+static int spiffs_procopen(FAR struct file *filep, FAR const char *relpath,
+                           int oflags, mode_t mode)
+{
+  FAR struct spiffs_procfile_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct spiffs_procfile_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spiffs_procclose
+ ****************************************************************************/
+
+static int spiffs_procclose(FAR struct file *filep)
+{
+  FAR struct spiffs_procfile_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct spiffs_procfile_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spiffs_procread
+ ****************************************************************************/
+
+static ssize_t spiffs_procread(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  FAR struct spiffs_procfile_s *attr;
+  FAR struct spiffs_cache_s *cache;
+  FAR struct spiffs_s *fs;
+  unsigned int cpages;
+  unsigned int lusize;
+  unsigned long luhits;
+  unsigned long lumisses;
+  off_t offset;
+  ssize_t ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct spiffs_procfile_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Sample the counters only once so that they stay consistent if the
+   * user reads the file in small pieces.
+   */
+
+  if (filep->f_pos == 0)
+    {
+      attr->linesize = 0;
+
+      ret = nxsem_wait_uninterruptible(&g_spiffs_volsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      for (fs = g_spiffs_volumes;
+           fs != NULL && attr->linesize < SPIFFS_LINELEN - 1;
+           fs = fs->flink)
+        {
+          cache  = spiffs_get_cache(fs);
+          cpages = fs->cache != NULL ? cache->cpage_count : 0;
+
+#ifdef CONFIG_SPIFFS_LUCACHE
+          lusize   = fs->lu_nentries;
+          luhits   = fs->lu_hits;
+          lumisses = fs->lu_misses;
+#else
+          lusize   = 0;
+          luhits   = 0;
+          lumisses = 0;
+#endif
+
+          attr->linesize +=
+            procfs_snprintf(&attr->line[attr->linesize],
+                            SPIFFS_LINELEN - attr->linesize,
+                            "%s:\n"
+                            "  Cache pages:   %u x %u bytes\n"
+                            "  Cache hits:    %lu\n"
+                            "  Cache misses:  %lu\n"
+                            "  Lookup cache:  %u entries\n"
+                            "  Lookup hits:   %lu\n"
+                            "  Lookup misses: %lu\n",
+                            fs->devname, cpages,
+                            (unsigned int)SPIFFS_GEO_PAGE_SIZE(fs),
+                            (unsigned long)fs->cache_hits,
+                            (unsigned long)fs->cache_misses,
+                            lusize, luhits, lumisses);
+        }
+
+      nxsem_post(&g_spiffs_volsem);
+    }
+
+  /* Transfer the statistics to user receive buffer */
+
+  offset = filep->f_pos;
+  ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+  /* Update the file offset */
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spiffs_procdup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int spiffs_procdup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct spiffs_procfile_s *oldattr;
+  FAR struct spiffs_procfile_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct spiffs_procfile_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct spiffs_procfile_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct spiffs_procfile_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spiffs_procstat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int spiffs_procstat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "fs/spiffs" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spiffs_procfs_register
+ *
+ * Description:
+ *   Add a mounted volume to the list of volumes that are reported by the
+ *   procfs "fs/spiffs" statistics file.
+ *
+ ****************************************************************************/
+
+void spiffs_procfs_register(FAR struct spiffs_s *fs)
+{
+  nxsem_wait_uninterruptible(&g_spiffs_volsem);
+  fs->flink        = g_spiffs_volumes;
+  g_spiffs_volumes = fs;
+  nxsem_post(&g_spiffs_volsem);
+}
+
+/****************************************************************************
+ * Name: spiffs_procfs_unregister
+ *
+ * Description:
+ *   Remove a volume from the list of volumes that are reported by the
+ *   procfs "fs/spiffs" statistics file.
+ *
+ ****************************************************************************/
+
+void spiffs_procfs_unregister(FAR struct spiffs_s *fs)
+{
+  FAR struct spiffs_s **prev;
+
+  nxsem_wait_uninterruptible(&g_spiffs_volsem);
+  for (prev = &g_spiffs_volumes; *prev != NULL; prev = &(*prev)->flink)
+    {
+      if (*prev == fs)
+        {
+          *prev = fs->flink;
+          break;
+        }
+    }
+
+  nxsem_post(&g_spiffs_volsem);
+}
+
+#endif /* HAVE_SPIFFS_PROCFS */
@@ -48,6 +48,7 @@
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
 #include <dirent.h>
@@ -1403,6 +1404,58 @@ static int spiffs_rewinddir(FAR struct inode *mountpt,
   return OK;
 }
 
+/****************************************************************************
+ * Name: spiffs_parse_options
+ *
+ * Description:
+ *   Parse the mount data.  The supported options are:
+ *
+ *   cache_pages=N     - Size the shared page cache to hold N pages instead
+ *                       of CONFIG_SPIFFS_CACHE_SIZE bytes.  The write cache
+ *                       pages of opened files come from the same pool.
+ *   lucache_entries=N - Number of object lookup cache entries (0 disables
+ *                       the object lookup cache)
+ *
+ *   Unknown options are ignored.
+ *
+ ****************************************************************************/
+
+static void spiffs_parse_options(FAR const char *data,
+                                 FAR unsigned long *cache_pages,
+                                 FAR unsigned long *lu_nentries)
+{
+  FAR const char *end;
+  size_t len;
+
+  *cache_pages = 0;
+#ifdef CONFIG_SPIFFS_LUCACHE
+  *lu_nentries = CONFIG_SPIFFS_LUCACHE_NENTRIES;
+#else
+  *lu_nentries = 0;
+#endif
+
+  while (data != NULL && *data != '\0')
+    {
+      end = strchr(data, ',');
+      len = end != NULL ? end - data : strlen(data);
+
+      if (len > 12 && strncmp(data, "cache_pages=", 12) == 0)
+        {
+          *cache_pages = strtoul(data + 12, NULL, 0);
+        }
+      else if (len > 16 && strncmp(data, "lucache_entries=", 16) == 0)
+        {
+          *lu_nentries = strtoul(data + 16, NULL, 0);
+        }
+      else
+        {
+          fwarn("WARNING: Unknown option %.*s\n", (int)len, data);
+        }
+
+      data = end != NULL ? end + 1 : NULL;
+    }
+}
+
 /****************************************************************************
  * Name: spiffs_bind
  ****************************************************************************/
@@ -1413,6 +1466,8 @@ static int spiffs_bind(FAR struct inode *mtdinode, FAR const void *data,
   FAR struct spiffs_s *fs;
   FAR struct mtd_dev_s *mtd;
   FAR uint8_t *work;
+  unsigned long cache_pages;
+  unsigned long lu_nentries;
   size_t cache_size;
   size_t cache_max;
   size_t work_size;
@@ -1422,6 +1477,8 @@ static int spiffs_bind(FAR struct inode *mtdinode, FAR const void *data,
   finfo("mtdinode=%p data=%p handle=%p\n", mtdinode, data, handle);
   DEBUGASSERT(mtdinode != NULL && handle != NULL);
 
+  spiffs_parse_options(data, &cache_pages, &lu_nentries);
+
   /* Extract the MTD interface reference */
 
   DEBUGASSERT(INODE_IS_MTD(mtdinode) && mtdinode->u.i_mtd != NULL);
@@ -1455,14 +1512,32 @@ static int spiffs_bind(FAR struct inode *mtdinode, FAR const void *data,
   fs->pages_per_block = SPIFFS_GEO_EBLOCK_SIZE(fs) /
                         SPIFFS_GEO_PAGE_SIZE(fs);
 
-  /* Get the aligned cache size */
+  /* Get the aligned cache size.  The cache use map limits the cache to 32
+   * pages.
+   */
 
   addrmask   = (sizeof(FAR void *) - 1);
-  cache_size = (CONFIG_SPIFFS_CACHE_SIZE + addrmask) & ~addrmask;
+  if (cache_pages > 0)
+    {
+      if (cache_pages > 32)
+        {
+          cache_pages = 32;
+        }
+
+      cache_size = sizeof(struct spiffs_cache_s) +
+                   cache_pages * SPIFFS_CACHE_PAGE_SIZE(fs);
+      cache_max  = cache_size;
+    }
+  else
+    {
+      cache_size = CONFIG_SPIFFS_CACHE_SIZE;
+      cache_max  = SPIFFS_GEO_PAGE_SIZE(fs) << 5;
+    }
+
+  cache_size = (cache_size + addrmask) & ~addrmask;
 
   /* Don't let the cache size exceed the maximum that is needed */
 
-  cache_max  = SPIFFS_GEO_PAGE_SIZE(fs) << 5;
   if (cache_size > cache_max)
     {
       cache_size = cache_max;
@@ -1482,6 +1557,33 @@ static int spiffs_bind(FAR struct inode *mtdinode, FAR const void *data,
 
   spiffs_cache_initialize(fs);
 
+#ifdef CONFIG_SPIFFS_LUCACHE
+  /* Allocate the object lookup cache.  Failure to do so is not fatal; the
+   * object lookup pages are then always scanned.
+   */
+
+  if (lu_nentries > UINT16_MAX)
+    {
+      lu_nentries = UINT16_MAX;
+    }
+
+  if (lu_nentries > 0)
+    {
+      fs->lucache = (FAR struct spiffs_lucache_s *)
+        kmm_malloc(lu_nentries * sizeof(struct spiffs_lucache_s));
+      if (fs->lucache != NULL)
+        {
+          memset(fs->lucache, 0xff,
+                 lu_nentries * sizeof(struct spiffs_lucache_s));
+          fs->lu_nentries = lu_nentries;
+        }
+      else
+        {
+          fwarn("WARNING: Failed to allocate object lookup cache\n");
+        }
+    }
+#endif
+
   /* Allocate the memory work buffer comprising 3*config->page_size bytes
    * used throughout all file system operations.
    *
@@ -1541,6 +1643,13 @@ static int spiffs_bind(FAR struct inode *mtdinode, FAR const void *data,
     }
 #endif
 
+  /* Make the volume statistics visible in the procfs */
+
+#ifdef HAVE_SPIFFS_PROCFS
+  fs->devname = mtdinode->i_name;
+#endif
+  spiffs_procfs_register(fs);
+
   /* Return the new file system handle */
 
   *handle = (FAR void *)fs;
@@ -1550,6 +1659,13 @@ errout_with_work:
   kmm_free(fs->work);
 
 errout_with_cache:
+#ifdef CONFIG_SPIFFS_LUCACHE
+  if (fs->lucache != NULL)
+    {
+      kmm_free(fs->lucache);
+    }
+
+#endif
   kmm_free(fs->cache);
 
 errout_with_volume:
@@ -1594,6 +1710,10 @@ static int spiffs_unbind(FAR void *handle, FAR struct inode **mtdinode,
       spiffs_fobj_free(fs, fobj, false);
     }
 
+  /* Remove the volume from the procfs statistics */
+
+  spiffs_procfs_unregister(fs);
+
   /* Free allocated working buffers */
 
   if (fs->work != NULL)
@@ -1606,6 +1726,13 @@ static int spiffs_unbind(FAR void *handle, FAR struct inode **mtdinode,
       kmm_free(fs->cache);
     }
 
+#ifdef CONFIG_SPIFFS_LUCACHE
+  if (fs->lucache != NULL)
+    {
+      kmm_free(fs->lucache);
+    }
+#endif
+
   /* Free the volume memory (note that the semaphore is now stale!) */
 
   nxsem_destroy(&fs->exclsem.sem);
@@ -55,6 +55,24 @@
 #  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
+/* The size of the file data chunks.  Zero selects one contiguous chunk. */
+
+#if CONFIG_FS_TMPFS_FILE_CHUNKSIZE > 0
+#  define TMPFS_CHUNKSIZE ((size_t)CONFIG_FS_TMPFS_FILE_CHUNKSIZE)
+#else
+#  define TMPFS_CHUNKSIZE SIZE_MAX
+#endif
+
+/* The number of chunks needed to hold n bytes */
+
+#define TMPFS_NCHUNKS(n) ((n) == 0 ? 0 : ((n) - 1) / TMPFS_CHUNKSIZE + 1)
+
+/* The initial number of hash buckets of a directory.  The number doubles
+ * whenever the directory holds more than two entries per bucket.
+ */
+
+#define TMPFS_MIN_BUCKETS 8
+
 #define tmpfs_lock_file(tfo) \
            (tmpfs_lock_object((FAR struct tmpfs_object_s *)tfo))
 #define tmpfs_lock_directory(tdo) \
@@ -80,6 +98,8 @@ static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
               unsigned int nentries);
 static int  tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
+static void tmpfs_copy_file(FAR struct tmpfs_file_s *tfo, size_t offset,
+              FAR void *dest, FAR const void *src, size_t nbytes);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
@@ -342,6 +362,115 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
   return ret;
 }
 
+/****************************************************************************
+ * Name: tmpfs_file_chunk
+ *
+ * Description:
+ *   Return the location of the pointer to one data chunk of a file.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t **tmpfs_file_chunk(FAR struct tmpfs_file_s *tfo,
+                                      size_t index)
+{
+  return index == 0 ? &tfo->tfo_data : &tfo->tfo_chunks[index - 1];
+}
+
+/****************************************************************************
+ * Name: tmpfs_chunk_slots
+ *
+ * Description:
+ *   Return the number of entries allocated in tfo_chunks for a file with
+ *   nchunks data chunks.  The array grows in powers of two, so that adding
+ *   a chunk does not copy the array each time.
+ *
+ ****************************************************************************/
+
+static size_t tmpfs_chunk_slots(size_t nchunks)
+{
+  size_t nslots = 1;
+
+  if (nchunks <= 1)
+    {
+      return 0;
+    }
+
+  while (nslots < nchunks - 1)
+    {
+      nslots <<= 1;
+    }
+
+  return nslots;
+}
+
+/****************************************************************************
+ * Name: tmpfs_realloc_chunks
+ *
+ * Description:
+ *   Resize the array of chunk pointers of a file for nchunks chunks.  The
+ *   chunks beyond nchunks must already have been freed.
+ *
+ ****************************************************************************/
+
+static int tmpfs_realloc_chunks(FAR struct tmpfs_file_s *tfo,
+                                size_t nchunks)
+{
+  FAR uint8_t **newchunks;
+  size_t nslots;
+  size_t oldslots;
+
+  nslots   = tmpfs_chunk_slots(nchunks);
+  oldslots = tmpfs_chunk_slots(tfo->tfo_nchunks);
+  if (nslots == oldslots)
+    {
+      return OK;
+    }
+
+  if (nslots == 0)
+    {
+      kmm_free(tfo->tfo_chunks);
+      tfo->tfo_chunks = NULL;
+      return OK;
+    }
+
+  newchunks = kmm_realloc(tfo->tfo_chunks, nslots * sizeof(FAR uint8_t *));
+  if (newchunks == NULL)
+    {
+      /* Failing to shrink the array is harmless */
+
+      return nslots < oldslots ? OK : -ENOMEM;
+    }
+
+  tfo->tfo_chunks = newchunks;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_realloc_tail
+ *
+ * Description:
+ *   Reallocate the last data chunk of a file to allocsize bytes.
+ *
+ ****************************************************************************/
+
+static int tmpfs_realloc_tail(FAR struct tmpfs_file_s *tfo,
+                              size_t allocsize)
+{
+  FAR uint8_t **chunk;
+  FAR uint8_t *newdata;
+
+  chunk   = tmpfs_file_chunk(tfo, tfo->tfo_nchunks - 1);
+  newdata = kmm_realloc(*chunk, allocsize);
+  if (newdata == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  *chunk         = newdata;
+  tfo->tfo_alloc = (tfo->tfo_nchunks - 1) * TMPFS_CHUNKSIZE + allocsize;
+  return OK;
+}
+
 /****************************************************************************
  * Name: tmpfs_realloc_file
  ****************************************************************************/
@@ -351,53 +480,152 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
 {
   FAR uint8_t *newdata;
   size_t allocsize;
-  size_t delta;
+  size_t tailalloc;
+  size_t tailsize;
+  size_t nchunks;
+  size_t index;
+  int ret;
+
+  nchunks = TMPFS_NCHUNKS(newsize);
+  if (nchunks < tfo->tfo_nchunks)
+    {
+      /* Free the chunks beyond the new end of the file.  The chunk that
+       * becomes the last one is a full chunk.
+       */
 
-  /* Are we growing or shrinking the object? */
+      for (index = nchunks; index < tfo->tfo_nchunks; index++)
+        {
+          kmm_free(*tmpfs_file_chunk(tfo, index));
+        }
+
+      if (nchunks == 0)
+        {
+          tfo->tfo_data = NULL;
+        }
 
-  if (newsize <= tfo->tfo_alloc)
+      tmpfs_realloc_chunks(tfo, nchunks);
+      tfo->tfo_nchunks = nchunks;
+      tfo->tfo_alloc   = nchunks * TMPFS_CHUNKSIZE;
+    }
+  else if (nchunks > tfo->tfo_nchunks)
     {
-      /* Shrinking ... Shrink unconditionally if the size is shrinking to
-       * zero.
+      ret = tmpfs_realloc_chunks(tfo, nchunks);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Fill up the old last chunk, then add full chunks up to the new
+       * last one.  Only the last chunk is ever reallocated, so growing the
+       * file never copies more than one chunk.
        */
 
-      if (newsize > 0)
+      if (tfo->tfo_nchunks > 0)
         {
-          /* Otherwise, don't realloc unless the object has shrunk by a
-           * lot.
-           */
+          ret = tmpfs_realloc_tail(tfo, TMPFS_CHUNKSIZE);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
 
-          delta = tfo->tfo_alloc - newsize;
-          if (delta <= CONFIG_FS_TMPFS_FILE_FREEGUARD)
+      while (tfo->tfo_nchunks < nchunks - 1)
+        {
+          newdata = kmm_malloc(TMPFS_CHUNKSIZE);
+          if (newdata == NULL)
             {
-              /* Hasn't shrunk enough.. Return doing nothing for now */
+              return -ENOMEM;
+            }
 
-              tfo->tfo_size = newsize;
-              return OK;
+          *tmpfs_file_chunk(tfo, tfo->tfo_nchunks++) = newdata;
+          tfo->tfo_alloc += TMPFS_CHUNKSIZE;
+        }
+
+      /* Add an empty last chunk, it is allocated below */
+
+      *tmpfs_file_chunk(tfo, tfo->tfo_nchunks++) = NULL;
+    }
+
+  if (nchunks > 0)
+    {
+      /* Don't realloc the last chunk unless it is too small or has shrunk
+       * by a lot.  Add some additional amount to the new size to account
+       * frequent reallocations.
+       */
+
+      tailsize  = newsize - (nchunks - 1) * TMPFS_CHUNKSIZE;
+      tailalloc = tfo->tfo_alloc - (nchunks - 1) * TMPFS_CHUNKSIZE;
+
+      if (tailsize > tailalloc ||
+          tailalloc - tailsize > CONFIG_FS_TMPFS_FILE_FREEGUARD)
+        {
+          allocsize = tailsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
+          if (allocsize > TMPFS_CHUNKSIZE || allocsize < tailsize)
+            {
+              allocsize = TMPFS_CHUNKSIZE;
+            }
+
+          ret = tmpfs_realloc_tail(tfo, allocsize);
+          if (ret < 0)
+            {
+              return ret;
             }
         }
     }
 
-  /* Added some additional amount to the new size to account frequent
-   * reallocations.
-   */
+  tfo->tfo_size = newsize;
+  return OK;
+}
 
-  allocsize = newsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
+/****************************************************************************
+ * Name: tmpfs_copy_file
+ *
+ * Description:
+ *   Copy nbytes of file data at offset to dest, or from src to the file
+ *   data if dest is NULL.  The file data is zeroed if both are NULL.
+ *
+ ****************************************************************************/
+
+static void tmpfs_copy_file(FAR struct tmpfs_file_s *tfo, size_t offset,
+                            FAR void *dest, FAR const void *src,
+                            size_t nbytes)
+{
+  FAR uint8_t *data;
+  size_t chunkoff;
+  size_t index;
+  size_t ncopy;
 
-  /* Realloc the file object */
+  index    = offset / TMPFS_CHUNKSIZE;
+  chunkoff = offset % TMPFS_CHUNKSIZE;
 
-  newdata = kmm_realloc(tfo->tfo_data, allocsize);
-  if (newdata == NULL)
+  while (nbytes > 0)
     {
-      return -ENOMEM;
-    }
+      data  = *tmpfs_file_chunk(tfo, index) + chunkoff;
+      ncopy = TMPFS_CHUNKSIZE - chunkoff;
+      if (ncopy > nbytes)
+        {
+          ncopy = nbytes;
+        }
 
-  /* Return the new address of the reallocated file object */
+      if (dest != NULL)
+        {
+          memcpy(dest, data, ncopy);
+          dest = (FAR uint8_t *)dest + ncopy;
+        }
+      else if (src != NULL)
+        {
+          memcpy(data, src, ncopy);
+          src = (FAR const uint8_t *)src + ncopy;
+        }
+      else
+        {
+          memset(data, 0, ncopy);
+        }
 
-  tfo->tfo_alloc = allocsize;
-  tfo->tfo_size  = newsize;
-  tfo->tfo_data  = newdata;
-  return OK;
+      nbytes  -= ncopy;
+      chunkoff = 0;
+      index++;
+    }
 }
 
 /****************************************************************************
@@ -436,7 +664,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
   if (tfo->tfo_refs == 1 && (tfo->tfo_flags & TFO_FLAG_UNLINKED) != 0)
     {
       nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
-      kmm_free(tfo->tfo_data);
+      tmpfs_realloc_file(tfo, 0);
       kmm_free(tfo);
     }
 
@@ -449,6 +677,119 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
     }
 }
 
+/****************************************************************************
+ * Name: tmpfs_hash_name
+ *
+ * Description:
+ *   Return the FNV-1a hash of a directory entry name.
+ *
+ ****************************************************************************/
+
+static uint32_t tmpfs_hash_name(FAR const char *name, size_t len)
+{
+  uint32_t hash = 2166136261u;
+
+  while (len-- > 0)
+    {
+      hash ^= (uint8_t)*name++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: tmpfs_rehash_directory
+ *
+ * Description:
+ *   Resize the hash table of a directory to nbuckets and rebuild the hash
+ *   chains.  Failing to allocate the table is harmless, the old table is
+ *   kept and the lookups only get slower.
+ *
+ ****************************************************************************/
+
+static void tmpfs_rehash_directory(FAR struct tmpfs_directory_s *tdo,
+                                   unsigned int nbuckets)
+{
+  FAR uint16_t *buckets;
+  unsigned int bucket;
+  unsigned int i;
+
+  buckets = kmm_realloc(tdo->tdo_buckets, nbuckets * sizeof(uint16_t));
+  if (buckets == NULL)
+    {
+      return;
+    }
+
+  memset(buckets, 0xff, nbuckets * sizeof(uint16_t));
+  for (i = 0; i < tdo->tdo_nentries; i++)
+    {
+      bucket = tdo->tdo_entry[i].tde_hash & (nbuckets - 1);
+      tdo->tdo_entry[i].tde_next = buckets[bucket];
+      buckets[bucket] = i;
+    }
+
+  tdo->tdo_buckets  = buckets;
+  tdo->tdo_nbuckets = nbuckets;
+}
+
+/****************************************************************************
+ * Name: tmpfs_dirent_link
+ *
+ * Description:
+ *   Return the location of the hash chain link that refers to a directory
+ *   entry.
+ *
+ ****************************************************************************/
+
+static FAR uint16_t *tmpfs_dirent_link(FAR struct tmpfs_directory_s *tdo,
+                                       unsigned int index)
+{
+  FAR uint16_t *link;
+
+  link = &tdo->tdo_buckets[tdo->tdo_entry[index].tde_hash &
+                           (tdo->tdo_nbuckets - 1)];
+  while (*link != index)
+    {
+      link = &tdo->tdo_entry[*link].tde_next;
+    }
+
+  return link;
+}
+
+/****************************************************************************
+ * Name: tmpfs_delete_dirent
+ *
+ * Description:
+ *   Remove a directory entry by replacing it with the final directory
+ *   entry.  The name of the entry must already have been freed.
+ *
+ ****************************************************************************/
+
+static void tmpfs_delete_dirent(FAR struct tmpfs_directory_s *tdo,
+                                unsigned int index)
+{
+  unsigned int last = tdo->tdo_nentries - 1;
+
+  if (tdo->tdo_nbuckets > 0)
+    {
+      *tmpfs_dirent_link(tdo, index) = tdo->tdo_entry[index].tde_next;
+      if (index != last)
+        {
+          *tmpfs_dirent_link(tdo, last) = index;
+        }
+    }
+
+  if (index != last)
+    {
+      tdo->tdo_entry[index] = tdo->tdo_entry[last];
+    }
+
+  /* And decrement the count of directory entries */
+
+  tdo->tdo_nentries = last;
+}
+
 /****************************************************************************
  * Name: tmpfs_find_dirent
  ****************************************************************************/
@@ -456,6 +797,8 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
 static int tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
                              FAR const char *name, size_t len)
 {
+  FAR struct tmpfs_dirent_s *tde;
+  uint32_t hash;
   int i;
 
   if (len == 0)
@@ -472,17 +815,27 @@ static int tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
         }
     }
 
-  /* Search the list of directory entries for a match */
+  /* Search the hash chain of the name, or all directory entries if there
+   * is no hash table, for a match.
+   */
 
-  for (i = 0;
-       i < tdo->tdo_nentries &&
-       (strncmp(tdo->tdo_entry[i].tde_name, name, len) != 0 ||
-       tdo->tdo_entry[i].tde_name[len] != 0);
-       i++);
+  hash = tmpfs_hash_name(name, len);
+  i    = tdo->tdo_nbuckets > 0 ?
+         tdo->tdo_buckets[hash & (tdo->tdo_nbuckets - 1)] : 0;
+
+  while (i < tdo->tdo_nentries)
+    {
+      tde = &tdo->tdo_entry[i];
+      if (tde->tde_hash == hash && strncmp(tde->tde_name, name, len) == 0 &&
+          tde->tde_name[len] == '\0')
+        {
+          return i;
+        }
 
-  /* Return what we found, if anything */
+      i = tdo->tdo_nbuckets > 0 ? tde->tde_next : i + 1;
+    }
 
-  return i < tdo->tdo_nentries ? i : -ENOENT;
+  return -ENOENT;
 }
 
 /****************************************************************************
@@ -493,7 +846,6 @@ static int tmpfs_remove_dirent(FAR struct tmpfs_directory_s *tdo,
                                FAR const char *name)
 {
   int index;
-  int last;
 
   /* Search the list of directory entries for a match */
 
@@ -512,15 +864,7 @@ static int tmpfs_remove_dirent(FAR struct tmpfs_directory_s *tdo,
 
   /* Remove by replacing this entry with the final directory entry */
 
-  last = tdo->tdo_nentries - 1;
-  if (index != last)
-    {
-      tdo->tdo_entry[index] = tdo->tdo_entry[last];
-    }
-
-  /* And decrement the count of directory entries */
-
-  tdo->tdo_nentries = last;
+  tmpfs_delete_dirent(tdo, index);
   return OK;
 }
 
@@ -535,9 +879,17 @@ static int tmpfs_add_dirent(FAR struct tmpfs_directory_s *tdo,
   FAR struct tmpfs_dirent_s *tde;
   FAR char *newname;
   unsigned int nentries;
+  unsigned int bucket;
   size_t namelen;
   int index;
 
+  /* The entry indices must fit in the hash chain links */
+
+  if (tdo->tdo_nentries >= TMPFS_NO_DIRENT)
+    {
+      return -ENOSPC;
+    }
+
   /* Copy the name string so that it will persist as long as the
    * directory entry.
    */
@@ -581,6 +933,29 @@ static int tmpfs_add_dirent(FAR struct tmpfs_directory_s *tdo,
   tde             = &tdo->tdo_entry[index];
   tde->tde_object = to;
   tde->tde_name   = newname;
+  tde->tde_hash   = tmpfs_hash_name(newname, namelen);
+  tde->tde_next   = TMPFS_NO_DIRENT;
+
+  /* Add the entry to its hash chain, then grow the hash table if the
+   * chains got too long.
+   */
+
+  if (tdo->tdo_nbuckets > 0)
+    {
+      bucket = tde->tde_hash & (tdo->tdo_nbuckets - 1);
+      tde->tde_next = tdo->tdo_buckets[bucket];
+      tdo->tdo_buckets[bucket] = index;
+    }
+
+  if (tdo->tdo_nbuckets == 0)
+    {
+      tmpfs_rehash_directory(tdo, TMPFS_MIN_BUCKETS);
+    }
+  else if (nentries > 2 * tdo->tdo_nbuckets &&
+           tdo->tdo_nbuckets < (TMPFS_NO_DIRENT + 1) / 2)
+    {
+      tmpfs_rehash_directory(tdo, 2 * tdo->tdo_nbuckets);
+    }
 
   return OK;
 }
@@ -610,7 +985,9 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
   tfo->tfo_refs  = 1;
   tfo->tfo_flags = 0;
   tfo->tfo_size  = 0;
+  tfo->tfo_nchunks = 0;
   tfo->tfo_data  = NULL;
+  tfo->tfo_chunks = NULL;
 
   tfo->tfo_exclsem.ts_holder = getpid();
   tfo->tfo_exclsem.ts_count  = 1;
@@ -758,6 +1135,8 @@ static FAR struct tmpfs_directory_s *tmpfs_alloc_directory(void)
   tdo->tdo_type     = TMPFS_DIRECTORY;
   tdo->tdo_refs     = 0;
   tdo->tdo_nentries = 0;
+  tdo->tdo_nbuckets = 0;
+  tdo->tdo_buckets  = NULL;
   tdo->tdo_entry    = NULL;
 
   tdo->tdo_exclsem.ts_holder = TMPFS_NO_HOLDER;
@@ -1195,10 +1574,8 @@ static int tmpfs_statfs_callout(FAR struct tmpfs_directory_s *tdo,
 static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
                               unsigned int index, FAR void *arg)
 {
-  FAR struct tmpfs_dirent_s *tde;
   FAR struct tmpfs_object_s *to;
   FAR struct tmpfs_file_s *tfo;
-  unsigned int last;
 
   /* Free the object name */
 
@@ -1209,20 +1586,8 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
 
   /* Remove by replacing this entry with the final directory entry */
 
-  tde  = &tdo->tdo_entry[index];
-  to   = tde->tde_object;
-  last = tdo->tdo_nentries - 1;
-
-  if (index != last)
-    {
-      /* Move the directory entry */
-
-      *tde = tdo->tdo_entry[last];
-    }
-
-  /* And decrement the count of directory entries */
-
-  tdo->tdo_nentries = last;
+  to = tdo->tdo_entry[index].tde_object;
+  tmpfs_delete_dirent(tdo, index);
 
   /* Is this directory entry a file object? */
 
@@ -1240,12 +1605,13 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           return TMPFS_UNLINKED;
         }
 
-      kmm_free(tfo->tfo_data);
+      tmpfs_realloc_file(tfo, 0);
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
       tdo = (FAR struct tmpfs_directory_s *)to;
 
+      kmm_free(tdo->tdo_buckets);
       kmm_free(tdo->tdo_entry);
     }
 
@@ -1533,7 +1899,7 @@ static int tmpfs_close(FAR struct file *filep)
        * have any other references.
        */
 
-      kmm_free(tfo->tfo_data);
+      tmpfs_realloc_file(tfo, 0);
       kmm_free(tfo);
       return OK;
     }
@@ -1579,7 +1945,11 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
   nread    = buflen;
   endpos   = startpos + buflen;
 
-  if (endpos > tfo->tfo_size)
+  if (startpos >= tfo->tfo_size)
+    {
+      nread = 0;
+    }
+  else if (endpos > tfo->tfo_size)
     {
       endpos = tfo->tfo_size;
       nread  = endpos - startpos;
@@ -1587,7 +1957,7 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Copy data from the memory object to the user buffer */
 
-  memcpy(buffer, &tfo->tfo_data[startpos], nread);
+  tmpfs_copy_file(tfo, startpos, buffer, NULL, nread);
   filep->f_pos += nread;
 
   /* Release the lock on the file */
@@ -1605,6 +1975,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 {
   FAR struct tmpfs_file_s *tfo;
   ssize_t nwritten;
+  size_t oldsize;
   off_t startpos;
   off_t endpos;
   int ret;
@@ -1635,16 +2006,24 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
     {
       /* Reallocate the file to handle the write past the end of the file. */
 
+      oldsize = tfo->tfo_size;
       ret = tmpfs_realloc_file(tfo, (size_t)endpos);
       if (ret < 0)
         {
           goto errout_with_lock;
         }
+
+      /* Zero the gap if the write starts beyond the old end of file */
+
+      if (startpos > oldsize)
+        {
+          tmpfs_copy_file(tfo, oldsize, NULL, NULL, startpos - oldsize);
+        }
     }
 
-  /* Copy data from the memory object to the user buffer */
+  /* Copy data from the user buffer to the memory object */
 
-  memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
+  tmpfs_copy_file(tfo, startpos, NULL, buffer, nwritten);
   filep->f_pos += nwritten;
 
   /* Release the lock on the file */
@@ -1740,9 +2119,15 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   if (cmd == FIOC_MMAP && ppv != NULL)
     {
       /* Return the address on the media corresponding to the start of
-       * the file.
+       * the file.  That is only possible if all of the data is in one
+       * chunk, otherwise mmap() has to fall back to a copy of the file.
        */
 
+      if (tfo->tfo_nchunks > 1)
+        {
+          return -ENOTTY;
+        }
+
       *ppv = (FAR void *)tfo->tfo_data;
       return OK;
     }
@@ -1884,7 +2269,7 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
 
       if (length > oldsize)
         {
-          memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
+          tmpfs_copy_file(tfo, oldsize, NULL, NULL, length - oldsize);
         }
 
       ret = OK;
@@ -2148,6 +2533,7 @@ static int tmpfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
   /* Now we can destroy the root file system and the file system itself. */
 
   nxsem_destroy(&tdo->tdo_exclsem.ts_sem);
+  kmm_free(tdo->tdo_buckets);
   kmm_free(tdo->tdo_entry);
   kmm_free(tdo);
 
@@ -2315,7 +2701,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
-      kmm_free(tfo->tfo_data);
+      tmpfs_realloc_file(tfo, 0);
       kmm_free(tfo);
     }
 
@@ -2457,6 +2843,7 @@ static int tmpfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
   /* Free the directory object */
 
   nxsem_destroy(&tdo->tdo_exclsem.ts_sem);
+  kmm_free(tdo->tdo_buckets);
   kmm_free(tdo->tdo_entry);
   kmm_free(tdo);
 
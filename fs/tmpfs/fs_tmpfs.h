@@ -44,6 +44,10 @@
 
 #define TFO_FLAG_UNLINKED (1 << 0)  /* Bit 0: File is unlinked */
 
+/* Marks the end of a directory hash chain */
+
+#define TMPFS_NO_DIRENT   0xffff
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -81,6 +85,8 @@ struct tmpfs_dirent_s
 {
   FAR struct tmpfs_object_s *tde_object;
   FAR char *tde_name;
+  uint32_t tde_hash;     /* Hash of the name */
+  uint16_t tde_next;     /* Next entry in the same hash bucket */
 };
 
 /* The generic form of a TMPFS memory object */
@@ -109,6 +115,11 @@ struct tmpfs_directory_s
   /* Remaining fields are unique to a directory object */
 
   uint16_t tdo_nentries; /* Number of directory entries */
+  uint16_t tdo_nbuckets; /* Number of hash buckets, a power of two */
+
+  /* First entry of each hash bucket and the directory entries */
+
+  FAR uint16_t *tdo_buckets;
   FAR struct tmpfs_dirent_s *tdo_entry;
 };
 
@@ -120,6 +131,11 @@ struct tmpfs_directory_s
  * state.  The file memory object also serves as the open file object,
  * saving an allocation.  This has the negative side effect that no per-
  * open state can be retained (such as open flags).
+ *
+ * The file data is held in chunks of CONFIG_FS_TMPFS_FILE_CHUNKSIZE bytes,
+ * so that growing a file never copies more than one chunk.  All chunks but
+ * the last one are full, the last one is only allocated as far as needed.
+ * tfo_data is the first chunk, tfo_chunks the array of the others.
  */
 
 struct tmpfs_file_s
@@ -134,9 +150,11 @@ struct tmpfs_file_s
 
   /* Remaining fields are unique to a directory object */
 
-  uint8_t       tfo_flags; /* See TFO_FLAG_* definitions */
-  size_t        tfo_size;  /* Valid file size */
-  FAR uint8_t  *tfo_data;  /* File data starts here */
+  uint8_t       tfo_flags;   /* See TFO_FLAG_* definitions */
+  size_t        tfo_size;    /* Valid file size */
+  size_t        tfo_nchunks; /* Number of data chunks */
+  FAR uint8_t  *tfo_data;    /* File data starts here */
+  FAR uint8_t **tfo_chunks;  /* Data chunks after the first one */
 };
 
 /* This structure represents one instance of a TMPFS file system */
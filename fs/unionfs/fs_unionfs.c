@@ -59,6 +59,18 @@
 #define MIN(a,b) (((a) < (b)) ? (a) : (b))
 #define MAX(a,b) (((a) > (b)) ? (a) : (b))
 
+/* Size of the per-opendir map of names seen on file system 1.  One bit per
+ * name hash; a clear bit proves that a name from file system 2 is not
+ * occluded, so it can be returned without a stat on file system 1.
+ */
+
+#define UNIONFS_NAMEMAP_BITS  512
+#define UNIONFS_NAMEMAP_BIT(h) ((h) & (UNIONFS_NAMEMAP_BITS - 1))
+
+#ifndef CONFIG_FS_UNIONFS_NLOOKUP
+#  define CONFIG_FS_UNIONFS_NLOOKUP 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -71,6 +83,16 @@ struct unionfs_mountpt_s
   FAR char *um_prefix;               /* Path prefix to filesystem */
 };
 
+/* This structure describes one path known to be absent on file system 1 */
+
+#if CONFIG_FS_UNIONFS_NLOOKUP > 0
+struct unionfs_nlookup_s
+{
+  uint32_t nl_hash;                  /* Hash of nl_path */
+  FAR char *nl_path;                 /* Relative path, NULL if unused */
+};
+#endif
+
 /* This structure describes the union file system */
 
 struct unionfs_inode_s
@@ -79,6 +101,14 @@ struct unionfs_inode_s
   sem_t ui_exclsem;                  /* Enforces mutually exclusive access */
   int16_t ui_nopen;                  /* Number of open references */
   bool ui_unmounted;                 /* File system has been unmounted */
+#if CONFIG_FS_UNIONFS_NLOOKUP > 0
+  uint8_t ui_nlnext;                 /* Next negative entry to replace */
+  sem_t ui_nlsem;                    /* Protects ui_nlookup[] */
+
+  /* Negative lookup cache for file system 1 */
+
+  struct unionfs_nlookup_s ui_nlookup[CONFIG_FS_UNIONFS_NLOOKUP];
+#endif
 };
 
 /* This structure descries one opened file */
@@ -124,12 +154,28 @@ static int     unionfs_trystat(FAR struct inode *inode,
 static int     unionfs_trychstat(FAR struct inode *inode,
                  FAR const char *relpath, FAR const char *prefix,
                  FAR const struct stat *buf, int flags);
+static int     unionfs_trystat0(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath, FAR struct stat *buf);
 static int     unionfs_trystatdir(FAR struct inode *inode,
                  FAR const char *relpath, FAR const char *prefix);
 static int     unionfs_trystatfile(FAR struct inode *inode,
                  FAR const char *relpath, FAR const char *prefix);
 static FAR char *unionfs_relpath(FAR const char *path,
                  FAR const char *name);
+static uint32_t unionfs_hash(FAR const char *str);
+static bool    unionfs_namemap(FAR struct fs_unionfsdir_s *fu,
+                 FAR const char *name, bool add);
+#if CONFIG_FS_UNIONFS_NLOOKUP > 0
+static bool    unionfs_nlookup_find(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath);
+static void    unionfs_nlookup_add(FAR struct unionfs_inode_s *ui,
+                 FAR const char *relpath);
+static void    unionfs_nlookup_flush(FAR struct unionfs_inode_s *ui);
+#else
+#  define unionfs_nlookup_find(ui,relpath) false
+#  define unionfs_nlookup_add(ui,relpath)
+#  define unionfs_nlookup_flush(ui)
+#endif
 
 static int     unionfs_unbind_child(FAR struct unionfs_mountpt_s *um);
 static void    unionfs_destroy(FAR struct unionfs_inode_s *ui);
@@ -570,6 +616,35 @@ static int unionfs_trystat(FAR struct inode *inode, FAR const char *relpath,
   return ops->stat(inode, trypath, buf);
 }
 
+/****************************************************************************
+ * Name: unionfs_trystat0
+ *
+ * Description:
+ *   unionfs_trystat() on file system 1, consulting and updating the
+ *   negative lookup cache.
+ *
+ ****************************************************************************/
+
+static int unionfs_trystat0(FAR struct unionfs_inode_s *ui,
+                            FAR const char *relpath, FAR struct stat *buf)
+{
+  FAR struct unionfs_mountpt_s *um = &ui->ui_fs[0];
+  int ret;
+
+  if (unionfs_nlookup_find(ui, relpath))
+    {
+      return -ENOENT;
+    }
+
+  ret = unionfs_trystat(um->um_node, relpath, um->um_prefix, buf);
+  if (ret == -ENOENT)
+    {
+      unionfs_nlookup_add(ui, relpath);
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Name: unionfs_trychstat
  ****************************************************************************/
@@ -758,6 +833,165 @@ static FAR char *unionfs_relpath(FAR const char *path, FAR const char *name)
     }
 }
 
+/****************************************************************************
+ * Name: unionfs_hash
+ *
+ * Description:
+ *   FNV-1a hash of a string, used by the lookup caches.
+ *
+ ****************************************************************************/
+
+static uint32_t unionfs_hash(FAR const char *str)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*str != '\0')
+    {
+      hash ^= (uint8_t)*str++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: unionfs_namemap
+ *
+ * Description:
+ *   Add 'name' to the map of names seen on file system 1 of an open
+ *   directory or, if 'add' is false, test whether the name may have been
+ *   seen.  False means the name was definitely not seen; true (including
+ *   when there is no map) means that a stat is still needed to know.
+ *
+ ****************************************************************************/
+
+static bool unionfs_namemap(FAR struct fs_unionfsdir_s *fu,
+                            FAR const char *name, bool add)
+{
+  uint32_t bit;
+
+  if (fu->fu_names == NULL)
+    {
+      return true;
+    }
+
+  bit = UNIONFS_NAMEMAP_BIT(unionfs_hash(name));
+  if (add)
+    {
+      fu->fu_names[bit >> 3] |= 1 << (bit & 7);
+      return true;
+    }
+
+  return (fu->fu_names[bit >> 3] & (1 << (bit & 7))) != 0;
+}
+
+#if CONFIG_FS_UNIONFS_NLOOKUP > 0
+
+/****************************************************************************
+ * Name: unionfs_nlookup_find
+ *
+ * Description:
+ *   Return true if 'relpath' is known not to exist on file system 1, so
+ *   that the probe of file system 1 can be skipped.
+ *
+ *   The contained file systems are hidden once they are joined (see
+ *   unionfs_mount()), so every change to file system 1 is made through
+ *   this file and the cache is flushed whenever a name may appear there.
+ *
+ ****************************************************************************/
+
+static bool unionfs_nlookup_find(FAR struct unionfs_inode_s *ui,
+                                 FAR const char *relpath)
+{
+  uint32_t hash = unionfs_hash(relpath);
+  bool found = false;
+  int i;
+
+  nxsem_wait_uninterruptible(&ui->ui_nlsem);
+  for (i = 0; i < CONFIG_FS_UNIONFS_NLOOKUP; i++)
+    {
+      FAR struct unionfs_nlookup_s *nl = &ui->ui_nlookup[i];
+
+      if (nl->nl_path != NULL && nl->nl_hash == hash &&
+          strcmp(nl->nl_path, relpath) == 0)
+        {
+          found = true;
+          break;
+        }
+    }
+
+  nxsem_post(&ui->ui_nlsem);
+  return found;
+}
+
+/****************************************************************************
+ * Name: unionfs_nlookup_add
+ *
+ * Description:
+ *   Remember that 'relpath' does not exist on file system 1, replacing the
+ *   oldest entry when the cache is full.
+ *
+ ****************************************************************************/
+
+static void unionfs_nlookup_add(FAR struct unionfs_inode_s *ui,
+                                FAR const char *relpath)
+{
+  FAR struct unionfs_nlookup_s *nl;
+  FAR char *path;
+
+  path = strdup(relpath);
+  if (path == NULL)
+    {
+      return;
+    }
+
+  nxsem_wait_uninterruptible(&ui->ui_nlsem);
+
+  nl = &ui->ui_nlookup[ui->ui_nlnext];
+  if (++ui->ui_nlnext >= CONFIG_FS_UNIONFS_NLOOKUP)
+    {
+      ui->ui_nlnext = 0;
+    }
+
+  if (nl->nl_path != NULL)
+    {
+      kmm_free(nl->nl_path);
+    }
+
+  nl->nl_hash = unionfs_hash(relpath);
+  nl->nl_path = path;
+
+  nxsem_post(&ui->ui_nlsem);
+}
+
+/****************************************************************************
+ * Name: unionfs_nlookup_flush
+ *
+ * Description:
+ *   Forget all negative entries.  Called after anything that may have
+ *   created a name on file system 1.
+ *
+ ****************************************************************************/
+
+static void unionfs_nlookup_flush(FAR struct unionfs_inode_s *ui)
+{
+  int i;
+
+  nxsem_wait_uninterruptible(&ui->ui_nlsem);
+  for (i = 0; i < CONFIG_FS_UNIONFS_NLOOKUP; i++)
+    {
+      if (ui->ui_nlookup[i].nl_path != NULL)
+        {
+          kmm_free(ui->ui_nlookup[i].nl_path);
+          ui->ui_nlookup[i].nl_path = NULL;
+        }
+    }
+
+  ui->ui_nlnext = 0;
+  nxsem_post(&ui->ui_nlsem);
+}
+#endif /* CONFIG_FS_UNIONFS_NLOOKUP > 0 */
+
 /****************************************************************************
  * Name: unionfs_unbind_child
  ****************************************************************************/
@@ -851,6 +1085,10 @@ static void unionfs_destroy(FAR struct unionfs_inode_s *ui)
 
   /* And finally free the allocated unionfs state structure as well */
 
+#if CONFIG_FS_UNIONFS_NLOOKUP > 0
+  unionfs_nlookup_flush(ui);
+  nxsem_destroy(&ui->ui_nlsem);
+#endif
   nxsem_destroy(&ui->ui_exclsem);
   kmm_free(ui);
 }
@@ -903,10 +1141,34 @@ static int unionfs_open(FAR struct file *filep, FAR const char *relpath,
   uf->uf_file.f_inode  = um->um_node;
   uf->uf_file.f_priv   = NULL;
 
-  ret = unionfs_tryopen(&uf->uf_file, relpath, um->um_prefix, oflags, mode);
+  /* Skip file system 1 if the path is known to be absent there, unless
+   * the open could create it.
+   */
+
+  if ((oflags & O_CREAT) == 0 && unionfs_nlookup_find(ui, relpath))
+    {
+      ret = -ENOENT;
+    }
+  else
+    {
+      ret = unionfs_tryopen(&uf->uf_file, relpath, um->um_prefix, oflags,
+                            mode);
+      if (ret == -ENOENT && (oflags & O_CREAT) == 0)
+        {
+          unionfs_nlookup_add(ui, relpath);
+        }
+    }
+
   if (ret >= 0)
     {
-      /* Successfully opened on file system 1 */
+      /* Successfully opened on file system 1.  The file may have just been
+       * created.
+       */
+
+      if ((oflags & O_CREAT) != 0)
+        {
+          unionfs_nlookup_flush(ui);
+        }
 
       uf->uf_ndx = 0;
     }
@@ -1504,13 +1766,38 @@ static int unionfs_opendir(FAR struct inode *mountpt,
 
   um = &ui->ui_fs[0];
   lowerdir->fd_root = um->um_node;
-  ret = unionfs_tryopendir(um->um_node, relpath, um->um_prefix, lowerdir);
+
+  if (unionfs_nlookup_find(ui, relpath))
+    {
+      ret = -ENOENT;
+    }
+  else
+    {
+      ret = unionfs_tryopendir(um->um_node, relpath, um->um_prefix,
+                               lowerdir);
+      if (ret == -ENOENT)
+        {
+          unionfs_nlookup_add(ui, relpath);
+        }
+    }
+
   if (ret >= 0)
     {
       /* Save the file system 1 access info */
 
       fu->fu_ndx = 0;
       fu->fu_lower[0] = lowerdir;
+
+      /* If file system 2 will be enumerated too, collect the names seen
+       * on file system 1 so that most duplicate checks need no stat.  On
+       * allocation failure every entry is simply checked with a stat.
+       */
+
+      if (fu->fu_lower[1] != NULL)
+        {
+          fu->fu_names = (FAR uint8_t *)
+            kmm_zalloc(UNIONFS_NAMEMAP_BITS / 8);
+        }
     }
   else
     {
@@ -1636,13 +1923,19 @@ static int unionfs_closedir(FAR struct inode *mountpt,
         }
     }
 
-  /* Free any allocated path */
+  /* Free any allocated path and name map */
 
   if (fu->fu_relpath != NULL)
     {
       kmm_free(fu->fu_relpath);
     }
 
+  if (fu->fu_names != NULL)
+    {
+      kmm_free(fu->fu_names);
+      fu->fu_names = NULL;
+    }
+
   fu->fu_ndx      = 0;
   fu->fu_relpath  = NULL;
   fu->fu_lower[0] = NULL;
@@ -1880,7 +2173,15 @@ static int unionfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
            */
 
           duplicate = false;
-          if (ret >= 0 && fu->fu_ndx == 1 && fu->fu_lower[0] != NULL)
+          if (ret >= 0 && fu->fu_ndx == 0)
+            {
+              /* Record the name seen on file system 1 */
+
+              unionfs_namemap(fu, fu->fu_lower[0]->fd_dir.d_name, true);
+            }
+          else if (ret >= 0 && fu->fu_ndx == 1 && fu->fu_lower[0] != NULL &&
+                   unionfs_namemap(fu, fu->fu_lower[1]->fd_dir.d_name,
+                                   false))
             {
               /* Get the relative path to the same file on file system 1.
                * NOTE: the on any failures we just assume that the filep
@@ -2237,7 +2538,7 @@ static int unionfs_unlink(FAR struct inode *mountpt,
    */
 
   um  = &ui->ui_fs[0];
-  ret = unionfs_trystat(um->um_node, relpath, um->um_prefix, &buf);
+  ret = unionfs_trystat0(ui, relpath, &buf);
   if (ret >= 0)
     {
       /* Yes.. Try to unlink the file on file system 1 (perhaps exposing
@@ -2298,8 +2599,7 @@ static int unionfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Is there anything with this name on either file system? */
 
-  um  = &ui->ui_fs[0];
-  ret = unionfs_trystat(um->um_node, relpath, um->um_prefix, &buf);
+  ret = unionfs_trystat0(ui, relpath, &buf);
   if (ret >= 0)
     {
       return -EEXIST;
@@ -2316,6 +2616,10 @@ static int unionfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
 
   um  = &ui->ui_fs[0];
   ret1 = unionfs_trymkdir(um->um_node, relpath, um->um_prefix, mode);
+  if (ret1 >= 0)
+    {
+      unionfs_nlookup_flush(ui);
+    }
 
   um  = &ui->ui_fs[1];
   ret2 = unionfs_trymkdir(um->um_node, relpath, um->um_prefix, mode);
@@ -2426,6 +2730,10 @@ static int unionfs_rename(FAR struct inode *mountpt,
                               um->um_prefix);
       if (ret >= 0)
         {
+          /* The new name now exists on file system 1 */
+
+          unionfs_nlookup_flush(ui);
+
           /* Return immediately on success.  In the event that the file
            * exists in both file systems, this will produce the odd behavior
            * that one file on file system 1 was renamed but another obscured
@@ -2477,8 +2785,7 @@ static int unionfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* stat this path on file system 1 */
 
-  um  = &ui->ui_fs[0];
-  ret = unionfs_trystat(um->um_node, relpath, um->um_prefix, buf);
+  ret = unionfs_trystat0(ui, relpath, buf);
   if (ret >= 0)
     {
       /* Return on the first success.  The first instance of the file will
@@ -2659,6 +2966,9 @@ static int unionfs_dobind(FAR const char *fspath1, FAR const char *prefix1,
     }
 
   nxsem_init(&ui->ui_exclsem, 0, 1);
+#if CONFIG_FS_UNIONFS_NLOOKUP > 0
+  nxsem_init(&ui->ui_nlsem, 0, 1);
+#endif
 
   /* Get the inodes associated with fspath1 and fspath2 */
 
@@ -2726,6 +3036,9 @@ errout_with_fs1:
   inode_release(ui->ui_fs[0].um_node);
 
 errout_with_uinode:
+#if CONFIG_FS_UNIONFS_NLOOKUP > 0
+  nxsem_destroy(&ui->ui_nlsem);
+#endif
   nxsem_destroy(&ui->ui_exclsem);
   kmm_free(ui);
   return ret;
@@ -2789,6 +3102,7 @@ int unionfs_mount(FAR const char *fspath1, FAR const char *prefix1,
   /* Populate the inode with driver specific information. */
 
   INODE_SET_MOUNTPT(mpinode);
+  inode_cache_invalidate();
 
   mpinode->u.i_mops = &unionfs_operations;
 
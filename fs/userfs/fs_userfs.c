@@ -71,6 +71,9 @@ struct userfs_state_s
   struct socket psock;       /* Client socket instance */
   struct sockaddr_in server; /* Server address */
   sem_t exclsem;             /* Exclusive access for request-response sequence */
+#ifdef CONFIG_FS_USERFS_SHM
+  FAR struct userfs_ring_s *ring; /* Shared ring, NULL if using the socket */
+#endif
 
   /* I/O Buffer (actual size depends on USERFS_REQ_MAXSIZE and the configured
    * mxwrite).
@@ -85,6 +88,13 @@ struct userfs_state_s
  * Private Function Prototypes
  ****************************************************************************/
 
+static int     userfs_getbuffer(FAR struct userfs_state_s *priv,
+                 FAR uint8_t **iobuffer);
+static void    userfs_putbuffer(FAR struct userfs_state_s *priv,
+                 FAR uint8_t *iobuffer);
+static ssize_t userfs_transact(FAR struct userfs_state_s *priv,
+                 FAR uint8_t *iobuffer, size_t reqsize);
+
 static int     userfs_open(FAR struct file *filep, const char *relpath,
                  int oflags, mode_t mode);
 static int     userfs_close(FAR struct file *filep);
@@ -182,6 +192,148 @@ const struct mountpt_operations userfs_operations =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: userfs_getbuffer
+ *
+ * Description:
+ *   Get a buffer in which to marshal a request.  With the socket, this is
+ *   the single I/O buffer and exclusive access is held until the buffer is
+ *   returned by userfs_putbuffer().  With the shared memory ring, this is
+ *   the buffer of a free slot and other requests may proceed in the other
+ *   slots.
+ *
+ ****************************************************************************/
+
+static int userfs_getbuffer(FAR struct userfs_state_s *priv,
+                            FAR uint8_t **iobuffer)
+{
+#ifdef CONFIG_FS_USERFS_SHM
+  FAR struct userfs_ring_s *ring = priv->ring;
+  int ret;
+  int i;
+
+  if (ring != NULL)
+    {
+      /* Wait for a free slot, then claim it */
+
+      ret = nxsem_wait(&ring->freesem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      nxsem_wait_uninterruptible(&priv->exclsem);
+      for (i = 0; i < ring->nslots; i++)
+        {
+          if (ring->slot[i].state == USERFS_SLOT_FREE)
+            {
+              ring->slot[i].state = USERFS_SLOT_CLIENT;
+              break;
+            }
+        }
+
+      nxsem_post(&priv->exclsem);
+
+      DEBUGASSERT(i < ring->nslots);
+      *iobuffer = USERFS_RING_BUFFER(ring, i);
+      return OK;
+    }
+#endif
+
+  *iobuffer = priv->iobuffer;
+  return nxsem_wait(&priv->exclsem);
+}
+
+/****************************************************************************
+ * Name: userfs_putbuffer
+ *
+ * Description:
+ *   Return the buffer obtained by userfs_getbuffer() once the response has
+ *   been unmarshalled.
+ *
+ ****************************************************************************/
+
+static void userfs_putbuffer(FAR struct userfs_state_s *priv,
+                             FAR uint8_t *iobuffer)
+{
+#ifdef CONFIG_FS_USERFS_SHM
+  FAR struct userfs_ring_s *ring = priv->ring;
+  int i;
+
+  if (ring != NULL)
+    {
+      i = (iobuffer - USERFS_RING_BUFFER(ring, 0)) /
+          USERFS_RING_ALIGN(ring->iolen);
+
+      nxsem_wait_uninterruptible(&priv->exclsem);
+      ring->slot[i].state = USERFS_SLOT_FREE;
+      nxsem_post(&priv->exclsem);
+
+      nxsem_post(&ring->freesem);
+      return;
+    }
+#endif
+
+  nxsem_post(&priv->exclsem);
+}
+
+/****************************************************************************
+ * Name: userfs_transact
+ *
+ * Description:
+ *   Send the request marshalled in iobuffer to the server and wait for the
+ *   response, which is returned in the same buffer.
+ *
+ * Returned Value:
+ *   The size of the response on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t userfs_transact(FAR struct userfs_state_s *priv,
+                               FAR uint8_t *iobuffer, size_t reqsize)
+{
+  ssize_t nsent;
+
+#ifdef CONFIG_FS_USERFS_SHM
+  FAR struct userfs_ring_s *ring = priv->ring;
+  FAR struct userfs_slot_s *slot;
+
+  if (ring != NULL)
+    {
+      slot = &ring->slot[(iobuffer - USERFS_RING_BUFFER(ring, 0)) /
+                         USERFS_RING_ALIGN(ring->iolen)];
+
+      /* Hand the slot over to the server.  Once the request is posted, the
+       * server owns the slot and the client may not be interrupted until
+       * the response is in: the server would write it into a slot that
+       * could already have been reused.
+       */
+
+      slot->size  = reqsize;
+      slot->state = USERFS_SLOT_REQUEST;
+      nxsem_post(&ring->reqsem);
+
+      nxsem_wait_uninterruptible(&slot->respsem);
+      DEBUGASSERT(slot->state == USERFS_SLOT_RESPONSE);
+      return slot->size;
+    }
+#endif
+
+  nsent = psock_sendto(&priv->psock, iobuffer, reqsize, 0,
+                       (FAR struct sockaddr *)&priv->server,
+                       sizeof(struct sockaddr_in));
+  if (nsent < 0)
+    {
+      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
+      return nsent;
+    }
+
+  /* Then get the response from the server */
+
+  return psock_recvfrom(&priv->psock, iobuffer, IOBUFFER_SIZE(priv),
+                        0, NULL, NULL);
+}
+
 /****************************************************************************
  * Name: userfs_open
  ****************************************************************************/
@@ -192,7 +344,7 @@ static int userfs_open(FAR struct file *filep, FAR const char *relpath,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_open_request_s *req;
   FAR struct userfs_open_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int pathlen;
   int ret;
@@ -213,9 +365,9 @@ static int userfs_open(FAR struct file *filep, FAR const char *relpath,
       return -E2BIG;
     }
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -223,53 +375,47 @@ static int userfs_open(FAR struct file *filep, FAR const char *relpath,
 
   /* Construct and send the request to the server */
 
-  req         = (FAR struct userfs_open_request_s *)priv->iobuffer;
+  req         = (FAR struct userfs_open_request_s *)iobuffer;
   req->req    = USERFS_REQ_OPEN;
   req->oflags = oflags;
   req->mode   = mode;
 
   strncpy(req->relpath, relpath, priv->mxwrite);
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       SIZEOF_USERFS_OPEN_REQUEST_S(pathlen + 1), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           SIZEOF_USERFS_OPEN_REQUEST_S(pathlen + 1));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_open_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   /* Save the returned openinfo as the filep private data. */
 
-  resp = (FAR struct userfs_open_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_open_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_OPEN)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   filep->f_priv = resp->openinfo;
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -281,7 +427,7 @@ static int userfs_close(FAR struct file *filep)
   FAR struct userfs_state_s *priv;
   FAR struct userfs_close_request_s *req;
   FAR struct userfs_close_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -290,9 +436,9 @@ static int userfs_close(FAR struct file *filep)
               filep->f_inode->i_private != NULL);
   priv = filep->f_inode->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -300,44 +446,34 @@ static int userfs_close(FAR struct file *filep)
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_close_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_close_request_s *)iobuffer;
   req->req      = USERFS_REQ_CLOSE;
   req->openinfo = filep->f_priv;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_close_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_close_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_close_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_close_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_close_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_CLOSE)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   if (resp->ret >= 0)
@@ -345,7 +481,11 @@ static int userfs_close(FAR struct file *filep)
       filep->f_priv = NULL;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -358,7 +498,7 @@ static ssize_t userfs_read(FAR struct file *filep, char *buffer,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_read_request_s *req;
   FAR struct userfs_read_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int respsize;
   int ret;
@@ -370,9 +510,9 @@ static ssize_t userfs_read(FAR struct file *filep, char *buffer,
               filep->f_inode->i_private != NULL);
   priv = filep->f_inode->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -380,64 +520,60 @@ static ssize_t userfs_read(FAR struct file *filep, char *buffer,
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_read_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_read_request_s *)iobuffer;
   req->req      = USERFS_REQ_READ;
   req->openinfo = filep->f_priv;
   req->readlen  = buflen;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_read_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_read_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd < SIZEOF_USERFS_READ_RESPONSE_S(0))
     {
       ferr("ERROR: Response too small: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_read_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_read_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_READ)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   if (resp->nread > buflen)
     {
       ferr("ERROR: Response size too large: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   respsize = SIZEOF_USERFS_READ_RESPONSE_S(resp->nread);
   if (respsize != nrecvd)
     {
       ferr("ERROR: Incorrect response size: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   /* Copy the received data to the user buffer */
 
   memcpy(buffer, resp->rddata, resp->nread);
-  return resp->nread;
+  ret = resp->nread;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -450,7 +586,7 @@ static ssize_t userfs_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_write_request_s *req;
   FAR struct userfs_write_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -470,9 +606,9 @@ static ssize_t userfs_write(FAR struct file *filep, FAR const char *buffer,
       return -E2BIG; /* No implemented yet */
     }
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -480,49 +616,43 @@ static ssize_t userfs_write(FAR struct file *filep, FAR const char *buffer,
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_write_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_write_request_s *)iobuffer;
   req->req      = USERFS_REQ_WRITE;
   req->openinfo = filep->f_priv;
   req->writelen = buflen;
   memcpy(req->wrdata, buffer, buflen);
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       SIZEOF_USERFS_WRITE_REQUEST_S(buflen), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           SIZEOF_USERFS_WRITE_REQUEST_S(buflen));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_write_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_write_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_write_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_WRITE)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->nwritten;
+  ret = resp->nwritten;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -534,9 +664,9 @@ static off_t userfs_seek(FAR struct file *filep, off_t offset, int whence)
   FAR struct userfs_state_s *priv;
   FAR struct userfs_seek_request_s *req;
   FAR struct userfs_seek_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
-  int ret;
+  off_t ret;
 
   finfo("Offset %lu bytes to whence=%d\n", (unsigned long)offset, whence);
 
@@ -545,9 +675,9 @@ static off_t userfs_seek(FAR struct file *filep, off_t offset, int whence)
               filep->f_inode->i_private != NULL);
   priv = filep->f_inode->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -555,49 +685,43 @@ static off_t userfs_seek(FAR struct file *filep, off_t offset, int whence)
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_seek_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_seek_request_s *)iobuffer;
   req->req      = USERFS_REQ_SEEK;
   req->openinfo = filep->f_priv;
   req->offset   = offset;
   req->whence   = whence;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_seek_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_seek_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_seek_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_seek_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_seek_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_SEEK)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -609,7 +733,7 @@ static int userfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   FAR struct userfs_state_s *priv;
   FAR struct userfs_ioctl_request_s *req;
   FAR struct userfs_ioctl_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -620,9 +744,9 @@ static int userfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
               filep->f_inode->i_private != NULL);
   priv = filep->f_inode->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -630,49 +754,43 @@ static int userfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_ioctl_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_ioctl_request_s *)iobuffer;
   req->req      = USERFS_REQ_IOCTL;
   req->openinfo = filep->f_priv;
   req->cmd      = cmd;
   req->arg      = arg;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_ioctl_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_ioctl_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_ioctl_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_ioctl_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_ioctl_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_IOCTL)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -684,7 +802,7 @@ static int userfs_sync(FAR struct file *filep)
   FAR struct userfs_state_s *priv;
   FAR struct userfs_sync_request_s *req;
   FAR struct userfs_sync_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -693,9 +811,9 @@ static int userfs_sync(FAR struct file *filep)
               filep->f_inode->i_private != NULL);
   priv = filep->f_inode->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -703,47 +821,41 @@ static int userfs_sync(FAR struct file *filep)
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_sync_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_sync_request_s *)iobuffer;
   req->req      = USERFS_REQ_SYNC;
   req->openinfo = filep->f_priv;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_sync_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_sync_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_sync_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_sync_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_sync_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_SYNC)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -759,7 +871,7 @@ static int userfs_dup(FAR const struct file *oldp, FAR struct file *newp)
   FAR struct userfs_state_s *priv;
   FAR struct userfs_dup_request_s *req;
   FAR struct userfs_dup_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -770,9 +882,9 @@ static int userfs_dup(FAR const struct file *oldp, FAR struct file *newp)
               oldp->f_inode->i_private != NULL);
   priv = oldp->f_inode->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -780,48 +892,42 @@ static int userfs_dup(FAR const struct file *oldp, FAR struct file *newp)
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_dup_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_dup_request_s *)iobuffer;
   req->req      = USERFS_REQ_DUP;
   req->openinfo = oldp->f_priv;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_dup_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_dup_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_dup_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_dup_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_dup_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_DUP)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   newp->f_priv = resp->openinfo;
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -838,7 +944,7 @@ static int userfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
   FAR struct userfs_state_s *priv;
   FAR struct userfs_fstat_request_s *req;
   FAR struct userfs_fstat_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -847,9 +953,9 @@ static int userfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
               filep->f_inode->i_private != NULL);
   priv = filep->f_inode->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -857,51 +963,45 @@ static int userfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_fstat_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_fstat_request_s *)iobuffer;
   req->req      = USERFS_REQ_FSTAT;
   req->openinfo = filep->f_priv;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_fstat_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_fstat_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_fstat_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_fstat_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_fstat_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_FSTAT)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   /* Return the status of the directory entry */
 
   DEBUGASSERT(buf != NULL);
   memcpy(buf, &resp->buf, sizeof(struct stat));
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -919,7 +1019,7 @@ static int userfs_fchstat(FAR const struct file *filep,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_fchstat_request_s *req;
   FAR struct userfs_fchstat_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -928,9 +1028,9 @@ static int userfs_fchstat(FAR const struct file *filep,
               filep->f_inode->i_private != NULL);
   priv = filep->f_inode->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -938,49 +1038,43 @@ static int userfs_fchstat(FAR const struct file *filep,
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_fchstat_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_fchstat_request_s *)iobuffer;
   req->req      = USERFS_REQ_FCHSTAT;
   req->openinfo = filep->f_priv;
   req->buf      = *buf;
   req->flags    = flags;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_fchstat_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %zd\n", nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_fchstat_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %zd\n", nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_fchstat_response_s))
     {
       ferr("ERROR: Response size incorrect: %zd\n", nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_fchstat_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_fchstat_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_FCHSTAT)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -996,7 +1090,7 @@ static int userfs_truncate(FAR struct file *filep, off_t length)
   FAR struct userfs_state_s *priv;
   FAR struct userfs_truncate_request_s *req;
   FAR struct userfs_truncate_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -1005,9 +1099,9 @@ static int userfs_truncate(FAR struct file *filep, off_t length)
               filep->f_inode->i_private != NULL);
   priv = filep->f_inode->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1015,50 +1109,44 @@ static int userfs_truncate(FAR struct file *filep, off_t length)
 
   /* Construct and send the request to the server */
 
-  req           = (FAR struct userfs_truncate_request_s *)priv->iobuffer;
+  req           = (FAR struct userfs_truncate_request_s *)iobuffer;
   req->req      = USERFS_REQ_TRUNCATE;
   req->openinfo = filep->f_priv;
   req->length   = length;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_truncate_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_truncate_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_truncate_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_truncate_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_truncate_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_FSTAT)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   /* Return the result of truncate operation */
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1075,7 +1163,7 @@ static int userfs_opendir(FAR struct inode *mountpt, FAR const char *relpath,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_opendir_request_s *req;
   FAR struct userfs_opendir_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int pathlen;
   int ret;
@@ -1095,9 +1183,9 @@ static int userfs_opendir(FAR struct inode *mountpt, FAR const char *relpath,
       return -E2BIG;
     }
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1105,52 +1193,46 @@ static int userfs_opendir(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_opendir_request_s *)priv->iobuffer;
+  req      = (FAR struct userfs_opendir_request_s *)iobuffer;
   req->req = USERFS_REQ_OPENDIR;
 
   strncpy(req->relpath, relpath, priv->mxwrite);
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       SIZEOF_USERFS_OPENDIR_REQUEST_S(pathlen + 1), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           SIZEOF_USERFS_OPENDIR_REQUEST_S(pathlen + 1));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_opendir_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_opendir_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_opendir_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_OPENDIR)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   /* Save the opaque dir reference in struct fs_dirent_s */
 
   DEBUGASSERT(dir != NULL);
   dir->u.userfs.fs_dir = resp->dir;
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1167,7 +1249,7 @@ static int userfs_closedir(FAR struct inode *mountpt,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_closedir_request_s *req;
   FAR struct userfs_closedir_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -1175,9 +1257,9 @@ static int userfs_closedir(FAR struct inode *mountpt,
               mountpt->i_private != NULL);
   priv = mountpt->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1185,47 +1267,41 @@ static int userfs_closedir(FAR struct inode *mountpt,
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_closedir_request_s *)priv->iobuffer;
+  req      = (FAR struct userfs_closedir_request_s *)iobuffer;
   req->req = USERFS_REQ_CLOSEDIR;
   req->dir = dir->u.userfs.fs_dir;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_closedir_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_closedir_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_closedir_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_closedir_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_closedir_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_CLOSEDIR)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1241,7 +1317,7 @@ static int userfs_readdir(FAR struct inode *mountpt,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_readdir_request_s *req;
   FAR struct userfs_readdir_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -1249,9 +1325,9 @@ static int userfs_readdir(FAR struct inode *mountpt,
               mountpt->i_private != NULL);
   priv = mountpt->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1259,51 +1335,45 @@ static int userfs_readdir(FAR struct inode *mountpt,
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_readdir_request_s *)priv->iobuffer;
+  req      = (FAR struct userfs_readdir_request_s *)iobuffer;
   req->req = USERFS_REQ_READDIR;
   req->dir = dir->u.userfs.fs_dir;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_readdir_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_readdir_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_readdir_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_readdir_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_readdir_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_READDIR)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   /* Return the dirent */
 
   DEBUGASSERT(dir != NULL);
   memcpy(&dir->fd_dir, &resp->entry, sizeof(struct dirent));
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1319,7 +1389,7 @@ static int userfs_rewinddir(FAR struct inode *mountpt,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_rewinddir_request_s *req;
   FAR struct userfs_rewinddir_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -1327,9 +1397,9 @@ static int userfs_rewinddir(FAR struct inode *mountpt,
               mountpt->i_private != NULL);
   priv = mountpt->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1337,47 +1407,41 @@ static int userfs_rewinddir(FAR struct inode *mountpt,
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_rewinddir_request_s *)priv->iobuffer;
+  req      = (FAR struct userfs_rewinddir_request_s *)iobuffer;
   req->req = USERFS_REQ_REWINDDIR;
   req->dir = dir->u.userfs.fs_dir;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_rewinddir_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_rewinddir_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_rewinddir_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_rewinddir_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_rewinddir_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_REWINDDIR)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1427,6 +1491,24 @@ static int userfs_bind(FAR struct inode *blkdriver, FAR const void *data,
 
   priv->mxwrite                = config->mxwrite;
 
+#ifdef CONFIG_FS_USERFS_SHM
+  /* Use the shared memory ring if the server provided one */
+
+  priv->ring                   = config->ring;
+  if (priv->ring != NULL)
+    {
+      if (priv->ring->iolen < iolen)
+        {
+          ferr("ERROR: Ring buffers too small: %u\n", priv->ring->iolen);
+          ret = -EINVAL;
+          goto errout_with_alloc;
+        }
+
+      *handle = (FAR void *)priv;
+      return OK;
+    }
+#endif
+
   /* Preset the server address */
 
   priv->server.sin_family      = AF_INET;
@@ -1483,15 +1565,15 @@ static int userfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
   FAR struct userfs_state_s *priv = (FAR struct userfs_state_s *)handle;
   FAR struct userfs_destroy_request_s *req;
   FAR struct userfs_destroy_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
   DEBUGASSERT(priv != NULL);
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1499,57 +1581,61 @@ static int userfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_destroy_request_s *)priv->iobuffer;
+  req      = (FAR struct userfs_destroy_request_s *)iobuffer;
   req->req = USERFS_REQ_DESTROY;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_destroy_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_destroy_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_destroy_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_destroy_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_destroy_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_DESTROY)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   /* If the destruction failed, then refuse to unmount at this time */
 
   if (resp->ret < 0)
     {
-      return resp->ret;
+      ret = resp->ret;
+      goto errout_with_buffer;
     }
 
-  /* Free resources and return success */
+  /* Free resources and return success.  With the shared memory ring, the
+   * slot must be returned before the server may release the ring.
+   */
+
+  userfs_putbuffer(priv, iobuffer);
+#ifdef CONFIG_FS_USERFS_SHM
+  if (priv->ring == NULL)
+#endif
+    {
+      psock_close(&priv->psock);
+    }
 
-  psock_close(&priv->psock);
   kmm_free(priv);
   return OK;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1565,7 +1651,7 @@ static int userfs_statfs(FAR struct inode *mountpt, FAR struct statfs *buf)
   FAR struct userfs_state_s *priv;
   FAR struct userfs_statfs_request_s *req;
   FAR struct userfs_statfs_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -1573,9 +1659,9 @@ static int userfs_statfs(FAR struct inode *mountpt, FAR struct statfs *buf)
               mountpt->i_private != NULL);
   priv = mountpt->i_private;
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1583,50 +1669,44 @@ static int userfs_statfs(FAR struct inode *mountpt, FAR struct statfs *buf)
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_statfs_request_s *)priv->iobuffer;
+  req      = (FAR struct userfs_statfs_request_s *)iobuffer;
   req->req = USERFS_REQ_STATFS;
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       sizeof(struct userfs_statfs_request_s), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           sizeof(struct userfs_statfs_request_s));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_statfs_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_statfs_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_statfs_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_STATFS)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   /* Return the status of the file system */
 
   DEBUGASSERT(buf != NULL);
   memcpy(buf, &resp->buf, sizeof(struct statfs));
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1643,7 +1723,7 @@ static int userfs_unlink(FAR struct inode *mountpt,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_unlink_request_s *req;
   FAR struct userfs_unlink_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int pathlen;
   int ret;
@@ -1661,9 +1741,9 @@ static int userfs_unlink(FAR struct inode *mountpt,
       return -E2BIG;
     }
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1671,48 +1751,42 @@ static int userfs_unlink(FAR struct inode *mountpt,
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_unlink_request_s *)priv->iobuffer;
+  req      = (FAR struct userfs_unlink_request_s *)iobuffer;
   req->req = USERFS_REQ_UNLINK;
 
   strncpy(req->relpath, relpath, priv->mxwrite);
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       SIZEOF_USERFS_UNLINK_REQUEST_S(pathlen + 1), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           SIZEOF_USERFS_UNLINK_REQUEST_S(pathlen + 1));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_unlink_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_unlink_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_unlink_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_UNLINK)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1729,7 +1803,7 @@ static int userfs_mkdir(FAR struct inode *mountpt,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_mkdir_request_s *req;
   FAR struct userfs_mkdir_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int pathlen;
   int ret;
@@ -1747,9 +1821,9 @@ static int userfs_mkdir(FAR struct inode *mountpt,
       return -E2BIG;
     }
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1757,49 +1831,43 @@ static int userfs_mkdir(FAR struct inode *mountpt,
 
   /* Construct and send the request to the server */
 
-  req       = (FAR struct userfs_mkdir_request_s *)priv->iobuffer;
+  req       = (FAR struct userfs_mkdir_request_s *)iobuffer;
   req->req  = USERFS_REQ_MKDIR;
   req->mode = mode;
 
   strncpy(req->relpath, relpath, priv->mxwrite);
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       SIZEOF_USERFS_MKDIR_REQUEST_S(pathlen + 1), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           SIZEOF_USERFS_MKDIR_REQUEST_S(pathlen + 1));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_mkdir_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_mkdir_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_mkdir_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_MKDIR)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1816,7 +1884,7 @@ static int userfs_rmdir(FAR struct inode *mountpt,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_rmdir_request_s *req;
   FAR struct userfs_rmdir_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int pathlen;
   int ret;
@@ -1834,9 +1902,9 @@ static int userfs_rmdir(FAR struct inode *mountpt,
       return -E2BIG;
     }
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1844,48 +1912,42 @@ static int userfs_rmdir(FAR struct inode *mountpt,
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_rmdir_request_s *)priv->iobuffer;
+  req      = (FAR struct userfs_rmdir_request_s *)iobuffer;
   req->req = USERFS_REQ_RMDIR;
 
   strncpy(req->relpath, relpath, priv->mxwrite);
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       SIZEOF_USERFS_RMDIR_REQUEST_S(pathlen + 1), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           SIZEOF_USERFS_RMDIR_REQUEST_S(pathlen + 1));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_rmdir_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_rmdir_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_rmdir_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_RMDIR)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1905,7 +1967,7 @@ static int userfs_rename(FAR struct inode *mountpt,
   FAR struct userfs_rename_response_s *resp;
   int oldpathlen;
   int newpathlen;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int ret;
 
@@ -1924,9 +1986,9 @@ static int userfs_rename(FAR struct inode *mountpt,
       return -E2BIG;
     }
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -1934,50 +1996,45 @@ static int userfs_rename(FAR struct inode *mountpt,
 
   /* Construct and send the request to the server */
 
-  req            = (FAR struct userfs_rename_request_s *)priv->iobuffer;
+  req            = (FAR struct userfs_rename_request_s *)iobuffer;
   req->req       = USERFS_REQ_RENAME;
   req->newoffset = oldpathlen;
 
   strncpy(req->oldrelpath, oldrelpath, oldpathlen);
   strncpy(&req->oldrelpath[oldpathlen], newrelpath, newpathlen);
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                      SIZEOF_USERFS_RENAME_REQUEST_S(oldpathlen, newpathlen),
-                      0, (FAR struct sockaddr *)&priv->server,
-                      sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           SIZEOF_USERFS_RENAME_REQUEST_S(oldpathlen,
+                                                          newpathlen));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_rename_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_rename_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_rename_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_RENAME)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -1994,7 +2051,7 @@ static int userfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_stat_request_s *req;
   FAR struct userfs_stat_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int pathlen;
   int ret;
@@ -2012,9 +2069,9 @@ static int userfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
       return -E2BIG;
     }
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -2022,52 +2079,46 @@ static int userfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_stat_request_s *)priv->iobuffer;
+  req      = (FAR struct userfs_stat_request_s *)iobuffer;
   req->req = USERFS_REQ_STAT;
 
   strncpy(req->relpath, relpath, priv->mxwrite);
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       SIZEOF_USERFS_STAT_REQUEST_S(pathlen + 1), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %d\n", (int)nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           SIZEOF_USERFS_STAT_REQUEST_S(pathlen + 1));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_stat_response_s))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_stat_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_stat_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_STAT)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
   /* Return the directory entry status */
 
   DEBUGASSERT(buf != NULL);
   memcpy(buf, &resp->buf, sizeof(struct stat));
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -2084,7 +2135,7 @@ static int userfs_chstat(FAR struct inode *mountpt, FAR const char *relpath,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_chstat_request_s *req;
   FAR struct userfs_chstat_response_s *resp;
-  ssize_t nsent;
+  FAR uint8_t *iobuffer;
   ssize_t nrecvd;
   int pathlen;
   int ret;
@@ -2102,9 +2153,9 @@ static int userfs_chstat(FAR struct inode *mountpt, FAR const char *relpath,
       return -E2BIG;
     }
 
-  /* Get exclusive access */
+  /* Get a buffer for the request */
 
-  ret = nxsem_wait(&priv->exclsem);
+  ret = userfs_getbuffer(priv, &iobuffer);
   if (ret < 0)
     {
       return ret;
@@ -2112,50 +2163,44 @@ static int userfs_chstat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Construct and send the request to the server */
 
-  req        = (FAR struct userfs_chstat_request_s *)priv->iobuffer;
+  req        = (FAR struct userfs_chstat_request_s *)iobuffer;
   req->req   = USERFS_REQ_CHSTAT;
   req->buf   = *buf;
   req->flags = flags;
 
   strncpy(req->relpath, relpath, priv->mxwrite);
 
-  nsent = psock_sendto(&priv->psock, priv->iobuffer,
-                       SIZEOF_USERFS_CHSTAT_REQUEST_S(pathlen + 1), 0,
-                       (FAR struct sockaddr *)&priv->server,
-                       sizeof(struct sockaddr_in));
-  if (nsent < 0)
-    {
-      ferr("ERROR: psock_sendto failed: %zd\n", nsent);
-      nxsem_post(&priv->exclsem);
-      return (int)nsent;
-    }
-
-  /* Then get the response from the server */
-
-  nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
-                          0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
+  /* Send the request and wait for the response */
 
+  nrecvd = userfs_transact(priv, iobuffer,
+                           SIZEOF_USERFS_CHSTAT_REQUEST_S(pathlen + 1));
   if (nrecvd < 0)
     {
-      ferr("ERROR: psock_recvfrom failed: %zd\n", nrecvd);
-      return (int)nrecvd;
+      ferr("ERROR: userfs_transact failed: %d\n", (int)nrecvd);
+      ret = (int)nrecvd;
+      goto errout_with_buffer;
     }
 
   if (nrecvd != sizeof(struct userfs_chstat_response_s))
     {
       ferr("ERROR: Response size incorrect: %zd\n", nrecvd);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  resp = (FAR struct userfs_chstat_response_s *)priv->iobuffer;
+  resp = (FAR struct userfs_chstat_response_s *)iobuffer;
   if (resp->resp != USERFS_RESP_STAT)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
-      return -EIO;
+      ret = -EIO;
+      goto errout_with_buffer;
     }
 
-  return resp->ret;
+  ret = resp->ret;
+
+errout_with_buffer:
+  userfs_putbuffer(priv, iobuffer);
+  return ret;
 }
 
 /****************************************************************************
@@ -65,6 +65,10 @@ int file_close(FAR struct file *filep)
 
   if (inode)
     {
+      /* Drop the epoll registrations of the file, as Linux does */
+
+      epoll_file_close(filep);
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
@@ -29,31 +29,70 @@
 #include <inttypes.h>
 #include <stdint.h>
 #include <poll.h>
+#include <queue.h>
+#include <assert.h>
 #include <errno.h>
 #include <string.h>
 #include <debug.h>
-#include <semaphore.h>
 
+#include <nuttx/nuttx.h>
+#include <nuttx/irq.h>
 #include <nuttx/clock.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/signal.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* These flags change how events are reported.  They are kept by epoll and
+ * are not passed to the drivers.
+ */
+
+#define EPOLL_FLAGS     (EPOLLET | EPOLLONESHOT | EPOLLWAKEUP)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+struct epoll_head;
+
+/* One registration in the interest list.  The poll setup of the
+ * registration stays in place across epoll_wait() calls; the driver reports
+ * events through poll_notify() and epoll_notify() moves the registration to
+ * the ready list.
+ */
+
+struct epoll_node_s
+{
+  dq_entry_t node;                /* Link in the interest or free list */
+  dq_entry_t rnode;               /* Link in the ready list */
+  bool ready;                     /* True: In the ready list */
+  bool armed;                     /* True: The poll is setup */
+  uint32_t events;                /* Requested events including flags */
+  epoll_data_t data;              /* User data returned with events */
+  FAR struct file *filep;         /* The file being monitored */
+  FAR struct epoll_head *eph;     /* The owning epoll instance */
+  struct pollfd pfd;              /* Poll structure given to the driver */
+};
+
 struct epoll_head
 {
-  int size;
-  int occupied;
-  int crefs;
-  sem_t sem;
-  struct file fp;
-  struct inode in;
-  FAR epoll_data_t *data;
-  FAR struct pollfd *poll;
+  dq_entry_t link;                /* Link in g_epoll_list */
+  int size;                       /* Number of registrations */
+  int crefs;                      /* Reference count */
+  sem_t sem;                      /* Protects the interest list */
+  sem_t waitsem;                  /* Posted when a registration is ready */
+  dq_queue_t setup;               /* Interest list */
+  dq_queue_t free;                /* Free registrations */
+  dq_queue_t ready;               /* Ready list (critical section) */
+  FAR struct pollfd *poll;        /* Poll waiter on the epoll fd itself */
+  FAR struct epoll_node_s *nodes; /* Preallocated registrations */
 };
 
 /****************************************************************************
@@ -83,6 +122,13 @@ static const struct file_operations g_epoll_ops =
 #endif
 };
 
+/* All epoll instances, so that closing a file can remove its registrations.
+ * g_epoll_sem is always taken before the sem of an instance.
+ */
+
+static dq_queue_t g_epoll_list;
+static sem_t g_epoll_sem = SEM_INITIALIZER(1);
+
 static struct inode g_epoll_inode =
 {
   NULL,                   /* i_parent */
@@ -124,6 +170,212 @@ static FAR struct epoll_head *epoll_head_from_fd(int fd)
   return (FAR struct epoll_head *)filep->f_priv;
 }
 
+/****************************************************************************
+ * Name: epoll_notify
+ *
+ * Description:
+ *   The poll callback of every registration.  This is called by
+ *   poll_notify(), possibly from an interrupt handler, when the driver
+ *   reports events.  It queues the registration in the ready list and
+ *   wakes up epoll_wait().
+ *
+ ****************************************************************************/
+
+static void epoll_notify(FAR struct pollfd *fds)
+{
+  FAR struct epoll_node_s *epn =
+    container_of(fds, struct epoll_node_s, pfd);
+  FAR struct epoll_head *eph = epn->eph;
+  irqstate_t flags;
+  int semcount;
+
+  flags = enter_critical_section();
+
+  if (!epn->ready)
+    {
+      dq_addlast(&epn->rnode, &eph->ready);
+      epn->ready = true;
+    }
+
+  nxsem_get_value(&eph->waitsem, &semcount);
+  if (semcount < 1)
+    {
+      nxsem_post(&eph->waitsem);
+    }
+
+  /* The epoll fd itself may be monitored by poll() or another epoll */
+
+  poll_notify(&eph->poll, 1, POLLIN);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ *
+ * Description:
+ *   Setup the poll of one registration.  The caller holds eph->sem.
+ *
+ ****************************************************************************/
+
+static int epoll_setup(FAR struct epoll_node_s *epn)
+{
+  int ret;
+
+  epn->pfd.events  = (epn->events & ~EPOLL_FLAGS) | POLLERR | POLLHUP;
+  epn->pfd.revents = 0;
+  epn->pfd.priv    = NULL;
+
+  ret = file_poll(epn->filep, &epn->pfd, true);
+  epn->armed = ret >= 0;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_teardown
+ *
+ * Description:
+ *   Teardown the poll of one registration and remove it from the ready
+ *   list.  The caller holds eph->sem.
+ *
+ ****************************************************************************/
+
+static void epoll_teardown(FAR struct epoll_node_s *epn)
+{
+  FAR struct epoll_head *eph = epn->eph;
+  irqstate_t flags;
+
+  if (epn->armed)
+    {
+      file_poll(epn->filep, &epn->pfd, false);
+      epn->armed = false;
+    }
+
+  flags = enter_critical_section();
+
+  if (epn->ready)
+    {
+      dq_rem(&epn->rnode, &eph->ready);
+      epn->ready = false;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ *
+ * Description:
+ *   Find the registration of a file descriptor.  The caller holds eph->sem.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_node_s *epoll_find(FAR struct epoll_head *eph,
+                                           int fd)
+{
+  FAR dq_entry_t *entry;
+
+  for (entry = dq_peek(&eph->setup); entry != NULL; entry = dq_next(entry))
+    {
+      FAR struct epoll_node_s *epn =
+        container_of(entry, struct epoll_node_s, node);
+
+      if (epn->pfd.fd == fd)
+        {
+          return epn;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_fetch
+ *
+ * Description:
+ *   Move up to maxevents events from the ready list to evs.  Only ready
+ *   registrations are visited.
+ *
+ *   Level-triggered registrations are re-armed after being reported.  The
+ *   driver checks its state again during the setup and queues the
+ *   registration again if the condition still holds.  Edge-triggered
+ *   registrations stay armed and are only queued again on the next event.
+ *   One-shot registrations are disarmed until EPOLL_CTL_MOD.
+ *
+ * Returned Value:
+ *   The number of events in evs or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int epoll_fetch(FAR struct epoll_head *eph,
+                       FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_node_s *epn;
+  FAR dq_entry_t *entry;
+  pollevent_t revents;
+  dq_queue_t rearm;
+  irqstate_t flags;
+  int nevents = 0;
+  int ret;
+
+  ret = nxsem_wait(&eph->sem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  dq_init(&rearm);
+
+  while (nevents < maxevents)
+    {
+      flags = enter_critical_section();
+
+      entry = dq_remfirst(&eph->ready);
+      if (entry == NULL)
+        {
+          leave_critical_section(flags);
+          break;
+        }
+
+      epn              = container_of(entry, struct epoll_node_s, rnode);
+      epn->ready       = false;
+      revents          = epn->pfd.revents & epn->pfd.events;
+      epn->pfd.revents = 0;
+
+      leave_critical_section(flags);
+
+      if (revents == 0)
+        {
+          continue;
+        }
+
+      evs[nevents].events = revents;
+      evs[nevents].data   = epn->data;
+      nevents++;
+
+      if ((epn->events & EPOLLONESHOT) != 0)
+        {
+          epoll_teardown(epn);
+        }
+      else if ((epn->events & EPOLLET) == 0)
+        {
+          /* Re-arm after the loop or the registration would be reported
+           * again by this same call.
+           */
+
+          epoll_teardown(epn);
+          dq_addlast(&epn->rnode, &rearm);
+        }
+    }
+
+  while ((entry = dq_remfirst(&rearm)) != NULL)
+    {
+      epoll_setup(container_of(entry, struct epoll_node_s, rnode));
+    }
+
+  nxsem_post(&eph->sem);
+  return nevents;
+}
+
 static int epoll_do_open(FAR struct file *filep)
 {
   FAR struct epoll_head *eph = filep->f_priv;
@@ -143,65 +395,125 @@ static int epoll_do_open(FAR struct file *filep)
 static int epoll_do_close(FAR struct file *filep)
 {
   FAR struct epoll_head *eph = filep->f_priv;
+  FAR dq_entry_t *entry;
   int ret;
 
-  ret = nxsem_wait(&eph->sem);
+  ret = nxsem_wait_uninterruptible(&g_epoll_sem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = nxsem_wait_uninterruptible(&eph->sem);
   if (ret < 0)
     {
+      nxsem_post(&g_epoll_sem);
       return ret;
     }
 
   eph->crefs--;
-  nxsem_post(&eph->sem);
   if (eph->crefs <= 0)
     {
+      dq_rem(&eph->link, &g_epoll_list);
+      nxsem_post(&g_epoll_sem);
+
+      /* Teardown all of the registrations that are still in place */
+
+      while ((entry = dq_remfirst(&eph->setup)) != NULL)
+        {
+          epoll_teardown(container_of(entry, struct epoll_node_s, node));
+        }
+
+      nxsem_destroy(&eph->waitsem);
+      nxsem_destroy(&eph->sem);
       kmm_free(eph);
+      return ret;
     }
 
+  nxsem_post(&eph->sem);
+  nxsem_post(&g_epoll_sem);
   return ret;
 }
 
 static int epoll_do_poll(FAR struct file *filep,
                          FAR struct pollfd *fds, bool setup)
 {
-  return OK;
+  FAR struct epoll_head *eph = filep->f_priv;
+  irqstate_t flags;
+  int ret = OK;
+
+  flags = enter_critical_section();
+
+  if (setup)
+    {
+      if (eph->poll != NULL)
+        {
+          ret = -EBUSY;
+        }
+      else
+        {
+          eph->poll = fds;
+          if (dq_peek(&eph->ready) != NULL)
+            {
+              poll_notify(&eph->poll, 1, POLLIN);
+            }
+        }
+    }
+  else if (eph->poll == fds)
+    {
+      eph->poll = NULL;
+    }
+
+  leave_critical_section(flags);
+  return ret;
 }
 
 static int epoll_do_create(int size, int flags)
 {
   FAR struct epoll_head *eph;
-  int reserve = size + 1;
   int fd;
+  int i;
+
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return -1;
+    }
 
   eph = (FAR struct epoll_head *)
         kmm_zalloc(sizeof(struct epoll_head) +
-                   sizeof(epoll_data_t) * reserve +
-                   sizeof(struct pollfd) * reserve);
+                   sizeof(struct epoll_node_s) * size);
   if (eph == NULL)
     {
       set_errno(ENOMEM);
       return -1;
     }
 
+  /* These semaphores are used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
   nxsem_init(&eph->sem, 0, 0);
   nxsem_set_protocol(&eph->sem, SEM_PRIO_NONE);
-  eph->size = size;
-  eph->data = (FAR epoll_data_t *)(eph + 1);
-  eph->poll = (FAR struct pollfd *)(eph->data + reserve);
+  nxsem_init(&eph->waitsem, 0, 0);
+  nxsem_set_protocol(&eph->waitsem, SEM_PRIO_NONE);
 
-  INODE_SET_DRIVER(&eph->in);
-  eph->in.u.i_ops = &g_epoll_ops;
-  eph->fp.f_inode = &eph->in;
-  eph->in.i_private = eph;
+  eph->size  = size;
+  eph->nodes = (FAR struct epoll_node_s *)(eph + 1);
 
-  eph->poll[0].ptr = &eph->fp;
-  eph->poll[0].events = POLLIN | POLLFILE;
+  for (i = 0; i < size; i++)
+    {
+      eph->nodes[i].eph    = eph;
+      eph->nodes[i].pfd.cb = epoll_notify;
+      dq_addlast(&eph->nodes[i].node, &eph->free);
+    }
 
   /* Alloc the file descriptor */
 
   fd = files_allocate(&g_epoll_inode, flags, 0, eph, 0);
   if (fd < 0)
     {
+      nxsem_destroy(&eph->waitsem);
       nxsem_destroy(&eph->sem);
       kmm_free(eph);
       set_errno(-fd);
@@ -210,6 +522,11 @@ static int epoll_do_create(int size, int flags)
 
   inode_addref(&g_epoll_inode);
   nxsem_post(&eph->sem);
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+  dq_addlast(&eph->link, &g_epoll_list);
+  nxsem_post(&g_epoll_sem);
+
   return fd;
 }
 
@@ -217,6 +534,56 @@ static int epoll_do_create(int size, int flags)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: epoll_file_close
+ *
+ * Description:
+ *   Remove the registrations of a file that is being closed from every
+ *   epoll instance, as Linux does.  The poll of each registration is torn
+ *   down while the file is still open.
+ *
+ ****************************************************************************/
+
+void epoll_file_close(FAR struct file *filep)
+{
+  FAR struct epoll_head *eph;
+  FAR struct epoll_node_s *epn;
+  FAR dq_entry_t *entry;
+  FAR dq_entry_t *next;
+  FAR dq_entry_t *link;
+
+  /* Most systems have no epoll instance at all */
+
+  if (dq_peek(&g_epoll_list) == NULL)
+    {
+      return;
+    }
+
+  nxsem_wait_uninterruptible(&g_epoll_sem);
+
+  for (link = dq_peek(&g_epoll_list); link != NULL; link = dq_next(link))
+    {
+      eph = container_of(link, struct epoll_head, link);
+      nxsem_wait_uninterruptible(&eph->sem);
+
+      for (entry = dq_peek(&eph->setup); entry != NULL; entry = next)
+        {
+          next = dq_next(entry);
+          epn  = container_of(entry, struct epoll_node_s, node);
+          if (epn->filep == filep)
+            {
+              epoll_teardown(epn);
+              dq_rem(&epn->node, &eph->setup);
+              dq_addlast(&epn->node, &eph->free);
+            }
+        }
+
+      nxsem_post(&eph->sem);
+    }
+
+  nxsem_post(&g_epoll_sem);
+}
+
 /****************************************************************************
  * Name: epoll_create
  *
@@ -269,6 +636,9 @@ void epoll_close(int epfd)
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify or remove a registration.  The poll of a registration is
+ *   setup here and stays in place until the registration is modified or
+ *   removed, or until the epoll fd or the file descriptor is closed.
  *
  * Input Parameters:
  *
@@ -279,7 +649,10 @@ void epoll_close(int epfd)
 int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
 {
   FAR struct epoll_head *eph;
-  int i;
+  FAR struct epoll_node_s *epn;
+  FAR struct file *filep;
+  FAR dq_entry_t *entry;
+  int ret;
 
   eph = epoll_head_from_fd(epfd);
   if (eph == NULL)
@@ -287,88 +660,100 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
       return -1;
     }
 
+  if (op != EPOLL_CTL_DEL && ev == NULL)
+    {
+      set_errno(EFAULT);
+      return -1;
+    }
+
+  ret = nxsem_wait(&eph->sem);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return -1;
+    }
+
+  epn = epoll_find(eph, fd);
+
   switch (op)
     {
       case EPOLL_CTL_ADD:
-        finfo("%08x CTL ADD(%d): fd=%d ev=%08" PRIx32 "\n",
-              epfd, eph->occupied, fd, ev->events);
-        if (eph->occupied >= eph->size)
+        finfo("%08x CTL ADD: fd=%d ev=%08" PRIx32 "\n",
+              epfd, fd, ev->events);
+        if (epn != NULL)
           {
-            set_errno(ENOMEM);
-            return -1;
+            ret = -EEXIST;
+            break;
           }
 
-        for (i = 1; i <= eph->occupied; i++)
+        ret = fs_getfilep(fd, &filep);
+        if (ret < 0)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                set_errno(EEXIST);
-                return -1;
-              }
+            break;
           }
 
-        eph->data[++eph->occupied]      = ev->data;
-        eph->poll[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->poll[eph->occupied].fd     = fd;
+        entry = dq_peek(&eph->free);
+        if (entry == NULL)
+          {
+            ret = -ENOMEM;
+            break;
+          }
 
-        break;
+        epn = container_of(entry, struct epoll_node_s, node);
+        epn->events  = ev->events;
+        epn->data    = ev->data;
+        epn->filep   = filep;
+        epn->pfd.fd  = fd;
+        epn->pfd.ptr = filep;
+        epn->pfd.sem = &eph->waitsem;
 
-      case EPOLL_CTL_DEL:
-        for (i = 1; i <= eph->occupied; i++)
+        ret = epoll_setup(epn);
+        if (ret >= 0)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                if (i != eph->occupied)
-                  {
-                    memmove(&eph->data[i], &eph->data[i + 1],
-                            sizeof(epoll_data_t) * (eph->occupied - i));
-                    memmove(&eph->poll[i], &eph->poll[i + 1],
-                            sizeof(struct pollfd) * (eph->occupied - i));
-                  }
-
-                break;
-              }
+            dq_rem(&epn->node, &eph->free);
+            dq_addlast(&epn->node, &eph->setup);
           }
+        break;
 
-        if (i > eph->occupied)
+      case EPOLL_CTL_DEL:
+        finfo("%08x CTL DEL: fd=%d\n", epfd, fd);
+        if (epn == NULL)
           {
-            set_errno(ENOENT);
-            return -1;
+            ret = -ENOENT;
+            break;
           }
 
-        eph->occupied--;
+        epoll_teardown(epn);
+        dq_rem(&epn->node, &eph->setup);
+        dq_addlast(&epn->node, &eph->free);
         break;
 
       case EPOLL_CTL_MOD:
-        finfo("%08x CTL MOD(%d): fd=%d ev=%08" PRIx32 "\n",
-              epfd, eph->occupied, fd, ev->events);
-        for (i = 1; i <= eph->occupied; i++)
-          {
-            if (eph->poll[i].fd == fd)
-              {
-                eph->data[i]        = ev->data;
-                eph->poll[i].events = ev->events | POLLERR | POLLHUP;
-                break;
-              }
-          }
-
-        if (i > eph->occupied)
+        finfo("%08x CTL MOD: fd=%d ev=%08" PRIx32 "\n",
+              epfd, fd, ev->events);
+        if (epn == NULL)
           {
-            set_errno(ENOENT);
-            return -1;
+            ret = -ENOENT;
+            break;
           }
 
+        epoll_teardown(epn);
+        epn->events = ev->events;
+        epn->data   = ev->data;
+        ret = epoll_setup(epn);
         break;
 
       default:
-        set_errno(EINVAL);
-        return -1;
+        ret = -EINVAL;
+        break;
     }
 
-  if (eph->poll[0].sem)
+  nxsem_post(&eph->sem);
+
+  if (ret < 0)
     {
-      eph->poll[0].revents |= eph->poll[0].events;
-      nxsem_post(eph->poll[0].sem);
+      set_errno(-ret);
+      return -1;
     }
 
   return 0;
@@ -376,18 +761,23 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
 
 /****************************************************************************
  * Name: epoll_pwait
+ *
+ * Description:
+ *   Wait for events on the registrations of an epoll instance.  Only the
+ *   registrations in the ready list are visited, so the cost of a wait
+ *   does not depend on the number of registrations.
+ *
  ****************************************************************************/
 
 int epoll_pwait(int epfd, FAR struct epoll_event *evs,
                 int maxevents, int timeout, FAR const sigset_t *sigmask)
 {
   FAR struct epoll_head *eph;
-  struct timespec expire;
-  struct timespec curr;
-  struct timespec diff;
-  int counter;
-  int rc;
-  int i;
+  sigset_t oldsigmask;
+  clock_t start;
+  clock_t ticks = 0;
+  clock_t elapsed;
+  int ret;
 
   eph = epoll_head_from_fd(epfd);
   if (eph == NULL)
@@ -395,61 +785,88 @@ int epoll_pwait(int epfd, FAR struct epoll_event *evs,
       return -1;
     }
 
-  if (timeout >= 0)
+  if (evs == NULL || maxevents <= 0)
     {
-      expire.tv_sec  = timeout / 1000;
-      expire.tv_nsec = timeout % 1000 * 1000;
-
-      clock_systime_timespec(&curr);
-      clock_timespec_add(&curr, &expire, &expire);
+      set_errno(EINVAL);
+      return -1;
     }
 
-again:
-  if (timeout < 0)
-    {
-      rc = ppoll(eph->poll, eph->occupied + 1, NULL, sigmask);
-    }
-  else
-    {
-      clock_systime_timespec(&curr);
-      clock_timespec_subtract(&expire, &curr, &diff);
+  /* epoll_wait() is a cancellation point */
 
-      rc = ppoll(eph->poll, eph->occupied + 1, &diff, sigmask);
+  enter_cancellation_point();
+
+  if (sigmask != NULL)
+    {
+      nxsig_procmask(SIG_SETMASK, sigmask, &oldsigmask);
     }
 
-  if (rc <= 0)
+  if (timeout > 0)
     {
-      return rc;
+      /* Round timeout up to next full tick as poll() does */
+
+#if (MSEC_PER_TICK * USEC_PER_MSEC) != USEC_PER_TICK && \
+    defined(CONFIG_HAVE_LONG_LONG)
+      ticks = (((unsigned long long)timeout * USEC_PER_MSEC) +
+               (USEC_PER_TICK - 1)) /
+              USEC_PER_TICK;
+#else
+      ticks = ((unsigned int)timeout + (MSEC_PER_TICK - 1)) /
+              MSEC_PER_TICK;
+#endif
     }
-  else if (eph->poll[0].revents != 0)
+
+  start = clock_systime_ticks();
+
+  for (; ; )
     {
-      if (--rc == 0)
+      ret = epoll_fetch(eph, evs, maxevents);
+      if (ret != 0 || timeout == 0)
+        {
+          break;
+        }
+
+      /* Nothing is ready.  Wait until a registration is queued in the
+       * ready list, for a signal, or for the timeout.
+       */
+
+      if (timeout < 0)
         {
-          goto again;
+          ret = nxsem_wait(&eph->waitsem);
+        }
+      else
+        {
+          elapsed = clock_systime_ticks() - start;
+          ret = elapsed < ticks ?
+                nxsem_tickwait(&eph->waitsem, ticks - elapsed) :
+                -ETIMEDOUT;
+        }
+
+      if (ret == -ETIMEDOUT)
+        {
+          /* Fetch one last time, then return */
+
+          timeout = 0;
+        }
+      else if (ret < 0)
+        {
+          break;
         }
     }
 
-  if (rc > maxevents)
+  if (sigmask != NULL)
     {
-      rc = maxevents;
+      nxsig_procmask(SIG_SETMASK, &oldsigmask, NULL);
     }
 
-  /* Iterate over non NULL event fds */
+  leave_cancellation_point();
 
-  for (i = 0, counter = 1; i < rc && counter <= eph->occupied; counter++)
+  if (ret < 0)
     {
-      if (eph->poll[counter].revents != 0)
-        {
-          evs[i].data     = eph->data[counter];
-          evs[i++].events = eph->poll[counter].revents;
-          if (eph->poll[counter].events & EPOLLONESHOT)
-            {
-              eph->poll[counter].events = 0; /* Disable oneshot internally */
-            }
-        }
+      set_errno(-ret);
+      return -1;
     }
 
-  return i;
+  return ret;
 }
 
 /****************************************************************************
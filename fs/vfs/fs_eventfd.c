@@ -36,6 +36,38 @@
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* When the counter can be updated with lock-free atomics, reads and
+ * writes that cannot need to wake anybody do not take exclsem: a write to
+ * a non-empty counter (no reader can be blocked and pollers saw POLLIN
+ * at setup) and a read while no writer is blocked and no poller waits for
+ * POLLOUT (nwrwait is zero).  Everything else is serialized by exclsem as
+ * before, but must still update the counter atomically.
+ */
+
+#ifdef __INT64_DEFINED
+#  define EVENTFD_LOCK_FREE __GCC_ATOMIC_LLONG_LOCK_FREE
+#else
+#  define EVENTFD_LOCK_FREE __GCC_ATOMIC_INT_LOCK_FREE
+#endif
+
+#if defined(EVENTFD_LOCK_FREE) && EVENTFD_LOCK_FREE == 2 && \
+    defined(__GCC_ATOMIC_INT_LOCK_FREE) && __GCC_ATOMIC_INT_LOCK_FREE == 2
+#  define EVENTFD_FASTPATH 1
+#  define eventfd_load(p)      __atomic_load_n(p, __ATOMIC_SEQ_CST)
+#  define eventfd_add(p, v)    __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST)
+#  define eventfd_cas(p, o, n) \
+     __atomic_compare_exchange_n(p, o, n, false, __ATOMIC_SEQ_CST, \
+                                 __ATOMIC_SEQ_CST)
+#else
+#  define eventfd_load(p)      (*(p))
+#  define eventfd_add(p, v)    (*(p) += (v))
+#  define eventfd_cas(p, o, n) (*(p) = (n), true)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -54,6 +86,7 @@ struct eventfd_priv_s
   eventfd_waiter_sem_t *rdsems; /* List of blocking readers */
   eventfd_waiter_sem_t *wrsems; /* List of blocking writers */
   eventfd_t    counter;         /* eventfd counter */
+  int          nwrwait;         /* Blocked writers and POLLOUT pollers */
   unsigned int minor;           /* eventfd minor number */
   uint8_t      crefs;           /* References counts on eventfd (max: 255) */
   bool         mode_semaphore;  /* eventfd mode (semaphore or counter) */
@@ -89,6 +122,12 @@ static void eventfd_pollnotify(FAR struct eventfd_priv_s *dev,
 static int eventfd_blocking_io(FAR struct eventfd_priv_s *dev,
                                eventfd_waiter_sem_t *sem,
                                FAR eventfd_waiter_sem_t **slist);
+static bool eventfd_tryread(FAR struct eventfd_priv_s *dev,
+                            FAR eventfd_t *value);
+static int eventfd_trywrite(FAR struct eventfd_priv_s *dev,
+                            eventfd_t value, bool locked,
+                            FAR eventfd_t *oldp);
+static void eventfd_wakeup(FAR eventfd_waiter_sem_t **slist);
 
 static unsigned int eventfd_get_unique_minor(void);
 static void eventfd_release_minor(unsigned int minor);
@@ -160,7 +199,7 @@ static void eventfd_pollnotify(FAR struct eventfd_priv_s *dev,
 
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -308,11 +347,75 @@ static int eventfd_blocking_io(FAR struct eventfd_priv_s *dev,
   return nxsem_wait(&dev->exclsem);
 }
 
+static bool eventfd_tryread(FAR struct eventfd_priv_s *dev,
+                            FAR eventfd_t *value)
+{
+  eventfd_t old = eventfd_load(&dev->counter);
+  eventfd_t next;
+
+  do
+    {
+      if (old == 0)
+        {
+          return false;
+        }
+
+      next = dev->mode_semaphore ? old - 1 : 0;
+    }
+  while (!eventfd_cas(&dev->counter, &old, next));
+
+  *value = dev->mode_semaphore ? 1 : old;
+  return true;
+}
+
+/* Add value to the counter.  Returns -EAGAIN if that would overflow and,
+ * if not locked, -EBUSY if the counter is empty: readers may then have to
+ * be woken up.
+ */
+
+static int eventfd_trywrite(FAR struct eventfd_priv_s *dev,
+                            eventfd_t value, bool locked,
+                            FAR eventfd_t *oldp)
+{
+  eventfd_t old = eventfd_load(&dev->counter);
+
+  do
+    {
+      *oldp = old;
+      if (old + value < old)
+        {
+          return -EAGAIN;
+        }
+
+      if (old == 0 && !locked)
+        {
+          return -EBUSY;
+        }
+    }
+  while (!eventfd_cas(&dev->counter, &old, old + value));
+
+  return OK;
+}
+
+static void eventfd_wakeup(FAR eventfd_waiter_sem_t **slist)
+{
+  eventfd_waiter_sem_t *cur_sem = *slist;
+
+  while (cur_sem != NULL)
+    {
+      nxsem_post(&cur_sem->sem);
+      cur_sem = cur_sem->next;
+    }
+
+  *slist = NULL;
+}
+
 static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
                                size_t len)
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct eventfd_priv_s *dev = inode->i_private;
+  eventfd_t value;
   ssize_t ret;
 
   if (len < sizeof(eventfd_t) || buffer == NULL)
@@ -320,6 +423,23 @@ static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
       return -EINVAL;
     }
 
+#ifdef EVENTFD_FASTPATH
+  if (eventfd_tryread(dev, &value))
+    {
+      *(FAR eventfd_t *)buffer = value;
+
+      /* The count is consumed, so exclsem must not be interrupted */
+
+      if (eventfd_load(&dev->nwrwait) != 0)
+        {
+          nxsem_wait_uninterruptible(&dev->exclsem);
+          goto notify;
+        }
+
+      return sizeof(eventfd_t);
+    }
+#endif
+
   ret = nxsem_wait(&dev->exclsem);
   if (ret < 0)
     {
@@ -328,7 +448,7 @@ static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
 
   /* Wait for an incoming event */
 
-  if (dev->counter == 0)
+  if (!eventfd_tryread(dev, &value))
     {
       if (filep->f_oflags & O_NONBLOCK)
         {
@@ -349,41 +469,31 @@ static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
               return ret;
             }
         }
-      while (dev->counter == 0);
+      while (!eventfd_tryread(dev, &value));
 
       nxsem_destroy(&sem.sem);
     }
 
   /* Device ready for read */
 
-  if (dev->mode_semaphore)
-    {
-      *(FAR eventfd_t *)buffer = 1;
-      dev->counter -= 1;
-    }
-  else
-    {
-      *(FAR eventfd_t *)buffer = dev->counter;
-      dev->counter = 0;
-    }
-
-#ifdef CONFIG_EVENT_FD_POLL
-  /* Notify all poll/select waiters */
+  *(FAR eventfd_t *)buffer = value;
 
-  eventfd_pollnotify(dev, POLLOUT);
+#ifdef EVENTFD_FASTPATH
+notify:
 #endif
 
-  /* Notify all waiting writers that counter have been decremented */
+  /* Notify all poll/select waiters and all waiting writers that the
+   * counter has been decremented, if there are any.
+   */
 
-  eventfd_waiter_sem_t *cur_sem = dev->wrsems;
-  while (cur_sem != NULL)
+  if (dev->nwrwait != 0)
     {
-      nxsem_post(&cur_sem->sem);
-      cur_sem = cur_sem->next;
+#ifdef CONFIG_EVENT_FD_POLL
+      eventfd_pollnotify(dev, POLLOUT);
+#endif
+      eventfd_wakeup(&dev->wrsems);
     }
 
-  dev->wrsems = NULL;
-
   nxsem_post(&dev->exclsem);
   return sizeof(eventfd_t);
 }
@@ -393,8 +503,9 @@ static ssize_t eventfd_do_write(FAR struct file *filep,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct eventfd_priv_s *dev = inode->i_private;
+  eventfd_t value;
+  eventfd_t old;
   ssize_t ret;
-  eventfd_t new_counter;
 
   if (len < sizeof(eventfd_t) || buffer == NULL ||
       (*(FAR eventfd_t *)buffer == (eventfd_t)-1) ||
@@ -403,15 +514,24 @@ static ssize_t eventfd_do_write(FAR struct file *filep,
       return -EINVAL;
     }
 
+  value = *(FAR eventfd_t *)buffer;
+
+#ifdef EVENTFD_FASTPATH
+  /* Nobody needs to be woken up if the counter was not empty */
+
+  if (eventfd_trywrite(dev, value, false, &old) == OK)
+    {
+      return sizeof(eventfd_t);
+    }
+#endif
+
   ret = nxsem_wait(&dev->exclsem);
   if (ret < 0)
     {
       return ret;
     }
 
-  new_counter = dev->counter + *(FAR eventfd_t *)buffer;
-
-  if (new_counter < dev->counter)
+  if (eventfd_trywrite(dev, value, true, &old) < 0)
     {
       /* Overflow detected */
 
@@ -425,42 +545,36 @@ static ssize_t eventfd_do_write(FAR struct file *filep,
       nxsem_init(&sem.sem, 0, 0);
       nxsem_set_protocol(&sem.sem, SEM_PRIO_NONE);
 
-      do
+      /* Readers must now take exclsem to wake us up */
+
+      eventfd_add(&dev->nwrwait, 1);
+      while (eventfd_trywrite(dev, value, true, &old) < 0)
         {
           ret = eventfd_blocking_io(dev, &sem, &dev->wrsems);
           if (ret < 0)
             {
+              nxsem_wait_uninterruptible(&dev->exclsem);
+              eventfd_add(&dev->nwrwait, -1);
+              nxsem_post(&dev->exclsem);
               nxsem_destroy(&sem.sem);
               return ret;
             }
         }
-      while ((new_counter = dev->counter + *(FAR eventfd_t *)buffer)
-            < dev->counter);
 
+      eventfd_add(&dev->nwrwait, -1);
       nxsem_destroy(&sem.sem);
     }
 
-  /* Ready to write, update counter */
-
-  dev->counter = new_counter;
+  /* Only the transition from empty can have readers to wake up */
 
+  if (old == 0)
+    {
 #ifdef CONFIG_EVENT_FD_POLL
-  /* Notify all poll/select waiters */
-
-  eventfd_pollnotify(dev, POLLIN);
+      eventfd_pollnotify(dev, POLLIN);
 #endif
-
-  /* Notify all of the waiting readers */
-
-  eventfd_waiter_sem_t *cur_sem = dev->rdsems;
-  while (cur_sem != NULL)
-    {
-      nxsem_post(&cur_sem->sem);
-      cur_sem = cur_sem->next;
+      eventfd_wakeup(&dev->rdsems);
     }
 
-  dev->rdsems = NULL;
-
   nxsem_post(&dev->exclsem);
   return sizeof(eventfd_t);
 }
@@ -474,6 +588,7 @@ static int eventfd_do_poll(FAR struct file *filep, FAR struct pollfd *fds,
   int ret;
   int i;
   pollevent_t eventset;
+  eventfd_t counter;
 
   ret = nxsem_wait(&dev->exclsem);
   if (ret < 0)
@@ -491,6 +606,11 @@ static int eventfd_do_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
       /* Remove all memory of the poll setup */
 
+      if (slot != NULL && (fds->events & POLLOUT) != 0)
+        {
+          eventfd_add(&dev->nwrwait, -1);
+        }
+
       *slot                = NULL;
       fds->priv            = NULL;
       goto out;
@@ -521,19 +641,27 @@ static int eventfd_do_poll(FAR struct file *filep, FAR struct pollfd *fds,
       goto out;
     }
 
+  /* Readers must take exclsem to report POLLOUT to this poller */
+
+  if ((fds->events & POLLOUT) != 0)
+    {
+      eventfd_add(&dev->nwrwait, 1);
+    }
+
   /* Notify the POLLOUT event if the pipe is not full, but only if
    * there is readers.
    */
 
+  counter  = eventfd_load(&dev->counter);
   eventset = 0;
-  if (dev->counter < (eventfd_t)-1)
+  if (counter < (eventfd_t)-1)
     {
       eventset |= POLLOUT;
     }
 
   /* Notify the POLLIN event if the pipe is not empty */
 
-  if (dev->counter > 0)
+  if (counter > 0)
     {
       eventset |= POLLIN;
     }
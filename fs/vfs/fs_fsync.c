@@ -32,6 +32,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/iostat.h>
 
 #include "inode/inode.h"
 
@@ -54,6 +55,8 @@
 int file_fsync(FAR struct file *filep)
 {
   struct inode *inode;
+  uint32_t start;
+  int ret;
 
   /* Is this inode a registered mountpoint? Does it support the
    * sync operations may be relevant to device drivers but only
@@ -69,7 +72,10 @@ int file_fsync(FAR struct file *filep)
 
   /* Yes, then tell the mountpoint to sync this file */
 
-  return inode->u.i_mops->sync(filep);
+  start = fs_iostat_begin();
+  ret = inode->u.i_mops->sync(filep);
+  fs_iostat_end(FS_IOSTAT_VFS_FSYNC, start, ret < 0 ? ret : 0);
+  return ret;
 }
 
 /****************************************************************************
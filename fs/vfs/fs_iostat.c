@@ -0,0 +1,227 @@
+/****************************************************************************
+ * fs/vfs/fs_iostat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/iostat.h>
+#include <nuttx/mtd/mtd.h>
+
+#ifdef CONFIG_FS_IOSTAT
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct fs_iostat_s g_fs_iostat[FS_IOSTAT_NOPS];
+static spinlock_t g_fs_iostat_lock;
+
+static FAR const char *g_fs_iostat_names[FS_IOSTAT_NOPS] =
+{
+  "vfs_read",
+  "vfs_write",
+  "vfs_fsync",
+  "bch_read",
+  "bch_write",
+  "mtd_bread",
+  "mtd_bwrite",
+  "mtd_read",
+  "mtd_erase"
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fs_iostat_end
+ *
+ * Description:
+ *   Account one operation.
+ *
+ ****************************************************************************/
+
+void fs_iostat_end(int op, uint32_t start, ssize_t result)
+{
+  FAR struct fs_iostat_s *stat;
+  uint32_t elapsed = up_perf_gettime() - start;
+  irqstate_t flags;
+
+  DEBUGASSERT(op >= 0 && op < FS_IOSTAT_NOPS);
+  stat = &g_fs_iostat[op];
+
+  flags = spin_lock_irqsave(&g_fs_iostat_lock);
+
+  stat->count++;
+  stat->time += elapsed;
+  if (elapsed > stat->maxtime)
+    {
+      stat->maxtime = elapsed;
+    }
+
+  if (result < 0)
+    {
+      stat->errors++;
+    }
+  else
+    {
+      stat->size += result;
+    }
+
+  spin_unlock_irqrestore(&g_fs_iostat_lock, flags);
+}
+
+/****************************************************************************
+ * Name: fs_iostat_get
+ *
+ * Description:
+ *   Return a snapshot of the counters of all operations.
+ *
+ ****************************************************************************/
+
+void fs_iostat_get(FAR struct fs_iostat_s *stats)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_fs_iostat_lock);
+  memcpy(stats, g_fs_iostat, sizeof(g_fs_iostat));
+  spin_unlock_irqrestore(&g_fs_iostat_lock, flags);
+}
+
+/****************************************************************************
+ * Name: fs_iostat_reset
+ *
+ * Description:
+ *   Clear the counters of all operations.
+ *
+ ****************************************************************************/
+
+void fs_iostat_reset(void)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_fs_iostat_lock);
+  memset(g_fs_iostat, 0, sizeof(g_fs_iostat));
+  spin_unlock_irqrestore(&g_fs_iostat_lock, flags);
+}
+
+/****************************************************************************
+ * Name: fs_iostat_name
+ *
+ * Description:
+ *   Return the name of an operation.
+ *
+ ****************************************************************************/
+
+FAR const char *fs_iostat_name(int op)
+{
+  return op >= 0 && op < FS_IOSTAT_NOPS ? g_fs_iostat_names[op] : NULL;
+}
+
+#ifdef CONFIG_MTD
+
+/****************************************************************************
+ * Name: mtd_iostat_*
+ *
+ * Description:
+ *   The accounted versions of the MTD access macros of
+ *   include/nuttx/mtd/mtd.h.
+ *
+ ****************************************************************************/
+
+int mtd_iostat_erase(FAR struct mtd_dev_s *dev, off_t startblock,
+                     size_t nblocks)
+{
+  uint32_t start;
+  int ret;
+
+  if (dev->erase == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  start = fs_iostat_begin();
+  ret = dev->erase(dev, startblock, nblocks);
+  fs_iostat_end(FS_IOSTAT_MTD_ERASE, start, ret < 0 ? ret : nblocks);
+  return ret;
+}
+
+ssize_t mtd_iostat_bread(FAR struct mtd_dev_s *dev, off_t startblock,
+                         size_t nblocks, FAR uint8_t *buffer)
+{
+  uint32_t start;
+  ssize_t ret;
+
+  if (dev->bread == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  start = fs_iostat_begin();
+  ret = dev->bread(dev, startblock, nblocks, buffer);
+  fs_iostat_end(FS_IOSTAT_MTD_BREAD, start, ret);
+  return ret;
+}
+
+ssize_t mtd_iostat_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
+                          size_t nblocks, FAR const uint8_t *buffer)
+{
+  uint32_t start;
+  ssize_t ret;
+
+  if (dev->bwrite == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  start = fs_iostat_begin();
+  ret = dev->bwrite(dev, startblock, nblocks, buffer);
+  fs_iostat_end(FS_IOSTAT_MTD_BWRITE, start, ret);
+  return ret;
+}
+
+ssize_t mtd_iostat_read(FAR struct mtd_dev_s *dev, off_t offset,
+                        size_t nbytes, FAR uint8_t *buffer)
+{
+  uint32_t start;
+  ssize_t ret;
+
+  if (dev->read == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  start = fs_iostat_begin();
+  ret = dev->read(dev, offset, nbytes, buffer);
+  fs_iostat_end(FS_IOSTAT_MTD_READ, start, ret);
+  return ret;
+}
+
+#endif /* CONFIG_MTD */
+#endif /* CONFIG_FS_IOSTAT */
@@ -191,7 +191,8 @@ errout_with_search:
  * Name: nx_vopen
  ****************************************************************************/
 
-static int nx_vopen(FAR const char *path, int oflags, va_list ap)
+static int nx_vopen(FAR struct tcb_s *tcb, FAR const char *path,
+                    int oflags, va_list ap)
 {
   struct file filep;
   int ret;
@@ -207,8 +208,8 @@ static int nx_vopen(FAR const char *path, int oflags, va_list ap)
 
   /* Allocate a new file descriptor for the inode */
 
-  fd = files_allocate(filep.f_inode, filep.f_oflags,
-                      filep.f_pos, filep.f_priv, 0);
+  fd = files_allocate_from_tcb(tcb, filep.f_inode, filep.f_oflags,
+                               filep.f_pos, filep.f_priv, 0);
   if (fd < 0)
     {
       file_close(&filep);
@@ -300,7 +301,36 @@ int nx_open(FAR const char *path, int oflags, ...)
   /* Let nx_vopen() do all of the work */
 
   va_start(ap, oflags);
-  fd = nx_vopen(path, oflags, ap);
+  fd = nx_vopen(nxsched_self(), path, oflags, ap);
+  va_end(ap);
+
+  return fd;
+}
+
+/****************************************************************************
+ * Name: nx_open_from_tcb
+ *
+ * Description:
+ *   nx_open_from_tcb() is similar to nx_open() except that the new file
+ *   descriptor is allocated in the file list of the task 'tcb'.  This is
+ *   used to open files on behalf of a new task before it is activated.
+ *
+ * Returned Value:
+ *   The new file descriptor is returned on success; a negated errno value is
+ *   returned on any failure.
+ *
+ ****************************************************************************/
+
+int nx_open_from_tcb(FAR struct tcb_s *tcb, FAR const char *path,
+                     int oflags, ...)
+{
+  va_list ap;
+  int fd;
+
+  /* Let nx_vopen() do all of the work */
+
+  va_start(ap, oflags);
+  fd = nx_vopen(tcb, path, oflags, ap);
   va_end(ap);
 
   return fd;
@@ -330,7 +360,7 @@ int open(FAR const char *path, int oflags, ...)
   /* Let nx_vopen() do most of the work */
 
   va_start(ap, oflags);
-  fd = nx_vopen(path, oflags, ap);
+  fd = nx_vopen(nxsched_self(), path, oflags, ap);
   va_end(ap);
 
   /* Set the errno value if any errors were reported by nx_open() */
@@ -89,6 +89,50 @@ static int poll_fdsetup(int fd, FAR struct pollfd *fds, bool setup)
   return file_poll(filep, fds, setup);
 }
 
+/****************************************************************************
+ * Name: poll_fdctl
+ *
+ * Description:
+ *   Setup or teardown the poll of one pollfd, whatever kind of object it
+ *   refers to.  Entries with nothing to poll (a negative fd or a NULL ptr)
+ *   are ignored.
+ *
+ ****************************************************************************/
+
+static int poll_fdctl(FAR struct pollfd *fds, bool setup)
+{
+  switch (fds->events & POLLMASK)
+    {
+    case POLLFD:
+      if (fds->fd >= 0)
+        {
+          return poll_fdsetup(fds->fd, fds, setup);
+        }
+      break;
+
+    case POLLFILE:
+      if (fds->ptr != NULL)
+        {
+          return file_poll(fds->ptr, fds, setup);
+        }
+      break;
+
+#ifdef CONFIG_NET
+    case POLLSOCK:
+      if (fds->ptr != NULL)
+        {
+          return psock_poll(fds->ptr, fds, setup);
+        }
+      break;
+#endif
+
+    default:
+      return -EINVAL;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: poll_setup
  *
@@ -118,6 +162,7 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
        */
 
       fds[i].sem     = sem;
+      fds[i].cb      = NULL;
       fds[i].revents = 0;
       fds[i].priv    = NULL;
 
@@ -130,36 +175,7 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
        * spec, that appears to be the correct behavior.
        */
 
-      switch (fds[i].events & POLLMASK)
-        {
-        case POLLFD:
-          if (fds[i].fd >= 0)
-            {
-              ret = poll_fdsetup(fds[i].fd, &fds[i], true);
-            }
-          break;
-
-        case POLLFILE:
-          if (fds[i].ptr != NULL)
-            {
-              ret = file_poll(fds[i].ptr, &fds[i], true);
-            }
-          break;
-
-#ifdef CONFIG_NET
-        case POLLSOCK:
-          if (fds[i].ptr != NULL)
-            {
-              ret = psock_poll(fds[i].ptr, &fds[i], true);
-            }
-          break;
-#endif
-
-        default:
-          ret = -EINVAL;
-          break;
-        }
-
+      ret = poll_fdctl(&fds[i], true);
       if (ret < 0)
         {
           /* Setup failed for fds[i]. We now need to teardown previously
@@ -170,25 +186,7 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
 
           for (j = 0; j < i; j++)
             {
-              switch (fds[j].events & POLLMASK)
-                {
-                case POLLFD:
-                  poll_fdsetup(fds[j].fd, &fds[j], false);
-                  break;
-
-                case POLLFILE:
-                  file_poll(fds[j].ptr, &fds[j], false);
-                  break;
-
-#ifdef CONFIG_NET
-                case POLLSOCK:
-                  psock_poll(fds[j].ptr, &fds[j], false);
-                  break;
-#endif
-
-                default:
-                  break;
-                }
+              poll_fdctl(&fds[j], false);
             }
 
           /* Indicate an error on the file descriptor */
@@ -221,36 +219,7 @@ static inline int poll_teardown(FAR struct pollfd *fds, nfds_t nfds,
   *count = 0;
   for (i = 0; i < nfds; i++)
     {
-      switch (fds[i].events & POLLMASK)
-        {
-        case POLLFD:
-          if (fds[i].fd >= 0)
-            {
-              status = poll_fdsetup(fds[i].fd, &fds[i], false);
-            }
-          break;
-
-        case POLLFILE:
-          if (fds[i].ptr != NULL)
-            {
-              status = file_poll(fds[i].ptr, &fds[i], false);
-            }
-          break;
-
-#ifdef CONFIG_NET
-        case POLLSOCK:
-            if (fds[i].ptr != NULL)
-            {
-              status = psock_poll(fds[i].ptr, &fds[i], false);
-            }
-          break;
-#endif
-
-        default:
-          status = -EINVAL;
-          break;
-        }
-
+      status = poll_fdctl(&fds[i], false);
       if (status < 0)
         {
           ret = status;
@@ -330,7 +299,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
               fds->revents |= (fds->events & (POLLIN | POLLOUT));
               if (fds->revents != 0)
                 {
-                  nxsem_post(fds->sem);
+                  poll_notify(&fds, 1, 0);
                 }
             }
 
@@ -340,7 +309,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
   else
     {
       fds->revents |= (POLLERR | POLLHUP);
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, 0);
 
       ret = OK;
     }
@@ -348,6 +317,61 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
   return ret;
 }
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Notify the poll waiters of new events.  The waiter's callback is called
+ *   if it provides one; otherwise its semaphore is posted, unless it has
+ *   already been posted and not yet taken.
+ *
+ * Input Parameters:
+ *   afds     - An array of pointers to the pollfd structures to notify.
+ *              NULL entries are skipped.
+ *   nfds     - The number of entries in afds
+ *   eventset - The events to add to revents (masked by the requested
+ *              events)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
+{
+  FAR struct pollfd *fds;
+  int semcount;
+  int i;
+
+  for (i = 0; i < nfds; i++)
+    {
+      fds = afds[i];
+      if (fds == NULL)
+        {
+          continue;
+        }
+
+      fds->revents |= fds->events & eventset;
+      if (fds->revents == 0)
+        {
+          continue;
+        }
+
+      if (fds->cb != NULL)
+        {
+          fds->cb(fds);
+        }
+      else if (fds->sem != NULL)
+        {
+          nxsem_get_value(fds->sem, &semcount);
+          if (semcount < 1)
+            {
+              poll_semgive(fds->sem);
+            }
+        }
+    }
+}
+
 /****************************************************************************
  * Name: nx_poll
  *
@@ -32,6 +32,7 @@
 #include <errno.h>
 
 #include <nuttx/cancelpt.h>
+#include <nuttx/fs/iostat.h>
 
 #include "inode/inode.h"
 
@@ -64,6 +65,7 @@
 ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
 {
   FAR struct inode *inode;
+  uint32_t start;
   int ret = -EBADF;
 
   DEBUGASSERT(filep);
@@ -89,9 +91,11 @@ ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
        * signature and position in the operations vtable.
        */
 
+      start = fs_iostat_begin();
       ret = (int)inode->u.i_ops->read(filep,
                                      (FAR char *)buf,
                                      (size_t)nbytes);
+      fs_iostat_end(FS_IOSTAT_VFS_READ, start, ret);
     }
 
   /* Return the number of bytes read (or possibly an error code) */
@@ -27,7 +27,9 @@
 #include <sys/select.h>
 #include <sys/time.h>
 
+#include <stdint.h>
 #include <string.h>
+#include <strings.h>
 #include <poll.h>
 #include <errno.h>
 #include <assert.h>
@@ -36,9 +38,104 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/sched.h>
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: select_word
+ *
+ * Description:
+ *   Return the 32 descriptors starting at fd = 32 * ndx that are in any of
+ *   the three sets, limited to descriptors below nfds.
+ *
+ ****************************************************************************/
+
+static uint32_t select_word(int nfds, int ndx, FAR fd_set *readfds,
+                            FAR fd_set *writefds, FAR fd_set *exceptfds)
+{
+  uint32_t bits = 0;
+  int nbits;
+
+  if (readfds)
+    {
+      bits |= readfds->arr[ndx];
+    }
+
+  if (writefds)
+    {
+      bits |= writefds->arr[ndx];
+    }
+
+  if (exceptfds)
+    {
+      bits |= exceptfds->arr[ndx];
+    }
+
+  nbits = nfds - (ndx << 5);
+  if (nbits < 32)
+    {
+      bits &= (UINT32_C(1) << nbits) - 1;
+    }
+
+  return bits;
+}
+
+/****************************************************************************
+ * Name: select_getpollset
+ *
+ * Description:
+ *   Return a pollfd array with room for npfds entries.  With
+ *   CONFIG_FS_SELECT_SCRATCH the array is kept in the TCB and reused by
+ *   later calls on the same thread; it is freed when the thread exits.
+ *
+ ****************************************************************************/
+
+static FAR struct pollfd *select_getpollset(int npfds)
+{
+#ifdef CONFIG_FS_SELECT_SCRATCH
+  FAR struct tcb_s *rtcb = nxsched_self();
+
+  if (rtcb->npollscratch < npfds)
+    {
+      /* Grow in steps of 8 so that sets changing by a few descriptors do
+       * not reallocate every time.
+       */
+
+      int nalloc = (npfds + 7) & ~7;
+
+      kmm_free(rtcb->pollscratch);
+      rtcb->npollscratch = 0;
+      rtcb->pollscratch  = (FAR struct pollfd *)
+        kmm_malloc(nalloc * sizeof(struct pollfd));
+      if (rtcb->pollscratch == NULL)
+        {
+          return NULL;
+        }
+
+      rtcb->npollscratch = nalloc;
+    }
+
+  return rtcb->pollscratch;
+#else
+  return (FAR struct pollfd *)kmm_malloc(npfds * sizeof(struct pollfd));
+#endif
+}
+
+/****************************************************************************
+ * Name: select_putpollset
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_SELECT_SCRATCH
+#  define select_putpollset(pollset)
+#else
+#  define select_putpollset(pollset) kmm_free(pollset)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -79,11 +176,16 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
            FAR fd_set *exceptfds, FAR struct timeval *timeout)
 {
   struct pollfd *pollset = NULL;
+  fd_set rset;
+  fd_set wset;
+  fd_set eset;
+  uint32_t bits;
   int errcode = OK;
-  int fd;
+  int nwords;
   int npfds;
   int msec;
   int ndx;
+  int fd;
   int ret;
 
   /* select() is cancellation point */
@@ -96,31 +198,30 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
       goto errout;
     }
 
-  /* How many pollfd structures do we need to allocate? */
+  if (nfds > FD_SETSIZE)
+    {
+      nfds = FD_SETSIZE;
+    }
 
-  /* Initialize the descriptor list for poll() */
+  /* How many pollfd structures do we need?  The three sets are scanned a
+   * word at a time so that empty ranges of descriptors cost nothing.
+   */
 
-  for (fd = 0, npfds = 0; fd < nfds; fd++)
+  nwords = (nfds + 31) >> 5;
+  for (ndx = 0, npfds = 0; ndx < nwords; ndx++)
     {
-      /* Check if any monitor operation is requested on this fd */
-
-      if ((readfds   && FD_ISSET(fd, readfds))  ||
-          (writefds  && FD_ISSET(fd, writefds)) ||
-          (exceptfds && FD_ISSET(fd, exceptfds)))
+      bits = select_word(nfds, ndx, readfds, writefds, exceptfds);
+      if (bits != 0)
         {
-          /* Yes.. increment the count of pollfds structures needed */
-
-          npfds++;
+          npfds += popcount(bits);
         }
     }
 
-  /* Allocate the descriptor list for poll() */
+  /* Get the descriptor list for poll() */
 
   if (npfds > 0)
     {
-      pollset = (FAR struct pollfd *)
-        kmm_zalloc(npfds * sizeof(struct pollfd));
-
+      pollset = select_getpollset(npfds);
       if (pollset == NULL)
         {
           errcode = ENOMEM;
@@ -130,49 +231,48 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
 
   /* Initialize the descriptor list for poll() */
 
-  for (fd = 0, ndx = 0; fd < nfds; fd++)
+  for (ndx = 0, npfds = 0; ndx < nwords; ndx++)
     {
-      int incr = 0;
+      bits = select_word(nfds, ndx, readfds, writefds, exceptfds);
+      while (bits != 0)
+        {
+          int bit = ffs((int)bits) - 1;
 
-      /* The readfs set holds the set of FDs that the caller can be assured
-       * of reading from without blocking.  Note that POLLHUP is included as
-       * a read-able condition.  POLLHUP will be reported at the end-of-file
-       * or when a connection is lost.  In either case, the read() can then
-       * be performed without blocking.
-       */
+          bits &= ~(UINT32_C(1) << bit);
+          fd    = (ndx << 5) + bit;
 
-      if (readfds && FD_ISSET(fd, readfds))
-        {
-          pollset[ndx].fd      = fd;
-          pollset[ndx].events |= POLLIN;
-          incr                 = 1;
-        }
+          pollset[npfds].fd     = fd;
+          pollset[npfds].events = 0;
+          pollset[npfds].ptr    = NULL;
 
-      /* The writefds set holds the set of FDs that the caller can be assured
-       * of writing to without blocking.
-       */
+          /* The readfs set holds the set of FDs that the caller can be
+           * assured of reading from without blocking.  Note that POLLHUP is
+           * included as a read-able condition.  POLLHUP will be reported at
+           * the end-of-file or when a connection is lost.  In either case,
+           * the read() can then be performed without blocking.
+           */
 
-      if (writefds && FD_ISSET(fd, writefds))
-        {
-          pollset[ndx].fd      = fd;
-          pollset[ndx].events |= POLLOUT;
-          incr                 = 1;
-        }
+          if (readfds && FD_ISSET(fd, readfds))
+            {
+              pollset[npfds].events |= POLLIN;
+            }
 
-      /* The exceptfds set holds the set of FDs that are watched for
-       * exceptions
-       */
+          /* The writefds set holds the set of FDs that the caller can be
+           * assured of writing to without blocking.
+           */
 
-      if (exceptfds && FD_ISSET(fd, exceptfds))
-        {
-          pollset[ndx].fd      = fd;
-          incr                  = 1;
-        }
+          if (writefds && FD_ISSET(fd, writefds))
+            {
+              pollset[npfds].events |= POLLOUT;
+            }
 
-      ndx += incr;
-    }
+          /* The exceptfds set holds the set of FDs that are watched for
+           * exceptions.  POLLERR is always reported.
+           */
 
-  DEBUGASSERT(ndx == npfds);
+          npfds++;
+        }
+    }
 
   /* Convert the timeout to milliseconds */
 
@@ -199,70 +299,79 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
       errcode = -ret;
     }
 
-  /* Now set up the return values */
-
-  if (readfds)
-    {
-      memset(readfds, 0, sizeof(fd_set));
-    }
-
-  if (writefds)
-    {
-      memset(writefds, 0, sizeof(fd_set));
-    }
-
-  if (exceptfds)
-    {
-      memset(exceptfds, 0, sizeof(fd_set));
-    }
+  /* Convert the poll descriptor list back into selects 3 bitsets.  Only
+   * report a descriptor in a set that it was requested in.
+   */
 
-  /* Convert the poll descriptor list back into selects 3 bitsets */
+  FD_ZERO(&rset);
+  FD_ZERO(&wset);
+  FD_ZERO(&eset);
 
   if (ret > 0)
     {
       ret = 0;
       for (ndx = 0; ndx < npfds; ndx++)
         {
+          pollevent_t revents = pollset[ndx].revents;
+
+          if (revents == 0)
+            {
+              continue;
+            }
+
+          fd = pollset[ndx].fd;
+
           /* Check for read conditions.  Note that POLLHUP is included as a
            * read condition.  POLLHUP will be reported when no more data will
            * be available (such as when a connection is lost).  In either
            * case, the read() can then be performed without blocking.
            */
 
-          if (readfds)
+          if ((pollset[ndx].events & POLLIN) != 0 &&
+              (revents & (POLLIN | POLLHUP)) != 0)
             {
-              if (pollset[ndx].revents & (POLLIN | POLLHUP))
-                {
-                  FD_SET(pollset[ndx].fd, readfds);
-                  ret++;
-                }
+              FD_SET(fd, &rset);
+              ret++;
             }
 
           /* Check for write conditions */
 
-          if (writefds)
+          if ((pollset[ndx].events & POLLOUT) != 0 &&
+              (revents & (POLLOUT | POLLHUP)) != 0)
             {
-              if (pollset[ndx].revents & (POLLOUT | POLLHUP))
-                {
-                  FD_SET(pollset[ndx].fd, writefds);
-                  ret++;
-                }
+              FD_SET(fd, &wset);
+              ret++;
             }
 
           /* Check for exceptions */
 
-          if (exceptfds)
+          if (exceptfds && FD_ISSET(fd, exceptfds) &&
+              (revents & POLLERR) != 0)
             {
-              if (pollset[ndx].revents & POLLERR)
-                {
-                  FD_SET(pollset[ndx].fd, exceptfds);
-                  ret++;
-                }
+              FD_SET(fd, &eset);
+              ret++;
             }
         }
     }
 
-  kmm_free(pollset);
+  /* Now set up the return values */
+
+  if (readfds)
+    {
+      memcpy(readfds, &rset, sizeof(fd_set));
+    }
+
+  if (writefds)
+    {
+      memcpy(writefds, &wset, sizeof(fd_set));
+    }
+
+  if (exceptfds)
+    {
+      memcpy(exceptfds, &eset, sizeof(fd_set));
+    }
+
+  select_putpollset(pollset);
 
   /* Did poll() fail above? */
 
@@ -176,6 +176,19 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
                    * suppose just continue?
                    */
 
+                  if (ntransferred > 0 && nbyteswritten == -EAGAIN)
+                    {
+                      /* A non-blocking output file is full.  Return the
+                       * progress made and give the unwritten data back to
+                       * the input file, so that the caller can continue
+                       * from there.
+                       */
+
+                      file_seek(infile, -nbytesread, SEEK_CUR);
+                      endxfr = true;
+                      break;
+                    }
+
                   if (nbyteswritten != -EINTR || ntransferred == 0)
                     {
                       /* Write error.  Break out and return the error
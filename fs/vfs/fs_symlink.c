@@ -149,19 +149,20 @@ int symlink(FAR const char *path1, FAR const char *path2)
         }
 
       ret = inode_reserve(path2, 0777, &inode);
-      inode_semgive();
-
       if (ret < 0)
         {
+          inode_semgive();
           kmm_free(newpath2);
           errcode = -ret;
           goto errout_with_search;
         }
 
-      /* Initialize the inode */
+      /* Initialize the inode before other lookups can see it */
 
       INODE_SET_SOFTLINK(inode);
       inode->u.i_link = newpath2;
+      inode_cache_invalidate();
+      inode_semgive();
     }
 
   /* Symbolic link successfully created */
@@ -32,6 +32,7 @@
 #include <debug.h>
 
 #include <nuttx/wdog.h>
+#include <nuttx/timers/hrtimer.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/spinlock.h>
 
@@ -67,6 +68,10 @@ struct timerfd_priv_s
   int           delay;          /* If non-zero, used to reset repetitive
                                  * timers */
   struct wdog_s wdog;           /* The watchdog that provides the timing */
+#ifdef CONFIG_HRTIMER
+  struct hrtimer_s hrtimer;     /* Used instead of wdog when available */
+  uint64_t      interval;       /* Repetition interval of the hrtimer (ns) */
+#endif
   struct work_s work;           /* For deferred timeout operations */
   timerfd_t     counter;        /* timerfd counter */
   spinlock_t    lock;           /* timerfd counter specific lock */
@@ -107,10 +112,15 @@ static unsigned int timerfd_get_unique_minor(void);
 static void timerfd_release_minor(unsigned int minor);
 
 static FAR struct timerfd_priv_s *timerfd_allocdev(void);
+static void timerfd_getvalue(FAR struct timerfd_priv_s *dev,
+                             FAR struct itimerspec *value);
 static void timerfd_destroy(FAR struct timerfd_priv_s *dev);
 
 static void timerfd_timeout_work(FAR void *arg);
 static void timerfd_timeout(wdparm_t idev);
+#ifdef CONFIG_HRTIMER
+static void timerfd_hrtimeout(FAR struct hrtimer_s *timer, FAR void *arg);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -157,6 +167,9 @@ static FAR struct timerfd_priv_s *timerfd_allocdev(void)
 static void timerfd_destroy(FAR struct timerfd_priv_s *dev)
 {
   wd_cancel(&dev->wdog);
+#ifdef CONFIG_HRTIMER
+  hrtimer_cancel(&dev->hrtimer);
+#endif
   work_cancel(TIMER_FD_WORK, &dev->work);
   nxsem_destroy(&dev->exclsem);
   kmm_free(dev);
@@ -174,6 +187,34 @@ static timerfd_t timerfd_get_counter(FAR struct timerfd_priv_s *dev)
   return counter;
 }
 
+static void timerfd_getvalue(FAR struct timerfd_priv_s *dev,
+                             FAR struct itimerspec *value)
+{
+  sclock_t ticks;
+
+#ifdef CONFIG_HRTIMER
+  if (HRTIMER_ISACTIVE(&dev->hrtimer))
+    {
+      uint64_t ns = hrtimer_gettime(&dev->hrtimer);
+
+      value->it_value.tv_sec     = ns / NSEC_PER_SEC;
+      value->it_value.tv_nsec    = ns % NSEC_PER_SEC;
+      value->it_interval.tv_sec  = dev->interval / NSEC_PER_SEC;
+      value->it_interval.tv_nsec = dev->interval % NSEC_PER_SEC;
+      return;
+    }
+#endif
+
+  /* Get the number of ticks before the underlying watchdog expires */
+
+  ticks = wd_gettime(&dev->wdog);
+
+  /* Convert that to a struct timespec and return it */
+
+  clock_ticks2time(ticks, &value->it_value);
+  clock_ticks2time(dev->delay, &value->it_interval);
+}
+
 #ifdef CONFIG_TIMER_FD_POLL
 static void timerfd_pollnotify(FAR struct timerfd_priv_s *dev,
                                pollevent_t eventset)
@@ -190,7 +231,7 @@ static void timerfd_pollnotify(FAR struct timerfd_priv_s *dev,
 
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -478,6 +519,9 @@ static void timerfd_timeout_work(FAR void *arg)
   if (ret < 0)
     {
       wd_cancel(&dev->wdog);
+#ifdef CONFIG_HRTIMER
+      hrtimer_cancel(&dev->hrtimer);
+#endif
       return;
     }
 
@@ -512,11 +556,15 @@ static void timerfd_timeout(wdparm_t idev)
 
   intflags = spin_lock_irqsave(&dev->lock);
 
-  /* Increment timer expiration counter */
-
-  dev->counter++;
+  /* Increment timer expiration counter.  Readers and pollers only need to
+   * be woken up when the counter leaves zero: until it is read, further
+   * expirations just add to it.
+   */
 
-  work_queue(TIMER_FD_WORK, &dev->work, timerfd_timeout_work, dev, 0);
+  if (dev->counter++ == 0)
+    {
+      work_queue(TIMER_FD_WORK, &dev->work, timerfd_timeout_work, dev, 0);
+    }
 
   /* If this is a repetitive timer, then restart the watchdog */
 
@@ -528,6 +576,65 @@ static void timerfd_timeout(wdparm_t idev)
   spin_unlock_irqrestore(&dev->lock, intflags);
 }
 
+#ifdef CONFIG_HRTIMER
+static void timerfd_hrtimeout(FAR struct hrtimer_s *timer, FAR void *arg)
+{
+  FAR struct timerfd_priv_s *dev = (FAR struct timerfd_priv_s *)arg;
+  irqstate_t intflags;
+  timerfd_t counter;
+  uint64_t overruns;
+  uint64_t now;
+
+  intflags = spin_lock_irqsave(&dev->lock);
+
+  /* If the expiration was handled late, count all of the periods that
+   * have elapsed at once rather than firing once for each of them.
+   */
+
+  overruns = 0;
+  if (dev->interval)
+    {
+      now = hrtimer_current();
+      if (now >= timer->expired + dev->interval)
+        {
+          overruns = (now - timer->expired) / dev->interval;
+        }
+    }
+
+  /* Increment timer expiration counter.  Readers and pollers only need to
+   * be woken up when the counter leaves zero.
+   */
+
+  counter = dev->counter;
+  if (overruns >= (timerfd_t)-1 - counter)
+    {
+      dev->counter = (timerfd_t)-1;
+    }
+  else
+    {
+      dev->counter = counter + 1 + overruns;
+    }
+
+  if (counter == 0)
+    {
+      work_queue(TIMER_FD_WORK, &dev->work, timerfd_timeout_work, dev, 0);
+    }
+
+  /* If this is a repetitive timer, then restart it relative to the last
+   * expiration time so that the period does not drift.
+   */
+
+  if (dev->interval)
+    {
+      hrtimer_start(&dev->hrtimer,
+                    timer->expired + (overruns + 1) * dev->interval,
+                    HRTIMER_MODE_ABS, timerfd_hrtimeout, dev);
+    }
+
+  spin_unlock_irqrestore(&dev->lock, intflags);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -623,6 +730,10 @@ int timerfd_settime(int fd, int flags,
   FAR struct timerfd_priv_s *dev;
   irqstate_t intflags;
   sclock_t delay;
+#ifdef CONFIG_HRTIMER
+  struct timespec ts;
+  uint64_t ns;
+#endif
   int ret;
 
   /* Some sanity checks */
@@ -659,14 +770,7 @@ int timerfd_settime(int fd, int flags,
 
   if (old_value)
     {
-      /* Get the number of ticks before the underlying watchdog expires */
-
-      delay = wd_gettime(&dev->wdog);
-
-      /* Convert that to a struct timespec and return it */
-
-      clock_ticks2time(delay, &old_value->it_value);
-      clock_ticks2time(dev->delay, &old_value->it_interval);
+      timerfd_getvalue(dev, old_value);
     }
 
   /* Disable interrupts here to ensure that expiration counter is accessed
@@ -680,6 +784,9 @@ int timerfd_settime(int fd, int flags,
    */
 
   wd_cancel(&dev->wdog);
+#ifdef CONFIG_HRTIMER
+  hrtimer_cancel(&dev->hrtimer);
+#endif
 
   /* Cancel notification work */
 
@@ -737,6 +844,42 @@ int timerfd_settime(int fd, int flags,
       clock_time2ticks(&new_value->it_value, &delay);
     }
 
+#ifdef CONFIG_HRTIMER
+  /* Prefer a high resolution timer if one is available.  The times are
+   * then used with nanosecond precision instead of being rounded to
+   * system ticks.
+   */
+
+  dev->interval = (uint64_t)new_value->it_interval.tv_sec * NSEC_PER_SEC +
+                  new_value->it_interval.tv_nsec;
+
+  if ((flags & TFD_TIMER_ABSTIME) != 0)
+    {
+      clock_gettime(dev->clock, &ts);
+      clock_timespec_subtract(&new_value->it_value, &ts, &ts);
+    }
+  else
+    {
+      ts = new_value->it_value;
+    }
+
+  ns = (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+  if (ns == 0)
+    {
+      ns = dev->interval;
+    }
+
+  if (ns == 0 ||
+      hrtimer_start(&dev->hrtimer, ns, HRTIMER_MODE_REL,
+                    timerfd_hrtimeout, dev) >= 0)
+    {
+      spin_unlock_irqrestore(&dev->lock, intflags);
+      return OK;
+    }
+
+  dev->interval = 0;
+#endif
+
   /* If the time is in the past or now, then set up the next interval
    * instead (assuming a repetitive timer).
    */
@@ -770,7 +913,6 @@ int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
 {
   FAR struct file *filep;
   FAR struct timerfd_priv_s *dev;
-  sclock_t ticks;
   int ret;
 
   /* Some sanity checks */
@@ -799,14 +941,7 @@ int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
 
   dev = (FAR struct timerfd_priv_s *)filep->f_inode->i_private;
 
-  /* Get the number of ticks before the underlying watchdog expires */
-
-  ticks = wd_gettime(&dev->wdog);
-
-  /* Convert that to a struct timespec and return it */
-
-  clock_ticks2time(ticks, &curr_value->it_value);
-  clock_ticks2time(dev->delay, &curr_value->it_interval);
+  timerfd_getvalue(dev, curr_value);
   return OK;
 
 errout:
@@ -32,6 +32,7 @@
 #include <assert.h>
 
 #include <nuttx/cancelpt.h>
+#include <nuttx/fs/iostat.h>
 
 #include "inode/inode.h"
 
@@ -68,6 +69,8 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf,
                    size_t nbytes)
 {
   FAR struct inode *inode;
+  uint32_t start;
+  ssize_t ret;
 
   /* Was this file opened for write access? */
 
@@ -86,7 +89,10 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf,
 
   /* Yes, then let the driver perform the write */
 
-  return inode->u.i_ops->write(filep, buf, nbytes);
+  start = fs_iostat_begin();
+  ret = inode->u.i_ops->write(filep, buf, nbytes);
+  fs_iostat_end(FS_IOSTAT_VFS_WRITE, start, ret);
+  return ret;
 }
 
 /****************************************************************************
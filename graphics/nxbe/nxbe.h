@@ -171,6 +171,19 @@ struct nxbe_plane_s
   struct nxbe_cursorops_s cursor;
 #endif
 
+#ifdef CONFIG_NX_ACCEL
+  /* Software rasterizers used when the 2D engine declines a request */
+
+  struct nxbe_dev_vtable_s swdev;
+
+#ifdef CONFIG_NX_SWCURSOR
+  struct nxbe_cursorops_s swcursor;
+#endif
+
+  uint8_t planeno;                /* Plane number in the driver */
+  bool busy;                      /* The engine may still be rendering */
+#endif
+
   /* Framebuffer plane info describing destination video plane */
 
   NX_DRIVERTYPE *driver;
@@ -323,6 +336,38 @@ void nxbe_notify_rectangle(FAR NX_DRIVERTYPE *dev,
 
 int nxbe_configure(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be);
 
+#ifdef CONFIG_NX_ACCEL
+/****************************************************************************
+ * Name: nxbe_accel_configure
+ *
+ * Description:
+ *   Route the raster operations of one plane through the 2D engine of the
+ *   framebuffer driver.  The software rasterizers selected for the plane
+ *   are kept as the fallback.
+ *
+ * Input Parameters:
+ *   plane   - The plane, with its software rasterizers already selected
+ *   planeno - The plane number in the framebuffer driver
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_accel_configure(FAR struct nxbe_plane_s *plane, int planeno);
+
+/****************************************************************************
+ * Name: nxbe_accel_sync
+ *
+ * Description:
+ *   Wait until all the 2D engine operations queued on the plane have
+ *   completed.
+ *
+ ****************************************************************************/
+
+void nxbe_accel_sync(FAR struct nxbe_plane_s *plane);
+#endif
+
 #if defined(CONFIG_NX_SWCURSOR) || defined(CONFIG_NX_HWCURSOR)
 /****************************************************************************
  * Name: nxbe_cursor_enable
@@ -0,0 +1,324 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_accel.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/nuttx.h>
+#include <nuttx/video/fb.h>
+
+#include "nxglib.h"
+#include "nxbe.h"
+
+#ifdef CONFIG_NX_ACCEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Recover the plane from the plane info passed to the raster operations */
+
+#define NXBE_PINFO2PLANE(p) container_of(p, struct nxbe_plane_s, pinfo)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_accel_area
+ *
+ * Description:
+ *   Convert an NX rectangle to a framebuffer area.
+ *
+ ****************************************************************************/
+
+static inline void nxbe_accel_area(FAR const struct nxgl_rect_s *rect,
+                                   FAR struct fb_area_s *area)
+{
+  area->x = rect->pt1.x;
+  area->y = rect->pt1.y;
+  area->w = rect->pt2.x - rect->pt1.x + 1;
+  area->h = rect->pt2.y - rect->pt1.y + 1;
+}
+
+/****************************************************************************
+ * Name: nxbe_accel_done
+ *
+ * Description:
+ *   An operation was accepted by the 2D engine.  Keep the display update
+ *   hooks coherent by waiting for it to finish if those are enabled.
+ *
+ ****************************************************************************/
+
+static inline void nxbe_accel_done(FAR struct nxbe_plane_s *plane)
+{
+  plane->busy = true;
+
+#ifdef CONFIG_NX_UPDATE
+  nxbe_accel_sync(plane);
+#endif
+}
+
+/****************************************************************************
+ * Name: nxbe_accel_setpixel, nxbe_accel_getrectangle and
+ *       nxbe_accel_filltrapezoid
+ *
+ * Description:
+ *   Operations that are always rendered by software.  They only have to
+ *   wait for the 2D engine first.
+ *
+ ****************************************************************************/
+
+static void nxbe_accel_setpixel(FAR NX_PLANEINFOTYPE *pinfo,
+                                FAR const struct nxgl_point_s *pos,
+                                nxgl_mxpixel_t color)
+{
+  FAR struct nxbe_plane_s *plane = NXBE_PINFO2PLANE(pinfo);
+
+  nxbe_accel_sync(plane);
+  plane->swdev.setpixel(pinfo, pos, color);
+}
+
+static void nxbe_accel_getrectangle(FAR NX_PLANEINFOTYPE *pinfo,
+                                    FAR const struct nxgl_rect_s *rect,
+                                    FAR void *dest, unsigned int deststride)
+{
+  FAR struct nxbe_plane_s *plane = NXBE_PINFO2PLANE(pinfo);
+
+  nxbe_accel_sync(plane);
+  plane->swdev.getrectangle(pinfo, rect, dest, deststride);
+}
+
+static void nxbe_accel_filltrapezoid(FAR NX_PLANEINFOTYPE *pinfo,
+                                     FAR const struct nxgl_trapezoid_s *trap,
+                                     FAR const struct nxgl_rect_s *bounds,
+                                     nxgl_mxpixel_t color)
+{
+  FAR struct nxbe_plane_s *plane = NXBE_PINFO2PLANE(pinfo);
+
+  nxbe_accel_sync(plane);
+  plane->swdev.filltrapezoid(pinfo, trap, bounds, color);
+}
+
+/****************************************************************************
+ * Name: nxbe_accel_fillrectangle
+ ****************************************************************************/
+
+static void nxbe_accel_fillrectangle(FAR NX_PLANEINFOTYPE *pinfo,
+                                     FAR const struct nxgl_rect_s *rect,
+                                     nxgl_mxpixel_t color)
+{
+  FAR struct nxbe_plane_s *plane = NXBE_PINFO2PLANE(pinfo);
+  FAR struct fb_vtable_s *vtable = plane->driver;
+  struct fb_area_s area;
+
+  if (vtable->fillarea != NULL)
+    {
+      nxbe_accel_area(rect, &area);
+      if (vtable->fillarea(vtable, plane->planeno, &area, color) >= 0)
+        {
+          nxbe_accel_done(plane);
+          return;
+        }
+    }
+
+  nxbe_accel_sync(plane);
+  plane->swdev.fillrectangle(pinfo, rect, color);
+}
+
+/****************************************************************************
+ * Name: nxbe_accel_moverectangle
+ ****************************************************************************/
+
+static void nxbe_accel_moverectangle(FAR NX_PLANEINFOTYPE *pinfo,
+                                     FAR const struct nxgl_rect_s *rect,
+                                     FAR struct nxgl_point_s *offset)
+{
+  FAR struct nxbe_plane_s *plane = NXBE_PINFO2PLANE(pinfo);
+  FAR struct fb_vtable_s *vtable = plane->driver;
+  struct fb_area_s area;
+
+  if (vtable->copyarea != NULL)
+    {
+      nxbe_accel_area(rect, &area);
+      if (vtable->copyarea(vtable, plane->planeno, &area,
+                           offset->x, offset->y) >= 0)
+        {
+          nxbe_accel_done(plane);
+          return;
+        }
+    }
+
+  nxbe_accel_sync(plane);
+  plane->swdev.moverectangle(pinfo, rect, offset);
+}
+
+/****************************************************************************
+ * Name: nxbe_accel_copyrectangle
+ ****************************************************************************/
+
+static void nxbe_accel_copyrectangle(FAR NX_PLANEINFOTYPE *pinfo,
+                                     FAR const struct nxgl_rect_s *dest,
+                                     FAR const void *src,
+                                     FAR const struct nxgl_point_s *origin,
+                                     unsigned int srcstride)
+{
+  FAR struct nxbe_plane_s *plane = NXBE_PINFO2PLANE(pinfo);
+  FAR struct fb_vtable_s *vtable = plane->driver;
+  FAR const uint8_t *sline;
+  struct fb_area_s area;
+
+  /* Sub-byte pixels may not start on a byte boundary in the source */
+
+  if (vtable->bltarea != NULL && pinfo->bpp >= 8)
+    {
+      sline = (FAR const uint8_t *)src +
+              (dest->pt1.x - origin->x) * (pinfo->bpp >> 3) +
+              (dest->pt1.y - origin->y) * srcstride;
+
+      nxbe_accel_area(dest, &area);
+      if (vtable->bltarea(vtable, plane->planeno, &area, sline,
+                          srcstride) >= 0)
+        {
+          nxbe_accel_done(plane);
+          return;
+        }
+    }
+
+  nxbe_accel_sync(plane);
+  plane->swdev.copyrectangle(pinfo, dest, src, origin, srcstride);
+}
+
+#ifdef CONFIG_NX_SWCURSOR
+/****************************************************************************
+ * Name: nxbe_accel_cursor_*
+ *
+ * Description:
+ *   The software cursor reads and writes the plane memory directly.
+ *
+ ****************************************************************************/
+
+static void nxbe_accel_cursor_draw(FAR struct nxbe_state_s *be,
+                                   FAR const struct nxgl_rect_s *bounds,
+                                   int planeno)
+{
+  nxbe_accel_sync(&be->plane[planeno]);
+  be->plane[planeno].swcursor.draw(be, bounds, planeno);
+}
+
+static void nxbe_accel_cursor_erase(FAR struct nxbe_state_s *be,
+                                    FAR const struct nxgl_rect_s *bounds,
+                                    int planeno)
+{
+  nxbe_accel_sync(&be->plane[planeno]);
+  be->plane[planeno].swcursor.erase(be, bounds, planeno);
+}
+
+static void nxbe_accel_cursor_backup(FAR struct nxbe_state_s *be,
+                                     FAR const struct nxgl_rect_s *bounds,
+                                     int planeno)
+{
+  nxbe_accel_sync(&be->plane[planeno]);
+  be->plane[planeno].swcursor.backup(be, bounds, planeno);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_accel_configure
+ *
+ * Description:
+ *   Route the raster operations of one plane through the 2D engine of the
+ *   framebuffer driver.  The software rasterizers selected for the plane
+ *   are kept as the fallback.
+ *
+ ****************************************************************************/
+
+void nxbe_accel_configure(FAR struct nxbe_plane_s *plane, int planeno)
+{
+  FAR struct fb_vtable_s *vtable = plane->driver;
+
+  DEBUGASSERT(vtable != NULL);
+
+  plane->planeno = planeno;
+  plane->busy    = false;
+
+  /* Nothing to do if the driver cannot accelerate anything */
+
+  if (vtable->fillarea == NULL && vtable->copyarea == NULL &&
+      vtable->bltarea == NULL)
+    {
+      return;
+    }
+
+  plane->swdev              = plane->dev;
+  plane->dev.setpixel       = nxbe_accel_setpixel;
+  plane->dev.fillrectangle  = nxbe_accel_fillrectangle;
+  plane->dev.getrectangle   = nxbe_accel_getrectangle;
+  plane->dev.filltrapezoid  = nxbe_accel_filltrapezoid;
+  plane->dev.moverectangle  = nxbe_accel_moverectangle;
+  plane->dev.copyrectangle  = nxbe_accel_copyrectangle;
+
+#ifdef CONFIG_NX_SWCURSOR
+  if (plane->cursor.draw != NULL)
+    {
+      plane->swcursor       = plane->cursor;
+      plane->cursor.draw    = nxbe_accel_cursor_draw;
+      plane->cursor.erase   = nxbe_accel_cursor_erase;
+      plane->cursor.backup  = nxbe_accel_cursor_backup;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: nxbe_accel_sync
+ *
+ * Description:
+ *   Wait until all the 2D engine operations queued on the plane have
+ *   completed.
+ *
+ ****************************************************************************/
+
+void nxbe_accel_sync(FAR struct nxbe_plane_s *plane)
+{
+  FAR struct fb_vtable_s *vtable = plane->driver;
+
+  if (plane->busy)
+    {
+      if (vtable->accelsync != NULL)
+        {
+          vtable->accelsync(vtable, plane->planeno);
+        }
+
+      plane->busy = false;
+    }
+}
+
+#endif /* CONFIG_NX_ACCEL */
@@ -290,6 +290,12 @@ int nxbe_configure(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be)
                i, be->plane[i].pinfo.bpp);
           return -ENOSYS;
         }
+
+#ifdef CONFIG_NX_ACCEL
+      /* Let the 2D engine of the driver do what it can */
+
+      nxbe_accel_configure(&be->plane[i], i);
+#endif
     }
 
   return OK;
@@ -28,6 +28,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <string.h>
 
 #include <nuttx/nx/nxglib.h>
 
@@ -105,52 +106,18 @@
 #  define NXGL_ALIGNUP(x)          (((x) + NXGL_PIXELMASK) & ~NXGL_PIXELMASK)
 
 #  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR uint8_t *_ptr = (FAR uint8_t*)(dest); \
-     int        _nby = NXGL_SCALEX(width); \
-     while (_nby--) \
-       { \
-         *_ptr++ = (value); \
-       } \
-   }
+   memset((dest), (value), NXGL_SCALEX(width))
 
 #  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR uint8_t *_dptr = (FAR uint8_t*)(dest); \
-     FAR uint8_t *_sptr = (FAR uint8_t*)(src); \
-     int        _nby  = NXGL_SCALEX(width); \
-     while (_nby--) \
-       { \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+   memmove((dest), (src), NXGL_SCALEX(width))
 
 #elif NXGLIB_BITSPERPIXEL == 24
 
 #  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR uint8_t *_ptr  = (FAR uint8_t*)(dest); \
-     nxgl_coord_t _npix = (width); \
-     while (_npix--) \
-       { \
-         *_ptr++ = (value); \
-         *_ptr++ = (value) >> 8; \
-         *_ptr++ = (value) >> 16; \
-       } \
-   }
+   nxgl_memset24((FAR uint8_t *)(dest), (value), (width))
 
 #  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR uint8_t *_dptr = (FAR uint8_t*)(dest); \
-     FAR uint8_t *_sptr = (FAR uint8_t*)(src); \
-     nxgl_coord_t _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-         *_dptr++ = *_sptr++; \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+   memmove((dest), (src), NXGL_SCALEX(width))
 
 #ifdef CONFIG_NX_ANTIALIASING
 
@@ -171,6 +138,10 @@
 #endif /* CONFIG_NX_ANTIALIASING */
 #else /* NXGLIB_BITSPERPIXEL == 16 || NXGLIB_BITSPERPIXEL == 32 */
 
+#if NXGLIB_BITSPERPIXEL == 16
+#  define NXGL_MEMSET(dest,value,width) \
+   nxgl_memset16((FAR uint16_t *)(dest), (value), (width))
+#else
 #  define NXGL_MEMSET(dest,value,width) \
    { \
      FAR NXGL_PIXEL_T *_ptr = (FAR NXGL_PIXEL_T*)(dest); \
@@ -180,17 +151,14 @@
          *_ptr++ = (value); \
        } \
    }
+#endif
+
+/* The source and destination runs may overlap when a rectangle is moved
+ * horizontally, so the copy must be done with memmove().
+ */
 
 #  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR NXGL_PIXEL_T *_dptr = (FAR NXGL_PIXEL_T*)(dest); \
-     FAR NXGL_PIXEL_T *_sptr = (FAR NXGL_PIXEL_T*)(src); \
-     nxgl_coord_t      _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+   memmove((dest), (src), NXGL_SCALEX(width))
 
 #ifdef CONFIG_NX_ANTIALIASING
 
@@ -226,6 +194,99 @@ extern "C"
  * Public Functions Definitions
  ****************************************************************************/
 
+#if NXGLIB_BITSPERPIXEL == 16
+/****************************************************************************
+ * Name: nxgl_memset16
+ *
+ * Description:
+ *   Fill a run of 16-bit pixels, two pixels per 32-bit store.
+ *
+ ****************************************************************************/
+
+static inline void nxgl_memset16(FAR uint16_t *dest, uint16_t value,
+                                 size_t npixels)
+{
+  FAR uint32_t *wptr;
+  uint32_t wide;
+
+  if (npixels > 0 && ((uintptr_t)dest & 3) != 0)
+    {
+      *dest++ = value;
+      npixels--;
+    }
+
+  wide = ((uint32_t)value << 16) | value;
+  wptr = (FAR uint32_t *)dest;
+
+  for (; npixels >= 2; npixels -= 2)
+    {
+      *wptr++ = wide;
+    }
+
+  if (npixels > 0)
+    {
+      *(FAR uint16_t *)wptr = value;
+    }
+}
+
+#elif NXGLIB_BITSPERPIXEL == 24
+/****************************************************************************
+ * Name: nxgl_memset24
+ *
+ * Description:
+ *   Fill a run of packed 24-bit pixels.  Once the destination is word
+ *   aligned, four pixels are written with three 32-bit stores.
+ *
+ ****************************************************************************/
+
+static inline void nxgl_memset24(FAR uint8_t *dest, uint32_t value,
+                                 size_t npixels)
+{
+  uint8_t b0 = (uint8_t)value;
+  uint8_t b1 = (uint8_t)(value >> 8);
+  uint8_t b2 = (uint8_t)(value >> 16);
+
+#ifndef CONFIG_ENDIAN_BIG
+  FAR uint32_t *wptr;
+  uint32_t w0;
+  uint32_t w1;
+  uint32_t w2;
+
+  while (npixels > 0 && ((uintptr_t)dest & 3) != 0)
+    {
+      *dest++ = b0;
+      *dest++ = b1;
+      *dest++ = b2;
+      npixels--;
+    }
+
+  w0 = b0 | ((uint32_t)b1 << 8) | ((uint32_t)b2 << 16) |
+       ((uint32_t)b0 << 24);
+  w1 = b1 | ((uint32_t)b2 << 8) | ((uint32_t)b0 << 16) |
+       ((uint32_t)b1 << 24);
+  w2 = b2 | ((uint32_t)b0 << 8) | ((uint32_t)b1 << 16) |
+       ((uint32_t)b2 << 24);
+  wptr = (FAR uint32_t *)dest;
+
+  for (; npixels >= 4; npixels -= 4)
+    {
+      *wptr++ = w0;
+      *wptr++ = w1;
+      *wptr++ = w2;
+    }
+
+  dest = (FAR uint8_t *)wptr;
+#endif
+
+  while (npixels-- > 0)
+    {
+      *dest++ = b0;
+      *dest++ = b1;
+      *dest++ = b2;
+    }
+}
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
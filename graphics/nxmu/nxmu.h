@@ -215,6 +215,20 @@ void nxmu_redrawreq(FAR struct nxbe_window_s *wnd,
 void nxmu_redraw(FAR struct nxbe_window_s *wnd,
                  FAR const struct nxgl_rect_s *rect);
 
+/****************************************************************************
+ * Name: nxmu_update
+ *
+ * Description:
+ *   The client modified a region of the per-window framebuffer directly.
+ *   Copy the region to the display.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_RAMBACKED
+void nxmu_update(FAR struct nxbe_window_s *wnd,
+                 FAR const struct nxgl_rect_s *rect);
+#endif
+
 /****************************************************************************
  * Name: nxmu_mouseinit
  *
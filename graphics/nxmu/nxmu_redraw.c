@@ -177,3 +177,35 @@ void nxmu_redraw(FAR struct nxbe_window_s *wnd,
         }
     }
 }
+
+/****************************************************************************
+ * Name: nxmu_update
+ *
+ * Description:
+ *   The client modified a region of the per-window framebuffer directly.
+ *   Copy the region to the display.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_RAMBACKED
+void nxmu_update(FAR struct nxbe_window_s *wnd,
+                 FAR const struct nxgl_rect_s *rect)
+{
+  struct nxgl_rect_s absrect;
+
+  if (!NXBE_ISRAMBACKED(wnd) || NXBE_ISHIDDEN(wnd))
+    {
+      return;
+    }
+
+  /* Convert to absolute coordinates and clip to the window */
+
+  nxgl_rectoffset(&absrect, rect, wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+  nxgl_rectintersect(&absrect, &absrect, &wnd->bounds);
+
+  if (!nxgl_nullrect(&absrect))
+    {
+      nxmu_redraw_pwfb(wnd, &absrect);
+    }
+}
+#endif
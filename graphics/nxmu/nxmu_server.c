@@ -572,6 +572,16 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
             }
             break;
 
+#ifdef CONFIG_NX_RAMBACKED
+          case NX_SVRMSG_UPDATE: /* Per-window framebuffer was modified */
+            {
+              FAR struct nxsvrmsg_update_s *updmsg =
+                (FAR struct nxsvrmsg_update_s *)buffer;
+              nxmu_update(updmsg->wnd, &updmsg->rect);
+            }
+            break;
+#endif
+
           /* Messages sent to the background window *************************/
 
           case NX_CLIMSG_REDRAW: /* Re-draw the background window */
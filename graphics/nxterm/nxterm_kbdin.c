@@ -64,7 +64,7 @@ static void nxterm_pollnotify(FAR struct nxterm_state_s *priv,
           fds->revents |= (fds->events & eventset);
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
 
@@ -501,6 +501,16 @@ void park_transform(FAR phase_angle_f32_t *angle, FAR ab_frame_f32_t *ab,
 void inv_park_transform(FAR phase_angle_f32_t *angle, FAR dq_frame_f32_t *dq,
                         FAR ab_frame_f32_t *ab);
 
+/* Multi-channel transformation functions */
+
+void clarke_transform_n(FAR abc_frame_f32_t *abc, FAR ab_frame_f32_t *ab,
+                        int n);
+void park_transform_n(FAR phase_angle_f32_t *angle, FAR ab_frame_f32_t *ab,
+                      FAR dq_frame_f32_t *dq, int n);
+void inv_park_transform_n(FAR phase_angle_f32_t *angle,
+                          FAR dq_frame_f32_t *dq, FAR ab_frame_f32_t *ab,
+                          int n);
+
 /* Phase angle related functions */
 
 void angle_norm(FAR float *angle, float per, float bottom, float top);
@@ -532,6 +542,12 @@ void foc_current_control(FAR struct foc_data_f32_s *foc,
 void foc_vabmod_get(FAR struct foc_data_f32_s *foc,
                     FAR ab_frame_f32_t *v_ab_mod);
 void foc_vdq_mag_max_get(FAR struct foc_data_f32_s *foc, FAR float *max);
+void foc_process_n(FAR struct foc_data_f32_s *foc,
+                   FAR phase_angle_f32_t *angle,
+                   FAR abc_frame_f32_t *i_abc,
+                   FAR dq_frame_f32_t *idq_ref,
+                   FAR dq_frame_f32_t *vdq_comp,
+                   FAR ab_frame_f32_t *v_ab_mod, int n);
 
 /* BLDC/PMSM motor observers */
 
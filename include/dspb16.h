@@ -491,6 +491,17 @@ void park_transform_b16(FAR phase_angle_b16_t *angle, FAR ab_frame_b16_t *ab,
 void inv_park_transform_b16(FAR phase_angle_b16_t *angle,
                             FAR dq_frame_b16_t *dq, FAR ab_frame_b16_t *ab);
 
+/* Multi-channel transformation functions */
+
+void clarke_transform_n_b16(FAR abc_frame_b16_t *abc,
+                            FAR ab_frame_b16_t *ab, int n);
+void park_transform_n_b16(FAR phase_angle_b16_t *angle,
+                          FAR ab_frame_b16_t *ab, FAR dq_frame_b16_t *dq,
+                          int n);
+void inv_park_transform_n_b16(FAR phase_angle_b16_t *angle,
+                              FAR dq_frame_b16_t *dq,
+                              FAR ab_frame_b16_t *ab, int n);
+
 /* Phase angle related functions */
 
 void angle_norm_b16(FAR b16_t *angle, b16_t per, b16_t bottom, b16_t top);
@@ -522,6 +533,12 @@ void foc_current_control_b16(FAR struct foc_data_b16_s *foc,
 void foc_vabmod_get_b16(FAR struct foc_data_b16_s *foc,
                         FAR ab_frame_b16_t *v_ab_mod);
 void foc_vdq_mag_max_get_b16(FAR struct foc_data_b16_s *foc, FAR b16_t *max);
+void foc_process_n_b16(FAR struct foc_data_b16_s *foc,
+                       FAR phase_angle_b16_t *angle,
+                       FAR abc_frame_b16_t *i_abc,
+                       FAR dq_frame_b16_t *idq_ref,
+                       FAR dq_frame_b16_t *vdq_comp,
+                       FAR ab_frame_b16_t *v_ab_mod, int n);
 
 /* BLDC/PMSM motor observers */
 
@@ -0,0 +1,67 @@
+/****************************************************************************
+ * include/net/net_tstamp.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NET_NET_TSTAMP_H
+#define __INCLUDE_NET_NET_TSTAMP_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <time.h>
+#include <sys/socket.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Flags of the SO_TIMESTAMPING socket option.  As with Linux, the RX_*
+ * flags select which timestamps are taken for received packets and the
+ * SOFTWARE and RAW_HARDWARE flags select which of those are reported in
+ * the SCM_TIMESTAMPING control message returned by recvmsg().
+ */
+
+#define SOF_TIMESTAMPING_TX_HARDWARE  (1 << 0)  /* Not supported yet */
+#define SOF_TIMESTAMPING_TX_SOFTWARE  (1 << 1)  /* Not supported yet */
+#define SOF_TIMESTAMPING_RX_HARDWARE  (1 << 2)  /* Take RX hardware stamps */
+#define SOF_TIMESTAMPING_RX_SOFTWARE  (1 << 3)  /* Take RX software stamps */
+#define SOF_TIMESTAMPING_SOFTWARE     (1 << 4)  /* Report software stamps */
+#define SOF_TIMESTAMPING_RAW_HARDWARE (1 << 6)  /* Report hardware stamps */
+
+#define SOF_TIMESTAMPING_MASK \
+  (SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RX_SOFTWARE | \
+   SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_RAW_HARDWARE)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Payload of the SCM_TIMESTAMPING control message.  ts[0] is the software
+ * timestamp (CLOCK_REALTIME when the stack received the packet), ts[2]
+ * the hardware timestamp from the PTP hardware clock of the interface.
+ * ts[1] is unused.  Timestamps that were not taken are zero.
+ */
+
+struct scm_timestamping
+{
+  struct timespec ts[3];
+};
+
+#endif /* __INCLUDE_NET_NET_TSTAMP_H */
@@ -26,6 +26,7 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -56,4 +57,40 @@
                                            * Argument: max retry count */
 #define TCP_MAXSEG    (__SO_PROTOCOL + 4) /* The maximum segment size */
 
+/* Congestion control algorithm.  Argument: name string */
+
+#define TCP_CONGESTION (__SO_PROTOCOL + 5)
+
+#define TCP_CORK      (__SO_PROTOCOL + 6) /* Only send full segments
+                                           * Argument: int */
+#define TCP_INFO      (__SO_PROTOCOL + 7) /* Connection information
+                                           * Argument: struct tcp_info */
+
+/* Maximum length of the name of a congestion control algorithm, including
+ * the NUL terminator
+ */
+
+#define TCP_CA_NAME_MAX 16
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Returned by getsockopt(TCP_INFO).  This is a subset of the Linux
+ * structure; the fields that exist have the same names and meaning.
+ */
+
+struct tcp_info
+{
+  uint8_t  tcpi_state;          /* TCP state (TCP_* of nuttx/net/tcp.h) */
+  uint8_t  tcpi_pad[3];
+  uint32_t tcpi_rto;            /* Retransmission timeout (usec) */
+  uint32_t tcpi_snd_mss;        /* Send MSS */
+  uint32_t tcpi_unacked;        /* Bytes sent but not yet ACKed */
+  uint32_t tcpi_snd_cwnd;       /* Congestion window (bytes), 0 if none */
+  uint32_t tcpi_segs_out;       /* Data segments sent */
+  uint64_t tcpi_bytes_sent;     /* Payload bytes sent, incl. rexmits */
+  uint32_t tcpi_notsent_bytes;  /* Bytes queued but not sent yet */
+};
+
 #endif /* __INCLUDE_NETINET_TCP_H */
@@ -28,6 +28,39 @@
 #include <nuttx/config.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* SOL_PACKET socket options */
+
+#define PACKET_RX_RING          5  /* Set up the receive ring, struct tpacket_req */
+#define PACKET_TX_RING          13 /* Set up the transmit ring, struct tpacket_req */
+
+/* Values of tp_status in the frames of the receive ring */
+
+#define TP_STATUS_KERNEL        0  /* The frame belongs to the kernel */
+#define TP_STATUS_USER          1  /* The frame holds a packet for the user */
+#define TP_STATUS_LOSING        4  /* Packets were dropped before this one */
+
+/* Values of tp_status in the frames of the transmit ring */
+
+#define TP_STATUS_AVAILABLE     0  /* The frame may be filled by the user */
+#define TP_STATUS_SEND_REQUEST  1  /* The frame holds a packet to send */
+#define TP_STATUS_SENDING       2  /* The kernel is sending the packet */
+#define TP_STATUS_WRONG_FORMAT  4  /* The packet could not be sent */
+
+/* Each frame of a ring starts with a struct tpacket_hdr followed by a
+ * struct sockaddr_ll.  Received packets start at tp_mac, packets to send
+ * start at TPACKET_HDRLEN - sizeof(struct sockaddr_ll).
+ */
+
+#define TPACKET_ALIGNMENT       16
+#define TPACKET_ALIGN(x) \
+  (((x) + TPACKET_ALIGNMENT - 1) & ~(TPACKET_ALIGNMENT - 1))
+#define TPACKET_HDRLEN \
+  (TPACKET_ALIGN(sizeof(struct tpacket_hdr)) + sizeof(struct sockaddr_ll))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -39,4 +72,32 @@ struct sockaddr_ll
   int16_t  sll_ifindex;
 };
 
+/* Argument of the PACKET_RX_RING and PACKET_TX_RING options.  The ring
+ * consists of tp_block_nr blocks of tp_block_size bytes, each holding
+ * tp_block_size / tp_frame_size frames.  A tp_frame_nr of zero removes
+ * the ring.  The rings are then mapped with mmap(), the receive ring
+ * first.
+ */
+
+struct tpacket_req
+{
+  unsigned int tp_block_size;  /* Minimal size of contiguous block */
+  unsigned int tp_block_nr;    /* Number of blocks */
+  unsigned int tp_frame_size;  /* Size of frame */
+  unsigned int tp_frame_nr;    /* Total number of frames */
+};
+
+/* The header at the start of each frame of a ring */
+
+struct tpacket_hdr
+{
+  unsigned long  tp_status;    /* See TP_STATUS_* definitions */
+  unsigned int   tp_len;       /* Length of the packet */
+  unsigned int   tp_snaplen;   /* Length of the packet in the frame */
+  unsigned short tp_mac;       /* Offset of the link layer header */
+  unsigned short tp_net;       /* Offset of the network header */
+  unsigned int   tp_sec;       /* Receive time */
+  unsigned int   tp_usec;
+};
+
 #endif /* __INCLUDE_NETPACKET_PACKET_H */
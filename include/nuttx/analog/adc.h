@@ -32,8 +32,10 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/mm/circbuf.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spi/spi.h>
 #include <nuttx/i2c/i2c_master.h>
@@ -58,6 +60,10 @@
 #  define CONFIG_ADC_NPOLLWAITERS 2
 #endif
 
+#if defined(CONFIG_ADC_STREAM) && !defined(CONFIG_ADC_STREAM_BUFSIZE)
+#  define CONFIG_ADC_STREAM_BUFSIZE 8192
+#endif
+
 #define ADC_RESET(dev)         ((dev)->ad_ops->ao_reset((dev)))
 #define ADC_SETUP(dev)         ((dev)->ad_ops->ao_setup((dev)))
 #define ADC_SHUTDOWN(dev)      ((dev)->ad_ops->ao_shutdown((dev)))
@@ -101,6 +107,25 @@ struct adc_callback_s
    */
 
   CODE int (*au_reset)(FAR struct adc_dev_s *dev);
+
+#ifdef CONFIG_ADC_STREAM
+  /* This method is called from the lower half, platform-specific ADC logic
+   * in streaming mode when a block of samples is complete, typically on
+   * the DMA half and full transfer interrupts.
+   *
+   * Input Parameters:
+   *   dev    - The ADC device structure that was previously registered by
+   *            adc_register()
+   *   data   - The raw samples, in the format of the lower half
+   *   nbytes - The size of the block in bytes
+   *
+   * Returned Value:
+   *   Zero on success; a negated errno value if the block was dropped.
+   */
+
+  CODE int (*au_receive_block)(FAR struct adc_dev_s *dev,
+                               FAR const void *data, size_t nbytes);
+#endif
 };
 
 /* This describes on ADC message */
@@ -111,6 +136,19 @@ begin_packed_struct struct adc_msg_s
   int32_t      am_data;                  /* ADC convert result (4 bytes) */
 } end_packed_struct;
 
+#ifdef CONFIG_ADC_STREAM
+/* In streaming mode read() returns whole blocks, each one this header
+ * followed by ab_nbytes bytes of raw samples.
+ */
+
+struct adc_block_s
+{
+  uint32_t        ab_seqno;              /* Block number, a gap means dropped blocks */
+  uint32_t        ab_nbytes;             /* Size of the samples that follow */
+  struct timespec ab_time;               /* Time the block was completed */
+};
+#endif
+
 /* This describes a FIFO of ADC messages */
 
 struct adc_fifo_s
@@ -192,6 +230,11 @@ struct adc_dev_s
   sem_t                       ad_recvsem;    /* Used to wakeup user waiting for space in ad_recv.buffer */
   struct adc_fifo_s           ad_recv;       /* Describes receive FIFO */
   bool                        ad_isovr;      /* Flag to indicate an ADC overrun */
+#ifdef CONFIG_ADC_STREAM
+  bool                        ad_streaming;  /* Blocks are received in ad_stream */
+  uint32_t                    ad_seqno;      /* Number of the next block */
+  struct circbuf_s            ad_stream;     /* Receive buffer of blocks */
+#endif
 
   /* The following is a list of poll structures of threads waiting for
    * driver events.  The 'struct pollfd' reference for each open is also
@@ -104,6 +104,20 @@
 #define AN_MCP48XX_FIRST (AN_MAX1161X_FIRST + AN_MAX1161X_NCMDS)
 #define AN_MCP48XX_NCMDS 3
 
+/* Common commands added after the lower-half ranges were allocated.  They
+ * are numbered after the last range so that the existing commands keep
+ * their numbers.
+ */
+
+#define AN_EXT_FIRST      (AN_MCP48XX_FIRST + AN_MCP48XX_NCMDS)
+#define AN_EXT_NCMDS      1
+
+#define ANIOC_STREAM      _ANIOC(AN_EXT_FIRST)  /* Enable or disable the
+                                                 * streaming of sample
+                                                 * blocks
+                                                 * IN: true or false
+                                                 * OUT: None */
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
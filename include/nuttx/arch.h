@@ -1517,6 +1517,27 @@ void up_trigger_irq(int irq);
 int up_prioritize_irq(int irq, int priority);
 #endif
 
+/****************************************************************************
+ * Name: up_affinity_irq
+ *
+ * Description:
+ *   Route an IRQ to the set of CPUs in 'cpuset'.  The interrupt controller
+ *   may deliver it to any one of them.  Use irq_set_affinity() instead of
+ *   calling this directly so that the OS knows about the routing.
+ *
+ * Input Parameters:
+ *   irq    - The IRQ number
+ *   cpuset - The set of CPUs that may service the IRQ
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the IRQ can't be routed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+int up_affinity_irq(int irq, cpu_set_t cpuset);
+#endif
+
 #ifdef CONFIG_ARCH_HAVE_TRUSTZONE
 
 /****************************************************************************
@@ -1573,6 +1594,10 @@ void up_timer_initialize(void);
  *   int up_alarm_cancel(void):  Cancel the alarm.
  *   int up_alarm_start(FAR const struct timespec *ts): Enable (or re-anable
  *     the alarm.
+ *   int up_cpu_alarm_cancel(void) and
+ *   int up_cpu_alarm_start(FAR const struct timespec *ts):  The same for
+ *     the local alarm of each CPU if CONFIG_SCHED_TICKLESS_PERCPU is
+ *     defined.
  * #else
  *   int up_timer_cancel(void):  Cancels the interval timer.
  *   int up_timer_start(FAR const struct timespec *ts): Start (or re-starts)
@@ -1585,6 +1610,9 @@ void up_timer_initialize(void);
  * #ifdef CONFIG_SCHED_TICKLESS_ALARM
  *   void nxsched_alarm_expiration(FAR const struct timespec *ts):  Called
  *     by the platform-specific logic when the alarm expires.
+ *   void nxsched_cpu_alarm_expiration(FAR const struct timespec *ts):
+ *     Called on the CPU whose local alarm expired if
+ *     CONFIG_SCHED_TICKLESS_PERCPU is defined.
  * #else
  *   void nxsched_timer_expiration(void):  Called by the platform-specific
  *     logic when the interval timer expires.
@@ -1701,6 +1729,34 @@ int up_alarm_cancel(FAR struct timespec *ts);
 int up_alarm_start(FAR const struct timespec *ts);
 #endif
 
+/****************************************************************************
+ * Name: up_cpu_alarm_start and up_cpu_alarm_cancel
+ *
+ * Description:
+ *   Start or cancel the local alarm of the calling CPU.  When the local
+ *   alarm occurs, nxsched_cpu_alarm_expiration() must be called on the
+ *   same CPU.  The local alarm is used to time the time slice of the task
+ *   running on the CPU; it uses the same time base as up_timer_gettime().
+ *
+ *   Provided by platform-specific code and called from the RTOS base code.
+ *
+ * Input Parameters:
+ *   ts - The time in the future at the alarm is expected to occur.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled on the calling CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+int up_cpu_alarm_start(FAR const struct timespec *ts);
+int up_cpu_alarm_cancel(void);
+#endif
+
 /****************************************************************************
  * Name: up_timer_cancel
  *
@@ -2241,6 +2297,31 @@ void nxsched_timer_expiration(void);
 void nxsched_alarm_expiration(FAR const struct timespec *ts);
 #endif
 
+/****************************************************************************
+ * Name:  nxsched_cpu_alarm_expiration
+ *
+ * Description:
+ *   If CONFIG_SCHED_TICKLESS_PERCPU is defined, then this function is
+ *   provided by the RTOS base code and called from platform-specific code
+ *   on the CPU whose local alarm, started with up_cpu_alarm_start(),
+ *   expired.
+ *
+ * Input Parameters:
+ *   ts - The time that the alarm expired
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions/Limitations:
+ *   Base code implementation assumes that this function is called from
+ *   interrupt handling logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+void nxsched_cpu_alarm_expiration(FAR const struct timespec *ts);
+#endif
+
 /****************************************************************************
  * Name: nxsched_process_cpuload
  *
@@ -2613,6 +2694,32 @@ uint32_t up_perf_gettime(void);
 uint32_t up_perf_getfreq(void);
 void up_perf_convert(uint32_t elapsed, FAR struct timespec *ts);
 
+/****************************************************************************
+ * Name: up_pmu_*
+ *
+ * Description:
+ *   Access to the hardware event counters of the current CPU, used by the
+ *   per-task performance counters (CONFIG_SCHED_PMU).  Counters are
+ *   numbered from 0 to up_pmu_ncounters() - 1 and are independent from
+ *   the cycle counter that is used by up_perf_gettime().
+ *
+ *   up_pmu_config() selects the event counted by a counter; the event is
+ *   one of the PMU_EVENT_* definitions of include/nuttx/pmu.h, either a
+ *   generic event or a raw, architecture-specific event number.
+ *   PMU_EVENT_NONE stops the counter.  It returns the width of the counter
+ *   in bits, or -ENOTSUP if the event can not be counted by this CPU.
+ *
+ *   up_pmu_read() returns the current value of a counter.  Only the
+ *   difference between two values is meaningful.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PMU
+int up_pmu_ncounters(void);
+int up_pmu_config(int counter, uint32_t event);
+uint32_t up_pmu_read(int counter);
+#endif
+
 /****************************************************************************
  * Name: up_saveusercontext
  *
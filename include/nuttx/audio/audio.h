@@ -93,6 +93,12 @@
  * AUDIOIOC_STOP - Stop Audio streaming
  *
  *   ioctl argument:  None
+ *
+ * AUDIOIOC_GETSTATS - Get the buffer statistics of the stream
+ *
+ *   ioctl argument:  Pointer to the audio_stats_s structure to receive the
+ *                    statistics.  The counters are cleared each time the
+ *                    stream is started.
  */
 
 #define AUDIOIOC_GETCAPS            _AUDIOIOC(1)
@@ -112,6 +118,7 @@
 #define AUDIOIOC_UNREGISTERMQ       _AUDIOIOC(15)
 #define AUDIOIOC_HWRESET            _AUDIOIOC(16)
 #define AUDIOIOC_SETBUFFERINFO      _AUDIOIOC(17)
+#define AUDIOIOC_GETSTATS           _AUDIOIOC(18)
 
 /* Audio Device Types *******************************************************/
 
@@ -401,6 +408,22 @@ struct ap_buffer_info_s
   apb_samp_t  buffer_size;  /* Preferred size of the buffers */
 };
 
+/* This structure is returned by AUDIOIOC_GETSTATS.  An xrun (an underrun
+ * on output, an overrun on input) is counted each time the lower half
+ * returns a buffer while no other buffer is queued, so that the stream
+ * stalls until the client enqueues the next one.  minqueued tells how
+ * close the client came to an xrun and is the figure to watch when the
+ * period size or count is reduced for lower latency.
+ */
+
+struct audio_stats_s
+{
+  uint32_t    nperiods;     /* Buffers returned by the lower half */
+  uint32_t    nxruns;       /* Times the lower half ran out of buffers */
+  uint16_t    nqueued;      /* Buffers currently held by the lower half */
+  uint16_t    minqueued;    /* Fewest buffers left queued at a dequeue */
+};
+
 /* This structure describes an Audio Pipeline Buffer */
 
 struct ap_buffer_s
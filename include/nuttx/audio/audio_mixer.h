@@ -0,0 +1,78 @@
+/****************************************************************************
+ * include/nuttx/audio/audio_mixer.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_AUDIO_AUDIO_MIXER_H
+#define __INCLUDE_NUTTX_AUDIO_AUDIO_MIXER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#ifdef CONFIG_AUDIO_MIXER
+#include <nuttx/audio/audio.h>
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: audio_mixer_initialize
+ *
+ * Description:
+ *   Create a software mixer in front of an audio output device.  The
+ *   mixer returns 'ninputs' new audio lower halves.  Each of them accepts
+ *   8 or 16-bit mono or stereo PCM at any sample rate, with its own volume
+ *   control.  The inputs are resampled to CONFIG_AUDIO_MIXER_SAMPRATE,
+ *   summed with saturation and played as 16-bit PCM on the output device.
+ *
+ *   The inputs may be registered with audio_register() directly or be
+ *   wrapped by a decoder such as pcm_decode_initialize() first.
+ *
+ * Input Parameters:
+ *   lower   - The output device.  It becomes owned by the mixer.
+ *   inputs  - The array that receives the new mixer inputs.
+ *   ninputs - The number of inputs to create.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int audio_mixer_initialize(FAR struct audio_lowerhalf_s *lower,
+                           FAR struct audio_lowerhalf_s **inputs,
+                           int ninputs);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_AUDIO_MIXER */
+#endif /* __INCLUDE_NUTTX_AUDIO_AUDIO_MIXER_H */
@@ -196,6 +196,11 @@ int unregister_binfmt(FAR struct binfmt_s *binfmt);
  * Description:
  *   This function for generating core dump stream.
  *
+ *   regions is terminated by an entry with an empty range.  If it is NULL,
+ *   only the stacks of the tasks are dumped.  The stream may be one of the
+ *   compressing streams, e.g. lib_lz4outstream on top of
+ *   lib_mtdoutstream, to reduce the amount of data to write.
+ *
  * Returned Value:
  *   This is a NuttX internal function so it follows the convention that
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -249,6 +254,8 @@ int unload_module(FAR struct binary_s *bin);
  *
  * Description:
  *   Execute a module that has been loaded into memory by load_module().
+ *   If 'actions' is not NULL, the spawn file actions are performed on the
+ *   file list of the new task before it is activated.
  *
  * Returned Value:
  *   This is a NuttX internal function so it follows the convention that
@@ -259,7 +266,8 @@ int unload_module(FAR struct binary_s *bin);
 
 int exec_module(FAR const struct binary_s *binp,
                 FAR const char *filename, FAR char * const *argv,
-                FAR char * const *envp);
+                FAR char * const *envp,
+                FAR const posix_spawn_file_actions_t *actions);
 
 /****************************************************************************
  * Name: exec
@@ -350,6 +358,7 @@ int exec(FAR const char *filename, FAR char * const *argv,
  *              exported by the caller and made available for linking the
  *              module into the system.
  *   nexports - The number of symbols in the exports table.
+ *   actions  - The spawn file actions
  *   attr     - The spawn attributes.
  *
  * Returned Value:
@@ -361,7 +370,8 @@ int exec(FAR const char *filename, FAR char * const *argv,
 
 int exec_spawn(FAR const char *filename, FAR char * const *argv,
                FAR char * const *envp, FAR const struct symtab_s *exports,
-               int nexports, FAR const posix_spawnattr_t *attr);
+               int nexports, FAR const posix_spawn_file_actions_t *actions,
+               FAR const posix_spawnattr_t *attr);
 
 /****************************************************************************
  * Name: binfmt_exit
@@ -104,6 +104,12 @@ struct elf_loadinfo_s
   FAR Elf_Shdr      *shdr;       /* Buffered ELF section headers */
   uint8_t           *iobuffer;   /* File I/O buffer */
 
+#if defined(CONFIG_ELF_READAHEAD_SIZE) && CONFIG_ELF_READAHEAD_SIZE > 0
+  FAR uint8_t       *rabuffer;   /* Read-ahead buffer */
+  off_t              raoffset;   /* File offset of rabuffer[0] */
+  size_t             ralen;      /* Number of valid bytes in rabuffer[] */
+#endif
+
   /* Constructors and destructors */
 
 #ifdef CONFIG_BINFMT_CONSTRUCTORS
@@ -383,6 +383,93 @@ int board_boot_image(FAR const char *path, uint32_t hdr_size);
 void board_timerhook(void);
 #endif
 
+/****************************************************************************
+ * Name: latencytest_main
+ *
+ * Description:
+ *   If CONFIG_BOARD_LATENCYTEST is selected, this measures the wakeup
+ *   latencies and the context switch cost of the scheduler and prints the
+ *   results.  It has the signature of a main() function so that it may be
+ *   used as CONFIG_INIT_ENTRYPOINT.  Run it with -h for its options.
+ *
+ * Input Parameters:
+ *   argc, argv - The command line options
+ *
+ * Returned Value:
+ *   EXIT_SUCCESS, or EXIT_FAILURE if the options are invalid.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_BOARD_LATENCYTEST
+int latencytest_main(int argc, FAR char *argv[]);
+#endif
+
+/****************************************************************************
+ * Name: netbench_main
+ *
+ * Description:
+ *   If CONFIG_BOARD_NETBENCH is selected, this measures the throughput,
+ *   the latency and the connection rate of the network stack and prints
+ *   the results.  It has the signature of a main() function so that it may
+ *   be used as CONFIG_INIT_ENTRYPOINT.  Run it with -h for its options.
+ *
+ * Input Parameters:
+ *   argc, argv - The command line options
+ *
+ * Returned Value:
+ *   EXIT_SUCCESS, or EXIT_FAILURE if the options are invalid or a test
+ *   failed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_BOARD_NETBENCH
+int netbench_main(int argc, FAR char *argv[]);
+#endif
+
+/****************************************************************************
+ * Name: fsbench_main
+ *
+ * Description:
+ *   If CONFIG_BOARD_FSBENCH is selected, this measures the throughput and
+ *   the latency of the file system mounted on a directory and prints the
+ *   results.  It has the signature of a main() function so that it may be
+ *   used as CONFIG_INIT_ENTRYPOINT.  Run it with -h for its options.
+ *
+ * Input Parameters:
+ *   argc, argv - The command line options
+ *
+ * Returned Value:
+ *   EXIT_SUCCESS, or EXIT_FAILURE if the options are invalid or a test
+ *   failed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_BOARD_FSBENCH
+int fsbench_main(int argc, FAR char *argv[]);
+#endif
+
+/****************************************************************************
+ * Name: mmbench_main
+ *
+ * Description:
+ *   If CONFIG_BOARD_MMBENCH is selected, this measures the latency of the
+ *   heap allocator and the fragmentation of the heap and prints the
+ *   results.  It has the signature of a main() function so that it may be
+ *   used as CONFIG_INIT_ENTRYPOINT.  Run it with -h for its options.
+ *
+ * Input Parameters:
+ *   argc, argv - The command line options
+ *
+ * Returned Value:
+ *   EXIT_SUCCESS, or EXIT_FAILURE if the options are invalid or a test
+ *   failed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_BOARD_MMBENCH
+int mmbench_main(int argc, FAR char *argv[]);
+#endif
+
 /****************************************************************************
  * Name:  board_<usbdev>_initialize
  *
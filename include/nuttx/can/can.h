@@ -32,6 +32,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <time.h>
+#include <sys/time.h>
 
 #include <nuttx/list.h>
 #include <nuttx/fs/fs.h>
@@ -215,6 +216,23 @@
  *                   is returned with the errno variable set to indicate the
  *                   nature of the error.
  *   Dependencies:   None
+ *
+ * CANIOC_ADD_RDFILTER:
+ *   Description:    Add a software filter to this open file.  Only the
+ *                   messages that match one of the filters of a file are
+ *                   queued for it; a file without filters gets all
+ *                   messages.  Error reports are never filtered.
+ *   Argument:       A pointer to an instance of struct canioc_rdfilter_s
+ *   Returned Value: Zero (OK) is returned on success.  Otherwise -1 (ERROR)
+ *                   is returned with the errno variable set to indicate the
+ *                   nature of the error (ENOSPC if all filters are in use).
+ *   Dependencies:   Requires CONFIG_CAN_READER_FILTERS=y
+ *
+ * CANIOC_CLR_RDFILTERS:
+ *   Description:    Remove all software filters of this open file
+ *   Argument:       None
+ *   Returned Value: Zero (OK) is returned on success.
+ *   Dependencies:   Requires CONFIG_CAN_READER_FILTERS=y
  */
 
 #define CANIOC_RTR                _CANIOC(1)
@@ -231,7 +249,19 @@
 #define CANIOC_SET_ABOM           _CANIOC(12)
 
 #define CAN_FIRST                 0x0001         /* First common command */
-#define CAN_NCMDS                 12             /* Ten common commands */
+#define CAN_NCMDS                 12             /* Twelve common commands */
+
+/* Common commands added after the lower-half ranges were allocated.  They
+ * are numbered down from the top of the command space so that the ranges
+ * that start at CAN_FIRST + CAN_NCMDS keep their numbers.  Lower-half
+ * ranges must end below CAN_EXT_FIRST.
+ */
+
+#define CAN_EXT_FIRST             0x00f0         /* First added command */
+#define CAN_EXT_NCMDS             2              /* Two added commands */
+
+#define CANIOC_ADD_RDFILTER       _CANIOC(CAN_EXT_FIRST + 0)
+#define CANIOC_CLR_RDFILTERS      _CANIOC(CAN_EXT_FIRST + 1)
 
 /* User defined ioctl commands are also supported. These will be forwarded
  * by the upper-half CAN driver to the lower-half CAN driver via the co_ioctl()
@@ -461,6 +491,9 @@ begin_packed_struct struct can_hdr_s
   uint8_t      ch_esi    : 1; /* Error State Indicator */
 #endif
   uint8_t      ch_unused : 1; /* FIXME: This field is useless, kept for backward compatibility */
+#ifdef CONFIG_CAN_TIMESTAMP
+  struct timeval ch_ts;       /* RX timestamp, from the hardware if available */
+#endif
 } end_packed_struct;
 
 #else
@@ -478,6 +511,9 @@ begin_packed_struct struct can_hdr_s
   uint8_t      ch_esi    : 1; /* Error State Indicator */
 #endif
   uint8_t      ch_unused : 1; /* FIXME: This field is useless, kept for backward compatibility */
+#ifdef CONFIG_CAN_TIMESTAMP
+  struct timeval ch_ts;       /* RX timestamp, from the hardware if available */
+#endif
 } end_packed_struct;
 #endif
 
@@ -601,10 +637,27 @@ struct can_ops_s
  * The common logic will initialize all semaphores.
  */
 
+#ifdef CONFIG_CAN_READER_FILTERS
+/* CANIOC_ADD_RDFILTER: A message matches if (ID & rf_mask) equals
+ * (rf_id & rf_mask) and, with CONFIG_CAN_EXTID, the ID kind is the same.
+ */
+
+struct canioc_rdfilter_s
+{
+  uint32_t              rf_id;           /* The ID to match */
+  uint32_t              rf_mask;         /* The ID bits to compare */
+  uint8_t               rf_extid;        /* 1=match extended IDs */
+};
+#endif
+
 struct can_reader_s
 {
   struct list_node     list;
   struct can_rxfifo_s  fifo;             /* Describes receive FIFO */
+#ifdef CONFIG_CAN_READER_FILTERS
+  uint8_t              nfilters;         /* Number of filters in use */
+  struct canioc_rdfilter_s filters[CONFIG_CAN_NREADER_FILTERS];
+#endif
 };
 
 struct can_dev_s
@@ -219,6 +219,44 @@ typedef int64_t sclock_t;
 typedef int32_t sclock_t;
 #endif
 
+/* This structure holds the copy of the kernel time that is published to
+ * user space when CONFIG_CLOCK_VDSO is selected.  The kernel makes seq odd
+ * while it updates the other fields; readers retry until they sample the
+ * same even value of seq before and after reading the time.
+ */
+
+#ifdef CONFIG_CLOCK_VDSO
+struct clock_vdso_s
+{
+  volatile uint32_t seq;       /* Sequence counter, odd while updating */
+  volatile clock_t  ticks;     /* Copy of the system timer */
+  volatile time_t   base_sec;  /* Copy of the time-of-day base time */
+  volatile long     base_nsec;
+};
+#endif
+
+/* A free-running hardware counter registered with clocksource_register().
+ * The driver provides read() and mask, the width of the counter; the
+ * remaining fields are set up at registration and convert counter cycles
+ * to nanoseconds as ns = (cycles * mult) >> shift.
+ */
+
+#ifdef CONFIG_CLOCKSOURCE
+struct clocksource_s
+{
+  CODE uint64_t (*read)(FAR const struct clocksource_s *cs);
+  uint64_t mask;               /* Mask of the valid counter bits */
+  FAR const char *name;        /* Name of the counter, for debug output */
+
+  /* Set up by clocksource_register() */
+
+  uint32_t freq;               /* Frequency of the counter in Hz */
+  uint32_t mult;               /* Cycle to nanosecond multiplier */
+  uint32_t shift;              /* ... and shift */
+  uint64_t maxcycles;          /* Cycles that can be converted at once */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -247,6 +285,14 @@ EXTERN volatile clock_t g_system_timer;
 #endif
 #endif
 
+/* The instance of the published kernel time.  It lives in the user-space
+ * blob and the kernel finds it through struct userspace_s.
+ */
+
+#if defined(CONFIG_CLOCK_VDSO) && !defined(__KERNEL__)
+EXTERN struct clock_vdso_s g_clock_vdso;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -458,6 +504,49 @@ int clock_ticks2time(sclock_t ticks, FAR struct timespec *reltime);
 
 int clock_systime_timespec(FAR struct timespec *ts);
 
+/****************************************************************************
+ * Name: clocksource_register
+ *
+ * Description:
+ *   Make a free-running counter the time source of CLOCK_MONOTONIC and
+ *   CLOCK_MONOTONIC_RAW.  The counter must keep running from then on; it
+ *   may wrap as given by cs->mask.  The clock continues from the current
+ *   value of the system timer, so that the clocks do not jump.
+ *
+ * Input Parameters:
+ *   cs   - The counter.  read and mask must be set, the rest is set up
+ *          here.  It must not be freed.
+ *   freq - The frequency of the counter in Hz.
+ *
+ * Returned Value:
+ *   OK (0) on success; -EINVAL if the counter cannot be used.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CLOCKSOURCE
+int clocksource_register(FAR struct clocksource_s *cs, uint32_t freq);
+#endif
+
+/****************************************************************************
+ * Name: clocksource_gettime
+ *
+ * Description:
+ *   Return the time since power up with the resolution of the registered
+ *   counter.  This takes no lock and may be called from any context,
+ *   interrupt handlers included.
+ *
+ * Input Parameters:
+ *   ts - Location to return the time
+ *
+ * Returned Value:
+ *   OK (0) on success; -ENODEV if no counter has been registered.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CLOCKSOURCE
+int clocksource_gettime(FAR struct timespec *ts);
+#endif
+
 /****************************************************************************
  * Name:  clock_cpuload
  *
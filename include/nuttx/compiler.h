@@ -185,6 +185,10 @@
 #  define inline_function __attribute__ ((always_inline,no_instrument_function))
 #  define noinline_function __attribute__ ((noinline))
 
+/* Return the address that the current function (x == 0) will return to */
+
+#  define return_address(x) __builtin_return_address(x)
+
 /* The noinstrument_function attribute informs GCC don't instrument it */
 
 #  define noinstrument_function __attribute__ ((no_instrument_function))
@@ -457,6 +461,7 @@
 
 #  define inline_function
 #  define noinline_function
+#  define return_address(x) 0
 #  define noinstrument_function
 #  define nostackprotect_function
 
@@ -588,6 +593,7 @@
 #  define naked_function
 #  define inline_function
 #  define noinline_function
+#  define return_address(x) 0
 #  define noinstrument_function
 #  define nostackprotect_function
 #  define unused_code
@@ -688,6 +694,7 @@
 #  define naked_function
 #  define inline_function
 #  define noinline_function
+#  define return_address(x) 0
 #  define noinstrument_function
 #  define nostackprotect_function
 #  define unused_code
@@ -754,6 +761,7 @@
 #  define naked_function
 #  define inline_function
 #  define noinline_function
+#  define return_address(x) 0
 #  define noinstrument_function
 #  define nostackprotect_function
 #  define unused_code
@@ -42,6 +42,7 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /****************************************************************************
@@ -164,6 +165,22 @@ void aes_encipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
                   int nblk);
 
+/****************************************************************************
+ * Name: aes_ctr_crypt
+ *
+ * Description:
+ *   Encrypt or decrypt a buffer in CTR mode using the previously defined
+ *   key.  The 16-byte counter block is incremented (as a 128-bit big-endian
+ *   number) for every block and the updated value is returned in ctr.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aes_ctr_crypt(FAR struct aes_state_s *state, FAR uint8_t *ctr,
+                   FAR uint8_t *out, FAR const uint8_t *in, size_t len);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
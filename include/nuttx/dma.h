@@ -0,0 +1,208 @@
+/****************************************************************************
+ * include/nuttx/dma.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_DMA_H
+#define __INCLUDE_NUTTX_DMA_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef CONFIG_DMA_MAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Cache maintenance works on whole lines.  DMA buffers that share a line
+ * with other data must be avoided for DMA_FROM_DEVICE transfers, since the
+ * invalidation after the transfer would discard CPU writes to that data.
+ * Buffers allocated with DMA_ALIGN and sizes rounded up with DMA_ALIGN_UP()
+ * are always safe.
+ */
+
+#ifdef CONFIG_ARCH_DCACHE
+#  define DMA_ALIGN           CONFIG_DMA_CACHE_LINESIZE
+#else
+#  define DMA_ALIGN           sizeof(uintptr_t)
+#endif
+
+#define DMA_ALIGN_MASK        (DMA_ALIGN - 1)
+#define DMA_ALIGN_UP(n)       (((n) + DMA_ALIGN_MASK) & ~DMA_ALIGN_MASK)
+#define DMA_ALIGN_DOWN(n)     ((n) & ~DMA_ALIGN_MASK)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The direction of a DMA transfer, seen from memory */
+
+enum dma_direction_e
+{
+  DMA_TO_DEVICE = 0,          /* The device reads the buffer */
+  DMA_FROM_DEVICE,            /* The device writes the buffer */
+  DMA_BIDIRECTIONAL           /* Both */
+};
+
+/* One entry of a scatter-gather list */
+
+struct dma_sg_s
+{
+  FAR void *addr;             /* CPU address of the segment */
+  size_t len;                 /* Length of the segment in bytes */
+  uintptr_t dmaaddr;          /* Device address, set by dma_map_sg() */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: dma_aligned
+ *
+ * Description:
+ *   Return true if the buffer starts and ends on cache line boundaries, so
+ *   that it can be used for a DMA_FROM_DEVICE transfer without disturbing
+ *   the data around it.  Always true if there is no data cache.
+ *
+ ****************************************************************************/
+
+bool dma_aligned(FAR const void *addr, size_t len);
+
+/****************************************************************************
+ * Name: dma_sync_for_device
+ *
+ * Description:
+ *   Give the buffer to the device:  Write back the CPU's modifications for
+ *   DMA_TO_DEVICE; write back and discard the cached lines otherwise, so
+ *   that no dirty line can be evicted over the data written by the device.
+ *
+ * Input Parameters:
+ *   addr - The start of the buffer
+ *   len  - The length of the buffer in bytes
+ *   dir  - The direction of the transfer
+ *
+ ****************************************************************************/
+
+void dma_sync_for_device(FAR const void *addr, size_t len,
+                         enum dma_direction_e dir);
+
+/****************************************************************************
+ * Name: dma_sync_for_cpu
+ *
+ * Description:
+ *   Give the buffer back to the CPU after the device is done with it:
+ *   Discard the cached lines for DMA_FROM_DEVICE or DMA_BIDIRECTIONAL so
+ *   that the CPU reads what the device wrote.  Nothing to do for
+ *   DMA_TO_DEVICE.
+ *
+ * Input Parameters:
+ *   addr - The start of the buffer
+ *   len  - The length of the buffer in bytes
+ *   dir  - The direction of the transfer
+ *
+ ****************************************************************************/
+
+void dma_sync_for_cpu(FAR const void *addr, size_t len,
+                      enum dma_direction_e dir);
+
+/****************************************************************************
+ * Name: dma_map_single, dma_unmap_single
+ *
+ * Description:
+ *   Map a buffer for one DMA transfer and unmap it when the transfer is
+ *   complete.  dma_map_single() returns the address to program into the
+ *   DMA controller.
+ *
+ ****************************************************************************/
+
+uintptr_t dma_map_single(FAR void *addr, size_t len,
+                         enum dma_direction_e dir);
+void dma_unmap_single(FAR void *addr, size_t len,
+                      enum dma_direction_e dir);
+
+/****************************************************************************
+ * Name: dma_map_sg, dma_unmap_sg
+ *
+ * Description:
+ *   Map and unmap each segment of a scatter-gather list.  dma_map_sg()
+ *   sets the dmaaddr of each segment and returns the number of segments.
+ *
+ ****************************************************************************/
+
+int dma_map_sg(FAR struct dma_sg_s *sg, int nents,
+               enum dma_direction_e dir);
+void dma_unmap_sg(FAR struct dma_sg_s *sg, int nents,
+                  enum dma_direction_e dir);
+
+/****************************************************************************
+ * Name: dma_coherent_initialize
+ *
+ * Description:
+ *   Provide the memory of the coherent DMA pool.  The board logic must
+ *   configure this region as non-cacheable (e.g. with the MPU) before the
+ *   call.  Memory from this pool needs no cache maintenance at all.
+ *
+ * Input Parameters:
+ *   start - The start of the non-cacheable region
+ *   size  - The size of the region in bytes
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DMA_COHERENT_POOL
+int dma_coherent_initialize(FAR void *start, size_t size);
+
+/****************************************************************************
+ * Name: dma_alloc_coherent, dma_free_coherent
+ *
+ * Description:
+ *   Allocate and free memory from the coherent DMA pool.  The allocations
+ *   are aligned to DMA_ALIGN.
+ *
+ ****************************************************************************/
+
+FAR void *dma_alloc_coherent(size_t size);
+void dma_free_coherent(FAR void *mem, size_t size);
+#endif
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_DMA_MAP */
+#endif /* __INCLUDE_NUTTX_DMA_H */
@@ -0,0 +1,312 @@
+/****************************************************************************
+ * include/nuttx/dmaengine.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_DMAENGINE_H
+#define __INCLUDE_NUTTX_DMAENGINE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/dma.h>
+
+#ifdef CONFIG_DMA_ENGINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Capabilities of a DMA controller (struct dmaengine_dev_s caps) */
+
+#define DMAENGINE_CAP_SG      (1 << 0) /* Chains scatter-gather lists itself */
+#define DMAENGINE_CAP_CYCLIC  (1 << 1) /* Supports cyclic transfers */
+#define DMAENGINE_CAP_MEMCPY  (1 << 2) /* Supports memory-to-memory copies */
+#define DMAENGINE_CAP_PAUSE   (1 << 3) /* Transfers may be paused */
+
+/* The result passed to the completion callback for each completed period
+ * of a cyclic transfer.  A non-cyclic transfer completes with OK or with a
+ * negated errno value.
+ */
+
+#define DMAENGINE_PERIOD      1
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The direction of a transfer */
+
+enum dmaengine_dir_e
+{
+  DMAENGINE_MEM_TO_MEM = 0,
+  DMAENGINE_MEM_TO_DEV,
+  DMAENGINE_DEV_TO_MEM
+};
+
+/* The kind of a prepared transfer */
+
+enum dmaengine_type_e
+{
+  DMAENGINE_SINGLE = 0,       /* One contiguous buffer */
+  DMAENGINE_SG,               /* A scatter-gather list */
+  DMAENGINE_CYCLIC,           /* One buffer, repeated until stopped */
+  DMAENGINE_MEMCPY            /* Memory-to-memory copy */
+};
+
+/* The static configuration of a channel */
+
+struct dmaengine_config_s
+{
+  uint8_t dir;                /* See enum dmaengine_dir_e */
+  uint8_t width;              /* Width of the device register in bytes */
+  uint8_t burst;              /* Burst length in units of width; 0 = single */
+  uint8_t priority;           /* 0 (lowest) .. 3 (highest) */
+  uintptr_t devaddr;          /* Address of the device data register */
+};
+
+/* A transfer prepared for the controller.  The lower half receives at most
+ * one segment at a time if it does not set DMAENGINE_CAP_SG:  The
+ * framework then chains the segments from the completion interrupt.
+ */
+
+struct dmaengine_desc_s
+{
+  uint8_t type;                  /* See enum dmaengine_type_e */
+  uintptr_t src;                 /* Source address (memory or device) */
+  uintptr_t dst;                 /* Destination address (memory or device) */
+  size_t len;                    /* Length in bytes */
+  size_t period;                 /* DMAENGINE_CYCLIC: Bytes per period */
+  FAR const struct dma_sg_s *sg; /* DMAENGINE_SG: The segments */
+  int nents;                     /* DMAENGINE_SG: The number of segments */
+};
+
+struct dmaengine_chan_s;
+typedef CODE void (*dmaengine_callback_t)(FAR struct dmaengine_chan_s *chan,
+                                          FAR void *arg, int result);
+
+/* The channel operations provided by the lower half */
+
+struct dmaengine_ops_s
+{
+  CODE int (*config)(FAR struct dmaengine_chan_s *chan,
+                     FAR const struct dmaengine_config_s *config);
+  CODE int (*prep)(FAR struct dmaengine_chan_s *chan,
+                   FAR const struct dmaengine_desc_s *desc);
+  CODE int (*start)(FAR struct dmaengine_chan_s *chan);
+  CODE int (*stop)(FAR struct dmaengine_chan_s *chan);
+  CODE int (*pause)(FAR struct dmaengine_chan_s *chan);
+  CODE int (*resume)(FAR struct dmaengine_chan_s *chan);
+  CODE size_t (*residue)(FAR struct dmaengine_chan_s *chan);
+};
+
+/* A channel.  The lower half embeds this structure at the beginning of its
+ * own channel state.
+ */
+
+struct dmaengine_chan_s
+{
+  FAR const struct dmaengine_ops_s *ops; /* Set by the lower half */
+  FAR struct dmaengine_dev_s *dev;       /* The owning controller */
+
+  /* The remaining fields belong to the framework */
+
+  struct dmaengine_config_s config;      /* The current configuration */
+  dmaengine_callback_t callback;         /* Completion callback */
+  FAR void *arg;                         /* Argument of the callback */
+  FAR const struct dma_sg_s *sg;         /* Segments chained by software */
+  int nents;                             /* Number of segments */
+  int sgindex;                           /* The segment in progress */
+};
+
+/* The controller operations provided by the lower half */
+
+struct dmaengine_dev_s;
+struct dmaengine_devops_s
+{
+  /* Allocate the channel identified by a controller specific value (e.g.
+   * the request line mapping).  May wait for the channel to become free.
+   */
+
+  CODE FAR struct dmaengine_chan_s *(*request)(
+                                    FAR struct dmaengine_dev_s *dev,
+                                    unsigned int ident);
+  CODE void (*release)(FAR struct dmaengine_dev_s *dev,
+                       FAR struct dmaengine_chan_s *chan);
+};
+
+/* A DMA controller */
+
+struct dmaengine_dev_s
+{
+  FAR const struct dmaengine_devops_s *ops;
+  uint32_t caps;                         /* See DMAENGINE_CAP_* */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: dmaengine_register
+ *
+ * Description:
+ *   Register a DMA controller.  Called by the architecture specific DMA
+ *   logic during initialization.
+ *
+ * Returned Value:
+ *   The controller number used with dmaengine_request() on success; a
+ *   negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int dmaengine_register(FAR struct dmaengine_dev_s *dev);
+
+/****************************************************************************
+ * Name: dmaengine_request, dmaengine_release
+ *
+ * Description:
+ *   Allocate a channel of a registered controller and free it again.
+ *
+ * Input Parameters:
+ *   devno - The controller number returned by dmaengine_register()
+ *   ident - Identifies the channel; the meaning depends on the controller
+ *
+ * Returned Value:
+ *   The channel on success; NULL if there is no such channel.
+ *
+ ****************************************************************************/
+
+FAR struct dmaengine_chan_s *dmaengine_request(int devno,
+                                               unsigned int ident);
+void dmaengine_release(FAR struct dmaengine_chan_s *chan);
+
+/****************************************************************************
+ * Name: dmaengine_config
+ *
+ * Description:
+ *   Set the direction, device address, width, burst and priority of the
+ *   channel.
+ *
+ ****************************************************************************/
+
+int dmaengine_config(FAR struct dmaengine_chan_s *chan,
+                     FAR const struct dmaengine_config_s *config);
+
+/****************************************************************************
+ * Name: dmaengine_prep_single, dmaengine_prep_sg, dmaengine_prep_cyclic,
+ *       dmaengine_prep_memcpy
+ *
+ * Description:
+ *   Prepare a transfer on a configured channel.  The transfer starts with
+ *   dmaengine_submit().  Memory addresses are device addresses, as
+ *   returned by dma_map_single() and dma_map_sg().
+ *
+ *   callback is called from the DMA interrupt handler when the transfer
+ *   completes or fails and, for cyclic transfers, after each period.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  -ENOSYS is
+ *   returned if the controller cannot do that kind of transfer.
+ *
+ ****************************************************************************/
+
+int dmaengine_prep_single(FAR struct dmaengine_chan_s *chan, uintptr_t buf,
+                          size_t len, dmaengine_callback_t callback,
+                          FAR void *arg);
+int dmaengine_prep_sg(FAR struct dmaengine_chan_s *chan,
+                      FAR const struct dma_sg_s *sg, int nents,
+                      dmaengine_callback_t callback, FAR void *arg);
+int dmaengine_prep_cyclic(FAR struct dmaengine_chan_s *chan, uintptr_t buf,
+                          size_t len, size_t period,
+                          dmaengine_callback_t callback, FAR void *arg);
+int dmaengine_prep_memcpy(FAR struct dmaengine_chan_s *chan, uintptr_t dst,
+                          uintptr_t src, size_t len,
+                          dmaengine_callback_t callback, FAR void *arg);
+
+/****************************************************************************
+ * Name: dmaengine_submit, dmaengine_terminate
+ *
+ * Description:
+ *   Start the prepared transfer, or stop the transfer in progress.  No
+ *   callback is made for a terminated transfer.
+ *
+ ****************************************************************************/
+
+int dmaengine_submit(FAR struct dmaengine_chan_s *chan);
+int dmaengine_terminate(FAR struct dmaengine_chan_s *chan);
+
+/****************************************************************************
+ * Name: dmaengine_pause, dmaengine_resume
+ *
+ * Description:
+ *   Suspend and continue a transfer, if the controller sets
+ *   DMAENGINE_CAP_PAUSE.
+ *
+ ****************************************************************************/
+
+int dmaengine_pause(FAR struct dmaengine_chan_s *chan);
+int dmaengine_resume(FAR struct dmaengine_chan_s *chan);
+
+/****************************************************************************
+ * Name: dmaengine_residue
+ *
+ * Description:
+ *   Return the number of bytes of the current segment not yet transferred.
+ *
+ ****************************************************************************/
+
+size_t dmaengine_residue(FAR struct dmaengine_chan_s *chan);
+
+/****************************************************************************
+ * Name: dmaengine_complete
+ *
+ * Description:
+ *   Called by the lower half from its interrupt handler when a segment or
+ *   a period completes, or when the transfer fails.
+ *
+ * Input Parameters:
+ *   chan   - The channel
+ *   result - OK, DMAENGINE_PERIOD or a negated errno value
+ *
+ ****************************************************************************/
+
+void dmaengine_complete(FAR struct dmaengine_chan_s *chan, int result);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_DMA_ENGINE */
+#endif /* __INCLUDE_NUTTX_DMAENGINE_H */
@@ -137,6 +137,22 @@ void devcrypto_register(void);
 
 void devzero_register(void);
 
+/****************************************************************************
+ * Name: devpmu_register
+ *
+ * Description:
+ *   Register /dev/pmu
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void devpmu_register(void);
+
 /****************************************************************************
  * Name: bchdev_register
  *
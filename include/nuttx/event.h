@@ -0,0 +1,238 @@
+/****************************************************************************
+ * include/nuttx/event.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_EVENT_H
+#define __INCLUDE_NUTTX_EVENT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <queue.h>
+
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Wait flags */
+
+#define NXEVENT_WAIT_ALL     (1 << 0) /* Wait for all events, not any */
+#define NXEVENT_WAIT_RESET   (1 << 1) /* Clear the awaited events on return */
+
+/* Waiting forever */
+
+#define NXEVENT_WAIT_FOREVER UINT32_MAX
+
+/* IOCTL commands of the event group character driver.
+ *
+ * EVENTIOC_POST
+ *   Description: Set events, as nxevent_post().
+ *   Argument:    The events to set (nxevent_mask_t)
+ *
+ * EVENTIOC_CLEAR
+ *   Description: Clear events, as nxevent_clear().
+ *   Argument:    The events to clear (nxevent_mask_t)
+ *
+ * EVENTIOC_GET
+ *   Description: Get the events that are currently set.
+ *   Argument:    A pointer to a nxevent_mask_t
+ *
+ * EVENTIOC_SETWAIT
+ *   Description: Select the events that read() waits for and poll()
+ *                reports with POLLIN for this open file.  By default any
+ *                event makes the file readable.
+ *   Argument:    A pointer to a struct nxevent_waitreq_s.  The timeout
+ *                and result fields are ignored.
+ *
+ * EVENTIOC_WAIT
+ *   Description: Wait for events, as nxevent_tickwait().
+ *   Argument:    A pointer to a struct nxevent_waitreq_s
+ */
+
+#define EVENTIOC_POST        _EVENTIOC(0x0001)
+#define EVENTIOC_CLEAR       _EVENTIOC(0x0002)
+#define EVENTIOC_GET         _EVENTIOC(0x0003)
+#define EVENTIOC_SETWAIT     _EVENTIOC(0x0004)
+#define EVENTIOC_WAIT        _EVENTIOC(0x0005)
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+typedef uint32_t nxevent_mask_t;
+
+/* This structure describes one event group.  Events are bits that can be
+ * set and cleared from any context, including interrupt handlers, and that
+ * tasks can wait for.
+ */
+
+struct nxevent_s
+{
+  volatile nxevent_mask_t events; /* The events that are set */
+  dq_queue_t waiters;             /* The list of waiting tasks */
+  spinlock_t lock;                /* Protects events and waiters */
+#if CONFIG_SCHED_EVENTS_NPOLLWAITERS > 0
+  FAR struct pollfd *fds[CONFIG_SCHED_EVENTS_NPOLLWAITERS];
+#endif
+};
+
+/* The argument of EVENTIOC_SETWAIT and EVENTIOC_WAIT */
+
+struct nxevent_waitreq_s
+{
+  nxevent_mask_t events;          /* The events to wait for */
+  nxevent_mask_t result;          /* The events that were set (returned) */
+  uint8_t flags;                  /* See NXEVENT_WAIT_* definitions */
+  uint32_t timeout;               /* Timeout in milliseconds */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: nxevent_init
+ *
+ * Description:
+ *   Initialize an event group.
+ *
+ * Input Parameters:
+ *   event  - The event group to initialize
+ *   events - The events that are initially set
+ *
+ ****************************************************************************/
+
+void nxevent_init(FAR struct nxevent_s *event, nxevent_mask_t events);
+
+/****************************************************************************
+ * Name: nxevent_destroy
+ *
+ * Description:
+ *   Release an event group.  No task may wait for it.
+ *
+ ****************************************************************************/
+
+void nxevent_destroy(FAR struct nxevent_s *event);
+
+/****************************************************************************
+ * Name: nxevent_post
+ *
+ * Description:
+ *   Set events and wake up every task whose wait is now satisfied.  This
+ *   may be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to set
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxevent_post(FAR struct nxevent_s *event, nxevent_mask_t events);
+
+/****************************************************************************
+ * Name: nxevent_clear
+ *
+ * Description:
+ *   Clear events.  This may be called from interrupt handlers.
+ *
+ * Returned Value:
+ *   The events that were set before they were cleared.
+ *
+ ****************************************************************************/
+
+nxevent_mask_t nxevent_clear(FAR struct nxevent_s *event,
+                             nxevent_mask_t events);
+
+/****************************************************************************
+ * Name: nxevent_tickwait
+ *
+ * Description:
+ *   Wait until any (or all, with NXEVENT_WAIT_ALL) of the given events are
+ *   set.  With NXEVENT_WAIT_RESET the awaited events are cleared before
+ *   returning.  This must not be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to wait for
+ *   flags  - See NXEVENT_WAIT_* definitions
+ *   delay  - The time to wait in ticks.  Zero does not wait at all and
+ *            NXEVENT_WAIT_FOREVER does not time out.
+ *   result - The location to return the awaited events that were set.
+ *            May be NULL.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure:
+ *
+ *     -EAGAIN    The events are not set and delay is zero
+ *     -ETIMEDOUT The events were not set in time
+ *     -EINTR     The wait was interrupted by a signal
+ *
+ ****************************************************************************/
+
+int nxevent_tickwait(FAR struct nxevent_s *event, nxevent_mask_t events,
+                     uint8_t flags, uint32_t delay,
+                     FAR nxevent_mask_t *result);
+
+#define nxevent_wait(e,v,f,r) nxevent_tickwait(e,v,f,NXEVENT_WAIT_FOREVER,r)
+
+/****************************************************************************
+ * Name: nxevent_register
+ *
+ * Description:
+ *   Register a character driver that gives user space access to an event
+ *   group.  read() waits for the events selected with EVENTIOC_SETWAIT and
+ *   returns them as a nxevent_mask_t, write() sets the events given as a
+ *   nxevent_mask_t and poll() reports POLLIN while the events selected
+ *   with EVENTIOC_SETWAIT are set.
+ *
+ * Input Parameters:
+ *   path  - The path of the driver, e.g. "/dev/event0"
+ *   event - The initialized event group
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxevent_register(FAR const char *path, FAR struct nxevent_s *event);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_EVENT_H */
@@ -0,0 +1,206 @@
+/****************************************************************************
+ * include/nuttx/fs/blkcache.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_BLKCACHE_H
+#define __INCLUDE_NUTTX_FS_BLKCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/fs/fs.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_BLKCACHE
+/* Counters of the block cache as reported by blkcache_stats() */
+
+struct blkcache_stats_s
+{
+  uint32_t hits;          /* Single sector accesses served by the cache */
+  uint32_t misses;        /* Single sector accesses that needed a page */
+  uint32_t writebacks;    /* Dirty pages written back to the media */
+  uint32_t bypasses;      /* Accesses that went directly to the driver */
+  uint32_t readaheads;    /* Sectors read before they were asked for */
+  uint16_t npages;        /* Number of pages in the cache */
+  uint16_t nused;         /* Number of pages holding a sector */
+  uint16_t ndirty;        /* Number of pages not yet written back */
+  uint16_t pagesize;      /* Size of one page in bytes */
+};
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_FS_BLKCACHE
+
+/****************************************************************************
+ * Name: blkcache_read
+ *
+ * Description:
+ *   Read sectors from a block driver through the shared block cache.
+ *   Single sector reads are served from and kept in the cache, longer
+ *   reads go to the driver and see the cached sectors that were not yet
+ *   written back.
+ *
+ * Input Parameters:
+ *   inode    - The inode of the block driver
+ *   buffer   - The location to receive the data
+ *   start    - The first sector to read
+ *   nsectors - The number of sectors to read
+ *   sectsize - The sector size of the block driver
+ *
+ * Returned Value:
+ *   The number of sectors read or a negated errno value, like the read
+ *   method of the block driver.
+ *
+ ****************************************************************************/
+
+ssize_t blkcache_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                      blkcnt_t start, unsigned int nsectors,
+                      size_t sectsize);
+
+/****************************************************************************
+ * Name: blkcache_write
+ *
+ * Description:
+ *   Write sectors to a block driver through the shared block cache.
+ *   Single sector writes only update the cache and are written back when
+ *   the page is reused or the cache is flushed, longer writes go to the
+ *   driver and update the cached copies.
+ *
+ * Input Parameters:
+ *   inode    - The inode of the block driver
+ *   buffer   - The data to write
+ *   start    - The first sector to write
+ *   nsectors - The number of sectors to write
+ *   sectsize - The sector size of the block driver
+ *
+ * Returned Value:
+ *   The number of sectors written or a negated errno value, like the write
+ *   method of the block driver.
+ *
+ ****************************************************************************/
+
+ssize_t blkcache_write(FAR struct inode *inode,
+                       FAR const unsigned char *buffer, blkcnt_t start,
+                       unsigned int nsectors, size_t sectsize);
+
+/****************************************************************************
+ * Name: blkcache_flush
+ *
+ * Description:
+ *   Write back the dirty pages of a block driver.
+ *
+ * Input Parameters:
+ *   inode - The inode of the block driver, or NULL for all block drivers
+ *
+ * Returned Value:
+ *   Zero (OK) on success; the first negated errno value reported by a
+ *   block driver on failure.
+ *
+ ****************************************************************************/
+
+int blkcache_flush(FAR struct inode *inode);
+
+/****************************************************************************
+ * Name: blkcache_invalidate
+ *
+ * Description:
+ *   Write back and then drop all pages of a block driver.  This must be
+ *   called before the last reference to the driver is released.
+ *
+ * Input Parameters:
+ *   inode - The inode of the block driver
+ *
+ * Returned Value:
+ *   The result of writing back the dirty pages.  The pages are dropped in
+ *   any case.
+ *
+ ****************************************************************************/
+
+int blkcache_invalidate(FAR struct inode *inode);
+
+/****************************************************************************
+ * Name: blkcache_stats
+ *
+ * Description:
+ *   Return a snapshot of the counters of the block cache.
+ *
+ ****************************************************************************/
+
+void blkcache_stats(FAR struct blkcache_stats_s *stats);
+
+#else
+
+/* Without the block cache, the cache interfaces map directly to the
+ * methods of the block driver.
+ */
+
+static inline ssize_t blkcache_read(FAR struct inode *inode,
+                                    FAR unsigned char *buffer,
+                                    blkcnt_t start, unsigned int nsectors,
+                                    size_t sectsize)
+{
+  return inode->u.i_bops->read(inode, buffer, start, nsectors);
+}
+
+static inline ssize_t blkcache_write(FAR struct inode *inode,
+                                     FAR const unsigned char *buffer,
+                                     blkcnt_t start, unsigned int nsectors,
+                                     size_t sectsize)
+{
+  return inode->u.i_bops->write(inode, buffer, start, nsectors);
+}
+
+static inline int blkcache_flush(FAR struct inode *inode)
+{
+  return OK;
+}
+
+static inline int blkcache_invalidate(FAR struct inode *inode)
+{
+  return OK;
+}
+
+#endif /* CONFIG_FS_BLKCACHE */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_FS_BLKCACHE_H */
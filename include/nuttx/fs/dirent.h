@@ -84,7 +84,7 @@ struct romfs_nodeinfo_s
 {
   FAR struct romfs_nodeinfo_s **rn_child;  /* The node array for link to lower level */
   uint16_t rn_count;                       /* The count of node in rn_child level */
-  uint32_t rn_offset;                      /* The offset to real file header of the current entry */
+  uint32_t rn_offset;                      /* The offset to the first entry or file data */
   uint32_t rn_next;                        /* The offset of the next file header+flags */
   uint32_t rn_size;                        /* The size to the entry (if file) */
   uint8_t  rn_namesize;                    /* The length of name of the entry */
@@ -209,6 +209,7 @@ struct fs_unionfsdir_s
   bool fu_prefix[2];                          /* True: Fake directory in prefix */
   FAR char *fu_relpath;                       /* Path being enumerated */
   FAR struct fs_dirent_s *fu_lower[2];        /* dirent struct used by contained file system */
+  FAR uint8_t *fu_names;                      /* Map of names seen on file system 1 */
 };
 #endif
 
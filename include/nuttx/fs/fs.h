@@ -33,6 +33,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <time.h>
+#include <poll.h>
 
 #include <nuttx/semaphore.h>
 
@@ -238,6 +239,14 @@ struct partition_info_s
   char      parent[NAME_MAX + 1];
 };
 
+/* This structure describes the range of sectors passed to BIOC_DISCARD */
+
+struct blk_discard_s
+{
+  blkcnt_t  startsector;  /* The first sector that is no longer in use */
+  blkcnt_t  nsectors;     /* The number of sectors */
+};
+
 /* This structure is provided by block devices when they register with the
  * system.  It is used by file systems to perform filesystem transfers.  It
  * differs from the normal driver vtable in several ways -- most notably in
@@ -830,6 +839,22 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2);
 
 int nx_dup2(int fd1, int fd2);
 
+/****************************************************************************
+ * Name: nx_dup2_from_tcb
+ *
+ * Description:
+ *   nx_dup2_from_tcb() is similar to nx_dup2() except that it operates on
+ *   the file list of the task 'tcb'.
+ *
+ * Returned Value:
+ *   fd2 is returned on success; a negated errno value is return on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+struct tcb_s; /* Forward reference */
+int nx_dup2_from_tcb(FAR struct tcb_s *tcb, int fd1, int fd2);
+
 /****************************************************************************
  * Name: file_open
  *
@@ -871,6 +896,22 @@ int file_open(FAR struct file *filep, FAR const char *path, int oflags, ...);
 
 int nx_open(FAR const char *path, int oflags, ...);
 
+/****************************************************************************
+ * Name: nx_open_from_tcb
+ *
+ * Description:
+ *   nx_open_from_tcb() is similar to nx_open() except that the new file
+ *   descriptor is allocated in the file list of the task 'tcb'.
+ *
+ * Returned Value:
+ *   The new file descriptor is returned on success; a negated errno value is
+ *   returned on any failure.
+ *
+ ****************************************************************************/
+
+int nx_open_from_tcb(FAR struct tcb_s *tcb, FAR const char *path,
+                     int oflags, ...);
+
 /****************************************************************************
  * Name: fs_getfilep
  *
@@ -927,6 +968,21 @@ int file_close(FAR struct file *filep);
 
 int nx_close(int fd);
 
+/****************************************************************************
+ * Name: nx_close_from_tcb
+ *
+ * Description:
+ *   nx_close_from_tcb() is similar to nx_close() except that it closes a
+ *   file descriptor in the file list of the task 'tcb'.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int nx_close_from_tcb(FAR struct tcb_s *tcb, int fd);
+
 /****************************************************************************
  * Name: open_blockdriver
  *
@@ -973,6 +1029,49 @@ int open_blockdriver(FAR const char *pathname, int mountflags,
 
 int close_blockdriver(FAR struct inode *inode);
 
+/****************************************************************************
+ * Name: find_mtddriver
+ *
+ * Description:
+ *   Return the inode of the named MTD driver specified by 'pathname'
+ *
+ * Input Parameters:
+ *   pathname   - the full path to the named MTD driver to be located
+ *   ppinode    - address of the location to return the inode reference
+ *
+ * Returned Value:
+ *   Returns zero on success or a negated errno on failure:
+ *
+ *   ENOENT  - No MTD driver of this name is registered
+ *   ENOTBLK - The inode associated with the pathname is not an MTD driver
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+int find_mtddriver(FAR const char *pathname, FAR struct inode **ppinode);
+#endif
+
+/****************************************************************************
+ * Name: close_mtddriver
+ *
+ * Description:
+ *   Release the inode reference returned by find_mtddriver
+ *
+ * Input Parameters:
+ *   inode - reference to the inode of an MTD driver found by
+ *           find_mtddriver
+ *
+ * Returned Value:
+ *   Returns zero on success or a negated errno on failure:
+ *
+ *   EINVAL  - inode is NULL
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+int close_mtddriver(FAR struct inode *inode);
+#endif
+
 /****************************************************************************
  * Name: fs_fdopen
  *
@@ -1223,6 +1322,17 @@ int file_mmap(FAR struct file *filep, FAR void *start, size_t length,
 
 int file_munmap(FAR void *start, size_t length);
 
+/****************************************************************************
+ * Name: file_msync
+ *
+ * Description:
+ *   Equivalent to the standard msync() function except it does not set
+ *   the errno variable and it is not a cancellation point.
+ *
+ ****************************************************************************/
+
+int file_msync(FAR void *start, size_t length, int flags);
+
 /****************************************************************************
  * Name: file_ioctl
  *
@@ -1323,6 +1433,29 @@ int nx_fcntl(int fd, int cmd, ...);
 
 int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Notify the poll waiters of new events.  This must be used by drivers
+ *   instead of posting fds->sem directly so that waiters that do not sleep
+ *   on the semaphore (such as epoll) are informed too.
+ *
+ * Input Parameters:
+ *   afds     - An array of pointers to the pollfd structures to notify.
+ *              NULL entries are skipped.
+ *   nfds     - The number of entries in afds
+ *   eventset - The events to add to revents (masked by the requested
+ *              events).  A waiter is notified only if its revents is
+ *              non-zero afterwards.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset);
+
 /****************************************************************************
  * Name: nx_poll
  *
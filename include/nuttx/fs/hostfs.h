@@ -204,6 +204,8 @@ int           host_rename(const char *oldpath, const char *newpath);
 int           host_stat(const char *path, struct nuttx_stat_s *buf);
 int           host_chstat(const char *path,
                           const struct nuttx_stat_s *buf, int flags);
+void         *host_mmap(int fd, nuttx_size_t length);
+int           host_munmap(void *addr, nuttx_size_t length);
 #else
 int           host_open(const char *pathname, int flags, int mode);
 int           host_close(int fd);
@@ -228,6 +230,8 @@ int           host_rename(const char *oldpath, const char *newpath);
 int           host_stat(const char *path, struct stat *buf);
 int           host_chstat(const char *path,
                           const struct stat *buf, int flags);
+void         *host_mmap(int fd, size_t length);
+int           host_munmap(void *addr, size_t length);
 #endif /* __SIM__ */
 
 #endif /* __INCLUDE_NUTTX_FS_HOSTFS_H */
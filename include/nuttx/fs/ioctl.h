@@ -89,6 +89,11 @@
 #define _MTRIOBASE      (0x3100) /* Motor device ioctl commands */
 #define _MATHIOBASE     (0x3200) /* MATH device ioctl commands */
 #define _MMCSDIOBASE    (0x3300) /* MMCSD device ioctl commands */
+#define _USRSOCKIOBASE  (0x3400) /* Usrsock device ioctl commands */
+#define _RAMLOGBASE     (0x3500) /* RAMLOG device ioctl commands */
+#define _EVENTBASE      (0x3600) /* Event group ioctl commands */
+#define _PMUBASE        (0x3700) /* Performance counter ioctl commands */
+#define _PTPBASE        (0x3800) /* PTP hardware clock ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -287,6 +292,13 @@
                                            * OUT: Partition information structure
                                            *      populated with data from the block
                                            *      device partition */
+#define BIOC_DISCARD    _BIOC(0x000f)     /* Tell the block device that a range of
+                                           * sectors no longer holds useful data.
+                                           * Their content is undefined until they
+                                           * are written again.
+                                           * IN:  Pointer to struct blk_discard_s
+                                           * OUT: None (ioctl return value provides
+                                           *      success/failure indication). */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
@@ -570,6 +582,31 @@
 #define _MMCSDIOCVALID(c)   (_IOC_TYPE(c) == _MMCSDIOBASE)
 #define _MMCSDIOC(nr)       _IOC(_MMCSDIOBASE, nr)
 
+/* RAMLOG device driver *****************************************************/
+
+#define _RAMLOGIOCVALID(c)  (_IOC_TYPE(c) == _RAMLOGBASE)
+#define _RAMLOGIOC(nr)      _IOC(_RAMLOGBASE, nr)
+
+/* Usrsock device driver ****************************************************/
+
+#define _USRSOCKIOCVALID(c) (_IOC_TYPE(c) == _USRSOCKIOBASE)
+#define _USRSOCKIOC(nr)     _IOC(_USRSOCKIOBASE, nr)
+
+/* Event group driver *******************************************************/
+
+#define _EVENTIOCVALID(c)   (_IOC_TYPE(c) == _EVENTBASE)
+#define _EVENTIOC(nr)       _IOC(_EVENTBASE, nr)
+
+/* Performance counter driver ***********************************************/
+
+#define _PMUIOCVALID(c)     (_IOC_TYPE(c) == _PMUBASE)
+#define _PMUIOC(nr)         _IOC(_PMUBASE, nr)
+
+/* PTP hardware clock driver ************************************************/
+
+#define _PTPIOCVALID(c)     (_IOC_TYPE(c) == _PTPBASE)
+#define _PTPIOC(nr)         _IOC(_PTPBASE, nr)
+
 /* Wireless driver network ioctl definitions ********************************/
 
 /* (see nuttx/include/wireless/wireless.h */
@@ -0,0 +1,160 @@
+/****************************************************************************
+ * include/nuttx/fs/iostat.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_IOSTAT_H
+#define __INCLUDE_NUTTX_FS_IOSTAT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/arch.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The operations that are accounted, from the top of the I/O stack to the
+ * bottom.  The time of an operation includes the time of the operations
+ * of the lower layers that it causes, so the time spent in one layer is
+ * its time minus the time of the layer below.
+ *
+ * The size is in bytes for the VFS, the BCH driver and the MTD byte
+ * reads, in blocks for the MTD block reads and writes and in erase blocks
+ * for the MTD erases.
+ */
+
+#define FS_IOSTAT_VFS_READ    0  /* file_read() */
+#define FS_IOSTAT_VFS_WRITE   1  /* file_write() */
+#define FS_IOSTAT_VFS_FSYNC   2  /* file_fsync() */
+#define FS_IOSTAT_BCH_READ    3  /* Reads of a BCH character driver */
+#define FS_IOSTAT_BCH_WRITE   4  /* Writes of a BCH character driver */
+#define FS_IOSTAT_MTD_BREAD   5  /* MTD_BREAD() */
+#define FS_IOSTAT_MTD_BWRITE  6  /* MTD_BWRITE() */
+#define FS_IOSTAT_MTD_READ    7  /* MTD_READ() */
+#define FS_IOSTAT_MTD_ERASE   8  /* MTD_ERASE() */
+#define FS_IOSTAT_NOPS        9
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The counters of one operation.  The times are in counts of the
+ * performance counter, see up_perf_gettime().
+ */
+
+struct fs_iostat_s
+{
+  uint32_t count;          /* Number of operations */
+  uint32_t errors;         /* Number of operations that failed */
+  uint64_t size;           /* Total size transferred */
+  uint64_t time;           /* Total time of the operations */
+  uint32_t maxtime;        /* Longest operation */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_FS_IOSTAT
+
+/****************************************************************************
+ * Name: fs_iostat_begin
+ *
+ * Description:
+ *   Return the start time of an operation, to be passed to
+ *   fs_iostat_end() when it completes.
+ *
+ ****************************************************************************/
+
+#define fs_iostat_begin() up_perf_gettime()
+
+/****************************************************************************
+ * Name: fs_iostat_end
+ *
+ * Description:
+ *   Account one operation.
+ *
+ * Input Parameters:
+ *   op     - One of the FS_IOSTAT_* operations
+ *   start  - The value returned by fs_iostat_begin()
+ *   result - The size transferred, or a negated errno value on failure
+ *
+ ****************************************************************************/
+
+void fs_iostat_end(int op, uint32_t start, ssize_t result);
+
+/****************************************************************************
+ * Name: fs_iostat_get
+ *
+ * Description:
+ *   Return a snapshot of the counters of all operations.
+ *
+ * Input Parameters:
+ *   stats - An array of FS_IOSTAT_NOPS entries to receive the counters
+ *
+ ****************************************************************************/
+
+void fs_iostat_get(FAR struct fs_iostat_s *stats);
+
+/****************************************************************************
+ * Name: fs_iostat_reset
+ *
+ * Description:
+ *   Clear the counters of all operations.
+ *
+ ****************************************************************************/
+
+void fs_iostat_reset(void);
+
+/****************************************************************************
+ * Name: fs_iostat_name
+ *
+ * Description:
+ *   Return the name of an operation, like "vfs_read".
+ *
+ ****************************************************************************/
+
+FAR const char *fs_iostat_name(int op);
+
+#else
+#  define fs_iostat_begin()            0
+#  define fs_iostat_end(op, s, r)      UNUSED(s)
+#endif /* CONFIG_FS_IOSTAT */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_FS_IOSTAT_H */
@@ -128,6 +128,60 @@ struct procfs_dir_priv_s
 /* An entry for procfs_register_meminfo */
 
 struct mm_heap_s;
+
+/* Binary layout of /proc/snapshot.  A read from offset zero samples the
+ * system state once and returns a struct procfs_snapshot_s header followed
+ * by 'ntasks' struct procfs_snapshot_task_s records.  The task records are
+ * all collected inside a single critical section, so they are mutually
+ * consistent.  Readers should use 'hdrsize' and 'tasksize' to step through
+ * the records so that fields appended in later versions can be ignored.
+ */
+
+#define PROCFS_SNAPSHOT_MAGIC     0x50414e53  /* "SNAP" little endian */
+#define PROCFS_SNAPSHOT_VERSION   1
+#define PROCFS_SNAPSHOT_NAMELEN   32
+
+/* Bits in procfs_snapshot_s::valid telling which groups were sampled */
+
+#define PROCFS_SNAPSHOT_CPULOAD   (1 << 0) /* cpuload fields are valid */
+#define PROCFS_SNAPSHOT_HEAP      (1 << 1) /* heap_* fields are valid */
+#define PROCFS_SNAPSHOT_IOB       (1 << 2) /* iob_* fields are valid */
+#define PROCFS_SNAPSHOT_STACKUSED (1 << 3) /* stackused fields are valid */
+
+struct procfs_snapshot_s
+{
+  uint32_t magic;                /* PROCFS_SNAPSHOT_MAGIC */
+  uint16_t version;              /* PROCFS_SNAPSHOT_VERSION */
+  uint16_t hdrsize;              /* sizeof(struct procfs_snapshot_s) */
+  uint16_t tasksize;             /* sizeof(struct procfs_snapshot_task_s) */
+  uint16_t ntasks;               /* Number of task records that follow */
+  uint32_t valid;                /* See PROCFS_SNAPSHOT_* bits */
+  uint32_t ticks;                /* System tick count at the sample */
+  uint32_t cpuload_total;        /* Total ticks of the CPU load window */
+  uint32_t heap_arena;           /* Total size of the kernel heap */
+  uint32_t heap_used;            /* Bytes in allocated chunks */
+  uint32_t heap_free;            /* Bytes in free chunks */
+  uint32_t heap_largest;         /* Size of the largest free chunk */
+  uint32_t heap_nused;           /* Number of allocated chunks */
+  uint32_t heap_nfree;           /* Number of free chunks */
+  int32_t  iob_nfree;            /* Free IOBs */
+  int32_t  iob_nthrottle;        /* Free IOBs available to throttled users */
+  int32_t  iob_nqentry;          /* Free IOB queue containers */
+};
+
+struct procfs_snapshot_task_s
+{
+  int32_t  pid;                  /* Task/thread ID */
+  uint16_t flags;                /* TCB flags (TCB_FLAG_*) */
+  uint8_t  priority;             /* Current priority */
+  uint8_t  basepriority;         /* Base priority */
+  uint8_t  state;                /* Task state (enum tstate_e) */
+  uint8_t  reserved[3];
+  uint32_t stacksize;            /* Size of the stack */
+  uint32_t stackused;            /* Stack high-water mark */
+  uint32_t cpuload;              /* Active ticks in the CPU load window */
+  char     name[PROCFS_SNAPSHOT_NAMELEN];
+};
 struct procfs_meminfo_entry_s
 {
   FAR const char *name;
@@ -221,6 +275,34 @@ size_t procfs_memcpy(FAR const char *src, size_t srclen,
 int procfs_snprintf(FAR char *buf, size_t size,
                     FAR const IPTR char *format, ...);
 
+/****************************************************************************
+ * Name: procfs_crithist
+ *
+ * Description:
+ *   Generate one line describing a latency histogram of the critical
+ *   section monitor:  the prefix, the longest duration, its code location
+ *   and the count of each bucket, all separated by commas.  The data is
+ *   transferred to the user receive buffer like procfs_memcpy() does.
+ *
+ * Input Parameters:
+ *   prefix  - The first field of the line
+ *   hist    - The histogram to describe
+ *   buffer  - The address of the user's receive buffer.
+ *   buflen  - The size (in bytes) of the user's receive buffer.
+ *   offset  - The number of bytes to skip, updated as by procfs_memcpy()
+ *
+ * Returned Value:
+ *   The number of bytes actually transferred into the user's receive buffer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+struct critmon_hist_s;
+size_t procfs_crithist(FAR const char *prefix,
+                       FAR const struct critmon_hist_s *hist,
+                       FAR char *buffer, size_t buflen, FAR off_t *offset);
+#endif
+
 /****************************************************************************
  * Name: procfs_register
  *
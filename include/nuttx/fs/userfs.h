@@ -58,6 +58,10 @@
  * 6. The UserFS kernel thread will listen on the LocalHost socket
  *    and will receive the user file system responses and forward them to
  *    the kernel-space file system client.
+ *
+ * With CONFIG_FS_USERFS_SHM, the LocalHost socket is replaced by a ring of
+ * request slots in memory that both sides can access (see struct
+ * userfs_ring_s below).
  */
 
 /****************************************************************************
@@ -70,7 +74,9 @@
 #include <sys/socket.h>
 #include <sys/statfs.h>
 #include <sys/stat.h>
+#include <stdint.h>
 #include <dirent.h>
+#include <semaphore.h>
 
 #include <nuttx/fs/fs.h>
 
@@ -106,6 +112,29 @@
 
 #define USERFS_REQ_MAXSIZE   (32)
 
+#ifdef CONFIG_FS_USERFS_SHM
+/* States of a slot of the shared memory ring */
+
+#define USERFS_SLOT_FREE     0   /* Available to the client */
+#define USERFS_SLOT_CLIENT   1   /* The client is building a request */
+#define USERFS_SLOT_REQUEST  2   /* The request waits for the server */
+#define USERFS_SLOT_SERVER   3   /* The server is handling the request */
+#define USERFS_SLOT_RESPONSE 4   /* The response waits for the client */
+
+/* The slot buffers follow the slot array, each aligned to a pointer */
+
+#define USERFS_RING_ALIGN(n) \
+  (((n) + sizeof(uintptr_t) - 1) & ~(sizeof(uintptr_t) - 1))
+#define USERFS_RING_HDRSIZE(n) \
+  USERFS_RING_ALIGN(sizeof(struct userfs_ring_s) + \
+                    ((n) - 1) * sizeof(struct userfs_slot_s))
+#define SIZEOF_USERFS_RING_S(n, iolen) \
+  (USERFS_RING_HDRSIZE(n) + (n) * USERFS_RING_ALIGN(iolen))
+#define USERFS_RING_BUFFER(r, i) \
+  ((FAR uint8_t *)(r) + USERFS_RING_HDRSIZE((r)->nslots) + \
+   (i) * USERFS_RING_ALIGN((r)->iolen))
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -178,12 +207,45 @@ enum userfs_resp_e
  * file system is mounted.
  */
 
+struct userfs_ring_s;
+
 struct userfs_config_s
 {
   size_t mxwrite;        /* The max size of a write data */
   uint16_t portno;       /* The server port number (host order) */
+#ifdef CONFIG_FS_USERFS_SHM
+  FAR struct userfs_ring_s *ring; /* Shared ring used instead of the
+                                   * socket, if not NULL */
+#endif
 };
 
+#ifdef CONFIG_FS_USERFS_SHM
+/* The shared memory transport.  The ring is allocated by the server.  The
+ * client takes a free slot, marshals the request in the slot buffer, sets
+ * the slot to USERFS_SLOT_REQUEST and posts reqsem.  The server handles the
+ * request in place, leaves the response in the same buffer and posts the
+ * respsem of the slot.  The client then unmarshals the response and frees
+ * the slot.  There may be one request in flight per slot and bulk data is
+ * never copied through the network stack.
+ */
+
+struct userfs_slot_s
+{
+  uint8_t state;         /* See USERFS_SLOT_* definitions */
+  uint16_t size;         /* Size of the request, then of the response */
+  sem_t respsem;         /* Posted by the server when the response is ready */
+};
+
+struct userfs_ring_s
+{
+  sem_t reqsem;          /* Counts the requests waiting for the server */
+  sem_t freesem;         /* Counts the free slots */
+  uint16_t nslots;       /* Number of slots */
+  uint16_t iolen;        /* Size of the buffer of each slot */
+  struct userfs_slot_s slot[1]; /* Actual size is nslots */
+};
+#endif
+
 /* This structure identifies the user-space file system operations. */
 
 struct stat;   /* Forward reference */
@@ -604,6 +666,10 @@ int userfs_register(void);
  *   3. Returns file system responses generated by the callbacks to the
  *      LocalHost client socket.
  *
+ *   With CONFIG_FS_USERFS_SHM, the requests are received and the responses
+ *   returned through a ring of CONFIG_FS_USERFS_NSLOTS shared slots
+ *   instead of the LocalHost socket.
+ *
  *   NOTE:  This is a user function that is implemented as part of the
  *   NuttX C library and is intended to be called by application logic.
  *
@@ -0,0 +1,198 @@
+/****************************************************************************
+ * include/nuttx/i2c/i2c_regmap.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_I2C_I2C_REGMAP_H
+#define __INCLUDE_NUTTX_I2C_I2C_REGMAP_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/i2c/i2c_master.h>
+
+#ifdef CONFIG_I2C_REGMAP
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The register map is opaque to the sensor drivers.  It caches the values
+ * of the 8-bit registers of one I2C device with an 8-bit register address
+ * space so that reads of configuration registers and writes of unchanged
+ * values do not reach the bus.
+ */
+
+struct i2c_regmap_s;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: i2c_regmap_create
+ *
+ * Description:
+ *   Create a register map for one device.  All registers are cacheable and
+ *   not yet cached.  Registers whose value changes behind the back of the
+ *   driver (status, data, FIFO) must be marked with
+ *   i2c_regmap_set_volatile().
+ *
+ * Input Parameters:
+ *   i2c     - The I2C bus the device is on
+ *   config  - The address and frequency of the device
+ *   autoinc - Bits or'ed into the register address of accesses of more
+ *             than one register, e.g. 0x80 for ST sensors.  Zero if the
+ *             device always increments the register address.
+ *
+ * Returned Value:
+ *   The register map on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_regmap_s *
+i2c_regmap_create(FAR struct i2c_master_s *i2c,
+                  FAR const struct i2c_config_s *config, uint8_t autoinc);
+
+/****************************************************************************
+ * Name: i2c_regmap_destroy
+ *
+ * Description:
+ *   Free a register map.  Pending cache-only writes are discarded.
+ *
+ ****************************************************************************/
+
+void i2c_regmap_destroy(FAR struct i2c_regmap_s *map);
+
+/****************************************************************************
+ * Name: i2c_regmap_set_volatile
+ *
+ * Description:
+ *   Mark count registers starting at reg as volatile.  Volatile registers
+ *   are never cached: every read and write goes to the bus.
+ *
+ ****************************************************************************/
+
+void i2c_regmap_set_volatile(FAR struct i2c_regmap_s *map, uint8_t reg,
+                             unsigned int count);
+
+/****************************************************************************
+ * Name: i2c_regmap_read / i2c_regmap_bulk_read
+ *
+ * Description:
+ *   Read one or len consecutive registers.  The value comes from the cache
+ *   if all registers are cached; otherwise all of them are read in one
+ *   burst and the cache is refreshed.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int i2c_regmap_read(FAR struct i2c_regmap_s *map, uint8_t reg,
+                    FAR uint8_t *val);
+int i2c_regmap_bulk_read(FAR struct i2c_regmap_s *map, uint8_t reg,
+                         FAR uint8_t *buf, unsigned int len);
+
+/****************************************************************************
+ * Name: i2c_regmap_write / i2c_regmap_bulk_write
+ *
+ * Description:
+ *   Write one or len consecutive registers in one burst.  A write of a
+ *   single cached register with an unchanged value is skipped.  In
+ *   cache-only mode the values of non-volatile registers are only stored
+ *   in the cache and written by i2c_regmap_sync().
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int i2c_regmap_write(FAR struct i2c_regmap_s *map, uint8_t reg,
+                     uint8_t val);
+int i2c_regmap_bulk_write(FAR struct i2c_regmap_s *map, uint8_t reg,
+                          FAR const uint8_t *buf, unsigned int len);
+
+/****************************************************************************
+ * Name: i2c_regmap_update_bits
+ *
+ * Description:
+ *   Read-modify-write the bits selected by mask.  With the register cached
+ *   this costs at most one bus write and none if nothing changes.
+ *
+ ****************************************************************************/
+
+int i2c_regmap_update_bits(FAR struct i2c_regmap_s *map, uint8_t reg,
+                           uint8_t mask, uint8_t val);
+
+/****************************************************************************
+ * Name: i2c_regmap_cache_only
+ *
+ * Description:
+ *   Enter or leave cache-only mode.  Leaving it writes the registers
+ *   changed in the meantime with i2c_regmap_sync().  This batches the
+ *   configuration of a device into a few burst writes.
+ *
+ ****************************************************************************/
+
+int i2c_regmap_cache_only(FAR struct i2c_regmap_s *map, bool enable);
+
+/****************************************************************************
+ * Name: i2c_regmap_sync
+ *
+ * Description:
+ *   Write the registers changed in cache-only mode.  Runs of consecutive
+ *   changed registers are written in one burst.
+ *
+ ****************************************************************************/
+
+int i2c_regmap_sync(FAR struct i2c_regmap_s *map);
+
+/****************************************************************************
+ * Name: i2c_regmap_invalidate
+ *
+ * Description:
+ *   Forget all cached values and pending writes, e.g. after a soft reset
+ *   of the device.
+ *
+ ****************************************************************************/
+
+void i2c_regmap_invalidate(FAR struct i2c_regmap_s *map);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_I2C_REGMAP */
+#endif /* __INCLUDE_NUTTX_I2C_I2C_REGMAP_H */
@@ -0,0 +1,172 @@
+/****************************************************************************
+ * include/nuttx/initcall.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_INITCALL_H
+#define __INCLUDE_NUTTX_INITCALL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef CONFIG_INITCALL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Initcall flags */
+
+#define INITCALL_SYNC  (1 << 0)  /* Must complete before the init task starts */
+
+/* Static initializer of struct initcall_s.  deps is NULL or a NULL
+ * terminated array of the initcalls that must complete first.
+ */
+
+#define INITCALL_INITIALIZER(name, func, arg, deps, flags) \
+  { NULL, (name), (func), (arg), (deps), (flags) }
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef CODE int (*initcall_t)(FAR void *arg);
+
+/* One deferred initialization step, usually the probe of a device that
+ * is slow to come up.  The structure is provided by the caller and must
+ * stay valid until the initcall has completed.
+ */
+
+struct initcall_s
+{
+  FAR struct initcall_s *flink;         /* Supports a singly linked list */
+  FAR const char *name;                 /* Name used in the boot report */
+  initcall_t func;                      /* The initialization function */
+  FAR void *arg;                        /* Argument passed to func */
+  FAR struct initcall_s * const *deps;  /* Initcalls that must run first */
+  uint8_t flags;                        /* See INITCALL_* definitions */
+
+  /* The remaining fields are private to the initcall logic */
+
+  volatile uint8_t state;               /* Pending, running or done */
+  int result;                           /* The value returned by func */
+#ifdef CONFIG_INITCALL_PROFILE
+  uint8_t cpu;                          /* The CPU that ran the initcall */
+  struct timespec start;                /* Start time, since power-up */
+  struct timespec end;                  /* Completion time */
+#endif
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: initcall_register
+ *
+ * Description:
+ *   Register an initcall.  The initcalls run after board_late_initialize()
+ *   returns, on CONFIG_INITCALL_NTHREADS kernel threads, in the order of
+ *   registration as far as their dependencies allow.  With SMP the threads
+ *   can run on all CPUs, so that independent devices are probed in
+ *   parallel.
+ *
+ *   The init task is started as soon as the INITCALL_SYNC initcalls and
+ *   their dependencies are done; the others complete in the background.
+ *
+ * Input Parameters:
+ *   ic - The initcall to register.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EBUSY if the initcalls have already been
+ *   started.
+ *
+ * Assumptions:
+ *   Called from board_early_initialize() or board_late_initialize().
+ *
+ ****************************************************************************/
+
+int initcall_register(FAR struct initcall_s *ic);
+
+/****************************************************************************
+ * Name: initcall_wait
+ *
+ * Description:
+ *   Wait for the completion of an initcall, or of all of them if ic is
+ *   NULL.  Code that uses a device which is brought up by a deferred
+ *   initcall calls this before it accesses the device.
+ *
+ * Input Parameters:
+ *   ic - The initcall to wait for, or NULL.
+ *
+ * Returned Value:
+ *   The value returned by the initcall function, -ECANCELED if it was not
+ *   run because one of its dependencies failed, -EDEADLK if its
+ *   dependencies can never be satisfied or -ENOENT if it was never
+ *   registered.  OK when waiting for all initcalls.
+ *
+ ****************************************************************************/
+
+int initcall_wait(FAR struct initcall_s *ic);
+
+/****************************************************************************
+ * Name: initcall_report
+ *
+ * Description:
+ *   Print to the syslog when each initcall ran, on which CPU and for how
+ *   long.  This is done automatically when the last initcall completes.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_INITCALL_PROFILE
+void initcall_report(void);
+#endif
+
+/****************************************************************************
+ * Name: initcall_run
+ *
+ * Description:
+ *   Start the initcall threads and wait for the INITCALL_SYNC initcalls.
+ *   This is called by the OS bring-up logic and not by board code.
+ *
+ ****************************************************************************/
+
+void initcall_run(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_INITCALL */
+#endif /* __INCLUDE_NUTTX_INITCALL_H */
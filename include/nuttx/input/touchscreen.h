@@ -139,6 +139,12 @@ struct touch_point_s
  * data structure is a struct touch_sample_s that "contains" a set of touch
  * points.  Each touch point is managed individually using an ID that
  * identifies a touch from first contact until the end of the contact.
+ *
+ * Each struct touch_sample_s is one complete report (frame) of the
+ * device.  read() returns as many whole samples as fit in the caller's
+ * buffer, so a reader may collect a batch of reports with a single call;
+ * the size of each one follows from its npoints field.  When the buffer
+ * of the reader overflows, the oldest whole samples are discarded.
  */
 
 struct touch_sample_s
@@ -28,6 +28,7 @@
 #include <nuttx/config.h>
 
 #ifndef __ASSEMBLY__
+# include <sys/types.h>
 # include <stdint.h>
 # include <stdbool.h>
 #endif
@@ -48,6 +49,12 @@
 
 #  define irq_detach(irq) irq_attach(irq, NULL, NULL)
 
+/* The value returned by the top half of a threaded interrupt (see
+ * irq_attach_thread()) to run its bottom half.
+ */
+
+#  define IRQ_WAKE_THREAD 1
+
 /* Maximum/minimum values of IRQ integer types */
 
 #  if NR_IRQS <= 256
@@ -104,6 +111,17 @@ typedef uint32_t irq_mapped_t;
 /* This struct defines the form of an interrupt service routine */
 
 typedef CODE int (*xcpt_t)(int irq, FAR void *context, FAR void *arg);
+
+#ifdef CONFIG_SMP_CSECTION_STATS
+/* This structure holds the critical section statistics of one CPU */
+
+struct csection_stat_s
+{
+  uint32_t acquired;   /* Times g_cpu_irqlock was taken */
+  uint32_t contended;  /* Times the CPU had to wait for g_cpu_irqlock */
+  uint32_t spins;      /* Total failed attempts while waiting */
+};
+#endif
 #endif /* __ASSEMBLY__ */
 
 /****************************************************************************
@@ -148,12 +166,70 @@ extern "C"
 
 int irq_attach(int irq, xcpt_t isr, FAR void *arg);
 
+/****************************************************************************
+ * Name: irq_attach_thread
+ *
+ * Description:
+ *   Configure the IRQ subsystem so that IRQ number 'irq' is serviced by a
+ *   kernel thread of its own with the given priority.  The top half 'isr'
+ *   runs in interrupt context and returns IRQ_WAKE_THREAD to run the
+ *   bottom half 'isrthread' in the thread.  Detach with a NULL
+ *   'isrthread'.
+ *
+ * Returned Value:
+ *   The pid of the thread on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int irq_attach_thread(int irq, xcpt_t isr, xcpt_t isrthread, FAR void *arg,
+                      int priority, int stack_size);
+
+/****************************************************************************
+ * Name: irq_storm
+ *
+ * Description:
+ *   Called by irq_dispatch() when IRQ number 'irq' was taken
+ *   CONFIG_SCHED_IRQMONITOR_STORM times within one second.  The default
+ *   implementation reports the storm and disables the IRQ; boards may
+ *   provide their own policy.
+ *
+ * Input Parameters:
+ *   irq - The IRQ number
+ *
+ * Assumptions:
+ *   Called from interrupt handling logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_IRQMONITOR_STORM) && \
+    CONFIG_SCHED_IRQMONITOR_STORM > 0
+void irq_storm(int irq);
+#endif
+
 #ifdef CONFIG_IRQCHAIN
 int irqchain_detach(int irq, xcpt_t isr, FAR void *arg);
 #else
 #  define irqchain_detach(irq, isr, arg) irq_detach(irq)
 #endif
 
+/****************************************************************************
+ * Name: irq_set_affinity and irq_get_affinity
+ *
+ * Description:
+ *   Set or get the set of CPUs that may service IRQ number 'irq'.  An IRQ
+ *   whose affinity was set explicitly is no longer moved by the IRQ
+ *   balancer (CONFIG_SCHED_IRQBALANCE).
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP) && defined(CONFIG_ARCH_HAVE_IRQAFFINITY)
+int irq_set_affinity(int irq, cpu_set_t cpuset);
+int irq_get_affinity(int irq, FAR cpu_set_t *cpuset);
+#endif
+
 /****************************************************************************
  * Name: enter_critical_section
  *
@@ -219,6 +295,25 @@ void leave_critical_section(irqstate_t flags);
 #  define leave_critical_section(f) up_irq_restore(f)
 #endif
 
+/****************************************************************************
+ * Name: csection_getstat
+ *
+ * Description:
+ *   Return the critical section contention statistics of one CPU.
+ *
+ * Input Parameters:
+ *   cpu  - The index of the CPU
+ *   stat - The location to return the statistics
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_CSECTION_STATS
+void csection_getstat(int cpu, FAR struct csection_stat_s *stat);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,145 @@
+/****************************************************************************
+ * include/nuttx/lib/lz4.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_LIB_LZ4_H
+#define __INCLUDE_NUTTX_LIB_LZ4_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#ifdef CONFIG_LIBC_LZ4
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LZ4_HLOG        CONFIG_LIBC_LZ4_HLOG
+
+/* The largest compressed size of n input bytes */
+
+#define LZ4_BOUND(n)    ((n) + (n) / 255 + 16)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The hash table of the compressor, provided by the caller as with LZF */
+
+typedef uint32_t lz4_state_t[1 << LZ4_HLOG];
+
+/* The state of a streaming decompression.  The compressed data may arrive
+ * in pieces of any size; the decompressed data is delivered to the
+ * output buffer, which must hold the whole block since matches refer back
+ * into it.
+ */
+
+struct lz4_stream_s
+{
+  FAR uint8_t *out;             /* The output buffer */
+  size_t outlen;                /* The size of the output buffer */
+  size_t outpos;                /* Bytes decompressed so far */
+  size_t count;                 /* Literal or match bytes still due */
+  uint16_t offset;              /* Offset of the current match */
+  uint8_t token;                /* The current sequence token */
+  uint8_t state;                /* Decoder state, private */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: lz4_compress
+ *
+ * Description:
+ *   Compress in_len bytes at in_data into an LZ4 block at out_data of at
+ *   most out_len bytes.  The block carries no header; the caller records
+ *   the compressed and uncompressed lengths.  LZ4_BOUND(in_len) bytes of
+ *   output are always enough.
+ *
+ * Returned Value:
+ *   The size of the compressed block, or zero if it does not fit.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress(FAR const void *in_data, size_t in_len,
+                    FAR void *out_data, size_t out_len, lz4_state_t htab);
+
+/****************************************************************************
+ * Name: lz4_decompress
+ *
+ * Description:
+ *   Decompress the LZ4 block of in_len bytes at in_data into out_data.
+ *   The input is fully validated; a corrupt block cannot write outside of
+ *   the output buffer.
+ *
+ * Returned Value:
+ *   The number of decompressed bytes.  Zero is returned with errno set to
+ *   E2BIG if the output buffer is too small, or to EINVAL if the block is
+ *   corrupt.
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress(FAR const void *in_data, size_t in_len,
+                      FAR void *out_data, size_t out_len);
+
+/****************************************************************************
+ * Name: lz4_stream_init, lz4_stream_decompress
+ *
+ * Description:
+ *   Decompress an LZ4 block that is delivered in pieces, e.g. as it is read
+ *   from a file or a network connection, without buffering the compressed
+ *   block.  lz4_stream_decompress() may be called with any number of
+ *   bytes; the decompressed data appears in the output buffer given to
+ *   lz4_stream_init().
+ *
+ * Returned Value:
+ *   lz4_stream_decompress() returns the total number of bytes decompressed
+ *   so far, or a negated errno value:  -E2BIG if the output buffer is too
+ *   small, -EINVAL if the block is corrupt.
+ *
+ ****************************************************************************/
+
+void lz4_stream_init(FAR struct lz4_stream_s *stream, FAR void *out_data,
+                     size_t out_len);
+ssize_t lz4_stream_decompress(FAR struct lz4_stream_s *stream,
+                              FAR const void *in_data, size_t in_len);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_LIBC_LZ4 */
+#endif /* __INCLUDE_NUTTX_LIB_LZ4_H */
@@ -0,0 +1,257 @@
+/****************************************************************************
+ * include/nuttx/lib/sort.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* Type specialized sorting and searching.  qsort() and bsearch() reach
+ * the comparison through a function pointer and move the elements through
+ * generic swaps.  For arrays of a known type, the macros below generate an
+ * introsort and a binary search in which the comparison is inlined and
+ * the elements are moved by assignment.
+ *
+ * Example:
+ *
+ *   #define U32_LESS(a, b) ((a) < (b))
+ *
+ *   SORT_DEFINE(sort_u32, uint32_t, U32_LESS)
+ *   BSEARCH_DEFINE(bsearch_u32, uint32_t, U32_LESS)
+ *
+ * defines
+ *
+ *   static void sort_u32(FAR uint32_t *base, size_t nel);
+ *   static FAR uint32_t *bsearch_u32(uint32_t key,
+ *                                    FAR const uint32_t *base,
+ *                                    size_t nel);
+ *
+ * 'less' may be a macro or a function; for structures it receives the
+ * elements themselves, e.g. #define REC_LESS(a, b) ((a).key < (b).key)
+ */
+
+#ifndef __INCLUDE_NUTTX_LIB_SORT_H
+#define __INCLUDE_NUTTX_LIB_SORT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Partitions smaller than this are finished with an insertion sort */
+
+#define SORT_THRESHOLD 16
+
+#define SORT_SWAP(type, a, b) \
+  do \
+    { \
+      type __tmp = (a); \
+      (a) = (b); \
+      (b) = __tmp; \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Name: SORT_DEFINE
+ *
+ * Description:
+ *   Define static void name(FAR type *base, size_t nel), sorting the array
+ *   in ascending order of less(a, b).  The sort is not stable.  It is a
+ *   median-of-three quicksort that falls back to a heapsort after
+ *   2 * log2(nel) levels, and to an insertion sort for small partitions.
+ *
+ ****************************************************************************/
+
+#define SORT_DEFINE(name, type, less) \
+  static void name##_heapsort(FAR type *base, size_t nel) \
+  { \
+    size_t root; \
+    size_t child; \
+    size_t end = nel; \
+    size_t i = nel / 2; \
+    type tmp; \
+    \
+    for (; ; ) \
+      { \
+        if (i > 0) \
+          { \
+            root = --i; \
+          } \
+        else if (--end > 0) \
+          { \
+            SORT_SWAP(type, base[0], base[end]); \
+            root = 0; \
+          } \
+        else \
+          { \
+            break; \
+          } \
+        \
+        tmp = base[root]; \
+        while ((child = 2 * root + 1) < end) \
+          { \
+            if (child + 1 < end && less(base[child], base[child + 1])) \
+              { \
+                child++; \
+              } \
+            \
+            if (!less(tmp, base[child])) \
+              { \
+                break; \
+              } \
+            \
+            base[root] = base[child]; \
+            root = child; \
+          } \
+        \
+        base[root] = tmp; \
+      } \
+  } \
+  \
+  static void name##_introsort(FAR type *base, size_t nel, int depth) \
+  { \
+    size_t i; \
+    size_t j; \
+    type pivot; \
+    type tmp; \
+    \
+    while (nel > SORT_THRESHOLD) \
+      { \
+        if (depth-- <= 0) \
+          { \
+            name##_heapsort(base, nel); \
+            return; \
+          } \
+        \
+        i = nel / 2; \
+        j = nel - 1; \
+        if (less(base[i], base[0])) \
+          { \
+            SORT_SWAP(type, base[i], base[0]); \
+          } \
+        \
+        if (less(base[j], base[i])) \
+          { \
+            SORT_SWAP(type, base[j], base[i]); \
+            if (less(base[i], base[0])) \
+              { \
+                SORT_SWAP(type, base[i], base[0]); \
+              } \
+          } \
+        \
+        pivot = base[i]; \
+        i = 0; \
+        for (; ; ) \
+          { \
+            do \
+              { \
+                i++; \
+              } \
+            while (less(base[i], pivot)); \
+            \
+            do \
+              { \
+                j--; \
+              } \
+            while (less(pivot, base[j])); \
+            \
+            if (i >= j) \
+              { \
+                break; \
+              } \
+            \
+            SORT_SWAP(type, base[i], base[j]); \
+          } \
+        \
+        j++; \
+        if (j < nel - j) \
+          { \
+            name##_introsort(base, j, depth); \
+            base += j; \
+            nel  -= j; \
+          } \
+        else \
+          { \
+            name##_introsort(base + j, nel - j, depth); \
+            nel = j; \
+          } \
+      } \
+    \
+    for (i = 1; i < nel; i++) \
+      { \
+        tmp = base[i]; \
+        for (j = i; j > 0 && less(tmp, base[j - 1]); j--) \
+          { \
+            base[j] = base[j - 1]; \
+          } \
+        \
+        base[j] = tmp; \
+      } \
+  } \
+  \
+  static void name(FAR type *base, size_t nel) \
+  { \
+    size_t n; \
+    int depth = 0; \
+    \
+    for (n = nel; n > 1; n >>= 1) \
+      { \
+        depth += 2; \
+      } \
+    \
+    name##_introsort(base, nel, depth); \
+  }
+
+/****************************************************************************
+ * Name: BSEARCH_DEFINE
+ *
+ * Description:
+ *   Define static FAR type *name(type key, FAR const type *base,
+ *   size_t nel), returning the first element of the sorted array that is
+ *   equivalent to key, or NULL if there is none.
+ *
+ ****************************************************************************/
+
+#define BSEARCH_DEFINE(name, type, less) \
+  static FAR type *name(type key, FAR const type *base, size_t nel) \
+  { \
+    FAR const type *end = base + nel; \
+    size_t half; \
+    \
+    while (nel > 0) \
+      { \
+        half = nel / 2; \
+        if (less(base[half], key)) \
+          { \
+            base += half + 1; \
+            nel  -= half + 1; \
+          } \
+        else \
+          { \
+            nel = half; \
+          } \
+      } \
+    \
+    return base < end && !less(key, *base) ? (FAR type *)base : NULL; \
+  }
+
+#endif /* __INCLUDE_NUTTX_LIB_SORT_H */
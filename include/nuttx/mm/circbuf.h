@@ -24,8 +24,9 @@
 /* Note about locking: There is no locking required while only one reader
  * and one writer is using the circular buffer.
  * For multiple writer and one reader there is only a need to lock the
- * writer. And vice versa for only one writer and multiple reader there is
- * only a need to lock the reader.
+ * writer, or to use circbuf_mpsc_write() for all of the writes. And vice
+ * versa for only one writer and multiple reader there is only a need to
+ * lock the reader.
  */
 
 /****************************************************************************
@@ -47,6 +48,7 @@ struct circbuf_s
   size_t    size;     /* The size of buffer space */
   size_t    head;     /* The head of buffer space */
   size_t    tail;     /* The tail of buffer space */
+  size_t    reserve;  /* The head reserved by circbuf_mpsc_write */
   bool      external; /* The flag for external buffer */
 };
 
@@ -301,6 +303,96 @@ ssize_t circbuf_write(FAR struct circbuf_s *circ,
 ssize_t circbuf_overwrite(FAR struct circbuf_s *circ,
                            FAR const void *src, size_t bytes);
 
+/****************************************************************************
+ * Name: circbuf_mpsc_write
+ *
+ * Description:
+ *   Write data to the circular buffer, from any number of concurrent
+ *   writers and without a lock.
+ *
+ * Note:
+ *   All of the writers of a buffer must use this function; the reader
+ *   may use any of the read functions.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   src   - The data to be added.
+ *   bytes - Number of bytes to be added.
+ *
+ * Returned Value:
+ *   The bytes of get data is returned if the write data is successful;
+ *   A negated errno value is returned on any failure.
+ ****************************************************************************/
+
+ssize_t circbuf_mpsc_write(FAR struct circbuf_s *circ,
+                           FAR const void *src, size_t bytes);
+
+/****************************************************************************
+ * Name: circbuf_get_writeptr
+ *
+ * Description:
+ *   Get the contiguous free space at the head of the circular buffer, so
+ *   that the writer can fill it in place and commit it with
+ *   circbuf_writecommit().
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   size  - Returns the number of contiguous free bytes.
+ *
+ * Returned Value:
+ *   The address of the free space.
+ ****************************************************************************/
+
+FAR void *circbuf_get_writeptr(FAR struct circbuf_s *circ,
+                               FAR size_t *size);
+
+/****************************************************************************
+ * Name: circbuf_writecommit
+ *
+ * Description:
+ *   Commit the bytes written to the space returned by
+ *   circbuf_get_writeptr().
+ *
+ * Input Parameters:
+ *   circ        - Address of the circular buffer to be used.
+ *   writtensize - The number of bytes written.
+ ****************************************************************************/
+
+void circbuf_writecommit(FAR struct circbuf_s *circ, size_t writtensize);
+
+/****************************************************************************
+ * Name: circbuf_get_readptr
+ *
+ * Description:
+ *   Get the contiguous data at the tail of the circular buffer, so that
+ *   the reader can use it in place and release it with
+ *   circbuf_readcommit().
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   size  - Returns the number of contiguous bytes.
+ *
+ * Returned Value:
+ *   The address of the data.
+ ****************************************************************************/
+
+FAR void *circbuf_get_readptr(FAR struct circbuf_s *circ,
+                              FAR size_t *size);
+
+/****************************************************************************
+ * Name: circbuf_readcommit
+ *
+ * Description:
+ *   Release the bytes consumed from the data returned by
+ *   circbuf_get_readptr().
+ *
+ * Input Parameters:
+ *   circ     - Address of the circular buffer to be used.
+ *   readsize - The number of bytes consumed.
+ ****************************************************************************/
+
+void circbuf_readcommit(FAR struct circbuf_s *circ, size_t readsize);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -62,9 +62,9 @@ typedef FAR void *GRAN_HANDLE;
 struct graninfo_s
 {
   uint8_t   log2gran;  /* Log base 2 of the size of one granule */
-  uint16_t  ngranules; /* The total number of (aligned) granules in the heap */
-  uint16_t  nfree;     /* The number of free granules */
-  uint16_t  mxfree;    /* The longest sequence of free granules */
+  uint32_t  ngranules; /* The total number of (aligned) granules in the heap */
+  uint32_t  nfree;     /* The number of free granules */
+  uint32_t  mxfree;    /* The longest sequence of free granules */
 };
 
 /****************************************************************************
@@ -110,10 +110,6 @@ extern "C"
  *   The actual memory allocates will be 64 byte (wasting 17 bytes) and
  *   will be aligned at least to (1 << log2align).
  *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 granules.  That restriction could be eliminated with some
- *   additional coding effort.
- *
  * Input Parameters:
  *   heapstart - Start of the granule allocation heap
  *   heapsize  - Size of heap in bytes
@@ -182,9 +178,7 @@ void gran_reserve(GRAN_HANDLE handle, uintptr_t start, size_t size);
  * Description:
  *   Allocate memory from the granule heap.
  *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 granules.  That restriction could be eliminated with some
- *   additional coding effort.
+ *   Allocations may span any number of granules.
  *
  * Input Parameters:
  *   handle - The handle previously returned by gran_initialize
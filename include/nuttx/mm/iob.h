@@ -70,10 +70,55 @@
 #  error CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
 #endif
 
+/* Optional pools of small and large I/O buffers.  They are used only by
+ * iob_alloc_size(); all other allocations come from the default pool of
+ * CONFIG_IOB_BUFSIZE buffers.
+ */
+
+#ifndef CONFIG_IOB_SMALL_NBUFFERS
+#  define CONFIG_IOB_SMALL_NBUFFERS 0
+#endif
+
+#ifndef CONFIG_IOB_LARGE_NBUFFERS
+#  define CONFIG_IOB_LARGE_NBUFFERS 0
+#endif
+
+#if CONFIG_IOB_SMALL_NBUFFERS > 0 || CONFIG_IOB_LARGE_NBUFFERS > 0
+#  define IOB_HAVE_CLASSES 1
+#endif
+
+#if CONFIG_IOB_SMALL_NBUFFERS > 0 && \
+    CONFIG_IOB_SMALL_BUFSIZE >= CONFIG_IOB_BUFSIZE
+#  error CONFIG_IOB_SMALL_BUFSIZE must be less than CONFIG_IOB_BUFSIZE
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0 && \
+    CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#  error CONFIG_IOB_LARGE_BUFSIZE must be greater than CONFIG_IOB_BUFSIZE
+#endif
+
+#if CONFIG_IOB_BUFSIZE >= 256 || \
+    (CONFIG_IOB_LARGE_NBUFFERS > 0 && CONFIG_IOB_LARGE_BUFSIZE >= 256)
+#  define IOB_HAVE_LARGE_LEN 1
+#endif
+
+/* The buffer classes, from the smallest to the largest */
+
+#define IOB_CLASS_SMALL   0
+#define IOB_CLASS_DEFAULT 1
+#define IOB_CLASS_LARGE   2
+#define IOB_NCLASSES      3
+
 /* IOB helpers */
 
+#ifdef IOB_HAVE_CLASSES
+#  define IOB_BUFSIZE(p) ((p)->io_bufsize)
+#else
+#  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
+#endif
+
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -99,7 +144,7 @@ struct iob_s
 
   /* Payload */
 
-#if CONFIG_IOB_BUFSIZE < 256
+#ifndef IOB_HAVE_LARGE_LEN
   uint8_t  io_len;      /* Length of the data in the entry */
   uint8_t  io_offset;   /* Data begins at this offset */
 #else
@@ -108,7 +153,13 @@ struct iob_s
 #endif
   unsigned int io_pktlen; /* Total length of the packet */
 
+#ifdef IOB_HAVE_CLASSES
+  uint16_t io_bufsize;  /* Size of the data buffer */
+  uint8_t  io_class;    /* Pool the buffer belongs to, IOB_CLASS_* */
+  FAR uint8_t *io_data; /* The data buffer, stored apart from the header */
+#else
   uint8_t  io_data[CONFIG_IOB_BUFSIZE];
+#endif
 };
 
 #if CONFIG_IOB_NCHAINS > 0
@@ -208,6 +259,12 @@ enum iob_user_e
 #endif
 #ifdef CONFIG_NET_CAN
   IOBUSER_NET_CAN_READAHEAD,
+#endif
+#ifdef CONFIG_NETDEV_IOB
+  IOBUSER_NET_NETDEV,
+#endif
+#if defined(CONFIG_NET_ARP) && CONFIG_NET_ARP_NHOLD > 0
+  IOBUSER_NET_ARP_HOLD,
 #endif
   IOBUSER_GLOBAL,
   IOBUSER_NENTRIES /* MUST BE LAST ENTRY */
@@ -219,6 +276,17 @@ struct iob_userstats_s
   int totalproduced;
 };
 
+/* Usage of one buffer class, see iob_getclassstats() */
+
+struct iob_classstats_s
+{
+  uint16_t bufsize;     /* Payload size of the buffers in the class */
+  int nbuffers;         /* Number of buffers in the class */
+  int navail;           /* Number of those that are free */
+  unsigned int nalloc;  /* Buffers handed out by iob_alloc_size() */
+  unsigned int nspill;  /* ... of which the best fitting class was empty */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -282,6 +350,48 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid);
 
 int iob_navail(bool throttled);
 
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer for a packet of about 'size' bytes.  The buffer
+ *   is taken from the smallest class whose buffers hold 'size' bytes or,
+ *   if that class is exhausted, from the next larger one.  Without
+ *   CONFIG_IOB_SMALL_NBUFFERS or CONFIG_IOB_LARGE_NBUFFERS this is the
+ *   same as iob_alloc().
+ *
+ *   The small and large pools are never waited on: when no buffer is free
+ *   in them the request falls back to the default pool and iob_alloc(),
+ *   which may block.  The returned buffer may therefore be smaller than
+ *   'size'; use IOB_BUFSIZE() and chain more buffers as usual.
+ *
+ * Input Parameters:
+ *   size       - The expected payload size.
+ *   throttled  - An indication of the IOB allocation is "throttled"
+ *   consumerid - id representing who is consuming the IOB
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_size(unsigned int size, bool throttled,
+                                 enum iob_user_e consumerid);
+
+/****************************************************************************
+ * Name: iob_getclassstats
+ *
+ * Description:
+ *   Return the usage of one buffer class.
+ *
+ * Input Parameters:
+ *   ioclass - One of IOB_CLASS_SMALL, IOB_CLASS_DEFAULT or IOB_CLASS_LARGE
+ *   stats   - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success; -ENOENT if the class is not configured.
+ *
+ ****************************************************************************/
+
+int iob_getclassstats(int ioclass, FAR struct iob_classstats_s *stats);
+
 /****************************************************************************
  * Name: iob_qentry_navail
  *
@@ -467,6 +577,18 @@ void iob_free_queue_qentry(FAR struct iob_s *iob,
 unsigned int iob_get_queue_size(FAR struct iob_queue_s *queue);
 #endif /* CONFIG_IOB_NCHAINS > 0 */
 
+/****************************************************************************
+ * Name: iob_get_queue_count
+ *
+ * Description:
+ *   Queue helper for get the number of I/O buffers in the iob queue.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_NCHAINS > 0
+unsigned int iob_get_queue_count(FAR struct iob_queue_s *queue);
+#endif /* CONFIG_IOB_NCHAINS > 0 */
+
 /****************************************************************************
  * Name: iob_copyin
  *
@@ -517,6 +639,16 @@ int iob_copyout(FAR uint8_t *dest, FAR const struct iob_s *iob,
 
 unsigned int iob_tailroom(FAR struct iob_s *iob);
 
+/****************************************************************************
+ * Name: iob_count
+ *
+ * Description:
+ *  Return the number of I/O buffers in the I/O buffer chain.
+ *
+ ****************************************************************************/
+
+unsigned int iob_count(FAR struct iob_s *iob);
+
 /****************************************************************************
  * Name: iob_clone
  *
@@ -29,6 +29,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -92,12 +93,48 @@
 #  undef CONFIG_MM_KERNEL_HEAP
 #endif
 
+/* The free chunks reported by mm_fraginfo() are grouped by the power of
+ * two of their size: bucket n holds the chunks of 2^n to 2^(n+1) - 1
+ * bytes.  These are the free lists of the default allocator, bucket n is
+ * mm_nodelist[n - MM_MIN_SHIFT].
+ */
+
+#define MM_FRAG_NBUCKETS 32
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
 struct mm_heap_s; /* Forward reference */
 
+/* The free space of a heap as reported by mm_fraginfo() */
+
+struct mm_fraginfo_s
+{
+  size_t nfree;                       /* Number of free chunks */
+  size_t freesize;                    /* Total size of the free chunks */
+  size_t largest;                     /* Size of the largest free chunk */
+  size_t nused;                       /* Number of allocated chunks */
+  size_t count[MM_FRAG_NBUCKETS];     /* Free chunks per bucket */
+  size_t size[MM_FRAG_NBUCKETS];      /* Their total size */
+};
+
+#ifdef CONFIG_MM_TRACE
+/* One call site of the sampling allocation tracer, as reported by
+ * mm_trace_getsite().  The byte counts are estimates: each sample stands
+ * for CONFIG_MM_TRACE_PERIOD bytes, or for its own size if larger.
+ */
+
+struct mm_tracesite_s
+{
+  FAR void *backtrace[CONFIG_MM_TRACE_DEPTH]; /* Zero terminated if short */
+  size_t nalloc;                      /* Samples taken at this site */
+  size_t nlive;                       /* Samples not freed yet */
+  size_t live;                        /* Estimated live bytes */
+  size_t snapshot;                    /* Live bytes at mm_trace_snapshot() */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -200,11 +237,19 @@ size_t kmm_malloc_size(FAR void *mem);
 /* Functions contained in mm_free.c *****************************************/
 
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_free_delaylist(FAR struct mm_heap_s *heap);
+
+/* Functions contained in umm_free.c ****************************************/
+
+void umm_free_delaylist(void);
 
 /* Functions contained in kmm_free.c ****************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 void kmm_free(FAR void *mem);
+void kmm_free_delaylist(void);
+#else
+#define kmm_free_delaylist()  umm_free_delaylist()
 #endif
 
 /* Functions contained in mm_realloc.c **************************************/
@@ -311,6 +356,17 @@ struct mallinfo_task kmm_mallinfo_task(pid_t pid);
 #  endif
 #endif
 
+/* Functions contained in mm_fraginfo.c *************************************/
+
+int mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info);
+
+/* Functions contained in mm_trace.c ****************************************/
+
+#ifdef CONFIG_MM_TRACE
+int mm_trace_getsite(int index, FAR struct mm_tracesite_s *site);
+void mm_trace_snapshot(void);
+#endif
+
 /* Functions contained in mm_memdump.c **************************************/
 
 void mm_memdump(FAR struct mm_heap_s *heap, pid_t pid);
@@ -0,0 +1,201 @@
+/****************************************************************************
+ * include/nuttx/mm/slab.h
+ * Slab allocator for fixed-size kernel objects.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_SLAB_H
+#define __INCLUDE_NUTTX_MM_SLAB_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <queue.h>
+
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Configuration ************************************************************/
+
+/* CONFIG_MM_SLAB - Enable the slab allocator
+ * CONFIG_MM_SLAB_SIZE - The size of one slab.  Must be a power of two;
+ *   slabs are aligned to their size so that the owning slab of an object
+ *   can be found by masking the object address.
+ * CONFIG_MM_SLAB_ALIGN - Minimum alignment of every object, normally the
+ *   size of a data cache line.
+ */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This describes one cache of equally sized objects.  The content is
+ * private to the slab allocator; it is exposed only so that caches can be
+ * statically allocated.
+ */
+
+struct slab_cache_s
+{
+  FAR struct slab_cache_s *sc_flink; /* Link in the list of all caches */
+  FAR const char *sc_name;           /* Name shown in /proc/slabinfo */
+  size_t sc_size;                    /* Object size as requested */
+
+  size_t sc_objsize;                 /* Object size rounded to alignment */
+  uint16_t sc_hdrsize;               /* Size of the slab header */
+  uint16_t sc_nobjs;                 /* Objects per slab */
+  dq_queue_t sc_partial;             /* Slabs with at least one free object */
+  dq_queue_t sc_full;                /* Slabs without free objects */
+  spinlock_t sc_lock;                /* Protects the lists and statistics */
+
+  /* Statistics */
+
+  size_t sc_nslabs;                  /* Number of slabs */
+  size_t sc_inuse;                   /* Number of objects allocated */
+  size_t sc_allocs;                  /* Total number of allocations */
+  size_t sc_fails;                   /* Number of failed allocations */
+};
+
+/* Form in which the state of one cache is returned by slab_foreach() */
+
+struct slabinfo_s
+{
+  FAR const char *name;              /* Name of the cache */
+  size_t objsize;                    /* Object size (including padding) */
+  size_t nobjs;                      /* Objects per slab */
+  size_t nslabs;                     /* Number of slabs */
+  size_t inuse;                      /* Number of objects allocated */
+  size_t allocs;                     /* Total number of allocations */
+  size_t fails;                      /* Number of failed allocations */
+};
+
+typedef CODE void (*slab_handler_t)(FAR const struct slabinfo_s *info,
+                                    FAR void *arg);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: slab_initialize
+ *
+ * Description:
+ *   Set up one slab cache for objects of the given size and register it
+ *   so that it is reported in /proc/slabinfo.  No memory is allocated
+ *   until the first object is allocated.
+ *
+ *   Usage Summary:
+ *
+ *     static struct slab_cache_s g_foocache;
+ *
+ *     slab_initialize(&g_foocache, "foo", sizeof(struct foo_s));
+ *     foo = slab_alloc(&g_foocache);
+ *     ...
+ *     slab_free(&g_foocache, foo);
+ *
+ * Input Parameters:
+ *   cache - The cache instance to initialize
+ *   name  - The name of the cache.  The string must persist.
+ *   size  - The size of one object
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value if the object size is too
+ *   large to fit into a slab.
+ *
+ ****************************************************************************/
+
+int slab_initialize(FAR struct slab_cache_s *cache, FAR const char *name,
+                    size_t size);
+
+/****************************************************************************
+ * Name: slab_alloc
+ *
+ * Description:
+ *   Allocate one object from the cache.  This may be called from interrupt
+ *   handlers, but then will fail if no slab has a free object since new
+ *   slabs can't be taken from the heap at interrupt level.
+ *
+ * Input Parameters:
+ *   cache - The cache to allocate from
+ *
+ * Returned Value:
+ *   On success, a non-NULL pointer to an object aligned to at least
+ *   CONFIG_MM_SLAB_ALIGN is returned; NULL is returned on failure.
+ *
+ ****************************************************************************/
+
+FAR void *slab_alloc(FAR struct slab_cache_s *cache);
+
+/****************************************************************************
+ * Name: slab_free
+ *
+ * Description:
+ *   Return one object to the cache it was allocated from.
+ *
+ * Input Parameters:
+ *   cache - The cache the object was allocated from
+ *   obj   - The object to free
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void slab_free(FAR struct slab_cache_s *cache, FAR void *obj);
+
+/****************************************************************************
+ * Name: slab_foreach
+ *
+ * Description:
+ *   Call the handler with the statistics of each registered cache.
+ *
+ * Input Parameters:
+ *   handler - The function to call for each cache
+ *   arg     - An opaque argument passed to the handler
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void slab_foreach(slab_handler_t handler, FAR void *arg);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_MM_SLAB */
+#endif /* __INCLUDE_NUTTX_MM_SLAB_H */
@@ -92,6 +92,10 @@ struct mqueue_inode_s
   int16_t nmsgs;              /* Number of message in the queue */
   int16_t nwaitnotfull;       /* Number tasks waiting for not full */
   int16_t nwaitnotempty;      /* Number tasks waiting for not empty */
+#ifdef CONFIG_MQ_QUEUE_POOL
+  sq_queue_t msgfree;         /* Free messages preallocated for the queue */
+  FAR void *msgpool;          /* Memory of the preallocated messages */
+#endif
 #if CONFIG_MQ_MAXMSGSIZE < 256
   uint8_t maxmsgsize;         /* Max size of message in message queue */
 #else
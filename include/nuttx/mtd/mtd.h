@@ -84,6 +84,21 @@
 #define MTD_WRITE(d,s,n,b) ((d)->write   ? (d)->write(d,s,n,b)  : (-ENOSYS))
 #define MTD_IOCTL(d,c,a)   ((d)->ioctl   ? (d)->ioctl(d,c,a)    : (-ENOSYS))
 
+/* With CONFIG_FS_IOSTAT, the transfers and erases are accounted in the
+ * I/O statistics, see include/nuttx/fs/iostat.h.
+ */
+
+#ifdef CONFIG_FS_IOSTAT
+#  undef  MTD_ERASE
+#  undef  MTD_BREAD
+#  undef  MTD_BWRITE
+#  undef  MTD_READ
+#  define MTD_ERASE(d,s,n)    mtd_iostat_erase(d,s,n)
+#  define MTD_BREAD(d,s,n,b)  mtd_iostat_bread(d,s,n,b)
+#  define MTD_BWRITE(d,s,n,b) mtd_iostat_bwrite(d,s,n,b)
+#  define MTD_READ(d,s,n,b)   mtd_iostat_read(d,s,n,b)
+#endif
+
 /* If any of the low-level device drivers declare they want sub-sector erase
  * support, then define MTD_SUBSECTOR_ERASE.
  */
@@ -206,6 +221,28 @@ extern "C"
 
 /* MTD Support **************************************************************/
 
+#ifdef CONFIG_FS_IOSTAT
+/****************************************************************************
+ * Name: mtd_iostat_erase, mtd_iostat_bread, mtd_iostat_bwrite and
+ *       mtd_iostat_read
+ *
+ * Description:
+ *   Call the method of an MTD driver and account the operation in the I/O
+ *   statistics.  These implement the MTD_ERASE(), MTD_BREAD(),
+ *   MTD_BWRITE() and MTD_READ() macros with CONFIG_FS_IOSTAT.
+ *
+ ****************************************************************************/
+
+int mtd_iostat_erase(FAR struct mtd_dev_s *dev, off_t startblock,
+                     size_t nblocks);
+ssize_t mtd_iostat_bread(FAR struct mtd_dev_s *dev, off_t startblock,
+                         size_t nblocks, FAR uint8_t *buffer);
+ssize_t mtd_iostat_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
+                          size_t nblocks, FAR const uint8_t *buffer);
+ssize_t mtd_iostat_read(FAR struct mtd_dev_s *dev, off_t offset,
+                        size_t nbytes, FAR uint8_t *buffer);
+#endif
+
 /****************************************************************************
  * Name: mtd_partition
  *
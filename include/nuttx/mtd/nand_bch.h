@@ -0,0 +1,123 @@
+/****************************************************************************
+ * include/nuttx/mtd/nand_bch.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MTD_NAND_BCH_H
+#define __INCLUDE_NUTTX_MTD_NAND_BCH_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#ifdef CONFIG_MTD_NAND_SWECC_BCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The BCH code works over GF(2^13) on 512 byte steps of the page data area
+ * and corrects up to CONFIG_MTD_NAND_BCH_STRENGTH bit errors per step.
+ */
+
+#ifndef CONFIG_MTD_NAND_BCH_STRENGTH
+#  define CONFIG_MTD_NAND_BCH_STRENGTH 4
+#endif
+
+#define NANDBCH_STEPSIZE  512
+#define NANDBCH_ECCBITS   (13 * CONFIG_MTD_NAND_BCH_STRENGTH)
+#define NANDBCH_ECCBYTES  ((NANDBCH_ECCBITS + 7) / 8)
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: nandbch_initialize
+ *
+ * Description:
+ *   Build the generator polynomial and the encoder lookup table.  This must
+ *   be called once before any other BCH function; later calls do nothing.
+ *
+ ****************************************************************************/
+
+void nandbch_initialize(void);
+
+/****************************************************************************
+ * Name: nandbch_compute512x
+ *
+ * Description:
+ *   Computes NANDBCH_ECCBYTES of BCH code for each 512 byte step of a data
+ *   block whose size is a multiple of 512 bytes.  The code of an erased
+ *   (all 0xff) step is all 0xff as well.
+ *
+ * Input Parameters:
+ *   data - Data to compute code for
+ *   size - Data size in bytes
+ *   code - Codes buffer, (size / 512) * NANDBCH_ECCBYTES bytes
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nandbch_compute512x(FAR const uint8_t *data, size_t size,
+                         FAR uint8_t *code);
+
+/****************************************************************************
+ * Name: nandbch_verify512x
+ *
+ * Description:
+ *   Verifies and, where possible, corrects in place a data block whose size
+ *   is a multiple of 512 bytes against the codes computed by
+ *   nandbch_compute512x().
+ *
+ * Input Parameters:
+ *   data - Data buffer to verify
+ *   size - Data size in bytes
+ *   code - Original codes
+ *
+ * Returned Value:
+ *   The number of corrected bit errors on success; -EBADMSG if any step
+ *   holds more errors than the code can correct.
+ *
+ ****************************************************************************/
+
+int nandbch_verify512x(FAR uint8_t *data, size_t size,
+                       FAR const uint8_t *code);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_MTD_NAND_SWECC_BCH */
+#endif /* __INCLUDE_NUTTX_MTD_NAND_BCH_H */
@@ -71,6 +71,13 @@
 #define COMMAND_STATUS                  0x70
 #define COMMAND_RESET                   0xff
 
+/* Nand flash commands (cache and multi-plane operations) */
+
+#define COMMAND_CACHE_READ              0x31
+#define COMMAND_CACHE_READ_END          0x3f
+#define COMMAND_CACHE_WRITE_2           0x15
+#define COMMAND_MULTIPLANE_WRITE_2      0x11
+
 /* Nand flash commands (small blocks) */
 
 #define COMMAND_READ_A                  0x00
@@ -226,6 +233,56 @@
 #  define NAND_WRITEPAGE(r,b,p,d,s) ((r)->rawwrite(r,b,p,d,s))
 #endif
 
+/****************************************************************************
+ * Name: NAND_READPAGES
+ *
+ * Description:
+ *   Reads the data area of several consecutive pages of one block into the
+ *   provided buffer, for example using the cache read or multi-plane read
+ *   commands of the part.  Hardware ECC checking will be performed if so
+ *   configured.  This method is optional.
+ *
+ * Input Parameters:
+ *   raw    - Lower-half, raw NAND FLASH interface
+ *   block  - Number of the block where the pages to read reside.
+ *   page   - Number of the first page to read inside the given block.
+ *   npages - Number of pages to read, all inside the given block.
+ *   data   - Buffer where the data areas will be stored.
+ *
+ * Returned Value:
+ *   OK is returned in success; a negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_NAND_MULTIPAGE
+#  define NAND_READPAGES(r,b,p,n,d) ((r)->readpages(r,b,p,n,d))
+#endif
+
+/****************************************************************************
+ * Name: NAND_WRITEPAGES
+ *
+ * Description:
+ *   Writes the data area of several consecutive pages of one block, for
+ *   example using the cache program or multi-plane program commands of the
+ *   part.  Hardware ECC will be generated if so configured.  This method is
+ *   optional.
+ *
+ * Input Parameters:
+ *   raw    - Lower-half, raw NAND FLASH interface
+ *   block  - Number of the block where the pages to write reside.
+ *   page   - Number of the first page to write inside the given block.
+ *   npages - Number of pages to write, all inside the given block.
+ *   data   - Buffer containing the data to be written
+ *
+ * Returned Value:
+ *   OK is returned in success; a negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_NAND_MULTIPAGE
+#  define NAND_WRITEPAGES(r,b,p,n,d) ((r)->writepages(r,b,p,n,d))
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -262,6 +319,17 @@ struct nand_raw_s
                         FAR const void *spare);
 #endif
 
+#ifdef CONFIG_MTD_NAND_MULTIPAGE
+  /* Optional multi-page operations, NULL if not supported */
+
+  CODE int (*readpages)(FAR struct nand_raw_s *raw, off_t block,
+                        unsigned int page, unsigned int npages,
+                        FAR void *data);
+  CODE int (*writepages)(FAR struct nand_raw_s *raw, off_t block,
+                         unsigned int page, unsigned int npages,
+                         FAR const void *data);
+#endif
+
 #if defined(CONFIG_MTD_NAND_SWECC) || defined(CONFIG_MTD_NAND_HWECC)
   /* ECC working buffers */
 
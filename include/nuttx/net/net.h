@@ -246,6 +246,9 @@ struct socket_conn_s
 #ifdef CONFIG_NET_TIMESTAMP
   int32_t       s_timestamp; /* Socket timestamp enabled/disabled */
 #endif
+#ifdef CONFIG_NET_TIMESTAMPING
+  uint32_t      s_tstamping; /* SOF_TIMESTAMPING_* flags */
+#endif
 #endif
 
   /* Connection-specific content may follow */
@@ -875,6 +878,68 @@ ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends several messages to a socket with the network
+ *   locked only once.  This is an internal OS interface.  It is
+ *   functionally equivalent to sendmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    The messages to send
+ *   vlen      The number of messages in msgvec
+ *   flags     Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  Otherwise, if not
+ *   even the first message could be sent, a negated errno value is
+ *   returned (see comments with sendmsg() for a list of appropriate errno
+ *   values).
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives several messages from a socket with the
+ *   network locked only once.  This is an internal OS interface.  It is
+ *   functionally equivalent to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Buffers to receive the messages
+ *   vlen      The number of messages in msgvec
+ *   flags     Receive flags
+ *   timeout   Time after which no more messages are waited for, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  Otherwise, if
+ *   not even the first message could be received, a negated errno value
+ *   is returned (see comments with recvmsg() for a list of appropriate
+ *   errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
 /****************************************************************************
  * Name: psock_send
  *
@@ -53,6 +53,7 @@
 #include <sys/ioctl.h>
 #include <stdint.h>
 #include <queue.h>
+#include <time.h>
 
 #include <net/if.h>
 #include <net/ethernet.h>
@@ -153,6 +154,50 @@
 #  define NETDEV_ERRORS(dev)
 #endif
 
+/* Offload features that a driver may advertise in d_features.  They are
+ * set by the driver before the device is registered.
+ *
+ *   NETDEV_F_TXCSUM - The device inserts the TCP and UDP checksums and the
+ *     IPv4 header checksum of outgoing TCP and UDP packets.  The network
+ *     leaves these checksum fields zero.
+ *   NETDEV_F_RXCSUM - The device validates the IPv4 header checksum and
+ *     the TCP and UDP checksums of received packets and does not pass
+ *     packets with bad checksums to the network.
+ *   NETDEV_F_TSO - The device cuts outgoing TCP packets that are larger
+ *     than d_pktsize into segments of d_tsomss payload bytes, repeating
+ *     the headers with the sequence numbers, lengths, IPv4 ID and
+ *     checksums fixed up.  TCP then produces packets of up to d_tsosize
+ *     bytes, so d_buf must be that large.  NETDEV_F_TSO requires
+ *     NETDEV_F_TXCSUM.
+ *   NETDEV_F_GRO - The driver receives in I/O buffers and calls
+ *     netdev_gro_flush() when it has no more received packets to process,
+ *     so TCP may hold a received segment back to merge the following
+ *     segments of the same connection into it (CONFIG_NET_TCP_GRO).
+ */
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+#  define NETDEV_F_TXCSUM         (1 << 0)
+#  define NETDEV_F_RXCSUM         (1 << 1)
+#  define NETDEV_F_TSO            (1 << 2)
+#  define NETDEV_F_GRO            (1 << 3)
+
+#  define NETDEV_HAS_FEATURE(dev,f) (((dev)->d_features & (f)) != 0)
+#else
+#  define NETDEV_HAS_FEATURE(dev,f) (false)
+#endif
+
+/* The largest outgoing packet that the device accepts, including the link
+ * layer header.
+ */
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+#  define NETDEV_TXSIZE(dev) \
+     (NETDEV_HAS_FEATURE(dev, NETDEV_F_TSO) ? \
+      (dev)->d_tsosize : NETDEV_PKTSIZE(dev))
+#else
+#  define NETDEV_TXSIZE(dev)      NETDEV_PKTSIZE(dev)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -221,6 +266,9 @@ struct netdev_varaddr_s
  */
 
 struct devif_callback_s; /* Forward reference */
+#ifdef CONFIG_NETDEV_IOB
+struct iob_s;            /* Forward reference See iob.h */
+#endif
 
 struct net_driver_s
 {
@@ -256,6 +304,14 @@ struct net_driver_s
 
   uint16_t d_pktsize;           /* Maximum packet size */
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* Offload features, see NETDEV_F_* definitions above */
+
+  uint8_t  d_features;          /* Features advertised by the driver */
+  uint16_t d_tsosize;           /* Largest packet with NETDEV_F_TSO */
+  uint16_t d_tsomss;            /* Segment size of the current packet */
+#endif
+
   /* Link layer address */
 
   union
@@ -305,6 +361,29 @@ struct net_driver_s
 
   FAR uint8_t *d_buf;
 
+#ifdef CONFIG_NETDEV_IOB
+  /* If the driver passes its packets in I/O buffers, then d_iob is the
+   * I/O buffer that holds the current packet and d_buf points to the
+   * packet data in that buffer.  See netdev_rx_iob() and netdev_tx_iob().
+   */
+
+  FAR struct iob_s *d_iob;
+#endif
+
+#ifdef CONFIG_NET_TCP_GRO
+  /* The TCP segment held back by the device to merge the following
+   * segments into (see NETDEV_F_GRO), the data of the merged segments and
+   * the IP and IP header length of the held segment.  d_groinput is set
+   * while the held segment is passed to TCP.
+   */
+
+  FAR struct iob_s *d_groiob;
+  FAR struct iob_s *d_grodata;
+  uint16_t d_grolen;
+  uint16_t d_groiplen;
+  bool d_groinput;
+#endif
+
   /* d_appdata points to the location where application data can be read from
    * or written to in the packet buffer.
    */
@@ -344,6 +423,17 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+#ifdef CONFIG_NET_TIMESTAMPING
+  /* A driver whose Ethernet controller timestamps received packets sets
+   * d_rxtstamp to the PTP hardware clock time at which the packet now in
+   * d_buf or d_iob was received, before calling the network input
+   * function, and to zero otherwise.  It is delivered to the sockets that
+   * ask for it with SO_TIMESTAMPING.
+   */
+
+  struct timespec d_rxtstamp;
+#endif
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -743,4 +833,249 @@ uint16_t ipv4_chksum(FAR struct net_driver_s *dev);
 
 int netdev_lladdrsize(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * I/O buffer packet interface
+ *
+ * Drivers that DMA directly into and out of I/O buffers can use these
+ * instead of a private d_buf so that packets are not copied between a
+ * driver buffer and d_buf.  The network still sees a contiguous packet in
+ * d_buf which simply points into the I/O buffer of the current packet.
+ * Drivers that provide their own d_buf are not affected.
+ *
+ *   Input:
+ *
+ *     iob = <I/O buffer holding a received packet>
+ *     netdev_rx_iob(dev, iob);
+ *     ipv4_input(dev);
+ *     iob = netdev_tx_iob(dev);
+ *     if (iob != NULL)
+ *       {
+ *         devicedriver_send(iob);
+ *       }
+ *
+ *   Polling:
+ *
+ *     netdev_iob_prepare(dev, false);
+ *     devif_poll(dev, devicedriver_txpoll);
+ *     netdev_iob_release(dev);
+ *
+ *   where devicedriver_txpoll() takes the packet with netdev_tx_iob() and
+ *   calls netdev_iob_prepare() again before returning zero to continue the
+ *   poll.  devif_poll_batch() does just this and returns the packets in an
+ *   array:
+ *
+ *     n = devif_poll_batch(dev, devicedriver_resolve, pkts, NTXDESC);
+ *     devicedriver_send_batch(pkts, n);
+ *
+ *   where devicedriver_resolve() may do arp_out() or neighbor_out() on
+ *   each packet as the usual poll callback would.
+ *
+ *   The I/O buffers passed to the driver or handed to the network must
+ *   hold the complete packet in one buffer, so CONFIG_IOB_BUFSIZE must be
+ *   at least as large as the link layer packet size.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB
+/****************************************************************************
+ * Name: netdev_iob_prepare
+ *
+ * Description:
+ *   Make sure that the device has an I/O buffer for the next outgoing
+ *   packet and point d_buf at it.
+ *
+ * Input Parameters:
+ *   dev       - The network device
+ *   throttled - An indication whether the allocation may dip into the
+ *               throttled I/O buffers
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if no I/O buffer is available.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled);
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Free the I/O buffer held by the device, if any.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void netdev_iob_release(FAR struct net_driver_s *dev);
+
+/****************************************************************************
+ * Name: netdev_rx_iob
+ *
+ * Description:
+ *   Pass a received packet held in an I/O buffer to the network.  The
+ *   device takes ownership of the buffer and d_buf and d_len are set up to
+ *   describe the packet so that the usual input functions can be called.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *   iob - The I/O buffer holding the packet, starting with the link layer
+ *         header
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EMSGSIZE if the packet can't be held in a
+ *   single I/O buffer.  The I/O buffer is freed in that case.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int netdev_rx_iob(FAR struct net_driver_s *dev, FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: netdev_tx_iob
+ *
+ * Description:
+ *   Take the I/O buffer holding the outgoing packet from the device.  On
+ *   return the driver owns the buffer and must free it once the packet has
+ *   been sent.  If there is no packet to send (d_len is zero), then the
+ *   buffer is released and NULL is returned.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   The I/O buffer holding d_len bytes of packet data or NULL.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_tx_iob(FAR struct net_driver_s *dev);
+
+/****************************************************************************
+ * Name: netdev_iob_take
+ *
+ * Description:
+ *   Detach the I/O buffer of the current incoming packet so that the part
+ *   of the packet at data can be queued without copying it.  The device
+ *   gets a new I/O buffer holding a copy of the headers in front of data,
+ *   so the rest of the input processing (building the response in d_buf)
+ *   works as usual.
+ *
+ *   This is only worthwhile if the data is larger than the headers; it
+ *   fails if there is no I/O buffer, if data is not in the I/O buffer or
+ *   if no new I/O buffer is available.  The caller must then copy.
+ *
+ *   In the I/O buffer user statistics, the buffer is counted as allocated
+ *   by the network device and as freed by its new consumer.
+ *
+ * Input Parameters:
+ *   dev  - The network device
+ *   data - The start of the data in d_buf
+ *   len  - The length of the data
+ *
+ * Returned Value:
+ *   On success, the I/O buffer holding the data with IOB_DATA() == data
+ *   and io_len == io_pktlen == len.  NULL on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_iob_take(FAR struct net_driver_s *dev,
+                                  FAR const uint8_t *data, uint16_t len);
+
+/****************************************************************************
+ * Name: netdev_iob_replace
+ *
+ * Description:
+ *   Make iob the I/O buffer of the current packet, or leave the device
+ *   without an I/O buffer if iob is NULL, and return the I/O buffer that
+ *   the device held before.  d_len is not changed.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *   iob - The new I/O buffer or NULL
+ *
+ * Returned Value:
+ *   The previous I/O buffer of the device or NULL.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_iob_replace(FAR struct net_driver_s *dev,
+                                     FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: devif_poll_batch
+ *
+ * Description:
+ *   Poll the network like devif_poll(), but collect up to npkts outgoing
+ *   packets in I/O buffers so that the driver can queue all of them to its
+ *   TX DMA ring at once.  The driver owns the returned buffers and frees
+ *   them with IOBUSER_NET_NETDEV once they have been sent.
+ *
+ * Input Parameters:
+ *   dev      - The network device
+ *   callback - Called with each packet in d_buf before it is added to the
+ *              batch, e.g. to do arp_out().  It may clear d_len to drop the
+ *              packet or return non-zero to stop polling.  May be NULL.
+ *   pkts     - The array that receives the packets
+ *   npkts    - The size of pkts[]
+ *
+ * Returned Value:
+ *   The number of packets placed in pkts[].  If it equals npkts, then there
+ *   may be more packets to send; poll again when the ring has room.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int devif_poll_batch(FAR struct net_driver_s *dev,
+                     devif_poll_callback_t callback,
+                     FAR struct iob_s **pkts, int npkts);
+#endif
+
+/****************************************************************************
+ * Name: netdev_gro_flush
+ *
+ * Description:
+ *   Pass the TCP segment that the device holds back for merging (see
+ *   NETDEV_F_GRO) to TCP.  A driver advertising NETDEV_F_GRO calls this
+ *   after the last packet of a batch of received packets and, if d_len is
+ *   then non-zero, sends the response in d_buf just as after ipv4_input()
+ *   or ipv6_input().  If a segment is held, the current I/O buffer of the
+ *   device is released first.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GRO
+void netdev_gro_flush(FAR struct net_driver_s *dev);
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_NETDEV_H */
@@ -84,8 +84,19 @@
  * CONFIG_NET_STATISTICS is defined.
  */
 
+/* Network lock statistics.  These are updated with the lock held. */
+
+struct netlock_stats_s
+{
+  uint32_t acquired;            /* Times the lock was taken */
+  uint32_t contended;           /* Times a thread had to wait for it */
+  uint32_t waitticks;           /* Clock ticks spent waiting for it */
+};
+
 struct net_stats_s
 {
+  struct netlock_stats_s lock;  /* Network lock statistics */
+
 #ifdef CONFIG_NET_IPv4
   struct ipv4_stats_s ipv4;     /* IPv4 statistics */
 #endif
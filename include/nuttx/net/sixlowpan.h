@@ -383,9 +383,19 @@ struct sixlowpan_reassbuf_s
 
   bool rb_active;
 
-  /* Supports a singly linked list */
+  /* Supports a doubly linked list.  Active reassembly buffers are kept in
+   * the order of their allocation, oldest first, so that the expired ones
+   * are always found at the head of the list.
+   */
 
   FAR struct sixlowpan_reassbuf_s *rb_flink;
+  FAR struct sixlowpan_reassbuf_s *rb_blink;
+
+  /* Supports the hash chain used to look up a reassembly by its tag and
+   * fragment source.
+   */
+
+  FAR struct sixlowpan_reassbuf_s *rb_hlink;
 
   /* Fragmentation is handled frame by frame and requires that certain
    * state information be retained from frame to frame.  That additional
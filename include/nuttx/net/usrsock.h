@@ -32,6 +32,7 @@
 
 #include <nuttx/net/netconfig.h>
 #include <nuttx/compiler.h>
+#include <nuttx/fs/ioctl.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -59,6 +60,19 @@
 #define USRSOCK_MESSAGE_REQ_COMPLETED(flags) \
                           (!USRSOCK_MESSAGE_REQ_IN_PROGRESS(flags))
 
+/* /dev/usrsock ioctl commands for the shared memory ring mode
+ *
+ *   USRSOCKIOC_RINGSETUP - Exchange the messages through the struct
+ *     usrsock_ring_s pointed to by the argument from now on, or through
+ *     read() and write() again if the argument is NULL.  Fails with -EBUSY
+ *     while requests are outstanding.
+ *   USRSOCKIOC_RINGENTER - Process all messages queued in the completion
+ *     ring.  Returns the number of messages processed.
+ */
+
+#define USRSOCKIOC_RINGSETUP _USRSOCKIOC(0x0001)
+#define USRSOCKIOC_RINGENTER _USRSOCKIOC(0x0002)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -255,4 +269,47 @@ begin_packed_struct struct usrsock_message_socket_event_s
   int16_t usockid;
 } end_packed_struct;
 
+#ifdef CONFIG_NET_USRSOCK_RING
+/* Shared memory rings between the kernel and the daemon.
+ *
+ * The kernel queues requests in sq[] and notifies POLLIN.  An entry refers
+ * to the request message and its data in place; the daemon may use that
+ * memory until it sends the first response to the request and must then
+ * no longer touch it.
+ *
+ * The daemon queues response and event messages, exactly as it would
+ * write() them, in cq[] and calls the USRSOCKIOC_RINGENTER ioctl.  The
+ * kernel processes the messages in place.
+ *
+ * The indexes run freely and the entry of index i is i modulo
+ * CONFIG_NET_USRSOCK_RING_ENTRIES.  The producer fills the entry before
+ * it advances the tail, the consumer advances the head when it is done
+ * with the entry.
+ */
+
+struct usrsock_ring_sqe_s
+{
+  FAR const struct iovec *iov;  /* The request message and its data */
+  uint32_t iovcnt;              /* Number of buffers in iov */
+  uint32_t len;                 /* Total length of the buffers */
+};
+
+struct usrsock_ring_cqe_s
+{
+  FAR const void *msg;          /* Response or event message */
+  uint32_t len;                 /* Length of the message */
+};
+
+struct usrsock_ring_s
+{
+  volatile uint32_t sq_head;    /* Advanced by the daemon */
+  volatile uint32_t sq_tail;    /* Advanced by the kernel */
+  volatile uint32_t cq_head;    /* Advanced by the kernel */
+  volatile uint32_t cq_tail;    /* Advanced by the daemon */
+
+  struct usrsock_ring_sqe_s sq[CONFIG_NET_USRSOCK_RING_ENTRIES];
+  struct usrsock_ring_cqe_s cq[CONFIG_NET_USRSOCK_RING_ENTRIES];
+};
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_USRSOCK_H */
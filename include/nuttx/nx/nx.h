@@ -1064,6 +1064,53 @@ void nx_redrawreq(NXWINDOW hwnd, FAR const struct nxgl_rect_s *rect);
 int nx_constructwindow(NXHANDLE handle, NXWINDOW hwnd, uint8_t flags,
                        FAR const struct nx_callback_s *cb, FAR void *arg);
 
+/****************************************************************************
+ * Name: nx_getsurface
+ *
+ * Description:
+ *   Get the per-window framebuffer of a RAM backed window so that the
+ *   client can render into it directly, instead of sending each drawing
+ *   operation to the server.  Changes become visible only after they are
+ *   reported with nx_update().
+ *
+ *   The framebuffer is re-allocated when the window is resized, so the
+ *   surface must be queried again after each size change.  The server may
+ *   read the framebuffer at any time to redraw the window.
+ *
+ * Input Parameters:
+ *   hwnd   - The RAM backed window
+ *   fbmem  - Location to return the address of the framebuffer
+ *   stride - Location to return the width of one row in bytes
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_RAMBACKED
+int nx_getsurface(NXWINDOW hwnd, FAR FAR void **fbmem,
+                  FAR nxgl_coord_t *stride);
+
+/****************************************************************************
+ * Name: nx_update
+ *
+ * Description:
+ *   Report that a region of the per-window framebuffer was modified by the
+ *   the client.  The server copies the visible part of the region to the
+ *   display.  No pixel data is sent with the request.
+ *
+ * Input Parameters:
+ *   hwnd - The RAM backed window
+ *   rect - The modified region (window relative)
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nx_update(NXWINDOW hwnd, FAR const struct nxgl_rect_s *rect);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -146,7 +146,8 @@ enum nxmsg_e
   NX_SVRMSG_SETBGCOLOR,       /* Set the color of the background */
   NX_SVRMSG_MOUSEIN,          /* New mouse report from mouse client */
   NX_SVRMSG_KBDIN,            /* New keyboard report from keyboard client */
-  NX_SVRMSG_REDRAWREQ         /* Request re-drawing of rectangular region */
+  NX_SVRMSG_REDRAWREQ,        /* Request re-drawing of rectangular region */
+  NX_SVRMSG_UPDATE            /* Per-window framebuffer region was modified */
 };
 
 /* Server-to-Client Message Structures **************************************/
@@ -524,6 +525,17 @@ struct nxsvrmsg_redrawreq_s
   struct nxgl_rect_s rect;         /* Describes the rectangular region to be redrawn */
 };
 
+/* The client modified a region of the per-window framebuffer directly */
+
+#ifdef CONFIG_NX_RAMBACKED
+struct nxsvrmsg_update_s
+{
+  uint32_t msgid;                  /* NX_SVRMSG_UPDATE */
+  FAR struct nxbe_window_s *wnd;   /* The window that was modified */
+  struct nxgl_rect_s rect;         /* The modified region (window relative) */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
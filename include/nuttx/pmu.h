@@ -0,0 +1,201 @@
+/****************************************************************************
+ * include/nuttx/pmu.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_PMU_H
+#define __INCLUDE_NUTTX_PMU_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/fs/ioctl.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Number of event counters that are virtualized per thread */
+
+#ifdef CONFIG_SCHED_PMU_NCOUNTERS
+#  define PMU_NCOUNTERS           CONFIG_SCHED_PMU_NCOUNTERS
+#else
+#  define PMU_NCOUNTERS           1
+#endif
+
+/* Generic events.  Each architecture maps them to its own event numbers;
+ * an event that the CPU can not count is refused with -ENOTSUP.
+ */
+
+#define PMU_EVENT_NONE            0  /* Counter stopped */
+#define PMU_EVENT_CYCLES          1  /* CPU cycles */
+#define PMU_EVENT_INSTRUCTIONS    2  /* Instructions executed */
+#define PMU_EVENT_CACHE_REFS      3  /* L1 data cache accesses */
+#define PMU_EVENT_CACHE_MISSES    4  /* L1 data cache refills */
+#define PMU_EVENT_BRANCHES        5  /* Branches executed */
+#define PMU_EVENT_BRANCH_MISSES   6  /* Branches mispredicted */
+#define PMU_EVENT_STALLS          7  /* Stalled cycles */
+
+/* Raw events are passed to the hardware unmodified */
+
+#define PMU_EVENT_RAW_FLAG        0x80000000
+#define PMU_EVENT_RAW(n)          (PMU_EVENT_RAW_FLAG | (uint32_t)(n))
+#define PMU_EVENT_ISRAW(e)        (((e) & PMU_EVENT_RAW_FLAG) != 0)
+#define PMU_EVENT_RAWNUM(e)       ((e) & ~PMU_EVENT_RAW_FLAG)
+
+/* IOCTL commands of /dev/pmu ***********************************************/
+
+/* Command:      PMUIOC_NCOUNTERS
+ * Description:  Get the number of event counters that can be configured
+ * Argument:     A reference to an int
+ * Return:       Zero (OK) on success.  On failure, -1 (ERROR) is returned
+ *               with the errno value set appropriately.
+ */
+
+#define PMUIOC_NCOUNTERS          _PMUIOC(0x0001)
+
+/* Command:      PMUIOC_CONFIG
+ * Description:  Select the event counted by one counter.  The counts of
+ *               all threads for that counter are reset.
+ * Argument:     A read-only reference to a struct pmu_config_s
+ * Return:       Zero (OK) on success.  On failure, -1 (ERROR) is returned
+ *               with the errno value set appropriately.
+ */
+
+#define PMUIOC_CONFIG             _PMUIOC(0x0002)
+
+/* Command:      PMUIOC_READ
+ * Description:  Read the event counts of the thread given in the pid field
+ *               of the argument, zero is the calling thread.
+ * Argument:     A reference to a struct pmu_count_s
+ * Return:       Zero (OK) on success.  On failure, -1 (ERROR) is returned
+ *               with the errno value set appropriately.
+ */
+
+#define PMUIOC_READ               _PMUIOC(0x0003)
+
+/* Command:      PMUIOC_RESET
+ * Description:  Reset the event counts of all threads
+ * Argument:     None
+ * Return:       Zero (OK)
+ */
+
+#define PMUIOC_RESET              _PMUIOC(0x0004)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Argument of PMUIOC_CONFIG */
+
+struct pmu_config_s
+{
+  int      counter;                  /* Counter to configure */
+  uint32_t event;                    /* PMU_EVENT_* to count */
+};
+
+/* Argument of PMUIOC_READ */
+
+struct pmu_count_s
+{
+  pid_t    pid;                      /* Thread to read, 0 for the caller */
+  uint32_t event[PMU_NCOUNTERS];     /* Event counted by each counter */
+  uint64_t count[PMU_NCOUNTERS];     /* Events while the thread ran */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#if defined(__KERNEL__) || defined(CONFIG_BUILD_FLAT)
+#ifdef CONFIG_SCHED_PMU
+
+struct tcb_s;
+
+/****************************************************************************
+ * Name: nxsched_pmu_config
+ *
+ * Description:
+ *   Select the event counted by one counter on all CPUs and reset the
+ *   counts of all threads for that counter.  The other CPUs reprogram
+ *   their counter at their next context switch.
+ *
+ * Input Parameters:
+ *   counter - The counter to configure
+ *   event   - One of the PMU_EVENT_* definitions
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_pmu_config(int counter, uint32_t event);
+
+/****************************************************************************
+ * Name: nxsched_pmu_read
+ *
+ * Description:
+ *   Return the events counted while a thread was running.  The counts of
+ *   the running thread include the events up to now; in SMP the counts of
+ *   a thread running on another CPU are updated at its context switches.
+ *
+ * Input Parameters:
+ *   tcb   - The thread to read
+ *   count - Receives the events and the counts; pid is not modified.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsched_pmu_read(FAR struct tcb_s *tcb,
+                      FAR struct pmu_count_s *count);
+
+/****************************************************************************
+ * Name: nxsched_pmu_reset
+ *
+ * Description:
+ *   Reset the event counts of all threads.
+ *
+ ****************************************************************************/
+
+void nxsched_pmu_reset(void);
+
+#endif /* CONFIG_SCHED_PMU */
+#endif /* __KERNEL__ || CONFIG_BUILD_FLAT */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_PMU_H */
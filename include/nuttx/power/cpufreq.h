@@ -0,0 +1,246 @@
+/****************************************************************************
+ * include/nuttx/power/cpufreq.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_POWER_CPUFREQ_H
+#define __INCLUDE_NUTTX_POWER_CPUFREQ_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <queue.h>
+
+#ifdef CONFIG_CPUFREQ
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The phases of a frequency change reported to the notifiers */
+
+#define CPUFREQ_PRECHANGE    0  /* The frequency is about to change */
+#define CPUFREQ_POSTCHANGE   1  /* The frequency has changed */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The policies that decide the core clock frequency */
+
+enum cpufreq_governor_e
+{
+  CPUFREQ_GOVERNOR_PERFORMANCE = 0, /* Always run at the highest frequency */
+  CPUFREQ_GOVERNOR_POWERSAVE,       /* Always run at the lowest frequency */
+  CPUFREQ_GOVERNOR_USERSPACE,       /* Frequency selected by cpufreq_set() */
+  CPUFREQ_GOVERNOR_ONDEMAND         /* Frequency follows the CPU load */
+};
+
+/* Describes one frequency change, in Hz */
+
+struct cpufreq_freqs_s
+{
+  uint32_t oldfreq;                 /* The frequency before the change */
+  uint32_t newfreq;                 /* The frequency after the change */
+};
+
+/* The arch lower half reprograms the PLL and dividers of the core clock */
+
+struct cpufreq_lowerhalf_s;
+struct cpufreq_ops_s
+{
+  /**************************************************************************
+   * Name: set_freq
+   *
+   * Description:
+   *   Switch the core clock to freq, one of the entries of the frequency
+   *   table.  The system tick and any clock derived from the core clock
+   *   must keep running at its nominal rate or be fixed up by a notifier.
+   *
+   * Returned Value:
+   *   Zero (OK) on success; a negated errno value on failure, in which case
+   *   the core must still be running at the previous frequency.
+   *
+   **************************************************************************/
+
+  CODE int (*set_freq)(FAR struct cpufreq_lowerhalf_s *lower,
+                       uint32_t freq);
+
+  /**************************************************************************
+   * Name: get_freq
+   *
+   * Description:
+   *   Return the current frequency of the core clock, in Hz.
+   *
+   **************************************************************************/
+
+  CODE uint32_t (*get_freq)(FAR struct cpufreq_lowerhalf_s *lower);
+};
+
+struct cpufreq_lowerhalf_s
+{
+  FAR const struct cpufreq_ops_s *ops;
+  FAR const uint32_t *table;        /* Supported frequencies, ascending */
+  uint8_t ntable;                   /* Number of entries in table[] */
+};
+
+/* Drivers whose timing depends on the core clock (timers, UART baud rate
+ * generators, peripheral clock dividers) register one of these structures
+ * to be told about the changes.  The notifiers are called from the thread
+ * that changes the frequency, once with CPUFREQ_PRECHANGE before the
+ * switch and once with CPUFREQ_POSTCHANGE after it.  If the switch failed,
+ * the POSTCHANGE call reports newfreq equal to oldfreq.
+ */
+
+struct cpufreq_notifier_s
+{
+  struct dq_entry_s entry;          /* Supports a doubly linked list */
+  CODE void (*notify)(FAR struct cpufreq_notifier_s *nb, int phase,
+                      FAR const struct cpufreq_freqs_s *freqs);
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: cpufreq_register
+ *
+ * Description:
+ *   Register the lower half driver of the core clock and start the
+ *   default governor.  Only one core clock is supported, so with SMP all
+ *   CPUs share the frequency.
+ *
+ * Input Parameters:
+ *   lower - The lower half driver with a non-empty frequency table.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int cpufreq_register(FAR struct cpufreq_lowerhalf_s *lower);
+
+/****************************************************************************
+ * Name: cpufreq_unregister
+ *
+ * Description:
+ *   Stop the governor and forget the lower half driver.  The core keeps
+ *   running at its current frequency.
+ *
+ ****************************************************************************/
+
+int cpufreq_unregister(FAR struct cpufreq_lowerhalf_s *lower);
+
+/****************************************************************************
+ * Name: cpufreq_get
+ *
+ * Description:
+ *   Return the current core clock frequency in Hz, or zero if no lower
+ *   half driver is registered.
+ *
+ ****************************************************************************/
+
+uint32_t cpufreq_get(void);
+
+/****************************************************************************
+ * Name: cpufreq_set
+ *
+ * Description:
+ *   Switch to the lowest supported frequency that is not below freq, or to
+ *   the highest one.  Only allowed with CPUFREQ_GOVERNOR_USERSPACE, since
+ *   the other governors would undo the change.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int cpufreq_set(uint32_t freq);
+
+/****************************************************************************
+ * Name: cpufreq_set_governor
+ *
+ * Description:
+ *   Select the policy that decides the core clock frequency.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the governor is not supported by the
+ *   configuration.
+ *
+ ****************************************************************************/
+
+int cpufreq_set_governor(enum cpufreq_governor_e governor);
+
+/****************************************************************************
+ * Name: cpufreq_register_notifier, cpufreq_unregister_notifier
+ *
+ * Description:
+ *   Add or remove a notifier of the frequency changes.
+ *
+ ****************************************************************************/
+
+int cpufreq_register_notifier(FAR struct cpufreq_notifier_s *nb);
+int cpufreq_unregister_notifier(FAR struct cpufreq_notifier_s *nb);
+
+/****************************************************************************
+ * Name: cpufreq_clk_initialize
+ *
+ * Description:
+ *   Create a lower half driver that scales the core clock through the
+ *   clock framework.  clk_set_rate() recalculates the rates of all the
+ *   clocks derived from it.
+ *
+ * Input Parameters:
+ *   name   - The name of the core clock in the clock framework.
+ *   table  - The supported frequencies in Hz, ascending.
+ *   ntable - The number of entries in table[].
+ *
+ * Returned Value:
+ *   The lower half driver to pass to cpufreq_register(), or NULL on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CLK
+FAR struct cpufreq_lowerhalf_s *
+cpufreq_clk_initialize(FAR const char *name, FAR const uint32_t *table,
+                       uint8_t ntable);
+#endif
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_CPUFREQ */
+#endif /* __INCLUDE_NUTTX_POWER_CPUFREQ_H */
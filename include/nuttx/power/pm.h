@@ -56,6 +56,7 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <queue.h>
 
 #ifdef CONFIG_PM
@@ -286,6 +287,30 @@ struct pm_user_governor_state_s
   enum pm_state_e state;
 };
 
+#ifdef CONFIG_PM_QOS
+/* This structure describes the cost of one power management state.  The
+ * board provides a table of PM_COUNT of them, indexed by the state, with
+ * pm_set_latency().
+ */
+
+struct pm_latency_s
+{
+  uint32_t entry;            /* Time to enter the state, in microseconds */
+  uint32_t exit;             /* Time to resume from the state, in usec */
+};
+
+/* This structure describes one latency constraint.  It is provided by the
+ * driver or thread that requests the constraint and must remain valid
+ * until it is removed with pm_qos_remove().
+ */
+
+struct pm_qos_s
+{
+  struct dq_entry_s entry;   /* Supports a doubly linked list */
+  uint32_t latency;          /* Max wakeup latency accepted, in usec */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -519,6 +544,118 @@ void pm_relax(int domain, enum pm_state_e state);
 
 uint32_t pm_staycount(int domain, enum pm_state_e state);
 
+#ifdef CONFIG_PM_QOS
+
+/****************************************************************************
+ * Name: pm_set_latency
+ *
+ * Description:
+ *   This function is called by board-specific logic to describe the entry
+ *   and exit latency of the power management states of a domain.  Until it
+ *   is called, the latency constraints of the domain have no effect.
+ *
+ * Input Parameters:
+ *   domain - The PM domain described
+ *   latency - A table of PM_COUNT entries indexed by the state.  It must
+ *     stay valid as long as the domain is in use.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void pm_set_latency(int domain, FAR const struct pm_latency_s *latency);
+
+/****************************************************************************
+ * Name: pm_qos_add
+ *
+ * Description:
+ *   This function is called by a driver or thread that cannot tolerate a
+ *   wakeup latency larger than 'latency' in the domain.  pm_checkstate()
+ *   will not recommend a state whose entry plus exit latency exceeds the
+ *   tightest of the active constraints.
+ *
+ * Input Parameters:
+ *   domain - The domain of the constraint
+ *   qos - The constraint instance, owned by the caller
+ *   latency - The maximum wakeup latency accepted, in microseconds
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void pm_qos_add(int domain, FAR struct pm_qos_s *qos, uint32_t latency);
+
+/****************************************************************************
+ * Name: pm_qos_update
+ *
+ * Description:
+ *   Change the latency of a constraint previously added with pm_qos_add().
+ *
+ * Input Parameters:
+ *   domain - The domain of the constraint
+ *   qos - The constraint instance
+ *   latency - The new maximum wakeup latency accepted, in microseconds
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void pm_qos_update(int domain, FAR struct pm_qos_s *qos, uint32_t latency);
+
+/****************************************************************************
+ * Name: pm_qos_remove
+ *
+ * Description:
+ *   Remove a constraint previously added with pm_qos_add().
+ *
+ * Input Parameters:
+ *   domain - The domain of the constraint
+ *   qos - The constraint instance
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void pm_qos_remove(int domain, FAR struct pm_qos_s *qos);
+
+/****************************************************************************
+ * Name: pm_qos_latency
+ *
+ * Description:
+ *   Return the tightest active latency constraint of the domain.
+ *
+ * Input Parameters:
+ *   domain - The PM domain to check
+ *
+ * Returned Value:
+ *   The maximum wakeup latency accepted, in microseconds.  UINT32_MAX if
+ *   there is no active constraint.
+ *
+ ****************************************************************************/
+
+uint32_t pm_qos_latency(int domain);
+
+#else
+#  define pm_set_latency(domain,latency)
+#  define pm_qos_add(domain,qos,latency)
+#  define pm_qos_update(domain,qos,latency)
+#  define pm_qos_remove(domain,qos)
+#  define pm_qos_latency(domain)       (UINT32_MAX)
+#endif /* CONFIG_PM_QOS */
+
 /****************************************************************************
  * Name: pm_checkstate
  *
@@ -638,6 +775,11 @@ void pm_auto_updatestate(int domain);
 #  define pm_checkstate(domain)        (0)
 #  define pm_changestate(domain,state) (0)
 #  define pm_querystate(domain)        (0)
+#  define pm_set_latency(domain,latency)
+#  define pm_qos_add(domain,qos,latency)
+#  define pm_qos_update(domain,qos,latency)
+#  define pm_qos_remove(domain,qos)
+#  define pm_qos_latency(domain)       (UINT32_MAX)
 
 #endif /* CONFIG_PM */
 #endif /* __INCLUDE_NUTTX_POWER_PM_H */
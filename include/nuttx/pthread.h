@@ -167,6 +167,30 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
 
 void nx_pthread_exit(FAR void *exit_value) noreturn_function;
 
+/****************************************************************************
+ * Name: nx_pthread_mutex_timedlock, nx_pthread_mutex_trylock and
+ *       nx_pthread_mutex_unlock
+ *
+ * Description:
+ *   These are the OS parts of pthread_mutex_timedlock(),
+ *   pthread_mutex_trylock() and pthread_mutex_unlock().  The C library
+ *   wrappers call them for every mutex that can't be handled without the
+ *   OS; see CONFIG_PTHREAD_MUTEX_FASTPATH.
+ *
+ * Input Parameters:
+ *   mutex       - A reference to the mutex
+ *   abs_timeout - Maximum wait time (NULL wait forever)
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int nx_pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
+                               FAR const struct timespec *abs_timeout);
+int nx_pthread_mutex_trylock(FAR pthread_mutex_t *mutex);
+int nx_pthread_mutex_unlock(FAR pthread_mutex_t *mutex);
+
 /****************************************************************************
  * Name: pthread_cleanup_popall
  *
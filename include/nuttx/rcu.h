@@ -0,0 +1,175 @@
+/****************************************************************************
+ * include/nuttx/rcu.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_RCU_H
+#define __INCLUDE_NUTTX_RCU_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sched.h>
+
+#include <nuttx/compiler.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* RCU_MB() orders the memory accesses before it against those after it.
+ * With SMP it must be a real memory barrier; on a single CPU it needs only
+ * keep the compiler from moving accesses across it.
+ */
+
+#if defined(CONFIG_SMP)
+#  define RCU_MB()  SP_DMB()
+#elif defined(__GNUC__)
+#  define RCU_MB()  __asm__ __volatile__("" : : : "memory")
+#else
+#  define RCU_MB()
+#endif
+
+/* rcu_assign_pointer() publishes a pointer to an object that readers may
+ * find without a lock.  The object must be fully initialized before the
+ * pointer becomes visible, hence the barrier.
+ *
+ * rcu_dereference() loads such a pointer in a read-side critical section.
+ * The architectures supported by NuttX keep dependent loads in order, so
+ * it does no more than document the access.
+ *
+ * These are available without CONFIG_RCU so that shared code need not be
+ * conditioned on it.
+ */
+
+#define rcu_assign_pointer(p, v) \
+  do \
+    { \
+      RCU_MB(); \
+      (p) = (v); \
+    } \
+  while (0)
+
+#define rcu_dereference(p) (p)
+
+#ifdef CONFIG_RCU
+
+/* With a single CPU, a reader only needs to keep other tasks from running
+ * until it is done: synchronize_rcu() can then never be called while a
+ * reader is in the middle of its critical section.
+ */
+
+#ifndef CONFIG_SMP
+#  define rcu_read_lock()   sched_lock()
+#  define rcu_read_unlock() sched_unlock()
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Deferred reclamation through call_rcu().  The rcu_head is embedded in the
+ * object to be freed and the callback uses container_of() to get back to
+ * it.
+ */
+
+struct rcu_head;
+typedef CODE void (*rcu_callback_t)(FAR struct rcu_head *head);
+
+struct rcu_head
+{
+  FAR struct rcu_head *flink;  /* Supports a singly linked list */
+  rcu_callback_t func;         /* Called when the grace period has elapsed */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: rcu_read_lock, rcu_read_unlock
+ *
+ * Description:
+ *   Enter and leave an RCU read-side critical section.  The sections may
+ *   nest and may be used from interrupt handlers.  The code between them
+ *   must not block, but it runs concurrently with other readers and with
+ *   the updater.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void rcu_read_lock(void);
+void rcu_read_unlock(void);
+#endif
+
+/****************************************************************************
+ * Name: synchronize_rcu
+ *
+ * Description:
+ *   Wait for a grace period: return only after every read-side critical
+ *   section that was in progress at the time of the call has completed.
+ *   An object unlinked before the call can then be freed.
+ *
+ *   The grace period ends when each CPU has been seen outside of a
+ *   read-side critical section or has switched context.
+ *
+ * Assumptions:
+ *   Must not be called from an interrupt handler or from inside a
+ *   read-side critical section.
+ *
+ ****************************************************************************/
+
+void synchronize_rcu(void);
+
+/****************************************************************************
+ * Name: call_rcu
+ *
+ * Description:
+ *   Call func(head) on the low priority work queue after a grace period
+ *   has elapsed.  Unlike synchronize_rcu(), this does not wait and may be
+ *   called from any context.
+ *
+ * Input Parameters:
+ *   head - The rcu_head embedded in the object to reclaim.
+ *   func - The function that will reclaim the object.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+void call_rcu(FAR struct rcu_head *head, rcu_callback_t func);
+#endif
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_RCU */
+#endif /* __INCLUDE_NUTTX_RCU_H */
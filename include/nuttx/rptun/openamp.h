@@ -57,6 +57,21 @@ extern "C"
 int rpmsg_wait(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem);
 int rpmsg_post(FAR struct rpmsg_endpoint *ept, FAR sem_t *sem);
 
+/* With CONFIG_RPTUN_NOTIFY_BATCH, the messages sent between
+ * rpmsg_batch_begin() and rpmsg_batch_end() on the endpoints of one remote
+ * are signaled to it with a single notification at the end.  The batch
+ * must not wait for an answer of the remote, except through rpmsg_wait()
+ * or the TX buffer allocation that send the notification first.
+ */
+
+#ifdef CONFIG_RPTUN_NOTIFY_BATCH
+void rpmsg_batch_begin(FAR struct rpmsg_endpoint *ept);
+void rpmsg_batch_end(FAR struct rpmsg_endpoint *ept);
+#else
+#  define rpmsg_batch_begin(ept)
+#  define rpmsg_batch_end(ept)
+#endif
+
 const char *rpmsg_get_cpuname(FAR struct rpmsg_device *rdev);
 
 int rpmsg_register_callback(FAR void *priv,
@@ -96,18 +96,20 @@
 #define TCB_FLAG_NONCANCELABLE     (1 << 2)                      /* Bit 2: Pthread is non-cancelable */
 #define TCB_FLAG_CANCEL_DEFERRED   (1 << 3)                      /* Bit 3: Deferred (vs asynch) cancellation type */
 #define TCB_FLAG_CANCEL_PENDING    (1 << 4)                      /* Bit 4: Pthread cancel is pending */
-#define TCB_FLAG_POLICY_SHIFT      (5)                           /* Bit 5-6: Scheduling policy */
-#define TCB_FLAG_POLICY_MASK       (3 << TCB_FLAG_POLICY_SHIFT)
+#define TCB_FLAG_POLICY_SHIFT      (5)                           /* Bit 5-7: Scheduling policy */
+#define TCB_FLAG_POLICY_MASK       (7 << TCB_FLAG_POLICY_SHIFT)
 #  define TCB_FLAG_SCHED_FIFO      (0 << TCB_FLAG_POLICY_SHIFT)  /* FIFO scheding policy */
 #  define TCB_FLAG_SCHED_RR        (1 << TCB_FLAG_POLICY_SHIFT)  /* Round robin scheding policy */
 #  define TCB_FLAG_SCHED_SPORADIC  (2 << TCB_FLAG_POLICY_SHIFT)  /* Sporadic scheding policy */
 #  define TCB_FLAG_SCHED_OTHER     (3 << TCB_FLAG_POLICY_SHIFT)  /* Other scheding policy */
+#  define TCB_FLAG_SCHED_DEADLINE  (4 << TCB_FLAG_POLICY_SHIFT)  /* Deadline scheding policy */
 #define TCB_FLAG_CPU_LOCKED        (1 << 8)                      /* Bit 7: Locked to this CPU */
 #define TCB_FLAG_SIGNAL_ACTION     (1 << 9)                      /* Bit 8: In a signal handler */
 #define TCB_FLAG_SYSCALL           (1 << 10)                     /* Bit 9: In a system call */
 #define TCB_FLAG_EXIT_PROCESSING   (1 << 11)                     /* Bit 10: Exitting */
 #define TCB_FLAG_FREE_STACK        (1 << 12)                     /* Bit 12: Free stack after exit */
 #define TCB_FLAG_MEM_CHECK         (1 << 13)                     /* Bit 13: Memory check */
+#define TCB_FLAG_COND_REQUEUED     (1 << 14)                     /* Bit 14: Moved from condvar to mutex */
                                                                  /* Bits 14-15: Available */
 
 /* Values for struct task_group tg_flags */
@@ -307,6 +309,27 @@ struct sporadic_s
 
 #endif /* CONFIG_SCHED_SPORADIC */
 
+/* struct deadline_s ********************************************************/
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/* The parameters and the constant bandwidth server state of a thread with
+ * the SCHED_DEADLINE policy.  The remaining budget of the current job is
+ * kept in the timeslice field of the TCB.  All times are in clock ticks.
+ */
+
+struct deadline_s
+{
+  clock_t   abstime;                /* Absolute deadline of the current job */
+  uint32_t  runtime;                /* Execution budget per period          */
+  uint32_t  reldeadline;            /* Relative deadline                    */
+  uint32_t  period;                 /* Period                               */
+  uint32_t  util;                   /* Reserved bandwidth, admission units  */
+  uint32_t  overruns;               /* Number of budget overruns            */
+};
+
+#endif /* CONFIG_SCHED_DEADLINE */
+
 /* struct child_status_s ****************************************************/
 
 /* This structure is used to maintain information about child tasks.
@@ -526,6 +549,39 @@ struct task_group_s
 #endif
 };
 
+/* struct critmon_hist_s ****************************************************/
+
+/* A log2 histogram of durations in up_perf_gettime() counts.  Bucket 0
+ * holds the durations below 2^CONFIG_SCHED_CRITMONITOR_HISTOGRAM_SHIFT,
+ * each following bucket the durations up to twice as long as the previous
+ * one, and the last bucket all longer durations.
+ */
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+struct critmon_hist_s
+{
+  uint32_t  max;                    /* Longest duration recorded            */
+  FAR void *maxip;                  /* Code location of the longest         */
+  uint32_t  count[CONFIG_SCHED_CRITMONITOR_HISTOGRAM_NBUCKETS];
+};
+#endif
+
+/* struct profile_sample_s **************************************************/
+
+/* One sample of the CPU profiler.  pc[0] is the PC that was interrupted,
+ * the following entries are the return addresses of its callers.
+ */
+
+#ifdef CONFIG_SCHED_PROFILE
+struct profile_sample_s
+{
+  pid_t     pid;                    /* The thread that was interrupted      */
+  uint8_t   cpu;                    /* The CPU that was interrupted         */
+  uint8_t   depth;                  /* Number of valid entries in pc[]      */
+  FAR void *pc[CONFIG_SCHED_PROFILE_DEPTH];
+};
+#endif
+
 /* struct tcb_s *************************************************************/
 
 /* This is the common part of the task control block (TCB).
@@ -579,13 +635,17 @@ struct tcb_s
 #endif
   int16_t  errcode;                      /* Used to pass error information  */
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
   int32_t  timeslice;                    /* RR timeslice OR Sporadic budget */
                                          /* interval remaining              */
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
   FAR struct sporadic_s *sporadic;       /* Sporadic scheduling parameters  */
 #endif
+#ifdef CONFIG_SCHED_DEADLINE
+  struct deadline_s deadline;            /* Deadline scheduling state       */
+#endif
 
   struct wdog_s waitdog;                 /* All timed waits use this timer  */
 
@@ -624,6 +684,13 @@ struct tcb_s
   FAR struct mqueue_inode_s *msgwaitq;   /* Waiting for this message queue  */
 #endif
 
+  /* select() support *******************************************************/
+
+#ifdef CONFIG_FS_SELECT_SCRATCH
+  FAR struct pollfd *pollscratch;        /* pollfd array reused by select() */
+  uint16_t npollscratch;                 /* Entries in pollscratch          */
+#endif
+
   /* Robust mutex support ***************************************************/
 
 #if !defined(CONFIG_DISABLE_PTHREAD) && !defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
@@ -647,6 +714,21 @@ struct tcb_s
   uint32_t run_max;                      /* Max time thread run                 */
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  FAR void *premp_ip;                    /* Caller that disabled preemption     */
+  FAR void *crit_ip;                     /* Caller that entered csection        */
+  uint32_t ready_start;                  /* Time when thread became ready       */
+  struct critmon_hist_s premp_hist;      /* Preemption disabled durations       */
+  struct critmon_hist_s crit_hist;       /* Critical section durations          */
+  struct critmon_hist_s wakeup_hist;     /* Ready-to-run to running latencies   */
+#endif
+
+  /* Hardware performance counters ******************************************/
+
+#ifdef CONFIG_SCHED_PMU
+  uint64_t pmu_count[CONFIG_SCHED_PMU_NCOUNTERS]; /* Events while running  */
+#endif
+
   /* State save areas *******************************************************/
 
   /* The form and content of these fields are platform-specific.            */
@@ -772,6 +854,17 @@ EXTERN uint32_t g_premp_max[CONFIG_SMP_NCPUS];
 EXTERN uint32_t g_crit_max[CONFIG_SMP_NCPUS];
 #endif /* CONFIG_SCHED_CRITMONITOR */
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/* Histograms of the time with pre-emption disabled, within critical
+ * section, in interrupt handlers and from ready-to-run to running.
+ */
+
+EXTERN struct critmon_hist_s g_premp_hist[CONFIG_SMP_NCPUS];
+EXTERN struct critmon_hist_s g_crit_hist[CONFIG_SMP_NCPUS];
+EXTERN struct critmon_hist_s g_irq_hist[CONFIG_SMP_NCPUS];
+EXTERN struct critmon_hist_s g_wakeup_hist[CONFIG_SMP_NCPUS];
+#endif
+
 #ifdef CONFIG_DEBUG_TCBINFO
 EXTERN const struct tcbinfo_s g_tcbinfo;
 #endif
@@ -1322,6 +1415,41 @@ int   nx_waitid(int idtype, id_t id, FAR siginfo_t *info, int options);
 pid_t nx_waitpid(pid_t pid, FAR int *stat_loc, int options);
 #endif
 
+/****************************************************************************
+ * Name: nxsched_profile_sample
+ *
+ * Description:
+ *   Record the PC interrupted on this CPU, and the return addresses of its
+ *   callers if CONFIG_SCHED_PROFILE_DEPTH > 1, in the sample buffer of
+ *   this CPU.  This is called on each CPU load sample; architectures may
+ *   also call it from a high-rate timer or a PMU overflow interrupt.
+ *
+ * Assumptions:
+ *   Called from interrupt handling logic.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PROFILE
+void nxsched_profile_sample(void);
+#endif
+
+/****************************************************************************
+ * Name: nxsched_profile_drain
+ *
+ * Description:
+ *   Remove up to 'nsamples' of the oldest samples recorded on CPU 'cpu'
+ *   and copy them to 'samples'.
+ *
+ * Returned Value:
+ *   The number of samples copied.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PROFILE
+int nxsched_profile_drain(int cpu, FAR struct profile_sample_s *samples,
+                          int nsamples);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
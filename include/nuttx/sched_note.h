@@ -128,6 +128,8 @@
           sched_note_begin(SCHED_NOTE_IP, __FUNCTION__)
 #  define SCHED_NOTE_END() \
           sched_note_end(SCHED_NOTE_IP, __FUNCTION__)
+#  define SCHED_NOTE_COUNTER(name, value) \
+          sched_note_counter(SCHED_NOTE_IP, name, value)
 #else
 #  define SCHED_NOTE_STRING(buf)
 #  define SCHED_NOTE_DUMP(event, buf, len)
@@ -137,6 +139,7 @@
 #  define SCHED_NOTE_BPRINTF(event, fmt, args...)
 #  define SCHED_NOTE_BEGIN()
 #  define SCHED_NOTE_END()
+#  define SCHED_NOTE_COUNTER(name, value)
 #endif
 
 /****************************************************************************
@@ -555,6 +558,7 @@ void sched_note_bprintf(uintptr_t ip, uint8_t event,
                         FAR const char *fmt, ...) printflike(3, 4);
 void sched_note_begin(uintptr_t ip, FAR const char *buf);
 void sched_note_end(uintptr_t ip, FAR const char *buf);
+void sched_note_counter(uintptr_t ip, FAR const char *name, long value);
 #else
 #  define sched_note_string(ip,b)
 #  define sched_note_dump(ip,e,b,l)
@@ -564,6 +568,7 @@ void sched_note_end(uintptr_t ip, FAR const char *buf);
 #  define sched_note_bprintf(ip,e,f...)
 #  define sched_note_begin(ip,f...)
 #  define sched_note_end(ip,f...)
+#  define sched_note_counter(ip,n,v)
 #endif /* CONFIG_SCHED_INSTRUMENTATION_DUMP */
 
 #if defined(__KERNEL__) || defined(CONFIG_BUILD_FLAT)
@@ -710,6 +715,7 @@ void sched_note_filter_irq(struct note_filter_irq_s *oldf,
 #  define sched_note_bprintf(ip,e,f...)
 #  define sched_note_begin(ip,f...)
 #  define sched_note_end(ip,f...)
+#  define sched_note_counter(ip,n,v)
 
 #endif /* CONFIG_SCHED_INSTRUMENTATION */
 #endif /* __INCLUDE_NUTTX_SCHED_NOTE_H */
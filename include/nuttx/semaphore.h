@@ -41,7 +41,7 @@
 #ifdef CONFIG_PRIORITY_INHERITANCE
 # if CONFIG_SEM_PREALLOCHOLDERS > 0
 #  define NXSEM_INITIALIZER(c, f) \
-    {(c), (f), NULL}                    /* semcount, flags, hhead */
+    {(c), (f), NULL, SEMHOLDER_INITIALIZER}  /* semcount, flags, hhead, holder */
 # else
 #  define NXSEM_INITIALIZER(c, f) \
     {(c), (f), {SEMHOLDER_INITIALIZER, SEMHOLDER_INITIALIZER}}  /* semcount, flags, holder[2] */
@@ -118,6 +118,24 @@ struct nsem_inode_s
 };
 #endif
 
+#ifdef CONFIG_SEM_HOLDER_STATS
+/* Priority inheritance holder bookkeeping statistics.  The number of
+ * holder entries examined per lookup is a measure of the time spent
+ * searching holder lists with interrupts disabled.
+ */
+
+struct semholder_stat_s
+{
+  uint32_t ninline;                 /* Holders kept in an inline slot */
+  uint32_t npool;                   /* Holders taken from the pool */
+  uint32_t nfail;                   /* Failures, no holder slot available */
+  uint32_t inuse;                   /* Pool holders currently in use */
+  uint32_t maxinuse;                /* Maximum pool holders in use */
+  uint32_t nlookups;                /* Number of holder lookups */
+  uint32_t nsteps;                  /* Holder entries examined by lookups */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -626,6 +644,24 @@ int nxsem_clockwait_uninterruptible(FAR sem_t *sem, clockid_t clockid,
 
 int nxsem_tickwait_uninterruptible(FAR sem_t *sem, uint32_t delay);
 
+/****************************************************************************
+ * Name: nxsem_holderstat
+ *
+ * Description:
+ *   Return a snapshot of the priority inheritance holder statistics.
+ *
+ * Input Parameters:
+ *   stat - Location to return the statistics
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_HOLDER_STATS
+void nxsem_holderstat(FAR struct semholder_stat_s *stat);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -236,9 +236,15 @@
 #define SNIOC_READROMCODE          _SNIOC(0x0067)  /* Arg: uint64_t* pointer */
 #define SNIOC_SETALARM             _SNIOC(0x0068)  /* Arg: struct ds18b20_alarm_s* */
 
+/* Each open file of a sensor device is a subscriber with its own cursor
+ * in the events published by the sensor, and its own activation, interval
+ * and batch latency set by the commands below.
+ */
+
 /* Command:      SNIOC_ACTIVATE
  * Description:  Enable or disable sensor
  * Argument:     true or false.
+ * Note:         The sensor runs while at least one subscriber enabled it.
  */
 
 #define SNIOC_ACTIVATE             _SNIOC(0x0080)
@@ -246,6 +252,8 @@
 /* Command:      SNIOC_SET_INTERVAL
  * Description:  Set interval between samples
  * Argument:     This is the interval pointer, in microseconds
+ * Note:         The sensor runs at the shortest interval of the
+ *               subscribers, the others only read every n'th event.
  */
 
 #define SNIOC_SET_INTERVAL         _SNIOC(0x0081)
@@ -253,6 +261,8 @@
 /* Command:      SNIOC_BATCH
  * Description:  Set batch latency between batch data.
  * Argument:     This is the latency pointer, in microseconds
+ * Note:         The subscriber is notified once per latency.  The sensor
+ *               batches at the shortest latency of the subscribers.
  */
 
 #define SNIOC_BATCH                _SNIOC(0x0082)
@@ -307,4 +317,27 @@
 
 #define SNIOC_SET_CALIBVALUE       _SNIOC(0x0087)
 
+/* Command:      SNIOC_GET_STATE
+ * Description:  Get the state of the circular buffer of upper half and of
+ *               the subscriber (the open file).
+ * Argument:     A pointer to struct sensor_state_s, is output parameter.
+ * Note:         Together with mmap() of the sensor device, this lets the
+ *               application read events in place.  The events between
+ *               cursor and head are still to be read; since old events
+ *               are overwritten when the buffer is full, the application
+ *               should check that tail didn't pass the events it copied
+ *               out.
+ */
+
+#define SNIOC_GET_STATE            _SNIOC(0x0088)
+
+/* Command:      SNIOC_RELEASE
+ * Description:  Advance the cursor of the subscriber past the events that
+ *               the application read in place.
+ * Argument:     The number of bytes to release, a multiple of the size of
+ *               one event.
+ */
+
+#define SNIOC_RELEASE              _SNIOC(0x0089)
+
 #endif /* __INCLUDE_NUTTX_SENSORS_IOCTL_H */
@@ -544,6 +544,22 @@ struct sensor_event_gps_satellite
   info[4];
 };
 
+/* The state of the circular buffer of the upper half and of one
+ * subscriber as returned by SNIOC_GET_STATE.  head, tail and cursor are
+ * free running byte counters, the event at position pos begins at
+ * (pos % size) in the buffer mapped by mmap().
+ */
+
+struct sensor_state_s
+{
+  size_t   size;            /* The size of the buffer in bytes */
+  size_t   head;            /* The position after the newest event */
+  size_t   tail;            /* The position of the oldest event */
+  size_t   cursor;          /* The position of next event to read */
+  uint32_t overrun;         /* Events overwritten before they were read */
+  uint32_t esize;           /* The size of one event in bytes */
+};
+
 /* The sensor lower half driver interface */
 
 struct sensor_lowerhalf_s;
@@ -780,13 +796,19 @@ struct sensor_lowerhalf_s
        * Name: push_event
        *
        * Description:
-       *   Lower half driver pushes a sensor event by calling this function.
+       *   Lower half driver pushes sensor events by calling this function.
        *   It is provided by upper half driver to lower half driver.
        *
+       *   A driver with a hardware fifo should push the whole fifo content
+       *   in one call rather than one event at a time: the events are
+       *   copied into the circular buffer at once and the readers are
+       *   notified only once.
+       *
        * Input Parameters:
        *   priv   - Upper half driver handle
-       *   data   - The buffer of event, it can be all type of sensor events.
-       *   bytes  - The number of bytes of sensor event
+       *   data   - The buffer of events, it can be all type of sensor events
+       *   bytes  - The number of bytes of sensor events, a multiple of the
+       *            size of one event.
        **********************************************************************/
 
       CODE void (*push_event)(FAR void *priv, FAR const void *data,
@@ -135,6 +135,7 @@ struct uart_dmaxfer_s
   size_t           length;  /* Length of first DMA buffer */
   size_t           nlength; /* Length of next DMA buffer */
   size_t           nbytes;  /* Bytes actually transferred by DMA from both buffers */
+  size_t           ncommit; /* Bytes already added to the RX buffer (RX only) */
 };
 #endif /* CONFIG_SERIAL_RXDMA || CONFIG_SERIAL_TXDMA */
 
@@ -273,6 +274,7 @@ struct uart_dev_s
   uint8_t              open_count;   /* Number of times the device has been opened */
   volatile bool        xmitwaiting;  /* true: User waiting for space in xmit.buffer */
   volatile bool        recvwaiting;  /* true: User waiting for data in recv.buffer */
+  volatile int16_t     recvmin;      /* Bytes in recv.buffer that wake up the user */
 #ifdef CONFIG_SERIAL_REMOVABLE
   volatile bool        disconnected; /* true: Removable device is not connected */
 #endif
@@ -288,6 +290,8 @@ struct uart_dev_s
   tcflag_t             tc_iflag;     /* Input modes */
   tcflag_t             tc_oflag;     /* Output modes */
   tcflag_t             tc_lflag;     /* Local modes */
+  cc_t                 tc_vmin;      /* VMIN: Minimum bytes returned by read() */
+  cc_t                 tc_vtime;     /* VTIME: read() timeout in deciseconds */
 #endif
 
   /* Semaphores */
@@ -483,6 +487,21 @@ void uart_recvchars_dma(FAR uart_dev_t *dev);
 void uart_recvchars_done(FAR uart_dev_t *dev);
 #endif
 
+/****************************************************************************
+ * Name: uart_recvchars_idle
+ *
+ * Description:
+ *  Add the bytes that an RX DMA transfer has received so far to the RX
+ *  circular buffer without ending the transfer.  The lower half calls this
+ *  on an idle-line or receive timeout event after updating dmarx.nbytes
+ *  with the total number of bytes received by the running transfer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_idle(FAR uart_dev_t *dev);
+#endif
+
 /****************************************************************************
  * Name: uart_reset_sem
  *
@@ -100,6 +100,26 @@ extern "C"
 void add_file_action(FAR posix_spawn_file_actions_t *file_action,
                      FAR struct spawn_general_file_action_s *entry);
 
+/****************************************************************************
+ * Name: spawn_file_actions
+ *
+ * Description:
+ *   Perform the file actions on the file list of a new task after
+ *   nxtask_init() and before the task is activated.
+ *
+ * Input Parameters:
+ *   tcb     - The TCB of the new task
+ *   actions - The file actions to be performed (may be NULL)
+ *
+ * Returned Value:
+ *   0 (OK) on success; A negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+struct tcb_s; /* Forward reference */
+int spawn_file_actions(FAR struct tcb_s *tcb,
+                       FAR const posix_spawn_file_actions_t *actions);
+
 #ifdef __cplusplus
 }
 #endif
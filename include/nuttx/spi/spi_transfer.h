@@ -31,6 +31,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <queue.h>
+
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/spi/spi.h>
 
@@ -112,6 +114,30 @@ struct spi_sequence_s
   FAR struct spi_trans_s *trans;
 };
 
+#ifdef CONFIG_SPI_QUEUE
+/* This describes one sequence queued for asynchronous execution by
+ * spi_queue_submit().  The message and the sequence it refers to belong to
+ * the caller and must stay valid until the callback has been called.
+ */
+
+struct spi_message_s;
+typedef CODE void (*spi_complete_t)(FAR struct spi_message_s *msg,
+                                    int result);
+
+struct spi_message_s
+{
+  sq_entry_t flink;               /* Implementation specific: queue link */
+  FAR struct spi_sequence_s *seq; /* The sequence of transfers */
+  uint8_t priority;               /* Higher priorities are executed first */
+  spi_complete_t callback;        /* Called on the bus thread when done */
+  FAR void *arg;                  /* Opaque argument for the callback */
+};
+
+/* The bus queue is opaque to its users */
+
+struct spi_queue_s;
+#endif
+
 /****************************************************************************
  * Public Functions Definitions
  ****************************************************************************/
@@ -161,6 +187,89 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq);
 int spi_register(FAR struct spi_dev_s *spi, int bus);
 #endif
 
+/****************************************************************************
+ * Name: spi_queue_initialize
+ *
+ * Description:
+ *   Create the transaction queue of one SPI bus and start the kernel
+ *   thread that executes the queued sequences back-to-back.  All devices
+ *   on the bus that want asynchronous transfers share the same queue.
+ *
+ * Input Parameters:
+ *   spi - An instance of the lower half SPI driver
+ *
+ * Returned Value:
+ *   The queue handle on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPI_QUEUE
+FAR struct spi_queue_s *spi_queue_initialize(FAR struct spi_dev_s *spi);
+
+/****************************************************************************
+ * Name: spi_queue_submit
+ *
+ * Description:
+ *   Queue a sequence of transfers for execution by the bus thread and
+ *   return immediately.  Messages are executed in priority order, and in
+ *   submission order for equal priorities.  msg->callback is called on
+ *   the bus thread with the result of spi_transfer() once the sequence has
+ *   completed.  This function may be called from the callback.
+ *
+ * Input Parameters:
+ *   queue - The queue returned by spi_queue_initialize()
+ *   msg   - The message to queue.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_submit(FAR struct spi_queue_s *queue,
+                     FAR struct spi_message_s *msg);
+
+/****************************************************************************
+ * Name: spi_queue_cancel
+ *
+ * Description:
+ *   Remove a message that has not been started yet from the queue.  The
+ *   callback of a cancelled message is not called.
+ *
+ * Input Parameters:
+ *   queue - The queue returned by spi_queue_initialize()
+ *   msg   - The message to remove.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if the message is not queued, i.e. it
+ *   is already running or completed.
+ *
+ ****************************************************************************/
+
+int spi_queue_cancel(FAR struct spi_queue_s *queue,
+                     FAR struct spi_message_s *msg);
+
+/****************************************************************************
+ * Name: spi_queue_transfer
+ *
+ * Description:
+ *   Execute a sequence through the bus queue and wait for its completion.
+ *   This lets synchronous users take part in the priority ordering of the
+ *   bus.
+ *
+ * Input Parameters:
+ *   queue    - The queue returned by spi_queue_initialize()
+ *   seq      - Describes the sequence of transfers.
+ *   priority - The priority of the sequence.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_transfer(FAR struct spi_queue_s *queue,
+                       FAR struct spi_sequence_s *seq, uint8_t priority);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 #define EXTERN extern "C"
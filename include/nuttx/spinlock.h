@@ -28,15 +28,12 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <nuttx/irq.h>
 
-#ifndef CONFIG_SPINLOCK
-typedef struct
-{
-} spinlock_t;
-#else
+#ifdef CONFIG_SPINLOCK
 
 /* The architecture specific spinlock.h header file must also provide the
  * following:
@@ -48,7 +45,8 @@ typedef struct
  * SP_LOCKED and SP_UNLOCKED must be constants of type spinlock_t.
  */
 
-#include <arch/spinlock.h>
+#  include <arch/spinlock.h>
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -58,17 +56,21 @@ typedef struct
  *
  *   DMB - Data memory barrier.  Assures writes are completed to memory.
  *   DSB - Data synchronization barrier.
+ *
+ * Otherwise no other CPU can observe the accesses out of order, but the
+ * compiler must still not move them across the barrier.  The barriers are
+ * also available without CONFIG_SPINLOCK.
  */
 
 #undef __SP_UNLOCK_FUNCTION
 #if !defined(SP_DMB)
-#  define SP_DMB()
+#  define SP_DMB() __asm__ __volatile__("" ::: "memory")
 #else
 #  define __SP_UNLOCK_FUNCTION 1
 #endif
 
 #if !defined(SP_DSB)
-#  define SP_DSB()
+#  define SP_DSB() __asm__ __volatile__("" ::: "memory")
 #endif
 
 #if !defined(SP_WFE)
@@ -83,6 +85,45 @@ typedef struct
 #  define __SP_UNLOCK_FUNCTION 1
 #endif
 
+#ifndef CONFIG_SPINLOCK
+typedef struct
+{
+} spinlock_t;
+#else
+
+#ifdef CONFIG_RW_SPINLOCK
+/* Static initializer and initialization of a reader-writer spinlock */
+
+#  define RW_SP_UNLOCKED  { SP_UNLOCKED, false, 0 }
+#  define rwlock_init(l) \
+  do \
+    { \
+      (l)->lock    = SP_UNLOCKED; \
+      (l)->writer  = false; \
+      (l)->readers = 0; \
+    } \
+  while (0)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+/* A reader-writer spinlock.  Any number of readers may hold it at the same
+ * time, but a writer holds it alone.  A waiting writer keeps new readers
+ * out, so readers cannot starve it.  The state is protected by a plain
+ * spinlock, so no atomic operation beyond up_testset() is needed.
+ */
+
+typedef struct
+{
+  spinlock_t lock;             /* Protects the state below */
+  volatile bool writer;        /* A writer holds the lock or waits for it */
+  volatile uint16_t readers;   /* Number of readers holding the lock */
+} rwlock_t;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -351,6 +392,57 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
                  FAR volatile spinlock_t *orlock);
 #endif
 
+/****************************************************************************
+ * Name: read_lock, read_trylock, read_unlock
+ *
+ * Description:
+ *   Take, try to take or release the reader-writer spinlock for reading.
+ *   Several readers may hold the lock at once.  read_trylock() returns
+ *   true if the lock was taken.
+ *
+ * Input Parameters:
+ *   lock - A reference to the reader-writer spinlock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+void read_lock(FAR volatile rwlock_t *lock);
+bool read_trylock(FAR volatile rwlock_t *lock);
+void read_unlock(FAR volatile rwlock_t *lock);
+
+/****************************************************************************
+ * Name: write_lock, write_trylock, write_unlock
+ *
+ * Description:
+ *   Take, try to take or release the reader-writer spinlock for writing.
+ *   The writer excludes both readers and other writers.  write_trylock()
+ *   returns true if the lock was taken.
+ *
+ * Input Parameters:
+ *   lock - A reference to the reader-writer spinlock.
+ *
+ ****************************************************************************/
+
+void write_lock(FAR volatile rwlock_t *lock);
+bool write_trylock(FAR volatile rwlock_t *lock);
+void write_unlock(FAR volatile rwlock_t *lock);
+
+/****************************************************************************
+ * Name: read_lock_irqsave, read_unlock_irqrestore,
+ *       write_lock_irqsave, write_unlock_irqrestore
+ *
+ * Description:
+ *   As above, but also disable the local interrupts while the lock is
+ *   held and restore them when it is released.
+ *
+ ****************************************************************************/
+
+irqstate_t read_lock_irqsave(FAR volatile rwlock_t *lock);
+void read_unlock_irqrestore(FAR volatile rwlock_t *lock, irqstate_t flags);
+irqstate_t write_lock_irqsave(FAR volatile rwlock_t *lock);
+void write_unlock_irqrestore(FAR volatile rwlock_t *lock, irqstate_t flags);
+#endif /* CONFIG_RW_SPINLOCK */
+
 #endif /* CONFIG_SPINLOCK */
 
 /****************************************************************************
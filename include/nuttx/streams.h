@@ -29,9 +29,13 @@
 
 #include <lzf.h>
 #include <stdio.h>
+#include <nuttx/lib/lz4.h>
 #ifndef CONFIG_DISABLE_MOUNTPOINT
 #include <nuttx/fs/fs.h>
 #endif
+#ifdef CONFIG_MTD
+#include <nuttx/mtd/mtd.h>
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -41,6 +45,10 @@
 #define LZF_STREAM_BLOCKSIZE  ((1 << CONFIG_STREAM_LZF_BLOG) - 1)
 #endif
 
+#ifdef CONFIG_LIBC_LZ4
+#define LZ4_STREAM_BLOCKSIZE  (1 << CONFIG_STREAM_LZ4_BLOG)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -200,6 +208,21 @@ struct lib_lzfoutstream_s
 };
 #endif
 
+/* LZ4 compressed stream pipeline, the output is in the LZ4 frame format */
+
+#ifdef CONFIG_LIBC_LZ4
+struct lib_lz4outstream_s
+{
+  struct lib_outstream_s      public;
+  FAR struct lib_outstream_s *backend;
+  lz4_state_t                 state;
+  size_t                      offset;
+  bool                        framed;  /* The frame header has been sent */
+  uint8_t                     in[LZ4_STREAM_BLOCKSIZE];
+  uint8_t                     out[LZ4_BOUND(LZ4_STREAM_BLOCKSIZE)];
+};
+#endif
+
 #ifndef CONFIG_DISABLE_MOUNTPOINT
 struct lib_blkoutstream_s
 {
@@ -210,6 +233,16 @@ struct lib_blkoutstream_s
 };
 #endif
 
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_MTD)
+struct lib_mtdoutstream_s
+{
+  struct lib_outstream_s public;
+  FAR struct inode      *inode;
+  struct mtd_geometry_s  geo;
+  FAR unsigned char     *cache;   /* One erase block */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -387,6 +420,29 @@ void lib_lzfoutstream(FAR struct lib_lzfoutstream_s *stream,
                       FAR struct lib_outstream_s *backend);
 #endif
 
+/****************************************************************************
+ * Name: lib_lz4outstream
+ *
+ * Description:
+ *  LZ4 compressed pipeline stream.  The data is written as an LZ4 frame
+ *  that the lz4 command line tool can decompress.  Every flush ends the
+ *  frame; data put after it starts a new one.
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_lz4outstream_s to be initialized.
+ *   backend - Stream backend port.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LZ4
+void lib_lz4outstream(FAR struct lib_lz4outstream_s *stream,
+                      FAR struct lib_outstream_s *backend);
+#endif
+
 /****************************************************************************
  * Name: lib_blkoutstream_open
  *
@@ -427,6 +483,47 @@ int lib_blkoutstream_open(FAR struct lib_blkoutstream_s *stream,
 void lib_blkoutstream_close(FAR struct lib_blkoutstream_s *stream);
 #endif
 
+/****************************************************************************
+ * Name: lib_mtdoutstream_open
+ *
+ * Description:
+ *  open MTD driver stream backend.  The data is written one whole erase
+ *  block at a time from the start of the device.
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_mtdoutstream_s to be initialized.
+ *   name    - The full path to the MTD driver to be opened.
+ *
+ * Returned Value:
+ *   Returns zero on success or a negated errno on failure
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_MTD)
+int lib_mtdoutstream_open(FAR struct lib_mtdoutstream_s *stream,
+                          FAR const char *name);
+#endif
+
+/****************************************************************************
+ * Name: lib_mtdoutstream_close
+ *
+ * Description:
+ *  close MTD driver stream backend
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_mtdoutstream_s to be initialized.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_MTD)
+void lib_mtdoutstream_close(FAR struct lib_mtdoutstream_s *stream);
+#endif
+
 /****************************************************************************
  * Name: lib_noflush
  *
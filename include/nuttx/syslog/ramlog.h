@@ -40,6 +40,11 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/syslog/syslog.h>
 
 #ifdef CONFIG_RAMLOG
@@ -78,6 +83,46 @@
 #  define CONFIG_RAMLOG_BUFSIZE 1024
 #endif
 
+/* IOCTL Commands ***********************************************************/
+
+/* In addition to FIONREAD, the RAMLOG device supports:
+ *
+ * FIOC_MMAP    - Return the address of the circular buffer, so that
+ *                mmap() can map the log without copying it.  Such a
+ *                reader does not remove any data from the buffer.
+ *                Argument: A writable pointer to a void pointer
+ * RAMLOGIOC_GETSTATE
+ *              - Return the state of the circular buffer, so that a
+ *                reader of the mapped buffer can locate the data and
+ *                detect data lost to overwrites.
+ *                Argument: A writable pointer to struct ramlog_state_s
+ */
+
+#define RAMLOGIOC_GETSTATE      _RAMLOGIOC(0x0001)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The argument of RAMLOGIOC_GETSTATE.
+ *
+ * rs_seq counts all bytes ever added to the log and wraps at 2^32.  The
+ * byte with sequence number 'seq' is at offset
+ * (rs_head + rs_size - (rs_seq - seq) % rs_size) % rs_size in the buffer,
+ * as long as rs_seq - seq does not exceed the number of bytes in the
+ * buffer, (rs_head + rs_size - rs_tail) % rs_size.  A reader that copied
+ * data starting at 'seq' checks again after the copy: if rs_seq - seq then
+ * exceeds rs_size - 1, the data was overwritten while it was copied.
+ */
+
+struct ramlog_state_s
+{
+  size_t   rs_size;  /* Size of the circular buffer */
+  size_t   rs_head;  /* Offset where the next byte will be added */
+  size_t   rs_tail;  /* Offset of the oldest byte in the buffer */
+  uint32_t rs_seq;   /* Number of bytes added to the log, wrapping */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -44,6 +44,11 @@ extern "C"
 
 void up_alarm_set_lowerhalf(FAR struct oneshot_lowerhalf_s *lower);
 
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+void up_cpu_alarm_set_lowerhalf(int cpu,
+                                FAR struct oneshot_lowerhalf_s *lower);
+#endif
+
 #else
 
 #  define up_alarm_set_lowerhalf(lower)
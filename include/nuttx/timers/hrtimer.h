@@ -0,0 +1,189 @@
+/****************************************************************************
+ * include/nuttx/timers/hrtimer.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_TIMERS_HRTIMER_H
+#define __INCLUDE_NUTTX_TIMERS_HRTIMER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/timers/oneshot.h>
+
+#ifdef CONFIG_HRTIMER
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HRTIMER_ISACTIVE(t)  ((t)->func != NULL)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* How the expiration time passed to hrtimer_start() is interpreted */
+
+enum hrtimer_mode_e
+{
+  HRTIMER_MODE_ABS = 0,        /* Absolute time, see hrtimer_current() */
+  HRTIMER_MODE_REL             /* Relative to the current time */
+};
+
+/* This is the form of the function that is called when the timer expires.
+ * It runs in the context of the oneshot timer interrupt handler.
+ */
+
+struct hrtimer_s;
+typedef CODE void (*hrtimer_entry_t)(FAR struct hrtimer_s *timer,
+                                     FAR void *arg);
+
+/* This is the internal representation of one high resolution timer.  It
+ * must not be modified by the user while the timer is active.
+ */
+
+struct hrtimer_s
+{
+  FAR struct hrtimer_s *child; /* First child in the pairing heap */
+  FAR struct hrtimer_s *next;  /* Next sibling in the pairing heap */
+  FAR struct hrtimer_s *prev;  /* Previous sibling, or parent if first */
+  hrtimer_entry_t func;        /* Function to execute on expiration */
+  FAR void *arg;               /* Callback argument */
+  uint64_t expired;            /* Absolute expiration time (nanoseconds) */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: hrtimer_initialize
+ *
+ * Description:
+ *   Bind the high resolution timers to a oneshot timer lower half.  This is
+ *   normally called once by board bring-up logic.  The lower half must
+ *   implement the 'current' method and not be used by anything else (in
+ *   particular, it must not be the lower half given to
+ *   up_alarm_set_lowerhalf()).
+ *
+ * Input Parameters:
+ *   lower - An instance of the oneshot lower half driver
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int hrtimer_initialize(FAR struct oneshot_lowerhalf_s *lower);
+
+/****************************************************************************
+ * Name: hrtimer_current
+ *
+ * Description:
+ *   Return the current time of the high resolution timer clock, the time
+ *   base of the absolute expiration times.
+ *
+ * Returned Value:
+ *   The time in nanoseconds since the oneshot lower half was initialized,
+ *   or zero if hrtimer_initialize() has not been called.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_current(void);
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start a high resolution timer.  If the timer is already active, it is
+ *   restarted with the new parameters.  This may be called from interrupt
+ *   handlers, including from the callback of a timer to restart it.
+ *
+ * Input Parameters:
+ *   timer - The timer to start
+ *   ns    - The expiration time in nanoseconds
+ *   mode  - Whether 'ns' is absolute or relative to the current time
+ *   func  - Function to call on expiration.
+ *   arg   - Parameter to pass to func
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENODEV is returned if no oneshot
+ *   lower half has been provided; -EINVAL on invalid parameters.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *timer, uint64_t ns,
+                  enum hrtimer_mode_e mode, hrtimer_entry_t func,
+                  FAR void *arg);
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Cancel a high resolution timer.
+ *
+ * Input Parameters:
+ *   timer - The timer to cancel
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EINVAL is returned if the timer was
+ *   not active.
+ *
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *timer);
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the time remaining before a high resolution timer expires.
+ *
+ * Input Parameters:
+ *   timer - The timer to query
+ *
+ * Returned Value:
+ *   The remaining time in nanoseconds.  Zero means that the timer is not
+ *   active or is about to expire.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(FAR struct hrtimer_s *timer);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_HRTIMER */
+#endif /* __INCLUDE_NUTTX_TIMERS_HRTIMER_H */
@@ -0,0 +1,163 @@
+/****************************************************************************
+ * include/nuttx/timers/ptp_clock.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_TIMERS_PTP_CLOCK_H
+#define __INCLUDE_NUTTX_TIMERS_PTP_CLOCK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+#include <nuttx/fs/ioctl.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef CONFIG_PTP_CLOCK
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* IOCTL Commands ***********************************************************/
+
+/* The PTP hardware clock (PHC) is the free-running, adjustable clock of a
+ * network interface that timestamps IEEE 1588 packets.  Its character
+ * driver, /dev/ptpN, supports the following commands:
+ *
+ * PTPIOC_GETCAPS   - Get the capabilities of the clock
+ *                    Argument: A pointer to struct ptp_clock_caps_s
+ * PTPIOC_GETTIME   - Read the clock
+ *                    Argument: A pointer to struct timespec
+ * PTPIOC_SETTIME   - Set the clock
+ *                    Argument: A pointer to a const struct timespec
+ * PTPIOC_ADJTIME   - Step the clock by a signed number of nanoseconds
+ *                    Argument: A pointer to a const int64_t
+ * PTPIOC_ADJFREQ   - Set the frequency offset of the clock in parts per
+ *                    billion, within +/- max_adj of the capabilities
+ *                    Argument: The offset, as a long
+ * PTPIOC_SYSOFFSET - Sample CLOCK_REALTIME, the PHC and CLOCK_REALTIME
+ *                    again, back to back, to estimate the offset between
+ *                    the two clocks
+ *                    Argument: A pointer to struct ptp_sys_offset_s
+ */
+
+#define PTPIOC_GETCAPS    _PTPIOC(0x0001)
+#define PTPIOC_GETTIME    _PTPIOC(0x0002)
+#define PTPIOC_SETTIME    _PTPIOC(0x0003)
+#define PTPIOC_ADJTIME    _PTPIOC(0x0004)
+#define PTPIOC_ADJFREQ    _PTPIOC(0x0005)
+#define PTPIOC_SYSOFFSET  _PTPIOC(0x0006)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Argument of PTPIOC_GETCAPS */
+
+struct ptp_clock_caps_s
+{
+  long max_adj;                 /* Largest frequency offset, in ppb */
+};
+
+/* Argument of PTPIOC_SYSOFFSET */
+
+struct ptp_sys_offset_s
+{
+  struct timespec ts[3];        /* System time, PHC time, system time */
+};
+
+/* The lower half of a PTP hardware clock, provided by the Ethernet driver.
+ * gettime, settime and adjfreq are mandatory; without adjtime the upper
+ * half steps the clock with gettime and settime.  The methods may be
+ * called from any task, but never concurrently for the same clock.
+ */
+
+struct ptp_lowerhalf_s;
+struct ptp_ops_s
+{
+  CODE int (*gettime)(FAR struct ptp_lowerhalf_s *lower,
+                      FAR struct timespec *ts);
+  CODE int (*settime)(FAR struct ptp_lowerhalf_s *lower,
+                      FAR const struct timespec *ts);
+  CODE int (*adjtime)(FAR struct ptp_lowerhalf_s *lower, int64_t delta);
+  CODE int (*adjfreq)(FAR struct ptp_lowerhalf_s *lower, long ppb);
+
+  /* Any ioctl commands not handled by the upper half */
+
+  CODE int (*ioctl)(FAR struct ptp_lowerhalf_s *lower, int cmd,
+                    unsigned long arg);
+};
+
+struct ptp_lowerhalf_s
+{
+  FAR const struct ptp_ops_s *ops;
+  long max_adj;                 /* Largest frequency offset, in ppb */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: ptp_clock_register
+ *
+ * Description:
+ *   Register a PTP hardware clock as /dev/ptpN.
+ *
+ * Input Parameters:
+ *   lower - The lower half of the clock.  It must stay valid until the
+ *           clock is unregistered.
+ *   devno - The N of /dev/ptpN
+ *
+ * Returned Value:
+ *   A handle for ptp_clock_unregister() on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR void *ptp_clock_register(FAR struct ptp_lowerhalf_s *lower, int devno);
+
+/****************************************************************************
+ * Name: ptp_clock_unregister
+ *
+ * Description:
+ *   Remove a PTP hardware clock registered by ptp_clock_register().
+ *
+ ****************************************************************************/
+
+void ptp_clock_unregister(FAR void *handle);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_PTP_CLOCK */
+#endif /* __INCLUDE_NUTTX_TIMERS_PTP_CLOCK_H */
@@ -65,12 +65,15 @@
 /* type tls_ndxset_t & tls_dtor_t *******************************************/
 
 /* Smallest addressable type that can hold the entire configured number of
- * TLS data indexes.
+ * TLS data indexes.  Beyond 64 indexes, the set is an array of 32-bit
+ * words.
  */
 
 #if CONFIG_TLS_NELEM > 0
-#  if CONFIG_TLS_NELEM > 64
+#  if CONFIG_TLS_NELEM > 1024
 #    error Too many TLS elements
+#  elif CONFIG_TLS_NELEM > 64
+     typedef uint32_t tls_ndxset_t;
 #  elif CONFIG_TLS_NELEM > 32
      typedef uint64_t tls_ndxset_t;
 #  elif CONFIG_TLS_NELEM > 16
@@ -81,6 +84,12 @@
      typedef uint8_t tls_ndxset_t;
 #  endif
 
+#  define TLS_NDXSET_BITS    (8 * sizeof(tls_ndxset_t))
+#  define TLS_NDXSET_NWORDS  ((CONFIG_TLS_NELEM + TLS_NDXSET_BITS - 1) / \
+                              TLS_NDXSET_BITS)
+#  define TLS_NDXSET_WORD(i) ((i) / TLS_NDXSET_BITS)
+#  define TLS_NDXSET_MASK(i) ((tls_ndxset_t)1 << ((i) % TLS_NDXSET_BITS))
+
 typedef CODE void (*tls_dtor_t)(FAR void *);
 
 #endif
@@ -124,7 +133,7 @@ struct task_info_s
   uintptr_t       ta_telem[CONFIG_TLS_TASK_NELEM]; /* Task local storage elements */
 #endif
 #if CONFIG_TLS_NELEM > 0
-  tls_ndxset_t    ta_tlsset;                    /* Set of TLS indexes allocated */
+  tls_ndxset_t    ta_tlsset[TLS_NDXSET_NWORDS]; /* Set of TLS indexes allocated */
   tls_dtor_t      ta_tlsdtor[CONFIG_TLS_NELEM]; /* List of TLS destructors      */
 #endif
 #ifndef CONFIG_BUILD_KERNEL
@@ -202,6 +211,8 @@ struct tls_info_s
   struct pthread_cleanup_s stack[CONFIG_PTHREAD_CLEANUP_STACKSIZE];
 #endif
 
+  pid_t tl_tid;                        /* Thread ID, readable without a
+                                        * system call */
   int tl_errno;                        /* Per-thread error number */
 };
 
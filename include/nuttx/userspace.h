@@ -75,7 +75,8 @@
  * Public Type Definitions
  ****************************************************************************/
 
-struct mm_heaps_s; /* Forward reference */
+struct mm_heaps_s;   /* Forward reference */
+struct clock_vdso_s; /* Forward reference */
 
 /* Every user-space blob starts with a header that provides information about
  * the blob.  The form of that header is provided by struct userspace_s. An
@@ -114,6 +115,12 @@ struct userspace_s
 #ifdef CONFIG_LIBC_USRWORK
   CODE int (*work_usrstart)(void);
 #endif
+
+  /* Kernel time published to user space */
+
+#ifdef CONFIG_CLOCK_VDSO
+  FAR struct clock_vdso_s *us_clockvdso;
+#endif
 };
 
 /****************************************************************************
@@ -533,6 +533,31 @@ struct fb_vtable_s
   int (*waitforvsync)(FAR struct fb_vtable_s *vtable);
 #endif
 
+#ifdef CONFIG_FB_ACCEL
+  /* The following are provided only if the video hardware has a 2D engine
+   * that can render into the framebuffer memory.  Each method returns OK
+   * if the engine accepted the request, or a negated errno value (e.g.
+   * -ENOSYS for an unsupported pixel format or size) if the caller has to
+   * render it by software instead.  Any method may be NULL.
+   *
+   * fillarea() and copyarea() may complete asynchronously.  accelsync()
+   * must then wait until all operations queued on the plane have finished;
+   * it is called before the CPU accesses the framebuffer memory.
+   * bltarea() reads from caller memory and must not return before the
+   * whole source image has been consumed.
+   */
+
+  int (*fillarea)(FAR struct fb_vtable_s *vtable, int planeno,
+                  FAR const struct fb_area_s *area, uint32_t color);
+  int (*copyarea)(FAR struct fb_vtable_s *vtable, int planeno,
+                  FAR const struct fb_area_s *area,
+                  fb_coord_t dstx, fb_coord_t dsty);
+  int (*bltarea)(FAR struct fb_vtable_s *vtable, int planeno,
+                 FAR const struct fb_area_s *area, FAR const void *src,
+                 fb_coord_t srcstride);
+  int (*accelsync)(FAR struct fb_vtable_s *vtable, int planeno);
+#endif
+
 #ifdef CONFIG_FB_OVERLAY
   /* Get information about the video controller configuration and the
    * configuration of each overlay.
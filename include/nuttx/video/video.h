@@ -66,7 +66,7 @@ extern "C"
 
 #define VIDIOC_S_PARM                 _VIDIOC(0x0006)
 
-/* Initiate user pointer I/O */
+/* Initiate user pointer or memory mapping I/O */
 
 #define VIDIOC_REQBUFS                _VIDIOC(0x0007)
 
@@ -172,6 +172,14 @@ extern "C"
 
 #define V4SIOC_S_EXT_CTRLS_SCENE      _VIDIOC(0x001a)
 
+/* Query the status of a buffer allocated by VIDIOC_REQBUFS with
+ * V4L2_MEMORY_MMAP.  The returned m.offset and length are passed to
+ * mmap() to access the frame in place.
+ *  Address pointing to struct v4l2_buffer
+ */
+
+#define VIDIOC_QUERYBUF               _VIDIOC(0x001b)
+
 #define VIDEO_HSIZE_QVGA        (320)   /* QVGA    horizontal size */
 #define VIDEO_VSIZE_QVGA        (240)   /* QVGA    vertical   size */
 #define VIDEO_HSIZE_VGA         (640)   /* VGA     horizontal size */
@@ -262,7 +270,9 @@ enum v4l2_buf_type
   V4L2_BUF_TYPE_STILL_CAPTURE        = 0x81  /* single-planar still capture stream */
 };
 
-/* Memory I/O method. Currently, support only V4L2_MEMORY_USERPTR. */
+/* Memory I/O method. Currently, support only V4L2_MEMORY_USERPTR and
+ * V4L2_MEMORY_MMAP (video stream only).
+ */
 
 enum v4l2_memory
 {
@@ -341,7 +351,7 @@ typedef struct v4l2_plane v4l2_plane_t;
 /* struct v4l2_buffer
  * Parameter of ioctl(VIDIOC_QBUF) and ioctl(VIDIOC_DQBUF).
  * Currently, support only index, type, bytesused, memory,
- * m.userptr, and length.
+ * m.userptr, m.offset and length.
  */
 
 struct v4l2_buffer
@@ -65,12 +65,14 @@ typedef CODE void (*wdentry_t)(wdparm_t arg);
 
 struct wdog_s
 {
-  FAR struct wdog_s *next;       /* Support for singly linked lists. */
+  FAR struct wdog_s *child;      /* First child in the pairing heap */
+  FAR struct wdog_s *next;       /* Next sibling in the pairing heap */
+  FAR struct wdog_s *prev;       /* Previous sibling, or parent if first */
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
 #endif
-  sclock_t           lag;        /* Timer associated with the delay */
+  clock_t            expired;    /* Tick at which the watchdog expires */
   wdparm_t           arg;        /* Callback argument */
 };
 
@@ -49,6 +49,14 @@
 #define bt_netdev_receive(btdev, type, data, len) \
         (btdev)->receive(btdev, type, data, len)
 
+/* Hand over an IOB holding the received frame from io_offset to io_len.
+ * The IOB belongs to the stack afterwards.  Only available if
+ * receive_iob is not NULL;  otherwise use bt_netdev_receive().
+ */
+
+#define bt_netdev_receive_iob(btdev, type, iob) \
+        (btdev)->receive_iob(btdev, type, iob)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -79,6 +87,14 @@ struct bt_driver_s
                       enum bt_buf_type_e type,
                       FAR void *data, size_t len);
 
+  /* Filled by register function but called by bt_driver_s.  Optional
+   * zero-copy alternative to receive(), may be NULL.
+   */
+
+  CODE int (*receive_iob)(FAR struct bt_driver_s *btdev,
+                          enum bt_buf_type_e type,
+                          FAR struct iob_s *iob);
+
   /* Filled by register function, shouldn't be touched by bt_driver_s */
 
   FAR void *priv;
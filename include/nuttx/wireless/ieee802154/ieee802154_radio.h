@@ -44,9 +44,17 @@
 
 struct ieee802154_txdesc_s
 {
-  /* Support a singly linked list of tx descriptors */
+  /* Support a singly linked list of tx descriptors.  The MAC keeps the
+   * indirect transactions in a doubly linked list, blink is only used
+   * there.
+   */
 
   FAR struct ieee802154_txdesc_s *flink;
+  FAR struct ieee802154_txdesc_s *blink;
+
+  /* Hash chain of the indirect transactions, keyed by the destination */
+
+  FAR struct ieee802154_txdesc_s *hlink;
 
   /* Destination Address */
 
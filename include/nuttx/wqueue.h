@@ -250,12 +250,14 @@ struct work_s
     struct
     {
       struct sq_entry_s sq; /* Implements a single linked list */
-      clock_t qtime;        /* Time work queued */
+      clock_t qtime;        /* Time when delayed work expires */
     } s;
-    struct wdog_s timer;    /* Delay expiry timer */
   } u;
   worker_t  worker;         /* Work callback */
   FAR void *arg;            /* Callback argument */
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  int16_t   cpu;            /* The CPU the work is bound to, or -1 */
+#endif
 };
 
 /* This is an enumeration of the various events that may be
@@ -363,6 +365,37 @@ int work_usrstart(void);
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_queue_cpu
+ *
+ * Description:
+ *   Queue kernel-mode work like work_queue() does, but to be performed on
+ *   the worker thread of one CPU only.  Without per-CPU work queues, this
+ *   is the same as work_queue().
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID
+ *   cpu    - The CPU that will perform the work
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.
+ *   arg    - The argument that will be passed to the worker callback.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKQUEUE_PERCPU) && \
+    (!defined(CONFIG_LIBC_USRWORK) || defined(__KERNEL__))
+int work_queue_cpu(int qid, int cpu, FAR struct work_s *work,
+                   worker_t worker, FAR void *arg, clock_t delay);
+#else
+#  define work_queue_cpu(qid, cpu, work, worker, arg, delay) \
+     work_queue(qid, work, worker, arg, delay)
+#endif
+
 /****************************************************************************
  * Name: work_cancel
  *
@@ -439,7 +472,7 @@ void work_foreach(int qid, work_foreach_t handler, FAR void *arg);
  ****************************************************************************/
 
 #ifdef __KERNEL__
-#  define work_timeleft(work) wd_gettime(&((work)->u.timer))
+sclock_t work_timeleft(FAR const struct work_s *work);
 #else
 #  define work_timeleft(work) ((sclock_t)((work)->u.s.qtime - clock()))
 #endif
@@ -260,6 +260,7 @@ struct pthread_cond_s
 {
   sem_t sem;
   clockid_t clockid;
+  FAR struct pthread_mutex_s *mutex;  /* Mutex of the last waiter */
 };
 
 #ifndef __PTHREAD_COND_T_DEFINED
@@ -267,7 +268,7 @@ typedef struct pthread_cond_s pthread_cond_t;
 #define __PTHREAD_COND_T_DEFINED 1
 #endif
 
-#define PTHREAD_COND_INITIALIZER {SEM_INITIALIZER(0), CLOCK_REALTIME }
+#define PTHREAD_COND_INITIALIZER {SEM_INITIALIZER(0), CLOCK_REALTIME, NULL}
 
 struct pthread_mutexattr_s
 {
@@ -355,7 +356,12 @@ typedef struct pthread_barrierattr_s pthread_barrierattr_t;
 
 struct pthread_barrier_s
 {
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+  sem_t        sem[2];  /* Waiters of the even and odd generations */
+  unsigned int state;   /* Generation and number of threads arrived */
+#else
   sem_t        sem;
+#endif
   unsigned int count;
 };
 
@@ -373,7 +379,7 @@ struct pthread_rwlock_s
 {
   pthread_mutex_t lock;
   pthread_cond_t  cv;
-  unsigned int num_readers;
+  unsigned int num_readers;  /* Atomic, with CONFIG_PTHREAD_SYNC_FASTPATH */
   unsigned int num_writers;
   bool write_in_progress;
 };
@@ -108,6 +108,7 @@ struct sem_s
   uint8_t flags;                 /* See PRIOINHERIT_FLAGS_* definitions */
 # if CONFIG_SEM_PREALLOCHOLDERS > 0
   FAR struct semholder_s *hhead; /* List of holders of semaphore counts */
+  struct semholder_s holder;     /* Inline slot for the first holder */
 # else
   struct semholder_s holder[2];  /* Slot for old and new holder */
 # endif
@@ -121,7 +122,7 @@ typedef struct sem_s sem_t;
 #ifdef CONFIG_PRIORITY_INHERITANCE
 # if CONFIG_SEM_PREALLOCHOLDERS > 0
 #  define SEM_INITIALIZER(c) \
-    {(c), 0, NULL}               /* semcount, flags, hhead */
+    {(c), 0, NULL, SEMHOLDER_INITIALIZER} /* semcount, flags, hhead, holder */
 # else
 #  define SEM_INITIALIZER(c) \
     {(c), 0, {SEMHOLDER_INITIALIZER, SEMHOLDER_INITIALIZER}} /* semcount, flags, holder[2] */
@@ -97,6 +97,13 @@ typedef unsigned int nfds_t;
 
 typedef uint32_t pollevent_t;
 
+/* The callback that poll_notify() calls when events are signalled on a
+ * pollfd.  If no callback is provided, the semaphore is posted instead.
+ */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+
 /* This is the NuttX variant of the standard pollfd structure.  The poll()
  * interfaces receive a variable length array of such structures.
  *
@@ -118,6 +125,7 @@ struct pollfd
 
   FAR void    *ptr;     /* The psock or file being polled */
   FAR sem_t   *sem;     /* Pointer to semaphore used to post output event */
+  pollcb_t     cb;      /* Notification callback or NULL (see pollcb_t) */
   FAR void    *priv;    /* For use by drivers */
 };
 
@@ -125,6 +125,10 @@
 #define MSG_NOSIGNAL   0x4000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE       0x8000 /* Sender will send more.  */
 
+/* recvmmsg(): Wait for the first message only */
+
+#define MSG_WAITFORONE 0x10000
+
 /* Protocol levels supported by get/setsockopt(): */
 
 #define SOL_SOCKET       1 /* Only socket-level options supported */
@@ -200,6 +204,14 @@
 #define SO_TIMESTAMP    16 /* Generates a timestamp for each incoming packet
                             * arg: integer value
                             */
+#define SO_TIMESTAMPING 17 /* Selects software and hardware timestamps
+                            * arg: SOF_TIMESTAMPING_* flags, see
+                            * <net/net_tstamp.h>
+                            */
+
+/* Control message carrying the timestamps selected with SO_TIMESTAMPING */
+
+#define SCM_TIMESTAMPING SO_TIMESTAMPING
 
 /* The options are unsupported but included for compatibility
  * and portability
@@ -215,6 +227,10 @@
 #define SOL_TCP         IPPROTO_TCP  /* See options in include/netinet/tcp.h */
 #define SOL_UDP         IPPROTO_UDP  /* See options in include/netinit/udp.h */
 
+/* Packet socket operations. */
+
+#define SOL_PACKET      263 /* See options in include/netpacket/packet.h */
+
 /* Bluetooth-level operations. */
 
 #define SOL_HCI         0  /* See options in include/netpacket/bluetooth.h */
@@ -322,6 +338,14 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* Used with sendmmsg() and recvmmsg() */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* Message */
+  unsigned int msg_len;         /* Number of bytes transferred */
+};
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -399,6 +423,12 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+struct timespec;
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -172,6 +172,7 @@ SYSCALL_LOOKUP(clock_gettime,              2)
 SYSCALL_LOOKUP(clock_settime,              2)
 #ifdef CONFIG_CLOCK_TIMEKEEPING
   SYSCALL_LOOKUP(adjtime,                  2)
+  SYSCALL_LOOKUP(clock_adjtime,            2)
 #endif
 
 /* The following are defined only if POSIX timers are supported */
@@ -233,6 +234,7 @@ SYSCALL_LOOKUP(dup2,                       2)
 SYSCALL_LOOKUP(fcntl,                      3)
 SYSCALL_LOOKUP(lseek,                      3)
 SYSCALL_LOOKUP(mmap,                       6)
+SYSCALL_LOOKUP(msync,                      3)
 SYSCALL_LOOKUP(open,                       3)
 SYSCALL_LOOKUP(opendir,                    1)
 SYSCALL_LOOKUP(readdir,                    1)
@@ -297,6 +299,11 @@ SYSCALL_LOOKUP(futimens,                   2)
   SYSCALL_LOOKUP(shmdt,                    1)
 #endif
 
+#ifdef CONFIG_FS_SHM
+  SYSCALL_LOOKUP(shm_open,                 3)
+  SYSCALL_LOOKUP(shm_unlink,               1)
+#endif
+
 /* The following are defined if pthreads are enabled */
 
 #ifndef CONFIG_DISABLE_PTHREAD
@@ -311,9 +318,9 @@ SYSCALL_LOOKUP(futimens,                   2)
   SYSCALL_LOOKUP(pthread_join,             2)
   SYSCALL_LOOKUP(pthread_mutex_destroy,    1)
   SYSCALL_LOOKUP(pthread_mutex_init,       2)
-  SYSCALL_LOOKUP(pthread_mutex_timedlock,  2)
-  SYSCALL_LOOKUP(pthread_mutex_trylock,    1)
-  SYSCALL_LOOKUP(pthread_mutex_unlock,     1)
+  SYSCALL_LOOKUP(nx_pthread_mutex_timedlock, 2)
+  SYSCALL_LOOKUP(nx_pthread_mutex_trylock, 1)
+  SYSCALL_LOOKUP(nx_pthread_mutex_unlock,  1)
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
   SYSCALL_LOOKUP(pthread_mutex_consistent, 1)
 #endif
@@ -367,9 +374,11 @@ SYSCALL_LOOKUP(futimens,                   2)
   SYSCALL_LOOKUP(recv,                     4)
   SYSCALL_LOOKUP(recvfrom,                 6)
   SYSCALL_LOOKUP(recvmsg,                  3)
+  SYSCALL_LOOKUP(recvmmsg,                 5)
   SYSCALL_LOOKUP(send,                     4)
   SYSCALL_LOOKUP(sendto,                   6)
   SYSCALL_LOOKUP(sendmsg,                  3)
+  SYSCALL_LOOKUP(sendmmsg,                 4)
   SYSCALL_LOOKUP(setsockopt,               5)
   SYSCALL_LOOKUP(socket,                   3)
 #endif
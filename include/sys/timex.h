@@ -0,0 +1,110 @@
+/****************************************************************************
+ * include/sys/timex.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SYS_TIMEX_H
+#define __INCLUDE_SYS_TIMEX_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/time.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Modes of struct timex, selecting what clock_adjtime() changes */
+
+#define ADJ_OFFSET        0x0001  /* Slew the clock by offset */
+#define ADJ_FREQUENCY     0x0002  /* Set the frequency offset to freq */
+#define ADJ_SETOFFSET     0x0100  /* Step the clock by time */
+#define ADJ_NANO          0x2000  /* offset and time.tv_usec are in ns */
+
+/* Status */
+
+#define STA_NANO          0x2000  /* Resolution of offset is ns */
+
+/* Return values of clock_adjtime() */
+
+#define TIME_OK           0       /* Clock synchronized */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A subset of the Linux and BSD structure, limited to what the NuttX
+ * timekeeping supports.  freq is in parts per million with a 16-bit
+ * fraction, as in Linux.
+ */
+
+struct timex
+{
+  unsigned int modes;     /* Mode selector, ADJ_* */
+  long offset;            /* Time offset, in us or ns with ADJ_NANO */
+  long freq;              /* Frequency offset, scaled ppm */
+  long maxerror;          /* Maximum error (not used) */
+  long esterror;          /* Estimated error (not used) */
+  int status;             /* Clock status, STA_* */
+  long constant;          /* PLL time constant (not used) */
+  long precision;         /* Clock precision, in us (read only) */
+  long tolerance;         /* Largest frequency offset, scaled ppm */
+  struct timeval time;    /* Time step of ADJ_SETOFFSET */
+  long tick;              /* Microseconds between clock ticks */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: clock_adjtime
+ *
+ * Description:
+ *   Read and adjust the clock given by clk_id.  Only CLOCK_REALTIME is
+ *   supported.
+ *
+ * Returned Value:
+ *   The clock state, TIME_OK, on success.  -1 on failure with errno set.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CLOCK_TIMEKEEPING
+int clock_adjtime(clockid_t clk_id, FAR struct timex *buf);
+#endif
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __INCLUDE_SYS_TIMEX_H */
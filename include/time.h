@@ -77,6 +77,12 @@
 
 #define CLOCK_BOOTTIME     2
 
+/* Like CLOCK_MONOTONIC, but read straight from the hardware counter when
+ * one is registered as clock source and never adjusted.
+ */
+
+#define CLOCK_MONOTONIC_RAW 4
+
 /* This is a flag that may be passed to the timer_settime() and
  * clock_nanosleep() functions.
  */
@@ -24,11 +24,121 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <assert.h>
 #include <errno.h>
 
 #include <nuttx/lib/builtin.h>
+#include <nuttx/lib/lib.h>
+#include <nuttx/semaphore.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The table of builtins is generated by the application build and is not
+ * necessarily sorted by name.  The first lookup checks; if it is not
+ * sorted, a table of indices sorted by name is built once so that all
+ * lookups can be binary searches.
+ */
+
+static sem_t g_builtin_sem = SEM_INITIALIZER(1);
+static FAR const struct builtin_s *g_sorted_table; /* Table checked */
+static int g_sorted_count;                         /* Its size when checked */
+static bool g_sorted_linear;                       /* Could not be indexed */
+static FAR uint16_t *g_sorted_index;               /* NULL if table sorted */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: builtin_compare
+ *
+ * Description:
+ *   qsort() comparison of two indices into g_builtins[].  Equal names keep
+ *   the order of the table so that a lookup finds the first of them, like
+ *   a linear search would.
+ *
+ ****************************************************************************/
+
+static int builtin_compare(FAR const void *a, FAR const void *b)
+{
+  int ia = *(FAR const uint16_t *)a;
+  int ib = *(FAR const uint16_t *)b;
+  int ret;
+
+  ret = strcmp(g_builtins[ia].name, g_builtins[ib].name);
+  return ret != 0 ? ret : ia - ib;
+}
+
+/****************************************************************************
+ * Name: builtin_sort
+ *
+ * Description:
+ *   Prepare the binary search of the current table of builtins.
+ *
+ * Assumptions:
+ *   The caller holds g_builtin_sem.
+ *
+ ****************************************************************************/
+
+static void builtin_sort(void)
+{
+  int i;
+
+  if (g_sorted_table == g_builtins && g_sorted_count == g_builtin_count)
+    {
+      return;
+    }
+
+  /* The table was replaced (see builtin_setlist()) or never checked */
+
+  lib_free(g_sorted_index);
+  g_sorted_index  = NULL;
+  g_sorted_linear = false;
+  g_sorted_table  = g_builtins;
+  g_sorted_count  = g_builtin_count;
+
+  for (i = 1; i < g_builtin_count; i++)
+    {
+      if (strcmp(g_builtins[i - 1].name, g_builtins[i].name) >= 0)
+        {
+          break;
+        }
+    }
+
+  if (i >= g_builtin_count)
+    {
+      return;
+    }
+
+  /* Not sorted: sort an array of indices instead of the (const) table.
+   * Fall back to the linear search if it cannot be allocated.
+   */
+
+  if (g_builtin_count <= UINT16_MAX)
+    {
+      g_sorted_index = lib_malloc(g_builtin_count * sizeof(uint16_t));
+    }
+
+  if (g_sorted_index == NULL)
+    {
+      g_sorted_linear = true;
+      return;
+    }
+
+  for (i = 0; i < g_builtin_count; i++)
+    {
+      g_sorted_index[i] = i;
+    }
+
+  qsort(g_sorted_index, g_builtin_count, sizeof(uint16_t), builtin_compare);
+}
 
 /****************************************************************************
  * Public Functions
@@ -56,15 +166,61 @@
 int builtin_isavail(FAR const char *appname)
 {
   FAR const char *name;
-  int i;
+  int index;
+  int low;
+  int high;
+  int mid;
+  int ret;
+
+  while ((ret = _SEM_WAIT(&g_builtin_sem)) < 0)
+    {
+      DEBUGASSERT(_SEM_ERRNO(ret) == EINTR || _SEM_ERRNO(ret) == ECANCELED);
+    }
+
+  builtin_sort();
 
-  for (i = 0; (name = builtin_getname(i)) != NULL; i++)
+  ret = -ENOENT;
+  if (g_sorted_linear)
     {
-      if (strcmp(name, appname) == 0)
+      for (index = 0; (name = builtin_getname(index)) != NULL; index++)
+        {
+          if (strcmp(name, appname) == 0)
+            {
+              ret = index;
+              break;
+            }
+        }
+    }
+  else
+    {
+      /* Find the first name that is not less than appname */
+
+      low  = 0;
+      high = g_builtin_count;
+      while (low < high)
+        {
+          mid   = (low + high) >> 1;
+          index = g_sorted_index != NULL ? g_sorted_index[mid] : mid;
+          if (strcmp(g_builtins[index].name, appname) < 0)
+            {
+              low = mid + 1;
+            }
+          else
+            {
+              high = mid;
+            }
+        }
+
+      if (low < g_builtin_count)
         {
-          return i;
+          index = g_sorted_index != NULL ? g_sorted_index[low] : low;
+          if (strcmp(g_builtins[index].name, appname) == 0)
+            {
+              ret = index;
+            }
         }
     }
 
-  return -ENOENT;
+  _SEM_POST(&g_builtin_sem);
+  return ret;
 }
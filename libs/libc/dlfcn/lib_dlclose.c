@@ -220,10 +220,26 @@ int dlclose(FAR void *handle)
 {
 #if defined(CONFIG_BUILD_FLAT)
   /* In the FLAT build, a shared library is essentially the same as a kernel
-   * module.
+   * module.  It is removed when the last dlopen() reference is closed.
    */
 
-  return rmmod(handle);
+  FAR struct module_s *modp = (FAR struct module_s *)handle;
+  int ret;
+
+  modlib_registry_lock();
+
+  if (modlib_registry_verify(modp) >= 0 && modp->nrefs > 0)
+    {
+      modp->nrefs--;
+      ret = OK;
+    }
+  else
+    {
+      ret = rmmod(handle);
+    }
+
+  modlib_registry_unlock();
+  return ret;
 
 #elif defined(CONFIG_BUILD_PROTECTED)
   /* The PROTECTED build is equivalent to the FLAT build EXCEPT that there
@@ -258,6 +258,9 @@ errout_with_lock:
 /* In the FLAT build, a shared library is essentially the same as a kernel
  * module.
  *
+ * Opening a library that is already loaded returns the same handle: the
+ * one copy of the module is shared and reference counted.
+ *
  * REVISIT:  Missing functionality:
  * - No automatic binding of symbols
  * - No dependencies
@@ -266,6 +269,7 @@ errout_with_lock:
 
 static inline FAR void *dlinsert(FAR const char *filename)
 {
+  FAR struct module_s *modp;
   FAR void *handle;
   FAR char *name;
 
@@ -277,11 +281,24 @@ static inline FAR void *dlinsert(FAR const char *filename)
       return NULL;
     }
 
-  /* Then install the file using the basename of the file as the module
-   * name.
+  /* Share the module if it is already installed.  Otherwise install the
+   * file using the basename of the file as the module name.
    */
 
-  handle = insmod(filename, basename(name));
+  modlib_registry_lock();
+
+  modp = modlib_registry_find(basename(name));
+  if (modp != NULL)
+    {
+      modp->nrefs++;
+      handle = modp;
+    }
+  else
+    {
+      handle = insmod(filename, basename(name));
+    }
+
+  modlib_registry_unlock();
   lib_free(name);
   return handle;
 }
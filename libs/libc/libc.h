@@ -95,10 +95,13 @@ int lib_mode2oflags(FAR const char *mode);
 /* Defined in lib_libfwrite.c */
 
 ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream);
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream);
 
 /* Defined in lib_libfread.c */
 
 ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream);
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream);
 
 /* Defined in lib_libfgets.c */
 
@@ -146,6 +149,12 @@ double lib_expi(size_t n);
 float lib_sqrtapprox(float x);
 #endif
 
+/* Defined in lib_libsincosf.c */
+
+#ifdef CONFIG_LIBM
+float lib_sincosf(float x, int quadrant);
+#endif
+
 /* Defined in lib_parsehostfile.c */
 
 #ifdef CONFIG_NETDB_HOSTFILE
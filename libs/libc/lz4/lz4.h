@@ -0,0 +1,119 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_LZ4_LZ4_H
+#define __LIBS_LIBC_LZ4_LZ4_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* LZ4 block format:  Each sequence is a token, literal length extension
+ * bytes, the literals, a 16-bit little endian offset and match length
+ * extension bytes.  The high nibble of the token is the literal length,
+ * the low nibble the match length minus LZ4_MINMATCH; 15 means that
+ * extension bytes follow, each adding up to 255.  The last sequence has
+ * literals only.
+ */
+
+#define LZ4_MINMATCH        4
+#define LZ4_ML_BITS         4
+#define LZ4_ML_MASK         ((1 << LZ4_ML_BITS) - 1)
+#define LZ4_RUN_MASK        ((1 << (8 - LZ4_ML_BITS)) - 1)
+#define LZ4_MAX_DISTANCE    65535
+
+/* The last match must start at least LZ4_MFLIMIT bytes before the end of
+ * the block and the last LZ4_LASTLITERALS bytes are always literals.
+ */
+
+#define LZ4_MFLIMIT         12
+#define LZ4_LASTLITERALS    5
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+static inline uint32_t lz4_read32(FAR const uint8_t *p)
+{
+  uint32_t v;
+
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/****************************************************************************
+ * Name: lz4_count
+ *
+ * Description:
+ *   Return the number of bytes that match at p and ref, stopping at limit.
+ *   Compares a word at a time.
+ *
+ ****************************************************************************/
+
+static inline size_t lz4_count(FAR const uint8_t *p,
+                               FAR const uint8_t *ref,
+                               FAR const uint8_t *limit)
+{
+  FAR const uint8_t *start = p;
+  unsigned long a;
+  unsigned long b;
+
+  while (limit - p >= (ptrdiff_t)sizeof(unsigned long))
+    {
+      memcpy(&a, p, sizeof(a));
+      memcpy(&b, ref, sizeof(b));
+
+      if (a != b)
+        {
+#if defined(__GNUC__)
+#  ifdef CONFIG_ENDIAN_BIG
+          return p - start + __builtin_clzl(a ^ b) / 8;
+#  else
+          return p - start + __builtin_ctzl(a ^ b) / 8;
+#  endif
+#else
+          break;
+#endif
+        }
+
+      p   += sizeof(unsigned long);
+      ref += sizeof(unsigned long);
+    }
+
+  while (p < limit && *p == *ref)
+    {
+      p++;
+      ref++;
+    }
+
+  return p - start;
+}
+
+#endif /* __LIBS_LIBC_LZ4_LZ4_H */
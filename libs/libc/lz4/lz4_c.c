@@ -0,0 +1,219 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4_c.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+
+#include <nuttx/lib/lz4.h>
+
+#include "lz4/lz4.h"
+
+#ifdef CONFIG_LIBC_LZ4
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LZ4_HASH(v)     (((v) * 2654435761u) >> (32 - LZ4_HLOG))
+
+/* Steps through incompressible data grow by one byte every 2^SKIP_TRIGGER
+ * bytes without a match.
+ */
+
+#define LZ4_SKIP_TRIGGER 6
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_putlength
+ *
+ * Description:
+ *   Write the extension bytes for the part of a length that does not fit
+ *   into the token.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *lz4_putlength(FAR uint8_t *op, size_t len)
+{
+  for (; len >= 255; len -= 255)
+    {
+      *op++ = 255;
+    }
+
+  *op++ = (uint8_t)len;
+  return op;
+}
+
+/****************************************************************************
+ * Name: lz4_putliterals
+ *
+ * Description:
+ *   Write the token and literals of a sequence.  Returns NULL if they do
+ *   not fit together with the extra bytes that follow them.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *lz4_putliterals(FAR uint8_t *op, FAR uint8_t *oend,
+                                    FAR const uint8_t *anchor,
+                                    size_t litlen, size_t extra)
+{
+  if ((size_t)(oend - op) < 1 + litlen / 255 + 1 + litlen + extra)
+    {
+      return NULL;
+    }
+
+  if (litlen >= LZ4_RUN_MASK)
+    {
+      *op = LZ4_RUN_MASK << LZ4_ML_BITS;
+      op  = lz4_putlength(op + 1, litlen - LZ4_RUN_MASK);
+    }
+  else
+    {
+      *op++ = (uint8_t)(litlen << LZ4_ML_BITS);
+    }
+
+  memcpy(op, anchor, litlen);
+  return op + litlen;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_compress
+ *
+ * Description:
+ *   Compress in_len bytes at in_data into an LZ4 block.  A greedy parser
+ *   with a single-entry hash table of 4-byte sequences.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress(FAR const void *in_data, size_t in_len,
+                    FAR void *out_data, size_t out_len, lz4_state_t htab)
+{
+  FAR const uint8_t *base   = in_data;
+  FAR const uint8_t *ip     = base;
+  FAR const uint8_t *anchor = base;
+  FAR const uint8_t *iend   = base + in_len;
+  FAR const uint8_t *mflimit;
+  FAR const uint8_t *mlimit;
+  FAR const uint8_t *ref;
+  FAR uint8_t *op   = out_data;
+  FAR uint8_t *oend = op + out_len;
+  FAR uint8_t *token;
+  unsigned int searches;
+  uint32_t seq;
+  uint32_t h;
+  size_t mlen;
+  size_t off;
+
+  if (in_len < LZ4_MFLIMIT + 1)
+    {
+      goto lastliterals;
+    }
+
+  memset(htab, 0, sizeof(lz4_state_t));
+
+  mflimit  = iend - LZ4_MFLIMIT;
+  mlimit   = iend - LZ4_LASTLITERALS;
+  searches = 1 << LZ4_SKIP_TRIGGER;
+
+  while (ip < mflimit)
+    {
+      seq     = lz4_read32(ip);
+      h       = LZ4_HASH(seq);
+      ref     = base + htab[h];
+      htab[h] = (uint32_t)(ip - base);
+
+      if (ref >= ip || ip - ref > LZ4_MAX_DISTANCE ||
+          lz4_read32(ref) != seq)
+        {
+          ip += searches++ >> LZ4_SKIP_TRIGGER;
+          continue;
+        }
+
+      searches = 1 << LZ4_SKIP_TRIGGER;
+
+      /* Extend the match backwards into the pending literals */
+
+      while (ip > anchor && ref > base && *(ip - 1) == *(ref - 1))
+        {
+          ip--;
+          ref--;
+        }
+
+      mlen  = LZ4_MINMATCH + lz4_count(ip + LZ4_MINMATCH,
+                                       ref + LZ4_MINMATCH, mlimit);
+      off   = ip - ref;
+      token = op;
+
+      /* Literals, then the offset and up to mlen / 255 + 1 length bytes */
+
+      op = lz4_putliterals(op, oend, anchor, ip - anchor,
+                           2 + (mlen - LZ4_MINMATCH) / 255 + 1);
+      if (op == NULL)
+        {
+          return 0;
+        }
+
+      *op++ = (uint8_t)off;
+      *op++ = (uint8_t)(off >> 8);
+
+      mlen -= LZ4_MINMATCH;
+      if (mlen >= LZ4_ML_MASK)
+        {
+          *token |= LZ4_ML_MASK;
+          op      = lz4_putlength(op, mlen - LZ4_ML_MASK);
+        }
+      else
+        {
+          *token |= (uint8_t)mlen;
+        }
+
+      ip    += mlen + LZ4_MINMATCH;
+      anchor = ip;
+
+      /* Also remember the position just before the next search */
+
+      if (ip < mflimit)
+        {
+          htab[LZ4_HASH(lz4_read32(ip - 2))] = (uint32_t)(ip - 2 - base);
+        }
+    }
+
+lastliterals:
+  op = lz4_putliterals(op, oend, anchor, iend - anchor, 0);
+  if (op == NULL)
+    {
+      return 0;
+    }
+
+  return op - (FAR uint8_t *)out_data;
+}
+
+#endif /* CONFIG_LIBC_LZ4 */
@@ -0,0 +1,318 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4_d.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/lib/lz4.h>
+
+#include "lz4/lz4.h"
+
+#ifdef CONFIG_LIBC_LZ4
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* States of the streaming decoder */
+
+#define LZ4_STATE_TOKEN     0  /* Expecting a token */
+#define LZ4_STATE_LITLEN    1  /* Expecting literal length bytes */
+#define LZ4_STATE_LITERALS  2  /* Copying literals */
+#define LZ4_STATE_OFFSET0   3  /* Expecting the low byte of the offset */
+#define LZ4_STATE_OFFSET1   4  /* Expecting the high byte of the offset */
+#define LZ4_STATE_MATCHLEN  5  /* Expecting match length bytes */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_copymatch
+ *
+ * Description:
+ *   Copy len bytes from off bytes back in the output.  The regions overlap
+ *   if off < len, which repeats a short pattern; that is done bytewise.
+ *
+ ****************************************************************************/
+
+static inline void lz4_copymatch(FAR uint8_t *op, size_t off, size_t len)
+{
+  FAR const uint8_t *match = op - off;
+
+  if (off >= len)
+    {
+      memcpy(op, match, len);
+    }
+  else
+    {
+      while (len-- > 0)
+        {
+          *op++ = *match++;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_decompress
+ *
+ * Description:
+ *   Decompress an LZ4 block, checking every length and offset.
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress(FAR const void *in_data, size_t in_len,
+                      FAR void *out_data, size_t out_len)
+{
+  FAR const uint8_t *ip   = in_data;
+  FAR const uint8_t *iend = ip + in_len;
+  FAR uint8_t *op         = out_data;
+  FAR uint8_t *oend       = op + out_len;
+  size_t len;
+  size_t off;
+  uint8_t token;
+  uint8_t b;
+
+  while (ip < iend)
+    {
+      /* Literals */
+
+      token = *ip++;
+      len   = token >> LZ4_ML_BITS;
+      if (len == LZ4_RUN_MASK)
+        {
+          do
+            {
+              if (ip >= iend)
+                {
+                  goto corrupt;
+                }
+
+              b    = *ip++;
+              len += b;
+            }
+          while (b == 255);
+        }
+
+      if (len > (size_t)(iend - ip))
+        {
+          goto corrupt;
+        }
+
+      if (len > (size_t)(oend - op))
+        {
+          goto toobig;
+        }
+
+      memcpy(op, ip, len);
+      op += len;
+      ip += len;
+
+      /* The last sequence ends after its literals */
+
+      if (ip == iend)
+        {
+          return op - (FAR uint8_t *)out_data;
+        }
+
+      /* Match */
+
+      if (iend - ip < 2)
+        {
+          goto corrupt;
+        }
+
+      off = ip[0] | (ip[1] << 8);
+      ip += 2;
+
+      if (off == 0 || off > (size_t)(op - (FAR uint8_t *)out_data))
+        {
+          goto corrupt;
+        }
+
+      len = token & LZ4_ML_MASK;
+      if (len == LZ4_ML_MASK)
+        {
+          do
+            {
+              if (ip >= iend)
+                {
+                  goto corrupt;
+                }
+
+              b    = *ip++;
+              len += b;
+            }
+          while (b == 255);
+        }
+
+      len += LZ4_MINMATCH;
+      if (len > (size_t)(oend - op))
+        {
+          goto toobig;
+        }
+
+      lz4_copymatch(op, off, len);
+      op += len;
+    }
+
+corrupt:
+  set_errno(EINVAL);
+  return 0;
+
+toobig:
+  set_errno(E2BIG);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: lz4_stream_init
+ ****************************************************************************/
+
+void lz4_stream_init(FAR struct lz4_stream_s *stream, FAR void *out_data,
+                     size_t out_len)
+{
+  memset(stream, 0, sizeof(*stream));
+  stream->out    = out_data;
+  stream->outlen = out_len;
+  stream->state  = LZ4_STATE_TOKEN;
+}
+
+/****************************************************************************
+ * Name: lz4_stream_decompress
+ *
+ * Description:
+ *   Feed the next in_len bytes of an LZ4 block to the decoder.  The decoder
+ *   keeps its position within the current sequence between calls, so the
+ *   block may be split anywhere.
+ *
+ ****************************************************************************/
+
+ssize_t lz4_stream_decompress(FAR struct lz4_stream_s *stream,
+                              FAR const void *in_data, size_t in_len)
+{
+  FAR const uint8_t *ip   = in_data;
+  FAR const uint8_t *iend = ip + in_len;
+  size_t n;
+  uint8_t b;
+
+  while (ip < iend)
+    {
+      switch (stream->state)
+        {
+          case LZ4_STATE_TOKEN:
+            stream->token = *ip++;
+            stream->count = stream->token >> LZ4_ML_BITS;
+            stream->state = stream->count == LZ4_RUN_MASK ?
+                            LZ4_STATE_LITLEN : LZ4_STATE_LITERALS;
+            break;
+
+          case LZ4_STATE_LITLEN:
+            b              = *ip++;
+            stream->count += b;
+            if (b != 255)
+              {
+                stream->state = LZ4_STATE_LITERALS;
+              }
+            break;
+
+          case LZ4_STATE_LITERALS:
+            n = stream->count;
+            if (n > (size_t)(iend - ip))
+              {
+                n = iend - ip;
+              }
+
+            if (n > stream->outlen - stream->outpos)
+              {
+                return -E2BIG;
+              }
+
+            memcpy(stream->out + stream->outpos, ip, n);
+            stream->outpos += n;
+            stream->count  -= n;
+            ip             += n;
+
+            if (stream->count == 0)
+              {
+                stream->state = LZ4_STATE_OFFSET0;
+              }
+            break;
+
+          case LZ4_STATE_OFFSET0:
+            stream->offset = *ip++;
+            stream->state  = LZ4_STATE_OFFSET1;
+            break;
+
+          case LZ4_STATE_OFFSET1:
+            stream->offset |= *ip++ << 8;
+            if (stream->offset == 0 || stream->offset > stream->outpos)
+              {
+                return -EINVAL;
+              }
+
+            stream->count = stream->token & LZ4_ML_MASK;
+            stream->state = LZ4_STATE_MATCHLEN;
+            if (stream->count < LZ4_ML_MASK)
+              {
+                goto copymatch;
+              }
+            break;
+
+          case LZ4_STATE_MATCHLEN:
+            b              = *ip++;
+            stream->count += b;
+            if (b == 255)
+              {
+                break;
+              }
+
+          copymatch:
+            stream->count += LZ4_MINMATCH;
+            if (stream->count > stream->outlen - stream->outpos)
+              {
+                return -E2BIG;
+              }
+
+            lz4_copymatch(stream->out + stream->outpos, stream->offset,
+                          stream->count);
+            stream->outpos += stream->count;
+            stream->state   = LZ4_STATE_TOKEN;
+            break;
+
+          default:
+            return -EINVAL;
+        }
+    }
+
+  return stream->outpos;
+}
+
+#endif /* CONFIG_LIBC_LZ4 */
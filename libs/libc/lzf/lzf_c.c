@@ -89,6 +89,65 @@
 #define expect_false(expr)   expect((expr) != 0, 0)
 #define expect_true(expr)    expect((expr) != 0, 1)
 
+/* Matches are extended one machine word at a time */
+
+typedef unsigned long lzf_word_t;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzf_matchlen
+ *
+ * Description:
+ *   Return the index of the first byte that differs between ref and ip,
+ *   at most maxlen.  The first three bytes are known to match.
+ *
+ *   Whole words are compared and the position of the first difference in
+ *   a word is found from its trailing (little endian) or leading (big
+ *   endian) zero bits.  memcpy() lets the compiler use unaligned loads
+ *   where the CPU allows them and byte loads where it does not.
+ *
+ ****************************************************************************/
+
+static unsigned int lzf_matchlen(FAR const uint8_t *ref,
+                                 FAR const uint8_t *ip,
+                                 unsigned int maxlen)
+{
+  unsigned int len = 3;
+  lzf_word_t a;
+  lzf_word_t b;
+
+  while (len + sizeof(lzf_word_t) <= maxlen)
+    {
+      memcpy(&a, ref + len, sizeof(lzf_word_t));
+      memcpy(&b, ip + len, sizeof(lzf_word_t));
+
+      if (a != b)
+        {
+#if defined(__GNUC__)
+#  ifdef CONFIG_ENDIAN_BIG
+          return len + __builtin_clzl(a ^ b) / 8;
+#  else
+          return len + __builtin_ctzl(a ^ b) / 8;
+#  endif
+#else
+          break;
+#endif
+        }
+
+      len += sizeof(lzf_word_t);
+    }
+
+  while (len < maxlen && ref[len] == ip[len])
+    {
+      len++;
+    }
+
+  return len;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -212,115 +271,7 @@ size_t lzf_compress(FAR const void *const in_data,
           op[(- lit) - 1] = lit - 1; /* Stop run */
           op -= !lit;                /* Undo run if length is zero */
 
-          for (; ; )
-            {
-              if (expect_true(maxlen > 16))
-                {
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-
-                  len++;
-                  if (ref[len] != ip[len])
-                    {
-                      break;
-                    }
-                }
-
-              do
-                {
-                  len++;
-                }
-              while (len < maxlen && ref[len] == ip[len]);
-
-              break;
-            }
+          len = lzf_matchlen(ref, ip, maxlen);
 
           len -= 2; /* len is now #octets - 1 */
           ip++;
@@ -29,84 +29,102 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <nuttx/config.h>
+
+#include <stdint.h>
 #include <math.h>
+#include <errno.h>
 
 #include "libc.h"
 
 /****************************************************************************
- * Private Data
+ * Pre-processor Definitions
  ****************************************************************************/
 
-static float _flt_inv_fact[] =
-{
-  1.0 / 1.0,                    /* 1/0! */
-  1.0 / 1.0,                    /* 1/1! */
-  1.0 / 2.0,                    /* 1/2! */
-  1.0 / 6.0,                    /* 1/3! */
-  1.0 / 24.0,                   /* 1/4! */
-  1.0 / 120.0,                  /* 1/5! */
-  1.0 / 720.0,                  /* 1/6! */
-  1.0 / 5040.0,                 /* 1/7! */
-  1.0 / 40320.0,                /* 1/8! */
-  1.0 / 362880.0,               /* 1/9! */
-  1.0 / 3628800.0,              /* 1/10! */
-};
+/* ln(2) split so that k * LN2_HI is exact for the k that can occur */
+
+#define LN2_HI      0.693359375F
+#define LN2_LO      -2.12194440e-4F
+
+#define EXPF_MAX    88.72283905206835F    /* ln(FLT_MAX) */
+#define EXPF_MIN    -103.972077083991796F /* ln(smallest denormal) */
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
-float expf(float x)
+/* Return x * 2^n for n in [-126 - 64, 128] without calling ldexpf(), which
+ * is built on powf() and therefore on expf().
+ */
+
+static inline float expf_scale(float x, int n)
 {
-  size_t int_part;
-  bool invert;
-  float value;
-  float x0;
-  size_t i;
+  union
+  {
+    uint32_t i;
+    float x;
+  } u;
 
-  if (x == 0)
+  if (n > 127)
     {
-      return 1;
+      x *= 2.0F;
+      n--;
     }
-  else if (x < 0)
+  else if (n < -126)
     {
-      invert = true;
-      x = -x;
+      x *= 5.42101086242752217e-20F;  /* 2^-64 */
+      n += 64;
     }
-  else
-    {
-      invert = false;
-    }
-
-  /* Extract integer component */
 
-  int_part = (size_t) x;
+  u.i = (uint32_t)(n + 127) << 23;
+  return x * u.x;
+}
 
-  /* set x to fractional component */
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
 
-  x -= (float)int_part;
+/****************************************************************************
+ * Name: expf
+ *
+ * Description:
+ *   x is written as k * ln(2) + r with |r| <= ln(2) / 2.  exp(r) is a
+ *   degree 7 polynomial on that interval and the result is scaled by 2^k
+ *   through the exponent bits.
+ *
+ ****************************************************************************/
 
-  /* Perform Taylor series approximation with eleven terms */
+float expf(float x)
+{
+  float r;
+  float z;
+  float p;
+  int k;
 
-  value = 0.0F;
-  x0 = 1.0F;
-  for (i = 0; i < 10; i++)
+  if (isnan(x))
     {
-      value += x0 * _flt_inv_fact[i];
-      x0 *= x;
+      return x;
     }
 
-  /* Multiply by exp of the integer component */
-
-  value *= lib_expif(int_part);
-
-  if (invert)
+  if (x > EXPF_MAX)
     {
-      return (1.0F / value);
+      set_errno(ERANGE);
+      return INFINITY_F;
     }
-  else
+
+  if (x < EXPF_MIN)
     {
-      return value;
+      set_errno(ERANGE);
+      return 0.0F;
     }
+
+  k = (int)(x * (float)M_LOG2E + (x < 0.0F ? -0.5F : 0.5F));
+  r = (x - k * LN2_HI) - k * LN2_LO;
+  z = r * r;
+
+  p = (((((1.9875691500e-4F * r + 1.3981999507e-3F) * r +
+          8.3334519073e-3F) * r + 4.1665795894e-2F) * r +
+          1.6666665459e-1F) * r + 5.0000001201e-1F) * z + r + 1.0F;
+
+  return expf_scale(p, k);
 }
@@ -0,0 +1,154 @@
+/****************************************************************************
+ * libs/libc/math/lib_libsincosf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <math.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* pi/2 split in four parts.  The first three have few enough significant
+ * bits that k * PIO2_1, k * PIO2_2 and k * PIO2_3 are exact in single
+ * precision for |x| < SINCOSF_FLOAT_MAX.
+ */
+
+#define PIO2_1             1.5703125F
+#define PIO2_2             4.837512969970703125e-4F
+#define PIO2_3             7.54953362047672271728515625e-8F
+#define PIO2_4             2.56334415159451890e-12F
+
+/* pi/2 split for the double precision reduction of larger arguments.
+ * k * PIO2_1_D is exact for |x| < SINCOSF_HUGE.
+ */
+
+#define PIO2_1_D           1.57079632673412561417e+00
+#define PIO2_1T_D          6.07710050650619224932e-11
+
+#define SINCOSF_FLOAT_MAX  8192.0F
+#define SINCOSF_HUGE       823549.0F      /* ~2^19 * pi/2 */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Minimax polynomials on [-pi/4, pi/4], written in Horner form so that the
+ * compiler can contract them into fused multiply-adds where the FPU has
+ * them.
+ */
+
+static inline float sinf_kernel(float r)
+{
+  float z = r * r;
+
+  return r + r * z * ((-1.9515295891e-4F * z + 8.3321608736e-3F) * z -
+                      1.6666654611e-1F);
+}
+
+static inline float cosf_kernel(float r)
+{
+  float z = r * r;
+
+  return 1.0F - 0.5F * z +
+         z * z * ((2.443315711809948e-5F * z - 1.388731625493765e-3F) * z +
+                  4.166664568298827e-2F);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_sincosf
+ *
+ * Description:
+ *   Return sin(x + quadrant * pi / 2).  sinf() and cosf() share this.
+ *
+ *   x is reduced to r in [-pi/4, pi/4] with x = k * pi/2 + r, in single
+ *   precision for moderate arguments (Cody & Waite) and in double
+ *   precision for larger ones.  The sine or cosine kernel is then selected
+ *   by (k + quadrant) mod 4.
+ *
+ ****************************************************************************/
+
+float lib_sincosf(float x, int quadrant)
+{
+  float r;
+  float k;
+  int n;
+
+  if (isnan(x) || isinf_f(x))
+    {
+      return NAN_F;
+    }
+
+  /* A float this large has an ulp of 1/16 or more, so its sine carries
+   * little information.  Just bring it into range.
+   */
+
+  if (fabsf(x) >= SINCOSF_HUGE)
+    {
+      x = fmodf(x, 2 * M_PI_F);
+    }
+
+  if (fabsf(x) <= (float)M_PI_4)
+    {
+      r = x;
+      n = 0;
+    }
+#ifdef CONFIG_HAVE_DOUBLE
+  else if (fabsf(x) >= SINCOSF_FLOAT_MAX)
+    {
+      double xd = x;
+
+      n = (int)(xd * M_2_PI + (x < 0.0F ? -0.5 : 0.5));
+      r = (float)((xd - n * PIO2_1_D) - n * PIO2_1T_D);
+    }
+#endif
+  else
+    {
+      n = (int)(x * (float)M_2_PI + (x < 0.0F ? -0.5F : 0.5F));
+      k = (float)n;
+      r = (((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3) - k * PIO2_4;
+    }
+
+  switch ((n + quadrant) & 3)
+    {
+      case 0:
+        return sinf_kernel(r);
+
+      case 1:
+        return cosf_kernel(r);
+
+      case 2:
+        return -sinf_kernel(r);
+
+      default:
+        return -cosf_kernel(r);
+    }
+}
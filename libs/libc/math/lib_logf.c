@@ -29,22 +29,25 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
+#include <stdint.h>
 #include <math.h>
-#include <float.h>
+#include <errno.h>
+
+#include "libc.h"
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define FLT_MAX_EXP_X   88.0F
+/* ln(2) split so that e * LN2_HI is exact */
 
-/* To avoid looping forever in particular corner cases, every LOGF_MAX_ITER
- * the error criteria is relaxed by a factor LOGF_RELAX_MULTIPLIER.
- * todo: might need to adjust the double floating point version too.
- */
+#define LN2_HI      0.693359375F
+#define LN2_LO      -2.12194440e-4F
 
-#define LOGF_MAX_ITER         10
-#define LOGF_RELAX_MULTIPLIER 2.0F
+#define ONE_BITS     0x3f800000  /* 1.0 */
+#define SQRT1_2_BITS 0x3f3504f3  /* sqrt(1/2) */
 
 /****************************************************************************
  * Public Functions
@@ -52,63 +55,76 @@
 
 /****************************************************************************
  * Name: logf
+ *
+ * Description:
+ *   x is written as 2^e * m with m in [sqrt(1/2), sqrt(2)), taken directly
+ *   from the bits of x.  log(m) = log(1 + f) is a polynomial in f and the
+ *   result is e * ln(2) + log(1 + f).
+ *
  ****************************************************************************/
 
 float logf(float x)
 {
+  union
+  {
+    uint32_t i;
+    float x;
+  } u;
+
+  float f;
+  float z;
   float y;
-  float y_old;
-  float ey;
-  float epsilon;
-  float relax_factor;
-  int   iter;
+  int e;
 
-  y       = 0.0F;
-  y_old   = 1.0F;
-  epsilon = FLT_EPSILON;
+  if (isnan(x))
+    {
+      return x;
+    }
 
-  iter         = 0;
-  relax_factor = 1.0F;
+  if (x < 0.0F)
+    {
+      set_errno(EDOM);
+      return NAN_F;
+    }
 
-  while (y > y_old + epsilon || y < y_old - epsilon)
+  if (x == 0.0F)
     {
-      y_old = y;
-      ey    = expf(y);
-      y    -= (ey - x) / ey;
-
-      if (y > FLT_MAX_EXP_X)
-        {
-          y = FLT_MAX_EXP_X;
-        }
-
-      if (y < -FLT_MAX_EXP_X)
-        {
-          y = -FLT_MAX_EXP_X;
-        }
-
-      epsilon = (fabsf(y) > 1.0F) ? fabsf(y) * FLT_EPSILON : FLT_EPSILON;
-
-      if (++iter >= LOGF_MAX_ITER)
-        {
-          relax_factor *= LOGF_RELAX_MULTIPLIER;
-          iter = 0;
-        }
-
-      if (relax_factor > 1.0F)
-        {
-          epsilon *= relax_factor;
-        }
+      set_errno(ERANGE);
+      return -INFINITY_F;
     }
 
-  if (y == FLT_MAX_EXP_X)
+  if (isinf_f(x))
     {
-      return INFINITY;
+      return x;
     }
 
-  if (y == -FLT_MAX_EXP_X)
+  u.x = x;
+  e   = 0;
+
+  /* Normalize denormals */
+
+  if (u.i < 0x00800000)
     {
-      return INFINITY;
+      u.x *= 8388608.0F;  /* 2^23 */
+      e    = -23;
     }
 
-  return y;
+  /* Split off the exponent, leaving m in [sqrt(1/2), sqrt(2)) */
+
+  u.i += ONE_BITS - SQRT1_2_BITS;
+  e   += (int)(u.i >> 23) - 127;
+  u.i  = (u.i & 0x007fffff) + SQRT1_2_BITS;
+  f    = u.x - 1.0F;
+
+  z = f * f;
+  y = ((((((((7.0376836292e-2F * f - 1.1514610310e-1F) * f +
+             1.1676998740e-1F) * f - 1.2420140846e-1F) * f +
+             1.4249322787e-1F) * f - 1.6668057665e-1F) * f +
+             2.0000714765e-1F) * f - 2.4999993993e-1F) * f +
+             3.3333331174e-1F) * f * z;
+
+  y += e * LN2_LO;
+  y -= 0.5F * z;
+
+  return f + y + e * LN2_HI;
 }
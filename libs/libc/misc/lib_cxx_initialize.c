@@ -26,9 +26,13 @@
 
 #include <assert.h>
 #include <debug.h>
+#include <errno.h>
 #include <sched.h>
+#include <stdbool.h>
 #include <stdlib.h>
 
+#include <nuttx/semaphore.h>
+
 #include "libc.h"
 
 /****************************************************************************
@@ -61,6 +65,66 @@ extern uintptr_t _etext;
 extern void macho_call_saved_init_funcs(void);
 #endif
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_HAVE_CXXINITIALIZE
+/* The static constructors run once, in the first task that starts.  Tasks
+ * that start meanwhile wait for them to complete so that no task may see
+ * a partially constructed object.
+ */
+
+static sem_t g_cxx_sem = SEM_INITIALIZER(1);
+static bool  g_cxx_inited;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cxx_initialize
+ *
+ * Description:
+ *   Call each entry of the initialization table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HAVE_CXXINITIALIZE
+static void cxx_initialize(void)
+{
+#if defined(CONFIG_ARCH_SIM) && defined(CONFIG_HOST_MACOS)
+  macho_call_saved_init_funcs();
+#else
+  FAR initializer_t *initp;
+
+  sinfo("_sinit: %p _einit: %p _stext: %p _etext: %p\n",
+        &_sinit, &_einit, &_stext, &_etext);
+
+  /* Visit each entry in the initialization table */
+
+  for (initp = &_sinit; initp != &_einit; initp++)
+    {
+      initializer_t initializer = *initp;
+      sinfo("initp: %p initializer: %p\n", initp, initializer);
+
+      /* Make sure that the address is non-NULL and lies in the text
+       * region defined by the linker script.  Some toolchains may put
+       * NULL values or counts in the initialization table.
+       */
+
+      if ((FAR void *)initializer >= (FAR void *)&_stext &&
+          (FAR void *)initializer < (FAR void *)&_etext)
+        {
+          sinfo("Calling %p\n", initializer);
+          initializer();
+        }
+    }
+#endif
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -84,40 +148,32 @@ extern void macho_call_saved_init_funcs(void);
 void lib_cxx_initialize(void)
 {
 #ifdef CONFIG_HAVE_CXXINITIALIZE
-  static int inited = 0;
+  int ret;
 
-  if (inited == 0)
-    {
-#if defined(CONFIG_ARCH_SIM) && defined(CONFIG_HOST_MACOS)
-      macho_call_saved_init_funcs();
-#else
-      initializer_t *initp;
+  /* Fast path: every task but the first finds the constructors done.  The
+   * acquire pairs with the release below so that the objects they built
+   * are visible.
+   */
 
-      sinfo("_sinit: %p _einit: %p _stext: %p _etext: %p\n",
-            &_sinit, &_einit, &_stext, &_etext);
+  if (__atomic_load_n(&g_cxx_inited, __ATOMIC_ACQUIRE))
+    {
+      return;
+    }
 
-      /* Visit each entry in the initialization table */
+  do
+    {
+      ret = _SEM_WAIT(&g_cxx_sem);
+    }
+  while (ret < 0 && _SEM_ERRNO(ret) == EINTR);
 
-      for (initp = &_sinit; initp != &_einit; initp++)
-        {
-          initializer_t initializer = *initp;
-          sinfo("initp: %p initializer: %p\n", initp, initializer);
-
-          /* Make sure that the address is non-NULL and lies in the text
-           * region defined by the linker script.  Some toolchains may put
-           * NULL values or counts in the initialization table.
-           */
-
-          if ((FAR void *)initializer >= (FAR void *)&_stext &&
-              (FAR void *)initializer < (FAR void *)&_etext)
-            {
-              sinfo("Calling %p\n", initializer);
-              initializer();
-            }
-        }
-#endif
+  DEBUGASSERT(ret >= 0);
 
-      inited = 1;
+  if (!g_cxx_inited)
+    {
+      cxx_initialize();
+      __atomic_store_n(&g_cxx_inited, true, __ATOMIC_RELEASE);
     }
+
+  _SEM_POST(&g_cxx_sem);
 #endif
 }
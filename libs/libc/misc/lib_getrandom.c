@@ -22,7 +22,10 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <sys/random.h>
+#include <stdlib.h>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -64,6 +67,18 @@ ssize_t getrandom(FAR void *bytes, size_t nbytes, unsigned int flags)
   FAR const char *dev;
   int fd;
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL
+  /* /dev/urandom is served by the entropy pool, get the bytes directly
+   * from it and save opening and closing the device.
+   */
+
+  if ((flags & GRND_RANDOM) == 0)
+    {
+      arc4random_buf(bytes, nbytes);
+      return nbytes;
+    }
+#endif
+
   if ((flags & GRND_NONBLOCK) != 0)
     {
       oflags |= O_NONBLOCK;
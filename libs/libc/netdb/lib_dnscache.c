@@ -21,11 +21,13 @@
 /****************************************************************************
  * Included Files
  ****************************************************************************/
-
 #include <nuttx/config.h>
 
 #include <sys/time.h>
+#include <stdint.h>
 #include <string.h>
+#include <strings.h>
+#include <ctype.h>
 #include <time.h>
 #include <assert.h>
 #include <errno.h>
@@ -35,11 +37,25 @@
 
 #if CONFIG_NETDB_DNSCLIENT_ENTRIES > 0
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The hash table has as many buckets as the cache has entries so that the
+ * chains stay short when the cache is full.
+ */
+
+#define DNS_CACHE_NBUCKETS  CONFIG_NETDB_DNSCLIENT_ENTRIES
+#define DNS_CACHE_NONE      UINT16_MAX
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
-/* This described one entry in the cache of resolved hostnames.
+/* This described one entry in the cache of resolved hostnames.  An entry
+ * with naddr == 0 is a negative entry:  it records that the name does not
+ * exist or has no addresses so that repeated lookups of the same bad name
+ * are not sent to the name server again until the entry expires.
  *
  * REVISIT: this consumes extra space, especially when multiple
  * addresses per name are stored.
@@ -47,11 +63,11 @@
 
 struct dns_cache_s
 {
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-  time_t            ctime;      /* Creation time */
-#endif
-  char              name[CONFIG_NETDB_DNSCLIENT_NAMESIZE];
+  time_t            expire;     /* Absolute expiration time, seconds */
+  uint16_t          next;       /* Next entry in the same hash chain */
+  bool              inuse;      /* True: The entry holds a valid answer */
   uint8_t           naddr;      /* How many addresses per name */
+  char              name[CONFIG_NETDB_DNSCLIENT_NAMESIZE];
   union dns_addr_u  addr[CONFIG_NETDB_MAX_IPADDR];
 };
 
@@ -59,17 +75,205 @@ struct dns_cache_s
  * Private Data
  ****************************************************************************/
 
-static uint8_t g_dns_head;        /* Head of the circular, DNS resolver cache */
-static uint8_t g_dns_tail;        /* Tail of the circular, DNS resolver cache */
-
-/* This is the DNS resolver cache */
+/* This is the DNS resolver cache.  The cache lives in the C library data
+ * and so it is shared by every task that uses the resolver.
+ */
 
 static struct dns_cache_s g_dns_cache[CONFIG_NETDB_DNSCLIENT_ENTRIES];
 
+/* Heads of the hash chains, indexes into g_dns_cache[] */
+
+static uint16_t g_dns_hash[DNS_CACHE_NBUCKETS];
+
+/* True once g_dns_hash[] has been initialized */
+
+static bool g_dns_initialized;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: dns_cache_now
+ *
+ * Description:
+ *   Return the current monotonic time in seconds.
+ *
+ ****************************************************************************/
+
+static time_t dns_cache_now(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec;
+}
+
+/****************************************************************************
+ * Name: dns_cache_hash
+ *
+ * Description:
+ *   Return the hash bucket of a host name.  Host names are compared
+ *   without regard to case, so the hash ignores case too.  Only the part
+ *   of the name that fits in the cache entry takes part.
+ *
+ ****************************************************************************/
+
+static unsigned int dns_cache_hash(FAR const char *hostname)
+{
+  uint32_t hash = 2166136261u;
+  int i;
+
+  for (i = 0; i < CONFIG_NETDB_DNSCLIENT_NAMESIZE - 1 && hostname[i];
+       i++)
+    {
+      hash ^= (uint8_t)tolower(hostname[i]);
+      hash *= 16777619u;
+    }
+
+  return hash % DNS_CACHE_NBUCKETS;
+}
+
+/****************************************************************************
+ * Name: dns_cache_initialize
+ *
+ * Description:
+ *   Empty the cache.  Must be called with the DNS lock held.
+ *
+ ****************************************************************************/
+
+static void dns_cache_initialize(void)
+{
+  int ndx;
+
+  for (ndx = 0; ndx < DNS_CACHE_NBUCKETS; ndx++)
+    {
+      g_dns_hash[ndx] = DNS_CACHE_NONE;
+    }
+
+  for (ndx = 0; ndx < CONFIG_NETDB_DNSCLIENT_ENTRIES; ndx++)
+    {
+      g_dns_cache[ndx].inuse = false;
+    }
+
+  g_dns_initialized = true;
+}
+
+/****************************************************************************
+ * Name: dns_cache_lookup
+ *
+ * Description:
+ *   Return the index of the entry holding hostname or DNS_CACHE_NONE.
+ *   Expired entries found along the chain are released.  Must be called
+ *   with the DNS lock held.
+ *
+ ****************************************************************************/
+
+static uint16_t dns_cache_lookup(FAR const char *hostname, time_t now)
+{
+  FAR struct dns_cache_s *entry;
+  FAR uint16_t *prev;
+  uint16_t ndx;
+
+  prev = &g_dns_hash[dns_cache_hash(hostname)];
+  while ((ndx = *prev) != DNS_CACHE_NONE)
+    {
+      entry = &g_dns_cache[ndx];
+      if (now >= entry->expire)
+        {
+          /* This entry has expired, remove it from the chain */
+
+          *prev        = entry->next;
+          entry->inuse = false;
+          continue;
+        }
+
+      /* Because the names are truncated to
+       * CONFIG_NETDB_DNSCLIENT_NAMESIZE, this has the possibility of
+       * aliasing two names and returning the wrong entry from the cache.
+       */
+
+      if (strncasecmp(hostname, entry->name,
+                      CONFIG_NETDB_DNSCLIENT_NAMESIZE - 1) == 0)
+        {
+          return ndx;
+        }
+
+      prev = &entry->next;
+    }
+
+  return DNS_CACHE_NONE;
+}
+
+/****************************************************************************
+ * Name: dns_cache_unlink
+ *
+ * Description:
+ *   Remove an entry from its hash chain.  Must be called with the DNS lock
+ *   held.
+ *
+ ****************************************************************************/
+
+static void dns_cache_unlink(uint16_t ndx)
+{
+  FAR struct dns_cache_s *entry = &g_dns_cache[ndx];
+  FAR uint16_t *prev;
+
+  prev = &g_dns_hash[dns_cache_hash(entry->name)];
+  while (*prev != DNS_CACHE_NONE)
+    {
+      if (*prev == ndx)
+        {
+          *prev = entry->next;
+          break;
+        }
+
+      prev = &g_dns_cache[*prev].next;
+    }
+
+  entry->inuse = false;
+}
+
+/****************************************************************************
+ * Name: dns_cache_alloc
+ *
+ * Description:
+ *   Select the entry to hold a new answer:  a free entry if there is one,
+ *   else an expired one, else the entry that would expire first.  The
+ *   entry is returned unlinked.  Must be called with the DNS lock held.
+ *
+ ****************************************************************************/
+
+static uint16_t dns_cache_alloc(time_t now)
+{
+  uint16_t victim = 0;
+  uint16_t ndx;
+
+  for (ndx = 0; ndx < CONFIG_NETDB_DNSCLIENT_ENTRIES; ndx++)
+    {
+      FAR struct dns_cache_s *entry = &g_dns_cache[ndx];
+
+      if (!entry->inuse)
+        {
+          return ndx;
+        }
+
+      if (now >= entry->expire)
+        {
+          victim = ndx;
+          break;
+        }
+
+      if (entry->expire < g_dns_cache[victim].expire)
+        {
+          victim = ndx;
+        }
+    }
+
+  dns_cache_unlink(victim);
+  return victim;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -83,7 +287,12 @@ static struct dns_cache_s g_dns_cache[CONFIG_NETDB_DNSCLIENT_ENTRIES];
  * Input Parameters:
  *   hostname - The hostname string to be cached.
  *   addr     - The IP addresses associated with the hostname.
- *   naddr    - The count of the IP addresses.
+ *   naddr    - The count of the IP addresses.  Zero records a negative
+ *              answer, i.e. a name that does not resolve.
+ *   ttl      - The time to live of the answer in seconds, as given by the
+ *              name server.  The lifetime is further limited by
+ *              CONFIG_NETDB_DNSCLIENT_LIFESEC (positive answers) or
+ *              CONFIG_NETDB_DNSCLIENT_NEGLIFESEC (negative answers).
  *
  * Returned Value:
  *   None
@@ -91,64 +300,73 @@ static struct dns_cache_s g_dns_cache[CONFIG_NETDB_DNSCLIENT_ENTRIES];
  ****************************************************************************/
 
 void dns_save_answer(FAR const char *hostname,
-                     FAR const union dns_addr_u *addr, int naddr)
+                     FAR const union dns_addr_u *addr, int naddr,
+                     uint32_t ttl)
 {
   FAR struct dns_cache_s *entry;
+  unsigned int hash;
+  time_t now;
+  uint16_t ndx;
+
+  naddr = MIN(naddr, CONFIG_NETDB_MAX_IPADDR);
+  DEBUGASSERT(naddr >= 0 && naddr <= UCHAR_MAX);
+
+  if (naddr == 0)
+    {
+      ttl = MIN(ttl, CONFIG_NETDB_DNSCLIENT_NEGLIFESEC);
+    }
 #if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-  struct timespec now;
+  else
+    {
+      ttl = MIN(ttl, CONFIG_NETDB_DNSCLIENT_LIFESEC);
+    }
 #endif
-  int next;
-  int ndx;
 
-  naddr = MIN(naddr, CONFIG_NETDB_MAX_IPADDR);
-  DEBUGASSERT(naddr >= 1 && naddr <= UCHAR_MAX);
+  /* A zero TTL means that the answer must not be cached */
+
+  if (ttl == 0)
+    {
+      return;
+    }
 
   /* Get exclusive access to the DNS cache */
 
   dns_semtake();
 
-  /* Get the index to the new head of the list */
-
-  ndx  = g_dns_head;
-  next = ndx + 1;
-  if (next >= CONFIG_NETDB_DNSCLIENT_ENTRIES)
+  if (!g_dns_initialized)
     {
-      next = 0;
+      dns_cache_initialize();
     }
 
-  /* If the next head pointer would match the tail index, then increment
-   * the tail index, discarding the oldest mapping in the cache.
-   */
+  /* Replace the entry of the same name, if any */
 
-  if (next == g_dns_tail)
+  now = dns_cache_now();
+  ndx = dns_cache_lookup(hostname, now);
+  if (ndx != DNS_CACHE_NONE)
     {
-      int tmp = g_dns_tail + 1;
-      if (tmp >= CONFIG_NETDB_DNSCLIENT_ENTRIES)
-        {
-          tmp = 0;
-        }
-
-      g_dns_tail = tmp;
+      dns_cache_unlink(ndx);
+    }
+  else
+    {
+      ndx = dns_cache_alloc(now);
     }
 
   /* Save the answer in the cache */
 
-  entry = &g_dns_cache[ndx];
-
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-  /* Get the current time */
-
-  clock_gettime(CLOCK_MONOTONIC, &now);
-  entry->ctime = (time_t)now.tv_sec;
-#endif
+  entry         = &g_dns_cache[ndx];
+  entry->expire = now + ttl;
+  entry->inuse  = true;
+  entry->naddr  = naddr;
 
   strlcpy(entry->name, hostname, CONFIG_NETDB_DNSCLIENT_NAMESIZE);
   memcpy(&entry->addr, addr, naddr * sizeof(*addr));
-  entry->naddr = naddr;
 
-  /* Save the updated head index */
+  /* Link it at the head of its hash chain */
+
+  hash             = dns_cache_hash(entry->name);
+  entry->next      = g_dns_hash[hash];
+  g_dns_hash[hash] = ndx;
 
-  g_dns_head = next;
   dns_semgive();
 }
 
@@ -169,10 +387,9 @@ void dns_clear_answer(void)
 
   dns_semtake();
 
-  /* Reset the circular of DNS cache */
+  /* Drop every entry */
 
-  g_dns_head = 0;
-  g_dns_tail = 0;
+  dns_cache_initialize();
 
   dns_semgive();
 }
@@ -194,8 +411,9 @@ void dns_clear_answer(void)
  * Returned Value:
  *   If the host name was successfully found in the DNS name resolution
  *   cache, zero (OK) will be returned.  Otherwise, some negated errno
- *   value will be returned, typically -ENOENT meaning that the hostname
- *   was not found in the cache.
+ *   value will be returned:  -ENOENT meaning that the hostname was not
+ *   found in the cache, -EADDRNOTAVAIL meaning that the cache holds a
+ *   negative answer for the hostname.
  *
  ****************************************************************************/
 
@@ -203,67 +421,27 @@ int dns_find_answer(FAR const char *hostname, FAR union dns_addr_u *addr,
                     FAR int *naddr)
 {
   FAR struct dns_cache_s *entry;
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-  struct timespec now;
-  uint32_t elapsed;
-  int ret;
-#endif
-  int next;
-  int ndx;
+  uint16_t ndx;
+  int ret = -ENOENT;
 
   /* Get exclusive access to the DNS cache */
 
   dns_semtake();
 
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-  /* Get the current time */
-
-  ret = clock_gettime(CLOCK_MONOTONIC, &now);
-#endif
-
-  for (ndx = g_dns_tail; ndx != g_dns_head; ndx = next)
+  if (g_dns_initialized)
     {
-      entry = &g_dns_cache[ndx];
-
-      /* Advance the index for the next time through the loop, handling
-       * wrapping to the beginning of the circular buffer.
-       */
-
-      next = ndx + 1;
-      if (next >= CONFIG_NETDB_DNSCLIENT_ENTRIES)
+      ndx = dns_cache_lookup(hostname, dns_cache_now());
+      if (ndx != DNS_CACHE_NONE)
         {
-          next = 0;
-        }
-
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-      /* Check if this entry has expired
-       * REVISIT: Does not this calculation assume that the sizeof(time_t)
-       * is equal to the sizeof(uint32_t)?
-       */
-
-      elapsed = (uint32_t)now.tv_sec - (uint32_t)entry->ctime;
-      if (ret >= 0 && elapsed > CONFIG_NETDB_DNSCLIENT_LIFESEC)
-        {
-          /* This entry has expired.  Increment the tail index to exclude
-           * this entry on future traversals.
-           */
-
-          g_dns_tail = next;
-        }
-      else
-#endif
-        {
-          /* The entry has not expired, check for a name match. Because
-           * the names are truncated to CONFIG_NETDB_DNSCLIENT_NAMESIZE,
-           * this has the possibility of aliasing two names and returning
-           * the wrong entry from the cache.
-           */
-
-          if (strncmp(hostname, entry->name,
-                      CONFIG_NETDB_DNSCLIENT_NAMESIZE) == 0)
+          entry = &g_dns_cache[ndx];
+          if (entry->naddr == 0)
             {
-              /* We have a match.  Return the resolved host address */
+              /* The name is known not to resolve */
 
+              ret = -EADDRNOTAVAIL;
+            }
+          else
+            {
               /* Make sure that the address will fit in the caller-provided
                * buffer.
                */
@@ -273,15 +451,11 @@ int dns_find_answer(FAR const char *hostname, FAR union dns_addr_u *addr,
               /* Return the address information */
 
               memcpy(addr, &entry->addr, *naddr * sizeof(*addr));
-
-              dns_semgive();
-              return OK;
+              ret = OK;
             }
         }
     }
 
-  ret = -ENOENT;
-
   dns_semgive();
   return ret;
 }
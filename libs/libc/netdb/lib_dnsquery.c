@@ -48,6 +48,8 @@
 
 #include <nuttx/config.h>
 
+#include <inttypes.h>
+#include <poll.h>
 #include <string.h>
 #include <time.h>
 #include <errno.h>
@@ -79,10 +81,41 @@
 #define SEND_BUFFER_SIZE (16 + CONFIG_NETDB_DNSCLIENT_NAMESIZE + 2)
 #define RECV_BUFFER_SIZE CONFIG_NETDB_DNSCLIENT_MAXRESPONSE
 
+/* The record types asked for in each lookup */
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+#  define DNS_QUERY_NRECS 2
+#else
+#  define DNS_QUERY_NRECS 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* Query info to check response against. */
+
+struct dns_query_info_s
+{
+  uint16_t id;                                     /* Query ID */
+  uint16_t rectype;                                /* Queried record type */
+  uint16_t qnamelen;                               /* Queried hostname length */
+  char qname[CONFIG_NETDB_DNSCLIENT_NAMESIZE + 2]; /* Queried hostname in
+                                                    * encoded format + NUL */
+};
+
+/* The state of the lookup of one record type */
+
+struct dns_query_rec_s
+{
+  struct dns_query_info_s qinfo;  /* The query in flight */
+  bool done;                      /* True: result is final */
+  uint8_t nfail;                  /* Servers that failed this round */
+  int result;                     /* Number of addresses or errno value */
+  uint32_t ttl;                   /* Smallest TTL of the answer */
+  union dns_addr_u addr[CONFIG_NETDB_MAX_IPADDR];
+};
+
 struct dns_query_s
 {
   int sd;                         /* DNS server socket */
@@ -90,17 +123,27 @@ struct dns_query_s
   FAR const char *hostname;       /* Hostname to lookup */
   FAR union dns_addr_u *addr;     /* Location to return host address */
   FAR int *naddr;                 /* Number of returned addresses */
+  int nservers;                   /* Number of servers in server[] */
+  union dns_addr_u server[CONFIG_NETDB_DNSCLIENT_PARALLEL];
+  struct dns_query_rec_s rec[DNS_QUERY_NRECS];
 };
 
-/* Query info to check response against. */
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
 
-struct dns_query_info_s
+/* The record types asked for in each lookup, in the order in which the
+ * addresses are returned.
+ */
+
+static const uint16_t g_dns_rectype[DNS_QUERY_NRECS] =
 {
-  uint16_t id;                                     /* Query ID */
-  uint16_t rectype;                                /* Queried record type */
-  uint16_t qnamelen;                               /* Queried hostname length */
-  char qname[CONFIG_NETDB_DNSCLIENT_NAMESIZE + 2]; /* Queried hostname in
-                                                    * encoded format + NUL */
+#ifdef CONFIG_NET_IPv6
+  DNS_RECTYPE_AAAA,
+#endif
+#ifdef CONFIG_NET_IPv4
+  DNS_RECTYPE_A,
+#endif
 };
 
 /****************************************************************************
@@ -185,17 +228,35 @@ static inline uint16_t dns_alloc_id(void)
   return (uint32_t)ts.tv_nsec + ((uint32_t)ts.tv_nsec >> 16);
 }
 
+/****************************************************************************
+ * Name: dns_answer_ttl
+ *
+ * Description:
+ *   Return the time to live of a resource record, in seconds.
+ *
+ ****************************************************************************/
+
+static inline uint32_t dns_answer_ttl(FAR struct dns_answer_s *ans)
+{
+  return ((uint32_t)NTOHS(ans->ttl[0]) << 16) | NTOHS(ans->ttl[1]);
+}
+
 /****************************************************************************
  * Name: dns_send_query
  *
  * Description:
- *   Runs through the list of names to see if there are any that have
- *   not yet been queried and, if so, sends out a query.
+ *   Format the query of one record type of the name and send it to each
+ *   of the name servers.
+ *
+ * Returned Value:
+ *   Zero (OK) if the query could be sent to at least one of the name
+ *   servers.  Otherwise, the negated errno value of the last failure.
  *
  ****************************************************************************/
 
 static int dns_send_query(int sd, FAR const char *name,
-                          FAR union dns_addr_u *uaddr, uint16_t rectype,
+                          FAR union dns_addr_u *server, int nservers,
+                          uint16_t rectype, uint16_t id,
                           FAR struct dns_query_info_s *qinfo)
 {
   FAR struct dns_header_s *hdr;
@@ -205,16 +266,13 @@ static int dns_send_query(int sd, FAR const char *name,
   FAR char *qptr;
   FAR const char *src;
   uint8_t buffer[SEND_BUFFER_SIZE];
-  uint16_t id;
   socklen_t addrlen;
+  int result = -EDESTADDRREQ;
+  int nsent = 0;
   int ret;
   int len;
   int n;
 
-  /* Get a new ID for query */
-
-  id = dns_alloc_id();
-
   /* Initialize the request header */
 
   hdr               = (FAR struct dns_header_s *)buffer;
@@ -282,55 +340,108 @@ static int dns_send_query(int sd, FAR const char *name,
   qinfo->rectype = HTONS(rectype);
   qinfo->id      = hdr->id;
 
-  /* Send the request */
+  /* Send the request to each name server */
 
-  if (uaddr->addr.sa_family == AF_INET)
+  for (n = 0; n < nservers; n++)
     {
-      addrlen = sizeof(struct sockaddr_in);
-    }
-  else
-    {
-      addrlen = sizeof(struct sockaddr_in6);
-    }
+      if (server[n].addr.sa_family == AF_INET)
+        {
+          addrlen = sizeof(struct sockaddr_in);
+        }
+      else
+        {
+          addrlen = sizeof(struct sockaddr_in6);
+        }
 
-  ret = connect(sd, &uaddr->addr, addrlen);
-  if (ret < 0)
-    {
-      ret = -get_errno();
-      nerr("ERROR: connect failed: %d\n", ret);
-      return ret;
+      ret = sendto(sd, buffer, dest - buffer, 0, &server[n].addr, addrlen);
+      if (ret < 0)
+        {
+          result = -get_errno();
+          nerr("ERROR: sendto failed: %d\n", result);
+        }
+      else
+        {
+          nsent++;
+        }
     }
 
-  ret = send(sd, buffer, dest - buffer, 0);
-  if (ret < 0)
+  return nsent > 0 ? OK : result;
+}
+
+/****************************************************************************
+ * Name: dns_parse_soa
+ *
+ * Description:
+ *   Look for the SOA record in the authority section of a negative
+ *   response and return the time for which the negative answer may be
+ *   cached (RFC 2308):  the smaller of the TTL of the SOA record and its
+ *   MINIMUM field, which is always the last 32 bits of the SOA data.
+ *
+ * Returned Value:
+ *   The time to live in seconds, UINT32_MAX if there is no SOA record.
+ *
+ ****************************************************************************/
+
+static uint32_t dns_parse_soa(FAR uint8_t *nameptr, FAR uint8_t *endofbuffer,
+                              uint16_t nauthrr)
+{
+  FAR struct dns_answer_s *ans;
+  uint32_t minimum;
+  uint32_t ttl;
+
+  for (; nauthrr > 0; nauthrr--)
     {
-      ret = -get_errno();
-      nerr("ERROR: sendto failed: %d\n", ret);
-      return ret;
+      nameptr = dns_parse_name(nameptr, endofbuffer);
+      if (nameptr + 10 > endofbuffer)
+        {
+          break;
+        }
+
+      ans      = (FAR struct dns_answer_s *)nameptr;
+      nameptr += 10 + NTOHS(ans->len);
+      if (nameptr > endofbuffer)
+        {
+          break;
+        }
+
+      if (ans->type == HTONS(DNS_RECTYPE_SOA) && NTOHS(ans->len) >= 22)
+        {
+          FAR uint8_t *ptr = nameptr - 4;
+
+          ttl     = dns_answer_ttl(ans);
+          minimum = ((uint32_t)ptr[0] << 24) | ((uint32_t)ptr[1] << 16) |
+                    ((uint32_t)ptr[2] << 8) | ptr[3];
+
+          return MIN(ttl, minimum);
+        }
     }
 
-  return OK;
+  return UINT32_MAX;
 }
 
 /****************************************************************************
- * Name: dns_recv_response
+ * Name: dns_parse_response
  *
  * Description:
- *   Called when new UDP data arrives
+ *   Parse the response to the query of one record type and save the
+ *   addresses in the record state.
  *
  * Returned Value:
- *   Returns number of valid IP address responses.  Negated errno value is
- *   returned in all other cases.
+ *   Returns number of valid IP address responses.  -EADDRNOTAVAIL is
+ *   returned if the name server says that the name does not exist or has
+ *   no address of this type; in that case rec->ttl holds the time for
+ *   which this negative answer may be cached.  Other negated errno values
+ *   are returned in all other cases.
  *
  ****************************************************************************/
 
-static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
-                             FAR struct dns_query_info_s *qinfo)
+static int dns_parse_response(FAR uint8_t *buffer, int buflen,
+                              FAR struct dns_query_rec_s *rec)
 {
+  FAR struct dns_query_info_s *qinfo = &rec->qinfo;
   FAR uint8_t *nameptr;
   FAR uint8_t *namestart;
   FAR uint8_t *endofbuffer;
-  char buffer[RECV_BUFFER_SIZE];
   FAR struct dns_answer_s *ans;
   FAR struct dns_header_s *hdr;
   FAR struct dns_question_s *que;
@@ -338,34 +449,12 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
   uint16_t nquestions;
   uint16_t nanswers;
   uint16_t temp;
+  uint32_t ttl = UINT32_MAX;
   int naddr_read;
   int ret;
 
-  if (naddr <= 0)
-    {
-      return -ERANGE;
-    }
-
-  /* Receive the response */
-
-  ret = recv(sd, buffer, RECV_BUFFER_SIZE, 0);
-  if (ret < 0)
-    {
-      ret = -get_errno();
-      nerr("ERROR: recv failed: %d\n", ret);
-      return ret;
-    }
-
-  if (ret < sizeof(*hdr))
-    {
-      /* DNS header can't fit in received data */
-
-      nerr("ERROR: DNS response is too short\n");
-      return -EILSEQ;
-    }
-
   hdr         = (FAR struct dns_header_s *)buffer;
-  endofbuffer = (FAR uint8_t *)buffer + ret;
+  endofbuffer = buffer + buflen;
 
   ninfo("ID %d\n", NTOHS(hdr->id));
   ninfo("Query %d\n", hdr->flags1 & DNS_FLAG1_RESPONSE);
@@ -374,25 +463,18 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
         NTOHS(hdr->numquestions), NTOHS(hdr->numanswers),
         NTOHS(hdr->numauthrr), NTOHS(hdr->numextrarr));
 
-  /* Check for error */
+  /* Check for error.  A non-existent name is a valid, negative answer. */
 
-  if ((hdr->flags2 & DNS_FLAG2_ERR_MASK) != 0)
+  temp = hdr->flags2 & DNS_FLAG2_ERR_MASK;
+  if (temp != DNS_FLAG2_ERR_NONE && temp != DNS_FLAG2_ERR_NAME)
     {
       nerr("ERROR: DNS reported error: flags2=%02x\n", hdr->flags2);
       return -EPROTO;
     }
 
-  /* Check for matching ID. */
-
-  if (hdr->id != qinfo->id)
-    {
-      nerr("ERROR: DNS wrong response ID (expected %d, got %d)\n",
-           NTOHS(qinfo->id), NTOHS(hdr->id));
-      return -EBADMSG;
-    }
-
-  /* We only care about the question(s) and the answers. The authrr
-   * and the extrarr are simply discarded.
+  /* We only care about the question(s), the answers and the SOA record of
+   * negative answers.  The rest of the authrr and the extrarr are simply
+   * discarded.
    */
 
   nquestions = NTOHS(hdr->numquestions);
@@ -410,7 +492,7 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
    * matches against the name in the question.
    */
 
-  namestart = (uint8_t *)buffer + sizeof(*hdr);
+  namestart = buffer + sizeof(*hdr);
   nameptr   = dns_parse_name(namestart, endofbuffer);
   if (nameptr == endofbuffer)
     {
@@ -437,6 +519,11 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
 
   /* Validate query type and class */
 
+  if (nameptr + sizeof(struct dns_question_s) > endofbuffer)
+    {
+      return -EILSEQ;
+    }
+
   que = (FAR struct dns_question_s *)nameptr;
   memcpy(&bak, que, sizeof(struct dns_question_s));
 
@@ -462,7 +549,7 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
       /* Each answer starts with a name */
 
       nameptr = dns_parse_name(nameptr, endofbuffer);
-      if (nameptr == endofbuffer)
+      if (nameptr + 10 > endofbuffer)
         {
           ret = -EILSEQ;
           nwarn("Further parse returned %d\n", ret);
@@ -471,9 +558,9 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
 
       ans = (FAR struct dns_answer_s *)nameptr;
 
-      ninfo("Answer: type=%04x, class=%04x, ttl=%06x, length=%04x\n",
-            NTOHS(ans->type), NTOHS(ans->class),
-            (NTOHS(ans->ttl[0]) << 16) | NTOHS(ans->ttl[1]),
+      ninfo("Answer: type=%04x, class=%04x, ttl=%06" PRIx32
+            ", length=%04x\n",
+            NTOHS(ans->type), NTOHS(ans->class), dns_answer_ttl(ans),
             NTOHS(ans->len));
 
       /* Check for IPv4/6 address type and Internet class. Others are
@@ -496,12 +583,13 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
                 (int)((ans->u.ipv4.s_addr >> 16) & 0xff),
                 (int)((ans->u.ipv4.s_addr >> 24) & 0xff));
 
-          inaddr                  = &addr[naddr_read].ipv4;
+          inaddr                  = &rec->addr[naddr_read].ipv4;
           inaddr->sin_family      = AF_INET;
           inaddr->sin_port        = 0;
           inaddr->sin_addr.s_addr = ans->u.ipv4.s_addr;
 
-          if (++naddr_read >= naddr)
+          ttl = MIN(ttl, dns_answer_ttl(ans));
+          if (++naddr_read >= CONFIG_NETDB_MAX_IPADDR)
             {
               ret = -ERANGE;
               break;
@@ -529,12 +617,13 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
                 NTOHS(ans->u.ipv6.s6_addr16[6]),
                 NTOHS(ans->u.ipv6.s6_addr16[7]));
 
-          inaddr                  = &addr[naddr_read].ipv6;
+          inaddr                  = &rec->addr[naddr_read].ipv6;
           inaddr->sin6_family     = AF_INET6;
           inaddr->sin6_port       = 0;
           memcpy(inaddr->sin6_addr.s6_addr, ans->u.ipv6.s6_addr, 16);
 
-          if (++naddr_read >= naddr)
+          ttl = MIN(ttl, dns_answer_ttl(ans));
+          if (++naddr_read >= CONFIG_NETDB_MAX_IPADDR)
             {
               ret = -ERANGE;
               break;
@@ -547,129 +636,363 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
         }
     }
 
-  if (naddr_read == 0 && ret == OK)
+  if (naddr_read > 0)
     {
-      ret = -EADDRNOTAVAIL;
+      rec->ttl = ttl;
+      return naddr_read;
     }
 
-  return naddr_read > 0 ? naddr_read : ret;
+  if (ret == -EILSEQ)
+    {
+      return ret;
+    }
+
+  /* The name does not exist or has no address of this type.  That is an
+   * answer too and it may be cached for the time given by the SOA record.
+   */
+
+  rec->ttl = dns_parse_soa(nameptr, endofbuffer, NTOHS(hdr->numauthrr));
+  return -EADDRNOTAVAIL;
 }
 
 /****************************************************************************
- * Name: dns_query_callback
+ * Name: dns_query_server
+ *
+ * Description:
+ *   Check that a response comes from one of the name servers queried.
+ *
+ ****************************************************************************/
+
+static bool dns_query_server(FAR struct dns_query_s *query,
+                             FAR const union dns_addr_u *from)
+{
+  FAR const union dns_addr_u *server;
+  int i;
+
+  for (i = 0; i < query->nservers; i++)
+    {
+      server = &query->server[i];
+      if (server->addr.sa_family != from->addr.sa_family)
+        {
+          continue;
+        }
+
+#ifdef CONFIG_NET_IPv4
+      if (from->addr.sa_family == AF_INET &&
+          server->ipv4.sin_port == from->ipv4.sin_port &&
+          server->ipv4.sin_addr.s_addr == from->ipv4.sin_addr.s_addr)
+        {
+          return true;
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      if (from->addr.sa_family == AF_INET6 &&
+          server->ipv6.sin6_port == from->ipv6.sin6_port &&
+          memcmp(&server->ipv6.sin6_addr, &from->ipv6.sin6_addr,
+                 sizeof(struct in6_addr)) == 0)
+        {
+          return true;
+        }
+#endif
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: dns_recv_response
  *
  * Description:
- *   Using the DNS information and this DNS server address, look up the
- *   hostname.
+ *   Called when new UDP data arrives.  Match the response against the
+ *   queries in flight and update the state of the record type queried.
+ *
+ * Returned Value:
+ *   Returns number of valid IP address responses.  Negated errno value is
+ *   returned in all other cases.
+ *
+ ****************************************************************************/
+
+static int dns_recv_response(FAR struct dns_query_s *query)
+{
+  FAR struct dns_query_rec_s *rec = NULL;
+  FAR struct dns_header_s *hdr;
+  union dns_addr_u from;
+  socklen_t fromlen = sizeof(from);
+  uint8_t buffer[RECV_BUFFER_SIZE];
+  int ret;
+  int i;
+
+  /* Receive the response */
+
+  ret = recvfrom(query->sd, buffer, RECV_BUFFER_SIZE, 0,
+                 &from.addr, &fromlen);
+  if (ret < 0)
+    {
+      ret = -get_errno();
+      nerr("ERROR: recv failed: %d\n", ret);
+      return ret;
+    }
+
+  if (ret < sizeof(*hdr))
+    {
+      /* DNS header can't fit in received data */
+
+      nerr("ERROR: DNS response is too short\n");
+      return -EILSEQ;
+    }
+
+  if (!dns_query_server(query, &from))
+    {
+      nerr("ERROR: DNS response from unknown server\n");
+      return -EBADMSG;
+    }
+
+  /* Check for matching ID.  Late answers of other servers to a record
+   * type which is already resolved are dropped here too.
+   */
+
+  hdr = (FAR struct dns_header_s *)buffer;
+  for (i = 0; i < DNS_QUERY_NRECS; i++)
+    {
+      if (!query->rec[i].done && hdr->id == query->rec[i].qinfo.id)
+        {
+          rec = &query->rec[i];
+          break;
+        }
+    }
+
+  if (rec == NULL)
+    {
+      nwarn("WARNING: DNS unexpected response ID %d\n", NTOHS(hdr->id));
+      return -EBADMSG;
+    }
+
+  ret = dns_parse_response(buffer, ret, rec);
+  if (ret > 0 || ret == -EADDRNOTAVAIL ||
+      ++rec->nfail >= query->nservers)
+    {
+      /* A positive or negative answer, or every server failed */
+
+      rec->result = ret;
+      rec->done   = true;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: dns_query_servers
+ *
+ * Description:
+ *   Send the queries of all record types to the name servers collected in
+ *   the query structure and wait for the answers.
  *
  * Input Parameters:
- *   arg      - Query arguments
- *   addr     - DNS name server address
- *   addrlen  - Length of the DNS name server address.
+ *   query    - Query arguments
  *
  * Returned Value:
- *   Returns one (1) if the query was successful.  Zero is returned in all
- *   other cases.  The result field of the query structure is set to a
+ *   Returns one (1) if the lookup is complete:  the result field of the
+ *   query structure is then zero (OK) if addresses were found or
+ *   -EADDRNOTAVAIL if the name servers say that the name does not resolve.
+ *   Zero is returned in all other cases, with the result field set to a
  *   negated errno value indicate the reason for the last failure (only).
  *
  ****************************************************************************/
 
-static int dns_query_callback(FAR void *arg, FAR struct sockaddr *addr,
-                              FAR socklen_t addrlen)
+static int dns_query_servers(FAR struct dns_query_s *query)
 {
-  FAR struct dns_query_s *query = (FAR struct dns_query_s *)arg;
-  FAR struct dns_query_info_s qinfo;
-  int next = 0;
+  FAR struct dns_query_rec_s *rec;
+  struct timespec start;
+  struct timespec now;
+  struct pollfd pfd;
+  uint32_t ttl = UINT32_MAX;
+  uint16_t id;
+  int npending;
+  int timeout;
   int retries;
+  int nneg = 0;
+  int next = 0;
   int ret;
+  int i;
+
+  for (i = 0; i < DNS_QUERY_NRECS; i++)
+    {
+      rec         = &query->rec[i];
+      rec->done   = false;
+      rec->result = -EAGAIN;
+    }
 
   /* Loop while receive timeout errors occur and there are remaining
-   * retries.
+   * retries.  Each round sends the queries of all the record types that
+   * are not yet resolved and waits for the answers together.
    */
 
   for (retries = 0; retries < CONFIG_NETDB_DNSCLIENT_RETRIES; retries++)
     {
-#ifdef CONFIG_NET_IPv6
-      /* Send the IPv6 query */
+      id       = dns_alloc_id();
+      npending = 0;
 
-      ret = dns_send_query(query->sd, query->hostname,
-                          (FAR union dns_addr_u *)addr,
-                           DNS_RECTYPE_AAAA, &qinfo);
-      if (ret < 0)
-        {
-          nerr("ERROR: IPv6 dns_send_query failed: %d\n", ret);
-          query->result = ret;
-        }
-      else
+      for (i = 0; i < DNS_QUERY_NRECS; i++)
         {
-          /* Obtain the IPv6 response */
+          rec = &query->rec[i];
+          if (rec->done)
+            {
+              continue;
+            }
 
-          ret = dns_recv_response(query->sd, &query->addr[next],
-                                  *query->naddr - next, &qinfo);
-          if (ret >= 0)
+          rec->nfail = 0;
+          ret = dns_send_query(query->sd, query->hostname, query->server,
+                               query->nservers, g_dns_rectype[i], id + i,
+                               &rec->qinfo);
+          if (ret < 0)
             {
-              next += ret;
+              nerr("ERROR: dns_send_query type %d failed: %d\n",
+                   g_dns_rectype[i], ret);
+              rec->result = ret;
+              rec->done   = true;
             }
           else
             {
-              nerr("ERROR: IPv6 dns_recv_response failed: %d\n", ret);
-              query->result = ret;
+              npending++;
             }
         }
-#endif
 
-#ifdef CONFIG_NET_IPv4
-      /* Send the IPv4 query */
+      /* Wait for the answers until all are in or the time is up */
 
-      ret = dns_send_query(query->sd, query->hostname,
-                           (FAR union dns_addr_u *)addr,
-                           DNS_RECTYPE_A, &qinfo);
-      if (ret < 0)
-        {
-          nerr("ERROR: IPv4 dns_send_query failed: %d\n", ret);
-          query->result = ret;
-        }
-      else
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      timeout = CONFIG_NETDB_DNSCLIENT_RECV_TIMEOUT * 1000;
+
+      while (npending > 0 && timeout > 0)
         {
-          /* Obtain the IPv4 response */
+          pfd.fd      = query->sd;
+          pfd.events  = POLLIN;
+          pfd.revents = 0;
 
-          ret = dns_recv_response(query->sd, &query->addr[next],
-                                  *query->naddr - next, &qinfo);
-          if (ret >= 0)
+          ret = poll(&pfd, 1, timeout);
+          if (ret < 0)
             {
-              next += ret;
+              ret = -get_errno();
+              if (ret != -EINTR)
+                {
+                  nerr("ERROR: poll failed: %d\n", ret);
+                  query->result = ret;
+                  return 0;
+                }
             }
-          else
+          else if (ret > 0)
+            {
+              dns_recv_response(query);
+            }
+
+          for (npending = 0, i = 0; i < DNS_QUERY_NRECS; i++)
             {
-              nerr("ERROR: IPv4 dns_recv_response failed: %d\n", ret);
-              query->result = ret;
+              npending += query->rec[i].done ? 0 : 1;
             }
+
+          clock_gettime(CLOCK_MONOTONIC, &now);
+          timeout = CONFIG_NETDB_DNSCLIENT_RECV_TIMEOUT * 1000 -
+                    (now.tv_sec - start.tv_sec) * 1000 -
+                    (now.tv_nsec - start.tv_nsec) / 1000000;
+        }
+
+      if (npending == 0)
+        {
+          break;
         }
-#endif /* CONFIG_NET_IPv4 */
+    }
+
+  /* Merge the addresses of all the record types */
 
-      if (next > 0)
+  for (i = 0; i < DNS_QUERY_NRECS; i++)
+    {
+      rec = &query->rec[i];
+      if (rec->result > 0)
+        {
+          ret = MIN(rec->result, *query->naddr - next);
+          memcpy(&query->addr[next], rec->addr, ret * sizeof(*rec->addr));
+          next += ret;
+          ttl   = MIN(ttl, rec->ttl);
+        }
+      else if (rec->result == -EADDRNOTAVAIL)
         {
+          nneg++;
+        }
+      else
+        {
+          query->result = rec->result;
+        }
+    }
+
+  if (next > 0)
+    {
 #if CONFIG_NETDB_DNSCLIENT_ENTRIES > 0
-          /* Save the answer in the DNS cache */
+      /* Save the answer in the DNS cache */
 
-          dns_save_answer(query->hostname, query->addr, next);
+      dns_save_answer(query->hostname, query->addr, next, ttl);
 #endif
-          /* Return 1 to indicate to (1) stop the traversal, and (2)
-           * indicate that the address was found.
-           */
+      *query->naddr = next;
+      query->result = OK;
+      return 1;
+    }
 
-          *query->naddr = next;
-          return 1;
-        }
-      else if (query->result != -EAGAIN)
+  if (nneg == DNS_QUERY_NRECS)
+    {
+#if CONFIG_NETDB_DNSCLIENT_ENTRIES > 0
+      /* Every record type was answered negatively, remember that */
+
+      for (i = 0; i < DNS_QUERY_NRECS; i++)
         {
-          break;
+          ttl = MIN(ttl, query->rec[i].ttl);
         }
+
+      dns_save_answer(query->hostname, query->addr, 0, ttl);
+#endif
+      query->result = -EADDRNOTAVAIL;
+      return 1;
     }
 
   return 0;
 }
 
+/****************************************************************************
+ * Name: dns_query_callback
+ *
+ * Description:
+ *   Collect this DNS server address and, once
+ *   CONFIG_NETDB_DNSCLIENT_PARALLEL servers are collected, look up the
+ *   hostname using all of them at once.
+ *
+ * Input Parameters:
+ *   arg      - Query arguments
+ *   addr     - DNS name server address
+ *   addrlen  - Length of the DNS name server address.
+ *
+ * Returned Value:
+ *   Returns one (1) if the lookup is complete.  Zero is returned in all
+ *   other cases.  The result field of the query structure is set to a
+ *   negated errno value indicate the reason for the last failure (only).
+ *
+ ****************************************************************************/
+
+static int dns_query_callback(FAR void *arg, FAR struct sockaddr *addr,
+                              FAR socklen_t addrlen)
+{
+  FAR struct dns_query_s *query = (FAR struct dns_query_s *)arg;
+  int ret;
+
+  memcpy(&query->server[query->nservers++], addr,
+         MIN(addrlen, sizeof(union dns_addr_u)));
+  if (query->nservers < CONFIG_NETDB_DNSCLIENT_PARALLEL)
+    {
+      return 0;
+    }
+
+  ret = dns_query_servers(query);
+  query->nservers = 0;
+  return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -708,22 +1031,25 @@ int dns_query(int sd, FAR const char *hostname, FAR union dns_addr_u *addr,
   query.hostname = hostname;
   query.addr     = addr;
   query.naddr    = naddr;
+  query.nservers = 0;
 
   /* Perform the query. dns_foreach_nameserver() will return:
    *
-   *  1 - The query was successful.
+   *  1 - The lookup is complete.
    *  0 - Look up failed
    * <0 - Some other failure (?, shouldn't happen)
+   *
+   * The name servers left over once the traversal ends are queried
+   * last.
    */
 
   ret = dns_foreach_nameserver(dns_query_callback, &query);
-  if (ret > 0)
+  if (ret == 0 && query.nservers > 0)
     {
-      /* The lookup was successful */
-
-      ret = OK;
+      ret = dns_query_servers(&query);
     }
-  else if (ret == 0)
+
+  if (ret >= 0)
     {
       ret = query.result;
     }
@@ -734,6 +734,10 @@ int gethostentbyname_r(FAR const char *name,
                        FAR struct hostent_s *host, FAR char *buf,
                        size_t buflen, FAR int *h_errnop)
 {
+#ifdef CONFIG_NETDB_DNSCLIENT
+  int ret = -ENOENT;
+#endif
+
   DEBUGASSERT(name != NULL && host != NULL && buf != NULL);
 
   /* Make sure that the h_errno has a non-error code */
@@ -769,7 +773,8 @@ int gethostentbyname_r(FAR const char *name,
 #if CONFIG_NETDB_DNSCLIENT_ENTRIES > 0
   /* Check if we already have this hostname mapping cached */
 
-  if (lib_find_answer(name, host, buf, buflen) >= 0)
+  ret = lib_find_answer(name, host, buf, buflen);
+  if (ret >= 0)
     {
       /* Found the address mapping in the cache */
 
@@ -777,9 +782,11 @@ int gethostentbyname_r(FAR const char *name,
     }
 #endif
 
-  /* Try to get the host address using the DNS name server */
+  /* Try to get the host address using the DNS name server, unless the
+   * cache says that the name server already failed to resolve it.
+   */
 
-  if (lib_dns_lookup(name, host, buf, buflen) >= 0)
+  if (ret != -EADDRNOTAVAIL && lib_dns_lookup(name, host, buf, buflen) >= 0)
     {
       /* Successful DNS lookup! */
 
@@ -0,0 +1,187 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_PTHREAD_PTHREAD_H
+#define __LIBS_LIBC_PTHREAD_PTHREAD_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <unistd.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+#include <nuttx/tls.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+
+/* With the fast path, the num_readers field of a read/write lock is updated
+ * atomically.  Its most significant bit is set, under the rwlock mutex,
+ * whenever a writer holds the lock or waits for it.  Readers may then only
+ * take the lock through the mutex.
+ */
+
+#define RWLOCK_WRITER            (1u << 31)
+#define RWLOCK_READERS(s)        ((s) & ~RWLOCK_WRITER)
+#define RWLOCK_MAX_READERS       (RWLOCK_WRITER - 1)
+
+/* The state of a barrier holds the generation in bits 16-31 and the number
+ * of threads that have arrived in the current generation in bits 0-15.
+ */
+
+#define BARRIER_GEN_SHIFT        16
+#define BARRIER_ARRIVED_MASK     0xffff
+#define BARRIER_MAX_COUNT        BARRIER_ARRIVED_MASK
+#define BARRIER_GEN(s)           ((s) >> BARRIER_GEN_SHIFT)
+#define BARRIER_ARRIVED(s)       ((s) & BARRIER_ARRIVED_MASK)
+
+#endif /* CONFIG_PTHREAD_SYNC_FASTPATH */
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_tid
+ *
+ * Description:
+ *   Return the thread ID recorded as the holder of a mutex.  This is the
+ *   same value as getpid() but, with CONFIG_TLS_ALIGNED, it is taken from
+ *   the thread local storage without a system call.
+ *
+ ****************************************************************************/
+
+static inline pid_t pthread_mutex_tid(void)
+{
+#if defined(CONFIG_TLS_ALIGNED) && !defined(__KERNEL__)
+  return up_tls_info()->tl_tid;
+#else
+  return getpid();
+#endif
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_isfast
+ *
+ * Description:
+ *   Return true if the mutex may be locked and unlocked without the OS.
+ *   That is the case for NORMAL mutexes without priority inheritance:
+ *   other mutex types need the OS to check the holder and the OS must know
+ *   the holder of a priority inheritance mutex in order to boost it.
+ *
+ ****************************************************************************/
+
+static inline bool pthread_mutex_isfast(FAR pthread_mutex_t *mutex)
+{
+  if (mutex == NULL)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  if (mutex->type != PTHREAD_MUTEX_NORMAL)
+    {
+      return false;
+    }
+#endif
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if ((mutex->sem.flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+    {
+      return false;
+    }
+#endif
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fastlock
+ *
+ * Description:
+ *   Try to take an unlocked mutex by changing the count of the underlying
+ *   semaphore from one to zero.
+ *
+ * Returned Value:
+ *   true if the mutex was taken.  Otherwise, the caller must fall back to
+ *   the OS.
+ *
+ ****************************************************************************/
+
+static inline bool pthread_mutex_fastlock(FAR pthread_mutex_t *mutex)
+{
+  int16_t count = 1;
+
+  if (pthread_mutex_isfast(mutex) &&
+      __atomic_compare_exchange_n(&mutex->sem.semcount, &count, 0, false,
+                                  __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      mutex->pid = pthread_mutex_tid();
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fastunlock
+ *
+ * Description:
+ *   Try to give a mutex that nobody is waiting for by changing the count of
+ *   the underlying semaphore from zero to one.
+ *
+ * Returned Value:
+ *   true if the mutex was given.  Otherwise there are waiters (or the mutex
+ *   is not locked) and the caller must fall back to the OS.
+ *
+ ****************************************************************************/
+
+static inline bool pthread_mutex_fastunlock(FAR pthread_mutex_t *mutex)
+{
+  int16_t count = 0;
+
+  if (!pthread_mutex_isfast(mutex))
+    {
+      return false;
+    }
+
+  /* The holder must be cleared first.  As soon as the count is one, another
+   * thread may take the mutex and record itself as the holder.
+   */
+
+  mutex->pid = INVALID_PROCESS_ID;
+  return __atomic_compare_exchange_n(&mutex->sem.semcount, &count, 1, false,
+                                     __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FASTPATH */
+#endif /* __LIBS_LIBC_PTHREAD_PTHREAD_H */
@@ -69,7 +69,12 @@ int pthread_barrier_destroy(FAR pthread_barrier_t *barrier)
     }
   else
     {
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+      sem_destroy(&barrier->sem[0]);
+      sem_destroy(&barrier->sem[1]);
+#else
       sem_destroy(&barrier->sem);
+#endif
       barrier->count = 0;
     }
 
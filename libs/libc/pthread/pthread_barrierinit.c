@@ -29,6 +29,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include "pthread/pthread.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -60,7 +62,8 @@
  *   EAGAIN The system lacks the necessary resources to initialize another
  *          barrier.  EINVAL The barrier reference is invalid, or the values
  *          specified by attr are invalid, or the value specified by count
- *          is equal to zero.
+ *          is equal to zero (or larger than 65535 with
+ *          CONFIG_PTHREAD_SYNC_FASTPATH).
  *   ENOMEM Insufficient memory exists to initialize the barrier.
  *   EBUSY  The implementation has detected an attempt to reinitialize a
  *          barrier while it is in use.
@@ -79,12 +82,28 @@ int pthread_barrier_init(FAR pthread_barrier_t *barrier,
     {
       ret = EINVAL;
     }
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+  else if (count > BARRIER_MAX_COUNT)
+    {
+      ret = EINVAL;
+    }
+  else
+    {
+      sem_init(&barrier->sem[0], 0, 0);
+      sem_setprotocol(&barrier->sem[0], SEM_PRIO_NONE);
+      sem_init(&barrier->sem[1], 0, 0);
+      sem_setprotocol(&barrier->sem[1], SEM_PRIO_NONE);
+      barrier->state = 0;
+      barrier->count = count;
+    }
+#else
   else
     {
       sem_init(&barrier->sem, 0, 0);
       sem_setprotocol(&barrier->sem, SEM_PRIO_NONE);
       barrier->count = count;
     }
+#endif
 
   return ret;
 }
@@ -30,6 +30,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include "pthread/pthread.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -78,6 +80,79 @@
  *
  ****************************************************************************/
 
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+int pthread_barrier_wait(FAR pthread_barrier_t *barrier)
+{
+  unsigned int state;
+  unsigned int next;
+  FAR sem_t *sem;
+
+  if (!barrier)
+    {
+      return EINVAL;
+    }
+
+  /* Count this thread in.  The last thread to arrive starts the next
+   * generation with no thread arrived in the same atomic update, so that
+   * the barrier can be used again at once.
+   */
+
+  state = __atomic_load_n(&barrier->state, __ATOMIC_RELAXED);
+  do
+    {
+      if (BARRIER_ARRIVED(state) + 1 >= barrier->count)
+        {
+          next = (BARRIER_GEN(state) + 1) << BARRIER_GEN_SHIFT;
+        }
+      else
+        {
+          next = state + 1;
+        }
+    }
+  while (!__atomic_compare_exchange_n(&barrier->state, &state, next, true,
+                                      __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+  /* The threads of this generation wait on the semaphore selected by its
+   * parity.  A thread released early that comes back to the barrier for
+   * the next generation can then not take a count meant for a thread of
+   * this generation that has not blocked yet.  The next generation cannot
+   * complete before all of those threads have arrived again.
+   */
+
+  sem = &barrier->sem[BARRIER_GEN(state) & 1];
+
+  if (BARRIER_ARRIVED(next) == 0)
+    {
+      unsigned int i;
+
+      /* Free all of the waiting threads, then return
+       * PTHREAD_BARRIER_SERIAL_THREAD to the final thread.
+       */
+
+      for (i = 1; i < barrier->count; i++)
+        {
+          sem_post(sem);
+        }
+
+      return PTHREAD_BARRIER_SERIAL_THREAD;
+    }
+
+  /* Otherwise, this thread must wait as well */
+
+  while (sem_wait(sem) != OK)
+    {
+      /* If the thread is awakened by a signal, just continue to wait */
+
+      int errornumber = get_errno();
+      if (errornumber != EINTR)
+        {
+          return errornumber;
+        }
+    }
+
+  return 0;
+}
+#else
 int pthread_barrier_wait(FAR pthread_barrier_t *barrier)
 {
   int semcount;
@@ -147,3 +222,4 @@ int pthread_barrier_wait(FAR pthread_barrier_t *barrier)
       return 0;
     }
 }
+#endif
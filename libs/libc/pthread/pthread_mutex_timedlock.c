@@ -0,0 +1,74 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_mutex_timedlock.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <pthread.h>
+
+#include <nuttx/pthread.h>
+
+#include "pthread/pthread.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_timedlock
+ *
+ * Description:
+ *   The pthread_mutex_timedlock() function will lock the mutex object
+ *   referenced by mutex. If the mutex is already locked, the calling
+ *   thread will block until the mutex becomes available as in the
+ *   pthread_mutex_lock() function. If the mutex cannot be locked without
+ *   waiting for another thread to unlock the mutex, this wait will be
+ *   terminated when the specified timeout expires.
+ *
+ *   An unlocked NORMAL mutex without priority inheritance is taken without
+ *   calling into the OS if CONFIG_PTHREAD_MUTEX_FASTPATH is selected.
+ *
+ * Input Parameters:
+ *   mutex - A reference to the mutex to be locked.
+ *   abs_timeout - max wait time (NULL wait forever)
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.  Note that the errno EINTR
+ *   is never returned by pthread_mutex_timedlock().
+ *   errno is ETIMEDOUT if mutex could not be locked before the specified
+ *   timeout expired
+ *
+ ****************************************************************************/
+
+int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
+                            FAR const struct timespec *abs_timeout)
+{
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  if (pthread_mutex_fastlock(mutex))
+    {
+      return OK;
+    }
+#endif
+
+  return nx_pthread_mutex_timedlock(mutex, abs_timeout);
+}
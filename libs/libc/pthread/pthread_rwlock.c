@@ -29,6 +29,55 @@
 #include <errno.h>
 #include <debug.h>
 
+#include "pthread/pthread.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+static int fastrdunlock(FAR pthread_rwlock_t *rw_lock)
+{
+  unsigned int state = __atomic_load_n(&rw_lock->num_readers,
+                                       __ATOMIC_RELAXED);
+
+  /* There are no readers while a writer holds the lock.  The caller is
+   * then the writer, or does not hold the lock at all.
+   */
+
+  do
+    {
+      if (RWLOCK_READERS(state) == 0)
+        {
+          return EPERM;
+        }
+    }
+  while (!__atomic_compare_exchange_n(&rw_lock->num_readers, &state,
+                                      state - 1, true, __ATOMIC_RELEASE,
+                                      __ATOMIC_RELAXED));
+
+  /* A writer that is waiting for the last reader to leave set the writer
+   * bit with the mutex held before it sampled the number of readers, so
+   * it is either waiting on the condition variable or will see no reader.
+   */
+
+  if (state == (RWLOCK_WRITER | 1))
+    {
+      int err = pthread_mutex_lock(&rw_lock->lock);
+      if (err != 0)
+        {
+          return err;
+        }
+
+      err = pthread_cond_broadcast(&rw_lock->cv);
+      pthread_mutex_unlock(&rw_lock->lock);
+      return err;
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -80,12 +129,33 @@ int pthread_rwlock_unlock(FAR pthread_rwlock_t *rw_lock)
 {
   int err;
 
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+  err = fastrdunlock(rw_lock);
+  if (err != EPERM)
+    {
+      return err;
+    }
+#endif
+
   err = pthread_mutex_lock(&rw_lock->lock);
   if (err != 0)
     {
       return err;
     }
 
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+  if (rw_lock->write_in_progress)
+    {
+      rw_lock->write_in_progress = false;
+      if (rw_lock->num_writers == 0)
+        {
+          __atomic_fetch_and(&rw_lock->num_readers, ~RWLOCK_WRITER,
+                             __ATOMIC_RELEASE);
+        }
+
+      err = pthread_cond_broadcast(&rw_lock->cv);
+    }
+#else
   if (rw_lock->num_readers > 0)
     {
       rw_lock->num_readers--;
@@ -101,6 +171,7 @@ int pthread_rwlock_unlock(FAR pthread_rwlock_t *rw_lock)
 
       err = pthread_cond_broadcast(&rw_lock->cv);
     }
+#endif
   else
     {
       err = EINVAL;
@@ -29,6 +29,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include "pthread/pthread.h"
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -42,6 +44,36 @@ static void rdlock_cleanup(FAR void *arg)
 }
 #endif
 
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+static int fastrdlock(FAR pthread_rwlock_t *rw_lock)
+{
+  unsigned int state = __atomic_load_n(&rw_lock->num_readers,
+                                       __ATOMIC_RELAXED);
+
+  /* Add one reader unless a writer holds the lock or waits for it.  The
+   * writer bit can only be set with the mutex held, readers added here
+   * race only with other readers.
+   */
+
+  do
+    {
+      if ((state & RWLOCK_WRITER) != 0)
+        {
+          return EBUSY;
+        }
+      else if (state == RWLOCK_MAX_READERS)
+        {
+          return EAGAIN;
+        }
+    }
+  while (!__atomic_compare_exchange_n(&rw_lock->num_readers, &state,
+                                      state + 1, true, __ATOMIC_ACQUIRE,
+                                      __ATOMIC_RELAXED));
+
+  return OK;
+}
+#endif
+
 static int tryrdlock(FAR pthread_rwlock_t *rw_lock)
 {
   int err;
@@ -50,6 +82,16 @@ static int tryrdlock(FAR pthread_rwlock_t *rw_lock)
     {
       err = EBUSY;
     }
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+  else
+    {
+      /* The writer bit is clear while we hold the mutex, but the readers
+       * of the fast path may still be counted concurrently.
+       */
+
+      err = fastrdlock(rw_lock);
+    }
+#else
   else if (rw_lock->num_readers == UINT_MAX)
     {
       err = EAGAIN;
@@ -59,6 +101,7 @@ static int tryrdlock(FAR pthread_rwlock_t *rw_lock)
       rw_lock->num_readers++;
       err = OK;
     }
+#endif
 
   return err;
 }
@@ -85,6 +128,13 @@ static int tryrdlock(FAR pthread_rwlock_t *rw_lock)
 
 int pthread_rwlock_tryrdlock(FAR pthread_rwlock_t *rw_lock)
 {
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+  /* A writer holds the lock or waits for it if the fast path fails with
+   * EBUSY.  There is no need to go through the mutex to learn that.
+   */
+
+  return fastrdlock(rw_lock);
+#else
   int err = pthread_mutex_trylock(&rw_lock->lock);
 
   if (err != 0)
@@ -96,13 +146,26 @@ int pthread_rwlock_tryrdlock(FAR pthread_rwlock_t *rw_lock)
 
   pthread_mutex_unlock(&rw_lock->lock);
   return err;
+#endif
 }
 
 int pthread_rwlock_clockrdlock(FAR pthread_rwlock_t *rw_lock,
                                clockid_t clockid,
                                FAR const struct timespec *ts)
 {
-  int err = pthread_mutex_lock(&rw_lock->lock);
+  int err;
+
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+  /* Readers only need the mutex when there are writers */
+
+  err = fastrdlock(rw_lock);
+  if (err != EBUSY)
+    {
+      return err;
+    }
+#endif
+
+  err = pthread_mutex_lock(&rw_lock->lock);
 
   if (err != 0)
     {
@@ -29,16 +29,53 @@
 #include <errno.h>
 #include <debug.h>
 
+#include "pthread/pthread.h"
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_PTHREAD_SYNC_FASTPATH
+/* Keep the readers of the fast path out.  The number of readers must be
+ * sampled again after this: it can no longer increase.
+ */
+
+static inline void wrlock_block_readers(FAR pthread_rwlock_t *rw_lock)
+{
+  __atomic_fetch_or(&rw_lock->num_readers, RWLOCK_WRITER, __ATOMIC_SEQ_CST);
+}
+
+/* Let the readers of the fast path in again if no writer holds the lock
+ * or waits for it.  Called with the mutex held.
+ */
+
+static inline void wrlock_allow_readers(FAR pthread_rwlock_t *rw_lock)
+{
+  if (rw_lock->num_writers == 0 && !rw_lock->write_in_progress)
+    {
+      __atomic_fetch_and(&rw_lock->num_readers, ~RWLOCK_WRITER,
+                         __ATOMIC_RELEASE);
+    }
+}
+
+static inline unsigned int wrlock_readers(FAR pthread_rwlock_t *rw_lock)
+{
+  return RWLOCK_READERS(__atomic_load_n(&rw_lock->num_readers,
+                                        __ATOMIC_ACQUIRE));
+}
+#else
+#  define wrlock_block_readers(rw_lock)
+#  define wrlock_allow_readers(rw_lock)
+#  define wrlock_readers(rw_lock) ((rw_lock)->num_readers)
+#endif
+
 #ifdef CONFIG_PTHREAD_CLEANUP
 static void wrlock_cleanup(FAR void *arg)
 {
   FAR pthread_rwlock_t *rw_lock = (FAR pthread_rwlock_t *)arg;
 
   rw_lock->num_writers--;
+  wrlock_allow_readers(rw_lock);
   pthread_mutex_unlock(&rw_lock->lock);
 }
 #endif
@@ -72,13 +109,22 @@ int pthread_rwlock_trywrlock(FAR pthread_rwlock_t *rw_lock)
       return err;
     }
 
-  if (rw_lock->num_readers > 0 || rw_lock->write_in_progress)
+  if (rw_lock->write_in_progress)
     {
       err = EBUSY;
     }
   else
     {
-      rw_lock->write_in_progress = true;
+      wrlock_block_readers(rw_lock);
+      if (wrlock_readers(rw_lock) > 0)
+        {
+          wrlock_allow_readers(rw_lock);
+          err = EBUSY;
+        }
+      else
+        {
+          rw_lock->write_in_progress = true;
+        }
     }
 
   pthread_mutex_unlock(&rw_lock->lock);
@@ -103,11 +149,12 @@ int pthread_rwlock_clockwrlock(FAR pthread_rwlock_t *rw_lock,
     }
 
   rw_lock->num_writers++;
+  wrlock_block_readers(rw_lock);
 
 #ifdef CONFIG_PTHREAD_CLEANUP
   pthread_cleanup_push(&wrlock_cleanup, rw_lock);
 #endif
-  while (rw_lock->write_in_progress || rw_lock->num_readers > 0)
+  while (rw_lock->write_in_progress || wrlock_readers(rw_lock) > 0)
     {
       if (ts != NULL)
         {
@@ -141,6 +188,7 @@ int pthread_rwlock_clockwrlock(FAR pthread_rwlock_t *rw_lock,
     }
 
   rw_lock->num_writers--;
+  wrlock_allow_readers(rw_lock);
 
 exit_with_mutex:
   pthread_mutex_unlock(&rw_lock->lock);
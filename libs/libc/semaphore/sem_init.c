@@ -77,6 +77,7 @@ int nxsem_init(FAR sem_t *sem, int pshared, unsigned int value)
       sem->flags            = 0;
 #  if CONFIG_SEM_PREALLOCHOLDERS > 0
       sem->hhead            = NULL;
+      INITIALIZE_SEMHOLDER(&sem->holder);
 #  else
       INITIALIZE_SEMHOLDER(&sem->holder[0]);
       INITIALIZE_SEMHOLDER(&sem->holder[1]);
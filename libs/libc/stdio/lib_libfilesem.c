@@ -95,6 +95,34 @@ void lib_take_semaphore(FAR struct file_struct *stream)
     }
 }
 
+/****************************************************************************
+ * lib_try_semaphore
+ ****************************************************************************/
+
+int lib_try_semaphore(FAR struct file_struct *stream)
+{
+  pid_t my_pid = getpid();
+
+  /* Do I already have the semaphore? */
+
+  if (stream->fs_holder == my_pid)
+    {
+      stream->fs_counts++;
+      return OK;
+    }
+
+  /* Take the semaphore only if nobody has it */
+
+  if (_SEM_TRYWAIT(&stream->fs_sem) < 0)
+    {
+      return ERROR;
+    }
+
+  stream->fs_holder = my_pid;
+  stream->fs_counts = 1;
+  return OK;
+}
+
 /****************************************************************************
  * lib_give_semaphore
  ****************************************************************************/
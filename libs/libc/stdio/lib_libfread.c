@@ -41,10 +41,15 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fread
+ * Name: lib_fread_unlocked
+ *
+ * Description:
+ *   Read from the stream without taking the stream semaphore.  The caller
+ *   either holds it or knows that no other thread uses the stream.
+ *
  ****************************************************************************/
 
-ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream)
 {
   FAR unsigned char *dest = (FAR unsigned char *)ptr;
   ssize_t bytes_read;
@@ -62,10 +67,6 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
     }
   else
     {
-      /* The stream must be stable until we complete the read */
-
-      lib_take_semaphore(stream);
-
 #if CONFIG_NUNGET_CHARS > 0
       /* First, re-read any previously ungotten characters */
 
@@ -115,12 +116,21 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
             {
               /* Is there readable data in the buffer? */
 
-              while (remaining > 0 && stream->fs_bufpos < stream->fs_bufread)
+              if (stream->fs_bufpos < stream->fs_bufread)
                 {
-                  /* Yes, copy a byte into the user buffer */
+                  /* Yes, copy it into the user buffer */
+
+                  size_t gulp_size = stream->fs_bufread - stream->fs_bufpos;
 
-                  *dest++ = *stream->fs_bufpos++;
-                  remaining--;
+                  if (gulp_size > remaining)
+                    {
+                      gulp_size = remaining;
+                    }
+
+                  memcpy(dest, stream->fs_bufpos, gulp_size);
+                  stream->fs_bufpos += gulp_size;
+                  dest              += gulp_size;
+                  remaining         -= gulp_size;
                 }
 
               /* The buffer is empty OR we have already supplied the number
@@ -298,7 +308,6 @@ shortread:
           stream->fs_flags |= __FS_FLAG_EOF;
         }
 
-      lib_give_semaphore(stream);
       return count - remaining;
     }
 
@@ -306,6 +315,28 @@ shortread:
 
 errout_with_errno:
   stream->fs_flags |= __FS_FLAG_ERROR;
-  lib_give_semaphore(stream);
   return ERROR;
 }
+
+/****************************************************************************
+ * Name: lib_fread
+ ****************************************************************************/
+
+ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  /* The stream must be stable until we complete the read */
+
+  lib_take_semaphore(stream);
+  ret = lib_fread_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
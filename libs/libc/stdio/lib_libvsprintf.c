@@ -75,6 +75,11 @@
 
 #define putc(c,stream)  (total_len++, (stream)->put(stream, c))
 
+/* Put runs of characters with one call to the stream */
+
+#define putn(s,n,stream)   (total_len += (n), vsprintf_puts(stream, s, n))
+#define pad(c,n,stream)    (total_len += (n), vsprintf_pad(stream, c, n))
+
 /* Order is relevant here and matches order in format string */
 
 #define FL_ZFILL           0x0001
@@ -145,6 +150,9 @@ struct arg_s
 
 static const char g_nullstring[] = "(null)";
 
+static const char g_spaces[] = "                ";
+static const char g_zeros[]  = "0000000000000000";
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -157,6 +165,53 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: vsprintf_puts
+ *
+ * Description:
+ *   Put a run of characters to the stream, with a single call if the
+ *   stream supports it.
+ *
+ ****************************************************************************/
+
+static void vsprintf_puts(FAR struct lib_outstream_s *stream,
+                          FAR const char *s, int n)
+{
+  if (stream->puts != NULL)
+    {
+      stream->puts(stream, s, n);
+    }
+  else
+    {
+      while (n-- > 0)
+        {
+          stream->put(stream, *s++);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: vsprintf_pad
+ *
+ * Description:
+ *   Put n times the padding character ' ' or '0' to the stream.
+ *
+ ****************************************************************************/
+
+static void vsprintf_pad(FAR struct lib_outstream_s *stream, int c, int n)
+{
+  FAR const char *s = c == '0' ? g_zeros : g_spaces;
+  const int maxchunk = sizeof(g_spaces) - 1;
+  int chunk;
+
+  while (n > 0)
+    {
+      chunk = n < maxchunk ? n : maxchunk;
+      vsprintf_puts(stream, s, chunk);
+      n -= chunk;
+    }
+}
+
 #ifdef CONFIG_ALLSYMS
 static int sprintf_internal(FAR struct lib_outstream_s *stream,
                             FAR const IPTR char *fmt, ...)
@@ -210,6 +265,27 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
     {
       for (; ; )
         {
+#ifndef CONFIG_ARCH_ROMGETC
+          /* Put the run of plain characters up to the next conversion at
+           * once.
+           */
+
+          pnt = fmt;
+          while (*fmt != '\0' && *fmt != '%')
+            {
+              fmt++;
+            }
+
+#ifdef CONFIG_LIBC_NUMBERED_ARGS
+          if (fmt != pnt && stream != NULL)
+#else
+          if (fmt != pnt)
+#endif
+            {
+              putn(pnt, fmt - pnt, stream);
+            }
+#endif
+
           c = fmt_char(fmt);
           if (c == '\0')
             {
@@ -755,13 +831,10 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
 
           /* Output before first digit */
 
-          if ((flags & (FL_LPAD | FL_ZFILL)) == 0)
+          if ((flags & (FL_LPAD | FL_ZFILL)) == 0 && width > 0)
             {
-              while (width)
-                {
-                  putc(' ', stream);
-                  width--;
-                }
+              pad(' ', width, stream);
+              width = 0;
             }
 
           if (sign != 0)
@@ -769,13 +842,10 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
               putc(sign, stream);
             }
 
-          if ((flags & FL_LPAD) == 0)
+          if ((flags & FL_LPAD) == 0 && width > 0)
             {
-              while (width)
-                {
-                  putc('0', stream);
-                  width--;
-                }
+              pad('0', width, stream);
+              width = 0;
             }
 
           if ((flags & FL_FLTFIX) != 0)
@@ -937,24 +1007,16 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
           size = strnlen(pnt, (flags & FL_PREC) ? prec : ~0);
 
         str_lpad:
-          if ((flags & FL_LPAD) == 0)
+          if ((flags & FL_LPAD) == 0 && size < width)
             {
-              while (size < width)
-                {
-                  putc(' ', stream);
-                  width--;
-                }
+              pad(' ', width - size, stream);
+              width = size;
             }
 
-          while (size)
+          width = size < width ? width - size : 0;
+          if (size > 0)
             {
-              putc(*pnt++, stream);
-              if (width != 0)
-                {
-                  width -= 1;
-                }
-
-              size -= 1;
+              putn(pnt, size, stream);
             }
 
           goto tail;
@@ -1153,10 +1215,7 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
                       if (symbol != NULL)
                         {
                           pnt = symbol->sym_name;
-                          while (*pnt != '\0')
-                            {
-                              putc(*pnt++, stream);
-                            }
+                          putn(pnt, strlen(pnt), stream);
 
                           if (c == 'S')
                             {
@@ -1264,10 +1323,10 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
                 }
             }
 
-          while (len < width)
+          if (len < width)
             {
-              putc(' ', stream);
-              len++;
+              pad(' ', width - len, stream);
+              len = width;
             }
         }
 
@@ -1297,25 +1356,33 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
           putc(z, stream);
         }
 
-      while (prec > c)
+      if (prec > c)
         {
-          putc('0', stream);
-          prec--;
+          pad('0', prec - c, stream);
+        }
+
+      /* The digits were converted in reverse order */
+
+      for (len = 0; len < c / 2; len++)
+        {
+          unsigned char tmp = buf[len];
+
+          buf[len] = buf[c - 1 - len];
+          buf[c - 1 - len] = tmp;
         }
 
-      while (c)
+      if (c > 0)
         {
-          putc(buf[--c], stream);
+          putn((FAR const char *)buf, c, stream);
         }
 
 tail:
 
       /* Tail is possible.  */
 
-      while (width)
+      if (width > 0)
         {
-          putc(' ', stream);
-          width--;
+          pad(' ', width, stream);
         }
     }
 
@@ -78,6 +78,7 @@ int setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size)
 {
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
   FAR unsigned char *newbuf = NULL;
+  bool resized = false;
   uint8_t flags;
   int errcode;
 
@@ -190,6 +191,32 @@ int setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size)
 
                 flags |= __FS_FLAG_UBF;
               }
+            else if (stream->fs_bufstart != NULL &&
+                     (stream->fs_flags & __FS_FLAG_UBF) == 0)
+              {
+                /* The buffer holds no data, so reuse the memory that we
+                 * allocated before if it is large enough, or else resize
+                 * it instead of freeing and allocating again.
+                 */
+
+                if (size <=
+                    (size_t)(stream->fs_bufend - stream->fs_bufstart))
+                  {
+                    newbuf = stream->fs_bufstart;
+                  }
+                else
+                  {
+                    newbuf = (FAR unsigned char *)
+                      lib_realloc(stream->fs_bufstart, size);
+                    if (newbuf == NULL)
+                      {
+                        errcode = ENOMEM;
+                        goto errout_with_semaphore;
+                      }
+                  }
+
+                resized = true;
+              }
             else
               {
                 newbuf = (FAR unsigned char *)lib_malloc(size);
@@ -229,7 +256,7 @@ int setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size)
     * on a previous call to setvbuf().
     */
 
-  if (stream->fs_bufstart != NULL &&
+  if (stream->fs_bufstart != NULL && !resized &&
      (stream->fs_flags & __FS_FLAG_UBF) == 0)
     {
       lib_free(stream->fs_bufstart);
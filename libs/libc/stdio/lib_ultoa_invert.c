@@ -37,8 +37,101 @@
  * Included Files
  ****************************************************************************/
 
+#include <limits.h>
+
 #include "lib_ultoa_invert.h"
 
+/****************************************************************************
+ * Private Constant Data
+ ****************************************************************************/
+
+/* The two decimal digits of each of 0 to 99 */
+
+static const char g_dec2digits[200] =
+{
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899"
+};
+
+static const char g_lowerdigits[] = "0123456789abcdef";
+static const char g_upperdigits[] = "0123456789ABCDEF";
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ultoa_invert
+ *
+ * Description:
+ *   Convert a value that fits in an unsigned long.  Decimal values are
+ *   converted two digits per division with a table, octal and hexadecimal
+ *   values with shifts instead of divisions.
+ *
+ ****************************************************************************/
+
+static FAR char *ultoa_invert(unsigned long val, FAR char *str, int base,
+                              FAR const char *digits)
+{
+  unsigned int v;
+
+  switch (base)
+    {
+      case 10:
+        while (val >= 100)
+          {
+            v    = val % 100;
+            val /= 100;
+
+            *str++ = g_dec2digits[2 * v + 1];
+            *str++ = g_dec2digits[2 * v];
+          }
+
+        if (val >= 10)
+          {
+            *str++ = g_dec2digits[2 * val + 1];
+            *str++ = g_dec2digits[2 * val];
+          }
+        else
+          {
+            *str++ = '0' + val;
+          }
+        break;
+
+      case 16:
+        do
+          {
+            *str++ = digits[val & 0xf];
+            val >>= 4;
+          }
+        while (val);
+        break;
+
+      case 8:
+        do
+          {
+            *str++ = '0' + (val & 0x7);
+            val >>= 3;
+          }
+        while (val);
+        break;
+
+      default:
+        do
+          {
+            *str++ = digits[val % base];
+            val /= base;
+          }
+        while (val);
+        break;
+    }
+
+  return str;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,36 +142,44 @@ FAR char *__ultoa_invert(unsigned long long val, FAR char *str, int base)
 FAR char *__ultoa_invert(unsigned long val, FAR char *str, int base)
 #endif
 {
-  int upper = 0;
+  FAR const char *digits = g_lowerdigits;
 
   if (base & XTOA_UPPER)
     {
-      upper = 1;
+      digits = g_upperdigits;
       base &= ~XTOA_UPPER;
     }
 
-  do
-    {
-      int v;
-
-      v   = val % base;
-      val = val / base;
+#if defined(CONFIG_LIBC_LONG_LONG) && ULLONG_MAX > ULONG_MAX
+  /* Divisions of long long are slow on 32-bit targets, so only convert
+   * with long long until the rest fits in an unsigned long.  Decimal
+   * values are split in blocks of nine digits.
+   */
 
-      if (v <= 9)
+  if (base == 10)
+    {
+      while (val > ULONG_MAX)
         {
-          v += '0';
+          unsigned long block = val % 1000000000;
+          int i;
+
+          val /= 1000000000;
+          for (i = 0; i < 9; i++)
+            {
+              *str++ = '0' + block % 10;
+              block /= 10;
+            }
         }
-      else
+    }
+  else
+    {
+      while (val > ULONG_MAX)
         {
-          if (upper)
-            v += 'A' - 10;
-          else
-            v += 'a' - 10;
+          *str++ = digits[val % base];
+          val /= base;
         }
-
-      *str++ = v;
     }
-  while (val);
+#endif
 
-  return str;
+  return ultoa_invert((unsigned long)val, str, base, digits);
 }
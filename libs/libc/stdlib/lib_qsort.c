@@ -47,13 +47,18 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define min(a, b)  (a) < (b) ? a : b
+/* Partitions smaller than this are finished with an insertion sort */
+
+#define QSORT_THRESHOLD 7
+
+#define min(a, b)  ((a) < (b) ? (a) : (b))
 
 #define swapcode(TYPE, parmi, parmj, n) \
   { \
@@ -67,9 +72,19 @@
     } while (--i > 0); \
   }
 
+/* Swap in the widest word that the base address and the element size are
+ * both aligned to:
+ *
+ *   0 - each element is a single long
+ *   1 - elements are swapped a long at a time
+ *   2 - elements are swapped an int at a time
+ *   3 - elements are swapped byte by byte
+ */
+
 #define SWAPINIT(a, width) \
-  swaptype = ((FAR char *)a - (FAR char *)0) % sizeof(long) || \
-  width % sizeof(long) ? 2 : width == sizeof(long)? 0 : 1;
+  swaptype = (((uintptr_t)(a) | (width)) % sizeof(long)) == 0 ? \
+             ((width) == sizeof(long) ? 0 : 1) : \
+             (((uintptr_t)(a) | (width)) % sizeof(int)) == 0 ? 2 : 3;
 
 #define swap(a, b) \
   if (swaptype == 0) \
@@ -85,25 +100,42 @@
 
 #define vecswap(a, b, n) if ((n) > 0) swapfunc(a, b, n, swaptype)
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+typedef CODE int (*compar_t)(FAR const void *, FAR const void *);
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
-static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype);
+static inline void swapfunc(FAR char *a, FAR char *b, size_t n,
+                            int swaptype);
 static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
-                             CODE int (*compar)(FAR const void *,
-                             FAR const void *));
+                             compar_t compar);
+static void insertion_sort(FAR char *base, size_t nel, size_t width,
+                           compar_t compar, int swaptype);
+static void heap_sort(FAR char *base, size_t nel, size_t width,
+                      compar_t compar, int swaptype);
+static void intro_sort(FAR char *base, size_t nel, size_t width,
+                       compar_t compar, int swaptype, int depth);
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype)
+static inline void swapfunc(FAR char *a, FAR char *b, size_t n,
+                            int swaptype)
 {
   if (swaptype <= 1)
     {
       swapcode(long, a, b, n)
     }
+  else if (swaptype == 2)
+    {
+      swapcode(int, a, b, n)
+    }
   else
     {
       swapcode(char, a, b, n)
@@ -111,8 +143,7 @@ static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype)
 }
 
 static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
-                             CODE int (*compar)(FAR const void *,
-                             FAR const void *))
+                             compar_t compar)
 {
   return compar(a, b) < 0 ?
          (compar(b, c) < 0 ? b : (compar(a, c) < 0 ? c : a)) :
@@ -120,50 +151,101 @@ static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
 }
 
 /****************************************************************************
- * Public Function
+ * Name: insertion_sort
+ *
+ * Description:
+ *   Sort a small partition.
+ *
  ****************************************************************************/
 
+static void insertion_sort(FAR char *base, size_t nel, size_t width,
+                           compar_t compar, int swaptype)
+{
+  FAR char *pm;
+  FAR char *pl;
+
+  for (pm = base + width; pm < base + nel * width; pm += width)
+    {
+      for (pl = pm; pl > base && compar(pl - width, pl) > 0; pl -= width)
+        {
+          swap(pl, pl - width);
+        }
+    }
+}
+
 /****************************************************************************
- * Name: qsort
+ * Name: heap_sort
  *
  * Description:
- *   The qsort() function will sort an array of 'nel' objects, the initial
- *   element of which is pointed to by 'base'. The size of each object, in
- *   bytes, is specified by the 'width" argument. If the 'nel' argument has
- *   the value zero, the comparison function pointed to by 'compar' will not
- *   be called and no rearrangement will take place.
- *
- *   The application will ensure that the comparison function pointed to by
- *   'compar' does not alter the contents of the array. The implementation
- *   may reorder elements of the array between calls to the comparison
- *   function, but will not alter the contents of any individual element.
- *
- *   When the same objects (consisting of 'width" bytes, irrespective of
- *   their current positions in the array) are passed more than once to
- *   the comparison function, the results will be consistent with one
- *   another. That is, they will define a total ordering on the array.
- *
- *   The contents of the array will be sorted in ascending order according
- *   to a comparison function. The 'compar' argument is a pointer to the
- *   comparison function, which is called with two arguments that point to
- *   the elements being compared. The application will ensure that the
- *   function returns an integer less than, equal to, or greater than 0,
- *   if the first argument is considered respectively less than, equal to,
- *   or greater than the second. If two members compare as equal, their
- *   order in the sorted array is unspecified.
+ *   Sort a partition in O(n log n) time without further recursion.  Used
+ *   once the quicksort has gone too deep, which only happens for inputs
+ *   that defeat the median-of-three pivot selection.
  *
- *   (Based on description from OpenGroup.org).
- *
- * Returned Value:
- *   The qsort() function will not return a value.
+ ****************************************************************************/
+
+static void heap_sort(FAR char *base, size_t nel, size_t width,
+                      compar_t compar, int swaptype)
+{
+  FAR char *pr;
+  FAR char *pc;
+  size_t root;
+  size_t child;
+  size_t end;
+  size_t i;
+
+  /* Build a max-heap, then repeatedly move its top to the end */
+
+  for (i = nel / 2, end = nel; ; )
+    {
+      if (i > 0)
+        {
+          root = --i;
+        }
+      else if (--end > 0)
+        {
+          swap(base, base + end * width);
+          root = 0;
+        }
+      else
+        {
+          break;
+        }
+
+      /* Sift the root down into place */
+
+      while ((child = 2 * root + 1) < end)
+        {
+          pc = base + child * width;
+          if (child + 1 < end && compar(pc, pc + width) < 0)
+            {
+              child++;
+              pc += width;
+            }
+
+          pr = base + root * width;
+          if (compar(pr, pc) >= 0)
+            {
+              break;
+            }
+
+          swap(pr, pc);
+          root = child;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: intro_sort
  *
- * Notes from the original BSD version:
- *   Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
+ * Description:
+ *   Bentley & McIlroy's quicksort with a bound on the recursion depth.
+ *   The smaller partition is sorted recursively and the larger one
+ *   iteratively, so the stack never holds more than log2(nel) frames.
  *
  ****************************************************************************/
 
-void qsort(FAR void *base, size_t nel, size_t width,
-           CODE int(*compar)(FAR const void *, FAR const void *))
+static void intro_sort(FAR char *base, size_t nel, size_t width,
+                       compar_t compar, int swaptype, int depth)
 {
   FAR char *pa;
   FAR char *pb;
@@ -172,126 +254,174 @@ void qsort(FAR void *base, size_t nel, size_t width,
   FAR char *pl;
   FAR char *pm;
   FAR char *pn;
-  int swaptype;
-  int swap_cnt;
-  int d;
+  size_t nleft;
+  size_t nright;
+  size_t d;
   int r;
 
-loop:
-  SWAPINIT(base, width);
-  swap_cnt = 0;
-
-  if (nel < 7)
+  while (nel >= QSORT_THRESHOLD)
     {
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
+      if (depth-- <= 0)
         {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
-            {
-              swap(pl, pl - width);
-            }
+          heap_sort(base, nel, width, compar, swaptype);
+          return;
         }
 
-      return;
-    }
-
-  pm = (FAR char *)base + (nel / 2) * width;
-  if (nel > 7)
-    {
-      pl = base;
-      pn = (FAR char *)base + (nel - 1) * width;
-      if (nel > 40)
+      pm = base + (nel / 2) * width;
+      if (nel > QSORT_THRESHOLD)
         {
-          d  = (nel / 8) * width;
-          pl = med3(pl, pl + d, pl + 2 * d, compar);
-          pm = med3(pm - d, pm, pm + d, compar);
-          pn = med3(pn - 2 * d, pn - d, pn, compar);
-        }
+          pl = base;
+          pn = base + (nel - 1) * width;
+          if (nel > 40)
+            {
+              d  = (nel / 8) * width;
+              pl = med3(pl, pl + d, pl + 2 * d, compar);
+              pm = med3(pm - d, pm, pm + d, compar);
+              pn = med3(pn - 2 * d, pn - d, pn, compar);
+            }
 
-      pm = med3(pl, pm, pn, compar);
-    }
+          pm = med3(pl, pm, pn, compar);
+        }
 
-  swap(base, pm);
-  pa = pb = (FAR char *)base + width;
+      swap(base, pm);
+      pa = pb = base + width;
 
-  pc = pd = (FAR char *)base + (nel - 1) * width;
-  for (; ; )
-    {
-      while (pb <= pc && (r = compar(pb, base)) <= 0)
+      pc = pd = base + (nel - 1) * width;
+      for (; ; )
         {
-          if (r == 0)
+          while (pb <= pc && (r = compar(pb, base)) <= 0)
             {
-              swap_cnt = 1;
-              swap(pa, pb);
-              pa += width;
+              if (r == 0)
+                {
+                  swap(pa, pb);
+                  pa += width;
+                }
+
+              pb += width;
             }
 
-          pb += width;
-        }
+          while (pb <= pc && (r = compar(pc, base)) >= 0)
+            {
+              if (r == 0)
+                {
+                  swap(pc, pd);
+                  pd -= width;
+                }
 
-      while (pb <= pc && (r = compar(pc, base)) >= 0)
-        {
-          if (r == 0)
+              pc -= width;
+            }
+
+          if (pb > pc)
             {
-              swap_cnt = 1;
-              swap(pc, pd);
-              pd -= width;
+              break;
             }
 
+          swap(pb, pc);
+          pb += width;
           pc -= width;
         }
 
-      if (pb > pc)
-        {
-          break;
-        }
+      /* Move the elements equal to the pivot to the middle */
 
-      swap(pb, pc);
-      swap_cnt = 1;
-      pb      += width;
-      pc      -= width;
-    }
+      pn = base + nel * width;
+      d  = min(pa - base, pb - pa);
+      vecswap(base, pb - d, d);
 
-  if (swap_cnt == 0)
-    {
-      /* Switch to insertion sort */
+      d  = min(pd - pc, pn - pd - width);
+      vecswap(pb, pn - d, d);
+
+      nleft  = (pb - pa) / width;
+      nright = (pd - pc) / width;
 
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
+      if (nleft < nright)
         {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
+          if (nleft > 1)
             {
-              swap(pl, pl - width);
+              intro_sort(base, nleft, width, compar, swaptype, depth);
             }
+
+          base = pn - nright * width;
+          nel  = nright;
         }
+      else
+        {
+          if (nright > 1)
+            {
+              intro_sort(pn - nright * width, nright, width, compar,
+                         swaptype, depth);
+            }
 
-      return;
+          nel = nleft;
+        }
     }
 
-  pn = (FAR char *)base + nel * width;
-  r  = min(pa - (FAR char *)base, pb - pa);
-  vecswap(base, pb - r, r);
+  insertion_sort(base, nel, width, compar, swaptype);
+}
 
-  r  = min(pd - pc, pn - pd - width);
-  vecswap(pb, pn - r, r);
+/****************************************************************************
+ * Public Function
+ ****************************************************************************/
 
-  if ((r = pb - pa) > width)
+/****************************************************************************
+ * Name: qsort
+ *
+ * Description:
+ *   The qsort() function will sort an array of 'nel' objects, the initial
+ *   element of which is pointed to by 'base'. The size of each object, in
+ *   bytes, is specified by the 'width" argument. If the 'nel' argument has
+ *   the value zero, the comparison function pointed to by 'compar' will not
+ *   be called and no rearrangement will take place.
+ *
+ *   The application will ensure that the comparison function pointed to by
+ *   'compar' does not alter the contents of the array. The implementation
+ *   may reorder elements of the array between calls to the comparison
+ *   function, but will not alter the contents of any individual element.
+ *
+ *   When the same objects (consisting of 'width" bytes, irrespective of
+ *   their current positions in the array) are passed more than once to
+ *   the comparison function, the results will be consistent with one
+ *   another. That is, they will define a total ordering on the array.
+ *
+ *   The contents of the array will be sorted in ascending order according
+ *   to a comparison function. The 'compar' argument is a pointer to the
+ *   comparison function, which is called with two arguments that point to
+ *   the elements being compared. The application will ensure that the
+ *   function returns an integer less than, equal to, or greater than 0,
+ *   if the first argument is considered respectively less than, equal to,
+ *   or greater than the second. If two members compare as equal, their
+ *   order in the sorted array is unspecified.
+ *
+ *   (Based on description from OpenGroup.org).
+ *
+ * Returned Value:
+ *   The qsort() function will not return a value.
+ *
+ * Notes from the original BSD version:
+ *   Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
+ *
+ *   This version is an introsort:  The quicksort switches to a heapsort
+ *   after 2 * log2(nel) levels, bounding the worst case to O(n log n).
+ *
+ ****************************************************************************/
+
+void qsort(FAR void *base, size_t nel, size_t width,
+           CODE int(*compar)(FAR const void *, FAR const void *))
+{
+  size_t n;
+  int swaptype;
+  int depth;
+
+  if (nel < 2 || width == 0)
     {
-      qsort(base, r / width, width, compar);
+      return;
     }
 
-  if ((r = pd - pc) > width)
-    {
-      /* Iterate rather than recurse to save stack space */
+  SWAPINIT(base, width);
 
-      base = pn - r;
-      nel = r / width;
-      goto loop;
+  for (depth = 0, n = nel; n > 1; n >>= 1)
+    {
+      depth += 2;
     }
+
+  intro_sort(base, nel, width, compar, swaptype, depth);
 }
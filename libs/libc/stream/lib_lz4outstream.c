@@ -0,0 +1,242 @@
+/****************************************************************************
+ * libs/libc/stream/lib_lz4outstream.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <nuttx/streams.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The frame descriptor is fixed: independent blocks of at most 64KB, no
+ * checksums and no content size.  This makes the header checksum, the
+ * second byte of the xxHash32 of the FLG and BD bytes, a constant.
+ */
+
+#define LZ4_FRAME_FLG         0x60
+#define LZ4_FRAME_BD          0x40
+#define LZ4_FRAME_HC          0x82
+
+/* A block size with this bit set marks a block stored uncompressed */
+
+#define LZ4_BLOCK_RAW         0x80000000
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const uint8_t g_lz4_frame_header[] =
+{
+  0x04, 0x22, 0x4d, 0x18, LZ4_FRAME_FLG, LZ4_FRAME_BD, LZ4_FRAME_HC
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4outstream_word
+ *
+ * Description:
+ *   Send one little endian word of the frame
+ *
+ ****************************************************************************/
+
+static int lz4outstream_word(FAR struct lib_lz4outstream_s *stream,
+                             uint32_t word)
+{
+  uint8_t buf[4];
+
+  buf[0] = word & 0xff;
+  buf[1] = (word >> 8) & 0xff;
+  buf[2] = (word >> 16) & 0xff;
+  buf[3] = word >> 24;
+
+  return stream->backend->puts(stream->backend, buf, sizeof(buf));
+}
+
+/****************************************************************************
+ * Name: lz4outstream_block
+ *
+ * Description:
+ *   Compress and send the buffered data as one block, preceded by the
+ *   frame header if this is the first block of the frame.  A block that
+ *   does not shrink is sent as it is.
+ *
+ ****************************************************************************/
+
+static int lz4outstream_block(FAR struct lib_lz4outstream_s *stream)
+{
+  FAR const uint8_t *data = stream->out;
+  size_t outlen;
+  uint32_t size;
+  int ret;
+
+  if (!stream->framed)
+    {
+      ret = stream->backend->puts(stream->backend, g_lz4_frame_header,
+                                  sizeof(g_lz4_frame_header));
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      stream->framed = true;
+    }
+
+  outlen = lz4_compress(stream->in, stream->offset, stream->out,
+                        stream->offset - 1, stream->state);
+  if (outlen > 0)
+    {
+      size = outlen;
+    }
+  else
+    {
+      data   = stream->in;
+      outlen = stream->offset;
+      size   = outlen | LZ4_BLOCK_RAW;
+    }
+
+  stream->offset = 0;
+
+  ret = lz4outstream_word(stream, size);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return stream->backend->puts(stream->backend, data, outlen);
+}
+
+/****************************************************************************
+ * Name: lz4outstream_flush
+ ****************************************************************************/
+
+static int lz4outstream_flush(FAR struct lib_outstream_s *this)
+{
+  FAR struct lib_lz4outstream_s *stream =
+                                 (FAR struct lib_lz4outstream_s *)this;
+  int ret;
+
+  if (stream->offset > 0)
+    {
+      ret = lz4outstream_block(stream);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* End the frame so that everything sent so far can be decompressed */
+
+  if (stream->framed)
+    {
+      ret = lz4outstream_word(stream, 0);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      stream->framed = false;
+    }
+
+  return stream->backend->flush(stream->backend);
+}
+
+/****************************************************************************
+ * Name: lz4outstream_puts
+ ****************************************************************************/
+
+static int lz4outstream_puts(FAR struct lib_outstream_s *this,
+                             FAR const void *buf, int len)
+{
+  FAR struct lib_lz4outstream_s *stream =
+                                 (FAR struct lib_lz4outstream_s *)this;
+  FAR const char *ptr = buf;
+  size_t total = len;
+  size_t copyin;
+  int ret;
+
+  while (total > 0)
+    {
+      copyin = stream->offset + total > LZ4_STREAM_BLOCKSIZE ?
+               LZ4_STREAM_BLOCKSIZE - stream->offset : total;
+
+      memcpy(stream->in + stream->offset, ptr, copyin);
+
+      ptr            += copyin;
+      stream->offset += copyin;
+      this->nput     += copyin;
+      total          -= copyin;
+
+      if (stream->offset == LZ4_STREAM_BLOCKSIZE)
+        {
+          ret = lz4outstream_block(stream);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_lz4outstream
+ *
+ * Description:
+ *  LZ4 compressed pipeline stream
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_lz4outstream_s to be initialized.
+ *   backend - Stream backend port.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+void lib_lz4outstream(FAR struct lib_lz4outstream_s *stream,
+                      FAR struct lib_outstream_s *backend)
+{
+  if (stream == NULL || backend == NULL)
+    {
+      return;
+    }
+
+  memset(stream, 0, sizeof(*stream));
+  stream->public.puts  = lz4outstream_puts;
+  stream->public.flush = lz4outstream_flush;
+  stream->backend      = backend;
+}
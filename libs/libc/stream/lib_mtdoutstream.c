@@ -0,0 +1,261 @@
+/****************************************************************************
+ * libs/libc/stream/lib_mtdoutstream.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <unistd.h>
+#include <nuttx/streams.h>
+
+#include "libc.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_MTD)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mtdoutstream_write
+ *
+ * Description:
+ *   Write the first nblocks of the erase block eblock.  Unless the device
+ *   has been erased ahead of time, the erase block is erased first.
+ *
+ ****************************************************************************/
+
+static int mtdoutstream_write(FAR struct lib_mtdoutstream_s *stream,
+                              size_t eblock, size_t nblocks,
+                              FAR const void *buf)
+{
+  FAR struct mtd_dev_s *mtd = stream->inode->u.i_mtd;
+  size_t perblock = stream->geo.erasesize / stream->geo.blocksize;
+  ssize_t ret;
+
+  if (eblock >= stream->geo.neraseblocks)
+    {
+      return -ENOSPC;
+    }
+
+#ifndef CONFIG_STREAM_MTD_PREERASED
+  ret = MTD_ERASE(mtd, eblock, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
+  ret = MTD_BWRITE(mtd, eblock * perblock, nblocks, buf);
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Name: mtdoutstream_flush
+ ****************************************************************************/
+
+static int mtdoutstream_flush(FAR struct lib_outstream_s *this)
+{
+  FAR struct lib_mtdoutstream_s *stream =
+                                 (FAR struct lib_mtdoutstream_s *)this;
+  size_t blocksize = stream->geo.blocksize;
+  size_t erasesize = stream->geo.erasesize;
+  size_t offset = this->nput % erasesize;
+  size_t nblocks;
+
+  if (offset == 0)
+    {
+      return OK;
+    }
+
+  /* Fill the last write block in the erased state and write the part of
+   * the erase block that holds data.
+   */
+
+  nblocks = (offset + blocksize - 1) / blocksize;
+  memset(stream->cache + offset, 0xff, nblocks * blocksize - offset);
+
+  return mtdoutstream_write(stream, this->nput / erasesize, nblocks,
+                            stream->cache);
+}
+
+/****************************************************************************
+ * Name: mtdoutstream_puts
+ ****************************************************************************/
+
+static int mtdoutstream_puts(FAR struct lib_outstream_s *this,
+                             FAR const void *buf, int len)
+{
+  FAR struct lib_mtdoutstream_s *stream =
+                                 (FAR struct lib_mtdoutstream_s *)this;
+  size_t erasesize = stream->geo.erasesize;
+  size_t perblock = erasesize / stream->geo.blocksize;
+  FAR const unsigned char *ptr = buf;
+  size_t remain = len;
+  int ret;
+
+  while (remain > 0)
+    {
+      size_t eblock = this->nput / erasesize;
+      size_t offset = this->nput % erasesize;
+
+      if (offset == 0 && remain >= erasesize)
+        {
+          /* Write whole erase blocks straight from the caller's buffer */
+
+          ret = mtdoutstream_write(stream, eblock, perblock, ptr);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          ptr        += erasesize;
+          this->nput += erasesize;
+          remain     -= erasesize;
+        }
+      else
+        {
+          size_t copyin = offset + remain > erasesize ?
+                          erasesize - offset : remain;
+
+          memcpy(stream->cache + offset, ptr, copyin);
+
+          ptr        += copyin;
+          offset     += copyin;
+          this->nput += copyin;
+          remain     -= copyin;
+
+          if (offset == erasesize)
+            {
+              ret = mtdoutstream_write(stream, eblock, perblock,
+                                       stream->cache);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+            }
+        }
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_mtdoutstream_close
+ *
+ * Description:
+ *  close MTD driver stream backend
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_mtdoutstream_s to be initialized.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+void lib_mtdoutstream_close(FAR struct lib_mtdoutstream_s *stream)
+{
+  if (stream != NULL)
+    {
+      if (stream->inode != NULL)
+        {
+          close_mtddriver(stream->inode);
+          stream->inode = NULL;
+        }
+
+      if (stream->cache != NULL)
+        {
+          lib_free(stream->cache);
+          stream->cache = NULL;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: lib_mtdoutstream_open
+ *
+ * Description:
+ *  MTD driver stream backend
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_mtdoutstream_s to be initialized.
+ *   name    - The full path to the MTD driver to be opened.
+ *
+ * Returned Value:
+ *   Returns zero on success or a negated errno on failure
+ *
+ ****************************************************************************/
+
+int lib_mtdoutstream_open(FAR struct lib_mtdoutstream_s *stream,
+                          FAR const char *name)
+{
+  FAR struct inode *inode = NULL;
+  FAR struct mtd_dev_s *mtd;
+  int ret;
+
+  if (stream == NULL || name == NULL)
+    {
+      return -EINVAL;
+    }
+
+  ret = find_mtddriver(name, &inode);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  memset(stream, 0, sizeof(*stream));
+
+  mtd = inode->u.i_mtd;
+  if (mtd->bwrite == NULL ||
+      MTD_IOCTL(mtd, MTDIOC_GEOMETRY,
+                (unsigned long)((uintptr_t)&stream->geo)) < 0 ||
+      stream->geo.blocksize == 0 ||
+      stream->geo.erasesize < stream->geo.blocksize ||
+      stream->geo.neraseblocks == 0)
+    {
+      close_mtddriver(inode);
+      return -EINVAL;
+    }
+
+  stream->cache = lib_malloc(stream->geo.erasesize);
+  if (stream->cache == NULL)
+    {
+      close_mtddriver(inode);
+      return -ENOMEM;
+    }
+
+  stream->inode        = inode;
+  stream->public.puts  = mtdoutstream_puts;
+  stream->public.flush = mtdoutstream_flush;
+
+  return OK;
+}
+#endif
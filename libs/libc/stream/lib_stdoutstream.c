@@ -23,6 +23,7 @@
  ****************************************************************************/
 
 #include <fcntl.h>
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -50,7 +51,7 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 
   do
     {
-      result = fputc(ch, sthis->stream);
+      result = fputc_unlocked(ch, sthis->stream);
       if (result != EOF)
         {
           this->nput++;
@@ -64,6 +65,48 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *this, int ch)
   while (get_errno() == EINTR);
 }
 
+/****************************************************************************
+ * Name: stdoutstream_puts
+ ****************************************************************************/
+
+static int stdoutstream_puts(FAR struct lib_outstream_s *this,
+                             FAR const void *buf, int len)
+{
+  FAR struct lib_stdoutstream_s *sthis =
+                               (FAR struct lib_stdoutstream_s *)this;
+  int result;
+
+  DEBUGASSERT(this && sthis->stream);
+
+  /* Write the whole run with one lib_fwrite() instead of one fputc() per
+   * character.  Like fputc(), flush a line buffered stream if a newline
+   * was written.
+   */
+
+  do
+    {
+      result = lib_fwrite_unlocked(buf, len, sthis->stream);
+      if (result >= 0)
+        {
+          this->nput += result;
+          if ((sthis->stream->fs_flags & __FS_FLAG_LBF) != 0 &&
+              memchr(buf, '\n', result) != NULL)
+            {
+              lib_fflush(sthis->stream, true);
+            }
+
+          return result;
+        }
+
+      /* EINTR (meaning that the write was interrupted by a signal) is the
+       * only recoverable error.
+       */
+    }
+  while (get_errno() == EINTR);
+
+  return result;
+}
+
 /****************************************************************************
  * Name: stdoutstream_flush
  ****************************************************************************/
@@ -103,9 +146,12 @@ static int stdoutstream_flush(FAR struct lib_outstream_s *this)
 void lib_stdoutstream(FAR struct lib_stdoutstream_s *outstream,
                       FAR FILE *stream)
 {
-  /* Select the put operation */
+  /* Select the put operations.  These do not lock the stream, the user of
+   * the outstream (vfprintf()) holds the lock.
+   */
 
-  outstream->public.put = stdoutstream_putc;
+  outstream->public.put  = stdoutstream_putc;
+  outstream->public.puts = stdoutstream_puts;
 
   /* Select the correct flush operation.  This flush is only called when
    * a newline is encountered in the output stream.  However, we do not
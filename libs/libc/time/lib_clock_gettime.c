@@ -0,0 +1,123 @@
+/****************************************************************************
+ * libs/libc/time/lib_clock_gettime.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+#include <assert.h>
+#include <syscall.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+
+/* The kernel uses its own clock_gettime() and user space traps into it
+ * unless the kernel time is published to user space.
+ */
+
+#if defined(CONFIG_CLOCK_VDSO) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The copy of the kernel time, updated by the kernel on every tick */
+
+struct clock_vdso_s g_clock_vdso;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_gettime
+ *
+ * Description:
+ *   Get the time of CLOCK_REALTIME, CLOCK_MONOTONIC or CLOCK_BOOTTIME
+ *   without entering the kernel.  Other clocks are handled by the system
+ *   call.
+ *
+ ****************************************************************************/
+
+int clock_gettime(clockid_t clock_id, FAR struct timespec *tp)
+{
+  FAR struct clock_vdso_s *vdso = &g_clock_vdso;
+  uint64_t usecs;
+  uint64_t secs;
+  uint32_t seq;
+  clock_t ticks;
+  time_t sec;
+  long nsec;
+
+  if (clock_id != CLOCK_REALTIME && clock_id != CLOCK_MONOTONIC &&
+      clock_id != CLOCK_BOOTTIME)
+    {
+      return (int)sys_call2((unsigned int)SYS_clock_gettime,
+                            (uintptr_t)clock_id, (uintptr_t)tp);
+    }
+
+  DEBUGASSERT(tp != NULL);
+
+  /* Take a consistent sample: retry while the kernel is updating the data
+   * or if it was updated while we were reading it.
+   */
+
+  do
+    {
+      seq = vdso->seq;
+      SP_DMB();
+
+      ticks = vdso->ticks;
+      sec   = vdso->base_sec;
+      nsec  = vdso->base_nsec;
+
+      SP_DMB();
+    }
+  while ((seq & 1) != 0 || seq != vdso->seq);
+
+  /* Convert the system timer to the time since power-on */
+
+  usecs = (uint64_t)ticks * USEC_PER_TICK;
+  secs  = usecs / USEC_PER_SEC;
+
+  tp->tv_sec  = (time_t)secs;
+  tp->tv_nsec = (long)(usecs - secs * USEC_PER_SEC) * NSEC_PER_USEC;
+
+  /* Add the base time for the wall time */
+
+  if (clock_id == CLOCK_REALTIME)
+    {
+      tp->tv_sec  += sec;
+      tp->tv_nsec += nsec;
+      if (tp->tv_nsec >= NSEC_PER_SEC)
+        {
+          tp->tv_nsec -= NSEC_PER_SEC;
+          tp->tv_sec++;
+        }
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_CLOCK_VDSO && !__KERNEL__ */
@@ -50,6 +50,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -290,6 +291,9 @@ struct state_s
                     (2 * (MY_TZNAME_MAX + 1)))];
   struct lsinfo_s lsis[TZ_MAX_LEAPS];
   int defaulttype;            /* For early times or if no transitions */
+  int lastidx;                /* Transition found by the last lookup */
+  int isset;                  /* >0: tzname valid, <0: no TZ, 0: reload */
+  char tzname[MY_TZNAME_MAX + 1];
 };
 
 struct rule_s
@@ -319,10 +323,15 @@ static const time_t g_max_timet =
 
 static const char g_wildabbr[] = WILDABBR;
 
-static char g_lcl_tzname[MY_TZNAME_MAX + 1];
-static int g_lcl_isset;
+/* The local time zone is read without locking.  tzset() parses a new time
+ * zone into the spare state and then swaps it with the current one, so a
+ * reader is only disturbed if the time zone changes twice while it is
+ * preempted.
+ */
+
 static int g_gmt_isset;
 static FAR struct state_s *g_lcl_ptr;
+static FAR struct state_s *g_lcl_spare;
 static FAR struct state_s *g_gmt_ptr;
 static sem_t g_lcl_sem = SEM_INITIALIZER(1);
 static sem_t g_gmt_sem = SEM_INITIALIZER(1);
@@ -389,7 +398,7 @@ static int  normalize_overflow32(FAR int_fast32_t *tensptr,
               FAR int *unitsptr, int base);
 static int  normalize_overflow(FAR int *tensptr, FAR int *unitsptr,
               int base);
-static void settzname(void);
+static void settzname(FAR struct state_s *sp);
 static time_t time1(FAR struct tm *tmp,
               FAR struct tm *(*funcp)(FAR const time_t *, int_fast32_t,
                                       FAR struct tm *),
@@ -467,9 +476,8 @@ static int_fast64_t detzcode64(FAR const char *codep)
   return result;
 }
 
-static void settzname(void)
+static void settzname(FAR struct state_s *sp)
 {
-  FAR struct state_s *const sp = g_lcl_ptr;
   int i;
 
   tzname[0] = tzname[1] = (FAR char *)g_wildabbr;
@@ -1625,6 +1633,46 @@ static int tzparse(FAR const char *name, FAR struct state_s *sp,
   return 0;
 }
 
+/* Return the state that the next time zone will be parsed into */
+
+static FAR struct state_s *tz_spare(void)
+{
+  if (g_lcl_spare == NULL)
+    {
+      g_lcl_spare = lib_malloc(sizeof *g_lcl_spare);
+    }
+
+  return g_lcl_spare;
+}
+
+/* Make the spare state, now holding a new time zone, the current one */
+
+static void tz_publish(FAR struct state_s *sp)
+{
+  sp->lastidx = 0;
+  settzname(sp);
+
+  g_lcl_spare = g_lcl_ptr;
+  __atomic_store_n(&g_lcl_ptr, sp, __ATOMIC_RELEASE);
+}
+
+/* Check if the time zone named by TZ is the one already loaded */
+
+static bool tz_isloaded(FAR const struct state_s *sp, FAR const char *name)
+{
+  if (sp == NULL)
+    {
+      return false;
+    }
+
+  if (name == NULL)
+    {
+      return sp->isset < 0;
+    }
+
+  return sp->isset > 0 && strcmp(sp->tzname, name) == 0;
+}
+
 static void gmtload(FAR struct state_s *sp)
 {
   if (tzload(GMT, sp, TRUE) != 0)
@@ -1639,24 +1687,27 @@ static void gmtload(FAR struct state_s *sp)
 
 static void tzsetwall(void)
 {
-  if (g_lcl_isset < 0)
+  FAR struct state_s *sp;
+
+  if (g_lcl_ptr != NULL && g_lcl_ptr->isset < 0)
     {
       return;
     }
 
-  if (g_lcl_ptr == NULL)
+  sp = tz_spare();
+  if (sp == NULL)
     {
-      g_lcl_ptr = lib_malloc(sizeof *g_lcl_ptr);
+      settzname(g_lcl_ptr);
+      return;
     }
 
-  if (g_lcl_ptr != NULL && tzload(NULL, g_lcl_ptr, TRUE) != 0)
+  if (tzload(NULL, sp, TRUE) != 0)
     {
-      gmtload(g_lcl_ptr);
+      gmtload(sp);
     }
 
-  settzname();
-
-  g_lcl_isset = -1;
+  sp->isset = -1;
+  tz_publish(sp);
 }
 
 /* The easy way to behave "as if no library function calls" localtime
@@ -1676,7 +1727,7 @@ static FAR struct tm *localsub(FAR const time_t *timep,
   FAR struct tm *result;
   const time_t t = *timep;
 
-  sp = g_lcl_ptr;
+  sp = __atomic_load_n(&g_lcl_ptr, __ATOMIC_ACQUIRE);
   if (sp == NULL)
     {
       return gmtsub(timep, offset, tmp);
@@ -1746,21 +1797,32 @@ static FAR struct tm *localsub(FAR const time_t *timep,
     }
   else
     {
-      int lo = 1;
+      int lo = sp->lastidx;
       int hi = sp->timecnt;
 
-      while (lo < hi)
-        {
-          int mid = (lo + hi) >> 1;
+      /* Successive lookups are usually for close times: try the interval
+       * between the transitions found last time before searching.
+       */
 
-          if (t < sp->ats[mid])
-            {
-              hi = mid;
-            }
-          else
+      if (lo < 1 || lo > hi || t < sp->ats[lo - 1] ||
+          (lo < hi && t >= sp->ats[lo]))
+        {
+          lo = 1;
+          while (lo < hi)
             {
-              lo = mid + 1;
+              int mid = (lo + hi) >> 1;
+
+              if (t < sp->ats[mid])
+                {
+                  hi = mid;
+                }
+              else
+                {
+                  lo = mid + 1;
+                }
             }
+
+          sp->lastidx = lo;
         }
 
       i = (int)sp->types[lo - 1];
@@ -2505,6 +2567,7 @@ static time_t time1(FAR struct tm *tmp,
 
 void tzset(void)
 {
+  FAR struct state_s *sp;
   FAR const char *name;
 
 #ifndef __KERNEL__
@@ -2514,57 +2577,67 @@ void tzset(void)
     }
 #endif
 
-  tz_semtake(&g_lcl_sem);
+  /* Every localtime() calls tzset(), so the common case of an unchanged TZ
+   * is checked without taking the lock.
+   */
+
   name = getenv("TZ");
+  if (tz_isloaded(__atomic_load_n(&g_lcl_ptr, __ATOMIC_ACQUIRE), name))
+    {
+      return;
+    }
+
+  tz_semtake(&g_lcl_sem);
   if (name == NULL)
     {
       tzsetwall();
       goto out;
     }
 
-  if (g_lcl_isset > 0 && strcmp(g_lcl_tzname, name) == 0)
+  if (tz_isloaded(g_lcl_ptr, name))
     {
       goto out;
     }
 
-  if (g_lcl_ptr == NULL)
+  sp = tz_spare();
+  if (sp == NULL)
     {
-      g_lcl_ptr = lib_malloc(sizeof *g_lcl_ptr);
-      if (g_lcl_ptr == NULL)
-        {
-          goto tzname;
-        }
+      settzname(g_lcl_ptr);
+      goto out;
     }
 
   if (*name == '\0')
     {
       /* User wants it fast rather than right */
 
-      g_lcl_ptr->leapcnt = 0; /* so, we're off a little */
-      g_lcl_ptr->timecnt = 0;
-      g_lcl_ptr->typecnt = 0;
-      g_lcl_ptr->ttis[0].tt_isdst = 0;
-      g_lcl_ptr->ttis[0].tt_gmtoff = 0;
-      g_lcl_ptr->ttis[0].tt_abbrind = 0;
-      strcpy(g_lcl_ptr->chars, GMT);
+      sp->leapcnt = 0; /* so, we're off a little */
+      sp->timecnt = 0;
+      sp->typecnt = 0;
+      sp->charcnt = 0;
+      sp->goback = 0;
+      sp->goahead = 0;
+      sp->defaulttype = 0;
+      sp->ttis[0].tt_isdst = 0;
+      sp->ttis[0].tt_gmtoff = 0;
+      sp->ttis[0].tt_abbrind = 0;
+      strcpy(sp->chars, GMT);
     }
-  else if (tzload(name, g_lcl_ptr, TRUE) != 0)
+  else if (tzload(name, sp, TRUE) != 0)
     {
-      if (name[0] == ':' || tzparse(name, g_lcl_ptr, FALSE) != 0)
+      if (name[0] == ':' || tzparse(name, sp, FALSE) != 0)
         {
-          gmtload(g_lcl_ptr);
-          goto tzname;
+          gmtload(sp);
         }
     }
 
-  g_lcl_isset = strlen(name) < sizeof g_lcl_tzname;
-  if (g_lcl_isset)
+  sp->isset = strlen(name) < sizeof sp->tzname;
+  if (sp->isset)
     {
-      strcpy(g_lcl_tzname, name);
+      strcpy(sp->tzname, name);
     }
 
-tzname:
-  settzname();
+  tz_publish(sp);
+
 out:
   tz_semgive(&g_lcl_sem);
 }
@@ -26,6 +26,7 @@
 #include <sys/types.h>
 
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <debug.h>
 
@@ -82,6 +83,54 @@ static const char * const g_monthname[12] =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name:  strftime_dec
+ *
+ * Description:
+ *   Format a small decimal number like snprintf(dest, chleft, "%0*d") or,
+ *   if pad is a space, "%*d", without going through the stream logic.
+ *   Time stamps are made of little else.
+ *
+ ****************************************************************************/
+
+static int strftime_dec(FAR char *dest, int chleft, int value, int width,
+                        char pad)
+{
+  char digits[4];
+  int limit = 10;
+  int len;
+  int i;
+
+  for (i = 1; i < width; i++)
+    {
+      limit *= 10;
+    }
+
+  if (value < 0 || value >= limit || width > sizeof(digits))
+    {
+      return snprintf(dest, chleft, pad == '0' ? "%0*d" : "%*d",
+                      width, value);
+    }
+
+  for (i = width - 1; i >= 0; i--)
+    {
+      digits[i] = '0' + value % 10;
+      value /= 10;
+    }
+
+  for (i = 0; pad != '0' && i < width - 1 && digits[i] == '0'; i++)
+    {
+      digits[i] = pad;
+    }
+
+  /* Truncate as snprintf() would */
+
+  len = width < chleft ? width : chleft - 1;
+  memcpy(dest, digits, len);
+  dest[len] = '\0';
+  return width;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -107,6 +156,7 @@ static const char * const g_monthname[12] =
  *   %d     The day of the month as a decimal number (range 01 to 31).
  *   %e     Like %d, the day of the month as a decimal number, but a leading
  *          zero is replaced by a space.
+ *   %F     Equivalent to %Y-%m-%d (the ISO 8601 date format). (C99)
  *   %h     Equivalent to %b.  (SU)
  *   %H     The hour as a decimal number using a 24-hour clock
  *          (range 00 to 23).
@@ -120,6 +170,8 @@ static const char * const g_monthname[12] =
  *   %m     The month as a decimal number (range 01 to 12).
  *   %M     The minute as a decimal number (range 00 to 59).
  *   %n     A newline character. (SU)
+ *   %R     The time in 24-hour notation (%H:%M). (SU)
+ *   %T     The time in 24-hour notation (%H:%M:%S). (SU)
  *   %p     Either "AM" or "PM" according to the given time  value, or the
  *          corresponding  strings  for the current locale.  Noon is treated
  *          as "PM" and midnight as "AM".
@@ -227,7 +279,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'C':
              {
-               len = snprintf(dest, chleft, "%02d", tm->tm_year / 100);
+               len = strftime_dec(dest, chleft, tm->tm_year / 100, 2, '0');
              }
              break;
 
@@ -237,7 +289,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'd':
              {
-               len = snprintf(dest, chleft, "%02d", tm->tm_mday);
+               len = strftime_dec(dest, chleft, tm->tm_mday, 2, '0');
              }
              break;
 
@@ -247,7 +299,33 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'e':
              {
-               len = snprintf(dest, chleft, "%2d", tm->tm_mday);
+               len = strftime_dec(dest, chleft, tm->tm_mday, 2, ' ');
+             }
+             break;
+
+           /* %F: The ISO 8601 date, %Y-%m-%d.  %R and %T: the time
+            * as %H:%M and %H:%M:%S.  A truncated result ends the
+            * conversion.
+            */
+
+           case 'F':
+             {
+               len = strftime(dest, chleft, "%Y-%m-%d", tm);
+               len = len > 0 ? len : chleft;
+             }
+             break;
+
+           case 'R':
+             {
+               len = strftime(dest, chleft, "%H:%M", tm);
+               len = len > 0 ? len : chleft;
+             }
+             break;
+
+           case 'T':
+             {
+               len = strftime(dest, chleft, "%H:%M:%S", tm);
+               len = len > 0 ? len : chleft;
              }
              break;
 
@@ -257,7 +335,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'H':
              {
-               len = snprintf(dest, chleft, "%02d", tm->tm_hour);
+               len = strftime_dec(dest, chleft, tm->tm_hour, 2, '0');
              }
              break;
 
@@ -267,7 +345,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'I':
              {
-               len = snprintf(dest, chleft, "%02d", tm->tm_hour % 12);
+               len = strftime_dec(dest, chleft, tm->tm_hour % 12, 2, '0');
              }
              break;
 
@@ -281,7 +359,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
                  {
                    value = clock_daysbeforemonth(tm->tm_mon,
                            clock_isleapyear(tm->tm_year)) + tm->tm_mday;
-                   len   = snprintf(dest, chleft, "%03d", value);
+                   len   = strftime_dec(dest, chleft, value, 3, '0');
                  }
              }
              break;
@@ -293,7 +371,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'k':
              {
-               len = snprintf(dest, chleft, "%2d", tm->tm_hour);
+               len = strftime_dec(dest, chleft, tm->tm_hour, 2, ' ');
              }
              break;
 
@@ -304,7 +382,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'l':
              {
-               len = snprintf(dest, chleft, "%2d", tm->tm_hour % 12);
+               len = strftime_dec(dest, chleft, tm->tm_hour % 12, 2, ' ');
              }
              break;
 
@@ -312,7 +390,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'm':
              {
-               len = snprintf(dest, chleft, "%02d", tm->tm_mon + 1);
+               len = strftime_dec(dest, chleft, tm->tm_mon + 1, 2, '0');
              }
              break;
 
@@ -320,7 +398,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'M':
              {
-               len = snprintf(dest, chleft, "%02d", tm->tm_min);
+               len = strftime_dec(dest, chleft, tm->tm_min, 2, '0');
              }
              break;
 
@@ -385,7 +463,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'S':
              {
-               len = snprintf(dest, chleft, "%02d", tm->tm_sec);
+               len = strftime_dec(dest, chleft, tm->tm_sec, 2, '0');
              }
              break;
 
@@ -404,7 +482,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'y':
              {
-               len = snprintf(dest, chleft, "%02d", tm->tm_year % 100);
+               len = strftime_dec(dest, chleft, tm->tm_year % 100, 2, '0');
              }
              break;
 
@@ -412,7 +490,7 @@ size_t strftime(FAR char *s, size_t max, FAR const char *format,
 
            case 'Y':
              {
-               len = snprintf(dest, chleft, "%04d", tm->tm_year + 1900);
+               len = strftime_dec(dest, chleft, tm->tm_year + 1900, 4, '0');
              }
              break;
 
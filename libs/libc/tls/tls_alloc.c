@@ -78,14 +78,24 @@ int tls_alloc(CODE void (*dtor)(FAR void *))
 
   for (candidate = 0; candidate < CONFIG_TLS_NELEM; candidate++)
     {
+      FAR tls_ndxset_t *set = &info->ta_tlsset[TLS_NDXSET_WORD(candidate)];
+      tls_ndxset_t mask = TLS_NDXSET_MASK(candidate);
+
+      /* Skip the words of the set that are full */
+
+      if (mask == 1 && *set == (tls_ndxset_t)~0)
+        {
+          candidate += TLS_NDXSET_BITS - 1;
+          continue;
+        }
+
       /* Is this candidate index available? */
 
-      tls_ndxset_t mask = (tls_ndxset_t)1 << candidate;
-      if ((info->ta_tlsset & mask) == 0)
+      if ((*set & mask) == 0)
         {
           /* Yes.. allocate the index and break out of the loop */
 
-          info->ta_tlsset |= mask;
+          *set |= mask;
           info->ta_tlsdtor[candidate] = dtor;
           ret = candidate;
           break;
@@ -55,17 +55,17 @@ void tls_destruct(void)
   FAR struct tls_info_s *tls = up_tls_info();
   FAR void *tls_elem_ptr = NULL;
   tls_dtor_t destructor;
-  tls_ndxset_t tlsset;
   int candidate;
 
   DEBUGASSERT(info != NULL);
-  tlsset = info->ta_tlsset;
 
   for (candidate = 0; candidate < CONFIG_TLS_NELEM; candidate++)
     {
       /* Is this candidate index available? */
 
-      tls_ndxset_t mask = (tls_ndxset_t)1 << candidate;
+      tls_ndxset_t tlsset = info->ta_tlsset[TLS_NDXSET_WORD(candidate)];
+      tls_ndxset_t mask = TLS_NDXSET_MASK(candidate);
+
       if (tlsset & mask)
         {
           tls_elem_ptr = (FAR void *)tls->tl_elem[candidate];
@@ -69,13 +69,16 @@ int tls_free(int tlsindex)
        * modification of the group TLS index set.
        */
 
-      mask  = (1 << tlsindex);
+      mask  = TLS_NDXSET_MASK(tlsindex);
 
       ret = _SEM_WAIT(&info->ta_sem);
       if (ret == OK)
         {
-          DEBUGASSERT((info->ta_tlsset & mask) != 0);
-          info->ta_tlsset &= ~mask;
+          FAR tls_ndxset_t *set =
+            &info->ta_tlsset[TLS_NDXSET_WORD(tlsindex)];
+
+          DEBUGASSERT((*set & mask) != 0);
+          *set &= ~mask;
           _SEM_POST(&info->ta_sem);
         }
       else
@@ -56,7 +56,18 @@ struct userfs_info_s
   int16_t sockfd;             /* Server socket */
   uint16_t iolen;             /* Size of I/O buffer */
   uint16_t mxwrite;           /* The max size of a write data */
-  uint8_t iobuffer[1];        /* I/O buffer.  Actual size is iolen. */
+#ifdef CONFIG_FS_USERFS_SHM
+  uint16_t next;              /* Slot to look at first for a request */
+
+  /* The shared ring (NULL if using the socket) and the slot of the request
+   * being handled.
+   */
+
+  FAR struct userfs_ring_s *ring;
+  FAR struct userfs_slot_s *slot;
+#endif
+  FAR uint8_t *iobuffer;      /* The request being handled */
+  uint8_t buffer[1];          /* I/O buffer.  Actual size is iolen. */
 };
 
 #define SIZEOF_USERFS_INFO_S(n) (sizeof(struct userfs_info_s) + (n) - 1)
@@ -102,6 +113,185 @@ static inline uint16_t userfs_server_portno(void)
   return ret;
 }
 
+/****************************************************************************
+ * Name: userfs_recv
+ *
+ * Description:
+ *   Wait for the next request from the UserFS client.  On return,
+ *   info->iobuffer holds the request.
+ *
+ * Returned Value:
+ *   The size of the request or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t userfs_recv(FAR struct userfs_info_s *info)
+{
+  socklen_t addrlen;
+  ssize_t nread;
+
+#ifdef CONFIG_FS_USERFS_SHM
+  FAR struct userfs_ring_s *ring = info->ring;
+  int ret;
+  int i;
+
+  if (ring != NULL)
+    {
+      do
+        {
+          ret = _SEM_WAIT(&ring->reqsem);
+        }
+      while (ret < 0 && _SEM_ERRNO(ret) == EINTR);
+
+      if (ret < 0)
+        {
+          return _SEM_ERRVAL(ret);
+        }
+
+      /* Look for the request, starting after the last one handled so that
+       * no slot can be starved.
+       */
+
+      for (i = info->next; ; i = (i + 1) % ring->nslots)
+        {
+          if (ring->slot[i].state == USERFS_SLOT_REQUEST)
+            {
+              break;
+            }
+        }
+
+      info->next           = (i + 1) % ring->nslots;
+      info->slot           = &ring->slot[i];
+      info->slot->state    = USERFS_SLOT_SERVER;
+      info->iobuffer       = USERFS_RING_BUFFER(ring, i);
+      return info->slot->size;
+    }
+#endif
+
+  finfo("Receiving up %u bytes\n", info->iolen);
+  addrlen = sizeof(struct sockaddr_in);
+  nread   = recvfrom(info->sockfd, info->iobuffer, info->iolen, 0,
+                     (FAR struct sockaddr *)&info->client,
+                     &addrlen);
+  if (nread < 0)
+    {
+      return -get_errno();
+    }
+
+  DEBUGASSERT(addrlen == sizeof(struct sockaddr_in));
+  return nread;
+}
+
+/****************************************************************************
+ * Name: userfs_send
+ *
+ * Description:
+ *   Return the response to the current request to the UserFS client.  The
+ *   semantics are those of sendto().
+ *
+ ****************************************************************************/
+
+static ssize_t userfs_send(FAR struct userfs_info_s *info,
+                           FAR const void *buf, size_t len)
+{
+#ifdef CONFIG_FS_USERFS_SHM
+  FAR struct userfs_slot_s *slot = info->slot;
+
+  if (info->ring != NULL)
+    {
+      /* The response is returned in the buffer of the request */
+
+      DEBUGASSERT(slot != NULL && len <= info->ring->iolen);
+      if (buf != info->iobuffer)
+        {
+          memcpy(info->iobuffer, buf, len);
+        }
+
+      info->slot  = NULL;
+      slot->size  = len;
+      slot->state = USERFS_SLOT_RESPONSE;
+      _SEM_POST(&slot->respsem);
+      return len;
+    }
+#endif
+
+  return sendto(info->sockfd, buf, len, 0,
+                (FAR struct sockaddr *)&info->client,
+                sizeof(struct sockaddr_in));
+}
+
+#ifdef CONFIG_FS_USERFS_SHM
+/****************************************************************************
+ * Name: userfs_ring_alloc
+ *
+ * Description:
+ *   Allocate and initialize the shared memory ring.
+ *
+ ****************************************************************************/
+
+static FAR struct userfs_ring_s *userfs_ring_alloc(unsigned int iolen)
+{
+  FAR struct userfs_ring_s *ring;
+  int i;
+
+  ring = lib_zalloc(SIZEOF_USERFS_RING_S(CONFIG_FS_USERFS_NSLOTS, iolen));
+  if (ring != NULL)
+    {
+      ring->nslots = CONFIG_FS_USERFS_NSLOTS;
+      ring->iolen  = iolen;
+
+      /* These semaphores are used for signaling and, hence, should not
+       * have priority inheritance enabled.
+       */
+
+      _SEM_INIT(&ring->reqsem, 0, 0);
+      _SEM_SETPROTOCOL(&ring->reqsem, SEM_PRIO_NONE);
+      _SEM_INIT(&ring->freesem, 0, CONFIG_FS_USERFS_NSLOTS);
+      _SEM_SETPROTOCOL(&ring->freesem, SEM_PRIO_NONE);
+
+      for (i = 0; i < CONFIG_FS_USERFS_NSLOTS; i++)
+        {
+          ring->slot[i].state = USERFS_SLOT_FREE;
+          _SEM_INIT(&ring->slot[i].respsem, 0, 0);
+          _SEM_SETPROTOCOL(&ring->slot[i].respsem, SEM_PRIO_NONE);
+        }
+    }
+
+  return ring;
+}
+
+/****************************************************************************
+ * Name: userfs_ring_free
+ *
+ * Description:
+ *   Free the shared memory ring once the client is done with all slots.
+ *
+ ****************************************************************************/
+
+static void userfs_ring_free(FAR struct userfs_ring_s *ring, bool drain)
+{
+  int i;
+
+  /* After the file system is unbound, wait for the client to give back the
+   * slots that it may still hold.
+   */
+
+  for (i = 0; drain && i < ring->nslots; i++)
+    {
+      while (_SEM_WAIT(&ring->freesem) < 0);
+    }
+
+  _SEM_DESTROY(&ring->reqsem);
+  _SEM_DESTROY(&ring->freesem);
+  for (i = 0; i < ring->nslots; i++)
+    {
+      _SEM_DESTROY(&ring->slot[i].respsem);
+    }
+
+  lib_free(ring);
+}
+#endif
+
 /****************************************************************************
  * Name: userfs_*_dispatch
  ****************************************************************************/
@@ -147,10 +337,8 @@ static inline int userfs_open_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_OPEN;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_open_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_open_response_s));
   if (nsent < 0)
     {
       ret = -get_errno();
@@ -185,10 +373,8 @@ static inline int userfs_close_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_CLOSE;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_close_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_close_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -225,9 +411,7 @@ static inline int userfs_read_dispatch(FAR struct userfs_info_s *info,
 
   resp->resp  = USERFS_RESP_READ;
   resplen     = SIZEOF_USERFS_READ_RESPONSE_S(resp->nread);
-  nsent       = sendto(info->sockfd, resp, resplen, 0,
-                       (FAR struct sockaddr *)&info->client,
-                       sizeof(struct sockaddr_in));
+  nsent       = userfs_send(info, resp, resplen);
   return nsent < 0 ? nsent : OK;
 }
 
@@ -267,10 +451,8 @@ static inline int userfs_write_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp     = USERFS_RESP_WRITE;
-  nsent         = sendto(info->sockfd, &resp,
-                         sizeof(struct userfs_write_response_s),
-                         0, (FAR struct sockaddr *)&info->client,
-                         sizeof(struct sockaddr_in));
+  nsent         = userfs_send(info, &resp,
+                              sizeof(struct userfs_write_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -296,10 +478,8 @@ static inline int userfs_seek_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_SEEK;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_seek_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_seek_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -325,10 +505,8 @@ static inline int userfs_ioctl_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_IOCTL;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_ioctl_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_ioctl_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -353,10 +531,8 @@ static inline int userfs_sync_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_SYNC;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_sync_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_sync_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -382,10 +558,7 @@ static inline int userfs_dup_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_DUP;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_dup_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp, sizeof(struct userfs_dup_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -410,10 +583,8 @@ static inline int userfs_fstat_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_FSTAT;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_fstat_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_fstat_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -439,10 +610,8 @@ static inline int userfs_truncate_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_FSTAT;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_truncate_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_truncate_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -481,10 +650,8 @@ static inline int userfs_opendir_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_OPENDIR;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_opendir_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_opendir_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -509,10 +676,8 @@ static inline int userfs_closedir_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_CLOSEDIR;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_closedir_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_closedir_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -537,10 +702,8 @@ static inline int userfs_readdir_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_READDIR;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_readdir_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_readdir_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -565,10 +728,8 @@ static inline int userfs_rewinddir_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_REWINDDIR;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_rewinddir_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_rewinddir_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -593,10 +754,8 @@ static inline int userfs_statfs_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_STATFS;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_statfs_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_statfs_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -635,10 +794,8 @@ static inline int userfs_unlink_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_UNLINK;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_unlink_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_unlink_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -677,10 +834,8 @@ static inline int userfs_mkdir_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_MKDIR;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_mkdir_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_mkdir_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -719,10 +874,8 @@ static inline int userfs_rmdir_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_RMDIR;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_rmdir_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_rmdir_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -775,10 +928,8 @@ static inline int userfs_rename_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_RENAME;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_rename_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_rename_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -817,10 +968,8 @@ static inline int userfs_stat_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_STAT;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_stat_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_stat_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -845,10 +994,8 @@ static inline int userfs_destroy_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_DESTROY;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_destroy_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_destroy_response_s));
   if (nsent < 0)
     {
       int ret = -get_errno();
@@ -886,10 +1033,8 @@ static inline int userfs_fchstat_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_FCHSTAT;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_fchstat_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_fchstat_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -929,10 +1074,8 @@ static inline int userfs_chstat_dispatch(FAR struct userfs_info_s *info,
   /* Send the response */
 
   resp.resp = USERFS_RESP_CHSTAT;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_chstat_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  nsent     = userfs_send(info, &resp,
+                          sizeof(struct userfs_chstat_response_s));
   return nsent < 0 ? nsent : OK;
 }
 
@@ -960,6 +1103,9 @@ static inline int userfs_chstat_dispatch(FAR struct userfs_info_s *info,
  *   3. Returns file system responses generated by the callbacks to the
  *      LocalHost client socket.
  *
+ *   With CONFIG_FS_USERFS_SHM, the requests and responses are exchanged
+ *   through a ring of shared slots instead of the LocalHost socket.
+ *
  *   NOTE:  This is a user function that is implemented as part of the
  *   NuttX C library and is intended to be called by application logic.
  *
@@ -987,7 +1133,6 @@ int userfs_run(FAR const char *mountpt,
   FAR struct userfs_config_s config;
   struct sockaddr_in server;
   unsigned int iolen;
-  socklen_t addrlen;
   ssize_t nread;
   int ret;
 
@@ -1012,6 +1157,8 @@ int userfs_run(FAR const char *mountpt,
   info->volinfo   = volinfo;
   info->iolen     = iolen;
   info->mxwrite   = mxwrite;
+  info->iobuffer  = info->buffer;
+  info->sockfd    = -1;
 
   /* Create the UserFS configuration that will be provided as optional
    * data when the UserFS is mounted.
@@ -1020,6 +1167,15 @@ int userfs_run(FAR const char *mountpt,
   config.mxwrite  = mxwrite;
   config.portno   = userfs_server_portno();
 
+#ifdef CONFIG_FS_USERFS_SHM
+  /* Allocate the shared memory ring.  The socket is used instead if that
+   * fails.
+   */
+
+  info->ring      = userfs_ring_alloc(iolen);
+  config.ring     = info->ring;
+#endif
+
   /* Mounts the user file system at the provided mount point path. */
 
   ret = mount(NULL, mountpt, "userfs", 0, (FAR const void *)&config);
@@ -1027,9 +1183,16 @@ int userfs_run(FAR const char *mountpt,
     {
       ret = -get_errno();
       ferr("ERROR: mount() failed: %d\n", ret);
-      goto errout_with_info;
+      goto errout_with_ring;
     }
 
+#ifdef CONFIG_FS_USERFS_SHM
+  if (info->ring != NULL)
+    {
+      goto process_requests;
+    }
+#endif
+
   /* Create a new LocalHost UDP server socket */
 
   info->sockfd = socket(PF_INET, SOCK_DGRAM, 0);
@@ -1037,7 +1200,7 @@ int userfs_run(FAR const char *mountpt,
     {
       ret = -get_errno();
       ferr("ERROR: socket() failed: %d\n", ret);
-      goto errout_with_info;
+      goto errout_with_ring;
     }
 
   /* Bind the socket to a server port number */
@@ -1059,24 +1222,21 @@ int userfs_run(FAR const char *mountpt,
    * as the mount persists.
    */
 
+#ifdef CONFIG_FS_USERFS_SHM
+process_requests:
+#endif
   do
     {
       /* Receive the next file system request */
 
-      finfo("Receiving up %u bytes\n", info->iolen);
-      addrlen = sizeof(struct sockaddr_in);
-      nread   = recvfrom(info->sockfd, info->iobuffer, info->iolen, 0,
-                         (FAR struct sockaddr *)&info->client,
-                         &addrlen);
+      nread = userfs_recv(info);
       if (nread < 0)
         {
-          ret = -get_errno();
-          ferr("ERROR: recvfrom failed: %d\n", ret);
+          ret = (int)nread;
+          ferr("ERROR: userfs_recv failed: %d\n", ret);
           goto errout_with_sockfd;
         }
 
-      DEBUGASSERT(addrlen == sizeof(struct sockaddr_in));
-
       /* Process the request according to its request ID */
 
       DEBUGASSERT(nread >= sizeof(uint8_t));
@@ -1226,17 +1386,53 @@ int userfs_run(FAR const char *mountpt,
             ret = -EINVAL;
             break;
         }
+
+#ifdef CONFIG_FS_USERFS_SHM
+      /* A client waiting in the shared memory ring cannot time out: always
+       * complete the request, even if it could not be dispatched.
+       */
+
+      if (info->slot != NULL)
+        {
+          userfs_send(info, info->iobuffer, 0);
+        }
+#endif
     }
   while (ret == OK);
 
   /* Close the LocalHost socket */
 
 errout_with_sockfd:
-  close(info->sockfd);
+  if (info->sockfd >= 0)
+    {
+      close(info->sockfd);
+    }
+
+#ifdef CONFIG_FS_USERFS_SHM
+  /* The OS gives up the ring when the file system is unmounted.
+   *
+   * REVISIT: The ring is leaked if the server fails while still mounted.
+   */
+
+  if (info->ring != NULL && ret == -ENOTCONN)
+    {
+      userfs_ring_free(info->ring, true);
+    }
+#endif
 
   /* Free the IO Buffer */
 
-errout_with_info:
+  lib_free(info);
+  return ret;
+
+errout_with_ring:
+#ifdef CONFIG_FS_USERFS_SHM
+  if (info->ring != NULL)
+    {
+      userfs_ring_free(info->ring, false);
+    }
+#endif
+
   lib_free(info);
   return ret;
 }
@@ -211,8 +211,8 @@ void foc_init(FAR struct foc_data_f32_s *foc,
 
   /* Enable PI anti-windup protection */
 
-  pi_antiwindup_enable(&foc->iq_pid, 0.99, true);
-  pi_antiwindup_enable(&foc->id_pid, 0.99, true);
+  pi_antiwindup_enable(&foc->iq_pid, 0.99f, true);
+  pi_antiwindup_enable(&foc->id_pid, 0.99f, true);
 }
 
 /****************************************************************************
@@ -461,3 +461,76 @@ void foc_vdq_mag_max_get(FAR struct foc_data_f32_s *foc, FAR float *max)
 
   *max = foc->vdq_mag_max;
 }
+
+/****************************************************************************
+ * Name: foc_process_n
+ *
+ * Description:
+ *   Run one step of the FOC current loop for a set of motor controllers.
+ *   For each axis this is equivalent to calling foc_angle_update(),
+ *   foc_iabc_update(), foc_current_control(),
+ *   foc_voltage_control() and foc_vabmod_get() in sequence,
+ *   but the whole pipeline is done in a single pass over each FOC
+ *   instance, while its data is still hot in the cache.
+ *
+ * Input Parameters:
+ *   foc      - (in/out) pointer to the array of FOC data
+ *   angle    - (in) pointer to the array of phase angles
+ *   i_abc    - (in) pointer to the array of ABC current frames
+ *   idq_ref  - (in) pointer to the array of current dq references
+ *   vdq_comp - (in) pointer to the array of voltage dq compensations,
+ *              may be NULL if no compensation is used
+ *   v_ab_mod - (out) pointer to the array of voltage alpha-beta
+ *              modulation frames
+ *   n        - (in) number of the FOC instances
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_process_n(FAR struct foc_data_f32_s *foc,
+                   FAR phase_angle_f32_t *angle,
+                   FAR abc_frame_f32_t *i_abc,
+                   FAR dq_frame_f32_t *idq_ref,
+                   FAR dq_frame_f32_t *vdq_comp,
+                   FAR ab_frame_f32_t *v_ab_mod, int n)
+{
+  FAR struct foc_data_f32_s *f;
+  dq_frame_f32_t vdq_ref;
+  int i;
+
+  LIBDSP_DEBUGASSERT(foc != NULL);
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(i_abc != NULL);
+  LIBDSP_DEBUGASSERT(idq_ref != NULL);
+  LIBDSP_DEBUGASSERT(v_ab_mod != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      f = &foc[i];
+
+      /* Current feedback (current abc -> current dq) */
+
+      foc_angle_update(f, &angle[i]);
+      foc_iabc_update(f, &i_abc[i]);
+
+      /* Current controller (current dq -> voltage dq) */
+
+      foc_idq_ref_set(f, &idq_ref[i]);
+      foc_current_controller(f, &vdq_ref);
+
+      if (vdq_comp != NULL)
+        {
+          vdq_ref.d -= vdq_comp[i].d;
+          vdq_ref.q -= vdq_comp[i].q;
+        }
+
+      /* Voltage controller (voltage dq -> modulation alpha-beta) */
+
+      foc_voltage_control(f, &vdq_ref);
+
+      v_ab_mod[i].a = f->v_ab_mod.a;
+      v_ab_mod[i].b = f->v_ab_mod.b;
+    }
+}
@@ -462,3 +462,76 @@ void foc_vdq_mag_max_get_b16(FAR struct foc_data_b16_s *foc, FAR b16_t *max)
 
   *max = foc->vdq_mag_max;
 }
+
+/****************************************************************************
+ * Name: foc_process_n_b16
+ *
+ * Description:
+ *   Run one step of the FOC current loop for a set of motor controllers.
+ *   For each axis this is equivalent to calling foc_angle_update_b16(),
+ *   foc_iabc_update_b16(), foc_current_control_b16(),
+ *   foc_voltage_control_b16() and foc_vabmod_get_b16() in sequence,
+ *   but the whole pipeline is done in a single pass over each FOC
+ *   instance, while its data is still hot in the cache.
+ *
+ * Input Parameters:
+ *   foc      - (in/out) pointer to the array of FOC data
+ *   angle    - (in) pointer to the array of phase angles
+ *   i_abc    - (in) pointer to the array of ABC current frames
+ *   idq_ref  - (in) pointer to the array of current dq references
+ *   vdq_comp - (in) pointer to the array of voltage dq compensations,
+ *              may be NULL if no compensation is used
+ *   v_ab_mod - (out) pointer to the array of voltage alpha-beta
+ *              modulation frames
+ *   n        - (in) number of the FOC instances
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void foc_process_n_b16(FAR struct foc_data_b16_s *foc,
+                       FAR phase_angle_b16_t *angle,
+                       FAR abc_frame_b16_t *i_abc,
+                       FAR dq_frame_b16_t *idq_ref,
+                       FAR dq_frame_b16_t *vdq_comp,
+                       FAR ab_frame_b16_t *v_ab_mod, int n)
+{
+  FAR struct foc_data_b16_s *f;
+  dq_frame_b16_t vdq_ref;
+  int i;
+
+  LIBDSP_DEBUGASSERT(foc != NULL);
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(i_abc != NULL);
+  LIBDSP_DEBUGASSERT(idq_ref != NULL);
+  LIBDSP_DEBUGASSERT(v_ab_mod != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      f = &foc[i];
+
+      /* Current feedback (current abc -> current dq) */
+
+      foc_angle_update_b16(f, &angle[i]);
+      foc_iabc_update_b16(f, &i_abc[i]);
+
+      /* Current controller (current dq -> voltage dq) */
+
+      foc_idq_ref_set_b16(f, &idq_ref[i]);
+      foc_current_controller_b16(f, &vdq_ref);
+
+      if (vdq_comp != NULL)
+        {
+          vdq_ref.d -= vdq_comp[i].d;
+          vdq_ref.q -= vdq_comp[i].q;
+        }
+
+      /* Voltage controller (voltage dq -> modulation alpha-beta) */
+
+      foc_voltage_control_b16(f, &vdq_ref);
+
+      v_ab_mod[i].a = f->v_ab_mod.a;
+      v_ab_mod[i].b = f->v_ab_mod.b;
+    }
+}
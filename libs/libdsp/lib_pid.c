@@ -61,7 +61,7 @@ void pid_controller_init(FAR pid_controller_f32_t *pid, float KP, float KI,
   pid->KP = KP;
   pid->KI = KI;
   pid->KD = KD;
-  pid->KC = 0.0;
+  pid->KC = 0.0f;
 }
 
 /****************************************************************************
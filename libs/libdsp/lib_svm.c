@@ -78,15 +78,15 @@ static uint8_t svm3_sector_get(FAR abc_frame_f32_t *ijk)
    *              k <=  0.0
    */
 
-  if (k <= 0.0)
+  if (k <= 0.0f)
     {
-      if (i <= 0.0)
+      if (i <= 0.0f)
         {
           sector = 2;
         }
       else
         {
-          if (j <= 0.0)
+          if (j <= 0.0f)
             {
               sector = 6;
             }
@@ -98,9 +98,9 @@ static uint8_t svm3_sector_get(FAR abc_frame_f32_t *ijk)
     }
   else
     {
-      if (i <= 0.0)
+      if (i <= 0.0f)
         {
-          if (j <= 0.0)
+          if (j <= 0.0f)
             {
               sector = 4;
             }
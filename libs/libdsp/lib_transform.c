@@ -147,3 +147,107 @@ void inv_park_transform(FAR phase_angle_f32_t *angle,
   ab->a = angle->cos * dq->d - angle->sin * dq->q;
   ab->b = angle->cos * dq->q + angle->sin * dq->d;
 }
+
+/****************************************************************************
+ * Name: clarke_transform_n
+ *
+ * Description:
+ *   Clarke transform for a set of independent channels (e.g. several
+ *   motors driven from one control loop).  The loop body carries no
+ *   dependency between iterations, so the compiler is free to vectorize
+ *   it on cores with SIMD support (e.g. Helium on Armv8.1-M).
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the array of abc frames
+ *   ab  - (out) pointer to the array of alpha-beta frames
+ *   n   - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_n(FAR abc_frame_f32_t *abc,
+                        FAR ab_frame_f32_t *ab, int n)
+{
+  int i;
+
+  LIBDSP_DEBUGASSERT(abc != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      ab[i].a = abc[i].a;
+      ab[i].b = ONE_BY_SQRT3_F*abc[i].a + TWO_BY_SQRT3_F*abc[i].b;
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_n
+ *
+ * Description:
+ *   Park transform for a set of independent channels, each one with its
+ *   own phase angle.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the array of phase angles
+ *   ab    - (in) pointer to the array of alpha-beta frames
+ *   dq    - (out) pointer to the array of direct-quadrature frames
+ *   n     - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_n(FAR phase_angle_f32_t *angle,
+                      FAR ab_frame_f32_t *ab,
+                      FAR dq_frame_f32_t *dq, int n)
+{
+  int i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      dq[i].d = angle[i].cos * ab[i].a + angle[i].sin * ab[i].b;
+      dq[i].q = angle[i].cos * ab[i].b - angle[i].sin * ab[i].a;
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_n
+ *
+ * Description:
+ *   Inverse Park transform for a set of independent channels, each one
+ *   with its own phase angle.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the array of phase angles
+ *   dq    - (in) pointer to the array of direct-quadrature frames
+ *   ab    - (out) pointer to the array of alpha-beta frames
+ *   n     - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_n(FAR phase_angle_f32_t *angle,
+                          FAR dq_frame_f32_t *dq,
+                          FAR ab_frame_f32_t *ab, int n)
+{
+  int i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      ab[i].a = angle[i].cos * dq[i].d - angle[i].sin * dq[i].q;
+      ab[i].b = angle[i].cos * dq[i].q + angle[i].sin * dq[i].d;
+    }
+}
@@ -149,3 +149,110 @@ void inv_park_transform_b16(FAR phase_angle_b16_t *angle,
   ab->a = b16mulb16(angle->cos, dq->d) - b16mulb16(angle->sin, dq->q);
   ab->b = b16mulb16(angle->cos, dq->q) + b16mulb16(angle->sin, dq->d);
 }
+
+/****************************************************************************
+ * Name: clarke_transform_n_b16
+ *
+ * Description:
+ *   Clarke transform for a set of independent channels (e.g. several
+ *   motors driven from one control loop).
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the array of abc frames
+ *   ab  - (out) pointer to the array of alpha-beta frames
+ *   n   - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_n_b16(FAR abc_frame_b16_t *abc,
+                            FAR ab_frame_b16_t *ab, int n)
+{
+  int i;
+
+  LIBDSP_DEBUGASSERT(abc != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      ab[i].a = abc[i].a;
+      ab[i].b = (b16mulb16(ONE_BY_SQRT3_B16, abc[i].a) +
+                 b16mulb16(TWO_BY_SQRT3_B16, abc[i].b));
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_n_b16
+ *
+ * Description:
+ *   Park transform for a set of independent channels, each one with its
+ *   own phase angle.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the array of phase angles
+ *   ab    - (in) pointer to the array of alpha-beta frames
+ *   dq    - (out) pointer to the array of direct-quadrature frames
+ *   n     - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_n_b16(FAR phase_angle_b16_t *angle,
+                          FAR ab_frame_b16_t *ab,
+                          FAR dq_frame_b16_t *dq, int n)
+{
+  int i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      dq[i].d = (b16mulb16(angle[i].cos, ab[i].a) +
+                 b16mulb16(angle[i].sin, ab[i].b));
+      dq[i].q = (b16mulb16(angle[i].cos, ab[i].b) -
+                 b16mulb16(angle[i].sin, ab[i].a));
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_n_b16
+ *
+ * Description:
+ *   Inverse Park transform for a set of independent channels, each one
+ *   with its own phase angle.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the array of phase angles
+ *   dq    - (in) pointer to the array of direct-quadrature frames
+ *   ab    - (out) pointer to the array of alpha-beta frames
+ *   n     - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_n_b16(FAR phase_angle_b16_t *angle,
+                              FAR dq_frame_b16_t *dq,
+                              FAR ab_frame_b16_t *ab, int n)
+{
+  int i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      ab[i].a = (b16mulb16(angle[i].cos, dq[i].d) -
+                 b16mulb16(angle[i].sin, dq[i].q));
+      ab[i].b = (b16mulb16(angle[i].cos, dq[i].q) +
+                 b16mulb16(angle[i].sin, dq[i].d));
+    }
+}
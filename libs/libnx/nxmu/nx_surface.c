@@ -0,0 +1,133 @@
+/****************************************************************************
+ * libs/libnx/nxmu/nx_surface.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <mqueue.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/nx/nxglib.h>
+#include <nuttx/nx/nx.h>
+#include <nuttx/nx/nxbe.h>
+#include <nuttx/nx/nxmu.h>
+
+#ifdef CONFIG_NX_RAMBACKED
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nx_getsurface
+ *
+ * Description:
+ *   Get the per-window framebuffer of a RAM backed window so that the
+ *   client can render into it directly, instead of sending each drawing
+ *   operation to the server.  Changes become visible only after they are
+ *   reported with nx_update().
+ *
+ * Input Parameters:
+ *   hwnd   - The RAM backed window
+ *   fbmem  - Location to return the address of the framebuffer
+ *   stride - Location to return the width of one row in bytes
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nx_getsurface(NXWINDOW hwnd, FAR FAR void **fbmem,
+                  FAR nxgl_coord_t *stride)
+{
+  FAR struct nxbe_window_s *wnd = (FAR struct nxbe_window_s *)hwnd;
+
+#ifdef CONFIG_DEBUG_FEATURES
+  if (!wnd || !fbmem || !stride)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+#endif
+
+#ifdef CONFIG_BUILD_KERNEL
+  /* The framebuffer lives in the kernel address space */
+
+  set_errno(ENOSYS);
+  return ERROR;
+#else
+  if (!NXBE_ISRAMBACKED(wnd) || wnd->fbmem == NULL)
+    {
+      set_errno(ENOTSUP);
+      return ERROR;
+    }
+
+  *fbmem  = (FAR void *)wnd->fbmem;
+  *stride = wnd->stride;
+  return OK;
+#endif
+}
+
+/****************************************************************************
+ * Name: nx_update
+ *
+ * Description:
+ *   Report that a region of the per-window framebuffer was modified by the
+ *   the client.  The server copies the visible part of the region to the
+ *   display.  No pixel data is sent with the request.
+ *
+ * Input Parameters:
+ *   hwnd - The RAM backed window
+ *   rect - The modified region (window relative)
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nx_update(NXWINDOW hwnd, FAR const struct nxgl_rect_s *rect)
+{
+  FAR struct nxbe_window_s *wnd = (FAR struct nxbe_window_s *)hwnd;
+  struct nxsvrmsg_update_s outmsg;
+
+#ifdef CONFIG_DEBUG_FEATURES
+  if (!wnd || !rect)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+#endif
+
+  /* Format the update notification */
+
+  outmsg.msgid = NX_SVRMSG_UPDATE;
+  outmsg.wnd   = wnd;
+  nxgl_rectcopy(&outmsg.rect, rect);
+
+  /* Forward the notification to the server */
+
+  return nxmu_sendwindow(wnd, &outmsg, sizeof(struct nxsvrmsg_update_s));
+}
+
+#endif /* CONFIG_NX_RAMBACKED */
@@ -21,8 +21,15 @@
 /* Note about locking: There is no locking required while only one reader
  * and one writer is using the circular buffer.
  * For multiple writer and one reader there is only a need to lock the
- * writer. And vice versa for only one writer and multiple reader there is
- * only a need to lock the reader.
+ * writer, or to use circbuf_mpsc_write() for all of the writes. And vice
+ * versa for only one writer and multiple reader there is only a need to
+ * lock the reader.
+ *
+ * The writer publishes the head with release semantics after the data is
+ * in the buffer, and the reader publishes the tail the same way after the
+ * data has been taken out.  Each side loads the index of the other with
+ * acquire semantics, so neither can see an index before the data it
+ * covers, not even on another CPU.
  */
 
 /****************************************************************************
@@ -33,6 +40,7 @@
 
 #include <assert.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mm/circbuf.h>
 
@@ -40,6 +48,31 @@
  * Private Types
  ****************************************************************************/
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: circbuf_publish_head, circbuf_publish_tail
+ *
+ * Description:
+ *   Make the data written, or the space freed, visible to the other side.
+ *
+ ****************************************************************************/
+
+static inline void circbuf_publish_head(FAR struct circbuf_s *circ,
+                                        size_t head)
+{
+  circ->reserve = head;
+  __atomic_store_n(&circ->head, head, __ATOMIC_RELEASE);
+}
+
+static inline void circbuf_publish_tail(FAR struct circbuf_s *circ,
+                                        size_t tail)
+{
+  __atomic_store_n(&circ->tail, tail, __ATOMIC_RELEASE);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -79,10 +112,11 @@ int circbuf_init(FAR struct circbuf_s *circ, FAR void *base, size_t bytes)
         }
     }
 
-  circ->base = base;
-  circ->size = bytes;
-  circ->head = 0;
-  circ->tail = 0;
+  circ->base    = base;
+  circ->size    = bytes;
+  circ->head    = 0;
+  circ->tail    = 0;
+  circ->reserve = 0;
 
   return 0;
 }
@@ -134,10 +168,11 @@ int circbuf_resize(FAR struct circbuf_s *circ, size_t bytes)
 
   kmm_free(circ->base);
 
-  circ->base = tmp;
-  circ->size = bytes;
-  circ->head = len;
-  circ->tail = 0;
+  circ->base    = tmp;
+  circ->size    = bytes;
+  circ->head    = len;
+  circ->tail    = 0;
+  circ->reserve = len;
 
   return 0;
 }
@@ -155,7 +190,7 @@ int circbuf_resize(FAR struct circbuf_s *circ, size_t bytes)
 void circbuf_reset(FAR struct circbuf_s *circ)
 {
   DEBUGASSERT(circ);
-  circ->head = circ->tail = 0;
+  circ->head = circ->tail = circ->reserve = 0;
 }
 
 /****************************************************************************
@@ -209,7 +244,8 @@ size_t circbuf_size(FAR struct circbuf_s *circ)
 size_t circbuf_used(FAR struct circbuf_s *circ)
 {
   DEBUGASSERT(circ);
-  return circ->head - circ->tail;
+  return __atomic_load_n(&circ->head, __ATOMIC_ACQUIRE) -
+         __atomic_load_n(&circ->tail, __ATOMIC_ACQUIRE);
 }
 
 /****************************************************************************
@@ -337,7 +373,7 @@ ssize_t circbuf_read(FAR struct circbuf_s *circ,
   DEBUGASSERT(dst || !bytes);
 
   bytes = circbuf_peek(circ, dst, bytes);
-  circ->tail += bytes;
+  circbuf_publish_tail(circ, circ->tail + bytes);
 
   return bytes;
 }
@@ -374,7 +410,7 @@ ssize_t circbuf_skip(FAR struct circbuf_s *circ, size_t bytes)
       bytes = len;
     }
 
-  circ->tail += bytes;
+  circbuf_publish_tail(circ, circ->tail + bytes);
 
   return bytes;
 }
@@ -428,11 +464,232 @@ ssize_t circbuf_write(FAR struct circbuf_s *circ,
 
   memcpy(circ->base + off, src, space);
   memcpy(circ->base, src + space, bytes - space);
-  circ->head += bytes;
+  circbuf_publish_head(circ, circ->head + bytes);
+
+  return bytes;
+}
+
+/****************************************************************************
+ * Name: circbuf_mpsc_write
+ *
+ * Description:
+ *   Write data to the circular buffer, from any number of concurrent
+ *   writers and without a lock.
+ *
+ *   Each writer reserves its bytes by moving the reserve index with an
+ *   atomic compare and swap, copies its data with no lock held, then
+ *   publishes the head in the order of the reservations.  Local interrupts
+ *   are disabled from the reservation to the publication so that a writer
+ *   is never preempted by another one on the same CPU, which would then
+ *   wait forever for the head to reach its reservation.  Only writers on
+ *   other CPUs can make it wait, and only for the time of a copy.
+ *
+ * Note:
+ *   All of the writers of a buffer must use this function; the reader
+ *   may use any of the read functions.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   src   - The data to be added.
+ *   bytes - Number of bytes to be added.
+ *
+ * Returned Value:
+ *   The bytes of get data is returned if the write data is successful;
+ *   A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t circbuf_mpsc_write(FAR struct circbuf_s *circ,
+                           FAR const void *src, size_t bytes)
+{
+  irqstate_t flags;
+  size_t start;
+  size_t space;
+  size_t off;
+
+  DEBUGASSERT(circ);
+  DEBUGASSERT(src || !bytes);
+
+  if (!circ->size)
+    {
+      return 0;
+    }
+
+  flags = up_irq_save();
+
+  /* Reserve the bytes, as many as fit */
+
+  start = __atomic_load_n(&circ->reserve, __ATOMIC_RELAXED);
+  do
+    {
+      space = circ->size -
+              (start - __atomic_load_n(&circ->tail, __ATOMIC_ACQUIRE));
+      if (bytes > space)
+        {
+          bytes = space;
+        }
+
+      if (bytes == 0)
+        {
+          up_irq_restore(flags);
+          return 0;
+        }
+    }
+  while (!__atomic_compare_exchange_n(&circ->reserve, &start,
+                                      start + bytes, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+  off   = start % circ->size;
+  space = circ->size - off;
+  if (bytes < space)
+    {
+      space = bytes;
+    }
+
+  memcpy(circ->base + off, src, space);
+  memcpy(circ->base, src + space, bytes - space);
+
+  /* Wait for the writers that reserved before us, then publish */
 
+  while (__atomic_load_n(&circ->head, __ATOMIC_RELAXED) != start)
+    {
+    }
+
+  __atomic_store_n(&circ->head, start + bytes, __ATOMIC_RELEASE);
+
+  up_irq_restore(flags);
   return bytes;
 }
 
+/****************************************************************************
+ * Name: circbuf_get_writeptr
+ *
+ * Description:
+ *   Get the contiguous free space at the head of the circular buffer, so
+ *   that the writer can fill it in place, e.g. by DMA, and then commit it
+ *   with circbuf_writecommit().
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   size  - Returns the number of contiguous free bytes.  It may be less
+ *           than circbuf_space() when the free space wraps around.
+ *
+ * Returned Value:
+ *   The address of the free space.
+ *
+ ****************************************************************************/
+
+FAR void *circbuf_get_writeptr(FAR struct circbuf_s *circ,
+                               FAR size_t *size)
+{
+  size_t space;
+  size_t off;
+
+  DEBUGASSERT(circ);
+  DEBUGASSERT(size);
+
+  if (!circ->size)
+    {
+      *size = 0;
+      return circ->base;
+    }
+
+  space = circbuf_space(circ);
+  off   = circ->head % circ->size;
+  *size = circ->size - off < space ? circ->size - off : space;
+
+  return circ->base + off;
+}
+
+/****************************************************************************
+ * Name: circbuf_writecommit
+ *
+ * Description:
+ *   Commit the bytes written to the space returned by
+ *   circbuf_get_writeptr(), making them visible to the reader.
+ *
+ * Input Parameters:
+ *   circ        - Address of the circular buffer to be used.
+ *   writtensize - The number of bytes written.
+ *
+ ****************************************************************************/
+
+void circbuf_writecommit(FAR struct circbuf_s *circ, size_t writtensize)
+{
+  DEBUGASSERT(circ);
+  DEBUGASSERT(writtensize <= circbuf_space(circ));
+
+  circbuf_publish_head(circ, circ->head + writtensize);
+}
+
+/****************************************************************************
+ * Name: circbuf_get_readptr
+ *
+ * Description:
+ *   Get the contiguous data at the tail of the circular buffer, so that
+ *   the reader can use it in place and then release it with
+ *   circbuf_readcommit().
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   size  - Returns the number of contiguous bytes.  It may be less than
+ *           circbuf_used() when the data wraps around.
+ *
+ * Returned Value:
+ *   The address of the data.
+ *
+ ****************************************************************************/
+
+FAR void *circbuf_get_readptr(FAR struct circbuf_s *circ, FAR size_t *size)
+{
+  size_t used;
+  size_t off;
+
+  DEBUGASSERT(circ);
+  DEBUGASSERT(size);
+
+  if (!circ->size)
+    {
+      *size = 0;
+      return circ->base;
+    }
+
+  used  = circbuf_used(circ);
+  off   = circ->tail % circ->size;
+  *size = circ->size - off < used ? circ->size - off : used;
+
+  return circ->base + off;
+}
+
+/****************************************************************************
+ * Name: circbuf_readcommit
+ *
+ * Description:
+ *   Release the bytes consumed from the data returned by
+ *   circbuf_get_readptr(), making the space available to the writer.
+ *
+ * Input Parameters:
+ *   circ     - Address of the circular buffer to be used.
+ *   readsize - The number of bytes consumed.
+ *
+ ****************************************************************************/
+
+void circbuf_readcommit(FAR struct circbuf_s *circ, size_t readsize)
+{
+  DEBUGASSERT(circ);
+  DEBUGASSERT(readsize <= circbuf_used(circ));
+
+  circbuf_publish_tail(circ, circ->tail + readsize);
+}
+
 /****************************************************************************
  * Name: circbuf_overwrite
  *
@@ -491,8 +748,8 @@ ssize_t circbuf_overwrite(FAR struct circbuf_s *circ,
 
   memcpy(circ->base + off, src, space);
   memcpy(circ->base, src + space, bytes - space);
-  circ->head += bytes;
-  circ->tail += overwrite;
+  circbuf_publish_tail(circ, circ->tail + overwrite);
+  circbuf_publish_head(circ, circ->head + bytes);
 
   return overwrite;
 }
@@ -70,6 +70,16 @@ extern FAR struct iob_qentry_s *g_iob_freeqlist;
 extern FAR struct iob_qentry_s *g_iob_qcommitted;
 #endif
 
+#ifdef IOB_HAVE_CLASSES
+/* The free lists of the small and large classes together with the number
+ * of buffers on each.  The entries of IOB_CLASS_DEFAULT are not used: that
+ * class is managed through g_iob_freelist and g_iob_sem.
+ */
+
+extern FAR struct iob_s *g_iob_classlist[IOB_NCLASSES];
+extern int g_iob_classavail[IOB_NCLASSES];
+#endif
+
 /* Counting semaphores that tracks the number of free IOBs/qentries */
 
 extern sem_t g_iob_sem;       /* Counts free I/O buffers */
@@ -119,6 +129,67 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void);
 
 FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 
+/****************************************************************************
+ * Name: iob_release
+ *
+ * Description:
+ *   Return a single I/O buffer to the free list or, if a thread is waiting
+ *   for one, to the committed list.  The caller must be in a critical
+ *   section.  This function is intended only for internal use by the IOB
+ *   module.
+ *
+ ****************************************************************************/
+
+void iob_release(FAR struct iob_s *iob);
+
+#ifdef IOB_HAVE_CLASSES
+/****************************************************************************
+ * Name: iob_class_release
+ *
+ * Description:
+ *   Return a single I/O buffer of the small or large class to the free
+ *   list of its class.  The caller must be in a critical section.  This
+ *   function is intended only for internal use by the IOB module.
+ *
+ ****************************************************************************/
+
+void iob_class_release(FAR struct iob_s *iob);
+#endif
+
+#ifdef CONFIG_IOB_CPU_CACHE
+/****************************************************************************
+ * Name: iob_cache_alloc
+ *
+ * Description:
+ *   Try to take an I/O buffer from the cache of the current CPU.  Returns
+ *   NULL if the caller must allocate from the shared pool.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_alloc(void);
+
+/****************************************************************************
+ * Name: iob_cache_free
+ *
+ * Description:
+ *   Try to put a free I/O buffer into the cache of the current CPU.
+ *   Returns false if the caller must return it to the shared pool.
+ *
+ ****************************************************************************/
+
+bool iob_cache_free(FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: iob_cache_navail
+ *
+ * Description:
+ *   Return the number of I/O buffers held by the caches of all CPUs.
+ *
+ ****************************************************************************/
+
+int iob_cache_navail(void);
+#endif
+
 /****************************************************************************
  * Name: iob_notifier_signal
  *
@@ -250,6 +250,30 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
   FAR sem_t *sem;
 #endif
 
+#ifdef CONFIG_IOB_CPU_CACHE
+  /* Try the cache of this CPU first.  It is only used while the shared
+   * pool is well above the throttle, so the throttled and unthrottled
+   * allocations need not be told apart here.
+   */
+
+  iob = iob_cache_alloc();
+  if (iob != NULL)
+    {
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      flags = enter_critical_section();
+      iob_stats_onalloc(consumerid);
+      leave_critical_section(flags);
+#endif
+
+      iob->io_flink  = NULL;
+      iob->io_len    = 0;
+      iob->io_offset = 0;
+      iob->io_pktlen = 0;
+      return iob;
+    }
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
   /* Select the semaphore count to check. */
 
@@ -0,0 +1,277 @@
+/****************************************************************************
+ * mm/iob/iob_cache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_CPU_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The caches are only used while the shared pool holds more free IOBs than
+ * this.  Below it, every allocation and free goes through the shared pool
+ * so that throttling and waiting work exactly as without the caches.
+ */
+
+#define IOB_CACHE_RESERVE   (CONFIG_IOB_THROTTLE + CONFIG_IOB_CPU_CACHE_BATCH)
+
+/* A cache is flushed down to one batch when it grows to two */
+
+#define IOB_CACHE_MAXCOUNT  (2 * CONFIG_IOB_CPU_CACHE_BATCH)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The cache of free IOBs of one CPU */
+
+struct iob_cache_s
+{
+  FAR struct iob_s *ic_list;  /* Cached free IOBs */
+  int ic_count;               /* Number of IOBs in ic_list */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct iob_cache_s g_iob_cache[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cache_healthy
+ *
+ * Description:
+ *   Return true if the shared pool has enough free IOBs for the caches to
+ *   be used.  The semaphore count is read without the critical section, so
+ *   the answer is only a hint.
+ *
+ ****************************************************************************/
+
+static inline bool iob_cache_healthy(void)
+{
+  return g_iob_sem.semcount > IOB_CACHE_RESERVE;
+}
+
+/****************************************************************************
+ * Name: iob_cache_refill
+ *
+ * Description:
+ *   Move up to one batch of IOBs from the shared pool into a cache.  The
+ *   IOBs are no longer counted by the semaphores.  This is called with
+ *   local interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void iob_cache_refill(FAR struct iob_cache_s *cache)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  while (cache->ic_count < CONFIG_IOB_CPU_CACHE_BATCH &&
+         g_iob_sem.semcount > IOB_CACHE_RESERVE &&
+         (iob = g_iob_freelist) != NULL)
+    {
+      g_iob_freelist = iob->io_flink;
+
+      g_iob_sem.semcount--;
+#if CONFIG_IOB_THROTTLE > 0
+      g_throttle_sem.semcount--;
+#endif
+
+      iob->io_flink  = cache->ic_list;
+      cache->ic_list = iob;
+      cache->ic_count++;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: iob_cache_flush
+ *
+ * Description:
+ *   Return IOBs from a cache to the shared pool until no more than count
+ *   are left in it.  This is called with local interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void iob_cache_flush(FAR struct iob_cache_s *cache, int count)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  while (cache->ic_count > count)
+    {
+      iob            = cache->ic_list;
+      cache->ic_list = iob->io_flink;
+      cache->ic_count--;
+
+      iob_release(iob);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cache_alloc
+ *
+ * Description:
+ *   Try to take an IOB from the cache of the current CPU, refilling the
+ *   cache from the shared pool in one batch if it is empty.  Each CPU only
+ *   ever touches its own cache and does so with local interrupts disabled.
+ *
+ * Returned Value:
+ *   An IOB, not yet put in a known state, or NULL if the caller must
+ *   allocate from the shared pool.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_alloc(void)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *iob = NULL;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+
+  cache = &g_iob_cache[up_cpu_index()];
+  if (!iob_cache_healthy())
+    {
+      /* The pool runs low: give the cached IOBs back to it */
+
+      if (cache->ic_count > 0)
+        {
+          iob_cache_flush(cache, 0);
+        }
+    }
+  else
+    {
+      if (cache->ic_list == NULL)
+        {
+          iob_cache_refill(cache);
+        }
+
+      iob = cache->ic_list;
+      if (iob != NULL)
+        {
+          cache->ic_list = iob->io_flink;
+          cache->ic_count--;
+        }
+    }
+
+  up_irq_restore(flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_cache_free
+ *
+ * Description:
+ *   Try to put a free IOB into the cache of the current CPU, returning one
+ *   batch to the shared pool if the cache is full.
+ *
+ * Returned Value:
+ *   true if the IOB was cached; false if the caller must return it to the
+ *   shared pool.
+ *
+ ****************************************************************************/
+
+bool iob_cache_free(FAR struct iob_s *iob)
+{
+  FAR struct iob_cache_s *cache;
+  irqstate_t flags;
+  bool cached = false;
+
+  flags = up_irq_save();
+
+  cache = &g_iob_cache[up_cpu_index()];
+  if (!iob_cache_healthy())
+    {
+      if (cache->ic_count > 0)
+        {
+          iob_cache_flush(cache, 0);
+        }
+    }
+  else
+    {
+      if (cache->ic_count >= IOB_CACHE_MAXCOUNT)
+        {
+          iob_cache_flush(cache, CONFIG_IOB_CPU_CACHE_BATCH);
+        }
+
+      iob->io_flink  = cache->ic_list;
+      cache->ic_list = iob;
+      cache->ic_count++;
+      cached         = true;
+    }
+
+  up_irq_restore(flags);
+  return cached;
+}
+
+/****************************************************************************
+ * Name: iob_cache_navail
+ *
+ * Description:
+ *   Return the number of IOBs in all caches.  The counts are read without
+ *   any locking, so the result is only a snapshot.
+ *
+ ****************************************************************************/
+
+int iob_cache_navail(void)
+{
+  int navail = 0;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      navail += g_iob_cache[i].ic_count;
+    }
+
+  return navail;
+}
+
+#endif /* CONFIG_IOB_CPU_CACHE */
@@ -0,0 +1,295 @@
+/****************************************************************************
+ * mm/iob/iob_class.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Allocation counters of each class, protected by the critical section */
+
+static unsigned int g_iob_classnalloc[IOB_NCLASSES];
+static unsigned int g_iob_classnspill[IOB_NCLASSES];
+
+#ifdef IOB_HAVE_CLASSES
+/* The configured buffers of each class */
+
+static const int g_iob_classnbuffers[IOB_NCLASSES] =
+{
+  CONFIG_IOB_SMALL_NBUFFERS,
+  CONFIG_IOB_NBUFFERS,
+  CONFIG_IOB_LARGE_NBUFFERS
+};
+
+static const uint16_t g_iob_classbufsize[IOB_NCLASSES] =
+{
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+  CONFIG_IOB_SMALL_BUFSIZE,
+#else
+  0,
+#endif
+  CONFIG_IOB_BUFSIZE,
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  CONFIG_IOB_LARGE_BUFSIZE
+#else
+  0
+#endif
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef IOB_HAVE_CLASSES
+/****************************************************************************
+ * Name: iob_class_tryalloc
+ *
+ * Description:
+ *   Take a buffer from the free list of the small or large class, without
+ *   waiting.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_class_tryalloc(int ioclass,
+                                            enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  iob = g_iob_classlist[ioclass];
+  if (iob != NULL)
+    {
+      g_iob_classlist[ioclass] = iob->io_flink;
+      g_iob_classavail[ioclass]--;
+      DEBUGASSERT(g_iob_classavail[ioclass] >= 0);
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      iob_stats_onalloc(consumerid);
+#endif
+    }
+
+  leave_critical_section(flags);
+
+  if (iob != NULL)
+    {
+      iob->io_flink  = NULL;
+      iob->io_len    = 0;
+      iob->io_offset = 0;
+      iob->io_pktlen = 0;
+    }
+
+  return iob;
+}
+#endif
+
+/****************************************************************************
+ * Name: iob_class_count
+ *
+ * Description:
+ *   Count one allocation served from 'ioclass' for a request that best fit
+ *   class 'fit'.
+ *
+ ****************************************************************************/
+
+static void iob_class_count(int ioclass, int fit)
+{
+  irqstate_t flags = enter_critical_section();
+
+  g_iob_classnalloc[ioclass]++;
+  if (ioclass != fit)
+    {
+      g_iob_classnspill[ioclass]++;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef IOB_HAVE_CLASSES
+/****************************************************************************
+ * Name: iob_class_release
+ *
+ * Description:
+ *   Return a single I/O buffer of the small or large class to the free
+ *   list of its class.  The caller must be in a critical section.
+ *
+ ****************************************************************************/
+
+void iob_class_release(FAR struct iob_s *iob)
+{
+  int ioclass = iob->io_class;
+
+  DEBUGASSERT(ioclass != IOB_CLASS_DEFAULT && ioclass < IOB_NCLASSES);
+
+  iob->io_flink            = g_iob_classlist[ioclass];
+  g_iob_classlist[ioclass] = iob;
+  g_iob_classavail[ioclass]++;
+  DEBUGASSERT(g_iob_classavail[ioclass] <= g_iob_classnbuffers[ioclass]);
+}
+#endif
+
+/****************************************************************************
+ * Name: iob_alloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer for a packet of about 'size' bytes.  The buffer
+ *   is taken from the smallest class whose buffers hold 'size' bytes or,
+ *   if that class is exhausted, from the next larger one.  The small and
+ *   large pools are never waited on; when the fitting classes are empty
+ *   the request falls back to iob_alloc(), which may block.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_size(unsigned int size, bool throttled,
+                                 enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob;
+  int fit = IOB_CLASS_DEFAULT;
+
+#ifdef IOB_HAVE_CLASSES
+  int ioclass;
+
+  /* Find the smallest configured class that holds the request, or the
+   * largest one if none does.
+   */
+
+  for (fit = IOB_CLASS_SMALL; fit < IOB_CLASS_LARGE; fit++)
+    {
+      if (g_iob_classnbuffers[fit] > 0 && size <= g_iob_classbufsize[fit])
+        {
+          break;
+        }
+    }
+
+  if (fit == IOB_CLASS_LARGE && g_iob_classnbuffers[fit] == 0)
+    {
+      fit = IOB_CLASS_DEFAULT;
+    }
+
+  /* Then try that class and each larger one without waiting.  The
+   * throttle applies only to the default pool, which is shared with the
+   * users of iob_alloc().
+   */
+
+  for (ioclass = fit; ioclass < IOB_NCLASSES; ioclass++)
+    {
+      if (ioclass == IOB_CLASS_DEFAULT)
+        {
+          iob = iob_tryalloc(throttled, consumerid);
+        }
+      else if (g_iob_classnbuffers[ioclass] > 0)
+        {
+          iob = iob_class_tryalloc(ioclass, consumerid);
+        }
+      else
+        {
+          iob = NULL;
+        }
+
+      if (iob != NULL)
+        {
+          iob_class_count(ioclass, fit);
+          return iob;
+        }
+    }
+#endif
+
+  /* Nothing is free in the classes that fit.  Wait for a buffer of the
+   * default pool as iob_alloc() would.
+   */
+
+  iob = iob_alloc(throttled, consumerid);
+  if (iob != NULL)
+    {
+      iob_class_count(IOB_CLASS_DEFAULT, fit);
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_getclassstats
+ *
+ * Description:
+ *   Return the usage of one buffer class.
+ *
+ ****************************************************************************/
+
+int iob_getclassstats(int ioclass, FAR struct iob_classstats_s *stats)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(stats != NULL);
+
+  if (ioclass < 0 || ioclass >= IOB_NCLASSES)
+    {
+      return -ENOENT;
+    }
+
+  if (ioclass == IOB_CLASS_DEFAULT)
+    {
+      stats->bufsize  = CONFIG_IOB_BUFSIZE;
+      stats->nbuffers = CONFIG_IOB_NBUFFERS;
+      stats->navail   = iob_navail(false);
+    }
+  else
+    {
+#ifdef IOB_HAVE_CLASSES
+      if (g_iob_classnbuffers[ioclass] == 0)
+        {
+          return -ENOENT;
+        }
+
+      stats->bufsize  = g_iob_classbufsize[ioclass];
+      stats->nbuffers = g_iob_classnbuffers[ioclass];
+      stats->navail   = g_iob_classavail[ioclass];
+#else
+      return -ENOENT;
+#endif
+    }
+
+  flags = enter_critical_section();
+  stats->nalloc = g_iob_classnalloc[ioclass];
+  stats->nspill = g_iob_classnspill[ioclass];
+  leave_critical_section(flags);
+
+  return OK;
+}
@@ -62,6 +62,71 @@
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_release
+ *
+ * Description:
+ *   Return a single I/O buffer to the free list or, if a thread is waiting
+ *   for one, to the committed list.  The caller must be in a critical
+ *   section.
+ *
+ ****************************************************************************/
+
+void iob_release(FAR struct iob_s *iob)
+{
+#ifdef CONFIG_IOB_NOTIFIER
+  int16_t navail;
+#endif
+
+  /* Which list?  If there is a task waiting for an IOB, then put
+   * the IOB on either the free list or on the committed list where
+   * it is reserved for that allocation (and not available to
+   * iob_tryalloc()).
+   */
+
+  if (g_iob_sem.semcount < 0)
+    {
+      iob->io_flink   = g_iob_committed;
+      g_iob_committed = iob;
+    }
+  else
+    {
+      iob->io_flink   = g_iob_freelist;
+      g_iob_freelist  = iob;
+    }
+
+  /* Signal that an IOB is available.  If there is a thread blocked,
+   * waiting for an IOB, this will wake up exactly one thread.  The
+   * semaphore count will correctly indicated that the awakened task
+   * owns an IOB and should find it in the committed list.
+   */
+
+  nxsem_post(&g_iob_sem);
+  DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
+
+#if CONFIG_IOB_THROTTLE > 0
+  nxsem_post(&g_throttle_sem);
+  DEBUGASSERT(g_throttle_sem.semcount <=
+              (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
+#endif
+
+#ifdef CONFIG_IOB_NOTIFIER
+  /* Check if the IOB was claimed by a thread that is blocked waiting
+   * for an IOB.
+   */
+
+  navail = iob_navail(false);
+  if (navail > 0 && (navail & IOB_MASK) == 0)
+    {
+      /* Signal any threads that have requested a signal notification
+       * when an IOB becomes available.
+       */
+
+      iob_notifier_signal();
+    }
+#endif
+}
+
 /****************************************************************************
  * Name: iob_free
  *
@@ -76,9 +141,6 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
 {
   FAR struct iob_s *next = iob->io_flink;
   irqstate_t flags;
-#ifdef CONFIG_IOB_NOTIFIER
-  int16_t navail;
-#endif
 
   iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
           iob, iob->io_pktlen, iob->io_len, next);
@@ -113,6 +175,28 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
               next, next->io_pktlen, next->io_len);
     }
 
+#ifdef CONFIG_IOB_CPU_CACHE
+  /* Keep the I/O buffer in the cache of this CPU if possible.  Only the
+   * buffers of the default class are cached.
+   */
+
+  if (
+#ifdef IOB_HAVE_CLASSES
+      iob->io_class == IOB_CLASS_DEFAULT &&
+#endif
+      iob_cache_free(iob))
+    {
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      flags = enter_critical_section();
+      iob_stats_onfree(producerid);
+      leave_critical_section(flags);
+#endif
+
+      return next;
+    }
+#endif
+
   /* Free the I/O buffer by adding it to the head of the free or the
    * committed list. We don't know what context we are called from so
    * we use extreme measures to protect the free list:  We disable
@@ -121,59 +205,22 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
 
   flags = enter_critical_section();
 
-  /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()).
-   */
-
-  if (g_iob_sem.semcount < 0)
+#ifdef IOB_HAVE_CLASSES
+  if (iob->io_class != IOB_CLASS_DEFAULT)
     {
-      iob->io_flink   = g_iob_committed;
-      g_iob_committed = iob;
+      iob_class_release(iob);
     }
   else
+#endif
     {
-      iob->io_flink   = g_iob_freelist;
-      g_iob_freelist  = iob;
+      iob_release(iob);
     }
 
-  /* Signal that an IOB is available.  If there is a thread blocked,
-   * waiting for an IOB, this will wake up exactly one thread.  The
-   * semaphore count will correctly indicated that the awakened task
-   * owns an IOB and should find it in the committed list.
-   */
-
-  nxsem_post(&g_iob_sem);
-  DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
-
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
   iob_stats_onfree(producerid);
 #endif
 
-#if CONFIG_IOB_THROTTLE > 0
-  nxsem_post(&g_throttle_sem);
-  DEBUGASSERT(g_throttle_sem.semcount <=
-              (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
-#endif
-
-#ifdef CONFIG_IOB_NOTIFIER
-  /* Check if the IOB was claimed by a thread that is blocked waiting
-   * for an IOB.
-   */
-
-  navail = iob_navail(false);
-  if (navail > 0 && (navail & IOB_MASK) == 0)
-    {
-      /* Signal any threads that have requested a signal notification
-       * when an IOB becomes available.
-       */
-
-      iob_notifier_signal();
-    }
-#endif
-
   leave_critical_section(flags);
 
   /* And return the I/O buffer after the one that was freed */
@@ -55,4 +55,25 @@ unsigned int iob_get_queue_size(FAR struct iob_queue_s *queue)
   return total;
 }
 
+/****************************************************************************
+ * Name: iob_get_queue_count
+ *
+ * Description:
+ *   Queue helper for get the number of I/O buffers in the iob queue.
+ *
+ ****************************************************************************/
+
+unsigned int iob_get_queue_count(FAR struct iob_queue_s *queue)
+{
+  FAR struct iob_qentry_s *iobq;
+  unsigned int total = 0;
+
+  for (iobq = queue->qh_head; iobq != NULL; iobq = iobq->qe_flink)
+    {
+      total += iob_count(iobq->qe_head);
+    }
+
+  return total;
+}
+
 #endif /* CONFIG_IOB_NCHAINS > 0 */
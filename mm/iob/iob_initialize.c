@@ -25,7 +25,9 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 
+#include <nuttx/compiler.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
@@ -38,6 +40,18 @@
 #  define NULL ((FAR void *)0)
 #endif
 
+/* With buffer classes the payload is kept apart from the header.  Each
+ * payload is rounded up so that all of them keep the alignment that the
+ * network headers cast onto them expect.
+ */
+
+#define IOB_ALIGNSIZE(n)  (((n) + sizeof(uintptr_t) - 1) & \
+                           ~(sizeof(uintptr_t) - 1))
+
+#define IOB_DATASIZE        IOB_ALIGNSIZE(CONFIG_IOB_BUFSIZE)
+#define IOB_SMALL_DATASIZE  IOB_ALIGNSIZE(CONFIG_IOB_SMALL_BUFSIZE)
+#define IOB_LARGE_DATASIZE  IOB_ALIGNSIZE(CONFIG_IOB_LARGE_BUFSIZE)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -45,6 +59,26 @@
 /* This is a pool of pre-allocated I/O buffers */
 
 static struct iob_s        g_iob_pool[CONFIG_IOB_NBUFFERS];
+#ifdef IOB_HAVE_CLASSES
+static uint8_t             g_iob_data[CONFIG_IOB_NBUFFERS]
+                                     [IOB_DATASIZE]
+                                     aligned_data(sizeof(uintptr_t));
+#endif
+
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+static struct iob_s        g_iob_smallpool[CONFIG_IOB_SMALL_NBUFFERS];
+static uint8_t             g_iob_smalldata[CONFIG_IOB_SMALL_NBUFFERS]
+                                          [IOB_SMALL_DATASIZE]
+                                          aligned_data(sizeof(uintptr_t));
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+static struct iob_s        g_iob_largepool[CONFIG_IOB_LARGE_NBUFFERS];
+static uint8_t             g_iob_largedata[CONFIG_IOB_LARGE_NBUFFERS]
+                                          [IOB_LARGE_DATASIZE]
+                                          aligned_data(sizeof(uintptr_t));
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 static struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
 #endif
@@ -61,6 +95,13 @@ FAR struct iob_s *g_iob_freelist;
 
 FAR struct iob_s *g_iob_committed;
 
+#ifdef IOB_HAVE_CLASSES
+/* The free lists of the small and large classes */
+
+FAR struct iob_s *g_iob_classlist[IOB_NCLASSES];
+int g_iob_classavail[IOB_NCLASSES];
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* A list of all free, unallocated I/O buffer queue containers */
 
@@ -88,6 +129,42 @@ sem_t g_throttle_sem = SEM_INITIALIZER(CONFIG_IOB_NBUFFERS -
 sem_t g_qentry_sem = SEM_INITIALIZER(CONFIG_IOB_NCHAINS);
 #endif
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_class_initialize
+ *
+ * Description:
+ *   Add the buffers of one of the small or large pools to the free list of
+ *   their class.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_SMALL_NBUFFERS > 0 || CONFIG_IOB_LARGE_NBUFFERS > 0
+static void iob_class_initialize(int ioclass, FAR struct iob_s *pool,
+                                 FAR uint8_t *data, int nbuffers,
+                                 uint16_t bufsize)
+{
+  int i;
+
+  for (i = 0; i < nbuffers; i++)
+    {
+      FAR struct iob_s *iob = &pool[i];
+
+      iob->io_data    = &data[i * IOB_ALIGNSIZE(bufsize)];
+      iob->io_bufsize = bufsize;
+      iob->io_class   = ioclass;
+
+      iob->io_flink   = g_iob_classlist[ioclass];
+      g_iob_classlist[ioclass] = iob;
+    }
+
+  g_iob_classavail[ioclass] = nbuffers;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -110,12 +187,30 @@ void iob_initialize(void)
     {
       FAR struct iob_s *iob = &g_iob_pool[i];
 
+#ifdef IOB_HAVE_CLASSES
+      iob->io_data    = g_iob_data[i];
+      iob->io_bufsize = CONFIG_IOB_BUFSIZE;
+      iob->io_class   = IOB_CLASS_DEFAULT;
+#endif
+
       /* Add the pre-allocate I/O buffer to the head of the free list */
 
       iob->io_flink  = g_iob_freelist;
       g_iob_freelist = iob;
     }
 
+#if CONFIG_IOB_SMALL_NBUFFERS > 0
+  iob_class_initialize(IOB_CLASS_SMALL, g_iob_smallpool,
+                       &g_iob_smalldata[0][0], CONFIG_IOB_SMALL_NBUFFERS,
+                       CONFIG_IOB_SMALL_BUFSIZE);
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  iob_class_initialize(IOB_CLASS_LARGE, g_iob_largepool,
+                       &g_iob_largedata[0][0], CONFIG_IOB_LARGE_NBUFFERS,
+                       CONFIG_IOB_LARGE_BUFSIZE);
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
       /* Add each I/O buffer chain queue container to the free list */
 
@@ -55,6 +55,12 @@ int iob_navail(bool throttled)
     {
       ret = navail;
 
+#ifdef CONFIG_IOB_CPU_CACHE
+      /* The IOBs in the caches of the CPUs are free, too */
+
+      ret += iob_cache_navail();
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
       /* Subtract the throttle value is so requested */
 
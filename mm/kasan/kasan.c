@@ -35,6 +35,25 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_MM_KASAN_INLINE
+
+/* The compiler compatible shadow:  One signed shadow byte per 8 byte
+ * granule at a fixed offset.  0 means that the whole granule is
+ * accessible, 1..7 that only that many leading bytes are and a negative
+ * value that the granule is poisoned.
+ */
+
+#define KASAN_SHADOW_SHIFT   3
+#define KASAN_GRANULE_SIZE   (1 << KASAN_SHADOW_SHIFT)
+#define KASAN_GRANULE_MASK   (KASAN_GRANULE_SIZE - 1)
+#define KASAN_POISON_VALUE   0xff
+
+#define KASAN_MEM_TO_SHADOW(addr) \
+  ((FAR int8_t *)(((uintptr_t)(addr) >> KASAN_SHADOW_SHIFT) + \
+                  CONFIG_MM_KASAN_SHADOW_OFFSET))
+
+#else
+
 #define KASAN_BYTES_PER_WORD (sizeof(uintptr_t))
 #define KASAN_BITS_PER_WORD  (KASAN_BYTES_PER_WORD * 8)
 
@@ -50,10 +69,19 @@
 #define KASAN_REGION_SIZE(size) \
   (sizeof(struct kasan_region_s) + KASAN_SHADOW_SIZE(size))
 
+#endif /* CONFIG_MM_KASAN_INLINE */
+
+#ifndef CONFIG_MM_KASAN_SAMPLE_SHIFT
+#  define CONFIG_MM_KASAN_SAMPLE_SHIFT 0
+#endif
+
+#define KASAN_SAMPLE_MASK ((1u << CONFIG_MM_KASAN_SAMPLE_SHIFT) - 1)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifndef CONFIG_MM_KASAN_INLINE
 struct kasan_region_s
 {
   FAR struct kasan_region_s *next;
@@ -61,18 +89,116 @@ struct kasan_region_s
   uintptr_t                  end;
   uintptr_t                  shadow[1];
 };
+#endif
 
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
+#ifndef CONFIG_MM_KASAN_INLINE
 static sem_t g_lock = SEM_INITIALIZER(1);
 static FAR struct kasan_region_s *g_region;
+#endif
+
+#if CONFIG_MM_KASAN_SAMPLE_SHIFT > 0
+static unsigned int g_sample;
+#endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+static void kasan_report(uintptr_t addr, size_t size, bool is_write)
+{
+  static int recursion;
+
+  if (++recursion == 1)
+    {
+      _alert("kasan detected a %s access error, address at %0#"PRIxPTR
+            ", size is %zu\n", is_write ? "write" : "read", addr, size);
+#ifdef CONFIG_MM_KASAN_PANIC
+      PANIC();
+#endif
+    }
+
+  --recursion;
+}
+
+/* Decide whether this access is one of the sampled ones */
+
+static inline bool kasan_sample(void)
+{
+#if CONFIG_MM_KASAN_SAMPLE_SHIFT > 0
+  return (++g_sample & KASAN_SAMPLE_MASK) == 0;
+#else
+  return true;
+#endif
+}
+
+#ifdef CONFIG_MM_KASAN_INLINE
+static bool kasan_is_poisoned(uintptr_t addr, size_t size)
+{
+  uintptr_t last = addr + size - 1;
+  uintptr_t end;
+  int8_t value;
+
+  /* Check each granule touched by the access */
+
+  while (addr <= last)
+    {
+      value = *KASAN_MEM_TO_SHADOW(addr);
+      end   = addr | KASAN_GRANULE_MASK;
+      if (end > last)
+        {
+          end = last;
+        }
+
+      /* The last byte accessed in the granule must be below the number of
+       * accessible bytes.  A negative value poisons the whole granule.
+       */
+
+      if (value != 0 && (int8_t)(end & KASAN_GRANULE_MASK) >= value)
+        {
+          return true;
+        }
+
+      if (end == last)
+        {
+          break;
+        }
+
+      addr = end + 1;
+    }
+
+  return false;
+}
+
+static void kasan_set_poison(uintptr_t addr, size_t size, bool poisoned)
+{
+  FAR int8_t *p;
+  size_t n;
+
+  /* Heap chunks are at least granule aligned */
+
+  DEBUGASSERT((addr & KASAN_GRANULE_MASK) == 0);
+
+  p = KASAN_MEM_TO_SHADOW(addr);
+  for (n = size >> KASAN_SHADOW_SHIFT; n > 0; n--)
+    {
+      *p++ = poisoned ? (int8_t)KASAN_POISON_VALUE : 0;
+    }
+
+  /* A partial tail granule is left alone when poisoning since its tail may
+   * belong to the next chunk.  When unpoisoning, only its leading bytes
+   * become accessible.
+   */
+
+  if (!poisoned && (size & KASAN_GRANULE_MASK) != 0)
+    {
+      *p = size & KASAN_GRANULE_MASK;
+    }
+}
+#else
 static FAR uintptr_t *kasan_mem_to_shadow(uintptr_t addr, size_t size,
                                           unsigned int *bit)
 {
@@ -93,20 +219,6 @@ static FAR uintptr_t *kasan_mem_to_shadow(uintptr_t addr, size_t size,
   return NULL;
 }
 
-static void kasan_report(uintptr_t addr, size_t size, bool is_write)
-{
-  static int recursion;
-
-  if (++recursion == 1)
-    {
-      _alert("kasan detected a %s access error, address at %0#"PRIxPTR
-            ", size is %zu\n", is_write ? "write" : "read", addr, size);
-      PANIC();
-    }
-
-  --recursion;
-}
-
 static bool kasan_is_poisoned(uintptr_t addr, size_t size)
 {
   FAR uintptr_t *p;
@@ -161,6 +273,7 @@ static void kasan_set_poison(uintptr_t addr, size_t size, bool poisoned)
         }
     }
 }
+#endif /* CONFIG_MM_KASAN_INLINE */
 
 /****************************************************************************
  * Public Functions
@@ -180,6 +293,13 @@ void kasan_unpoison(FAR const void *addr, size_t size)
 
 void kasan_register(FAR void *addr, FAR size_t *size)
 {
+#ifdef CONFIG_MM_KASAN_INLINE
+  /* The shadow lives at the fixed offset and was set aside by the board.
+   * Nothing is taken from the heap.
+   */
+
+  kasan_poison(addr, *size);
+#else
   FAR struct kasan_region_s *region;
 
   region = (FAR struct kasan_region_s *)
@@ -195,6 +315,7 @@ void kasan_register(FAR void *addr, FAR size_t *size)
 
   kasan_poison(addr, *size);
   *size -= KASAN_REGION_SIZE(*size);
+#endif
 }
 
 /* Exported functions called from the compiler generated code */
@@ -284,7 +405,7 @@ void __asan_report_store1_noabort(uintptr_t addr)
 
 void __asan_loadN_noabort(uintptr_t addr, size_t size)
 {
-  if (kasan_is_poisoned(addr, size))
+  if (kasan_sample() && kasan_is_poisoned(addr, size))
     {
       kasan_report(addr, size, false);
     }
@@ -292,7 +413,7 @@ void __asan_loadN_noabort(uintptr_t addr, size_t size)
 
 void __asan_storeN_noabort(uintptr_t addr, size_t size)
 {
-  if (kasan_is_poisoned(addr, size))
+  if (kasan_sample() && kasan_is_poisoned(addr, size))
     {
       kasan_report(addr, size, true);
     }
@@ -56,4 +56,24 @@ void kmm_free(FAR void *mem)
   mm_free(g_kmmheap, mem);
 }
 
+/****************************************************************************
+ * Name: kmm_free_delaylist
+ *
+ * Description:
+ *   Free the chunks of the kernel heap whose deallocation had to be
+ *   delayed.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void kmm_free_delaylist(void)
+{
+  mm_free_delaylist(g_kmmheap);
+}
+
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -28,6 +28,8 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
 
 #include <arch/types.h>
 #include <nuttx/mm/gran.h>
@@ -44,6 +46,20 @@
 #define SIZEOF_GRAN_S(n) \
   (sizeof(struct gran_s) + sizeof(uint32_t) * (SIZEOF_GAT(n) - 1))
 
+/* Number of search hints.  Hint k covers requests of 2**k granules or
+ * more (the last hint covers everything larger).
+ */
+
+#define GRAN_NHINTS 8
+
+/* Index of the least significant set bit of a non-zero GAT entry */
+
+#ifdef CONFIG_HAVE_BUILTIN_CTZ
+#  define GRAN_CTZ(v)                __builtin_ctz(v)
+#else
+#  define GRAN_CTZ(v)                (ffs(v) - 1)
+#endif
+
 /* Debug */
 
 #ifdef CONFIG_DEBUG_GRAM
@@ -60,18 +76,28 @@
  * Public Types
  ****************************************************************************/
 
-/* This structure represents the state of one granule allocation */
+/* This structure represents the state of one granule allocation.
+ *
+ * hint[k] is a lower bound on where the allocator has to start looking
+ * for 2**k consecutive free granules:  No such run begins before it.
+ * Allocations only ever raise the hints and frees lower them, so a search
+ * never revisits fully allocated parts of the heap.
+ */
 
 struct gran_s
 {
   uint8_t    log2gran;  /* Log base 2 of the size of one granule */
-  uint16_t   ngranules; /* The total number of (aligned) granules in the heap */
+  uint32_t   ngranules; /* The total number of (aligned) granules in the heap */
 #ifdef CONFIG_GRAN_INTR
   irqstate_t irqstate;  /* For exclusive access to the GAT */
 #else
   sem_t      exclsem;   /* For exclusive access to the GAT */
 #endif
   uintptr_t  heapstart; /* The aligned start of the granule heap */
+
+  /* Search start for each size class */
+
+  uint32_t   hint[GRAN_NHINTS];
   uint32_t   gat[1];    /* Start of the granule allocation table */
 };
 
@@ -116,4 +142,46 @@ void gran_leave_critical(FAR struct gran_s *priv);
 void gran_mark_allocated(FAR struct gran_s *priv, uintptr_t alloc,
                          unsigned int ngranules);
 
+/****************************************************************************
+ * Name: gran_mark_free
+ *
+ * Description:
+ *   Mark a range of granules as free and lower the search hints that the
+ *   newly freed granules may affect.
+ *
+ * Input Parameters:
+ *   priv  - The granule heap state structure.
+ *   alloc - The address of the allocation.
+ *   ngranules - The number of granules freed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void gran_mark_free(FAR struct gran_s *priv, uintptr_t alloc,
+                    unsigned int ngranules);
+
+/****************************************************************************
+ * Name: gran_find
+ *
+ * Description:
+ *   Find the first granule at or after 'granno', but before 'end', whose
+ *   allocation state matches 'used'.  The GAT is scanned a whole entry at
+ *   a time.
+ *
+ * Input Parameters:
+ *   priv   - The granule heap state structure.
+ *   granno - The first granule to examine.
+ *   end    - One past the last granule to examine.
+ *   used   - True to look for an allocated granule, false for a free one.
+ *
+ * Returned Value:
+ *   The number of the granule found; 'end' if there is none.
+ *
+ ****************************************************************************/
+
+unsigned int gran_find(FAR struct gran_s *priv, unsigned int granno,
+                       unsigned int end, bool used);
+
 #endif /* __MM_MM_GRAN_MM_GRAN_H */
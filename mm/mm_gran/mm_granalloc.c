@@ -32,6 +32,56 @@
 
 #ifdef CONFIG_GRAN
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gran_search
+ *
+ * Description:
+ *   Find the first run of 'ngranules' free granules that begins at or
+ *   after granule 'start'.
+ *
+ * Returned Value:
+ *   The number of the first granule of the run; priv->ngranules if there
+ *   is no such run.
+ *
+ ****************************************************************************/
+
+static unsigned int gran_search(FAR struct gran_s *priv, unsigned int start,
+                                unsigned int ngranules)
+{
+  unsigned int granno;
+  unsigned int used;
+
+  while (start + ngranules <= priv->ngranules)
+    {
+      /* Skip to the next free granule, then to the next allocated one
+       * within the span needed.  Whole GAT entries are skipped at once.
+       */
+
+      granno = gran_find(priv, start, priv->ngranules - ngranules + 1,
+                         false);
+      if (granno + ngranules > priv->ngranules)
+        {
+          break;
+        }
+
+      used = gran_find(priv, granno, granno + ngranules, true);
+      if (used == granno + ngranules)
+        {
+          return granno;
+        }
+
+      /* The run is too short.  Continue after the allocated granule. */
+
+      start = used + 1;
+    }
+
+  return priv->ngranules;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -42,9 +92,10 @@
  * Description:
  *   Allocate memory from the granule heap.
  *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 granules.  That restriction could be eliminated with some
- *   additional coding effort.
+ *   The GAT is searched first fit, a whole GAT entry at a time.  The
+ *   search for a request of n granules starts at the hint of its size
+ *   class, so that the fully allocated or fragmented start of the heap is
+ *   not rescanned on every request.
  *
  * Input Parameters:
  *   handle - The handle previously returned by gran_initialize
@@ -60,191 +111,76 @@ FAR void *gran_alloc(GRAN_HANDLE handle, size_t size)
 {
   FAR struct gran_s *priv = (FAR struct gran_s *)handle;
   unsigned int ngranules;
+  unsigned int granno;
+  uintptr_t    alloc = 0;
   size_t       tmpmask;
-  uintptr_t    alloc;
-  uint32_t     curr;
-  uint32_t     next;
-  uint32_t     mask;
-  int          granidx;
-  int          gatidx;
-  int          bitidx;
-  int          shift;
+  int          class;
   int          ret;
+  int          i;
 
-  DEBUGASSERT(priv != NULL && size <= 32 * (1 << priv->log2gran));
+  DEBUGASSERT(priv != NULL);
 
   if (priv != NULL && size > 0)
     {
-      /* Get exclusive access to the GAT */
+      /* How many contiguous granules we we need to find? */
 
-      ret = gran_enter_critical(priv);
-      if (ret < 0)
+      tmpmask = ((size_t)1 << priv->log2gran) - 1;
+      if (size > ((size_t)priv->ngranules << priv->log2gran))
         {
           return NULL;
         }
 
-      /* How many contiguous granules we we need to find? */
-
-      tmpmask   = (1 << priv->log2gran) - 1;
       ngranules = (size + tmpmask) >> priv->log2gran;
 
-      /* Then create mask for that number of granules */
-
-      DEBUGASSERT(ngranules <= 32);
-      mask = 0xffffffff >> (32 - ngranules);
-
-      /* Now search the granule allocation table for that number
-       * of contiguous
+      /* Get the size class of the request:  The largest k with 2**k not
+       * greater than the number of granules.
        */
 
-      for (granidx = 0; granidx < priv->ngranules; granidx += 32)
+      class = fls(ngranules) - 1;
+      if (class >= GRAN_NHINTS)
         {
-          /* Get the GAT index associated with the granule table entry */
-
-          gatidx = granidx >> 5;
-          curr = priv->gat[gatidx];
+          class = GRAN_NHINTS - 1;
+        }
 
-          /* Handle the case where there are no free granules in the entry */
+      /* Get exclusive access to the GAT */
 
-          if (curr == 0xffffffff)
-            {
-              continue;
-            }
+      ret = gran_enter_critical(priv);
+      if (ret < 0)
+        {
+          return NULL;
+        }
 
-          /* Get the next entry from the GAT to support a 64 bit shift */
+      /* No run of 2**class free granules, hence none of ngranules, begins
+       * before the hint.
+       */
 
-          if (granidx + 32 < priv->ngranules)
-            {
-              next = priv->gat[gatidx + 1];
-            }
+      granno = gran_search(priv, priv->hint[class], ngranules);
 
-          /* Use all ones when are at the last entry in the GAT (meaning
-           * nothing can be allocated.
-           */
+      /* Now no run of ngranules free granules begins before granno (or
+       * at all if the search failed).  The same is then true for the size
+       * classes that are at least that large.
+       */
 
-          else
+      for (i = class; i < GRAN_NHINTS; i++)
+        {
+          if ((1u << i) >= ngranules && priv->hint[i] < granno)
             {
-              next = 0xffffffff;
+              priv->hint[i] = granno;
             }
+        }
 
-          /* Search through the allocations in the 'curr' GAT entry
-           * to see if we can satisfy the allocation starting in that
-           * entry.
-           *
-           * This loop continues until either all of the bits have been
-           * examined (bitidx >= 32), or until there are insufficient
-           * granules left to satisfy the allocation.
-           */
-
-          alloc = priv->heapstart + (granidx << priv->log2gran);
-
-          for (bitidx = 0;
-               bitidx < 32 &&
-               (granidx + bitidx + ngranules) <= priv->ngranules;
-              )
-            {
-              /* Break out if there are no further free bits in 'curr'.
-               * All of the zero bits might have gotten shifted out.
-               */
-
-              if (curr == 0xffffffff)
-                {
-                  break;
-                }
-
-              /* Check for the first zero bit in the lower or upper 16-bits.
-               * From the test above, we know that at least one of the 32-
-               * bits in 'curr' is zero.
-               */
-
-              else if ((curr & 0x0000ffff) == 0x0000ffff)
-                {
-                  /* Not in the lower 16 bits.  The first free bit must be
-                   * in the upper 16 bits.
-                   */
-
-                  shift = 16;
-                }
-
-              /* We know that the first free bit is now within the lower 16
-               * bits of 'curr'.  Is it in the upper or lower byte?
-               */
-
-              else if ((curr & 0x0000ff) == 0x000000ff)
-                {
-                  /* Not in the lower 8 bits.  The first free bit must be in
-                   * the upper 8 bits.
-                   */
-
-                  shift = 8;
-                }
-
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Is it in the upper or lower nibble?
-               */
-
-              else if ((curr & 0x00000f) == 0x0000000f)
-                {
-                  /* Not in the lower 4 bits.  The first free bit must be in
-                   * the upper 4 bits.
-                   */
-
-                  shift = 4;
-                }
-
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Is it in the upper or lower pair?
-               */
-
-              else if ((curr & 0x000003) == 0x00000003)
-                {
-                  /* Not in the lower 2 bits.  The first free bit must be in
-                   * the upper 2 bits.
-                   */
-
-                  shift = 2;
-                }
-
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Check if we have the allocation at this
-               * bit position.
-               */
-
-              else if ((curr & mask) == 0)
-                {
-                  /* Yes.. mark these granules allocated */
-
-                  gran_mark_allocated(priv, alloc, ngranules);
-
-                  /* And return the allocation address */
-
-                  gran_leave_critical(priv);
-                  return (FAR void *)alloc;
-                }
-
-              /* The free allocation does not start at this position */
-
-              else
-                {
-                  shift = 1;
-                }
-
-              /* Set up for the next time through the loop.  Perform a 64
-               * bit shift to move to the next gran position and increment
-               * to the next candidate allocation address.
-               */
-
-              alloc  += (shift << priv->log2gran);
-              curr    = (curr >> shift) | (next << (32 - shift));
-              next  >>= shift;
-              bitidx += shift;
-            }
+      if (granno < priv->ngranules)
+        {
+          /* Mark these granules allocated */
+
+          alloc = priv->heapstart + ((uintptr_t)granno << priv->log2gran);
+          gran_mark_allocated(priv, alloc, ngranules);
         }
 
       gran_leave_critical(priv);
     }
 
-  return NULL;
+  return (FAR void *)alloc;
 }
 
 #endif /* CONFIG_GRAN */
@@ -32,6 +32,62 @@
 
 #ifdef CONFIG_GRAN
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gran_mark
+ *
+ * Description:
+ *   Set or clear the GAT bits of a range of granules, one GAT entry at a
+ *   time.
+ *
+ ****************************************************************************/
+
+static void gran_mark(FAR struct gran_s *priv, unsigned int granno,
+                      unsigned int ngranules, bool allocated)
+{
+  unsigned int gatidx;
+  unsigned int gatbit;
+  unsigned int nbits;
+  uint32_t     gatmask;
+
+  DEBUGASSERT(granno + ngranules <= priv->ngranules);
+
+  while (ngranules > 0)
+    {
+      /* Determine the GAT table index and the bits of that entry covered
+       * by the remainder of the range.
+       */
+
+      gatidx = granno >> 5;
+      gatbit = granno & 31;
+      nbits  = 32 - gatbit;
+      if (nbits > ngranules)
+        {
+          nbits = ngranules;
+        }
+
+      gatmask   = 0xffffffff >> (32 - nbits);
+      gatmask <<= gatbit;
+
+      if (allocated)
+        {
+          DEBUGASSERT((priv->gat[gatidx] & gatmask) == 0);
+          priv->gat[gatidx] |= gatmask;
+        }
+      else
+        {
+          DEBUGASSERT((priv->gat[gatidx] & gatmask) == gatmask);
+          priv->gat[gatidx] &= ~gatmask;
+        }
+
+      granno    += nbits;
+      ngranules -= nbits;
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -55,55 +111,97 @@
 void gran_mark_allocated(FAR struct gran_s *priv, uintptr_t alloc,
                          unsigned int ngranules)
 {
-  unsigned int granno;
-  unsigned int gatidx;
-  unsigned int gatbit;
-  unsigned int avail;
-  uint32_t     gatmask;
-
-  /* Determine the granule number of the allocation */
+  gran_mark(priv, (alloc - priv->heapstart) >> priv->log2gran,
+            ngranules, true);
+}
 
-  granno = (alloc - priv->heapstart) >> priv->log2gran;
+/****************************************************************************
+ * Name: gran_mark_free
+ *
+ * Description:
+ *   Mark a range of granules as free and lower the search hints that the
+ *   newly freed granules may affect.
+ *
+ * Input Parameters:
+ *   priv  - The granule heap state structure.
+ *   alloc - The address of the allocation.
+ *   ngranules - The number of granules freed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
 
-  /* Determine the GAT table index associated with the allocation */
+void gran_mark_free(FAR struct gran_s *priv, uintptr_t alloc,
+                    unsigned int ngranules)
+{
+  unsigned int granno;
+  unsigned int lowest;
+  int i;
 
-  gatidx = granno >> 5;
-  gatbit = granno & 31;
+  granno = (alloc - priv->heapstart) >> priv->log2gran;
+  gran_mark(priv, granno, ngranules, false);
 
-  /* Mark bits in the GAT entry or entries */
+  /* A new run of 2**i free granules must include one of the freed
+   * granules, so it cannot begin more than 2**i - 1 granules before the
+   * first of them.
+   */
 
-  avail = 32 - gatbit;
-  if (ngranules > avail)
+  for (i = 0; i < GRAN_NHINTS; i++)
     {
-      /* Mark bits in the first GAT entry */
-
-      gatmask = 0xffffffff << gatbit;
-      DEBUGASSERT((priv->gat[gatidx] & gatmask) == 0);
-
-      priv->gat[gatidx] |= gatmask;
-      ngranules -= avail;
-
-      /* Mark bits in the second GAT entry */
-
-      gatmask = 0xffffffff >> (32 - ngranules);
-      DEBUGASSERT((priv->gat[gatidx + 1] & gatmask) == 0);
-
-      priv->gat[gatidx + 1] |= gatmask;
+      lowest = granno >= (1u << i) ? granno - (1u << i) + 1 : 0;
+      if (priv->hint[i] > lowest)
+        {
+          priv->hint[i] = lowest;
+        }
     }
+}
+
+/****************************************************************************
+ * Name: gran_find
+ *
+ * Description:
+ *   Find the first granule at or after 'granno', but before 'end', whose
+ *   allocation state matches 'used'.  The GAT is scanned a whole entry at
+ *   a time.
+ *
+ * Input Parameters:
+ *   priv   - The granule heap state structure.
+ *   granno - The first granule to examine.
+ *   end    - One past the last granule to examine.
+ *   used   - True to look for an allocated granule, false for a free one.
+ *
+ * Returned Value:
+ *   The number of the granule found; 'end' if there is none.
+ *
+ ****************************************************************************/
 
-  /* Handle the case where where all of the granules come from one entry */
+unsigned int gran_find(FAR struct gran_s *priv, unsigned int granno,
+                       unsigned int end, bool used)
+{
+  unsigned int gatidx;
+  uint32_t     value;
 
-  else
+  while (granno < end)
     {
-      /* Mark bits in a single GAT entry */
+      /* Get the GAT entry with the granules of interest set to one and
+       * all preceding granules of the entry cleared.
+       */
 
-      gatmask   = 0xffffffff >> (32 - ngranules);
-      gatmask <<= gatbit;
-      DEBUGASSERT((priv->gat[gatidx] & gatmask) == 0);
+      gatidx = granno >> 5;
+      value  = used ? priv->gat[gatidx] : ~priv->gat[gatidx];
+      value &= 0xffffffff << (granno & 31);
 
-      priv->gat[gatidx] |= gatmask;
-      return;
+      if (value != 0)
+        {
+          granno = (gatidx << 5) + GRAN_CTZ(value);
+          return granno < end ? granno : end;
+        }
+
+      granno = (gatidx + 1) << 5;
     }
+
+  return end;
 }
 
 #endif /* CONFIG_GRAN */
@@ -28,6 +28,8 @@
 #include <nuttx/config.h>
 
 #include <nuttx/fs/procfs.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
 
 #include <assert.h>
 #include <execinfo.h>
@@ -120,10 +122,64 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* With CONFIG_MM_TLSF the free chunks are kept in a two-level segregated
+ * fit (TLSF) array of lists.  The first level splits the chunk sizes by
+ * powers of two, the second level splits each power of two linearly into
+ * MM_SL_COUNT lists.  Chunks of at least MM_MAX_CHUNK bytes are all kept in
+ * one extra first-level list, MM_FL_HUGE.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#  define MM_SL_SHIFT    CONFIG_MM_TLSF_SL_SHIFT
+#  define MM_SL_COUNT    (1 << MM_SL_SHIFT)
+#  define MM_FL_HUGE     (MM_MAX_SHIFT - MM_MIN_SHIFT - MM_SL_SHIFT + 1)
+#  define MM_FL_COUNT    (MM_FL_HUGE + 1)
+#endif
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK - 1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
 
+/* The per-CPU chunk cache can only be used where local interrupts can be
+ * disabled, i.e. not from the user-space half of a protected/kernel build.
+ * Chunks are cached in one size class per granule, so a size class holds
+ * chunks of exactly one size.
+ */
+
+#if defined(CONFIG_MM_CPU_CACHE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MM_HAVE_CACHE 1
+#endif
+
+/* The allocation tracer has the same restriction, its tables are protected
+ * by a spinlock.  Most allocations only count down the bytes to the next
+ * sample; the tracer itself is called for the one that reaches it.
+ */
+
+#if defined(CONFIG_MM_TRACE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MM_HAVE_TRACE 1
+#  define mm_trace_alloc(mem, size) \
+     do \
+       { \
+         if ((mem) != NULL && \
+             (g_mm_trace_countdown -= (ssize_t)(size)) <= 0) \
+           { \
+             mm_trace_sample(mem, size); \
+           } \
+       } \
+     while (0)
+#else
+#  define mm_trace_alloc(mem, size)
+#  define mm_trace_free(mem)
+#endif
+
+#ifdef CONFIG_MM_CPU_CACHE
+#  define MM_CACHE_MAXSIZE   MM_ALIGN_DOWN(CONFIG_MM_CPU_CACHE_MAXSIZE)
+#  define MM_CACHE_NCLASSES  (MM_CACHE_MAXSIZE >> MM_MIN_SHIFT)
+#  define MM_CACHE_NDX(s)    (((s) >> MM_MIN_SHIFT) - 1)
+#endif
+
 /* An allocated chunk is distinguished from a free chunk by bit 0
  * of the 'preceding' chunk size.  If set, then this is an allocated chunk.
  */
@@ -198,6 +254,23 @@ struct mm_delaynode_s
   FAR struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_CPU_CACHE
+/* This describes the chunk cache of one CPU.  Cached chunks remain marked
+ * as allocated in the heap and are linked through their user memory.  In
+ * SMP configurations the lock lets mm_cache_flush() on another CPU drain
+ * the cache; it is almost never contended.
+ */
+
+struct mm_cache_s
+{
+  FAR struct mm_delaynode_s *mc_list[MM_CACHE_NCLASSES];
+  uint8_t mc_count[MM_CACHE_NCLASSES];
+#ifdef CONFIG_SMP
+  spinlock_t mc_lock;
+#endif
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -221,19 +294,44 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_TLSF
+  /* All free nodes are maintained in doubly linked lists, one per TLSF
+   * size class.  The bitmaps tell which of the lists are not empty.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_FL_COUNT];
+  FAR struct mm_freenode_s *mm_freelist[MM_FL_COUNT][MM_SL_COUNT];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
 
   /* Free delay list, for some situations where we can't do free
-   * immdiately.
+   * immdiately.  In SMP configurations these are lock-free stacks: any
+   * CPU may push and the whole list is detached at once when drained.
    */
 
   FAR struct mm_delaynode_s *mm_delaylist[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_SCHED_WORKQUEUE
+  /* The IDLE thread can't take mm_semaphore, so it drains the delay lists
+   * through this work.
+   */
+
+  struct work_s mm_delaywork;
+#endif
+
+#ifdef CONFIG_MM_CPU_CACHE
+  /* Small chunks freed on each CPU, reused without taking mm_semaphore */
+
+  struct mm_cache_s mm_cache[CONFIG_SMP_NCPUS];
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
   struct procfs_meminfo_entry_s mm_procfs;
 #endif
@@ -244,6 +342,16 @@ struct mm_heap_s
 typedef CODE void (*mmchunk_handler_t)(FAR struct mm_allocnode_s *node,
                                        FAR void *arg);
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef MM_HAVE_TRACE
+/* Bytes left to allocate before the next sample of the tracer */
+
+extern ssize_t g_mm_trace_countdown;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -252,6 +360,7 @@ typedef CODE void (*mmchunk_handler_t)(FAR struct mm_allocnode_s *node,
 
 void mm_seminitialize(FAR struct mm_heap_s *heap);
 bool mm_takesemaphore(FAR struct mm_heap_s *heap);
+bool mm_trysemaphore(FAR struct mm_heap_s *heap);
 void mm_givesemaphore(FAR struct mm_heap_s *heap);
 
 /* Functions contained in mm_shrinkchunk.c **********************************/
@@ -259,10 +368,33 @@ void mm_givesemaphore(FAR struct mm_heap_s *heap);
 void mm_shrinkchunk(FAR struct mm_heap_s *heap,
                     FAR struct mm_allocnode_s *node, size_t size);
 
-/* Functions contained in mm_addfreechunk.c *********************************/
+/* Functions contained in mm_addfreechunk.c or mm_tlsf.c ********************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size);
+
+/* Functions contained in mm_free.c *****************************************/
+
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem);
+
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef MM_HAVE_CACHE
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize);
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+bool mm_cache_flush(FAR struct mm_heap_s *heap);
+#endif
+
+/* Functions contained in mm_trace.c ****************************************/
+
+#ifdef MM_HAVE_TRACE
+void mm_trace_sample(FAR void *mem, size_t size);
+void mm_trace_free(FAR void *mem);
+#endif
 
 /* Functions contained in mm_size2ndx.c *************************************/
 
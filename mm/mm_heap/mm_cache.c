@@ -0,0 +1,246 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/spinlock.h>
+
+#include "mm_heap/mm.h"
+#include "kasan/kasan.h"
+
+#ifdef MM_HAVE_CACHE
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_alloc
+ *
+ * Description:
+ *   Try to satisfy an allocation from the size-classed cache of the
+ *   current CPU.  The cache is only shared with mm_cache_flush(), so its
+ *   lock is practically never contended and no heap semaphore and no
+ *   global critical section are needed.
+ *
+ * Input Parameters:
+ *   heap      - The selected heap
+ *   alignsize - The chunk size (including the allocation header) needed
+ *
+ * Returned Value:
+ *   The user memory of a cached chunk or NULL if the cache is empty for
+ *   this size class.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize)
+{
+  FAR struct mm_cache_s *cache;
+  FAR struct mm_delaynode_s *mem;
+  irqstate_t flags;
+  int ndx;
+
+  if (alignsize > MM_CACHE_MAXSIZE)
+    {
+      return NULL;
+    }
+
+  ndx = MM_CACHE_NDX(alignsize);
+
+  /* Local interrupts must be disabled before the CPU index is read, so
+   * that the thread can't migrate to another CPU in between.
+   */
+
+  flags = up_irq_save();
+
+  cache = &heap->mm_cache[up_cpu_index()];
+#ifdef CONFIG_SMP
+  spin_lock(&cache->mc_lock);
+#endif
+
+  mem = cache->mc_list[ndx];
+  if (mem != NULL)
+    {
+      cache->mc_list[ndx] = mem->flink;
+      cache->mc_count[ndx]--;
+    }
+
+#ifdef CONFIG_SMP
+  spin_unlock(&cache->mc_lock);
+#endif
+  up_irq_restore(flags);
+
+  if (mem != NULL)
+    {
+      MM_ADD_BACKTRACE(heap, (FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+      kasan_unpoison(mem, mm_malloc_size(mem));
+    }
+
+  return mem;
+}
+
+/****************************************************************************
+ * Name: mm_cache_free
+ *
+ * Description:
+ *   Try to return a chunk to the size-classed cache of the current CPU.
+ *   The chunk stays marked as allocated in the heap; it just isn't owned
+ *   by anyone until the next mm_cache_alloc() or mm_cache_flush().
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   mem  - The user memory being freed
+ *
+ * Returned Value:
+ *   true if the chunk was cached; false if the caller must return it to
+ *   the heap proper (too large or the size class is full).
+ *
+ ****************************************************************************/
+
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cache_s *cache;
+  FAR struct mm_delaynode_s *tmp = mem;
+  irqstate_t flags;
+  bool cached = false;
+  int ndx;
+
+  node = (FAR struct mm_allocnode_s *)
+         ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(node->preceding & MM_ALLOC_BIT);
+
+  if (node->size > MM_CACHE_MAXSIZE)
+    {
+      return false;
+    }
+
+  ndx = MM_CACHE_NDX(node->size);
+
+  flags = up_irq_save();
+
+  cache = &heap->mm_cache[up_cpu_index()];
+#ifdef CONFIG_SMP
+  spin_lock(&cache->mc_lock);
+#endif
+
+  if (cache->mc_count[ndx] < CONFIG_MM_CPU_CACHE_DEPTH)
+    {
+      tmp->flink          = cache->mc_list[ndx];
+      cache->mc_list[ndx] = tmp;
+      cache->mc_count[ndx]++;
+      cached              = true;
+
+      kasan_poison(mem, mm_malloc_size(mem));
+    }
+
+#ifdef CONFIG_SMP
+  spin_unlock(&cache->mc_lock);
+#endif
+  up_irq_restore(flags);
+  return cached;
+}
+
+/****************************************************************************
+ * Name: mm_cache_flush
+ *
+ * Description:
+ *   Return every chunk held in the caches of all CPUs to the heap proper.
+ *   This is called when an allocation can't be satisfied so that chunks
+ *   parked in the caches can be merged back into larger free chunks.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *
+ * Returned Value:
+ *   true if at least one chunk was returned to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_cache_flush(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_delaynode_s *list = NULL;
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  int cpu;
+  int ndx;
+
+  /* Detach all size classes of each cache under its lock, then free the
+   * chunks with the heap semaphore as usual.
+   */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cache[cpu];
+      flags = up_irq_save();
+#ifdef CONFIG_SMP
+      spin_lock(&cache->mc_lock);
+#endif
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          FAR struct mm_delaynode_s *tmp = cache->mc_list[ndx];
+
+          while (tmp != NULL)
+            {
+              FAR struct mm_delaynode_s *next = tmp->flink;
+
+              tmp->flink = list;
+              list       = tmp;
+              tmp        = next;
+            }
+
+          cache->mc_list[ndx]  = NULL;
+          cache->mc_count[ndx] = 0;
+        }
+
+#ifdef CONFIG_SMP
+      spin_unlock(&cache->mc_lock);
+#endif
+      up_irq_restore(flags);
+    }
+
+  if (list == NULL)
+    {
+      return false;
+    }
+
+  while (list != NULL)
+    {
+      FAR void *address = list;
+
+      list = list->flink;
+      mm_freechunk(heap, address);
+    }
+
+  return true;
+}
+
+#endif /* MM_HAVE_CACHE */
@@ -0,0 +1,95 @@
+/****************************************************************************
+ * mm/mm_heap/mm_fraginfo.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void fraginfo_handler(FAR struct mm_allocnode_s *node,
+                             FAR void *arg)
+{
+  FAR struct mm_fraginfo_s *info = arg;
+  size_t size = node->size;
+  int ndx = 0;
+
+  if ((node->preceding & MM_ALLOC_BIT) != 0)
+    {
+      info->nused++;
+      return;
+    }
+
+  DEBUGASSERT(size >= SIZEOF_MM_FREENODE);
+
+  /* The bucket is the index of the most significant bit of the size */
+
+  while (ndx < MM_FRAG_NBUCKETS - 1 && (size >> (ndx + 1)) != 0)
+    {
+      ndx++;
+    }
+
+  info->count[ndx]++;
+  info->size[ndx] += size;
+  info->nfree++;
+  info->freesize += size;
+  if (size > info->largest)
+    {
+      info->largest = size;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Return the number and the size of the free chunks of the heap, by
+ *   size bucket, and its largest free chunk.  The free space is
+ *   fragmented when the largest chunk is much smaller than the total.
+ *
+ *   The regions are visited one at a time, so the counts are only
+ *   consistent if the heap is not used concurrently.
+ *
+ ****************************************************************************/
+
+int mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info)
+{
+  DEBUGASSERT(info);
+
+  memset(info, 0, sizeof(*info));
+  mm_foreach(heap, fraginfo_handler, info);
+  return OK;
+}
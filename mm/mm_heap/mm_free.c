@@ -27,8 +27,11 @@
 #include <assert.h>
 #include <debug.h>
 
+#include <sched.h>
+
 #include <nuttx/arch.h>
 #include <nuttx/mm/mm.h>
+#include <nuttx/wqueue.h>
 
 #include "mm_heap/mm.h"
 #include "kasan/kasan.h"
@@ -37,67 +40,92 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: mm_add_delaylist
+ *
+ * Description:
+ *   Queue a chunk that can't be freed now on the delay list of this CPU.
+ *   In SMP configurations this is a lock-free push, so interrupt handlers
+ *   on any CPU never have to take the global critical section.
+ *
+ ****************************************************************************/
+
 static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
 {
 #if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  FAR struct mm_delaynode_s **list = &heap->mm_delaylist[up_cpu_index()];
   FAR struct mm_delaynode_s *tmp = mem;
+#ifndef CONFIG_SMP
   irqstate_t flags;
+#endif
 
-  /* Delay the deallocation until a more appropriate time. */
+  /* Delay the deallocation until a more appropriate time.  Being preempted
+   * onto another CPU after up_cpu_index() is harmless: all delay lists are
+   * drained the same way.
+   */
 
-  flags = enter_critical_section();
+#ifdef CONFIG_SMP
+  tmp->flink = __atomic_load_n(list, __ATOMIC_RELAXED);
+  while (!__atomic_compare_exchange_n(list, &tmp->flink, tmp, true,
+                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+#else
+  flags = up_irq_save();
 
-  tmp->flink = heap->mm_delaylist[up_cpu_index()];
-  heap->mm_delaylist[up_cpu_index()] = tmp;
+  tmp->flink = *list;
+  *list      = tmp;
 
-  leave_critical_section(flags);
+  up_irq_restore(flags);
+#endif
 #endif
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: mm_free
+ * Name: mm_take_delaylist
  *
  * Description:
- *   Returns a chunk of memory to the list of free nodes,  merging with
- *   adjacent free chunks if possible.
+ *   Detach the whole delay list of one CPU.
  *
  ****************************************************************************/
 
-void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+static FAR struct mm_delaynode_s *
+mm_take_delaylist(FAR struct mm_heap_s *heap, int cpu)
 {
-  FAR struct mm_freenode_s *node;
-  FAR struct mm_freenode_s *prev;
-  FAR struct mm_freenode_s *next;
-  int ret;
-
-  UNUSED(ret);
-  minfo("Freeing %p\n", mem);
+  FAR struct mm_delaynode_s **list = &heap->mm_delaylist[cpu];
+  FAR struct mm_delaynode_s *tmp;
+#ifndef CONFIG_SMP
+  irqstate_t flags;
+#endif
 
-  /* Protect against attempts to free a NULL reference */
+#ifdef CONFIG_SMP
+  tmp = __atomic_exchange_n(list, NULL, __ATOMIC_ACQUIRE);
+#else
+  flags = up_irq_save();
 
-  if (!mem)
-    {
-      return;
-    }
+  tmp   = *list;
+  *list = NULL;
 
-  kasan_poison(mem, mm_malloc_size(mem));
+  up_irq_restore(flags);
+#endif
 
-  if (mm_takesemaphore(heap) == false)
-    {
-      kasan_unpoison(mem, mm_malloc_size(mem));
+  return tmp;
+}
+#endif
 
-      /* Meet -ESRCH return, which means we are in situations
-       * during context switching(See mm_takesemaphore() & getpid()).
-       * Then add to the delay list.
-       */
+/****************************************************************************
+ * Name: mm_mergechunk
+ *
+ * Description:
+ *   Return an allocated chunk to the free lists, merging it with the
+ *   adjacent free chunks if possible.  The caller holds the mm semaphore.
+ *
+ ****************************************************************************/
 
-      mm_add_delaylist(heap, mem);
-      return;
-    }
+static void mm_mergechunk(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_freenode_s *node;
+  FAR struct mm_freenode_s *prev;
+  FAR struct mm_freenode_s *next;
 
   DEBUGASSERT(mm_heapmember(heap, mem));
 
@@ -127,16 +155,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
       andbeyond = (FAR struct mm_allocnode_s *)
                     ((FAR char *)next + next->size);
 
-      /* Remove the next node.  There must be a predecessor,
-       * but there may not be a successor node.
-       */
+      /* Remove the next node from the free list */
 
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
+      mm_delfreechunk(heap, next);
 
       /* Then merge the two chunks */
 
@@ -154,16 +175,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   DEBUGASSERT((node->preceding & ~MM_ALLOC_BIT) == prev->size);
   if ((prev->preceding & MM_ALLOC_BIT) == 0)
     {
-      /* Remove the node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+      /* Remove the previous node from the free list */
 
-      DEBUGASSERT(prev->blink);
-      prev->blink->flink = prev->flink;
-      if (prev->flink)
-        {
-          prev->flink->blink = prev->blink;
-        }
+      mm_delfreechunk(heap, prev);
 
       /* Then merge the two chunks */
 
@@ -175,5 +189,193 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   /* Add the merged node to the nodelist */
 
   mm_addfreechunk(heap, node);
+}
+
+/****************************************************************************
+ * Name: mm_drain_delaylist
+ *
+ * Description:
+ *   Free the chunks queued on the delay lists of every CPU.  The caller
+ *   holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+static void mm_drain_delaylist(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_delaynode_s *tmp;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      tmp = mm_take_delaylist(heap, cpu);
+      while (tmp != NULL)
+        {
+          FAR void *address = tmp;
+
+          tmp = tmp->flink;
+
+          kasan_poison(address, mm_malloc_size(address));
+          mm_mergechunk(heap, address);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_delaylist_worker
+ *
+ * Description:
+ *   Drain the delay lists on behalf of the IDLE thread.  Running on a work
+ *   queue thread, this may wait for the mm semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+static void mm_delaylist_worker(FAR void *arg)
+{
+  FAR struct mm_heap_s *heap = arg;
+
+  if (mm_takesemaphore(heap))
+    {
+      mm_drain_delaylist(heap);
+      mm_givesemaphore(heap);
+    }
+}
+#endif
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_freechunk
+ *
+ * Description:
+ *   Returns a chunk of memory to the list of free nodes,  merging with
+ *   adjacent free chunks if possible.  Unlike mm_free(), this never
+ *   places the chunk in the per-CPU cache.
+ *
+ ****************************************************************************/
+
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  kasan_poison(mem, mm_malloc_size(mem));
+
+  if (mm_takesemaphore(heap) == false)
+    {
+      kasan_unpoison(mem, mm_malloc_size(mem));
+
+      /* Meet -ESRCH return, which means we are in situations
+       * during context switching(See mm_takesemaphore() & getpid()).
+       * Then add to the delay list.
+       */
+
+      mm_add_delaylist(heap, mem);
+      return;
+    }
+
+  mm_mergechunk(heap, mem);
   mm_givesemaphore(heap);
 }
+
+/****************************************************************************
+ * Name: mm_free_delaylist
+ *
+ * Description:
+ *   Free the chunks queued on the delay lists of every CPU.  This never
+ *   waits for the mm semaphore; if it is not available, the chunks are
+ *   simply left for the next attempt.  It is called on each allocation and
+ *   from the IDLE loop so that memory freed from interrupt handlers on a
+ *   CPU that rarely allocates is not stranded.  From the IDLE loop the
+ *   chunks are freed by the low priority work queue.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_free_delaylist(FAR struct mm_heap_s *heap)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  int cpu;
+
+  /* Don't touch the semaphore unless there is something to free */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (heap->mm_delaylist[cpu] != NULL)
+        {
+          break;
+        }
+    }
+
+  if (cpu >= CONFIG_SMP_NCPUS)
+    {
+      return;
+    }
+
+  /* The IDLE thread must not take the semaphore at all, not even with a
+   * try-wait, so it hands the work over to the low priority work queue.
+   * Without a work queue the lists are drained by the next allocation.
+   */
+
+  if (!up_interrupt_context() && sched_idletask())
+    {
+#ifdef CONFIG_SCHED_WORKQUEUE
+      if (work_available(&heap->mm_delaywork))
+        {
+          work_queue(LPWORK, &heap->mm_delaywork, mm_delaylist_worker,
+                     heap, 0);
+        }
+#endif
+
+      return;
+    }
+
+  if (mm_trysemaphore(heap))
+    {
+      mm_drain_delaylist(heap);
+      mm_givesemaphore(heap);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_free
+ *
+ * Description:
+ *   Returns a chunk of memory to the list of free nodes,  merging with
+ *   adjacent free chunks if possible.
+ *
+ ****************************************************************************/
+
+void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  minfo("Freeing %p\n", mem);
+
+  /* Protect against attempts to free a NULL reference */
+
+  if (!mem)
+    {
+      return;
+    }
+
+  mm_trace_free(mem);
+
+#ifdef MM_HAVE_CACHE
+  /* Small chunks go to the cache of this CPU without taking the heap
+   * semaphore.
+   */
+
+  if (mm_cache_free(heap, mem))
+    {
+      return;
+    }
+#endif
+
+  mm_freechunk(heap, mem);
+}
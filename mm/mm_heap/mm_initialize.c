@@ -172,7 +172,9 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 {
   FAR struct mm_heap_s *heap;
   uintptr_t             heap_adj;
+#ifndef CONFIG_MM_TLSF
   int                   i;
+#endif
 
   minfo("Heap: name=%s, start=%p size=%zu\n", name, heapstart, heapsize);
 
@@ -195,13 +197,17 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 
   memset(heap, 0, sizeof(struct mm_heap_s));
 
-  /* Initialize the node array */
+#ifndef CONFIG_MM_TLSF
+  /* Initialize the node array.  The TLSF lists and bitmaps start out
+   * empty, which the memset() above already took care of.
+   */
 
   for (i = 1; i < MM_NNODES; i++)
     {
       heap->mm_nodelist[i - 1].flink = &heap->mm_nodelist[i];
       heap->mm_nodelist[i].blink     = &heap->mm_nodelist[i - 1];
     }
+#endif
 
   /* Initialize the malloc semaphore to one (to support one-at-
    * a-time access to private data sets).
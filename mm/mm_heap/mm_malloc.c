@@ -43,45 +43,6 @@
 #  define NULL ((void *)0)
 #endif
 
-/****************************************************************************
- * Private Functions
- ****************************************************************************/
-
-static void mm_free_delaylist(FAR struct mm_heap_s *heap)
-{
-#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
-  FAR struct mm_delaynode_s *tmp;
-  irqstate_t flags;
-
-  /* Move the delay list to local */
-
-  flags = enter_critical_section();
-
-  tmp = heap->mm_delaylist[up_cpu_index()];
-  heap->mm_delaylist[up_cpu_index()] = NULL;
-
-  leave_critical_section(flags);
-
-  /* Test if the delayed is empty */
-
-  while (tmp)
-    {
-      FAR void *address;
-
-      /* Get the first delayed deallocation */
-
-      address = tmp;
-      tmp = tmp->flink;
-
-      /* The address should always be non-NULL since that was checked in the
-       * 'while' condition above.
-       */
-
-      mm_free(heap, address);
-    }
-#endif
-}
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -102,7 +63,6 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   FAR struct mm_freenode_s *node;
   size_t alignsize;
   FAR void *ret = NULL;
-  int ndx;
 
   /* Free the delay list first */
 
@@ -130,58 +90,40 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
   DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
 
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
-
-  DEBUGVERIFY(mm_takesemaphore(heap));
-
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
+#ifdef MM_HAVE_CACHE
+  /* Small allocations are first tried from the cache of this CPU, which
+   * doesn't need the MM semaphore.
    */
 
-  if (alignsize >= MM_MAX_CHUNK)
+  ret = mm_cache_alloc(heap, alignsize);
+  if (ret != NULL)
     {
-      ndx = MM_NNODES - 1;
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+      memset(ret, 0xaa, mm_malloc_size(ret));
+#endif
+      mm_trace_alloc(ret, size);
+      return ret;
     }
-  else
-    {
-      /* Convert the request size into a nodelist index */
 
-      ndx = mm_size2ndx(alignsize);
-    }
+retry:
+#endif
 
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
+  /* We need to hold the MM semaphore while we muck with the nodelist. */
 
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink)
-    {
-      DEBUGASSERT(node->blink->flink == node);
-    }
+  DEBUGVERIFY(mm_takesemaphore(heap));
 
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that it must be the best fitting chunk
-   * available.
-   */
+  /* Search for a large enough chunk in the list of free nodes */
 
+  node = mm_findfreechunk(heap, alignsize);
   if (node)
     {
       FAR struct mm_freenode_s *remainder;
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -231,8 +173,20 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
   mm_givesemaphore(heap);
 
+#ifdef MM_HAVE_CACHE
+  /* Chunks parked in the cache may be all that keeps a large enough free
+   * chunk from forming.  Give them back to the heap and try once more.
+   */
+
+  if (ret == NULL && mm_cache_flush(heap))
+    {
+      goto retry;
+    }
+#endif
+
   if (ret)
     {
+      mm_trace_alloc(ret, size);
       kasan_unpoison(ret, mm_malloc_size(ret));
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
       memset(ret, 0xaa, alignsize - SIZEOF_MM_ALLOCNODE);
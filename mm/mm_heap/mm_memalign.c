@@ -112,6 +112,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       return NULL;
     }
 
+  /* The raw chunk is traced again once it has been aligned */
+
+  mm_trace_free((FAR void *)rawchunk);
   kasan_poison((FAR void *)rawchunk, mm_malloc_size((FAR void *)rawchunk));
 
   /* We need to hold the MM semaphore while we muck with the chunks and
@@ -224,6 +227,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
 
   mm_givesemaphore(heap);
 
+  mm_trace_alloc((FAR void *)alignedchunk, size - SIZEOF_MM_ALLOCNODE);
   kasan_unpoison((FAR void *)alignedchunk,
                  mm_malloc_size((FAR void *)alignedchunk));
 
@@ -139,6 +139,39 @@ bool mm_takesemaphore(FAR struct mm_heap_s *heap)
     }
 }
 
+/****************************************************************************
+ * Name: mm_trysemaphore
+ *
+ * Description:
+ *   Take the MM mutex only if that is possible without waiting.  This is
+ *   used to drain the delay lists opportunistically.  It must not be
+ *   called from the IDLE thread, which can't take semaphores at all.
+ *
+ * Input Parameters:
+ *   heap  - heap instance want to take semaphore
+ *
+ * Returned Value:
+ *   true if the semaphore was taken, otherwise false.
+ *
+ ****************************************************************************/
+
+bool mm_trysemaphore(FAR struct mm_heap_s *heap)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  if (up_interrupt_context())
+    {
+      return false;
+    }
+#endif
+
+  if (getpid() < 0)
+    {
+      return false;
+    }
+
+  return _SEM_TRYWAIT(&heap->mm_semaphore) >= 0;
+}
+
 /****************************************************************************
  * Name: mm_givesemaphore
  *
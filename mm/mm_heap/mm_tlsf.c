@@ -0,0 +1,241 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tlsf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <strings.h>
+
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+static_assert(MM_FL_COUNT < 32, "Too many TLSF first-level lists\n");
+static_assert(MM_SL_COUNT <= 32, "Too many TLSF second-level lists\n");
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_mapping
+ *
+ * Description:
+ *   Convert a chunk size into the first- and second-level indexes of the
+ *   list holding chunks of that size.
+ *
+ ****************************************************************************/
+
+static void mm_tlsf_mapping(size_t size, FAR int *fl, FAR int *sl)
+{
+  int ngran;
+  int msb;
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      *fl = MM_FL_HUGE;
+      *sl = 0;
+      return;
+    }
+
+  /* Small sizes are mapped linearly into the first first-level list */
+
+  ngran = size >> MM_MIN_SHIFT;
+  if (ngran < MM_SL_COUNT)
+    {
+      *fl = 0;
+      *sl = ngran;
+      return;
+    }
+
+  msb = fls(ngran) - 1;
+  *fl = msb - MM_SL_SHIFT + 1;
+  *sl = (ngran >> (msb - MM_SL_SHIFT)) - MM_SL_COUNT;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_addfreechunk
+ *
+ * Description:
+ *   Add a free chunk to the head of its TLSF list.  It is assumed that the
+ *   caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_addfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_freenode_s *next;
+  int fl;
+  int sl;
+
+  DEBUGASSERT(node->size >= SIZEOF_MM_FREENODE);
+  DEBUGASSERT((node->preceding & MM_ALLOC_BIT) == 0);
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+
+  next        = heap->mm_freelist[fl][sl];
+  node->blink = NULL;
+  node->flink = next;
+
+  if (next)
+    {
+      next->blink = node;
+    }
+
+  heap->mm_freelist[fl][sl] = node;
+  heap->mm_slbitmap[fl]    |= 1ul << sl;
+  heap->mm_flbitmap        |= 1ul << fl;
+}
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from its TLSF list.  The chunk size must not have
+ *   been changed since the chunk was added.  It is assumed that the caller
+ *   holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  int fl;
+  int sl;
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+
+  if (node->blink)
+    {
+      node->blink->flink = node->flink;
+    }
+  else
+    {
+      DEBUGASSERT(heap->mm_freelist[fl][sl] == node);
+      heap->mm_freelist[fl][sl] = node->flink;
+    }
+
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+
+  /* Clear the bitmap bits if that was the last chunk in the list */
+
+  if (heap->mm_freelist[fl][sl] == NULL)
+    {
+      heap->mm_slbitmap[fl] &= ~(1ul << sl);
+      if (heap->mm_slbitmap[fl] == 0)
+        {
+          heap->mm_flbitmap &= ~(1ul << fl);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least the given size, without removing it from
+ *   its list.  The size is first rounded up to the next size class so that
+ *   any chunk of that class or of a larger class is large enough and the
+ *   head of the first non-empty list can be taken.  It is assumed that the
+ *   caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  size_t rounded = size;
+  uint32_t slmap;
+  uint32_t flmap;
+  int fl;
+  int sl;
+
+  /* Really big allocations need a first-fit search in the list of huge
+   * chunks.
+   */
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      for (node = heap->mm_freelist[MM_FL_HUGE][0];
+           node && node->size < size;
+           node = node->flink);
+
+      return node;
+    }
+
+  /* Round up to the next size class */
+
+  if ((size >> MM_MIN_SHIFT) >= MM_SL_COUNT)
+    {
+      rounded += ((size_t)1 << (fls(size) - 1 - MM_SL_SHIFT)) - 1;
+    }
+
+  mm_tlsf_mapping(rounded, &fl, &sl);
+
+  /* Find a non-empty list in this first-level list or, failing that, in
+   * the smallest larger first-level list that is not empty.
+   */
+
+  slmap = heap->mm_slbitmap[fl] & (UINT32_MAX << sl);
+  if (slmap == 0)
+    {
+      flmap = heap->mm_flbitmap & (UINT32_MAX << (fl + 1));
+      if (flmap == 0)
+        {
+          /* Rounding up may have skipped a chunk that is large enough in
+           * the size class of the request itself.  Search that one list
+           * before giving up.
+           */
+
+          mm_tlsf_mapping(size, &fl, &sl);
+          for (node = heap->mm_freelist[fl][sl];
+               node && node->size < size;
+               node = node->flink);
+
+          return node;
+        }
+
+      fl    = ffs(flmap) - 1;
+      slmap = heap->mm_slbitmap[fl];
+    }
+
+  sl   = ffs(slmap) - 1;
+  node = heap->mm_freelist[fl][sl];
+
+  DEBUGASSERT(node != NULL && node->size >= size);
+  return node;
+}
@@ -0,0 +1,417 @@
+/****************************************************************************
+ * mm/mm_heap/mm_trace.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <execinfo.h>
+#include <string.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+#ifdef MM_HAVE_TRACE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MM_TRACE_PERIOD    CONFIG_MM_TRACE_PERIOD
+#define MM_TRACE_NSITES    CONFIG_MM_TRACE_NSITES
+#define MM_TRACE_NSAMPLES  CONFIG_MM_TRACE_NSAMPLES
+
+/* The golden ratio multiplier of Fibonacci hashing */
+
+#define MM_TRACE_GOLDEN    0x9e3779b1u
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One sampled allocation that has not been freed yet.  The samples are
+ * kept in an open addressed hash table keyed by the address, so that
+ * mm_free() can find them without anything stored in the chunk itself.
+ */
+
+struct mm_tracesample_s
+{
+  FAR void *mem;                   /* The sampled allocation, NULL if free */
+  size_t weight;                   /* The bytes this sample stands for */
+  uint16_t site;                   /* Index of the call site */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+ssize_t g_mm_trace_countdown = MM_TRACE_PERIOD;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The call sites and their backtraces.  Each distinct backtrace is stored
+ * once, however many allocations are made from it, and the sites are never
+ * removed so that the history of a freed site remains visible.
+ */
+
+static struct mm_tracesite_s g_mm_trace_sites[MM_TRACE_NSITES];
+static uint32_t g_mm_trace_hash[MM_TRACE_NSITES];
+
+static struct mm_tracesample_s g_mm_trace_samples[MM_TRACE_NSAMPLES];
+static uint32_t g_mm_trace_seed = MM_TRACE_GOLDEN;
+static spinlock_t g_mm_trace_lock;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_trace_slot
+ *
+ * Description:
+ *   Return the home slot of an address in the table of samples
+ *
+ ****************************************************************************/
+
+static inline int mm_trace_slot(FAR void *mem)
+{
+  return (uint32_t)(((uintptr_t)mem >> MM_MIN_SHIFT) * MM_TRACE_GOLDEN) %
+         MM_TRACE_NSAMPLES;
+}
+
+/****************************************************************************
+ * Name: mm_trace_period
+ *
+ * Description:
+ *   Return the distance to the next sample.  It is drawn uniformly from
+ *   [PERIOD / 2, 3 * PERIOD / 2) so that a program allocating in a fixed
+ *   pattern cannot always hit, or always miss, the same allocation.
+ *
+ ****************************************************************************/
+
+static ssize_t mm_trace_period(void)
+{
+  uint32_t x = g_mm_trace_seed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  g_mm_trace_seed = x;
+
+  return MM_TRACE_PERIOD / 2 + x % MM_TRACE_PERIOD + 1;
+}
+
+/****************************************************************************
+ * Name: mm_trace_findsite
+ *
+ * Description:
+ *   Find the call site of a backtrace or add it to the table.  Called with
+ *   the lock held.
+ *
+ * Returned Value:
+ *   The index of the site, or a negated errno value if the table is full.
+ *
+ ****************************************************************************/
+
+static int mm_trace_findsite(FAR void **frames, uint32_t hash)
+{
+  FAR struct mm_tracesite_s *site;
+  int ndx = hash % MM_TRACE_NSITES;
+  int i;
+
+  for (i = 0; i < MM_TRACE_NSITES; i++)
+    {
+      site = &g_mm_trace_sites[ndx];
+      if (site->nalloc == 0)
+        {
+          memcpy(site->backtrace, frames, sizeof(site->backtrace));
+          g_mm_trace_hash[ndx] = hash;
+          return ndx;
+        }
+
+      if (g_mm_trace_hash[ndx] == hash &&
+          memcmp(site->backtrace, frames, sizeof(site->backtrace)) == 0)
+        {
+          return ndx;
+        }
+
+      if (++ndx == MM_TRACE_NSITES)
+        {
+          ndx = 0;
+        }
+    }
+
+  return -ENOSPC;
+}
+
+/****************************************************************************
+ * Name: mm_trace_remove
+ *
+ * Description:
+ *   Remove the sample in slot ndx.  The samples that follow it in its
+ *   cluster are moved back so that no lookup ever stops early at the hole.
+ *   Called with the lock held.
+ *
+ ****************************************************************************/
+
+static void mm_trace_remove(int ndx)
+{
+  int next = ndx;
+  int home;
+  int i;
+
+  for (i = 1; i < MM_TRACE_NSAMPLES; i++)
+    {
+      if (++next == MM_TRACE_NSAMPLES)
+        {
+          next = 0;
+        }
+
+      if (g_mm_trace_samples[next].mem == NULL)
+        {
+          break;
+        }
+
+      /* Move the sample back unless its home slot lies cyclically between
+       * the hole and its current slot.
+       */
+
+      home = mm_trace_slot(g_mm_trace_samples[next].mem);
+      if (ndx <= next ? (home <= ndx || home > next) :
+                        (home <= ndx && home > next))
+        {
+          g_mm_trace_samples[ndx] = g_mm_trace_samples[next];
+          ndx = next;
+        }
+    }
+
+  g_mm_trace_samples[ndx].mem = NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_trace_sample
+ *
+ * Description:
+ *   Record the allocation that made the countdown of mm_trace_alloc()
+ *   expire and restart the countdown.
+ *
+ * Input Parameters:
+ *   mem  - The allocated memory
+ *   size - The size that was requested
+ *
+ ****************************************************************************/
+
+void mm_trace_sample(FAR void *mem, size_t size)
+{
+  FAR void *frames[CONFIG_MM_TRACE_DEPTH];
+  FAR struct mm_tracesite_s *site;
+  uint32_t hash = 0;
+  irqstate_t flags;
+  int ndx;
+  int i;
+
+  /* Take the backtrace before the lock, it is by far the most expensive
+   * part.
+   */
+
+  memset(frames, 0, sizeof(frames));
+  backtrace(frames, CONFIG_MM_TRACE_DEPTH);
+
+  for (i = 0; i < CONFIG_MM_TRACE_DEPTH; i++)
+    {
+      hash = (hash ^ (uint32_t)(uintptr_t)frames[i]) * MM_TRACE_GOLDEN;
+    }
+
+  flags = spin_lock_irqsave(&g_mm_trace_lock);
+
+  g_mm_trace_countdown = mm_trace_period();
+
+  ndx = mm_trace_findsite(frames, hash);
+  if (ndx < 0)
+    {
+      goto out;
+    }
+
+  /* Find a free slot, the sample is dropped if the table is full */
+
+  i = mm_trace_slot(mem);
+  while (g_mm_trace_samples[i].mem != NULL)
+    {
+      if (++i == MM_TRACE_NSAMPLES)
+        {
+          i = 0;
+        }
+
+      if (i == mm_trace_slot(mem))
+        {
+          goto out;
+        }
+    }
+
+  site = &g_mm_trace_sites[ndx];
+
+  g_mm_trace_samples[i].mem    = mem;
+  g_mm_trace_samples[i].weight = size > MM_TRACE_PERIOD ?
+                                 size : MM_TRACE_PERIOD;
+  g_mm_trace_samples[i].site   = ndx;
+
+  site->nalloc++;
+  site->nlive++;
+  site->live += g_mm_trace_samples[i].weight;
+
+out:
+  spin_unlock_irqrestore(&g_mm_trace_lock, flags);
+}
+
+/****************************************************************************
+ * Name: mm_trace_free
+ *
+ * Description:
+ *   Forget the sample of an allocation that is being freed, if any.
+ *
+ * Input Parameters:
+ *   mem - The memory being freed
+ *
+ ****************************************************************************/
+
+void mm_trace_free(FAR void *mem)
+{
+  FAR struct mm_tracesite_s *site;
+  irqstate_t flags;
+  int home = mm_trace_slot(mem);
+  int ndx = home;
+
+  /* Most freed memory was never sampled.  An empty home slot says so
+   * without taking the lock: the slot of a live sample never empties
+   * while another sample is removed, and this one can only be removed
+   * here.
+   */
+
+  if (g_mm_trace_samples[home].mem == NULL)
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&g_mm_trace_lock);
+
+  while (g_mm_trace_samples[ndx].mem != NULL)
+    {
+      if (g_mm_trace_samples[ndx].mem == mem)
+        {
+          site = &g_mm_trace_sites[g_mm_trace_samples[ndx].site];
+          site->nlive--;
+          site->live -= g_mm_trace_samples[ndx].weight;
+
+          mm_trace_remove(ndx);
+          break;
+        }
+
+      if (++ndx == MM_TRACE_NSAMPLES)
+        {
+          ndx = 0;
+        }
+
+      if (ndx == home)
+        {
+          break;
+        }
+    }
+
+  spin_unlock_irqrestore(&g_mm_trace_lock, flags);
+}
+
+/****************************************************************************
+ * Name: mm_trace_getsite
+ *
+ * Description:
+ *   Get a copy of one call site of the allocation tracer.
+ *
+ * Input Parameters:
+ *   index - The index of the site, from 0 to CONFIG_MM_TRACE_NSITES - 1
+ *   site  - The location to return the site
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -ENOENT if no allocation was sampled at this
+ *   index, or -EINVAL if the index is out of range.
+ *
+ ****************************************************************************/
+
+int mm_trace_getsite(int index, FAR struct mm_tracesite_s *site)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  if (index < 0 || index >= MM_TRACE_NSITES)
+    {
+      return -EINVAL;
+    }
+
+  flags = spin_lock_irqsave(&g_mm_trace_lock);
+
+  if (g_mm_trace_sites[index].nalloc == 0)
+    {
+      ret = -ENOENT;
+    }
+  else
+    {
+      *site = g_mm_trace_sites[index];
+    }
+
+  spin_unlock_irqrestore(&g_mm_trace_lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_trace_snapshot
+ *
+ * Description:
+ *   Remember the live bytes of every call site.  The sites whose live bytes
+ *   keep growing from one snapshot to the next are the likely leaks.
+ *
+ ****************************************************************************/
+
+void mm_trace_snapshot(void)
+{
+  irqstate_t flags;
+  int i;
+
+  flags = spin_lock_irqsave(&g_mm_trace_lock);
+
+  for (i = 0; i < MM_TRACE_NSITES; i++)
+    {
+      g_mm_trace_sites[i].snapshot = g_mm_trace_sites[i].live;
+    }
+
+  spin_unlock_irqrestore(&g_mm_trace_lock, flags);
+}
+
+#endif /* MM_HAVE_TRACE */
@@ -45,6 +45,19 @@
 #define SRFLAG_AVAILABLE 0        /* Available if no flag bits set */
 #define SRFLAG_INUSE     (1 << 0) /* Bit 0: Region is in use */
 #define SRFLAG_UNLINKED  (1 << 1) /* Bit 1: Region perists while references */
+#define SRFLAG_CONTIG    (1 << 2) /* Bit 2: Pages are physically contiguous */
+
+/* Large page geometry.  Contiguous regions of at least one large page are
+ * aligned, both physically and virtually, on a large page boundary so that
+ * the architecture may map them with section (large page) descriptors.
+ */
+
+#ifdef CONFIG_MM_SHM_CONTIGUOUS
+#  define SHM_LPSIZE       (1 << CONFIG_MM_SHM_LARGEPAGE_SHIFT)
+#  define SHM_LPMASK       (SHM_LPSIZE - 1)
+#  define SHM_LPPAGES      (SHM_LPSIZE >> MM_PGSHIFT)
+#  define SHM_LPALIGNUP(a) (((uintptr_t)(a) + SHM_LPMASK) & ~SHM_LPMASK)
+#endif
 
 /****************************************************************************
  * Public Types
@@ -57,7 +70,7 @@
 struct shm_region_s
 {
   struct shmid_ds sr_ds; /* Region info */
-  bool  sr_flags;        /* See SRFLAGS_* definitions */
+  uint8_t sr_flags;      /* See SRFLAGS_* definitions */
   key_t sr_key;          /* Lookup key */
   sem_t sr_sem;          /* Manages exclusive access to this region */
 
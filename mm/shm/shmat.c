@@ -31,11 +31,75 @@
 #include <nuttx/sched.h>
 #include <nuttx/arch.h>
 #include <nuttx/pgalloc.h>
+#include <nuttx/mm/gran.h>
 
 #include "shm/shm.h"
 
 #ifdef CONFIG_MM_SHM
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shm_valloc
+ *
+ * Description:
+ *   Set aside a virtual address space to span a shared memory region.
+ *   Physically contiguous regions of at least one large page are placed on
+ *   a large page boundary so that the architecture may map them with
+ *   section descriptors.
+ *
+ * Input Parameters:
+ *   handle - The group's shared memory virtual address allocator.
+ *   region - The region to be attached.
+ *
+ * Returned Value:
+ *   The virtual address on success; zero on failure.
+ *
+ ****************************************************************************/
+
+static uintptr_t shm_valloc(GRAN_HANDLE handle,
+                            FAR struct shm_region_s *region)
+{
+  size_t segsz = region->sr_ds.shm_segsz;
+#ifdef CONFIG_MM_SHM_CONTIGUOUS
+  uintptr_t vaddr;
+  uintptr_t vend;
+  size_t extra;
+
+  if ((region->sr_flags & SRFLAG_CONTIG) != 0 && segsz >= SHM_LPSIZE)
+    {
+      segsz = MM_PGALIGNUP(segsz);
+      extra = SHM_LPSIZE - MM_PGSIZE;
+
+      vaddr = (uintptr_t)gran_alloc(handle, segsz + extra);
+      if (vaddr != 0)
+        {
+          /* Release the unaligned head and the unused tail */
+
+          vend = vaddr + segsz + extra;
+          if (SHM_LPALIGNUP(vaddr) != vaddr)
+            {
+              gran_free(handle, (FAR void *)vaddr,
+                        SHM_LPALIGNUP(vaddr) - vaddr);
+              vaddr = SHM_LPALIGNUP(vaddr);
+            }
+
+          if (vend > vaddr + segsz)
+            {
+              gran_free(handle, (FAR void *)(vaddr + segsz),
+                        vend - vaddr - segsz);
+            }
+
+          return vaddr;
+        }
+    }
+#endif
+
+  return (uintptr_t)gran_alloc(handle, segsz);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -128,8 +192,7 @@ FAR void *shmat(int shmid, FAR const void *shmaddr, int shmflg)
 
   /* Set aside a virtual address space to span this physical region */
 
-  vaddr = (uintptr_t)gran_alloc(group->tg_shm.gs_handle,
-                                region->sr_ds.shm_segsz);
+  vaddr = shm_valloc(group->tg_shm.gs_handle, region);
   if (vaddr == 0)
     {
       shmerr("ERROR: gran_alloc() failed\n");
@@ -131,6 +131,82 @@ static int shm_reserve(key_t key, int shmflg)
   return -ENOSPC;
 }
 
+/****************************************************************************
+ * Name: shm_extend_contig
+ *
+ * Description:
+ *   Try to back a new, empty memory region with a single physically
+ *   contiguous run of pages.  Regions of at least one large page are also
+ *   aligned on a large page boundary so that the architecture may map them
+ *   with section descriptors.
+ *
+ * Input Parameters:
+ *   region - The region to be populated.  It must not yet own any pages.
+ *   npages - The number of pages needed.
+ *
+ * Returned Value:
+ *   Zero is returned on success; -ENOMEM is returned if no contiguous run
+ *   of pages is available.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_SHM_CONTIGUOUS
+static int shm_extend_contig(FAR struct shm_region_s *region,
+                             unsigned int npages)
+{
+  unsigned int extra = 0;
+  unsigned int lead = 0;
+  uintptr_t paddr = 0;
+  unsigned int i;
+
+  /* Over-allocate by up to one large page so that an aligned run can be
+   * carved out of the allocation.
+   */
+
+  if (npages >= SHM_LPPAGES)
+    {
+      extra = SHM_LPPAGES - 1;
+      paddr = mm_pgalloc(npages + extra);
+    }
+
+  if (paddr != 0)
+    {
+      /* Return the unaligned head and the unused tail to the allocator */
+
+      lead = (SHM_LPALIGNUP(paddr) - paddr) >> MM_PGSHIFT;
+      if (lead > 0)
+        {
+          mm_pgfree(paddr, lead);
+          paddr += (uintptr_t)lead << MM_PGSHIFT;
+        }
+
+      if (extra > lead)
+        {
+          mm_pgfree(paddr + ((uintptr_t)npages << MM_PGSHIFT),
+                    extra - lead);
+        }
+    }
+  else
+    {
+      /* No aligned run available, settle for a contiguous one */
+
+      paddr = mm_pgalloc(npages);
+      if (paddr == 0)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  for (i = 0; i < npages; i++)
+    {
+      region->sr_pages[i] = paddr + ((uintptr_t)i << MM_PGSHIFT);
+    }
+
+  region->sr_flags |= SRFLAG_CONTIG;
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: shm_extend
  *
@@ -163,6 +239,24 @@ static int shm_extend(int shmid, size_t size)
 
   pgalloc = MM_NPAGES(region->sr_ds.shm_segsz);
 
+#ifdef CONFIG_MM_SHM_CONTIGUOUS
+  /* A new region is preferably backed by one contiguous run of pages */
+
+  if (pgalloc == 0 && pgneeded > 1 && pgneeded <= CONFIG_ARCH_SHM_NPAGES &&
+      shm_extend_contig(region, pgneeded) == OK)
+    {
+      region->sr_ds.shm_segsz = size;
+      return OK;
+    }
+
+  /* Pages added one at a time break the contiguity of the region */
+
+  if (pgalloc < pgneeded)
+    {
+      region->sr_flags &= ~SRFLAG_CONTIG;
+    }
+#endif
+
   /* Loop until all pages have been allocated (or something bad happens) */
 
   while (pgalloc < pgneeded && pgalloc < CONFIG_ARCH_SHM_NPAGES)
@@ -351,24 +445,29 @@ int shmget(key_t key, size_t size, int shmflg)
   int shmid = -1;
   int ret;
 
-  /* Check for the special case where the caller doesn't really want shared
-   * memory (they why do they bother to call us?)
-   */
+  /* Get exclusive access to the global list of shared memory regions */
 
-  if (key == IPC_PRIVATE)
+  ret = nxsem_wait(&g_shminfo.si_sem);
+  if (ret < 0)
     {
-      /* Not yet implemented */
-
-      ret = -ENOSYS;
       goto errout;
     }
 
-  /* Get exclusive access to the global list of shared memory regions */
+  /* A private region is always created anew.  It can only be referenced
+   * through the returned identifier, never found by its key.
+   */
 
-  ret = nxsem_wait(&g_shminfo.si_sem);
-  if (ret < 0)
+  if (key == IPC_PRIVATE)
     {
-      goto errout;
+      ret = shm_create(key, size, shmflg);
+      if (ret < 0)
+        {
+          shmerr("ERROR: shm_create failed: %d\n", ret);
+          goto errout_with_semaphore;
+        }
+
+      nxsem_post(&g_shminfo.si_sem);
+      return ret;
     }
 
   /* Find the requested memory region */
@@ -449,7 +548,7 @@ int shmget(key_t key, size_t size, int shmflg)
        * then it is no longer deleted.
        */
 
-      region->sr_flags = SRFLAG_INUSE;
+      region->sr_flags &= ~SRFLAG_UNLINKED;
     }
 
   /* Release our lock on the shared memory region list */
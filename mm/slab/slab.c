@@ -0,0 +1,382 @@
+/****************************************************************************
+ * mm/slab/slab.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <string.h>
+#include <strings.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/slab.h>
+
+#ifdef CONFIG_MM_SLAB
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_MM_SLAB_SIZE & (CONFIG_MM_SLAB_SIZE - 1)) != 0
+#  error CONFIG_MM_SLAB_SIZE must be a power of two
+#endif
+
+#if (CONFIG_MM_SLAB_ALIGN & (CONFIG_MM_SLAB_ALIGN - 1)) != 0
+#  error CONFIG_MM_SLAB_ALIGN must be a power of two
+#endif
+
+#define SLAB_ALIGN_UP(a) \
+  (((a) + CONFIG_MM_SLAB_ALIGN - 1) & ~(CONFIG_MM_SLAB_ALIGN - 1))
+
+/* Each bitmap word tracks 32 objects; a set bit marks a free object */
+
+#define SLAB_NWORDS(n)   (((n) + 31) >> 5)
+
+/* Find the slab that holds an object */
+
+#define SLAB_OF(obj) \
+  ((FAR struct slab_s *)((uintptr_t)(obj) & ~(CONFIG_MM_SLAB_SIZE - 1)))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This is the header at the beginning of each slab.  The objects follow
+ * the header, starting at sc_hdrsize bytes from the beginning of the slab.
+ */
+
+struct slab_s
+{
+  dq_entry_t sl_node;          /* Link in sc_partial or sc_full */
+  uint16_t sl_inuse;           /* Number of allocated objects */
+  uint32_t sl_bitmap[1];       /* Free object bitmap (variable length) */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct slab_cache_s *g_slab_caches;
+static spinlock_t g_slab_lock;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: slab_grow
+ *
+ * Description:
+ *   Allocate a new slab from the kernel heap with all objects free.
+ *
+ ****************************************************************************/
+
+static FAR struct slab_s *slab_grow(FAR struct slab_cache_s *cache)
+{
+  FAR struct slab_s *slab;
+  int nwords;
+  int i;
+
+  slab = kmm_memalign(CONFIG_MM_SLAB_SIZE, CONFIG_MM_SLAB_SIZE);
+  if (slab == NULL)
+    {
+      return NULL;
+    }
+
+  slab->sl_inuse = 0;
+
+  /* Mark all objects free, except the bits beyond sc_nobjs */
+
+  nwords = SLAB_NWORDS(cache->sc_nobjs);
+  for (i = 0; i < nwords; i++)
+    {
+      slab->sl_bitmap[i] = UINT32_MAX;
+    }
+
+  if ((cache->sc_nobjs & 31) != 0)
+    {
+      slab->sl_bitmap[nwords - 1] = (1ul << (cache->sc_nobjs & 31)) - 1;
+    }
+
+  return slab;
+}
+
+/****************************************************************************
+ * Name: slab_take
+ *
+ * Description:
+ *   Take one free object from a slab that is known to have one.
+ *
+ * Assumptions:
+ *   The cache lock is held.
+ *
+ ****************************************************************************/
+
+static FAR void *slab_take(FAR struct slab_cache_s *cache,
+                           FAR struct slab_s *slab)
+{
+  int ndx;
+  int i;
+
+  for (i = 0; slab->sl_bitmap[i] == 0; i++)
+    {
+      DEBUGASSERT(i < SLAB_NWORDS(cache->sc_nobjs));
+    }
+
+  ndx = ffs(slab->sl_bitmap[i]) - 1;
+  slab->sl_bitmap[i] &= ~(1ul << ndx);
+  ndx += i << 5;
+
+  if (++slab->sl_inuse >= cache->sc_nobjs)
+    {
+      dq_rem(&slab->sl_node, &cache->sc_partial);
+      dq_addlast(&slab->sl_node, &cache->sc_full);
+    }
+
+  cache->sc_inuse++;
+  cache->sc_allocs++;
+
+  return (FAR char *)slab + cache->sc_hdrsize + ndx * cache->sc_objsize;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: slab_initialize
+ *
+ * Description:
+ *   Set up one slab cache for objects of the given size and register it
+ *   so that it is reported in /proc/slabinfo.
+ *
+ ****************************************************************************/
+
+int slab_initialize(FAR struct slab_cache_s *cache, FAR const char *name,
+                    size_t size)
+{
+  irqstate_t flags;
+  size_t hdrsize;
+  size_t nobjs;
+
+  DEBUGASSERT(cache != NULL && name != NULL && size > 0);
+
+  memset(cache, 0, sizeof(struct slab_cache_s));
+
+  cache->sc_name    = name;
+  cache->sc_size    = size;
+  cache->sc_objsize = SLAB_ALIGN_UP(size);
+
+  /* The bitmap size depends on the number of objects which depends on the
+   * header size.  Start with a guess that ignores the bitmap and shrink the
+   * object count until everything fits.
+   */
+
+  nobjs = (CONFIG_MM_SLAB_SIZE - sizeof(struct slab_s)) / cache->sc_objsize;
+  for (; ; )
+    {
+      hdrsize = SLAB_ALIGN_UP(sizeof(struct slab_s) +
+                              (SLAB_NWORDS(nobjs) - 1) * sizeof(uint32_t));
+      if (nobjs == 0 ||
+          hdrsize + nobjs * cache->sc_objsize <= CONFIG_MM_SLAB_SIZE)
+        {
+          break;
+        }
+
+      nobjs--;
+    }
+
+  if (nobjs == 0 || nobjs > UINT16_MAX)
+    {
+      merr("ERROR: %s: object size %zu does not fit a slab\n", name, size);
+      return -EINVAL;
+    }
+
+  cache->sc_hdrsize = hdrsize;
+  cache->sc_nobjs   = nobjs;
+
+  flags = spin_lock_irqsave(&g_slab_lock);
+  cache->sc_flink = g_slab_caches;
+  g_slab_caches   = cache;
+  spin_unlock_irqrestore(&g_slab_lock, flags);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: slab_alloc
+ *
+ * Description:
+ *   Allocate one object from the cache.
+ *
+ ****************************************************************************/
+
+FAR void *slab_alloc(FAR struct slab_cache_s *cache)
+{
+  FAR struct slab_s *slab;
+  FAR void *obj = NULL;
+  irqstate_t flags;
+
+  DEBUGASSERT(cache != NULL && cache->sc_nobjs > 0);
+
+  flags = spin_lock_irqsave(&cache->sc_lock);
+
+  slab = (FAR struct slab_s *)dq_peek(&cache->sc_partial);
+  if (slab != NULL)
+    {
+      obj = slab_take(cache, slab);
+    }
+
+  spin_unlock_irqrestore(&cache->sc_lock, flags);
+
+  /* If all slabs are full, then get a new one from the heap.  This is not
+   * possible from an interrupt handler.
+   */
+
+  if (obj == NULL)
+    {
+      slab = up_interrupt_context() ? NULL : slab_grow(cache);
+
+      flags = spin_lock_irqsave(&cache->sc_lock);
+
+      if (slab != NULL)
+        {
+          dq_addlast(&slab->sl_node, &cache->sc_partial);
+          cache->sc_nslabs++;
+          obj = slab_take(cache, slab);
+        }
+      else
+        {
+          cache->sc_fails++;
+        }
+
+      spin_unlock_irqrestore(&cache->sc_lock, flags);
+    }
+
+  return obj;
+}
+
+/****************************************************************************
+ * Name: slab_free
+ *
+ * Description:
+ *   Return one object to the cache it was allocated from.
+ *
+ ****************************************************************************/
+
+void slab_free(FAR struct slab_cache_s *cache, FAR void *obj)
+{
+  FAR struct slab_s *slab;
+  FAR struct slab_s *release = NULL;
+  irqstate_t flags;
+  size_t nfree;
+  int ndx;
+
+  if (obj == NULL)
+    {
+      return;
+    }
+
+  slab = SLAB_OF(obj);
+  ndx  = ((uintptr_t)obj - (uintptr_t)slab - cache->sc_hdrsize) /
+         cache->sc_objsize;
+
+  DEBUGASSERT(ndx < cache->sc_nobjs);
+
+  flags = spin_lock_irqsave(&cache->sc_lock);
+
+  /* Sanity check against double-frees */
+
+  DEBUGASSERT((slab->sl_bitmap[ndx >> 5] & (1ul << (ndx & 31))) == 0);
+  slab->sl_bitmap[ndx >> 5] |= 1ul << (ndx & 31);
+
+  if (slab->sl_inuse-- >= cache->sc_nobjs)
+    {
+      dq_rem(&slab->sl_node, &cache->sc_full);
+      dq_addlast(&slab->sl_node, &cache->sc_partial);
+    }
+
+  cache->sc_inuse--;
+
+  /* Give an empty slab back to the heap, but only if other slabs still
+   * have free objects.  That avoids bouncing one slab in and out of the
+   * heap when the object count hovers around a slab boundary.
+   */
+
+  nfree = cache->sc_nslabs * cache->sc_nobjs - cache->sc_inuse;
+  if (slab->sl_inuse == 0 && nfree > cache->sc_nobjs &&
+      !up_interrupt_context())
+    {
+      dq_rem(&slab->sl_node, &cache->sc_partial);
+      cache->sc_nslabs--;
+      release = slab;
+    }
+
+  spin_unlock_irqrestore(&cache->sc_lock, flags);
+
+  if (release != NULL)
+    {
+      kmm_free(release);
+    }
+}
+
+/****************************************************************************
+ * Name: slab_foreach
+ *
+ * Description:
+ *   Call the handler with the statistics of each registered cache.
+ *
+ ****************************************************************************/
+
+void slab_foreach(slab_handler_t handler, FAR void *arg)
+{
+  FAR struct slab_cache_s *cache;
+  struct slabinfo_s info;
+  irqstate_t flags;
+
+  /* Caches are never unregistered, so the list can be walked without
+   * holding g_slab_lock.
+   */
+
+  for (cache = g_slab_caches; cache != NULL; cache = cache->sc_flink)
+    {
+      flags = spin_lock_irqsave(&cache->sc_lock);
+
+      info.name    = cache->sc_name;
+      info.objsize = cache->sc_objsize;
+      info.nobjs   = cache->sc_nobjs;
+      info.nslabs  = cache->sc_nslabs;
+      info.inuse   = cache->sc_inuse;
+      info.allocs  = cache->sc_allocs;
+      info.fails   = cache->sc_fails;
+
+      spin_unlock_irqrestore(&cache->sc_lock, flags);
+
+      handler(&info, arg);
+    }
+}
+
+#endif /* CONFIG_MM_SLAB */
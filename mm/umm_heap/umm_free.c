@@ -48,3 +48,16 @@ void free(FAR void *mem)
 {
   mm_free(USR_HEAP, mem);
 }
+
+/****************************************************************************
+ * Name: umm_free_delaylist
+ *
+ * Description:
+ *   Free the chunks of the user heap whose deallocation had to be delayed.
+ *
+ ****************************************************************************/
+
+void umm_free_delaylist(void)
+{
+  mm_free_delaylist(USR_HEAP);
+}
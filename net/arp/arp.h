@@ -422,6 +422,52 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
 void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
                     FAR uint8_t *ethaddr);
 
+/****************************************************************************
+ * Name: arp_hold
+ *
+ * Description:
+ *   Keep a copy of the IPv4 packet in d_buf that cannot be sent until the
+ *   MAC address of 'ipaddr' is known.  Only the most recent packet is kept
+ *   for each address.
+ *
+ * Input Parameters:
+ *   dev    - The device that the packet is being sent on
+ *   ipaddr - The next hop IP address being resolved
+ *
+ * Assumptions
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_ARP_NHOLD > 0
+void arp_hold(FAR struct net_driver_s *dev, in_addr_t ipaddr);
+#else
+#  define arp_hold(d,i)
+#endif
+
+/****************************************************************************
+ * Name: arp_hold_release
+ *
+ * Description:
+ *   Send the packet held for 'ipaddr' (if any) now that its MAC address is
+ *   known.  The packet is placed in d_buf with the Ethernet header and
+ *   d_len is set, so the driver sends it as the response to the ARP reply.
+ *
+ * Input Parameters:
+ *   dev    - The device that received the ARP reply
+ *   ipaddr - The IP address that was resolved
+ *
+ * Assumptions
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_ARP_NHOLD > 0
+void arp_hold_release(FAR struct net_driver_s *dev, in_addr_t ipaddr);
+#else
+#  define arp_hold_release(d,i)
+#endif
+
 /****************************************************************************
  * Name: arp_snapshot
  *
@@ -485,6 +531,8 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 #  define arp_cleanup(d)
 #  define arp_update(d,i,m);
 #  define arp_hdr_update(d,i,m);
+#  define arp_hold(d,i)
+#  define arp_hold_release(d,i)
 #  define arp_snapshot(s,n) (0)
 #  define arp_dump(arp)
 
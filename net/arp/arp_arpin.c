@@ -157,6 +157,10 @@ void arp_arpin(FAR struct net_driver_s *dev)
             /* Then notify any logic waiting for the ARP result */
 
             arp_notify(net_ip4addr_conv32(arp->ah_sipaddr));
+
+            /* And send any packet that was held for this address */
+
+            arp_hold_release(dev, net_ip4addr_conv32(arp->ah_sipaddr));
           }
         break;
     }
@@ -47,6 +47,7 @@
 #ifdef CONFIG_NET
 
 #include <sys/ioctl.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include <debug.h>
@@ -55,6 +56,8 @@
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -72,6 +75,47 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+/* The ARP table is indexed by a hash of the IP address.  The number of
+ * buckets is the smallest power of two not less than the table size, so
+ * chains are short even when the table is full.
+ */
+
+#if CONFIG_NET_ARPTAB_SIZE <= 8
+#  define ARP_HASH_BITS 3
+#elif CONFIG_NET_ARPTAB_SIZE <= 16
+#  define ARP_HASH_BITS 4
+#elif CONFIG_NET_ARPTAB_SIZE <= 32
+#  define ARP_HASH_BITS 5
+#elif CONFIG_NET_ARPTAB_SIZE <= 64
+#  define ARP_HASH_BITS 6
+#elif CONFIG_NET_ARPTAB_SIZE <= 128
+#  define ARP_HASH_BITS 7
+#elif CONFIG_NET_ARPTAB_SIZE <= 256
+#  define ARP_HASH_BITS 8
+#elif CONFIG_NET_ARPTAB_SIZE <= 512
+#  define ARP_HASH_BITS 9
+#else
+#  define ARP_HASH_BITS 10
+#endif
+
+#define ARP_HASH_SIZE   (1 << ARP_HASH_BITS)
+#define ARP_HASH(a)     (((uint32_t)(a) * 2654435761u) >> (32 - ARP_HASH_BITS))
+
+/* Links in the hash chains are table indices plus one; zero ends a chain */
+
+#define ARP_NOENTRY     0
+
+/* Period of the background worker that retires expired entries and the
+ * maximum time that a packet is held waiting for an ARP reply.
+ */
+
+#define ARP_AGING_TICK  SEC2TICK(10)
+#define ARP_HOLD_TICK   SEC2TICK(3)
+
+#ifndef CONFIG_NET_ARP_NHOLD
+#  define CONFIG_NET_ARP_NHOLD 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -82,6 +126,18 @@ struct arp_table_info_s
   FAR struct ether_addr *ai_ethaddr;  /* Location to return the MAC address */
 };
 
+#if CONFIG_NET_ARP_NHOLD > 0
+/* A packet held while the MAC address of its next hop is being resolved */
+
+struct arp_hold_s
+{
+  in_addr_t                ah_ipaddr; /* IP address being resolved */
+  clock_t                  ah_time;   /* Time the packet was held */
+  FAR struct net_driver_s *ah_dev;    /* Device the packet was sent on */
+  FAR struct iob_s        *ah_iob;    /* The IP packet, NULL if unused */
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -90,10 +146,232 @@ struct arp_table_info_s
 
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
 
+/* Hash buckets and chain links over g_arptable[] */
+
+static uint16_t g_arphash[ARP_HASH_SIZE];
+static uint16_t g_arpnext[CONFIG_NET_ARPTAB_SIZE];
+
+/* Time of last use of each entry, used to evict the least recently used
+ * entry when the table is full.  at_time holds the time that the mapping
+ * was last confirmed and controls expiry.
+ */
+
+static clock_t g_arpused[CONFIG_NET_ARPTAB_SIZE];
+
+#if CONFIG_NET_ARP_NHOLD > 0
+/* Packets waiting for ARP replies */
+
+static struct arp_hold_s g_arphold[CONFIG_NET_ARP_NHOLD];
+#endif
+
+#ifdef CONFIG_SCHED_LPWORK
+/* Background aging of the table */
+
+static struct work_s g_arpwork;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: arp_hash_find
+ *
+ * Description:
+ *   Return the index of the table entry holding 'ipaddr', expired or not,
+ *   or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static int arp_hash_find(in_addr_t ipaddr)
+{
+  uint16_t link = g_arphash[ARP_HASH(ipaddr)];
+
+  while (link != ARP_NOENTRY)
+    {
+      int ndx = link - 1;
+
+      if (net_ipv4addr_cmp(g_arptable[ndx].at_ipaddr, ipaddr))
+        {
+          return ndx;
+        }
+
+      link = g_arpnext[ndx];
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: arp_hash_insert
+ ****************************************************************************/
+
+static void arp_hash_insert(int ndx)
+{
+  FAR uint16_t *head = &g_arphash[ARP_HASH(g_arptable[ndx].at_ipaddr)];
+
+  g_arpnext[ndx] = *head;
+  *head          = ndx + 1;
+}
+
+/****************************************************************************
+ * Name: arp_entry_free
+ *
+ * Description:
+ *   Unlink a used entry from its hash chain and clear it.
+ *
+ ****************************************************************************/
+
+static void arp_entry_free(int ndx)
+{
+  FAR uint16_t *link = &g_arphash[ARP_HASH(g_arptable[ndx].at_ipaddr)];
+
+  while (*link != ARP_NOENTRY)
+    {
+      if (*link == ndx + 1)
+        {
+          *link = g_arpnext[ndx];
+          break;
+        }
+
+      link = &g_arpnext[*link - 1];
+    }
+
+  memset(&g_arptable[ndx], 0, sizeof(g_arptable[ndx]));
+  g_arpnext[ndx] = ARP_NOENTRY;
+}
+
+/****************************************************************************
+ * Name: arp_entry_alloc
+ *
+ * Description:
+ *   Select the entry to hold a new mapping: a free entry if there is one,
+ *   else the longest expired entry, else the least recently used one.
+ *
+ ****************************************************************************/
+
+static int arp_entry_alloc(clock_t now)
+{
+  clock_t oldest = 0;
+  bool expired = false;
+  int victim = 0;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; i++)
+    {
+      FAR struct arp_entry_s *tabptr = &g_arptable[i];
+
+      if (tabptr->at_ipaddr == 0)
+        {
+          return i;
+        }
+
+      if (now - tabptr->at_time > ARP_MAXAGE_TICK)
+        {
+          if (!expired || now - tabptr->at_time > oldest)
+            {
+              expired = true;
+              oldest  = now - tabptr->at_time;
+              victim  = i;
+            }
+        }
+      else if (!expired && now - g_arpused[i] > oldest)
+        {
+          oldest = now - g_arpused[i];
+          victim = i;
+        }
+    }
+
+  arp_entry_free(victim);
+  return victim;
+}
+
+#if CONFIG_NET_ARP_NHOLD > 0
+/****************************************************************************
+ * Name: arp_hold_free
+ ****************************************************************************/
+
+static void arp_hold_free(FAR struct arp_hold_s *hold)
+{
+  iob_free_chain(hold->ah_iob, IOBUSER_NET_ARP_HOLD);
+  hold->ah_iob = NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: arp_aging_work
+ *
+ * Description:
+ *   Retire expired ARP entries and stale held packets.  Runs on the low
+ *   priority work queue while there is anything left to age.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LPWORK
+static void arp_aging_work(FAR void *arg)
+{
+  clock_t now;
+  bool busy = false;
+  int i;
+
+  net_lock();
+  now = clock_systime_ticks();
+
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; i++)
+    {
+      if (g_arptable[i].at_ipaddr != 0)
+        {
+          if (now - g_arptable[i].at_time > ARP_MAXAGE_TICK)
+            {
+              arp_entry_free(i);
+            }
+          else
+            {
+              busy = true;
+            }
+        }
+    }
+
+#if CONFIG_NET_ARP_NHOLD > 0
+  for (i = 0; i < CONFIG_NET_ARP_NHOLD; i++)
+    {
+      if (g_arphold[i].ah_iob != NULL)
+        {
+          if (now - g_arphold[i].ah_time > ARP_HOLD_TICK)
+            {
+              arp_hold_free(&g_arphold[i]);
+            }
+          else
+            {
+              busy = true;
+            }
+        }
+    }
+#endif
+
+  if (busy)
+    {
+      work_queue(LPWORK, &g_arpwork, arp_aging_work, NULL, ARP_AGING_TICK);
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: arp_aging_start
+ ****************************************************************************/
+
+static void arp_aging_start(void)
+{
+  if (work_available(&g_arpwork))
+    {
+      work_queue(LPWORK, &g_arpwork, arp_aging_work, NULL, ARP_AGING_TICK);
+    }
+}
+#else
+#  define arp_aging_start()
+#endif
+
 /****************************************************************************
  * Name: arp_match
  *
@@ -140,35 +418,6 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
   return 1;
 }
 
-/****************************************************************************
- * Name: arp_return_old_entry
- *
- * Description:
- *   Compare and return the old ARP table entry.
- *
- ****************************************************************************/
-
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
-{
-  if (e1->at_ipaddr == 0)
-    {
-      return e1;
-    }
-  else if (e2->at_ipaddr == 0)
-    {
-      return e2;
-    }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
-    {
-      return e1;
-    }
-  else
-    {
-      return e2;
-    }
-}
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -197,44 +446,33 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
-  int i;
+  FAR struct arp_entry_s *tabptr;
+  clock_t now = clock_systime_ticks();
+  int ndx;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* Find the entry to update.  If none is found, the IP -> MAC address
+   * mapping is inserted in the ARP table, replacing a free, expired or
+   * least recently used entry.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  ndx = arp_hash_find(ipaddr);
+  if (ndx < 0)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
-
-      if (g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
-        {
-          /* An old entry found, break. */
-
-          tabptr = &g_arptable[i];
-          break;
-        }
-      else
-        {
-          /* Record the oldest entry. */
-
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
+      ndx = arp_entry_alloc(now);
+      g_arptable[ndx].at_ipaddr = ipaddr;
+      arp_hash_insert(ndx);
+      arp_aging_start();
     }
 
   /* Now, tabptr is the ARP table entry which we will fill with the new
    * information.
    */
 
-  tabptr->at_ipaddr = ipaddr;
+  tabptr = &g_arptable[ndx];
   memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_dev = dev;
-  tabptr->at_time = clock_systime_ticks();
+  tabptr->at_dev  = dev;
+  tabptr->at_time = now;
+  g_arpused[ndx]  = now;
   return OK;
 }
 
@@ -286,19 +524,16 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
 
 FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
-  int i;
+  clock_t now = clock_systime_ticks();
+  int ndx;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  ndx = arp_hash_find(ipaddr);
+  if (ndx >= 0 && now - g_arptable[ndx].at_time <= ARP_MAXAGE_TICK)
     {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
+      g_arpused[ndx] = now;
+      return &g_arptable[ndx];
     }
 
   /* Not found */
@@ -385,16 +620,16 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 
 void arp_delete(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
+  int ndx;
 
   /* Check if the IPv4 address is in the ARP table. */
 
-  tabptr = arp_lookup(ipaddr);
-  if (tabptr != NULL)
+  ndx = arp_hash_find(ipaddr);
+  if (ndx >= 0)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. remove it */
 
-      tabptr->at_ipaddr = 0;
+      arp_entry_free(ndx);
     }
 }
 
@@ -418,13 +653,135 @@ void arp_cleanup(FAR struct net_driver_s *dev)
 
   for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
     {
-      if (dev == g_arptable[i].at_dev)
+      if (g_arptable[i].at_ipaddr != 0 && dev == g_arptable[i].at_dev)
+        {
+          arp_entry_free(i);
+        }
+    }
+
+#if CONFIG_NET_ARP_NHOLD > 0
+  for (i = 0; i < CONFIG_NET_ARP_NHOLD; i++)
+    {
+      if (g_arphold[i].ah_iob != NULL && g_arphold[i].ah_dev == dev)
         {
-          memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
+          arp_hold_free(&g_arphold[i]);
         }
     }
+#endif
 }
 
+#if CONFIG_NET_ARP_NHOLD > 0
+/****************************************************************************
+ * Name: arp_hold
+ *
+ * Description:
+ *   Keep a copy of the IPv4 packet in d_buf that cannot be sent until the
+ *   MAC address of 'ipaddr' is known.  As in BSD, only the most recent
+ *   packet is kept for each address.  If all hold slots are in use, the
+ *   oldest held packet is dropped.
+ *
+ * Input Parameters:
+ *   dev    - The device that the packet is being sent on
+ *   ipaddr - The next hop IP address being resolved
+ *
+ * Assumptions
+ *   The network is locked.  The IP packet starts at d_buf[ETH_HDRLEN] and
+ *   holds d_len bytes.
+ *
+ ****************************************************************************/
+
+void arp_hold(FAR struct net_driver_s *dev, in_addr_t ipaddr)
+{
+  FAR struct arp_hold_s *hold = NULL;
+  FAR struct iob_s *iob;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_ARP_NHOLD; i++)
+    {
+      FAR struct arp_hold_s *tmp = &g_arphold[i];
+
+      if (tmp->ah_iob != NULL && tmp->ah_dev == dev &&
+          net_ipv4addr_cmp(tmp->ah_ipaddr, ipaddr))
+        {
+          hold = tmp;
+          break;
+        }
+
+      if (hold == NULL || tmp->ah_iob == NULL ||
+          (hold->ah_iob != NULL &&
+           (int)(tmp->ah_time - hold->ah_time) < 0))
+        {
+          hold = tmp;
+        }
+    }
+
+  if (hold->ah_iob != NULL)
+    {
+      arp_hold_free(hold);
+    }
+
+  iob = iob_tryalloc(false, IOBUSER_NET_ARP_HOLD);
+  if (iob == NULL)
+    {
+      return;
+    }
+
+  if (iob_trycopyin(iob, &dev->d_buf[ETH_HDRLEN], dev->d_len, 0, false,
+                    IOBUSER_NET_ARP_HOLD) < 0)
+    {
+      iob_free_chain(iob, IOBUSER_NET_ARP_HOLD);
+      return;
+    }
+
+  hold->ah_ipaddr = ipaddr;
+  hold->ah_dev    = dev;
+  hold->ah_time   = clock_systime_ticks();
+  hold->ah_iob    = iob;
+
+  arp_aging_start();
+}
+
+/****************************************************************************
+ * Name: arp_hold_release
+ *
+ * Description:
+ *   Called when the MAC address of 'ipaddr' has been learned from an ARP
+ *   reply.  If a packet was held for that address, it is copied back into
+ *   d_buf and passed through arp_out() so that the driver sends it in
+ *   place of the (empty) response to the ARP reply.
+ *
+ * Assumptions
+ *   The network is locked and d_len is zero on entry.
+ *
+ ****************************************************************************/
+
+void arp_hold_release(FAR struct net_driver_s *dev, in_addr_t ipaddr)
+{
+  FAR struct arp_hold_s *hold;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_ARP_NHOLD; i++)
+    {
+      hold = &g_arphold[i];
+      if (hold->ah_iob != NULL && hold->ah_dev == dev &&
+          net_ipv4addr_cmp(hold->ah_ipaddr, ipaddr))
+        {
+          unsigned int len = hold->ah_iob->io_pktlen;
+
+          if (len + ETH_HDRLEN <= NETDEV_PKTSIZE(dev))
+            {
+              iob_copyout(&dev->d_buf[ETH_HDRLEN], hold->ah_iob, len, 0);
+              dev->d_len = len;
+              arp_out(dev);
+            }
+
+          arp_hold_free(hold);
+          break;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: arp_snapshot
  *
@@ -56,6 +56,15 @@
 #define can_callback_free(dev,conn,cb) \
   devif_conn_callback_free(dev, cb, &conn->sconn.list, &conn->sconn.list_tail)
 
+/* Frames are packed into the read-ahead I/O buffers as records.  Each
+ * record starts with one byte that holds the length of the frame and tells
+ * if a struct timeval with the receive time follows the frame.
+ */
+
+#define CAN_RECHDR_LEN       1
+#define CAN_RECHDR_TIMESTAMP 0x80
+#define CAN_RECHDR_LENMASK   0x7f
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -107,6 +116,9 @@ struct can_conn_s
 #endif
   struct can_filter filters[CONFIG_NET_CAN_RAW_FILTER_MAX];
   int32_t filter_count;
+#  ifdef CONFIG_NET_CAN_RAW_FILTER_HW
+  uint8_t hwfilter_count;            /* Filters pushed to conn->dev */
+#  endif
 # ifdef CONFIG_NET_CAN_RAW_TX_DEADLINE
   int32_t tx_deadline;
 # endif
@@ -314,6 +326,73 @@ ssize_t can_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 void can_readahead_signal(FAR struct can_conn_s *conn);
 #endif
 
+/****************************************************************************
+ * Name: can_recv_filter
+ *
+ * Description:
+ *   Check if the CAN_RAW_FILTER filters of a connection accept a frame with
+ *   the given CAN ID.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection that would receive the frame
+ *   id   - The CAN ID of the frame
+ *
+ * Returned Value:
+ *   Non-zero if the frame is accepted, zero if it has to be dropped.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+int can_recv_filter(FAR struct can_conn_s *conn, canid_t id);
+#endif
+
+/****************************************************************************
+ * Name: can_hwfilter_remove
+ *
+ * Description:
+ *   Remove the acceptance filters that were pushed down to the controller
+ *   of a CAN device.  This must be called before the filters or the device
+ *   binding of any connection change.
+ *
+ * Input Parameters:
+ *   dev - The CAN device, or NULL for all CAN devices
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CAN_RAW_FILTER_HW
+void can_hwfilter_remove(FAR struct net_driver_s *dev);
+#else
+#  define can_hwfilter_remove(dev)
+#endif
+
+/****************************************************************************
+ * Name: can_hwfilter_add
+ *
+ * Description:
+ *   Push the CAN_RAW_FILTER filters of the connections bound to a CAN
+ *   device down to the acceptance filters of its controller.  This is only
+ *   done if the union of the filters can be expressed in hardware, i.e.
+ *   every connection receiving from the device has a set of non-inverted
+ *   filters for a fixed frame format, and if the driver accepts all of
+ *   them.  Otherwise the controller is left accepting all frames.
+ *
+ * Input Parameters:
+ *   dev - The CAN device, or NULL for all CAN devices
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CAN_RAW_FILTER_HW
+void can_hwfilter_add(FAR struct net_driver_s *dev);
+#else
+#  define can_hwfilter_add(dev)
+#endif
+
 /****************************************************************************
  * Name: can_setsockopt
  *
@@ -26,6 +26,7 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_CAN)
 
 #include <stdint.h>
+#include <string.h>
 #include <debug.h>
 
 #include <nuttx/net/netconfig.h>
@@ -140,11 +141,21 @@ uint16_t can_callback(FAR struct net_driver_s *dev,
       if (net_trylock() == OK)
         {
           flags = devif_conn_event(dev, conn, flags, conn->sconn.list);
+
+          /* There is no application listening, store the frame in the
+           * read-ahead buffer while the network is still locked.
+           */
+
+          if ((flags & CAN_NEWDATA) != 0)
+            {
+              flags = can_data_event(dev, conn, flags);
+            }
+
           net_unlock();
         }
 
-      /* Either we did not get the lock or there is no application listening
-       * If we did not get a lock we store the frame in the read-ahead buffer
+      /* If we did not get a lock we store the frame in the read-ahead
+       * buffer
        */
 
       if ((flags & CAN_NEWDATA) != 0)
@@ -177,6 +188,10 @@ uint16_t can_callback(FAR struct net_driver_s *dev,
  *   The number of bytes actually buffered is returned.  This will be either
  *   zero or equal to buflen; partial packets are not buffered.
  *
+ *   The frame is stored as a record (see CAN_RECHDR_LEN).  Small frames
+ *   are appended to the last I/O buffer of the read-ahead queue as long as
+ *   they fit, so that one I/O buffer holds several of them.
+ *
  * Assumptions:
  * - The caller has checked that CAN_NEWDATA is set in flags and that is no
  *   other handler available to process the incoming data.
@@ -188,8 +203,49 @@ uint16_t can_datahandler(FAR struct can_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t buflen)
 {
   FAR struct iob_s *iob;
+  uint16_t framelen = buflen;
+  uint8_t hdr = 0;
   int ret;
 
+  /* The record header holds the length of the frame without the timestamp
+   * that can_callback() may have added behind it.
+   */
+
+#ifdef CONFIG_NET_TIMESTAMP
+  if (conn->sconn.s_timestamp && buflen > sizeof(struct timeval))
+    {
+      framelen -= sizeof(struct timeval);
+      hdr       = CAN_RECHDR_TIMESTAMP;
+    }
+#endif
+
+  if (framelen > CAN_RECHDR_LENMASK)
+    {
+      nerr("ERROR: Frame of %u bytes is too large\n", framelen);
+      return 0;
+    }
+
+  hdr |= framelen;
+
+  /* Append the record to the last I/O buffer if there is room for it */
+
+  if (conn->readahead.qh_tail != NULL)
+    {
+      iob = conn->readahead.qh_tail->qe_head;
+      if (iob->io_flink == NULL &&
+          iob->io_offset + iob->io_len + CAN_RECHDR_LEN + buflen <=
+          CONFIG_IOB_BUFSIZE)
+        {
+          IOB_DATA(iob)[iob->io_len] = hdr;
+          memcpy(IOB_DATA(iob) + iob->io_len + CAN_RECHDR_LEN, buffer,
+                 buflen);
+
+          iob->io_len    += CAN_RECHDR_LEN + buflen;
+          iob->io_pktlen += CAN_RECHDR_LEN + buflen;
+          goto out;
+        }
+    }
+
   /* Try to allocate on I/O buffer to start the chain without waiting (and
    * throttling as necessary).  If we would have to wait, then drop the
    * packet.
@@ -204,8 +260,14 @@ uint16_t can_datahandler(FAR struct can_conn_s *conn, FAR uint8_t *buffer,
 
   /* Copy the new appdata into the I/O buffer chain (without waiting) */
 
-  ret = iob_trycopyin(iob, buffer, buflen, 0, true,
+  ret = iob_trycopyin(iob, &hdr, CAN_RECHDR_LEN, 0, true,
                       IOBUSER_NET_CAN_READAHEAD);
+  if (ret >= 0)
+    {
+      ret = iob_trycopyin(iob, buffer, buflen, CAN_RECHDR_LEN, true,
+                          IOBUSER_NET_CAN_READAHEAD);
+    }
+
   if (ret < 0)
     {
       /* On a failure, iob_copyin return a negated error value but does
@@ -229,6 +291,7 @@ uint16_t can_datahandler(FAR struct can_conn_s *conn, FAR uint8_t *buffer,
       return 0;
     }
 
+out:
 #ifdef CONFIG_NET_CAN_NOTIFIER
   /* Provide notification(s) that additional CAN read-ahead data is
    * available.
@@ -0,0 +1,321 @@
+/****************************************************************************
+ * net/can/can_filter.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <net/if.h>
+#include <netpacket/can.h>
+
+#include <nuttx/can/can.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ioctl.h>
+
+#include "netdev/netdev.h"
+#include "can/can.h"
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The filter types of the CAN character driver are only visible with
+ * CONFIG_CAN, but the SIOCxCANxxxFILTER commands use the same values.
+ */
+
+#ifndef CAN_FILTER_MASK
+#  define CAN_FILTER_MASK  0
+#endif
+
+#ifndef CAN_MSGPRIO_LOW
+#  define CAN_MSGPRIO_LOW  0
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CAN_RAW_FILTER_HW
+
+/****************************************************************************
+ * Name: can_hwfilter_eligible
+ *
+ * Description:
+ *   Check if the controller may drop every frame that the filters of a
+ *   connection reject.  That is the case if none of the filters is
+ *   inverted and each of them matches only one frame format.
+ *
+ ****************************************************************************/
+
+static bool can_hwfilter_eligible(FAR struct can_conn_s *conn)
+{
+  int i;
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      if ((conn->filters[i].can_id & CAN_INV_FILTER) != 0 ||
+          (conn->filters[i].can_mask & CAN_EFF_FLAG) == 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: can_hwfilter_ioctl
+ *
+ * Description:
+ *   Add or delete the acceptance filter of the controller that matches one
+ *   CAN_RAW_FILTER filter.
+ *
+ ****************************************************************************/
+
+static int can_hwfilter_ioctl(FAR struct net_driver_s *dev,
+                              FAR const struct can_filter *filter,
+                              bool add)
+{
+  struct can_ioctl_filter_s req;
+  int cmd;
+
+  if (dev->d_ioctl == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  if ((filter->can_id & CAN_EFF_FLAG) != 0)
+    {
+      cmd      = add ? SIOCACANEXTFILTER : SIOCDCANEXTFILTER;
+      req.fid1 = filter->can_id & CAN_EFF_MASK;
+      req.fid2 = filter->can_mask & CAN_EFF_MASK;
+    }
+  else
+    {
+      cmd      = add ? SIOCACANSTDFILTER : SIOCDCANSTDFILTER;
+      req.fid1 = filter->can_id & CAN_SFF_MASK;
+      req.fid2 = filter->can_mask & CAN_SFF_MASK;
+    }
+
+  req.ftype = CAN_FILTER_MASK;
+  req.fprio = CAN_MSGPRIO_LOW;
+
+  return dev->d_ioctl(dev, cmd, (unsigned long)(uintptr_t)&req);
+}
+
+/****************************************************************************
+ * Name: can_hwfilter_callback
+ *
+ * Description:
+ *   netdev_foreach() callback that updates the filters of each CAN device.
+ *
+ ****************************************************************************/
+
+static int can_hwfilter_callback(FAR struct net_driver_s *dev,
+                                 FAR void *arg)
+{
+  if (dev->d_lltype == NET_LL_CAN)
+    {
+      can_hwfilter_add(dev);
+    }
+
+  return 0;
+}
+
+#endif /* CONFIG_NET_CAN_RAW_FILTER_HW */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_recv_filter
+ *
+ * Description:
+ *   Check if the CAN_RAW_FILTER filters of a connection accept a frame with
+ *   the given CAN ID.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection that would receive the frame
+ *   id   - The CAN ID of the frame
+ *
+ * Returned Value:
+ *   Non-zero if the frame is accepted, zero if it has to be dropped.
+ *
+ ****************************************************************************/
+
+int can_recv_filter(FAR struct can_conn_s *conn, canid_t id)
+{
+  int i;
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      if (conn->filters[i].can_id & CAN_INV_FILTER)
+        {
+          if ((id & conn->filters[i].can_mask) !=
+                ((conn->filters[i].can_id & ~CAN_INV_FILTER) &
+                conn->filters[i].can_mask))
+            {
+              return 1;
+            }
+        }
+      else
+        {
+          if ((id & conn->filters[i].can_mask) ==
+                (conn->filters[i].can_id & conn->filters[i].can_mask))
+            {
+              return 1;
+            }
+        }
+    }
+
+  return 0;
+}
+
+#ifdef CONFIG_NET_CAN_RAW_FILTER_HW
+
+/****************************************************************************
+ * Name: can_hwfilter_remove
+ *
+ * Description:
+ *   Remove the acceptance filters that were pushed down to the controller
+ *   of a CAN device.  This must be called before the filters or the device
+ *   binding of any connection change.
+ *
+ * Input Parameters:
+ *   dev - The CAN device, or NULL for all CAN devices
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void can_hwfilter_remove(FAR struct net_driver_s *dev)
+{
+  FAR struct can_conn_s *conn = NULL;
+  int i;
+
+  net_lock();
+
+  while ((conn = can_nextconn(conn)) != NULL)
+    {
+      if (conn->dev == NULL || (dev != NULL && conn->dev != dev))
+        {
+          continue;
+        }
+
+      for (i = 0; i < conn->hwfilter_count; i++)
+        {
+          can_hwfilter_ioctl(conn->dev, &conn->filters[i], false);
+        }
+
+      conn->hwfilter_count = 0;
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: can_hwfilter_add
+ *
+ * Description:
+ *   Push the CAN_RAW_FILTER filters of the connections bound to a CAN
+ *   device down to the acceptance filters of its controller.  This is only
+ *   done if the union of the filters can be expressed in hardware, i.e.
+ *   every connection receiving from the device has a set of non-inverted
+ *   filters for a fixed frame format, and if the driver accepts all of
+ *   them.  Otherwise the controller is left accepting all frames.
+ *
+ * Input Parameters:
+ *   dev - The CAN device, or NULL for all CAN devices
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void can_hwfilter_add(FAR struct net_driver_s *dev)
+{
+  FAR struct can_conn_s *conn = NULL;
+  int ret;
+  int i;
+
+  net_lock();
+
+  if (dev == NULL)
+    {
+      netdev_foreach(can_hwfilter_callback, NULL);
+      net_unlock();
+      return;
+    }
+
+  /* A connection that is not bound receives the frames of all devices */
+
+  while ((conn = can_nextconn(conn)) != NULL)
+    {
+      if ((conn->dev == NULL || conn->dev == dev) &&
+          !can_hwfilter_eligible(conn))
+        {
+          net_unlock();
+          return;
+        }
+    }
+
+  while ((conn = can_nextconn(conn)) != NULL)
+    {
+      if (conn->dev != dev)
+        {
+          continue;
+        }
+
+      for (i = conn->hwfilter_count; i < conn->filter_count; i++)
+        {
+          ret = can_hwfilter_ioctl(dev, &conn->filters[i], true);
+          if (ret < 0)
+            {
+              /* The controller cannot take all of the filters, so let it
+               * accept everything and filter in software only.
+               */
+
+              ninfo("No hardware filters on %s: %d\n", dev->d_ifname, ret);
+              can_hwfilter_remove(dev);
+              net_unlock();
+              return;
+            }
+
+          conn->hwfilter_count = i + 1;
+        }
+    }
+
+  net_unlock();
+}
+
+#endif /* CONFIG_NET_CAN_RAW_FILTER_HW */
+#endif /* CONFIG_NET_CANPROTO_OPTIONS */
@@ -26,6 +26,7 @@
 #include <nuttx/config.h>
 #if defined(CONFIG_NET) && defined(CONFIG_NET_CAN)
 
+#include <stdbool.h>
 #include <errno.h>
 #include <debug.h>
 
@@ -154,24 +155,37 @@ const uint8_t len_to_can_dlc[65] =
 int can_input(struct net_driver_s *dev)
 {
   FAR struct can_conn_s *conn = NULL;
+  uint16_t buflen = dev->d_len;
+  bool delivered = false;
   int ret = OK;
 
-  do
-    {
-      /* FIXME Support for multiple sockets??? */
-
-      conn = can_nextconn(conn);
-    }
-  while (conn && conn->dev != 0 && dev != conn->dev);
+  /* Every connection bound to the device (or to all devices) whose filters
+   * accept the frame gets its own copy.  The filters are evaluated here,
+   * once per frame, so that rejected frames are never buffered.
+   */
 
-  if (conn)
+  while ((conn = can_nextconn(conn)) != NULL)
     {
       uint16_t flags;
 
+      if (conn->dev != NULL && conn->dev != dev)
+        {
+          continue;
+        }
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+      if (can_recv_filter(conn, *(FAR canid_t *)dev->d_buf) == 0)
+        {
+          continue;
+        }
+#endif
+
       /* Setup for the application callback */
 
       dev->d_appdata = dev->d_buf;
+      dev->d_len     = buflen;
       dev->d_sndlen  = 0;
+      delivered      = true;
 
       /* Perform the application callback */
 
@@ -184,20 +198,24 @@ int can_input(struct net_driver_s *dev)
       if ((flags & CAN_NEWDATA) != 0)
         {
           /* No.. the packet was not processed now.  Return -EAGAIN so
-           * that the driver may retry again later.  We still need to
-           * set d_len to zero so that the driver is aware that there
-           * is nothing to be sent.
+           * that the driver may retry again later.
            */
 
            nwarn("WARNING: Packet not processed\n");
            ret = -EAGAIN;
         }
     }
-  else
+
+  if (!delivered)
     {
       ninfo("No CAN listener\n");
     }
 
+  /* We still need to set d_len to zero so that the driver is aware that
+   * there is nothing to be sent.
+   */
+
+  dev->d_len = 0;
   return ret;
 }
 
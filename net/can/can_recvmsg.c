@@ -27,6 +27,7 @@
 #ifdef CONFIG_NET_CAN
 
 #include <sys/types.h>
+#include <sys/param.h>
 #include <sys/socket.h>
 #include <stdint.h>
 #include <string.h>
@@ -101,54 +102,12 @@ static inline void can_add_recvlen(FAR struct can_recvfrom_s *pstate,
   pstate->pr_buflen  -= recvlen;
 }
 
-/****************************************************************************
- * Name: can_recvfrom_newdata
- *
- * Description:
- *   Copy the read data from the packet
- *
- * Input Parameters:
- *   dev      The structure of the network driver that caused the event.
- *   pstate   recvfrom state structure
- *
- * Returned Value:
- *   None.
- *
- * Assumptions:
- *   The network is locked.
- *
- ****************************************************************************/
-
-static size_t can_recvfrom_newdata(FAR struct net_driver_s *dev,
-                                 FAR struct can_recvfrom_s *pstate)
-{
-  size_t recvlen;
-
-  if (dev->d_len > pstate->pr_buflen)
-    {
-      recvlen = pstate->pr_buflen;
-    }
-  else
-    {
-      recvlen = dev->d_len;
-    }
-
-  /* Copy the new packet data into the user buffer */
-
-  memcpy(pstate->pr_buffer, dev->d_buf, recvlen);
-
-  /* Update the accumulated size of the data read */
-
-  can_add_recvlen(pstate, recvlen);
-
-  return recvlen;
-}
-
 /****************************************************************************
  * Name: can_newdata
  *
  * Description:
- *   Copy the read data from the packet
+ *   Copy the frame of the packet into the user buffer and its timestamp
+ *   into the control message buffer.
  *
  * Input Parameters:
  *   dev      The structure of the network driver that generated the event
@@ -165,46 +124,34 @@ static size_t can_recvfrom_newdata(FAR struct net_driver_s *dev,
 static inline void can_newdata(FAR struct net_driver_s *dev,
                                FAR struct can_recvfrom_s *pstate)
 {
-  /* Take as much data from the packet as we can */
-
-  size_t recvlen = can_recvfrom_newdata(dev, pstate);
+  size_t framelen = dev->d_len;
+  size_t recvlen;
 
-  /* If there is more data left in the packet that we could not buffer, then
-   * add it to the read-ahead buffers.
-   */
+#ifdef CONFIG_NET_TIMESTAMP
+  FAR struct can_conn_s *conn =
+    (FAR struct can_conn_s *)pstate->pr_sock->s_conn;
 
-  if (recvlen < dev->d_len)
+  if (conn->sconn.s_timestamp && framelen > sizeof(struct timeval))
     {
-      FAR struct can_conn_s *conn =
-        (FAR struct can_conn_s *)pstate->pr_sock->s_conn;
-      FAR uint8_t *buffer = (FAR uint8_t *)dev->d_appdata + recvlen;
-      uint16_t buflen = dev->d_len - recvlen;
-#ifdef CONFIG_DEBUG_NET
-      uint16_t nsaved;
-
-      nsaved = can_datahandler(conn, buffer, buflen);
-#else
-      can_datahandler(conn, buffer, buflen);
-#endif
-
-      /* There are complicated buffering issues that are not addressed fully
-       * here.  For example, what if up_datahandler() cannot buffer the
-       * remainder of the packet?  In that case, the data will be dropped but
-       * still ACKed.  Therefore it would not be resent.
-       *
-       * This is probably not an issue here because we only get here if the
-       * read-ahead buffers are empty and there would have to be something
-       * serioulsy wrong with the configuration not to be able to buffer a
-       * partial packet in this context.
-       */
-
-#ifdef CONFIG_DEBUG_NET
-      if (nsaved < buflen)
+      framelen -= sizeof(struct timeval);
+      if (pstate->pr_msglen == sizeof(struct timeval))
         {
-          nerr("ERROR: packet data not saved (%d bytes)\n", buflen - nsaved);
+          memcpy(pstate->pr_msgbuf, dev->d_appdata + framelen,
+                 sizeof(struct timeval));
         }
-#endif
     }
+#endif
+
+  /* Copy the new frame into the user buffer.  Like with any datagram,
+   * the part of the frame that does not fit is lost.
+   */
+
+  recvlen = MIN(framelen, pstate->pr_buflen);
+  memcpy(pstate->pr_buffer, dev->d_appdata, recvlen);
+
+  /* Update the accumulated size of the data read */
+
+  can_add_recvlen(pstate, recvlen);
 
   /* Indicate no data in the buffer */
 
@@ -215,13 +162,14 @@ static inline void can_newdata(FAR struct net_driver_s *dev,
  * Name: can_readahead
  *
  * Description:
- *   Copy the read-ahead data from the packet
+ *   Copy the next frame from the read-ahead buffers into the user buffer
+ *   and its timestamp into the control message buffer.
  *
  * Input Parameters:
  *   pstate   recvfrom state structure
  *
  * Returned Value:
- *   None
+ *   The length of the frame that was received, zero if there is none.
  *
  * Assumptions:
  *   The network is locked.
@@ -233,7 +181,10 @@ static inline int can_readahead(struct can_recvfrom_s *pstate)
   FAR struct can_conn_s *conn =
     (FAR struct can_conn_s *) pstate->pr_sock->s_conn;
   FAR struct iob_s *iob;
+  unsigned int framelen;
+  unsigned int reclen;
   int recvlen;
+  uint8_t hdr;
 
   /* Check there is any CAN data already buffered in a read-ahead
    * buffer.
@@ -241,108 +192,44 @@ static inline int can_readahead(struct can_recvfrom_s *pstate)
 
   pstate->pr_recvlen = -1;
 
-  if ((iob = iob_peek_queue(&conn->readahead)) != NULL &&
-      pstate->pr_buflen > 0)
+  while ((iob = iob_peek_queue(&conn->readahead)) != NULL &&
+         pstate->pr_buflen > 0)
     {
       DEBUGASSERT(iob->io_pktlen > 0);
 
-      /* Transfer that buffered data from the I/O buffer chain into
-       * the user buffer.
-       */
+      /* Each I/O buffer chain holds one or more records of one frame */
 
-      recvlen = iob_copyout(pstate->pr_buffer, iob, pstate->pr_buflen, 0);
+      iob_copyout(&hdr, iob, CAN_RECHDR_LEN, 0);
+      framelen = hdr & CAN_RECHDR_LENMASK;
+      reclen   = CAN_RECHDR_LEN + framelen;
 
-      /* If we took all of the data from the I/O buffer chain is empty, then
-       * release it.  If there is still data available in the I/O buffer
-       * chain, then just trim the data that we have taken from the
-       * beginning of the I/O buffer chain.
+      /* Transfer the frame from the I/O buffer chain into the user
+       * buffer.
        */
 
-      if (recvlen >= iob->io_pktlen)
-        {
-          FAR struct iob_s *tmp;
-
-          /* Remove the I/O buffer chain from the head of the read-ahead
-           * buffer queue.
-           */
+      recvlen = iob_copyout(pstate->pr_buffer, iob,
+                            MIN(framelen, pstate->pr_buflen),
+                            CAN_RECHDR_LEN);
 
-          tmp = iob_remove_queue(&conn->readahead);
-          DEBUGASSERT(tmp == iob);
-          UNUSED(tmp);
-
-          /* And free the I/O buffer chain */
-
-          iob_free_chain(iob, IOBUSER_NET_CAN_READAHEAD);
-        }
-      else
-        {
-          /* The bytes that we have received from the head of the I/O
-           * buffer chain (probably changing the head of the I/O
-           * buffer queue).
-           */
-
-          iob_trimhead_queue(&conn->readahead, recvlen,
-                             IOBUSER_NET_CAN_READAHEAD);
-        }
-
-      /* do not pass frames with DLC > 8 to a legacy socket */
-#if defined(CONFIG_NET_CANPROTO_OPTIONS) && defined(CONFIG_NET_CAN_CANFD)
-      if (!conn->fd_frames)
-#endif
+#ifdef CONFIG_NET_TIMESTAMP
+      if ((hdr & CAN_RECHDR_TIMESTAMP) != 0)
         {
-          if (recvlen > sizeof(struct can_frame))
+          if (pstate->pr_msglen == sizeof(struct timeval))
             {
-              return 0;
+              iob_copyout(pstate->pr_msgbuf, iob, sizeof(struct timeval),
+                          reclen);
             }
-        }
-
-      return recvlen;
-    }
-
-  return 0;
-}
-
-/****************************************************************************
- * Name: can_readahead
- *
- * Description:
- *   Copy the read-ahead data from the packet
- *
- * Input Parameters:
- *   pstate   recvfrom state structure
- *
- * Returned Value:
- *   None
- *
- * Assumptions:
- *   The network is locked.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_TIMESTAMP
-static inline int can_readahead_timestamp(struct can_conn_s *conn,
-                                          FAR uint8_t *buffer)
-{
-  FAR struct iob_s *iob;
-  int recvlen;
-
-  if ((iob = iob_peek_queue(&conn->readahead)) != NULL)
-    {
-      DEBUGASSERT(iob->io_pktlen > 0);
-
-      /* Transfer that buffered data from the I/O buffer chain into
-       * the user buffer.
-       */
 
-      recvlen = iob_copyout(buffer, iob, sizeof(struct timeval), 0);
+          reclen += sizeof(struct timeval);
+        }
+#endif
 
-      /* If we took all of the data from the I/O buffer chain is empty, then
-       * release it.  If there is still data available in the I/O buffer
-       * chain, then just trim the data that we have taken from the
-       * beginning of the I/O buffer chain.
+      /* If this was the last record in the I/O buffer chain, then release
+       * it.  Otherwise just trim the record from the beginning of the I/O
+       * buffer chain.
        */
 
-      if (recvlen >= iob->io_pktlen)
+      if (reclen >= iob->io_pktlen)
         {
           FAR struct iob_s *tmp;
 
@@ -360,57 +247,34 @@ static inline int can_readahead_timestamp(struct can_conn_s *conn,
         }
       else
         {
-          /* The bytes that we have received from the head of the I/O
-           * buffer chain (probably changing the head of the I/O
-           * buffer queue).
-           */
-
-          iob_trimhead_queue(&conn->readahead, recvlen,
+          iob_trimhead_queue(&conn->readahead, reclen,
                              IOBUSER_NET_CAN_READAHEAD);
         }
 
-      return recvlen;
-    }
-
-  return 0;
-}
+      /* do not pass frames with DLC > 8 to a legacy socket */
+#if defined(CONFIG_NET_CANPROTO_OPTIONS) && defined(CONFIG_NET_CAN_CANFD)
+      if (!conn->fd_frames)
 #endif
-
-#ifdef CONFIG_NET_CANPROTO_OPTIONS
-static int can_recv_filter(struct can_conn_s *conn, canid_t id)
-{
-  uint32_t i;
-  for (i = 0; i < conn->filter_count; i++)
-    {
-      if (conn->filters[i].can_id & CAN_INV_FILTER)
-        {
-          if ((id & conn->filters[i].can_mask) !=
-                ((conn->filters[i].can_id & ~CAN_INV_FILTER) &
-                conn->filters[i].can_mask))
-            {
-              return 1;
-            }
-        }
-      else
         {
-          if ((id & conn->filters[i].can_mask) ==
-                (conn->filters[i].can_id & conn->filters[i].can_mask))
+          if (framelen > sizeof(struct can_frame))
             {
-              return 1;
+              continue;
             }
         }
+
+      return recvlen;
     }
 
   return 0;
 }
-#endif
 
 static uint16_t can_recvfrom_eventhandler(FAR struct net_driver_s *dev,
                                           FAR void *pvconn,
                                           FAR void *pvpriv, uint16_t flags)
 {
   struct can_recvfrom_s *pstate = (struct can_recvfrom_s *)pvpriv;
-#if defined(CONFIG_NET_CANPROTO_OPTIONS) || defined(CONFIG_NET_TIMESTAMP)
+#if (defined(CONFIG_NET_CANPROTO_OPTIONS) && defined(CONFIG_NET_CAN_CANFD)) \
+    || defined(CONFIG_NET_TIMESTAMP)
   struct can_conn_s *conn = (struct can_conn_s *)pstate->pr_sock->s_conn;
 #endif
 
@@ -420,16 +284,9 @@ static uint16_t can_recvfrom_eventhandler(FAR struct net_driver_s *dev,
     {
       if ((flags & CAN_NEWDATA) != 0)
         {
-          /* If a new packet is available, check receive filters
-           * when is valid then complete the read action.
+          /* A new frame is available that passed the receive filters in
+           * can_input(), complete the read action.
            */
-#ifdef CONFIG_NET_CANPROTO_OPTIONS
-          if (can_recv_filter(conn, (canid_t) *dev->d_appdata) == 0)
-            {
-              flags &= ~CAN_NEWDATA;
-              return flags;
-            }
-#endif
 
           /* do not pass frames with DLC > 8 to a legacy socket */
 #if defined(CONFIG_NET_CANPROTO_OPTIONS) && defined(CONFIG_NET_CAN_CANFD)
@@ -456,25 +313,6 @@ static uint16_t can_recvfrom_eventhandler(FAR struct net_driver_s *dev,
 
           can_newdata(dev, pstate);
 
-#ifdef CONFIG_NET_TIMESTAMP
-          if (conn->sconn.s_timestamp)
-            {
-              if (pstate->pr_msglen == sizeof(struct timeval))
-                {
-                  can_readahead_timestamp(conn, pstate->pr_msgbuf);
-                }
-              else
-                {
-                  /* We still have to consume the data
-                   * otherwise IOB gets full
-                   */
-
-                  uint8_t dummy_buf[sizeof(struct timeval)];
-                  can_readahead_timestamp(conn, (uint8_t *)&dummy_buf);
-                }
-            }
-#endif
-
           /* We are finished. */
 
           /* Don't allow any further call backs. */
@@ -627,23 +465,6 @@ ssize_t can_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
   ret = can_readahead(&state);
   if (ret > 0)
     {
-#ifdef CONFIG_NET_TIMESTAMP
-      if (conn->sconn.s_timestamp)
-        {
-          if (state.pr_msglen == sizeof(struct timeval))
-            {
-              can_readahead_timestamp(conn, state.pr_msgbuf);
-            }
-          else
-            {
-              /* We still have to consume the data otherwise IOB gets full */
-
-              uint8_t dummy_buf[sizeof(struct timeval)];
-              can_readahead_timestamp(conn, (uint8_t *)&dummy_buf);
-            }
-        }
-#endif
-
       goto errout_with_state;
     }
 
@@ -90,12 +90,7 @@ int can_setsockopt(FAR struct socket *psock, int option,
   switch (option)
     {
       case CAN_RAW_FILTER:
-        if (value_len == 0)
-          {
-            conn->filter_count = 0;
-            ret = OK;
-          }
-        else if (value_len % sizeof(struct can_filter) != 0)
+        if (value_len % sizeof(struct can_filter) != 0)
           {
             ret = -EINVAL;
           }
@@ -106,15 +101,22 @@ int can_setsockopt(FAR struct socket *psock, int option,
           }
         else
           {
-        count = value_len / sizeof(struct can_filter);
+            /* The filters in the controller must not reject frames that
+             * the new filters accept.
+             */
 
-        for (int i = 0; i < count; i++)
-          {
-        conn->filters[i] = ((struct can_filter *)value)[i];
-          }
+            can_hwfilter_remove(conn->dev);
+
+            count = value_len / sizeof(struct can_filter);
+
+            for (int i = 0; i < count; i++)
+              {
+                conn->filters[i] = ((struct can_filter *)value)[i];
+              }
 
-        conn->filter_count = count;
+            conn->filter_count = count;
 
+            can_hwfilter_add(conn->dev);
             ret = OK;
           }
         break;
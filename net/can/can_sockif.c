@@ -36,6 +36,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/net/net.h>
 
@@ -154,7 +155,7 @@ static uint16_t can_poll_eventhandler(FAR struct net_driver_s *dev,
       if (eventset)
         {
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(&info->fds, 1, 0);
         }
     }
 
@@ -334,6 +335,8 @@ static int can_bind(FAR struct socket *psock,
 
   /* Bind CAN device to socket */
 
+  can_hwfilter_remove(conn->dev);
+
 #ifdef CONFIG_NETDEV_IFINDEX
   conn->dev = netdev_findbyindex(canaddr->can_ifindex);
 #else
@@ -342,6 +345,11 @@ static int can_bind(FAR struct socket *psock,
   conn->dev = netdev_findbyname((const char *)&netdev_name);
 #endif
 
+  /* The connection stopped receiving from all devices or started to
+   * receive from its device, which may change the filters of any device.
+   */
+
+  can_hwfilter_add(NULL);
   return OK;
 }
 
@@ -623,7 +631,7 @@ static int can_poll_local(FAR struct socket *psock, FAR struct pollfd *fds,
         {
           /* Yes.. then signal the poll logic */
 
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
         }
 
 errout_with_lock:
@@ -671,6 +679,9 @@ errout_with_lock:
 static int can_close(FAR struct socket *psock)
 {
   FAR struct can_conn_s *conn = psock->s_conn;
+#ifdef CONFIG_NET_CAN_RAW_FILTER_HW
+  FAR struct net_driver_s *dev = conn->dev;
+#endif
   int ret = OK;
 
   /* Perform some pre-close operations for the CAN socket type. */
@@ -688,7 +699,13 @@ static int can_close(FAR struct socket *psock)
       /* Free the connection structure */
 
       conn->crefs = 0;
+#ifdef CONFIG_NET_CAN_RAW_FILTER_HW
+      can_hwfilter_remove(dev);
       can_free(psock->s_conn);
+      can_hwfilter_add(dev);
+#else
+      can_free(psock->s_conn);
+#endif
 
       if (ret < 0)
         {
@@ -55,10 +55,10 @@
 void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
                     unsigned int len, unsigned int offset)
 {
-  if (dev == NULL || len == 0 || len >= NETDEV_PKTSIZE(dev))
+  if (dev == NULL || len == 0 || len >= NETDEV_TXSIZE(dev))
     {
       nerr("devif_iob_send error, %p, send len: %u, pkt len: %u\n",
-                                          dev, len, NETDEV_PKTSIZE(dev));
+                                          dev, len, NETDEV_TXSIZE(dev));
       return;
     }
 
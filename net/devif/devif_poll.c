@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/clock.h>
@@ -61,6 +62,30 @@ enum devif_packet_type
   DEVIF_ICMP6
 };
 
+#ifdef CONFIG_NETDEV_IOB
+/* The state of one devif_poll_batch() */
+
+struct devif_batch_s
+{
+  devif_poll_callback_t callback; /* Driver callback, may be NULL */
+  FAR struct iob_s **pkts;        /* Where to put the packets */
+  int npkts;                      /* The size of pkts[] */
+  int count;                      /* Number of packets in pkts[] */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB
+/* The batch being collected.  Polling happens with the network locked so
+ * there is never more than one.
+ */
+
+static FAR struct devif_batch_s *g_devif_batch;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -445,6 +470,15 @@ static inline int devif_poll_icmpv6(FAR struct net_driver_s *dev,
 static inline int devif_poll_forward(FAR struct net_driver_s *dev,
                                      devif_poll_callback_t callback)
 {
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Send the packets of cached flows first */
+
+  if (ipfwd_flow_poll(dev, callback))
+    {
+      return 1;
+    }
+#endif
+
   /* Perform the forwarding poll */
 
   ipfwd_poll(dev);
@@ -587,6 +621,8 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 {
   FAR struct tcp_conn_s *conn  = NULL;
   int bstop = 0;
+  int nsegs;
+  bool sent;
 
   /* Traverse all of the active TCP connections and perform the poll action */
 
@@ -596,17 +632,27 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 
       if (dev == conn->dev)
         {
-          /* Perform the TCP TX poll */
+          /* Keep polling the connection as long as it has segments to send,
+           * up to CONFIG_NET_TCP_POLL_BATCH segments.
+           */
+
+          nsegs = 0;
+          do
+            {
+              /* Perform the TCP TX poll */
 
-          tcp_poll(dev, conn);
+              tcp_poll(dev, conn);
 
-          /* Perform any necessary conversions on outgoing packets */
+              /* Perform any necessary conversions on outgoing packets */
 
-          devif_packet_conversion(dev, DEVIF_TCP);
+              devif_packet_conversion(dev, DEVIF_TCP);
 
-          /* Call back into the driver */
+              /* Call back into the driver */
 
-          bstop = callback(dev);
+              sent  = dev->d_len > 0;
+              bstop = callback(dev);
+            }
+          while (!bstop && sent && ++nsegs < CONFIG_NET_TCP_POLL_BATCH);
         }
     }
 
@@ -616,6 +662,48 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 # define devif_poll_tcp_connections(dev, callback) (0)
 #endif
 
+/****************************************************************************
+ * Name: devif_batch_callback
+ *
+ * Description:
+ *   The devif_poll() callback of devif_poll_batch().  Moves each packet
+ *   into the batch and prepares a new I/O buffer for the next one.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB
+static int devif_batch_callback(FAR struct net_driver_s *dev)
+{
+  FAR struct devif_batch_s *batch = g_devif_batch;
+  int bstop = 0;
+
+  /* Let the driver resolve the link layer address first */
+
+  if (dev->d_len > 0 && batch->callback != NULL)
+    {
+      bstop = batch->callback(dev);
+    }
+
+  if (dev->d_len > 0)
+    {
+      batch->pkts[batch->count++] = netdev_tx_iob(dev);
+    }
+
+  /* Stop if the batch is full or there is no buffer for the next packet */
+
+  if (bstop || batch->count >= batch->npkts ||
+      netdev_iob_prepare(dev, false) < 0)
+    {
+      return 1;
+    }
+
+  return 0;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -771,6 +859,49 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
   return bstop;
 }
 
+/****************************************************************************
+ * Name: devif_poll_batch
+ *
+ * Description:
+ *   Poll the network like devif_poll(), but collect the outgoing packets
+ *   in I/O buffers instead of calling back into the driver to send each
+ *   one from d_buf.  The driver can then hand the whole batch to its DMA
+ *   ring at once.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB
+int devif_poll_batch(FAR struct net_driver_s *dev,
+                     devif_poll_callback_t callback,
+                     FAR struct iob_s **pkts, int npkts)
+{
+  struct devif_batch_s batch;
+
+  DEBUGASSERT(pkts != NULL && npkts > 0 && g_devif_batch == NULL);
+
+  if (netdev_iob_prepare(dev, false) < 0)
+    {
+      return 0;
+    }
+
+  batch.callback = callback;
+  batch.pkts     = pkts;
+  batch.npkts    = npkts;
+  batch.count    = 0;
+
+  g_devif_batch  = &batch;
+  devif_poll(dev, devif_batch_callback);
+  g_devif_batch  = NULL;
+
+  netdev_iob_release(dev);
+  return batch.count;
+}
+#endif
+
 /****************************************************************************
  * Name: devif_timer
  *
@@ -331,7 +331,8 @@ int ipv4_input(FAR struct net_driver_s *dev)
     }
 #endif
 
-  if (ipv4_chksum(dev) != 0xffff)
+  if (!NETDEV_HAS_FEATURE(dev, NETDEV_F_RXCSUM) &&
+      ipv4_chksum(dev) != 0xffff)
     {
       /* Compute and check the IP header checksum. */
 
@@ -355,6 +356,13 @@ int ipv4_input(FAR struct net_driver_s *dev)
     {
 #ifdef NET_TCP_HAVE_STACK
       case IP_PROTO_TCP:   /* TCP input */
+#ifdef CONFIG_NET_TCP_GRO
+        if (tcp_gro_receive(dev, (ipv4->vhl & IPv4_HLMASK) << 2))
+          {
+            break;
+          }
+#endif
+
         tcp_ipv4_input(dev);
         break;
 #endif
@@ -421,6 +421,13 @@ int ipv6_input(FAR struct net_driver_s *dev)
 
         /* Forward the IPv6 TCP packet */
 
+#ifdef CONFIG_NET_TCP_GRO
+        if (tcp_gro_receive(dev, iphdrlen))
+          {
+            break;
+          }
+#endif
+
         tcp_ipv6_input(dev, iphdrlen);
 
 #ifdef CONFIG_NET_6LOWPAN
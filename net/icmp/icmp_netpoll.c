@@ -30,6 +30,7 @@
 #include <debug.h>
 
 #include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 
 #include "devif/devif.h"
@@ -113,7 +114,7 @@ static uint16_t icmp_poll_eventhandler(FAR struct net_driver_s *dev,
       if (eventset)
         {
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(&info->fds, 1, 0);
         }
     }
 
@@ -221,7 +222,7 @@ int icmp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, 0);
     }
 
 errout_with_lock:
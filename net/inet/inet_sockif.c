@@ -1555,8 +1555,6 @@ static ssize_t inet_sendfile(FAR struct socket *psock,
 static ssize_t inet_recvmsg(FAR struct socket *psock,
                             FAR struct msghdr *msg, int flags)
 {
-  FAR void *buf = msg->msg_iov->iov_base;
-  size_t len = msg->msg_iov->iov_len;
   FAR struct sockaddr *from = msg->msg_name;
   FAR socklen_t *fromlen = &msg->msg_namelen;
   ssize_t ret;
@@ -1610,7 +1608,9 @@ static ssize_t inet_recvmsg(FAR struct socket *psock,
     case SOCK_STREAM:
       {
 #ifdef NET_TCP_HAVE_STACK
-        ret = psock_tcp_recvfrom(psock, buf, len, flags, from, fromlen);
+        ret = psock_tcp_recvfrom(psock, msg->msg_iov->iov_base,
+                                 msg->msg_iov->iov_len, flags,
+                                 from, fromlen);
 #else
         ret = -ENOSYS;
 #endif
@@ -1622,7 +1622,7 @@ static ssize_t inet_recvmsg(FAR struct socket *psock,
     case SOCK_DGRAM:
       {
 #ifdef NET_UDP_HAVE_STACK
-        ret = psock_udp_recvfrom(psock, buf, len, flags, from, fromlen);
+        ret = psock_udp_recvfrom(psock, msg, flags);
 #else
         ret = -ENOSYS;
 #endif
@@ -29,6 +29,8 @@
 
 #include <stdint.h>
 
+#include <nuttx/net/netdev.h>
+
 #undef HAVE_FWDALLOC
 #ifdef CONFIG_NET_IPFORWARD
 
@@ -240,6 +242,116 @@ int ipfwd_forward(FAR struct forward_s *fwd);
 
 void ipfwd_poll(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: ipv4_flow_lookup
+ *
+ * Description:
+ *   Return the device that the flow of an IPv4 packet is forwarded on, or
+ *   NULL if the flow is not in the cache.
+ *
+ * Input Parameters:
+ *   dev   - The device on which the packet was received
+ *   ipv4  - A pointer to the IPv4 header of the packet
+ *
+ * Returned Value:
+ *   The forwarding device or NULL.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+FAR struct net_driver_s *ipv4_flow_lookup(FAR struct net_driver_s *dev,
+                                          FAR struct ipv4_hdr_s *ipv4);
+
+/****************************************************************************
+ * Name: ipv4_flow_add
+ *
+ * Description:
+ *   Remember the device that the flow of an IPv4 packet is forwarded on.
+ *
+ * Input Parameters:
+ *   dev    - The device on which the packet was received
+ *   ipv4   - A pointer to the IPv4 header of the packet
+ *   fwddev - The device on which the packet is forwarded
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipv4_flow_add(FAR struct net_driver_s *dev,
+                   FAR struct ipv4_hdr_s *ipv4,
+                   FAR struct net_driver_s *fwddev);
+
+/****************************************************************************
+ * Name: ipfwd_flow_flush
+ *
+ * Description:
+ *   Forget the cached flows through a device and drop the packets queued
+ *   for it.
+ *
+ * Input Parameters:
+ *   dev - The device going down or being unregistered
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfwd_flow_flush(FAR struct net_driver_s *dev);
+
+/****************************************************************************
+ * Name: ipfwd_flow_send
+ *
+ * Description:
+ *   Queue a packet of a cached flow to be sent in the next TX poll of its
+ *   forwarding device, without setting up a device callback.
+ *
+ * Input Parameters:
+ *   fwd - An initialized instance of the common forwarding structure that
+ *         includes everything needed to perform the forwarding operation.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfwd_flow_send(FAR struct forward_s *fwd);
+
+/****************************************************************************
+ * Name: ipfwd_flow_poll
+ *
+ * Description:
+ *   Send the packets queued for a device by ipfwd_flow_send().
+ *
+ * Input Parameters:
+ *   dev      - The device being polled
+ *   callback - The poll callback of the driver
+ *
+ * Returned Value:
+ *   Non-zero if the driver stopped the poll.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver indirectly through
+ *   devif_poll() with the network locked.
+ *
+ ****************************************************************************/
+
+int ipfwd_flow_poll(FAR struct net_driver_s *dev,
+                    devif_poll_callback_t callback);
+#endif
+
 /****************************************************************************
  * Name: ipfwd_dropstats
  *
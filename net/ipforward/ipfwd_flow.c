@@ -0,0 +1,371 @@
+/****************************************************************************
+ * net/ipforward/ipfwd_flow.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <net/if.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+
+#include "netdev/netdev.h"
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IPFWD_FLOW_MASK   (CONFIG_NET_IPFORWARD_NFLOWS - 1)
+#define IPFWD_FLOW_AGE    SEC2TICK(CONFIG_NET_IPFORWARD_FLOWAGE)
+
+#if (CONFIG_NET_IPFORWARD_NFLOWS & IPFWD_FLOW_MASK) != 0
+#  error CONFIG_NET_IPFORWARD_NFLOWS must be a power of two
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One entry of the flow cache.  The flow is identified by the receiving
+ * device and the 5-tuple of its packets.
+ */
+
+struct ipfwd_flow_s
+{
+  FAR struct net_driver_s *fl_indev;  /* Device the packets arrive on */
+  FAR struct net_driver_s *fl_outdev; /* Device to forward them on */
+  clock_t   fl_time;                  /* Time of the last packet */
+  in_addr_t fl_srcaddr;               /* Source IPv4 address */
+  in_addr_t fl_destaddr;              /* Destination IPv4 address */
+  uint16_t  fl_srcport;               /* Source port, network order */
+  uint16_t  fl_destport;              /* Destination port, network order */
+  uint8_t   fl_proto;                 /* IP protocol */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct ipfwd_flow_s g_ipfwd_flows[CONFIG_NET_IPFORWARD_NFLOWS];
+
+/* Packets of cached flows waiting for a TX poll of their device */
+
+static sq_queue_t g_ipfwd_txq;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_flow_key
+ *
+ * Description:
+ *   Fill in the key of the flow that an IPv4 packet belongs to and return
+ *   the index of its entry in the cache, or -1 if the packet is a fragment.
+ *   Only the first fragment has the ports, so fragmented packets always
+ *   take the slow path.
+ *
+ ****************************************************************************/
+
+static int ipv4_flow_key(FAR struct net_driver_s *dev,
+                         FAR struct ipv4_hdr_s *ipv4,
+                         FAR struct ipfwd_flow_s *key)
+{
+  FAR const uint16_t *ports;
+  uint32_t hash;
+
+  if ((ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0)
+    {
+      return -1;
+    }
+
+  key->fl_indev    = dev;
+  key->fl_srcaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+  key->fl_destaddr = net_ip4addr_conv32(ipv4->destipaddr);
+  key->fl_proto    = ipv4->proto;
+  key->fl_srcport  = 0;
+  key->fl_destport = 0;
+
+  /* TCP and UDP both start with the source and destination ports */
+
+  if (ipv4->proto == IP_PROTO_TCP || ipv4->proto == IP_PROTO_UDP)
+    {
+      ports = (FAR const uint16_t *)
+              ((FAR uint8_t *)ipv4 + ((ipv4->vhl & IPv4_HLMASK) << 2));
+      key->fl_srcport  = ports[0];
+      key->fl_destport = ports[1];
+    }
+
+  hash  = key->fl_srcaddr ^ key->fl_destaddr ^ key->fl_proto;
+  hash ^= ((uint32_t)key->fl_srcport << 16) | key->fl_destport;
+  hash *= UINT32_C(0x9e3779b1);
+  return (hash >> 16) & IPFWD_FLOW_MASK;
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_match
+ *
+ * Description:
+ *   Return true if a cache entry holds the flow of the key.
+ *
+ ****************************************************************************/
+
+static bool ipfwd_flow_match(FAR const struct ipfwd_flow_s *flow,
+                             FAR const struct ipfwd_flow_s *key)
+{
+  return flow->fl_outdev != NULL &&
+         flow->fl_indev == key->fl_indev &&
+         flow->fl_srcaddr == key->fl_srcaddr &&
+         flow->fl_destaddr == key->fl_destaddr &&
+         flow->fl_srcport == key->fl_srcport &&
+         flow->fl_destport == key->fl_destport &&
+         flow->fl_proto == key->fl_proto;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_flow_lookup
+ *
+ * Description:
+ *   Return the device that the flow of an IPv4 packet is forwarded on, or
+ *   NULL if the flow is not in the cache.  Entries expire when no packet
+ *   of their flow was forwarded for CONFIG_NET_IPFORWARD_FLOWAGE seconds,
+ *   so that changes of the routes take effect.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct net_driver_s *ipv4_flow_lookup(FAR struct net_driver_s *dev,
+                                          FAR struct ipv4_hdr_s *ipv4)
+{
+  FAR struct ipfwd_flow_s *flow;
+  struct ipfwd_flow_s key;
+  clock_t now;
+  int ndx;
+
+  ndx = ipv4_flow_key(dev, ipv4, &key);
+  if (ndx < 0)
+    {
+      return NULL;
+    }
+
+  flow = &g_ipfwd_flows[ndx];
+  if (!ipfwd_flow_match(flow, &key))
+    {
+      return NULL;
+    }
+
+  now = clock_systime_ticks();
+  if (now - flow->fl_time >= IPFWD_FLOW_AGE ||
+      !IFF_IS_UP(flow->fl_outdev->d_flags))
+    {
+      flow->fl_outdev = NULL;
+      return NULL;
+    }
+
+  flow->fl_time = now;
+  return flow->fl_outdev;
+}
+
+/****************************************************************************
+ * Name: ipv4_flow_add
+ *
+ * Description:
+ *   Remember the device that the flow of an IPv4 packet is forwarded on,
+ *   replacing the flow that used the same cache entry before.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipv4_flow_add(FAR struct net_driver_s *dev,
+                   FAR struct ipv4_hdr_s *ipv4,
+                   FAR struct net_driver_s *fwddev)
+{
+  struct ipfwd_flow_s key;
+  int ndx;
+
+  ndx = ipv4_flow_key(dev, ipv4, &key);
+  if (ndx >= 0)
+    {
+      key.fl_outdev = fwddev;
+      key.fl_time   = clock_systime_ticks();
+      memcpy(&g_ipfwd_flows[ndx], &key, sizeof(struct ipfwd_flow_s));
+    }
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_flush
+ *
+ * Description:
+ *   Forget the flows through a device and drop the packets waiting to be
+ *   sent on it.  Called when the device goes down or is unregistered.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfwd_flow_flush(FAR struct net_driver_s *dev)
+{
+  FAR struct forward_s *prev = NULL;
+  FAR struct forward_s *fwd;
+  FAR struct forward_s *next;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_IPFORWARD_NFLOWS; i++)
+    {
+      if (g_ipfwd_flows[i].fl_indev == dev ||
+          g_ipfwd_flows[i].fl_outdev == dev)
+        {
+          g_ipfwd_flows[i].fl_indev  = NULL;
+          g_ipfwd_flows[i].fl_outdev = NULL;
+        }
+    }
+
+  for (fwd = (FAR struct forward_s *)sq_peek(&g_ipfwd_txq);
+       fwd != NULL;
+       fwd = next)
+    {
+      next = fwd->f_flink;
+      if (fwd->f_dev != dev)
+        {
+          prev = fwd;
+          continue;
+        }
+
+      if (prev == NULL)
+        {
+          sq_remfirst(&g_ipfwd_txq);
+        }
+      else
+        {
+          sq_remafter((FAR sq_entry_t *)prev, &g_ipfwd_txq);
+        }
+
+      ipfwd_dropstats(fwd);
+      iob_free_chain(fwd->f_iob, IOBUSER_NET_IPFORWARD);
+      ipfwd_free(fwd);
+    }
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_send
+ *
+ * Description:
+ *   Queue a packet of a cached flow for its forwarding device.  Unlike
+ *   ipfwd_forward(), no device callback is set up: the packets are sent
+ *   from the queue, all of them in the same TX poll if the driver takes
+ *   them, before any of the other pollers run.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfwd_flow_send(FAR struct forward_s *fwd)
+{
+  DEBUGASSERT(fwd != NULL && fwd->f_iob != NULL && fwd->f_dev != NULL);
+
+  sq_addlast((FAR sq_entry_t *)fwd, &g_ipfwd_txq);
+  netdev_txnotify_dev(fwd->f_dev);
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_poll
+ *
+ * Description:
+ *   Send the packets queued by ipfwd_flow_send() for a device, calling
+ *   back into the driver for each one.  Returns non-zero if the driver
+ *   stopped the poll.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver indirectly through
+ *   devif_poll() with the network locked.
+ *
+ ****************************************************************************/
+
+int ipfwd_flow_poll(FAR struct net_driver_s *dev,
+                    devif_poll_callback_t callback)
+{
+  FAR struct forward_s *prev = NULL;
+  FAR struct forward_s *fwd;
+  FAR struct forward_s *next;
+  int bstop = 0;
+
+  for (fwd = (FAR struct forward_s *)sq_peek(&g_ipfwd_txq);
+       fwd != NULL && bstop == 0;
+       fwd = next)
+    {
+      next = fwd->f_flink;
+      if (fwd->f_dev != dev)
+        {
+          prev = fwd;
+          continue;
+        }
+
+      if (prev == NULL)
+        {
+          sq_remfirst(&g_ipfwd_txq);
+        }
+      else
+        {
+          sq_remafter((FAR sq_entry_t *)prev, &g_ipfwd_txq);
+        }
+
+#ifdef CONFIG_NET_IPv6
+      /* Tell the driver that this is an IPv4 packet */
+
+      IFF_SET_IPv4(dev->d_flags);
+#endif
+
+      devif_forward(fwd);
+      iob_free_chain(fwd->f_iob, IOBUSER_NET_IPFORWARD);
+      ipfwd_free(fwd);
+
+      bstop = callback(dev);
+    }
+
+  return bstop;
+}
+
+#endif /* CONFIG_NET_IPFORWARD_FLOWCACHE */
@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <string.h>
 #include <assert.h>
 #include <debug.h>
@@ -200,6 +201,10 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
  *              contains the IPv4 packet.
  *   fwdddev  - The device on which the packet must be forwarded.
  *   ipv4     - A pointer to the IPv4 header in within the IPv4 packet
+ *   flow     - True if the packet belongs to a flow in the flow cache.
+ *              Such packets are moved out of the receiving device without
+ *              copying them if possible and queued directly for the
+ *              forwarding device.
  *
  * Returned Value:
  *   Zero is returned if the packet was successfully forward;  A negated
@@ -210,7 +215,7 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 
 static int ipv4_dev_forward(FAR struct net_driver_s *dev,
                             FAR struct net_driver_s *fwddev,
-                            FAR struct ipv4_hdr_s *ipv4)
+                            FAR struct ipv4_hdr_s *ipv4, bool flow)
 {
   FAR struct forward_s *fwd = NULL;
 #ifdef CONFIG_DEBUG_NET_WARN
@@ -269,34 +274,56 @@ static int ipv4_dev_forward(FAR struct net_driver_s *dev,
     }
 #endif
 
-  /* Try to allocate the head of an IOB chain.  If this fails, the
-   * packet will be dropped; we are not operating in a context
-   * where waiting for an IOB is a good idea
+#ifdef CONFIG_NETDEV_IOB
+  /* If the driver passed the packet in an I/O buffer, just take that
+   * buffer from the receiving device.
    */
 
-  fwd->f_iob = iob_tryalloc(false, IOBUSER_NET_IPFORWARD);
-  if (fwd->f_iob == NULL)
+  if (flow)
     {
-      nwarn("WARNING: iob_tryalloc() failed\n");
-      ret = -ENOMEM;
-      goto errout_with_fwd;
-    }
+      /* Nothing may fail once the packet is out of the device, so check
+       * the hop limit first.
+       */
 
-  /* Copy the L2/L3 headers plus any following payload into an IOB chain.
-   * iob_trycopin() will not wait, but will fail there are no available
-   * IOBs.
-   *
-   * REVISIT: Consider an alternative design that does not require data
-   * copying.  This would require a pool of d_buf's that are managed by
-   * the network rather than the network device.
-   */
+      if (ipv4->ttl <= 1)
+        {
+          nwarn("WARNING: Hop limit exceeded... Dropping!\n");
+          ret = -EMULTIHOP;
+          goto errout_with_fwd;
+        }
+
+      fwd->f_iob = netdev_iob_take(dev, (FAR const uint8_t *)ipv4,
+                                   dev->d_len);
+    }
 
-  ret = iob_trycopyin(fwd->f_iob, (FAR const uint8_t *)ipv4,
-                      dev->d_len, 0, false, IOBUSER_NET_IPFORWARD);
-  if (ret < 0)
+  if (fwd->f_iob == NULL)
+#endif
     {
-      nwarn("WARNING: iob_trycopyin() failed: %d\n", ret);
-      goto errout_with_iobchain;
+      /* Try to allocate the head of an IOB chain.  If this fails, the
+       * packet will be dropped; we are not operating in a context
+       * where waiting for an IOB is a good idea
+       */
+
+      fwd->f_iob = iob_tryalloc(false, IOBUSER_NET_IPFORWARD);
+      if (fwd->f_iob == NULL)
+        {
+          nwarn("WARNING: iob_tryalloc() failed\n");
+          ret = -ENOMEM;
+          goto errout_with_fwd;
+        }
+
+      /* Copy the L2/L3 headers plus any following payload into an IOB
+       * chain.  iob_trycopin() will not wait, but will fail there are no
+       * available IOBs.
+       */
+
+      ret = iob_trycopyin(fwd->f_iob, (FAR const uint8_t *)ipv4,
+                          dev->d_len, 0, false, IOBUSER_NET_IPFORWARD);
+      if (ret < 0)
+        {
+          nwarn("WARNING: iob_trycopyin() failed: %d\n", ret);
+          goto errout_with_iobchain;
+        }
     }
 
   /* Decrement the TTL in the copy of the IPv4 header (retaining the
@@ -304,7 +331,7 @@ static int ipv4_dev_forward(FAR struct net_driver_s *dev,
    * TLL decrements to zero, then do not forward the packet.
    */
 
-  ret = ipv4_decr_ttl((FAR struct ipv4_hdr_s *)fwd->f_iob->io_data);
+  ret = ipv4_decr_ttl((FAR struct ipv4_hdr_s *)IOB_DATA(fwd->f_iob));
   if (ret < 1)
     {
       nwarn("WARNING: Hop limit exceeded... Dropping!\n");
@@ -312,6 +339,17 @@ static int ipv4_dev_forward(FAR struct net_driver_s *dev,
       goto errout_with_iobchain;
     }
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Packets of cached flows skip the device callback */
+
+  if (flow)
+    {
+      ipfwd_flow_send(fwd);
+      dev->d_len = 0;
+      return OK;
+    }
+#endif
+
   /* Then set up to forward the packet according to the protocol. */
 
   ret = ipfwd_forward(fwd);
@@ -380,7 +418,7 @@ int ipv4_forward_callback(FAR struct net_driver_s *fwddev, FAR void *arg)
 
       /* Send the packet asynchrously on the forwarding device. */
 
-      ret = ipv4_dev_forward(dev, fwddev, ipv4);
+      ret = ipv4_dev_forward(dev, fwddev, ipv4, false);
       if (ret < 0)
         {
           nwarn("WARNING: ipv4_dev_forward failed: %d\n", ret);
@@ -430,18 +468,38 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
   in_addr_t destipaddr;
   in_addr_t srcipaddr;
   FAR struct net_driver_s *fwddev;
+  bool flow = false;
   int ret;
 
-  /* Search for a device that can forward this packet. */
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Packets of established flows do not need a route lookup */
 
-  destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
-  srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
-
-  fwddev     = netdev_findby_ripv4addr(srcipaddr, destipaddr);
-  if (fwddev == NULL)
+  fwddev = ipv4_flow_lookup(dev, ipv4);
+  if (fwddev != NULL)
+    {
+      flow = true;
+    }
+  else
+#endif
     {
-      nwarn("WARNING: Not routable\n");
-      return (ssize_t)-ENETUNREACH;
+      /* Search for a device that can forward this packet. */
+
+      destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
+      srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+
+      fwddev     = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+      if (fwddev == NULL)
+        {
+          nwarn("WARNING: Not routable\n");
+          return (ssize_t)-ENETUNREACH;
+        }
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      if (fwddev != dev)
+        {
+          ipv4_flow_add(dev, ipv4, fwddev);
+        }
+#endif
     }
 
   /* Check if we are forwarding on the same device that we received the
@@ -452,7 +510,7 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
     {
       /* Send the packet asynchrously on the forwarding device. */
 
-      ret = ipv4_dev_forward(dev, fwddev, ipv4);
+      ret = ipv4_dev_forward(dev, fwddev, ipv4, flow);
       if (ret < 0)
         {
           nwarn("WARNING: ipv4_dev_forward failed: %d\n", ret);
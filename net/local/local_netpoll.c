@@ -36,6 +36,24 @@
 #include "socket/socket.h"
 #include "local/local.h"
 
+/****************************************************************************
+ * Name: local_inout_poll_cb
+ *
+ * Description:
+ *   Forward the events of a shadow pollfd to the pollfd of the caller.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+static void local_inout_poll_cb(FAR struct pollfd *fds)
+{
+  FAR struct pollfd *originfds = fds->ptr;
+
+  originfds->revents |= fds->revents;
+  poll_notify(&originfds, 1, 0);
+}
+#endif
+
 /****************************************************************************
  * Name: local_event_pollsetup
  ****************************************************************************/
@@ -136,7 +154,7 @@ void local_event_pollnotify(FAR struct local_conn_s *conn,
           if (fds->revents != 0)
             {
               ninfo("Report events: %08" PRIx32 "\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -216,11 +234,15 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
             }
 
           shadowfds[0].fd     = 1; /* Does not matter */
+          shadowfds[0].ptr    = fds;
           shadowfds[0].sem    = fds->sem;
+          shadowfds[0].cb     = local_inout_poll_cb;
           shadowfds[0].events = fds->events & ~POLLOUT;
 
           shadowfds[1].fd     = 0; /* Does not matter */
+          shadowfds[1].ptr    = fds;
           shadowfds[1].sem    = fds->sem;
+          shadowfds[1].cb     = local_inout_poll_cb;
           shadowfds[1].events = fds->events & ~POLLIN;
 
           net_unlock();
@@ -289,7 +311,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 #ifdef CONFIG_NET_LOCAL_STREAM
 pollerr:
   fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_notify(&fds, 1, 0);
   return OK;
 #endif
 }
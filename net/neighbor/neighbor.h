@@ -37,6 +37,34 @@
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The Neighbor table is indexed by a hash of the interface identifier part
+ * of the IPv6 address.  The number of buckets is the smallest power of two
+ * not less than the table size.
+ */
+
+#if CONFIG_NET_IPv6_NCONF_ENTRIES <= 8
+#  define NEIGHBOR_HASH_BITS 3
+#elif CONFIG_NET_IPv6_NCONF_ENTRIES <= 16
+#  define NEIGHBOR_HASH_BITS 4
+#elif CONFIG_NET_IPv6_NCONF_ENTRIES <= 32
+#  define NEIGHBOR_HASH_BITS 5
+#elif CONFIG_NET_IPv6_NCONF_ENTRIES <= 64
+#  define NEIGHBOR_HASH_BITS 6
+#elif CONFIG_NET_IPv6_NCONF_ENTRIES <= 128
+#  define NEIGHBOR_HASH_BITS 7
+#else
+#  define NEIGHBOR_HASH_BITS 8
+#endif
+
+#define NEIGHBOR_HASH_SIZE (1 << NEIGHBOR_HASH_BITS)
+#define NEIGHBOR_HASH(a) \
+  (((((uint32_t)(a)[4] << 16 | (a)[5]) ^ ((uint32_t)(a)[6] << 16 | (a)[7])) * \
+    2654435761u) >> (32 - NEIGHBOR_HASH_BITS))
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -47,6 +75,13 @@
 
 extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+/* Hash buckets and chain links over g_neighbors[].  Links are table
+ * indices plus one; zero ends a chain.  Unused entries are not linked.
+ */
+
+extern uint8_t g_neighbor_hash[NEIGHBOR_HASH_SIZE];
+extern uint8_t g_neighbor_next[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -36,6 +36,7 @@
 #include <nuttx/net/neighbor.h>
 
 #include "netdev/netdev.h"
+#include "inet/inet.h"
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -62,53 +63,77 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
-  uint8_t lltype;
+  FAR struct neighbor_entry_s *neighbor;
+  FAR uint8_t *link;
   clock_t oldest_time;
   int     oldest_ndx;
   int     i;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
-   */
+  /* Update the existing entry for this address if there is one */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
-
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  neighbor = neighbor_findentry(ipaddr);
+  if (neighbor == NULL)
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
+      /* Otherwise use the first unused entry or the least recently used
+       * entry.
+       */
+
+      oldest_time = g_neighbors[0].ne_time;
+      oldest_ndx  = 0;
+
+      for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
         {
-          oldest_ndx = i;
-          break;
+          if (net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, g_ipv6_unspecaddr))
+            {
+              oldest_ndx = i;
+              break;
+            }
+
+          if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+            {
+              oldest_ndx = i;
+              oldest_time = g_neighbors[i].ne_time;
+            }
         }
 
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+      neighbor = &g_neighbors[oldest_ndx];
+
+      /* Unlink the entry from the hash chain of its old address */
+
+      if (!net_ipv6addr_cmp(neighbor->ne_ipaddr, g_ipv6_unspecaddr))
         {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
+          link = &g_neighbor_hash[NEIGHBOR_HASH(neighbor->ne_ipaddr)];
+          while (*link != 0)
+            {
+              if (*link == oldest_ndx + 1)
+                {
+                  *link = g_neighbor_next[oldest_ndx];
+                  break;
+                }
+
+              link = &g_neighbor_next[*link - 1];
+            }
         }
-    }
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
-   */
+      /* And link it into the chain of the new address */
+
+      net_ipv6addr_copy(neighbor->ne_ipaddr, ipaddr);
+
+      link = &g_neighbor_hash[NEIGHBOR_HASH(ipaddr)];
+      g_neighbor_next[oldest_ndx] = *link;
+      *link = oldest_ndx + 1;
+    }
 
-  g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  neighbor->ne_time = clock_systime_ticks();
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+  neighbor->ne_addr.na_lltype = dev->d_lltype;
+  neighbor->ne_addr.na_llsize = netdev_lladdrsize(dev);
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+  memcpy(&neighbor->ne_addr.u, addr, neighbor->ne_addr.na_llsize);
 
   /* Dump the contents of the new entry */
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+  neighbor_dumpentry("Added entry", neighbor);
 }
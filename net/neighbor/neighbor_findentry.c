@@ -51,17 +51,19 @@
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  uint8_t link = g_neighbor_hash[NEIGHBOR_HASH(ipaddr)];
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  while (link != 0)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      FAR struct neighbor_entry_s *neighbor = &g_neighbors[link - 1];
 
       if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
         {
           neighbor_dumpentry("Entry found", neighbor);
           return neighbor;
         }
+
+      link = g_neighbor_next[link - 1];
     }
 
   neighbor_dumpipaddr("Not found", ipaddr);
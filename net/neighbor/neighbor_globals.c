@@ -36,6 +36,11 @@
 
 struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+/* Hash buckets and chain links over g_neighbors[] */
+
+uint8_t g_neighbor_hash[NEIGHBOR_HASH_SIZE];
+uint8_t g_neighbor_next[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -130,6 +130,12 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
           memcpy(laddr, &neighbor->ne_addr, sizeof(*laddr));
         }
 
+      /* This makes the entry the most recently used, so the least
+       * recently used one is replaced when the table is full.
+       */
+
+      neighbor->ne_time = clock_systime_ticks();
+
       /* Return success in any case meaning that a valid link layer
        * address mapping is available for the IPv6 address.
        */
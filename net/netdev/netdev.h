@@ -36,6 +36,27 @@
 #  include <nuttx/wqueue.h>
 #endif
 
+#include <nuttx/rcu.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Protection of lookups in g_netdevices.  With RCU, the lookups do not
+ * serialize on the network lock:  netdev_register() publishes the new
+ * device with rcu_assign_pointer() and netdev_unregister() waits for a
+ * grace period before the device may be freed.  Modifications of the list
+ * always hold the network lock.
+ */
+
+#ifdef CONFIG_RCU
+#  define netdev_list_lock()    rcu_read_lock()
+#  define netdev_list_unlock()  rcu_read_unlock()
+#else
+#  define netdev_list_lock()    net_lock()
+#  define netdev_list_unlock()  net_unlock()
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -50,7 +71,8 @@ extern "C"
 #endif
 
 /* List of registered Ethernet device drivers.  You must have the network
- * locked in order to access this list.
+ * locked in order to access this list, or be inside netdev_list_lock() for
+ * read-only lookups.
  *
  * NOTE that this duplicates a declaration in net/tcp/tcp.h
  */
@@ -0,0 +1,281 @@
+/****************************************************************************
+ * net/netdev/netdev_iob.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NETDEV_IOB
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The room that the network needs in d_buf, starting at the link layer
+ * header.
+ */
+
+#define NETDEV_IOB_ROOM(dev) (NETDEV_PKTSIZE(dev) + CONFIG_NET_GUARDSIZE)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_attach
+ *
+ * Description:
+ *   Make iob the I/O buffer of the current packet.
+ *
+ ****************************************************************************/
+
+static void netdev_iob_attach(FAR struct net_driver_s *dev,
+                              FAR struct iob_s *iob)
+{
+  DEBUGASSERT(CONFIG_IOB_BUFSIZE - iob->io_offset >= NETDEV_IOB_ROOM(dev));
+
+  dev->d_iob = iob;
+  dev->d_buf = IOB_DATA(iob);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_prepare
+ *
+ * Description:
+ *   Make sure that the device has an I/O buffer for the next outgoing
+ *   packet and point d_buf at it.
+ *
+ ****************************************************************************/
+
+int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled)
+{
+  FAR struct iob_s *iob;
+
+  if (dev->d_iob == NULL)
+    {
+      iob = iob_tryalloc(throttled, IOBUSER_NET_NETDEV);
+      if (iob == NULL)
+        {
+          nwarn("WARNING: No I/O buffer for %s\n", dev->d_ifname);
+          return -ENOMEM;
+        }
+
+      netdev_iob_attach(dev, iob);
+    }
+
+  dev->d_len = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Free the I/O buffer held by the device, if any.
+ *
+ ****************************************************************************/
+
+void netdev_iob_release(FAR struct net_driver_s *dev)
+{
+  if (dev->d_iob != NULL)
+    {
+      iob_free_chain(dev->d_iob, IOBUSER_NET_NETDEV);
+      dev->d_iob = NULL;
+      dev->d_buf = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_rx_iob
+ *
+ * Description:
+ *   Pass a received packet held in an I/O buffer to the network.
+ *
+ ****************************************************************************/
+
+int netdev_rx_iob(FAR struct net_driver_s *dev, FAR struct iob_s *iob)
+{
+  DEBUGASSERT(iob != NULL);
+
+  netdev_iob_release(dev);
+
+  /* The packet must be contiguous and leave room for the largest response
+   * behind the data offset.  Normally the driver has received into a
+   * single buffer at offset zero and nothing needs to be done.
+   */
+
+  if (iob->io_flink != NULL ||
+      CONFIG_IOB_BUFSIZE - iob->io_offset < NETDEV_IOB_ROOM(dev))
+    {
+      iob = iob_pack(iob, IOBUSER_NET_NETDEV);
+      if (iob == NULL)
+        {
+          dev->d_len = 0;
+          return OK;
+        }
+    }
+
+  if (iob->io_flink != NULL || iob->io_pktlen > UINT16_MAX)
+    {
+      nerr("ERROR: Packet of %u bytes does not fit into one I/O buffer\n",
+           (unsigned int)iob->io_pktlen);
+      iob_free_chain(iob, IOBUSER_NET_NETDEV);
+      dev->d_len = 0;
+      return -EMSGSIZE;
+    }
+
+  netdev_iob_attach(dev, iob);
+  dev->d_len = iob->io_len;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: netdev_tx_iob
+ *
+ * Description:
+ *   Take the I/O buffer holding the outgoing packet from the device.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_tx_iob(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+
+  if (iob == NULL)
+    {
+      return NULL;
+    }
+
+  if (dev->d_len == 0)
+    {
+      netdev_iob_release(dev);
+      return NULL;
+    }
+
+  DEBUGASSERT(dev->d_buf == IOB_DATA(iob) &&
+              dev->d_len <= CONFIG_IOB_BUFSIZE - iob->io_offset);
+
+  iob->io_len    = dev->d_len;
+  iob->io_pktlen = dev->d_len;
+
+  dev->d_iob     = NULL;
+  dev->d_buf     = NULL;
+  return iob;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_take
+ *
+ * Description:
+ *   Detach the I/O buffer of the current incoming packet so that the part
+ *   of the packet at data can be queued without copying it.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_iob_take(FAR struct net_driver_s *dev,
+                                  FAR const uint8_t *data, uint16_t len)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct iob_s *niob;
+  unsigned int hdrlen;
+
+  if (iob == NULL || data < dev->d_buf)
+    {
+      return NULL;
+    }
+
+  /* Copying the data is cheaper than copying the headers if there is less
+   * data than headers.
+   */
+
+  hdrlen = data - dev->d_buf;
+  if (len <= hdrlen ||
+      hdrlen + len > CONFIG_IOB_BUFSIZE - iob->io_offset)
+    {
+      return NULL;
+    }
+
+  niob = iob_tryalloc(true, IOBUSER_NET_NETDEV);
+  if (niob == NULL)
+    {
+      return NULL;
+    }
+
+  /* Continue with a copy of the headers in the new buffer */
+
+  memcpy(IOB_DATA(niob), dev->d_buf, hdrlen);
+
+  dev->d_appdata = IOB_DATA(niob) + (dev->d_appdata - dev->d_buf);
+  netdev_iob_attach(dev, niob);
+
+  /* And leave only the data in the old one */
+
+  iob->io_offset += hdrlen;
+  iob->io_len     = len;
+  iob->io_pktlen  = len;
+  return iob;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_replace
+ *
+ * Description:
+ *   Make iob the I/O buffer of the current packet and return the I/O
+ *   buffer that the device held before.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_iob_replace(FAR struct net_driver_s *dev,
+                                     FAR struct iob_s *iob)
+{
+  FAR struct iob_s *old = dev->d_iob;
+
+  if (iob != NULL)
+    {
+      netdev_iob_attach(dev, iob);
+    }
+  else
+    {
+      dev->d_iob = NULL;
+      dev->d_buf = NULL;
+    }
+
+  return old;
+}
+
+#endif /* CONFIG_NETDEV_IOB */
@@ -75,6 +75,8 @@
 #include "icmpv6/icmpv6.h"
 #include "route/route.h"
 #include "netlink/netlink.h"
+#include "ipforward/ipforward.h"
+#include "tcp/tcp.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -142,6 +144,7 @@ static int ioctl_add_ipv4route(FAR struct rtentry *rtentry)
   in_addr_t target;
   in_addr_t netmask;
   in_addr_t router;
+  int ret;
 
   addr    = (FAR struct sockaddr_in *)&rtentry->rt_dst;
   target  = (in_addr_t)addr->sin_addr.s_addr;
@@ -152,7 +155,20 @@ static int ioctl_add_ipv4route(FAR struct rtentry *rtentry)
   addr    = (FAR struct sockaddr_in *)&rtentry->rt_gateway;
   router  = (in_addr_t)addr->sin_addr.s_addr;
 
-  return net_addroute_ipv4(target, netmask, router);
+  ret = net_addroute_ipv4(target, netmask, router);
+#ifdef CONFIG_NETLINK_ROUTE
+  if (ret >= 0)
+    {
+      struct net_route_ipv4_s route;
+
+      route.target  = target;
+      route.netmask = netmask;
+      route.router  = router;
+      netlink_ipv4route_notify(&route, RTM_NEWROUTE);
+    }
+#endif
+
+  return ret;
 }
 #endif /* HAVE_WRITABLE_IPv4ROUTE */
 
@@ -174,6 +190,7 @@ static int ioctl_add_ipv6route(FAR struct rtentry *rtentry)
   FAR struct sockaddr_in6 *netmask;
   FAR struct sockaddr_in6 *gateway;
   net_ipv6addr_t router;
+  int ret;
 
   target  = (FAR struct sockaddr_in6 *)&rtentry->rt_dst;
   netmask = (FAR struct sockaddr_in6 *)&rtentry->rt_genmask;
@@ -183,8 +200,21 @@ static int ioctl_add_ipv6route(FAR struct rtentry *rtentry)
   gateway = (FAR struct sockaddr_in6 *)&rtentry->rt_gateway;
   net_ipv6addr_copy(router, gateway->sin6_addr.s6_addr16);
 
-  return net_addroute_ipv6(target->sin6_addr.s6_addr16,
-                           netmask->sin6_addr.s6_addr16, router);
+  ret = net_addroute_ipv6(target->sin6_addr.s6_addr16,
+                          netmask->sin6_addr.s6_addr16, router);
+#ifdef CONFIG_NETLINK_ROUTE
+  if (ret >= 0)
+    {
+      struct net_route_ipv6_s route;
+
+      net_ipv6addr_copy(route.target, target->sin6_addr.s6_addr16);
+      net_ipv6addr_copy(route.netmask, netmask->sin6_addr.s6_addr16);
+      net_ipv6addr_copy(route.router, router);
+      netlink_ipv6route_notify(&route, RTM_NEWROUTE);
+    }
+#endif
+
+  return ret;
 }
 #endif /* HAVE_WRITABLE_IPv6ROUTE */
 
@@ -205,6 +235,7 @@ static int ioctl_del_ipv4route(FAR struct rtentry *rtentry)
   FAR struct sockaddr_in *addr;
   in_addr_t target;
   in_addr_t netmask;
+  int ret;
 
   addr    = (FAR struct sockaddr_in *)&rtentry->rt_dst;
   target  = (in_addr_t)addr->sin_addr.s_addr;
@@ -212,7 +243,20 @@ static int ioctl_del_ipv4route(FAR struct rtentry *rtentry)
   addr    = (FAR struct sockaddr_in *)&rtentry->rt_genmask;
   netmask = (in_addr_t)addr->sin_addr.s_addr;
 
-  return net_delroute_ipv4(target, netmask);
+  ret = net_delroute_ipv4(target, netmask);
+#ifdef CONFIG_NETLINK_ROUTE
+  if (ret >= 0)
+    {
+      struct net_route_ipv4_s route;
+
+      route.target  = target;
+      route.netmask = netmask;
+      route.router  = INADDR_ANY;
+      netlink_ipv4route_notify(&route, RTM_DELROUTE);
+    }
+#endif
+
+  return ret;
 }
 #endif /* HAVE_WRITABLE_IPv4ROUTE */
 
@@ -232,12 +276,26 @@ static int ioctl_del_ipv6route(FAR struct rtentry *rtentry)
 {
   FAR struct sockaddr_in6 *target;
   FAR struct sockaddr_in6 *netmask;
+  int ret;
 
   target  = (FAR struct sockaddr_in6 *)&rtentry->rt_dst;
   netmask = (FAR struct sockaddr_in6 *)&rtentry->rt_genmask;
 
-  return net_delroute_ipv6(target->sin6_addr.s6_addr16,
-                           netmask->sin6_addr.s6_addr16);
+  ret = net_delroute_ipv6(target->sin6_addr.s6_addr16,
+                          netmask->sin6_addr.s6_addr16);
+#ifdef CONFIG_NETLINK_ROUTE
+  if (ret >= 0)
+    {
+      struct net_route_ipv6_s route;
+
+      net_ipv6addr_copy(route.target, target->sin6_addr.s6_addr16);
+      net_ipv6addr_copy(route.netmask, netmask->sin6_addr.s6_addr16);
+      memset(route.router, 0, sizeof(net_ipv6addr_t));
+      netlink_ipv6route_notify(&route, RTM_DELROUTE);
+    }
+#endif
+
+  return ret;
 }
 #endif /* HAVE_WRITABLE_IPv6ROUTE */
 
@@ -665,6 +723,7 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
           if (dev)
             {
               ioctl_set_ipv4addr(&dev->d_ipaddr, &req->ifr_addr);
+              netlink_ipv4addr_notify(dev, RTM_NEWADDR);
               ret = OK;
             }
         }
@@ -769,6 +828,7 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
               FAR struct lifreq *lreq = (FAR struct lifreq *)req;
 
               ioctl_set_ipv6addr(dev->d_ipv6addr, &lreq->lifr_addr);
+              netlink_ipv6addr_notify(dev, RTM_NEWADDR);
               ret = OK;
             }
         }
@@ -1000,9 +1060,11 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
           if (dev)
             {
 #ifdef CONFIG_NET_IPv4
+              netlink_ipv4addr_notify(dev, RTM_DELADDR);
               dev->d_ipaddr = 0;
 #endif
 #ifdef CONFIG_NET_IPv6
+              netlink_ipv6addr_notify(dev, RTM_DELADDR);
               memset(&dev->d_ipv6addr, 0, sizeof(net_ipv6addr_t));
 #endif
               ret = OK;
@@ -1680,6 +1742,11 @@ ssize_t net_ioctl_arglen(int cmd)
       case SIOCSMIIREG:
         return sizeof(struct mii_ioctl_data_s);
 
+#ifdef CONFIG_NET_PKT_RING
+      case FIOC_MMAP:
+        return sizeof(FAR void *);
+#endif
+
       default:
 #ifdef CONFIG_NETDEV_IOCTL
 #  ifdef CONFIG_NETDEV_WIRELESS_IOCTL
@@ -1931,6 +1998,18 @@ void netdev_ifdown(FAR struct net_driver_s *dev)
 
       devif_dev_event(dev, NULL, NETDEV_DOWN);
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* Drop the packets of forwarded flows still queued for it */
+
+      ipfwd_flow_flush(dev);
+#endif
+
+#ifdef CONFIG_NET_TCP_GRO
+      /* And the TCP segment held back for merging */
+
+      tcp_gro_release(dev);
+#endif
+
 #ifdef CONFIG_NETDOWN_NOTIFIER
       /* Provide signal notifications to threads that want to be
        * notified of the network down state via signal.
@@ -437,9 +437,10 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
           last = &((*last)->flink);
         }
 
-      *last = dev;
+      /* The device must be complete before lock-less lookups find it */
 
       dev->flink = NULL;
+      rcu_assign_pointer(*last, dev);
 
 #ifdef CONFIG_NET_IGMP
       /* Configure the device for IGMP support */
@@ -37,6 +37,8 @@
 
 #include "utils/utils.h"
 #include "netdev/netdev.h"
+#include "ipforward/ipforward.h"
+#include "tcp/tcp.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -142,14 +144,35 @@ int netdev_unregister(FAR struct net_driver_s *dev)
               g_netdevices = curr->flink;
             }
 
+#ifndef CONFIG_RCU
           curr->flink = NULL;
+#endif
         }
 
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
 #endif
+#ifdef CONFIG_NETDEV_IOB
+      netdev_iob_release(dev);
+#endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      ipfwd_flow_flush(dev);
+#endif
+#ifdef CONFIG_NET_TCP_GRO
+      tcp_gro_release(dev);
+#endif
+
       net_unlock();
 
+#ifdef CONFIG_RCU
+      /* A lookup may still be walking past the device.  Wait for those
+       * lookups to finish before the caller may free it.
+       */
+
+      synchronize_rcu();
+      dev->flink = NULL;
+#endif
+
 #ifdef CONFIG_NET_ETHERNET
       ninfo("Unregistered MAC: %02x:%02x:%02x:%02x:%02x:%02x as dev: %s\n",
             dev->d_mac.ether.ether_addr_octet[0],
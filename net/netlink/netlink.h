@@ -45,6 +45,10 @@
 
 #ifndef CONFIG_NETLINK_ROUTE
   #define netlink_device_notify(dev)
+  #define netlink_ipv4addr_notify(dev, type)
+  #define netlink_ipv6addr_notify(dev, type)
+  #define netlink_ipv4route_notify(route, type)
+  #define netlink_ipv6route_notify(route, type)
 #endif
 
 #ifdef CONFIG_NET_NETLINK
@@ -73,8 +77,7 @@ struct netlink_conn_s
   /* poll() support */
 
   int key;                           /* used to cancel notifications */
-  FAR sem_t *pollsem;                /* Used to wakeup poll() */
-  FAR pollevent_t *pollevent;        /* poll() wakeup event */
+  FAR struct pollfd *fds;            /* Used to wakeup poll() */
 
   /* Queued response data */
 
@@ -219,6 +222,22 @@ void netlink_notifier_signal(FAR struct netlink_conn_s *conn);
 FAR struct netlink_response_s *
 netlink_tryget_response(FAR struct netlink_conn_s *conn);
 
+/****************************************************************************
+ * Name: netlink_tryget_response_fit
+ *
+ * Description:
+ *   Return the next response from the head of the pending response list,
+ *   but only if its message is no longer than maxlen.
+ *
+ * Returned Value:
+ *   The next response or NULL if the list is empty or the next response
+ *   does not fit.
+ *
+ ****************************************************************************/
+
+FAR struct netlink_response_s *
+netlink_tryget_response_fit(FAR struct netlink_conn_s *conn, size_t maxlen);
+
 /****************************************************************************
  * Name: netlink_get_response
  *
@@ -277,6 +296,53 @@ ssize_t netlink_route_sendto(NETLINK_HANDLE handle,
  ****************************************************************************/
 
 void netlink_device_notify(FAR struct net_driver_s *dev);
+
+/****************************************************************************
+ * Name: netlink_ipv4addr_notify() and netlink_ipv6addr_notify()
+ *
+ * Description:
+ *   Broadcast an address change of the device to the members of the
+ *   RTNLGRP_IPV4_IFADDR or RTNLGRP_IPV6_IFADDR group.
+ *
+ * Input Parameters:
+ *   dev  - The device whose address changed.  For RTM_DELADDR, this must
+ *          be called while the device still holds the old address.
+ *   type - RTM_NEWADDR or RTM_DELADDR
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+void netlink_ipv4addr_notify(FAR struct net_driver_s *dev, int type);
+#endif
+
+#ifdef CONFIG_NET_IPv6
+void netlink_ipv6addr_notify(FAR struct net_driver_s *dev, int type);
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv4route_notify() and netlink_ipv6route_notify()
+ *
+ * Description:
+ *   Broadcast a routing table change to the members of the
+ *   RTNLGRP_IPV4_ROUTE or RTNLGRP_IPV6_ROUTE group.
+ *
+ * Input Parameters:
+ *   route - The route added or deleted
+ *   type  - RTM_NEWROUTE or RTM_DELROUTE
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_IPv4)
+struct net_route_ipv4_s;
+void netlink_ipv4route_notify(FAR const struct net_route_ipv4_s *route,
+                              int type);
+#endif
+
+#if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_IPv6)
+struct net_route_ipv6_s;
+void netlink_ipv6route_notify(FAR const struct net_route_ipv6_s *route,
+                              int type);
+#endif
 #endif
 
 #undef EXTERN
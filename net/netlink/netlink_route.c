@@ -40,7 +40,9 @@
 #include <nuttx/net/neighbor.h>
 #include <nuttx/net/netlink.h>
 
+#include "utils/utils.h"
 #include "netdev/netdev.h"
+#include "inet/inet.h"
 #include "arp/arp.h"
 #include "neighbor/neighbor.h"
 #include "route/route.h"
@@ -65,6 +67,11 @@
 #  define CONFIG_NETLINK_DISABLE_GETROUTE 1
 #endif
 
+#if !defined(CONFIG_NET_IPv4) && !defined(CONFIG_NET_IPv6)
+#  undef CONFIG_NETLINK_DISABLE_GETADDR
+#  define CONFIG_NETLINK_DISABLE_GETADDR 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -151,6 +158,35 @@ struct getroute_recvfrom_ipv6resplist_s
   struct getroute_recvfrom_ipv6response_s payload;
 };
 
+/* RTM_GETADDR:  Enumerate the addresses of the network devices */
+
+struct getaddr_recvfrom_ipv4response_s
+{
+  struct nlmsghdr  hdr;
+  struct ifaddrmsg ifaddr;
+  struct getroute_recvfrom_ipv4addr_s address;
+  struct getroute_recvfrom_ipv4addr_s local;
+};
+
+struct getaddr_recvfrom_ipv4resplist_s
+{
+  sq_entry_t flink;
+  struct getaddr_recvfrom_ipv4response_s payload;
+};
+
+struct getaddr_recvfrom_ipv6response_s
+{
+  struct nlmsghdr  hdr;
+  struct ifaddrmsg ifaddr;
+  struct getroute_recvfrom_ipv6addr_s address;
+};
+
+struct getaddr_recvfrom_ipv6resplist_s
+{
+  sq_entry_t flink;
+  struct getaddr_recvfrom_ipv6response_s payload;
+};
+
 /* netdev_foreach() callback */
 
 struct nlroute_sendto_request_s
@@ -202,7 +238,7 @@ netlink_get_device(FAR struct net_driver_s *dev,
 
   resp->hdr.nlmsg_len    = sizeof(struct getlink_recvfrom_response_s);
   resp->hdr.nlmsg_type   = up ? RTM_NEWLINK : RTM_DELLINK;
-  resp->hdr.nlmsg_flags  = req ? req->hdr.nlmsg_flags : 0;
+  resp->hdr.nlmsg_flags  = req ? req->hdr.nlmsg_flags | NLM_F_MULTI : 0;
   resp->hdr.nlmsg_seq    = req ? req->hdr.nlmsg_seq : 0;
   resp->hdr.nlmsg_pid    = req ? req->hdr.nlmsg_pid : 0;
 
@@ -253,7 +289,7 @@ netlink_get_terminator(FAR const struct nlroute_sendto_request_s *req)
   hdr              = &resp->msg;
   hdr->nlmsg_len   = sizeof(struct nlmsghdr);
   hdr->nlmsg_type  = NLMSG_DONE;
-  hdr->nlmsg_flags = req ? req->hdr.nlmsg_flags : 0;
+  hdr->nlmsg_flags = req ? req->hdr.nlmsg_flags | NLM_F_MULTI : 0;
   hdr->nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
   hdr->nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
 
@@ -500,23 +536,22 @@ static int netlink_get_nbtable(NETLINK_HANDLE handle,
 #endif
 
 /****************************************************************************
- * Name: netlink_ipv4_route
+ * Name: netlink_ipv4route_response
  *
  * Description:
- *   Dump a list of all network devices of the specified type.
+ *   Generate one IPv4 routing table entry message.  req is NULL for an
+ *   unsolicited route change event.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
-static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
-                              FAR void *arg)
+#if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_IPv4)
+static FAR struct netlink_response_s *
+netlink_ipv4route_response(FAR const struct net_route_ipv4_s *route,
+                           int type,
+                           FAR const struct nlroute_sendto_request_s *req)
 {
   FAR struct getroute_recvfrom_ipv4resplist_s *alloc;
   FAR struct getroute_recvfrom_ipv4response_s *resp;
-  FAR struct nlroute_info_s *info;
-
-  DEBUGASSERT(route != NULL && arg != NULL);
-  info = (FAR struct nlroute_info_s *)arg;
 
   /* Allocate the response */
 
@@ -524,19 +559,19 @@ static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
     kmm_zalloc(sizeof(struct getroute_recvfrom_ipv4resplist_s));
   if (alloc == NULL)
     {
-      return -ENOMEM;
+      return NULL;
     }
 
   /* Format the response */
 
   resp                  = &alloc->payload;
   resp->hdr.nlmsg_len   = sizeof(struct getroute_recvfrom_ipv4response_s);
-  resp->hdr.nlmsg_type  = RTM_NEWROUTE;
-  resp->hdr.nlmsg_flags = info->req->hdr.nlmsg_flags;
-  resp->hdr.nlmsg_seq   = info->req->hdr.nlmsg_seq;
-  resp->hdr.nlmsg_pid   = info->req->hdr.nlmsg_pid;
+  resp->hdr.nlmsg_type  = type;
+  resp->hdr.nlmsg_flags = req ? req->hdr.nlmsg_flags | NLM_F_MULTI : 0;
+  resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
 
-  resp->rte.rtm_family   = info->req->gen.rtgen_family;
+  resp->rte.rtm_family   = AF_INET;
   resp->rte.rtm_table    = RT_TABLE_MAIN;
   resp->rte.rtm_protocol = RTPROT_STATIC;
   resp->rte.rtm_scope    = RT_SCOPE_SITE;
@@ -553,9 +588,37 @@ static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
   resp->gateway.attr.rta_type = RTA_GATEWAY;
   resp->gateway.addr          = route->router;
 
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv4_route
+ *
+ * Description:
+ *   Add the response for one routing table entry to the dump.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
+                              FAR void *arg)
+{
+  FAR struct netlink_response_s *resp;
+  FAR struct nlroute_info_s *info;
+
+  DEBUGASSERT(route != NULL && arg != NULL);
+  info = (FAR struct nlroute_info_s *)arg;
+
+  resp = netlink_ipv4route_response(route, RTM_NEWROUTE, info->req);
+  if (resp == NULL)
+    {
+      return -ENOMEM;
+    }
+
   /* Finally, add the response to the list of pending responses */
 
-  netlink_add_response(info->handle, (FAR struct netlink_response_s *)alloc);
+  netlink_add_response(info->handle, resp);
   return OK;
 }
 #endif
@@ -593,23 +656,22 @@ static int netlink_get_ipv4route(NETLINK_HANDLE handle,
 #endif
 
 /****************************************************************************
- * Name: netlink_ipv6_route
+ * Name: netlink_ipv6route_response
  *
  * Description:
- *   Dump a list of all network devices of the specified type.
+ *   Generate one IPv6 routing table entry message.  req is NULL for an
+ *   unsolicited route change event.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
-static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
-                              FAR void *arg)
+#if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_IPv6)
+static FAR struct netlink_response_s *
+netlink_ipv6route_response(FAR const struct net_route_ipv6_s *route,
+                           int type,
+                           FAR const struct nlroute_sendto_request_s *req)
 {
   FAR struct getroute_recvfrom_ipv6resplist_s *alloc;
   FAR struct getroute_recvfrom_ipv6response_s *resp;
-  FAR struct nlroute_info_s *info;
-
-  DEBUGASSERT(route != NULL && arg != NULL);
-  info = (FAR struct nlroute_info_s *)arg;
 
   /* Allocate the response */
 
@@ -617,19 +679,19 @@ static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
     kmm_zalloc(sizeof(struct getroute_recvfrom_ipv6resplist_s));
   if (alloc == NULL)
     {
-      return -ENOMEM;
+      return NULL;
     }
 
   /* Format the response */
 
   resp                  = &alloc->payload;
   resp->hdr.nlmsg_len   = sizeof(struct getroute_recvfrom_ipv6response_s);
-  resp->hdr.nlmsg_type  = RTM_NEWROUTE;
-  resp->hdr.nlmsg_flags = info->req->hdr.nlmsg_flags;
-  resp->hdr.nlmsg_seq   = info->req->hdr.nlmsg_seq;
-  resp->hdr.nlmsg_pid   = info->req->hdr.nlmsg_pid;
+  resp->hdr.nlmsg_type  = type;
+  resp->hdr.nlmsg_flags = req ? req->hdr.nlmsg_flags | NLM_F_MULTI : 0;
+  resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
 
-  resp->rte.rtm_family   = info->req->gen.rtgen_family;
+  resp->rte.rtm_family   = AF_INET6;
   resp->rte.rtm_table    = RT_TABLE_MAIN;
   resp->rte.rtm_protocol = RTPROT_STATIC;
   resp->rte.rtm_scope    = RT_SCOPE_SITE;
@@ -646,9 +708,37 @@ static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
   resp->gateway.attr.rta_type = RTA_GATEWAY;
   net_ipv6addr_copy(resp->gateway.addr, route->router);
 
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv6_route
+ *
+ * Description:
+ *   Add the response for one routing table entry to the dump.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
+                              FAR void *arg)
+{
+  FAR struct netlink_response_s *resp;
+  FAR struct nlroute_info_s *info;
+
+  DEBUGASSERT(route != NULL && arg != NULL);
+  info = (FAR struct nlroute_info_s *)arg;
+
+  resp = netlink_ipv6route_response(route, RTM_NEWROUTE, info->req);
+  if (resp == NULL)
+    {
+      return -ENOMEM;
+    }
+
   /* Finally, add the response to the list of pending responses */
 
-  netlink_add_response(info->handle, (FAR struct netlink_response_s *)alloc);
+  netlink_add_response(info->handle, resp);
   return OK;
 }
 #endif
@@ -685,6 +775,184 @@ static int netlink_get_ip6vroute(NETLINK_HANDLE handle,
 }
 #endif
 
+/****************************************************************************
+ * Name: netlink_ipv4addr_response
+ *
+ * Description:
+ *   Generate one IPv4 interface address message.  req is NULL for an
+ *   unsolicited address change event.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static FAR struct netlink_response_s *
+netlink_ipv4addr_response(FAR struct net_driver_s *dev, int type,
+                          FAR const struct nlroute_sendto_request_s *req)
+{
+  FAR struct getaddr_recvfrom_ipv4resplist_s *alloc;
+  FAR struct getaddr_recvfrom_ipv4response_s *resp;
+  uint32_t mask;
+
+  alloc = (FAR struct getaddr_recvfrom_ipv4resplist_s *)
+    kmm_zalloc(sizeof(struct getaddr_recvfrom_ipv4resplist_s));
+  if (alloc == NULL)
+    {
+      nerr("ERROR: Failed to allocate response buffer.\n");
+      return NULL;
+    }
+
+  resp                  = &alloc->payload;
+  resp->hdr.nlmsg_len   = sizeof(struct getaddr_recvfrom_ipv4response_s);
+  resp->hdr.nlmsg_type  = type;
+  resp->hdr.nlmsg_flags = req ? req->hdr.nlmsg_flags | NLM_F_MULTI : 0;
+  resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
+
+  resp->ifaddr.ifa_family = AF_INET;
+  resp->ifaddr.ifa_scope  = RT_SCOPE_UNIVERSE;
+#ifdef CONFIG_NETDEV_IFINDEX
+  resp->ifaddr.ifa_index  = dev->d_ifindex;
+#endif
+
+  /* The netmask is contiguous, its prefix length is the number of bits
+   * set.
+   */
+
+  for (mask = NTOHL(dev->d_netmask); mask != 0; mask <<= 1)
+    {
+      resp->ifaddr.ifa_prefixlen++;
+    }
+
+  resp->address.attr.rta_len  = RTA_LENGTH(sizeof(in_addr_t));
+  resp->address.attr.rta_type = IFA_ADDRESS;
+  resp->address.addr          = dev->d_ipaddr;
+
+  resp->local.attr.rta_len    = RTA_LENGTH(sizeof(in_addr_t));
+  resp->local.attr.rta_type   = IFA_LOCAL;
+  resp->local.addr            = dev->d_ipaddr;
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv6addr_response
+ *
+ * Description:
+ *   Generate one IPv6 interface address message.  req is NULL for an
+ *   unsolicited address change event.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static FAR struct netlink_response_s *
+netlink_ipv6addr_response(FAR struct net_driver_s *dev, int type,
+                          FAR const struct nlroute_sendto_request_s *req)
+{
+  FAR struct getaddr_recvfrom_ipv6resplist_s *alloc;
+  FAR struct getaddr_recvfrom_ipv6response_s *resp;
+
+  alloc = (FAR struct getaddr_recvfrom_ipv6resplist_s *)
+    kmm_zalloc(sizeof(struct getaddr_recvfrom_ipv6resplist_s));
+  if (alloc == NULL)
+    {
+      nerr("ERROR: Failed to allocate response buffer.\n");
+      return NULL;
+    }
+
+  resp                  = &alloc->payload;
+  resp->hdr.nlmsg_len   = sizeof(struct getaddr_recvfrom_ipv6response_s);
+  resp->hdr.nlmsg_type  = type;
+  resp->hdr.nlmsg_flags = req ? req->hdr.nlmsg_flags | NLM_F_MULTI : 0;
+  resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
+
+  resp->ifaddr.ifa_family    = AF_INET6;
+  resp->ifaddr.ifa_prefixlen = net_ipv6_mask2pref(dev->d_ipv6netmask);
+  resp->ifaddr.ifa_scope     = RT_SCOPE_UNIVERSE;
+#ifdef CONFIG_NETDEV_IFINDEX
+  resp->ifaddr.ifa_index     = dev->d_ifindex;
+#endif
+
+  resp->address.attr.rta_len  = RTA_LENGTH(sizeof(net_ipv6addr_t));
+  resp->address.attr.rta_type = IFA_ADDRESS;
+  net_ipv6addr_copy(resp->address.addr, dev->d_ipv6addr);
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_get_addrlist
+ *
+ * Description:
+ *   Dump the addresses of all network devices.  Each address is queued as
+ *   a separate part of a multi-part response as the devices are visited.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETADDR
+static int netlink_addr_callback(FAR struct net_driver_s *dev,
+                                 FAR void *arg)
+{
+  FAR struct nlroute_info_s *info = arg;
+  FAR struct netlink_response_s *resp;
+  uint8_t family = info->req->gen.rtgen_family;
+
+#ifdef CONFIG_NET_IPv4
+  if ((family == AF_UNSPEC || family == AF_INET) &&
+      !net_ipv4addr_cmp(dev->d_ipaddr, INADDR_ANY))
+    {
+      resp = netlink_ipv4addr_response(dev, RTM_NEWADDR, info->req);
+      if (resp == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      netlink_add_response(info->handle, resp);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((family == AF_UNSPEC || family == AF_INET6) &&
+      !net_ipv6addr_cmp(dev->d_ipv6addr, g_ipv6_unspecaddr))
+    {
+      resp = netlink_ipv6addr_response(dev, RTM_NEWADDR, info->req);
+      if (resp == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      netlink_add_response(info->handle, resp);
+    }
+#endif
+
+  return OK;
+}
+
+static int netlink_get_addrlist(NETLINK_HANDLE handle,
+                              FAR const struct nlroute_sendto_request_s *req)
+{
+  struct nlroute_info_s info;
+  int ret;
+
+  /* Visit each device */
+
+  info.handle = handle;
+  info.req    = req;
+
+  net_lock();
+  ret = netdev_foreach(netlink_addr_callback, &info);
+  net_unlock();
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return netlink_add_terminator(handle, req);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -728,6 +996,14 @@ ssize_t netlink_route_sendto(NETLINK_HANDLE handle,
         break;
 #endif
 
+#ifndef CONFIG_NETLINK_DISABLE_GETADDR
+      /* Dump the addresses of all devices */
+
+      case RTM_GETADDR:
+        ret = netlink_get_addrlist(handle, req);
+        break;
+#endif
+
 #ifndef CONFIG_NETLINK_DISABLE_GETNEIGH
       /* Retrieve ARP/Neighbor Tables */
 
@@ -825,4 +1101,102 @@ void netlink_device_notify(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: netlink_ipv4addr_notify()
+ *
+ * Description:
+ *   Broadcast an IPv4 address change of the device to the members of the
+ *   RTNLGRP_IPV4_IFADDR group.  type is RTM_NEWADDR or RTM_DELADDR.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+void netlink_ipv4addr_notify(FAR struct net_driver_s *dev, int type)
+{
+  FAR struct netlink_response_s *resp;
+
+  DEBUGASSERT(dev != NULL);
+
+  resp = netlink_ipv4addr_response(dev, type, NULL);
+  if (resp != NULL)
+    {
+      netlink_add_broadcast(RTNLGRP_IPV4_IFADDR, resp);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv6addr_notify()
+ *
+ * Description:
+ *   Broadcast an IPv6 address change of the device to the members of the
+ *   RTNLGRP_IPV6_IFADDR group.  type is RTM_NEWADDR or RTM_DELADDR.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+void netlink_ipv6addr_notify(FAR struct net_driver_s *dev, int type)
+{
+  FAR struct netlink_response_s *resp;
+
+  DEBUGASSERT(dev != NULL);
+
+  resp = netlink_ipv6addr_response(dev, type, NULL);
+  if (resp != NULL)
+    {
+      netlink_add_broadcast(RTNLGRP_IPV6_IFADDR, resp);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv4route_notify()
+ *
+ * Description:
+ *   Broadcast a change of the IPv4 routing table to the members of the
+ *   RTNLGRP_IPV4_ROUTE group.  type is RTM_NEWROUTE or RTM_DELROUTE.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_IPv4)
+void netlink_ipv4route_notify(FAR const struct net_route_ipv4_s *route,
+                              int type)
+{
+  FAR struct netlink_response_s *resp;
+
+  DEBUGASSERT(route != NULL);
+
+  resp = netlink_ipv4route_response(route, type, NULL);
+  if (resp != NULL)
+    {
+      netlink_add_broadcast(RTNLGRP_IPV4_ROUTE, resp);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv6route_notify()
+ *
+ * Description:
+ *   Broadcast a change of the IPv6 routing table to the members of the
+ *   RTNLGRP_IPV6_ROUTE group.  type is RTM_NEWROUTE or RTM_DELROUTE.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_IPv6)
+void netlink_ipv6route_notify(FAR const struct net_route_ipv6_s *route,
+                              int type)
+{
+  FAR struct netlink_response_s *resp;
+
+  DEBUGASSERT(route != NULL);
+
+  resp = netlink_ipv6route_response(route, type, NULL);
+  if (resp != NULL)
+    {
+      netlink_add_broadcast(RTNLGRP_IPV6_ROUTE, resp);
+    }
+}
+#endif
+
 #endif /* CONFIG_NETLINK_ROUTE */
@@ -36,6 +36,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/net/net.h>
 
@@ -516,12 +517,11 @@ static void netlink_response_available(FAR void *arg)
   sched_lock();
   net_lock();
 
-  if (conn->pollsem != NULL && conn->pollevent != NULL)
+  if (conn->fds != NULL)
     {
       /* Wake up the poll() with POLLIN */
 
-       *conn->pollevent |= POLLIN;
-       nxsem_post(conn->pollsem);
+      poll_notify(&conn->fds, 1, POLLIN);
     }
   else
     {
@@ -530,8 +530,7 @@ static void netlink_response_available(FAR void *arg)
 
   /* Allow another poll() */
 
-  conn->pollsem   = NULL;
-  conn->pollevent = NULL;
+  conn->fds = NULL;
 
   net_unlock();
   sched_unlock();
@@ -595,7 +594,7 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
       if (revents != 0)
         {
           fds->revents = revents;
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, 0);
           net_unlock();
           return OK;
         }
@@ -610,7 +609,7 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
            * on the Netlink connection.
            */
 
-          if (conn->pollsem != NULL || conn->pollevent != NULL)
+          if (conn->fds != NULL)
             {
               nerr("ERROR: Multiple polls() on socket not supported.\n");
               net_unlock();
@@ -619,16 +618,14 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
 
           /* Set up the notification */
 
-          conn->pollsem    = fds->sem;
-          conn->pollevent  = &fds->revents;
+          conn->fds = fds;
 
           ret = netlink_notifier_setup(netlink_response_available,
                                        conn, conn);
           if (ret < 0)
             {
               nerr("ERROR: netlink_notifier_setup() failed: %d\n", ret);
-              conn->pollsem   = NULL;
-              conn->pollevent = NULL;
+              conn->fds = NULL;
             }
         }
 
@@ -639,8 +636,7 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
       /* Cancel any response notifications */
 
       netlink_notifier_teardown(conn);
-      conn->pollsem   = NULL;
-      conn->pollevent = NULL;
+      conn->fds = NULL;
     }
 
   return ret;
@@ -762,6 +758,10 @@ static ssize_t netlink_recvmsg(FAR struct socket *psock,
   FAR socklen_t *fromlen = &msg->msg_namelen;
   FAR struct netlink_response_s *entry;
   FAR struct socket_conn_s *conn;
+#ifdef CONFIG_NETLINK_RECV_BATCH
+  size_t buflen = len;
+  size_t offset;
+#endif
 
   DEBUGASSERT(psock != NULL && psock->s_conn != NULL && buf != NULL);
   DEBUGASSERT(from == NULL ||
@@ -803,6 +803,26 @@ static ssize_t netlink_recvmsg(FAR struct socket *psock,
   memcpy(buf, &entry->msg, len);
   kmm_free(entry);
 
+#ifdef CONFIG_NETLINK_RECV_BATCH
+  /* Append the following responses as long as they fit completely, so
+   * that the parts of a dump or a burst of events need fewer calls.
+   */
+
+  offset = NLMSG_ALIGN(len);
+  while (offset < buflen &&
+         (entry = netlink_tryget_response_fit(psock->s_conn,
+                                              buflen - offset)) != NULL)
+    {
+      memset((FAR uint8_t *)buf + len, 0, offset - len);
+      memcpy((FAR uint8_t *)buf + offset, &entry->msg,
+             entry->msg.nlmsg_len);
+
+      len    = offset + entry->msg.nlmsg_len;
+      offset = NLMSG_ALIGN(len);
+      kmm_free(entry);
+    }
+#endif
+
   if (from != NULL)
     {
       netlink_getpeername(psock, from, fromlen);
@@ -29,6 +29,7 @@
 
 #include <sys/types.h>
 #include <queue.h>
+#include <poll.h>
 
 #include <nuttx/net/net.h>
 
@@ -53,6 +54,19 @@
 
 struct devif_callback_s; /* Forward reference */
 
+#ifdef CONFIG_NET_PKT_RING
+/* A frame ring shared with the application (see PACKET_RX_RING) */
+
+struct pkt_ring_s
+{
+  FAR uint8_t *pr_base;      /* The first block of the ring */
+  uint32_t     pr_blocksize; /* Size of one block */
+  uint32_t     pr_framesize; /* Size of one frame */
+  uint32_t     pr_framenr;   /* Number of frames, zero if there is no ring */
+  uint32_t     pr_head;      /* The next frame used by the kernel */
+};
+#endif
+
 struct pkt_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -65,6 +79,20 @@ struct pkt_conn_s
   uint8_t    ifindex;
   uint16_t   proto;
   uint8_t    crefs;    /* Reference counts on this instance */
+
+#ifdef CONFIG_NET_PKT_RING
+  /* The memory of the receive ring followed by that of the transmit ring,
+   * and the threads polling for the rings.
+   */
+
+  FAR uint8_t *ringmem;
+  size_t       ringsize;
+  bool         mapped;   /* The rings were mapped by the application */
+  bool         losing;   /* Received packets were dropped */
+  struct pkt_ring_s rxring;
+  struct pkt_ring_s txring;
+  FAR struct pollfd *fds[CONFIG_NET_PKT_NPOLLWAITERS];
+#endif
 };
 
 /****************************************************************************
@@ -284,6 +312,98 @@ void pkt_poll(FAR struct net_driver_s *dev, FAR struct pkt_conn_s *conn);
 ssize_t pkt_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                     int flags);
 
+#ifdef CONFIG_NET_PKT_RING
+
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   pkt_setsockopt() sets the SOL_PACKET option specified by the 'option'
+ *   argument to the value pointed to by the 'value' argument for the socket
+ *   specified by the 'psock' argument.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of socket to operate on
+ *   option    identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.
+ *
+ ****************************************************************************/
+
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len);
+
+/****************************************************************************
+ * Name: pkt_ring_mmap
+ *
+ * Description:
+ *   Return the address of the rings of a packet socket for mmap().
+ *
+ ****************************************************************************/
+
+int pkt_ring_mmap(FAR struct pkt_conn_s *conn, FAR void **addr);
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Store the received packet in the next free frame of the receive ring of
+ *   a packet socket.
+ *
+ * Returned Value:
+ *   true if the socket has a receive ring and the packet was consumed by it
+ *   (stored or dropped because the ring is full).  false if the packet has
+ *   to be passed to the socket as usual.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn);
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send all frames of the transmit ring that the application marked with
+ *   TP_STATUS_SEND_REQUEST.
+ *
+ * Returned Value:
+ *   The number of bytes sent, or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pkt_ring_send(FAR struct socket *psock);
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down a poll for the rings of a packet socket.
+ *
+ ****************************************************************************/
+
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup);
+
+/****************************************************************************
+ * Name: pkt_ring_free
+ *
+ * Description:
+ *   Release the rings of a packet socket that is being closed.
+ *
+ ****************************************************************************/
+
+void pkt_ring_free(FAR struct pkt_conn_s *conn);
+
+#endif /* CONFIG_NET_PKT_RING */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -72,6 +72,15 @@ int pkt_input(struct net_driver_s *dev)
   int ret = OK;
 
   conn = pkt_active(pbuf);
+#ifdef CONFIG_NET_PKT_RING
+  if (conn && pkt_ring_input(dev, conn))
+    {
+      /* The packet is in the receive ring shared with the application */
+
+      return OK;
+    }
+#endif
+
   if (conn)
     {
       uint16_t flags;
@@ -0,0 +1,653 @@
+/****************************************************************************
+ * net/pkt/pkt_ring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netpacket/packet.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ethernet.h>
+
+#include "netdev/netdev.h"
+#include "devif/devif.h"
+#include "socket/socket.h"
+#include "pkt/pkt.h"
+
+#ifdef CONFIG_NET_PKT_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Offsets in a frame */
+
+#define PKT_RING_SLLOFF  TPACKET_ALIGN(sizeof(struct tpacket_hdr))
+#define PKT_RING_NETOFF  TPACKET_ALIGN(TPACKET_HDRLEN + ETH_HDRLEN)
+#define PKT_RING_MACOFF  (PKT_RING_NETOFF - ETH_HDRLEN)
+#define PKT_RING_TXOFF   (TPACKET_HDRLEN - sizeof(struct sockaddr_ll))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of a transmit ring flush */
+
+struct pkt_ring_send_s
+{
+  FAR struct pkt_conn_s       *ps_conn;
+  FAR struct devif_callback_s *ps_cb;   /* Reference to callback instance */
+  sem_t                        ps_sem;  /* Wakes up the waiting thread */
+  ssize_t                      ps_sent; /* The number of bytes sent */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_frame
+ *
+ * Description:
+ *   Return the header of frame ndx of a ring.  Frames never cross the
+ *   boundary of a block.
+ *
+ ****************************************************************************/
+
+static FAR volatile struct tpacket_hdr *
+pkt_ring_frame(FAR struct pkt_ring_s *ring, uint32_t ndx)
+{
+  uint32_t perblock = ring->pr_blocksize / ring->pr_framesize;
+
+  return (FAR volatile struct tpacket_hdr *)
+    (ring->pr_base + (ndx / perblock) * ring->pr_blocksize +
+     (ndx % perblock) * ring->pr_framesize);
+}
+
+/****************************************************************************
+ * Name: pkt_ring_size
+ *
+ * Description:
+ *   Validate a ring request and return the size of its memory.
+ *
+ ****************************************************************************/
+
+static ssize_t pkt_ring_size(FAR const struct tpacket_req *req)
+{
+  uint32_t perblock;
+
+  if (req->tp_frame_nr == 0)
+    {
+      return 0;
+    }
+
+  if (req->tp_block_size == 0 || req->tp_block_nr == 0 ||
+      (req->tp_block_size % TPACKET_ALIGNMENT) != 0 ||
+      (req->tp_frame_size % TPACKET_ALIGNMENT) != 0 ||
+      req->tp_frame_size < PKT_RING_NETOFF ||
+      req->tp_frame_size > req->tp_block_size ||
+      req->tp_block_nr > SSIZE_MAX / req->tp_block_size)
+    {
+      return -EINVAL;
+    }
+
+  perblock = req->tp_block_size / req->tp_frame_size;
+  if (req->tp_frame_nr != perblock * req->tp_block_nr)
+    {
+      return -EINVAL;
+    }
+
+  return (ssize_t)req->tp_block_size * req->tp_block_nr;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_memsize
+ *
+ * Description:
+ *   Return the size of the memory of a ring that is set up.
+ *
+ ****************************************************************************/
+
+static size_t pkt_ring_memsize(FAR struct pkt_ring_s *ring)
+{
+  if (ring->pr_framenr == 0)
+    {
+      return 0;
+    }
+
+  return (size_t)(ring->pr_framenr /
+                  (ring->pr_blocksize / ring->pr_framesize)) *
+         ring->pr_blocksize;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_events
+ *
+ * Description:
+ *   Return the poll events that the rings of a packet socket signal now.
+ *
+ ****************************************************************************/
+
+static pollevent_t pkt_ring_events(FAR struct pkt_conn_s *conn)
+{
+  FAR struct pkt_ring_s *ring;
+  pollevent_t eventset = 0;
+  uint32_t prev;
+
+  /* There is something to read if the application did not hand the last
+   * frame filled by the network back yet.
+   */
+
+  ring = &conn->rxring;
+  if (ring->pr_framenr > 0)
+    {
+      prev = ring->pr_head == 0 ? ring->pr_framenr - 1 : ring->pr_head - 1;
+      if (pkt_ring_frame(ring, prev)->tp_status != TP_STATUS_KERNEL)
+        {
+          eventset |= POLLIN;
+        }
+    }
+
+  ring = &conn->txring;
+  if (ring->pr_framenr == 0 ||
+      pkt_ring_frame(ring, ring->pr_head)->tp_status == TP_STATUS_AVAILABLE)
+    {
+      eventset |= POLLOUT;
+    }
+
+  return eventset;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_send_eventhandler
+ *
+ * Description:
+ *   Send the next frame of the transmit ring for each poll of the device.
+ *
+ ****************************************************************************/
+
+static uint16_t pkt_ring_send_eventhandler(FAR struct net_driver_s *dev,
+                                           FAR void *pvconn,
+                                           FAR void *pvpriv, uint16_t flags)
+{
+  FAR struct pkt_ring_send_s *pstate = (FAR struct pkt_ring_send_s *)pvpriv;
+  FAR volatile struct tpacket_hdr *hdr;
+  FAR struct pkt_ring_s *ring;
+  uint32_t len;
+  uint32_t i;
+
+  if (pstate == NULL)
+    {
+      return flags;
+    }
+
+  /* Wait for the next polling cycle if the buffer is busy */
+
+  if (dev->d_sndlen > 0 || (flags & PKT_NEWDATA) != 0)
+    {
+      return flags;
+    }
+
+  ring = &pstate->ps_conn->txring;
+  for (i = 0; i < ring->pr_framenr; i++)
+    {
+      hdr = pkt_ring_frame(ring, ring->pr_head);
+      if (hdr->tp_status != TP_STATUS_SEND_REQUEST)
+        {
+          break;
+        }
+
+      /* Read the frame only after its status */
+
+      SP_DMB();
+
+      len = hdr->tp_len;
+      if (len == 0 || len > ring->pr_framesize - PKT_RING_TXOFF ||
+          len > NETDEV_PKTSIZE(dev))
+        {
+          nwarn("WARNING: Bad frame of %" PRIu32 " bytes\n", len);
+          hdr->tp_status = TP_STATUS_WRONG_FORMAT;
+          ring->pr_head  = (ring->pr_head + 1) % ring->pr_framenr;
+          continue;
+        }
+
+      devif_pkt_send(dev, (FAR uint8_t *)hdr + PKT_RING_TXOFF, len);
+      IFF_SET_NOARP(dev->d_flags);
+      pstate->ps_sent += len;
+
+      /* The packet is in the device buffer, the frame may be reused */
+
+      SP_DMB();
+
+      hdr->tp_status = TP_STATUS_AVAILABLE;
+      ring->pr_head  = (ring->pr_head + 1) % ring->pr_framenr;
+
+      poll_notify(pstate->ps_conn->fds, CONFIG_NET_PKT_NPOLLWAITERS,
+                  POLLOUT);
+
+      /* Get polled again soon if there are more frames to send */
+
+      if (pkt_ring_frame(ring, ring->pr_head)->tp_status ==
+          TP_STATUS_SEND_REQUEST)
+        {
+          netdev_txnotify_dev(dev);
+          return flags;
+        }
+
+      break;
+    }
+
+  /* All requested frames have been sent, don't allow any further call
+   * backs.
+   */
+
+  pstate->ps_cb->flags = 0;
+  pstate->ps_cb->priv  = NULL;
+  pstate->ps_cb->event = NULL;
+
+  nxsem_post(&pstate->ps_sem);
+  return flags;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   pkt_setsockopt() sets the SOL_PACKET option specified by the 'option'
+ *   argument to the value pointed to by the 'value' argument for the socket
+ *   specified by the 'psock' argument.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of socket to operate on
+ *   option    identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.
+ *
+ ****************************************************************************/
+
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len)
+{
+  FAR struct pkt_conn_s *conn = psock->s_conn;
+  FAR const struct tpacket_req *req = value;
+  FAR struct pkt_ring_s *ring;
+  FAR struct pkt_ring_s *other;
+  FAR uint8_t *mem = NULL;
+  ssize_t size;
+  size_t othersize;
+  int ret = OK;
+
+  if (psock->s_domain != PF_PACKET)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  switch (option)
+    {
+      case PACKET_RX_RING:
+        ring  = &conn->rxring;
+        other = &conn->txring;
+        break;
+
+      case PACKET_TX_RING:
+        ring  = &conn->txring;
+        other = &conn->rxring;
+        break;
+
+      default:
+        nerr("ERROR: Unrecognized SOL_PACKET option: %d\n", option);
+        return -ENOPROTOOPT;
+    }
+
+  if (value == NULL || value_len < sizeof(struct tpacket_req))
+    {
+      return -EINVAL;
+    }
+
+  size = pkt_ring_size(req);
+  if (size < 0)
+    {
+      return size;
+    }
+
+  net_lock();
+
+  /* The application may access the old rings as long as they are mapped */
+
+  if (conn->mapped)
+    {
+      ret = -EBUSY;
+      goto errout;
+    }
+
+  /* The receive ring comes first and the transmit ring follows it in one
+   * block of user memory, so the memory is allocated again for both.
+   */
+
+  othersize = pkt_ring_memsize(other);
+
+  if (size + othersize > 0)
+    {
+      mem = kumm_zalloc(size + othersize);
+      if (mem == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout;
+        }
+    }
+
+  if (conn->ringmem != NULL)
+    {
+      kumm_free(conn->ringmem);
+    }
+
+  conn->ringmem      = mem;
+  conn->ringsize     = size + othersize;
+
+  ring->pr_blocksize = req->tp_block_size;
+  ring->pr_framesize = req->tp_frame_size;
+  ring->pr_framenr   = req->tp_frame_nr;
+  ring->pr_head      = 0;
+  other->pr_head     = 0;
+
+  if (ring == &conn->rxring)
+    {
+      ring->pr_base  = mem;
+      other->pr_base = mem + size;
+    }
+  else
+    {
+      other->pr_base = mem;
+      ring->pr_base  = mem + othersize;
+    }
+
+errout:
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_mmap
+ *
+ * Description:
+ *   Return the address of the rings of a packet socket for mmap().
+ *
+ ****************************************************************************/
+
+int pkt_ring_mmap(FAR struct pkt_conn_s *conn, FAR void **addr)
+{
+  int ret = -EINVAL;
+
+  net_lock();
+  if (conn->ringmem != NULL)
+    {
+      conn->mapped = true;
+      *addr        = conn->ringmem;
+      ret          = OK;
+    }
+
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Store the received packet in the next free frame of the receive ring of
+ *   a packet socket.
+ *
+ * Returned Value:
+ *   true if the socket has a receive ring and the packet was consumed by it
+ *   (stored or dropped because the ring is full).  false if the packet has
+ *   to be passed to the socket as usual.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn)
+{
+  FAR struct pkt_ring_s *ring = &conn->rxring;
+  FAR volatile struct tpacket_hdr *hdr;
+  FAR struct sockaddr_ll *sll;
+  struct timespec ts;
+  uint32_t snaplen;
+
+  if (ring->pr_framenr == 0)
+    {
+      return false;
+    }
+
+  /* Drop the packet if the application still owns the next frame */
+
+  hdr = pkt_ring_frame(ring, ring->pr_head);
+  if (hdr->tp_status != TP_STATUS_KERNEL)
+    {
+      ninfo("Ring full, dropped %u bytes\n", dev->d_len);
+      conn->losing = true;
+      return true;
+    }
+
+  snaplen = dev->d_len;
+  if (snaplen > ring->pr_framesize - PKT_RING_MACOFF)
+    {
+      snaplen = ring->pr_framesize - PKT_RING_MACOFF;
+    }
+
+  memcpy((FAR uint8_t *)hdr + PKT_RING_MACOFF, dev->d_buf, snaplen);
+
+  sll = (FAR struct sockaddr_ll *)((FAR uint8_t *)hdr + PKT_RING_SLLOFF);
+  sll->sll_family   = AF_PACKET;
+  sll->sll_protocol = ((FAR struct eth_hdr_s *)dev->d_buf)->type;
+  sll->sll_ifindex  = dev->d_ifindex;
+
+  clock_systime_timespec(&ts);
+
+  hdr->tp_len     = dev->d_len;
+  hdr->tp_snaplen = snaplen;
+  hdr->tp_mac     = PKT_RING_MACOFF;
+  hdr->tp_net     = PKT_RING_NETOFF;
+  hdr->tp_sec     = ts.tv_sec;
+  hdr->tp_usec    = ts.tv_nsec / 1000;
+
+  /* Hand the frame over only once it is complete */
+
+  SP_DMB();
+
+  hdr->tp_status  = TP_STATUS_USER | (conn->losing ? TP_STATUS_LOSING : 0);
+  conn->losing    = false;
+  ring->pr_head   = (ring->pr_head + 1) % ring->pr_framenr;
+
+  poll_notify(conn->fds, CONFIG_NET_PKT_NPOLLWAITERS, POLLIN);
+  return true;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send all frames of the transmit ring that the application marked with
+ *   TP_STATUS_SEND_REQUEST.
+ *
+ * Returned Value:
+ *   The number of bytes sent, or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pkt_ring_send(FAR struct socket *psock)
+{
+  FAR struct pkt_conn_s *conn = psock->s_conn;
+  FAR struct net_driver_s *dev;
+  struct pkt_ring_send_s state;
+  int ret;
+
+  dev = pkt_find_device(conn);
+  if (dev == NULL)
+    {
+      return -ENODEV;
+    }
+
+  net_lock();
+  memset(&state, 0, sizeof(struct pkt_ring_send_s));
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&state.ps_sem, 0, 0); /* Doesn't really fail */
+  nxsem_set_protocol(&state.ps_sem, SEM_PRIO_NONE);
+
+  state.ps_conn = conn;
+  state.ps_cb   = pkt_callback_alloc(dev, conn);
+  if (state.ps_cb != NULL)
+    {
+      state.ps_cb->flags = PKT_POLL;
+      state.ps_cb->priv  = (FAR void *)&state;
+      state.ps_cb->event = pkt_ring_send_eventhandler;
+
+      /* Notify the device driver that new TX data is available. */
+
+      netdev_txnotify_dev(dev);
+
+      /* Wait until all requested frames are in the device or a signal is
+       * received.
+       */
+
+      ret = net_lockedwait(&state.ps_sem);
+
+      /* Make sure that no further events are processed */
+
+      pkt_callback_free(dev, conn, state.ps_cb);
+    }
+  else
+    {
+      ret = -EBUSY;
+    }
+
+  nxsem_destroy(&state.ps_sem);
+  net_unlock();
+
+  if (ret < 0 && state.ps_sent == 0)
+    {
+      return ret;
+    }
+
+  return state.ps_sent;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down a poll for the rings of a packet socket.
+ *
+ ****************************************************************************/
+
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup)
+{
+  FAR struct pollfd **slot;
+  int ret = OK;
+  int i;
+
+  net_lock();
+
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_NET_PKT_NPOLLWAITERS; i++)
+        {
+          if (conn->fds[i] == NULL)
+            {
+              conn->fds[i] = fds;
+              fds->priv    = &conn->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_NET_PKT_NPOLLWAITERS)
+        {
+          ret = -EBUSY;
+        }
+      else
+        {
+          poll_notify(&fds, 1, pkt_ring_events(conn));
+        }
+    }
+  else
+    {
+      slot = (FAR struct pollfd **)fds->priv;
+      if (slot != NULL)
+        {
+          *slot     = NULL;
+          fds->priv = NULL;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_free
+ *
+ * Description:
+ *   Release the rings of a packet socket that is being closed.
+ *
+ ****************************************************************************/
+
+void pkt_ring_free(FAR struct pkt_conn_s *conn)
+{
+  if (conn->ringmem != NULL)
+    {
+      kumm_free(conn->ringmem);
+      conn->ringmem = NULL;
+    }
+}
+
+#endif /* CONFIG_NET_PKT_RING */
@@ -184,6 +184,16 @@ ssize_t pkt_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
       return -EBADF;
     }
 
+#ifdef CONFIG_NET_PKT_RING
+  /* Sending nothing flushes the transmit ring */
+
+  if (len == 0 &&
+      ((FAR struct pkt_conn_s *)psock->s_conn)->txring.pr_framenr > 0)
+    {
+      return pkt_ring_send(psock);
+    }
+#endif
+
   /* Only SOCK_RAW is supported */
 
   if (psock->s_type == SOCK_RAW)
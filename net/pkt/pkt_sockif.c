@@ -34,6 +34,7 @@
 
 #include <netpacket/packet.h>
 
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 
@@ -65,6 +66,10 @@ static int        pkt_accept(FAR struct socket *psock,
 static int        pkt_poll_local(FAR struct socket *psock,
                     FAR struct pollfd *fds, bool setup);
 static int        pkt_close(FAR struct socket *psock);
+#ifdef CONFIG_NET_PKT_RING
+static int        pkt_ioctl(FAR struct socket *psock, int cmd,
+                            FAR void *arg, size_t arglen);
+#endif
 
 /****************************************************************************
  * Public Data
@@ -84,7 +89,10 @@ const struct sock_intf_s g_pkt_sockif =
   pkt_poll_local,  /* si_poll */
   pkt_sendmsg,     /* si_sendmsg */
   pkt_recvmsg,     /* si_recvmsg */
-  pkt_close        /* si_close */
+  pkt_close,       /* si_close */
+#ifdef CONFIG_NET_PKT_RING
+  pkt_ioctl        /* si_ioctl */
+#endif
 };
 
 /****************************************************************************
@@ -492,9 +500,54 @@ int pkt_listen(FAR struct socket *psock, int backlog)
 static int pkt_poll_local(FAR struct socket *psock, FAR struct pollfd *fds,
                           bool setup)
 {
+#ifdef CONFIG_NET_PKT_RING
+  FAR struct pkt_conn_s *conn = psock->s_conn;
+
+  /* Only the rings can be polled */
+
+  if (conn->rxring.pr_framenr > 0 || conn->txring.pr_framenr > 0 ||
+      !setup)
+    {
+      return pkt_ring_poll(conn, fds, setup);
+    }
+#endif
+
   return -ENOSYS;
 }
 
+/****************************************************************************
+ * Name: pkt_ioctl
+ *
+ * Description:
+ *   Handle the packet socket specific ioctl commands.  FIOC_MMAP returns
+ *   the address of the rings set up with PACKET_RX_RING and PACKET_TX_RING
+ *   for mmap().
+ *
+ * Input Parameters:
+ *   psock    A reference to the socket structure of the socket
+ *   cmd      The ioctl command
+ *   arg      The argument of the ioctl cmd
+ *   arglen   The length of 'arg'
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  -ENOTTY is
+ *   returned for commands that are not handled here.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+static int pkt_ioctl(FAR struct socket *psock, int cmd,
+                     FAR void *arg, size_t arglen)
+{
+  if (cmd == FIOC_MMAP && arglen >= sizeof(FAR void *))
+    {
+      return pkt_ring_mmap(psock->s_conn, (FAR void **)arg);
+    }
+
+  return -ENOTTY;
+}
+#endif
+
 /****************************************************************************
  * Name: pkt_close
  *
@@ -530,6 +583,9 @@ static int pkt_close(FAR struct socket *psock)
               /* Yes... free the connection structure */
 
               conn->crefs = 0;          /* No more references on the connection */
+#ifdef CONFIG_NET_PKT_RING
+              pkt_ring_free(conn);
+#endif
               pkt_free(psock->s_conn);  /* Free network resources */
             }
           else
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 #include <debug.h>
@@ -65,6 +66,7 @@ static int netprocfs_sent(FAR struct netprocfs_file_s *netfile);
 #ifdef CONFIG_NET_TCP
 static int netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile);
 #endif /* CONFIG_NET_TCP */
+static int netprocfs_netlock(FAR struct netprocfs_file_s *netfile);
 
 /****************************************************************************
  * Private Data
@@ -99,6 +101,8 @@ static const linegen_t g_stat_linegen[] =
 #ifdef CONFIG_NET_TCP
   , netprocfs_retransmissions
 #endif /* CONFIG_NET_TCP */
+
+  , netprocfs_netlock
 };
 
 #define NSTAT_LINES (sizeof(g_stat_linegen) / sizeof(linegen_t))
@@ -421,6 +425,21 @@ static int netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NET_STATISTICS && CONFIG_NET_TCP */
 
+/****************************************************************************
+ * Name: netprocfs_netlock
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_STATISTICS
+static int netprocfs_netlock(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "Lock  taken %" PRIu32 " contended %" PRIu32
+                  " waited %" PRIu32 " ticks\n",
+                  g_netstats.lock.acquired, g_netstats.lock.contended,
+                  g_netstats.lock.waitticks);
+}
+#endif /* CONFIG_NET_STATISTICS */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
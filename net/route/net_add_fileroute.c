@@ -34,6 +34,7 @@
 #include <nuttx/net/ip.h>
 
 #include "route/fileroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
@@ -84,7 +85,13 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   nwritten = net_writeroute_ipv4(&fshandle, &route);
 
   net_closeroute_ipv4(&fshandle);
-  return nwritten >= 0 ? 0 : (int)nwritten;
+  if (nwritten < 0)
+    {
+      return (int)nwritten;
+    }
+
+  net_trieroute_ipv4_update();
+  return OK;
 }
 #endif
 
@@ -118,7 +125,13 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   nwritten = net_writeroute_ipv6(&fshandle, &route);
 
   net_closeroute_ipv6(&fshandle);
-  return nwritten >= 0 ? 0 : (int)nwritten;
+  if (nwritten < 0)
+    {
+      return (int)nwritten;
+    }
+
+  net_trieroute_ipv6_update();
+  return OK;
 }
 #endif
 
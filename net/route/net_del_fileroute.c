@@ -38,6 +38,7 @@
 
 #include "route/fileroute.h"
 #include "route/cacheroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
@@ -318,6 +319,10 @@ errout_with_fshandle:
 
 errout_with_lock:
   net_unlockroute_ipv4();
+
+  /* Rebuild the trie from whatever the routing table holds now */
+
+  net_trieroute_ipv4_update();
   return ret;
 }
 #endif
@@ -469,6 +474,10 @@ errout_with_fshandle:
 
 errout_with_lock:
   net_unlockroute_ipv6();
+
+  /* Rebuild the trie from whatever the routing table holds now */
+
+  net_trieroute_ipv6_update();
   return ret;
 }
 #endif
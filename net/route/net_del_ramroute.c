@@ -33,6 +33,7 @@
 #include <nuttx/net/ip.h>
 
 #include "route/ramroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -211,7 +212,13 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv4(net_match_ipv4, &match) ? OK : -ENOENT;
+  if (!net_foreachroute_ipv4(net_match_ipv4, &match))
+    {
+      return -ENOENT;
+    }
+
+  net_trieroute_ipv4_update();
+  return OK;
 }
 #endif
 
@@ -228,7 +235,13 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv6(net_match_ipv6, &match) ? OK : -ENOENT;
+  if (!net_foreachroute_ipv6(net_match_ipv6, &match))
+    {
+      return -ENOENT;
+    }
+
+  net_trieroute_ipv6_update();
+  return OK;
 }
 #endif
 
@@ -26,6 +26,7 @@
 
 #include "route/ramroute.h"
 #include "route/cacheroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #ifdef CONFIG_NET_ROUTE
@@ -57,6 +58,11 @@ void net_init_route(void)
 #if defined(CONFIG_ROUTE_IPv4_CACHEROUTE) || defined(CONFIG_ROUTE_IPv6_CACHEROUTE)
   net_init_cacheroute();
 #endif
+
+  /* Build the tries for the routes that are already there */
+
+  net_trieroute_ipv4_update();
+  net_trieroute_ipv6_update();
 }
 
 #endif /* CONFIG_NET_ROUTE */
@@ -34,6 +34,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/trieroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -199,6 +200,9 @@ static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
 int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 {
   struct route_ipv4_match_s match;
+#ifdef CONFIG_ROUTE_TRIE
+  struct net_route_ipv4_s route;
+#endif
   int ret;
 
   /* Do not route the special broadcast IP address */
@@ -208,6 +212,24 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
       return -ENOENT;
     }
 
+#ifdef CONFIG_ROUTE_TRIE
+  /* Look for the longest prefix match in the trie.  Without a trie, fall
+   * back to searching the routing table.
+   */
+
+  ret = net_trieroute_ipv4(target, &route);
+  if (ret != -ENOSYS)
+    {
+      if (ret < 0)
+        {
+          return -ENOENT;
+        }
+
+      net_ipv4addr_copy(*router, route.router);
+      return OK;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv4_match_s));
@@ -274,6 +296,9 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
 {
   struct route_ipv6_match_s match;
+#ifdef CONFIG_ROUTE_TRIE
+  struct net_route_ipv6_s route;
+#endif
   int ret;
 
   /* Do not route to any the special IPv6 multicast addresses */
@@ -283,6 +308,24 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
       return -ENOENT;
     }
 
+#ifdef CONFIG_ROUTE_TRIE
+  /* Look for the longest prefix match in the trie.  Without a trie, fall
+   * back to searching the routing table.
+   */
+
+  ret = net_trieroute_ipv6(target, &route);
+  if (ret != -ENOSYS)
+    {
+      if (ret < 0)
+        {
+          return -ENOENT;
+        }
+
+      net_ipv6addr_copy(router, route.router);
+      return OK;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv6_match_s));
@@ -0,0 +1,676 @@
+/****************************************************************************
+ * net/route/net_trieroute.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/rcu.h>
+#include <nuttx/net/net.h>
+
+#include "route/trieroute.h"
+#include "route/route.h"
+
+#ifdef CONFIG_ROUTE_TRIE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The largest key (address) size in bytes */
+
+#ifdef CONFIG_NET_IPv6
+#  define TRIE_KEYLEN   16
+#else
+#  define TRIE_KEYLEN   4
+#endif
+
+/* The number of routes is limited by the 16-bit node indexes.  Each route
+ * adds at most two nodes to the trie.
+ */
+
+#define TRIE_MAXROUTES  ((UINT16_MAX - 1) / 2)
+
+/* Protection of the lookups.  A trie is never modified once it has been
+ * published, so with RCU the lookups need not serialize on the network
+ * lock.
+ */
+
+#ifdef CONFIG_RCU
+#  define route_trie_read_lock()    rcu_read_lock()
+#  define route_trie_read_unlock()  rcu_read_unlock()
+#else
+#  define route_trie_read_lock()    net_lock()
+#  define route_trie_read_unlock()  net_unlock()
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A node of the path-compressed binary trie.  Each node stands for the
+ * prefix of its first tn_plen bits.  The bits between the prefix of the
+ * parent and that of a node are not tested on the way down, so they must
+ * be compared when a node is reached.
+ */
+
+struct route_trie_node_s
+{
+  uint16_t tn_child[2];           /* Children by the next bit, 0 if none */
+  int16_t  tn_route;              /* Route with exactly this prefix or -1 */
+  uint8_t  tn_plen;               /* Length of the prefix in bits */
+  uint8_t  tn_prefix[TRIE_KEYLEN];
+};
+
+/* A trie built from a routing table.  The trie, the copies of the routing
+ * table entries and the nodes are allocated as one block, so that the
+ * whole trie can be replaced at once.
+ */
+
+struct route_trie_s
+{
+  uint16_t rt_keylen;             /* Size of the keys in bytes */
+  uint16_t rt_nnodes;             /* Number of nodes in use */
+  uint16_t rt_nroutes;            /* Number of routes in use */
+  uint16_t rt_maxroutes;          /* Number of routes allocated */
+  size_t   rt_routesize;          /* Size of one routing table entry */
+  FAR uint8_t *rt_routes;         /* Copies of the routing table entries */
+  FAR struct route_trie_node_s *rt_nodes;
+};
+
+/* The state of a trie build */
+
+struct route_trie_build_s
+{
+  FAR struct route_trie_s *trie;
+  unsigned int nroutes;
+  bool failed;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Serializes the updates so that the last one always wins */
+
+static mutex_t g_trie_lock = MUTEX_INITIALIZER;
+
+#ifdef CONFIG_NET_IPv4
+static FAR struct route_trie_s *g_ipv4_trie;
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static FAR struct route_trie_s *g_ipv6_trie;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: route_trie_bit
+ *
+ * Description:
+ *   Return bit n of a key, counting from the most significant bit of the
+ *   first byte as for addresses in network order.
+ *
+ ****************************************************************************/
+
+static inline int route_trie_bit(FAR const uint8_t *key, int n)
+{
+  return (key[n >> 3] >> (7 - (n & 7))) & 1;
+}
+
+/****************************************************************************
+ * Name: route_trie_common
+ *
+ * Description:
+ *   Return the number of leading bits, up to nbits, that two keys have in
+ *   common.
+ *
+ ****************************************************************************/
+
+static int route_trie_common(FAR const uint8_t *a, FAR const uint8_t *b,
+                             int nbits)
+{
+  uint8_t diff;
+  int n;
+
+  for (n = 0; n < nbits; n += 8)
+    {
+      diff = a[n >> 3] ^ b[n >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              n++;
+            }
+
+          break;
+        }
+    }
+
+  return n < nbits ? n : nbits;
+}
+
+/****************************************************************************
+ * Name: route_trie_plen
+ *
+ * Description:
+ *   Return the prefix length of a netmask or -1 if the netmask is not
+ *   contiguous.
+ *
+ ****************************************************************************/
+
+static int route_trie_plen(FAR const uint8_t *mask, int keylen)
+{
+  int plen = route_trie_common(mask, (FAR const uint8_t *)
+                               "\xff\xff\xff\xff\xff\xff\xff\xff"
+                               "\xff\xff\xff\xff\xff\xff\xff\xff",
+                               8 * keylen);
+  int n;
+
+  for (n = plen; n < 8 * keylen; n++)
+    {
+      if (route_trie_bit(mask, n) != 0)
+        {
+          return -1;
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: route_trie_alloc
+ *
+ * Description:
+ *   Allocate a trie with room for maxroutes routes and its root node.
+ *
+ ****************************************************************************/
+
+static FAR struct route_trie_s *route_trie_alloc(int keylen,
+                                                 unsigned int maxroutes,
+                                                 size_t routesize)
+{
+  FAR struct route_trie_s *trie;
+
+  if (maxroutes > TRIE_MAXROUTES)
+    {
+      return NULL;
+    }
+
+  trie = kmm_zalloc(sizeof(struct route_trie_s) + maxroutes * routesize +
+                    (2 * maxroutes + 1) * sizeof(struct route_trie_node_s));
+  if (trie != NULL)
+    {
+      trie->rt_keylen    = keylen;
+      trie->rt_nnodes    = 1;
+      trie->rt_maxroutes = maxroutes;
+      trie->rt_routesize = routesize;
+      trie->rt_routes    = (FAR uint8_t *)(trie + 1);
+      trie->rt_nodes     = (FAR struct route_trie_node_s *)
+                           (trie->rt_routes + maxroutes * routesize);
+
+      trie->rt_nodes[0].tn_route = -1;
+    }
+
+  return trie;
+}
+
+/****************************************************************************
+ * Name: route_trie_newnode
+ *
+ * Description:
+ *   Add a node for the first plen bits of key and return its index.
+ *
+ ****************************************************************************/
+
+static uint16_t route_trie_newnode(FAR struct route_trie_s *trie,
+                                   FAR const uint8_t *key, int plen,
+                                   int route)
+{
+  FAR struct route_trie_node_s *node = &trie->rt_nodes[trie->rt_nnodes];
+  int n;
+
+  node->tn_route = route;
+  node->tn_plen  = plen;
+  memcpy(node->tn_prefix, key, (plen + 7) >> 3);
+
+  /* Clear the bits beyond the prefix in the last byte */
+
+  n = plen & 7;
+  if (n != 0)
+    {
+      node->tn_prefix[plen >> 3] &= 0xff << (8 - n);
+    }
+
+  return trie->rt_nnodes++;
+}
+
+/****************************************************************************
+ * Name: route_trie_insert
+ *
+ * Description:
+ *   Add a route for the first plen bits of key to the trie.  If there is
+ *   already a route for the same prefix, the first one is kept, just as
+ *   the first match is used when the routing table is searched.
+ *
+ ****************************************************************************/
+
+static void route_trie_insert(FAR struct route_trie_s *trie,
+                              FAR const uint8_t *key, int plen,
+                              FAR const void *entry)
+{
+  FAR struct route_trie_node_s *node = &trie->rt_nodes[0];
+  FAR struct route_trie_node_s *child;
+  uint16_t ndx;
+  int route;
+  int cplen;
+  int b;
+
+  /* Copy the routing table entry */
+
+  route = trie->rt_nroutes++;
+  memcpy(trie->rt_routes + route * trie->rt_routesize, entry,
+         trie->rt_routesize);
+
+  for (; ; )
+    {
+      /* Here the first node->tn_plen bits of key match the node */
+
+      if (node->tn_plen == plen)
+        {
+          if (node->tn_route < 0)
+            {
+              node->tn_route = route;
+            }
+
+          return;
+        }
+
+      b = route_trie_bit(key, node->tn_plen);
+      if (node->tn_child[b] == 0)
+        {
+          node->tn_child[b] = route_trie_newnode(trie, key, plen, route);
+          return;
+        }
+
+      child = &trie->rt_nodes[node->tn_child[b]];
+      cplen = route_trie_common(key, child->tn_prefix,
+                                plen < child->tn_plen ?
+                                plen : child->tn_plen);
+      if (cplen == child->tn_plen)
+        {
+          node = child;
+          continue;
+        }
+
+      /* The key leaves the path to the child before the child's prefix
+       * ends.  Split the edge there, with a new node that is either the
+       * new route itself or a branch between the child and the route.
+       */
+
+      if (cplen == plen)
+        {
+          ndx = route_trie_newnode(trie, key, plen, route);
+        }
+      else
+        {
+          ndx = route_trie_newnode(trie, key, cplen, -1);
+          trie->rt_nodes[ndx].tn_child[route_trie_bit(key, cplen)] =
+            route_trie_newnode(trie, key, plen, route);
+        }
+
+      trie->rt_nodes[ndx].tn_child[route_trie_bit(child->tn_prefix,
+                                                  cplen)] =
+        node->tn_child[b];
+      node->tn_child[b] = ndx;
+      return;
+    }
+}
+
+/****************************************************************************
+ * Name: route_trie_lookup
+ *
+ * Description:
+ *   Return the routing table entry with the longest prefix matching key or
+ *   NULL if there is none.
+ *
+ ****************************************************************************/
+
+static FAR const void *route_trie_lookup(FAR struct route_trie_s *trie,
+                                         FAR const uint8_t *key)
+{
+  FAR struct route_trie_node_s *node = &trie->rt_nodes[0];
+  int route = -1;
+  uint16_t ndx;
+
+  for (; ; )
+    {
+      if (route_trie_common(key, node->tn_prefix, node->tn_plen) <
+          node->tn_plen)
+        {
+          break;
+        }
+
+      if (node->tn_route >= 0)
+        {
+          route = node->tn_route;
+        }
+
+      if (node->tn_plen >= 8 * trie->rt_keylen)
+        {
+          break;
+        }
+
+      ndx = node->tn_child[route_trie_bit(key, node->tn_plen)];
+      if (ndx == 0)
+        {
+          break;
+        }
+
+      node = &trie->rt_nodes[ndx];
+    }
+
+  return route < 0 ? NULL :
+         trie->rt_routes + route * trie->rt_routesize;
+}
+
+/****************************************************************************
+ * Name: route_trie_add
+ *
+ * Description:
+ *   Add one routing table entry to the trie being built.  The trie gets
+ *   discarded if the netmask is not contiguous, because such a route has
+ *   no prefix, or if the table has grown since the routes were counted.
+ *
+ ****************************************************************************/
+
+static int route_trie_add(FAR struct route_trie_build_s *build,
+                          FAR const uint8_t *target,
+                          FAR const uint8_t *netmask,
+                          FAR const void *entry)
+{
+  FAR struct route_trie_s *trie = build->trie;
+  uint8_t key[TRIE_KEYLEN];
+  int plen;
+  int i;
+
+  plen = route_trie_plen(netmask, trie->rt_keylen);
+  if (plen < 0 || trie->rt_nroutes >= trie->rt_maxroutes)
+    {
+      build->failed = true;
+      return 1;
+    }
+
+  for (i = 0; i < trie->rt_keylen; i++)
+    {
+      key[i] = target[i] & netmask[i];
+    }
+
+  route_trie_insert(trie, key, plen, entry);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: route_trie_swap
+ *
+ * Description:
+ *   Replace a trie with a new one.  No lookup may still be using the old
+ *   trie when it is freed:  Either wait for an RCU grace period or, without
+ *   RCU, swap with the network locked as the lookups do.
+ *
+ ****************************************************************************/
+
+static void route_trie_swap(FAR struct route_trie_s **ptrie,
+                            FAR struct route_trie_s *trie)
+{
+  FAR struct route_trie_s *old;
+
+#ifdef CONFIG_RCU
+  old = *ptrie;
+  rcu_assign_pointer(*ptrie, trie);
+  synchronize_rcu();
+#else
+  net_lock();
+  old    = *ptrie;
+  *ptrie = trie;
+  net_unlock();
+#endif
+
+  if (old != NULL)
+    {
+      kmm_free(old);
+    }
+}
+
+/****************************************************************************
+ * Name: net_trieroute_count_ipv4, net_trieroute_add_ipv4
+ *
+ * Description:
+ *   net_foreachroute_ipv4() callbacks that count and add routes.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static int net_trieroute_count_ipv4(FAR struct net_route_ipv4_s *route,
+                                    FAR void *arg)
+{
+  ((FAR struct route_trie_build_s *)arg)->nroutes++;
+  return 0;
+}
+
+static int net_trieroute_add_ipv4(FAR struct net_route_ipv4_s *route,
+                                  FAR void *arg)
+{
+  return route_trie_add((FAR struct route_trie_build_s *)arg,
+                        (FAR const uint8_t *)&route->target,
+                        (FAR const uint8_t *)&route->netmask, route);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_trieroute_count_ipv6, net_trieroute_add_ipv6
+ *
+ * Description:
+ *   net_foreachroute_ipv6() callbacks that count and add routes.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static int net_trieroute_count_ipv6(FAR struct net_route_ipv6_s *route,
+                                    FAR void *arg)
+{
+  ((FAR struct route_trie_build_s *)arg)->nroutes++;
+  return 0;
+}
+
+static int net_trieroute_add_ipv6(FAR struct net_route_ipv6_s *route,
+                                  FAR void *arg)
+{
+  return route_trie_add((FAR struct route_trie_build_s *)arg,
+                        (FAR const uint8_t *)route->target,
+                        (FAR const uint8_t *)route->netmask, route);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_trieroute_ipv4_update and net_trieroute_ipv6_update
+ *
+ * Description:
+ *   Rebuild the longest-prefix-match trie from the routing table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+void net_trieroute_ipv4_update(void)
+{
+  struct route_trie_build_s build;
+
+  memset(&build, 0, sizeof(build));
+  nxmutex_lock(&g_trie_lock);
+
+  /* A routing table that cannot be read, for example a file on a file
+   * system not mounted yet, leaves no trie behind.
+   */
+
+  if (net_foreachroute_ipv4(net_trieroute_count_ipv4, &build) >= 0)
+    {
+      build.trie = route_trie_alloc(sizeof(in_addr_t), build.nroutes,
+                                    sizeof(struct net_route_ipv4_s));
+    }
+
+  if (build.trie != NULL)
+    {
+      if (net_foreachroute_ipv4(net_trieroute_add_ipv4, &build) < 0 ||
+          build.failed)
+        {
+          kmm_free(build.trie);
+          build.trie = NULL;
+        }
+    }
+
+  if (build.trie == NULL)
+    {
+      nwarn("WARNING: No IPv4 route trie, searching the table\n");
+    }
+
+  route_trie_swap(&g_ipv4_trie, build.trie);
+  nxmutex_unlock(&g_trie_lock);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+void net_trieroute_ipv6_update(void)
+{
+  struct route_trie_build_s build;
+
+  memset(&build, 0, sizeof(build));
+  nxmutex_lock(&g_trie_lock);
+
+  if (net_foreachroute_ipv6(net_trieroute_count_ipv6, &build) >= 0)
+    {
+      build.trie = route_trie_alloc(sizeof(net_ipv6addr_t), build.nroutes,
+                                    sizeof(struct net_route_ipv6_s));
+    }
+
+  if (build.trie != NULL)
+    {
+      if (net_foreachroute_ipv6(net_trieroute_add_ipv6, &build) < 0 ||
+          build.failed)
+        {
+          kmm_free(build.trie);
+          build.trie = NULL;
+        }
+    }
+
+  if (build.trie == NULL)
+    {
+      nwarn("WARNING: No IPv6 route trie, searching the table\n");
+    }
+
+  route_trie_swap(&g_ipv6_trie, build.trie);
+  nxmutex_unlock(&g_trie_lock);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_trieroute_ipv4 and net_trieroute_ipv6
+ *
+ * Description:
+ *   Find the routing table entry with the longest prefix matching target.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+int net_trieroute_ipv4(in_addr_t target,
+                       FAR struct net_route_ipv4_s *route)
+{
+  FAR struct route_trie_s *trie;
+  FAR const void *entry;
+  int ret = -ENOSYS;
+
+  route_trie_read_lock();
+  trie = rcu_dereference(g_ipv4_trie);
+  if (trie != NULL)
+    {
+      entry = route_trie_lookup(trie, (FAR const uint8_t *)&target);
+      if (entry != NULL)
+        {
+          memcpy(route, entry, sizeof(struct net_route_ipv4_s));
+          ret = OK;
+        }
+      else
+        {
+          ret = -ENOENT;
+        }
+    }
+
+  route_trie_read_unlock();
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+int net_trieroute_ipv6(const net_ipv6addr_t target,
+                       FAR struct net_route_ipv6_s *route)
+{
+  FAR struct route_trie_s *trie;
+  FAR const void *entry;
+  int ret = -ENOSYS;
+
+  route_trie_read_lock();
+  trie = rcu_dereference(g_ipv6_trie);
+  if (trie != NULL)
+    {
+      entry = route_trie_lookup(trie, (FAR const uint8_t *)target);
+      if (entry != NULL)
+        {
+          memcpy(route, entry, sizeof(struct net_route_ipv6_s));
+          ret = OK;
+        }
+      else
+        {
+          ret = -ENOENT;
+        }
+    }
+
+  route_trie_read_unlock();
+  return ret;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_TRIE */
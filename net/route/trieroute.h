@@ -0,0 +1,98 @@
+/****************************************************************************
+ * net/route/trieroute.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_TRIEROUTE_H
+#define __NET_ROUTE_TRIEROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include "route/route.h"
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_TRIE
+
+/****************************************************************************
+ * Name: net_trieroute_ipv4_update and net_trieroute_ipv6_update
+ *
+ * Description:
+ *   Rebuild the longest-prefix-match trie from the routing table.  This
+ *   must be called whenever the routing table has been modified.  The new
+ *   trie is built aside and then replaces the old one with the network
+ *   locked, so lookups never see a partial trie.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from normal user mode logic without the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+void net_trieroute_ipv4_update(void);
+#endif
+
+#ifdef CONFIG_NET_IPv6
+void net_trieroute_ipv6_update(void);
+#endif
+
+/****************************************************************************
+ * Name: net_trieroute_ipv4 and net_trieroute_ipv6
+ *
+ * Description:
+ *   Find the routing table entry with the longest prefix matching target.
+ *
+ * Input Parameters:
+ *   target - The IP address to route
+ *   route  - The location to return a copy of the routing table entry
+ *
+ * Returned Value:
+ *   OK if a route was found, -ENOENT if there is no route for target, or
+ *   -ENOSYS if there is no trie.  In the last case, the caller must search
+ *   the routing table itself.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+int net_trieroute_ipv4(in_addr_t target,
+                       FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef CONFIG_NET_IPv6
+int net_trieroute_ipv6(const net_ipv6addr_t target,
+                       FAR struct net_route_ipv6_s *route);
+#endif
+
+#else
+#  define net_trieroute_ipv4_update()
+#  define net_trieroute_ipv6_update()
+#endif /* CONFIG_ROUTE_TRIE */
+
+#endif /* __NET_ROUTE_TRIEROUTE_H */
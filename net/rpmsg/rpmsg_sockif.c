@@ -34,6 +34,7 @@
 #include <nuttx/mm/circbuf.h>
 #include <nuttx/rptun/openamp.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 
 #include <netinet/in.h>
@@ -208,22 +209,7 @@ static inline void rpmsg_socket_post(FAR sem_t *sem)
 static void rpmsg_socket_pollnotify(FAR struct rpmsg_socket_conn_s *conn,
                                     pollevent_t eventset)
 {
-  int i;
-
-  for (i = 0; i < CONFIG_NET_RPMSG_NPOLLWAITERS; i++)
-    {
-      FAR struct pollfd *fds = conn->fds[i];
-
-      if (fds)
-        {
-          fds->revents |= (fds->events & eventset);
-
-          if (fds->revents != 0)
-            {
-              rpmsg_socket_post(fds->sem);
-            }
-        }
-    }
+  poll_notify(conn->fds, CONFIG_NET_RPMSG_NPOLLWAITERS, eventset);
 }
 
 static FAR struct rpmsg_socket_conn_s *rpmsg_socket_alloc(void)
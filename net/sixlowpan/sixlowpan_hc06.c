@@ -59,7 +59,9 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <string.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/mm/iob.h>
@@ -101,6 +103,26 @@ struct sixlowpan_addrcontext_s
   uint8_t prefix[8];
 };
 
+#if CONFIG_NET_6LOWPAN_HC06_NFLOWS > 0
+/* The compressed address fields of a recent flow.  The IPHC address
+ * encoding depends only on the IPv6 and MAC addresses of both ends, so it
+ * can be reused as is for every packet of the same flow.
+ */
+
+struct sixlowpan_hc06flow_s
+{
+  bool inuse;                       /* The entry is valid */
+  uint8_t iphc1;                    /* Second IPHC byte (address flags) */
+  uint8_t iphc2;                    /* [ SCI | DCI ] byte */
+  uint8_t addrlen;                  /* Length of the inline addresses */
+  net_ipv6addr_t srcipaddr;         /* IPv6 source address */
+  net_ipv6addr_t destipaddr;        /* IPv6 destination address */
+  struct netdev_varaddr_s srcmac;   /* MAC source address */
+  struct netdev_varaddr_s destmac;  /* MAC destination address */
+  uint8_t addr[32];                 /* The inline address fields */
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -124,6 +146,14 @@ static struct sixlowpan_addrcontext_s
 
 static FAR uint8_t *g_hc06ptr;
 
+#if CONFIG_NET_6LOWPAN_HC06_NFLOWS > 0
+/* Compressed addresses of the most recent flows, replaced round-robin */
+
+static struct sixlowpan_hc06flow_s
+  g_hc06_flows[CONFIG_NET_6LOWPAN_HC06_NFLOWS];
+static uint8_t g_hc06_nextflow;
+#endif
+
 /* Constant Data ************************************************************/
 
 /* Uncompression of linklocal
@@ -568,6 +598,268 @@ static void uncompress_addr(FAR const struct netdev_varaddr_s *addr,
         NTOHS(ipaddr[6]), NTOHS(ipaddr[7]));
 }
 
+/****************************************************************************
+ * Name: compress_ipaddrs
+ *
+ * Description:
+ *   Compress the source and destination addresses of the IPv6 header at
+ *   g_hc06ptr, setting the context numbers in iphc[2].
+ *
+ * Returned Value:
+ *   The address flags of the second IPHC byte.
+ *
+ ****************************************************************************/
+
+static uint8_t
+  compress_ipaddrs(FAR struct radio_driver_s *radio,
+                   FAR const struct ipv6_hdr_s *ipv6,
+                   FAR const struct netdev_varaddr_s *destmac,
+                   FAR struct sixlowpan_addrcontext_s *saddrcontext,
+                   FAR struct sixlowpan_addrcontext_s *daddrcontext,
+                   FAR uint8_t *iphc)
+{
+  uint8_t iphc1 = 0;
+
+  /* Source address - cannot be multicast */
+
+  if (net_is_addr_unspecified(ipv6->srcipaddr))
+    {
+      ninfo("Compressing unspecified srcipaddr.  Setting SAC\n");
+
+      iphc1 |= SIXLOWPAN_IPHC_SAC;
+      iphc1 |= SIXLOWPAN_IPHC_SAM_128;
+    }
+  else if (saddrcontext != NULL)
+    {
+      /* Elide the prefix - indicate by CID and set address context + SAC */
+
+      ninfo("Compressing src with address context."
+            " Setting SAC. Context: %d\n",
+            saddrcontext->number);
+
+      iphc1   |= SIXLOWPAN_IPHC_SAC;
+      iphc[2] |= saddrcontext->number << 4;
+
+      /* Compression compare with this nodes address (source) */
+
+      iphc1   |= compress_laddr(ipv6->srcipaddr,
+                                &radio->r_dev.d_mac.radio,
+                                SIXLOWPAN_IPHC_SAM_BIT);
+    }
+
+  /* No address context found for the source address */
+
+  else if (net_is_addr_linklocal(ipv6->srcipaddr) &&
+           ipv6->srcipaddr[1] == 0 &&  ipv6->srcipaddr[2] == 0 &&
+           ipv6->srcipaddr[3] == 0)
+    {
+      iphc1   |= compress_laddr(ipv6->srcipaddr,
+                                &radio->r_dev.d_mac.radio,
+                                SIXLOWPAN_IPHC_SAM_BIT);
+    }
+  else
+    {
+      /* Send the full source address ipaddr:  SAC = 0, SAM = 00 */
+
+      ninfo("Uncompressable "
+            "srcipaddr=%04x:%04x:%04x:%04x:%04x:%04x:%04x:%04x\n",
+            NTOHS(ipv6->srcipaddr[0]), NTOHS(ipv6->srcipaddr[1]),
+            NTOHS(ipv6->srcipaddr[2]), NTOHS(ipv6->srcipaddr[3]),
+            NTOHS(ipv6->srcipaddr[4]), NTOHS(ipv6->srcipaddr[5]),
+            NTOHS(ipv6->srcipaddr[6]), NTOHS(ipv6->srcipaddr[7]));
+
+      iphc1 |= SIXLOWPAN_IPHC_SAM_128;   /* 128-bits */
+      memcpy(g_hc06ptr, ipv6->srcipaddr, 16);
+      g_hc06ptr += 16;
+    }
+
+  /* Destination address */
+
+  if (net_is_addr_mcast(ipv6->destipaddr))
+    {
+      /* Address is multicast, try to compress */
+
+      iphc1 |= SIXLOWPAN_IPHC_M;
+      if (SIXLOWPAN_IS_MCASTADDR_COMPRESSABLE8(ipv6->destipaddr))
+        {
+          iphc1 |= SIXLOWPAN_IPHC_MDAM_8;
+
+          /* Use "last" byte ("last" meaning the LS byte in host order.
+           * destipaddr is in big-endian network order).
+           */
+
+#ifdef CONFIG_ENDIAN_BIG
+          *g_hc06ptr = (ipv6->destipaddr[7] & 0xff);
+#else
+          *g_hc06ptr = (ipv6->destipaddr[7] >> 8);
+#endif
+          g_hc06ptr += 1;
+        }
+      else if (SIXLOWPAN_IS_MCASTADDR_COMPRESSABLE32(ipv6->destipaddr))
+        {
+          FAR uint8_t *iptr = (FAR uint8_t *)ipv6->destipaddr;
+
+          iphc1 |= SIXLOWPAN_IPHC_MDAM_32;
+
+          /* Second byte + the last three */
+
+          *g_hc06ptr = iptr[1];
+          memcpy(g_hc06ptr + 1, &iptr[13], 3);
+          g_hc06ptr += 4;
+        }
+      else if (SIXLOWPAN_IS_MCASTADDR_COMPRESSABLE48(ipv6->destipaddr))
+        {
+          FAR uint8_t *iptr = (FAR uint8_t *)ipv6->destipaddr;
+
+          iphc1 |= SIXLOWPAN_IPHC_MDAM_48;
+
+          /* Second byte + the last five */
+
+          *g_hc06ptr = iptr[1];
+          memcpy(g_hc06ptr + 1, &iptr[11], 5);
+          g_hc06ptr += 6;
+        }
+      else
+        {
+          iphc1 |= SIXLOWPAN_IPHC_MDAM_128;
+
+          /* Full address */
+
+          memcpy(g_hc06ptr, ipv6->destipaddr, 16);
+          g_hc06ptr += 16;
+        }
+    }
+  else
+    {
+      /* Address is unicast, try to compress */
+
+      if (daddrcontext != NULL)
+        {
+          /* Elide the prefix */
+
+          ninfo("Compressing dest with address context. "
+                "Setting DAC. Context: %d\n",
+                daddrcontext->number);
+
+          iphc1   |= SIXLOWPAN_IPHC_DAC;
+          iphc[2] |= daddrcontext->number;
+
+          /* Compession compare with link address (destination) */
+
+          iphc1   |= compress_tagaddr(ipv6->destipaddr, destmac,
+                                      SIXLOWPAN_IPHC_DAM_BIT);
+        }
+
+      /* No address context found for this address */
+
+      else if (net_is_addr_linklocal(ipv6->destipaddr) &&
+               ipv6->destipaddr[1] == 0 && ipv6->destipaddr[2] == 0 &&
+               ipv6->destipaddr[3] == 0)
+        {
+          iphc1 |= compress_tagaddr(ipv6->destipaddr, destmac,
+                                    SIXLOWPAN_IPHC_DAM_BIT);
+        }
+
+      /* Send the full address */
+
+      else
+        {
+          iphc1 |= SIXLOWPAN_IPHC_DAM_128;       /* 128-bits */
+          memcpy(g_hc06ptr, ipv6->destipaddr, 16);
+          g_hc06ptr += 16;
+        }
+    }
+
+  return iphc1;
+}
+
+#if CONFIG_NET_6LOWPAN_HC06_NFLOWS > 0
+/****************************************************************************
+ * Name: macaddr_equal
+ *
+ * Description:
+ *   Compare two variable length MAC addresses.
+ *
+ ****************************************************************************/
+
+static bool macaddr_equal(FAR const struct netdev_varaddr_s *addr1,
+                          FAR const struct netdev_varaddr_s *addr2)
+{
+  return addr1->nv_addrlen == addr2->nv_addrlen &&
+         memcmp(addr1->nv_addr, addr2->nv_addr, addr1->nv_addrlen) == 0;
+}
+
+/****************************************************************************
+ * Name: find_flow
+ *
+ * Description:
+ *   Find the compressed addresses saved for the flow of this packet.
+ *
+ ****************************************************************************/
+
+static FAR struct sixlowpan_hc06flow_s *
+  find_flow(FAR struct radio_driver_s *radio,
+            FAR const struct ipv6_hdr_s *ipv6,
+            FAR const struct netdev_varaddr_s *destmac)
+{
+  FAR struct sixlowpan_hc06flow_s *flow;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_6LOWPAN_HC06_NFLOWS; i++)
+    {
+      flow = &g_hc06_flows[i];
+      if (flow->inuse &&
+          net_ipv6addr_cmp(flow->destipaddr, ipv6->destipaddr) &&
+          net_ipv6addr_cmp(flow->srcipaddr, ipv6->srcipaddr) &&
+          macaddr_equal(&flow->destmac, destmac) &&
+          macaddr_equal(&flow->srcmac, &radio->r_dev.d_mac.radio))
+        {
+          return flow;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: save_flow
+ *
+ * Description:
+ *   Save the compressed addresses of this packet for the next packets of
+ *   the same flow.
+ *
+ ****************************************************************************/
+
+static void save_flow(FAR struct radio_driver_s *radio,
+                      FAR const struct ipv6_hdr_s *ipv6,
+                      FAR const struct netdev_varaddr_s *destmac,
+                      uint8_t iphc1, uint8_t iphc2,
+                      FAR const uint8_t *addr, size_t addrlen)
+{
+  FAR struct sixlowpan_hc06flow_s *flow;
+
+  DEBUGASSERT(addrlen <= sizeof(flow->addr));
+
+  flow = &g_hc06_flows[g_hc06_nextflow];
+  if (++g_hc06_nextflow >= CONFIG_NET_6LOWPAN_HC06_NFLOWS)
+    {
+      g_hc06_nextflow = 0;
+    }
+
+  net_ipv6addr_copy(flow->srcipaddr, ipv6->srcipaddr);
+  net_ipv6addr_copy(flow->destipaddr, ipv6->destipaddr);
+  memcpy(&flow->srcmac, &radio->r_dev.d_mac.radio,
+         sizeof(struct netdev_varaddr_s));
+  memcpy(&flow->destmac, destmac, sizeof(struct netdev_varaddr_s));
+  memcpy(flow->addr, addr, addrlen);
+
+  flow->iphc1   = iphc1;
+  flow->iphc2   = iphc2;
+  flow->addrlen = addrlen;
+  flow->inuse   = true;
+}
+#endif /* CONFIG_NET_6LOWPAN_HC06_NFLOWS > 0 */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -744,8 +1036,11 @@ int sixlowpan_compresshdr_hc06(FAR struct radio_driver_s *radio,
                                FAR uint8_t *fptr)
 {
   FAR uint8_t *iphc = fptr + g_frame_hdrlen;
-  FAR struct sixlowpan_addrcontext_s *saddrcontext;
-  FAR struct sixlowpan_addrcontext_s *daddrcontext;
+  FAR struct sixlowpan_addrcontext_s *saddrcontext = NULL;
+  FAR struct sixlowpan_addrcontext_s *daddrcontext = NULL;
+#if CONFIG_NET_6LOWPAN_HC06_NFLOWS > 0
+  FAR struct sixlowpan_hc06flow_s *flow;
+#endif
   uint8_t iphc0;
   uint8_t iphc1;
   uint8_t tmp;
@@ -771,17 +1066,38 @@ int sixlowpan_compresshdr_hc06(FAR struct radio_driver_s *radio,
    * byte with [ SCI | DCI ]
    */
 
-  /* Check if dest address context exists (for allocating third byte) */
+#if CONFIG_NET_6LOWPAN_HC06_NFLOWS > 0
+  /* The address fields depend only on the addresses of the flow.  If they
+   * were compressed for a previous packet, reuse the result.
+   */
 
-  daddrcontext = find_addrcontext_byprefix(ipv6->destipaddr);
-  saddrcontext = find_addrcontext_byprefix(ipv6->srcipaddr);
+  flow = find_flow(radio, ipv6, destmac);
+  if (flow != NULL)
+    {
+      iphc1   = flow->iphc1;
+      iphc[2] = flow->iphc2;
+    }
+  else
+#endif
+    {
+      /* Check if dest address context exists (for allocating third byte) */
 
-  if (daddrcontext != NULL || saddrcontext != NULL)
+      daddrcontext = find_addrcontext_byprefix(ipv6->destipaddr);
+      saddrcontext = find_addrcontext_byprefix(ipv6->srcipaddr);
+
+      if (daddrcontext != NULL || saddrcontext != NULL)
+        {
+          /* set address context flag */
+
+          ninfo("Compressing dest or src ipaddr. Setting CID\n");
+          iphc1 |= SIXLOWPAN_IPHC_CID;
+        }
+    }
+
+  if ((iphc1 & SIXLOWPAN_IPHC_CID) != 0)
     {
-      /* set address context flag and increase g_hc06ptr */
+      /* Skip over the byte with [ SCI | DCI ] */
 
-      ninfo("Compressing dest or src ipaddr. Setting CID\n");
-      iphc1 |= SIXLOWPAN_IPHC_CID;
       g_hc06ptr++;
     }
 
@@ -888,155 +1204,31 @@ int sixlowpan_compresshdr_hc06(FAR struct radio_driver_s *radio,
       break;
     }
 
-  /* Source address - cannot be multicast */
+  /* Source and destination addresses */
 
-  if (net_is_addr_unspecified(ipv6->srcipaddr))
+#if CONFIG_NET_6LOWPAN_HC06_NFLOWS > 0
+  if (flow != NULL)
     {
-      ninfo("Compressing unspecified srcipaddr.  Setting SAC\n");
-
-      iphc1 |= SIXLOWPAN_IPHC_SAC;
-      iphc1 |= SIXLOWPAN_IPHC_SAM_128;
-    }
-  else if (saddrcontext != NULL)
-    {
-      /* Elide the prefix - indicate by CID and set address context + SAC */
-
-      ninfo("Compressing src with address context."
-            " Setting SAC. Context: %d\n",
-            saddrcontext->number);
-
-      iphc1   |= SIXLOWPAN_IPHC_SAC;
-      iphc[2] |= saddrcontext->number << 4;
-
-      /* Compression compare with this nodes address (source) */
+      /* Replay the address fields compressed for the previous packet of
+       * the same flow.
+       */
 
-      iphc1   |= compress_laddr(ipv6->srcipaddr,
-                                &radio->r_dev.d_mac.radio,
-                                SIXLOWPAN_IPHC_SAM_BIT);
-    }
-
-  /* No address context found for the source address */
-
-  else if (net_is_addr_linklocal(ipv6->srcipaddr) &&
-           ipv6->srcipaddr[1] == 0 &&  ipv6->srcipaddr[2] == 0 &&
-           ipv6->srcipaddr[3] == 0)
-    {
-      iphc1   |= compress_laddr(ipv6->srcipaddr,
-                                &radio->r_dev.d_mac.radio,
-                                SIXLOWPAN_IPHC_SAM_BIT);
+      memcpy(g_hc06ptr, flow->addr, flow->addrlen);
+      g_hc06ptr += flow->addrlen;
     }
   else
     {
-      /* Send the full source address ipaddr:  SAC = 0, SAM = 00 */
-
-      ninfo("Uncompressable "
-            "srcipaddr=%04x:%04x:%04x:%04x:%04x:%04x:%04x:%04x\n",
-            NTOHS(ipv6->srcipaddr[0]), NTOHS(ipv6->srcipaddr[1]),
-            NTOHS(ipv6->srcipaddr[2]), NTOHS(ipv6->srcipaddr[3]),
-            NTOHS(ipv6->srcipaddr[4]), NTOHS(ipv6->srcipaddr[5]),
-            NTOHS(ipv6->srcipaddr[6]), NTOHS(ipv6->srcipaddr[7]));
+      FAR uint8_t *addrptr = g_hc06ptr;
 
-      iphc1 |= SIXLOWPAN_IPHC_SAM_128;   /* 128-bits */
-      memcpy(g_hc06ptr, ipv6->srcipaddr, 16);
-      g_hc06ptr += 16;
+      iphc1 |= compress_ipaddrs(radio, ipv6, destmac, saddrcontext,
+                                daddrcontext, iphc);
+      save_flow(radio, ipv6, destmac, iphc1, iphc[2], addrptr,
+                g_hc06ptr - addrptr);
     }
-
-  /* Destination address */
-
-  if (net_is_addr_mcast(ipv6->destipaddr))
-    {
-      /* Address is multicast, try to compress */
-
-      iphc1 |= SIXLOWPAN_IPHC_M;
-      if (SIXLOWPAN_IS_MCASTADDR_COMPRESSABLE8(ipv6->destipaddr))
-        {
-          iphc1 |= SIXLOWPAN_IPHC_MDAM_8;
-
-          /* Use "last" byte ("last" meaning the LS byte in host order.
-           * destipaddr is in big-endian network order).
-           */
-
-#ifdef CONFIG_ENDIAN_BIG
-          *g_hc06ptr = (ipv6->destipaddr[7] & 0xff);
 #else
-          *g_hc06ptr = (ipv6->destipaddr[7] >> 8);
+  iphc1 |= compress_ipaddrs(radio, ipv6, destmac, saddrcontext,
+                            daddrcontext, iphc);
 #endif
-          g_hc06ptr += 1;
-        }
-      else if (SIXLOWPAN_IS_MCASTADDR_COMPRESSABLE32(ipv6->destipaddr))
-        {
-          FAR uint8_t *iptr = (FAR uint8_t *)ipv6->destipaddr;
-
-          iphc1 |= SIXLOWPAN_IPHC_MDAM_32;
-
-          /* Second byte + the last three */
-
-          *g_hc06ptr = iptr[1];
-          memcpy(g_hc06ptr + 1, &iptr[13], 3);
-          g_hc06ptr += 4;
-        }
-      else if (SIXLOWPAN_IS_MCASTADDR_COMPRESSABLE48(ipv6->destipaddr))
-        {
-          FAR uint8_t *iptr = (FAR uint8_t *)ipv6->destipaddr;
-
-          iphc1 |= SIXLOWPAN_IPHC_MDAM_48;
-
-          /* Second byte + the last five */
-
-          *g_hc06ptr = iptr[1];
-          memcpy(g_hc06ptr + 1, &iptr[11], 5);
-          g_hc06ptr += 6;
-        }
-      else
-        {
-          iphc1 |= SIXLOWPAN_IPHC_MDAM_128;
-
-          /* Full address */
-
-          memcpy(g_hc06ptr, ipv6->destipaddr, 16);
-          g_hc06ptr += 16;
-        }
-    }
-  else
-    {
-      /* Address is unicast, try to compress */
-
-      if (daddrcontext != NULL)
-        {
-          /* Elide the prefix */
-
-          ninfo("Compressing dest with address context. "
-                "Setting DAC. Context: %d\n",
-                daddrcontext->number);
-
-          iphc1   |= SIXLOWPAN_IPHC_DAC;
-          iphc[2] |= daddrcontext->number;
-
-          /* Compession compare with link address (destination) */
-
-          iphc1   |= compress_tagaddr(ipv6->destipaddr, destmac,
-                                      SIXLOWPAN_IPHC_DAM_BIT);
-        }
-
-      /* No address context found for this address */
-
-      else if (net_is_addr_linklocal(ipv6->destipaddr) &&
-               ipv6->destipaddr[1] == 0 && ipv6->destipaddr[2] == 0 &&
-               ipv6->destipaddr[3] == 0)
-        {
-          iphc1 |= compress_tagaddr(ipv6->destipaddr, destmac,
-                                    SIXLOWPAN_IPHC_DAM_BIT);
-        }
-
-      /* Send the full address */
-
-      else
-        {
-          iphc1 |= SIXLOWPAN_IPHC_DAM_128;       /* 128-bits */
-          memcpy(g_hc06ptr, ipv6->destipaddr, 16);
-          g_hc06ptr += 16;
-        }
-    }
 
   g_uncomp_hdrlen = IPv6_HDRLEN;
 
@@ -44,6 +44,18 @@
 
 #define NET_6LOWPAN_TIMEOUT SEC2TICK(CONFIG_NET_6LOWPAN_MAXAGE)
 
+/* Reassembly hash table */
+
+#ifndef CONFIG_NET_6LOWPAN_REASS_NHASH
+#  define CONFIG_NET_6LOWPAN_REASS_NHASH 8
+#endif
+
+#define REASS_HASH_MASK (CONFIG_NET_6LOWPAN_REASS_NHASH - 1)
+
+#if (CONFIG_NET_6LOWPAN_REASS_NHASH & REASS_HASH_MASK) != 0
+#  error CONFIG_NET_6LOWPAN_REASS_NHASH must be a power of two
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -55,9 +67,20 @@
 
 static FAR struct sixlowpan_reassbuf_s *g_free_reass;
 
-/* This is a list of active, allocated reassemby buffers */
+/* This is a list of active, allocated reassemby buffers.  New buffers are
+ * added at the tail so the list is ordered by the start time of the
+ * reassembly, the oldest at the head.
+ */
 
 static FAR struct sixlowpan_reassbuf_s *g_active_reass;
+static FAR struct sixlowpan_reassbuf_s *g_active_tail;
+
+/* Hash table of the active reassembly buffers, keyed on reassembly tag and
+ * fragment source.
+ */
+
+static FAR struct sixlowpan_reassbuf_s *
+              g_reass_hash[CONFIG_NET_6LOWPAN_REASS_NHASH];
 
 /* Pool of pre-allocated reassembly buffer structures */
 
@@ -65,7 +88,7 @@ static struct sixlowpan_reassbuf_s
               g_metadata_pool[CONFIG_NET_6LOWPAN_NREASSBUF];
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
@@ -100,11 +123,36 @@ static bool sixlowpan_compare_fragsrc(FAR struct sixlowpan_reassbuf_s *reass,
   return false;
 }
 
+/****************************************************************************
+ * Name: sixlowpan_reass_hash
+ *
+ * Description:
+ *   Return the hash table index for a reassembly tag and fragment source.
+ *
+ ****************************************************************************/
+
+static unsigned int
+  sixlowpan_reass_hash(uint16_t reasstag,
+                       FAR const struct netdev_varaddr_s *fragsrc)
+{
+  unsigned int hash = reasstag;
+  int i;
+
+  for (i = 0; i < fragsrc->nv_addrlen; i++)
+    {
+      hash = (hash * 31) + fragsrc->nv_addr[i];
+    }
+
+  return (hash ^ (hash >> 8)) & REASS_HASH_MASK;
+}
+
 /****************************************************************************
  * Name: sixlowpan_reass_expire
  *
  * Description:
- *   Free all expired or inactive reassembly buffers.
+ *   Free all expired or inactive reassembly buffers at the head of the
+ *   active list.  The list is ordered by age, so the walk stops at the
+ *   first buffer that is still in progress and has not timed out.
  *
  * Input Parameters:
  *   None
@@ -120,39 +168,31 @@ static bool sixlowpan_compare_fragsrc(FAR struct sixlowpan_reassbuf_s *reass,
 static void sixlowpan_reass_expire(void)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
-  FAR struct sixlowpan_reassbuf_s *next;
   clock_t elapsed;
 
-  /* If reassembly timed out, cancel it */
-
-  for (reass = g_active_reass; reass != NULL; reass = next)
+  while ((reass = g_active_reass) != NULL)
     {
-      /* Needed if 'reass' is freed */
-
-      next = reass->rb_flink;
-
       /* Free any inactive reassembly buffers.  This is done because the life
        * the reassembly buffer is not cerain.
        */
 
-      if (!reass->rb_active)
-        {
-          sixlowpan_reass_free(reass);
-        }
-      else
+      if (reass->rb_active)
         {
           /* Get the elpased time of the reassembly */
 
           elapsed = clock_systime_ticks() - reass->rb_time;
 
-          /* If the reassembly has expired, then free the reassembly buffer */
+          /* If this one has not expired, none of the younger ones has */
 
-          if (elapsed >= NET_6LOWPAN_TIMEOUT)
+          if (elapsed < NET_6LOWPAN_TIMEOUT)
             {
-              nwarn("WARNING: Reassembly timed out\n");
-              sixlowpan_reass_free(reass);
+              break;
             }
+
+          nwarn("WARNING: Reassembly timed out\n");
         }
+
+      sixlowpan_reass_free(reass);
     }
 }
 
@@ -160,7 +200,8 @@ static void sixlowpan_reass_expire(void)
  * Name: sixlowpan_remove_active
  *
  * Description:
- *   Remove a reassembly buffer from the active reassembly buffer list.
+ *   Remove a reassembly buffer from the active reassembly buffer list and
+ *   from the hash table.
  *
  * Input Parameters:
  *   reass - The reassembly buffer to be removed.
@@ -175,34 +216,45 @@ static void sixlowpan_reass_expire(void)
 
 static void sixlowpan_remove_active(FAR struct sixlowpan_reassbuf_s *reass)
 {
-  FAR struct sixlowpan_reassbuf_s *curr;
-  FAR struct sixlowpan_reassbuf_s *prev;
+  FAR struct sixlowpan_reassbuf_s **prev;
 
-  /* Find the reassembly buffer in the list of active reassembly buffers */
+  /* Remove it from the active reassembly buffer list */
 
-  for (prev = NULL, curr = g_active_reass;
-       curr != NULL && curr != reass;
-       prev = curr, curr = curr->rb_flink)
+  if (reass->rb_blink == NULL)
     {
+      g_active_reass = reass->rb_flink;
+    }
+  else
+    {
+      reass->rb_blink->rb_flink = reass->rb_flink;
     }
 
-  /* Did we find it? */
+  if (reass->rb_flink == NULL)
+    {
+      g_active_tail = reass->rb_blink;
+    }
+  else
+    {
+      reass->rb_flink->rb_blink = reass->rb_blink;
+    }
 
-  if (curr != NULL)
+  /* Remove it from its hash chain */
+
+  prev = &g_reass_hash[sixlowpan_reass_hash(reass->rb_reasstag,
+                                            &reass->rb_fragsrc)];
+  while (*prev != NULL && *prev != reass)
     {
-      /* Yes.. remove it from the active reassembly buffer list */
+      prev = &(*prev)->rb_hlink;
+    }
 
-      if (prev == NULL)
-        {
-          g_active_reass = reass->rb_flink;
-        }
-      else
-        {
-          prev->rb_flink = reass->rb_flink;
-        }
+  if (*prev != NULL)
+    {
+      *prev = reass->rb_hlink;
     }
 
   reass->rb_flink = NULL;
+  reass->rb_blink = NULL;
+  reass->rb_hlink = NULL;
 }
 
 /****************************************************************************
@@ -280,6 +332,7 @@ FAR struct sixlowpan_reassbuf_s *
                            FAR const struct netdev_varaddr_s *fragsrc)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
+  unsigned int hash;
   uint8_t pool;
 
   /* First, removed any expired or inactive reassembly buffers.  This might
@@ -324,10 +377,25 @@ FAR struct sixlowpan_reassbuf_s *
       reass->rb_reasstag = reasstag;
       reass->rb_time     = clock_systime_ticks();
 
-      /* Add the reassembly buffer to the list of active reassembly buffers */
+      /* Add the reassembly buffer to the tail of the list of active
+       * reassembly buffers and to the hash table.
+       */
 
-      reass->rb_flink   = g_active_reass;
-      g_active_reass    = reass;
+      reass->rb_blink = g_active_tail;
+      if (g_active_tail == NULL)
+        {
+          g_active_reass = reass;
+        }
+      else
+        {
+          g_active_tail->rb_flink = reass;
+        }
+
+      g_active_tail = reass;
+
+      hash               = sixlowpan_reass_hash(reasstag, fragsrc);
+      reass->rb_hlink    = g_reass_hash[hash];
+      g_reass_hash[hash] = reass;
     }
 
   return reass;
@@ -365,17 +433,19 @@ FAR struct sixlowpan_reassbuf_s *
   sixlowpan_reass_expire();
 
   /* Now search for the matching reassembly buffer in the remainng, active
-   * reassembly buffers.
+   * reassembly buffers of the same hash chain.
    */
 
-  for (reass = g_active_reass; reass != NULL; reass = reass->rb_flink)
+  for (reass = g_reass_hash[sixlowpan_reass_hash(reasstag, fragsrc)];
+       reass != NULL;
+       reass = reass->rb_hlink)
     {
       /* In order to be a match, it must have the same reassembly tag as
        * well as source address (different sources might use the same
        * reassembly tag).
        */
 
-      if (reass->rb_reasstag == reasstag &&
+      if (reass->rb_active && reass->rb_reasstag == reasstag &&
           sixlowpan_compare_fragsrc(reass, fragsrc))
         {
           return reass;
@@ -410,10 +480,13 @@ FAR struct sixlowpan_reassbuf_s *
 void sixlowpan_reass_free(FAR struct sixlowpan_reassbuf_s *reass)
 {
   /* First, remove the reassembly buffer from the list of active reassembly
-   * buffers.
+   * buffers.  Buffers provided by the radio driver are never on that list.
    */
 
-  sixlowpan_remove_active(reass);
+  if (reass->rb_pool != REASS_POOL_RADIO)
+    {
+      sixlowpan_remove_active(reass);
+    }
 
   /* If this is a pre-allocated reassembly buffer structure, then just put it
    * back in the free list.
@@ -0,0 +1,188 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives several messages from a socket with the
+ *   network locked only once.  This is an internal OS interface.  It is
+ *   functionally equivalent to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Buffers to receive the messages
+ *   vlen      The number of messages in msgvec
+ *   flags     Receive flags
+ *   timeout   Time after which no more messages are waited for, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  Otherwise, if
+ *   not even the first message could be received, a negated errno value
+ *   is returned (see comments with recvmsg() for a list of appropriate
+ *   errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  clock_t deadline = 0;
+  unsigned int i;
+  ssize_t ret = 0;
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (timeout != NULL)
+    {
+      sclock_t ticks;
+
+      ret = clock_time2ticks(timeout, &ticks);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      deadline = clock_systime_ticks() + ticks;
+    }
+
+  /* The protocols lock the network again for each message, which is cheap
+   * while it is already held.  Waiting for a message still releases it.
+   */
+
+  net_lock();
+  for (i = 0; i < vlen; i++)
+    {
+      ret = psock_recvmsg(psock, &msgvec[i].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+
+      /* Do not wait for the following messages if so requested */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      /* As on other systems, the timeout is only checked after each
+       * message received.
+       */
+
+      if (timeout != NULL &&
+          (sclock_t)(clock_systime_ticks() - deadline) >= 0)
+        {
+          i++;
+          break;
+        }
+    }
+
+  net_unlock();
+
+  /* Report an error only if no message was received.  Otherwise, the
+   * error will be seen again by the next call.
+   */
+
+  return i > 0 ? (int)i : (int)ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() receives up to vlen messages from a socket in one call.
+ *   It behaves as a sequence of recvmsg() calls, storing the length of
+ *   each message received in the msg_len field of its element of msgvec.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   Buffers to receive the messages
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags.  In addition to the flags of recvmsg(),
+ *            MSG_WAITFORONE makes only the first message wait.
+ *   timeout  Time after which no more messages are waited for, or NULL to
+ *            wait forever.  It is only checked after each message.
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On error, -1 is
+ *   returned, and errno is set as by recvmsg().
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  psock = sockfd_socket(sockfd);
+  ret   = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+  if (ret < 0)
+    {
+      _SO_SETERRNO(psock, -ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
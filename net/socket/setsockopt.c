@@ -34,6 +34,9 @@
 #include <arch/irq.h>
 
 #include <nuttx/net/net.h>
+#ifdef CONFIG_NET_TIMESTAMPING
+#  include <net/net_tstamp.h>
+#endif
 
 #include "socket/socket.h"
 #include "inet/inet.h"
@@ -42,6 +45,7 @@
 #include "usrsock/usrsock.h"
 #include "utils/utils.h"
 #include "can/can.h"
+#include "pkt/pkt.h"
 
 /****************************************************************************
  * Public Functions
@@ -275,6 +279,37 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_TIMESTAMPING
+      case SO_TIMESTAMPING: /* Selects the timestamps of incoming packets */
+        {
+          int tsflags;
+
+          if (value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          /* Only the receive timestamps are supported for now */
+
+          tsflags = *(FAR const int *)value;
+          if ((tsflags & (SOF_TIMESTAMPING_TX_HARDWARE |
+                          SOF_TIMESTAMPING_TX_SOFTWARE)) != 0)
+            {
+              return -EOPNOTSUPP;
+            }
+
+          if ((tsflags & ~SOF_TIMESTAMPING_MASK) != 0)
+            {
+              return -EINVAL;
+            }
+
+          net_lock();
+          conn->s_tstamping = tsflags;
+          net_unlock();
+        }
+        break;
+#endif
+
 #if CONFIG_NET_RECV_BUFSIZE > 0
       case SO_RCVBUF:     /* Sets receive buffer size */
         {
@@ -523,6 +558,12 @@ int psock_setsockopt(FAR struct socket *psock, int level, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_PKT_RING
+      case SOL_PACKET: /* Packet socket options (see include/netpacket/packet.h) */
+        ret = pkt_setsockopt(psock, option, value, value_len);
+        break;
+#endif
+
       default:         /* The provided level is invalid */
         ret = -ENOPROTOOPT;
         break;
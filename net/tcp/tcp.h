@@ -31,12 +31,15 @@
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/net.h>
 #include <nuttx/wqueue.h>
 
+#include "utils/utils.h"
+
 #if defined(CONFIG_NET_TCP) && !defined(CONFIG_NET_TCP_NO_STACK)
 
 /****************************************************************************
@@ -66,6 +69,9 @@
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 #  define TCP_WBNACK(wrb)            ((wrb)->wb_nack)
 #endif
+#ifdef CONFIG_NET_TCP_SACK
+#  define TCP_WBFLAGS(wrb)           ((wrb)->wb_flags)
+#endif
 #  define TCP_WBIOB(wrb)             ((wrb)->wb_iob)
 #  define TCP_WBCOPYOUT(wrb,dest,n)  (iob_copyout(dest,(wrb)->wb_iob,(n),0))
 #  define TCP_WBCOPYIN(wrb,src,n,off) \
@@ -100,6 +106,8 @@
 /* The TCP options flags */
 
 #define TCP_WSCALE            0x01U /* Window Scale option enabled */
+#define TCP_SACK              0x02U /* SACK permitted by the peer */
+#define TCP_RECOVERY          0x04U /* In fast recovery */
 
 /* After receiving 3 duplicate ACKs, TCP performs a retransmission
  * (RFC 5681 (3.2))
@@ -107,6 +115,11 @@
 
 #define TCP_FAST_RETRANSMISSION_THRESH 3
 
+/* The write buffer flags used with CONFIG_NET_TCP_SACK */
+
+#define TCP_WBF_SACKED        0x01U /* All of the data has been SACKed */
+#define TCP_WBF_REXMIT        0x02U /* Sent again in this fast recovery */
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -129,6 +142,7 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct tcp_cc_s;          /* Forward reference */
 
 /* This is a container that holds the poll-related information */
 
@@ -171,6 +185,10 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+#ifdef CONFIG_NET_HASH_CONNS
+  struct net_hnode_s hnode; /* Hashed on local/remote port, remote address */
+  struct net_hnode_s pnode; /* Hashed on local port */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -189,7 +207,13 @@ struct tcp_conn_s
                            * variable */
   uint8_t  rto;           /* Retransmission time-out */
   uint8_t  tcpstateflags; /* TCP state and flags */
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+  dq_entry_t tmnode;      /* Node in the TCP timer wheel slot */
+  uint32_t tmexpiry;      /* Wheel tick at which the timer expires */
+  bool     tmarmed;       /* True: tmnode is linked into the wheel */
+#else
   struct   work_s work;   /* TCP timer handle */
+#endif
   bool     timeout;       /* Trigger from timer expiry */
   uint8_t  timer;         /* The retransmission timer (units: half-seconds) */
   uint8_t  nrtx;          /* The number of retransmissions for the last
@@ -261,6 +285,49 @@ struct tcp_conn_s
   uint32_t   isn;         /* Initial sequence number */
   uint32_t   sndseq_max;  /* The sequence number of next not-retransmitted
                            * segment (next greater sndseq) */
+#ifdef CONFIG_NET_TCP_SACK
+  uint32_t   recover;     /* sndseq_max when the fast recovery began */
+#endif
+#endif
+
+#ifdef CONFIG_NET_TCP_NAGLE
+  /* Coalescing of small writes
+   *
+   *   nodelay - TCP_NODELAY: do not hold back small segments while data is
+   *             in flight (Nagle's algorithm disabled).
+   *   cork    - TCP_CORK: only send full segments until uncorked or
+   *             TCP_CORK_TIMEOUT has elapsed.
+   *   more    - The last send() had MSG_MORE: behave as if corked.
+   *   held    - A partial segment is being held back since hold_start.
+   */
+
+  bool       nodelay;
+  bool       cork;
+  bool       more;
+  bool       held;
+  clock_t    hold_start;
+#endif
+
+  /* Transmit statistics, reported by TCP_INFO */
+
+  uint32_t   segs_out;    /* Number of data segments sent */
+  uint64_t   bytes_sent;  /* Number of payload bytes sent, incl. rexmits */
+
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control (RFC 5681).  The cc_* fields are private to the
+   * congestion control algorithm.
+   */
+
+  /* The congestion control algorithm */
+
+  FAR const struct tcp_cc_s *cc;
+
+  uint32_t cwnd;          /* Congestion window (bytes) */
+  uint32_t ssthresh;      /* Slow start threshold (bytes) */
+  uint32_t cc_wmax;       /* CUBIC: window before the last reduction */
+  uint32_t cc_west;       /* CUBIC: window that Reno would have reached */
+  uint32_t cc_k;          /* CUBIC: time to grow back to cc_wmax (msec) */
+  clock_t  cc_epoch;      /* CUBIC: start of the growth epoch, 0 if none */
 #endif
 
 #ifdef CONFIG_NET_TCPBACKLOG
@@ -312,6 +379,15 @@ struct tcp_conn_s
 #ifdef CONFIG_DEBUG_ASSERTIONS
   int sndcb_alloc_cnt;    /* The callback allocation counter */
 #endif
+
+#ifdef CONFIG_NET_TCP_CONN_LOCK
+  /* Serializes the senders on this connection while they copy data into
+   * write buffers without the network lock.  It is always taken before
+   * the network lock.
+   */
+
+  mutex_t snd_lock;
+#endif
 #endif
 
   /* accept() is called when the TCP logic has created a connection
@@ -345,11 +421,44 @@ struct tcp_wrbuffer_s
                             * segment sent */
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
   uint8_t    wb_nack;      /* The number of ack count */
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+  uint8_t    wb_flags;     /* See TCP_WBF_* definitions */
 #endif
   struct iob_s *wb_iob;    /* Head of the I/O buffer chain */
 };
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+/* A congestion control algorithm.  The common slow start is done by
+ * tcp_cc_ack(); the algorithm handles congestion avoidance and the
+ * reaction to losses.
+ */
+
+struct tcp_cc_s
+{
+  FAR const char *name;   /* Name for the TCP_CONGESTION socket option */
+
+  /* Set up the state of a newly established connection.  cwnd and
+   * ssthresh have already been initialized.
+   */
+
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+
+  /* Grow cwnd in congestion avoidance when acked bytes were ACKed */
+
+  CODE void (*ack)(FAR struct tcp_conn_s *conn, uint32_t acked);
+
+  /* Reduce the window after a loss detected by duplicate ACKs */
+
+  CODE void (*loss)(FAR struct tcp_conn_s *conn);
+
+  /* Reduce the window after a retransmission timeout */
+
+  CODE void (*rto)(FAR struct tcp_conn_s *conn);
+};
+#endif
+
 /* Support for listen backlog:
  *
  *   struct tcp_blcontainer_s describes one backlogged connection
@@ -1074,6 +1183,61 @@ uint16_t tcp_rx_mss(FAR struct net_driver_s *dev);
 void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
                 uint8_t ack);
 
+/****************************************************************************
+ * Name: tcp_synq_syn
+ *
+ * Description:
+ *   Handle a SYN for a listening port without allocating a connection
+ *   structure.  The handshake is recorded in the SYN queue, or encoded in
+ *   a SYN cookie if the queue is full, and a SYN-ACK is formatted into the
+ *   device buffer.
+ *
+ * Input Parameters:
+ *   dev       - The device that received the SYN
+ *   tcp       - The TCP header of the SYN
+ *   mss       - The MSS option of the SYN (clamped), zero if none
+ *   flags     - TCP_WSCALE and/or TCP_SACK options of the SYN
+ *   snd_scale - The window scale announced by the peer
+ *
+ * Returned Value:
+ *   OK if a SYN-ACK has been formatted; -ENOMEM if the SYN must be
+ *   dropped.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNQUEUE
+int tcp_synq_syn(FAR struct net_driver_s *dev, FAR struct tcp_hdr_s *tcp,
+                 uint16_t mss, uint8_t flags, uint8_t snd_scale);
+#endif
+
+/****************************************************************************
+ * Name: tcp_synq_ack
+ *
+ * Description:
+ *   Handle an ACK that matches no active connection.  If it completes a
+ *   handshake recorded by tcp_synq_syn(), the connection structure is
+ *   allocated and returned in the TCP_SYN_RCVD state.
+ *
+ * Input Parameters:
+ *   dev - The device that received the ACK
+ *   tcp - The TCP header of the ACK
+ *
+ * Returned Value:
+ *   The new connection or NULL.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNQUEUE
+FAR struct tcp_conn_s *tcp_synq_ack(FAR struct net_driver_s *dev,
+                                    FAR struct tcp_hdr_s *tcp);
+#endif
+
 /****************************************************************************
  * Name: tcp_appsend
  *
@@ -1208,6 +1372,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device driver structure holding the packet
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -1224,9 +1389,84 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t nbytes);
 
+#ifdef CONFIG_NET_TCP_GRO
+/****************************************************************************
+ * Name: tcp_gro_receive
+ *
+ * Description:
+ *   Try to merge the incoming TCP segment in d_buf with the segments
+ *   received before it.  A plain data segment that continues the stream of
+ *   an established connection is held back by the device, and the data of
+ *   the following in-order segments of that connection is queued behind
+ *   it.  The merged segment is passed to TCP once the sender pushes, once
+ *   CONFIG_NET_TCP_GRO_MAXSIZE bytes have been merged, when a segment of
+ *   the connection arrives that cannot be merged or when the driver calls
+ *   netdev_gro_flush().
+ *
+ * Input Parameters:
+ *   dev   - The device driver structure containing the received segment.
+ *   iplen - The size of the IP header, including IPv6 extension headers.
+ *
+ * Returned Value:
+ *   True if the segment has been taken; d_len is then either zero or the
+ *   length of a response in d_buf.  False if the segment must be passed
+ *   to TCP as usual.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool tcp_gro_receive(FAR struct net_driver_s *dev, unsigned int iplen);
+
+/****************************************************************************
+ * Name: tcp_gro_input
+ *
+ * Description:
+ *   Called by TCP input for a merged segment: queue the data of the
+ *   segment in d_buf and the data merged into it in the read-ahead buffer
+ *   of the connection and advance rcvseq.  d_len is zero on return.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure holding the segment
+ *   conn - The TCP connection of the segment
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_gro_input(FAR struct net_driver_s *dev,
+                   FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_gro_release
+ *
+ * Description:
+ *   Drop the segment held back by the device, if any.  Called when the
+ *   device goes down or is unregistered.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_gro_release(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Name: tcp_backlogcreate
  *
@@ -1304,6 +1544,24 @@ bool tcp_backlogavailable(FAR struct tcp_conn_s *conn);
 #  define tcp_backlogavailable(c) (false)
 #endif
 
+/****************************************************************************
+ * Name: tcp_backlogpending
+ *
+ * Description:
+ *   Return the number of connections in the backlog that are ready to be
+ *   accepted.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCPBACKLOG
+int tcp_backlogpending(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_backlogpending(c) (0)
+#endif
+
 /****************************************************************************
  * Name: tcp_backlogremove
  *
@@ -2025,6 +2283,96 @@ int tcp_ioctl(FAR struct tcp_conn_s *conn, int cmd,
 void tcp_sendbuffer_notify(FAR struct tcp_conn_s *conn);
 #endif /* CONFIG_NET_SEND_BUFSIZE */
 
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize the congestion window of a connection that has just been
+ *   established.  The MSS must be known.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Grow the congestion window when new data has been ACKed.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   acked - The number of newly ACKed bytes
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+
+/****************************************************************************
+ * Name: tcp_cc_loss and tcp_cc_rto
+ *
+ * Description:
+ *   Reduce the congestion window when a segment has been found lost by
+ *   duplicate ACKs (tcp_cc_loss) or by the retransmission timer
+ *   (tcp_cc_rto).
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_loss(FAR struct tcp_conn_s *conn);
+void tcp_cc_rto(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   name - The name of the algorithm, e.g. "newreno" or "cubic"
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no such algorithm.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name);
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_cc_init(conn)
+#  define tcp_cc_ack(conn, acked)
+#  define tcp_cc_loss(conn)
+#  define tcp_cc_rto(conn)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
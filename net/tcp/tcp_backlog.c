@@ -268,6 +268,28 @@ bool tcp_backlogavailable(FAR struct tcp_conn_s *conn)
   return (conn && conn->backlog && !sq_empty(&conn->backlog->bl_pending));
 }
 
+/****************************************************************************
+ * Name: tcp_backlogpending
+ *
+ * Description:
+ *  Called from ioctl(FIONREAD) on a listening socket so that a server can
+ *  accept all pending connections after a single poll() wakeup.
+ *
+ * Assumptions:
+ *   Called from network socket logic with the network locked
+ *
+ ****************************************************************************/
+
+int tcp_backlogpending(FAR struct tcp_conn_s *conn)
+{
+  if (conn == NULL || conn->backlog == NULL)
+    {
+      return 0;
+    }
+
+  return (int)sq_count(&conn->backlog->bl_pending);
+}
+
 /****************************************************************************
  * Name: tcp_backlogremove
  *
@@ -85,7 +85,7 @@ tcp_data_event(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
        * partial packets will not be buffered.
        */
 
-      recvlen = tcp_datahandler(conn, buffer, buflen);
+      recvlen = tcp_datahandler(dev, conn, buffer, buflen);
       if (recvlen < buflen)
         {
           /* There is no handler to receive new data and there are no free
@@ -215,6 +215,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device driver structure holding the packet
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -231,7 +232,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t buflen)
 {
   FAR struct iob_s *iob;
@@ -239,6 +241,25 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
   int ret;
   unsigned int i;
 
+#ifdef CONFIG_NETDEV_IOB
+  /* If the driver passed the packet in an I/O buffer, then try to queue
+   * that buffer instead of copying the data.
+   */
+
+  iob = netdev_iob_take(dev, buffer, buflen);
+  if (iob != NULL)
+    {
+      if (conn->readahead != NULL)
+        {
+          iob_concat(conn->readahead, iob);
+          iob = conn->readahead;
+        }
+
+      copied = buflen;
+      goto queue;
+    }
+#endif
+
   /* Try to allocate I/O buffers and copy the data into them
    * without waiting (and throttling as necessary).
    */
@@ -309,6 +330,9 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
       return 0;
     }
 
+#ifdef CONFIG_NETDEV_IOB
+queue:
+#endif
   conn->readahead = iob;
 
 #ifdef CONFIG_NET_TCP_NOTIFIER
@@ -0,0 +1,499 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Initial window (RFC 6928) */
+
+#define TCP_CC_IW(mss) \
+  ((mss) * 10 < 14600 ? (mss) * 10 : \
+   ((mss) * 2 > 14600 ? (mss) * 2 : 14600))
+
+/* The window is never reduced below two segments (RFC 5681) */
+
+#define TCP_CC_MINWND(mss)   (2 * (uint32_t)(mss))
+
+/* CUBIC parameters (RFC 8312): the multiplicative decrease factor beta is
+ * 0.7, approximated as 717 / 1024, and the scaling constant C is 0.4.
+ */
+
+#define CUBIC_BETA           717
+#define CUBIC_BETA_SHIFT     10
+
+/* Limit the time since the epoch used in the cubic function, so that its
+ * cube cannot overflow (100 seconds)
+ */
+
+#define CUBIC_MAXDELTA       100000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void newreno_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+static void newreno_loss(FAR struct tcp_conn_s *conn);
+static void newreno_rto(FAR struct tcp_conn_s *conn);
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+static void cubic_init(FAR struct tcp_conn_s *conn);
+static void cubic_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+static void cubic_loss(FAR struct tcp_conn_s *conn);
+static void cubic_rto(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct tcp_cc_s g_tcp_cc_newreno =
+{
+  "newreno",
+  NULL,
+  newreno_ack,
+  newreno_loss,
+  newreno_rto
+};
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+static const struct tcp_cc_s g_tcp_cc_cubic =
+{
+  "cubic",
+  cubic_init,
+  cubic_ack,
+  cubic_loss,
+  cubic_rto
+};
+#endif
+
+/* All available algorithms */
+
+static FAR const struct tcp_cc_s * const g_tcp_cc[] =
+{
+  &g_tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cc_cubic,
+#endif
+};
+
+#ifdef CONFIG_NET_TCP_CC_DEFAULT_CUBIC
+#  define TCP_CC_DEFAULT (&g_tcp_cc_cubic)
+#else
+#  define TCP_CC_DEFAULT (&g_tcp_cc_newreno)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_ops
+ *
+ * Description:
+ *   Return the algorithm of a connection.  Connections for which none has
+ *   been selected use the configured default.
+ *
+ ****************************************************************************/
+
+static FAR const struct tcp_cc_s *tcp_cc_ops(FAR struct tcp_conn_s *conn)
+{
+  return conn->cc != NULL ? conn->cc : TCP_CC_DEFAULT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_halfflight
+ *
+ * Description:
+ *   Half of the data in flight, but at least the minimum window.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cc_halfflight(FAR struct tcp_conn_s *conn)
+{
+  uint32_t half = conn->tx_unacked / 2;
+
+  return half > TCP_CC_MINWND(conn->mss) ? half : TCP_CC_MINWND(conn->mss);
+}
+
+/****************************************************************************
+ * Name: newreno_ack, newreno_loss and newreno_rto
+ *
+ * Description:
+ *   The congestion avoidance of RFC 5681: grow by about one segment per
+ *   round trip time and halve the window after a loss.
+ *
+ ****************************************************************************/
+
+static void newreno_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t incr;
+
+  if (acked > conn->mss)
+    {
+      acked = conn->mss;
+    }
+
+  incr = (uint32_t)conn->mss * acked / conn->cwnd;
+  conn->cwnd += incr > 0 ? incr : 1;
+}
+
+static void newreno_loss(FAR struct tcp_conn_s *conn)
+{
+  conn->ssthresh = tcp_cc_halfflight(conn);
+  conn->cwnd     = conn->ssthresh;
+}
+
+static void newreno_rto(FAR struct tcp_conn_s *conn)
+{
+  conn->ssthresh = tcp_cc_halfflight(conn);
+  conn->cwnd     = conn->mss;
+}
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/****************************************************************************
+ * Name: cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root, rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+  uint64_t root = 0;
+  uint64_t b;
+  int shift;
+
+  for (shift = 63; shift >= 0; shift -= 3)
+    {
+      root <<= 1;
+      b = 3 * root * (root + 1) + 1;
+      if ((x >> shift) >= b)
+        {
+          x -= b << shift;
+          root++;
+        }
+    }
+
+  return (uint32_t)root;
+}
+
+/****************************************************************************
+ * Name: cubic_init, cubic_ack, cubic_loss and cubic_rto
+ *
+ * Description:
+ *   CUBIC (RFC 8312).  After a reduction, the window follows
+ *   W(t) = C * (t - K)^3 + Wmax, where t is the time since the growth
+ *   epoch began: it grows back quickly towards Wmax, the window at which
+ *   the last loss happened, stays near it for a while, and then probes
+ *   for more bandwidth.  The window never grows slower than NewReno would.
+ *
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn)
+{
+  conn->cc_wmax  = 0;
+  conn->cc_epoch = 0;
+}
+
+static void cubic_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t target;
+  uint32_t incr;
+  int64_t offset;
+  int64_t delta;
+  clock_t now = clock_systime_ticks();
+
+  if (conn->cc_epoch == 0)
+    {
+      /* Start a new epoch, K = cbrt((Wmax - cwnd) / C) seconds */
+
+      conn->cc_epoch = now != 0 ? now : 1;
+      conn->cc_west  = conn->cwnd;
+
+      if (conn->cwnd < conn->cc_wmax)
+        {
+          conn->cc_k = cubic_cbrt((uint64_t)(conn->cc_wmax - conn->cwnd) *
+                                  25000 / conn->mss * 100000);
+        }
+      else
+        {
+          conn->cc_k    = 0;
+          conn->cc_wmax = conn->cwnd;
+        }
+    }
+
+  /* Evaluate W(t) in bytes with t in milliseconds */
+
+  delta = (int64_t)TICK2MSEC(now - conn->cc_epoch) - conn->cc_k;
+  if (delta > CUBIC_MAXDELTA)
+    {
+      delta = CUBIC_MAXDELTA;
+    }
+  else if (delta < -CUBIC_MAXDELTA)
+    {
+      delta = -CUBIC_MAXDELTA;
+    }
+
+  offset = 4 * delta * delta * delta / 10000 * conn->mss / 1000000;
+  offset += conn->cc_wmax;
+  target = offset < 0 ? 0 : offset > UINT32_MAX / 2 ? UINT32_MAX / 2 :
+           (uint32_t)offset;
+
+  /* Grow by the distance to the target over one window's worth of ACKs,
+   * but by no more than half a segment per segment ACKed.
+   */
+
+  if (target > conn->cwnd)
+    {
+      incr = (uint64_t)(target - conn->cwnd) * acked / conn->cwnd;
+      if (incr > acked / 2)
+        {
+          incr = acked / 2;
+        }
+    }
+  else
+    {
+      incr = (uint64_t)conn->mss * acked / (100 * conn->cwnd);
+    }
+
+  conn->cwnd += incr > 0 ? incr : 1;
+
+  /* The TCP-friendly region: Reno with CUBIC's beta grows by
+   * 3 * beta / (2 - beta) (about 9 / 17) segments per round trip time.
+   */
+
+  conn->cc_west += (uint64_t)9 * conn->mss * acked / (17 * conn->cwnd);
+  if (conn->cwnd < conn->cc_west)
+    {
+      conn->cwnd = conn->cc_west;
+    }
+}
+
+static void cubic_loss(FAR struct tcp_conn_s *conn)
+{
+  uint32_t ssthresh;
+
+  /* Fast convergence: release bandwidth to newer flows if the window did
+   * not get back to where it was at the last loss.
+   */
+
+  if (conn->cwnd < conn->cc_wmax)
+    {
+      conn->cc_wmax = (uint32_t)(((uint64_t)conn->cwnd *
+                                  ((1 << CUBIC_BETA_SHIFT) + CUBIC_BETA)) >>
+                                 (CUBIC_BETA_SHIFT + 1));
+    }
+  else
+    {
+      conn->cc_wmax = conn->cwnd;
+    }
+
+  ssthresh = (uint32_t)(((uint64_t)conn->cwnd * CUBIC_BETA) >>
+                        CUBIC_BETA_SHIFT);
+
+  conn->ssthresh = ssthresh > TCP_CC_MINWND(conn->mss) ?
+                   ssthresh : TCP_CC_MINWND(conn->mss);
+  conn->cwnd     = conn->ssthresh;
+  conn->cc_epoch = 0;
+}
+
+static void cubic_rto(FAR struct tcp_conn_s *conn)
+{
+  cubic_loss(conn);
+  conn->cwnd = conn->mss;
+}
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize the congestion window of a connection that has just been
+ *   established.
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn)
+{
+  FAR const struct tcp_cc_s *cc = tcp_cc_ops(conn);
+
+  conn->cwnd     = TCP_CC_IW((uint32_t)conn->mss);
+  conn->ssthresh = UINT32_MAX;
+
+  if (cc->init != NULL)
+    {
+      cc->init(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Grow the congestion window when new data has been ACKed.
+ *
+ ****************************************************************************/
+
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  if (acked == 0 || conn->cwnd == 0 || conn->cwnd >= UINT32_MAX / 2)
+    {
+      return;
+    }
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Keep the reduced window until the fast recovery is over */
+
+  if ((conn->flags & TCP_RECOVERY) != 0)
+    {
+      return;
+    }
+#endif
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      /* Slow start, by at most one segment per ACK (RFC 5681) */
+
+      conn->cwnd += acked < conn->mss ? acked : conn->mss;
+    }
+  else
+    {
+      tcp_cc_ops(conn)->ack(conn, acked);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_loss
+ *
+ * Description:
+ *   Reduce the congestion window after a loss found by duplicate ACKs.
+ *
+ ****************************************************************************/
+
+void tcp_cc_loss(FAR struct tcp_conn_s *conn)
+{
+  if (conn->cwnd != 0)
+    {
+      tcp_cc_ops(conn)->loss(conn);
+      ninfo("cwnd=%" PRIu32 " ssthresh=%" PRIu32 "\n",
+            conn->cwnd, conn->ssthresh);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_rto
+ *
+ * Description:
+ *   Reduce the congestion window after a retransmission timeout.  Only the
+ *   first timeout of a segment reduces ssthresh.  This is called after the
+ *   retransmission count has been incremented.
+ *
+ ****************************************************************************/
+
+void tcp_cc_rto(FAR struct tcp_conn_s *conn)
+{
+  if (conn->cwnd == 0)
+    {
+      return;
+    }
+
+  if (conn->nrtx <= 1)
+    {
+      tcp_cc_ops(conn)->rto(conn);
+    }
+  else
+    {
+      conn->cwnd = conn->mss;
+    }
+
+  ninfo("cwnd=%" PRIu32 " ssthresh=%" PRIu32 "\n",
+        conn->cwnd, conn->ssthresh);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name)
+{
+  int i;
+
+  for (i = 0; i < sizeof(g_tcp_cc) / sizeof(g_tcp_cc[0]); i++)
+    {
+      if (strcmp(g_tcp_cc[i]->name, name) == 0)
+        {
+          conn->cc = g_tcp_cc[i];
+
+          /* Restart the new algorithm from the current window */
+
+          if (conn->cwnd != 0 && conn->cc->init != NULL)
+            {
+              conn->cc->init(conn);
+            }
+
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn)
+{
+  return tcp_cc_ops(conn)->name;
+}
+
+#endif /* CONFIG_NET_TCP_CC */
@@ -55,6 +55,7 @@
 
 #include <arch/irq.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/netconfig.h>
@@ -66,6 +67,7 @@
 #include "devif/devif.h"
 #include "inet/inet.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 #include "arp/arp.h"
 #include "icmpv6/icmpv6.h"
 
@@ -76,6 +78,24 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* Without the hash tables, the candidates for a match are simply all active
+ * connections.
+ */
+
+#ifndef CONFIG_NET_HASH_CONNS
+#  define tcp_ipv4_hash(lport, rport, raddr) 0
+#  define tcp_ipv6_hash(lport, rport, raddr) 0
+#  define tcp_port_hash(lport)               0
+#  define tcp_hash_add(conn)
+#  define tcp_hash_remove(conn)
+#  define tcp_active_first(hash) \
+     ((FAR struct tcp_conn_s *)g_active_tcp_connections.head)
+#  define tcp_active_next(conn) \
+     ((FAR struct tcp_conn_s *)(conn)->sconn.node.flink)
+#  define tcp_port_first(hash)               tcp_active_first(hash)
+#  define tcp_port_next(conn)                tcp_active_next(conn)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,10 +114,186 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_HASH_CONNS
+/* The active connections hashed on local port, remote port and remote
+ * address, and hashed on local port only.
+ */
+
+static struct net_htable_s g_tcp_conn_hash;
+static struct net_htable_s g_tcp_port_hash;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_HASH_CONNS
+/****************************************************************************
+ * Name: tcp_ipv4_hash, tcp_ipv6_hash and tcp_port_hash
+ *
+ * Description:
+ *   Hash the key of a connection: the local and remote port numbers and
+ *   remote address, or just the local port number.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static uint32_t tcp_ipv4_hash(uint16_t lport, uint16_t rport,
+                              in_addr_t raddr)
+{
+  uint32_t hash = net_hash_mix(0, ((uint32_t)lport << 16) | rport);
+
+  return net_hash_mix(hash, raddr);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static uint32_t tcp_ipv6_hash(uint16_t lport, uint16_t rport,
+                              FAR const uint16_t *raddr)
+{
+  uint32_t hash = net_hash_mix(0, ((uint32_t)lport << 16) | rport);
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      hash = net_hash_mix(hash, ((uint32_t)raddr[i] << 16) | raddr[i + 1]);
+    }
+
+  return hash;
+}
+#endif
+
+#define tcp_port_hash(lport) net_hash_mix(0, lport)
+
+/****************************************************************************
+ * Name: tcp_hash_add
+ *
+ * Description:
+ *   Add a connection that is put into the active list to the hash tables.
+ *
+ ****************************************************************************/
+
+static void tcp_hash_add(FAR struct tcp_conn_s *conn)
+{
+  uint32_t hash;
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      hash = tcp_ipv4_hash(conn->lport, conn->rport, conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      hash = tcp_ipv6_hash(conn->lport, conn->rport, conn->u.ipv6.raddr);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+  net_hash_insert(&g_tcp_conn_hash, &conn->hnode, hash);
+  net_hash_insert(&g_tcp_port_hash, &conn->pnode,
+                  tcp_port_hash(conn->lport));
+}
+
+/****************************************************************************
+ * Name: tcp_hash_remove
+ *
+ * Description:
+ *   Remove a connection that is taken from the active list from the hash
+ *   tables.
+ *
+ ****************************************************************************/
+
+static void tcp_hash_remove(FAR struct tcp_conn_s *conn)
+{
+  net_hash_remove(&g_tcp_conn_hash, &conn->hnode);
+  net_hash_remove(&g_tcp_port_hash, &conn->pnode);
+}
+
+/****************************************************************************
+ * Name: tcp_hash_match
+ *
+ * Description:
+ *   Skip the nodes of the hash bucket that have a different hash value.
+ *
+ ****************************************************************************/
+
+static FAR struct net_hnode_s *tcp_hash_match(FAR struct net_htable_s *ht,
+                                              FAR struct net_hnode_s *node,
+                                              uint32_t hash)
+{
+  while (node != NULL && node->hash != hash)
+    {
+      node = net_hash_next(ht, node, hash);
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: tcp_active_first and tcp_active_next
+ *
+ * Description:
+ *   Iterate over the active connections with the hash value of the
+ *   addresses and ports of an incoming segment.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_conn_s *tcp_active_first(uint32_t hash)
+{
+  FAR struct net_hnode_s *node;
+
+  node = tcp_hash_match(&g_tcp_conn_hash,
+                        net_hash_first(&g_tcp_conn_hash, hash), hash);
+  return node ? container_of(node, struct tcp_conn_s, hnode) : NULL;
+}
+
+static FAR struct tcp_conn_s *tcp_active_next(FAR struct tcp_conn_s *conn)
+{
+  FAR struct net_hnode_s *node;
+  uint32_t hash = conn->hnode.hash;
+
+  node = tcp_hash_match(&g_tcp_conn_hash,
+                        net_hash_next(&g_tcp_conn_hash, &conn->hnode, hash),
+                        hash);
+  return node ? container_of(node, struct tcp_conn_s, hnode) : NULL;
+}
+
+/****************************************************************************
+ * Name: tcp_port_first and tcp_port_next
+ *
+ * Description:
+ *   Iterate over the active connections with the hash value of a local
+ *   port.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_conn_s *tcp_port_first(uint32_t hash)
+{
+  FAR struct net_hnode_s *node;
+
+  node = tcp_hash_match(&g_tcp_port_hash,
+                        net_hash_first(&g_tcp_port_hash, hash), hash);
+  return node ? container_of(node, struct tcp_conn_s, pnode) : NULL;
+}
+
+static FAR struct tcp_conn_s *tcp_port_next(FAR struct tcp_conn_s *conn)
+{
+  FAR struct net_hnode_s *node;
+  uint32_t hash = conn->pnode.hash;
+
+  node = tcp_hash_match(&g_tcp_port_hash,
+                        net_hash_next(&g_tcp_port_hash, &conn->pnode, hash),
+                        hash);
+  return node ? container_of(node, struct tcp_conn_s, pnode) : NULL;
+}
+#endif /* CONFIG_NET_HASH_CONNS */
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -114,11 +310,13 @@ static FAR struct tcp_conn_s *
   tcp_listener(uint8_t domain, FAR const union ip_addr_u *ipaddr,
                uint16_t portno)
 {
-  FAR struct tcp_conn_s *conn = NULL;
+  FAR struct tcp_conn_s *conn;
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
-  while ((conn = tcp_nextconn(conn)) != NULL)
+  for (conn = tcp_port_first(tcp_port_hash(portno));
+       conn != NULL;
+       conn = tcp_port_next(conn))
     {
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -293,9 +491,10 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
+  conn       = tcp_active_first(tcp_ipv4_hash(tcp->destport, tcp->srcport,
+                                              srcipaddr));
 
   while (conn)
     {
@@ -332,7 +531,7 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = tcp_active_next(conn);
     }
 
   return conn;
@@ -360,9 +559,10 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
+  conn       = tcp_active_first(tcp_ipv6_hash(tcp->destport, tcp->srcport,
+                                              ip->srcipaddr));
 
   while (conn)
     {
@@ -399,7 +599,7 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = tcp_active_next(conn);
     }
 
   return conn;
@@ -739,6 +939,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 
       nxsem_init(&conn->snd_sem, 0, 0);
       nxsem_set_protocol(&conn->snd_sem, SEM_PRIO_NONE);
+#endif
+#ifdef CONFIG_NET_TCP_CONN_LOCK
+      nxmutex_init(&conn->snd_lock);
 #endif
     }
 
@@ -791,6 +994,7 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_hash_remove(conn);
     }
 
   /* Release any read-ahead buffers attached to the connection */
@@ -1060,6 +1264,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        */
 
       dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_hash_add(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1333,6 +1538,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   /* And, finally, put the connection structure into the active list. */
 
   dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_hash_add(conn);
   ret = OK;
 
 errout_with_lock:
@@ -26,6 +26,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -82,9 +83,10 @@
 int tcp_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC) || \
+    defined(CONFIG_NET_TCP_NAGLE)
+  /* Keep alive, congestion control and segment coalescing options are the
+   * only TCP protocol socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -109,6 +111,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
 
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -137,6 +140,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret                = OK;
           }
         break;
+#endif
 
       case TCP_NODELAY:  /* Avoid coalescing of small segments. */
         if (*value_len < sizeof(int))
@@ -147,14 +151,19 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
           {
             FAR int *nodelay   = (FAR int *)value;
 
+#ifdef CONFIG_NET_TCP_NAGLE
+            *nodelay           = conn->nodelay;
+#else
             /* Always true here since we do not support Nagle. */
 
             *nodelay           = 1;
+#endif
             *value_len         = sizeof(int);
             ret                = OK;
           }
         break;
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
       case TCP_KEEPINTVL: /* Interval between keepalives */
         {
@@ -222,6 +231,87 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        {
+          FAR const char *name = tcp_cc_name(conn);
+          socklen_t len = strlen(name) + 1;
+
+          if (*value_len < len)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              strlcpy(value, name, len);
+              *value_len = len;
+              ret        = OK;
+            }
+        }
+        break;
+#endif
+
+#ifdef CONFIG_NET_TCP_NAGLE
+      case TCP_CORK:     /* Only send full segments */
+        if (*value_len < sizeof(int))
+          {
+            ret                = -EINVAL;
+          }
+        else
+          {
+            FAR int *cork      = (FAR int *)value;
+            *cork              = conn->cork;
+            *value_len         = sizeof(int);
+            ret                = OK;
+          }
+        break;
+#endif
+
+      case TCP_INFO:     /* Connection information */
+        if (*value_len < sizeof(struct tcp_info))
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            FAR struct tcp_info *info = (FAR struct tcp_info *)value;
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+            FAR sq_entry_t *entry;
+#endif
+
+            memset(info, 0, sizeof(*info));
+
+            net_lock();
+            info->tcpi_state      = conn->tcpstateflags & TCP_STATE_MASK;
+            info->tcpi_rto        = conn->rto * (USEC_PER_SEC / 2);
+            info->tcpi_snd_mss    = conn->mss;
+            info->tcpi_unacked    = conn->tx_unacked;
+#ifdef CONFIG_NET_TCP_CC
+            info->tcpi_snd_cwnd   = conn->cwnd;
+#endif
+            info->tcpi_segs_out   = conn->segs_out;
+            info->tcpi_bytes_sent = conn->bytes_sent;
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+            for (entry = sq_peek(&conn->write_q); entry != NULL;
+                 entry = sq_next(entry))
+              {
+                FAR struct tcp_wrbuffer_s *wrb =
+                  (FAR struct tcp_wrbuffer_s *)entry;
+
+                info->tcpi_notsent_bytes += TCP_WBPKTLEN(wrb) -
+                                            TCP_WBSENT(wrb);
+              }
+#endif
+
+            net_unlock();
+
+            *value_len = sizeof(struct tcp_info);
+            ret        = OK;
+          }
+        break;
+
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
         ret = -ENOPROTOOPT;
@@ -231,7 +321,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC || ... */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
@@ -0,0 +1,446 @@
+/****************************************************************************
+ * net/tcp/tcp_gro.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "devif/devif.h"
+#include "utils/utils.h"
+#include "tcp/tcp.h"
+
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_GRO)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TCPBUF(dev,buf,iplen) \
+  ((FAR struct tcp_hdr_s *)&(buf)[NET_LL_HDRLEN(dev) + (iplen)])
+
+/* The length of the link layer, IP and TCP headers of a segment */
+
+#define TCP_GRO_HDRLEN(dev,tcp,iplen) \
+  (NET_LL_HDRLEN(dev) + (iplen) + (((tcp)->tcpoffset >> 4) << 2))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_gro_sameflow
+ *
+ * Description:
+ *   Return true if the segment in d_buf belongs to the same connection as
+ *   the segment held by the device.
+ *
+ ****************************************************************************/
+
+static bool tcp_gro_sameflow(FAR struct net_driver_s *dev,
+                             unsigned int iplen)
+{
+  FAR const uint8_t *held = IOB_DATA(dev->d_groiob);
+  unsigned int llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int addroff;
+  unsigned int addrlen;
+
+  if (iplen != dev->d_groiplen ||
+      dev->d_buf[llhdrlen] >> 4 != held[llhdrlen] >> 4)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (dev->d_buf[llhdrlen] >> 4 == 4)
+#endif
+    {
+      addroff = offsetof(struct ipv4_hdr_s, srcipaddr);
+      addrlen = 4 * sizeof(uint16_t);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      addroff = offsetof(struct ipv6_hdr_s, srcipaddr);
+      addrlen = 2 * sizeof(net_ipv6addr_t);
+    }
+#endif
+
+  /* Compare the source and destination addresses and the ports */
+
+  return memcmp(&dev->d_buf[llhdrlen + addroff], &held[llhdrlen + addroff],
+                addrlen) == 0 &&
+         memcmp(&dev->d_buf[llhdrlen + iplen], &held[llhdrlen + iplen],
+                2 * sizeof(uint16_t)) == 0;
+}
+
+/****************************************************************************
+ * Name: tcp_gro_mergeable
+ *
+ * Description:
+ *   Return true if a segment carrying len bytes of data can be merged with
+ *   the segments before it.  It must be a plain data segment of an
+ *   established connection that starts offset bytes after rcvseq.  push
+ *   selects whether the PSH flag is allowed; PSH ends the merging.
+ *
+ ****************************************************************************/
+
+static bool tcp_gro_mergeable(FAR struct tcp_conn_s *conn,
+                              FAR struct tcp_hdr_s *tcp, uint16_t len,
+                              uint32_t offset, bool push)
+{
+  uint8_t ctl = push ? TCP_CTL & ~TCP_PSH : TCP_CTL;
+
+  return conn != NULL && len > 0 &&
+         (conn->tcpstateflags & (TCP_STATE_MASK | TCP_STOPPED)) ==
+         TCP_ESTABLISHED &&
+         (tcp->flags & ctl) == TCP_ACK &&
+         tcp_getsequence(tcp->seqno) ==
+         tcp_getsequence(conn->rcvseq) + offset;
+}
+
+/****************************************************************************
+ * Name: tcp_gro_process
+ *
+ * Description:
+ *   Pass the held segment and the data merged into it to TCP.  The I/O
+ *   buffer of the device is freed; any response is left in d_buf.
+ *
+ ****************************************************************************/
+
+static void tcp_gro_process(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob;
+
+  iob = netdev_iob_replace(dev, dev->d_groiob);
+  if (iob != NULL)
+    {
+      iob_free_chain(iob, IOBUSER_NET_NETDEV);
+    }
+
+  dev->d_groiob   = NULL;
+  dev->d_len      = dev->d_grolen;
+  dev->d_groinput = true;
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (dev->d_buf[NET_LL_HDRLEN(dev)] >> 4 == 4)
+#endif
+    {
+      IFF_SET_IPv4(dev->d_flags);
+      tcp_ipv4_input(dev);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      IFF_SET_IPv6(dev->d_flags);
+      tcp_ipv6_input(dev, dev->d_groiplen);
+    }
+#endif
+
+  dev->d_groinput = false;
+
+  /* The merged data is left over if TCP did not accept the segment */
+
+  if (dev->d_grodata != NULL)
+    {
+      iob_free_chain(dev->d_grodata, IOBUSER_NET_NETDEV);
+      dev->d_grodata = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_gro_hold
+ *
+ * Description:
+ *   Hold the segment in d_buf back so that the following segments may be
+ *   merged into it.
+ *
+ ****************************************************************************/
+
+static void tcp_gro_hold(FAR struct net_driver_s *dev, unsigned int iplen)
+{
+  dev->d_grolen   = dev->d_len;
+  dev->d_groiplen = iplen;
+  dev->d_groiob   = netdev_iob_replace(dev, NULL);
+  dev->d_len      = 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_gro_receive
+ *
+ * Description:
+ *   Try to merge the incoming TCP segment in d_buf with the segments
+ *   before it.
+ *
+ ****************************************************************************/
+
+bool tcp_gro_receive(FAR struct net_driver_s *dev, unsigned int iplen)
+{
+  FAR struct tcp_conn_s *conn;
+  FAR struct tcp_hdr_s *tcp;
+  FAR struct tcp_hdr_s *held;
+  FAR struct iob_s *iob;
+  unsigned int hdrlen;
+  uint32_t total;
+  uint16_t heldlen;
+  uint16_t len;
+
+  if (!NETDEV_HAS_FEATURE(dev, NETDEV_F_GRO) || dev->d_iob == NULL)
+    {
+      return false;
+    }
+
+  tcp    = TCPBUF(dev, dev->d_buf, iplen);
+  hdrlen = TCP_GRO_HDRLEN(dev, tcp, iplen);
+  if (hdrlen > NET_LL_HDRLEN(dev) + dev->d_len)
+    {
+      return false;
+    }
+
+  len = NET_LL_HDRLEN(dev) + dev->d_len - hdrlen;
+
+  /* Only one connection is held per device; segments of the others are
+   * passed on right away.
+   */
+
+  if (dev->d_groiob != NULL && !tcp_gro_sameflow(dev, iplen))
+    {
+      return false;
+    }
+
+  conn = tcp_active(dev, tcp);
+  if (dev->d_groiob == NULL &&
+      !tcp_gro_mergeable(conn, tcp, len, 0, false))
+    {
+      return false;
+    }
+
+  /* TCP does not check the held segment again, so bad segments must not
+   * get this far.
+   */
+
+  if (!NETDEV_HAS_FEATURE(dev, NETDEV_F_RXCSUM) &&
+      tcp_chksum(dev) != 0xffff)
+    {
+      return false;
+    }
+
+  if (dev->d_groiob == NULL)
+    {
+      tcp_gro_hold(dev, iplen);
+      return true;
+    }
+
+  held    = TCPBUF(dev, IOB_DATA(dev->d_groiob), iplen);
+  heldlen = NET_LL_HDRLEN(dev) + dev->d_grolen -
+            TCP_GRO_HDRLEN(dev, held, iplen);
+  total   = heldlen;
+  if (dev->d_grodata != NULL)
+    {
+      total += dev->d_grodata->io_pktlen;
+    }
+
+  /* Queue the data of the segment behind the held one if it continues the
+   * held segment.  The I/O buffer is taken over unless the segment is so
+   * small that copying is cheaper; such segments are not merged.
+   */
+
+  if (tcp_gro_mergeable(conn, held, heldlen, 0, false) &&
+      tcp_gro_mergeable(conn, tcp, len, total, true) &&
+      total + len <= CONFIG_NET_TCP_GRO_MAXSIZE)
+    {
+      dev->d_appdata = &dev->d_buf[hdrlen];
+      iob = netdev_iob_take(dev, dev->d_appdata, len);
+      if (iob != NULL)
+        {
+          if (dev->d_grodata == NULL)
+            {
+              dev->d_grodata = iob;
+            }
+          else
+            {
+              iob_concat(dev->d_grodata, iob);
+            }
+
+          /* The held segment now acknowledges what this one does */
+
+          memcpy(held->ackno, tcp->ackno, 4);
+          memcpy(held->wnd, tcp->wnd, 2);
+          held->flags |= tcp->flags & TCP_PSH;
+          dev->d_len   = 0;
+
+          /* Pass the merged segment on if the sender pushed it or if the
+           * next segment would not fit.
+           */
+
+          total += len;
+          if ((tcp->flags & TCP_PSH) != 0 ||
+              total + len > CONFIG_NET_TCP_GRO_MAXSIZE)
+            {
+              tcp_gro_process(dev);
+            }
+
+          return true;
+        }
+    }
+
+  /* The held segment must be processed before this one.  Do that now,
+   * leaving its response in d_buf, and hold this segment instead.
+   */
+
+  len = dev->d_len;
+  iob = netdev_iob_replace(dev, NULL);
+
+  tcp_gro_process(dev);
+
+  dev->d_groiob   = iob;
+  dev->d_grolen   = len;
+  dev->d_groiplen = iplen;
+  return true;
+}
+
+/****************************************************************************
+ * Name: tcp_gro_input
+ *
+ * Description:
+ *   Queue the data of the held segment and the data merged into it in the
+ *   read-ahead buffer of the connection.
+ *
+ ****************************************************************************/
+
+void tcp_gro_input(FAR struct net_driver_s *dev,
+                   FAR struct tcp_conn_s *conn)
+{
+  FAR struct iob_s *iob = dev->d_grodata;
+  uint32_t len;
+
+  DEBUGASSERT(iob != NULL);
+
+  dev->d_grodata = NULL;
+  len            = iob->io_pktlen;
+
+  if (dev->d_len > 0 &&
+      tcp_datahandler(dev, conn, dev->d_appdata, dev->d_len) <
+      dev->d_len)
+    {
+      /* Drop all of it and let the peer send it again */
+
+      iob_free_chain(iob, IOBUSER_NET_NETDEV);
+      dev->d_len = 0;
+
+#ifdef CONFIG_NET_STATISTICS
+      g_netstats.tcp.drop++;
+#endif
+      return;
+    }
+
+  if (conn->readahead != NULL)
+    {
+      iob_concat(conn->readahead, iob);
+    }
+  else
+    {
+      conn->readahead = iob;
+    }
+
+  net_incr32(conn->rcvseq, dev->d_len + len);
+  dev->d_len = 0;
+
+#ifdef CONFIG_NET_TCP_NOTIFIER
+  tcp_readahead_signal(conn);
+#endif
+
+  ninfo("Queued %" PRIu32 " bytes of merged segments\n", len);
+}
+
+/****************************************************************************
+ * Name: tcp_gro_release
+ *
+ * Description:
+ *   Drop the segment held by the device, if any.
+ *
+ ****************************************************************************/
+
+void tcp_gro_release(FAR struct net_driver_s *dev)
+{
+  if (dev->d_groiob != NULL)
+    {
+      iob_free_chain(dev->d_groiob, IOBUSER_NET_NETDEV);
+      dev->d_groiob = NULL;
+    }
+
+  if (dev->d_grodata != NULL)
+    {
+      iob_free_chain(dev->d_grodata, IOBUSER_NET_NETDEV);
+      dev->d_grodata = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_gro_flush
+ *
+ * Description:
+ *   Pass the TCP segment held back by the device to TCP.
+ *
+ ****************************************************************************/
+
+void netdev_gro_flush(FAR struct net_driver_s *dev)
+{
+  if (dev->d_groiob != NULL)
+    {
+      tcp_gro_process(dev);
+    }
+  else
+    {
+      dev->d_len = 0;
+    }
+}
+
+#endif /* NET_TCP_HAVE_STACK && CONFIG_NET_TCP_GRO */
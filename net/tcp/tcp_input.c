@@ -324,9 +324,15 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   /* Start of TCP input header processing code. */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!NETDEV_HAS_FEATURE(dev, NETDEV_F_RXCSUM) &&
+#ifdef CONFIG_NET_TCP_GRO
+      !dev->d_groinput &&
+#endif
+      tcp_chksum(dev) != 0xffff)
     {
-      /* Compute and check the TCP checksum. */
+      /* Compute and check the TCP checksum.  Segments held back for GRO
+       * have been checked already.
+       */
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.tcp.drop++;
@@ -397,60 +403,15 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
       if (tcp_islistener(&uaddr, tmp16))
 #endif
         {
-          /* We matched the incoming packet with a connection in LISTEN.
-           * We now need to create a new connection and send a SYNACK in
-           * response.
-           */
+          uint16_t synmss   = 0;
+          uint8_t  synflags = 0;
+          uint8_t  synscale = 0;
 
-          /* First allocate a new connection structure and see if there is
-           * any user application to accept it.
+          /* We matched the incoming packet with a connection in LISTEN.
+           * Parse the TCP options of the SYN first: they are needed
+           * whether or not a connection structure is allocated now.
            */
 
-          conn = tcp_alloc_accept(dev, tcp);
-          if (conn)
-            {
-              /* The connection structure was successfully allocated and has
-               * been initialized in the TCP_SYN_RECVD state.  The expected
-               * sequence of events is then the rest of the 3-way handshake:
-               *
-               *  1. We just received a TCP SYN packet from a remote host.
-               *  2. We will send the SYN-ACK response below (perhaps
-               *     repeatedly in the event of a timeout)
-               *  3. Then we expect to receive an ACK from the remote host
-               *     indicated the TCP socket connection is ESTABLISHED.
-               *
-               * Possible failure:
-               *
-               *  1. The ACK is never received.  This will be handled by
-               *     a timeout managed by tcp_timer().
-               *  2. The listener "unlistens()".  This will be handled by
-               *     the failure of tcp_accept_connection() when the ACK is
-               *     received.
-               */
-
-              conn->crefs = 1;
-            }
-
-          if (!conn)
-            {
-              /* Either (1) all available connections are in use, or (2)
-               * there is no application in place to accept the connection.
-               * We drop packet and hope that the remote end will retransmit
-               * the packet at a time when we have more spare connections
-               * or someone waiting to accept the connection.
-               */
-
-#ifdef CONFIG_NET_STATISTICS
-              g_netstats.tcp.syndrop++;
-#endif
-              nerr("ERROR: No free TCP connections\n");
-              goto drop;
-            }
-
-          net_incr32(conn->rcvseq, 1); /* ack SYN */
-
-          /* Parse the TCP MSS option, if present. */
-
           if ((tcp->tcpoffset & 0xf0) > 0x50)
             {
               for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
@@ -478,15 +439,22 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
                       tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
                                (uint16_t)dev->d_buf[hdrlen + 3 + i];
-                      conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
+                      synmss = tmp16 > tcp_mss ? tcp_mss : tmp16;
                     }
 #ifdef CONFIG_NET_TCP_WINDOW_SCALE
                   else if (opt == TCP_OPT_WS &&
                           dev->d_buf[hdrlen + 1 + i] == TCP_OPT_WS_LEN)
                     {
-                      conn->snd_scale = dev->d_buf[hdrlen + 2 + i];
-                      conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
-                      conn->flags    |= TCP_WSCALE;
+                      synscale  = dev->d_buf[hdrlen + 2 + i];
+                      synflags |= TCP_WSCALE;
+                    }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+                  else if (opt == TCP_OPT_SACK_PERM &&
+                          dev->d_buf[hdrlen + 1 + i] ==
+                          TCP_OPT_SACK_PERM_LEN)
+                    {
+                      synflags |= TCP_SACK;
                     }
 #endif
                   else
@@ -509,12 +477,112 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                 }
             }
 
+#ifdef CONFIG_NET_TCP_SYNQUEUE
+          /* Keep only the minimal handshake state for now.  The
+           * connection structure is allocated by tcp_synq_ack() when the
+           * handshake completes.
+           */
+
+          if (tcp_synq_syn(dev, tcp, synmss, synflags, synscale) < 0)
+            {
+#ifdef CONFIG_NET_STATISTICS
+              g_netstats.tcp.syndrop++;
+#endif
+              goto drop;
+            }
+
+          return;
+#else
+          /* We now need to create a new connection and send a SYNACK in
+           * response.  First allocate a new connection structure and see
+           * if there is any user application to accept it.
+           */
+
+          conn = tcp_alloc_accept(dev, tcp);
+          if (conn)
+            {
+              /* The connection structure was successfully allocated and has
+               * been initialized in the TCP_SYN_RECVD state.  The expected
+               * sequence of events is then the rest of the 3-way handshake:
+               *
+               *  1. We just received a TCP SYN packet from a remote host.
+               *  2. We will send the SYN-ACK response below (perhaps
+               *     repeatedly in the event of a timeout)
+               *  3. Then we expect to receive an ACK from the remote host
+               *     indicated the TCP socket connection is ESTABLISHED.
+               *
+               * Possible failure:
+               *
+               *  1. The ACK is never received.  This will be handled by
+               *     a timeout managed by tcp_timer().
+               *  2. The listener "unlistens()".  This will be handled by
+               *     the failure of tcp_accept_connection() when the ACK is
+               *     received.
+               */
+
+              conn->crefs = 1;
+            }
+
+          if (!conn)
+            {
+              /* Either (1) all available connections are in use, or (2)
+               * there is no application in place to accept the connection.
+               * We drop packet and hope that the remote end will retransmit
+               * the packet at a time when we have more spare connections
+               * or someone waiting to accept the connection.
+               */
+
+#ifdef CONFIG_NET_STATISTICS
+              g_netstats.tcp.syndrop++;
+#endif
+              nerr("ERROR: No free TCP connections\n");
+              goto drop;
+            }
+
+          net_incr32(conn->rcvseq, 1); /* ack SYN */
+
+          /* Apply the TCP options of the SYN */
+
+          if (synmss != 0)
+            {
+              conn->mss = synmss;
+            }
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+          if ((synflags & TCP_WSCALE) != 0)
+            {
+              conn->snd_scale = synscale;
+              conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
+            }
+#else
+          UNUSED(synscale);
+#endif
+
+          conn->flags |= synflags;
+
           /* Our response will be a SYNACK. */
 
           tcp_synack(dev, conn, TCP_ACK | TCP_SYN);
           return;
+#endif /* CONFIG_NET_TCP_SYNQUEUE */
         }
     }
+#ifdef CONFIG_NET_TCP_SYNQUEUE
+  else if ((tcp->flags & (TCP_SYN | TCP_RST | TCP_ACK)) == TCP_ACK)
+    {
+      /* This may be the final ACK of a handshake in the SYN queue (or
+       * one answered with a SYN cookie).  If so, the connection has
+       * just been allocated in the TCP_SYN_RCVD state and the ACK is
+       * processed like for any other connection.
+       */
+
+      conn = tcp_synq_ack(dev, tcp);
+      if (conn != NULL)
+        {
+          goto found;
+        }
+    }
+#endif
 
   nwarn("WARNING: SYN with no listener (or old packet) .. reset\n");
 
@@ -720,6 +788,15 @@ found:
 
       if (TCP_SEQ_LTE(ackseq, unackseq))
         {
+#ifdef CONFIG_NET_TCP_CC
+          /* Let the congestion window grow by the newly acked bytes */
+
+          if (conn->tx_unacked > unackseq - ackseq)
+            {
+              tcp_cc_ack(conn, conn->tx_unacked - (unackseq - ackseq));
+            }
+#endif
+
           /* Calculate the new number of outstanding, unacknowledged bytes */
 
           conn->tx_unacked = unackseq - ackseq;
@@ -829,6 +906,7 @@ found:
              */
 
             conn->tcpstateflags = TCP_ESTABLISHED;
+            tcp_cc_init(conn);
 
             /* Wake up any listener waiting for a connection on this port */
 
@@ -942,6 +1020,14 @@ found:
                         conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
                         conn->flags    |= TCP_WSCALE;
                       }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+                    else if (opt == TCP_OPT_SACK_PERM &&
+                            dev->d_buf[hdrlen + 1 + i] ==
+                            TCP_OPT_SACK_PERM_LEN)
+                      {
+                        conn->flags    |= TCP_SACK;
+                      }
 #endif
                     else
                       {
@@ -964,6 +1050,7 @@ found:
               }
 
             conn->tcpstateflags = TCP_ESTABLISHED;
+            tcp_cc_init(conn);
             memcpy(conn->rcvseq, tcp->seqno, 4);
             conn->rcv_adv = tcp_getsequence(conn->rcvseq);
             tcp_snd_wnd_init(conn, tcp);
@@ -1156,6 +1243,20 @@ found:
          * packets from the remote host.
          */
 
+#ifdef CONFIG_NET_TCP_GRO
+        /* The data of a merged segment goes to the read-ahead buffer.
+         * TCP_NEWDATA with no data then makes the receiver take it from
+         * there and causes the ACK.
+         */
+
+        if (dev->d_grodata != NULL && dev->d_groinput &&
+            (conn->tcpstateflags & TCP_STOPPED) == 0)
+          {
+            tcp_gro_input(dev, conn);
+            flags |= TCP_NEWDATA;
+          }
+#endif
+
         if (dev->d_len > 0 && (conn->tcpstateflags & TCP_STOPPED) == 0)
           {
             flags |= TCP_NEWDATA;
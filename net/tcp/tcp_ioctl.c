@@ -65,7 +65,15 @@ int tcp_ioctl(FAR struct tcp_conn_s *conn,
   switch (cmd)
     {
       case FIONREAD:
-        if (conn->readahead != NULL)
+        if (tcp_backlogavailable(conn))
+          {
+            /* On a listener, report the number of connections that
+             * accept() can return without blocking.
+             */
+
+            *(FAR int *)((uintptr_t)arg) = tcp_backlogpending(conn);
+          }
+        else if (conn->readahead != NULL)
           {
             *(FAR int *)((uintptr_t)arg) = conn->readahead->io_pktlen;
           }
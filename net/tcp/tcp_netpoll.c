@@ -32,6 +32,7 @@
 #include <nuttx/net/net.h>
 #include <nuttx/net/tcp.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 
 #include "devif/devif.h"
 #include "netdev/netdev.h"
@@ -169,7 +170,7 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
           info->cb->event   = NULL;
 
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(&info->fds, 1, 0);
         }
     }
 
@@ -356,7 +357,7 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, 0);
     }
 
 errout_with_lock:
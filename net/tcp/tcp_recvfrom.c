@@ -186,7 +186,7 @@ static inline uint16_t tcp_newdata(FAR struct net_driver_s *dev,
       uint16_t buflen = dev->d_len - recvlen;
       uint16_t nsaved;
 
-      nsaved = tcp_datahandler(conn, buffer, buflen);
+      nsaved = tcp_datahandler(dev, conn, buffer, buflen);
       if (nsaved < buflen)
         {
           nwarn("WARNING: packet data not fully saved "
@@ -411,6 +411,14 @@ static uint16_t tcp_recvhandler(FAR struct net_driver_s *dev,
 
           flags = tcp_newdata(dev, pstate, flags);
 
+#ifdef CONFIG_NET_TCP_GRO
+          /* The data of segments merged by GRO is passed in the read-ahead
+           * buffer.
+           */
+
+          tcp_readahead(pstate);
+#endif
+
           /* Save the sender's address in the caller's 'from' location */
 
           tcp_sender(dev, pstate);
@@ -35,6 +35,7 @@
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/tcp.h>
 
+#include "utils/utils.h"
 #include "tcp/tcp.h"
 
 /****************************************************************************
@@ -63,7 +64,7 @@ static uint32_t tcp_calc_rcvsize(FAR struct tcp_conn_s *conn,
   uint32_t recvsize;
   uint32_t desire;
 
-  recvsize = conn->readahead ? conn->readahead->io_pktlen : 0;
+  recvsize = conn->readahead ? NET_IOB_CHARGE(conn->readahead) : 0;
   if (conn->rcv_bufs > recvsize)
     {
       desire = conn->rcv_bufs - recvsize;
@@ -102,8 +103,8 @@ static uint32_t tcp_maxrcvwin(FAR struct tcp_conn_s *conn)
    * This needs to be in sync with tcp_get_recvwindow().
    */
 
-  recvwndo = tcp_calc_rcvsize(conn, (CONFIG_IOB_NBUFFERS -
-                                     CONFIG_IOB_THROTTLE) *
+  recvwndo = tcp_calc_rcvsize(conn, NET_IOB_SHARE(CONFIG_IOB_NBUFFERS -
+                                                  CONFIG_IOB_THROTTLE) *
                                      CONFIG_IOB_BUFSIZE);
 #ifdef CONFIG_NET_TCP_WINDOW_SCALE
   recvwndo >>= conn->rcv_scale;
@@ -163,7 +164,7 @@ uint32_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
       tailroom = 0;
     }
 
-  niob_avail = iob_navail(true);
+  niob_avail = NET_IOB_SHARE(iob_navail(true));
 
   /* Is there a a queue entry and IOBs available for read-ahead buffering? */
 
@@ -181,7 +182,8 @@ uint32_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
        * sockets (and perhaps multiple network devices) or if there are
        * other consumers of IOBs (such as for TCP write buffering) then the
        * total number of IOBs will all not be available for read-ahead
-       * buffering for this connection.
+       * buffering for this connection.  CONFIG_NET_IOB_QUOTA offers only a
+       * share of them, so that one connection never takes them all.
        */
 
       recvwndo = tailroom + (niob_avail * CONFIG_IOB_BUFSIZE);
@@ -290,6 +290,352 @@ static inline void send_ipselect(FAR struct net_driver_s *dev,
 }
 #endif
 
+#ifdef CONFIG_NET_TCP_SACK
+/****************************************************************************
+ * Name: psock_sack_update
+ *
+ * Description:
+ *   Mark the write buffers in the unacked_q that are entirely covered by
+ *   the SACK blocks of an incoming ACK.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of the socket
+ *   tcp  - The TCP header of the incoming ACK
+ *
+ * Returned Value:
+ *   True if a write buffer was newly marked as SACKed.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+static bool psock_sack_update(FAR struct tcp_conn_s *conn,
+                              FAR struct tcp_hdr_s *tcp)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  FAR uint8_t *opt = tcp->optdata;
+  unsigned int optlen;
+  unsigned int i;
+  unsigned int j;
+  uint32_t left;
+  uint32_t right;
+  bool update = false;
+
+  if ((conn->flags & TCP_SACK) == 0 || (tcp->tcpoffset & 0xf0) <= 0x50)
+    {
+      return false;
+    }
+
+  optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
+  for (i = 0; i < optlen; )
+    {
+      if (opt[i] == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (opt[i] == TCP_OPT_NOOP)
+        {
+          i++;
+          continue;
+        }
+
+      /* Stop at a malformed option */
+
+      if (i + 1 >= optlen || opt[i + 1] < 2 || i + opt[i + 1] > optlen)
+        {
+          break;
+        }
+
+      if (opt[i] == TCP_OPT_SACK)
+        {
+          for (j = i + 2; j + TCP_OPT_SACK_BLOCK <= i + opt[i + 1];
+               j += TCP_OPT_SACK_BLOCK)
+            {
+              left  = tcp_getsequence(&opt[j]);
+              right = tcp_getsequence(&opt[j + 4]);
+
+              for (entry = sq_peek(&conn->unacked_q); entry;
+                   entry = sq_next(entry))
+                {
+                  wrb = (FAR struct tcp_wrbuffer_s *)entry;
+                  if ((TCP_WBFLAGS(wrb) & TCP_WBF_SACKED) == 0 &&
+                      TCP_SEQ_GTE(TCP_WBSEQNO(wrb), left) &&
+                      TCP_SEQ_LTE(TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb),
+                                  right))
+                    {
+                      TCP_WBFLAGS(wrb) |= TCP_WBF_SACKED;
+                      update = true;
+                    }
+                }
+            }
+        }
+
+      i += opt[i + 1];
+    }
+
+  return update;
+}
+
+/****************************************************************************
+ * Name: psock_sack_reset
+ *
+ * Description:
+ *   Leave the fast recovery and forget the SACK scoreboard.  This is done
+ *   on a retransmission timeout, after which the peer may have discarded
+ *   data that it SACKed before (RFC 2018, section 8).
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of the socket
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+static void psock_sack_reset(FAR struct tcp_conn_s *conn)
+{
+  FAR sq_entry_t *entry;
+
+  conn->flags &= ~TCP_RECOVERY;
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      TCP_WBFLAGS((FAR struct tcp_wrbuffer_s *)entry) = 0;
+    }
+
+  for (entry = sq_peek(&conn->write_q); entry; entry = sq_next(entry))
+    {
+      TCP_WBFLAGS((FAR struct tcp_wrbuffer_s *)entry) = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: psock_fast_retransmit
+ *
+ * Description:
+ *   Enter or continue the fast recovery and move the write buffers that
+ *   appear to be lost from the unacked_q back to the write_q.
+ *
+ *   If the peer has SACKed some write buffers, then every write buffer
+ *   below the highest SACKed one that is not SACKed itself is considered
+ *   lost.  Otherwise only the first unacknowledged write buffer is sent
+ *   again, and the next one on a partial ACK (NewReno, RFC 6582).  No
+ *   write buffer is sent twice in one recovery.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of the socket
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+static void psock_fast_retransmit(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  FAR sq_entry_t *next;
+  uint32_t highsack = 0;
+  bool sacked = false;
+  uint16_t sent;
+
+  /* The unacked_q is in sequence number order, so the last SACKed write
+   * buffer found is the highest one.
+   */
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)entry;
+      if ((TCP_WBFLAGS(wrb) & TCP_WBF_SACKED) != 0)
+        {
+          highsack = TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb);
+          sacked   = true;
+        }
+    }
+
+  if ((conn->flags & TCP_RECOVERY) == 0)
+    {
+      conn->flags  |= TCP_RECOVERY;
+      conn->recover = conn->sndseq_max;
+    }
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = next)
+    {
+      next = sq_next(entry);
+      wrb  = (FAR struct tcp_wrbuffer_s *)entry;
+
+      if (sacked && TCP_SEQ_GTE(TCP_WBSEQNO(wrb), highsack))
+        {
+          break;
+        }
+
+      if ((TCP_WBFLAGS(wrb) & (TCP_WBF_SACKED | TCP_WBF_REXMIT)) != 0)
+        {
+          continue;
+        }
+
+      sq_rem(entry, &conn->unacked_q);
+
+      /* Reset the number of bytes sent from the write buffer */
+
+      sent = TCP_WBSENT(wrb);
+      conn->tx_unacked = conn->tx_unacked > sent ?
+                         conn->tx_unacked - sent : 0;
+      conn->sent       = conn->sent > sent ? conn->sent - sent : 0;
+      TCP_WBSENT(wrb)  = 0;
+
+      if (++TCP_WBNRTX(wrb) >= TCP_MAXRTX)
+        {
+          nwarn("WARNING: Expiring wrb=%p nrtx=%u\n",
+                wrb, TCP_WBNRTX(wrb));
+
+          tcp_wrbuffer_release(wrb);
+          psock_writebuffer_notify(conn);
+          conn->expired++;
+          continue;
+        }
+
+      ninfo("FASTREXMIT: Moving wrb=%p seqno=%" PRIu32 "\n",
+            wrb, TCP_WBSEQNO(wrb));
+
+      TCP_WBFLAGS(wrb) |= TCP_WBF_REXMIT;
+      TCP_WBNACK(wrb)   = 0;
+      psock_insert_segment(wrb, &conn->write_q);
+
+      if (!sacked)
+        {
+          break;
+        }
+    }
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/****************************************************************************
+ * Name: tcp_max_seglen
+ *
+ * Description:
+ *   Return the largest amount of data to send in one packet.  That is the
+ *   MSS, unless the device does TCP segmentation offload.  Then it is the
+ *   largest multiple of the MSS that fits into a TSO packet.
+ *
+ * Input Parameters:
+ *   dev  - The network device that will send the packet
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   The maximum payload size of the next packet
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_max_seglen(FAR struct net_driver_s *dev,
+                               FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NETDEV_OFFLOAD
+  uint32_t maxlen;
+
+  if (NETDEV_HAS_FEATURE(dev, NETDEV_F_TSO) &&
+      dev->d_tsosize > NETDEV_PKTSIZE(dev) && conn->mss > 0)
+    {
+      /* conn->mss is not larger than the MSS of the device, so the
+       * headers still fit into the extra room of a TSO packet.
+       */
+
+      maxlen  = conn->mss + (dev->d_tsosize - NETDEV_PKTSIZE(dev));
+      return maxlen - maxlen % conn->mss;
+    }
+#endif
+
+  return conn->mss;
+}
+
+/****************************************************************************
+ * Name: tcp_send_hold
+ *
+ * Description:
+ *   Decide whether the unsent data in the write queue should be held back
+ *   rather than sent as a partial segment now:
+ *
+ *   - Nagle (RFC 896): hold while any sent data is unacknowledged, unless
+ *     TCP_NODELAY is set.
+ *   - TCP_CORK or MSG_MORE: hold for up to CONFIG_NET_TCP_CORK_TIMEOUT.
+ *
+ *   Retransmissions and full segments are never held.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   maxlen - The largest segment that could be sent now
+ *
+ * Returned Value:
+ *   true if nothing should be sent now.
+ *
+ * Assumptions:
+ *   The network is locked and conn->write_q is not empty.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_NAGLE
+static bool tcp_send_hold(FAR struct tcp_conn_s *conn, uint32_t maxlen)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  uint32_t pending = 0;
+  bool hold;
+
+  wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+  if (TCP_WBNRTX(wrb) > 0)
+    {
+      conn->held = false;
+      return false;
+    }
+
+  /* Is there at least one full segment of data queued? */
+
+  for (; wrb != NULL;
+       wrb = (FAR struct tcp_wrbuffer_s *)sq_next(&wrb->wb_node))
+    {
+      pending += TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
+      if (pending >= maxlen)
+        {
+          conn->held = false;
+          return false;
+        }
+    }
+
+  if (conn->cork || conn->more)
+    {
+      if (!conn->held)
+        {
+          conn->hold_start = clock_systime_ticks();
+        }
+
+      hold = clock_systime_ticks() - conn->hold_start <
+             MSEC2TICK(CONFIG_NET_TCP_CORK_TIMEOUT);
+    }
+  else
+    {
+      hold = !conn->nodelay && conn->tx_unacked > 0;
+    }
+
+  if (hold && !conn->held)
+    {
+      ninfo("Holding %" PRIu32 " bytes on conn %p\n", pending, conn);
+    }
+
+  conn->held = hold;
+  return hold;
+}
+#endif
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -324,6 +670,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
   FAR struct tcp_conn_s *conn = pvpriv;
   bool rexmit = false;
+#ifdef CONFIG_NET_TCP_SACK
+  bool fastrexmit = false;
+#endif
 
   /* Get the TCP connection pointer reliably from
    * the corresponding TCP socket.
@@ -376,6 +725,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       FAR sq_entry_t *entry;
       FAR sq_entry_t *next;
       uint32_t ackno;
+#ifdef CONFIG_NET_TCP_SACK
+      bool sackupdate;
+      bool acked = false;
+#endif
 
       /* Get the offset address of the TCP header */
 
@@ -404,6 +757,24 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       ackno = tcp_getsequence(tcp->ackno);
       ninfo("ACK: ackno=%" PRIu32 " flags=%04x\n", ackno, flags);
 
+#ifdef CONFIG_NET_TCP_NAGLE
+      /* All data in flight is acknowledged: a segment held back by Nagle's
+       * algorithm may go now.  Ask for a poll rather than waiting for the
+       * next periodic one.
+       */
+
+      if (conn->held && conn->tx_unacked == 0)
+        {
+          netdev_txnotify_dev(dev);
+        }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+      /* Update the scoreboard from the SACK blocks of the ACK */
+
+      sackupdate = psock_sack_update(conn, tcp);
+#endif
+
       /* Look at every write buffer in the unacked_q.  The unacked_q
        * holds write buffers that have been entirely sent, but which
        * have not yet been ACKed.
@@ -425,6 +796,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
           if (TCP_SEQ_GT(ackno, TCP_WBSEQNO(wrb)))
             {
+#ifdef CONFIG_NET_TCP_SACK
+              acked = true;
+#endif
+
               /* Get the sequence number at the end of the data */
 
               lastseq = TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb);
@@ -501,7 +876,20 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                 {
                   /* Do fast retransmit */
 
+#ifdef CONFIG_NET_TCP_SACK
+                  /* Only the holes are sent again, and only once in each
+                   * fast recovery.
+                   */
+
+                  if ((conn->flags & TCP_RECOVERY) == 0)
+                    {
+                      tcp_cc_loss(conn);
+                      fastrexmit = true;
+                    }
+#else
+                  tcp_cc_loss(conn);
                   rexmit = true;
+#endif
                 }
               else if ((TCP_WBNACK(wrb) > TCP_FAST_RETRANSMISSION_THRESH) &&
                        TCP_WBNACK(wrb) == sq_count(&conn->unacked_q) - 1)
@@ -514,6 +902,25 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 #endif
         }
 
+#ifdef CONFIG_NET_TCP_SACK
+      if ((conn->flags & TCP_RECOVERY) != 0)
+        {
+          if (TCP_SEQ_GTE(ackno, conn->recover))
+            {
+              /* Everything sent before the recovery began has been ACKed */
+
+              ninfo("ACK: leave fast recovery at %" PRIu32 "\n", ackno);
+              conn->flags &= ~TCP_RECOVERY;
+            }
+          else if (acked || sackupdate)
+            {
+              /* A partial ACK or new SACK information reveal more holes */
+
+              fastrexmit = true;
+            }
+        }
+#endif
+
       /* A special case is the head of the write_q which may be partially
        * sent and so can still have un-ACKed bytes that could get ACKed
        * before the entire write buffer has even been sent.
@@ -587,6 +994,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       ninfo("REXMIT: %04x\n", flags);
 
+#ifdef CONFIG_NET_TCP_SACK
+      psock_sack_reset(conn);
+#endif
+
       /* If there is a partially sent write buffer at the head of the
        * write_q?  Has anything been sent from that write buffer?
        */
@@ -742,6 +1153,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
             }
         }
     }
+#ifdef CONFIG_NET_TCP_SACK
+  else if (fastrexmit)
+    {
+      psock_fast_retransmit(conn);
+    }
+#endif
 
 #if CONFIG_NET_SEND_BUFSIZE > 0
   /* Notify the send buffer available if wrbbuffer drained */
@@ -771,12 +1188,16 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
   if ((conn->tcpstateflags & TCP_ESTABLISHED) &&
       (flags & (TCP_POLL | TCP_REXMIT)) &&
       !(sq_empty(&conn->write_q)) &&
+#ifdef CONFIG_NET_TCP_NAGLE
+      !tcp_send_hold(conn, tcp_max_seglen(dev, conn)) &&
+#endif
       conn->snd_wnd > 0)
     {
       FAR struct tcp_wrbuffer_s *wrb;
       uint32_t predicted_seqno;
       uint32_t seq;
       uint32_t snd_wnd_edge;
+      uint32_t maxlen;
       size_t sndlen;
 
       /* Peek at the head of the write queue (but don't remove anything
@@ -805,14 +1226,25 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       seq = TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb);
       snd_wnd_edge = conn->snd_wl2 + conn->snd_wnd;
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Do not send beyond the congestion window either */
+
+      if (conn->cwnd != 0 && conn->cwnd < conn->snd_wnd)
+        {
+          snd_wnd_edge = conn->snd_wl2 + conn->cwnd;
+        }
+
+#endif
       if (TCP_SEQ_LT(seq, snd_wnd_edge))
         {
           uint32_t remaining_snd_wnd;
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          maxlen = tcp_max_seglen(dev, conn);
+          if (sndlen > maxlen)
             {
-              sndlen = conn->mss;
+              sndlen = maxlen;
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -861,6 +1293,8 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
           conn->tx_unacked += sndlen;
           conn->sent       += sndlen;
+          conn->segs_out++;
+          conn->bytes_sent += sndlen;
 
           /* Below prediction will become true,
            * unless retransmission occurrence
@@ -1125,6 +1559,16 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       unsigned int off;
       size_t chunk_len = len;
       ssize_t chunk_result;
+#ifdef CONFIG_NET_TCP_CONN_LOCK
+      unsigned int count;
+      int blresult;
+
+      ret = nxmutex_lock(&conn->snd_lock);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+#endif
 
       net_lock();
 
@@ -1178,6 +1622,14 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       conn->sndcb->priv  = (FAR void *)conn;
       conn->sndcb->event = psock_send_eventhandler;
 
+#ifdef CONFIG_NET_TCP_NAGLE
+      /* MSG_MORE holds back the tail of this write like TCP_CORK, until
+       * the next write without it.
+       */
+
+      conn->more = (flags & MSG_MORE) != 0;
+#endif
+
 #if CONFIG_NET_SEND_BUFSIZE > 0
       /* If the send buffer size exceeds the send limit,
        * wait for the write buffer to be released
@@ -1287,7 +1739,22 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
            * remaining data.
            */
 
+#ifdef CONFIG_NET_TCP_CONN_LOCK
+          /* The write buffer is not in any queue now, so nobody else can
+           * see it.  Let the rest of the network run during the copy, the
+           * send lock keeps other senders on this connection out.
+           */
+
+          blresult     = net_breaklock(&count);
           chunk_result = TCP_WBTRYCOPYIN(wrb, cp, chunk_len, off);
+          if (blresult >= 0)
+            {
+              net_restorelock(count);
+            }
+#else
+          chunk_result = TCP_WBTRYCOPYIN(wrb, cp, chunk_len, off);
+#endif
+
           if (chunk_result == -ENOMEM)
             {
               if (TCP_WBPKTLEN(wrb) > 0)
@@ -1372,6 +1839,9 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
       tcp_send_txnotify(psock, conn);
       net_unlock();
+#ifdef CONFIG_NET_TCP_CONN_LOCK
+      nxmutex_unlock(&conn->snd_lock);
+#endif
 
       if (chunk_result == 0)
         {
@@ -1418,6 +1888,9 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
 errout_with_lock:
   net_unlock();
+#ifdef CONFIG_NET_TCP_CONN_LOCK
+  nxmutex_unlock(&conn->snd_lock);
+#endif
 
 errout:
   if (result > 0)
@@ -361,6 +361,8 @@ static uint16_t tcpsend_eventhandler(FAR struct net_driver_s *dev,
       devif_send(dev,
                  &pstate->snd_buffer[pstate->snd_acked],
                  sndlen);
+      conn->segs_out++;
+      conn->bytes_sent += sndlen;
 
       /* Continue waiting */
 
@@ -442,6 +444,8 @@ static uint16_t tcpsend_eventhandler(FAR struct net_driver_s *dev,
            */
 
           devif_send(dev, &pstate->snd_buffer[pstate->snd_sent], sndlen);
+          conn->segs_out++;
+          conn->bytes_sent += sndlen;
 
           /* Update the amount of data sent (but not necessarily ACKed) */
 
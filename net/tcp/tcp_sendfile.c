@@ -40,8 +40,10 @@
 #include <debug.h>
 
 #include <arch/irq.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
@@ -65,6 +67,10 @@
 #define TCPIPv4BUF ((FAR struct tcp_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev) + IPv4_HDRLEN])
 #define TCPIPv6BUF ((FAR struct tcp_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev) + IPv6_HDRLEN])
 
+#ifndef CONFIG_NET_SENDFILE_READAHEAD
+#  define CONFIG_NET_SENDFILE_READAHEAD 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -81,6 +87,12 @@ struct sendfile_s
   sem_t              snd_sem;              /* Used to wake up the waiting thread */
   off_t              snd_foffset;          /* Input file offset */
   size_t             snd_flen;             /* File length */
+  FAR const uint8_t *snd_map;              /* File data if mapped, or NULL */
+#if CONFIG_NET_SENDFILE_READAHEAD > 0
+  FAR uint8_t       *snd_rabuf;            /* Read-ahead buffer, or NULL */
+  size_t             snd_rapos;            /* Offset of snd_rabuf data */
+  size_t             snd_ralen;            /* Size of snd_rabuf data */
+#endif
   ssize_t            snd_sent;             /* The number of bytes sent */
   uint32_t           snd_isn;              /* Initial sequence number */
   uint32_t           snd_acked;            /* The number of bytes acked */
@@ -101,6 +113,94 @@ struct sendfile_s
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sendfile_read
+ *
+ * Description:
+ *   Copy len bytes of the part of the file being sent, starting pos bytes
+ *   into that part, to dest.  The data is taken from the memory the file
+ *   is mapped to, if there is such a mapping, and otherwise from the file
+ *   in chunks of CONFIG_NET_SENDFILE_READAHEAD bytes, so that the file
+ *   system is accessed once for several segments.
+ *
+ * Input Parameters:
+ *   pstate - The state of the transfer
+ *   dest   - Where to copy the data to
+ *   pos    - Position of the data relative to snd_foffset
+ *   len    - The number of bytes to copy
+ *
+ * Returned Value:
+ *   The number of bytes copied or a negated errno value.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+static ssize_t sendfile_read(FAR struct sendfile_s *pstate,
+                             FAR uint8_t *dest, size_t pos, size_t len)
+{
+  ssize_t ret;
+
+  if (pstate->snd_map != NULL)
+    {
+      memcpy(dest, pstate->snd_map + pos, len);
+      return len;
+    }
+
+#if CONFIG_NET_SENDFILE_READAHEAD > 0
+  if (pstate->snd_rabuf != NULL && len <= CONFIG_NET_SENDFILE_READAHEAD)
+    {
+      if (pos < pstate->snd_rapos ||
+          pos + len > pstate->snd_rapos + pstate->snd_ralen)
+        {
+          /* Refill the buffer starting with the data needed now */
+
+          pstate->snd_ralen = 0;
+
+          ret = file_seek(pstate->snd_file, pstate->snd_foffset + pos,
+                          SEEK_SET);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          ret = pstate->snd_flen - pos;
+          if (ret > CONFIG_NET_SENDFILE_READAHEAD)
+            {
+              ret = CONFIG_NET_SENDFILE_READAHEAD;
+            }
+
+          ret = file_read(pstate->snd_file, pstate->snd_rabuf, ret);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          pstate->snd_rapos = pos;
+          pstate->snd_ralen = ret;
+        }
+
+      ret = pstate->snd_rapos + pstate->snd_ralen - pos;
+      if (ret > len)
+        {
+          ret = len;
+        }
+
+      memcpy(dest, pstate->snd_rabuf + (pos - pstate->snd_rapos), ret);
+      return ret;
+    }
+#endif
+
+  ret = file_seek(pstate->snd_file, pstate->snd_foffset + pos, SEEK_SET);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_read(pstate->snd_file, dest, len);
+}
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -302,16 +402,8 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
        * happen until the polling cycle completes).
        */
 
-      ret = file_seek(pstate->snd_file,
-                      pstate->snd_foffset + pstate->snd_acked, SEEK_SET);
-      if (ret < 0)
-        {
-          nerr("ERROR: Failed to lseek: %d\n", ret);
-          pstate->snd_sent = ret;
-          goto end_wait;
-        }
-
-      ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
+      ret = sendfile_read(pstate, dev->d_appdata, pstate->snd_acked,
+                          sndlen);
       if (ret < 0)
         {
           nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
@@ -380,21 +472,26 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = file_seek(pstate->snd_file,
-                          pstate->snd_foffset + pstate->snd_sent, SEEK_SET);
+          ret = sendfile_read(pstate, dev->d_appdata, pstate->snd_sent,
+                              sndlen);
           if (ret < 0)
             {
-              nerr("ERROR: Failed to lseek: %d\n", ret);
+              nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
               pstate->snd_sent = ret;
               goto end_wait;
             }
 
-          ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
-          if (ret < 0)
+          /* The file may end before count bytes were sent */
+
+          if (ret < sndlen)
             {
-              nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
+              pstate->snd_flen = pstate->snd_sent + ret;
+              if (pstate->snd_acked >= pstate->snd_flen)
+                {
+                  goto end_wait;
+                }
+
+              sndlen = ret;
             }
 
           dev->d_sndlen = sndlen;
@@ -465,6 +562,7 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
 {
   FAR struct tcp_conn_s *conn;
   struct sendfile_s state;
+  FAR void *map;
   off_t startpos;
   int ret;
 
@@ -479,6 +577,23 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
       return -ENOTCONN;
     }
 
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+  /* This function waits until all of the data is acknowledged.  A
+   * non-blocking socket rather needs the copy through the write buffers,
+   * which returns as soon as they are full.
+   */
+
+  if (_SS_ISNONBLOCK(conn->sconn.s_flags))
+    {
+      return -ENOSYS;
+    }
+#endif
+
+  if (count == 0)
+    {
+      return 0;
+    }
+
   /* Make sure that we have the IP address mapping */
 
 #if defined(CONFIG_NET_ARP_SEND) || defined(CONFIG_NET_ICMPv6_NEIGHBOR)
@@ -520,6 +635,40 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
       return startpos;
     }
 
+  /* If the file system can map the whole file into memory, as it can for
+   * files in ROM or RAM, the segments are copied from there without
+   * reading the file.
+   */
+
+  map = NULL;
+  if (file_ioctl(infile, FIOC_MMAP, (unsigned long)((uintptr_t)&map)) < 0)
+    {
+      map = NULL;
+    }
+  else
+    {
+      struct stat buf;
+      off_t foffset = offset ? *offset : startpos;
+
+      ret = file_fstat(infile, &buf);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (foffset >= buf.st_size)
+        {
+          return 0;
+        }
+
+      if (count > buf.st_size - foffset)
+        {
+          count = buf.st_size - foffset;
+        }
+
+      map = (FAR uint8_t *)map + foffset;
+    }
+
   /* Initialize the state structure.  This is done with the network
    * locked because we don't want anything to happen until we are
    * ready.
@@ -542,6 +691,18 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   state.snd_foffset = offset ? *offset : startpos; /* Input file offset */
   state.snd_flen    = count;                       /* Number of bytes to send */
   state.snd_file    = infile;                      /* File to read from */
+  state.snd_map     = map;                         /* Mapped file data */
+
+#if CONFIG_NET_SENDFILE_READAHEAD > 0
+  /* Without a mapping, read the file in larger chunks.  If there is no
+   * memory for that, just read each segment.
+   */
+
+  if (map == NULL)
+    {
+      state.snd_rabuf = kmm_malloc(CONFIG_NET_SENDFILE_READAHEAD);
+    }
+#endif
 
   /* Allocate resources to receive a callback */
 
@@ -596,6 +757,22 @@ errout_locked:
 #endif
   net_unlock();
 
+#if CONFIG_NET_SENDFILE_READAHEAD > 0
+  if (state.snd_rabuf != NULL)
+    {
+      kmm_free(state.snd_rabuf);
+    }
+#endif
+
+  /* The data was not necessarily read in order, nor at all if the file
+   * is mapped.  Leave the file position just after the data sent.
+   */
+
+  if (ret >= 0 && state.snd_sent >= 0)
+    {
+      file_seek(infile, state.snd_foffset + state.snd_sent, SEEK_SET);
+    }
+
   /* Return the current file position */
 
   if (offset)
@@ -26,6 +26,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -72,9 +73,10 @@
 int tcp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC) || \
+    defined(CONFIG_NET_TCP_NAGLE)
+  /* Keep alive, congestion control and segment coalescing options are the
+   * only TCP protocol socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -98,6 +100,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
 
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -134,6 +137,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif
 
       case TCP_NODELAY: /* Avoid coalescing of small segments. */
         if (value_len != sizeof(int))
@@ -144,14 +148,50 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
           {
             int nodelay = *(FAR int *)value;
 
+#ifdef CONFIG_NET_TCP_NAGLE
+            net_lock();
+            conn->nodelay = nodelay != 0;
+            if (conn->nodelay)
+              {
+                /* Send anything held back by Nagle's algorithm */
+
+                tcp_send_txnotify(psock, conn);
+              }
+
+            net_unlock();
+#else
             if (!nodelay)
               {
                 nerr("ERROR: TCP_NODELAY not supported\n");
                 ret = -ENOSYS;
               }
+#endif
+          }
+        break;
+
+#ifdef CONFIG_NET_TCP_NAGLE
+      case TCP_CORK: /* Only send full segments */
+        if (value_len != sizeof(int))
+          {
+            ret = -EDOM;
+          }
+        else
+          {
+            net_lock();
+            conn->cork = *(FAR int *)value != 0;
+            if (!conn->cork)
+              {
+                /* Uncorking sends any partial segment right away */
+
+                tcp_send_txnotify(psock, conn);
+              }
+
+            net_unlock();
           }
         break;
+#endif
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
       case TCP_KEEPINTVL: /* Interval between keepalives */
         {
@@ -234,6 +274,34 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        {
+          char name[TCP_CA_NAME_MAX];
+          size_t len;
+
+          if (value_len == 0)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              /* The name need not be NUL terminated */
+
+              len = value_len < sizeof(name) ? value_len : sizeof(name) - 1;
+              memcpy(name, value, len);
+              name[len] = '\0';
+
+              net_lock();
+              ret = tcp_cc_select(conn, name);
+              net_unlock();
+            }
+        }
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
         ret = -ENOPROTOOPT;
@@ -243,7 +311,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC || ... */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
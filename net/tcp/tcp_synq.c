@@ -0,0 +1,638 @@
+/****************************************************************************
+ * net/tcp/tcp_synq.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_SYNQUEUE)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+#include <sys/random.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "devif/devif.h"
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+#define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+
+#define SYNQ_TIMEOUT     SEC2TICK(CONFIG_NET_TCP_SYNQUEUE_TIMEOUT)
+
+/* SYN cookie layout (our initial sequence number):
+ *
+ *   bits 31-27: coarse time counter, advancing every 64 seconds
+ *   bits 26-2:  keyed hash of the connection 4-tuple, the peer ISN and
+ *               the time counter
+ *   bits 1-0:   index into g_cookie_mss[]
+ *
+ * A cookie is accepted if its counter is the current one or the one
+ * before, i.e. for 64 to 128 seconds.
+ */
+
+#define COOKIE_TSHIFT    27
+#define COOKIE_TMASK     0x1f
+#define COOKIE_HMASK     0x07fffffc
+#define COOKIE_MSSMASK   0x03
+#define COOKIE_PERIOD    64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A half-open connection: just enough to answer a retransmitted SYN and to
+ * build the connection when the handshake completes.
+ */
+
+struct tcp_synent_s
+{
+  union ip_binding_u u;          /* Local and remote IP addresses */
+  FAR struct net_driver_s *dev;  /* Device the SYN arrived on */
+  clock_t    time;               /* Time the SYN was received */
+  uint32_t   isn;                /* Our initial sequence number */
+  uint32_t   rcvisn;             /* Initial sequence number of the peer */
+  uint16_t   lport;              /* Local port, network byte order */
+  uint16_t   rport;              /* Remote port, network byte order */
+  uint16_t   mss;                /* MSS announced by the peer, 0 if none */
+  uint8_t    flags;              /* TCP_WSCALE and/or TCP_SACK */
+  uint8_t    snd_scale;          /* Window scale announced by the peer */
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  uint8_t    domain;             /* PF_INET or PF_INET6 */
+#endif
+  bool       used;               /* Entry holds a half-open connection */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct tcp_synent_s g_synq[CONFIG_NET_TCP_SYNQUEUE_SIZE];
+
+/* Scratch connection used to format SYN-ACKs for entries that have no
+ * connection structure.  Protected by the network lock.
+ */
+
+static struct tcp_conn_s g_synconn;
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+static const uint16_t g_cookie_mss[] =
+{
+  536, 1220, 1440, 1460
+};
+
+static uint32_t g_cookie_secret[4];
+static bool g_cookie_seeded;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_synq_domain
+ *
+ * Description:
+ *   Return the IP domain of the packet in the device buffer.
+ *
+ ****************************************************************************/
+
+static inline uint8_t tcp_synq_domain(FAR struct net_driver_s *dev)
+{
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  return IFF_IS_IPv6(dev->d_flags) ? PF_INET6 : PF_INET;
+#elif defined(CONFIG_NET_IPv4)
+  return PF_INET;
+#else
+  return PF_INET6;
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_synq_addr
+ *
+ * Description:
+ *   Extract the local (destination) and remote (source) addresses of the
+ *   packet in the device buffer.
+ *
+ ****************************************************************************/
+
+static void tcp_synq_addr(FAR struct net_driver_s *dev, uint8_t domain,
+                          FAR union ip_binding_u *u)
+{
+  memset(u, 0, sizeof(*u));
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (domain == PF_INET6)
+#endif
+    {
+      net_ipv6addr_copy(u->ipv6.laddr, IPv6BUF->destipaddr);
+      net_ipv6addr_copy(u->ipv6.raddr, IPv6BUF->srcipaddr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      net_ipv4addr_copy(u->ipv4.laddr,
+                        net_ip4addr_conv32(IPv4BUF->destipaddr));
+      net_ipv4addr_copy(u->ipv4.raddr,
+                        net_ip4addr_conv32(IPv4BUF->srcipaddr));
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_synq_find
+ *
+ * Description:
+ *   Find the half-open connection matching the packet, if any.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_synent_s *
+tcp_synq_find(FAR const union ip_binding_u *u, uint8_t domain,
+              FAR struct tcp_hdr_s *tcp)
+{
+  FAR struct tcp_synent_s *ent;
+  int i;
+
+  UNUSED(domain);
+
+  for (i = 0; i < CONFIG_NET_TCP_SYNQUEUE_SIZE; i++)
+    {
+      ent = &g_synq[i];
+      if (ent->used && ent->lport == tcp->destport &&
+          ent->rport == tcp->srcport &&
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+          ent->domain == domain &&
+#endif
+          memcmp(&ent->u, u, sizeof(*u)) == 0)
+        {
+          return ent;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: tcp_synq_alloc
+ *
+ * Description:
+ *   Return a free entry, or one whose handshake has timed out.  Returns
+ *   NULL if the queue is full.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_synent_s *tcp_synq_alloc(void)
+{
+  FAR struct tcp_synent_s *ent;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0; i < CONFIG_NET_TCP_SYNQUEUE_SIZE; i++)
+    {
+      ent = &g_synq[i];
+      if (!ent->used || now - ent->time >= SYNQ_TIMEOUT)
+        {
+          return ent;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: tcp_synq_reply
+ *
+ * Description:
+ *   Format a SYN-ACK for a connection that has no connection structure
+ *   into the device buffer, in place of the received SYN.
+ *
+ ****************************************************************************/
+
+static void tcp_synq_reply(FAR struct net_driver_s *dev,
+                           FAR const union ip_binding_u *u, uint8_t domain,
+                           FAR struct tcp_hdr_s *tcp, uint32_t isn,
+                           uint16_t mss, uint8_t flags)
+{
+  FAR struct tcp_conn_s *conn = &g_synconn;
+
+  UNUSED(domain);
+
+  /* Only the fields used by tcp_synack() matter here */
+
+  memset(conn, 0, sizeof(*conn));
+  memcpy(&conn->u, u, sizeof(*u));
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  conn->domain = domain;
+#endif
+  conn->dev           = dev;
+  conn->lport         = tcp->destport;
+  conn->rport         = tcp->srcport;
+  conn->mss           = mss;
+  conn->flags         = flags;
+  conn->tcpstateflags = TCP_SYN_RCVD;
+#if CONFIG_NET_RECV_BUFSIZE > 0
+  conn->rcv_bufs      = CONFIG_NET_RECV_BUFSIZE;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  if ((flags & TCP_WSCALE) != 0)
+    {
+      conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
+    }
+#endif
+
+  tcp_setsequence(conn->sndseq, isn);
+  memcpy(conn->rcvseq, tcp->seqno, 4);
+  net_incr32(conn->rcvseq, 1);
+
+  tcp_synack(dev, conn, TCP_ACK | TCP_SYN);
+}
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+/****************************************************************************
+ * Name: tcp_cookie_hash
+ *
+ * Description:
+ *   Keyed hash of the connection 4-tuple, the peer ISN and the cookie
+ *   time counter.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cookie_hash(FAR const union ip_binding_u *u,
+                                FAR struct tcp_hdr_s *tcp,
+                                uint32_t rcvisn, uint32_t count)
+{
+  FAR const uint8_t *ptr;
+  uint32_t hash;
+  size_t i;
+
+  if (!g_cookie_seeded)
+    {
+      if (getrandom(g_cookie_secret, sizeof(g_cookie_secret), 0) !=
+          sizeof(g_cookie_secret))
+        {
+          g_cookie_secret[0] = clock_systime_ticks();
+          g_cookie_secret[1] = (uint32_t)(uintptr_t)&g_synq;
+        }
+
+      g_cookie_seeded = true;
+    }
+
+  /* FNV-1a over the 4-tuple, then mix in the secret, the peer ISN and the
+   * counter with a multiplicative round each.
+   */
+
+  hash = 2166136261u ^ g_cookie_secret[0];
+  ptr  = (FAR const uint8_t *)u;
+  for (i = 0; i < sizeof(*u); i++)
+    {
+      hash = (hash ^ ptr[i]) * 16777619u;
+    }
+
+  hash ^= ((uint32_t)tcp->srcport << 16) | tcp->destport;
+  hash  = (hash ^ g_cookie_secret[1]) * 0x9e3779b1u;
+  hash ^= rcvisn + g_cookie_secret[2];
+  hash  = (hash ^ (hash >> 15)) * 0x85ebca6bu;
+  hash ^= count + g_cookie_secret[3];
+  hash  = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+  return hash ^ (hash >> 16);
+}
+
+/****************************************************************************
+ * Name: tcp_cookie_count
+ ****************************************************************************/
+
+static inline uint32_t tcp_cookie_count(void)
+{
+  return (TICK2SEC(clock_systime_ticks()) / COOKIE_PERIOD) & COOKIE_TMASK;
+}
+
+/****************************************************************************
+ * Name: tcp_cookie_make
+ *
+ * Description:
+ *   Create the SYN cookie for a SYN.  On return *mss holds the MSS the
+ *   cookie encodes, which is never larger than the MSS requested.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cookie_make(FAR const union ip_binding_u *u,
+                                FAR struct tcp_hdr_s *tcp,
+                                FAR uint16_t *mss)
+{
+  uint32_t count = tcp_cookie_count();
+  uint32_t idx;
+
+  for (idx = COOKIE_MSSMASK; idx > 0; idx--)
+    {
+      if (g_cookie_mss[idx] <= *mss)
+        {
+          break;
+        }
+    }
+
+  *mss = g_cookie_mss[idx];
+
+  return (count << COOKIE_TSHIFT) |
+         (tcp_cookie_hash(u, tcp, tcp_getsequence(tcp->seqno), count) &
+          COOKIE_HMASK) | idx;
+}
+
+/****************************************************************************
+ * Name: tcp_cookie_check
+ *
+ * Description:
+ *   Validate the SYN cookie acknowledged by an ACK.  Returns the encoded
+ *   MSS, or zero if the ACK does not acknowledge a valid cookie.
+ *
+ ****************************************************************************/
+
+static uint16_t tcp_cookie_check(FAR const union ip_binding_u *u,
+                                 FAR struct tcp_hdr_s *tcp)
+{
+  uint32_t cookie = tcp_getsequence(tcp->ackno) - 1;
+  uint32_t rcvisn = tcp_getsequence(tcp->seqno) - 1;
+  uint32_t count  = cookie >> COOKIE_TSHIFT;
+
+  if (((tcp_cookie_count() - count) & COOKIE_TMASK) > 1)
+    {
+      return 0;
+    }
+
+  if (((tcp_cookie_hash(u, tcp, rcvisn, count) ^ cookie) &
+       COOKIE_HMASK) != 0)
+    {
+      return 0;
+    }
+
+  return g_cookie_mss[cookie & COOKIE_MSSMASK];
+}
+#endif /* CONFIG_NET_TCP_SYNCOOKIES */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_synq_syn
+ *
+ * Description:
+ *   Handle a SYN for a listening port without allocating a connection:
+ *   record the handshake in the SYN queue (or encode it in a SYN cookie
+ *   if the queue is full) and format the SYN-ACK into the device buffer.
+ *
+ * Input Parameters:
+ *   dev       - The device that received the SYN
+ *   tcp       - The TCP header of the SYN
+ *   mss       - The MSS announced by the peer, clamped to the device MSS,
+ *               or zero if the SYN had no MSS option
+ *   flags     - TCP_WSCALE and/or TCP_SACK options of the SYN
+ *   snd_scale - The window scale announced by the peer
+ *
+ * Returned Value:
+ *   OK if a SYN-ACK has been formatted; -ENOMEM if the SYN must be
+ *   dropped.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_synq_syn(FAR struct net_driver_s *dev, FAR struct tcp_hdr_s *tcp,
+                 uint16_t mss, uint8_t flags, uint8_t snd_scale)
+{
+  FAR struct tcp_synent_s *ent;
+  union ip_binding_u u;
+  uint8_t domain = tcp_synq_domain(dev);
+  uint32_t rcvisn = tcp_getsequence(tcp->seqno);
+  uint8_t seqno[4];
+  uint16_t devmss;
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  devmss = domain == PF_INET6 ? TCP_IPv6_INITIAL_MSS(dev) :
+                                TCP_IPv4_INITIAL_MSS(dev);
+#elif defined(CONFIG_NET_IPv4)
+  devmss = TCP_IPv4_INITIAL_MSS(dev);
+#else
+  devmss = TCP_IPv6_INITIAL_MSS(dev);
+#endif
+
+  tcp_synq_addr(dev, domain, &u);
+
+  ent = tcp_synq_find(&u, domain, tcp);
+  if (ent != NULL && ent->rcvisn == rcvisn)
+    {
+      /* A retransmitted SYN: our SYN-ACK was lost.  Answer it again with
+       * the same sequence number.
+       */
+
+      tcp_synq_reply(dev, &u, domain, tcp, ent->isn,
+                     ent->mss != 0 ? ent->mss : devmss, ent->flags);
+      return OK;
+    }
+
+  if (ent == NULL)
+    {
+      ent = tcp_synq_alloc();
+    }
+
+  if (ent == NULL)
+    {
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+      uint32_t cookie;
+
+      /* The queue is full.  Keep no state at all: encode the connection
+       * in our sequence number.
+       */
+
+      mss    = mss != 0 ? mss : devmss;
+      cookie = tcp_cookie_make(&u, tcp, &mss);
+      ninfo("SYN queue full, sending cookie %08" PRIx32 "\n", cookie);
+
+      tcp_synq_reply(dev, &u, domain, tcp, cookie, mss, 0);
+      return OK;
+#else
+      nwarn("WARNING: SYN queue full\n");
+      return -ENOMEM;
+#endif
+    }
+
+  memcpy(&ent->u, &u, sizeof(u));
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  ent->domain    = domain;
+#endif
+  ent->dev       = dev;
+  ent->time      = clock_systime_ticks();
+  ent->rcvisn    = rcvisn;
+  ent->lport     = tcp->destport;
+  ent->rport     = tcp->srcport;
+  ent->mss       = mss;
+  ent->flags     = flags;
+  ent->snd_scale = snd_scale;
+  ent->used      = true;
+
+  tcp_initsequence(seqno);
+  ent->isn       = tcp_getsequence(seqno);
+  tcp_nextsequence();
+
+  tcp_synq_reply(dev, &u, domain, tcp, ent->isn,
+                 mss != 0 ? mss : devmss, flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tcp_synq_ack
+ *
+ * Description:
+ *   Handle an ACK that matches no active connection.  If it completes a
+ *   handshake in the SYN queue, or acknowledges a valid SYN cookie, the
+ *   connection structure is allocated now and returned in the TCP_SYN_RCVD
+ *   state, exactly as if it had been allocated when the SYN arrived.  The
+ *   caller then processes the ACK normally.
+ *
+ * Input Parameters:
+ *   dev - The device that received the ACK
+ *   tcp - The TCP header of the ACK
+ *
+ * Returned Value:
+ *   The new connection, or NULL if the ACK completes no handshake or no
+ *   connection structure is available.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct tcp_conn_s *tcp_synq_ack(FAR struct net_driver_s *dev,
+                                    FAR struct tcp_hdr_s *tcp)
+{
+  FAR struct tcp_synent_s *ent;
+  FAR struct tcp_conn_s *conn;
+  union ip_binding_u u;
+  uint8_t domain = tcp_synq_domain(dev);
+  uint32_t isn = tcp_getsequence(tcp->ackno) - 1;
+  uint16_t mss = 0;
+  uint8_t flags = 0;
+  uint8_t snd_scale = 0;
+
+  tcp_synq_addr(dev, domain, &u);
+
+  ent = tcp_synq_find(&u, domain, tcp);
+  if (ent != NULL)
+    {
+      if (ent->isn != isn ||
+          ent->rcvisn != tcp_getsequence(tcp->seqno) - 1)
+        {
+          return NULL;
+        }
+
+      mss       = ent->mss;
+      flags     = ent->flags;
+      snd_scale = ent->snd_scale;
+      ent->used = false;
+    }
+  else
+    {
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+      if (!tcp_islistener(&u, tcp->destport, domain))
+#else
+      if (!tcp_islistener(&u, tcp->destport))
+#endif
+        {
+          return NULL;
+        }
+
+      mss = tcp_cookie_check(&u, tcp);
+      if (mss == 0)
+        {
+          return NULL;
+        }
+#else
+      return NULL;
+#endif
+    }
+
+  conn = tcp_alloc_accept(dev, tcp);
+  if (conn == NULL)
+    {
+#ifdef CONFIG_NET_STATISTICS
+      g_netstats.tcp.syndrop++;
+#endif
+      nerr("ERROR: No free TCP connections\n");
+      return NULL;
+    }
+
+  conn->crefs = 1;
+
+  /* tcp_alloc_accept() took rcvseq from this ACK, which already accounts
+   * for the peer's SYN.  Restore the state we would have been in after
+   * sending our SYN-ACK.
+   */
+
+  if (mss != 0 && mss < conn->mss)
+    {
+      conn->mss = mss;
+    }
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  if ((flags & TCP_WSCALE) != 0)
+    {
+      conn->snd_scale = snd_scale;
+      conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
+    }
+#else
+  UNUSED(snd_scale);
+#endif
+
+  conn->flags |= flags;
+
+  tcp_setsequence(conn->sndseq, isn);
+#ifndef CONFIG_NET_TCP_WRITE_BUFFERS
+  conn->rexmit_seq = isn;
+  net_incr32(conn->sndseq, 1);
+#endif
+
+  return conn;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_SYNQUEUE */
@@ -52,6 +52,7 @@
 #include <time.h>
 #include <stdlib.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -76,6 +77,31 @@
 
 #define ACK_DELAY (1)
 
+/* Timing wheel geometry.  Each slot covers one half-second tick. */
+
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+#  define TCP_WHEEL_SLOTS CONFIG_NET_TCP_TIMER_WHEEL_SLOTS
+#  define TCP_WHEEL_MASK  (TCP_WHEEL_SLOTS - 1)
+#  define TCP_WHEEL_TICK  HSEC2TICK(1)
+
+#  if (TCP_WHEEL_SLOTS & TCP_WHEEL_MASK) != 0
+#    error CONFIG_NET_TCP_TIMER_WHEEL_SLOTS must be a power of two
+#  endif
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+/* The TCP timing wheel.  All fields are protected by the network lock. */
+
+static dq_queue_t g_tcp_wheel[TCP_WHEEL_SLOTS];
+static struct work_s g_tcp_wheel_work;
+static uint32_t g_tcp_wheel_now;       /* Current wheel tick */
+static unsigned int g_tcp_wheel_armed; /* Number of armed connections */
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -135,6 +161,7 @@ static int tcp_get_timeout(FAR struct tcp_conn_s *conn)
  *
  ****************************************************************************/
 
+#ifndef CONFIG_NET_TCP_TIMER_WHEEL
 static void tcp_timer_expiry(FAR void *arg)
 {
   FAR struct tcp_conn_s *conn = arg;
@@ -142,6 +169,152 @@ static void tcp_timer_expiry(FAR void *arg)
   conn->timeout = true;
   conn->dev->d_txavail(conn->dev);
 }
+#else
+
+/****************************************************************************
+ * Name: tcp_wheel_expiry
+ *
+ * Description:
+ *   Advance the TCP timing wheel by one tick and mark every connection
+ *   expiring in this tick.  Re-arms itself while any timer is pending.
+ *
+ * Input Parameters:
+ *   arg - Not used
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void tcp_wheel_expiry(FAR void *arg)
+{
+  FAR struct net_driver_s *lastdev = NULL;
+  FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry;
+  FAR dq_entry_t *next;
+  FAR dq_queue_t *slot;
+
+  net_lock();
+
+  /* Advance the wheel and expire every connection in the new slot whose
+   * round has come up.  Entries that belong to a later round stay put.
+   */
+
+  g_tcp_wheel_now++;
+  slot = &g_tcp_wheel[g_tcp_wheel_now & TCP_WHEEL_MASK];
+
+  for (entry = dq_peek(slot); entry != NULL; entry = next)
+    {
+      next = dq_next(entry);
+      conn = container_of(entry, struct tcp_conn_s, tmnode);
+
+      if ((int32_t)(conn->tmexpiry - g_tcp_wheel_now) > 0)
+        {
+          continue;
+        }
+
+      dq_rem(entry, slot);
+      conn->tmarmed = false;
+      g_tcp_wheel_armed--;
+
+      /* Poll the device once per tick, not once per connection.  The
+       * device will visit all of its connections and pick up the
+       * timeout flag of each.
+       */
+
+      conn->timeout = true;
+      if (conn->dev != NULL && conn->dev != lastdev)
+        {
+          lastdev = conn->dev;
+          lastdev->d_txavail(lastdev);
+        }
+    }
+
+  if (g_tcp_wheel_armed > 0)
+    {
+      work_queue(LPWORK, &g_tcp_wheel_work, tcp_wheel_expiry, NULL,
+                 TCP_WHEEL_TICK);
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: tcp_wheel_remove
+ *
+ * Description:
+ *   Unlink a connection from the TCP timing wheel, if it is armed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_wheel_remove(FAR struct tcp_conn_s *conn)
+{
+  if (conn->tmarmed)
+    {
+      dq_rem(&conn->tmnode, &g_tcp_wheel[conn->tmexpiry & TCP_WHEEL_MASK]);
+      conn->tmarmed = false;
+      g_tcp_wheel_armed--;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_wheel_insert
+ *
+ * Description:
+ *   Arm the connection timer to expire "timeout" half-seconds from now.
+ *   The expiry is rounded to the nearest wheel tick.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_wheel_insert(FAR struct tcp_conn_s *conn, int timeout)
+{
+  uint32_t expiry;
+
+  if (g_tcp_wheel_armed == 0 && work_available(&g_tcp_wheel_work))
+    {
+      /* The wheel is idle: restart the tick so that it is in phase with
+       * this timer.
+       */
+
+      work_queue(LPWORK, &g_tcp_wheel_work, tcp_wheel_expiry, NULL,
+                 TCP_WHEEL_TICK);
+      expiry = g_tcp_wheel_now + timeout;
+    }
+  else
+    {
+      /* Round to the nearest tick: if more than half of the current tick
+       * has already elapsed, count it as consumed.
+       */
+
+      expiry = g_tcp_wheel_now + timeout;
+      if (work_timeleft(&g_tcp_wheel_work) < TCP_WHEEL_TICK / 2)
+        {
+          expiry++;
+        }
+    }
+
+  if (conn->tmarmed)
+    {
+      if (conn->tmexpiry == expiry)
+        {
+          return;
+        }
+
+      tcp_wheel_remove(conn);
+    }
+
+  conn->tmexpiry = expiry;
+  conn->tmarmed  = true;
+  dq_addlast(&conn->tmnode, &g_tcp_wheel[expiry & TCP_WHEEL_MASK]);
+  g_tcp_wheel_armed++;
+}
+#endif /* CONFIG_NET_TCP_TIMER_WHEEL */
 
 /****************************************************************************
  * Name: tcp_update_timer
@@ -166,6 +339,16 @@ static void tcp_update_timer(FAR struct tcp_conn_s *conn)
 {
   int timeout = tcp_get_timeout(conn);
 
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+  if (timeout > 0)
+    {
+      tcp_wheel_insert(conn, timeout);
+    }
+  else
+    {
+      tcp_wheel_remove(conn);
+    }
+#else
   if (timeout > 0)
     {
       if (TICK2HSEC(work_timeleft(&conn->work)) != timeout)
@@ -178,6 +361,7 @@ static void tcp_update_timer(FAR struct tcp_conn_s *conn)
     {
       work_cancel(LPWORK, &conn->work);
     }
+#endif
 }
 
 /****************************************************************************
@@ -258,7 +442,11 @@ void tcp_update_keeptimer(FAR struct tcp_conn_s *conn, int timeout)
 
 void tcp_stop_timer(FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TCP_TIMER_WHEEL
+  tcp_wheel_remove(conn);
+#else
   work_cancel(LPWORK, &conn->work);
+#endif
 }
 
 /****************************************************************************
@@ -525,6 +713,7 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                      * the code for sending out the packet.
                      */
 
+                    tcp_cc_rto(conn);
                     result = tcp_callback(dev, conn, TCP_REXMIT);
                     tcp_rexmit(dev, conn, result);
                     goto done;
@@ -275,13 +275,13 @@ uint32_t tcp_wrbuffer_inqueue_size(FAR struct tcp_conn_s *conn)
       for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
         {
           wrb = (FAR struct tcp_wrbuffer_s *)entry;
-          total += TCP_WBPKTLEN(wrb);
+          total += NET_IOB_CHARGE(TCP_WBIOB(wrb));
         }
 
       for (entry = sq_peek(&conn->write_q); entry; entry = sq_next(entry))
         {
           wrb = (FAR struct tcp_wrbuffer_s *)entry;
-          total += TCP_WBPKTLEN(wrb);
+          total += NET_IOB_CHARGE(TCP_WBIOB(wrb));
         }
     }
 
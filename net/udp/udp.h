@@ -36,6 +36,8 @@
 #include <nuttx/net/net.h>
 #include <nuttx/mm/iob.h>
 
+#include "utils/utils.h"
+
 #ifdef CONFIG_NET_UDP_NOTIFIER
 #  include <nuttx/wqueue.h>
 #endif
@@ -72,6 +74,14 @@
 
 #define _UDP_ISCONNECTMODE(f) (((f) & _UDP_FLAG_CONNECTMODE) != 0)
 
+/* Each read-ahead record starts with a byte that holds the size of the
+ * source address that follows.  With UDP_RECHDR_TSTAMP set, a struct
+ * scm_timestamping follows the address, ahead of the payload.
+ */
+
+#define UDP_RECHDR_TSTAMP     0x80
+#define UDP_RECHDR_ADDRMASK   0x7f
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -104,6 +114,9 @@ struct udp_conn_s
 
   /* UDP-specific content follows */
 
+#ifdef CONFIG_NET_HASH_CONNS
+  struct net_hnode_s pnode; /* Hashed on local port, if lport != 0 */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
@@ -260,6 +273,18 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
 uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u);
 
+/****************************************************************************
+ * Name: udp_set_lport
+ *
+ * Description:
+ *   Set the local port number (network byte order) of a connection.  This
+ *   must be used instead of assigning lport directly, so that the
+ *   connection can be found by its new port number.
+ *
+ ****************************************************************************/
+
+void udp_set_lport(FAR struct udp_conn_s *conn, uint16_t lport);
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -663,6 +688,27 @@ udp_find_raddr_device(FAR struct udp_conn_s *conn,
 uint16_t udp_callback(FAR struct net_driver_s *dev,
                       FAR struct udp_conn_s *conn, uint16_t flags);
 
+/****************************************************************************
+ * Name: udp_rxtstamp
+ *
+ * Description:
+ *   Take the receive timestamps that the SO_TIMESTAMPING flags of the
+ *   connection ask for, for the packet in the device buffer.
+ *
+ * Returned Value:
+ *   true if any timestamp was requested, false otherwise.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMPING
+struct scm_timestamping;
+bool udp_rxtstamp(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
+                  FAR struct scm_timestamping *tss);
+#endif
+
 /****************************************************************************
  * Name: psock_udp_recvfrom
  *
@@ -671,11 +717,9 @@ uint16_t udp_callback(FAR struct net_driver_s *dev,
  *
  * Input Parameters:
  *   psock    Pointer to the socket structure for the SOCK_DRAM socket
- *   buf      Buffer to receive data
- *   len      Length of buffer
+ *   msg      Receive buffer, source address (may be NULL) and control
+ *            data
  *   flags    Receive flags
- *   from     INET address of source (may be NULL)
- *   fromlen  The length of the address structure
  *
  * Returned Value:
  *   On success, returns the number of characters received.  On  error,
@@ -685,9 +729,8 @@ uint16_t udp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
-                           size_t len, int flags, FAR struct sockaddr *from,
-                           FAR socklen_t *fromlen);
+ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
+                           int flags);
 
 /****************************************************************************
  * Name: psock_udp_sendto
@@ -27,7 +27,13 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <time.h>
 #include <debug.h>
+#include <assert.h>
+
+#ifdef CONFIG_NET_TIMESTAMPING
+#  include <net/net_tstamp.h>
+#endif
 
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
@@ -35,6 +41,7 @@
 #include <nuttx/net/udp.h>
 
 #include "devif/devif.h"
+#include "utils/utils.h"
 #include "udp/udp.h"
 
 /****************************************************************************
@@ -82,26 +89,21 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
 
   FAR void  *src_addr;
   uint8_t src_addr_size;
+  uint8_t rechdr;
+  uint8_t hdrlen;
+#ifdef CONFIG_NET_TIMESTAMPING
+  struct scm_timestamping tss;
+  uint8_t tslen = 0;
+#endif
 
 #if CONFIG_NET_RECV_BUFSIZE > 0
-  while (iob_get_queue_size(&conn->readahead) > conn->rcvbufs)
+  while (NET_IOBQ_CHARGE(&conn->readahead) > conn->rcvbufs)
     {
       iob = iob_remove_queue(&conn->readahead);
       iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
     }
 #endif
 
-  /* Allocate on I/O buffer to start the chain (throttling as necessary).
-   * We will not wait for an I/O buffer to become available in this context.
-   */
-
-  iob = iob_tryalloc(true, IOBUSER_NET_UDP_READAHEAD);
-  if (iob == NULL)
-    {
-      nerr("ERROR: Failed to create new I/O buffer chain\n");
-      return 0;
-    }
-
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv6(dev->d_flags))
@@ -166,13 +168,67 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
     }
 #endif /* CONFIG_NET_IPv4 */
 
+  /* The record header: the size of the source address, plus a flag if the
+   * receive timestamps follow it.
+   */
+
+  rechdr = src_addr_size;
+  hdrlen = sizeof(uint8_t) + src_addr_size;
+
+#ifdef CONFIG_NET_TIMESTAMPING
+  if (udp_rxtstamp(dev, conn, &tss))
+    {
+      tslen   = sizeof(struct scm_timestamping);
+      rechdr |= UDP_RECHDR_TSTAMP;
+      hdrlen += tslen;
+    }
+#endif
+
+#ifdef CONFIG_NETDEV_IOB
+  /* If the driver passed the packet in an I/O buffer, then queue that
+   * buffer instead of copying the data.  The src address info is placed in
+   * front of the data where the packet headers were.  The headers do not
+   * leave room for the timestamps as well, so timestamped packets are
+   * copied.
+   */
+
+#ifdef CONFIG_NET_TIMESTAMPING
+  iob = tslen == 0 ? netdev_iob_take(dev, buffer, buflen) : NULL;
+#else
+  iob = netdev_iob_take(dev, buffer, buflen);
+#endif
+  if (iob != NULL)
+    {
+      DEBUGASSERT(iob->io_offset >= hdrlen);
+
+      iob->io_offset -= hdrlen;
+      iob->io_len    += hdrlen;
+      iob->io_pktlen += hdrlen;
+
+      IOB_DATA(iob)[0] = rechdr;
+      memcpy(IOB_DATA(iob) + sizeof(uint8_t), src_addr, src_addr_size);
+      goto queue;
+    }
+#endif
+
+  /* Allocate on I/O buffer to start the chain (throttling as necessary).
+   * We will not wait for an I/O buffer to become available in this context.
+   */
+
+  iob = iob_tryalloc(true, IOBUSER_NET_UDP_READAHEAD);
+  if (iob == NULL)
+    {
+      nerr("ERROR: Failed to create new I/O buffer chain\n");
+      return 0;
+    }
+
   /* Copy the src address info into the I/O buffer chain.  We will not wait
    * for an I/O buffer to become available in this context.  It there is
    * any failure to allocated, the entire I/O buffer chain will be discarded.
    */
 
-  ret = iob_trycopyin(iob, (FAR const uint8_t *)&src_addr_size,
-                      sizeof(uint8_t), 0, true, IOBUSER_NET_UDP_READAHEAD);
+  ret = iob_trycopyin(iob, &rechdr, sizeof(uint8_t), 0, true,
+                      IOBUSER_NET_UDP_READAHEAD);
   if (ret < 0)
     {
       /* On a failure, iob_trycopyin return a negated error value but does
@@ -197,12 +253,27 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
       return 0;
     }
 
+#ifdef CONFIG_NET_TIMESTAMPING
+  if (tslen > 0)
+    {
+      ret = iob_trycopyin(iob, (FAR const uint8_t *)&tss, tslen,
+                          sizeof(uint8_t) + src_addr_size, true,
+                          IOBUSER_NET_UDP_READAHEAD);
+      if (ret < 0)
+        {
+          nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n",
+               ret);
+          iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+          return 0;
+        }
+    }
+#endif
+
   if (buflen > 0)
     {
       /* Copy the new appdata into the I/O buffer chain */
 
-      ret = iob_trycopyin(iob, buffer, buflen,
-                          src_addr_size + sizeof(uint8_t), true,
+      ret = iob_trycopyin(iob, buffer, buflen, hdrlen, true,
                           IOBUSER_NET_UDP_READAHEAD);
       if (ret < 0)
         {
@@ -217,6 +288,10 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
         }
     }
 
+#ifdef CONFIG_NETDEV_IOB
+queue:
+#endif
+
   /* Add the new I/O buffer chain to the tail of the read-ahead queue */
 
   ret = iob_tryadd_queue(iob, &conn->readahead);
@@ -292,6 +367,42 @@ net_dataevent(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: udp_rxtstamp
+ *
+ * Description:
+ *   Take the receive timestamps that the SO_TIMESTAMPING flags of the
+ *   connection ask for, for the packet in the device buffer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMPING
+bool udp_rxtstamp(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
+                  FAR struct scm_timestamping *tss)
+{
+  uint32_t tsflags = conn->sconn.s_tstamping;
+  bool taken = false;
+
+  memset(tss, 0, sizeof(*tss));
+
+  if ((tsflags & SOF_TIMESTAMPING_RX_SOFTWARE) != 0 &&
+      (tsflags & SOF_TIMESTAMPING_SOFTWARE) != 0)
+    {
+      clock_gettime(CLOCK_REALTIME, &tss->ts[0]);
+      taken = true;
+    }
+
+  if ((tsflags & SOF_TIMESTAMPING_RX_HARDWARE) != 0 &&
+      (tsflags & SOF_TIMESTAMPING_RAW_HARDWARE) != 0)
+    {
+      tss->ts[2] = dev->d_rxtstamp;
+      taken = true;
+    }
+
+  return taken;
+}
+#endif
+
 /****************************************************************************
  * Name: udp_callback
  *
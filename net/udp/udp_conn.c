@@ -54,6 +54,7 @@
 
 #include <arch/irq.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
@@ -67,6 +68,7 @@
 #include "netdev/netdev.h"
 #include "inet/inet.h"
 #include "udp/udp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -75,6 +77,20 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* Without the hash table, the candidates for a match are simply all active
+ * connections.
+ */
+
+#ifdef CONFIG_NET_HASH_CONNS
+#  define udp_port_hash(lport) net_hash_mix(0, lport)
+#else
+#  define udp_port_hash(lport) 0
+#  define udp_port_first(hash) \
+     ((FAR struct udp_conn_s *)g_active_udp_connections.head)
+#  define udp_port_next(conn) \
+     ((FAR struct udp_conn_s *)(conn)->sconn.node.flink)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,10 +110,58 @@ static sem_t g_free_sem = SEM_INITIALIZER(1);
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_HASH_CONNS
+/* The active connections with a local port, hashed on that port */
+
+static struct net_htable_s g_udp_port_hash;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_HASH_CONNS
+/****************************************************************************
+ * Name: udp_port_match
+ *
+ * Description:
+ *   Skip the nodes of the hash bucket that have a different hash value.
+ *
+ ****************************************************************************/
+
+static FAR struct udp_conn_s *udp_port_match(FAR struct net_hnode_s *node,
+                                             uint32_t hash)
+{
+  while (node != NULL && node->hash != hash)
+    {
+      node = net_hash_next(&g_udp_port_hash, node, hash);
+    }
+
+  return node ? container_of(node, struct udp_conn_s, pnode) : NULL;
+}
+
+/****************************************************************************
+ * Name: udp_port_first and udp_port_next
+ *
+ * Description:
+ *   Iterate over the connections with the hash value of a local port.
+ *
+ ****************************************************************************/
+
+static FAR struct udp_conn_s *udp_port_first(uint32_t hash)
+{
+  return udp_port_match(net_hash_first(&g_udp_port_hash, hash), hash);
+}
+
+static FAR struct udp_conn_s *udp_port_next(FAR struct udp_conn_s *conn)
+{
+  uint32_t hash = conn->pnode.hash;
+
+  return udp_port_match(net_hash_next(&g_udp_port_hash, &conn->pnode,
+                                      hash), hash);
+}
+#endif /* CONFIG_NET_HASH_CONNS */
+
 /****************************************************************************
  * Name: _udp_semtake() and _udp_semgive()
  *
@@ -128,11 +192,13 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             FAR union ip_binding_u *ipaddr,
                                             uint16_t portno)
 {
-  FAR struct udp_conn_s *conn = NULL;
+  FAR struct udp_conn_s *conn;
 
   /* Now search each connection structure. */
 
-  while ((conn = udp_nextconn(conn)) != NULL)
+  for (conn = udp_port_first(udp_port_hash(portno));
+       conn != NULL;
+       conn = udp_port_next(conn))
     {
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
@@ -194,7 +260,7 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  conn = udp_port_first(udp_port_hash(udp->destport));
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -307,7 +373,7 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = udp_port_next(conn);
     }
 
   return conn;
@@ -333,7 +399,7 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  conn = udp_port_first(udp_port_hash(udp->destport));
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -446,7 +512,7 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = udp_port_next(conn);
     }
 
   return conn;
@@ -567,6 +633,36 @@ uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
   return portno;
 }
 
+/****************************************************************************
+ * Name: udp_set_lport
+ *
+ * Description:
+ *   Set the local port number (network byte order) of a connection.
+ *
+ ****************************************************************************/
+
+void udp_set_lport(FAR struct udp_conn_s *conn, uint16_t lport)
+{
+#ifdef CONFIG_NET_HASH_CONNS
+  net_lock();
+
+  if (conn->lport != 0)
+    {
+      net_hash_remove(&g_udp_port_hash, &conn->pnode);
+    }
+
+  if (lport != 0)
+    {
+      net_hash_insert(&g_udp_port_hash, &conn->pnode, udp_port_hash(lport));
+    }
+
+  conn->lport = lport;
+  net_unlock();
+#else
+  conn->lport = lport;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_initialize
  *
@@ -669,7 +765,7 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
-  conn->lport = 0;
+  udp_set_lport(conn, 0);
 
   /* Remove the connection from the active list */
 
@@ -829,7 +925,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_set_lport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
       ret         = OK;
     }
   else
@@ -846,7 +942,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_set_lport(conn, portno);
           ret         = OK;
         }
       else
@@ -899,7 +995,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_set_lport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
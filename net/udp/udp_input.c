@@ -135,7 +135,7 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
   chksum = udp->udpchksum;
-  if (chksum != 0)
+  if (chksum != 0 && !NETDEV_HAS_FEATURE(dev, NETDEV_F_RXCSUM))
     {
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
@@ -30,6 +30,10 @@
 #include <debug.h>
 #include <assert.h>
 
+#ifdef CONFIG_NET_TIMESTAMPING
+#  include <net/net_tstamp.h>
+#endif
+
 #include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
 #include <nuttx/mm/iob.h>
@@ -67,6 +71,10 @@ struct udp_recvfrom_s
   FAR socklen_t           *ir_fromlen;   /* Number of bytes allocated for address of sender */
   ssize_t                  ir_recvlen;   /* The received length */
   int                      ir_result;    /* Success:OK, failure:negated errno */
+#ifdef CONFIG_NET_TIMESTAMPING
+  bool                     ir_tstamped;  /* ir_tstamp holds the timestamps */
+  struct scm_timestamping  ir_tstamp;    /* Receive timestamps */
+#endif
 };
 
 /****************************************************************************
@@ -195,6 +203,8 @@ static inline void udp_readahead(struct udp_recvfrom_s *pstate)
     {
       FAR struct iob_s *tmp;
       uint8_t src_addr_size;
+      uint8_t rechdr;
+      unsigned int hdrlen;
 
       DEBUGASSERT(iob->io_pktlen > 0);
 
@@ -202,12 +212,27 @@ static inline void udp_readahead(struct udp_recvfrom_s *pstate)
        * the user buffer.
        */
 
-      recvlen = iob_copyout(&src_addr_size, iob, sizeof(uint8_t), 0);
+      recvlen = iob_copyout(&rechdr, iob, sizeof(uint8_t), 0);
       if (recvlen != sizeof(uint8_t))
         {
           goto out;
         }
 
+      src_addr_size = rechdr & UDP_RECHDR_ADDRMASK;
+      hdrlen        = sizeof(uint8_t) + src_addr_size;
+
+#ifdef CONFIG_NET_TIMESTAMPING
+      /* Get the receive timestamps that follow the source address */
+
+      if ((rechdr & UDP_RECHDR_TSTAMP) != 0)
+        {
+          recvlen = iob_copyout((FAR uint8_t *)&pstate->ir_tstamp, iob,
+                                sizeof(struct scm_timestamping), hdrlen);
+          pstate->ir_tstamped = recvlen == sizeof(struct scm_timestamping);
+          hdrlen += sizeof(struct scm_timestamping);
+        }
+#endif
+
       if (0
 #ifdef CONFIG_NET_IPv6
           || src_addr_size == sizeof(struct sockaddr_in6)
@@ -235,7 +260,7 @@ static inline void udp_readahead(struct udp_recvfrom_s *pstate)
       if (pstate->ir_buflen > 0)
         {
           recvlen = iob_copyout(pstate->ir_buffer, iob, pstate->ir_buflen,
-                                src_addr_size + sizeof(uint8_t));
+                                hdrlen);
 
           ninfo("Received %d bytes (of %d)\n", recvlen, iob->io_pktlen);
 
@@ -454,6 +479,11 @@ static uint16_t udp_eventhandler(FAR struct net_driver_s *dev,
 
           udp_newdata(dev, pstate);
 
+#ifdef CONFIG_NET_TIMESTAMPING
+          pstate->ir_tstamped = udp_rxtstamp(dev, pstate->ir_conn,
+                                             &pstate->ir_tstamp);
+#endif
+
           /* We are finished. */
 
           ninfo("UDP done\n");
@@ -572,6 +602,50 @@ static ssize_t udp_recvfrom_result(int result, struct udp_recvfrom_s *pstate)
   return pstate->ir_recvlen;
 }
 
+/****************************************************************************
+ * Name: udp_recvfrom_tstamp
+ *
+ * Description:
+ *   Return the receive timestamps of the datagram, if any, as an
+ *   SCM_TIMESTAMPING control message.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMPING
+static void udp_recvfrom_tstamp(FAR struct msghdr *msg,
+                                FAR struct udp_recvfrom_s *pstate)
+{
+  FAR struct cmsghdr *cmsg;
+
+  if (msg->msg_control == NULL)
+    {
+      return;
+    }
+
+  if (!pstate->ir_tstamped)
+    {
+      msg->msg_controllen = 0;
+      return;
+    }
+
+  if (msg->msg_controllen < CMSG_SPACE(sizeof(struct scm_timestamping)))
+    {
+      msg->msg_flags     |= MSG_CTRUNC;
+      msg->msg_controllen = 0;
+      return;
+    }
+
+  cmsg             = CMSG_FIRSTHDR(msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type  = SCM_TIMESTAMPING;
+  cmsg->cmsg_len   = CMSG_LEN(sizeof(struct scm_timestamping));
+  memcpy(CMSG_DATA(cmsg), &pstate->ir_tstamp,
+         sizeof(struct scm_timestamping));
+
+  msg->msg_controllen = CMSG_SPACE(sizeof(struct scm_timestamping));
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -584,9 +658,8 @@ static ssize_t udp_recvfrom_result(int result, struct udp_recvfrom_s *pstate)
  *
  * Input Parameters:
  *   psock  Pointer to the socket structure for the SOCK_DRAM socket
- *   buf    Buffer to receive data
- *   len    Length of buffer
- *   from   INET address of source (may be NULL)
+ *   msg    Receive buffer, source address (may be NULL) and control data
+ *   flags  Receive flags
  *
  * Returned Value:
  *   On success, returns the number of characters received.  On  error,
@@ -596,11 +669,14 @@ static ssize_t udp_recvfrom_result(int result, struct udp_recvfrom_s *pstate)
  *
  ****************************************************************************/
 
-ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
-                           size_t len, int flags, FAR struct sockaddr *from,
-                           FAR socklen_t *fromlen)
+ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
+                           int flags)
 {
   FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
+  FAR void *buf = msg->msg_iov->iov_base;
+  size_t len = msg->msg_iov->iov_len;
+  FAR struct sockaddr *from = msg->msg_name;
+  FAR socklen_t *fromlen = &msg->msg_namelen;
   FAR struct net_driver_s *dev;
   struct udp_recvfrom_s state;
   int ret;
@@ -693,6 +769,13 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
         }
     }
 
+#ifdef CONFIG_NET_TIMESTAMPING
+  if (ret >= 0)
+    {
+      udp_recvfrom_tstamp(msg, &state);
+    }
+#endif
+
   net_unlock();
   udp_recvfrom_uninitialize(&state);
   return ret;
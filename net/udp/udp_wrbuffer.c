@@ -269,7 +269,7 @@ uint32_t udp_wrbuffer_inqueue_size(FAR struct udp_conn_s *conn)
       for (entry = sq_peek(&conn->write_q); entry; entry = sq_next(entry))
         {
           wrb = (FAR struct udp_wrbuffer_s *)entry;
-          total += wrb->wb_iob->io_pktlen;
+          total += NET_IOB_CHARGE(wrb->wb_iob);
         }
     }
 
@@ -41,6 +41,7 @@
 #include <nuttx/random.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/usrsock.h>
 
@@ -55,10 +56,30 @@
 #  define CONFIG_NET_USRSOCKDEV_NPOLLWAITERS 1
 #endif
 
+#ifdef CONFIG_NET_USRSOCK_RING
+#  if (CONFIG_NET_USRSOCK_RING_ENTRIES & \
+       (CONFIG_NET_USRSOCK_RING_ENTRIES - 1)) != 0
+#    error CONFIG_NET_USRSOCK_RING_ENTRIES must be a power of two
+#  endif
+
+#  define USRSOCK_RING_MASK (CONFIG_NET_USRSOCK_RING_ENTRIES - 1)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_NET_USRSOCK_RING
+/* A request queued in the submission ring */
+
+struct usrsockdev_slot_s
+{
+  bool     busy;                 /* The slot is in use */
+  uint64_t xid;                  /* Exchange id waiting for ack or 0 */
+  sem_t    acksem;               /* Request acknowledgment notification */
+};
+#endif
+
 struct usrsockdev_s
 {
   sem_t   devsem;     /* Lock for device node */
@@ -80,6 +101,18 @@ struct usrsockdev_s
   FAR struct usrsock_conn_s *datain_conn; /* Connection instance to receive
                                            * data buffers. */
   struct pollfd *pollfds[CONFIG_NET_USRSOCKDEV_NPOLLWAITERS];
+
+#ifdef CONFIG_NET_USRSOCK_RING
+  struct
+  {
+    FAR struct usrsock_ring_s *ring; /* Rings set up by the daemon or NULL */
+    sem_t     sem;                   /* Counts the free request slots */
+
+    /* One slot per outstanding request */
+
+    struct usrsockdev_slot_s slot[CONFIG_NET_USRSOCK_RING_ENTRIES];
+  } ring;
+#endif
 };
 
 /****************************************************************************
@@ -101,6 +134,11 @@ static int usrsockdev_open(FAR struct file *filep);
 
 static int usrsockdev_close(FAR struct file *filep);
 
+#ifdef CONFIG_NET_USRSOCK_RING
+static int usrsockdev_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg);
+#endif
+
 static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
                            bool setup);
 
@@ -115,7 +153,11 @@ static const struct file_operations g_usrsockdevops =
   usrsockdev_read,    /* read */
   usrsockdev_write,   /* write */
   usrsockdev_seek,    /* seek */
+#ifdef CONFIG_NET_USRSOCK_RING
+  usrsockdev_ioctl,   /* ioctl */
+#else
   NULL,               /* ioctl */
+#endif
   usrsockdev_poll     /* poll */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL              /* unlink */
@@ -296,7 +338,7 @@ static void usrsockdev_pollnotify(FAR struct usrsockdev_s *dev,
           if (fds->revents != 0)
             {
               ninfo("Report events: %08" PRIx32 "\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, 0);
             }
         }
     }
@@ -681,6 +723,32 @@ unlock_out:
   return ret;
 }
 
+#ifdef CONFIG_NET_USRSOCK_RING
+/****************************************************************************
+ * Name: usrsockdev_ring_ack
+ *
+ * Description:
+ *   Wake up the thread that queued the request with exchange id xid in the
+ *   submission ring.  Only the first response to a request does that.
+ *
+ ****************************************************************************/
+
+static void usrsockdev_ring_ack(FAR struct usrsockdev_s *dev, uint64_t xid)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NET_USRSOCK_RING_ENTRIES; i++)
+    {
+      if (dev->ring.slot[i].busy && dev->ring.slot[i].xid == xid)
+        {
+          dev->ring.slot[i].xid = 0;
+          nxsem_post(&dev->ring.slot[i].acksem);
+          break;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: usrsockdev_handle_req_response
  ****************************************************************************/
@@ -750,6 +818,12 @@ static ssize_t usrsockdev_handle_req_response(FAR struct usrsockdev_s *dev,
 
       nxsem_post(&dev->req.acksem);
     }
+#ifdef CONFIG_NET_USRSOCK_RING
+  else
+    {
+      usrsockdev_ring_ack(dev, hdr->xid);
+    }
+#endif
 
   ret = handle_response(dev, conn, buffer);
 
@@ -782,40 +856,22 @@ static ssize_t usrsockdev_handle_message(FAR struct usrsockdev_s *dev,
 }
 
 /****************************************************************************
- * Name: usrsockdev_write
+ * Name: usrsockdev_input
+ *
+ * Description:
+ *   Handle the next part of the message stream from the daemon: a message
+ *   header, the data following it, or both.  Returns the number of bytes
+ *   used.  The caller holds devsem.
+ *
  ****************************************************************************/
 
-static ssize_t usrsockdev_write(FAR struct file *filep,
+static ssize_t usrsockdev_input(FAR struct usrsockdev_s *dev,
                                 FAR const char *buffer, size_t len)
 {
-  FAR struct inode *inode = filep->f_inode;
   FAR struct usrsock_conn_s *conn;
-  FAR struct usrsockdev_s *dev;
   size_t origlen = len;
   ssize_t ret = 0;
 
-  if (len == 0)
-    {
-      return 0;
-    }
-
-  if (buffer == NULL)
-    {
-      return -EINVAL;
-    }
-
-  DEBUGASSERT(inode);
-
-  dev = inode->i_private;
-
-  DEBUGASSERT(dev);
-
-  ret = (ssize_t)usrsockdev_semtake(&dev->devsem);
-  if (ret < 0)
-    {
-      return ret;
-    }
-
   if (!dev->datain_conn)
     {
       /* Start of message, buffer length should be at least size of common
@@ -827,8 +883,7 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
           nwarn("message too short, %zu < %zu.\n", len,
                 sizeof(struct usrsock_message_common_s));
 
-          ret = -EINVAL;
-          goto errout;
+          return -EINVAL;
         }
 
       /* Handle message. */
@@ -879,7 +934,44 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
         }
     }
 
-errout:
+  return ret;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_write
+ ****************************************************************************/
+
+static ssize_t usrsockdev_write(FAR struct file *filep,
+                                FAR const char *buffer, size_t len)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_s *dev;
+  ssize_t ret;
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  if (buffer == NULL)
+    {
+      return -EINVAL;
+    }
+
+  DEBUGASSERT(inode);
+
+  dev = inode->i_private;
+
+  DEBUGASSERT(dev);
+
+  ret = (ssize_t)usrsockdev_semtake(&dev->devsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = usrsockdev_input(dev, buffer, len);
+
   usrsockdev_semgive(&dev->devsem);
   return ret;
 }
@@ -941,6 +1033,9 @@ static int usrsockdev_close(FAR struct file *filep)
   FAR struct usrsock_conn_s *conn = NULL;
   FAR struct usrsockdev_s *dev;
   int ret;
+#ifdef CONFIG_NET_USRSOCK_RING
+  int i;
+#endif
 
   DEBUGASSERT(inode);
 
@@ -973,6 +1068,12 @@ static int usrsockdev_close(FAR struct file *filep)
   DEBUGASSERT(dev->ocount == 0);
   ret = OK;
 
+#ifdef CONFIG_NET_USRSOCK_RING
+  /* The rings belong to the daemon, stop using them */
+
+  dev->ring.ring = NULL;
+#endif
+
   do
     {
       /* Give other threads short time window to complete recently completed
@@ -1002,6 +1103,17 @@ static int usrsockdev_close(FAR struct file *filep)
 
       dev->req.iov = NULL;
       nxsem_post(&dev->req.acksem);
+
+#ifdef CONFIG_NET_USRSOCK_RING
+      for (i = 0; i < CONFIG_NET_USRSOCK_RING_ENTRIES; i++)
+        {
+          if (dev->ring.slot[i].busy && dev->ring.slot[i].xid != 0)
+            {
+              dev->ring.slot[i].xid = 0;
+              nxsem_post(&dev->ring.slot[i].acksem);
+            }
+        }
+#endif
     }
   while (true);
 
@@ -1019,6 +1131,196 @@ static int usrsockdev_close(FAR struct file *filep)
   return ret;
 }
 
+#ifdef CONFIG_NET_USRSOCK_RING
+/****************************************************************************
+ * Name: usrsockdev_ring_setup
+ *
+ * Description:
+ *   Switch to the rings set up by the daemon, or back to read() and write()
+ *   if ring is NULL.  The caller holds devsem and the network lock.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_ring_setup(FAR struct usrsockdev_s *dev,
+                                 FAR struct usrsock_ring_s *ring)
+{
+  if (dev->req.nbusy > 0)
+    {
+      return -EBUSY;
+    }
+
+  if (ring != NULL)
+    {
+      ring->sq_head = 0;
+      ring->sq_tail = 0;
+      ring->cq_head = 0;
+      ring->cq_tail = 0;
+    }
+
+  dev->ring.ring = ring;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_ring_enter
+ *
+ * Description:
+ *   Process the messages that the daemon has queued in the completion
+ *   ring.  A message may be split over several entries just like over
+ *   several write() calls.  The caller holds devsem and the network lock.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_ring_enter(FAR struct usrsockdev_s *dev)
+{
+  FAR struct usrsock_ring_s *ring = dev->ring.ring;
+  FAR struct usrsock_ring_cqe_s *cqe;
+  ssize_t ret;
+  int count = 0;
+
+  if (ring == NULL)
+    {
+      return -EINVAL;
+    }
+
+  while (ring->cq_head != ring->cq_tail)
+    {
+      /* Read the entry only after the tail that covers it */
+
+      SP_DMB();
+
+      cqe = &ring->cq[ring->cq_head & USRSOCK_RING_MASK];
+      if (cqe->msg != NULL && cqe->len > 0)
+        {
+          ret = usrsockdev_input(dev, cqe->msg, cqe->len);
+          if (ret < 0)
+            {
+              nwarn("WARNING: Bad message in completion ring: %zd\n", ret);
+            }
+        }
+
+      ring->cq_head++;
+      count++;
+    }
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_ioctl
+ ****************************************************************************/
+
+static int usrsockdev_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_s *dev;
+  int ret;
+
+  DEBUGASSERT(inode);
+
+  dev = inode->i_private;
+
+  DEBUGASSERT(dev);
+
+  ret = usrsockdev_semtake(&dev->devsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* All completions of one USRSOCKIOC_RINGENTER are handled with a
+   * single network lock.
+   */
+
+  net_lock();
+
+  switch (cmd)
+    {
+      case USRSOCKIOC_RINGSETUP:
+        ret = usrsockdev_ring_setup(dev,
+                                    (FAR struct usrsock_ring_s *)arg);
+        break;
+
+      case USRSOCKIOC_RINGENTER:
+        ret = usrsockdev_ring_enter(dev);
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  net_unlock();
+  usrsockdev_semgive(&dev->devsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_ring_request
+ *
+ * Description:
+ *   Queue a request in the submission ring and wait until the daemon has
+ *   acknowledged it.  The network lock is held and is released while
+ *   waiting.
+ *
+ ****************************************************************************/
+
+static void usrsockdev_ring_request(FAR struct usrsockdev_s *dev,
+                                    FAR struct iovec *iov,
+                                    unsigned int iovcnt, uint64_t xid)
+{
+  FAR struct usrsock_ring_sqe_s *sqe;
+  FAR struct usrsock_ring_s *ring;
+  size_t len = 0;
+  unsigned int i;
+  int slot;
+
+  /* Wait for a free request slot.  There are as many slots as entries in
+   * the submission ring, so the ring cannot overflow.
+   */
+
+  net_lockedwait_uninterruptible(&dev->ring.sem);
+
+  ring = dev->ring.ring;
+  if (!usrsockdev_is_opened(dev) || ring == NULL)
+    {
+      ninfo("daemon abruptly closed /dev/usrsock.\n");
+      usrsockdev_semgive(&dev->ring.sem);
+      return;
+    }
+
+  for (slot = 0; dev->ring.slot[slot].busy; slot++);
+  DEBUGASSERT(slot < CONFIG_NET_USRSOCK_RING_ENTRIES);
+
+  dev->ring.slot[slot].busy = true;
+  dev->ring.slot[slot].xid  = xid;
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
+
+  sqe         = &ring->sq[ring->sq_tail & USRSOCK_RING_MASK];
+  sqe->iov    = iov;
+  sqe->iovcnt = iovcnt;
+  sqe->len    = len;
+
+  /* Make the entry visible before the new tail */
+
+  SP_DMB();
+  ring->sq_tail++;
+
+  /* Notify daemon of new request and wait for the ack */
+
+  usrsockdev_pollnotify(dev, POLLIN);
+  net_lockedwait_uninterruptible(&dev->ring.slot[slot].acksem);
+
+  dev->ring.slot[slot].busy = false;
+  usrsockdev_semgive(&dev->ring.sem);
+}
+#endif
+
 /****************************************************************************
  * Name: usrsockdev_poll
  ****************************************************************************/
@@ -1094,6 +1396,16 @@ static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
           eventset |= POLLIN;
         }
 
+#ifdef CONFIG_NET_USRSOCK_RING
+      /* Or if there are requests in the submission ring */
+
+      if (dev->ring.ring != NULL &&
+          dev->ring.ring->sq_head != dev->ring.ring->sq_tail)
+        {
+          eventset |= POLLIN;
+        }
+#endif
+
       if (eventset)
         {
           usrsockdev_pollnotify(dev, eventset);
@@ -1163,6 +1475,20 @@ int usrsockdev_do_request(FAR struct usrsock_conn_s *conn,
 
   ++dev->req.nbusy; /* net_lock held. */
 
+#ifdef CONFIG_NET_USRSOCK_RING
+  if (dev->ring.ring != NULL)
+    {
+      /* Requests of other connections may be outstanding at the same
+       * time.
+       */
+
+      usrsockdev_ring_request(dev, iov, iovcnt, req_head->xid);
+
+      --dev->req.nbusy; /* net_lock held. */
+      return OK;
+    }
+#endif
+
   /* Set outstanding request for daemon to handle. */
 
   net_lockedwait_uninterruptible(&dev->req.sem);
@@ -1208,6 +1534,10 @@ int usrsockdev_do_request(FAR struct usrsock_conn_s *conn,
 
 void usrsockdev_register(void)
 {
+#ifdef CONFIG_NET_USRSOCK_RING
+  int i;
+#endif
+
   /* Initialize device private structure. */
 
   g_usrsockdev.ocount = 0;
@@ -1217,6 +1547,15 @@ void usrsockdev_register(void)
   nxsem_init(&g_usrsockdev.req.acksem, 0, 0);
   nxsem_set_protocol(&g_usrsockdev.req.acksem, SEM_PRIO_NONE);
 
+#ifdef CONFIG_NET_USRSOCK_RING
+  nxsem_init(&g_usrsockdev.ring.sem, 0, CONFIG_NET_USRSOCK_RING_ENTRIES);
+  for (i = 0; i < CONFIG_NET_USRSOCK_RING_ENTRIES; i++)
+    {
+      nxsem_init(&g_usrsockdev.ring.slot[i].acksem, 0, 0);
+      nxsem_set_protocol(&g_usrsockdev.ring.slot[i].acksem, SEM_PRIO_NONE);
+    }
+#endif
+
   register_driver("/dev/usrsock", &g_usrsockdevops, 0666,
                   &g_usrsockdev);
 }
@@ -36,6 +36,7 @@
 
 #include <sys/socket.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/usrsock.h>
 
@@ -118,7 +119,7 @@ static uint16_t poll_event(FAR struct net_driver_s *dev, FAR void *pvconn,
   if (eventset)
     {
       info->fds->revents |= eventset;
-      nxsem_post(info->fds->sem);
+      poll_notify(&info->fds, 1, 0);
     }
 
   return flags;
@@ -269,7 +270,7 @@ static int usrsock_pollsetup(FAR struct socket *psock,
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, 0);
     }
 
 errout_unlock:
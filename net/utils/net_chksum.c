@@ -25,8 +25,64 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The value of a 16-bit word loaded from memory when only its first (LO)
+ * or its second (HI) byte is b.
+ */
+
+#ifdef CONFIG_ENDIAN_BIG
+#  define CHKSUM_LOBYTE(b)  ((uint32_t)(b) << 8)
+#  define CHKSUM_HIBYTE(b)  ((uint32_t)(b))
+#else
+#  define CHKSUM_LOBYTE(b)  ((uint32_t)(b))
+#  define CHKSUM_HIBYTE(b)  ((uint32_t)(b) << 8)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum_swap
+ *
+ * Description:
+ *   Swap the bytes of a 16-bit one's complement sum.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM
+static inline uint16_t chksum_swap(uint16_t sum)
+{
+  return (uint16_t)((sum << 8) | (sum >> 8));
+}
+
+/****************************************************************************
+ * Name: chksum_fold
+ *
+ * Description:
+ *   Fold a wide sum of 16-bit words into a 16-bit one's complement sum by
+ *   adding back the carries.
+ *
+ ****************************************************************************/
+
+static inline uint16_t chksum_fold(uint64_t acc)
+{
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+  return (uint16_t)acc;
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -38,6 +94,12 @@
  *   Calculate the raw change sum over the memory region described by
  *   data and len.
  *
+ *   The data is summed a 32-bit word at a time in its memory byte order
+ *   into a 64-bit accumulator; the one's complement sum does not depend
+ *   on the byte order, so the bytes are only swapped once at the end
+ *   (RFC 1071, section 2).  An odd start address shifts every byte into
+ *   the other half of its 16-bit word, which is also undone by one swap.
+ *
  * Input Parameters:
  *   sum  - Partial calculations carried over from a previous call to
  *          chksum().  This should be zero on the first time that check
@@ -53,40 +115,93 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint32_t *words;
+  unsigned int nleft = len;
+  uint64_t acc = 0;
+  uint16_t result;
+  bool odd = false;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  if (nleft == 0)
+    {
+      return sum;
+    }
 
-  while (dataptr < last_byte)
+  /* Align the data to a 16-bit boundary.  The first byte is summed as the
+   * second byte of the preceding 16-bit word.
+   */
+
+  if (((uintptr_t)data & 1) != 0)
     {
-      /* At least two more bytes */
+      acc   = CHKSUM_HIBYTE(*data);
+      odd   = true;
+      data++;
+      nleft--;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  /* Then to a 32-bit boundary */
 
-      dataptr += 2;
+  if (((uintptr_t)data & 2) != 0 && nleft >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      nleft -= 2;
     }
 
-  if (dataptr == last_byte)
+  /* Sum 32 bytes per iteration.  The 64-bit accumulator cannot overflow
+   * for the at most 64 KiB of data.
+   */
+
+  words = (FAR const uint32_t *)data;
+  while (nleft >= 32)
+    {
+      acc   += words[0];
+      acc   += words[1];
+      acc   += words[2];
+      acc   += words[3];
+      acc   += words[4];
+      acc   += words[5];
+      acc   += words[6];
+      acc   += words[7];
+      words += 8;
+      nleft -= 32;
+    }
+
+  while (nleft >= 4)
+    {
+      acc   += *words++;
+      nleft -= 4;
+    }
+
+  /* Sum the remaining 16-bit word and byte */
+
+  data = (FAR const uint8_t *)words;
+  if (nleft >= 2)
+    {
+      acc   += *(FAR const uint16_t *)data;
+      data  += 2;
+      nleft -= 2;
+    }
+
+  if (nleft > 0)
+    {
+      acc += CHKSUM_LOBYTE(*data);
+    }
+
+  /* Convert the sum to the byte order of the network and add it to the
+   * sum carried over from a previous call (in host byte order).
+   */
+
+  result = chksum_fold(acc);
+  if (odd)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      result = chksum_swap(result);
     }
 
-  /* Return sum in host byte order. */
+#ifndef CONFIG_ENDIAN_BIG
+  result = chksum_swap(result);
+#endif
 
-  return sum;
+  return chksum_fold((uint32_t)sum + result);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
@@ -0,0 +1,300 @@
+/****************************************************************************
+ * net/utils/net_hash.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/kmalloc.h>
+
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_HASH_CONNS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Do not grow the tables beyond 1 << NET_HASH_MAXBITS buckets */
+
+#define NET_HASH_MAXBITS  14
+
+/* Number of buckets of the old table moved on each insertion/removal */
+
+#define NET_HASH_STEP     4
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_hash_bucket
+ *
+ * Description:
+ *   Return the bucket of table tbl that holds the given hash value.
+ *
+ ****************************************************************************/
+
+static inline FAR dq_queue_t *net_hash_bucket(FAR struct net_htable_s *ht,
+                                              int tbl, uint32_t hash)
+{
+  return &ht->ht_bucket[tbl][hash & ((UINT32_C(1) << ht->ht_bits[tbl]) - 1)];
+}
+
+/****************************************************************************
+ * Name: net_hash_oldbucket
+ *
+ * Description:
+ *   Return the bucket of the old table that may still hold nodes with the
+ *   given hash value, or NULL if there is none.
+ *
+ ****************************************************************************/
+
+static FAR dq_queue_t *net_hash_oldbucket(FAR struct net_htable_s *ht,
+                                          uint32_t hash)
+{
+  int old = ht->ht_cur ^ 1;
+  uint32_t ndx;
+
+  if (!ht->ht_resizing)
+    {
+      return NULL;
+    }
+
+  ndx = hash & ((UINT32_C(1) << ht->ht_bits[old]) - 1);
+  return ndx < ht->ht_migrate ? NULL : &ht->ht_bucket[old][ndx];
+}
+
+/****************************************************************************
+ * Name: net_hash_migrate
+ *
+ * Description:
+ *   Move the nodes of the next few buckets of the old table to the current
+ *   table and free the old table once it is empty.
+ *
+ ****************************************************************************/
+
+static void net_hash_migrate(FAR struct net_htable_s *ht)
+{
+  FAR struct net_hnode_s *node;
+  FAR dq_queue_t *bucket;
+  int old = ht->ht_cur ^ 1;
+  uint32_t nold = UINT32_C(1) << ht->ht_bits[old];
+  int i;
+
+  for (i = 0; i < NET_HASH_STEP && ht->ht_migrate < nold; i++)
+    {
+      /* Move the nodes from the tail so that they stay in front of any
+       * nodes inserted since the resizing started, in their original order.
+       */
+
+      bucket = &ht->ht_bucket[old][ht->ht_migrate++];
+      while ((node = (FAR struct net_hnode_s *)dq_remlast(bucket)) != NULL)
+        {
+          node->tbl = ht->ht_cur;
+          dq_addfirst(&node->node,
+                      net_hash_bucket(ht, ht->ht_cur, node->hash));
+        }
+    }
+
+  if (ht->ht_migrate >= nold)
+    {
+      if (ht->ht_bucket[old] != ht->ht_static)
+        {
+          kmm_free(ht->ht_bucket[old]);
+        }
+
+      ht->ht_bucket[old] = NULL;
+      ht->ht_resizing    = false;
+    }
+}
+
+/****************************************************************************
+ * Name: net_hash_grow
+ *
+ * Description:
+ *   Start moving to a table with twice the number of buckets.  If there is
+ *   no memory for it, just keep using the current table.
+ *
+ ****************************************************************************/
+
+static void net_hash_grow(FAR struct net_htable_s *ht)
+{
+  FAR dq_queue_t *table;
+  int next = ht->ht_cur ^ 1;
+  int bits = ht->ht_bits[ht->ht_cur] + 1;
+
+  table = kmm_malloc(sizeof(dq_queue_t) << bits);
+  if (table == NULL)
+    {
+      return;
+    }
+
+  memset(table, 0, sizeof(dq_queue_t) << bits);
+
+  ht->ht_bucket[next] = table;
+  ht->ht_bits[next]   = bits;
+  ht->ht_cur          = next;
+  ht->ht_migrate      = 0;
+  ht->ht_resizing     = true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_hash_mix
+ *
+ * Description:
+ *   Mix one 32-bit word of a key into a hash value.
+ *
+ ****************************************************************************/
+
+uint32_t net_hash_mix(uint32_t hash, uint32_t word)
+{
+  hash ^= word;
+  hash *= UINT32_C(0x9e3779b1);
+  return hash ^ (hash >> 15);
+}
+
+/****************************************************************************
+ * Name: net_hash_insert
+ *
+ * Description:
+ *   Add a node with the given hash value to the hash table.
+ *
+ ****************************************************************************/
+
+void net_hash_insert(FAR struct net_htable_s *ht,
+                     FAR struct net_hnode_s *node, uint32_t hash)
+{
+  /* Start with the statically allocated table */
+
+  if (ht->ht_bucket[ht->ht_cur] == NULL)
+    {
+      ht->ht_bucket[ht->ht_cur] = ht->ht_static;
+      ht->ht_bits[ht->ht_cur]   = NET_HASH_MINBITS;
+    }
+
+  if (ht->ht_resizing)
+    {
+      net_hash_migrate(ht);
+    }
+
+  node->hash = hash;
+  node->tbl  = ht->ht_cur;
+  dq_addlast(&node->node, net_hash_bucket(ht, ht->ht_cur, hash));
+
+  if (++ht->ht_count > (NET_HASH_LOAD << ht->ht_bits[ht->ht_cur]) &&
+      !ht->ht_resizing && ht->ht_bits[ht->ht_cur] < NET_HASH_MAXBITS)
+    {
+      net_hash_grow(ht);
+    }
+}
+
+/****************************************************************************
+ * Name: net_hash_remove
+ *
+ * Description:
+ *   Remove a node from the hash table.
+ *
+ ****************************************************************************/
+
+void net_hash_remove(FAR struct net_htable_s *ht,
+                     FAR struct net_hnode_s *node)
+{
+  DEBUGASSERT(ht->ht_count > 0 && ht->ht_bucket[node->tbl] != NULL);
+
+  dq_rem(&node->node, net_hash_bucket(ht, node->tbl, node->hash));
+  ht->ht_count--;
+
+  if (ht->ht_resizing)
+    {
+      net_hash_migrate(ht);
+    }
+}
+
+/****************************************************************************
+ * Name: net_hash_first
+ *
+ * Description:
+ *   Return the first node that may have the given hash value.
+ *
+ ****************************************************************************/
+
+FAR struct net_hnode_s *net_hash_first(FAR struct net_htable_s *ht,
+                                       uint32_t hash)
+{
+  FAR dq_queue_t *bucket;
+
+  if (ht->ht_bucket[ht->ht_cur] == NULL)
+    {
+      return NULL;
+    }
+
+  /* Nodes still in the old table are older, so return those first */
+
+  bucket = net_hash_oldbucket(ht, hash);
+  if (bucket == NULL || dq_peek(bucket) == NULL)
+    {
+      bucket = net_hash_bucket(ht, ht->ht_cur, hash);
+    }
+
+  return (FAR struct net_hnode_s *)dq_peek(bucket);
+}
+
+/****************************************************************************
+ * Name: net_hash_next
+ *
+ * Description:
+ *   Return the next node that may have the given hash value.
+ *
+ ****************************************************************************/
+
+FAR struct net_hnode_s *net_hash_next(FAR struct net_htable_s *ht,
+                                      FAR struct net_hnode_s *node,
+                                      uint32_t hash)
+{
+  if (node->node.flink != NULL)
+    {
+      return (FAR struct net_hnode_s *)node->node.flink;
+    }
+
+  /* At the end of the old bucket, continue with the current one */
+
+  if (node->tbl != ht->ht_cur)
+    {
+      return (FAR struct net_hnode_s *)
+        dq_peek(net_hash_bucket(ht, ht->ht_cur, hash));
+    }
+
+  return NULL;
+}
+
+#endif /* CONFIG_NET_HASH_CONNS */
@@ -37,6 +37,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
+#include <nuttx/net/netstats.h>
 
 #include "utils/utils.h"
 
@@ -69,7 +70,33 @@ static unsigned int g_count;
 
 static int _net_takesem(void)
 {
+#ifdef CONFIG_NET_STATISTICS
+  clock_t start;
+  int ret;
+
+  /* Count the cases where the lock was not free and how long it took to
+   * get it.  The statistics are only updated with the lock held.
+   */
+
+  if (nxsem_trywait(&g_netlock) >= 0)
+    {
+      g_netstats.lock.acquired++;
+      return OK;
+    }
+
+  start = clock_systime_ticks();
+  ret   = nxsem_wait_uninterruptible(&g_netlock);
+  if (ret >= 0)
+    {
+      g_netstats.lock.acquired++;
+      g_netstats.lock.contended++;
+      g_netstats.lock.waitticks += clock_systime_ticks() - start;
+    }
+
+  return ret;
+#else
   return nxsem_wait_uninterruptible(&g_netlock);
+#endif
 }
 
 /****************************************************************************
@@ -222,6 +249,10 @@ int net_trylock(void)
 
           g_holder = me;
           g_count  = 1;
+
+#ifdef CONFIG_NET_STATISTICS
+          g_netstats.lock.acquired++;
+#endif
         }
     }
 
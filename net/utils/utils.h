@@ -29,6 +29,45 @@
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_HASH_CONNS
+/* The initial (and minimum) number of buckets of a hash table is
+ * 1 << NET_HASH_MINBITS.  Tables grow when there are more than
+ * NET_HASH_LOAD nodes per bucket.
+ */
+
+#  define NET_HASH_MINBITS  4
+#  define NET_HASH_LOAD     2
+#endif
+
+/* The amount of buffer space charged against the buffer limit of a socket
+ * (SO_RCVBUF, SO_SNDBUF) for an I/O buffer chain or queue.  With
+ * CONFIG_NET_IOB_QUOTA each I/O buffer counts in full, however little data
+ * it holds.
+ */
+
+#ifdef CONFIG_NET_IOB_QUOTA
+#  define NET_IOB_CHARGE(iob)  (iob_count(iob) * CONFIG_IOB_BUFSIZE)
+#  define NET_IOBQ_CHARGE(q)   (iob_get_queue_count(q) * CONFIG_IOB_BUFSIZE)
+#else
+#  define NET_IOB_CHARGE(iob)  ((iob)->io_pktlen)
+#  define NET_IOBQ_CHARGE(q)   iob_get_queue_size(q)
+#endif
+
+/* The share of the free I/O buffers that the receive window of one TCP
+ * connection may offer
+ */
+
+#ifdef CONFIG_NET_IOB_QUOTA
+#  define NET_IOB_SHARE(n) \
+  (((n) + (1 << CONFIG_NET_IOB_SHARE_SHIFT) - 1) >> CONFIG_NET_IOB_SHARE_SHIFT)
+#else
+#  define NET_IOB_SHARE(n)     (n)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -42,6 +81,41 @@ enum tv2ds_remainder_e
   TV2DS_CEIL       /* Force to next larger full decisecond */
 };
 
+#ifdef CONFIG_NET_HASH_CONNS
+/* A node in a hash table, embedded in the connection structure */
+
+struct net_hnode_s
+{
+  dq_entry_t node;          /* Link in the hash bucket */
+  uint32_t   hash;          /* The full hash value of the key */
+  uint8_t    tbl;           /* The table (ht_bucket[] index) holding it */
+};
+
+/* A hash table of connections.  The table doubles in size when it becomes
+ * too loaded.  The nodes are then moved from the old to the new table a
+ * few buckets at a time on each later insertion and removal, so that no
+ * single operation has to rehash all connections.  While that is going on,
+ * lookups search both tables.
+ *
+ * Must be zero-initialized.
+ */
+
+struct net_htable_s
+{
+  FAR dq_queue_t *ht_bucket[2];  /* The current and, while resizing, the
+                                  * old table */
+  uint8_t  ht_bits[2];           /* log2 of the number of buckets */
+  uint8_t  ht_cur;               /* ht_bucket[] index of the current table */
+  bool     ht_resizing;          /* The old table is not yet empty */
+  uint32_t ht_migrate;           /* Next bucket of the old table to move */
+  size_t   ht_count;             /* Number of nodes in the table */
+
+  /* The initial table, so that no memory is needed for few connections */
+
+  dq_queue_t ht_static[1 << NET_HASH_MINBITS];
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -367,6 +441,71 @@ uint16_t icmp_chksum(FAR struct net_driver_s *dev, int len);
 uint16_t icmpv6_chksum(FAR struct net_driver_s *dev, unsigned int iplen);
 #endif
 
+/****************************************************************************
+ * Name: net_hash_mix
+ *
+ * Description:
+ *   Mix one 32-bit word of a key into a hash value.  A key is hashed by
+ *   starting with zero and mixing in each word of the key in turn.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_HASH_CONNS
+uint32_t net_hash_mix(uint32_t hash, uint32_t word);
+
+/****************************************************************************
+ * Name: net_hash_insert
+ *
+ * Description:
+ *   Add a node with the given hash value to the hash table.  This may
+ *   start growing the table and moves some nodes of a table that is being
+ *   resized.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void net_hash_insert(FAR struct net_htable_s *ht,
+                     FAR struct net_hnode_s *node, uint32_t hash);
+
+/****************************************************************************
+ * Name: net_hash_remove
+ *
+ * Description:
+ *   Remove a node from the hash table.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void net_hash_remove(FAR struct net_htable_s *ht,
+                     FAR struct net_hnode_s *node);
+
+/****************************************************************************
+ * Name: net_hash_first and net_hash_next
+ *
+ * Description:
+ *   Iterate over all nodes that may have the given hash value, oldest
+ *   first.  Nodes with other hash values may also be returned; the caller
+ *   must compare node->hash and then the key of each node.
+ *
+ *     for (node = net_hash_first(ht, hash); node != NULL;
+ *          node = net_hash_next(ht, node, hash))
+ *
+ * Assumptions:
+ *   The network is locked and the table is not modified while iterating.
+ *
+ ****************************************************************************/
+
+FAR struct net_hnode_s *net_hash_first(FAR struct net_htable_s *ht,
+                                       uint32_t hash);
+FAR struct net_hnode_s *net_hash_next(FAR struct net_htable_s *ht,
+                                      FAR struct net_hnode_s *node,
+                                      uint32_t hash);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -85,4 +85,14 @@ int  clock_abstime2ticks(clockid_t clockid,
                          FAR const struct timespec *abstime,
                          FAR sclock_t *ticks);
 
+#ifdef CONFIG_CLOCKSOURCE
+int  clocksource_getres(FAR struct timespec *res);
+#endif
+
+#ifdef CONFIG_CLOCK_VDSO
+void clock_vdso_update(void);
+#else
+#  define clock_vdso_update()
+#endif
+
 #endif /* __SCHED_CLOCK_CLOCK_H */
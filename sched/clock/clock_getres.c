@@ -58,6 +58,16 @@ int clock_getres(clockid_t clock_id, struct timespec *res)
         break;
 
       case CLOCK_MONOTONIC:
+      case CLOCK_MONOTONIC_RAW:
+#ifdef CONFIG_CLOCKSOURCE
+        if (clocksource_getres(res) >= 0)
+          {
+            break;
+          }
+#endif
+
+        /* Otherwise fall through to the resolution of the system timer */
+
       case CLOCK_BOOTTIME:
       case CLOCK_REALTIME:
 
@@ -73,13 +73,27 @@ int clock_gettime(clockid_t clock_id, struct timespec *tp)
    * is invoked with a clock_id argument of CLOCK_MONOTONIC."
    */
 
-  if (clock_id == CLOCK_MONOTONIC || clock_id == CLOCK_BOOTTIME)
+  if (clock_id == CLOCK_MONOTONIC || clock_id == CLOCK_BOOTTIME ||
+      clock_id == CLOCK_MONOTONIC_RAW)
     {
       /* The the time elapsed since the timer was initialized at power on
-       * reset.
+       * reset.  Read it from the hardware counter if one is registered,
+       * except for CLOCK_BOOTTIME: the counter may stop in low power
+       * modes.
        */
 
-      ret = clock_systime_timespec(tp);
+#ifdef CONFIG_CLOCKSOURCE
+      ret = -ENODEV;
+      if (clock_id != CLOCK_BOOTTIME)
+        {
+          ret = clocksource_gettime(tp);
+        }
+
+      if (ret < 0)
+#endif
+        {
+          ret = clock_systime_timespec(tp);
+        }
     }
 
   /* CLOCK_REALTIME - POSIX demands this to be present.  CLOCK_REALTIME
@@ -182,6 +182,8 @@ static void clock_inittime(FAR const struct timespec *tp)
       g_basetime.tv_nsec += NSEC_PER_SEC;
       g_basetime.tv_sec--;
     }
+
+  clock_vdso_update();
 #else
   clock_inittimekeeping(tp);
 #endif
@@ -396,6 +398,7 @@ void clock_resynchronize(FAR struct timespec *rtc_diff)
 
       g_system_timer += SEC2TICK(rtc_diff->tv_sec);
       g_system_timer += NSEC2TICK(rtc_diff->tv_nsec);
+      clock_vdso_update();
     }
 
 skip:
@@ -419,5 +422,9 @@ void clock_timer(void)
   /* Increment the per-tick system counter */
 
   g_system_timer++;
+
+  /* And publish it to user space */
+
+  clock_vdso_update();
 }
 #endif
@@ -0,0 +1,328 @@
+/****************************************************************************
+ * sched/clock/clock_source.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wdog.h>
+
+#include "clock/clock.h"
+
+#ifdef CONFIG_CLOCKSOURCE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The longest interval, in seconds, that the conversion is set up for.
+ * The watchdog folds the counter into the clock twice as often.
+ */
+
+#define CLOCKSOURCE_MAXSEC 600
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The registered counter */
+
+static FAR struct clocksource_s *volatile g_clocksource;
+
+/* The time at counter value g_cs_last, as seconds plus nanoseconds scaled
+ * by the shift of the counter.  Keeping the fraction of a nanosecond that
+ * the conversion leaves over makes each fold exact, so the clock never
+ * steps back.  Readers retry while g_cs_seq is odd or has changed.
+ */
+
+static volatile uint32_t g_cs_seq;
+static uint64_t          g_cs_last;
+static time_t            g_cs_sec;
+static uint64_t          g_cs_snsec;
+
+static spinlock_t        g_cs_lock;
+static struct wdog_s     g_cs_wdog;
+static sclock_t          g_cs_period;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clocksource_calc
+ *
+ * Description:
+ *   Choose the largest shift for which 'maxsec' seconds of cycles, times
+ *   the multiplier, stay below 2^63.  Then the scaled time of day plus a
+ *   converted interval never overflows 64 bits.
+ *
+ ****************************************************************************/
+
+static void clocksource_calc(FAR struct clocksource_s *cs, uint32_t freq,
+                             uint32_t maxsec)
+{
+  uint64_t tmp;
+  uint32_t sftacc = 31;
+  uint32_t sft;
+
+  tmp = ((uint64_t)maxsec * freq) >> 31;
+  while (tmp != 0)
+    {
+      tmp >>= 1;
+      sftacc--;
+    }
+
+  for (sft = 32; sft > 0; sft--)
+    {
+      tmp = (((uint64_t)NSEC_PER_SEC << sft) + freq / 2) / freq;
+      if ((tmp >> sftacc) == 0)
+        {
+          break;
+        }
+    }
+
+  cs->freq      = freq;
+  cs->mult      = (uint32_t)tmp;
+  cs->shift     = sft;
+  cs->maxcycles = (UINT64_MAX >> 1) / cs->mult;
+  if (cs->maxcycles > cs->mask)
+    {
+      cs->maxcycles = cs->mask;
+    }
+}
+
+/****************************************************************************
+ * Name: clocksource_fold
+ *
+ * Description:
+ *   Add the cycles counted since the last fold to the time of day.  The
+ *   caller holds g_cs_lock.
+ *
+ ****************************************************************************/
+
+static void clocksource_fold(FAR struct clocksource_s *cs)
+{
+  uint64_t limit = (uint64_t)NSEC_PER_SEC << cs->shift;
+  uint64_t now   = cs->read(cs);
+  uint64_t delta = (now - g_cs_last) & cs->mask;
+
+  g_cs_seq++;
+  SP_DMB();
+
+  g_cs_last   = now;
+  g_cs_snsec += delta * cs->mult;
+  while (g_cs_snsec >= limit)
+    {
+      g_cs_snsec -= limit;
+      g_cs_sec++;
+    }
+
+  SP_DMB();
+  g_cs_seq++;
+}
+
+/****************************************************************************
+ * Name: clocksource_timeout
+ *
+ * Description:
+ *   Fold the counter regularly so that it never wraps, nor exceeds the
+ *   interval the conversion is set up for, between two folds.
+ *
+ ****************************************************************************/
+
+static void clocksource_timeout(wdparm_t arg)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_cs_lock);
+  clocksource_fold(g_clocksource);
+  spin_unlock_irqrestore(&g_cs_lock, flags);
+
+  wd_start(&g_cs_wdog, g_cs_period, clocksource_timeout, 0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clocksource_register
+ *
+ * Description:
+ *   Make a free-running counter the time source of CLOCK_MONOTONIC and
+ *   CLOCK_MONOTONIC_RAW.
+ *
+ ****************************************************************************/
+
+int clocksource_register(FAR struct clocksource_s *cs, uint32_t freq)
+{
+  struct timespec ts;
+  irqstate_t flags;
+  uint64_t maxns;
+  uint32_t maxsec;
+
+  if (cs == NULL || cs->read == NULL || cs->mask == 0 || freq == 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Set up the conversion for the time the counter takes to wrap, within
+   * reason.
+   */
+
+  maxsec = cs->mask / freq;
+  if (maxsec > CLOCKSOURCE_MAXSEC)
+    {
+      maxsec = CLOCKSOURCE_MAXSEC;
+    }
+  else if (maxsec == 0)
+    {
+      maxsec = 1;
+    }
+
+  clocksource_calc(cs, freq, maxsec);
+
+  /* The watchdog must run at least once per half of that interval */
+
+  maxns = (cs->maxcycles >> 1) * cs->mult >> cs->shift;
+  if (maxns > (uint64_t)CLOCKSOURCE_MAXSEC * NSEC_PER_SEC / 2)
+    {
+      maxns = (uint64_t)CLOCKSOURCE_MAXSEC * NSEC_PER_SEC / 2;
+    }
+
+  g_cs_period = maxns / NSEC_PER_TICK;
+  if (g_cs_period < 1)
+    {
+      serr("ERROR: %s wraps too fast\n", cs->name ? cs->name : "counter");
+      return -EINVAL;
+    }
+
+  /* Continue from the current time so that the clocks do not jump */
+
+  if (clocksource_gettime(&ts) < 0)
+    {
+      clock_systime_timespec(&ts);
+    }
+
+  wd_cancel(&g_cs_wdog);
+
+  flags = spin_lock_irqsave(&g_cs_lock);
+
+  g_cs_seq++;
+  SP_DMB();
+
+  g_cs_last     = cs->read(cs);
+  g_cs_sec      = ts.tv_sec;
+  g_cs_snsec    = (uint64_t)ts.tv_nsec << cs->shift;
+  g_clocksource = cs;
+
+  SP_DMB();
+  g_cs_seq++;
+
+  spin_unlock_irqrestore(&g_cs_lock, flags);
+
+  sinfo("%s: freq=%" PRIu32 " mult=%" PRIu32 " shift=%" PRIu32 "\n",
+        cs->name ? cs->name : "counter", freq, cs->mult, cs->shift);
+
+  return wd_start(&g_cs_wdog, g_cs_period, clocksource_timeout, 0);
+}
+
+/****************************************************************************
+ * Name: clocksource_gettime
+ *
+ * Description:
+ *   Return the time since power up with the resolution of the registered
+ *   counter.
+ *
+ ****************************************************************************/
+
+int clocksource_gettime(FAR struct timespec *ts)
+{
+  FAR struct clocksource_s *cs;
+  uint64_t last;
+  uint64_t snsec;
+  uint64_t delta;
+  uint64_t nsec;
+  uint64_t now;
+  uint32_t seq;
+  time_t sec;
+
+  do
+    {
+      seq = g_cs_seq;
+      SP_DMB();
+
+      cs    = g_clocksource;
+      last  = g_cs_last;
+      sec   = g_cs_sec;
+      snsec = g_cs_snsec;
+      now   = cs != NULL ? cs->read(cs) : 0;
+
+      SP_DMB();
+    }
+  while ((seq & 1) != 0 || seq != g_cs_seq);
+
+  if (cs == NULL)
+    {
+      return -ENODEV;
+    }
+
+  delta = (now - last) & cs->mask;
+  nsec  = (snsec + delta * cs->mult) >> cs->shift;
+
+  ts->tv_sec  = sec + (time_t)(nsec / NSEC_PER_SEC);
+  ts->tv_nsec = (long)(nsec % NSEC_PER_SEC);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: clocksource_getres
+ *
+ * Description:
+ *   Return the resolution of the registered counter.
+ *
+ ****************************************************************************/
+
+int clocksource_getres(FAR struct timespec *res)
+{
+  FAR struct clocksource_s *cs = g_clocksource;
+
+  if (cs == NULL)
+    {
+      return -ENODEV;
+    }
+
+  res->tv_sec  = 0;
+  res->tv_nsec = (NSEC_PER_SEC + cs->freq - 1) / cs->freq;
+  return OK;
+}
+
+#endif /* CONFIG_CLOCKSOURCE */
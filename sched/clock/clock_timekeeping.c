@@ -27,6 +27,7 @@
 #ifdef CONFIG_CLOCK_TIMEKEEPING
 
 #include <sys/time.h>
+#include <sys/timex.h>
 #include <stdint.h>
 #include <time.h>
 #include <errno.h>
@@ -36,6 +37,7 @@
 #include <nuttx/arch.h>
 
 #include "clock/clock.h"
+#include "clock/clock_timekeeping.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -43,6 +45,12 @@
 
 #define NTP_MAX_ADJUST 500
 
+/* The largest frequency offset accepted by clock_adjtime(), in ppm scaled
+ * by 2^16.  It matches the slew rate of adjtime(), NTP_MAX_ADJUST us/s.
+ */
+
+#define NTP_MAX_FREQ   ((long)NTP_MAX_ADJUST << 16)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -51,11 +59,32 @@ static struct timespec g_clock_wall_time;
 static uint64_t        g_clock_last_counter;
 static uint64_t        g_clock_mask;
 static long            g_clock_adjust;
+static long            g_clock_freq;
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: clock_freq_correction
+ *
+ * Description:
+ *   Return the correction, in nanoseconds, that the frequency offset set
+ *   with clock_adjtime() adds to an interval of 'nsec' nanoseconds.  The
+ *   interval is split in milliseconds and the rest so that the product
+ *   with the scaled ppm offset cannot overflow.
+ *
+ ****************************************************************************/
+
+static int64_t clock_freq_correction(uint64_t nsec)
+{
+  int64_t msec = nsec / NSEC_PER_MSEC;
+  int64_t rem  = nsec % NSEC_PER_MSEC;
+
+  return (msec * g_clock_freq + rem * g_clock_freq / NSEC_PER_MSEC) /
+         65536;
+}
+
 /****************************************************************************
  * Name: clock_get_current_time
  ****************************************************************************/
@@ -80,6 +109,7 @@ static int clock_get_current_time(FAR struct timespec *ts,
 
   offset = (counter - g_clock_last_counter) & g_clock_mask;
   nsec   = offset * NSEC_PER_TICK;
+  nsec  += clock_freq_correction(nsec);
   sec    = nsec   / NSEC_PER_SEC;
   nsec  -= sec    * NSEC_PER_SEC;
 
@@ -202,6 +232,108 @@ int adjtime(FAR const struct timeval *delta, FAR struct timeval *olddelta)
   return OK;
 }
 
+/****************************************************************************
+ * Name: clock_adjtime
+ *
+ * Description:
+ *   Read and adjust CLOCK_REALTIME, as used by NTP and PTP daemons.
+ *
+ *   ADJ_SETOFFSET steps the clock by 'time', ADJ_OFFSET slews it by
+ *   'offset' like adjtime() and ADJ_FREQUENCY sets a lasting frequency
+ *   offset of 'freq' ppm, scaled by 2^16.  On return the structure holds
+ *   the current state of the clock.
+ *
+ ****************************************************************************/
+
+int clock_adjtime(clockid_t clk_id, FAR struct timex *buf)
+{
+  struct timespec ts;
+  irqstate_t flags;
+  long nsec;
+
+  if (clk_id != CLOCK_REALTIME || buf == NULL)
+    {
+      set_errno(EINVAL);
+      return -1;
+    }
+
+  if ((buf->modes & ADJ_FREQUENCY) != 0 &&
+      (buf->freq > NTP_MAX_FREQ || buf->freq < -NTP_MAX_FREQ))
+    {
+      set_errno(EINVAL);
+      return -1;
+    }
+
+  if ((buf->modes & ADJ_SETOFFSET) != 0)
+    {
+      nsec = buf->time.tv_usec;
+      if ((buf->modes & ADJ_NANO) == 0)
+        {
+          nsec *= NSEC_PER_USEC;
+        }
+
+      if (nsec < 0 || nsec >= NSEC_PER_SEC)
+        {
+          set_errno(EINVAL);
+          return -1;
+        }
+    }
+
+  /* Bring the wall time up to date with the current settings before any
+   * of them change.
+   */
+
+  clock_update_wall_time();
+
+  flags = enter_critical_section();
+
+  if ((buf->modes & ADJ_SETOFFSET) != 0)
+    {
+      g_clock_wall_time.tv_sec  += buf->time.tv_sec;
+      g_clock_wall_time.tv_nsec += nsec;
+      if (g_clock_wall_time.tv_nsec >= NSEC_PER_SEC)
+        {
+          g_clock_wall_time.tv_nsec -= NSEC_PER_SEC;
+          g_clock_wall_time.tv_sec++;
+        }
+    }
+
+  if ((buf->modes & ADJ_OFFSET) != 0)
+    {
+      g_clock_adjust = (buf->modes & ADJ_NANO) != 0 ?
+                       buf->offset / NSEC_PER_USEC : buf->offset;
+    }
+
+  if ((buf->modes & ADJ_FREQUENCY) != 0)
+    {
+      g_clock_freq = buf->freq;
+    }
+
+  /* Return the current state */
+
+  buf->offset    = (buf->modes & ADJ_NANO) != 0 ?
+                   g_clock_adjust * NSEC_PER_USEC : g_clock_adjust;
+  buf->freq      = g_clock_freq;
+  buf->status    = (buf->modes & ADJ_NANO) != 0 ? STA_NANO : 0;
+  buf->maxerror  = 0;
+  buf->esterror  = 0;
+  buf->constant  = 0;
+  buf->precision = USEC_PER_TICK;
+  buf->tolerance = NTP_MAX_FREQ;
+  buf->tick      = USEC_PER_TICK;
+
+  leave_critical_section(flags);
+
+  if (clock_timekeeping_get_wall_time(&ts) >= 0)
+    {
+      buf->time.tv_sec  = ts.tv_sec;
+      buf->time.tv_usec = (buf->modes & ADJ_NANO) != 0 ?
+                          ts.tv_nsec : ts.tv_nsec / NSEC_PER_USEC;
+    }
+
+  return TIME_OK;
+}
+
 /****************************************************************************
  * Name: clock_update_wall_time
  ****************************************************************************/
@@ -230,6 +362,7 @@ void clock_update_wall_time(void)
     }
 
   nsec  = offset * NSEC_PER_TICK;
+  nsec += clock_freq_correction(nsec);
   sec   = nsec / NSEC_PER_SEC;
   nsec -= sec * NSEC_PER_SEC;
 
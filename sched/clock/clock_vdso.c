@@ -0,0 +1,83 @@
+/****************************************************************************
+ * sched/clock/clock_vdso.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/userspace.h>
+
+#include "clock/clock.h"
+
+#ifdef CONFIG_CLOCK_VDSO
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_vdso_update
+ *
+ * Description:
+ *   Copy the system timer and the time-of-day base time to the structure
+ *   that is shared with user space.  This must be called whenever either
+ *   of them changes, that is from the timer interrupt and whenever the
+ *   base time is set.
+ *
+ ****************************************************************************/
+
+void clock_vdso_update(void)
+{
+  FAR struct clock_vdso_s *vdso = USERSPACE->us_clockvdso;
+  irqstate_t flags;
+
+  if (vdso == NULL)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+
+  /* An odd sequence number tells the readers that an update is in
+   * progress and that they must retry.
+   */
+
+  vdso->seq++;
+  SP_DMB();
+
+  vdso->ticks     = g_system_timer;
+  vdso->base_sec  = g_basetime.tv_sec;
+  vdso->base_nsec = g_basetime.tv_nsec;
+
+  SP_DMB();
+  vdso->seq++;
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_CLOCK_VDSO */
@@ -0,0 +1,74 @@
+/****************************************************************************
+ * sched/event/event.h
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __SCHED_EVENT_EVENT_H
+#define __SCHED_EVENT_EVENT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <queue.h>
+#include <semaphore.h>
+
+#include <nuttx/event.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Check whether the events that are set satisfy a wait */
+
+#define nxevent_satisfied(s,e,f) \
+  (((f) & NXEVENT_WAIT_ALL) != 0 ? ((s) & (e)) == (e) : ((s) & (e)) != 0)
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* This structure describes one task waiting for an event group.  It lives
+ * on the stack of the waiting task.
+ */
+
+struct nxevent_wait_s
+{
+  dq_entry_t node;                /* Node in the list of waiters */
+  nxevent_mask_t events;          /* The events to wait for */
+  nxevent_mask_t result;          /* The events that satisfied the wait */
+  uint8_t flags;                  /* See NXEVENT_WAIT_* definitions */
+  bool done;                      /* The wait was satisfied */
+  sem_t sem;                      /* Posted when the wait is satisfied */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#if CONFIG_SCHED_EVENTS_NPOLLWAITERS > 0
+void nxevent_pollnotify(FAR struct nxevent_s *event);
+#else
+#  define nxevent_pollnotify(e)
+#endif
+
+#endif /* __SCHED_EVENT_EVENT_H */
@@ -0,0 +1,69 @@
+/****************************************************************************
+ * sched/event/event_init.c
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include "event/event.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxevent_init
+ *
+ * Description:
+ *   Initialize an event group.
+ *
+ ****************************************************************************/
+
+void nxevent_init(FAR struct nxevent_s *event, nxevent_mask_t events)
+{
+  DEBUGASSERT(event != NULL);
+
+  memset(event, 0, sizeof(struct nxevent_s));
+  dq_init(&event->waiters);
+#ifdef CONFIG_SPINLOCK
+  spin_initialize(&event->lock, SP_UNLOCKED);
+#endif
+  event->events = events;
+}
+
+/****************************************************************************
+ * Name: nxevent_destroy
+ *
+ * Description:
+ *   Release an event group.  No task may wait for it.
+ *
+ ****************************************************************************/
+
+void nxevent_destroy(FAR struct nxevent_s *event)
+{
+  DEBUGASSERT(event != NULL && dq_empty(&event->waiters));
+  event->events = 0;
+}
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * sched/event/event_post.c
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/semaphore.h>
+
+#include "event/event.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxevent_post
+ *
+ * Description:
+ *   Set events and wake up every task whose wait is now satisfied.  This
+ *   may be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to set
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxevent_post(FAR struct nxevent_s *event, nxevent_mask_t events)
+{
+  FAR struct nxevent_wait_s *wait;
+  FAR dq_entry_t *curr;
+  FAR dq_entry_t *next;
+  nxevent_mask_t reset = 0;
+  dq_queue_t ready;
+  irqstate_t flags;
+
+  if (event == NULL)
+    {
+      return -EINVAL;
+    }
+
+  dq_init(&ready);
+
+  flags = spin_lock_irqsave(&event->lock);
+  event->events |= events;
+
+  /* Take every satisfied waiter off the list.  All of them see the same
+   * set of events; the events they asked to reset are cleared afterwards.
+   */
+
+  for (curr = dq_peek(&event->waiters); curr != NULL; curr = next)
+    {
+      next = dq_next(curr);
+      wait = (FAR struct nxevent_wait_s *)curr;
+
+      if (nxevent_satisfied(event->events, wait->events, wait->flags))
+        {
+          wait->result = event->events & wait->events;
+          wait->done   = true;
+          if ((wait->flags & NXEVENT_WAIT_RESET) != 0)
+            {
+              reset |= wait->events;
+            }
+
+          dq_rem(curr, &event->waiters);
+          dq_addlast(curr, &ready);
+        }
+    }
+
+  event->events &= ~reset;
+  spin_unlock_irqrestore(&event->lock, flags);
+
+  /* Wake up the waiters outside of the lock, nxsem_post() may need the
+   * critical section.
+   */
+
+  while ((curr = dq_remfirst(&ready)) != NULL)
+    {
+      wait = (FAR struct nxevent_wait_s *)curr;
+      nxsem_post(&wait->sem);
+    }
+
+  nxevent_pollnotify(event);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxevent_clear
+ *
+ * Description:
+ *   Clear events.  This may be called from interrupt handlers.
+ *
+ * Returned Value:
+ *   The events that were set before they were cleared.
+ *
+ ****************************************************************************/
+
+nxevent_mask_t nxevent_clear(FAR struct nxevent_s *event,
+                             nxevent_mask_t events)
+{
+  nxevent_mask_t old;
+  irqstate_t flags;
+
+  DEBUGASSERT(event != NULL);
+
+  flags = spin_lock_irqsave(&event->lock);
+  old = event->events;
+  event->events &= ~events;
+  spin_unlock_irqrestore(&event->lock, flags);
+
+  return old;
+}
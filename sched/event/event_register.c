@@ -0,0 +1,368 @@
+/****************************************************************************
+ * sched/event/event_register.c
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+
+#include "event/event.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open file of the driver */
+
+struct nxevent_file_s
+{
+  nxevent_mask_t events;          /* The events read() and poll() wait for */
+  uint8_t flags;                  /* See NXEVENT_WAIT_* definitions */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     event_open(FAR struct file *filep);
+static int     event_close(FAR struct file *filep);
+static ssize_t event_read(FAR struct file *filep, FAR char *buffer,
+                          size_t buflen);
+static ssize_t event_write(FAR struct file *filep, FAR const char *buffer,
+                           size_t buflen);
+static int     event_ioctl(FAR struct file *filep, int cmd,
+                           unsigned long arg);
+#if CONFIG_SCHED_EVENTS_NPOLLWAITERS > 0
+static int     event_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                          bool setup);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_event_fops =
+{
+  event_open,      /* open */
+  event_close,     /* close */
+  event_read,      /* read */
+  event_write,     /* write */
+  NULL,            /* seek */
+  event_ioctl,     /* ioctl */
+#if CONFIG_SCHED_EVENTS_NPOLLWAITERS > 0
+  event_poll       /* poll */
+#else
+  NULL             /* poll */
+#endif
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL           /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: event_open
+ ****************************************************************************/
+
+static int event_open(FAR struct file *filep)
+{
+  FAR struct nxevent_file_s *priv;
+
+  priv = kmm_malloc(sizeof(struct nxevent_file_s));
+  if (priv == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* By default any event makes the file readable */
+
+  priv->events  = ~(nxevent_mask_t)0;
+  priv->flags   = 0;
+  filep->f_priv = priv;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: event_close
+ ****************************************************************************/
+
+static int event_close(FAR struct file *filep)
+{
+  kmm_free(filep->f_priv);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: event_read
+ *
+ * Description:
+ *   Wait for the events selected with EVENTIOC_SETWAIT and return them.
+ *
+ ****************************************************************************/
+
+static ssize_t event_read(FAR struct file *filep, FAR char *buffer,
+                          size_t buflen)
+{
+  FAR struct nxevent_s *event = filep->f_inode->i_private;
+  FAR struct nxevent_file_s *priv = filep->f_priv;
+  nxevent_mask_t result;
+  int ret;
+
+  if (buffer == NULL || buflen < sizeof(nxevent_mask_t))
+    {
+      return -EINVAL;
+    }
+
+  ret = nxevent_tickwait(event, priv->events, priv->flags,
+                         (filep->f_oflags & O_NONBLOCK) != 0 ?
+                         0 : NXEVENT_WAIT_FOREVER, &result);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  *(FAR nxevent_mask_t *)buffer = result;
+  return sizeof(nxevent_mask_t);
+}
+
+/****************************************************************************
+ * Name: event_write
+ *
+ * Description:
+ *   Set the events given in the buffer.
+ *
+ ****************************************************************************/
+
+static ssize_t event_write(FAR struct file *filep, FAR const char *buffer,
+                           size_t buflen)
+{
+  FAR struct nxevent_s *event = filep->f_inode->i_private;
+  int ret;
+
+  if (buffer == NULL || buflen < sizeof(nxevent_mask_t))
+    {
+      return -EINVAL;
+    }
+
+  ret = nxevent_post(event, *(FAR const nxevent_mask_t *)buffer);
+  return ret < 0 ? ret : sizeof(nxevent_mask_t);
+}
+
+/****************************************************************************
+ * Name: event_ioctl
+ ****************************************************************************/
+
+static int event_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct nxevent_s *event = filep->f_inode->i_private;
+  FAR struct nxevent_file_s *priv = filep->f_priv;
+  FAR struct nxevent_waitreq_s *req;
+  uint32_t delay;
+  int ret = OK;
+
+  switch (cmd)
+    {
+      case EVENTIOC_POST:
+        ret = nxevent_post(event, (nxevent_mask_t)arg);
+        break;
+
+      case EVENTIOC_CLEAR:
+        nxevent_clear(event, (nxevent_mask_t)arg);
+        break;
+
+      case EVENTIOC_GET:
+        if (arg == 0)
+          {
+            return -EINVAL;
+          }
+
+        *(FAR nxevent_mask_t *)((uintptr_t)arg) = event->events;
+        break;
+
+      case EVENTIOC_SETWAIT:
+        req = (FAR struct nxevent_waitreq_s *)((uintptr_t)arg);
+        if (req == NULL || req->events == 0)
+          {
+            return -EINVAL;
+          }
+
+        priv->events = req->events;
+        priv->flags  = req->flags;
+
+        /* The file may have become readable */
+
+        nxevent_pollnotify(event);
+        break;
+
+      case EVENTIOC_WAIT:
+        req = (FAR struct nxevent_waitreq_s *)((uintptr_t)arg);
+        if (req == NULL)
+          {
+            return -EINVAL;
+          }
+
+        delay = req->timeout == NXEVENT_WAIT_FOREVER ?
+                NXEVENT_WAIT_FOREVER : MSEC2TICK(req->timeout);
+        ret   = nxevent_tickwait(event, req->events, req->flags, delay,
+                                 &req->result);
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: event_poll
+ ****************************************************************************/
+
+#if CONFIG_SCHED_EVENTS_NPOLLWAITERS > 0
+static int event_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                      bool setup)
+{
+  FAR struct nxevent_s *event = filep->f_inode->i_private;
+  FAR struct pollfd **slot;
+  irqstate_t flags;
+  int ret = OK;
+  int i;
+
+  flags = spin_lock_irqsave(&event->lock);
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_SCHED_EVENTS_NPOLLWAITERS; i++)
+        {
+          if (event->fds[i] == NULL)
+            {
+              event->fds[i] = fds;
+              fds->priv     = &event->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_SCHED_EVENTS_NPOLLWAITERS)
+        {
+          fds->priv = NULL;
+          ret       = -EBUSY;
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      slot      = (FAR struct pollfd **)fds->priv;
+      *slot     = NULL;
+      fds->priv = NULL;
+    }
+
+  spin_unlock_irqrestore(&event->lock, flags);
+
+  /* Report the events that are already set */
+
+  if (setup && ret == OK)
+    {
+      nxevent_pollnotify(event);
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxevent_pollnotify
+ *
+ * Description:
+ *   Notify the poll waiters whose events are set.  Writing is always
+ *   possible.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_EVENTS_NPOLLWAITERS > 0
+void nxevent_pollnotify(FAR struct nxevent_s *event)
+{
+  FAR struct nxevent_file_s *priv;
+  FAR struct pollfd *fds;
+  pollevent_t eventset;
+  irqstate_t flags;
+  int i;
+
+  for (i = 0; i < CONFIG_SCHED_EVENTS_NPOLLWAITERS; i++)
+    {
+      flags = spin_lock_irqsave(&event->lock);
+      fds   = event->fds[i];
+      if (fds == NULL)
+        {
+          spin_unlock_irqrestore(&event->lock, flags);
+          continue;
+        }
+
+      priv     = ((FAR struct file *)fds->ptr)->f_priv;
+      eventset = POLLOUT;
+      if (nxevent_satisfied(event->events, priv->events, priv->flags))
+        {
+          eventset |= POLLIN;
+        }
+
+      spin_unlock_irqrestore(&event->lock, flags);
+      poll_notify(&fds, 1, eventset);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxevent_register
+ *
+ * Description:
+ *   Register a character driver that gives user space access to an event
+ *   group.
+ *
+ * Input Parameters:
+ *   path  - The path of the driver, e.g. "/dev/event0"
+ *   event - The initialized event group
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxevent_register(FAR const char *path, FAR struct nxevent_s *event)
+{
+  DEBUGASSERT(path != NULL && event != NULL);
+  return register_driver(path, &g_event_fops, 0666, event);
+}
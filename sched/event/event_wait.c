@@ -0,0 +1,159 @@
+/****************************************************************************
+ * sched/event/event_wait.c
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/semaphore.h>
+
+#include "event/event.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxevent_tickwait
+ *
+ * Description:
+ *   Wait until any (or all, with NXEVENT_WAIT_ALL) of the given events are
+ *   set.  With NXEVENT_WAIT_RESET the awaited events are cleared before
+ *   returning.  This must not be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   event  - The event group
+ *   events - The events to wait for
+ *   flags  - See NXEVENT_WAIT_* definitions
+ *   delay  - The time to wait in ticks.  Zero does not wait at all and
+ *            NXEVENT_WAIT_FOREVER does not time out.
+ *   result - The location to return the awaited events that were set.
+ *            May be NULL.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure:
+ *
+ *     -EAGAIN    The events are not set and delay is zero
+ *     -ETIMEDOUT The events were not set in time
+ *     -EINTR     The wait was interrupted by a signal
+ *
+ ****************************************************************************/
+
+int nxevent_tickwait(FAR struct nxevent_s *event, nxevent_mask_t events,
+                     uint8_t flags, uint32_t delay,
+                     FAR nxevent_mask_t *result)
+{
+  struct nxevent_wait_s wait;
+  irqstate_t irqflags;
+  int ret;
+
+  if (event == NULL || events == 0)
+    {
+      return -EINVAL;
+    }
+
+  DEBUGASSERT(!up_interrupt_context());
+
+  /* Return at once if the events are already set */
+
+  irqflags = spin_lock_irqsave(&event->lock);
+  if (nxevent_satisfied(event->events, events, flags))
+    {
+      wait.result = event->events & events;
+      if ((flags & NXEVENT_WAIT_RESET) != 0)
+        {
+          event->events &= ~events;
+        }
+
+      spin_unlock_irqrestore(&event->lock, irqflags);
+      goto out;
+    }
+
+  if (delay == 0)
+    {
+      spin_unlock_irqrestore(&event->lock, irqflags);
+      return -EAGAIN;
+    }
+
+  /* Queue up and wait for nxevent_post() to satisfy the wait */
+
+  wait.events = events;
+  wait.result = 0;
+  wait.flags  = flags;
+  wait.done   = false;
+
+  nxsem_init(&wait.sem, 0, 0);
+  nxsem_set_protocol(&wait.sem, SEM_PRIO_NONE);
+
+  dq_addlast(&wait.node, &event->waiters);
+  spin_unlock_irqrestore(&event->lock, irqflags);
+
+  if (delay == NXEVENT_WAIT_FOREVER)
+    {
+      ret = nxsem_wait(&wait.sem);
+    }
+  else
+    {
+      ret = nxsem_tickwait(&wait.sem, delay);
+    }
+
+  if (ret < 0)
+    {
+      irqflags = spin_lock_irqsave(&event->lock);
+      if (!wait.done)
+        {
+          dq_rem(&wait.node, &event->waiters);
+        }
+
+      spin_unlock_irqrestore(&event->lock, irqflags);
+
+      /* If the events arrived while we timed out, nxevent_post() has
+       * already consumed them for us.  Take the wake-up so that it does
+       * not touch our stack after we return, and report success.
+       */
+
+      if (wait.done)
+        {
+          nxsem_wait_uninterruptible(&wait.sem);
+          ret = OK;
+        }
+    }
+
+  nxsem_destroy(&wait.sem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+out:
+  if (result != NULL)
+    {
+      *result = wait.result;
+    }
+
+  return OK;
+}
@@ -203,6 +203,16 @@ int group_signal(FAR struct task_group_s *group, FAR siginfo_t *siginfo)
 
   DEBUGASSERT(group && siginfo);
 
+  /* A group with a single member, by far the most common case, can only
+   * deliver the signal to that member.  Skip the search.
+   */
+
+  if (group->tg_nmembers == 1)
+    {
+      tcb = nxsched_get_tcb(group->tg_members[0]);
+      return tcb != NULL ? nxsig_tcbdispatch(tcb, siginfo) : -ECHILD;
+    }
+
   info.siginfo = siginfo;
   info.dtcb    = NULL;     /* Default, valid TCB */
   info.utcb    = NULL;     /* TCB with this signal unblocked */
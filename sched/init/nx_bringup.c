@@ -34,6 +34,7 @@
 #include <nuttx/board.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/init.h>
+#include <nuttx/initcall.h>
 #include <nuttx/symtab.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/kthread.h>
@@ -246,6 +247,14 @@ static inline void nx_start_application(void)
   board_late_initialize();
 #endif
 
+#ifdef CONFIG_INITCALL
+  /* Start the deferred initcalls registered by the board logic and wait
+   * for those needed by the init task.
+   */
+
+  initcall_run();
+#endif
+
 #if defined(CONFIG_INIT_ENTRY)
 
   /* Start the application initialization task.  In a flat build, this is
@@ -293,7 +302,7 @@ static inline void nx_start_application(void)
   attr.stacksize = CONFIG_INIT_STACKSIZE;
 #endif
   ret = exec_spawn(CONFIG_INIT_FILEPATH, argv, NULL,
-                   CONFIG_INIT_SYMTAB, CONFIG_INIT_NEXPORTS, &attr);
+                   CONFIG_INIT_SYMTAB, CONFIG_INIT_NEXPORTS, NULL, &attr);
   DEBUGASSERT(ret >= 0);
 #endif
 
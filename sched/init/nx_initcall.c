@@ -0,0 +1,508 @@
+/****************************************************************************
+ * sched/init/nx_initcall.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+#include <syslog.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/initcall.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_INITCALL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Initcall states.  Zero is the state of an initcall that has never been
+ * registered.
+ */
+
+#define INITCALL_UNREGISTERED  0
+#define INITCALL_PENDING       1
+#define INITCALL_RUNNING       2
+#define INITCALL_DONE          3
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The registered initcalls, in the order of registration */
+
+static sq_queue_t g_initcall_list;
+
+/* The initcall threads and the waiters sleep here until an initcall
+ * completes.  All of the state is protected by the critical section.
+ */
+
+static sem_t g_initcall_sem = SEM_INITIALIZER(0);
+static uint16_t g_initcall_nwaiters;
+
+static uint8_t g_initcall_nthreads;   /* Initcall threads still alive */
+static uint8_t g_initcall_nrunning;   /* Initcalls in progress */
+static bool g_initcall_started;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: initcall_wakeup
+ *
+ * Description:
+ *   Wake up all of the threads waiting for a change of state.
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+static void initcall_wakeup(void)
+{
+  while (g_initcall_nwaiters > 0)
+    {
+      g_initcall_nwaiters--;
+      nxsem_post(&g_initcall_sem);
+    }
+}
+
+/****************************************************************************
+ * Name: initcall_sleep
+ *
+ * Description:
+ *   Wait for the next change of state.
+ *
+ * Assumptions:
+ *   Called in the critical section, which is released while waiting.
+ *
+ ****************************************************************************/
+
+static void initcall_sleep(void)
+{
+  g_initcall_nwaiters++;
+  nxsem_wait_uninterruptible(&g_initcall_sem);
+}
+
+/****************************************************************************
+ * Name: initcall_complete
+ *
+ * Description:
+ *   Mark an initcall as done.
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+static void initcall_complete(FAR struct initcall_s *ic, int result)
+{
+  ic->result = result;
+  ic->state  = INITCALL_DONE;
+  initcall_wakeup();
+}
+
+/****************************************************************************
+ * Name: initcall_ready
+ *
+ * Description:
+ *   Check the dependencies of a pending initcall.  An initcall whose
+ *   dependencies can never succeed is completed with an error.
+ *
+ * Returned Value:
+ *   True if the initcall can run now.
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+static bool initcall_ready(FAR struct initcall_s *ic)
+{
+  FAR struct initcall_s * const *dep;
+
+  if (ic->deps == NULL)
+    {
+      return true;
+    }
+
+  for (dep = ic->deps; *dep != NULL; dep++)
+    {
+      if ((*dep)->state == INITCALL_UNREGISTERED)
+        {
+          serr("ERROR: %s: %s is not registered\n",
+               ic->name, (*dep)->name);
+          initcall_complete(ic, -ENOENT);
+          return false;
+        }
+      else if ((*dep)->state != INITCALL_DONE)
+        {
+          return false;
+        }
+      else if ((*dep)->result < 0)
+        {
+          serr("ERROR: %s: %s failed: %d\n",
+               ic->name, (*dep)->name, (*dep)->result);
+          initcall_complete(ic, -ECANCELED);
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: initcall_next
+ *
+ * Description:
+ *   Find the first pending initcall that can run now.
+ *
+ * Input Parameters:
+ *   pending - Set to true if there are initcalls that cannot run yet.
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct initcall_s *initcall_next(FAR bool *pending)
+{
+  FAR sq_entry_t *entry;
+
+  *pending = false;
+  for (entry = sq_peek(&g_initcall_list); entry; entry = sq_next(entry))
+    {
+      FAR struct initcall_s *ic = (FAR struct initcall_s *)entry;
+
+      if (ic->state == INITCALL_PENDING)
+        {
+          if (initcall_ready(ic))
+            {
+              return ic;
+            }
+
+          if (ic->state == INITCALL_PENDING)
+            {
+              *pending = true;
+            }
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: initcall_sync_done
+ *
+ * Description:
+ *   Return true if all of the INITCALL_SYNC initcalls are done.
+ *
+ ****************************************************************************/
+
+static bool initcall_sync_done(void)
+{
+  FAR sq_entry_t *entry;
+
+  for (entry = sq_peek(&g_initcall_list); entry; entry = sq_next(entry))
+    {
+      FAR struct initcall_s *ic = (FAR struct initcall_s *)entry;
+
+      if ((ic->flags & INITCALL_SYNC) != 0 && ic->state != INITCALL_DONE)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: initcall_thread
+ *
+ * Description:
+ *   The initcall threads run the initcalls until none is left.
+ *
+ ****************************************************************************/
+
+static int initcall_thread(int argc, FAR char **argv)
+{
+  FAR struct initcall_s *ic;
+  irqstate_t flags;
+  bool pending;
+  bool last;
+  int ret;
+
+  flags = enter_critical_section();
+
+  for (; ; )
+    {
+      ic = initcall_next(&pending);
+      if (ic != NULL)
+        {
+          ic->state = INITCALL_RUNNING;
+          g_initcall_nrunning++;
+          leave_critical_section(flags);
+
+          sinfo("Running %s\n", ic->name);
+
+#ifdef CONFIG_INITCALL_PROFILE
+          ic->cpu = this_cpu();
+          clock_systime_timespec(&ic->start);
+#endif
+          ret = ic->func(ic->arg);
+#ifdef CONFIG_INITCALL_PROFILE
+          clock_systime_timespec(&ic->end);
+#endif
+          if (ret < 0)
+            {
+              serr("ERROR: %s failed: %d\n", ic->name, ret);
+            }
+
+          flags = enter_critical_section();
+          g_initcall_nrunning--;
+          initcall_complete(ic, ret);
+        }
+      else if (!pending)
+        {
+          break;
+        }
+      else if (g_initcall_nrunning == 0)
+        {
+          FAR sq_entry_t *entry;
+
+          /* Nothing is running that could unblock the pending initcalls:
+           * their dependencies are circular.
+           */
+
+          for (entry = sq_peek(&g_initcall_list); entry;
+               entry = sq_next(entry))
+            {
+              ic = (FAR struct initcall_s *)entry;
+              if (ic->state == INITCALL_PENDING)
+                {
+                  serr("ERROR: %s: circular dependency\n", ic->name);
+                  initcall_complete(ic, -EDEADLK);
+                }
+            }
+        }
+      else
+        {
+          initcall_sleep();
+        }
+    }
+
+  /* The last thread out wakes up those waiting for all initcalls */
+
+  last = --g_initcall_nthreads == 0;
+  if (last)
+    {
+      initcall_wakeup();
+    }
+
+  leave_critical_section(flags);
+
+#ifdef CONFIG_INITCALL_PROFILE
+  if (last)
+    {
+      initcall_report();
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: initcall_register
+ ****************************************************************************/
+
+int initcall_register(FAR struct initcall_s *ic)
+{
+  irqstate_t flags;
+  int ret = -EBUSY;
+
+  DEBUGASSERT(ic != NULL && ic->func != NULL && ic->name != NULL);
+
+  flags = enter_critical_section();
+  if (!g_initcall_started)
+    {
+      DEBUGASSERT(ic->state == INITCALL_UNREGISTERED);
+
+      ic->state  = INITCALL_PENDING;
+      ic->result = 0;
+      sq_addlast((FAR sq_entry_t *)ic, &g_initcall_list);
+      ret = OK;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: initcall_wait
+ ****************************************************************************/
+
+int initcall_wait(FAR struct initcall_s *ic)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  flags = enter_critical_section();
+
+  if (ic == NULL)
+    {
+      while (g_initcall_nthreads > 0)
+        {
+          initcall_sleep();
+        }
+    }
+  else if (ic->state == INITCALL_UNREGISTERED)
+    {
+      ret = -ENOENT;
+    }
+  else
+    {
+      while (ic->state != INITCALL_DONE)
+        {
+          initcall_sleep();
+        }
+
+      ret = ic->result;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: initcall_report
+ ****************************************************************************/
+
+#ifdef CONFIG_INITCALL_PROFILE
+void initcall_report(void)
+{
+  FAR sq_entry_t *entry;
+
+  syslog(LOG_INFO, "%-24s %3s %10s %10s %6s\n",
+         "INITCALL", "CPU", "START(us)", "TIME(us)", "RESULT");
+
+  for (entry = sq_peek(&g_initcall_list); entry; entry = sq_next(entry))
+    {
+      FAR struct initcall_s *ic = (FAR struct initcall_s *)entry;
+      struct timespec elapsed;
+
+      if (ic->state != INITCALL_DONE)
+        {
+          continue;
+        }
+
+      clock_timespec_subtract(&ic->end, &ic->start, &elapsed);
+      syslog(LOG_INFO, "%-24s %3d %10llu %10llu %6d\n",
+             ic->name, ic->cpu,
+             (unsigned long long)ic->start.tv_sec * USEC_PER_SEC +
+             ic->start.tv_nsec / NSEC_PER_USEC,
+             (unsigned long long)elapsed.tv_sec * USEC_PER_SEC +
+             elapsed.tv_nsec / NSEC_PER_USEC,
+             ic->result);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: initcall_run
+ ****************************************************************************/
+
+void initcall_run(void)
+{
+  irqstate_t flags;
+  int nthreads;
+  int ret;
+  int i;
+
+  flags = enter_critical_section();
+  g_initcall_started = true;
+  if (sq_empty(&g_initcall_list))
+    {
+      leave_critical_section(flags);
+      return;
+    }
+
+  nthreads = sq_count(&g_initcall_list);
+  if (nthreads > CONFIG_INITCALL_NTHREADS)
+    {
+      nthreads = CONFIG_INITCALL_NTHREADS;
+    }
+
+  g_initcall_nthreads = nthreads;
+  leave_critical_section(flags);
+
+  /* With SMP, the threads are free to run on any CPU */
+
+  for (i = 0; i < nthreads; i++)
+    {
+      ret = kthread_create("initcall", CONFIG_INITCALL_PRIORITY,
+                           CONFIG_INITCALL_STACKSIZE,
+                           initcall_thread, NULL);
+      if (ret < 0)
+        {
+          serr("ERROR: Failed to start initcall thread: %d\n", ret);
+
+          /* Take the place of the threads that could not be started */
+
+          flags = enter_critical_section();
+          g_initcall_nthreads -= nthreads - i - 1;
+          leave_critical_section(flags);
+
+          initcall_thread(0, NULL);
+          break;
+        }
+    }
+
+  /* Let the init task start only once the INITCALL_SYNC initcalls are
+   * done.
+   */
+
+  flags = enter_critical_section();
+  while (!initcall_sync_done() && g_initcall_nthreads > 0)
+    {
+      initcall_sleep();
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_INITCALL */
@@ -79,6 +79,12 @@ void nx_idle_trampoline(void)
 
   for (; ; )
     {
+      /* Release memory whose deallocation had to be delayed, e.g. because
+       * it was freed from an interrupt handler.
+       */
+
+      kmm_free_delaylist();
+
       /* Perform any processor-specific idle state operations */
 
       up_idle();
@@ -553,6 +553,7 @@ void nx_start(void)
       info = up_stack_frame(&g_idletcb[i].cmn, sizeof(struct tls_info_s));
       DEBUGASSERT(info == g_idletcb[i].cmn.stack_alloc_ptr);
       info->tl_task = g_idletcb[i].cmn.group->tg_info;
+      info->tl_tid  = g_idletcb[i].cmn.pid;
 
       /* Complete initialization of the IDLE group.  Suppress retention
        * of child status in the IDLE group.
@@ -742,6 +743,12 @@ void nx_start(void)
   sinfo("CPU0: Beginning Idle Loop\n");
   for (; ; )
     {
+      /* Release memory whose deallocation had to be delayed, e.g. because
+       * it was freed from an interrupt handler.
+       */
+
+      kmm_free_delaylist();
+
       /* Perform any processor-specific idle state operations */
 
       up_idle();
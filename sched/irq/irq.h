@@ -44,6 +44,10 @@
 #  error CONFIG_ARCH_NUSER_INTERRUPTS is not defined
 #endif
 
+#if defined(CONFIG_SMP) && defined(CONFIG_ARCH_HAVE_IRQAFFINITY)
+#  define HAVE_IRQAFFINITY 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -66,7 +70,27 @@ struct irq_info_s
   uint32_t mscount;  /* Number of interrupts on this IRQ (MS) */
   uint32_t lscount;  /* Number of interrupts on this IRQ (LS) */
 #endif
-  uint32_t time;     /* Maximum execution time on this IRQ */
+  uint32_t time;     /* Maximum execution time on this IRQ (perf counts) */
+#ifdef CONFIG_HAVE_LONG_LONG
+  uint64_t total;    /* Cumulative execution time (perf counts) */
+#endif
+#ifdef CONFIG_SMP
+  uint32_t cpucount[CONFIG_SMP_NCPUS]; /* Interrupts taken on each CPU */
+#endif
+#if defined(CONFIG_SCHED_IRQMONITOR_STORM) && \
+    CONFIG_SCHED_IRQMONITOR_STORM > 0
+  uint32_t wstart;   /* Start of the current one second window */
+  uint32_t wcount;   /* Number of interrupts in the current window */
+  uint32_t storms;   /* Number of storms detected */
+#endif
+#endif
+#ifdef HAVE_IRQAFFINITY
+  cpu_set_t cpuset;  /* The CPUs that may service this IRQ */
+  bool pinned;       /* Affinity set explicitly, don't balance */
+#endif
+#ifdef CONFIG_SCHED_IRQBALANCE
+  int8_t target;     /* The CPU this IRQ keeps waking tasks on */
+  uint8_t balance;   /* Number of consecutive wakeups on target */
 #endif
 };
 
@@ -122,6 +146,14 @@ extern volatile cpu_set_t g_cpu_irqset;
 extern volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #endif
 
+#ifdef CONFIG_SCHED_IRQBALANCE
+/* The CPU (plus one) on which the interrupt handler running on each CPU
+ * made a task run, or zero if it did not.
+ */
+
+extern int8_t g_irq_wakecpu[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -182,6 +214,25 @@ int irq_unexpected_isr(int irq, FAR void *context, FAR void *arg);
 bool irq_cpu_locked(int cpu);
 #endif
 
+/****************************************************************************
+ * Name: irq_balance
+ *
+ * Description:
+ *   Called by irq_dispatch() after the handler of 'irq' returned.  If the
+ *   handler keeps waking tasks that run on one other CPU, then route the
+ *   IRQ to that CPU so that the wakeup does not need an inter-processor
+ *   interrupt.
+ *
+ * Input Parameters:
+ *   irq - The IRQ number
+ *   ndx - The index of the IRQ in g_irqvector[]
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_IRQBALANCE
+void irq_balance(int irq, int ndx);
+#endif
+
 /****************************************************************************
  * Name: irq_foreach
  *
@@ -0,0 +1,231 @@
+/****************************************************************************
+ * sched/irq/irq_affinity.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+
+#include "irq/irq.h"
+#include "sched/sched.h"
+
+#ifdef HAVE_IRQAFFINITY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_MINIMAL_VECTORTABLE
+#  define NUSER_IRQS CONFIG_ARCH_NUSER_INTERRUPTS
+#else
+#  define NUSER_IRQS NR_IRQS
+#endif
+
+#define ALL_CPUS ((cpu_set_t)((1 << CONFIG_SMP_NCPUS) - 1))
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_IRQBALANCE
+int8_t g_irq_wakecpu[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_to_ndx
+ *
+ * Description:
+ *   Return the index of IRQ number 'irq' in g_irqvector[] or a negated
+ *   errno value if there is none.
+ *
+ ****************************************************************************/
+
+static int irq_to_ndx(int irq)
+{
+  if ((unsigned)irq >= NR_IRQS)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_ARCH_MINIMAL_VECTORTABLE
+  if ((unsigned)g_irqmap[irq] >= CONFIG_ARCH_NUSER_INTERRUPTS)
+    {
+      return -EINVAL;
+    }
+
+  return g_irqmap[irq];
+#else
+  return irq;
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_set_affinity
+ *
+ * Description:
+ *   Route IRQ number 'irq' to the set of CPUs in 'cpuset'.  The IRQ
+ *   balancer will not move it afterwards.
+ *
+ * Input Parameters:
+ *   irq    - The IRQ number
+ *   cpuset - The set of CPUs that may service the IRQ
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int irq_set_affinity(int irq, cpu_set_t cpuset)
+{
+  irqstate_t flags;
+  int ndx;
+  int ret;
+
+  ndx = irq_to_ndx(irq);
+  if (ndx < 0)
+    {
+      return ndx;
+    }
+
+  cpuset &= ALL_CPUS;
+  if (cpuset == 0)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  ret = up_affinity_irq(irq, cpuset);
+  if (ret >= 0)
+    {
+      g_irqvector[ndx].cpuset = cpuset;
+      g_irqvector[ndx].pinned = true;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: irq_get_affinity
+ *
+ * Description:
+ *   Return the set of CPUs that may service IRQ number 'irq'.
+ *
+ * Input Parameters:
+ *   irq    - The IRQ number
+ *   cpuset - The location to return the set of CPUs
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int irq_get_affinity(int irq, FAR cpu_set_t *cpuset)
+{
+  int ndx;
+
+  ndx = irq_to_ndx(irq);
+  if (ndx < 0)
+    {
+      return ndx;
+    }
+
+  *cpuset = g_irqvector[ndx].cpuset;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: irq_balance
+ *
+ * Description:
+ *   Called by irq_dispatch() after the handler of 'irq' returned.  If the
+ *   handler keeps waking tasks that run on one other CPU, then route the
+ *   IRQ to that CPU so that the wakeup does not need an inter-processor
+ *   interrupt.
+ *
+ * Input Parameters:
+ *   irq - The IRQ number
+ *   ndx - The index of the IRQ in g_irqvector[]
+ *
+ * Assumptions:
+ *   Called from interrupt handling logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_IRQBALANCE
+void irq_balance(int irq, int ndx)
+{
+  FAR struct irq_info_s *info;
+  int me = up_cpu_index();
+  int cpu;
+
+  /* Which CPU, if any, did the handler make a task run on? */
+
+  cpu = g_irq_wakecpu[me] - 1;
+  g_irq_wakecpu[me] = 0;
+
+  if (cpu < 0 || ndx >= NUSER_IRQS)
+    {
+      return;
+    }
+
+  info = &g_irqvector[ndx];
+  if (info->pinned || cpu == me || nxsched_cpu_isolated(cpu))
+    {
+      /* Never move an IRQ whose affinity was chosen explicitly or to an
+       * isolated CPU, and nothing is to gain if the task runs here anyway.
+       */
+
+      info->balance = 0;
+      return;
+    }
+
+  if (info->target != cpu)
+    {
+      /* Start counting toward a new CPU */
+
+      info->target  = cpu;
+      info->balance = 0;
+    }
+
+  if (++info->balance >= CONFIG_SCHED_IRQBALANCE_THRESHOLD &&
+      up_affinity_irq(irq, (cpu_set_t)(1 << cpu)) >= 0)
+    {
+      info->cpuset  = (cpu_set_t)(1 << cpu);
+      info->balance  = 0;
+    }
+}
+#endif
+
+#endif /* HAVE_IRQAFFINITY */
@@ -0,0 +1,253 @@
+/****************************************************************************
+ * sched/irq/irq_attachthread.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+
+#include "irq/irq.h"
+
+#if NR_IRQS > 0
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one threaded interrupt */
+
+struct irq_thread_s
+{
+  int irq;                   /* The IRQ number */
+  xcpt_t isr;                /* The top half, may be NULL */
+  xcpt_t isrthread;          /* The bottom half, run by the thread */
+  FAR void *arg;             /* The argument of both halves */
+  sem_t sem;                 /* Posted by the top half to wake the thread */
+  pid_t pid;                 /* The pid of the thread */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The threaded interrupts, indexed by the IRQ number */
+
+static FAR struct irq_thread_s *g_irq_thread[NR_IRQS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_thread_isr
+ *
+ * Description:
+ *   The handler attached to a threaded interrupt.  It runs the top half,
+ *   if any, and wakes the thread when the top half asks for it.  Without
+ *   a top half, the IRQ is masked until the bottom half has run so that a
+ *   level triggered interrupt does not fire again in the meantime.
+ *
+ ****************************************************************************/
+
+static int irq_thread_isr(int irq, FAR void *context, FAR void *arg)
+{
+  FAR struct irq_thread_s *info = (FAR struct irq_thread_s *)arg;
+  int ret = IRQ_WAKE_THREAD;
+
+  if (info->isr != NULL)
+    {
+      ret = info->isr(irq, context, info->arg);
+    }
+#if !defined(CONFIG_ARCH_NOINTC) && !defined(CONFIG_ARCH_VECNOTIRQ)
+  else
+    {
+      up_disable_irq(irq);
+    }
+#endif
+
+  if (ret == IRQ_WAKE_THREAD)
+    {
+      nxsem_post(&info->sem);
+      ret = OK;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: irq_thread
+ *
+ * Description:
+ *   The thread of a threaded interrupt.  It runs the bottom half each time
+ *   that it is woken by the top half.
+ *
+ ****************************************************************************/
+
+static int irq_thread(int argc, FAR char *argv[])
+{
+  FAR struct irq_thread_s *info;
+
+  info = (FAR struct irq_thread_s *)
+         ((uintptr_t)strtoul(argv[1], NULL, 0));
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&info->sem);
+      info->isrthread(info->irq, NULL, info->arg);
+
+#if !defined(CONFIG_ARCH_NOINTC) && !defined(CONFIG_ARCH_VECNOTIRQ)
+      if (info->isr == NULL)
+        {
+          /* The top half masked the IRQ, the cause is handled now */
+
+          up_enable_irq(info->irq);
+        }
+#endif
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_attach_thread
+ *
+ * Description:
+ *   Configure the IRQ subsystem so that IRQ number 'irq' is serviced by a
+ *   kernel thread of its own.
+ *
+ * Input Parameters:
+ *   irq        - The IRQ number
+ *   isr        - The top half, run in interrupt context.  It returns
+ *                IRQ_WAKE_THREAD to run the bottom half.  If NULL, the
+ *                IRQ is masked and the bottom half always runs; the IRQ
+ *                is unmasked when the bottom half returns.
+ *   isrthread  - The bottom half, run by the thread (context is NULL).
+ *                If NULL, the threaded interrupt is detached and its
+ *                thread deleted.  The driver must have quiesced the
+ *                device first.
+ *   arg        - The argument passed to both halves
+ *   priority   - The priority of the thread
+ *   stack_size - The stack size of the thread
+ *
+ * Returned Value:
+ *   The pid of the thread on success, so that the caller may set its CPU
+ *   affinity; zero when detaching; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int irq_attach_thread(int irq, xcpt_t isr, xcpt_t isrthread, FAR void *arg,
+                      int priority, int stack_size)
+{
+  FAR struct irq_thread_s *info;
+  FAR char *argv[2];
+  char args[32];
+  char name[16];
+  pid_t pid;
+  int ret;
+
+  if ((unsigned)irq >= NR_IRQS)
+    {
+      return -EINVAL;
+    }
+
+  /* Detach and delete the previous thread, if any */
+
+  info = g_irq_thread[irq];
+  if (info != NULL)
+    {
+      irq_detach(irq);
+      g_irq_thread[irq] = NULL;
+      kthread_delete(info->pid);
+      nxsem_destroy(&info->sem);
+      kmm_free(info);
+    }
+
+  if (isrthread == NULL)
+    {
+      return OK;
+    }
+
+  info = (FAR struct irq_thread_s *)kmm_zalloc(sizeof(*info));
+  if (info == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  info->irq       = irq;
+  info->isr       = isr;
+  info->isrthread = isrthread;
+  info->arg       = arg;
+
+  nxsem_init(&info->sem, 0, 0);
+  nxsem_set_protocol(&info->sem, SEM_PRIO_NONE);
+
+  snprintf(args, sizeof(args), "0x%" PRIxPTR, (uintptr_t)info);
+  argv[0] = args;
+  argv[1] = NULL;
+
+  snprintf(name, sizeof(name), "isr%d", irq);
+  pid = kthread_create(name, priority, stack_size,
+                       (main_t)irq_thread, argv);
+  if (pid < 0)
+    {
+      serr("ERROR: Failed to create the thread of IRQ %d: %d\n", irq, pid);
+      ret = pid;
+      goto errout_with_info;
+    }
+
+  info->pid = pid;
+
+  /* Attach only now that the thread exists to be woken */
+
+  ret = irq_attach(irq, irq_thread_isr, info);
+  if (ret < 0)
+    {
+      kthread_delete(pid);
+      goto errout_with_info;
+    }
+
+  g_irq_thread[irq] = info;
+  return pid;
+
+errout_with_info:
+  nxsem_destroy(&info->sem);
+  kmm_free(info);
+  return ret;
+}
+
+#endif /* NR_IRQS > 0 */
@@ -58,6 +58,18 @@ volatile cpu_set_t g_cpu_irqset;
 volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #endif
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_CSECTION_STATS
+/* Contention statistics of g_cpu_irqlock.  Each CPU only updates its own
+ * entry and does so with interrupts disabled.
+ */
+
+static struct csection_stat_s g_cpu_irqlockstat[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -108,6 +120,10 @@ volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #ifdef CONFIG_SMP
 static bool irq_waitlock(int cpu)
 {
+#ifdef CONFIG_SMP_CSECTION_STATS
+  FAR struct csection_stat_s *stat = &g_cpu_irqlockstat[cpu];
+  uint32_t spins = 0;
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   FAR struct tcb_s *tcb = current_task(cpu);
 
@@ -122,6 +138,10 @@ static bool irq_waitlock(int cpu)
 
   while (spin_trylock_wo_note(&g_cpu_irqlock) == SP_LOCKED)
     {
+#ifdef CONFIG_SMP_CSECTION_STATS
+      spins++;
+#endif
+
       /* Is a pause request pending? */
 
       if (up_cpu_pausereq(cpu))
@@ -130,6 +150,10 @@ static bool irq_waitlock(int cpu)
            * Abort the wait and return false.
            */
 
+#ifdef CONFIG_SMP_CSECTION_STATS
+          stat->spins += spins;
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
           /* Notify that we have aborted the wait for the spinlock */
 
@@ -142,6 +166,15 @@ static bool irq_waitlock(int cpu)
 
   /* We have g_cpu_irqlock! */
 
+#ifdef CONFIG_SMP_CSECTION_STATS
+  stat->acquired++;
+  if (spins > 0)
+    {
+      stat->contended++;
+      stat->spins += spins;
+    }
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we have the spinlock */
 
@@ -377,7 +410,7 @@ try_again_in_irq:
               /* Note that we have entered the critical section */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
-              nxsched_critmon_csection(rtcb, true);
+              nxsched_critmon_csection(rtcb, true, return_address(0));
 #endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_CSECTION
               sched_note_csection(rtcb, true);
@@ -420,7 +453,7 @@ irqstate_t enter_critical_section(void)
           /* Note that we have entered the critical section */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
-          nxsched_critmon_csection(rtcb, true);
+          nxsched_critmon_csection(rtcb, true, return_address(0));
 #endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_CSECTION
           sched_note_csection(rtcb, true);
@@ -527,7 +560,7 @@ void leave_critical_section(irqstate_t flags)
               /* No.. Note that we have left the critical section */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
-              nxsched_critmon_csection(rtcb, false);
+              nxsched_critmon_csection(rtcb, false, return_address(0));
 #endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_CSECTION
               sched_note_csection(rtcb, false);
@@ -609,7 +642,7 @@ void leave_critical_section(irqstate_t flags)
           /* Note that we have left the critical section */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
-          nxsched_critmon_csection(rtcb, false);
+          nxsched_critmon_csection(rtcb, false, return_address(0));
 #endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_CSECTION
           sched_note_csection(rtcb, false);
@@ -697,4 +730,20 @@ bool irq_cpu_locked(int cpu)
 }
 #endif
 
+/****************************************************************************
+ * Name: csection_getstat
+ *
+ * Description:
+ *   Return the critical section contention statistics of one CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_CSECTION_STATS
+void csection_getstat(int cpu, FAR struct csection_stat_s *stat)
+{
+  DEBUGASSERT(cpu >= 0 && cpu < CONFIG_SMP_NCPUS && stat != NULL);
+  *stat = g_cpu_irqlockstat[cpu];
+}
+#endif
+
 #endif /* CONFIG_IRQCOUNT */
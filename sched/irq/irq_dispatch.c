@@ -68,6 +68,18 @@
      while (0)
 #endif
 
+/* HIST_VECTOR - Add the execution time of the handler to the interrupt
+ * latency histogram of this CPU
+ */
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+#  define HIST_VECTOR(vector, elapsed) \
+     nxsched_critmon_hist(&g_irq_hist[this_cpu()], elapsed, \
+                          (FAR void *)vector)
+#else
+#  define HIST_VECTOR(vector, elapsed)
+#endif
+
 /* CALL_VECTOR - Call the interrupt service routine attached to this
  * interrupt request
  */
@@ -76,24 +88,75 @@
 #  define CONFIG_SCHED_CRITMONITOR_MAXTIME_IRQ 0
 #endif
 
+/* ACCT_TIME - Account the execution time of the handler, in counts of the
+ * performance counter, and the CPU that took the interrupt.  The counts
+ * are only converted to time units when /proc/irqs is read.
+ */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+#  define ACCT_TOTAL(ndx, elapsed) g_irqvector[ndx].total += (elapsed)
+#else
+#  define ACCT_TOTAL(ndx, elapsed)
+#endif
+
+#ifdef CONFIG_SMP
+#  define ACCT_CPU(ndx) g_irqvector[ndx].cpucount[this_cpu()]++
+#else
+#  define ACCT_CPU(ndx)
+#endif
+
+#define ACCT_TIME(ndx, elapsed) \
+  do \
+    { \
+      ACCT_TOTAL(ndx, elapsed); \
+      ACCT_CPU(ndx); \
+      if ((elapsed) > g_irqvector[ndx].time) \
+        { \
+          g_irqvector[ndx].time = (elapsed); \
+        } \
+    } \
+  while (0)
+
+/* CHECK_STORM - Count the interrupts taken in a window of one second of
+ * the performance counter and report a storm when there are too many.
+ */
+
+#if defined(CONFIG_SCHED_IRQMONITOR_STORM) && \
+    CONFIG_SCHED_IRQMONITOR_STORM > 0
+#  define CHECK_STORM(ndx, irq, now) \
+     do \
+       { \
+         if ((now) - g_irqvector[ndx].wstart >= up_perf_getfreq()) \
+           { \
+             g_irqvector[ndx].wstart = (now); \
+             g_irqvector[ndx].wcount = 0; \
+           } \
+         if (++g_irqvector[ndx].wcount == CONFIG_SCHED_IRQMONITOR_STORM) \
+           { \
+             g_irqvector[ndx].storms++; \
+             irq_storm(irq); \
+           } \
+       } \
+     while (0)
+#else
+#  define CHECK_STORM(ndx, irq, now)
+#endif
+
 #ifdef CONFIG_SCHED_IRQMONITOR
 #  define CALL_VECTOR(ndx, vector, irq, context, arg) \
      do \
        { \
-         struct timespec delta; \
          uint32_t start; \
          uint32_t elapsed; \
          start = up_perf_gettime(); \
          vector(irq, context, arg); \
          elapsed = up_perf_gettime() - start; \
-         up_perf_convert(elapsed, &delta); \
+         HIST_VECTOR(vector, elapsed); \
          if (ndx < NUSER_IRQS) \
            { \
              INCR_COUNT(ndx); \
-             if (delta.tv_nsec > g_irqvector[ndx].time) \
-               { \
-                 g_irqvector[ndx].time = delta.tv_nsec; \
-               } \
+             ACCT_TIME(ndx, elapsed); \
+             CHECK_STORM(ndx, irq, start); \
            } \
          if (CONFIG_SCHED_CRITMONITOR_MAXTIME_IRQ > 0 && \
              elapsed > CONFIG_SCHED_CRITMONITOR_MAXTIME_IRQ) \
@@ -112,6 +175,28 @@
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: irq_storm
+ *
+ * Description:
+ *   Called when IRQ number 'irq' was taken CONFIG_SCHED_IRQMONITOR_STORM
+ *   times within one second.  This default implementation reports the
+ *   storm and disables the IRQ.  Boards may provide their own policy.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_IRQMONITOR_STORM) && \
+    CONFIG_SCHED_IRQMONITOR_STORM > 0
+void weak_function irq_storm(int irq)
+{
+  serr("ERROR: Interrupt storm on IRQ %d\n", irq);
+
+#if !defined(CONFIG_ARCH_NOINTC) && !defined(CONFIG_ARCH_VECNOTIRQ)
+  up_disable_irq(irq);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: irq_dispatch
  *
@@ -168,6 +253,12 @@ void irq_dispatch(int irq, FAR void *context)
   CALL_VECTOR(ndx, vector, irq, context, arg);
   UNUSED(ndx);
 
+#ifdef CONFIG_SCHED_IRQBALANCE
+  /* Move the IRQ closer to the tasks that its handler wakes up */
+
+  irq_balance(irq, ndx);
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
   /* Notify that we are leaving from the interrupt handler */
 
@@ -73,6 +73,11 @@ void irq_initialize(void)
   for (i = 0; i < TAB_SIZE; i++)
     {
       g_irqvector[i].handler = irq_unexpected_isr;
+#ifdef HAVE_IRQAFFINITY
+      /* The interrupt controllers route all interrupts to CPU0 at reset */
+
+      g_irqvector[i].cpuset = 1;
+#endif
     }
 
 #ifdef CONFIG_IRQCHAIN
@@ -47,26 +47,41 @@
 
 /* Output format:
  *
- *            1111111111222222222233333333334444444444
- *   1234567890123456789012345678901234567890123456789
+ *            1111111111222222222233333333334444444444555555555566666666
+ *   1234567890123456789012345678901234567890123456789012345678901234567
  *
- *   IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME
- *   DDD XXXXXXXX XXXXXXXX DDDDDDDDDD DDDD.DDD DDDD
+ *   IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME      TOTAL
+ *   DDD XXXXXXXX XXXXXXXX DDDDDDDDDD DDDD.DDD DDDD DDDDDDDDDD
+ *
+ * TIME is the maximum and TOTAL the cumulative execution time of the
+ * handler, both in microseconds.  These columns are followed by:
+ *
+ *   - In SMP, the count of interrupts taken on each CPU (CPUn).
+ *   - If the interrupts can be routed to chosen CPUs, the set of CPUs
+ *     that may service the IRQ (CPUS).
+ *   - If storm detection is enabled, the number of storms detected
+ *     (STORMS).
  *
  * NOTE:  This assumes that an address can be represented in 32-bits.  In
  * the typical configuration where CONFIG_HAVE_LONG_LONG=y, the COUNT field
  * may not be wide enough.
  */
 
-#define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME\n"
-#define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu\n"
+#define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME      TOTAL"
+#define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu %10lu"
 
 /* Determines the size of an intermediate buffer that must be large enough
  * to handle the longest line generated by this logic (plus a couple of
  * bytes).
  */
 
-#define IRQ_LINELEN 50
+#ifdef CONFIG_SMP
+#  define IRQ_CPULEN (11 * CONFIG_SMP_NCPUS)
+#else
+#  define IRQ_CPULEN 0
+#endif
+
+#define IRQ_LINELEN (80 + IRQ_CPULEN)
 
 /****************************************************************************
  * Private Types
@@ -151,6 +166,11 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
   unsigned long intpart;
   unsigned long fracpart;
   unsigned long count;
+  uint64_t total;
+  uint32_t freq;
+#ifdef CONFIG_SMP
+  int cpu;
+#endif
 
   DEBUGASSERT(irqfile != NULL);
 
@@ -167,6 +187,16 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
   info->lscount = 0;
 #endif
   info->time    = 0;
+#ifdef CONFIG_HAVE_LONG_LONG
+  info->total   = 0;
+#endif
+#ifdef CONFIG_SMP
+  memset(info->cpucount, 0, sizeof(info->cpucount));
+#endif
+#if defined(CONFIG_SCHED_IRQMONITOR_STORM) && \
+    CONFIG_SCHED_IRQMONITOR_STORM > 0
+  info->storms  = 0;
+#endif
   leave_critical_section(flags);
 
   /* Don't bother if count == 0.
@@ -233,6 +263,18 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
 #  error Missing logic
 #endif
 
+  /* Convert the execution times from counts of the performance counter
+   * to microseconds.
+   */
+
+  freq  = up_perf_getfreq();
+  total = (copy.total / freq) * USEC_PER_SEC +
+          ((copy.total % freq) * USEC_PER_SEC) / freq;
+  if (total > ULONG_MAX)
+    {
+      total = ULONG_MAX;
+    }
+
   /* Output information about this interrupt */
 
   linesize = snprintf(irqfile->line, IRQ_LINELEN, IRQ_FMT,
@@ -240,7 +282,32 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
                       (unsigned long)((uintptr_t)copy.handler),
                       (unsigned long)((uintptr_t)copy.arg),
                       count, intpart, fracpart,
-                      (unsigned long)copy.time / 1000);
+                      (unsigned long)
+                      (((uint64_t)copy.time * USEC_PER_SEC) / freq),
+                      (unsigned long)total);
+
+#ifdef CONFIG_SMP
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      linesize += snprintf(irqfile->line + linesize,
+                           IRQ_LINELEN - linesize, " %10lu",
+                           (unsigned long)copy.cpucount[cpu]);
+    }
+#endif
+
+#ifdef HAVE_IRQAFFINITY
+  linesize += snprintf(irqfile->line + linesize, IRQ_LINELEN - linesize,
+                       " %04x", (unsigned int)copy.cpuset);
+#endif
+
+#if defined(CONFIG_SCHED_IRQMONITOR_STORM) && \
+    CONFIG_SCHED_IRQMONITOR_STORM > 0
+  linesize += snprintf(irqfile->line + linesize, IRQ_LINELEN - linesize,
+                       " %6lu", (unsigned long)copy.storms);
+#endif
+
+  linesize += snprintf(irqfile->line + linesize, IRQ_LINELEN - linesize,
+                       "\n");
 
   copysize  = procfs_memcpy(irqfile->line, linesize, irqfile->buffer,
                             irqfile->remaining, &irqfile->offset);
@@ -329,6 +396,9 @@ static ssize_t irq_read(FAR struct file *filep, FAR char *buffer,
   FAR struct irq_file_s *irqfile;
   size_t linesize;
   size_t copysize;
+#ifdef CONFIG_SMP
+  int cpu;
+#endif
 
   finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
 
@@ -347,6 +417,28 @@ static ssize_t irq_read(FAR struct file *filep, FAR char *buffer,
 
   linesize = snprintf(irqfile->line, IRQ_LINELEN, HDR_FMT);
 
+#ifdef CONFIG_SMP
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      linesize += snprintf(irqfile->line + linesize,
+                           IRQ_LINELEN - linesize, "       CPU%d", cpu);
+    }
+#endif
+
+#ifdef HAVE_IRQAFFINITY
+  linesize += snprintf(irqfile->line + linesize, IRQ_LINELEN - linesize,
+                       " CPUS");
+#endif
+
+#if defined(CONFIG_SCHED_IRQMONITOR_STORM) && \
+    CONFIG_SCHED_IRQMONITOR_STORM > 0
+  linesize += snprintf(irqfile->line + linesize, IRQ_LINELEN - linesize,
+                       " STORMS");
+#endif
+
+  linesize += snprintf(irqfile->line + linesize, IRQ_LINELEN - linesize,
+                       "\n");
+
   copysize = procfs_memcpy(irqfile->line, linesize, irqfile->buffer,
                            irqfile->remaining, &irqfile->offset);
 
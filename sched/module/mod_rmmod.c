@@ -85,6 +85,15 @@ int rmmod(FAR void *handle)
     }
 #endif
 
+  /* Refuse to remove a module that is still shared through dlopen() */
+
+  if (modp->nrefs > 0)
+    {
+      berr("ERROR: Module is still shared: %u\n", modp->nrefs);
+      ret = -EBUSY;
+      goto errout_with_lock;
+    }
+
   /* Is there an uninitializer? */
 
   if (modp->modinfo.uninitializer != NULL)
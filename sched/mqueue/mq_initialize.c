@@ -47,6 +47,20 @@ sq_queue_t  g_msgfree;
 
 sq_queue_t  g_msgfreeirq;
 
+#if defined(CONFIG_SMP) && !defined(CONFIG_SMP_GLOBAL_CSECTION)
+/* The g_msgfreelock protects g_msgfree and g_msgfreeirq. */
+
+spinlock_t  g_msgfreelock = SP_UNLOCKED;
+#endif
+
+#ifdef CONFIG_MM_SLAB
+/* The g_msgcache is the slab cache that dynamically allocated messages are
+ * taken from once the pre-allocated messages are exhausted.
+ */
+
+struct slab_cache_s g_msgcache;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -146,4 +160,10 @@ void nxmq_initialize(void)
   g_msgfreeirqalloc =
     mq_msgblockalloc(&g_msgfreeirq, CONFIG_PREALLOC_MQ_IRQ_MSGS,
                      MQ_ALLOC_IRQ);
+
+#ifdef CONFIG_MM_SLAB
+  /* Dynamically allocated messages come from a slab cache */
+
+  slab_initialize(&g_msgcache, "mqueue_msg", sizeof(struct mqueue_msg_s));
+#endif
 }
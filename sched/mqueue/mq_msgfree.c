@@ -46,6 +46,7 @@
  *   allocated dynamically it will be deallocated.
  *
  * Input Parameters:
+ *   msgq  - The message queue that the message was allocated for
  *   mqmsg - message to free
  *
  * Returned Value:
@@ -53,7 +54,8 @@
  *
  ****************************************************************************/
 
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg)
 {
   irqstate_t flags;
 
@@ -67,9 +69,9 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = nxmq_lock_freelist();
       sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfree);
-      leave_critical_section(flags);
+      nxmq_unlock_freelist(flags);
     }
 
   /* If this is a message pre-allocated for interrupts,
@@ -82,10 +84,23 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = nxmq_lock_freelist();
       sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfreeirq);
+      nxmq_unlock_freelist(flags);
+    }
+
+#ifdef CONFIG_MQ_QUEUE_POOL
+  /* If this message was pre-allocated for the message queue, then put it
+   * back in the free list of the queue.
+   */
+
+  else if (mqmsg->type == MQ_ALLOC_QUEUE)
+    {
+      flags = enter_critical_section();
+      sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->msgfree);
       leave_critical_section(flags);
     }
+#endif
 
   /* Otherwise, deallocate it.  Note:  interrupt handlers
    * will never deallocate messages because they will not
@@ -94,7 +109,11 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
 
   else if (mqmsg->type == MQ_ALLOC_DYN)
     {
+#ifdef CONFIG_MM_SLAB
+      slab_free(&g_msgcache, mqmsg);
+#else
       kmm_free(mqmsg);
+#endif
     }
   else
     {
@@ -34,6 +34,52 @@
 #include "sched/sched.h"
 #include "mqueue/mqueue.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_alloc_pool
+ *
+ * Description:
+ *   Allocate the messages reserved for one message queue and add them to
+ *   the free list of the queue.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MQ_QUEUE_POOL
+static int nxmq_alloc_pool(FAR struct mqueue_inode_s *msgq)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+  FAR uint8_t *pool;
+  size_t msgsize;
+  int i;
+
+  sq_init(&msgq->msgfree);
+  if (msgq->maxmsgs <= 0)
+    {
+      return OK;
+    }
+
+  msgsize = MQ_MSG_SIZE(msgq->maxmsgsize);
+  pool    = kmm_malloc(msgsize * msgq->maxmsgs);
+  if (pool == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  msgq->msgpool = pool;
+  for (i = 0; i < msgq->maxmsgs; i++)
+    {
+      mqmsg       = (FAR struct mqueue_msg_s *)(pool + i * msgsize);
+      mqmsg->type = MQ_ALLOC_QUEUE;
+      sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->msgfree);
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -99,6 +145,18 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
         }
 
       msgq->ntpid = INVALID_PROCESS_ID;
+
+#ifdef CONFIG_MQ_QUEUE_POOL
+      /* Pre-allocate the messages of the queue, each one just large enough
+       * for the message size of the queue.
+       */
+
+      if (nxmq_alloc_pool(msgq) < 0)
+        {
+          kmm_free(msgq);
+          return -ENOSPC;
+        }
+#endif
     }
   else
     {
@@ -63,10 +63,16 @@ void nxmq_free_msgq(FAR struct mqueue_inode_s *msgq)
       /* Deallocate the message structure. */
 
       next = curr->next;
-      nxmq_free_msg(curr);
+      nxmq_free_msg(msgq, curr);
       curr = next;
     }
 
+#ifdef CONFIG_MQ_QUEUE_POOL
+  /* Deallocate the messages preallocated for the queue */
+
+  kmm_free(msgq->msgpool);
+#endif
+
   /* Then deallocate the message queue itself */
 
   kmm_free(msgq);
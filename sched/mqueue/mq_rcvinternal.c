@@ -267,7 +267,7 @@ ssize_t nxmq_do_receive(FAR struct mqueue_inode_s *msgq,
 
   /* We are done with the message.  Deallocate it now. */
 
-  nxmq_free_msg(mqmsg);
+  nxmq_free_msg(msgq, mqmsg);
 
   /* Check if any tasks are waiting for the MQ not full event. */
 
@@ -130,7 +130,7 @@ int file_mq_send(FAR struct file *mq, FAR const char *msg, size_t msglen,
     {
       /* Now allocate the message. */
 
-      mqmsg = nxmq_alloc_msg();
+      mqmsg = nxmq_alloc_msg(msgq);
 
       /* Check if the message was successfully allocated */
 
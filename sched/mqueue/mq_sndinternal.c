@@ -101,8 +101,9 @@ int nxmq_verify_send(FAR struct mqueue_inode_s *msgq, int oflags,
  *
  * Description:
  *   The nxmq_alloc_msg function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   operating system.  The message will be taken from the messages
+ *   pre-allocated for the message queue, if any, or else from the
+ *   g_msgfree list.
  *
  *   If the list is empty AND the message is NOT being allocated from the
  *   interrupt level, then the message will be allocated.  If a message
@@ -115,7 +116,7 @@ int nxmq_verify_send(FAR struct mqueue_inode_s *msgq, int oflags,
  *   handler will be notified.
  *
  * Input Parameters:
- *   None
+ *   msgq - The message queue that the message will be sent to
  *
  * Returned Value:
  *   A reference to the allocated msg structure.  On a failure to allocate,
@@ -123,11 +124,24 @@ int nxmq_verify_send(FAR struct mqueue_inode_s *msgq, int oflags,
  *
  ****************************************************************************/
 
-FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
+FAR struct mqueue_msg_s *nxmq_alloc_msg(FAR struct mqueue_inode_s *msgq)
 {
   FAR struct mqueue_msg_s *mqmsg;
   irqstate_t flags;
 
+#ifdef CONFIG_MQ_QUEUE_POOL
+  /* Try the messages pre-allocated for this queue first */
+
+  flags = enter_critical_section();
+  mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msgfree);
+  leave_critical_section(flags);
+
+  if (mqmsg != NULL)
+    {
+      return mqmsg;
+    }
+#endif
+
   /* If we were called from an interrupt handler, then try to get the message
    * from generally available list of messages. If this fails, then try the
    * list of messages reserved for interrupt handlers
@@ -135,8 +149,11 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
   if (up_interrupt_context())
     {
-      /* Try the general free list */
+      /* Try the general free list.  The lock is still needed here since
+       * other CPUs may access the free lists at the same time.
+       */
 
+      flags = nxmq_lock_freelist();
       mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
       if (mqmsg == NULL)
         {
@@ -144,6 +161,23 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
           mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfreeirq);
         }
+
+      nxmq_unlock_freelist(flags);
+
+#ifdef CONFIG_MM_SLAB
+      /* The slab cache may still have a free message in a slab that is
+       * already allocated.
+       */
+
+      if (mqmsg == NULL)
+        {
+          mqmsg = (FAR struct mqueue_msg_s *)slab_alloc(&g_msgcache);
+          if (mqmsg != NULL)
+            {
+              mqmsg->type = MQ_ALLOC_DYN;
+            }
+        }
+#endif
     }
 
   /* We were not called from an interrupt handler. */
@@ -154,9 +188,9 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
        * Disable interrupts -- we might be called from an interrupt handler.
        */
 
-      flags = enter_critical_section();
+      flags = nxmq_lock_freelist();
       mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      leave_critical_section(flags);
+      nxmq_unlock_freelist(flags);
 
       /* If we cannot a message from the free list, then we will have to
        * allocate one.
@@ -164,8 +198,12 @@ FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 
       if (mqmsg == NULL)
         {
+#ifdef CONFIG_MM_SLAB
+          mqmsg = (FAR struct mqueue_msg_s *)slab_alloc(&g_msgcache);
+#else
           mqmsg = (FAR struct mqueue_msg_s *)
             kmm_malloc((sizeof (struct mqueue_msg_s)));
+#endif
 
           /* Check if we allocated the message */
 
@@ -346,11 +384,18 @@ int nxmq_do_send(FAR struct mqueue_inode_s *msgq,
 
   /* Search the message list to find the location to insert the new
    * message. Each is list is maintained in ascending priority order.
+   * Most messages are sent with the same priority as the last message in
+   * the queue, so check the tail first to avoid walking the whole list.
    */
 
-  for (prev = NULL, next = (FAR struct mqueue_msg_s *)msgq->msglist.head;
-       next && prio <= next->priority;
-       prev = next, next = next->next);
+  prev = (FAR struct mqueue_msg_s *)msgq->msglist.tail;
+  if (prev == NULL || prio > prev->priority)
+    {
+      for (prev = NULL,
+           next = (FAR struct mqueue_msg_s *)msgq->msglist.head;
+           next && prio <= next->priority;
+           prev = next, next = next->next);
+    }
 
   /* Add the message at the right place */
 
@@ -175,7 +175,7 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
 
   /* Pre-allocate a message structure */
 
-  mqmsg = nxmq_alloc_msg();
+  mqmsg = nxmq_alloc_msg(msgq);
   if (mqmsg == NULL)
     {
       /* Failed to allocate the message. nxmq_alloc_msg() does not set the
@@ -302,7 +302,7 @@ errout_in_critical_section:
    */
 
 errout_with_mqmsg:
-  nxmq_free_msg(mqmsg);
+  nxmq_free_msg(msgq, mqmsg);
   sched_unlock();
   return ret;
 }
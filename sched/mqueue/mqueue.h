@@ -29,13 +29,17 @@
 #include <nuttx/compiler.h>
 
 #include <sys/types.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <limits.h>
 #include <mqueue.h>
 #include <sched.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/mqueue.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/slab.h>
 
 #if defined(CONFIG_MQ_MAXMSGSIZE) && CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -47,6 +51,19 @@
 #define MQ_MAX_MSGS    16
 #define MQ_PRIO_MAX    _POSIX_MQ_PRIO_MAX
 
+/* The message free lists are protected by a spinlock of their own in SMP
+ * mode so that message allocation does not contend for the global critical
+ * section, unless CONFIG_SMP_GLOBAL_CSECTION selects the legacy behavior.
+ */
+
+#if defined(CONFIG_SMP) && !defined(CONFIG_SMP_GLOBAL_CSECTION)
+#  define nxmq_lock_freelist()    spin_lock_irqsave(&g_msgfreelock)
+#  define nxmq_unlock_freelist(f) spin_unlock_irqrestore(&g_msgfreelock, f)
+#else
+#  define nxmq_lock_freelist()    enter_critical_section()
+#  define nxmq_unlock_freelist(f) leave_critical_section(f)
+#endif
+
 /********************************************************************************
  * Public Type Definitions
  ********************************************************************************/
@@ -55,7 +72,8 @@ enum mqalloc_e
 {
   MQ_ALLOC_FIXED = 0,  /* Pre-allocated; never freed */
   MQ_ALLOC_DYN,        /* Dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_QUEUE       /* Preallocated for one message queue */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -73,6 +91,12 @@ struct mqueue_msg_s
   char mail[MQ_MAX_BYTES];        /* Message data */
 };
 
+/* The size of a message that has room for 'n' bytes of data */
+
+#define MQ_MSG_SIZE(n) \
+  ((offsetof(struct mqueue_msg_s, mail) + (n) + sizeof(uintptr_t) - 1) & \
+   ~(sizeof(uintptr_t) - 1))
+
 /********************************************************************************
  * Public Data
  ********************************************************************************/
@@ -97,6 +121,20 @@ EXTERN sq_queue_t  g_msgfree;
 
 EXTERN sq_queue_t  g_msgfreeirq;
 
+#if defined(CONFIG_SMP) && !defined(CONFIG_SMP_GLOBAL_CSECTION)
+/* The g_msgfreelock protects g_msgfree and g_msgfreeirq. */
+
+EXTERN spinlock_t  g_msgfreelock;
+#endif
+
+#ifdef CONFIG_MM_SLAB
+/* The g_msgcache is the slab cache that dynamically allocated messages are
+ * taken from once the pre-allocated messages are exhausted.
+ */
+
+EXTERN struct slab_cache_s g_msgcache;
+#endif
+
 /********************************************************************************
  * Public Function Prototypes
  ********************************************************************************/
@@ -107,7 +145,8 @@ struct task_group_s; /* Forward reference */
 /* Functions defined in mq_initialize.c *****************************************/
 
 void weak_function nxmq_initialize(void);
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg);
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg);
 
 /* mq_waitirq.c *****************************************************************/
 
@@ -127,7 +166,7 @@ ssize_t nxmq_do_receive(FAR struct mqueue_inode_s *msgq,
 
 int nxmq_verify_send(FAR struct mqueue_inode_s *msgq, int oflags,
                      FAR const char *msg, size_t msglen, unsigned int prio);
-FAR struct mqueue_msg_s *nxmq_alloc_msg(void);
+FAR struct mqueue_msg_s *nxmq_alloc_msg(FAR struct mqueue_inode_s *msgq);
 int nxmq_wait_send(FAR struct mqueue_inode_s *msgq, int oflags);
 int nxmq_do_send(FAR struct mqueue_inode_s *msgq,
                  FAR struct mqueue_msg_s *mqmsg,
@@ -88,6 +88,13 @@ FAR struct join_s *pthread_findjoininfo(FAR struct task_group_s *group,
                                         pid_t pid);
 void pthread_release(FAR struct task_group_s *group);
 
+#if CONFIG_PTHREAD_CACHE > 0
+FAR struct pthread_tcb_s *pthread_cache_alloc(size_t stacksize,
+                                              FAR void **stack,
+                                              FAR size_t *size);
+void pthread_cache_release(FAR struct tcb_s *tcb);
+#endif
+
 int pthread_sem_take(FAR sem_t *sem, FAR const struct timespec *abs_timeout,
                      bool intr);
 #ifdef CONFIG_PTHREAD_MUTEX_UNSAFE
@@ -99,14 +106,21 @@ int pthread_sem_give(sem_t *sem);
 int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
                        FAR const struct timespec *abs_timeout, bool intr);
 int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex);
+int pthread_mutex_requeued(FAR struct pthread_mutex_s *mutex);
 int pthread_mutex_give(FAR struct pthread_mutex_s *mutex);
 void pthread_mutex_inconsistent(FAR struct tcb_s *tcb);
 #else
 #  define pthread_mutex_take(m,abs_timeout,i)  pthread_sem_take(&(m)->sem,(abs_timeout),(i))
 #  define pthread_mutex_trytake(m)             pthread_sem_trytake(&(m)->sem)
+#  define pthread_mutex_requeued(m)            (OK)
 #  define pthread_mutex_give(m)                pthread_sem_give(&(m)->sem)
 #endif
 
+int pthread_cond_take(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex,
+                      clockid_t clockid, FAR const struct timespec *abstime,
+                      FAR bool *locked);
+bool pthread_cond_requeue(FAR pthread_cond_t *cond);
+
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
 int pthread_mutexattr_verifytype(int type);
 #endif
@@ -0,0 +1,212 @@
+/****************************************************************************
+ * sched/pthread/pthread_cache.c
+ *
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+
+#include "pthread/pthread.h"
+
+#if CONFIG_PTHREAD_CACHE > 0
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The TCBs of exited pthreads, each one still owning its stack.  The list
+ * is linked through the flink field of the TCB.
+ */
+
+static sq_queue_t g_pthread_cache;
+static uint8_t    g_pthread_ncached;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_cache_stacksize
+ *
+ * Description:
+ *   Return the size of the stack region owned by a cached TCB, i.e. the
+ *   size that was set up by up_create_stack() or up_use_stack().
+ *
+ ****************************************************************************/
+
+static size_t pthread_cache_stacksize(FAR struct tcb_s *tcb)
+{
+  return (uintptr_t)tcb->stack_base_ptr - (uintptr_t)tcb->stack_alloc_ptr +
+         tcb->adj_stack_size;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_cache_alloc
+ *
+ * Description:
+ *   Allocate a zeroed pthread TCB, preferably one cached by
+ *   pthread_cache_release() together with a stack that is large enough.
+ *
+ * Input Parameters:
+ *   stacksize - The stack size needed, including the TLS
+ *   stack     - The location to return the cached stack, or NULL if the
+ *               caller provides its own stack.  NULL is returned if no
+ *               cached stack is large enough.
+ *   size      - The location to return the size of the cached stack
+ *
+ * Returned Value:
+ *   The TCB or NULL if there is no memory for it.
+ *
+ ****************************************************************************/
+
+FAR struct pthread_tcb_s *pthread_cache_alloc(size_t stacksize,
+                                              FAR void **stack,
+                                              FAR size_t *size)
+{
+  FAR struct tcb_s *tcb;
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *curr;
+  irqstate_t flags;
+
+  if (stack != NULL)
+    {
+      *stack = NULL;
+    }
+
+  flags = enter_critical_section();
+
+  /* Look for a TCB with a stack that fits.  Without one, take the oldest
+   * TCB; its stack is released below.
+   */
+
+  for (curr = sq_peek(&g_pthread_cache); curr != NULL; curr = sq_next(curr))
+    {
+      tcb = (FAR struct tcb_s *)curr;
+      if (stack != NULL && pthread_cache_stacksize(tcb) >= stacksize)
+        {
+          break;
+        }
+
+      prev = curr;
+    }
+
+  if (curr != NULL)
+    {
+      if (prev != NULL)
+        {
+          sq_remafter(prev, &g_pthread_cache);
+        }
+      else
+        {
+          sq_remfirst(&g_pthread_cache);
+        }
+    }
+  else
+    {
+      curr = sq_remfirst(&g_pthread_cache);
+    }
+
+  if (curr != NULL)
+    {
+      g_pthread_ncached--;
+    }
+
+  leave_critical_section(flags);
+
+  if (curr == NULL)
+    {
+      return (FAR struct pthread_tcb_s *)
+        kmm_zalloc(sizeof(struct pthread_tcb_s));
+    }
+
+  /* Hand over the stack if it fits, or release it */
+
+  tcb = (FAR struct tcb_s *)curr;
+  if (stack != NULL && pthread_cache_stacksize(tcb) >= stacksize)
+    {
+      *stack = tcb->stack_alloc_ptr;
+      *size  = pthread_cache_stacksize(tcb);
+    }
+  else
+    {
+      up_release_stack(tcb, TCB_FLAG_TTYPE_PTHREAD);
+    }
+
+  memset(tcb, 0, sizeof(struct pthread_tcb_s));
+  return (FAR struct pthread_tcb_s *)tcb;
+}
+
+/****************************************************************************
+ * Name: pthread_cache_release
+ *
+ * Description:
+ *   Release the TCB of a pthread and its stack.  They are kept for the
+ *   next pthread_create() if the stack was allocated by the OS and the
+ *   cache is not full; otherwise they are freed.
+ *
+ * Input Parameters:
+ *   tcb - The TCB to release.  Everything except the stack has already
+ *         been released.
+ *
+ ****************************************************************************/
+
+void pthread_cache_release(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+
+  if (tcb->stack_alloc_ptr != NULL && (tcb->flags & TCB_FLAG_FREE_STACK))
+    {
+      flags = enter_critical_section();
+      if (g_pthread_ncached < CONFIG_PTHREAD_CACHE)
+        {
+          sq_addlast((FAR sq_entry_t *)tcb, &g_pthread_cache);
+          g_pthread_ncached++;
+          leave_critical_section(flags);
+          return;
+        }
+
+      leave_critical_section(flags);
+    }
+
+  if (tcb->stack_alloc_ptr != NULL)
+    {
+      up_release_stack(tcb, TCB_FLAG_TTYPE_PTHREAD);
+    }
+
+  kmm_free(tcb);
+}
+
+#endif /* CONFIG_PTHREAD_CACHE > 0 */
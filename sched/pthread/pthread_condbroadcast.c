@@ -77,8 +77,22 @@ int pthread_cond_broadcast(FAR pthread_cond_t *cond)
         {
           ret = EINVAL;
         }
+
+      /* If the mutex that the waiters will take next is held, move them
+       * all to the mutex instead: they would otherwise all be restarted
+       * just to block again on the mutex, one after the other.
+       */
+
+      else if (sval < 0 && pthread_cond_requeue(cond))
+        {
+          sinfo("Waiters moved to mutex=0x%p\n", cond->mutex);
+        }
       else
         {
+          /* Some threads may have been moved to the mutex */
+
+          nxsem_get_value((FAR sem_t *)&cond->sem, &sval);
+
           /* Loop until all of the waiting threads have been restarted. */
 
           while (sval < 0)
@@ -116,6 +116,7 @@ int pthread_cond_clockwait(FAR pthread_cond_t *cond,
       uint8_t type;
       int16_t nlocks;
 #endif
+      bool locked = false;
 
       sinfo("Give up mutex...\n");
 
@@ -141,12 +142,7 @@ int pthread_cond_clockwait(FAR pthread_cond_t *cond,
       ret        = pthread_mutex_give(mutex);
       if (ret == 0)
         {
-          status = nxsem_clockwait_uninterruptible(
-                   &cond->sem, clockid, abstime);
-          if (status < 0)
-            {
-              ret = -status;
-            }
+          ret = pthread_cond_take(cond, mutex, clockid, abstime, &locked);
         }
 
       /* Restore interrupts  (pre-emption will be enabled
@@ -159,7 +155,15 @@ int pthread_cond_clockwait(FAR pthread_cond_t *cond,
 
       sinfo("Re-locking...\n");
 
-      status = pthread_mutex_take(mutex, NULL, false);
+      if (locked)
+        {
+          status = ret;
+        }
+      else
+        {
+          status = pthread_mutex_take(mutex, NULL, false);
+        }
+
       if (status == OK)
         {
           mutex->pid    = mypid;
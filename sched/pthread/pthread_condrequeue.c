@@ -0,0 +1,255 @@
+/****************************************************************************
+ * sched/pthread/pthread_condrequeue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+#include <queue.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
+#include "pthread/pthread.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_cond_block
+ *
+ * Description:
+ *   Account for one more thread waiting on the semaphore of a mutex, but
+ *   only if the mutex is held: a thread moved to a free mutex would never
+ *   be woken up.  The caller must be in a critical section.
+ *
+ *   With CONFIG_PTHREAD_MUTEX_FASTPATH the count of an uncontended mutex
+ *   may go from 0 to 1 in the C library at any time, see
+ *   nxsem_dec_count().
+ *
+ ****************************************************************************/
+
+static bool pthread_cond_block(FAR sem_t *sem)
+{
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && defined(CONFIG_SMP)
+  int16_t count = sem->semcount;
+
+  while (count <= 0)
+    {
+      if (__atomic_compare_exchange_n(&sem->semcount, &count, count - 1,
+                                      false, __ATOMIC_ACQUIRE,
+                                      __ATOMIC_RELAXED))
+        {
+          return true;
+        }
+    }
+
+  return false;
+#else
+  if (sem->semcount <= 0)
+    {
+      sem->semcount--;
+      return true;
+    }
+
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_cond_take
+ *
+ * Description:
+ *   Wait on the semaphore of a condition variable after the mutex has been
+ *   given up.  If pthread_cond_broadcast() moved the thread to the mutex
+ *   in the meantime, the thread may have been woken up as the new holder
+ *   of the mutex: there is then no need to take the mutex again.
+ *
+ *   Signals are ignored as long as the thread waits on the condition
+ *   variable.  The caller must have locked the scheduler.
+ *
+ * Input Parameters:
+ *   cond    - The condition variable to wait on
+ *   mutex   - The mutex that was given up
+ *   clockid - The timing source of abstime
+ *   abstime - The absolute time of the timeout or NULL to wait forever
+ *   locked  - Set to true if the mutex is held on return
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.  If *locked is true, this
+ *   is the status of the take of the mutex instead.
+ *
+ ****************************************************************************/
+
+int pthread_cond_take(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex,
+                      clockid_t clockid, FAR const struct timespec *abstime,
+                      FAR bool *locked)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  int ret;
+
+  /* Record the mutex for pthread_cond_broadcast().  POSIX leaves the use
+   * of different mutexes with the same condition variable at the same
+   * time undefined, so all waiters must be using this one.
+   */
+
+  cond->mutex = mutex;
+  *locked     = false;
+
+  do
+    {
+      if (abstime != NULL)
+        {
+          ret = nxsem_clockwait(&cond->sem, clockid, abstime);
+        }
+      else
+        {
+          ret = nxsem_wait(&cond->sem);
+        }
+    }
+  while (ret == -EINTR &&
+         (rtcb->flags & TCB_FLAG_COND_REQUEUED) == 0);
+
+  if ((rtcb->flags & TCB_FLAG_COND_REQUEUED) != 0)
+    {
+      rtcb->flags &= ~TCB_FLAG_COND_REQUEUED;
+
+      if (ret == OK)
+        {
+          /* We were woken up by the holder of the mutex that gave it to
+           * us.
+           */
+
+          *locked = true;
+          return pthread_mutex_requeued(mutex);
+        }
+      else if (ret == -EINTR)
+        {
+          /* A signal was received while waiting for the mutex: the
+           * condition was already signaled, so this is no error.
+           */
+
+          ret = OK;
+        }
+    }
+
+  return -ret;
+}
+
+/****************************************************************************
+ * Name: pthread_cond_requeue
+ *
+ * Description:
+ *   Move all of the threads waiting on a condition variable to the
+ *   semaphore of the mutex that they will take next, in place of waking
+ *   them all up only to have all but one block again on the mutex.  The
+ *   holder of the mutex will then wake them up one at a time as it is
+ *   released.
+ *
+ *   This is only possible if the mutex is currently held and if it does
+ *   not use priority inheritance: waiters that did not block on a mutex
+ *   with priority inheritance have not boosted its holder.
+ *
+ * Input Parameters:
+ *   cond - The condition variable to broadcast
+ *
+ * Returned Value:
+ *   true if all of the waiters were moved to the mutex.  false if some, or
+ *   all, of them must still be woken up by posting the condition variable.
+ *
+ * Assumptions:
+ *   The caller has locked the scheduler.
+ *
+ ****************************************************************************/
+
+bool pthread_cond_requeue(FAR pthread_cond_t *cond)
+{
+  FAR pthread_mutex_t *mutex = cond->mutex;
+  FAR struct tcb_s *stcb;
+  irqstate_t flags;
+  bool done = true;
+
+  if (mutex == NULL)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if ((mutex->sem.flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+    {
+      return false;
+    }
+#endif
+
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
+  if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0)
+    {
+      return false;
+    }
+#endif
+
+  flags = enter_critical_section();
+
+  /* All waiters are in the same list, so a waiter is moved by changing
+   * the semaphore it waits on.  The list is kept in priority order, so
+   * the mutex will still go to the highest priority waiter first.
+   */
+
+  for (stcb = (FAR struct tcb_s *)g_waitingforsemaphore.head;
+       stcb != NULL && cond->sem.semcount < 0;
+       stcb = stcb->flink)
+    {
+      if (stcb->waitsem == &cond->sem)
+        {
+          if (!pthread_cond_block(&mutex->sem))
+            {
+              /* The mutex was released.  Leave the remaining waiters to
+               * the caller.
+               */
+
+              done = false;
+              break;
+            }
+
+          cond->sem.semcount++;
+          stcb->waitsem = &mutex->sem;
+          stcb->flags  |= TCB_FLAG_COND_REQUEUED;
+        }
+    }
+
+  leave_critical_section(flags);
+  return done;
+}
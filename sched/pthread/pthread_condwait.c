@@ -87,6 +87,7 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
       uint8_t type;
       int16_t nlocks;
 #endif
+      bool locked = false;
 
       /* Give up the mutex */
 
@@ -104,15 +105,15 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
       ret        = pthread_mutex_give(mutex);
 
       /* Take the semaphore.  This may be awakened only be a signal (EINTR)
-       * or if the thread is canceled (ECANCELED)
+       * or if the thread is canceled (ECANCELED).  If the thread was moved
+       * to the mutex by pthread_cond_broadcast(), it may also come back
+       * with the mutex held.
        */
 
-      status = pthread_sem_take((FAR sem_t *)&cond->sem, NULL, false);
       if (ret == OK)
         {
-          /* Report the first failure that occurs */
-
-          ret = status;
+          ret = pthread_cond_take(cond, mutex, CLOCK_REALTIME, NULL,
+                                  &locked);
         }
 
       sched_unlock();
@@ -126,12 +127,19 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 
       sinfo("Reacquire mutex...\n");
 
-      status = pthread_mutex_take(mutex, NULL, false);
-      if (ret == OK)
+      if (locked)
+        {
+          status = ret;
+        }
+      else
         {
-          /* Report the first failure that occurs */
+          status = pthread_mutex_take(mutex, NULL, false);
+          if (ret == OK)
+            {
+              /* Report the first failure that occurs */
 
-          ret = status;
+              ret = status;
+            }
         }
 
       /* Did we get the mutex? */
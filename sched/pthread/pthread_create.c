@@ -218,6 +218,10 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
   FAR struct tls_info_s *info;
   FAR struct join_s *pjoin;
   struct sched_param param;
+#if CONFIG_PTHREAD_CACHE > 0
+  FAR void *stack;
+  size_t stacksize;
+#endif
   int policy;
   int errcode;
   pid_t pid;
@@ -235,8 +239,13 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
 
   /* Allocate a TCB for the new task. */
 
+#if CONFIG_PTHREAD_CACHE > 0
+  ptcb = pthread_cache_alloc(up_tls_size() + attr->stacksize,
+                             attr->stackaddr ? NULL : &stack, &stacksize);
+#else
   ptcb = (FAR struct pthread_tcb_s *)
             kmm_zalloc(sizeof(struct pthread_tcb_s));
+#endif
   if (!ptcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -287,6 +296,17 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
       ret = up_use_stack((FAR struct tcb_s *)ptcb, attr->stackaddr,
                          attr->stacksize);
     }
+#if CONFIG_PTHREAD_CACHE > 0
+  else if (stack != NULL)
+    {
+      /* Use the stack of an exited pthread.  It was allocated by the OS and
+       * must still be freed by it.
+       */
+
+      ret = up_use_stack((FAR struct tcb_s *)ptcb, stack, stacksize);
+      ptcb->cmn.flags |= TCB_FLAG_FREE_STACK;
+    }
+#endif
   else
     {
       /* Allocate the stack for the TCB */
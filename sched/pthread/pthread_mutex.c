@@ -253,6 +253,45 @@ int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
   return ret;
 }
 
+/****************************************************************************
+ * Name: pthread_mutex_requeued
+ *
+ * Description:
+ *   Complete the take of a mutex whose semaphore was handed to the calling
+ *   thread after pthread_cond_broadcast() moved it from the condition
+ *   variable to the mutex.  The mutex is added to the list of mutexes held
+ *   by this thread as pthread_mutex_take() does.
+ *
+ * Input Parameters:
+ *  mutex - The mutex that was acquired
+ *
+ * Returned Value:
+ *   0 on success or EOWNERDEAD if the mutex is inconsistent.  The
+ *   semaphore is held in either case.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_requeued(FAR struct pthread_mutex_s *mutex)
+{
+  int ret = OK;
+
+  DEBUGASSERT(mutex != NULL);
+
+  sched_lock();
+
+  if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0)
+    {
+      ret = EOWNERDEAD;
+    }
+  else
+    {
+      pthread_mutex_add(mutex);
+    }
+
+  sched_unlock();
+  return ret;
+}
+
 /****************************************************************************
  * Name: pthread_mutex_give
  *
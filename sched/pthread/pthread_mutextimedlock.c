@@ -31,6 +31,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/pthread.h>
 #include <nuttx/sched.h>
 
 #include "pthread/pthread.h"
@@ -40,7 +41,7 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pthread_mutex_timedlock
+ * Name: nx_pthread_mutex_timedlock
  *
  * Description:
  *   The pthread_mutex_timedlock() function will lock the mutex object
@@ -56,6 +57,10 @@
  *   abs_timeout), or if the absolute time specified by abs_timeout
  *   has already been passed at the time of the call.
  *
+ *   This is the OS part of pthread_mutex_timedlock().  The C library wrapper
+ *   handles uncontended mutexes itself if CONFIG_PTHREAD_MUTEX_FASTPATH is
+ *   selected and calls this function otherwise.
+ *
  * Input Parameters:
  *   mutex - A reference to the mutex to be locked.
  *   abs_timeout - max wait time (NULL wait forever)
@@ -75,8 +80,8 @@
  *
  ****************************************************************************/
 
-int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
-                            FAR const struct timespec *abs_timeout)
+int nx_pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
+                               FAR const struct timespec *abs_timeout)
 {
   pid_t mypid = getpid();
   int ret = EINVAL;
@@ -31,6 +31,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/pthread.h>
+
 #include "pthread/pthread.h"
 
 /****************************************************************************
@@ -38,7 +40,7 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pthread_mutex_trylock
+ * Name: nx_pthread_mutex_trylock
  *
  * Description:
  *   The function pthread_mutex_trylock() is identical to
@@ -50,6 +52,10 @@
  *   from the signal handler the thread resumes waiting for the mutex as if
  *   it was not interrupted.
  *
+ *   This is the OS part of pthread_mutex_trylock().  The C library wrapper
+ *   handles uncontended mutexes itself if CONFIG_PTHREAD_MUTEX_FASTPATH is
+ *   selected and calls this function otherwise.
+ *
  * Input Parameters:
  *   mutex - A reference to the mutex to be locked.
  *
@@ -66,7 +72,7 @@
  *
  ****************************************************************************/
 
-int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
+int nx_pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
 {
   int status;
   int ret = EINVAL;
@@ -31,6 +31,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/pthread.h>
+
 #include "pthread/pthread.h"
 
 /****************************************************************************
@@ -71,7 +73,7 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pthread_mutex_unlock
+ * Name: nx_pthread_mutex_unlock
  *
  * Description:
  *   The pthread_mutex_unlock() function releases the mutex object referenced
@@ -88,6 +90,10 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  *   from the signal handler the thread resumes waiting for the mutex as if
  *   it was not interrupted.
  *
+ *   This is the OS part of pthread_mutex_unlock().  The C library wrapper
+ *   handles uncontended mutexes itself if CONFIG_PTHREAD_MUTEX_FASTPATH is
+ *   selected and calls this function otherwise.
+ *
  * Input Parameters:
  *   None
  *
@@ -98,7 +104,7 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  *
  ****************************************************************************/
 
-int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
+int nx_pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
 {
   int ret = EPERM;
 
@@ -0,0 +1,59 @@
+/****************************************************************************
+ * sched/rcu/rcu.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __SCHED_RCU_RCU_H
+#define __SCHED_RCU_RCU_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/rcu.h>
+
+#if defined(CONFIG_RCU) && defined(CONFIG_SMP)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Called on each context switch: a CPU that has switched context cannot
+ * still be in a read-side critical section that it entered before.
+ */
+
+#define rcu_note_context_switch(cpu) (g_rcu_qscount[cpu]++)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The read-side critical section nesting level of each CPU */
+
+extern volatile uint16_t g_rcu_nesting[CONFIG_SMP_NCPUS];
+
+/* The number of context switches of each CPU */
+
+extern volatile uint32_t g_rcu_qscount[CONFIG_SMP_NCPUS];
+
+#endif /* CONFIG_RCU && CONFIG_SMP */
+#endif /* __SCHED_RCU_RCU_H */
@@ -0,0 +1,132 @@
+/****************************************************************************
+ * sched/rcu/rcu_call.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+
+#include "rcu/rcu.h"
+
+#if defined(CONFIG_RCU) && defined(CONFIG_SCHED_WORKQUEUE)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The callbacks waiting for the next grace period */
+
+static FAR struct rcu_head *g_rcu_head;
+static FAR struct rcu_head *g_rcu_tail;
+
+/* Runs the callbacks on the low priority work queue */
+
+static struct work_s g_rcu_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rcu_worker
+ *
+ * Description:
+ *   Take all of the pending callbacks, wait for one grace period and call
+ *   them.  The callbacks queued meanwhile will schedule the work again.
+ *
+ ****************************************************************************/
+
+static void rcu_worker(FAR void *arg)
+{
+  FAR struct rcu_head *head;
+  FAR struct rcu_head *next;
+  irqstate_t flags;
+
+  flags      = enter_critical_section();
+  head       = g_rcu_head;
+  g_rcu_head = NULL;
+  g_rcu_tail = NULL;
+  leave_critical_section(flags);
+
+  synchronize_rcu();
+
+  for (; head != NULL; head = next)
+    {
+      next = head->flink;
+      head->func(head);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: call_rcu
+ *
+ * Description:
+ *   Call func(head) on the low priority work queue after a grace period
+ *   has elapsed.
+ *
+ * Input Parameters:
+ *   head - The rcu_head embedded in the object to reclaim.
+ *   func - The function that will reclaim the object.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void call_rcu(FAR struct rcu_head *head, rcu_callback_t func)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(head != NULL && func != NULL);
+
+  head->flink = NULL;
+  head->func  = func;
+
+  flags = enter_critical_section();
+  if (g_rcu_tail != NULL)
+    {
+      g_rcu_tail->flink = head;
+    }
+  else
+    {
+      g_rcu_head = head;
+    }
+
+  g_rcu_tail = head;
+
+  if (work_available(&g_rcu_work))
+    {
+      work_queue(LPWORK, &g_rcu_work, rcu_worker, NULL, 0);
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_RCU && CONFIG_SCHED_WORKQUEUE */
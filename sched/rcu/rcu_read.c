@@ -0,0 +1,111 @@
+/****************************************************************************
+ * sched/rcu/rcu_read.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+
+#include "sched/sched.h"
+#include "rcu/rcu.h"
+
+#if defined(CONFIG_RCU) && defined(CONFIG_SMP)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The read-side critical section nesting level of each CPU */
+
+volatile uint16_t g_rcu_nesting[CONFIG_SMP_NCPUS];
+
+/* The number of context switches of each CPU */
+
+volatile uint32_t g_rcu_qscount[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The interrupt state saved by the outermost rcu_read_lock() of each CPU */
+
+static irqstate_t g_rcu_flags[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rcu_read_lock
+ *
+ * Description:
+ *   Enter an RCU read-side critical section.  The local interrupts are
+ *   disabled so that the reader stays on this CPU without a context
+ *   switch.  Unlike sched_lock(), this takes no lock that is shared with
+ *   the other CPUs, so readers on different CPUs do not contend.
+ *
+ ****************************************************************************/
+
+void rcu_read_lock(void)
+{
+  irqstate_t flags = up_irq_save();
+  int cpu = this_cpu();
+
+  if (g_rcu_nesting[cpu]++ == 0)
+    {
+      g_rcu_flags[cpu] = flags;
+    }
+
+  /* The nesting level must be visible before the protected data are read */
+
+  RCU_MB();
+}
+
+/****************************************************************************
+ * Name: rcu_read_unlock
+ *
+ * Description:
+ *   Leave an RCU read-side critical section.
+ *
+ ****************************************************************************/
+
+void rcu_read_unlock(void)
+{
+  int cpu = this_cpu();
+
+  DEBUGASSERT(g_rcu_nesting[cpu] > 0);
+
+  /* Complete the reads of the protected data before leaving */
+
+  RCU_MB();
+
+  if (--g_rcu_nesting[cpu] == 0)
+    {
+      up_irq_restore(g_rcu_flags[cpu]);
+    }
+}
+
+#endif /* CONFIG_RCU && CONFIG_SMP */
@@ -0,0 +1,111 @@
+/****************************************************************************
+ * sched/rcu/rcu_synchronize.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+
+#include "sched/sched.h"
+#include "rcu/rcu.h"
+
+#ifdef CONFIG_RCU
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: synchronize_rcu
+ *
+ * Description:
+ *   Wait for a grace period: return only after every read-side critical
+ *   section that was in progress at the time of the call has completed.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Must not be called from an interrupt handler or from inside a
+ *   read-side critical section.
+ *
+ ****************************************************************************/
+
+void synchronize_rcu(void)
+{
+#ifdef CONFIG_SMP
+  uint32_t snap[CONFIG_SMP_NCPUS];
+  int cpu;
+#endif
+
+  DEBUGASSERT(!up_interrupt_context());
+
+  /* Make the updates visible before looking at the readers */
+
+  RCU_MB();
+
+#ifdef CONFIG_SMP
+  /* A reader on this CPU cannot have been pre-empted, so we would wait
+   * for ourselves.
+   */
+
+  DEBUGASSERT(g_rcu_nesting[this_cpu()] == 0);
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      snap[cpu] = g_rcu_qscount[cpu];
+    }
+
+  /* A CPU has passed through a quiescent state once it is seen outside of
+   * any read-side critical section, or once it has switched context.  A
+   * CPU running its idle loop is never in a critical section, so it does
+   * not hold up the grace period.  Readers are short and never block, so
+   * simply spin on the remaining CPUs.
+   */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      while (g_rcu_nesting[cpu] > 0 && g_rcu_qscount[cpu] == snap[cpu])
+        {
+          SP_DSB();
+        }
+    }
+
+  /* Do not let the reclamation by the caller move before the wait */
+
+  RCU_MB();
+#else
+  /* With a single CPU, rcu_read_lock() disables pre-emption and readers
+   * never block:  There cannot be a reader in progress while we are
+   * running.  Interrupt handlers always complete before we resume.
+   */
+#endif
+}
+
+#endif /* CONFIG_RCU */
@@ -341,6 +341,9 @@ int  nxsched_reprioritize(FAR struct tcb_s *tcb, int sched_priority);
 unsigned int nxsched_cancel_timer(void);
 void nxsched_resume_timer(void);
 void nxsched_reassess_timer(void);
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+void nxsched_resume_cpu_timer(FAR struct tcb_s *tcb);
+#endif
 #else
 #  define nxsched_cancel_timer() (0)
 #  define nxsched_resume_timer()
@@ -366,6 +369,25 @@ uint32_t nxsched_process_sporadic(FAR struct tcb_s *tcb, uint32_t ticks,
 void nxsched_sporadic_lowpriority(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+int  nxsched_start_deadline(FAR struct tcb_s *tcb,
+                            FAR const struct sched_param *param);
+void nxsched_stop_deadline(FAR struct tcb_s *tcb);
+void nxsched_wakeup_deadline(FAR struct tcb_s *tcb);
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches);
+
+/* True if the deadline thread 'a' must run before the thread 'b' of the
+ * same priority: earliest deadline first.
+ */
+
+#  define nxsched_deadline_before(a, b) \
+     (((a)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE && \
+      ((b)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE && \
+      (a)->sched_priority == (b)->sched_priority && \
+      (sclock_t)((a)->deadline.abstime - (b)->deadline.abstime) < 0)
+#endif
+
 #ifdef CONFIG_SIG_SIGSTOP_ACTION
 void nxsched_suspend(FAR struct tcb_s *tcb);
 void nxsched_continue(FAR struct tcb_s *tcb);
@@ -386,6 +408,25 @@ int  nxsched_pause_cpu(FAR struct tcb_s *tcb);
 #  define nxsched_islocked_tcb(tcb) ((tcb)->lockcount > 0)
 #endif
 
+/* CPU isolation.  nxsched_cpu_nohz() is true if the CPU is isolated and
+ * runs a single thread (other than its IDLE task, which is the last in
+ * the assigned task list), so that there is nothing to time slice.
+ */
+
+#ifdef CONFIG_SCHED_CPU_ISOLATION
+#  define CPU_ISOLATED_SET \
+     ((cpu_set_t)CONFIG_SCHED_ISOLCPUS & ~(cpu_set_t)1)
+#  define nxsched_cpu_isolated(cpu) \
+     ((CPU_ISOLATED_SET & ((cpu_set_t)1 << (cpu))) != 0)
+#  define nxsched_cpu_nohz(cpu) \
+     (nxsched_cpu_isolated(cpu) && \
+      (current_task(cpu)->flink == NULL || \
+       current_task(cpu)->flink->flink == NULL))
+#else
+#  define nxsched_cpu_isolated(cpu) (false)
+#  define nxsched_cpu_nohz(cpu)     (false)
+#endif
+
 #if defined(CONFIG_SCHED_CPULOAD) && !defined(CONFIG_SCHED_CPULOAD_EXTCLK)
 /* CPU load measurement support */
 
@@ -396,12 +437,26 @@ void weak_function nxsched_process_cpuload_ticks(uint32_t ticks);
 /* Critical section monitor */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
-void nxsched_critmon_preemption(FAR struct tcb_s *tcb, bool state);
-void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state);
+void nxsched_critmon_preemption(FAR struct tcb_s *tcb, bool state,
+                                FAR void *caller);
+void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state,
+                              FAR void *caller);
 void nxsched_resume_critmon(FAR struct tcb_s *tcb);
 void nxsched_suspend_critmon(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+void nxsched_critmon_hist(FAR struct critmon_hist_s *hist,
+                          uint32_t elapsed, FAR void *ip);
+#endif
+
+/* Per-task hardware performance counters */
+
+#ifdef CONFIG_SCHED_PMU
+void nxsched_resume_pmu(FAR struct tcb_s *tcb);
+void nxsched_suspend_pmu(FAR struct tcb_s *tcb);
+#endif
+
 /* TCB operations */
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
@@ -76,9 +76,20 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
    * Each is list is maintained in descending sched_priority order.
    */
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Threads with the SCHED_DEADLINE policy and the same priority are
+   * further kept in order of their absolute deadlines.
+   */
+
+  for (next = (FAR struct tcb_s *)list->head;
+       (next && sched_priority <= next->sched_priority &&
+        !nxsched_deadline_before(tcb, next));
+       next = next->flink);
+#else
   for (next = (FAR struct tcb_s *)list->head;
        (next && sched_priority <= next->sched_priority);
        next = next->flink);
+#endif
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
    * goes at the end of the list. NOTE:  This could only happen if list
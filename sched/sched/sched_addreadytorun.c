@@ -69,6 +69,12 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   FAR struct tcb_s *rtcb = this_task();
   bool ret;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  /* Remember when the task became ready for the wakeup latency */
+
+  btcb->ready_start = up_perf_gettime();
+#endif
+
   /* Check if pre-emption is disabled for the current running task and if
    * the new ready-to-run task would cause the current running task to be
    * pre-empted.  NOTE that IRQs disabled implies that pre-emption is
@@ -158,6 +164,12 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   int cpu;
   int me;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  /* Remember when the task became ready for the wakeup latency */
+
+  btcb->ready_start = up_perf_gettime();
+#endif
+
   /* Check if the blocked TCB is locked to this CPU */
 
   if ((btcb->flags & TCB_FLAG_CPU_LOCKED) != 0)
@@ -259,6 +271,15 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
           DEBUGVERIFY(up_cpu_pause(cpu));
         }
 
+#ifdef CONFIG_SCHED_IRQBALANCE
+      /* Tell the IRQ balancer where the interrupt handler woke a task */
+
+      if (up_interrupt_context())
+        {
+          g_irq_wakecpu[me] = cpu + 1;
+        }
+#endif
+
       /* Add the task to the list corresponding to the selected state
        * and check if a context switch will occur
        */
@@ -180,9 +180,20 @@ void weak_function nxsched_process_cpuload_ticks(uint32_t ticks)
 
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
-      nxsched_cpu_process_cpuload(i, ticks);
+      /* The load of isolated CPUs is not sampled */
+
+      if (!nxsched_cpu_isolated(i))
+        {
+          nxsched_cpu_process_cpuload(i, ticks);
+        }
     }
 
+#ifdef CONFIG_SCHED_PROFILE
+  /* Sample what this CPU was doing for the profiler */
+
+  nxsched_profile_sample();
+#endif
+
   /* If the accumulated tick value exceed a time constant, then shift the
    * accumulators and recalculate the total.
    */
@@ -50,6 +50,15 @@
  *   Return the index to the CPU with the lowest priority running task,
  *   possibly its IDLE task.
  *
+ *   If several CPUs qualify, the calling CPU is preferred.  Starting a task
+ *   on another CPU requires pausing that CPU with up_cpu_pause() while its
+ *   assigned task list is modified; starting it on this CPU does not.  This
+ *   matters most for wake-ups from interrupt handlers that run on an idle
+ *   CPU.
+ *
+ *   Isolated CPUs are only selected for threads that may not run on any
+ *   other CPU.
+ *
  * Input Parameters:
  *   affinity - The set of CPUs on which the thread is permitted to run.
  *
@@ -63,21 +72,51 @@
 
 int nxsched_select_cpu(cpu_set_t affinity)
 {
+  FAR struct tcb_s *rtcb;
   uint8_t minprio;
   int cpu;
+  int me;
   int i;
 
-  minprio = SCHED_PRIORITY_MAX;
-  cpu     = IMPOSSIBLE_CPU;
+#ifdef CONFIG_SCHED_CPU_ISOLATION
+  /* Keep off the isolated CPUs if possible */
+
+  if ((affinity & ~CPU_ISOLATED_SET) != 0)
+    {
+      affinity &= ~CPU_ISOLATED_SET;
+    }
+#endif
+
+  /* Check this CPU first */
+
+  me = this_cpu();
+  if ((affinity & (1 << me)) != 0)
+    {
+      rtcb    = (FAR struct tcb_s *)g_assignedtasks[me].head;
+      minprio = rtcb->sched_priority;
+      cpu     = me;
+
+      /* If this CPU is executing its IDLE task, then use it */
+
+      if (rtcb->flink == NULL)
+        {
+          DEBUGASSERT(rtcb->sched_priority == 0);
+          return me;
+        }
+    }
+  else
+    {
+      minprio = SCHED_PRIORITY_MAX;
+      cpu     = IMPOSSIBLE_CPU;
+    }
 
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
       /* Is the thread permitted to run on this CPU? */
 
-      if ((affinity & (1 << i)) != 0)
+      if (i != me && (affinity & (1 << i)) != 0)
         {
-          FAR struct tcb_s *rtcb = (FAR struct tcb_s *)
-                                   g_assignedtasks[i].head;
+          rtcb = (FAR struct tcb_s *)g_assignedtasks[i].head;
 
           /* If this CPU is executing its IDLE task, then use it.  The
            * IDLE task is always the last task in the assigned task list.
@@ -92,7 +131,11 @@ int nxsched_select_cpu(cpu_set_t affinity)
               DEBUGASSERT(rtcb->sched_priority == 0);
               return i;
             }
-          else if (rtcb->sched_priority < minprio)
+
+          /* Only a strictly lower priority beats the calling CPU */
+
+          else if (rtcb->sched_priority < minprio ||
+                   cpu == IMPOSSIBLE_CPU)
             {
               DEBUGASSERT(rtcb->sched_priority > 0);
               minprio = rtcb->sched_priority;
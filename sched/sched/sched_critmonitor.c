@@ -105,6 +105,13 @@
 static uint32_t g_premp_start[CONFIG_SMP_NCPUS];
 static uint32_t g_crit_start[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/* Code location that started the global interval */
+
+static FAR void *g_premp_ip[CONFIG_SMP_NCPUS];
+static FAR void *g_crit_ip[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -114,23 +121,81 @@ static uint32_t g_crit_start[CONFIG_SMP_NCPUS];
 uint32_t g_premp_max[CONFIG_SMP_NCPUS];
 uint32_t g_crit_max[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+/* Histograms of the time with pre-emption disabled, within critical
+ * section, in interrupt handlers and from ready-to-run to running.
+ */
+
+struct critmon_hist_s g_premp_hist[CONFIG_SMP_NCPUS];
+struct critmon_hist_s g_crit_hist[CONFIG_SMP_NCPUS];
+struct critmon_hist_s g_irq_hist[CONFIG_SMP_NCPUS];
+struct critmon_hist_s g_wakeup_hist[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: nxsched_critmon_hist
+ *
+ * Description:
+ *   Add one duration to a latency histogram.
+ *
+ * Input Parameters:
+ *   hist    - The histogram to update
+ *   elapsed - The duration in up_perf_gettime() counts
+ *   ip      - The code location responsible for the duration
+ *
+ * Assumptions:
+ *   - Called within a critical section or from an interrupt handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+void nxsched_critmon_hist(FAR struct critmon_hist_s *hist,
+                          uint32_t elapsed, FAR void *ip)
+{
+  uint32_t value = elapsed >> CONFIG_SCHED_CRITMONITOR_HISTOGRAM_SHIFT;
+  int bucket = 0;
+
+  /* Bucket n holds the durations below 2^(SHIFT + n) */
+
+  while (value != 0 &&
+         bucket < CONFIG_SCHED_CRITMONITOR_HISTOGRAM_NBUCKETS - 1)
+    {
+      value >>= 1;
+      bucket++;
+    }
+
+  hist->count[bucket]++;
+  if (elapsed > hist->max)
+    {
+      hist->max   = elapsed;
+      hist->maxip = ip;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: nxsched_critmon_preemption
  *
  * Description:
  *   Called when there is any change in pre-emptible state of a thread.
  *
+ * Input Parameters:
+ *   tcb    - The thread changing its pre-emptible state
+ *   state  - True if pre-emption is being disabled
+ *   caller - The code location of the sched_lock()/sched_unlock() call
+ *
  * Assumptions:
  *   - Called within a critical section.
  *   - Never called from an interrupt handler
  *
  ****************************************************************************/
 
-void nxsched_critmon_preemption(FAR struct tcb_s *tcb, bool state)
+void nxsched_critmon_preemption(FAR struct tcb_s *tcb, bool state,
+                                FAR void *caller)
 {
   int cpu = this_cpu();
 
@@ -151,7 +216,14 @@ void nxsched_critmon_preemption(FAR struct tcb_s *tcb, bool state)
           /* Save the global start time */
 
           g_premp_start[cpu] = tcb->premp_start;
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+          g_premp_ip[cpu]    = caller;
+#endif
         }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      tcb->premp_ip = caller;
+#endif
     }
   else if (tcb->premp_start != 0)
     {
@@ -169,6 +241,10 @@ void nxsched_critmon_preemption(FAR struct tcb_s *tcb, bool state)
           CHECK_PREEMPTION(tcb->pid, elapsed);
         }
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      nxsched_critmon_hist(&tcb->premp_hist, elapsed, tcb->premp_ip);
+#endif
+
       /* Check for the global max elapsed time */
 
       if (g_premp_start[cpu] != 0)
@@ -176,6 +252,11 @@ void nxsched_critmon_preemption(FAR struct tcb_s *tcb, bool state)
           elapsed            = now - g_premp_start[cpu];
           g_premp_start[cpu] = 0;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+          nxsched_critmon_hist(&g_premp_hist[cpu], elapsed,
+                               g_premp_ip[cpu]);
+#endif
+
           if (elapsed > g_premp_max[cpu])
             {
               g_premp_max[cpu] = elapsed;
@@ -190,13 +271,19 @@ void nxsched_critmon_preemption(FAR struct tcb_s *tcb, bool state)
  * Description:
  *   Called when a thread enters or leaves a critical section.
  *
+ * Input Parameters:
+ *   tcb    - The thread entering or leaving the critical section
+ *   state  - True if the critical section is being entered
+ *   caller - The code location of the enter/leave_critical_section() call
+ *
  * Assumptions:
  *   - Called within a critical section.
  *   - Never called from an interrupt handler
  *
  ****************************************************************************/
 
-void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state)
+void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state,
+                              FAR void *caller)
 {
   int cpu = this_cpu();
 
@@ -216,7 +303,14 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state)
           /* Set the global start time */
 
           g_crit_start[cpu] = tcb->crit_start;
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+          g_crit_ip[cpu]    = caller;
+#endif
         }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      tcb->crit_ip = caller;
+#endif
     }
   else if (tcb->crit_start != 0)
     {
@@ -234,6 +328,10 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state)
           CHECK_CSECTION(tcb->pid, elapsed);
         }
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      nxsched_critmon_hist(&tcb->crit_hist, elapsed, tcb->crit_ip);
+#endif
+
       /* Check for the global max elapsed time */
 
       if (g_crit_start[cpu] != 0)
@@ -241,6 +339,10 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state)
           elapsed           = now - g_crit_start[cpu];
           g_crit_start[cpu] = 0;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+          nxsched_critmon_hist(&g_crit_hist[cpu], elapsed, g_crit_ip[cpu]);
+#endif
+
           if (elapsed > g_crit_max[cpu])
             {
               g_crit_max[cpu] = elapsed;
@@ -273,6 +375,23 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb)
 
   tcb->run_start = current;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+  /* Record the latency from ready-to-run to running */
+
+  if (tcb->ready_start != 0)
+    {
+      elapsed          = current - tcb->ready_start;
+      tcb->ready_start = 0;
+
+      /* The location is the entry point of the thread that waited */
+
+      nxsched_critmon_hist(&tcb->wakeup_hist, elapsed,
+                           (FAR void *)tcb->entry.main);
+      nxsched_critmon_hist(&g_wakeup_hist[cpu], elapsed,
+                           (FAR void *)tcb->entry.main);
+    }
+#endif
+
   /* Did this task disable pre-emption? */
 
   if (tcb->lockcount > 0)
@@ -286,6 +405,9 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb)
       if (g_premp_start[cpu] == 0)
         {
           g_premp_start[cpu] = tcb->premp_start;
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+          g_premp_ip[cpu]    = tcb->premp_ip;
+#endif
         }
     }
   else if (g_premp_start[cpu] != 0)
@@ -295,6 +417,10 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb)
       elapsed            = current - g_premp_start[cpu];
       g_premp_start[cpu] = 0;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      nxsched_critmon_hist(&g_premp_hist[cpu], elapsed, g_premp_ip[cpu]);
+#endif
+
       if (elapsed > g_premp_max[cpu])
         {
           g_premp_max[cpu] = elapsed;
@@ -313,6 +439,9 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb)
       if (g_crit_start[cpu] == 0)
         {
           g_crit_start[cpu] = tcb->crit_start;
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+          g_crit_ip[cpu]    = tcb->crit_ip;
+#endif
         }
     }
   else if (g_crit_start[cpu] != 0)
@@ -322,6 +451,10 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb)
       elapsed      = current - g_crit_start[cpu];
       g_crit_start[cpu] = 0;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      nxsched_critmon_hist(&g_crit_hist[cpu], elapsed, g_crit_ip[cpu]);
+#endif
+
       if (elapsed > g_crit_max[cpu])
         {
           g_crit_max[cpu] = elapsed;
@@ -369,6 +502,10 @@ void nxsched_suspend_critmon(FAR struct tcb_s *tcb)
           tcb->premp_max = elapsed;
           CHECK_PREEMPTION(tcb->pid, elapsed);
         }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      nxsched_critmon_hist(&tcb->premp_hist, elapsed, tcb->premp_ip);
+#endif
     }
 
   /* Is this task in a critical section? */
@@ -385,6 +522,10 @@ void nxsched_suspend_critmon(FAR struct tcb_s *tcb)
           tcb->crit_max = elapsed;
           CHECK_CSECTION(tcb->pid, elapsed);
         }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_HISTOGRAM
+      nxsched_critmon_hist(&tcb->crit_hist, elapsed, tcb->crit_ip);
+#endif
     }
 }
 
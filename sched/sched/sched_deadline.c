@@ -0,0 +1,309 @@
+/****************************************************************************
+ * sched/sched/sched_deadline.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+
+#include "clock/clock.h"
+#include "signal/signal.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Bandwidths are fixed point fractions of one CPU */
+
+#define DEADLINE_UTIL_SHIFT  20
+#define DEADLINE_UTIL_ONE    (UINT32_C(1) << DEADLINE_UTIL_SHIFT)
+
+#ifdef CONFIG_SMP
+#  define DEADLINE_NCPUS     CONFIG_SMP_NCPUS
+#else
+#  define DEADLINE_NCPUS     1
+#endif
+
+/* The total bandwidth that admission control may hand out */
+
+#define DEADLINE_UTIL_MAX \
+  ((uint32_t)(((uint64_t)DEADLINE_UTIL_ONE * DEADLINE_NCPUS * \
+               CONFIG_SCHED_DEADLINE_MAXUTIL) / 100))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The bandwidth reserved by all of the deadline threads */
+
+static uint32_t g_deadline_util;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: deadline_overrun
+ *
+ * Description:
+ *   The current job of a deadline thread has used up its budget.  Follow
+ *   the constant bandwidth server rule: postpone the deadline by one
+ *   period and replenish the budget, so that the thread keeps running but
+ *   no longer delays threads with earlier deadlines.
+ *
+ ****************************************************************************/
+
+static void deadline_overrun(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = &tcb->deadline;
+#if CONFIG_SCHED_DEADLINE_SIGNAL > 0
+  siginfo_t info;
+#endif
+
+  dl->overruns++;
+  dl->abstime   += dl->period;
+  tcb->timeslice = dl->runtime;
+
+#if CONFIG_SCHED_DEADLINE_SIGNAL > 0
+  /* Notify the thread of the overrun */
+
+  info.si_signo           = CONFIG_SCHED_DEADLINE_SIGNAL;
+  info.si_code            = SI_QUEUE;
+  info.si_errno           = OK;
+  info.si_value.sival_int = (int)dl->overruns;
+#ifdef CONFIG_SCHED_HAVE_PARENT
+  info.si_pid             = tcb->pid;
+  info.si_status          = OK;
+#endif
+
+  nxsig_tcbdispatch(tcb, &info);
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_start_deadline
+ *
+ * Description:
+ *   Apply the SCHED_DEADLINE parameters to a thread after admission
+ *   control.  The caller sets the policy in the TCB flags.
+ *
+ * Input Parameters:
+ *   tcb   - The TCB of the thread.
+ *   param - The runtime, deadline and period of the thread.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the parameters are not such that
+ *   runtime <= deadline <= period; -EBUSY if the bandwidth would exceed
+ *   CONFIG_SCHED_DEADLINE_MAXUTIL.
+ *
+ ****************************************************************************/
+
+int nxsched_start_deadline(FAR struct tcb_s *tcb,
+                           FAR const struct sched_param *param)
+{
+  FAR struct deadline_s *dl = &tcb->deadline;
+  irqstate_t flags;
+  sclock_t runtime;
+  sclock_t deadline;
+  sclock_t period;
+  uint32_t util;
+  uint32_t total;
+
+  /* Convert timespec values to system clock ticks */
+
+  clock_time2ticks(&param->sched_dl_runtime, &runtime);
+  clock_time2ticks(&param->sched_dl_deadline, &deadline);
+  clock_time2ticks(&param->sched_dl_period, &period);
+
+  /* A zero period means a period equal to the deadline */
+
+  if (period == 0)
+    {
+      period = deadline;
+    }
+
+  if (runtime < 1 || runtime > deadline || deadline > period ||
+      period > INT32_MAX)
+    {
+      return -EINVAL;
+    }
+
+  util = (uint32_t)(((uint64_t)runtime << DEADLINE_UTIL_SHIFT) / period);
+
+  /* Admission control: the deadlines can only be met if the reserved
+   * bandwidth does not exceed the capacity of the CPUs.
+   */
+
+  flags = enter_critical_section();
+
+  total = g_deadline_util - dl->util + util;
+  if (total > DEADLINE_UTIL_MAX)
+    {
+      leave_critical_section(flags);
+      return -EBUSY;
+    }
+
+  g_deadline_util = total;
+
+  dl->runtime     = runtime;
+  dl->reldeadline = deadline;
+  dl->period      = period;
+  dl->util        = util;
+  dl->overruns    = 0;
+
+  /* The first job starts now */
+
+  dl->abstime     = clock_systime_ticks() + deadline;
+  tcb->timeslice  = runtime;
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_stop_deadline
+ *
+ * Description:
+ *   Release the bandwidth of a thread that leaves the SCHED_DEADLINE
+ *   policy or exits.
+ *
+ ****************************************************************************/
+
+void nxsched_stop_deadline(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  g_deadline_util   -= tcb->deadline.util;
+  tcb->deadline.util = 0;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: nxsched_wakeup_deadline
+ *
+ * Description:
+ *   Called when a deadline thread is unblocked, before it is added to the
+ *   ready-to-run list.  The current deadline is kept if the remaining
+ *   budget can be consumed before it without exceeding the reserved
+ *   bandwidth.  Otherwise a new job starts now, with a full budget.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_wakeup_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = &tcb->deadline;
+  clock_t now = clock_systime_ticks();
+  sclock_t left = (sclock_t)(dl->abstime - now);
+
+  if (left <= 0 || tcb->timeslice <= 0 ||
+      (uint64_t)tcb->timeslice * dl->period >
+      (uint64_t)left * dl->runtime)
+    {
+      dl->abstime    = now + dl->reldeadline;
+      tcb->timeslice = dl->runtime;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_process_deadline
+ *
+ * Description:
+ *   Charge the elapsed time to the budget of the running deadline thread
+ *   and handle a budget overrun.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the currently executing task
+ *   ticks - The number of ticks that have elapsed on the interval timer.
+ *   noswitches - True: Can't do context switches now.
+ *
+ * Returned Value:
+ *   The number of ticks remaining in the budget.  The value one is
+ *   returned when the budget is exhausted but the overrun cannot be
+ *   handled now, so that the timer expires again as soon as possible.
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *   - The task associated with TCB uses the deadline scheduling policy
+ *
+ ****************************************************************************/
+
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches)
+{
+  DEBUGASSERT(tcb != NULL);
+
+  if (tcb->timeslice > (int32_t)ticks)
+    {
+      tcb->timeslice -= ticks;
+      return tcb->timeslice;
+    }
+
+  tcb->timeslice = 0;
+
+  /* The budget is exhausted.  Context switches may not be possible now:
+   * try again as soon as possible.
+   */
+
+  if (noswitches || nxsched_islocked_tcb(tcb))
+    {
+      return 1;
+    }
+
+  deadline_overrun(tcb);
+
+  /* We are at the head of the ready to run list.  If the new deadline is
+   * later than that of the next deadline thread, let that one run.
+   */
+
+  if (tcb->flink && nxsched_deadline_before(tcb->flink, tcb))
+    {
+      /* Resetting the priority to its current value re-inserts the task
+       * in the ready-to-run list according to its new deadline.
+       */
+
+      up_reprioritize_rtr(tcb, tcb->sched_priority);
+    }
+
+  return tcb->timeslice;
+}
+
+#endif /* CONFIG_SCHED_DEADLINE */
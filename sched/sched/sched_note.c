@@ -33,6 +33,7 @@
 #include <time.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/arch.h>
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
 #include <nuttx/spinlock.h>
@@ -150,10 +151,17 @@ static void note_common(FAR struct tcb_s *tcb,
                         FAR struct note_common_s *note,
                         uint8_t length, uint8_t type)
 {
-#ifdef CONFIG_SCHED_INSTRUMENTATION_HIRES
+#if defined(CONFIG_SCHED_INSTRUMENTATION_HIRES)
   struct timespec ts;
 
-  clock_systime_timespec(&ts);
+#ifdef CONFIG_CLOCKSOURCE
+  if (clocksource_gettime(&ts) < 0)
+#endif
+    {
+      clock_systime_timespec(&ts);
+    }
+#elif defined(CONFIG_SCHED_INSTRUMENTATION_PERFCOUNT)
+  clock_t systime = up_perf_gettime();
 #else
   clock_t systime = clock_systime_ticks();
 #endif
@@ -1182,6 +1190,11 @@ void sched_note_end(uintptr_t ip, FAR const char *buf)
 {
   sched_note_printf(ip, "E|%d|%s", getpid(), buf);
 }
+
+void sched_note_counter(uintptr_t ip, FAR const char *name, long value)
+{
+  sched_note_printf(ip, "C|%d|%s|%ld", getpid(), name, value);
+}
 #endif /* CONFIG_SCHED_INSTRUMENTATION_DUMP */
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
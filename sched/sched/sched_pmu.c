@@ -0,0 +1,354 @@
+/****************************************************************************
+ * sched/sched/sched_pmu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/pmu.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PMU
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of the event counters of one CPU */
+
+struct pmu_cpu_s
+{
+  uint32_t gen;                          /* Configuration applied      */
+  uint32_t start[PMU_NCOUNTERS];         /* Values at the last switch  */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The configuration shared by all CPUs.  g_pmu_gen is incremented on each
+ * change so that the other CPUs know that they must reprogram their
+ * counters.  A mask of zero marks a counter that is not used.
+ */
+
+static uint32_t g_pmu_event[PMU_NCOUNTERS];
+static uint32_t g_pmu_mask[PMU_NCOUNTERS];
+static uint32_t g_pmu_gen;
+
+static struct pmu_cpu_s g_pmu_cpu[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_pmu_apply
+ *
+ * Description:
+ *   Program the counters of this CPU with the current configuration.
+ *
+ ****************************************************************************/
+
+static void nxsched_pmu_apply(FAR struct pmu_cpu_s *pcpu)
+{
+  int i;
+
+  for (i = 0; i < PMU_NCOUNTERS; i++)
+    {
+      if (g_pmu_mask[i] != 0)
+        {
+          up_pmu_config(i, g_pmu_event[i]);
+        }
+    }
+
+  pcpu->gen = g_pmu_gen;
+}
+
+/****************************************************************************
+ * Name: nxsched_pmu_elapsed
+ *
+ * Description:
+ *   Return the events counted by counter i of this CPU since the last
+ *   switch and restart the measurement.
+ *
+ ****************************************************************************/
+
+static uint32_t nxsched_pmu_elapsed(FAR struct pmu_cpu_s *pcpu, int i)
+{
+  uint32_t now = up_pmu_read(i);
+  uint32_t elapsed = (now - pcpu->start[i]) & g_pmu_mask[i];
+
+  pcpu->start[i] = now;
+  return elapsed;
+}
+
+/****************************************************************************
+ * Name: nxsched_pmu_clear
+ *
+ * Description:
+ *   nxsched_foreach() callback that resets the counts of one thread.  arg
+ *   is the counter to reset or NULL for all of them.
+ *
+ ****************************************************************************/
+
+static void nxsched_pmu_clear(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  if (arg != NULL)
+    {
+      tcb->pmu_count[*(FAR int *)arg] = 0;
+    }
+  else
+    {
+      memset(tcb->pmu_count, 0, sizeof(tcb->pmu_count));
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_resume_pmu
+ *
+ * Description:
+ *   Called when a thread is resumed: reprogram the counters of this CPU if
+ *   the configuration changed and start measuring the events of the
+ *   thread.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_resume_pmu(FAR struct tcb_s *tcb)
+{
+  FAR struct pmu_cpu_s *pcpu = &g_pmu_cpu[this_cpu()];
+  int i;
+
+  if (pcpu->gen != g_pmu_gen)
+    {
+      nxsched_pmu_apply(pcpu);
+    }
+
+  for (i = 0; i < PMU_NCOUNTERS; i++)
+    {
+      if (g_pmu_mask[i] != 0)
+        {
+          pcpu->start[i] = up_pmu_read(i);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_suspend_pmu
+ *
+ * Description:
+ *   Called when a thread is suspended: add the events counted since it was
+ *   resumed to its counts.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_suspend_pmu(FAR struct tcb_s *tcb)
+{
+  FAR struct pmu_cpu_s *pcpu = &g_pmu_cpu[this_cpu()];
+  int i;
+
+  /* The counts were reset if the configuration changed meanwhile */
+
+  if (pcpu->gen != g_pmu_gen)
+    {
+      return;
+    }
+
+  for (i = 0; i < PMU_NCOUNTERS; i++)
+    {
+      if (g_pmu_mask[i] != 0)
+        {
+          tcb->pmu_count[i] += nxsched_pmu_elapsed(pcpu, i);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_pmu_config
+ *
+ * Description:
+ *   Select the event counted by one counter on all CPUs and reset the
+ *   counts of all threads for that counter.  The other CPUs reprogram
+ *   their counter at their next context switch.
+ *
+ * Input Parameters:
+ *   counter - The counter to configure
+ *   event   - One of the PMU_EVENT_* definitions
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_pmu_config(int counter, uint32_t event)
+{
+  FAR struct pmu_cpu_s *pcpu;
+  irqstate_t flags;
+  bool current;
+  int ret;
+
+  if (counter < 0 || counter >= PMU_NCOUNTERS ||
+      counter >= up_pmu_ncounters())
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  pcpu  = &g_pmu_cpu[this_cpu()];
+
+  /* Program this CPU first: this also validates the event */
+
+  ret = up_pmu_config(counter, event);
+  if (ret >= 0)
+    {
+      current = pcpu->gen == g_pmu_gen;
+
+      g_pmu_event[counter] = event;
+      if (event == PMU_EVENT_NONE)
+        {
+          g_pmu_mask[counter] = 0;
+        }
+      else if (ret >= 32)
+        {
+          g_pmu_mask[counter] = UINT32_MAX;
+        }
+      else
+        {
+          g_pmu_mask[counter] = (UINT32_C(1) << ret) - 1;
+        }
+
+      g_pmu_gen++;
+
+      /* The other counters of this CPU still count for the running
+       * thread if they were up to date.
+       */
+
+      if (current)
+        {
+          pcpu->gen = g_pmu_gen;
+          pcpu->start[counter] = up_pmu_read(counter);
+        }
+
+      nxsched_foreach(nxsched_pmu_clear, &counter);
+      ret = OK;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxsched_pmu_read
+ *
+ * Description:
+ *   Return the events counted while a thread was running.  The counts of
+ *   the running thread include the events up to now; in SMP the counts of
+ *   a thread running on another CPU are updated at its context switches.
+ *
+ * Input Parameters:
+ *   tcb   - The thread to read
+ *   count - Receives the events and the counts; pid is not modified.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsched_pmu_read(FAR struct tcb_s *tcb,
+                      FAR struct pmu_count_s *count)
+{
+  FAR struct pmu_cpu_s *pcpu;
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+
+  /* Account the events of the running thread up to now */
+
+  pcpu = &g_pmu_cpu[this_cpu()];
+  if (tcb == this_task() && pcpu->gen == g_pmu_gen)
+    {
+      for (i = 0; i < PMU_NCOUNTERS; i++)
+        {
+          if (g_pmu_mask[i] != 0)
+            {
+              tcb->pmu_count[i] += nxsched_pmu_elapsed(pcpu, i);
+            }
+        }
+    }
+
+  memcpy(count->event, g_pmu_event, sizeof(count->event));
+  memcpy(count->count, tcb->pmu_count, sizeof(count->count));
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: nxsched_pmu_reset
+ *
+ * Description:
+ *   Reset the event counts of all threads.
+ *
+ ****************************************************************************/
+
+void nxsched_pmu_reset(void)
+{
+  FAR struct pmu_cpu_s *pcpu;
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+
+  /* Restart the measurement of the running thread too */
+
+  pcpu = &g_pmu_cpu[this_cpu()];
+  for (i = 0; i < PMU_NCOUNTERS; i++)
+    {
+      if (g_pmu_mask[i] != 0)
+        {
+          pcpu->start[i] = up_pmu_read(i);
+        }
+    }
+
+  nxsched_foreach(nxsched_pmu_clear, NULL);
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_SCHED_PMU */
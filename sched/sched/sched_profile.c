@@ -0,0 +1,211 @@
+/****************************************************************************
+ * sched/sched/sched_profile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if CONFIG_SCHED_PROFILE_DEPTH > 1 && !defined(CONFIG_SCHED_BACKTRACE)
+#  error CONFIG_SCHED_PROFILE_DEPTH > 1 requires CONFIG_SCHED_BACKTRACE
+#endif
+
+/* The backtrace taken in interrupt context starts with the frames of the
+ * interrupt handling logic.  Allow for that many of them before the
+ * interrupted PC.
+ */
+
+#define PROFILE_IRQFRAMES 8
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The ring buffer of samples of one CPU */
+
+struct profile_buffer_s
+{
+  uint16_t head;                    /* Index of the oldest sample */
+  uint16_t count;                   /* Number of samples */
+  struct profile_sample_s sample[CONFIG_SCHED_PROFILE_NSAMPLES];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct profile_buffer_s g_profile[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_profile_callers
+ *
+ * Description:
+ *   Add the return addresses of the callers of the interrupted PC to the
+ *   sample.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_PROFILE_DEPTH > 1
+static void nxsched_profile_callers(FAR struct profile_sample_s *sample)
+{
+  FAR void *frames[PROFILE_IRQFRAMES + CONFIG_SCHED_PROFILE_DEPTH];
+  int nframes;
+  int i;
+
+  nframes = up_backtrace(NULL, frames, PROFILE_IRQFRAMES +
+                         CONFIG_SCHED_PROFILE_DEPTH, 0);
+
+  /* Skip the frames of the interrupt handling logic:  The backtrace of
+   * the interrupted code starts with the interrupted PC.
+   */
+
+  for (i = 0; i < nframes; i++)
+    {
+      if (frames[i] == sample->pc[0])
+        {
+          break;
+        }
+    }
+
+  for (i++; i < nframes && sample->depth < CONFIG_SCHED_PROFILE_DEPTH;
+       i++)
+    {
+      sample->pc[sample->depth++] = frames[i];
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_profile_sample
+ *
+ * Description:
+ *   Record the PC interrupted on this CPU, and the return addresses of its
+ *   callers if CONFIG_SCHED_PROFILE_DEPTH > 1, in the sample buffer of
+ *   this CPU.
+ *
+ * Assumptions:
+ *   Called from interrupt handling logic.
+ *
+ ****************************************************************************/
+
+void nxsched_profile_sample(void)
+{
+  FAR struct profile_buffer_s *buffer;
+  FAR struct profile_sample_s *sample;
+  irqstate_t flags;
+  int cpu;
+
+  if (!up_interrupt_context())
+    {
+      /* Not called from an interrupt, there is no interrupted PC */
+
+      return;
+    }
+
+  flags  = enter_critical_section();
+  cpu    = this_cpu();
+  buffer = &g_profile[cpu];
+
+  /* Overwrite the oldest sample if the buffer is full */
+
+  if (buffer->count < CONFIG_SCHED_PROFILE_NSAMPLES)
+    {
+      sample = &buffer->sample[(buffer->head + buffer->count++) %
+                               CONFIG_SCHED_PROFILE_NSAMPLES];
+    }
+  else
+    {
+      sample       = &buffer->sample[buffer->head];
+      buffer->head = (buffer->head + 1) % CONFIG_SCHED_PROFILE_NSAMPLES;
+    }
+
+  sample->pid   = this_task()->pid;
+  sample->cpu   = cpu;
+  sample->pc[0] = (FAR void *)up_getusrpc(NULL);
+  sample->depth = 1;
+
+#if CONFIG_SCHED_PROFILE_DEPTH > 1
+  nxsched_profile_callers(sample);
+#endif
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: nxsched_profile_drain
+ *
+ * Description:
+ *   Remove up to 'nsamples' of the oldest samples recorded on CPU 'cpu'
+ *   and copy them to 'samples'.
+ *
+ * Returned Value:
+ *   The number of samples copied.
+ *
+ ****************************************************************************/
+
+int nxsched_profile_drain(int cpu, FAR struct profile_sample_s *samples,
+                          int nsamples)
+{
+  FAR struct profile_buffer_s *buffer;
+  irqstate_t flags;
+  int n;
+
+  DEBUGASSERT(cpu >= 0 && cpu < CONFIG_SMP_NCPUS);
+  buffer = &g_profile[cpu];
+
+  flags = enter_critical_section();
+  for (n = 0; n < nsamples && buffer->count > 0; n++)
+    {
+      memcpy(&samples[n], &buffer->sample[buffer->head],
+             sizeof(struct profile_sample_s));
+
+      buffer->head = (buffer->head + 1) % CONFIG_SCHED_PROFILE_NSAMPLES;
+      buffer->count--;
+    }
+
+  leave_critical_section(flags);
+  return n;
+}
+
+#endif /* CONFIG_SCHED_PROFILE */
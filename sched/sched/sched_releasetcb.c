@@ -34,6 +34,7 @@
 #include "sched/sched.h"
 #include "group/group.h"
 #include "timer/timer.h"
+#include "pthread/pthread.h"
 
 /****************************************************************************
  * Private Functions
@@ -131,7 +132,14 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
 
       if (tcb->stack_alloc_ptr)
         {
-          up_release_stack(tcb, ttype);
+#if !defined(CONFIG_DISABLE_PTHREAD) && CONFIG_PTHREAD_CACHE > 0
+          /* The stack of a pthread may be cached together with its TCB */
+
+          if (ttype != TCB_FLAG_TTYPE_PTHREAD)
+#endif
+            {
+              up_release_stack(tcb, ttype);
+            }
         }
 
 #ifdef CONFIG_PIC
@@ -150,6 +158,17 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
         }
 #endif
 
+#ifdef CONFIG_FS_SELECT_SCRATCH
+      /* Release the pollfd array cached by select() */
+
+      if (tcb->pollscratch != NULL)
+        {
+          kmm_free(tcb->pollscratch);
+          tcb->pollscratch  = NULL;
+          tcb->npollscratch = 0;
+        }
+#endif
+
 #if defined(CONFIG_ARCH_ADDRENV) && defined(CONFIG_ARCH_KERNEL_STACK)
       /* Release the kernel stack */
 
@@ -168,6 +187,14 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
 
       /* And, finally, release the TCB itself */
 
+#if !defined(CONFIG_DISABLE_PTHREAD) && CONFIG_PTHREAD_CACHE > 0
+      if (ttype == TCB_FLAG_TTYPE_PTHREAD)
+        {
+          pthread_cache_release(tcb);
+          return ret;
+        }
+#endif
+
       kmm_free(tcb);
     }
 
@@ -72,4 +72,15 @@ void nxsched_remove_blocked(FAR struct tcb_s *btcb)
    */
 
   btcb->task_state = TSTATE_TASK_INVALID;
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* A deadline thread that wakes up may need a new deadline before it is
+   * placed in the ready-to-run list.
+   */
+
+  if ((btcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      nxsched_wakeup_deadline(btcb);
+    }
+#endif
 }
@@ -31,6 +31,7 @@
 #include <nuttx/sched_note.h>
 
 #include "irq/irq.h"
+#include "rcu/rcu.h"
 #include "sched/sched.h"
 
 #if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_RESUMESCHEDULER)
@@ -66,11 +67,20 @@ void nxsched_resume_scheduler(FAR struct tcb_s *tcb)
     }
 #endif
 
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+  /* Restart the timing of the time slice on this CPU for the new task */
+
+  nxsched_resume_cpu_timer(tcb);
+#endif
+
   /* Indicate the task has been resumed */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
   nxsched_resume_critmon(tcb);
 #endif
+#ifdef CONFIG_SCHED_PMU
+  nxsched_resume_pmu(tcb);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_resume(tcb);
 #endif
@@ -84,6 +94,12 @@ void nxsched_resume_scheduler(FAR struct tcb_s *tcb)
 
   int me = this_cpu();
 
+#ifdef CONFIG_RCU
+  /* A context switch is a quiescent state for RCU */
+
+  rcu_note_context_switch(me);
+#endif
+
   /* Adjust global IRQ controls.  If irqcount is greater than zero,
    * then this task/this CPU holds the IRQ lock
    */
@@ -72,6 +72,7 @@
  *
  *   EINVAL The scheduling policy is not one of the recognized policies.
  *   ESRCH  The task whose ID is pid could not be found.
+ *   EBUSY  SCHED_DEADLINE: admission control rejected the bandwidth.
  *
  ****************************************************************************/
 
@@ -80,6 +81,7 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 {
   FAR struct tcb_s *tcb;
   irqstate_t flags;
+  int priority = param->sched_priority;
   int ret;
 
   /* Check for supported scheduling policy */
@@ -90,6 +92,9 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
       && policy != SCHED_SPORADIC
+#endif
+#ifdef CONFIG_SCHED_DEADLINE
+      && policy != SCHED_DEADLINE
 #endif
      )
     {
@@ -120,6 +125,17 @@ int nxsched_set_scheduler(pid_t pid, int policy,
   /* Further, disable timer interrupts while we set up scheduling policy. */
 
   flags = enter_critical_section();
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Release the bandwidth of a thread that leaves deadline scheduling */
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE &&
+      policy != SCHED_DEADLINE)
+    {
+      nxsched_stop_deadline(tcb);
+    }
+#endif
+
   tcb->flags &= ~TCB_FLAG_POLICY_MASK;
   switch (policy)
     {
@@ -141,7 +157,8 @@ int nxsched_set_scheduler(pid_t pid, int policy,
           /* Save the FIFO scheduling parameters */
 
           tcb->flags       |= TCB_FLAG_SCHED_FIFO;
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
           tcb->timeslice    = 0;
 #endif
         }
@@ -258,6 +275,26 @@ int nxsched_set_scheduler(pid_t pid, int policy,
         break;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        {
+          /* Admit the thread and start its first job.  All deadline
+           * threads run at the same priority so that the order of their
+           * deadlines decides between them.
+           */
+
+          ret = nxsched_start_deadline(tcb, param);
+          if (ret < 0)
+            {
+              goto errout_with_irq;
+            }
+
+          tcb->flags |= TCB_FLAG_SCHED_DEADLINE;
+          priority    = CONFIG_SCHED_DEADLINE_PRIORITY;
+        }
+        break;
+#endif
+
 #if 0 /* Not supported */
       case SCHED_OTHER:
         tcb->flags    |= TCB_FLAG_SCHED_OTHER;
@@ -269,11 +306,11 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 
   /* Set the new priority */
 
-  ret = nxsched_reprioritize(tcb, param->sched_priority);
+  ret = nxsched_reprioritize(tcb, priority);
   sched_unlock();
   return ret;
 
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
 errout_with_irq:
   leave_critical_section(flags);
   sched_unlock();
@@ -307,6 +344,7 @@ errout_with_irq:
  *
  *   EINVAL The scheduling policy is not one of the recognized policies.
  *   ESRCH  The task whose ID is pid could not be found.
+ *   EBUSY  SCHED_DEADLINE: admission control rejected the bandwidth.
  *
  ****************************************************************************/
 
@@ -29,7 +29,7 @@
 #include <assert.h>
 #include <debug.h>
 
-#if CONFIG_RR_INTERVAL > 0
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_TICKLESS_PERCPU)
 #  include <sched.h>
 #  include <nuttx/arch.h>
 #endif
@@ -102,16 +102,24 @@ uint32_t g_oneshot_maxticks = UINT32_MAX;
  * Private Function Prototypes
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
                                       bool noswitches);
 #endif
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if (CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+     defined(CONFIG_SCHED_DEADLINE)) && !defined(CONFIG_SCHED_TICKLESS_PERCPU)
 static uint32_t nxsched_process_scheduler(uint32_t ticks, bool noswitches);
 #endif
 static unsigned int nxsched_timer_process(unsigned int ticks,
                                           bool noswitches);
+static void nxsched_ticks2timespec(unsigned int ticks,
+                                   FAR struct timespec *ts);
 static void nxsched_timer_start(unsigned int ticks);
+#ifdef CONFIG_SCHED_TICKLESS_ALARM
+static unsigned int nxsched_timer_elapsed(FAR struct timespec *stop,
+                                          FAR const struct timespec *ts);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -139,6 +147,19 @@ static unsigned int g_timer_interval;
 static struct timespec g_sched_time;
 #endif
 
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+/* With per-CPU alarms, the time slice of the task running on each CPU is
+ * timed by the local alarm of that CPU and the global alarm only serves
+ * the watchdogs.  g_cpu_stop_time[] is the time from which the task
+ * currently running on the CPU has not been accounted for and
+ * g_cpu_alarm_active[] tells whether the local alarm is armed.  Both are
+ * only touched by the owning CPU.
+ */
+
+static struct timespec g_cpu_stop_time[CONFIG_SMP_NCPUS];
+static bool g_cpu_alarm_active[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -168,7 +189,8 @@ static struct timespec g_sched_time;
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
                                       bool noswitches)
 {
@@ -176,6 +198,13 @@ static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
   FAR struct tcb_s *ntcb = current_task(cpu);
   uint32_t ret = 0;
 
+  /* Leave alone an isolated CPU that has nothing to switch to */
+
+  if (nxsched_cpu_nohz(cpu))
+    {
+      return 0;
+    }
+
 #if CONFIG_RR_INTERVAL > 0
   /* Check if the currently executing task uses round robin scheduling. */
 
@@ -216,6 +245,19 @@ static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
     }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Check if the currently executing task uses deadline scheduling. */
+
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Yes, charge the elapsed time to the budget of its current job and
+       * get the time until the budget is exhausted.
+       */
+
+      ret = nxsched_process_deadline(rtcb, ticks, noswitches);
+    }
+#endif
+
   /* If a context switch occurred, then need to return delay remaining for
    * the new task at the head of the ready to run list.
    */
@@ -228,12 +270,20 @@ static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
     {
       /* Recurse just to get the correct return value */
 
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+      return nxsched_cpu_scheduler(cpu, 0, true);
+#else
       return nxsched_process_scheduler(0, true);
+#endif
     }
 
-  /* Returning zero means that there is no interesting event to be timed */
+  /* Returning zero means that there is no interesting event to be timed.
+   * The keep alive hack is not needed with per-CPU alarms:  The local
+   * alarm is re-assessed on each context switch instead, so a CPU that
+   * runs no time-sliced task is not woken up at all.
+   */
 
-#ifdef KEEP_ALIVE_HACK
+#if defined(KEEP_ALIVE_HACK) && !defined(CONFIG_SCHED_TICKLESS_PERCPU)
   if (ret == 0)
     {
       /* Apply the keep alive hack */
@@ -270,7 +320,8 @@ static uint32_t nxsched_cpu_scheduler(int cpu, uint32_t ticks,
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if (CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+     defined(CONFIG_SCHED_DEADLINE)) && !defined(CONFIG_SCHED_TICKLESS_PERCPU)
 static uint32_t nxsched_process_scheduler(uint32_t ticks, bool noswitches)
 {
 #ifdef CONFIG_SMP
@@ -373,7 +424,8 @@ static inline unsigned int nxsched_process_wdtimer(uint32_t ticks,
 static unsigned int nxsched_timer_process(unsigned int ticks,
                                           bool noswitches)
 {
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
   unsigned int cmptime = UINT_MAX;
 #endif
   unsigned int rettime = 0;
@@ -403,7 +455,8 @@ static unsigned int nxsched_timer_process(unsigned int ticks,
   tmp = nxsched_process_wdtimer(ticks, noswitches);
   if (tmp > 0)
     {
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
       cmptime = tmp;
 #endif
       rettime = tmp;
@@ -415,7 +468,8 @@ static unsigned int nxsched_timer_process(unsigned int ticks,
 
   tmp = nxsched_process_scheduler(ticks, noswitches);
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
   if (tmp > 0 && tmp < cmptime)
     {
       rettime = tmp;
@@ -426,20 +480,23 @@ static unsigned int nxsched_timer_process(unsigned int ticks,
 }
 
 /****************************************************************************
- * Name:  nxsched_timer_start
+ * Name:  nxsched_ticks2timespec
  *
  * Description:
- *   Start the interval timer.
+ *   Convert a delay in ticks to a struct timespec that up_timer_start() and
+ *   up_alarm_start() can understand.
  *
  * Input Parameters:
- *   ticks - The number of ticks defining the timer interval to setup.
+ *   ticks - The number of ticks to convert.
+ *   ts    - The location to return the converted time.
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-static void nxsched_timer_start(unsigned int ticks)
+static void nxsched_ticks2timespec(unsigned int ticks,
+                                   FAR struct timespec *ts)
 {
 #ifdef CONFIG_HAVE_LONG_LONG
   uint64_t usecs;
@@ -449,6 +506,39 @@ static void nxsched_timer_start(unsigned int ticks)
   uint32_t secs;
 #endif
   uint32_t nsecs;
+
+  /* REVISIT: Calculations may not have an acceptable range if uint64_t
+   * is not supported(?)
+   */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+  usecs = TICK2USEC((uint64_t)ticks);
+#else
+  usecs = TICK2USEC(ticks);
+#endif
+  secs  = usecs / USEC_PER_SEC;
+  nsecs = (usecs - (secs * USEC_PER_SEC)) * NSEC_PER_USEC;
+
+  ts->tv_sec  = (time_t)secs;
+  ts->tv_nsec = (long)nsecs;
+}
+
+/****************************************************************************
+ * Name:  nxsched_timer_start
+ *
+ * Description:
+ *   Start the interval timer.
+ *
+ * Input Parameters:
+ *   ticks - The number of ticks defining the timer interval to setup.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void nxsched_timer_start(unsigned int ticks)
+{
   int ret;
 
   if (ticks > 0)
@@ -464,21 +554,9 @@ static void nxsched_timer_start(unsigned int ticks)
 
       /* Convert ticks to a struct timespec that up_timer_start() can
        * understand.
-       *
-       * REVISIT: Calculations may not have an acceptable range if uint64_t
-       * is not supported(?)
        */
 
-#ifdef CONFIG_HAVE_LONG_LONG
-      usecs = TICK2USEC((uint64_t)ticks);
-#else
-      usecs = TICK2USEC(ticks);
-#endif
-      secs  = usecs / USEC_PER_SEC;
-      nsecs = (usecs - (secs * USEC_PER_SEC)) * NSEC_PER_USEC;
-
-      ts.tv_sec  = (time_t)secs;
-      ts.tv_nsec = (long)nsecs;
+      nxsched_ticks2timespec(ticks, &ts);
 
 #ifdef CONFIG_SCHED_TICKLESS_ALARM
       /* Convert the delay to a time in the future (with respect
@@ -506,6 +584,148 @@ static void nxsched_timer_start(unsigned int ticks)
     }
 }
 
+/****************************************************************************
+ * Name:  nxsched_timer_elapsed
+ *
+ * Description:
+ *   Return the number of whole ticks between the time '*stop' and 'ts' and
+ *   advance '*stop' by that number of ticks.  The remainder is kept so
+ *   that it is accounted for on the next call.
+ *
+ * Input Parameters:
+ *   stop - The time of the last accounting.  Updated on return.
+ *   ts   - The current time.
+ *
+ * Returned Value:
+ *   The number of elapsed ticks.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_ALARM
+static unsigned int nxsched_timer_elapsed(FAR struct timespec *stop,
+                                          FAR const struct timespec *ts)
+{
+  struct timespec delta;
+  unsigned int elapsed;
+
+  /* Calculate elapsed */
+
+  clock_timespec_subtract(ts, stop, &delta);
+
+#ifdef CONFIG_HAVE_LONG_LONG
+  elapsed  = SEC2TICK((uint64_t)delta.tv_sec);
+#else
+  elapsed  = SEC2TICK(delta.tv_sec);
+#endif
+  elapsed += delta.tv_nsec / NSEC_PER_TICK;
+
+  /* Save the new time, corrected for the remainder of the elapsed time */
+
+  stop->tv_sec  = ts->tv_sec;
+  stop->tv_nsec = ts->tv_nsec - delta.tv_nsec % NSEC_PER_TICK;
+  if (stop->tv_nsec < 0)
+    {
+      stop->tv_nsec += NSEC_PER_SEC;
+      stop->tv_sec--;
+    }
+
+  return elapsed;
+}
+#endif
+
+/****************************************************************************
+ * Name:  nxsched_cpu_timer_process
+ *
+ * Description:
+ *   Account the time elapsed on this CPU to the task that is running on it
+ *   and return the number of ticks until its time slice or budget expires.
+ *
+ * Input Parameters:
+ *   cpu - The index of this CPU.
+ *   ts - The current time.
+ *   noswitches - True: Can't do context switches now.
+ *
+ * Returned Value:
+ *   The number of ticks until the next local alarm.  Zero if the task
+ *   running on this CPU is not time sliced.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+static unsigned int nxsched_cpu_timer_process(int cpu,
+                                              FAR const struct timespec *ts,
+                                              bool noswitches)
+{
+  unsigned int elapsed;
+
+  elapsed = nxsched_timer_elapsed(&g_cpu_stop_time[cpu], ts);
+  if (!g_cpu_alarm_active[cpu])
+    {
+      /* Nothing was being timed on this CPU */
+
+      elapsed = 0;
+    }
+
+#ifdef CONFIG_SCHED_SPORADIC
+  /* Save the last time that the scheduler ran */
+
+  g_sched_time.tv_sec  = ts->tv_sec;
+  g_sched_time.tv_nsec = ts->tv_nsec;
+#endif
+
+  return nxsched_cpu_scheduler(cpu, elapsed, noswitches);
+}
+
+/****************************************************************************
+ * Name:  nxsched_cpu_timer_start
+ *
+ * Description:
+ *   Start the local alarm of this CPU or leave it stopped if 'ticks' is
+ *   zero.
+ *
+ * Input Parameters:
+ *   cpu - The index of this CPU.
+ *   ticks - The number of ticks until the local alarm should expire.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void nxsched_cpu_timer_start(int cpu, unsigned int ticks)
+{
+  struct timespec ts;
+  int ret;
+
+  g_cpu_alarm_active[cpu] = false;
+  if (ticks > 0)
+    {
+#ifdef CONFIG_SCHED_TICKLESS_LIMIT_MAX_SLEEP
+      if (ticks > g_oneshot_maxticks)
+        {
+          ticks = g_oneshot_maxticks;
+        }
+#endif
+
+      /* Convert the delay to a time in the future (with respect to the
+       * time when the task running on this CPU was last accounted).
+       */
+
+      nxsched_ticks2timespec(ticks, &ts);
+      clock_timespec_add(&g_cpu_stop_time[cpu], &ts, &ts);
+
+      ret = up_cpu_alarm_start(&ts);
+      if (ret < 0)
+        {
+          serr("ERROR: up_cpu_alarm_start failed: %d\n", ret);
+          return;
+        }
+
+      g_cpu_alarm_active[cpu] = true;
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -535,25 +755,12 @@ void nxsched_alarm_expiration(FAR const struct timespec *ts)
 {
   unsigned int elapsed;
   unsigned int nexttime;
-  struct timespec delta;
 
   DEBUGASSERT(ts);
 
-  /* Calculate elapsed */
-
-  clock_timespec_subtract(ts, &g_stop_time, &delta);
-
-#ifdef CONFIG_HAVE_LONG_LONG
-  elapsed  = SEC2TICK((uint64_t)delta.tv_sec);
-#else
-  elapsed  = SEC2TICK(delta.tv_sec);
-#endif
-  elapsed += delta.tv_nsec / NSEC_PER_TICK;
-
-  /* Save the time that the alarm occurred */
+  /* Calculate elapsed and save the time that the alarm occurred */
 
-  g_stop_time.tv_sec  = ts->tv_sec;
-  g_stop_time.tv_nsec = ts->tv_nsec;
+  elapsed = nxsched_timer_elapsed(&g_stop_time, ts);
 
 #ifdef CONFIG_SCHED_SPORADIC
   /* Save the last time that the scheduler ran */
@@ -562,19 +769,132 @@ void nxsched_alarm_expiration(FAR const struct timespec *ts)
   g_sched_time.tv_nsec = ts->tv_nsec;
 #endif
 
-  /* Correct g_stop_time cause of the elapsed have remainder */
+  /* Process the timer ticks and set up the next interval (or not) */
+
+  nexttime = nxsched_timer_process(elapsed, false);
+  nxsched_timer_start(nexttime);
+}
+#endif
+
+/****************************************************************************
+ * Name:  nxsched_cpu_alarm_expiration
+ *
+ * Description:
+ *   If CONFIG_SCHED_TICKLESS_PERCPU is defined, then this function is
+ *   provided by the RTOS base code and called from platform-specific code
+ *   on the CPU whose local alarm expired.  Only the time slice or budget
+ *   of the task running on that CPU is processed.
+ *
+ * Input Parameters:
+ *   ts - The time that the alarm expired
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions/Limitations:
+ *   Base code implementation assumes that this function is called from
+ *   interrupt handling logic with interrupts disabled.
+ *
+ ****************************************************************************/
 
-  g_stop_time.tv_nsec -= delta.tv_nsec % NSEC_PER_TICK;
-  if (g_stop_time.tv_nsec < 0)
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+void nxsched_cpu_alarm_expiration(FAR const struct timespec *ts)
+{
+  unsigned int nexttime;
+  irqstate_t flags;
+  int cpu;
+
+  DEBUGASSERT(ts);
+
+  /* The TCBs of the scheduler are protected by the critical section */
+
+  flags = enter_critical_section();
+  cpu   = this_cpu();
+
+  nexttime = nxsched_cpu_timer_process(cpu, ts, false);
+  nxsched_cpu_timer_start(cpu, nexttime);
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name:  nxsched_resume_cpu_timer
+ *
+ * Description:
+ *   Restart the timing of the time slice on this CPU for the task that is
+ *   about to run on it.  This is called from nxsched_resume_scheduler() on
+ *   each context switch.  If the new task is not time sliced, the local
+ *   alarm is stopped so that the CPU is not woken up needlessly.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the task that is about to run on this CPU.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   This may be called while another CPU holds the critical section and
+ *   waits for this CPU, so it must not enter the critical section.  Only
+ *   the state of this CPU and the time slice of 'tcb' are accessed.
+ *
+ ****************************************************************************/
+
+void nxsched_resume_cpu_timer(FAR struct tcb_s *tcb)
+{
+  unsigned int nexttime = 0;
+  irqstate_t flags;
+  int cpu;
+
+  flags = up_irq_save();
+  cpu   = this_cpu();
+
+  if (g_cpu_alarm_active[cpu])
     {
-      g_stop_time.tv_nsec += NSEC_PER_SEC;
-      g_stop_time.tv_sec--;
+      up_cpu_alarm_cancel();
     }
 
-  /* Process the timer ticks and set up the next interval (or not) */
+  /* The time used so far belongs to the previous task, start accounting
+   * for the new task from now on.
+   */
 
-  nexttime = nxsched_timer_process(elapsed, false);
-  nxsched_timer_start(nexttime);
+  up_timer_gettime(&g_cpu_stop_time[cpu]);
+
+  /* No local alarm on an isolated CPU that runs a single thread */
+
+  if (nxsched_cpu_nohz(cpu))
+    {
+      up_irq_restore(flags);
+      return;
+    }
+
+#if CONFIG_RR_INTERVAL > 0
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_RR)
+    {
+      /* If the time slice expired while the task could not be switched
+       * out, let the local alarm expire as soon as possible.
+       */
+
+      nexttime = tcb->timeslice > 0 ? tcb->timeslice : 1;
+    }
+#endif
+
+#ifdef CONFIG_SCHED_SPORADIC
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_SPORADIC &&
+      tcb->timeslice > 0)
+    {
+      nexttime = tcb->timeslice;
+    }
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      nexttime = tcb->timeslice > 0 ? tcb->timeslice : 1;
+    }
+#endif
+
+  nxsched_cpu_timer_start(cpu, nexttime);
+  up_irq_restore(flags);
 }
 #endif
 
@@ -653,39 +973,18 @@ unsigned int nxsched_cancel_timer(void)
    * current time.
    */
 
-  ts.tv_sec  = g_stop_time.tv_sec;
-  ts.tv_nsec = g_stop_time.tv_nsec;
-
-  up_alarm_cancel(&g_stop_time);
+  up_alarm_cancel(&ts);
 
 #ifdef CONFIG_SCHED_SPORADIC
   /* Save the last time that the scheduler ran */
 
-  g_sched_time.tv_sec  = g_stop_time.tv_sec;
-  g_sched_time.tv_nsec = g_stop_time.tv_nsec;
-#endif
-
-  /* Convert this to the elapsed time */
-
-  clock_timespec_subtract(&g_stop_time, &ts, &ts);
-
-  /* Convert to ticks */
-
-#ifdef CONFIG_HAVE_LONG_LONG
-  elapsed  = SEC2TICK((uint64_t)ts.tv_sec);
-#else
-  elapsed  = SEC2TICK(ts.tv_sec);
+  g_sched_time.tv_sec  = ts.tv_sec;
+  g_sched_time.tv_nsec = ts.tv_nsec;
 #endif
-  elapsed += ts.tv_nsec / NSEC_PER_TICK;
 
-  /* Correct g_stop_time cause of the elapsed have remainder */
+  /* Convert this to the elapsed time and save the cancellation time */
 
-  g_stop_time.tv_nsec -= ts.tv_nsec % NSEC_PER_TICK;
-  if (g_stop_time.tv_nsec < 0)
-    {
-      g_stop_time.tv_nsec += NSEC_PER_SEC;
-      g_stop_time.tv_sec--;
-    }
+  elapsed = nxsched_timer_elapsed(&g_stop_time, &ts);
 
   /* Process the timer ticks and return the next interval */
 
@@ -810,11 +1109,37 @@ void nxsched_resume_timer(void)
 void nxsched_reassess_timer(void)
 {
   unsigned int nexttime;
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+  struct timespec ts;
+  irqstate_t flags;
+  int cpu;
+#endif
 
   /* Cancel and restart the timer */
 
   nexttime = nxsched_cancel_timer();
   nxsched_timer_start(nexttime);
+
+#ifdef CONFIG_SCHED_TICKLESS_PERCPU
+  /* Re-assess the time slice of the task running on this CPU, too.  It is
+   * the same task that has been accounted for since the last context
+   * switch, so the elapsed time is charged to it.
+   */
+
+  flags = enter_critical_section();
+  cpu   = this_cpu();
+
+  if (g_cpu_alarm_active[cpu])
+    {
+      up_cpu_alarm_cancel();
+    }
+
+  up_timer_gettime(&ts);
+  nexttime = nxsched_cpu_timer_process(cpu, &ts, true);
+  nxsched_cpu_timer_start(cpu, nexttime);
+
+  leave_critical_section(flags);
+#endif
 }
 
 #endif /* CONFIG_SCHED_TICKLESS */
@@ -28,6 +28,7 @@
 #include <assert.h>
 #include <debug.h>
 #include <nuttx/arch.h>
+#include <nuttx/irq.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -44,6 +45,14 @@
 #  define CONFIG_SEM_PREALLOCHOLDERS 0
 #endif
 
+/* Statistics */
+
+#ifdef CONFIG_SEM_HOLDER_STATS
+#  define HOLDERSTAT_INC(f)  (g_holderstat.f++)
+#else
+#  define HOLDERSTAT_INC(f)
+#endif
+
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -62,6 +71,32 @@ static struct semholder_s g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS];
 static FAR struct semholder_s *g_freeholders;
 #endif
 
+#ifdef CONFIG_SEM_HOLDER_STATS
+static struct semholder_stat_s g_holderstat;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_nextholder
+ *
+ * Description:
+ *   Return the holder container that follows pholder.  The inline holder
+ *   slot comes first and is followed by the list of holders that were
+ *   allocated from the pool.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+static inline FAR struct semholder_s *
+nxsem_nextholder(FAR sem_t *sem, FAR struct semholder_s *pholder)
+{
+  return pholder == &sem->holder ? sem->hhead : pholder->flink;
+}
+#endif
+
 /****************************************************************************
  * Name: nxsem_allocholder
  ****************************************************************************/
@@ -77,31 +112,49 @@ nxsem_allocholder(FAR sem_t *sem, FAR struct tcb_s *htcb)
    */
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  pholder = g_freeholders;
-  if (pholder != NULL)
+  if (sem->holder.htcb == NULL)
+    {
+      /* The inline slot is never linked into the semaphore's holder list */
+
+      pholder          = &sem->holder;
+      HOLDERSTAT_INC(ninline);
+    }
+  else if (g_freeholders != NULL)
     {
       /* Remove the holder from the free list and
        * put it into the semaphore's holder list
        */
 
+      pholder          = g_freeholders;
       g_freeholders    = pholder->flink;
       pholder->flink   = sem->hhead;
       sem->hhead       = pholder;
+
+#ifdef CONFIG_SEM_HOLDER_STATS
+      g_holderstat.npool++;
+      if (++g_holderstat.inuse > g_holderstat.maxinuse)
+        {
+          g_holderstat.maxinuse = g_holderstat.inuse;
+        }
+#endif
     }
 #else
   if (sem->holder[0].htcb == NULL)
     {
       pholder          = &sem->holder[0];
+      HOLDERSTAT_INC(ninline);
     }
   else if (sem->holder[1].htcb == NULL)
     {
       pholder          = &sem->holder[1];
+      HOLDERSTAT_INC(ninline);
     }
 #endif
   else
     {
       serr("ERROR: Insufficient pre-allocated holders\n");
       pholder          = NULL;
+      HOLDERSTAT_INC(nfail);
       DEBUGASSERT(0);
     }
 
@@ -134,13 +187,17 @@ nxsem_findholder(FAR sem_t *sem, FAR struct tcb_s *htcb)
 {
   FAR struct semholder_s *pholder;
 
+  HOLDERSTAT_INC(nlookups);
+
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  /* Try to find the holder in the list of holders associated with this
-   * semaphore
+  /* Try the inline slot first, then the list of holders associated with
+   * this semaphore.  A semaphore used as a mutex never needs the list.
    */
 
-  for (pholder = sem->hhead; pholder != NULL; pholder = pholder->flink)
+  for (pholder = &sem->holder; pholder != NULL;
+       pholder = nxsem_nextholder(sem, pholder))
     {
+      HOLDERSTAT_INC(nsteps);
       if (pholder->htcb == htcb)
         {
           /* Got it! */
@@ -156,6 +213,7 @@ nxsem_findholder(FAR sem_t *sem, FAR struct tcb_s *htcb)
   for (i = 0; i < 2; i++)
     {
       pholder = &sem->holder[i];
+      HOLDERSTAT_INC(nsteps);
       if (pholder->htcb == htcb)
         {
           /* Got it! */
@@ -216,6 +274,13 @@ static inline void nxsem_freeholder(FAR sem_t *sem,
   pholder->counts = 0;
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
+  /* Nothing more to do if this was the inline slot */
+
+  if (pholder == &sem->holder)
+    {
+      return;
+    }
+
   /* Remove the holder from the semaphore's list */
 
   for (curr = &sem->hhead;
@@ -233,6 +298,10 @@ static inline void nxsem_freeholder(FAR sem_t *sem,
 
   pholder->flink = g_freeholders;
   g_freeholders  = pholder;
+
+#ifdef CONFIG_SEM_HOLDER_STATS
+  g_holderstat.inuse--;
+#endif
 #endif
 }
 
@@ -269,17 +338,22 @@ static int nxsem_foreachholder(FAR sem_t *sem, holderhandler_t handler,
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
   FAR struct semholder_s *next;
 
-  for (pholder = sem->hhead; pholder && ret == 0; pholder = next)
+  for (pholder = &sem->holder; pholder && ret == 0; pholder = next)
     {
       /* In case this holder gets deleted */
 
-      next = pholder->flink;
+      next = nxsem_nextholder(sem, pholder);
+
+      /* Only the inline slot may hold a NULL holder */
 
-      DEBUGASSERT(pholder->htcb != NULL);
+      DEBUGASSERT(pholder->htcb != NULL || pholder == &sem->holder);
 
-      /* Call the handler */
+      if (pholder->htcb != NULL)
+        {
+          /* Call the handler */
 
-      ret = handler(pholder, sem, arg);
+          ret = handler(pholder, sem, arg);
+        }
     }
 #else
   int i;
@@ -819,7 +893,7 @@ void nxsem_destroyholder(FAR sem_t *sem)
        * the semaphore.
        */
 
-      DEBUGASSERT(sem->hhead->flink == NULL);
+      DEBUGASSERT(sem->holder.htcb == NULL && sem->hhead->flink == NULL);
     }
 
 #else
@@ -952,7 +1026,8 @@ void nxsem_release_holder(FAR sem_t *sem)
   /* Find the container for this holder */
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  for (pholder = sem->hhead; pholder; pholder = pholder->flink)
+  for (pholder = &sem->holder; pholder;
+       pholder = nxsem_nextholder(sem, pholder))
 #else
   int i;
 
@@ -963,11 +1038,14 @@ void nxsem_release_holder(FAR sem_t *sem)
     {
 #if CONFIG_SEM_PREALLOCHOLDERS == 0
       pholder = &sem->holder[i];
+#endif
+
+      /* The inline containers may hold a NULL holder */
+
       if (pholder->htcb == NULL)
         {
           continue;
         }
-#endif
 
       DEBUGASSERT(pholder->counts > 0);
 
@@ -1205,4 +1283,29 @@ void nxsem_release_all(FAR struct tcb_s *htcb)
     }
 }
 
+/****************************************************************************
+ * Name: nxsem_holderstat
+ *
+ * Description:
+ *   Return a snapshot of the priority inheritance holder statistics.
+ *
+ * Input Parameters:
+ *   stat - Location to return the statistics
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_HOLDER_STATS
+void nxsem_holderstat(FAR struct semholder_stat_s *stat)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  *stat = g_holderstat;
+  leave_critical_section(flags);
+}
+#endif
+
 #endif /* CONFIG_PRIORITY_INHERITANCE */
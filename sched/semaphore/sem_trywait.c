@@ -85,11 +85,10 @@ int nxsem_trywait(FAR sem_t *sem)
 
       /* If the semaphore is available, give it to the requesting task */
 
-      if (sem->semcount > 0)
+      if (nxsem_trydec_count(sem))
         {
           /* It is, let the task take the semaphore */
 
-          sem->semcount--;
           nxsem_add_holder(sem);
           rtcb->waitsem = NULL;
           ret = OK;
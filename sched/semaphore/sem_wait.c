@@ -90,13 +90,14 @@ int nxsem_wait(FAR sem_t *sem)
 
   if (sem != NULL)
     {
-      /* Check if the lock is available */
+      /* Check if the lock is available.  The count is decremented in
+       * either case.
+       */
 
-      if (sem->semcount > 0)
+      if (nxsem_dec_count(sem) > 0)
         {
           /* It is, let the task take the semaphore. */
 
-          sem->semcount--;
           nxsem_add_holder(sem);
           rtcb->waitsem = NULL;
           ret = OK;
@@ -114,10 +115,6 @@ int nxsem_wait(FAR sem_t *sem)
 
           DEBUGASSERT(rtcb->waitsem == NULL);
 
-          /* Handle the POSIX semaphore (but don't set the owner yet) */
-
-          sem->semcount--;
-
           /* Save the waited on semaphore in the TCB */
 
           rtcb->waitsem = sem;
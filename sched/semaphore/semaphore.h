@@ -34,6 +34,74 @@
 #include <stdbool.h>
 #include <queue.h>
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_dec_count
+ *
+ * Description:
+ *   Decrement the semaphore count and return the count before decrementing.
+ *   The caller must be in a critical section.
+ *
+ *   With CONFIG_PTHREAD_MUTEX_FASTPATH, the C library may take (1 -> 0) or
+ *   give (0 -> 1) an uncontended mutex with a compare-and-swap on the count
+ *   without entering the critical section.  In SMP mode, that may happen on
+ *   another CPU at any time, so any decrement of a positive count must be
+ *   atomic.  Increments can't race with it: the C library never changes a
+ *   negative count and only the holder of the mutex gives it back.
+ *
+ ****************************************************************************/
+
+static inline int16_t nxsem_dec_count(FAR sem_t *sem)
+{
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && defined(CONFIG_SMP)
+  return __atomic_fetch_sub(&sem->semcount, 1, __ATOMIC_ACQUIRE);
+#else
+  return sem->semcount--;
+#endif
+}
+
+/****************************************************************************
+ * Name: nxsem_trydec_count
+ *
+ * Description:
+ *   Decrement the semaphore count if it is positive.  The caller must be in
+ *   a critical section.  See nxsem_dec_count().
+ *
+ * Returned Value:
+ *   true if the count was decremented.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_trydec_count(FAR sem_t *sem)
+{
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && defined(CONFIG_SMP)
+  int16_t count = sem->semcount;
+
+  while (count > 0)
+    {
+      if (__atomic_compare_exchange_n(&sem->semcount, &count, count - 1,
+                                      false, __ATOMIC_ACQUIRE,
+                                      __ATOMIC_RELAXED))
+        {
+          return true;
+        }
+    }
+
+  return false;
+#else
+  if (sem->semcount > 0)
+    {
+      sem->semcount--;
+      return true;
+    }
+
+  return false;
+#endif
+}
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
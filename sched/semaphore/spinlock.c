@@ -36,6 +36,33 @@
 
 #ifdef CONFIG_SPINLOCK
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spin_wait_unlocked
+ *
+ * Description:
+ *   Wait until the spinlock looks unlocked, using only plain loads.  The
+ *   atomic test-and-set writes the lock's cache line on each attempt, even
+ *   if it fails, so the contending CPUs would keep stealing the line from
+ *   each other and from the owner.  Spinning on a load lets the line stay
+ *   shared until the owner releases the lock.  Where the architecture
+ *   provides WFE/SEV, the CPU sleeps until the owner signals the release.
+ *
+ ****************************************************************************/
+
+static inline void spin_wait_unlocked(FAR volatile spinlock_t *lock)
+{
+  do
+    {
+      SP_DSB();
+      SP_WFE();
+    }
+  while (*lock == SP_LOCKED);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -73,8 +100,7 @@ void spin_lock(FAR volatile spinlock_t *lock)
 
   while (up_testset(lock) == SP_LOCKED)
     {
-      SP_DSB();
-      SP_WFE();
+      spin_wait_unlocked(lock);
     }
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
@@ -111,8 +137,7 @@ void spin_lock_wo_note(FAR volatile spinlock_t *lock)
 {
   while (up_testset(lock) == SP_LOCKED)
     {
-      SP_DSB();
-      SP_WFE();
+      spin_wait_unlocked(lock);
     }
 
   SP_DMB();
@@ -384,4 +409,258 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
 }
 #endif
 
+/****************************************************************************
+ * Name: read_lock
+ *
+ * Description:
+ *   Take the reader-writer spinlock for reading.  Any number of readers
+ *   may hold the lock at the same time.  Loop while a writer holds the
+ *   lock or waits for it, so that writers are not starved by a steady
+ *   stream of readers.
+ *
+ * Input Parameters:
+ *   lock - A reference to the reader-writer spinlock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the lock is held for reading.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RW_SPINLOCK
+void read_lock(FAR volatile rwlock_t *lock)
+{
+  for (; ; )
+    {
+      spin_lock(&lock->lock);
+      if (!lock->writer)
+        {
+          lock->readers++;
+          spin_unlock(&lock->lock);
+          break;
+        }
+
+      spin_unlock(&lock->lock);
+
+      while (lock->writer)
+        {
+          SP_DSB();
+          SP_WFE();
+        }
+    }
+
+  SP_DMB();
+}
+
+/****************************************************************************
+ * Name: read_trylock
+ *
+ * Description:
+ *   Try once to take the reader-writer spinlock for reading.
+ *
+ * Input Parameters:
+ *   lock - A reference to the reader-writer spinlock.
+ *
+ * Returned Value:
+ *   true if the lock is now held for reading; false if a writer holds the
+ *   lock or waits for it.
+ *
+ ****************************************************************************/
+
+bool read_trylock(FAR volatile rwlock_t *lock)
+{
+  bool locked = false;
+
+  spin_lock(&lock->lock);
+  if (!lock->writer)
+    {
+      lock->readers++;
+      locked = true;
+    }
+
+  spin_unlock(&lock->lock);
+  return locked;
+}
+
+/****************************************************************************
+ * Name: read_unlock
+ *
+ * Description:
+ *   Release the reader-writer spinlock held for reading.
+ *
+ * Input Parameters:
+ *   lock - A reference to the reader-writer spinlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void read_unlock(FAR volatile rwlock_t *lock)
+{
+  SP_DMB();
+  spin_lock(&lock->lock);
+  DEBUGASSERT(lock->readers > 0);
+  lock->readers--;
+  spin_unlock(&lock->lock);
+}
+
+/****************************************************************************
+ * Name: write_lock
+ *
+ * Description:
+ *   Take the reader-writer spinlock for writing.  First claim the writer
+ *   slot, which keeps new readers out, then wait for the readers that
+ *   still hold the lock to leave.
+ *
+ * Input Parameters:
+ *   lock - A reference to the reader-writer spinlock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the lock is held for writing.
+ *
+ ****************************************************************************/
+
+void write_lock(FAR volatile rwlock_t *lock)
+{
+  for (; ; )
+    {
+      spin_lock(&lock->lock);
+      if (!lock->writer)
+        {
+          lock->writer = true;
+          spin_unlock(&lock->lock);
+          break;
+        }
+
+      spin_unlock(&lock->lock);
+
+      while (lock->writer)
+        {
+          SP_DSB();
+          SP_WFE();
+        }
+    }
+
+  while (lock->readers > 0)
+    {
+      SP_DSB();
+      SP_WFE();
+    }
+
+  SP_DMB();
+}
+
+/****************************************************************************
+ * Name: write_trylock
+ *
+ * Description:
+ *   Try once to take the reader-writer spinlock for writing.
+ *
+ * Input Parameters:
+ *   lock - A reference to the reader-writer spinlock.
+ *
+ * Returned Value:
+ *   true if the lock is now held for writing; false if it is held by a
+ *   reader or a writer.
+ *
+ ****************************************************************************/
+
+bool write_trylock(FAR volatile rwlock_t *lock)
+{
+  bool locked = false;
+
+  spin_lock(&lock->lock);
+  if (!lock->writer && lock->readers == 0)
+    {
+      lock->writer = true;
+      locked = true;
+    }
+
+  spin_unlock(&lock->lock);
+  return locked;
+}
+
+/****************************************************************************
+ * Name: write_unlock
+ *
+ * Description:
+ *   Release the reader-writer spinlock held for writing.
+ *
+ * Input Parameters:
+ *   lock - A reference to the reader-writer spinlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void write_unlock(FAR volatile rwlock_t *lock)
+{
+  SP_DMB();
+  spin_lock(&lock->lock);
+  DEBUGASSERT(lock->writer && lock->readers == 0);
+  lock->writer = false;
+  spin_unlock(&lock->lock);
+}
+
+/****************************************************************************
+ * Name: read_lock_irqsave, write_lock_irqsave
+ *
+ * Description:
+ *   Disable local interrupts, then take the reader-writer spinlock for
+ *   reading or writing.
+ *
+ * Input Parameters:
+ *   lock - A reference to the reader-writer spinlock.
+ *
+ * Returned Value:
+ *   The state of the interrupts prior to the call.
+ *
+ ****************************************************************************/
+
+irqstate_t read_lock_irqsave(FAR volatile rwlock_t *lock)
+{
+  irqstate_t flags = up_irq_save();
+
+  read_lock(lock);
+  return flags;
+}
+
+irqstate_t write_lock_irqsave(FAR volatile rwlock_t *lock)
+{
+  irqstate_t flags = up_irq_save();
+
+  write_lock(lock);
+  return flags;
+}
+
+/****************************************************************************
+ * Name: read_unlock_irqrestore, write_unlock_irqrestore
+ *
+ * Description:
+ *   Release the reader-writer spinlock, then restore the interrupt state
+ *   returned by read_lock_irqsave() or write_lock_irqsave().
+ *
+ * Input Parameters:
+ *   lock  - A reference to the reader-writer spinlock.
+ *   flags - The interrupt state to restore.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void read_unlock_irqrestore(FAR volatile rwlock_t *lock, irqstate_t flags)
+{
+  read_unlock(lock);
+  up_irq_restore(flags);
+}
+
+void write_unlock_irqrestore(FAR volatile rwlock_t *lock, irqstate_t flags)
+{
+  write_unlock(lock);
+  up_irq_restore(flags);
+}
+#endif /* CONFIG_RW_SPINLOCK */
+
 #endif /* CONFIG_SPINLOCK */
@@ -53,8 +53,12 @@ FAR sigq_t *nxsig_alloc_pendingsigaction(void)
 
   if (up_interrupt_context())
     {
-      /* Try to get the pending signal action structure from the free list */
+      /* Try to get the pending signal action structure from the free list.
+       * The lock is still needed since other CPUs may access the free
+       * lists at the same time.
+       */
 
+      flags = nxsig_lock_freelist();
       sigq = (FAR sigq_t *)sq_remfirst(&g_sigpendingaction);
 
       /* If so, then try the special list of structures reserved for
@@ -65,6 +69,8 @@ FAR sigq_t *nxsig_alloc_pendingsigaction(void)
         {
           sigq = (FAR sigq_t *)sq_remfirst(&g_sigpendingirqaction);
         }
+
+      nxsig_unlock_freelist(flags);
     }
 
   /* If we were not called from an interrupt handler, then we are
@@ -75,9 +81,9 @@ FAR sigq_t *nxsig_alloc_pendingsigaction(void)
     {
       /* Try to get the pending signal action structure from the free list */
 
-      flags = enter_critical_section();
+      flags = nxsig_lock_freelist();
       sigq = (FAR sigq_t *)sq_remfirst(&g_sigpendingaction);
-      leave_critical_section(flags);
+      nxsig_unlock_freelist(flags);
 
       /* Check if we got one. */
 
@@ -137,8 +137,12 @@ static FAR sigpendq_t *nxsig_alloc_pendingsignal(void)
 
   if (up_interrupt_context())
     {
-      /* Try to get the pending signal structure from the free list */
+      /* Try to get the pending signal structure from the free list.  The
+       * lock is still needed since other CPUs may access the free lists at
+       * the same time.
+       */
 
+      flags = nxsig_lock_freelist();
       sigpend = (FAR sigpendq_t *)sq_remfirst(&g_sigpendingsignal);
       if (!sigpend)
         {
@@ -149,6 +153,8 @@ static FAR sigpendq_t *nxsig_alloc_pendingsignal(void)
 
           sigpend = (FAR sigpendq_t *)sq_remfirst(&g_sigpendingirqsignal);
         }
+
+      nxsig_unlock_freelist(flags);
     }
 
   /* If we were not called from an interrupt handler, then we are
@@ -159,9 +165,9 @@ static FAR sigpendq_t *nxsig_alloc_pendingsignal(void)
     {
       /* Try to get the pending signal structure from the free list */
 
-      flags = enter_critical_section();
+      flags = nxsig_lock_freelist();
       sigpend = (FAR sigpendq_t *)sq_remfirst(&g_sigpendingsignal);
-      leave_critical_section(flags);
+      nxsig_unlock_freelist(flags);
 
       /* Check if we got one. */
 
@@ -551,3 +557,57 @@ int nxsig_dispatch(pid_t pid, FAR siginfo_t *info)
 
 #endif
 }
+
+/****************************************************************************
+ * Name: nxsig_ispending
+ *
+ * Description:
+ *   Check if a signal with the same number, code and value as 'info' is
+ *   still queued for the task 'pid', either as a pending signal of its
+ *   group or as a signal action that has not run yet.  This lets senders
+ *   such as the POSIX timers queue only one signal at a time.
+ *
+ * Input Parameters:
+ *   pid  - The task that the signal is queued for
+ *   info - The signal information to look for
+ *
+ * Returned Value:
+ *   true if such a signal is still queued.
+ *
+ ****************************************************************************/
+
+bool nxsig_ispending(pid_t pid, FAR const siginfo_t *info)
+{
+  FAR struct tcb_s *stcb;
+  FAR sigpendq_t *sigpend;
+  FAR sigq_t *sigq;
+  irqstate_t flags;
+  bool pending = false;
+
+  flags = enter_critical_section();
+
+  stcb = nxsched_get_tcb(pid);
+  if (stcb != NULL && stcb->group != NULL)
+    {
+      for (sigq = (FAR sigq_t *)stcb->sigpendactionq.head;
+           sigq != NULL && !pending; sigq = sigq->flink)
+        {
+          pending = sigq->info.si_signo == info->si_signo &&
+                    sigq->info.si_code == info->si_code &&
+                    sigq->info.si_value.sival_ptr ==
+                    info->si_value.sival_ptr;
+        }
+
+      for (sigpend = (FAR sigpendq_t *)stcb->group->tg_sigpendingq.head;
+           sigpend != NULL && !pending; sigpend = sigpend->flink)
+        {
+          pending = sigpend->info.si_signo == info->si_signo &&
+                    sigpend->info.si_code == info->si_code &&
+                    sigpend->info.si_value.sival_ptr ==
+                    info->si_value.sival_ptr;
+        }
+    }
+
+  leave_critical_section(flags);
+  return pending;
+}
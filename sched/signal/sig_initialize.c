@@ -67,6 +67,14 @@ sq_queue_t  g_sigpendingsignal;
 
 sq_queue_t  g_sigpendingirqsignal;
 
+#if defined(CONFIG_SMP) && !defined(CONFIG_SMP_GLOBAL_CSECTION)
+/* The g_sigfreelock protects the pending signal action and pending signal
+ * free lists.
+ */
+
+spinlock_t  g_sigfreelock = SP_UNLOCKED;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
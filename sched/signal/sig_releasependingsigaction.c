@@ -56,9 +56,9 @@ void nxsig_release_pendingsigaction(FAR sigq_t *sigq)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = nxsig_lock_freelist();
       sq_addlast((FAR sq_entry_t *)sigq, &g_sigpendingaction);
-      leave_critical_section(flags);
+      nxsig_unlock_freelist(flags);
     }
 
   /* If this is a message pre-allocated for interrupts,
@@ -71,9 +71,9 @@ void nxsig_release_pendingsigaction(FAR sigq_t *sigq)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = nxsig_lock_freelist();
       sq_addlast((FAR sq_entry_t *)sigq, &g_sigpendingirqaction);
-      leave_critical_section(flags);
+      nxsig_unlock_freelist(flags);
     }
 
   /* Otherwise, deallocate it.  Note:  interrupt handlers
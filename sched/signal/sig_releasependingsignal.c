@@ -64,9 +64,9 @@ void nxsig_release_pendingsignal(FAR sigpendq_t *sigpend)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = nxsig_lock_freelist();
       sq_addlast((FAR sq_entry_t *)sigpend, &g_sigpendingsignal);
-      leave_critical_section(flags);
+      nxsig_unlock_freelist(flags);
     }
 
   /* If this is a message pre-allocated for interrupts,
@@ -79,9 +79,9 @@ void nxsig_release_pendingsignal(FAR sigpendq_t *sigpend)
        * list from interrupt handlers.
        */
 
-      flags = enter_critical_section();
+      flags = nxsig_lock_freelist();
       sq_addlast((FAR sq_entry_t *)sigpend, &g_sigpendingirqsignal);
-      leave_critical_section(flags);
+      nxsig_unlock_freelist(flags);
     }
 
   /* Otherwise, deallocate it.  Note:  interrupt handlers
@@ -37,6 +37,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
+#include <nuttx/timers/hrtimer.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
 
@@ -112,6 +113,22 @@ static void nxsig_timeout(wdparm_t arg)
 #endif
 }
 
+/****************************************************************************
+ * Name: nxsig_hrtimeout
+ *
+ * Description:
+ *   A timeout elapsed while waiting for signals to be queued, signalled by
+ *   a high resolution timer instead of a watchdog.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER
+static void nxsig_hrtimeout(FAR struct hrtimer_s *timer, FAR void *arg)
+{
+  nxsig_timeout((wdparm_t)(uintptr_t)arg);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -212,6 +229,9 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
   FAR struct tcb_s *rtcb = this_task();
   sigset_t intersection;
   FAR sigpendq_t *sigpend;
+#ifdef CONFIG_HRTIMER
+  struct hrtimer_s hrtimer;
+#endif
   irqstate_t flags;
   int32_t waitticks;
   int ret;
@@ -309,10 +329,23 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
           waitticks = MSEC2TICK(waitmsec);
 #endif
 
-          /* Start the watchdog */
+#ifdef CONFIG_HRTIMER
+          /* Use a high resolution timer if one is available so that the
+           * wait is not rounded up to the system tick.
+           */
+
+          hrtimer.func = NULL;
+          if (hrtimer_start(&hrtimer,
+                            (uint64_t)timeout->tv_sec * NSEC_PER_SEC +
+                            timeout->tv_nsec, HRTIMER_MODE_REL,
+                            nxsig_hrtimeout, rtcb) < 0)
+#endif
+            {
+              /* Start the watchdog */
 
-          wd_start(&rtcb->waitdog, waitticks,
-                   nxsig_timeout, (uintptr_t)rtcb);
+              wd_start(&rtcb->waitdog, waitticks,
+                       nxsig_timeout, (uintptr_t)rtcb);
+            }
 
           /* Now wait for either the signal or the watchdog, but
            * first, make sure this is not the idle task,
@@ -324,6 +357,9 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
 
           /* We no longer need the watchdog */
 
+#ifdef CONFIG_HRTIMER
+          hrtimer_cancel(&hrtimer);
+#endif
           wd_cancel(&rtcb->waitdog);
         }
 
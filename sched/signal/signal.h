@@ -32,7 +32,9 @@
 #include <queue.h>
 #include <sched.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/spinlock.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -46,6 +48,20 @@
 #define NUM_PENDING_ACTIONS      4
 #define NUM_SIGNALS_PENDING      4
 
+/* The free lists of pending signal actions and of pending signals are
+ * protected by a spinlock of their own in SMP mode so that signal delivery
+ * does not contend for the global critical section just to allocate, unless
+ * CONFIG_SMP_GLOBAL_CSECTION selects the legacy behavior.
+ */
+
+#if defined(CONFIG_SMP) && !defined(CONFIG_SMP_GLOBAL_CSECTION)
+#  define nxsig_lock_freelist()    spin_lock_irqsave(&g_sigfreelock)
+#  define nxsig_unlock_freelist(f) spin_unlock_irqrestore(&g_sigfreelock, f)
+#else
+#  define nxsig_lock_freelist()    enter_critical_section()
+#  define nxsig_unlock_freelist(f) leave_critical_section(f)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -135,6 +151,12 @@ extern sq_queue_t  g_sigpendingsignal;
 
 extern sq_queue_t  g_sigpendingirqsignal;
 
+#if defined(CONFIG_SMP) && !defined(CONFIG_SMP_GLOBAL_CSECTION)
+/* The g_sigfreelock protects the four free lists above. */
+
+extern spinlock_t  g_sigfreelock;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -172,6 +194,7 @@ sigset_t           nxsig_pendingset(FAR struct tcb_s *stcb);
 int                nxsig_tcbdispatch(FAR struct tcb_s *stcb,
                                      FAR siginfo_t *info);
 int                nxsig_dispatch(pid_t pid, FAR siginfo_t *info);
+bool               nxsig_ispending(pid_t pid, FAR const siginfo_t *info);
 
 /* sig_cleanup.c */
 
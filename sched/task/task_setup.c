@@ -35,6 +35,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
 #include <nuttx/signal.h>
+#include <nuttx/tls.h>
 
 #include "sched/sched.h"
 #include "pthread/pthread.h"
@@ -376,6 +377,13 @@ static int nxthread_setup_scheduler(FAR struct tcb_s *tcb, int priority,
   ret = nxtask_assign_pid(tcb);
   if (ret == OK)
     {
+      /* The thread local storage is always at the beginning of the stack
+       * allocation.  Keep a copy of the thread ID there.
+       */
+
+      DEBUGASSERT(tcb->stack_alloc_ptr != NULL);
+      ((FAR struct tls_info_s *)tcb->stack_alloc_ptr)->tl_tid = tcb->pid;
+
       /* Save task priority and entry point in the TCB */
 
       tcb->sched_priority = (uint8_t)priority;
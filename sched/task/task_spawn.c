@@ -24,7 +24,6 @@
 
 #include <nuttx/config.h>
 
-#include <sys/wait.h>
 #include <sched.h>
 #include <spawn.h>
 #include <assert.h>
@@ -32,7 +31,7 @@
 #include <errno.h>
 
 #include <nuttx/sched.h>
-#include <nuttx/kthread.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/spawn.h>
 
 #include "sched/sched.h"
@@ -50,7 +49,8 @@
  * Name: nxtask_spawn_exec
  *
  * Description:
- *   Execute the task from the file system.
+ *   Create the new task, perform the file actions on its file list and
+ *   then start it.
  *
  * Input Parameters:
  *
@@ -61,6 +61,9 @@
  *
  *   entry - The child task's entry point (an address in memory)
  *
+ *   actions - The file actions to be performed on the file list of the
+ *     new task before it is started.
+ *
  *   attr - If the value of the 'attr' parameter is NULL, the all default
  *     values for the POSIX spawn attributes will be used.  Otherwise, the
  *     attributes will be set according to the spawn flags.  The
@@ -70,25 +73,29 @@
  *       value.
  *     - POSIX_SPAWN_SETSCHEDULER: Set the new tasks scheduler priority to
  *       the sched_policy value.
- *
- *     NOTE: POSIX_SPAWN_SETSIGMASK is handled in nxtask_spawn_proxy().
+ *     - POSIX_SPAWN_SETSIGMASK: Set the new task's signal mask.
  *
  *   argv - argv[] is the argument list for the new task.  argv[] is an
  *     array of pointers to null-terminated strings. The list is terminated
  *     with a null pointer.
  *
+ *   envp - envp[] is the environment of the new task.  If NULL, the new
+ *     task inherits the environment of the caller.
+ *
  * Returned Value:
- *   This function will return zero on success. Otherwise, an error number
- *   will be returned as the function return value to indicate the error.
- *   This errno value may be that set by execv(), sched_setpolicy(), or
- *   sched_setparam().
+ *   This function will return zero on success. Otherwise, a negated errno
+ *   value will be returned to indicate the error.
  *
  ****************************************************************************/
 
 static int nxtask_spawn_exec(FAR pid_t *pidp, FAR const char *name,
-                             main_t entry, FAR const posix_spawnattr_t *attr,
-                             FAR char * const *argv)
+                             main_t entry,
+                             FAR const posix_spawn_file_actions_t *actions,
+                             FAR const posix_spawnattr_t *attr,
+                             FAR char * const *argv,
+                             FAR char * const *envp)
 {
+  FAR struct task_tcb_s *tcb;
   size_t stacksize;
   int priority;
   int pid;
@@ -124,23 +131,51 @@ static int nxtask_spawn_exec(FAR pid_t *pidp, FAR const char *name,
       stacksize = CONFIG_TASK_SPAWN_DEFAULT_STACKSIZE;
     }
 
-  /* Start the task */
+  /* Allocate a TCB for the new task. */
 
-  pid = nxtask_create(name, priority, stacksize, entry, argv);
-  if (pid < 0)
+  tcb = (FAR struct task_tcb_s *)kmm_zalloc(sizeof(struct task_tcb_s));
+  if (tcb == NULL)
     {
-      ret = pid;
-      serr("ERROR: nxtask_create failed: %d\n", ret);
+      serr("ERROR: Failed to allocate TCB\n");
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  /* Initialize the task.  This also duplicates the file descriptors of
+   * this task for the new task.
+   */
+
+  ret = nxtask_init(tcb, name, priority, NULL, stacksize, entry, argv,
+                    envp);
+  if (ret < 0)
+    {
+      serr("ERROR: nxtask_init failed: %d\n", ret);
+      kmm_free(tcb);
+      goto errout;
+    }
+
+  /* Perform the file actions directly on the file list of the new task */
+
+  ret = spawn_file_actions(&tcb->cmn, actions);
+  if (ret < 0)
+    {
+      serr("ERROR: spawn_file_actions failed: %d\n", ret);
+      nxsched_release_tcb(&tcb->cmn, TCB_FLAG_TTYPE_TASK);
       goto errout;
     }
 
   /* Return the task ID to the caller */
 
-  if (pid)
+  pid = tcb->cmn.pid;
+  if (pidp)
     {
       *pidp = pid;
     }
 
+  /* Activate the task */
+
+  nxtask_activate(&tcb->cmn);
+
   /* Now set the attributes.  Note that we ignore all of the return values
    * here because we have already successfully started the task.  If we
    * return an error value, then we would also have to stop the task.
@@ -158,88 +193,6 @@ errout:
   return ret;
 }
 
-/****************************************************************************
- * Name: nxtask_spawn_proxy
- *
- * Description:
- *   Perform file_actions, then execute the task from the file system.
- *
- *   Do we really need a proxy task in this case?  Isn't that wasteful?
- *
- *   Q: Why can we do what we need to do here and the just call the
- *      new task's entry point.
- *   A: This would require setting up the name, priority, and stacksize from
- *      the task_spawn, but it do-able.  The only issue I can think of is
- *      that NuttX supports task_restart(), and you would never be able to
- *      restart a task from this point.
- *
- *   Q: Why not use a starthook so that there is callout from nxtask_start()
- *      to perform these operations?
- *   A: Good idea, except that existing nxtask_starthook() implementation
- *      cannot be used here unless we get rid of task_create and, instead,
- *      use nxtask_init() and nxtask_activate().  start_taskhook() could then
- *      be called between nxtask_init() and nxtask_activate().
- *      task_restart() would still be an issue.
- *
- * Input Parameters:
- *   Standard task start-up parameters
- *
- * Returned Value:
- *   Standard task return value.
- *
- ****************************************************************************/
-
-static int nxtask_spawn_proxy(int argc, FAR char *argv[])
-{
-  int ret;
-
-  /* Perform file actions and/or set a custom signal mask.  We get here only
-   * if the file_actions parameter to task_spawn[p] was non-NULL and/or the
-   * option to change the signal mask was selected.
-   */
-
-  DEBUGASSERT(g_spawn_parms.file_actions ||
-              (g_spawn_parms.attr &&
-               (g_spawn_parms.attr->flags & POSIX_SPAWN_SETSIGMASK) != 0));
-
-  /* Set the attributes and perform the file actions as appropriate */
-
-  ret = spawn_proxyattrs(g_spawn_parms.attr, g_spawn_parms.file_actions);
-  if (ret == OK)
-    {
-      /* Start the task */
-
-      ret = nxtask_spawn_exec(g_spawn_parms.pid, g_spawn_parms.u.task.name,
-                              g_spawn_parms.u.task.entry, g_spawn_parms.attr,
-                              g_spawn_parms.argv);
-
-#ifdef CONFIG_SCHED_HAVE_PARENT
-      if (ret == OK)
-        {
-          /* Change of the parent of the task we just spawned to our parent.
-           * What should we do in the event of a failure?
-           */
-
-          int tmp = task_reparent(0, *g_spawn_parms.pid);
-          if (tmp < 0)
-            {
-              serr("ERROR: task_reparent() failed: %d\n", tmp);
-            }
-        }
-#endif
-    }
-
-  /* Post the semaphore to inform the parent task that we have completed
-   * what we need to do.
-   */
-
-  g_spawn_parms.result = ret;
-#ifndef CONFIG_SCHED_WAITPID
-  spawn_semgive(&g_spawn_execsem);
-#endif
-  return OK;
-}
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -311,143 +264,20 @@ int task_spawn(FAR const char *name, main_t entry,
                FAR const posix_spawnattr_t *attr,
                FAR char * const argv[], FAR char * const envp[])
 {
-  struct sched_param param;
-  pid_t proxy;
   pid_t pid = INVALID_PROCESS_ID;
-#ifdef CONFIG_SCHED_WAITPID
-  int status;
-#endif
   int ret;
 
   sinfo("name=%s entry=%p file_actions=%p attr=%p argv=%p\n",
         name, entry, file_actions, attr, argv);
 
-  /* If there are no file actions to be performed and there is no change to
-   * the signal mask, then start the new child task directly from the parent
-   * task.
-   */
-
-  if ((file_actions == NULL || *file_actions == NULL) &&
-      (attr == NULL || (attr->flags & POSIX_SPAWN_SETSIGMASK) == 0))
-    {
-      ret = nxtask_spawn_exec(&pid, name, entry, attr, argv);
-      if (ret < 0)
-        {
-          return ret;
-        }
-
-      return pid;
-    }
-
-  /* Otherwise, we will have to go through an intermediary/proxy task in
-   * order to perform the I/O redirection.  This would be a natural place to
-   * fork(). However, true fork() behavior requires an MMU and most
-   * implementations of vfork() are not capable of these operations.
-   *
-   * Even without fork(), we can still do the job, but parameter passing is
-   * messier.  Unfortunately, there is no (clean) way to pass binary values
-   * as a task parameter, so we will use a semaphore-protected global
-   * structure.
-   */
-
-  /* Get exclusive access to the global parameter structure */
-
-  ret = spawn_semtake(&g_spawn_parmsem);
-  if (ret < 0)
-    {
-      serr("ERROR: spawn_semtake failed: %d\n", ret);
-      return ret;
-    }
-
-  /* Populate the parameter structure */
-
-  g_spawn_parms.result       = ENOSYS;
-  g_spawn_parms.pid          = &pid;
-  g_spawn_parms.file_actions = file_actions ? *file_actions : NULL;
-  g_spawn_parms.attr         = attr;
-  g_spawn_parms.argv         = argv;
-  g_spawn_parms.envp         = envp;
-  g_spawn_parms.u.task.name  = name;
-  g_spawn_parms.u.task.entry = entry;
-
-  /* Get the priority of this (parent) task */
-
-  ret = nxsched_get_param(0, &param);
+  ret = nxtask_spawn_exec(&pid, name, entry, file_actions, attr, argv,
+                          envp);
   if (ret < 0)
     {
-      serr("ERROR: nxsched_get_param failed: %d\n", ret);
-      g_spawn_parms.pid = NULL;
-      spawn_semgive(&g_spawn_parmsem);
       return ret;
     }
 
-#ifdef CONFIG_SCHED_WAITPID
-  /* Disable pre-emption so that the proxy does not run until waitpid
-   * is called.  This is probably unnecessary since the nxtask_spawn_proxy
-   * has the same priority as this thread; it should be schedule behind
-   * this task in the ready-to-run list.
-   *
-   * REVISIT:  This will may not have the desired effect in SMP mode.
-   */
-
-  sched_lock();
-#endif
-
-  /* Start the intermediary/proxy task at the same priority as the parent
-   * task.
-   */
-
-  proxy = nxtask_create("nxtask_spawn_proxy", param.sched_priority,
-                        CONFIG_POSIX_SPAWN_PROXY_STACKSIZE,
-                        (main_t)nxtask_spawn_proxy,
-                        (FAR char * const *)NULL);
-  if (proxy < 0)
-    {
-      ret = proxy;
-      serr("ERROR: Failed to start nxtask_spawn_proxy: %d\n", ret);
-      goto errout_with_lock;
-    }
-
-  /* Wait for the proxy to complete its job */
-
-#ifdef CONFIG_SCHED_WAITPID
-  /* REVISIT: This should not call waitpid() directly.  waitpid is a
-   * cancellation point and modifies the errno value.  It is inappropriate
-   * for use within the OS.
-   */
-
-  ret = nx_waitpid(proxy, &status, 0);
-  if (ret < 0)
-    {
-      serr("ERROR: waitpid() failed: %d\n", ret);
-      goto errout_with_lock;
-    }
-#else
-  ret = spawn_semtake(&g_spawn_execsem);
-  if (ret < 0)
-    {
-      serr("ERROR: g_spawn_execsem() failed: %d\n", ret);
-      goto errout_with_lock;
-    }
-#endif
-
-  /* Get the result and relinquish our access to the parameter structure */
-
-  ret = -g_spawn_parms.result;
-  if (ret < 0)
-    {
-      goto errout_with_lock;
-    }
-
-  ret = (int)pid;
-
-errout_with_lock:
-#ifdef CONFIG_SCHED_WAITPID
-  sched_unlock();
-#endif
-  g_spawn_parms.pid = NULL;
-  spawn_semgive(&g_spawn_parmsem);
-  return ret;
+  return pid;
 }
 
 #endif /* CONFIG_BUILD_KERNEL */
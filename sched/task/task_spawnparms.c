@@ -30,24 +30,13 @@
 #include <debug.h>
 #include <errno.h>
 
-#include <nuttx/semaphore.h>
-#include <nuttx/signal.h>
+#include <nuttx/sched.h>
 #include <nuttx/spawn.h>
 #include <nuttx/fs/fs.h>
 
 #include "task/spawn.h"
 #include "task/task.h"
 
-/****************************************************************************
- * Public Data
- ****************************************************************************/
-
-sem_t g_spawn_parmsem = SEM_INITIALIZER(1);
-#ifndef CONFIG_SCHED_WAITPID
-sem_t g_spawn_execsem = SEM_INITIALIZER(0);
-#endif
-struct spawn_parms_s g_spawn_parms;
-
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -56,29 +45,31 @@ struct spawn_parms_s g_spawn_parms;
  * Name: nxspawn_close, nxspawn_dup2, and nxspawn_open
  *
  * Description:
- *   Implement individual file actions
+ *   Implement individual file actions on the file list of the new task.
  *
  * Input Parameters:
+ *   tcb    - The TCB of the new task
  *   action - describes the action to be performed
  *
  * Returned Value:
- *   posix_spawn() and posix_spawnp() will return zero on success.
- *   Otherwise, an error number will be returned as the function return
- *   value to indicate the error.
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failure.
  *
  ****************************************************************************/
 
-static inline int nxspawn_close(FAR struct spawn_close_file_action_s *action)
+static inline int nxspawn_close(FAR struct tcb_s *tcb,
+                                FAR struct spawn_close_file_action_s *action)
 {
-  /* The return value from nx_close() is ignored */
+  /* The return value from nx_close_from_tcb() is ignored */
 
   sinfo("Closing fd=%d\n", action->fd);
 
-  nx_close(action->fd);
+  nx_close_from_tcb(tcb, action->fd);
   return OK;
 }
 
-static inline int nxspawn_dup2(FAR struct spawn_dup2_file_action_s *action)
+static inline int nxspawn_dup2(FAR struct tcb_s *tcb,
+                               FAR struct spawn_dup2_file_action_s *action)
 {
   int ret;
 
@@ -86,7 +77,7 @@ static inline int nxspawn_dup2(FAR struct spawn_dup2_file_action_s *action)
 
   sinfo("Dup'ing %d->%d\n", action->fd1, action->fd2);
 
-  ret = nx_dup2(action->fd1, action->fd2);
+  ret = nx_dup2_from_tcb(tcb, action->fd1, action->fd2);
   if (ret < 0)
     {
       serr("ERROR: dup2 failed: %d\n", ret);
@@ -96,7 +87,8 @@ static inline int nxspawn_dup2(FAR struct spawn_dup2_file_action_s *action)
   return OK;
 }
 
-static inline int nxspawn_open(FAR struct spawn_open_file_action_s *action)
+static inline int nxspawn_open(FAR struct tcb_s *tcb,
+                               FAR struct spawn_open_file_action_s *action)
 {
   int fd;
   int ret = OK;
@@ -106,7 +98,7 @@ static inline int nxspawn_open(FAR struct spawn_open_file_action_s *action)
   sinfo("Open'ing path=%s oflags=%04x mode=%04x\n",
         action->path, action->oflags, action->mode);
 
-  fd = nx_open(action->path, action->oflags, action->mode);
+  fd = nx_open_from_tcb(tcb, action->path, action->oflags, action->mode);
   if (fd < 0)
     {
       ret = fd;
@@ -123,7 +115,7 @@ static inline int nxspawn_open(FAR struct spawn_open_file_action_s *action)
 
       sinfo("Dup'ing %d->%d\n", fd, action->fd);
 
-      ret = nx_dup2(fd, action->fd);
+      ret = nx_dup2_from_tcb(tcb, fd, action->fd);
       if (ret < 0)
         {
           serr("ERROR: dup2 failed: %d\n", ret);
@@ -134,7 +126,7 @@ static inline int nxspawn_open(FAR struct spawn_open_file_action_s *action)
         }
 
       sinfo("Closing fd=%d\n", fd);
-      nx_close(fd);
+      nx_close_from_tcb(tcb, fd);
     }
 
   return ret;
@@ -144,31 +136,13 @@ static inline int nxspawn_open(FAR struct spawn_open_file_action_s *action)
  * Public Functions
  ****************************************************************************/
 
-/****************************************************************************
- * Name: spawn_semtake and spawn_semgive
- *
- * Description:
- *   Give and take semaphores
- *
- * Input Parameters:
- *
- *   sem - The semaphore to act on.
- *
- * Returned Value:
- *   See nxsem_wait_uninterruptible
- *
- ****************************************************************************/
-
-int spawn_semtake(FAR sem_t *sem)
-{
-  return nxsem_wait_uninterruptible(sem);
-}
-
 /****************************************************************************
  * Name: spawn_execattrs
  *
  * Description:
  *   Set attributes of the new child task after it has been spawned.
+ *   This includes the signal mask (POSIX_SPAWN_SETSIGMASK), which is set
+ *   directly in the TCB since the new task has not run yet.
  *
  * Input Parameters:
  *
@@ -194,6 +168,18 @@ int spawn_execattrs(pid_t pid, FAR const posix_spawnattr_t *attr)
 
   DEBUGASSERT(attr);
 
+  /* Check if we need to change the signal mask */
+
+  if ((attr->flags & POSIX_SPAWN_SETSIGMASK) != 0)
+    {
+      FAR struct tcb_s *tcb = nxsched_get_tcb(pid);
+
+      if (tcb != NULL)
+        {
+          tcb->sigprocmask = attr->sigmask;
+        }
+    }
+
   /* Now set the attributes.  Note that we ignore all of the return values
    * here because we have already successfully started the task.  If we
    * return an error value, then we would also have to stop the task.
@@ -278,69 +264,65 @@ int spawn_execattrs(pid_t pid, FAR const posix_spawnattr_t *attr)
 }
 
 /****************************************************************************
- * Name: spawn_proxyattrs
+ * Name: spawn_file_actions
  *
  * Description:
- *   Set attributes of the proxy task before it has started the new child
- *   task.
+ *   Perform the file actions on the file list of a new task before it is
+ *   activated.  The new task inherits the file descriptors of the caller
+ *   in nxtask_init() so the actions are applied directly to that copy;
+ *   no intermediary task is needed.
  *
  * Input Parameters:
- *
- *   pid - The pid of the new task.
- *   attr - The attributes to use
- *   file_actions - The attributes to use
+ *   tcb     - The TCB of the new task
+ *   actions - The file actions to be performed (may be NULL)
  *
  * Returned Value:
  *   0 (OK) on success; A negated errno value is returned on failure.
  *
  ****************************************************************************/
 
-int spawn_proxyattrs(FAR const posix_spawnattr_t *attr,
-                     FAR const posix_spawn_file_actions_t *file_actions)
+int spawn_file_actions(FAR struct tcb_s *tcb,
+                       FAR const posix_spawn_file_actions_t *actions)
 {
   FAR struct spawn_general_file_action_s *entry;
   int ret = OK;
 
-  /* Check if we need to change the signal mask */
-
-  if (attr != NULL && (attr->flags & POSIX_SPAWN_SETSIGMASK) != 0)
+  if (actions == NULL)
     {
-      nxsig_procmask(SIG_SETMASK, &attr->sigmask, NULL);
+      return OK;
     }
 
-  /* Were we also requested to perform file actions? */
+  /* Execute each file action */
 
-  if (file_actions != NULL)
+  for (entry = (FAR struct spawn_general_file_action_s *)*actions;
+       entry && ret == OK;
+       entry = entry->flink)
     {
-      /* Yes.. Execute each file action */
-
-      for (entry = (FAR struct spawn_general_file_action_s *)file_actions;
-           entry && ret == OK;
-           entry = entry->flink)
+      switch (entry->action)
         {
-          switch (entry->action)
-            {
-              case SPAWN_FILE_ACTION_CLOSE:
-                ret = nxspawn_close((FAR struct spawn_close_file_action_s *)
-                                    entry);
-                break;
-
-              case SPAWN_FILE_ACTION_DUP2:
-                ret = nxspawn_dup2((FAR struct spawn_dup2_file_action_s *)
-                                   entry);
-                break;
-
-              case SPAWN_FILE_ACTION_OPEN:
-                ret = nxspawn_open((FAR struct spawn_open_file_action_s *)
-                                   entry);
-                break;
-
-              case SPAWN_FILE_ACTION_NONE:
-              default:
-                serr("ERROR: Unknown action: %d\n", entry->action);
-                ret = EINVAL;
-                break;
-            }
+          case SPAWN_FILE_ACTION_CLOSE:
+            ret = nxspawn_close(tcb,
+                                (FAR struct spawn_close_file_action_s *)
+                                entry);
+            break;
+
+          case SPAWN_FILE_ACTION_DUP2:
+            ret = nxspawn_dup2(tcb,
+                               (FAR struct spawn_dup2_file_action_s *)
+                               entry);
+            break;
+
+          case SPAWN_FILE_ACTION_OPEN:
+            ret = nxspawn_open(tcb,
+                               (FAR struct spawn_open_file_action_s *)
+                               entry);
+            break;
+
+          case SPAWN_FILE_ACTION_NONE:
+          default:
+            serr("ERROR: Unknown action: %d\n", entry->action);
+            ret = -EINVAL;
+            break;
         }
     }
 
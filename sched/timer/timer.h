@@ -57,6 +57,7 @@ struct posix_timer_s
   int              pt_delay;       /* If non-zero, used to reset repetitive timers */
   struct wdog_s    pt_wdog;        /* The watchdog that provides the timing */
   struct sigevent  pt_event;       /* Notification information */
+  int              pt_overrun;     /* Expirations while the signal was queued */
   struct sigwork_s pt_work;
 };
 
@@ -75,8 +75,19 @@
 
 int timer_getoverrun(timer_t timerid)
 {
-  set_errno(ENOSYS);
-  return ERROR;
+  FAR struct posix_timer_s *timer = (FAR struct posix_timer_s *)timerid;
+
+  if (timer == NULL)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  /* The count is reset each time that a new signal is queued for the
+   * timer, so it holds the overruns of the signal being delivered.
+   */
+
+  return timer->pt_overrun;
 }
 
 #endif /* CONFIG_DISABLE_POSIX_TIMERS */
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <limits.h>
 #include <time.h>
 #include <string.h>
 #include <assert.h>
@@ -33,6 +34,7 @@
 #include <nuttx/irq.h>
 
 #include "clock/clock.h"
+#include "signal/signal.h"
 #include "timer/timer.h"
 
 #ifndef CONFIG_DISABLE_POSIX_TIMERS
@@ -70,6 +72,31 @@ static void timer_timeout(wdparm_t itimer);
 
 static inline void timer_signotify(FAR struct posix_timer_s *timer)
 {
+  siginfo_t info;
+
+  /* Only a single signal is queued for a timer at any time.  If the last
+   * one has not been delivered or accepted yet, just count the overrun.
+   */
+
+  if (timer->pt_event.sigev_notify == SIGEV_SIGNAL)
+    {
+      info.si_signo = timer->pt_event.sigev_signo;
+      info.si_code  = SI_TIMER;
+      info.si_value = timer->pt_event.sigev_value;
+
+      if (nxsig_ispending(timer->pt_owner, &info))
+        {
+          if (timer->pt_overrun < DELAYTIMER_MAX)
+            {
+              timer->pt_overrun++;
+            }
+
+          return;
+        }
+
+      timer->pt_overrun = 0;
+    }
+
   DEBUGVERIFY(nxsig_notification(timer->pt_owner, &timer->pt_event,
                                  SI_TIMER, &timer->pt_work));
 }
@@ -57,8 +57,6 @@
 
 int wd_cancel(FAR struct wdog_s *wdog)
 {
-  FAR struct wdog_s *curr;
-  FAR struct wdog_s *prev;
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -74,53 +72,18 @@ int wd_cancel(FAR struct wdog_s *wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
-      /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
-       * to do this because there are additional operations that need to be
-       * done.
-       */
-
-      prev = NULL;
-      curr = (FAR struct wdog_s *)g_wdactivelist.head;
-
-      while ((curr) && (curr != wdog))
-        {
-          prev = curr;
-          curr = curr->next;
-        }
+      bool head = (wdog == g_wdactivelist);
 
-      /* Check if the watchdog was found in the list.  If not, then an OS
-       * error has occurred because the watchdog is marked active!
-       */
+      /* Remove the watchdog from the timer queue */
 
-      DEBUGASSERT(curr);
+      wd_remove(wdog);
 
-      /* If there is a watchdog in the timer queue after the one that
-       * is being canceled, then it inherits the remaining ticks.
+      /* If the watchdog was at the head of the queue, reassess the interval
+       * timer that will generate the next interval event.
        */
 
-      if (curr->next)
-        {
-          curr->next->lag += curr->lag;
-        }
-
-      /* Now, remove the watchdog from the timer queue */
-
-      if (prev)
-        {
-          /* Remove the watchdog from mid- or end-of-queue */
-
-          sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
-        }
-      else
+      if (head)
         {
-          /* Remove the watchdog at the head of the queue */
-
-          sq_remfirst(&g_wdactivelist);
-
-          /* Reassess the interval timer that will generate the next
-           * interval event.
-           */
-
           nxsched_reassess_timer();
         }
 
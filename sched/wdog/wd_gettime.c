@@ -59,25 +59,13 @@ sclock_t wd_gettime(FAR struct wdog_s *wdog)
   flags = enter_critical_section();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
-      /* Traverse the watchdog list accumulating lag times until we find the
-       * wdog that we are looking for
-       */
+      /* The expiration time is absolute in the wdog time base */
 
-      FAR struct wdog_s *curr;
-      sclock_t delay = 0;
+      sclock_t delay = (sclock_t)(wdog->expired - g_wdtickbase) -
+                       wd_elapse();
 
-      for (curr = (FAR struct wdog_s *)g_wdactivelist.head;
-           curr != NULL;
-           curr = curr->next)
-        {
-          delay += curr->lag;
-          if (curr == wdog)
-            {
-              delay -= wd_elapse();
-              leave_critical_section(flags);
-              return delay;
-            }
-        }
+      leave_critical_section(flags);
+      return delay;
     }
 
   leave_critical_section(flags);
@@ -24,28 +24,25 @@
 
 #include <nuttx/config.h>
 
-#include <queue.h>
-
 #include "wdog/wdog.h"
 
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* The g_wdactivelist data structure is a singly linked list ordered by
- * watchdog expiration time. When watchdog timers expire,the functions on
- * this linked list are removed and the function is called.
+/* g_wdactivelist is the root of a pairing heap of the active watchdogs,
+ * ordered by expiration time.  The root is always the watchdog that
+ * expires next.  When watchdog timers expire, they are removed from the
+ * heap and their functions are called.
  */
 
-sq_queue_t g_wdactivelist;
+FAR struct wdog_s *g_wdactivelist;
 
-/* This is wdog tickbase, for wd_gettime() may called many times
- * between 2 times of wd_timer(), we use it to update wd_gettime().
+/* This is wdog tickbase, the time that wd_timer() has been told about so
+ * far.  Watchdog expiration times are absolute in this time base.
  */
 
-#ifdef CONFIG_SCHED_TICKLESS
 clock_t g_wdtickbase;
-#endif
 
 /****************************************************************************
  * Public Functions
@@ -0,0 +1,205 @@
+/****************************************************************************
+ * sched/wdog/wd_queue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_meld
+ *
+ * Description:
+ *   Combine two pairing heaps, making the root that expires later the first
+ *   child of the other.  Both roots must be detached (no siblings).  On a
+ *   tie the first heap stays on top, so that watchdogs started earlier for
+ *   the same tick tend to run first.
+ *
+ ****************************************************************************/
+
+static FAR struct wdog_s *wd_meld(FAR struct wdog_s *a,
+                                  FAR struct wdog_s *b)
+{
+  FAR struct wdog_s *tmp;
+
+  if (a == NULL)
+    {
+      return b;
+    }
+
+  if (b == NULL)
+    {
+      return a;
+    }
+
+  if (WDOG_BEFORE(b->expired, a->expired))
+    {
+      tmp = a;
+      a   = b;
+      b   = tmp;
+    }
+
+  b->prev = a;
+  b->next = a->child;
+  if (a->child != NULL)
+    {
+      a->child->prev = b;
+    }
+
+  a->child = b;
+  return a;
+}
+
+/****************************************************************************
+ * Name: wd_mergepairs
+ *
+ * Description:
+ *   Combine a list of sibling heaps into one with the usual two-pass
+ *   pairing: meld the siblings pairwise from left to right, then meld the
+ *   resulting heaps from right to left.
+ *
+ ****************************************************************************/
+
+static FAR struct wdog_s *wd_mergepairs(FAR struct wdog_s *first)
+{
+  FAR struct wdog_s *pairs = NULL;
+  FAR struct wdog_s *root = NULL;
+  FAR struct wdog_s *a;
+  FAR struct wdog_s *b;
+
+  /* First pass.  The melded pairs are pushed on a stack linked through
+   * 'next' so that the second pass sees them from right to left.
+   */
+
+  while (first != NULL)
+    {
+      a     = first;
+      b     = a->next;
+      first = b != NULL ? b->next : NULL;
+
+      a->next = a->prev = NULL;
+      if (b != NULL)
+        {
+          b->next = b->prev = NULL;
+        }
+
+      a       = wd_meld(a, b);
+      a->next = pairs;
+      pairs   = a;
+    }
+
+  /* Second pass */
+
+  while (pairs != NULL)
+    {
+      a       = pairs;
+      pairs   = a->next;
+      a->next = NULL;
+      root    = wd_meld(root, a);
+    }
+
+  return root;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_insert
+ *
+ * Description:
+ *   Add a watchdog to the active watchdog queue.  This is O(1).
+ *
+ * Assumptions:
+ *   Called in a critical section.  wdog->expired has been set.
+ *
+ ****************************************************************************/
+
+void wd_insert(FAR struct wdog_s *wdog)
+{
+  wdog->child = NULL;
+  wdog->next  = NULL;
+  wdog->prev  = NULL;
+
+  g_wdactivelist = wd_meld(g_wdactivelist, wdog);
+}
+
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove a watchdog from the active watchdog queue.  This is O(log n)
+ *   amortized.
+ *
+ * Assumptions:
+ *   Called in a critical section.  The watchdog is in the queue.
+ *
+ ****************************************************************************/
+
+void wd_remove(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_s *sub;
+
+  if (wdog == g_wdactivelist)
+    {
+      g_wdactivelist = wd_mergepairs(wdog->child);
+    }
+  else
+    {
+      /* Unlink the watchdog from its sibling list */
+
+      DEBUGASSERT(wdog->prev != NULL);
+
+      if (wdog->prev->child == wdog)
+        {
+          wdog->prev->child = wdog->next;
+        }
+      else
+        {
+          wdog->prev->next = wdog->next;
+        }
+
+      if (wdog->next != NULL)
+        {
+          wdog->next->prev = wdog->prev;
+        }
+
+      /* Then put its children back */
+
+      sub            = wd_mergepairs(wdog->child);
+      g_wdactivelist = wd_meld(g_wdactivelist, sub);
+    }
+
+  wdog->child = NULL;
+  wdog->next  = NULL;
+  wdog->prev  = NULL;
+}
@@ -42,10 +42,6 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#ifndef MIN
-#  define MIN(a,b) (((a) < (b)) ? (a) : (b))
-#endif
-
 #ifndef MAX
 #  define MAX(a,b) (((a) > (b)) ? (a) : (b))
 #endif
@@ -98,25 +94,17 @@ static inline void wd_expiration(void)
   FAR struct wdog_s *wdog;
   wdentry_t func;
 
-  /* Process the watchdog at the head of the list as well as any
+  /* Process the watchdog at the head of the queue as well as any
    * other watchdogs that became ready to run at this time
    */
 
-  while (g_wdactivelist.head &&
-        ((FAR struct wdog_s *)g_wdactivelist.head)->lag <= 0)
+  while (g_wdactivelist != NULL &&
+         !WDOG_BEFORE(g_wdtickbase, g_wdactivelist->expired))
     {
-      /* Remove the watchdog from the head of the list */
-
-      wdog = (FAR struct wdog_s *)sq_remfirst(&g_wdactivelist);
+      /* Remove the watchdog from the head of the queue */
 
-      /* If there is another watchdog behind this one, update its
-       * its lag (this shouldn't be necessary).
-       */
-
-      if (g_wdactivelist.head)
-        {
-          ((FAR struct wdog_s *)g_wdactivelist.head)->lag += wdog->lag;
-        }
+      wdog = g_wdactivelist;
+      wd_remove(wdog);
 
       /* Indicate that the watchdog is no longer active. */
 
@@ -173,10 +161,6 @@ static inline void wd_expiration(void)
 int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
              wdentry_t wdentry, wdparm_t arg)
 {
-  FAR struct wdog_s *curr;
-  FAR struct wdog_s *prev;
-  FAR struct wdog_s *next;
-  sclock_t now;
   irqstate_t flags;
 
   /* Verify the wdog and setup parameters */
@@ -230,107 +214,29 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Cancel the interval timer that drives the timing events.  This will
-   * cause wd_timer to be called which update the delay value for the first
-   * time at the head of the timer list (there is a possibility that it
-   * could even remove it).
+   * cause wd_timer to be called which brings g_wdtickbase up to date (there
+   * is a possibility that it could even expire the watchdog at the head of
+   * the queue).
    */
 
   nxsched_cancel_timer();
-#endif
 
-  /* Do the easy case first -- when the watchdog timer queue is empty. */
+  /* If the queue is empty, the interval timer was not running and the
+   * tickbase may be stale.
+   */
 
-  if (g_wdactivelist.head == NULL)
+  if (g_wdactivelist == NULL)
     {
-#ifdef CONFIG_SCHED_TICKLESS
-      /* Update clock tickbase */
-
       g_wdtickbase = clock_systime_ticks();
-#endif
-
-      /* Add the watchdog to the head == tail of the queue. */
-
-      sq_addlast((FAR sq_entry_t *)wdog, &g_wdactivelist);
-    }
-
-  /* There are other active watchdogs in the timer queue */
-
-  else
-    {
-      now = 0;
-      prev = curr = (FAR struct wdog_s *)g_wdactivelist.head;
-
-      /* Advance to positive time */
-
-      while ((now += curr->lag) < 0 && curr->next)
-        {
-          prev = curr;
-          curr = curr->next;
-        }
-
-      /* Advance past shorter delays */
-
-      while (now <= delay && curr->next)
-        {
-          prev = curr;
-          curr = curr->next;
-          now += curr->lag;
-        }
-
-      /* Check if the new wdog must be inserted before the curr. */
-
-      if (delay < now)
-        {
-          /* The relative delay time is smaller or equal to the current delay
-           * time, so decrement the current delay time by the new relative
-           * delay time.
-           */
-
-          delay -= (now - curr->lag);
-          curr->lag -= delay;
-
-          /* Insert the new watchdog in the list */
-
-          if (curr == (FAR struct wdog_s *)g_wdactivelist.head)
-            {
-              /* Insert the watchdog at the head of the list */
-
-              sq_addfirst((FAR sq_entry_t *)wdog, &g_wdactivelist);
-            }
-          else
-            {
-              /* Insert the watchdog in mid- or end-of-queue */
-
-              sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)wdog,
-                          &g_wdactivelist);
-            }
-        }
-
-      /* The new watchdog delay time is greater than the curr delay time,
-       * so the new wdog must be inserted after the curr. This only occurs
-       * if the wdog is to be added to the end of the list.
-       */
-
-      else
-        {
-          delay -= now;
-          if (!curr->next)
-            {
-              sq_addlast((FAR sq_entry_t *)wdog, &g_wdactivelist);
-            }
-          else
-            {
-              next = curr->next;
-              next->lag -= delay;
-              sq_addafter((FAR sq_entry_t *)curr, (FAR sq_entry_t *)wdog,
-                          &g_wdactivelist);
-            }
-        }
     }
+#endif
 
-  /* Put the lag into the watchdog structure and mark it as active. */
+  /* Put the expiration time into the watchdog structure and add it to the
+   * queue, which marks it as active.
+   */
 
-  wdog->lag = delay;
+  wdog->expired = g_wdtickbase + delay;
+  wd_insert(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Resume the interval timer that will generate the next interval event.
@@ -374,63 +280,32 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
 #ifdef CONFIG_SCHED_TICKLESS
 unsigned int wd_timer(int ticks, bool noswitches)
 {
-  FAR struct wdog_s *wdog;
-  unsigned int ret;
-  int decr;
+  /* Advance the time base */
 
-  /* Check if there are any active watchdogs to process */
-
-  wdog = (FAR struct wdog_s *)g_wdactivelist.head;
-  while (wdog != NULL && ticks > 0)
-    {
-      /* Decrement the lag for this watchdog. */
-
-      decr = MIN(wdog->lag, ticks);
-
-      /* There are.  Decrement the lag counter */
-
-      wdog->lag    -= decr;
-      ticks        -= decr;
-      g_wdtickbase += decr;
-
-      wdog = wdog->next;
-    }
+  g_wdtickbase += ticks;
 
-  /* Check if the watchdog at the head of the list is ready to run */
+  /* Check if the watchdog at the head of the queue is ready to run */
 
   if (!noswitches)
     {
       wd_expiration();
     }
 
-  /* Update clock tickbase */
-
-  g_wdtickbase += ticks;
-
-  /* Return the delay for the next watchdog to expire */
-
-  ret = g_wdactivelist.head ?
-        MAX(((FAR struct wdog_s *)g_wdactivelist.head)->lag, 1) : 0;
-
   /* Return the delay for the next watchdog to expire */
 
-  return ret;
+  return g_wdactivelist != NULL ?
+         MAX((sclock_t)(g_wdactivelist->expired - g_wdtickbase), 1) : 0;
 }
 
 #else
 void wd_timer(void)
 {
-  /* Check if there are any active watchdogs to process */
+  /* Advance the time base */
 
-  if (g_wdactivelist.head)
-    {
-      /* There are.  Decrement the lag counter */
-
-      --(((FAR struct wdog_s *)g_wdactivelist.head)->lag);
+  g_wdtickbase++;
 
-      /* Check if the watchdog at the head of the list is ready to run */
+  /* Check if the watchdog at the head of the queue is ready to run */
 
-      wd_expiration();
-    }
+  wd_expiration();
 }
 #endif /* CONFIG_SCHED_TICKLESS */
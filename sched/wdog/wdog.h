@@ -55,6 +55,10 @@
 #  define wd_elapse() (0)
 #endif
 
+/* Compare two expiration times in a way that survives clock wrap-around */
+
+#define WDOG_BEFORE(a, b) ((sclock_t)((a) - (b)) < 0)
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -67,20 +71,19 @@ extern "C"
 #define EXTERN extern
 #endif
 
-/* The g_wdactivelist data structure is a singly linked list ordered by
- * watchdog expiration time. When watchdog timers expire,the functions on
- * this linked list are removed and the function is called.
+/* g_wdactivelist is the root of a pairing heap of the active watchdogs,
+ * ordered by expiration time.  The root is always the watchdog that
+ * expires next.  When watchdog timers expire, they are removed from the
+ * heap and their functions are called.
  */
 
-extern sq_queue_t g_wdactivelist;
+extern FAR struct wdog_s *g_wdactivelist;
 
-/* This is wdog tickbase, for wd_gettime() may called many times
- * between 2 times of wd_timer(), we use it to update wd_gettime().
+/* This is wdog tickbase, the time that wd_timer() has been told about so
+ * far.  Watchdog expiration times are absolute in this time base.
  */
 
-#ifdef CONFIG_SCHED_TICKLESS
 extern clock_t g_wdtickbase;
-#endif
 
 /****************************************************************************
  * Public Function Prototypes
@@ -118,6 +121,44 @@ unsigned int wd_timer(int ticks, bool noswitches);
 void wd_timer(void);
 #endif
 
+/****************************************************************************
+ * Name: wd_insert
+ *
+ * Description:
+ *   Add a watchdog to the active watchdog queue.
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to add.  wdog->expired must be set.
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+void wd_insert(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove a watchdog from the active watchdog queue.
+ *
+ * Input Parameters:
+ *   wdog - The watchdog to remove.  It must be in the queue.
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+void wd_remove(FAR struct wdog_s *wdog);
+
 /****************************************************************************
  * Name: wd_recover
  *
@@ -66,6 +66,9 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
 {
   irqstate_t flags;
   int ret = -ENOENT;
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  int wndx;
+#endif
 
   DEBUGASSERT(work != NULL);
 
@@ -77,18 +80,21 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
   flags = enter_critical_section();
   if (work->worker != NULL)
     {
-      /* Remove the entry from the work queue and make sure that it is
-       * marked as available (i.e., the worker field is nullified).
+      /* Remove the entry from the delayed or the work queue and make sure
+       * that it is marked as available (i.e., the worker field is
+       * nullified).  The timer is left running; if this was the first
+       * delayed work, the expiry simply restarts it for the next one.
        */
 
-      if (WDOG_ISACTIVE(&work->u.timer))
-        {
-          wd_cancel(&work->u.timer);
-        }
-      else
+      sq_rem((FAR sq_entry_t *)work, &wqueue->dq);
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      for (wndx = 0; wndx < CONFIG_SMP_NCPUS; wndx++)
         {
-          sq_rem((FAR sq_entry_t *)work, &wqueue->q);
+          sq_rem((FAR sq_entry_t *)work, &wqueue->worker[wndx].q);
         }
+#else
+      sq_rem((FAR sq_entry_t *)work, &wqueue->q);
+#endif
 
       work->worker = NULL;
       ret = OK;
@@ -125,27 +131,14 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
 
 int work_cancel(int qid, FAR struct work_s *work)
 {
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
-    {
-      /* Cancel high priority work */
-
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork, work);
-    }
-  else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
-    {
-      /* Cancel low priority work */
+  FAR struct kwork_wqueue_s *wqueue = work_qid2wq(qid);
 
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_lpwork, work);
-    }
-  else
-#endif
+  if (wqueue == NULL)
     {
       return -EINVAL;
     }
+
+  return work_qcancel(wqueue, work);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
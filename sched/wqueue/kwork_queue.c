@@ -32,8 +32,10 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
 
+#include "sched/sched.h"
 #include "wqueue/wqueue.h"
 
 #ifdef CONFIG_SCHED_WORKQUEUE
@@ -43,33 +45,178 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: hp_work_timer_expiry
+ * Name: work_post
+ *
+ * Description:
+ *   Add work that is due to the queue of its worker thread(s) and wake
+ *   up a worker.  Called within a critical section.
+ *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_HPWORK
-static void hp_work_timer_expiry(wdparm_t arg)
+static void work_post(FAR struct kwork_wqueue_s *wqueue,
+                      FAR struct work_s *work)
 {
-  irqstate_t flags = enter_critical_section();
-  sq_addlast((FAR sq_entry_t *)arg, &g_hpwork.q);
-  nxsem_post(&g_hpwork.sem);
-  leave_critical_section(flags);
-}
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  FAR struct kworker_s *kworker;
+  int cpu;
+
+  /* Unbound work runs on the CPU that queued it or whose timer expired */
+
+  cpu     = work->cpu >= 0 ? work->cpu : this_cpu();
+  kworker = &wqueue->worker[cpu];
+
+  sq_addlast(&work->u.s.sq, &kworker->q);
+  nxsem_post(&kworker->sem);
+
+  /* If that worker is busy, let an idle one steal unbound work */
+
+  if (kworker->busy && work->cpu < 0)
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          if (!wqueue->worker[cpu].busy &&
+              &wqueue->worker[cpu] != kworker)
+            {
+              nxsem_post(&wqueue->worker[cpu].sem);
+              break;
+            }
+        }
+    }
+#else
+  sq_addlast(&work->u.s.sq, &wqueue->q);
+  nxsem_post(&wqueue->sem);
 #endif
+}
 
 /****************************************************************************
- * Name: lp_work_timer_expiry
+ * Name: work_timer_expiry
+ *
+ * Description:
+ *   Move the delayed work that expired to the work queue, then restart the
+ *   timer for the next delayed work.
+ *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_LPWORK
-static void lp_work_timer_expiry(wdparm_t arg)
+static void work_timer_expiry(wdparm_t arg)
 {
-  irqstate_t flags = enter_critical_section();
-  sq_addlast((FAR sq_entry_t *)arg, &g_lpwork.q);
-  nxsem_post(&g_lpwork.sem);
+  FAR struct kwork_wqueue_s *wqueue = (FAR struct kwork_wqueue_s *)arg;
+  FAR struct work_s *work;
+  irqstate_t flags;
+  clock_t now;
+
+  flags = enter_critical_section();
+  now   = clock_systime_ticks();
+
+  while ((work = (FAR struct work_s *)sq_peek(&wqueue->dq)) != NULL &&
+         (sclock_t)(work->u.s.qtime - now) <= 0)
+    {
+      sq_remfirst(&wqueue->dq);
+      work_post(wqueue, work);
+    }
+
+  if (work != NULL)
+    {
+      wd_start(&wqueue->timer, work->u.s.qtime - now, work_timer_expiry,
+               arg);
+    }
+
   leave_critical_section(flags);
 }
+
+/****************************************************************************
+ * Name: work_delay
+ *
+ * Description:
+ *   Insert work in the queue of delayed work, in the order of expiry.
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+static void work_delay(FAR struct kwork_wqueue_s *wqueue,
+                       FAR struct work_s *work, clock_t delay)
+{
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *curr;
+
+  work->u.s.qtime = clock_systime_ticks() + delay;
+
+  /* Work with the same expiry is performed in the order it was queued */
+
+  for (curr = sq_peek(&wqueue->dq);
+       curr != NULL &&
+       (sclock_t)(work->u.s.qtime -
+                  ((FAR struct work_s *)curr)->u.s.qtime) >= 0;
+       curr = sq_next(curr))
+    {
+      prev = curr;
+    }
+
+  if (prev == NULL)
+    {
+      /* This is the first delayed work now, (re)start the timer */
+
+      sq_addfirst(&work->u.s.sq, &wqueue->dq);
+      wd_start(&wqueue->timer, delay, work_timer_expiry,
+               (wdparm_t)wqueue);
+    }
+  else
+    {
+      sq_addafter(prev, &work->u.s.sq, &wqueue->dq);
+    }
+}
+
+/****************************************************************************
+ * Name: work_qqueue
+ *
+ * Description:
+ *   Queue work on a kernel work queue.
+ *
+ ****************************************************************************/
+
+static int work_qqueue(int qid, int cpu, FAR struct work_s *work,
+                       worker_t worker, FAR void *arg, clock_t delay)
+{
+  FAR struct kwork_wqueue_s *wqueue = work_qid2wq(qid);
+  irqstate_t flags;
+
+  if (wqueue == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* Remove the entry from the timer and work queue. */
+
+  work_cancel(qid, work);
+
+  /* Interrupts are disabled so that this logic can be called from with
+   * task logic or from interrupt handling logic.
+   */
+
+  flags = enter_critical_section();
+
+  /* Initialize the work structure. */
+
+  work->worker = worker;           /* Work callback. non-NULL means queued */
+  work->arg = arg;                 /* Callback argument */
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  work->cpu = cpu;                 /* Bound CPU, or -1 */
 #endif
 
+  /* Queue the new work */
+
+  if (!delay)
+    {
+      work_post(wqueue, work);
+    }
+  else
+    {
+      work_delay(wqueue, work, delay);
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -107,69 +254,78 @@ static void lp_work_timer_expiry(wdparm_t arg)
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay)
 {
-  irqstate_t flags;
-  int ret = OK;
-
-  /* Remove the entry from the timer and work queue. */
-
-  work_cancel(qid, work);
+  return work_qqueue(qid, -1, work, worker, arg, delay);
+}
 
-  /* Interrupts are disabled so that this logic can be called from with
-   * task logic or from interrupt handling logic.
-   */
+/****************************************************************************
+ * Name: work_queue_cpu
+ *
+ * Description:
+ *   Queue kernel-mode work to be performed on the worker thread of one
+ *   CPU.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (index)
+ *   cpu    - The CPU that will perform the work
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.
+ *   arg    - The argument that will be passed to the worker callback.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
 
-  flags = enter_critical_section();
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+int work_queue_cpu(int qid, int cpu, FAR struct work_s *work,
+                   worker_t worker, FAR void *arg, clock_t delay)
+{
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS)
+    {
+      return -EINVAL;
+    }
 
-  /* Initialize the work structure. */
+  return work_qqueue(qid, cpu, work, worker, arg, delay);
+}
+#endif
 
-  work->worker = worker;           /* Work callback. non-NULL means queued */
-  work->arg = arg;                 /* Callback argument */
+/****************************************************************************
+ * Name: work_timeleft
+ *
+ * Description:
+ *   Return the time remaining before the specified work starts.
+ *
+ * Input Parameters:
+ *   work - The work queue structure to check.
+ *
+ * Returned Value:
+ *   The time in system ticks remaining until the work start.
+ *   Zero means either that work is not valid or that work has already
+ *   started.
+ *
+ ****************************************************************************/
 
-  /* Queue the new work */
+sclock_t work_timeleft(FAR const struct work_s *work)
+{
+  irqstate_t flags;
+  sclock_t left = 0;
 
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
-    {
-      /* Queue high priority work */
+  /* qtime is only meaningful while the work is queued */
 
-      if (!delay)
-        {
-          sq_addlast((FAR sq_entry_t *)work, &g_hpwork.q);
-          nxsem_post(&g_hpwork.sem);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, hp_work_timer_expiry,
-                   (wdparm_t)work);
-        }
-    }
-  else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
+  flags = enter_critical_section();
+  if (work->worker != NULL)
     {
-      /* Queue low priority work */
-
-      if (!delay)
+      left = (sclock_t)(work->u.s.qtime - clock_systime_ticks());
+      if (left < 0)
         {
-          sq_addlast((FAR sq_entry_t *)work, &g_lpwork.q);
-          nxsem_post(&g_lpwork.sem);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, lp_work_timer_expiry,
-                   (wdparm_t)work);
+          left = 0;
         }
     }
-  else
-#endif
-    {
-      ret = -EINVAL;
-    }
 
   leave_critical_section(flags);
-
-  return ret;
+  return left;
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
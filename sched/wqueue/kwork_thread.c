@@ -36,6 +36,7 @@
 
 #include <nuttx/wqueue.h>
 #include <nuttx/kthread.h>
+#include <nuttx/sched.h>
 #include <nuttx/semaphore.h>
 
 #include "wqueue/wqueue.h"
@@ -100,6 +101,60 @@ struct lp_wqueue_s g_lpwork =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_dequeue
+ *
+ * Description:
+ *   Remove the next work from the queue of one per-CPU worker thread.  If
+ *   that queue is empty, steal work that is not bound to a CPU from the
+ *   queue of another worker.  Called within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+static FAR struct work_s *work_dequeue(FAR struct kwork_wqueue_s *wqueue,
+                                       int wndx)
+{
+  FAR sq_entry_t *prev;
+  FAR sq_entry_t *curr;
+  int i;
+
+  curr = sq_remfirst(&wqueue->worker[wndx].q);
+  if (curr != NULL)
+    {
+      return (FAR struct work_s *)curr;
+    }
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == wndx)
+        {
+          continue;
+        }
+
+      for (prev = NULL, curr = sq_peek(&wqueue->worker[i].q);
+           curr != NULL; prev = curr, curr = sq_next(curr))
+        {
+          if (((FAR struct work_s *)curr)->cpu < 0)
+            {
+              if (prev == NULL)
+                {
+                  sq_remfirst(&wqueue->worker[i].q);
+                }
+              else
+                {
+                  sq_remafter(prev, &wqueue->worker[i].q);
+                }
+
+              return (FAR struct work_s *)curr;
+            }
+        }
+    }
+
+  return NULL;
+}
+#endif
+
 /****************************************************************************
  * Name: work_thread
  *
@@ -129,9 +184,17 @@ static int work_thread(int argc, FAR char *argv[])
   worker_t  worker;
   irqstate_t flags;
   FAR void *arg;
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  FAR struct kworker_s *kworker;
+  int wndx;
+#endif
 
   wqueue = (FAR struct kwork_wqueue_s *)
            ((uintptr_t)strtoul(argv[1], NULL, 0));
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  wndx    = atoi(argv[2]);
+  kworker = &wqueue->worker[wndx];
+#endif
 
   flags = enter_critical_section();
 
@@ -144,6 +207,19 @@ static int work_thread(int argc, FAR char *argv[])
        * posted.
        */
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      /* Keep on running while there is work to do or to steal, the count
+       * of the semaphore may then be too high, but that only causes a
+       * wakeup that finds no work.
+       */
+
+      work = work_dequeue(wqueue, wndx);
+      if (work == NULL)
+        {
+          nxsem_wait_uninterruptible(&kworker->sem);
+          continue;
+        }
+#else
       nxsem_wait_uninterruptible(&wqueue->sem);
 
       /* And check each entry in the work queue.  Since we have disabled
@@ -154,6 +230,7 @@ static int work_thread(int argc, FAR char *argv[])
       /* Remove the ready-to-execute work from the list */
 
       work = (FAR struct work_s *)sq_remfirst(&wqueue->q);
+#endif
       if (work && work->worker)
         {
           /* Extract the work description from the entry (in case the work
@@ -174,9 +251,15 @@ static int work_thread(int argc, FAR char *argv[])
            * performed... we don't have any idea how long this will take!
            */
 
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+          kworker->busy = true;
+#endif
           leave_critical_section(flags);
           CALL_WORKER(worker, arg);
           flags = enter_critical_section();
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+          kworker->busy = false;
+#endif
         }
     }
 
@@ -208,14 +291,25 @@ static int work_thread_create(FAR const char *name, int priority,
                               int stack_size, int nthread,
                               FAR struct kwork_wqueue_s *wqueue)
 {
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  FAR char *argv[3];
+  char index[12];
+  cpu_set_t cpuset;
+#else
   FAR char *argv[2];
+#endif
   char args[32];
   int wndx;
   int pid;
 
   snprintf(args, sizeof(args), "0x%" PRIxPTR, (uintptr_t)wqueue);
   argv[0] = args;
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  argv[1] = index;
+  argv[2] = NULL;
+#else
   argv[1] = NULL;
+#endif
 
   /* Don't permit any of the threads to run until we have fully initialized
    * g_hpwork and g_lpwork.
@@ -225,6 +319,15 @@ static int work_thread_create(FAR const char *name, int priority,
 
   for (wndx = 0; wndx < nthread; wndx++)
     {
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      /* Each worker thread has its own queue and runs on its own CPU */
+
+      sq_init(&wqueue->worker[wndx].q);
+      nxsem_init(&wqueue->worker[wndx].sem, 0, 0);
+      nxsem_set_protocol(&wqueue->worker[wndx].sem, SEM_PRIO_NONE);
+      snprintf(index, sizeof(index), "%d", wndx);
+#endif
+
       pid = kthread_create(name, priority, stack_size,
                            (main_t)work_thread, argv);
 
@@ -237,6 +340,12 @@ static int work_thread_create(FAR const char *name, int priority,
         }
 
       wqueue->worker[wndx].pid  = pid;
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+      CPU_ZERO(&cpuset);
+      CPU_SET(wndx, &cpuset);
+      nxsched_set_affinity(pid, sizeof(cpu_set_t), &cpuset);
+#endif
     }
 
   sched_unlock();
@@ -274,7 +383,7 @@ void work_foreach(int qid, work_foreach_t handler, FAR void *arg)
   if (qid == HPWORK)
     {
       wqueue  = (FAR struct kwork_wqueue_s *)&g_hpwork;
-      nthread = CONFIG_SCHED_HPNTHREADS;
+      nthread = HPWORK_NTHREADS;
     }
   else
 #endif
@@ -282,7 +391,7 @@ void work_foreach(int qid, work_foreach_t handler, FAR void *arg)
   if (qid == LPWORK)
     {
       wqueue  = (FAR struct kwork_wqueue_s *)&g_lpwork;
-      nthread = CONFIG_SCHED_LPNTHREADS;
+      nthread = LPWORK_NTHREADS;
     }
   else
 #endif
@@ -319,7 +428,7 @@ int work_start_highpri(void)
 
   return work_thread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
                             CONFIG_SCHED_HPWORKSTACKSIZE,
-                            CONFIG_SCHED_HPNTHREADS,
+                            HPWORK_NTHREADS,
                             (FAR struct kwork_wqueue_s *)&g_hpwork);
 }
 #endif /* CONFIG_SCHED_HPWORK */
@@ -347,7 +456,7 @@ int work_start_lowpri(void)
 
   return work_thread_create(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
                             CONFIG_SCHED_LPWORKSTACKSIZE,
-                            CONFIG_SCHED_LPNTHREADS,
+                            LPWORK_NTHREADS,
                             (FAR struct kwork_wqueue_s *)&g_lpwork);
 }
 #endif /* CONFIG_SCHED_LPWORK */
@@ -31,6 +31,8 @@
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -43,6 +45,16 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* The number of worker threads of each kernel work queue */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+#  define HPWORK_NTHREADS CONFIG_SMP_NCPUS
+#  define LPWORK_NTHREADS CONFIG_SMP_NCPUS
+#else
+#  define HPWORK_NTHREADS CONFIG_SCHED_HPNTHREADS
+#  define LPWORK_NTHREADS CONFIG_SCHED_LPNTHREADS
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -52,14 +64,24 @@
 struct kworker_s
 {
   pid_t             pid;       /* The task ID of the worker thread */
+#ifdef CONFIG_SCHED_WORKQUEUE_PERCPU
+  struct sq_queue_s q;         /* The queue of pending work of this CPU */
+  sem_t             sem;       /* The counting semaphore of this worker */
+  bool              busy;      /* The worker is performing work */
+#endif
 };
 
-/* This structure defines the state of one kernel-mode work queue */
+/* This structure defines the state of one kernel-mode work queue.  The
+ * delayed work is kept in the order of expiry and a single timer expires
+ * the first one, instead of one timer per work.
+ */
 
 struct kwork_wqueue_s
 {
   struct sq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+  struct sq_queue_s dq;        /* The queue of delayed work */
+  struct wdog_s     timer;     /* Expires the first delayed work */
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -72,10 +94,12 @@ struct hp_wqueue_s
 {
   struct sq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+  struct sq_queue_s dq;        /* The queue of delayed work */
+  struct wdog_s     timer;     /* Expires the first delayed work */
 
   /* Describes each thread in the high priority queue's thread pool */
 
-  struct kworker_s  worker[CONFIG_SCHED_HPNTHREADS];
+  struct kworker_s  worker[HPWORK_NTHREADS];
 };
 #endif
 
@@ -88,10 +112,12 @@ struct lp_wqueue_s
 {
   struct sq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+  struct sq_queue_s dq;        /* The queue of delayed work */
+  struct wdog_s     timer;     /* Expires the first delayed work */
 
   /* Describes each thread in the low priority queue's thread pool */
 
-  struct kworker_s  worker[CONFIG_SCHED_LPNTHREADS];
+  struct kworker_s  worker[LPWORK_NTHREADS];
 };
 #endif
 
@@ -111,6 +137,38 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_qid2wq
+ *
+ * Description:
+ *   Return the kernel work queue of a work queue ID, or NULL if the ID is
+ *   not valid.
+ *
+ ****************************************************************************/
+
+static inline FAR struct kwork_wqueue_s *work_qid2wq(int qid)
+{
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_hpwork;
+    }
+#endif
+
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_lpwork;
+    }
+#endif
+
+  return NULL;
+}
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -93,6 +93,8 @@
 #define CROMFS_MAGIC       0x4d4f5243
 #define CROMFS_BLOCKSIZE   512
 
+#define CROMFS_NODE_INDEXED (1 << 0)  /* Must match fs/cromfs/cromfs.h */
+
 #define LZF_BUFSIZE        512
 #define LZF_HLOG           13
 #define LZF_HSIZE          (1 << LZF_HLOG)
@@ -140,7 +142,7 @@ struct cromfs_volume_s
 struct cromfs_node_s
 {
   uint16_t cn_mode;       /* File type, attributes, and access mode bits */
-  uint16_t cn_pad;        /* Not used */
+  uint16_t cn_flags;      /* See CROMFS_NODE_* definitions */
   uint32_t cn_name;       /* Offset from the beginning of the volume header to the
                            * node name string.  NUL-terminated. */
   uint32_t cn_size;       /* Size of the uncompressed data (in bytes) */
@@ -219,6 +221,9 @@ static char *g_progname;       /* Name of this program */
 static char *g_dirname;        /* Source directory path */
 static char *g_outname;        /* Output file path */
 
+static bool g_indexed = true;  /* Generate block indices for files */
+static unsigned int g_minsave; /* Required saving of compression (%) */
+
 static FILE *g_outstream;      /* Main output stream */
 static FILE *g_tmpstream;      /* Temporary file output stream */
 
@@ -272,7 +277,7 @@ static void dump_hexbuffer(FILE *stream, const void *buffer,
                            unsigned int nbytes);
 static void dump_nextline(FILE *stream);
 static size_t lzf_compress(const uint8_t *inbuffer, unsigned int inlen,
-                           union lzf_result_u *result);
+                           unsigned int maxout, union lzf_result_u *result);
 static uint16_t get_mode(mode_t mode);
 #ifdef HOST_TGTSWAP
 static inline uint16_t tgt_uint16(uint16_t a);
@@ -301,7 +306,21 @@ static int  traverse_directory(const char *dirpath,
 
 static void show_usage(void)
 {
-  fprintf(stderr, "USAGE: %s <dir-path> <out-file>\n", g_progname);
+  fprintf(stderr, "USAGE: %s [-l] [-c <percent>] <dir-path> <out-file>\n",
+          g_progname);
+  fprintf(stderr, "\nWhere:\n\n");
+  fprintf(stderr, "  -l  Do not generate block indices.  Without them, "
+          "reading from the\n");
+  fprintf(stderr, "      middle of a file walks the preceding blocks, but "
+          "the image is\n");
+  fprintf(stderr, "      4 bytes per %u byte block smaller.\n",
+          CROMFS_BLOCKSIZE);
+  fprintf(stderr, "  -c  Store a block uncompressed unless compression "
+          "saves at least\n");
+  fprintf(stderr, "      <percent> of its size (default 0).  Uncompressed "
+          "blocks are read\n");
+  fprintf(stderr, "      by a plain copy.  100 stores all data "
+          "uncompressed.\n");
   exit(1);
 }
 
@@ -523,12 +542,12 @@ static void dump_nextline(FILE *stream)
 }
 
 static size_t lzf_compress(const uint8_t *inbuffer, unsigned int inlen,
-                           union lzf_result_u *result)
+                           unsigned int maxout, union lzf_result_u *result)
 {
   const uint8_t *inptr  = inbuffer;
         uint8_t *outptr = result->compressed.lzf_buffer;
   const uint8_t *inend  = inptr + inlen;
-        uint8_t *outend = outptr + LZF_BUFSIZE;
+        uint8_t *outend = outptr + maxout;
   const uint8_t *ref;
   uintptr_t off;
   ssize_t cs;
@@ -536,7 +555,7 @@ static size_t lzf_compress(const uint8_t *inbuffer, unsigned int inlen,
   unsigned int hval;
   int lit;
 
-  if (inlen == 0)
+  if (inlen == 0 || maxout == 0)
     {
       cs = 0;
       goto genhdr;
@@ -877,7 +896,7 @@ static void gen_dirlink(const char *name, uint32_t tgtoffs, bool dirempty)
           (unsigned long)g_offset, name);
 
   node.cn_mode    = TGT_UINT16(DIRLINK_MODEFLAGS);
-  node.cn_pad     = 0;
+  node.cn_flags   = 0;
 
   g_offset       += sizeof(struct cromfs_node_s);
   node.cn_name    = TGT_UINT32(g_offset);
@@ -960,7 +979,7 @@ static void gen_directory(const char *path, const char *name, mode_t mode,
           (unsigned long)save_offset, path);
 
   node.cn_mode    = TGT_UINT16(NUTTX_IFDIR | get_mode(mode));
-  node.cn_pad     = 0;
+  node.cn_flags   = 0;
 
   save_offset    += sizeof(struct cromfs_node_s);
   node.cn_name    = TGT_UINT32(save_offset);
@@ -988,7 +1007,9 @@ static void gen_file(const char *path, const char *name, mode_t mode,
 {
   struct cromfs_node_s node;
   union lzf_result_u result;
+  struct stat buf;
   uint32_t nodeoffs = g_offset;
+  uint32_t *index = NULL;
   FILE *save_tmpstream = g_tmpstream;
   FILE *outstream;
   FILE *instream;
@@ -997,17 +1018,14 @@ static void gen_file(const char *path, const char *name, mode_t mode,
   size_t ntotal;
   size_t blklen;
   size_t blktotal;
+  size_t indexsize;
+  unsigned int maxout;
+  unsigned int nblocks;
   unsigned int blkno;
   int namlen;
 
   namlen      = strlen(name) + 1;
 
-  /* Open a new temporary file */
-
-  outstream   = open_tmpfile();
-  g_tmpstream = outstream;
-  g_offset    = nodeoffs + sizeof(struct cromfs_node_s) + namlen;
-
   /* Open the source data file */
 
   instream    = fopen(path, "r");
@@ -1018,6 +1036,42 @@ static void gen_file(const char *path, const char *name, mode_t mode,
       exit(1);
     }
 
+  /* The block index lies between the file name and the first block, so
+   * the number of blocks must be known before the blocks are generated.
+   */
+
+  nblocks     = 0;
+  if (g_indexed)
+    {
+      if (fstat(fileno(instream), &buf) < 0)
+        {
+          fprintf(stderr, "ERROR: fstat(%s) failed: %s\n",
+                  path, strerror(errno));
+          exit(1);
+        }
+
+      nblocks = (buf.st_size + LZF_BUFSIZE - 1) / LZF_BUFSIZE;
+      if (nblocks > 0)
+        {
+          index = malloc(nblocks * sizeof(uint32_t));
+          if (index == NULL)
+            {
+              fprintf(stderr, "ERROR: Failed to allocate index of %s\n",
+                      path);
+              exit(1);
+            }
+        }
+    }
+
+  indexsize   = nblocks * sizeof(uint32_t);
+
+  /* Open a new temporary file */
+
+  outstream   = open_tmpfile();
+  g_tmpstream = outstream;
+  g_offset    = nodeoffs + sizeof(struct cromfs_node_s) + namlen +
+                indexsize;
+
   /* Then read data from the file, compress it, and write it to the new
    * temporary file
    */
@@ -1035,9 +1089,13 @@ static void gen_file(const char *path, const char *name, mode_t mode,
         {
           uint16_t clen;
 
-          /* Compress the chunk */
+          /* Compress the chunk, keeping it uncompressed if compression
+           * does not save enough.
+           */
 
-          blklen = lzf_compress(iobuffer, nread, &result);
+          maxout = g_minsave > 0 ? nread - nread * g_minsave / 100 :
+                                   LZF_BUFSIZE;
+          blklen = lzf_compress(iobuffer, nread, maxout, &result);
           if (result.cmn.lzf_type == LZF_TYPE0_HDR)
             {
               clen = nread;
@@ -1056,6 +1114,17 @@ static void gen_file(const char *path, const char *name, mode_t mode,
           dump_hexbuffer(g_tmpstream, &result, blklen);
           dump_nextline(g_tmpstream);
 
+          if (g_indexed)
+            {
+              if (blkno >= nblocks)
+                {
+                  fprintf(stderr, "ERROR: %s changed size\n", path);
+                  exit(1);
+                }
+
+              index[blkno] = TGT_UINT32(g_offset);
+            }
+
           ntotal   += nread;
           blktotal += blklen;
           g_offset += blklen;
@@ -1066,6 +1135,14 @@ static void gen_file(const char *path, const char *name, mode_t mode,
     }
   while (nread > 0);
 
+  fclose(instream);
+
+  if (g_indexed && blkno != nblocks)
+    {
+      fprintf(stderr, "ERROR: %s changed size\n", path);
+      exit(1);
+    }
+
   /* Restore the old tmpfile context */
 
   g_tmpstream        = save_tmpstream;
@@ -1078,7 +1155,7 @@ static void gen_file(const char *path, const char *name, mode_t mode,
           (unsigned long)blktotal);
 
   node.cn_mode       = TGT_UINT16(NUTTX_IFREG | get_mode(mode));
-  node.cn_pad        = 0;
+  node.cn_flags      = TGT_UINT16(g_indexed ? CROMFS_NODE_INDEXED : 0);
 
   nodeoffs          += sizeof(struct cromfs_node_s);
   node.cn_name       = TGT_UINT32(nodeoffs);
@@ -1088,13 +1165,23 @@ static void gen_file(const char *path, const char *name, mode_t mode,
   nodeoffs          += namlen;
   node.u.cn_blocks   = TGT_UINT32(nodeoffs);
 
-  nodeoffs          += blktotal;
+  nodeoffs          += indexsize + blktotal;
   node.cn_peer       = TGT_UINT32(lastentry ? 0 : nodeoffs);
 
   dump_hexbuffer(g_tmpstream, &node, sizeof(struct cromfs_node_s));
   dump_hexbuffer(g_tmpstream, name, namlen);
   dump_nextline(g_tmpstream);
 
+  if (indexsize > 0)
+    {
+      fprintf(g_tmpstream, "\n  /* Block index of %s:  %u blocks */\n\n",
+              path, nblocks);
+      dump_hexbuffer(g_tmpstream, index, indexsize);
+      dump_nextline(g_tmpstream);
+    }
+
+  free(index);
+
   g_nnodes++;
 
   /* Now append the sub-tree nodes in the new tmpfile to the previous
@@ -1242,22 +1329,47 @@ static int traverse_directory(const char *dirpath,
 int main(int argc, char **argv, char **envp)
 {
   struct cromfs_volume_s vol;
+  char *endptr;
   char *ptr;
   int result;
+  int ch;
 
   /* Verify arguments */
 
   ptr = strrchr(argv[0], '/');
   g_progname = ptr == NULL ? argv[0] : ptr + 1;
 
-  if (argc != 3)
+  while ((ch = getopt(argc, argv, "c:lh")) != -1)
+    {
+      switch (ch)
+        {
+          case 'c':
+            g_minsave = strtoul(optarg, &endptr, 10);
+            if (*optarg == '\0' || *endptr != '\0' || g_minsave > 100)
+              {
+                fprintf(stderr, "Invalid percentage: %s\n", optarg);
+                show_usage();
+              }
+            break;
+
+          case 'l':
+            g_indexed = false;
+            break;
+
+          case 'h':
+          default:
+            show_usage();
+        }
+    }
+
+  if (argc - optind != 2)
     {
       fprintf(stderr, "Unexpected number of arguments\n");
       show_usage();
     }
 
-  g_dirname  = argv[1];
-  g_outname  = argv[2];
+  g_dirname  = argv[optind];
+  g_outname  = argv[optind + 1];
 
   verify_directory();
   verify_outfile();
@@ -0,0 +1,759 @@
+/****************************************************************************
+ * tools/notetrace.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The note types of include/nuttx/sched_note.h */
+
+#define NOTE_START           0
+#define NOTE_STOP            1
+#define NOTE_SUSPEND         2
+#define NOTE_RESUME          3
+#define NOTE_CPU_START       4
+#define NOTE_CPU_STARTED     5
+#define NOTE_CPU_PAUSE       6
+#define NOTE_CPU_PAUSED      7
+#define NOTE_CPU_RESUME      8
+#define NOTE_CPU_RESUMED     9
+#define NOTE_PREEMPT_LOCK    10
+#define NOTE_PREEMPT_UNLOCK  11
+#define NOTE_CSECTION_ENTER  12
+#define NOTE_CSECTION_LEAVE  13
+#define NOTE_SPINLOCK_LOCK   14
+#define NOTE_SPINLOCK_LOCKED 15
+#define NOTE_SPINLOCK_UNLOCK 16
+#define NOTE_SPINLOCK_ABORT  17
+#define NOTE_SYSCALL_ENTER   18
+#define NOTE_SYSCALL_LEAVE   19
+#define NOTE_IRQ_ENTER       20
+#define NOTE_IRQ_LEAVE       21
+#define NOTE_DUMP_STRING     22
+#define NOTE_DUMP_BINARY     23
+
+/* The trace viewer "processes" that hold the tracks.  The tasks are the
+ * threads of the first one, the CPUs and their interrupts the threads of
+ * the second one.
+ */
+
+#define TRACE_PID_TASKS      0
+#define TRACE_PID_CPUS       1
+#define TRACE_TID_IRQ        1000 /* Added to the CPU number */
+
+#define MAX_CPUS             32
+#define MAX_TASKS            256
+#define MAX_NAMELEN          32
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The layout of the notes, which depends on the target configuration */
+
+struct layout_s
+{
+  bool smp;              /* CONFIG_SMP: Notes carry the CPU number */
+  bool hires;            /* CONFIG_SCHED_INSTRUMENTATION_HIRES */
+  unsigned int pidsize;  /* sizeof(pid_t) */
+  unsigned int timesize; /* sizeof(clock_t), sizeof(time_t) if hires */
+  unsigned int nsecsize; /* sizeof(long) if hires */
+  unsigned int ptrsize;  /* sizeof(uintptr_t) */
+  double freq;           /* Frequency of the timestamps if not hires */
+};
+
+/* The decoded common header of a note */
+
+struct note_s
+{
+  const uint8_t *data;  /* The whole note */
+  unsigned int length;  /* Length of the note */
+  unsigned int hdrlen;  /* Length of the common header */
+  unsigned int type;    /* See the NOTE_* definitions */
+  unsigned int prio;    /* Priority of the task */
+  unsigned int cpu;     /* CPU the task was running on */
+  unsigned long pid;    /* ID of the task */
+  double ts;            /* Time of the note in microseconds */
+};
+
+/* The name of a task learned from its NOTE_START note */
+
+struct taskname_s
+{
+  unsigned long pid;
+  char name[MAX_NAMELEN];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static char *g_progname;
+static struct layout_s g_layout =
+{
+  false, false, 4, 4, 4, 4, 100.0
+};
+
+static FILE *g_outstream;
+static bool g_first = true;
+static uint64_t g_lasttime;
+static uint64_t g_timebase;
+static bool g_cpubusy[MAX_CPUS];
+static unsigned long g_cpupid[MAX_CPUS];
+static struct taskname_s g_tasknames[MAX_TASKS];
+static unsigned int g_ntasknames;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(void)
+{
+  fprintf(stderr, "USAGE: %s [-s] [-p <size>] [-t <size>] "
+          "[-r <secsize>,<nsecsize>]\n", g_progname);
+  fprintf(stderr, "       [-a <size>] [-f <hz>] [-o <out-file>] "
+          "<note-file>\n");
+  fprintf(stderr, "\nWhere:\n\n");
+  fprintf(stderr, "  <note-file> holds the notes read from /dev/note.\n");
+  fprintf(stderr, "  -s  The notes contain the CPU number (CONFIG_SMP).\n");
+  fprintf(stderr, "  -p  Size of pid_t in bytes (default 4).\n");
+  fprintf(stderr, "  -t  Size of clock_t in bytes (default 4).\n");
+  fprintf(stderr, "  -r  The notes hold a struct timespec "
+          "(CONFIG_SCHED_INSTRUMENTATION_HIRES)\n");
+  fprintf(stderr, "      with the given sizes of time_t and long.\n");
+  fprintf(stderr, "  -a  Size of uintptr_t in bytes (default 4).\n");
+  fprintf(stderr, "  -f  Frequency of the clock_t timestamps: the tick "
+          "rate, or the rate\n");
+  fprintf(stderr, "      of up_perf_gettime() with "
+          "CONFIG_SCHED_INSTRUMENTATION_PERFCOUNT\n");
+  fprintf(stderr, "      (default 100).\n");
+  fprintf(stderr, "  -o  Write the trace to <out-file> instead of "
+          "stdout.\n");
+  fprintf(stderr, "\nThe output is Chrome trace event JSON, which is "
+          "loaded by ui.perfetto.dev\n");
+  fprintf(stderr, "and chrome://tracing.\n");
+  exit(1);
+}
+
+static uint64_t get_value(const uint8_t *data, unsigned int size)
+{
+  uint64_t value = 0;
+
+  /* The notes are in little endian order */
+
+  while (size-- > 0)
+    {
+      value = (value << 8) | data[size];
+    }
+
+  return value;
+}
+
+static int64_t get_signed(const uint8_t *data, unsigned int size)
+{
+  uint64_t value = get_value(data, size);
+
+  if (size < 8 && (value & ((uint64_t)1 << (8 * size - 1))) != 0)
+    {
+      value |= ~(uint64_t)0 << (8 * size);
+    }
+
+  return (int64_t)value;
+}
+
+static void put_string(const char *str, size_t maxlen)
+{
+  /* Quote a string as a JSON string */
+
+  fputc('"', g_outstream);
+  for (; maxlen > 0 && *str != '\0'; str++, maxlen--)
+    {
+      unsigned char ch = *str;
+
+      if (ch == '"' || ch == '\\')
+        {
+          fprintf(g_outstream, "\\%c", ch);
+        }
+      else if (ch < 0x20 || ch >= 0x7f)
+        {
+          fprintf(g_outstream, "\\u%04x", ch);
+        }
+      else
+        {
+          fputc(ch, g_outstream);
+        }
+    }
+
+  fputc('"', g_outstream);
+}
+
+static void begin_event(const char *name, size_t namelen, char ph,
+                        double ts, unsigned long pid, unsigned long tid)
+{
+  /* Start a new trace event.  The caller may add more fields and must
+   * close it with end_event().
+   */
+
+  fprintf(g_outstream, "%s\n{\"name\":", g_first ? "" : ",");
+  put_string(name, namelen);
+  fprintf(g_outstream, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%lu,"
+          "\"tid\":%lu", ph, ts, pid, tid);
+  g_first = false;
+}
+
+static void end_event(void)
+{
+  fputc('}', g_outstream);
+}
+
+static void put_event(const char *name, char ph, double ts,
+                      unsigned long pid, unsigned long tid)
+{
+  begin_event(name, SIZE_MAX, ph, ts, pid, tid);
+  if (ph == 'i')
+    {
+      fprintf(g_outstream, ",\"s\":\"t\"");
+    }
+
+  end_event();
+}
+
+static void put_metadata(const char *what, unsigned long pid,
+                         unsigned long tid, const char *name,
+                         size_t namelen)
+{
+  fprintf(g_outstream, "%s\n{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%lu,"
+          "\"tid\":%lu,\"args\":{\"name\":", g_first ? "" : ",", what,
+          pid, tid);
+  put_string(name, namelen);
+  fprintf(g_outstream, "}}");
+  g_first = false;
+}
+
+static void put_cpus(unsigned int ncpus)
+{
+  char name[32];
+  unsigned int cpu;
+
+  put_metadata("process_name", TRACE_PID_TASKS, 0, "Tasks", SIZE_MAX);
+  put_metadata("process_name", TRACE_PID_CPUS, 0, "CPUs", SIZE_MAX);
+
+  for (cpu = 0; cpu < ncpus; cpu++)
+    {
+      snprintf(name, sizeof(name), "CPU %u", cpu);
+      put_metadata("thread_name", TRACE_PID_CPUS, cpu, name, SIZE_MAX);
+      snprintf(name, sizeof(name), "CPU %u IRQ", cpu);
+      put_metadata("thread_name", TRACE_PID_CPUS, TRACE_TID_IRQ + cpu,
+                   name, SIZE_MAX);
+    }
+}
+
+static void set_taskname(unsigned long pid, const char *name, size_t len)
+{
+  unsigned int i;
+
+  for (i = 0; i < g_ntasknames && g_tasknames[i].pid != pid; i++)
+    {
+    }
+
+  if (i == MAX_TASKS)
+    {
+      return;
+    }
+
+  if (i == g_ntasknames)
+    {
+      g_ntasknames++;
+    }
+
+  if (len >= MAX_NAMELEN)
+    {
+      len = MAX_NAMELEN - 1;
+    }
+
+  g_tasknames[i].pid = pid;
+  memcpy(g_tasknames[i].name, name, len);
+  g_tasknames[i].name[len] = '\0';
+}
+
+static void get_taskname(unsigned long pid, char *name, size_t size)
+{
+  unsigned int i;
+
+  for (i = 0; i < g_ntasknames; i++)
+    {
+      if (g_tasknames[i].pid == pid)
+        {
+          snprintf(name, size, "%s (%lu)", g_tasknames[i].name, pid);
+          return;
+        }
+    }
+
+  snprintf(name, size, "pid %lu", pid);
+}
+
+static bool decode_header(const uint8_t *data, unsigned int length,
+                          struct note_s *note)
+{
+  unsigned int offset;
+  uint64_t time;
+
+  offset = g_layout.smp ? 4 : 3;
+  note->hdrlen = offset + g_layout.pidsize + g_layout.timesize +
+                 (g_layout.hires ? g_layout.nsecsize : 0);
+  if (length < note->hdrlen)
+    {
+      return false;
+    }
+
+  note->data   = data;
+  note->length = length;
+  note->type   = data[1];
+  note->prio   = data[2];
+  note->cpu    = g_layout.smp ? data[3] : 0;
+  note->pid    = (unsigned long)get_value(&data[offset], g_layout.pidsize);
+  offset      += g_layout.pidsize;
+
+  if (g_layout.hires)
+    {
+      time = get_value(&data[offset], g_layout.timesize);
+      note->ts = (double)time * 1000000.0 +
+                 (double)get_value(&data[offset + g_layout.timesize],
+                                   g_layout.nsecsize) / 1000.0;
+    }
+  else
+    {
+      /* Extend a 32-bit counter that wraps around */
+
+      time = get_value(&data[offset], g_layout.timesize);
+      if (g_layout.timesize < 8)
+        {
+          if (time < g_lasttime)
+            {
+              g_timebase += (uint64_t)1 << (8 * g_layout.timesize);
+            }
+
+          g_lasttime = time;
+          time += g_timebase;
+        }
+
+      note->ts = (double)time * 1000000.0 / g_layout.freq;
+    }
+
+  if (note->cpu >= MAX_CPUS)
+    {
+      note->cpu = MAX_CPUS - 1;
+    }
+
+  return true;
+}
+
+static void put_string_note(const struct note_s *note, const char *str,
+                            size_t len)
+{
+  const char *name;
+  const char *value;
+  const char *end = str + len;
+  char *stop;
+  unsigned long tid;
+
+  /* Strings of sched_note_begin(), sched_note_end() and
+   * sched_note_counter() use the "B|pid|name", "E|pid|name" and
+   * "C|pid|name|value" format of atrace.
+   */
+
+  if (len > 2 && (str[0] == 'B' || str[0] == 'E' || str[0] == 'C') &&
+      str[1] == '|')
+    {
+      tid = strtoul(&str[2], &stop, 10);
+      if (stop < end && *stop == '|')
+        {
+          name = stop + 1;
+          if (str[0] != 'C')
+            {
+              begin_event(name, end - name, str[0], note->ts,
+                          TRACE_PID_TASKS, tid);
+              end_event();
+              return;
+            }
+
+          value = memchr(name, '|', end - name);
+          if (value != NULL)
+            {
+              begin_event(name, value - name, 'C', note->ts,
+                          TRACE_PID_TASKS, tid);
+              fprintf(g_outstream, ",\"args\":{\"value\":%ld}",
+                      strtol(value + 1, NULL, 10));
+              end_event();
+              return;
+            }
+        }
+    }
+
+  begin_event("string", SIZE_MAX, 'i', note->ts, TRACE_PID_TASKS,
+              note->pid);
+  fprintf(g_outstream, ",\"s\":\"t\",\"args\":{\"string\":");
+  put_string(str, len);
+  fprintf(g_outstream, "}");
+  end_event();
+}
+
+static void put_note(const struct note_s *note)
+{
+  const uint8_t *payload = note->data + note->hdrlen;
+  unsigned int paylen = note->length - note->hdrlen;
+  unsigned int cpu = note->cpu;
+  char name[64];
+
+  switch (note->type)
+    {
+      case NOTE_START:
+        if (paylen > 0)
+          {
+            paylen = strnlen((const char *)payload, paylen);
+            put_metadata("thread_name", TRACE_PID_TASKS, note->pid,
+                         (const char *)payload, paylen);
+            set_taskname(note->pid, (const char *)payload, paylen);
+          }
+        break;
+
+      case NOTE_STOP:
+        put_event("exit", 'i', note->ts, TRACE_PID_TASKS, note->pid);
+        break;
+
+      /* Task switches are shown as a slice per task on the track of the
+       * CPU.
+       */
+
+      case NOTE_SUSPEND:
+        if (g_cpubusy[cpu] && g_cpupid[cpu] == note->pid)
+          {
+            put_event("", 'E', note->ts, TRACE_PID_CPUS, cpu);
+            g_cpubusy[cpu] = false;
+          }
+        break;
+
+      case NOTE_RESUME:
+        if (g_cpubusy[cpu])
+          {
+            put_event("", 'E', note->ts, TRACE_PID_CPUS, cpu);
+          }
+
+        get_taskname(note->pid, name, sizeof(name));
+        begin_event(name, SIZE_MAX, 'B', note->ts, TRACE_PID_CPUS, cpu);
+        fprintf(g_outstream, ",\"args\":{\"pid\":%lu,\"priority\":%u}",
+                note->pid, note->prio);
+        end_event();
+
+        g_cpubusy[cpu] = true;
+        g_cpupid[cpu]  = note->pid;
+        break;
+
+      case NOTE_CPU_START:
+      case NOTE_CPU_PAUSE:
+      case NOTE_CPU_RESUME:
+        snprintf(name, sizeof(name), "%s CPU %u",
+                 note->type == NOTE_CPU_START ? "start" :
+                 note->type == NOTE_CPU_PAUSE ? "pause" : "resume",
+                 paylen > 0 ? payload[0] : 0);
+        put_event(name, 'i', note->ts, TRACE_PID_CPUS, cpu);
+        break;
+
+      case NOTE_CPU_STARTED:
+      case NOTE_CPU_PAUSED:
+      case NOTE_CPU_RESUMED:
+        put_event(note->type == NOTE_CPU_STARTED ? "started" :
+                  note->type == NOTE_CPU_PAUSED ? "paused" : "resumed",
+                  'i', note->ts, TRACE_PID_CPUS, cpu);
+        break;
+
+      /* The nesting counts become counter tracks of the task */
+
+      case NOTE_PREEMPT_LOCK:
+      case NOTE_PREEMPT_UNLOCK:
+      case NOTE_CSECTION_ENTER:
+      case NOTE_CSECTION_LEAVE:
+        snprintf(name, sizeof(name), "%s %lu",
+                 note->type <= NOTE_PREEMPT_UNLOCK ? "preempt" :
+                 "csection", note->pid);
+        begin_event(name, SIZE_MAX, 'C', note->ts, TRACE_PID_TASKS,
+                    note->pid);
+        fprintf(g_outstream, ",\"args\":{\"count\":%u}",
+                paylen >= 2 ? (unsigned int)get_value(payload, 2) :
+                note->type == NOTE_CSECTION_ENTER);
+        end_event();
+        break;
+
+      case NOTE_SPINLOCK_LOCK:
+      case NOTE_SPINLOCK_LOCKED:
+      case NOTE_SPINLOCK_UNLOCK:
+      case NOTE_SPINLOCK_ABORT:
+        {
+          static const char *g_spinnames[] =
+          {
+            "spin lock", "spin locked", "spin unlock", "spin abort"
+          };
+
+          begin_event(g_spinnames[note->type - NOTE_SPINLOCK_LOCK],
+                      SIZE_MAX, 'i', note->ts, TRACE_PID_TASKS, note->pid);
+          if (paylen >= g_layout.ptrsize)
+            {
+              fprintf(g_outstream, ",\"s\":\"t\",\"args\":"
+                      "{\"lock\":\"0x%llx\"}", (unsigned long long)
+                      get_value(payload, g_layout.ptrsize));
+            }
+
+          end_event();
+        }
+        break;
+
+      /* System calls are slices on the track of the task */
+
+      case NOTE_SYSCALL_ENTER:
+        snprintf(name, sizeof(name), "syscall %u",
+                 paylen > 0 ? payload[0] : 0);
+        put_event(name, 'B', note->ts, TRACE_PID_TASKS, note->pid);
+        break;
+
+      case NOTE_SYSCALL_LEAVE:
+        begin_event("", 0, 'E', note->ts, TRACE_PID_TASKS, note->pid);
+        if (paylen >= 1 + g_layout.ptrsize)
+          {
+            fprintf(g_outstream, ",\"args\":{\"result\":%lld}",
+                    (long long)get_signed(payload + 1, g_layout.ptrsize));
+          }
+
+        end_event();
+        break;
+
+      /* Interrupts are slices on the interrupt track of the CPU */
+
+      case NOTE_IRQ_ENTER:
+        snprintf(name, sizeof(name), "irq %u", paylen > 0 ? payload[0] : 0);
+        put_event(name, 'B', note->ts, TRACE_PID_CPUS,
+                  TRACE_TID_IRQ + cpu);
+        break;
+
+      case NOTE_IRQ_LEAVE:
+        put_event("", 'E', note->ts, TRACE_PID_CPUS, TRACE_TID_IRQ + cpu);
+        break;
+
+      case NOTE_DUMP_STRING:
+        if (paylen > g_layout.ptrsize)
+          {
+            put_string_note(note, (const char *)payload + g_layout.ptrsize,
+                            strnlen((const char *)payload +
+                                    g_layout.ptrsize,
+                                    paylen - g_layout.ptrsize));
+          }
+        break;
+
+      case NOTE_DUMP_BINARY:
+        if (paylen > g_layout.ptrsize)
+          {
+            begin_event("binary", SIZE_MAX, 'i', note->ts, TRACE_PID_TASKS,
+                        note->pid);
+            fprintf(g_outstream, ",\"s\":\"t\",\"args\":{\"event\":%u,"
+                    "\"length\":%u}", payload[g_layout.ptrsize],
+                    paylen - g_layout.ptrsize - 1);
+            end_event();
+          }
+        break;
+
+      default:
+        fprintf(stderr, "Unknown note type %u\n", note->type);
+        break;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  struct note_s note;
+  const char *outfile = NULL;
+  unsigned int ncpus = 1;
+  uint8_t *buffer = NULL;
+  size_t buflen = 0;
+  size_t bufsize = 0;
+  size_t offset;
+  unsigned int length;
+  FILE *instream;
+  int option;
+  int cpu;
+
+  g_progname = argv[0];
+  memset(&note, 0, sizeof(note));
+  while ((option = getopt(argc, argv, "sp:t:r:a:f:o:")) != -1)
+    {
+      switch (option)
+        {
+          case 's':
+            g_layout.smp = true;
+            break;
+
+          case 'p':
+            g_layout.pidsize = atoi(optarg);
+            break;
+
+          case 't':
+            g_layout.timesize = atoi(optarg);
+            break;
+
+          case 'r':
+            g_layout.hires = true;
+            if (sscanf(optarg, "%u,%u", &g_layout.timesize,
+                       &g_layout.nsecsize) != 2)
+              {
+                show_usage();
+              }
+            break;
+
+          case 'a':
+            g_layout.ptrsize = atoi(optarg);
+            break;
+
+          case 'f':
+            g_layout.freq = atof(optarg);
+            break;
+
+          case 'o':
+            outfile = optarg;
+            break;
+
+          default:
+            show_usage();
+        }
+    }
+
+  if (optind != argc - 1 || g_layout.freq <= 0.0 ||
+      g_layout.pidsize < 1 || g_layout.pidsize > 8 ||
+      g_layout.timesize < 1 || g_layout.timesize > 8 ||
+      g_layout.nsecsize < 1 || g_layout.nsecsize > 8 ||
+      g_layout.ptrsize < 1 || g_layout.ptrsize > 8)
+    {
+      show_usage();
+    }
+
+  /* Read all of the notes */
+
+  instream = fopen(argv[optind], "rb");
+  if (instream == NULL)
+    {
+      fprintf(stderr, "ERROR: Failed to open %s\n", argv[optind]);
+      exit(1);
+    }
+
+  do
+    {
+      if (buflen == bufsize)
+        {
+          bufsize = bufsize ? 2 * bufsize : 65536;
+          buffer  = realloc(buffer, bufsize);
+          if (buffer == NULL)
+            {
+              fprintf(stderr, "ERROR: Out of memory\n");
+              exit(1);
+            }
+        }
+
+      buflen += fread(buffer + buflen, 1, bufsize - buflen, instream);
+    }
+  while (!feof(instream) && !ferror(instream));
+
+  fclose(instream);
+
+  if (outfile != NULL)
+    {
+      g_outstream = fopen(outfile, "w");
+      if (g_outstream == NULL)
+        {
+          fprintf(stderr, "ERROR: Failed to open %s\n", outfile);
+          exit(1);
+        }
+    }
+  else
+    {
+      g_outstream = stdout;
+    }
+
+  /* Find the number of CPUs to name their tracks first */
+
+  for (offset = 0; offset < buflen && buffer[offset] != 0;
+       offset += buffer[offset])
+    {
+      if (g_layout.smp && buffer[offset] > 3 && offset + 3 < buflen &&
+          buffer[offset + 3] >= ncpus && buffer[offset + 3] < MAX_CPUS)
+        {
+          ncpus = buffer[offset + 3] + 1;
+        }
+    }
+
+  fprintf(g_outstream, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  put_cpus(ncpus);
+
+  /* Then convert the notes one by one */
+
+  for (offset = 0; offset < buflen; offset += length)
+    {
+      length = buffer[offset];
+      if (offset + length > buflen ||
+          !decode_header(&buffer[offset], length, &note))
+        {
+          fprintf(stderr, "Bad note at offset %lu\n", (unsigned long)offset);
+          break;
+        }
+
+      put_note(&note);
+    }
+
+  /* Close the task slices that are still running */
+
+  for (cpu = 0; cpu < MAX_CPUS; cpu++)
+    {
+      if (g_cpubusy[cpu])
+        {
+          put_event("", 'E', note.ts, TRACE_PID_CPUS, cpu);
+        }
+    }
+
+  fprintf(g_outstream, "\n]}\n");
+
+  if (g_outstream != stdout)
+    {
+      fclose(g_outstream);
+    }
+
+  free(buffer);
+  return 0;
+}
@@ -52,6 +52,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/kthread.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/net/bluetooth.h>
@@ -122,11 +123,12 @@ static struct work_s g_hp_work;
  * Name: bt_enqueue_bufwork
  *
  * Description:
- *   Add the provided buffer 'buf' to the head selected buffer list 'list'
+ *   Add the provided buffer 'buf' to the tail of the selected buffer list
+ *   'list'
  *
  * Input Parameters:
  *   list - The buffer list to use
- *   buf  - The buffer to be added to the head of the buffer list
+ *   buf  - The buffer to be added to the tail of the buffer list
  *
  * Returned Value:
  *
@@ -138,13 +140,17 @@ static void bt_enqueue_bufwork(FAR struct bt_bufferlist_s *list,
   irqstate_t flags;
 
   flags      = spin_lock_irqsave(NULL);
-  buf->flink = list->head;
-  if (list->head == NULL)
+  buf->flink = NULL;
+  if (list->tail == NULL)
     {
-      list->tail = buf;
+      list->head = buf;
+    }
+  else
+    {
+      list->tail->flink = buf;
     }
 
-  list->head = buf;
+  list->tail = buf;
   spin_unlock_irqrestore(NULL, flags);
 }
 
@@ -152,54 +158,45 @@ static void bt_enqueue_bufwork(FAR struct bt_bufferlist_s *list,
  * Name: bt_dequeue_bufwork
  *
  * Description:
- *   Remove and return the buffer at the tail of the buffer list specified
- *   by 'list'.
+ *   Remove and return the oldest buffer.  Buffers are taken from the
+ *   caller's private 'batch' list; when that is empty, everything queued
+ *   on 'list' is moved there at once.  The work functions so process all
+ *   the buffers received since they were scheduled in one pass, taking the
+ *   lock once per batch rather than once per buffer.
  *
  * Input Parameters:
- *   list - The buffer list to use
+ *   list  - The buffer list to use
+ *   batch - The private list of the caller, initially NULL
  *
  * Returned Value:
- *   A pointer to the buffer that was at the tail of the buffer list.  NULL
- *   is returned if the list was empty.
+ *   A pointer to the oldest buffer.  NULL is returned if both lists were
+ *   empty.
  *
  ****************************************************************************/
 
 static FAR struct bt_buf_s *
-  bt_dequeue_bufwork(FAR struct bt_bufferlist_s *list)
+  bt_dequeue_bufwork(FAR struct bt_bufferlist_s *list,
+                     FAR struct bt_buf_s **batch)
 {
   FAR struct bt_buf_s *buf;
   irqstate_t flags;
 
-  flags = spin_lock_irqsave(NULL);
-  buf   = list->tail;
-  if (buf != NULL)
+  buf = *batch;
+  if (buf == NULL)
     {
-      if (list->head == list->tail)
-        {
-          list->head = NULL;
-          list->tail = NULL;
-        }
-      else
-        {
-          FAR struct bt_buf_s *prev;
-
-          for (prev = list->head;
-               prev && prev->flink != buf;
-               prev = prev->flink)
-            {
-            }
-
-          if (prev != NULL)
-            {
-              prev->flink = NULL;
-              list->tail  = prev;
-            }
-        }
+      flags      = spin_lock_irqsave(NULL);
+      buf        = list->head;
+      list->head = NULL;
+      list->tail = NULL;
+      spin_unlock_irqrestore(NULL, flags);
+    }
 
+  if (buf != NULL)
+    {
+      *batch     = buf->flink;
       buf->flink = NULL;
     }
 
-  spin_unlock_irqrestore(NULL, flags);
   return buf;
 }
 
@@ -1051,12 +1048,13 @@ static int hci_tx_kthread(int argc, FAR char *argv[])
 static void hci_rx_work(FAR void *arg)
 {
   FAR struct bt_bufferlist_s *list = (FAR struct bt_bufferlist_s *)arg;
+  FAR struct bt_buf_s *batch = NULL;
   FAR struct bt_buf_s *buf;
 
   wlinfo("list %p\n", list);
   DEBUGASSERT(list != NULL);
 
-  while ((buf = bt_dequeue_bufwork(list)) != NULL)
+  while ((buf = bt_dequeue_bufwork(list, &batch)) != NULL)
     {
       wlinfo("buf %p type %u len %u\n", buf, buf->type, buf->len);
 
@@ -1103,12 +1101,13 @@ static void hci_rx_work(FAR void *arg)
 static void priority_rx_work(FAR void *arg)
 {
   FAR struct bt_bufferlist_s *list = (FAR struct bt_bufferlist_s *)arg;
+  FAR struct bt_buf_s *batch = NULL;
   FAR struct bt_buf_s *buf;
 
   wlinfo("list %p\n", list);
   DEBUGASSERT(list != NULL);
 
-  while ((buf = bt_dequeue_bufwork(list)) != NULL)
+  while ((buf = bt_dequeue_bufwork(list, &batch)) != NULL)
     {
       FAR struct bt_hci_evt_hdr_s *hdr = (FAR void *)buf->data;
 
@@ -1458,6 +1457,92 @@ static void cmd_queue_init(void)
   UNUSED(ret);
 }
 
+/****************************************************************************
+ * Name: bt_receive_buf
+ *
+ * Description:
+ *   Queue a received buffer for processing on the low or on the high
+ *   priority work queue.
+ *
+ * Input Parameters:
+ *   buf - An instance of the buffer structure providing the received frame.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  The buffer is
+ *   released on failure.
+ *
+ ****************************************************************************/
+
+static int bt_receive_buf(FAR struct bt_buf_s *buf)
+{
+  FAR struct bt_hci_evt_hdr_s *hdr;
+  int ret;
+
+  /* Critical command complete/status events use the high priority work
+   * queue.
+   */
+
+  if (buf->type != BT_ACL_IN)
+    {
+      if (buf->type != BT_EVT)
+        {
+          wlerr("ERROR: Invalid buf type %u\n", buf->type);
+          bt_buf_release(buf);
+          return -EINVAL;
+        }
+
+      /* Command Complete/Status events use high priority messages. */
+
+      hdr = (FAR void *)buf->data;
+      if (hdr->evt == BT_HCI_EVT_CMD_COMPLETE ||
+          hdr->evt == BT_HCI_EVT_CMD_STATUS ||
+          hdr->evt == BT_HCI_EVT_NUM_COMPLETED_PACKETS)
+        {
+          /* Add the buffer to the high priority Rx buffer list */
+
+          bt_enqueue_bufwork(&g_hp_rxlist, buf);
+
+          /* If there is already pending work, then do nothing.  Otherwise,
+           * schedule processing of the Rx buffer list on the high priority
+           * work queue.
+           */
+
+          if (work_available(&g_hp_work))
+            {
+              ret = work_queue(HPWORK, &g_hp_work, priority_rx_work,
+                               &g_hp_rxlist, 0);
+              if (ret < 0)
+                {
+                  wlerr("ERROR:  Failed to schedule HPWORK: %d\n", ret);
+                }
+            }
+
+          return OK;
+        }
+    }
+
+  /* All others use the low priority work queue */
+
+  /* Add the buffer to the low priority Rx buffer list */
+
+  bt_enqueue_bufwork(&g_lp_rxlist, buf);
+
+  /* If there is already pending work, then do nothing.  Otherwise, schedule
+   * processing of the Rx buffer list on the low priority work queue.
+   */
+
+  if (work_available(&g_lp_work))
+    {
+      ret = work_queue(LPWORK, &g_lp_work, hci_rx_work, &g_lp_rxlist, 0);
+      if (ret < 0)
+        {
+          wlerr("ERROR:  Failed to schedule LPWORK: %d\n", ret);
+        }
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -1609,16 +1694,10 @@ void bt_driver_unregister(FAR struct bt_driver_s *btdev)
 int bt_receive(FAR struct bt_driver_s *btdev, enum bt_buf_type_e type,
                FAR void *data, size_t len)
 {
-  FAR struct bt_hci_evt_hdr_s *hdr;
   struct bt_buf_s *buf;
-  int ret;
 
   wlinfo("data %p len %zu\n", data, len);
 
-  /* Critical command complete/status events use the high priority work
-   * queue.
-   */
-
   buf = bt_buf_alloc(type, NULL, BLUETOOTH_H4_HDRLEN);
   if (buf == NULL)
     {
@@ -1626,66 +1705,44 @@ int bt_receive(FAR struct bt_driver_s *btdev, enum bt_buf_type_e type,
     }
 
   memcpy(bt_buf_extend(buf, len), data, len);
+  return bt_receive_buf(buf);
+}
 
-  if (type != BT_ACL_IN)
-    {
-      if (type != BT_EVT)
-        {
-          wlerr("ERROR: Invalid buf type %u\n", buf->type);
-          bt_buf_release(buf);
-          return -EINVAL;
-        }
-
-      /* Command Complete/Status events use high priority messages. */
-
-      hdr = (FAR void *)buf->data;
-      if (hdr->evt == BT_HCI_EVT_CMD_COMPLETE ||
-          hdr->evt == BT_HCI_EVT_CMD_STATUS ||
-          hdr->evt == BT_HCI_EVT_NUM_COMPLETED_PACKETS)
-        {
-          /* Add the buffer to the high priority Rx buffer list */
-
-          bt_enqueue_bufwork(&g_hp_rxlist, buf);
-
-          /* If there is already pending work, then do nothing.  Otherwise,
-           * schedule processing of the Rx buffer list on the high priority
-           * work queue.
-           */
-
-          if (work_available(&g_hp_work))
-            {
-              ret = work_queue(HPWORK, &g_hp_work, priority_rx_work,
-                               &g_hp_rxlist, 0);
-              if (ret < 0)
-                {
-                  wlerr("ERROR:  Failed to schedule HPWORK: %d\n", ret);
-                }
-            }
-
-          return OK;
-        }
-    }
-
-  /* All others use the low priority work queue */
-
-  /* Add the buffer to the low priority Rx buffer list */
+/****************************************************************************
+ * Name: bt_receive_iob
+ *
+ * Description:
+ *   Same as bt_receive() but the low-level driver hands over an IOB that
+ *   already holds the received frame, from io_offset up to io_len.  The
+ *   IOB is used as the frame of the buffer as is, so the frame data is
+ *   never copied.  The IOB belongs to the stack afterwards, also if the
+ *   function fails.
+ *
+ * Input Parameters:
+ *   btdev - An instance of the low-level drivers interface structure.
+ *   type  - The type of the frame:  BT_EVT or BT_ACL_IN
+ *   iob   - The IOB holding the frame.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
 
-  bt_enqueue_bufwork(&g_lp_rxlist, buf);
+int bt_receive_iob(FAR struct bt_driver_s *btdev, enum bt_buf_type_e type,
+                   FAR struct iob_s *iob)
+{
+  struct bt_buf_s *buf;
 
-  /* If there is already pending work, then do nothing.  Otherwise, schedule
-   * processing of the Rx buffer list on the low priority work queue.
-   */
+  wlinfo("iob %p len %u\n", iob, iob->io_len - iob->io_offset);
 
-  if (work_available(&g_lp_work))
+  buf = bt_buf_alloc(type, iob, 0);
+  if (buf == NULL)
     {
-      ret = work_queue(LPWORK, &g_lp_work, hci_rx_work, &g_lp_rxlist, 0);
-      if (ret < 0)
-        {
-          wlerr("ERROR:  Failed to schedule LPWORK: %d\n", ret);
-        }
+      iob_free(iob, IOBUSER_WIRELESS_BLUETOOTH);
+      return -ENOMEM;
     }
 
-  return OK;
+  return bt_receive_buf(buf);
 }
 
 #ifdef CONFIG_WIRELESS_BLUETOOTH_HOST
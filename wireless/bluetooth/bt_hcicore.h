@@ -471,4 +471,17 @@ void bt_hci_cb_register(FAR struct bt_hci_cb_s *cb);
 int bt_receive(FAR struct bt_driver_s *btdev, enum bt_buf_type_e type,
                FAR void *data, size_t len);
 
+/****************************************************************************
+ * Name: bt_receive_iob
+ *
+ * Description:
+ *   Same as bt_receive() but takes over an IOB holding the received frame,
+ *   without copying it.  This may be called from the low-level driver and
+ *   is part of the driver interface
+ *
+ ****************************************************************************/
+
+int bt_receive_iob(FAR struct bt_driver_s *btdev, enum bt_buf_type_e type,
+                   FAR struct iob_s *iob);
+
 #endif /* __WIRELESS_BLUETOOTH_BT_HDICORE_H */
@@ -53,6 +53,17 @@
 
 static void mac802154_resetqueues(FAR struct ieee802154_privmac_s *priv);
 
+/* Indirect transactions */
+
+static unsigned int
+mac802154_indirect_hash(FAR const struct ieee802154_addr_s *addr);
+static void
+mac802154_indirect_remove(FAR struct ieee802154_privmac_s *priv,
+                          FAR struct ieee802154_txdesc_s *txdesc);
+static FAR struct ieee802154_txdesc_s *
+mac802154_indirect_find(FAR struct ieee802154_privmac_s *priv,
+                        FAR const struct ieee802154_addr_s *addr);
+
 /* IEEE 802.15.4 PHY Interface OPs */
 
 static int
@@ -105,7 +116,8 @@ static void mac802154_resetqueues(FAR struct ieee802154_privmac_s *priv)
   sq_init(&priv->txdone_queue);
   sq_init(&priv->csma_queue);
   sq_init(&priv->gts_queue);
-  sq_init(&priv->indirect_queue);
+  dq_init(&priv->indirect_queue);
+  memset(priv->indirect_hash, 0, sizeof(priv->indirect_hash));
   sq_init(&priv->dataind_queue);
   sq_init(&priv->primitive_queue);
 
@@ -121,6 +133,110 @@ static void mac802154_resetqueues(FAR struct ieee802154_privmac_s *priv)
   nxsem_init(&priv->txdesc_sem, 0, CONFIG_MAC802154_NTXDESC);
 }
 
+/****************************************************************************
+ * Name: mac802154_indirect_hash
+ *
+ * Description:
+ *   Return the hash bucket of the indirect transactions for the provided
+ *   destination address.
+ *
+ ****************************************************************************/
+
+static unsigned int
+mac802154_indirect_hash(FAR const struct ieee802154_addr_s *addr)
+{
+  unsigned int hash = 0;
+  int i;
+
+  if (addr->mode == IEEE802154_ADDRMODE_SHORT)
+    {
+      hash = addr->saddr[0] ^ addr->saddr[1];
+    }
+  else if (addr->mode == IEEE802154_ADDRMODE_EXTENDED)
+    {
+      for (i = 0; i < IEEE802154_EADDRSIZE; i++)
+        {
+          hash ^= addr->eaddr[i];
+        }
+    }
+
+  return hash & MAC802154_INDIRECT_HASHMASK;
+}
+
+/****************************************************************************
+ * Name: mac802154_indirect_remove
+ *
+ * Description:
+ *   Unlink an indirect transaction from the list and from its hash chain.
+ *
+ * Assumptions:
+ *    Called with the MAC locked
+ *
+ ****************************************************************************/
+
+static void mac802154_indirect_remove(FAR struct ieee802154_privmac_s *priv,
+                                      FAR struct ieee802154_txdesc_s *txdesc)
+{
+  FAR struct ieee802154_txdesc_s **link;
+
+  dq_rem((FAR dq_entry_t *)txdesc, &priv->indirect_queue);
+
+  link = &priv->indirect_hash[mac802154_indirect_hash(&txdesc->destaddr)];
+  while (*link != NULL)
+    {
+      if (*link == txdesc)
+        {
+          *link = txdesc->hlink;
+          break;
+        }
+
+      link = &(*link)->hlink;
+    }
+
+  txdesc->hlink = NULL;
+}
+
+/****************************************************************************
+ * Name: mac802154_indirect_find
+ *
+ * Description:
+ *   Find the oldest indirect transaction waiting for the provided address.
+ *
+ * Assumptions:
+ *    Called with the MAC locked
+ *
+ ****************************************************************************/
+
+static FAR struct ieee802154_txdesc_s *
+mac802154_indirect_find(FAR struct ieee802154_privmac_s *priv,
+                        FAR const struct ieee802154_addr_s *addr)
+{
+  FAR struct ieee802154_txdesc_s *txdesc;
+
+  txdesc = priv->indirect_hash[mac802154_indirect_hash(addr)];
+  for (; txdesc != NULL; txdesc = txdesc->hlink)
+    {
+      if (txdesc->destaddr.mode != addr->mode)
+        {
+          continue;
+        }
+
+      if (addr->mode == IEEE802154_ADDRMODE_SHORT &&
+          IEEE802154_SADDRCMP(txdesc->destaddr.saddr, addr->saddr))
+        {
+          return txdesc;
+        }
+
+      if (addr->mode == IEEE802154_ADDRMODE_EXTENDED &&
+          IEEE802154_EADDRCMP(txdesc->destaddr.eaddr, addr->eaddr))
+        {
+          return txdesc;
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Name: mac802154_txdesc_pool
  *
@@ -375,13 +491,16 @@ static void mac802154_notify_worker(FAR void *arg)
     (FAR struct ieee802154_privmac_s *)arg;
   FAR struct mac802154_maccb_s *cb;
   FAR struct ieee802154_primitive_s *primitive;
+  sq_queue_t queue;
   int ret;
 
+  /* Take all the pending primitives at once */
+
   mac802154_lock(priv, false);
-  primitive =
-    (FAR struct ieee802154_primitive_s *)sq_remfirst(&priv->primitive_queue);
+  sq_move(&priv->primitive_queue, &queue);
   mac802154_unlock(priv);
 
+  primitive = (FAR struct ieee802154_primitive_s *)sq_remfirst(&queue);
   while (primitive != NULL)
     {
       /* Data indications are a special case since the frame can only be
@@ -449,12 +568,20 @@ static void mac802154_notify_worker(FAR void *arg)
             }
         }
 
-      /* Get the next primitive then loop */
+      /* Get the next primitive then loop, refilling the local queue with
+       * the ones queued in the meantime.
+       */
 
-      mac802154_lock(priv, false);
-      primitive = (FAR struct ieee802154_primitive_s *)
-                    sq_remfirst(&priv->primitive_queue);
-      mac802154_unlock(priv);
+      primitive = (FAR struct ieee802154_primitive_s *)sq_remfirst(&queue);
+      if (primitive == NULL)
+        {
+          mac802154_lock(priv, false);
+          sq_move(&priv->primitive_queue, &queue);
+          mac802154_unlock(priv);
+
+          primitive = (FAR struct ieee802154_primitive_s *)
+                        sq_remfirst(&queue);
+        }
     }
 }
 
@@ -581,7 +708,7 @@ void mac802154_updatebeacon(FAR struct ieee802154_privmac_s *priv)
   pendaddrspec_ind = beacon->bf_len++;
 
   txdesc = (FAR struct ieee802154_txdesc_s *)
-             sq_peek(&priv->indirect_queue);
+             dq_peek(&priv->indirect_queue);
 
   while (txdesc != NULL)
     {
@@ -610,7 +737,7 @@ void mac802154_updatebeacon(FAR struct ieee802154_privmac_s *priv)
       /* Get the next pending indirect transaction */
 
       txdesc = (FAR struct ieee802154_txdesc_s *)
-                 sq_next((FAR sq_entry_t *)txdesc);
+                 dq_next((FAR dq_entry_t *)txdesc);
     }
 
   /* At this point, we know how many of each transaction we have, we can
@@ -646,12 +773,24 @@ void mac802154_updatebeacon(FAR struct ieee802154_privmac_s *priv)
 void mac802154_setupindirect(FAR struct ieee802154_privmac_s *priv,
                              FAR struct ieee802154_txdesc_s *txdesc)
 {
+  FAR struct ieee802154_txdesc_s **link;
   uint32_t ticks;
   uint32_t symbols;
 
-  /* Link the tx descriptor into the list */
+  /* Link the tx descriptor into the list and at the end of its hash chain
+   * so that the transactions for one device are sent in order.
+   */
+
+  dq_addlast((FAR dq_entry_t *)txdesc, &priv->indirect_queue);
+
+  link = &priv->indirect_hash[mac802154_indirect_hash(&txdesc->destaddr)];
+  while (*link != NULL)
+    {
+      link = &(*link)->hlink;
+    }
 
-  sq_addlast((FAR sq_entry_t *)txdesc, &priv->indirect_queue);
+  txdesc->hlink = NULL;
+  *link = txdesc;
 
   /* Update the timestamp for purging the transaction */
 
@@ -732,7 +871,7 @@ static void mac802154_purge_worker(FAR void *arg)
        */
 
       txdesc = (FAR struct ieee802154_txdesc_s *)
-                 sq_peek(&priv->indirect_queue);
+                 dq_peek(&priv->indirect_queue);
       if (txdesc == NULL)
         {
           break;
@@ -747,7 +886,7 @@ static void mac802154_purge_worker(FAR void *arg)
         {
           /* Unlink the transaction */
 
-          sq_remfirst(&priv->indirect_queue);
+          mac802154_indirect_remove(priv, txdesc);
 
           /* Free the IOB, the notification, and the tx descriptor */
 
@@ -1063,34 +1202,41 @@ static void mac802154_rxframe_worker(FAR void *arg)
     (FAR struct ieee802154_privmac_s *)arg;
   FAR struct ieee802154_data_ind_s *ind;
   FAR struct iob_s *iob;
+  sq_queue_t rxqueue;
   uint16_t *frame_ctrl;
   bool panid_comp;
   uint8_t ftype;
 
+  sq_init(&rxqueue);
+
   while (1)
     {
-      /* Get exclusive access to the driver structure.  We don't care about
-       * any signals so if we see one, just go back to trying to get access
-       * again.
-       */
-
-      mac802154_lock(priv, false);
-
       /* Pop the data indication from the head of the frame list for
        * processing.   Note: dataind_queue contains ieee802154_primitive_s
        * which is safe to cast directly to a data indication.
        */
 
-      ind = (FAR struct ieee802154_data_ind_s *)
-              sq_remfirst(&priv->dataind_queue);
-
-      /* Once we pop off the indication, we needn't to keep the mac locked */
-
-      mac802154_unlock(priv)
-
+      ind = (FAR struct ieee802154_data_ind_s *)sq_remfirst(&rxqueue);
       if (ind == NULL)
         {
-          return;
+          /* Get exclusive access to the driver structure.  We don't care
+           * about any signals so if we see one, just go back to trying to
+           * get access again.
+           *
+           * Take all the frames received so far at once, so that a burst
+           * of frames only costs one lock per worker pass.  Once we have
+           * them, we needn't to keep the mac locked.
+           */
+
+          mac802154_lock(priv, false);
+          sq_move(&priv->dataind_queue, &rxqueue);
+          mac802154_unlock(priv)
+
+          ind = (FAR struct ieee802154_data_ind_s *)sq_remfirst(&rxqueue);
+          if (ind == NULL)
+            {
+              return;
+            }
         }
 
       /* Get a local copy of the frame to make it easier to access */
@@ -1465,63 +1611,27 @@ static void mac802154_rxdatareq(FAR struct ieee802154_privmac_s *priv,
    * need to check for this condition.
    */
 
-  txdesc = (FAR struct ieee802154_txdesc_s *)sq_peek(&priv->indirect_queue);
-
-  while (txdesc != NULL)
+  txdesc = mac802154_indirect_find(priv, &ind->src);
+  if (txdesc != NULL)
     {
-      if (txdesc->destaddr.mode == ind->src.mode)
-        {
-          if (txdesc->destaddr.mode == IEEE802154_ADDRMODE_SHORT)
-            {
-              if (IEEE802154_SADDRCMP(txdesc->destaddr.saddr,
-                                      ind->src.saddr))
-                {
-                  /* Remove the transaction from the queue */
-
-                  sq_rem((FAR sq_entry_t *)txdesc, &priv->indirect_queue);
+      /* Remove the transaction from the queue */
 
-                  /* NOTE: We don't do anything with the purge timeout,
-                   * because we really don't need to. As of now, I see no
-                   * disadvantage to just letting the timeout expire, which
-                   * won't purge the transaction since it is no longer on
-                   * the list, and then it will reschedule the next timeout
-                   * appropriately.  The logic otherwise may get complicated
-                   * even though it may save a few clock cycles.
-                   */
+      mac802154_indirect_remove(priv, txdesc);
 
-                  /* The addresses match, send the transaction immediately */
-
-                  priv->radio->txdelayed(priv->radio, txdesc, 0);
-                  priv->beaconupdate = true;
-                  mac802154_unlock(priv)
-                  return;
-                }
-            }
-          else if (txdesc->destaddr.mode == IEEE802154_ADDRMODE_EXTENDED)
-            {
-              if (IEEE802154_EADDRCMP(txdesc->destaddr.eaddr,
-                                      ind->src.eaddr))
-                {
-                  /* Remove the transaction from the queue */
-
-                  sq_rem((FAR sq_entry_t *)txdesc, &priv->indirect_queue);
-
-                  /* The addresses match, send the transaction immediately */
+      /* NOTE: We don't do anything with the purge timeout, because we
+       * really don't need to. As of now, I see no disadvantage to just
+       * letting the timeout expire, which won't purge the transaction since
+       * it is no longer on the list, and then it will reschedule the next
+       * timeout appropriately.  The logic otherwise may get complicated
+       * even though it may save a few clock cycles.
+       */
 
-                  priv->radio->txdelayed(priv->radio, txdesc, 0);
-                  priv->beaconupdate = true;
-                  mac802154_unlock(priv)
-                  return;
-                }
-            }
-          else
-            {
-              DEBUGASSERT(false);
-            }
-        }
+      /* The addresses match, send the transaction immediately */
 
-      txdesc = (FAR struct ieee802154_txdesc_s *)
-                 sq_next((FAR sq_entry_t *)txdesc);
+      priv->radio->txdelayed(priv->radio, txdesc, 0);
+      priv->beaconupdate = true;
+      mac802154_unlock(priv)
+      return;
     }
 
   /* If there is no data frame pending for the requesting device, the
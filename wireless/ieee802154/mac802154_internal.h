@@ -59,6 +59,17 @@
 #  define CONFIG_MAC802154_NTXDESC 5
 #endif
 
+#ifndef CONFIG_MAC802154_INDIRECT_NHASH
+#  define CONFIG_MAC802154_INDIRECT_NHASH 8
+#endif
+
+#if (CONFIG_MAC802154_INDIRECT_NHASH & \
+     (CONFIG_MAC802154_INDIRECT_NHASH - 1)) != 0
+#  error CONFIG_MAC802154_INDIRECT_NHASH must be a power of two
+#endif
+
+#define MAC802154_INDIRECT_HASHMASK (CONFIG_MAC802154_INDIRECT_NHASH - 1)
+
 #if !defined(CONFIG_IEEE802154_DEFAULT_EADDR)
 #  define CONFIG_IEEE802154_DEFAULT_EADDR 0xFFFFFFFFFFFFFFFF
 #endif
@@ -155,16 +166,22 @@ struct ieee802154_privmac_s
   sq_queue_t csma_queue;
   sq_queue_t gts_queue;
 
-  /* Support a singly linked list of transactions that will be sent
+  /* Support a doubly linked list of transactions that will be sent
    * indirectly. This list should only be used by a MAC acting as a
    * coordinator.  These transactions will stay here until the data
    * is extracted by the destination device sending a Data Request
    * MAC command or if too much time passes. This list should also
    * be used to populate the address list of the outgoing beacon
    * frame.
+   *
+   * The list is kept in the order the transactions expire.  The same
+   * transactions are also hashed by destination address so that a Data
+   * Request does not have to scan all the pending transactions.
    */
 
-  sq_queue_t indirect_queue;
+  dq_queue_t indirect_queue;
+  FAR struct ieee802154_txdesc_s *
+    indirect_hash[CONFIG_MAC802154_INDIRECT_NHASH];
 
   /* Support a singly linked list of frames received */
 